@@ -18,10 +18,14 @@
 
 #include "asylo/bazel/application_wrapper/application_wrapper_driver_main.h"
 
+#include <cstdlib>
+#include <fstream>
+
 #include "absl/status/status.h"
 #include "asylo/bazel/application_wrapper/application_wrapper.pb.h"
 #include "asylo/bazel/application_wrapper/argv.h"
 #include "asylo/client.h"
+#include "asylo/platform/primitives/util/call_metrics.h"
 #include "asylo/util/logging.h"
 #include "asylo/util/cleanup.h"
 #include "asylo/util/status.h"
@@ -29,9 +33,41 @@
 
 namespace asylo {
 
+namespace {
+
+// Writes the per-selector exit-call statistics recorded by CallMetrics to
+// |path| as text: one "exit <selector> <count> <total_nanos>" line per
+// selector with a nonzero count. Benchmark harnesses driving a wrapped
+// application from outside the process parse this to compute exit-rate
+// metrics such as exits per operation.
+void DumpExitStats(const char *path) {
+  std::ofstream out(path, std::ios::trunc);
+  if (!out) {
+    LOG(ERROR) << "Failed to open exit stats file " << path;
+    return;
+  }
+  for (const primitives::CallMetrics::SelectorSnapshot &snapshot :
+       primitives::CallMetrics::Snapshot(/*exit_calls=*/true)) {
+    out << "exit " << snapshot.selector << " " << snapshot.count << " "
+        << snapshot.total_nanos << "\n";
+  }
+}
+
+}  // namespace
+
 StatusOr<int> ApplicationWrapperDriverMain(const EnclaveLoader &loader,
                                            const std::string &enclave_name,
                                            int argc, char *argv[]) {
+  // When ASYLO_EXIT_STATS_FILE is set in the environment, record
+  // per-selector exit statistics for the application's lifetime and write
+  // them to the named file after the enclave is destroyed. The environment is
+  // used rather than a flag so the wrapped application's own command line is
+  // not disturbed.
+  const char *exit_stats_file = std::getenv("ASYLO_EXIT_STATS_FILE");
+  if (exit_stats_file != nullptr) {
+    primitives::CallMetrics::SetEnabled(true);
+  }
+
   // Retrieve the EnclaveManager instance.
   EnclaveManager *manager;
   ASYLO_ASSIGN_OR_RETURN(manager, EnclaveManager::Instance());
@@ -70,6 +106,11 @@ StatusOr<int> ApplicationWrapperDriverMain(const EnclaveLoader &loader,
   destroy_enclave.release();
   ASYLO_RETURN_IF_ERROR(manager->DestroyEnclave(client, EnclaveFinal()));
 
+  // Dump after destruction so exits made during finalization are included.
+  if (exit_stats_file != nullptr) {
+    DumpExitStats(exit_stats_file);
+  }
+
   return main_return;
 }
 
@@ -3,14 +3,32 @@
 load("@linux_sgx//:sgx_sdk.bzl", "sgx")
 load("//asylo/bazel:asylo.bzl", "cc_unsigned_enclave", "debug_sign_enclave", "enclave_test")
 
-def sgx_cc_unsigned_enclave(name, **kwargs):
+def sgx_cc_unsigned_enclave(name, function_ordering_file = None, **kwargs):
     """Shorthand for cc_unsigned_enclave with only SGX backends.
 
     Args:
         name: The name of the rule.
+        function_ordering_file: Optional label of a hot-first symbol ordering
+            file generated from in-enclave sampling profiler output (see
+            //asylo/platform/primitives/util:function_ordering). When set, the
+            enclave is compiled with -ffunction-sections and linked with the
+            ordering so hot functions land on a compact set of pages, reducing
+            the enclave's resident EPC footprint. Requires a linker that
+            supports --symbol-ordering-file (LLD).
         **kwargs: The arguments to cc_unsigned_enclave (may not include
             "backends").
     """
+    if function_ordering_file:
+        kwargs["copts"] = kwargs.get("copts", []) + ["-ffunction-sections"]
+        kwargs["linkopts"] = kwargs.get("linkopts", []) + [
+            "-Wl,--symbol-ordering-file=$(location {})".format(
+                function_ordering_file,
+            ),
+        ]
+        kwargs["additional_linker_inputs"] = kwargs.get(
+            "additional_linker_inputs",
+            [],
+        ) + [function_ordering_file]
     cc_unsigned_enclave(name, backends = sgx.backend_labels, **kwargs)
 
 def sgx_debug_sign_enclave(name, **kwargs):
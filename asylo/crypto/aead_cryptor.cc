@@ -17,12 +17,17 @@
  */
 #include "asylo/crypto/aead_cryptor.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <utility>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "asylo/crypto/aead_key_pool.h"
+#include "asylo/crypto/counter_nonce_generator.h"
 #include "asylo/crypto/random_nonce_generator.h"
 #include "asylo/util/status_macros.h"
 
@@ -39,6 +44,27 @@ constexpr size_t kAesGcmMaxMessageSize = static_cast<size_t>(1) << 25;
 constexpr uint64_t kAesGcmSivMaxSealedMessages = UINT64_C(1) << 48;
 constexpr size_t kAesGcmSivMaxMessageSize = static_cast<size_t>(1) << 25;
 
+// The number of trailing nonce bytes carrying the streaming segment counter.
+constexpr size_t kSegmentCounterBytes = 4;
+
+// Derives the nonce of streaming segment |segment| from |base_nonce| into
+// |derived_nonce| by XORing the big-endian segment counter into the trailing
+// nonce bytes and, for the final segment, flipping the top bit of the leading
+// byte. Segment nonces of one payload are therefore pairwise distinct, and a
+// final segment can never authenticate as a non-final one.
+void DeriveSegmentNonce(const std::vector<uint8_t> &base_nonce,
+                        uint32_t segment, bool final_segment,
+                        std::vector<uint8_t> *derived_nonce) {
+  *derived_nonce = base_nonce;
+  const size_t size = derived_nonce->size();
+  for (size_t byte = 0; byte < kSegmentCounterBytes; byte++) {
+    (*derived_nonce)[size - 1 - byte] ^= (segment >> (8 * byte)) & 0xff;
+  }
+  if (final_segment) {
+    (*derived_nonce)[0] ^= 0x80;
+  }
+}
+
 }  // namespace
 
 StatusOr<std::unique_ptr<AeadCryptor>> AeadCryptor::CreateAesGcmCryptor(
@@ -60,6 +86,39 @@ StatusOr<std::unique_ptr<AeadCryptor>> AeadCryptor::CreateAesGcmSivCryptor(
                       RandomNonceGenerator::CreateAesGcmNonceGenerator()));
 }
 
+StatusOr<std::unique_ptr<AeadCryptor>>
+AeadCryptor::CreateAesGcmCryptorWithCounterNonces(ByteContainerView key) {
+  std::unique_ptr<AeadKey> aead_key;
+  ASYLO_ASSIGN_OR_RETURN(aead_key, AeadKey::CreateAesGcmKey(key));
+  std::unique_ptr<CounterNonceGenerator> nonce_generator;
+  ASYLO_ASSIGN_OR_RETURN(nonce_generator,
+                         CounterNonceGenerator::CreateAesGcmNonceGenerator());
+  return absl::WrapUnique<AeadCryptor>(new AeadCryptor(
+      std::move(aead_key), kAesGcmMaxMessageSize, kAesGcmMaxSealedMessages,
+      std::move(nonce_generator)));
+}
+
+StatusOr<std::unique_ptr<AeadCryptor>>
+AeadCryptor::CreateAesGcmCryptorWithPooledKey(ByteContainerView key) {
+  std::shared_ptr<AeadKey> aead_key;
+  ASYLO_ASSIGN_OR_RETURN(aead_key,
+                         AeadKeyPool::GetInstance()->GetAesGcmKey(key));
+  return absl::WrapUnique<AeadCryptor>(new AeadCryptor(
+      std::move(aead_key), kAesGcmMaxMessageSize, kAesGcmMaxSealedMessages,
+      RandomNonceGenerator::CreateAesGcmNonceGenerator()));
+}
+
+StatusOr<std::unique_ptr<AeadCryptor>>
+AeadCryptor::CreateAesGcmSivCryptorWithPooledKey(ByteContainerView key) {
+  std::shared_ptr<AeadKey> aead_key;
+  ASYLO_ASSIGN_OR_RETURN(aead_key,
+                         AeadKeyPool::GetInstance()->GetAesGcmSivKey(key));
+  return absl::WrapUnique<AeadCryptor>(
+      new AeadCryptor(std::move(aead_key), kAesGcmSivMaxMessageSize,
+                      kAesGcmSivMaxSealedMessages,
+                      RandomNonceGenerator::CreateAesGcmNonceGenerator()));
+}
+
 StatusOr<size_t> AeadCryptor::MaxMessageSize(AeadScheme scheme) {
   switch (scheme) {
     case AES128_GCM:
@@ -127,8 +186,159 @@ Status AeadCryptor::Open(ByteContainerView ciphertext,
                     plaintext_size);
 }
 
+StatusOr<std::unique_ptr<AeadCryptor::SealContext>>
+AeadCryptor::CreateSealContext(ByteContainerView associated_data,
+                               absl::Span<uint8_t> nonce) {
+  std::unique_ptr<SealContext> context(new SealContext(this));
+  ASYLO_RETURN_IF_ERROR(context->Reset(associated_data, nonce));
+  return std::move(context);
+}
+
+StatusOr<std::unique_ptr<AeadCryptor::OpenContext>>
+AeadCryptor::CreateOpenContext(ByteContainerView associated_data,
+                               ByteContainerView nonce) {
+  std::unique_ptr<OpenContext> context(new OpenContext(this));
+  ASYLO_RETURN_IF_ERROR(context->Reset(associated_data, nonce));
+  return std::move(context);
+}
+
+AeadCryptor::SealContext::SealContext(AeadCryptor *cryptor)
+    : cryptor_(cryptor), next_segment_(0), finalized_(false) {}
+
+Status AeadCryptor::SealContext::Update(ByteContainerView plaintext,
+                                        absl::Span<uint8_t> ciphertext,
+                                        size_t *ciphertext_size) {
+  return SealSegment(plaintext, /*final_segment=*/false, ciphertext,
+                     ciphertext_size);
+}
+
+Status AeadCryptor::SealContext::Finalize(ByteContainerView plaintext,
+                                          absl::Span<uint8_t> ciphertext,
+                                          size_t *ciphertext_size) {
+  ASYLO_RETURN_IF_ERROR(
+      SealSegment(plaintext, /*final_segment=*/true, ciphertext,
+                  ciphertext_size));
+  finalized_ = true;
+  return Status::OkStatus();
+}
+
+Status AeadCryptor::SealContext::Reset(ByteContainerView associated_data,
+                                       absl::Span<uint8_t> nonce) {
+  const size_t nonce_size = cryptor_->NonceSize();
+  if (nonce_size <= kSegmentCounterBytes) {
+    return Status(absl::StatusCode::kInternal,
+                  absl::StrCat("Nonce size ", nonce_size,
+                               " is too small for segment derivation"));
+  }
+  if (nonce.size() < nonce_size) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrCat("Invalid nonce length: ", nonce.size(),
+                               " (must be at least ", nonce_size, " bytes)"));
+  }
+  associated_data_.assign(associated_data.begin(), associated_data.end());
+  base_nonce_.resize(nonce_size);
+  ASYLO_RETURN_IF_ERROR(
+      cryptor_->nonce_generator_->NextNonce(absl::MakeSpan(base_nonce_)));
+  std::copy(base_nonce_.begin(), base_nonce_.end(), nonce.begin());
+  next_segment_ = 0;
+  finalized_ = false;
+  return Status::OkStatus();
+}
+
+Status AeadCryptor::SealContext::SealSegment(ByteContainerView plaintext,
+                                             bool final_segment,
+                                             absl::Span<uint8_t> ciphertext,
+                                             size_t *ciphertext_size) {
+  if (finalized_) {
+    return Status(absl::StatusCode::kFailedPrecondition,
+                  "Seal context has been finalized and must be Reset()");
+  }
+  if (plaintext.size() > cryptor_->max_message_size_) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrCat("Segment size ", plaintext.size(),
+                               " exceeds maximum message size (",
+                               cryptor_->max_message_size_, " bytes)"));
+  }
+  if (next_segment_ == UINT32_MAX) {
+    return Status(absl::StatusCode::kFailedPrecondition,
+                  "Reached maximum number of segments per payload");
+  }
+  if (cryptor_->number_of_sealed_messages_ >=
+      cryptor_->max_sealed_messages_) {
+    return Status(
+        absl::StatusCode::kFailedPrecondition,
+        absl::StrCat("Reached maximum number of sealed messages (",
+                     cryptor_->max_sealed_messages_, ")"));
+  }
+  DeriveSegmentNonce(base_nonce_, next_segment_, final_segment,
+                     &derived_nonce_);
+  ASYLO_RETURN_IF_ERROR(cryptor_->key_->Seal(plaintext, associated_data_,
+                                             derived_nonce_, ciphertext,
+                                             ciphertext_size));
+  cryptor_->number_of_sealed_messages_++;
+  next_segment_++;
+  return Status::OkStatus();
+}
+
+AeadCryptor::OpenContext::OpenContext(AeadCryptor *cryptor)
+    : cryptor_(cryptor), next_segment_(0), finalized_(false) {}
+
+Status AeadCryptor::OpenContext::Update(ByteContainerView ciphertext,
+                                        absl::Span<uint8_t> plaintext,
+                                        size_t *plaintext_size) {
+  return OpenSegment(ciphertext, /*final_segment=*/false, plaintext,
+                     plaintext_size);
+}
+
+Status AeadCryptor::OpenContext::Finalize(ByteContainerView ciphertext,
+                                          absl::Span<uint8_t> plaintext,
+                                          size_t *plaintext_size) {
+  ASYLO_RETURN_IF_ERROR(
+      OpenSegment(ciphertext, /*final_segment=*/true, plaintext,
+                  plaintext_size));
+  finalized_ = true;
+  return Status::OkStatus();
+}
+
+Status AeadCryptor::OpenContext::Reset(ByteContainerView associated_data,
+                                       ByteContainerView nonce) {
+  if (nonce.size() != cryptor_->NonceSize() ||
+      nonce.size() <= kSegmentCounterBytes) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrCat("Invalid nonce length: ", nonce.size(),
+                               " (must be ", cryptor_->NonceSize(),
+                               " bytes)"));
+  }
+  associated_data_.assign(associated_data.begin(), associated_data.end());
+  base_nonce_.assign(nonce.begin(), nonce.end());
+  next_segment_ = 0;
+  finalized_ = false;
+  return Status::OkStatus();
+}
+
+Status AeadCryptor::OpenContext::OpenSegment(ByteContainerView ciphertext,
+                                             bool final_segment,
+                                             absl::Span<uint8_t> plaintext,
+                                             size_t *plaintext_size) {
+  if (finalized_) {
+    return Status(absl::StatusCode::kFailedPrecondition,
+                  "Open context has been finalized and must be Reset()");
+  }
+  if (next_segment_ == UINT32_MAX) {
+    return Status(absl::StatusCode::kFailedPrecondition,
+                  "Reached maximum number of segments per payload");
+  }
+  DeriveSegmentNonce(base_nonce_, next_segment_, final_segment,
+                     &derived_nonce_);
+  ASYLO_RETURN_IF_ERROR(cryptor_->key_->Open(ciphertext, associated_data_,
+                                             derived_nonce_, plaintext,
+                                             plaintext_size));
+  next_segment_++;
+  return Status::OkStatus();
+}
+
 AeadCryptor::AeadCryptor(
-    std::unique_ptr<AeadKey> key, size_t max_message_size,
+    std::shared_ptr<AeadKey> key, size_t max_message_size,
     uint64_t max_sealed_messages,
     std::unique_ptr<NonceGeneratorInterface> nonce_generator)
     : key_(std::move(key)),
@@ -21,6 +21,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/types/span.h"
 #include "asylo/crypto/aead_key.h"
@@ -56,6 +57,40 @@ class AeadCryptor {
   static StatusOr<std::unique_ptr<AeadCryptor>> CreateAesGcmSivCryptor(
       ByteContainerView key);
 
+  /// As CreateAesGcmCryptor(), but generates nonces with the deterministic
+  /// counter construction of NIST SP 800-38D (a random fixed field plus an
+  /// invocation counter) instead of the system RNG. Nonce generation becomes
+  /// a copy and an increment, for callers that Seal() at rates where per-nonce
+  /// RNG draws are measurable. Each cryptor created this way draws an
+  /// independent 32-bit fixed field, so do not share one `key` across many
+  /// such cryptors; see CounterNonceGenerator.
+  ///
+  /// \param key The underlying key used for encryption and decryption.
+  /// \return A pointer to the created cryptor, or a non-OK Status if creation
+  ///         failed.
+  static StatusOr<std::unique_ptr<AeadCryptor>>
+  CreateAesGcmCryptorWithCounterNonces(ByteContainerView key);
+
+  /// As CreateAesGcmCryptor(), but fetches the underlying AeadKey from the
+  /// process-wide AeadKeyPool so that repeated cryptor creation with the same
+  /// key material reuses the expanded AES key schedule.
+  ///
+  /// \param key The underlying key used for encryption and decryption.
+  /// \return A pointer to the created cryptor, or a non-OK Status if creation
+  ///         failed.
+  static StatusOr<std::unique_ptr<AeadCryptor>> CreateAesGcmCryptorWithPooledKey(
+      ByteContainerView key);
+
+  /// As CreateAesGcmSivCryptor(), but fetches the underlying AeadKey from the
+  /// process-wide AeadKeyPool so that repeated cryptor creation with the same
+  /// key material reuses the expanded AES key schedule.
+  ///
+  /// \param key The underlying key used for encryption and decryption.
+  /// \return A pointer to the created cryptor, or a non-OK Status if creation
+  ///         failed.
+  static StatusOr<std::unique_ptr<AeadCryptor>>
+  CreateAesGcmSivCryptorWithPooledKey(ByteContainerView key);
+
   /// Gets the maximum size of a message that may be sealed successfully with a
   /// cryptor that uses `scheme`.
   ///
@@ -131,13 +166,177 @@ class AeadCryptor {
               ByteContainerView nonce, absl::Span<uint8_t> plaintext,
               size_t *plaintext_size);
 
+  /// A reusable streaming Seal() context created by CreateSealContext().
+  ///
+  /// A payload is sealed in caller-sized segments: each call to Update()
+  /// seals one segment directly into a caller-provided output span, and
+  /// Finalize() seals the last segment - which may be empty - with a
+  /// final-segment marker so that truncation or reordering of the segment
+  /// sequence is detected by OpenContext. Segment nonces are derived from the
+  /// payload's base nonce and a segment counter, and the context holds no
+  /// per-segment state, so arbitrarily large payloads can be sealed in
+  /// cache-sized chunks without intermediate buffers. Each segment counts as
+  /// one sealed message toward MaxSealedMessages().
+  class SealContext {
+   public:
+    /// Seals one non-final segment of the payload.
+    ///
+    /// `plaintext.size()` must be less than or equal to the cryptor's
+    /// MaxMessageSize(). `ciphertext.size()` must be greater than or equal to
+    /// `plaintext.size()` + MaxSealOverhead(). `ciphertext` is not resized,
+    /// but its final size is returned through `ciphertext_size`.
+    ///
+    /// \param plaintext The segment that will be sealed.
+    /// \param[out] ciphertext The sealed ciphertext of `plaintext`.
+    /// \param[out] ciphertext_size The size of `ciphertext`.
+    /// \return The resulting status of the Seal() operation.
+    Status Update(ByteContainerView plaintext, absl::Span<uint8_t> ciphertext,
+                  size_t *ciphertext_size);
+
+    /// Seals the final segment of the payload, which may be empty. After
+    /// Finalize() succeeds the context must be Reset() before further use.
+    ///
+    /// \param plaintext The final segment that will be sealed.
+    /// \param[out] ciphertext The sealed ciphertext of `plaintext`.
+    /// \param[out] ciphertext_size The size of `ciphertext`.
+    /// \return The resulting status of the Seal() operation.
+    Status Finalize(ByteContainerView plaintext, absl::Span<uint8_t> ciphertext,
+                    size_t *ciphertext_size);
+
+    /// Rearms the context for a new payload with a freshly generated base
+    /// nonce, returned through `nonce`, and new `associated_data`.
+    ///
+    /// \param associated_data The authenticated data for the new payload.
+    /// \param[out] nonce The generated base nonce of the new payload.
+    /// \return The resulting status of the Reset() operation.
+    Status Reset(ByteContainerView associated_data, absl::Span<uint8_t> nonce);
+
+   private:
+    friend class AeadCryptor;
+
+    explicit SealContext(AeadCryptor *cryptor);
+
+    // Seals one segment with the nonce derived from the segment counter and
+    // |final_segment|.
+    Status SealSegment(ByteContainerView plaintext, bool final_segment,
+                       absl::Span<uint8_t> ciphertext, size_t *ciphertext_size);
+
+    // The cryptor that created this context. Not owned.
+    AeadCryptor *const cryptor_;
+
+    // The authenticated data of the current payload.
+    std::vector<uint8_t> associated_data_;
+
+    // The base nonce of the current payload.
+    std::vector<uint8_t> base_nonce_;
+
+    // Preallocated scratch space for the derived per-segment nonces.
+    std::vector<uint8_t> derived_nonce_;
+
+    // The counter of the next segment to seal.
+    uint32_t next_segment_;
+
+    // Whether the final segment of the current payload has been sealed.
+    bool finalized_;
+  };
+
+  /// A reusable streaming Open() context created by CreateOpenContext(). The
+  /// counterpart of SealContext: segments must be presented to Update() and
+  /// Finalize() whole and in the order in which they were sealed.
+  class OpenContext {
+   public:
+    /// Opens one non-final segment of the payload. `plaintext` is not
+    /// resized, but its final size is returned through `plaintext_size`; to
+    /// ascertain that `plaintext` is large enough, `plaintext.size()` should
+    /// be greater than or equal to `ciphertext.size()`.
+    ///
+    /// \param ciphertext The sealed segment.
+    /// \param[out] plaintext The unsealed segment.
+    /// \param[out] plaintext_size The size of `plaintext`.
+    /// \return The resulting status of the Open() operation, or a non-OK
+    ///         Status if the segment fails authentication.
+    Status Update(ByteContainerView ciphertext, absl::Span<uint8_t> plaintext,
+                  size_t *plaintext_size);
+
+    /// Opens the final segment of the payload. A non-OK Status indicates that
+    /// the segment is not the authentic final segment - e.g. the sequence was
+    /// truncated. After Finalize() succeeds the context must be Reset()
+    /// before further use.
+    ///
+    /// \param ciphertext The sealed final segment.
+    /// \param[out] plaintext The unsealed segment.
+    /// \param[out] plaintext_size The size of `plaintext`.
+    /// \return The resulting status of the Open() operation.
+    Status Finalize(ByteContainerView ciphertext, absl::Span<uint8_t> plaintext,
+                    size_t *plaintext_size);
+
+    /// Rearms the context for a new payload sealed with base `nonce` and
+    /// `associated_data`.
+    ///
+    /// \param associated_data The authenticated data of the payload.
+    /// \param nonce The base nonce the payload was sealed with.
+    /// \return The resulting status of the Reset() operation.
+    Status Reset(ByteContainerView associated_data, ByteContainerView nonce);
+
+   private:
+    friend class AeadCryptor;
+
+    explicit OpenContext(AeadCryptor *cryptor);
+
+    // Opens one segment with the nonce derived from the segment counter and
+    // |final_segment|.
+    Status OpenSegment(ByteContainerView ciphertext, bool final_segment,
+                       absl::Span<uint8_t> plaintext, size_t *plaintext_size);
+
+    // The cryptor that created this context. Not owned.
+    AeadCryptor *const cryptor_;
+
+    // The authenticated data of the current payload.
+    std::vector<uint8_t> associated_data_;
+
+    // The base nonce of the current payload.
+    std::vector<uint8_t> base_nonce_;
+
+    // Preallocated scratch space for the derived per-segment nonces.
+    std::vector<uint8_t> derived_nonce_;
+
+    // The counter of the next segment to open.
+    uint32_t next_segment_;
+
+    // Whether the final segment of the current payload has been opened.
+    bool finalized_;
+  };
+
+  /// Creates a streaming Seal() context bound to this cryptor. The context
+  /// must not outlive the cryptor.
+  ///
+  /// \param associated_data The authenticated data for the first payload.
+  /// \param[out] nonce The generated base nonce of the first payload.
+  ///             `nonce.size()` must be greater than or equal to NonceSize().
+  /// \return A pointer to the created context, or a non-OK Status if creation
+  ///         failed.
+  StatusOr<std::unique_ptr<SealContext>> CreateSealContext(
+      ByteContainerView associated_data, absl::Span<uint8_t> nonce);
+
+  /// Creates a streaming Open() context bound to this cryptor. The context
+  /// must not outlive the cryptor.
+  ///
+  /// \param associated_data The authenticated data of the payload.
+  /// \param nonce The base nonce the payload was sealed with.
+  /// \return A pointer to the created context, or a non-OK Status if creation
+  ///         failed.
+  StatusOr<std::unique_ptr<OpenContext>> CreateOpenContext(
+      ByteContainerView associated_data, ByteContainerView nonce);
+
  private:
-  AeadCryptor(std::unique_ptr<AeadKey> key, size_t max_message_size,
+  AeadCryptor(std::shared_ptr<AeadKey> key, size_t max_message_size,
               uint64_t max_sealed_messages,
               std::unique_ptr<NonceGeneratorInterface> nonce_generator);
 
-  // The AeadKey used for Seal() and Open().
-  const std::unique_ptr<AeadKey> key_;
+  // The AeadKey used for Seal() and Open(). Held through a shared_ptr so that
+  // the key may be interned in an AeadKeyPool; exclusively-owned keys convert
+  // implicitly.
+  const std::shared_ptr<AeadKey> key_;
 
   // The maximum size of a message passed in for Seal().
   const size_t max_message_size_;
@@ -17,6 +17,9 @@
  */
 #include "asylo/crypto/aead_cryptor.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -77,6 +80,7 @@ const char kAesGcmSivNonceHex256[] = "030000000000000000000000";
 const char kAesGcmSivCiphertextHex256[] = "c91545823cc24f17dbb0e9e807d5ec17";
 const char kAesGcmSivTagHex256[] = "b292d28ff61189e8e49f3875ef91aff7";
 
+using ::testing::Not;
 using ::testing::TestWithParam;
 
 struct AeadCryptorParam {
@@ -128,6 +132,162 @@ TEST_P(AeadCryptorTest, OpenTest) {
             ByteContainerView(actual_plaintext));
 }
 
+TEST_P(AeadCryptorTest, StreamingSealOpenEndToEndTest) {
+  AeadTestVector test_vector = GetParam().test_vector;
+  std::unique_ptr<AeadCryptor> cryptor;
+  ASYLO_ASSERT_OK_AND_ASSIGN(cryptor, GetParam().factory(test_vector.key));
+
+  // A payload larger than the segment size, with a partial final segment.
+  constexpr size_t kSegmentSize = 96;
+  std::vector<uint8_t> payload(5 * kSegmentSize + 17);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(i);
+  }
+
+  std::vector<uint8_t> nonce(cryptor->NonceSize());
+  std::unique_ptr<AeadCryptor::SealContext> seal_context;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      seal_context,
+      cryptor->CreateSealContext(test_vector.aad, absl::MakeSpan(nonce)));
+
+  // Seal the payload in segments into per-segment output spans.
+  std::vector<std::vector<uint8_t>> sealed_segments;
+  for (size_t offset = 0; offset < payload.size(); offset += kSegmentSize) {
+    const size_t segment_size =
+        std::min(kSegmentSize, payload.size() - offset);
+    const bool final_segment = offset + segment_size == payload.size();
+    std::vector<uint8_t> sealed(segment_size + cryptor->MaxSealOverhead());
+    size_t sealed_size;
+    ByteContainerView segment(payload.data() + offset, segment_size);
+    if (final_segment) {
+      ASYLO_ASSERT_OK(seal_context->Finalize(segment, absl::MakeSpan(sealed),
+                                             &sealed_size));
+    } else {
+      ASYLO_ASSERT_OK(seal_context->Update(segment, absl::MakeSpan(sealed),
+                                           &sealed_size));
+    }
+    sealed.resize(sealed_size);
+    sealed_segments.push_back(std::move(sealed));
+  }
+
+  // A finalized context must be Reset() before further use.
+  std::vector<uint8_t> scratch(kSegmentSize + cryptor->MaxSealOverhead());
+  size_t scratch_size;
+  EXPECT_THAT(seal_context->Update(ByteContainerView(payload.data(), 1),
+                                   absl::MakeSpan(scratch), &scratch_size),
+              Not(IsOk()));
+
+  // Open the segments in order and reassemble the payload.
+  std::unique_ptr<AeadCryptor::OpenContext> open_context;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      open_context, cryptor->CreateOpenContext(test_vector.aad, nonce));
+  CleansingVector<uint8_t> actual_payload;
+  for (size_t segment = 0; segment < sealed_segments.size(); ++segment) {
+    const bool final_segment = segment == sealed_segments.size() - 1;
+    CleansingVector<uint8_t> opened(sealed_segments[segment].size());
+    size_t opened_size;
+    if (final_segment) {
+      ASYLO_ASSERT_OK(open_context->Finalize(sealed_segments[segment],
+                                             absl::MakeSpan(opened),
+                                             &opened_size));
+    } else {
+      ASYLO_ASSERT_OK(open_context->Update(sealed_segments[segment],
+                                           absl::MakeSpan(opened),
+                                           &opened_size));
+    }
+    actual_payload.insert(actual_payload.end(), opened.begin(),
+                          opened.begin() + opened_size);
+  }
+  EXPECT_EQ(ByteContainerView(payload), ByteContainerView(actual_payload));
+}
+
+TEST_P(AeadCryptorTest, StreamingOpenRejectsReorderingAndTruncationTest) {
+  AeadTestVector test_vector = GetParam().test_vector;
+  std::unique_ptr<AeadCryptor> cryptor;
+  ASYLO_ASSERT_OK_AND_ASSIGN(cryptor, GetParam().factory(test_vector.key));
+
+  constexpr size_t kSegmentSize = 64;
+  std::vector<uint8_t> payload(3 * kSegmentSize, 0xa5);
+
+  std::vector<uint8_t> nonce(cryptor->NonceSize());
+  std::unique_ptr<AeadCryptor::SealContext> seal_context;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      seal_context,
+      cryptor->CreateSealContext(test_vector.aad, absl::MakeSpan(nonce)));
+
+  std::vector<std::vector<uint8_t>> sealed_segments;
+  for (size_t segment = 0; segment < 3; ++segment) {
+    std::vector<uint8_t> sealed(kSegmentSize + cryptor->MaxSealOverhead());
+    size_t sealed_size;
+    ByteContainerView view(payload.data() + segment * kSegmentSize,
+                           kSegmentSize);
+    if (segment == 2) {
+      ASYLO_ASSERT_OK(
+          seal_context->Finalize(view, absl::MakeSpan(sealed), &sealed_size));
+    } else {
+      ASYLO_ASSERT_OK(
+          seal_context->Update(view, absl::MakeSpan(sealed), &sealed_size));
+    }
+    sealed.resize(sealed_size);
+    sealed_segments.push_back(std::move(sealed));
+  }
+
+  CleansingVector<uint8_t> opened(kSegmentSize + cryptor->MaxSealOverhead());
+  size_t opened_size;
+
+  // Segments presented out of order fail authentication.
+  std::unique_ptr<AeadCryptor::OpenContext> open_context;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      open_context, cryptor->CreateOpenContext(test_vector.aad, nonce));
+  EXPECT_THAT(open_context->Update(sealed_segments[1], absl::MakeSpan(opened),
+                                   &opened_size),
+              Not(IsOk()));
+
+  // A truncated sequence fails authentication: a non-final segment does not
+  // verify as the final one.
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      open_context, cryptor->CreateOpenContext(test_vector.aad, nonce));
+  EXPECT_THAT(open_context->Finalize(sealed_segments[0],
+                                     absl::MakeSpan(opened), &opened_size),
+              Not(IsOk()));
+}
+
+TEST_P(AeadCryptorTest, StreamingSealContextResetTest) {
+  AeadTestVector test_vector = GetParam().test_vector;
+  std::unique_ptr<AeadCryptor> cryptor;
+  ASYLO_ASSERT_OK_AND_ASSIGN(cryptor, GetParam().factory(test_vector.key));
+
+  std::vector<uint8_t> payload(128, 0x3c);
+  std::vector<uint8_t> nonce(cryptor->NonceSize());
+  std::unique_ptr<AeadCryptor::SealContext> seal_context;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      seal_context,
+      cryptor->CreateSealContext(test_vector.aad, absl::MakeSpan(nonce)));
+
+  // Seal two payloads through the same context, separated by Reset().
+  for (int payload_index = 0; payload_index < 2; ++payload_index) {
+    if (payload_index > 0) {
+      ASYLO_ASSERT_OK(
+          seal_context->Reset(test_vector.aad, absl::MakeSpan(nonce)));
+    }
+    std::vector<uint8_t> sealed(payload.size() + cryptor->MaxSealOverhead());
+    size_t sealed_size;
+    ASYLO_ASSERT_OK(seal_context->Finalize(payload, absl::MakeSpan(sealed),
+                                           &sealed_size));
+    sealed.resize(sealed_size);
+
+    std::unique_ptr<AeadCryptor::OpenContext> open_context;
+    ASYLO_ASSERT_OK_AND_ASSIGN(
+        open_context, cryptor->CreateOpenContext(test_vector.aad, nonce));
+    CleansingVector<uint8_t> opened(sealed.size());
+    size_t opened_size;
+    ASYLO_ASSERT_OK(
+        open_context->Finalize(sealed, absl::MakeSpan(opened), &opened_size));
+    opened.resize(opened_size);
+    EXPECT_EQ(ByteContainerView(payload), ByteContainerView(opened));
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     AllTests, AeadCryptorTest,
     ::testing::Values(
@@ -21,13 +21,12 @@
 #include <openssl/aead.h>
 
 #include <memory>
+#include <utility>
 
-#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "asylo/crypto/algorithms.pb.h"
 #include "asylo/crypto/util/bssl_util.h"
-#include "asylo/util/cleanup.h"
 #include "asylo/util/status_macros.h"
 
 namespace asylo {
@@ -83,7 +82,10 @@ StatusOr<std::unique_ptr<AeadKey>> AeadKey::CreateAesGcmKey(
                   absl::StrCat("Invalid AES-GCM key length: ", key.size(),
                                " (must be 16 or 32 bytes)"));
   }
-  return absl::WrapUnique<AeadKey>(new AeadKey(scheme, key));
+  std::unique_ptr<AeadKey> aead_key(new AeadKey(scheme, key));
+  ASYLO_RETURN_IF_ERROR(aead_key->InitContext());
+  // GCC 4.9 requires this std::move() here.
+  return std::move(aead_key);
 }
 
 StatusOr<std::unique_ptr<AeadKey>> AeadKey::CreateAesGcmSivKey(
@@ -94,9 +96,14 @@ StatusOr<std::unique_ptr<AeadKey>> AeadKey::CreateAesGcmSivKey(
                   absl::StrCat("Invalid AES-GCM-SIV key length: ", key.size(),
                                " (must be 16 or 32 bytes)"));
   }
-  return absl::WrapUnique<AeadKey>(new AeadKey(scheme, key));
+  std::unique_ptr<AeadKey> aead_key(new AeadKey(scheme, key));
+  ASYLO_RETURN_IF_ERROR(aead_key->InitContext());
+  // GCC 4.9 requires this std::move() here.
+  return std::move(aead_key);
 }
 
+AeadKey::~AeadKey() { EVP_AEAD_CTX_cleanup(&context_); }
+
 AeadScheme AeadKey::GetAeadScheme() const { return aead_scheme_; }
 
 size_t AeadKey::NonceSize() const { return nonce_size_; }
@@ -112,18 +119,7 @@ Status AeadKey::Seal(ByteContainerView plaintext,
                                " (must be ", nonce_size_, " bytes)"));
   }
 
-  EVP_AEAD_CTX context;
-  Cleanup cleanup_context([&context]() { EVP_AEAD_CTX_cleanup(&context); });
-
-  if (EVP_AEAD_CTX_init(&context, aead_, key_.data(), key_.size(),
-                        EVP_AEAD_max_tag_len(aead_),
-                        /*impl=*/nullptr) != 1) {
-    return Status(
-        absl::StatusCode::kInternal,
-        absl::StrCat("EVP_AEAD_CTX_init failed: ", BsslLastErrorString()));
-  }
-
-  if (EVP_AEAD_CTX_seal(&context, ciphertext.data(), ciphertext_size,
+  if (EVP_AEAD_CTX_seal(&context_, ciphertext.data(), ciphertext_size,
                         ciphertext.size(), nonce.data(), nonce.size(),
                         plaintext.data(), plaintext.size(),
                         associated_data.data(), associated_data.size()) != 1) {
@@ -144,17 +140,7 @@ Status AeadKey::Open(ByteContainerView ciphertext,
                                " (must be ", nonce_size_, " bytes)"));
   }
 
-  EVP_AEAD_CTX context;
-  Cleanup cleanup_context([&context]() { EVP_AEAD_CTX_cleanup(&context); });
-  if (EVP_AEAD_CTX_init(&context, aead_, key_.data(), key_.size(),
-                        EVP_AEAD_max_tag_len(aead_),
-                        /*impl=*/nullptr) != 1) {
-    return Status(
-        absl::StatusCode::kInternal,
-        absl::StrCat("EVP_AEAD_CTX_init failed: ", BsslLastErrorString()));
-  }
-
-  if (EVP_AEAD_CTX_open(&context, plaintext.data(), plaintext_size,
+  if (EVP_AEAD_CTX_open(&context_, plaintext.data(), plaintext_size,
                         plaintext.size(), nonce.data(), nonce.size(),
                         ciphertext.data(), ciphertext.size(),
                         associated_data.data(), associated_data.size()) != 1) {
@@ -171,6 +157,23 @@ AeadKey::AeadKey(AeadScheme aead_scheme, ByteContainerView key)
       aead_scheme_(aead_scheme),
       key_(key.cbegin(), key.cend()),
       max_seal_overhead_(EVP_AEAD_max_overhead(aead_)),
-      nonce_size_(EVP_AEAD_nonce_length(aead_)) {}
+      nonce_size_(EVP_AEAD_nonce_length(aead_)) {
+  // Leave context_ in a state that is safe to clean up even if InitContext()
+  // is never called or fails.
+  EVP_AEAD_CTX_zero(&context_);
+}
+
+Status AeadKey::InitContext() {
+  // Initializing the context here - rather than per Seal()/Open() call -
+  // expands the AES key schedule exactly once per key.
+  if (EVP_AEAD_CTX_init(&context_, aead_, key_.data(), key_.size(),
+                        EVP_AEAD_max_tag_len(aead_),
+                        /*impl=*/nullptr) != 1) {
+    return Status(
+        absl::StatusCode::kInternal,
+        absl::StrCat("EVP_AEAD_CTX_init failed: ", BsslLastErrorString()));
+  }
+  return Status::OkStatus();
+}
 
 }  // namespace asylo
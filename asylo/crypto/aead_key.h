@@ -33,6 +33,9 @@
 namespace asylo {
 
 // Key used for AEAD (Authenticated Encryption with Associated Data) operations.
+//
+// The underlying AEAD context - including the expanded AES key schedule - is
+// initialized once at creation and reused across Seal() and Open() calls.
 class AeadKey {
  public:
   // Creates an instance of AeadKey using |key| with AES-GCM. |key| must be
@@ -47,6 +50,11 @@ class AeadKey {
   static StatusOr<std::unique_ptr<AeadKey>> CreateAesGcmSivKey(
       ByteContainerView key);
 
+  AeadKey(const AeadKey &) = delete;
+  AeadKey &operator=(const AeadKey &) = delete;
+
+  ~AeadKey();
+
   // Gets the AEAD scheme used by this AeadKey.
   AeadScheme GetAeadScheme() const;
 
@@ -75,9 +83,19 @@ class AeadKey {
  private:
   AeadKey(AeadScheme scheme, ByteContainerView key);
 
+  // Initializes context_ with the key material. Called exactly once, by the
+  // factory methods. Kept out of the constructor so that initialization
+  // failures can be reported through a Status.
+  Status InitContext();
+
   // The object that encapsulates the AEAD algorithm.
   const EVP_AEAD *const aead_;
 
+  // The AEAD context holding the expanded key schedule. Initialized once by
+  // InitContext(). BoringSSL permits concurrent EVP_AEAD_CTX_seal() and
+  // EVP_AEAD_CTX_open() calls on an initialized context.
+  EVP_AEAD_CTX context_;
+
   // The Asylo enum representation of the AEAD algorithm used by this object.
   const AeadScheme aead_scheme_;
 
@@ -0,0 +1,82 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/crypto/aead_key_pool.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "asylo/crypto/sha256_batch.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+
+AeadKeyPool *AeadKeyPool::GetInstance() {
+  static AeadKeyPool *instance = new AeadKeyPool();
+  return instance;
+}
+
+StatusOr<std::shared_ptr<AeadKey>> AeadKeyPool::GetAesGcmKey(
+    ByteContainerView key) {
+  return GetKey(key, /*gcm_siv=*/false);
+}
+
+StatusOr<std::shared_ptr<AeadKey>> AeadKeyPool::GetAesGcmSivKey(
+    ByteContainerView key) {
+  return GetKey(key, /*gcm_siv=*/true);
+}
+
+void AeadKeyPool::Clear() {
+  absl::MutexLock lock(&mu_);
+  keys_.clear();
+}
+
+size_t AeadKeyPool::Size() const {
+  absl::MutexLock lock(&mu_);
+  return keys_.size();
+}
+
+StatusOr<std::shared_ptr<AeadKey>> AeadKeyPool::GetKey(ByteContainerView key,
+                                                       bool gcm_siv) {
+  std::vector<uint8_t> digest;
+  ASYLO_RETURN_IF_ERROR(Sha256HashOneShot(key, &digest));
+  std::string pool_key =
+      absl::StrCat(gcm_siv ? "AES_GCM_SIV" : "AES_GCM", "-", key.size(), "-",
+                   std::string(digest.begin(), digest.end()));
+
+  absl::MutexLock lock(&mu_);
+  auto it = keys_.find(pool_key);
+  if (it != keys_.end()) {
+    return it->second;
+  }
+
+  std::unique_ptr<AeadKey> aead_key;
+  ASYLO_ASSIGN_OR_RETURN(aead_key, gcm_siv ? AeadKey::CreateAesGcmSivKey(key)
+                                           : AeadKey::CreateAesGcmKey(key));
+  std::shared_ptr<AeadKey> shared_key(std::move(aead_key));
+  keys_.emplace(std::move(pool_key), shared_key);
+  // GCC 4.9 requires this std::move() here.
+  return std::move(shared_key);
+}
+
+}  // namespace asylo
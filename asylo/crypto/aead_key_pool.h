@@ -0,0 +1,89 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_CRYPTO_AEAD_KEY_POOL_H_
+#define ASYLO_CRYPTO_AEAD_KEY_POOL_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "asylo/crypto/aead_key.h"
+#include "asylo/crypto/util/byte_container_view.h"
+#include "asylo/util/statusor.h"
+
+namespace asylo {
+
+// A process-wide pool of interned AeadKey objects, keyed by AEAD scheme and a
+// SHA-256 hash of the key material. AeadKey expands its AES key schedule once
+// at creation, so callers that repeatedly construct keys from the same key
+// material - such as a sealer unsealing many secrets at boot - can fetch the
+// pooled key instead and skip the re-expansion.
+//
+// Pooled keys are shared. BoringSSL permits concurrent Seal() and Open()
+// operations on an initialized AEAD context, so a pooled key may be used from
+// multiple threads.
+class AeadKeyPool {
+ public:
+  // Returns the singleton instance of AeadKeyPool.
+  static AeadKeyPool *GetInstance();
+
+  AeadKeyPool(const AeadKeyPool &) = delete;
+  AeadKeyPool &operator=(const AeadKeyPool &) = delete;
+
+  // Returns the pooled AES-GCM AeadKey for |key|, creating and interning it
+  // if this key material has not been seen before. Returns a non-OK Status if
+  // |key| has an invalid size.
+  StatusOr<std::shared_ptr<AeadKey>> GetAesGcmKey(ByteContainerView key)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Returns the pooled AES-GCM-SIV AeadKey for |key|, creating and interning
+  // it if this key material has not been seen before. Returns a non-OK Status
+  // if |key| has an invalid size.
+  StatusOr<std::shared_ptr<AeadKey>> GetAesGcmSivKey(ByteContainerView key)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Drops all interned keys, e.g. after a key-rotation event. Outstanding
+  // shared references remain valid.
+  void Clear() ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Returns the number of keys currently interned.
+  size_t Size() const ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  AeadKeyPool() = default;
+
+  // Looks up or creates the key for |key| under the AES-GCM-SIV scheme if
+  // |gcm_siv| is true, and the AES-GCM scheme otherwise.
+  StatusOr<std::shared_ptr<AeadKey>> GetKey(ByteContainerView key, bool gcm_siv)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  mutable absl::Mutex mu_;
+
+  // Interned keys, indexed by scheme name and key-material hash. Only a hash
+  // of the key material is retained as the map key; the material itself lives
+  // in the AeadKey's cleansing storage.
+  absl::flat_hash_map<std::string, std::shared_ptr<AeadKey>> keys_
+      ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_CRYPTO_AEAD_KEY_POOL_H_
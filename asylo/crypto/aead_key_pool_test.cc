@@ -0,0 +1,107 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/crypto/aead_key_pool.h"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "asylo/crypto/aead_key.h"
+#include "asylo/crypto/util/bytes.h"
+#include "asylo/crypto/util/trivial_object_util.h"
+#include "asylo/test/util/status_matchers.h"
+
+namespace asylo {
+namespace {
+
+constexpr size_t kAes256KeySize = 32;
+
+class AeadKeyPoolTest : public ::testing::Test {
+ protected:
+  // The pool is a process-wide singleton, so start each test from an empty
+  // pool.
+  void SetUp() override { AeadKeyPool::GetInstance()->Clear(); }
+
+  SafeBytes<kAes256KeySize> key_ =
+      TrivialZeroObject<SafeBytes<kAes256KeySize>>();
+};
+
+TEST_F(AeadKeyPoolTest, SameKeyMaterialReturnsSameInstance) {
+  std::shared_ptr<AeadKey> first;
+  std::shared_ptr<AeadKey> second;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      first, AeadKeyPool::GetInstance()->GetAesGcmSivKey(key_));
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      second, AeadKeyPool::GetInstance()->GetAesGcmSivKey(key_));
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(AeadKeyPool::GetInstance()->Size(), 1);
+}
+
+TEST_F(AeadKeyPoolTest, DifferentKeyMaterialReturnsDistinctInstances) {
+  SafeBytes<kAes256KeySize> other_key =
+      TrivialZeroObject<SafeBytes<kAes256KeySize>>();
+  other_key[0] = 1;
+
+  std::shared_ptr<AeadKey> first;
+  std::shared_ptr<AeadKey> second;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      first, AeadKeyPool::GetInstance()->GetAesGcmSivKey(key_));
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      second, AeadKeyPool::GetInstance()->GetAesGcmSivKey(other_key));
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ(AeadKeyPool::GetInstance()->Size(), 2);
+}
+
+TEST_F(AeadKeyPoolTest, SameKeyMaterialDifferentSchemesAreDistinct) {
+  std::shared_ptr<AeadKey> gcm_key;
+  std::shared_ptr<AeadKey> gcm_siv_key;
+  ASYLO_ASSERT_OK_AND_ASSIGN(gcm_key,
+                             AeadKeyPool::GetInstance()->GetAesGcmKey(key_));
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      gcm_siv_key, AeadKeyPool::GetInstance()->GetAesGcmSivKey(key_));
+  EXPECT_NE(gcm_key.get(), gcm_siv_key.get());
+  EXPECT_EQ(AeadKeyPool::GetInstance()->Size(), 2);
+}
+
+TEST_F(AeadKeyPoolTest, InvalidKeySizeFails) {
+  SafeBytes<kAes256KeySize - 1> bad_key =
+      TrivialZeroObject<SafeBytes<kAes256KeySize - 1>>();
+  EXPECT_THAT(AeadKeyPool::GetInstance()->GetAesGcmSivKey(bad_key).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_EQ(AeadKeyPool::GetInstance()->Size(), 0);
+}
+
+TEST_F(AeadKeyPoolTest, ClearDropsInternedKeys) {
+  std::shared_ptr<AeadKey> first;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      first, AeadKeyPool::GetInstance()->GetAesGcmSivKey(key_));
+
+  AeadKeyPool::GetInstance()->Clear();
+  EXPECT_EQ(AeadKeyPool::GetInstance()->Size(), 0);
+
+  // Outstanding references remain valid, and a refetch interns a new key.
+  std::shared_ptr<AeadKey> second;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      second, AeadKeyPool::GetInstance()->GetAesGcmSivKey(key_));
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ(first->GetAeadScheme(), second->GetAeadScheme());
+}
+
+}  // namespace
+}  // namespace asylo
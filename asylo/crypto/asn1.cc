@@ -21,6 +21,7 @@
 #include <openssl/asn1.h>
 #include <openssl/base.h>
 #include <openssl/bn.h>
+#include <openssl/bytestring.h>
 #include <openssl/obj.h>
 
 #include <cstdint>
@@ -73,6 +74,32 @@ absl::optional<Asn1Type> FromOpensslType(int openssl_type) {
   }
 }
 
+// Converts a BER tag in the representation used by the BoringSSL bytestring
+// library to an Asn1Type. Returns absl::nullopt if the tag does not identify
+// a supported universal type.
+absl::optional<Asn1Type> FromCbsTag(unsigned tag) {
+  switch (tag) {
+    case CBS_ASN1_BOOLEAN:
+      return Asn1Type::kBoolean;
+    case CBS_ASN1_INTEGER:
+      return Asn1Type::kInteger;
+    case CBS_ASN1_ENUMERATED:
+      return Asn1Type::kEnumerated;
+    case CBS_ASN1_BITSTRING:
+      return Asn1Type::kBitString;
+    case CBS_ASN1_OCTETSTRING:
+      return Asn1Type::kOctetString;
+    case CBS_ASN1_OBJECT:
+      return Asn1Type::kObjectId;
+    case CBS_ASN1_SEQUENCE:
+      return Asn1Type::kSequence;
+    case CBS_ASN1_IA5STRING:
+      return Asn1Type::kIA5String;
+    default:
+      return absl::nullopt;
+  }
+}
+
 // Converts an Asn1Type to an OpenSSL ASN.1 type code.
 int ToOpensslType(Asn1Type type) {
   switch (type) {
@@ -861,4 +888,74 @@ bool operator!=(const Asn1Value &lhs, const Asn1Value &rhs) {
   return !(lhs == rhs);
 }
 
+StatusOr<Asn1ValueView> Asn1ValueView::CreateFromDer(
+    ByteContainerView asn1_der) {
+  CBS der;
+  CBS_init(&der, asn1_der.data(), asn1_der.size());
+  CBS contents;
+  unsigned tag;
+  if (CBS_get_any_asn1(&der, &contents, &tag) != 1) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "ASN.1 DER value has a malformed header");
+  }
+  if (CBS_len(&der) != 0) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "ASN.1 DER value is followed by trailing data");
+  }
+  return Asn1ValueView(tag, asn1_der,
+                       ByteContainerView(CBS_data(&contents),
+                                         CBS_len(&contents)));
+}
+
+absl::optional<Asn1Type> Asn1ValueView::Type() const {
+  return FromCbsTag(tag_);
+}
+
+StatusOr<std::vector<Asn1ValueView>> Asn1ValueView::GetSequence() const {
+  ASYLO_RETURN_IF_ERROR(CheckIsType(Asn1Type::kSequence));
+  CBS elements_cbs;
+  CBS_init(&elements_cbs, contents_.data(), contents_.size());
+  std::vector<Asn1ValueView> elements;
+  while (CBS_len(&elements_cbs) != 0) {
+    CBS element;
+    unsigned element_tag;
+    size_t header_length;
+    if (CBS_get_any_asn1_element(&elements_cbs, &element, &element_tag,
+                                 &header_length) != 1) {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    "SEQUENCE contains an element with a malformed header");
+    }
+    elements.push_back(Asn1ValueView(
+        element_tag, ByteContainerView(CBS_data(&element), CBS_len(&element)),
+        ByteContainerView(CBS_data(&element) + header_length,
+                          CBS_len(&element) - header_length)));
+  }
+  return elements;
+}
+
+StatusOr<ByteContainerView> Asn1ValueView::GetOctetString() const {
+  ASYLO_RETURN_IF_ERROR(CheckIsType(Asn1Type::kOctetString));
+  return contents_;
+}
+
+StatusOr<Asn1Value> Asn1ValueView::Materialize() const {
+  return Asn1Value::CreateFromDer(der_);
+}
+
+Status Asn1ValueView::CheckIsType(Asn1Type type) const {
+  absl::optional<Asn1Type> actual_type = FromCbsTag(tag_);
+  if (actual_type != type) {
+    std::string actual_name =
+        actual_type.has_value()
+            ? OpensslTypeName(ToOpensslType(actual_type.value()))
+            : absl::StrFormat("(unsupported tag %#x)", tag_);
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrFormat("Asn1ValueView is a %s, not a %s",
+                                  actual_name,
+                                  OpensslTypeName(ToOpensslType(type))));
+  }
+
+  return Status::OkStatus();
+}
+
 }  // namespace asylo
@@ -316,6 +316,65 @@ class Asn1Value {
 bool operator==(const Asn1Value &lhs, const Asn1Value &rhs);
 bool operator!=(const Asn1Value &lhs, const Asn1Value &rhs);
 
+// A non-owning view of a single DER-encoded ASN.1 value.
+//
+// Unlike Asn1Value::CreateFromDer(), which eagerly converts the encoding into
+// owned recursive structures, an Asn1ValueView only parses the outermost
+// tag-length header and keeps a pointer into the original DER buffer. The
+// elements of a SEQUENCE are returned as further views into the same buffer,
+// so a caller can drill into a large structure and only pay to materialize
+// the values that it actually needs. This is useful on certificate-heavy
+// paths that extract a few fields from large DER structures; see
+// Asn1Schema::Read(Asn1ValueView) in asn1_schema.h for schema-driven
+// extraction built on these views.
+//
+// An Asn1ValueView is only valid as long as the buffer that it was created
+// from is live and unmodified.
+class Asn1ValueView {
+ public:
+  // Creates a view of the single DER-encoded value spanning all of
+  // |asn1_der|. Fails if |asn1_der| does not consist of exactly one value
+  // with a well-formed DER header.
+  static StatusOr<Asn1ValueView> CreateFromDer(ByteContainerView asn1_der);
+
+  // Returns the type of the viewed value, or absl::nullopt if the value has
+  // an unsupported type.
+  absl::optional<Asn1Type> Type() const;
+
+  // Returns the complete DER encoding of the viewed value.
+  ByteContainerView Der() const { return der_; }
+
+  // Returns views of the elements of a SEQUENCE value. No element contents
+  // are copied or parsed beyond their tag-length headers. Fails if the value
+  // is not a SEQUENCE.
+  StatusOr<std::vector<Asn1ValueView>> GetSequence() const;
+
+  // Returns a view of the contents of an OCTET STRING value without copying.
+  // Fails if the value is not an OCTET STRING.
+  StatusOr<ByteContainerView> GetOctetString() const;
+
+  // Converts the viewed value into an owned Asn1Value. Use the getters on the
+  // materialized value for types that have no zero-copy accessor above.
+  StatusOr<Asn1Value> Materialize() const;
+
+ private:
+  Asn1ValueView(unsigned tag, ByteContainerView der,
+                ByteContainerView contents)
+      : tag_(tag), der_(der), contents_(contents) {}
+
+  // Returns an OK status if this view's type is the same as |type|.
+  // Otherwise, returns an INVALID_ARGUMENT status describing the mismatch.
+  Status CheckIsType(Asn1Type type) const;
+
+  // The BER tag of the viewed value, in the representation used by the
+  // BoringSSL bytestring library.
+  unsigned tag_;
+
+  // The complete encoding of the viewed value and its contents octets.
+  ByteContainerView der_;
+  ByteContainerView contents_;
+};
+
 }  // namespace asylo
 
 #endif  // ASYLO_CRYPTO_ASN1_H_
@@ -54,6 +54,17 @@ class Asn1Schema {
   // match the schema.
   virtual StatusOr<ValueType> Read(const Asn1Value &asn1) const = 0;
 
+  // Reads a matching value from the DER view |asn1| or returns an error if
+  // the viewed value does not match the schema. The default implementation
+  // materializes |asn1| and delegates to Read() above. Container schemas
+  // override this to walk the encoding lazily, so that a single pass over a
+  // DER buffer only materializes the leaf values that the schema extracts.
+  virtual StatusOr<ValueType> Read(const Asn1ValueView &asn1) const {
+    Asn1Value owned;
+    ASYLO_ASSIGN_OR_RETURN(owned, asn1.Materialize());
+    return Read(owned);
+  }
+
   // Writes |value| to an Asn1Value.
   virtual StatusOr<Asn1Value> Write(const ValueType &value) const = 0;
 };
@@ -93,6 +104,25 @@ class Asn1SequenceImpl
     return value;
   }
 
+  // From Asn1Schema.
+  StatusOr<std::tuple<FirstValueTypeT, SecondValueTypeT>> Read(
+      const Asn1ValueView &asn1) const override {
+    std::vector<Asn1ValueView> elements;
+    ASYLO_ASSIGN_OR_RETURN(elements, asn1.GetSequence());
+    if (elements.size() != 2) {
+      return Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrFormat("Sequence has size %d, but size 2 was expected",
+                          elements.size()));
+    }
+    std::tuple<FirstValueTypeT, SecondValueTypeT> value;
+    ASYLO_ASSIGN_OR_RETURN(std::get<0>(value),
+                           first_schema_->Read(elements[0]));
+    ASYLO_ASSIGN_OR_RETURN(std::get<1>(value),
+                           second_schema_->Read(elements[1]));
+    return value;
+  }
+
   // From Asn1Schema.
   StatusOr<Asn1Value> Write(
       const std::tuple<FirstValueTypeT, SecondValueTypeT> &value) const {
@@ -134,6 +164,19 @@ class Asn1SequenceOfImpl : public Asn1Schema<std::vector<ValueTypeT>> {
     return result;
   }
 
+  // From Asn1Schema.
+  StatusOr<std::vector<ValueTypeT>> Read(
+      const Asn1ValueView &asn1) const override {
+    std::vector<Asn1ValueView> elements;
+    ASYLO_ASSIGN_OR_RETURN(elements, asn1.GetSequence());
+    ASYLO_RETURN_IF_ERROR(VerifySize(elements.size()));
+    std::vector<ValueTypeT> result(elements.size());
+    for (int i = 0; i < elements.size(); ++i) {
+      ASYLO_ASSIGN_OR_RETURN(result[i], element_schema_->Read(elements[i]));
+    }
+    return result;
+  }
+
   // From Asn1Schema.
   StatusOr<Asn1Value> Write(
       const std::vector<ValueTypeT> &value) const override {
@@ -184,6 +227,16 @@ class NamedSchemaImpl : public Asn1Schema<ValueTypeT> {
     return result.ValueOrDie();
   }
 
+  // From Asn1Schema.
+  StatusOr<ValueTypeT> Read(const Asn1ValueView &asn1) const override {
+    StatusOr<ValueTypeT> result = schema_->Read(asn1);
+    if (!result.ok()) {
+      return result.status().WithPrependedContext(
+          absl::StrFormat("Failed to read %s", name_));
+    }
+    return result.ValueOrDie();
+  }
+
   // From Asn1Schema.
   StatusOr<Asn1Value> Write(const ValueTypeT &value) const override {
     StatusOr<Asn1Value> result = schema_->Write(value);
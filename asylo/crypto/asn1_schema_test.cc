@@ -444,5 +444,68 @@ TEST(Asn1SchemaTest, NamedSchemaWriteInvalidValues) {
               HasSubstr("Failed to write Fail"));
 }
 
+TEST(Asn1SchemaTest, Asn1SequenceReadFromViewValidValues) {
+  ObjectId some_oid;
+  ASYLO_ASSERT_OK_AND_ASSIGN(some_oid, ObjectId::CreateFromNumericId(NID_md5));
+
+  Asn1Value asn1;
+  ASYLO_ASSERT_OK_AND_ASSIGN(asn1, Asn1Value::CreateSequenceFromStatusOrs(
+                                       {Asn1Value::CreateObjectId(some_oid),
+                                        Asn1Value::CreateBoolean(true)}));
+  std::vector<uint8_t> der;
+  ASYLO_ASSERT_OK_AND_ASSIGN(der, asn1.SerializeToDer());
+
+  auto view_result = Asn1ValueView::CreateFromDer(der);
+  ASYLO_ASSERT_OK(view_result);
+
+  std::tuple<ObjectId, Asn1Value> read_result;
+  ASYLO_ASSERT_OK_AND_ASSIGN(read_result,
+                             Asn1Sequence(Asn1ObjectId(), Asn1Any())
+                                 ->Read(view_result.ValueOrDie()));
+  EXPECT_THAT(std::get<0>(read_result), Eq(some_oid));
+  EXPECT_THAT(std::get<1>(read_result).GetBoolean(), IsOkAndHolds(true));
+}
+
+TEST(Asn1SchemaTest, Asn1SequenceOfReadFromViewValidValues) {
+  constexpr int kTestSequenceElements = 7;
+
+  ObjectId some_oid;
+  ASYLO_ASSERT_OK_AND_ASSIGN(some_oid, ObjectId::CreateFromNumericId(NID_md5));
+
+  Asn1Value asn1;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      asn1,
+      Asn1Value::CreateSequenceFromStatusOrs(std::vector<StatusOr<Asn1Value>>(
+          kTestSequenceElements, Asn1Value::CreateObjectId(some_oid))));
+  std::vector<uint8_t> der;
+  ASYLO_ASSERT_OK_AND_ASSIGN(der, asn1.SerializeToDer());
+
+  auto view_result = Asn1ValueView::CreateFromDer(der);
+  ASYLO_ASSERT_OK(view_result);
+
+  std::vector<ObjectId> read_result;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      read_result,
+      Asn1SequenceOf(Asn1ObjectId())->Read(view_result.ValueOrDie()));
+  EXPECT_THAT(read_result, ElementsAreArray(std::vector<ObjectId>(
+                               kTestSequenceElements, some_oid)));
+}
+
+TEST(Asn1SchemaTest, NamedSchemaReadFromViewAddsNameToErrors) {
+  Asn1Value asn1;
+  ASYLO_ASSERT_OK_AND_ASSIGN(asn1, Asn1Value::CreateOctetString("bad"));
+  std::vector<uint8_t> der;
+  ASYLO_ASSERT_OK_AND_ASSIGN(der, asn1.SerializeToDer());
+
+  auto view_result = Asn1ValueView::CreateFromDer(der);
+  ASYLO_ASSERT_OK(view_result);
+
+  auto oid_read_result = NamedSchema("OBJECT IDENTIFIER", Asn1ObjectId())
+                             ->Read(view_result.ValueOrDie());
+  EXPECT_THAT(oid_read_result, StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(std::string(oid_read_result.status().error_message()),
+              HasSubstr("Failed to read OBJECT IDENTIFIER"));
+}
+
 }  // namespace
 }  // namespace asylo
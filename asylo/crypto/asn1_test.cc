@@ -1198,5 +1198,91 @@ TYPED_TEST(Asn1Test, ValuesOfUnsupportedTypesCanBeSerialized) {
                   absl::HexStringToBytes(kUnsupportedValueDerHex))));
 }
 
+TYPED_TEST(Asn1Test, ViewsMaterializeToOriginalValues) {
+  Asn1Value asn1;
+  for (const auto &value : TestFixture::TestData()) {
+    ASYLO_ASSERT_OK_AND_ASSIGN(asn1, TestFixture::Create(value));
+    std::vector<uint8_t> der;
+    ASYLO_ASSERT_OK_AND_ASSIGN(der, asn1.SerializeToDer());
+
+    auto view_result = Asn1ValueView::CreateFromDer(der);
+    ASYLO_ASSERT_OK(view_result);
+    Asn1ValueView view = view_result.ValueOrDie();
+    EXPECT_THAT(view.Type(), Eq(asn1.Type()));
+    EXPECT_THAT(view.Der(), ContainerEq(ByteContainerView(der)));
+
+    Asn1Value materialized;
+    ASYLO_ASSERT_OK_AND_ASSIGN(materialized, view.Materialize());
+    typename TestFixture::ValueType roundtrip;
+    ASYLO_ASSERT_OK_AND_ASSIGN(roundtrip, TestFixture::Get(materialized));
+    TestFixture::ExpectEqual(roundtrip, value);
+  }
+}
+
+TEST(Asn1Test, Asn1ValueViewGetSequenceReturnsViewsIntoOriginalBuffer) {
+  std::vector<Asn1Value> elements(2);
+  ASYLO_ASSERT_OK_AND_ASSIGN(elements[0], Asn1Value::CreateIntegerFromInt(27));
+  ASYLO_ASSERT_OK_AND_ASSIGN(elements[1],
+                             Asn1Value::CreateOctetString("foobar"));
+  Asn1Value asn1;
+  ASYLO_ASSERT_OK_AND_ASSIGN(asn1, Asn1Value::CreateSequence(elements));
+  std::vector<uint8_t> der;
+  ASYLO_ASSERT_OK_AND_ASSIGN(der, asn1.SerializeToDer());
+
+  auto view_result = Asn1ValueView::CreateFromDer(der);
+  ASYLO_ASSERT_OK(view_result);
+
+  std::vector<Asn1ValueView> element_views;
+  ASYLO_ASSERT_OK_AND_ASSIGN(element_views,
+                             view_result.ValueOrDie().GetSequence());
+  ASSERT_THAT(element_views, SizeIs(2));
+  EXPECT_THAT(element_views[0].Type(), Optional(Asn1Type::kInteger));
+  EXPECT_THAT(element_views[1].Type(), Optional(Asn1Type::kOctetString));
+
+  Asn1Value integer_element;
+  ASYLO_ASSERT_OK_AND_ASSIGN(integer_element, element_views[0].Materialize());
+  EXPECT_THAT(integer_element.GetIntegerAsInt<int>(), IsOkAndHolds(27));
+
+  // The contents of the OCTET STRING element must be visible without any
+  // copies - i.e. through a view into the original DER buffer.
+  ByteContainerView octet_string_contents;
+  ASYLO_ASSERT_OK_AND_ASSIGN(octet_string_contents,
+                             element_views[1].GetOctetString());
+  EXPECT_THAT(octet_string_contents,
+              ContainerEq(ByteContainerView("foobar", 6)));
+  EXPECT_GE(octet_string_contents.data(), der.data());
+  EXPECT_LE(octet_string_contents.data() + octet_string_contents.size(),
+            der.data() + der.size());
+}
+
+TEST(Asn1Test, Asn1ValueViewCreateFromDerFailsWithMalformedInput) {
+  std::string der = absl::HexStringToBytes(kUnsupportedValueDerHex);
+
+  // A truncated value must be rejected.
+  ByteContainerView truncated(der.data(), der.size() - 1);
+  EXPECT_THAT(Asn1ValueView::CreateFromDer(truncated).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  // Trailing data after the value must be rejected.
+  der.push_back('\0');
+  EXPECT_THAT(Asn1ValueView::CreateFromDer(der).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(Asn1Test, Asn1ValueViewGettersFailWithIncorrectType) {
+  Asn1Value asn1;
+  ASYLO_ASSERT_OK_AND_ASSIGN(asn1, Asn1Value::CreateIntegerFromInt(42));
+  std::vector<uint8_t> der;
+  ASYLO_ASSERT_OK_AND_ASSIGN(der, asn1.SerializeToDer());
+
+  auto view_result = Asn1ValueView::CreateFromDer(der);
+  ASYLO_ASSERT_OK(view_result);
+  Asn1ValueView view = view_result.ValueOrDie();
+  EXPECT_THAT(view.GetSequence().status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(view.GetOctetString().status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 }  // namespace
 }  // namespace asylo
@@ -21,7 +21,6 @@
 #include <openssl/base.h>
 #include <openssl/bn.h>
 
-#include <algorithm>
 #include <cstdint>
 #include <utility>
 #include <vector>
@@ -116,25 +115,62 @@ StatusOr<std::pair<Sign, std::vector<uint8_t>>> PaddedBigEndianBytesFromBignum(
 
 StatusOr<bssl::UniquePtr<BIGNUM>> BignumFromLittleEndianBytes(
     ByteContainerView bytes, Sign sign) {
-  std::vector<uint8_t> big_endian_bytes(bytes.rbegin(), bytes.rend());
-  return BignumFromBigEndianBytes(big_endian_bytes, sign);
+  // BN_le2bn() consumes the bytes in word-sized chunks - no intermediate
+  // reversed copy of the input is made.
+  bssl::UniquePtr<BIGNUM> bignum(
+      BN_le2bn(bytes.data(), bytes.size(), /*ret=*/nullptr));
+  if (bignum == nullptr) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
+  if (sign == Sign::kNegative) {
+    BN_set_negative(bignum.get(), kSetNegative);
+  }
+  // GCC 4.9 requires this std::move() here.
+  return std::move(bignum);
 }
 
 StatusOr<std::pair<Sign, std::vector<uint8_t>>> LittleEndianBytesFromBignum(
     const BIGNUM &bignum) {
-  std::pair<Sign, std::vector<uint8_t>> result;
-  ASYLO_ASSIGN_OR_RETURN(result, BigEndianBytesFromBignum(bignum));
-  std::reverse(result.second.begin(), result.second.end());
-  return result;
+  return PaddedLittleEndianBytesFromBignum(bignum, BN_num_bytes(&bignum));
 }
 
 StatusOr<std::pair<Sign, std::vector<uint8_t>>>
 PaddedLittleEndianBytesFromBignum(const BIGNUM &bignum, size_t padded_size) {
+  size_t bignum_bytes_size = BN_num_bytes(&bignum);
+  if (bignum_bytes_size > padded_size) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrFormat("Number of bytes in BIGNUM (%d) is larger "
+                                  "than the buffer size (%d)",
+                                  bignum_bytes_size, padded_size));
+  }
   std::pair<Sign, std::vector<uint8_t>> result;
-  ASYLO_ASSIGN_OR_RETURN(result,
-                         PaddedBigEndianBytesFromBignum(bignum, padded_size));
-  std::reverse(result.second.begin(), result.second.end());
+  result.first = BN_is_negative(&bignum) ? Sign::kNegative : Sign::kPositive;
+  result.second.resize(padded_size);
+  // BN_bn2le_padded() serializes directly in little-endian order - no
+  // big-endian detour followed by a byte reversal.
+  if (BN_bn2le_padded(result.second.data(), padded_size, &bignum) != 1) {
+    return Status(absl::StatusCode::kInternal, "Serialization failed");
+  }
   return result;
 }
 
+Status BignumFromBigEndianBytesInPlace(ByteContainerView bytes, BIGNUM *bignum,
+                                       Sign sign) {
+  if (BN_bin2bn(bytes.data(), bytes.size(), bignum) == nullptr) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
+  // |bignum| may be reused across parses - always set the sign.
+  BN_set_negative(bignum, sign == Sign::kNegative ? kSetNegative : 0);
+  return Status::OkStatus();
+}
+
+Status BignumFromLittleEndianBytesInPlace(ByteContainerView bytes,
+                                          BIGNUM *bignum, Sign sign) {
+  if (BN_le2bn(bytes.data(), bytes.size(), bignum) == nullptr) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
+  BN_set_negative(bignum, sign == Sign::kNegative ? kSetNegative : 0);
+  return Status::OkStatus();
+}
+
 }  // namespace asylo
@@ -81,6 +81,56 @@ StatusOr<std::pair<Sign, std::vector<uint8_t>>> LittleEndianBytesFromBignum(
 StatusOr<std::pair<Sign, std::vector<uint8_t>>>
 PaddedLittleEndianBytesFromBignum(const BIGNUM &bignum, size_t padded_size);
 
+// Parses |bytes| as a big-endian integer into the caller-provided |bignum| -
+// typically a StackBignum - instead of allocating a new one. If |sign| is
+// kNegative, then the parsed value is negated.
+Status BignumFromBigEndianBytesInPlace(ByteContainerView bytes, BIGNUM *bignum,
+                                       Sign sign = Sign::kPositive);
+
+// Parses |bytes| as a little-endian integer into the caller-provided |bignum|
+// instead of allocating a new one. If |sign| is kNegative, then the parsed
+// value is negated.
+Status BignumFromLittleEndianBytesInPlace(ByteContainerView bytes,
+                                          BIGNUM *bignum,
+                                          Sign sign = Sign::kPositive);
+
+// A BIGNUM whose limb storage lives inline in the object - typically on the
+// stack - rather than on the heap. The limbs are marked BN_FLG_STATIC_DATA,
+// so operations that would grow the value beyond |kCapacityBytes| fail
+// instead of reallocating. Intended for fixed-width values such as NIST curve
+// coordinates, where it eliminates the BN_new()/BN_free() round trip per
+// value. BoringSSL declares struct bignum_st publicly, which is what permits
+// the inline initialization.
+template <size_t kCapacityBytes>
+class StackBignum {
+ public:
+  static constexpr size_t kLimbCount =
+      (kCapacityBytes + sizeof(BN_ULONG) - 1) / sizeof(BN_ULONG);
+
+  StackBignum() {
+    BN_init(&bn_);
+    bn_.d = limbs_;
+    bn_.dmax = kLimbCount;
+    bn_.flags = BN_FLG_STATIC_DATA;
+  }
+
+  StackBignum(const StackBignum &) = delete;
+  StackBignum &operator=(const StackBignum &) = delete;
+
+  // No destructor: the limbs are owned inline and nothing is heap-allocated.
+
+  BIGNUM *get() { return &bn_; }
+  const BIGNUM *get() const { return &bn_; }
+
+ private:
+  BN_ULONG limbs_[kLimbCount] = {};
+  BIGNUM bn_;
+};
+
+// Stack bignum widths for the NIST curve coordinates that dominate usage.
+using P256Bignum = StackBignum<32>;
+using P384Bignum = StackBignum<48>;
+
 namespace internal {
 
 // Returns true if the host is big-endian and false otherwise.
@@ -150,6 +150,62 @@ TEST(BignumUtilTest, LittleEndianNegativeZeroPadded) {
                                 ElementsAreArray(kBytesWithZerosAppended))));
 }
 
+TEST(BignumUtilTest, InPlaceBigEndianParseMatchesAllocatingParse) {
+  bssl::UniquePtr<BIGNUM> expected;
+  ASYLO_ASSERT_OK_AND_ASSIGN(expected,
+                             BignumFromBigEndianBytes(absl::MakeSpan(kBytes)));
+
+  bssl::UniquePtr<BIGNUM> bignum(BN_new());
+  ASYLO_ASSERT_OK(
+      BignumFromBigEndianBytesInPlace(absl::MakeSpan(kBytes), bignum.get()));
+  EXPECT_EQ(BN_cmp(bignum.get(), expected.get()), 0);
+}
+
+TEST(BignumUtilTest, InPlaceLittleEndianParseMatchesAllocatingParse) {
+  bssl::UniquePtr<BIGNUM> expected;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      expected, BignumFromLittleEndianBytes(absl::MakeSpan(kBytes)));
+
+  bssl::UniquePtr<BIGNUM> bignum(BN_new());
+  ASYLO_ASSERT_OK(
+      BignumFromLittleEndianBytesInPlace(absl::MakeSpan(kBytes), bignum.get()));
+  EXPECT_EQ(BN_cmp(bignum.get(), expected.get()), 0);
+}
+
+TEST(BignumUtilTest, InPlaceParseClearsSignOfReusedBignum) {
+  bssl::UniquePtr<BIGNUM> bignum(BN_new());
+  ASYLO_ASSERT_OK(BignumFromBigEndianBytesInPlace(absl::MakeSpan(kBytes),
+                                                  bignum.get(),
+                                                  Sign::kNegative));
+  ASSERT_TRUE(BN_is_negative(bignum.get()));
+
+  ASYLO_ASSERT_OK(
+      BignumFromBigEndianBytesInPlace(absl::MakeSpan(kBytes), bignum.get()));
+  EXPECT_FALSE(BN_is_negative(bignum.get()));
+}
+
+TEST(BignumUtilTest, StackBignumRoundtrip) {
+  constexpr uint8_t kCoordinate[32] = {1,  2,  3,  4,  5,  6,  7,  8,
+                                       9,  10, 11, 12, 13, 14, 15, 16,
+                                       17, 18, 19, 20, 21, 22, 23, 24,
+                                       25, 26, 27, 28, 29, 30, 31, 32};
+  P256Bignum bignum;
+  ASYLO_ASSERT_OK(BignumFromBigEndianBytesInPlace(absl::MakeSpan(kCoordinate),
+                                                  bignum.get()));
+  EXPECT_THAT(
+      PaddedBigEndianBytesFromBignum(*bignum.get(), sizeof(kCoordinate)),
+      IsOkAndHolds(Pair(Sign::kPositive, ElementsAreArray(kCoordinate))));
+}
+
+TEST(BignumUtilTest, StackBignumRejectsOverCapacityValues) {
+  // kBytes is 40 bytes - wider than a P-256 coordinate - so the parse must
+  // fail rather than grow the static limb storage.
+  P256Bignum bignum;
+  EXPECT_THAT(
+      BignumFromBigEndianBytesInPlace(absl::MakeSpan(kBytes), bignum.get()),
+      StatusIs(absl::StatusCode::kInternal));
+}
+
 // A test fixture for conversions between BIGNUM and IntT.
 template <typename IntT>
 class BignumUtilIntegerTest : public Test {};
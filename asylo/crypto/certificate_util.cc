@@ -19,16 +19,22 @@
 #include "asylo/crypto/certificate_util.h"
 
 #include <cstdint>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
 #include "absl/types/optional.h"
+#include "asylo/crypto/sha256_batch.h"
+#include "asylo/crypto/util/byte_container_view.h"
 #include "asylo/crypto/x509_certificate.h"
 #include "asylo/identity/attestation/sgx/internal/attestation_key_certificate_impl.h"
 #include "asylo/util/proto_enum_util.h"
 #include "asylo/util/status_macros.h"
+#include "asylo/util/thread.h"
 
 namespace asylo {
 
@@ -149,6 +155,60 @@ StatusOr<CertificateInterfaceVector> CreateCertificateChain(
   return std::move(certificate_interface_chain);
 }
 
+StatusOr<CertificateInterfaceVector> CreateCertificateChainParallel(
+    const CertificateFactoryMap &factory_map, const CertificateChain &chain) {
+  if (chain.certificates_size() < 2) {
+    return CreateCertificateChain(factory_map, chain);
+  }
+
+  // Resolve all factories up front so that an unknown format is reported
+  // before any threads are launched.
+  std::vector<const CertificateFactoryMap::mapped_type *> factories;
+  factories.reserve(chain.certificates_size());
+  for (int i = 0; i < chain.certificates_size(); i++) {
+    auto factory_iter = factory_map.find(chain.certificates(i).format());
+    if (factory_iter == factory_map.end()) {
+      return Status(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("At index ", i,
+                       " no mapping from format to factory for format ",
+                       ProtoEnumValueName(chain.certificates(i).format())));
+    }
+    factories.push_back(&factory_iter->second);
+  }
+
+  CertificateInterfaceVector certificate_interface_chain(
+      chain.certificates_size());
+  std::vector<Status> statuses(chain.certificates_size(), Status::OkStatus());
+  std::vector<Thread> threads;
+  threads.reserve(chain.certificates_size());
+  for (int i = 0; i < chain.certificates_size(); i++) {
+    threads.emplace_back([&factories, &chain, &certificate_interface_chain,
+                          &statuses, i] {
+      auto certificate_result = (*factories[i])(chain.certificates(i));
+      if (certificate_result.ok()) {
+        certificate_interface_chain[i] =
+            std::move(certificate_result).ValueOrDie();
+      } else {
+        statuses[i] = certificate_result.status().WithPrependedContext(
+            absl::StrCat("Failed to create certificate at index ", i));
+      }
+    });
+  }
+  for (Thread &thread : threads) {
+    thread.Join();
+  }
+
+  // Report the error for the lowest failing index, matching the sequential
+  // version.
+  for (const Status &status : statuses) {
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  return std::move(certificate_interface_chain);
+}
+
 Status VerifyCertificateChain(CertificateInterfaceSpan certificate_chain,
                               const VerificationConfig &verification_config) {
   if (certificate_chain.empty()) {
@@ -198,6 +258,116 @@ Status VerifyCertificateChain(CertificateInterfaceSpan certificate_chain,
   return Status::OkStatus();
 }
 
+CertificateChainVerificationCache::CertificateChainVerificationCache(
+    size_t max_entries, absl::Duration ttl)
+    : max_entries_(max_entries), ttl_(ttl) {}
+
+Status CertificateChainVerificationCache::VerifyCertificateChain(
+    CertificateInterfaceSpan certificate_chain,
+    const VerificationConfig &verification_config) {
+  StatusOr<std::string> fingerprint_result =
+      ChainFingerprint(certificate_chain, verification_config);
+  if (!fingerprint_result.ok()) {
+    // Chains that cannot be fingerprinted are verified without caching.
+    return asylo::VerifyCertificateChain(certificate_chain,
+                                         verification_config);
+  }
+  std::string fingerprint = std::move(fingerprint_result).ValueOrDie();
+
+  const absl::Time now = absl::Now();
+  bool cache_hit = false;
+  {
+    absl::MutexLock lock(&mu_);
+    auto entry = entries_.find(fingerprint);
+    if (entry != entries_.end()) {
+      if (entry->second > now) {
+        cache_hit = true;
+      } else {
+        entries_.erase(entry);
+      }
+    }
+  }
+
+  if (cache_hit && verification_config.subject_validity_period.has_value()) {
+    // The validity-period check depends on the requested time, which is not
+    // part of the cache key, so it is re-run on every hit. It involves no
+    // public-key operations. If any certificate is outside its validity
+    // window, fall through to full verification so that the caller gets the
+    // same error it would have gotten without the cache.
+    for (const auto &certificate : certificate_chain) {
+      StatusOr<bool> within_period_result = certificate->WithinValidityPeriod(
+          verification_config.subject_validity_period.value());
+      if (!within_period_result.ok() || !within_period_result.ValueOrDie()) {
+        cache_hit = false;
+        break;
+      }
+    }
+  }
+  if (cache_hit) {
+    return Status::OkStatus();
+  }
+
+  ASYLO_RETURN_IF_ERROR(asylo::VerifyCertificateChain(certificate_chain,
+                                                      verification_config));
+
+  absl::MutexLock lock(&mu_);
+  if (entries_.insert_or_assign(fingerprint, now + ttl_).second) {
+    insertion_order_.push_back(std::move(fingerprint));
+  }
+  // Eviction is FIFO over first insertions; refreshing an existing entry does
+  // not move it to the back of the queue.
+  while (entries_.size() > max_entries_ && !insertion_order_.empty()) {
+    entries_.erase(insertion_order_.front());
+    insertion_order_.pop_front();
+  }
+  return Status::OkStatus();
+}
+
+StatusOr<std::string> CertificateChainVerificationCache::ChainFingerprint(
+    CertificateInterfaceSpan certificate_chain,
+    const VerificationConfig &verification_config) {
+  const uint8_t config_bits =
+      (verification_config.issuer_ca ? 1 : 0) |
+      (verification_config.max_pathlen ? 2 : 0) |
+      (verification_config.issuer_key_usage ? 4 : 0);
+
+  // Collect views over the fingerprinted fields and hash them in one
+  // multi-part pass, rather than building a Sha256Hash (and its hash
+  // contexts) per lookup. The vectors below own the bytes the views point
+  // into, and are sized up front so growth cannot relocate them.
+  const size_t chain_size = certificate_chain.size();
+  std::vector<Certificate> protos;
+  std::vector<uint32_t> formats(chain_size);
+  std::vector<uint64_t> data_sizes(chain_size);
+  std::vector<ByteContainerView> parts;
+  protos.reserve(chain_size);
+  parts.reserve(3 * chain_size + 1);
+  parts.emplace_back(&config_bits, sizeof(config_bits));
+  for (size_t i = 0; i < chain_size; ++i) {
+    const auto &certificate = certificate_chain[i];
+    StatusOr<Certificate> proto_result =
+        certificate->ToCertificateProto(Certificate::X509_DER);
+    if (!proto_result.ok()) {
+      // Non-X.509 certificates (e.g. attestation key certificates) serialize
+      // to their own formats.
+      ASYLO_ASSIGN_OR_RETURN(
+          proto_result,
+          certificate->ToCertificateProto(
+              Certificate::SGX_ATTESTATION_KEY_CERTIFICATE));
+    }
+    protos.push_back(std::move(proto_result).ValueOrDie());
+    const Certificate &proto = protos.back();
+    formats[i] = proto.format();
+    data_sizes[i] = proto.data().size();
+    parts.emplace_back(&formats[i], sizeof(formats[i]));
+    parts.emplace_back(&data_sizes[i], sizeof(data_sizes[i]));
+    parts.emplace_back(proto.data());
+  }
+  std::vector<uint8_t> digest;
+  ASYLO_RETURN_IF_ERROR(Sha256HashMultiPart(parts, &digest));
+  return std::string(digest.begin(), digest.end());
+}
+
 StatusOr<Certificate> GetCertificateFromPem(absl::string_view pem_cert) {
   std::unique_ptr<X509Certificate> cert;
   ASYLO_ASSIGN_OR_RETURN(cert, X509Certificate::CreateFromPem(pem_cert));
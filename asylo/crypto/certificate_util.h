@@ -19,12 +19,17 @@
 #ifndef ASYLO_CRYPTO_CERTIFICATE_UTIL_H_
 #define ASYLO_CRYPTO_CERTIFICATE_UTIL_H_
 
+#include <cstddef>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "asylo/crypto/certificate.pb.h"
 #include "asylo/crypto/certificate_interface.h"
@@ -95,6 +100,13 @@ StatusOr<std::unique_ptr<CertificateInterface>> CreateCertificateInterface(
 StatusOr<CertificateInterfaceVector> CreateCertificateChain(
     const CertificateFactoryMap &factory_map, const CertificateChain &chain);
 
+// As CreateCertificateChain(), but parses the certificates in |chain| on
+// parallel threads, one per certificate. Produces the same results and errors
+// as the sequential version. Chains with fewer than two certificates are
+// parsed on the calling thread.
+StatusOr<CertificateInterfaceVector> CreateCertificateChainParallel(
+    const CertificateFactoryMap &factory_map, const CertificateChain &chain);
+
 // Checks if |certificate_chain| is a valid chain of certificates. The last
 // certificate must be self-signed. Checks signatures and, depending on whether
 // they are applicable for the format, checks the additional constraints set in
@@ -103,6 +115,54 @@ StatusOr<CertificateInterfaceVector> CreateCertificateChain(
 Status VerifyCertificateChain(CertificateInterfaceSpan certificate_chain,
                               const VerificationConfig &verification_config);
 
+// A thread-safe memoization cache for VerifyCertificateChain() results.
+//
+// Verifying a certificate chain costs one public-key signature verification per
+// certificate. Callers that are repeatedly presented with the same chain (e.g.
+// the same attestation certificate chain on every inbound handshake) can route
+// verification through a cache, which only re-runs the full verification when a
+// chain is first seen or when its cache entry has expired.
+//
+// Entries are keyed by a hash of each certificate's serialized form together
+// with the |issuer_ca|, |max_pathlen|, and |issuer_key_usage| fields of the
+// VerificationConfig. Only successful verifications are cached. The
+// |subject_validity_period| check is deliberately excluded from the key, since
+// its value typically differs on every call; instead, it is re-checked cheaply
+// on each cache hit so that a hit cannot outlive a certificate's validity
+// window.
+class CertificateChainVerificationCache {
+ public:
+  // Creates a cache that holds at most |max_entries| verified chains, each of
+  // which remains valid for |ttl| after insertion.
+  CertificateChainVerificationCache(size_t max_entries, absl::Duration ttl);
+
+  // Has the same contract as VerifyCertificateChain(). On a cache hit, skips
+  // signature verification; on a miss, verifies |certificate_chain| and caches
+  // the result if verification succeeded.
+  Status VerifyCertificateChain(CertificateInterfaceSpan certificate_chain,
+                                const VerificationConfig &verification_config);
+
+ private:
+  // Returns a fingerprint identifying |certificate_chain| and the keyed fields
+  // of |verification_config|, or a non-OK Status if any certificate in the
+  // chain could not be serialized.
+  static StatusOr<std::string> ChainFingerprint(
+      CertificateInterfaceSpan certificate_chain,
+      const VerificationConfig &verification_config);
+
+  const size_t max_entries_;
+  const absl::Duration ttl_;
+
+  absl::Mutex mu_;
+
+  // Maps chain fingerprints to the expiration times of their cache entries.
+  absl::flat_hash_map<std::string, absl::Time> entries_ ABSL_GUARDED_BY(mu_);
+
+  // Fingerprints in first-insertion order, used to bound the size of
+  // |entries_|.
+  std::deque<std::string> insertion_order_ ABSL_GUARDED_BY(mu_);
+};
+
 // Parses PEM-encoded certificate |pem_cert| into Certificate protobuf.
 // Returns a non-OK Status if |pem_cert| is not X.509 PEM encoded.
 StatusOr<Certificate> GetCertificateFromPem(absl::string_view pem_cert);
@@ -26,6 +26,7 @@
 #include <gtest/gtest.h>
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/time/time.h"
 #include "absl/types/optional.h"
 #include "absl/types/span.h"
 #include "asylo/crypto/certificate.pb.h"
@@ -742,6 +743,78 @@ TEST(CertificateUtilTest, VerifyCertificateChainCaValuesSet) {
   ASYLO_EXPECT_OK(VerifyCertificateChain(absl::MakeConstSpan(chain), config));
 }
 
+TEST(CertificateUtilTest, CertificateChainVerificationCacheVerifiesValidChain) {
+  CertificateInterfaceVector chain;
+  chain.emplace_back(absl::make_unique<FakeCertificate>(
+      kEndUserKey, kIntermediateKey, /*is_ca=*/absl::nullopt,
+      /*pathlength=*/absl::nullopt, /*subject_name=*/absl::nullopt));
+  chain.emplace_back(absl::make_unique<FakeCertificate>(
+      kIntermediateKey, kRootKey, /*is_ca=*/absl::nullopt, /*pathlength=*/0,
+      /*subject_name=*/absl::nullopt));
+  chain.emplace_back(absl::make_unique<FakeCertificate>(
+      kRootKey, kRootKey, /*is_ca=*/absl::nullopt, /*pathlength=*/1,
+      /*subject_name=*/absl::nullopt));
+
+  CertificateChainVerificationCache cache(/*max_entries=*/16,
+                                          /*ttl=*/absl::Minutes(5));
+  VerificationConfig config(/*all_fields=*/true);
+
+  // The first call verifies the chain; the second is served from the cache.
+  ASYLO_EXPECT_OK(
+      cache.VerifyCertificateChain(absl::MakeConstSpan(chain), config));
+  ASYLO_EXPECT_OK(
+      cache.VerifyCertificateChain(absl::MakeConstSpan(chain), config));
+}
+
+TEST(CertificateUtilTest, CertificateChainVerificationCacheForwardsFailures) {
+  CertificateInterfaceVector chain;
+  chain.emplace_back(absl::make_unique<FakeCertificate>(
+      kEndUserKey, kExtraIntermediateKey, /*is_ca=*/absl::nullopt,
+      /*pathlength=*/absl::nullopt, /*subject_name=*/absl::nullopt));
+  chain.emplace_back(absl::make_unique<FakeCertificate>(
+      kIntermediateKey, kRootKey, /*is_ca=*/absl::nullopt, /*pathlength=*/0,
+      /*subject_name=*/absl::nullopt));
+  chain.emplace_back(absl::make_unique<FakeCertificate>(
+      kRootKey, kRootKey, /*is_ca=*/absl::nullopt, /*pathlength=*/1,
+      /*subject_name=*/absl::nullopt));
+
+  CertificateChainVerificationCache cache(/*max_entries=*/16,
+                                          /*ttl=*/absl::Minutes(5));
+  VerificationConfig config(/*all_fields=*/false);
+
+  EXPECT_THAT(cache.VerifyCertificateChain(absl::MakeConstSpan(chain), config),
+              StatusIs(absl::StatusCode::kUnauthenticated));
+  EXPECT_THAT(cache.VerifyCertificateChain(absl::MakeConstSpan(chain), config),
+              StatusIs(absl::StatusCode::kUnauthenticated));
+}
+
+TEST(CertificateUtilTest, CertificateChainVerificationCacheKeysOnConfig) {
+  // This chain verifies successfully without the pathlength check but fails
+  // with it, so a cached success for one config must not satisfy the other.
+  CertificateInterfaceVector chain;
+  chain.emplace_back(absl::make_unique<FakeCertificate>(
+      kEndUserKey, kIntermediateKey, /*is_ca=*/absl::nullopt,
+      /*pathlength=*/absl::nullopt, /*subject_name=*/absl::nullopt));
+  chain.emplace_back(absl::make_unique<FakeCertificate>(
+      kIntermediateKey, kRootKey, /*is_ca=*/absl::nullopt, /*pathlength=*/0,
+      /*subject_name=*/absl::nullopt));
+  chain.emplace_back(absl::make_unique<FakeCertificate>(
+      kRootKey, kRootKey, /*is_ca=*/absl::nullopt, /*pathlength=*/0,
+      /*subject_name=*/absl::nullopt));
+
+  CertificateChainVerificationCache cache(/*max_entries=*/16,
+                                          /*ttl=*/absl::Minutes(5));
+
+  VerificationConfig permissive_config(/*all_fields=*/false);
+  ASYLO_EXPECT_OK(cache.VerifyCertificateChain(absl::MakeConstSpan(chain),
+                                               permissive_config));
+
+  VerificationConfig strict_config(/*all_fields=*/true);
+  EXPECT_THAT(cache.VerifyCertificateChain(absl::MakeConstSpan(chain),
+                                           strict_config),
+              StatusIs(absl::StatusCode::kUnauthenticated));
+}
+
 TEST(CertificateUtilTest, CreateCertificateInterfaceMissingFormat) {
   FakeCertificateProto cert_proto;
   cert_proto.set_subject_key(kRootKey);
@@ -826,6 +899,44 @@ TEST(CertificateUtilTest, CreateCertificateChainSuccess) {
   EXPECT_THAT(chain[0]->IsCa(), Eq(absl::nullopt));
 }
 
+TEST(CertificateUtilTest, CreateCertificateChainParallelMissingFormat) {
+  CertificateFactoryMap factory_map = CreateFactoryMap({Certificate::X509_PEM});
+  EXPECT_THAT(CreateCertificateChainParallel(factory_map,
+                                             TestCertificateChain()),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(CertificateUtilTest, CreateCertificateChainParallelMalformedCertificate) {
+  CertificateFactoryMap factory_map = CreateFactoryMap({Certificate::X509_PEM});
+  CertificateChain chain;
+  Certificate *malformed_cert = chain.add_certificates();
+  malformed_cert->set_format(Certificate::X509_PEM);
+  malformed_cert->set_data(kMalformedCertData);
+
+  EXPECT_THAT(CreateCertificateChainParallel(factory_map, chain),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(CertificateUtilTest, CreateCertificateChainParallelSuccess) {
+  CertificateFactoryMap factory_map =
+      CreateFactoryMap({Certificate::X509_PEM, Certificate::X509_DER});
+
+  CertificateInterfaceVector chain;
+  ASYLO_ASSERT_OK_AND_ASSIGN(chain, CreateCertificateChainParallel(
+                                        factory_map, TestCertificateChain()));
+  ASSERT_THAT(chain, SizeIs(3));
+
+  EXPECT_THAT(chain[2]->SubjectKeyDer(), IsOkAndHolds(kRootKey));
+  EXPECT_THAT(chain[2]->CertPathLength(), Optional(1));
+  EXPECT_THAT(chain[2]->IsCa(), Optional(true));
+  EXPECT_THAT(chain[1]->SubjectKeyDer(), IsOkAndHolds(kIntermediateKey));
+  EXPECT_THAT(chain[1]->CertPathLength(), Optional(0));
+  EXPECT_THAT(chain[1]->IsCa(), Optional(true));
+  EXPECT_THAT(chain[0]->SubjectKeyDer(), IsOkAndHolds(kEndUserKey));
+  EXPECT_THAT(chain[0]->CertPathLength(), Eq(absl::nullopt));
+  EXPECT_THAT(chain[0]->IsCa(), Eq(absl::nullopt));
+}
+
 TEST(CertificateUtilTest, GetCertificateFromPem_Success) {
   Certificate cert;
   ASYLO_ASSERT_OK_AND_ASSIGN(cert, GetCertificateFromPem(kPemCert));
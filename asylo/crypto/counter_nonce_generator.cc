@@ -0,0 +1,117 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/crypto/counter_nonce_generator.h"
+
+#include <openssl/rand.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "asylo/crypto/util/bssl_util.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+namespace {
+
+// A thread's claim on a run of counter values from one generator. The claim
+// records the generation ID of the generator it belongs to; a thread
+// alternating between generators abandons its remaining claim, and the
+// skipped values are simply never issued. Ownership is tracked by ID rather
+// than by generator address so a claim can never outlive its generator and
+// be mistaken for a claim on a later generator allocated at the same
+// address.
+struct ThreadCounterBatch {
+  uint64_t owner = 0;
+  uint64_t next = 0;
+  uint64_t end = 0;
+};
+
+thread_local ThreadCounterBatch thread_batch;
+
+// Source of generation IDs. Starts at 1 so the default-constructed batch
+// never matches a live generator.
+std::atomic<uint64_t> next_generation{1};
+
+}  // namespace
+
+constexpr size_t CounterNonceGenerator::kFixedFieldSize;
+constexpr uint64_t CounterNonceGenerator::kCounterBatchSize;
+
+StatusOr<std::unique_ptr<CounterNonceGenerator>>
+CounterNonceGenerator::CreateAesGcmNonceGenerator() {
+  uint8_t fixed_field[kFixedFieldSize];
+  if (RAND_bytes(fixed_field, kFixedFieldSize) != 1) {
+    return Status(absl::StatusCode::kInternal,
+                  absl::StrCat("RAND_bytes failed: ", BsslLastErrorString()));
+  }
+  return absl::WrapUnique<CounterNonceGenerator>(
+      new CounterNonceGenerator(fixed_field));
+}
+
+size_t CounterNonceGenerator::NonceSize() const {
+  return kFixedFieldSize + sizeof(uint64_t);
+}
+
+Status CounterNonceGenerator::NextNonce(absl::Span<uint8_t> nonce) {
+  const size_t nonce_size = NonceSize();
+  if (nonce.size() < nonce_size) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrCat("Invalid vector parameter size: ", nonce.size(),
+                               " (vector size must be >= ", nonce_size, ")"));
+  }
+
+  ThreadCounterBatch *batch = &thread_batch;
+  if (batch->owner != generation_ || batch->next == batch->end) {
+    // Claim a fresh run of counter values from the shared counter. This is
+    // the only cross-thread traffic on the generation path, paid once per
+    // kCounterBatchSize nonces.
+    uint64_t start =
+        next_counter_.fetch_add(kCounterBatchSize, std::memory_order_relaxed);
+    if (start + kCounterBatchSize < start) {
+      // The 64-bit counter space is exhausted; never reissue a value.
+      return Status(absl::StatusCode::kInternal,
+                    "Counter nonce space exhausted");
+    }
+    batch->owner = generation_;
+    batch->next = start;
+    batch->end = start + kCounterBatchSize;
+  }
+
+  const uint64_t counter = batch->next++;
+  memcpy(nonce.data(), fixed_field_, kFixedFieldSize);
+  // Big-endian counter, matching the increment ordering of SP 800-38D.
+  for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+    nonce[kFixedFieldSize + i] =
+        static_cast<uint8_t>(counter >> (8 * (sizeof(uint64_t) - 1 - i)));
+  }
+  return Status::OkStatus();
+}
+
+CounterNonceGenerator::CounterNonceGenerator(
+    const uint8_t (&fixed_field)[kFixedFieldSize])
+    : generation_(next_generation.fetch_add(1, std::memory_order_relaxed)) {
+  memcpy(fixed_field_, fixed_field, kFixedFieldSize);
+}
+
+}  // namespace asylo
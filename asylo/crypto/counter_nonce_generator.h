@@ -0,0 +1,94 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_CRYPTO_COUNTER_NONCE_GENERATOR_H_
+#define ASYLO_CRYPTO_COUNTER_NONCE_GENERATOR_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "absl/types/span.h"
+#include "asylo/crypto/nonce_generator_interface.h"
+#include "asylo/util/status.h"
+#include "asylo/util/statusor.h"
+
+namespace asylo {
+
+// CounterNonceGenerator generates unique nonces using the deterministic
+// construction of NIST SP 800-38D section 8.2.1: a random fixed field drawn
+// once at construction followed by a monotonically increasing invocation
+// counter. Generating a nonce is a copy and an increment, with no call into
+// the system RNG, so nonce generation stays off the profile of callers that
+// seal at high rates.
+//
+// Threads claim counter values in batches from one shared atomic, so
+// concurrent generation does not contend on a cache line per nonce. Counter
+// values in an abandoned batch are skipped, never reissued, so uniqueness
+// holds regardless of thread interleaving.
+//
+// Nonces from one generator never repeat. Distinct generator instances draw
+// independent fixed fields, so a key shared across many instances created by
+// this class carries a fixed-field collision risk of about n^2/2^33 for n
+// instances; give each key its own generator, or use RandomNonceGenerator
+// when one key must span many generators.
+class CounterNonceGenerator : public NonceGeneratorInterface {
+ public:
+  // Creates a NonceGenerator compliant with the standard for AES-GCM nonces:
+  // a 4-byte random fixed field and an 8-byte invocation counter. Returns a
+  // non-OK status if the fixed field could not be drawn from the system RNG.
+  static StatusOr<std::unique_ptr<CounterNonceGenerator>>
+  CreateAesGcmNonceGenerator();
+
+  // From NonceGeneratorInterface.
+
+  size_t NonceSize() const override;
+
+  Status NextNonce(absl::Span<uint8_t> nonce) override;
+
+ private:
+  // Size in bytes of the random fixed field prefixing each nonce.
+  static constexpr size_t kFixedFieldSize = 4;
+
+  // Number of counter values a thread claims from the shared counter at a
+  // time.
+  static constexpr uint64_t kCounterBatchSize = 256;
+
+  // Creates a generator with fixed field |fixed_field| producing nonces of
+  // kFixedFieldSize + 8 bytes.
+  explicit CounterNonceGenerator(const uint8_t (&fixed_field)[kFixedFieldSize]);
+
+  // The random fixed field, identical in every nonce from this generator.
+  uint8_t fixed_field_[kFixedFieldSize];
+
+  // Identity of this generator for thread-local batch ownership checks,
+  // drawn from a process-wide monotonic counter at construction. The
+  // object's address would be ABA-unsafe: a batch claimed from a destroyed
+  // generator could be mistaken for one claimed from a new generator reusing
+  // the same allocation, and the stale counter run would collide with values
+  // the new generator hands out itself.
+  const uint64_t generation_;
+
+  // The next unclaimed invocation counter value. Threads claim
+  // kCounterBatchSize values at a time.
+  std::atomic<uint64_t> next_counter_{0};
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_CRYPTO_COUNTER_NONCE_GENERATOR_H_
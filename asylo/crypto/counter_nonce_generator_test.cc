@@ -0,0 +1,157 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/crypto/counter_nonce_generator.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "asylo/test/util/status_matchers.h"
+#include "asylo/util/thread.h"
+
+namespace asylo {
+namespace {
+
+constexpr size_t kAesGcmNonceSize = 12;
+constexpr size_t kBadNonceSize = 11;
+constexpr size_t kFixedFieldSize = 4;
+
+// More nonces than one thread batch, so generation crosses batch refills.
+constexpr int kNumberOfGeneratedNonces = 1000;
+
+// Tests that NonceSize() matches the AES-GCM nonce size.
+TEST(CounterNonceGeneratorTest, CounterNonceGeneratorNonceSize) {
+  std::unique_ptr<CounterNonceGenerator> nonce_generator;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      nonce_generator, CounterNonceGenerator::CreateAesGcmNonceGenerator());
+  EXPECT_EQ(nonce_generator->NonceSize(), kAesGcmNonceSize);
+}
+
+// Tests that every nonce carries the same fixed field and that no nonce
+// repeats, including across thread-batch refills.
+TEST(CounterNonceGeneratorTest, CounterNonceGeneratorNoncesAreUnique) {
+  std::unique_ptr<CounterNonceGenerator> nonce_generator;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      nonce_generator, CounterNonceGenerator::CreateAesGcmNonceGenerator());
+  std::vector<uint8_t> nonce(kAesGcmNonceSize);
+  ASYLO_ASSERT_OK(nonce_generator->NextNonce(absl::MakeSpan(nonce)));
+  const std::string fixed_field(nonce.cbegin(),
+                                nonce.cbegin() + kFixedFieldSize);
+
+  absl::flat_hash_set<std::string> generated_nonces;
+  generated_nonces.emplace(nonce.cbegin(), nonce.cend());
+  for (int i = 1; i < kNumberOfGeneratedNonces; i++) {
+    ASYLO_ASSERT_OK(nonce_generator->NextNonce(absl::MakeSpan(nonce)));
+    EXPECT_EQ(std::string(nonce.cbegin(), nonce.cbegin() + kFixedFieldSize),
+              fixed_field);
+    EXPECT_TRUE(
+        generated_nonces.emplace(nonce.cbegin(), nonce.cend()).second);
+  }
+}
+
+// Tests that nonces stay unique when generated concurrently from several
+// threads, each claiming counter batches from the shared counter.
+TEST(CounterNonceGeneratorTest, CounterNonceGeneratorThreadedUniqueness) {
+  constexpr int kNumThreads = 4;
+  std::unique_ptr<CounterNonceGenerator> nonce_generator;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      nonce_generator, CounterNonceGenerator::CreateAesGcmNonceGenerator());
+
+  absl::Mutex mu;
+  absl::flat_hash_set<std::string> generated_nonces;
+  std::vector<Thread> threads;
+  threads.reserve(kNumThreads);
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&nonce_generator, &mu, &generated_nonces] {
+      std::vector<uint8_t> nonce(kAesGcmNonceSize);
+      for (int i = 0; i < kNumberOfGeneratedNonces; i++) {
+        ASYLO_ASSERT_OK(nonce_generator->NextNonce(absl::MakeSpan(nonce)));
+        absl::MutexLock lock(&mu);
+        EXPECT_TRUE(
+            generated_nonces.emplace(nonce.cbegin(), nonce.cend()).second);
+      }
+    });
+  }
+  for (Thread &thread : threads) {
+    thread.Join();
+  }
+  EXPECT_EQ(generated_nonces.size(), kNumThreads * kNumberOfGeneratedNonces);
+}
+
+// Tests that a thread's unexhausted batch from a destroyed generator is
+// never honored by a successor generator - the successor is likely to be
+// allocated at the same address, and a stale counter run claimed from the
+// old generator must not resurface as issued values of the new one.
+TEST(CounterNonceGeneratorTest, CounterNonceGeneratorGeneratorChurn) {
+  constexpr int kGenerations = 8;
+  std::vector<uint8_t> nonce(kAesGcmNonceSize);
+  for (int generation = 0; generation < kGenerations; generation++) {
+    std::unique_ptr<CounterNonceGenerator> nonce_generator;
+    ASYLO_ASSERT_OK_AND_ASSIGN(
+        nonce_generator, CounterNonceGenerator::CreateAesGcmNonceGenerator());
+
+    absl::flat_hash_set<std::string> generated_nonces;
+    for (int i = 0; i < kNumberOfGeneratedNonces; i++) {
+      ASYLO_ASSERT_OK(nonce_generator->NextNonce(absl::MakeSpan(nonce)));
+      EXPECT_TRUE(
+          generated_nonces.emplace(nonce.cbegin(), nonce.cend()).second);
+    }
+    // The generator dies here with this thread's last batch unexhausted.
+  }
+}
+
+// Tests that two generators draw distinct fixed fields.
+TEST(CounterNonceGeneratorTest, CounterNonceGeneratorIndependentFixedFields) {
+  std::unique_ptr<CounterNonceGenerator> first;
+  std::unique_ptr<CounterNonceGenerator> second;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      first, CounterNonceGenerator::CreateAesGcmNonceGenerator());
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      second, CounterNonceGenerator::CreateAesGcmNonceGenerator());
+
+  std::vector<uint8_t> first_nonce(kAesGcmNonceSize);
+  std::vector<uint8_t> second_nonce(kAesGcmNonceSize);
+  ASYLO_ASSERT_OK(first->NextNonce(absl::MakeSpan(first_nonce)));
+  ASYLO_ASSERT_OK(second->NextNonce(absl::MakeSpan(second_nonce)));
+  // A 2^-32 flake is acceptable here.
+  EXPECT_NE(
+      std::string(first_nonce.cbegin(), first_nonce.cbegin() + kFixedFieldSize),
+      std::string(second_nonce.cbegin(),
+                  second_nonce.cbegin() + kFixedFieldSize));
+}
+
+// Tests that NextNonce() rejects an undersized output span.
+TEST(CounterNonceGeneratorTest, CounterNonceGeneratorIncorrectNonceSize) {
+  std::unique_ptr<CounterNonceGenerator> nonce_generator;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      nonce_generator, CounterNonceGenerator::CreateAesGcmNonceGenerator());
+  std::vector<uint8_t> nonce(kBadNonceSize);
+  EXPECT_THAT(nonce_generator->NextNonce(absl::MakeSpan(nonce)),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace asylo
@@ -177,17 +177,25 @@ Status VerifyEcdsa(ByteContainerView digest, ByteContainerView signature,
 
 Status VerifyEcdsaWithRS(ByteContainerView r, ByteContainerView s,
                          ByteContainerView digest, const EC_KEY *public_key) {
-  bssl::UniquePtr<BIGNUM> r_bignum;
-  ASYLO_ASSIGN_OR_RETURN(r_bignum, BignumFromBigEndianBytes(r));
-  bssl::UniquePtr<BIGNUM> s_bignum;
-  ASYLO_ASSIGN_OR_RETURN(s_bignum, BignumFromBigEndianBytes(s));
-
   bssl::UniquePtr<ECDSA_SIG> sig(ECDSA_SIG_new());
-  if (ECDSA_SIG_set0(sig.get(), r_bignum.release(), s_bignum.release()) != 1) {
+  if (sig == nullptr) {
     return Status(absl::StatusCode::kInternal, BsslLastErrorString());
   }
 
-  if (ECDSA_do_verify(digest.data(), digest.size(), sig.get(), public_key) !=
+  return VerifyEcdsaWithRS(r, s, digest, public_key, sig.get());
+}
+
+Status VerifyEcdsaWithRS(ByteContainerView r, ByteContainerView s,
+                         ByteContainerView digest, const EC_KEY *public_key,
+                         ECDSA_SIG *scratch_sig) {
+  // Parse |r| and |s| directly into the BIGNUMs already owned by
+  // |scratch_sig| (BoringSSL declares struct ecdsa_sig_st publicly). After
+  // the first verification through a given scratch signature the limb
+  // buffers are already wide enough, so parsing allocates nothing.
+  ASYLO_RETURN_IF_ERROR(BignumFromBigEndianBytesInPlace(r, scratch_sig->r));
+  ASYLO_RETURN_IF_ERROR(BignumFromBigEndianBytesInPlace(s, scratch_sig->s));
+
+  if (ECDSA_do_verify(digest.data(), digest.size(), scratch_sig, public_key) !=
       1) {
     return Status(absl::StatusCode::kInternal, BsslLastErrorString());
   }
@@ -42,6 +42,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "asylo/crypto/algorithms.pb.h"
 #include "asylo/crypto/bignum_util.h"
 #include "asylo/crypto/keys.pb.h"
@@ -127,6 +128,12 @@ Status VerifyEcdsa(ByteContainerView digest, ByteContainerView signature,
                    const EC_KEY *public_key);
 Status VerifyEcdsaWithRS(ByteContainerView r, ByteContainerView s,
                          ByteContainerView digest, const EC_KEY *public_key);
+// Same as above, but reuses |scratch_sig| instead of allocating a signature
+// object per call. |scratch_sig| must have been created by ECDSA_SIG_new();
+// its R and S values are replaced.
+Status VerifyEcdsaWithRS(ByteContainerView r, ByteContainerView s,
+                         ByteContainerView digest, const EC_KEY *public_key,
+                         ECDSA_SIG *scratch_sig);
 
 // Miscellaneous Boring SSL Helper functions.
 int GetEcCurveNid(const EC_KEY *key);
@@ -213,10 +220,23 @@ class EcdsaVerifyingKey : public VerifyingKey {
   Status Verify(ByteContainerView message,
                 const Signature &signature) const override;
 
+  // Verifies that each element of |signatures| is a valid signature of the
+  // message at the same index in |messages|. Unlike repeated calls to
+  // Verify(), the hash context and the BoringSSL signature object are
+  // allocated once and reused across the whole batch, which matters when
+  // checking many signatures with the same key. Returns a non-OK Status
+  // identifying the index of the first pair that fails.
+  Status VerifyBatch(absl::Span<const ByteContainerView> messages,
+                     absl::Span<const Signature> signatures) const;
+
  private:
   explicit EcdsaVerifyingKey(bssl::UniquePtr<EC_KEY> public_key)
       : public_key_(std::move(public_key)) {}
 
+  // Checks that |signature| uses this key's signature scheme and carries
+  // correctly-sized ECDSA R and S values.
+  static Status CheckSignatureFormat(const Signature &signature);
+
   // An ECDSA public key.
   bssl::UniquePtr<EC_KEY> public_key_;
 };
@@ -310,6 +330,13 @@ class EcdsaSigningKey : public SigningKey {
     return Status::OkStatus();
   }
 
+  // Signs a hash of each element of |messages| and appends the resulting
+  // signatures to |signatures| in the same order. The hash context is created
+  // once and reused across the whole batch. On failure, |signatures| is left
+  // unchanged.
+  Status SignBatch(absl::Span<const ByteContainerView> messages,
+                   std::vector<Signature> *signatures) const;
+
   Status SignX509(X509 *x509) const override {
     return BsslSignX509<Hash>(x509, private_key_.get());
   }
@@ -414,11 +441,26 @@ template <SignatureScheme kSignatureScheme, int kNid, int32_t kCoordinateSize,
           class Hash>
 Status EcdsaVerifyingKey<kSignatureScheme, kNid, kCoordinateSize, Hash>::Verify(
     ByteContainerView message, const Signature &signature) const {
-  if (signature.signature_scheme() != GetSignatureScheme()) {
+  ASYLO_RETURN_IF_ERROR(CheckSignatureFormat(signature));
+
+  std::vector<uint8_t> digest;
+  ASYLO_RETURN_IF_ERROR(DoHash<Hash>(message, &digest));
+
+  return VerifyEcdsaWithRS(signature.ecdsa_signature().r(),
+                           signature.ecdsa_signature().s(), digest,
+                           public_key_.get());
+}
+
+template <SignatureScheme kSignatureScheme, int kNid, int32_t kCoordinateSize,
+          class Hash>
+Status EcdsaVerifyingKey<kSignatureScheme, kNid, kCoordinateSize,
+                         Hash>::CheckSignatureFormat(const Signature
+                                                         &signature) {
+  if (signature.signature_scheme() != kSignatureScheme) {
     return Status(
         absl::StatusCode::kInvalidArgument,
         absl::StrFormat("Signature scheme should be %s, instead is %s",
-                        ProtoEnumValueName(GetSignatureScheme()),
+                        ProtoEnumValueName(kSignatureScheme),
                         ProtoEnumValueName(signature.signature_scheme())));
   }
 
@@ -440,12 +482,50 @@ Status EcdsaVerifyingKey<kSignatureScheme, kNid, kCoordinateSize, Hash>::Verify(
                                kCoordinateSize, " bytes"));
   }
 
+  return Status::OkStatus();
+}
+
+template <SignatureScheme kSignatureScheme, int kNid, int32_t kCoordinateSize,
+          class Hash>
+Status
+EcdsaVerifyingKey<kSignatureScheme, kNid, kCoordinateSize, Hash>::VerifyBatch(
+    absl::Span<const ByteContainerView> messages,
+    absl::Span<const Signature> signatures) const {
+  if (messages.size() != signatures.size()) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrCat("Number of messages (", messages.size(),
+                               ") does not match number of signatures (",
+                               signatures.size(), ")"));
+  }
+
+  bssl::UniquePtr<ECDSA_SIG> scratch_sig(ECDSA_SIG_new());
+  if (scratch_sig == nullptr) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
+
+  Hash hasher;
   std::vector<uint8_t> digest;
-  ASYLO_RETURN_IF_ERROR(DoHash<Hash>(message, &digest));
+  for (size_t i = 0; i < messages.size(); ++i) {
+    const Signature &signature = signatures[i];
+    Status status = CheckSignatureFormat(signature);
+    if (status.ok()) {
+      hasher.Init();
+      hasher.Update(messages[i]);
+      status = hasher.CumulativeHash(&digest);
+    }
+    if (status.ok()) {
+      status = VerifyEcdsaWithRS(signature.ecdsa_signature().r(),
+                                 signature.ecdsa_signature().s(), digest,
+                                 public_key_.get(), scratch_sig.get());
+    }
+    if (!status.ok()) {
+      return Status(status.code(),
+                    absl::StrCat("Failed to verify signature at index ", i,
+                                 ": ", status.message()));
+    }
+  }
 
-  return VerifyEcdsaWithRS(signature.ecdsa_signature().r(),
-                           signature.ecdsa_signature().s(), digest,
-                           public_key_.get());
+  return Status::OkStatus();
 }
 
 // EcdsaSigningKey methods CreateFromProto, Create, and methods from SigningKey.
@@ -510,6 +590,32 @@ StatusOr<EccCurvePoint<kCoordinateSize>> EcdsaSigningKey<
   return public_key;
 }
 
+template <SignatureScheme kSignatureScheme, int kNid, int32_t kCoordinateSize,
+          class Hash>
+Status
+EcdsaSigningKey<kSignatureScheme, kNid, kCoordinateSize, Hash>::SignBatch(
+    absl::Span<const ByteContainerView> messages,
+    std::vector<Signature> *signatures) const {
+  std::vector<Signature> batch(messages.size());
+
+  Hash hasher;
+  std::vector<uint8_t> digest;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    hasher.Init();
+    hasher.Update(messages[i]);
+    ASYLO_RETURN_IF_ERROR(hasher.CumulativeHash(&digest));
+
+    ASYLO_RETURN_IF_ERROR(EcdsaSignDigestAndSetRS(kSignatureScheme, digest,
+                                                  private_key_.get(),
+                                                  kCoordinateSize, &batch[i]));
+  }
+
+  for (Signature &signature : batch) {
+    signatures->push_back(std::move(signature));
+  }
+  return Status::OkStatus();
+}
+
 }  // namespace internal
 }  // namespace asylo
 
@@ -444,6 +444,43 @@ TYPED_TEST_P(VerifyingKeyTest, VerifySignatureOverloadSuccess) {
       absl::HexStringToBytes(this->test_message_hex_), signature));
 }
 
+// Verify that VerifyBatch() verifies multiple valid (message, signature)
+// pairs with the same key.
+TYPED_TEST_P(VerifyingKeyTest, VerifyBatchSuccess) {
+  std::string valid_message(absl::HexStringToBytes(this->test_message_hex_));
+  std::vector<ByteContainerView> messages(3, ByteContainerView(valid_message));
+  std::vector<Signature> signatures(
+      3, this->CreateValidSignatureForTestMessage());
+
+  std::unique_ptr<typename TestFixture::VerifyingKeyType> verifying_key;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      verifying_key,
+      TestFixture::VerifyingKeyType::CreateFromPem(this->verifying_key_pem_));
+
+  ASYLO_EXPECT_OK(verifying_key->VerifyBatch(messages, signatures));
+}
+
+// Verify that VerifyBatch() fails when one pair in the batch is invalid, and
+// when the numbers of messages and signatures do not match.
+TYPED_TEST_P(VerifyingKeyTest, VerifyBatchFailsWithInvalidSignature) {
+  std::string valid_message(absl::HexStringToBytes(this->test_message_hex_));
+  std::vector<ByteContainerView> messages(3, ByteContainerView(valid_message));
+  std::vector<Signature> signatures(
+      3, this->CreateValidSignatureForTestMessage());
+  signatures[1].mutable_ecdsa_signature()->mutable_r()->back() ^= 1;
+
+  std::unique_ptr<typename TestFixture::VerifyingKeyType> verifying_key;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      verifying_key,
+      TestFixture::VerifyingKeyType::CreateFromPem(this->verifying_key_pem_));
+
+  EXPECT_THAT(verifying_key->VerifyBatch(messages, signatures), Not(IsOk()));
+
+  messages.pop_back();
+  EXPECT_THAT(verifying_key->VerifyBatch(messages, signatures),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 // Verify that operator== fails with a different VerifyingKey implementation.
 TYPED_TEST_P(VerifyingKeyTest, EqualsFailsWithDifferentClassKeys) {
   FakeVerifyingKey other_verifying_key(this->sig_scheme_,
@@ -550,6 +587,7 @@ REGISTER_TYPED_TEST_SUITE_P(
     VerifyWithMissingEcdsaSignatureFails, VerifyWithMissingRFieldFails,
     VerifyWithMissingSFieldFails, VerifyWithShortRFieldFails,
     VerifyWithLongSFieldFails, VerifySignatureOverloadSuccess,
+    VerifyBatchSuccess, VerifyBatchFailsWithInvalidSignature,
     EqualsFailsWithDifferentClassKeys, NotEqualsPassesWithDifferentClassKeys,
     EqualsSucceedsWithEquivalentKeys, EqualsFailsWithDifferentKeys,
     NotEqualsFailsWithEquivalentKeys, NotEqualsSucceedsWithDifferentKeys,
@@ -785,6 +823,37 @@ TYPED_TEST_P(SigningKeyTest, SignAndVerifySignatureOverloads) {
   EXPECT_THAT(verifying_key->Verify(message, signature), Not(IsOk()));
 }
 
+// Verify that SignBatch() produces signatures that VerifyBatch() accepts, and
+// that the batch is rejected if one entry is corrupted.
+TYPED_TEST_P(SigningKeyTest, SignBatchAndVerifyBatch) {
+  constexpr int kBatchSize = 8;
+  std::vector<std::vector<uint8_t>> message_storage(kBatchSize);
+  std::vector<ByteContainerView> messages;
+  for (std::vector<uint8_t> &message : message_storage) {
+    message.resize(this->message_size_);
+    ASSERT_TRUE(RAND_bytes(message.data(), this->message_size_));
+    messages.push_back(ByteContainerView(message));
+  }
+
+  std::vector<Signature> signatures;
+  ASYLO_ASSERT_OK(this->signing_key_->SignBatch(messages, &signatures));
+  ASSERT_EQ(signatures.size(), kBatchSize);
+
+  typename TestFixture::CurvePointType public_key_point;
+  ASYLO_ASSERT_OK_AND_ASSIGN(public_key_point,
+                             this->signing_key_->GetPublicKeyPoint());
+
+  std::unique_ptr<typename TestFixture::VerifyingKeyType> verifying_key;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      verifying_key, TestFixture::VerifyingKeyType::Create(public_key_point));
+
+  ASYLO_EXPECT_OK(verifying_key->VerifyBatch(messages, signatures));
+
+  // Ensure that the batch is not verifiable if one signature is corrupted.
+  signatures.back().mutable_ecdsa_signature()->mutable_s()->back() ^= 1;
+  EXPECT_THAT(verifying_key->VerifyBatch(messages, signatures), Not(IsOk()));
+}
+
 // Verify that SerializeToDer() and CreateFromDer() from a serialized key are
 // working correctly, and that an EcdsaSigningKey restored from a
 // serialized version of another EcdsaSigningKey can verify a
@@ -882,7 +951,8 @@ REGISTER_TYPED_TEST_SUITE_P(
     SignatureScheme, CreateSigningKeyFromPemMatchesDer,
     CreateSigningKeyFromDerMatchesPem, SerializeToKeyProtoUnknownFailure,
     SerializeToKeyProtoSuccess, SignAndVerify, SignAndVerifySignatureOverloads,
-    SerializeToDerAndRestoreSigningKey, RestoreFromAndSerializeToDerSigningKey,
+    SignBatchAndVerifyBatch, SerializeToDerAndRestoreSigningKey,
+    RestoreFromAndSerializeToDerSigningKey,
     CreateSigningKeyFromInvalidDerSerializationFails,
     CreateSigningKeyFromInvalidPemSerializationFails,
     ExportAndImportRawPublicKey);
@@ -0,0 +1,127 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Benchmarks for RSA-OAEP decryption, comparing one-at-a-time Decrypt calls
+// against DecryptBatch at several thread counts. The workload models key
+// distribution, where one enclave unwraps many independently encrypted keys
+// under the same RSA private key.
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "asylo/crypto/algorithms.pb.h"
+#include "asylo/crypto/asymmetric_encryption_key.h"
+#include "asylo/crypto/rsa_oaep_encryption_key.h"
+#include "asylo/crypto/util/byte_container_view.h"
+#include "asylo/util/cleansing_types.h"
+
+namespace asylo {
+namespace {
+
+// Number of ciphertexts decrypted per batch iteration.
+constexpr int kBatchSize = 64;
+
+// Size of each wrapped key.
+constexpr size_t kMessageSize = 32;
+
+// Returns a process-wide RSA-3072 decryption key. Key generation is slow, so
+// all benchmarks share one key; this also matches the key-distribution
+// workload, where every unwrap uses the same private key.
+const RsaOaepDecryptionKey *GetDecryptionKey() {
+  static const RsaOaepDecryptionKey *decryption_key = []() {
+    auto result = RsaOaepDecryptionKey::CreateRsa3072OaepDecryptionKey(
+        HashAlgorithm::SHA256);
+    return result.ok() ? result.ValueOrDie().release() : nullptr;
+  }();
+  return decryption_key;
+}
+
+// Encrypts kBatchSize distinct messages under the public half of |key|.
+bool MakeCiphertexts(const RsaOaepDecryptionKey &key,
+                     std::vector<std::vector<uint8_t>> *ciphertexts) {
+  auto encryption_key_result = key.GetEncryptionKey();
+  if (!encryption_key_result.ok()) {
+    return false;
+  }
+  std::unique_ptr<AsymmetricEncryptionKey> encryption_key =
+      std::move(encryption_key_result).ValueOrDie();
+  ciphertexts->resize(kBatchSize);
+  for (int i = 0; i < kBatchSize; ++i) {
+    std::vector<uint8_t> message(kMessageSize, static_cast<uint8_t>(i));
+    if (!encryption_key->Encrypt(message, &(*ciphertexts)[i]).ok()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Decrypts kBatchSize ciphertexts per iteration with one Decrypt call each.
+void BM_RsaOaepDecryptOneAtATime(benchmark::State &state) {
+  const RsaOaepDecryptionKey *decryption_key = GetDecryptionKey();
+  std::vector<std::vector<uint8_t>> ciphertexts;
+  if (decryption_key == nullptr ||
+      !MakeCiphertexts(*decryption_key, &ciphertexts)) {
+    state.SkipWithError("Failed to set up key and ciphertexts");
+    return;
+  }
+  CleansingVector<uint8_t> plaintext;
+  for (auto _ : state) {
+    for (const std::vector<uint8_t> &ciphertext : ciphertexts) {
+      if (!decryption_key->Decrypt(ciphertext, &plaintext).ok()) {
+        state.SkipWithError("Decrypt failed");
+        return;
+      }
+      benchmark::DoNotOptimize(plaintext.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_RsaOaepDecryptOneAtATime);
+
+// Decrypts kBatchSize ciphertexts per iteration through DecryptBatch; the
+// argument is the maximum number of worker threads.
+void BM_RsaOaepDecryptBatch(benchmark::State &state) {
+  const RsaOaepDecryptionKey *decryption_key = GetDecryptionKey();
+  std::vector<std::vector<uint8_t>> ciphertexts;
+  if (decryption_key == nullptr ||
+      !MakeCiphertexts(*decryption_key, &ciphertexts)) {
+    state.SkipWithError("Failed to set up key and ciphertexts");
+    return;
+  }
+  const std::vector<ByteContainerView> ciphertext_views(ciphertexts.begin(),
+                                                        ciphertexts.end());
+  std::vector<CleansingVector<uint8_t>> plaintexts;
+  for (auto _ : state) {
+    if (!decryption_key
+             ->DecryptBatch(ciphertext_views, state.range(0), &plaintexts)
+             .ok()) {
+      state.SkipWithError("DecryptBatch failed");
+      return;
+    }
+    benchmark::DoNotOptimize(plaintexts.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_RsaOaepDecryptBatch)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+}  // namespace
+}  // namespace asylo
+
+BENCHMARK_MAIN();
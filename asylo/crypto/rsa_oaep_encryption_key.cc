@@ -26,6 +26,10 @@
 #include <openssl/pem.h>
 #include <openssl/rsa.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
@@ -36,6 +40,7 @@
 #include "asylo/crypto/util/byte_container_view.h"
 #include "asylo/util/proto_enum_util.h"
 #include "asylo/util/status_macros.h"
+#include "asylo/util/thread.h"
 
 namespace asylo {
 namespace {
@@ -94,97 +99,95 @@ Status CheckEncryptionScheme(AsymmetricEncryptionScheme scheme) {
       absl::StrCat("Invalid encryption scheme: ", ProtoEnumValueName(scheme)));
 }
 
-// Defines a functor which performs RSA crypto with OAEP.
-class RsaOaepOperation {
- public:
-  // Encrypts data with RSA-OAEP.
-  static const RsaOaepOperation kEncrypt;
-
-  // Decrypts data with RSA-OAEP.
-  static const RsaOaepOperation kDecrypt;
-
-  // Encrypt and decrypt functions have identical signatures.
-  using InitFunc = decltype(&EVP_PKEY_encrypt_init);
-  using CryptoFunc = decltype(&EVP_PKEY_encrypt);
-
-  // Performs an BoringSSL EVP key crypto operation using an BoringSSL RSA
-  // object.
-  template <typename AllocatorT>
-  Status operator()(RSA *rsa, HashAlgorithm hash_alg, ByteContainerView input,
-                    std::vector<uint8_t, AllocatorT> *output) const {
-    const EVP_MD *md;
-    ASYLO_ASSIGN_OR_RETURN(md, GetBoringSslHash(hash_alg));
-
-    bssl::UniquePtr<EVP_PKEY> evp_key(EVP_PKEY_new());
-    if (EVP_PKEY_set1_RSA(evp_key.get(), rsa) != 1) {
-      return Status(absl::StatusCode::kInternal, BsslLastErrorString());
-    }
-
-    bssl::UniquePtr<EVP_PKEY_CTX> ctx(
-        EVP_PKEY_CTX_new(evp_key.get(), /*ENGINE e=*/nullptr));
-    if (ctx == nullptr) {
-      return Status(absl::StatusCode::kInternal, BsslLastErrorString());
-    }
-
-    if (init_func_(ctx.get()) != 1) {
-      return Status(absl::StatusCode::kInternal, BsslLastErrorString());
-    }
-    if (EVP_PKEY_CTX_set_rsa_padding(ctx.get(), RSA_PKCS1_OAEP_PADDING) != 1) {
-      return Status(absl::StatusCode::kInternal, BsslLastErrorString());
-    }
-    if (EVP_PKEY_CTX_set_rsa_oaep_md(ctx.get(), md) != 1) {
-      return Status(absl::StatusCode::kInternal, BsslLastErrorString());
-    }
+// Encrypt and decrypt functions have identical signatures.
+using OaepInitFunc = decltype(&EVP_PKEY_encrypt_init);
+using OaepCryptoFunc = decltype(&EVP_PKEY_encrypt);
+
+StatusOr<const EVP_MD *> GetBoringSslHash(HashAlgorithm hash_alg) {
+  switch (hash_alg) {
+    case HashAlgorithm::SHA_1:
+      return EVP_sha1();
+    case HashAlgorithm::SHA224:
+      return EVP_sha224();
+    case HashAlgorithm::SHA256:
+      return EVP_sha256();
+    case HashAlgorithm::SHA384:
+      return EVP_sha384();
+    case HashAlgorithm::SHA512:
+      return EVP_sha512();
+    case HashAlgorithm::UNKNOWN_HASH_ALGORITHM:
+      break;
+  }
 
-    size_t out_len = 0;
-    if (crypto_func_(ctx.get(), /*out=*/nullptr, &out_len, input.data(),
-                     input.size()) != 1) {
-      return Status(absl::StatusCode::kInternal, BsslLastErrorString());
-    }
+  return Status(
+      absl::StatusCode::kInvalidArgument,
+      absl::StrCat("Invalid hash algorithm in RSA key object: ", hash_alg));
+}
 
-    output->resize(out_len);
-    if (crypto_func_(ctx.get(), output->data(), &out_len, input.data(),
-                     input.size()) != 1) {
-      return Status(absl::StatusCode::kInternal, BsslLastErrorString());
-    }
-    output->resize(out_len);
-    return Status::OkStatus();
+// Creates an EVP key context for |rsa| configured for OAEP with |hash_alg|
+// and initialized with |init_func|. The context retains its own reference to
+// the key, and may be reused for any number of operations; reusing it
+// amortizes the per-operation setup, while BoringSSL itself caches the
+// Montgomery contexts inside |rsa| after the first private-key operation.
+StatusOr<bssl::UniquePtr<EVP_PKEY_CTX>> CreateOaepContext(
+    RSA *rsa, HashAlgorithm hash_alg, OaepInitFunc init_func) {
+  const EVP_MD *md;
+  ASYLO_ASSIGN_OR_RETURN(md, GetBoringSslHash(hash_alg));
+
+  bssl::UniquePtr<EVP_PKEY> evp_key(EVP_PKEY_new());
+  if (EVP_PKEY_set1_RSA(evp_key.get(), rsa) != 1) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
   }
 
- private:
-  InitFunc init_func_;
-  CryptoFunc crypto_func_;
-
-  static StatusOr<const EVP_MD *> GetBoringSslHash(HashAlgorithm hash_alg) {
-    switch (hash_alg) {
-      case HashAlgorithm::SHA_1:
-        return EVP_sha1();
-      case HashAlgorithm::SHA224:
-        return EVP_sha224();
-      case HashAlgorithm::SHA256:
-        return EVP_sha256();
-      case HashAlgorithm::SHA384:
-        return EVP_sha384();
-      case HashAlgorithm::SHA512:
-        return EVP_sha512();
-      case HashAlgorithm::UNKNOWN_HASH_ALGORITHM:
-        break;
-    }
+  bssl::UniquePtr<EVP_PKEY_CTX> ctx(
+      EVP_PKEY_CTX_new(evp_key.get(), /*ENGINE e=*/nullptr));
+  if (ctx == nullptr) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
 
-    return Status(
-        absl::StatusCode::kInvalidArgument,
-        absl::StrCat("Invalid hash algorithm in RSA key object: ", hash_alg));
+  if (init_func(ctx.get()) != 1) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
   }
+  if (EVP_PKEY_CTX_set_rsa_padding(ctx.get(), RSA_PKCS1_OAEP_PADDING) != 1) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
+  if (EVP_PKEY_CTX_set_rsa_oaep_md(ctx.get(), md) != 1) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
+  return std::move(ctx);
+}
 
-  RsaOaepOperation(InitFunc init_func, CryptoFunc crypto_func)
-      : init_func_(init_func), crypto_func_(crypto_func) {}
-};
+// Runs |crypto_func| on |ctx|, sizing |output| to the operation's result.
+template <typename AllocatorT>
+Status OaepCrypt(EVP_PKEY_CTX *ctx, OaepCryptoFunc crypto_func,
+                 ByteContainerView input,
+                 std::vector<uint8_t, AllocatorT> *output) {
+  size_t out_len = 0;
+  if (crypto_func(ctx, /*out=*/nullptr, &out_len, input.data(),
+                  input.size()) != 1) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
 
-const RsaOaepOperation RsaOaepOperation::kEncrypt{EVP_PKEY_encrypt_init,
-                                                  EVP_PKEY_encrypt};
+  output->resize(out_len);
+  if (crypto_func(ctx, output->data(), &out_len, input.data(), input.size()) !=
+      1) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
+  output->resize(out_len);
+  return Status::OkStatus();
+}
 
-const RsaOaepOperation RsaOaepOperation::kDecrypt{EVP_PKEY_decrypt_init,
-                                                  EVP_PKEY_decrypt};
+// Performs a one-shot BoringSSL EVP key crypto operation using a BoringSSL
+// RSA object.
+template <typename AllocatorT>
+Status RsaOaepOperation(RSA *rsa, HashAlgorithm hash_alg,
+                        OaepInitFunc init_func, OaepCryptoFunc crypto_func,
+                        ByteContainerView input,
+                        std::vector<uint8_t, AllocatorT> *output) {
+  bssl::UniquePtr<EVP_PKEY_CTX> ctx;
+  ASYLO_ASSIGN_OR_RETURN(ctx, CreateOaepContext(rsa, hash_alg, init_func));
+  return OaepCrypt(ctx.get(), crypto_func, input, output);
+}
 
 }  // namespace
 
@@ -294,8 +297,8 @@ StatusOr<std::string> RsaOaepEncryptionKey::SerializeToDer() const {
 
 Status RsaOaepEncryptionKey::Encrypt(ByteContainerView plaintext,
                                      std::vector<uint8_t> *ciphertext) const {
-  return RsaOaepOperation::kEncrypt(public_key_.get(), hash_alg_, plaintext,
-                                    ciphertext);
+  return RsaOaepOperation(public_key_.get(), hash_alg_, EVP_PKEY_encrypt_init,
+                          EVP_PKEY_encrypt, plaintext, ciphertext);
 }
 
 RsaOaepEncryptionKey::RsaOaepEncryptionKey(bssl::UniquePtr<RSA> public_key,
@@ -354,8 +357,58 @@ RsaOaepDecryptionKey::GetEncryptionKey() const {
 
 Status RsaOaepDecryptionKey::Decrypt(
     ByteContainerView ciphertext, CleansingVector<uint8_t> *plaintext) const {
-  return RsaOaepOperation::kDecrypt(private_key_.get(), hash_alg_, ciphertext,
-                                    plaintext);
+  return RsaOaepOperation(private_key_.get(), hash_alg_, EVP_PKEY_decrypt_init,
+                          EVP_PKEY_decrypt, ciphertext, plaintext);
+}
+
+Status RsaOaepDecryptionKey::DecryptBatch(
+    const std::vector<ByteContainerView> &ciphertexts, size_t max_threads,
+    std::vector<CleansingVector<uint8_t>> *plaintexts) const {
+  plaintexts->clear();
+  plaintexts->resize(ciphertexts.size());
+  if (ciphertexts.empty()) {
+    return Status::OkStatus();
+  }
+  const size_t num_threads =
+      std::max<size_t>(1, std::min(max_threads, ciphertexts.size()));
+
+  // Each worker decrypts a strided slice of the batch with a single reusable
+  // context, so the per-operation key and padding setup runs once per worker
+  // rather than once per ciphertext. The RSA key itself is safe to share
+  // across workers.
+  std::vector<Status> statuses(num_threads);
+  auto decrypt_slice = [this, &ciphertexts, plaintexts, num_threads,
+                        &statuses](size_t worker) {
+    statuses[worker] = [&]() -> Status {
+      bssl::UniquePtr<EVP_PKEY_CTX> ctx;
+      ASYLO_ASSIGN_OR_RETURN(
+          ctx, CreateOaepContext(private_key_.get(), hash_alg_,
+                                 EVP_PKEY_decrypt_init));
+      for (size_t i = worker; i < ciphertexts.size(); i += num_threads) {
+        ASYLO_RETURN_IF_ERROR(OaepCrypt(ctx.get(), EVP_PKEY_decrypt,
+                                        ciphertexts[i], &(*plaintexts)[i]));
+      }
+      return Status::OkStatus();
+    }();
+  };
+
+  if (num_threads == 1) {
+    decrypt_slice(0);
+  } else {
+    std::vector<Thread> threads;
+    threads.reserve(num_threads);
+    for (size_t worker = 0; worker < num_threads; ++worker) {
+      threads.emplace_back(decrypt_slice, worker);
+    }
+    for (Thread &thread : threads) {
+      thread.Join();
+    }
+  }
+
+  for (const Status &status : statuses) {
+    ASYLO_RETURN_IF_ERROR(status);
+  }
+  return Status::OkStatus();
 }
 
 RsaOaepDecryptionKey::RsaOaepDecryptionKey(bssl::UniquePtr<RSA> private_key,
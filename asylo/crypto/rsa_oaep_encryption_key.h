@@ -120,6 +120,16 @@ class RsaOaepDecryptionKey : public AsymmetricDecryptionKey {
   Status Decrypt(ByteContainerView ciphertext,
                  CleansingVector<uint8_t> *plaintext) const override;
 
+  // Decrypts every ciphertext in |ciphertexts| into the corresponding entry
+  // of |plaintexts|. The per-operation key and padding setup is shared across
+  // the batch rather than repeated per ciphertext, and decryption is fanned
+  // out over up to |max_threads| threads (capped at the batch size; values of
+  // 0 or 1 decrypt on the calling thread). Returns the first error
+  // encountered; on error, the contents of |plaintexts| are unspecified.
+  Status DecryptBatch(const std::vector<ByteContainerView> &ciphertexts,
+                      size_t max_threads,
+                      std::vector<CleansingVector<uint8_t>> *plaintexts) const;
+
  private:
   RsaOaepDecryptionKey(bssl::UniquePtr<RSA> private_key,
                        HashAlgorithm hash_alg);
@@ -367,6 +367,61 @@ TEST(RsaOaepEncryptionKeyTest, DecryptInvalidInputFails) {
               StatusIs(absl::StatusCode::kInternal));
 }
 
+TEST(RsaOaepEncryptionKeyTest, DecryptBatchSuccess) {
+  std::unique_ptr<RsaOaepDecryptionKey> decryption_key;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      decryption_key, CreateDecryptionKeyFromTestDer(HashAlgorithm::SHA256));
+
+  std::unique_ptr<AsymmetricEncryptionKey> encryption_key;
+  ASYLO_ASSERT_OK_AND_ASSIGN(encryption_key,
+                             decryption_key->GetEncryptionKey());
+
+  constexpr size_t kBatchSize = 5;
+  std::vector<std::string> messages;
+  std::vector<std::vector<uint8_t>> ciphertexts(kBatchSize);
+  std::vector<ByteContainerView> ciphertext_views;
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    messages.push_back(std::string(kPlaintext) + std::to_string(i));
+    ASYLO_ASSERT_OK(encryption_key->Encrypt(messages[i], &ciphertexts[i]));
+    ciphertext_views.emplace_back(ciphertexts[i]);
+  }
+
+  // The result must be the same whether the batch is decrypted on the calling
+  // thread or fanned out over multiple threads.
+  for (size_t max_threads : {1, 4}) {
+    std::vector<CleansingVector<uint8_t>> plaintexts;
+    ASYLO_ASSERT_OK(decryption_key->DecryptBatch(ciphertext_views, max_threads,
+                                                 &plaintexts));
+    ASSERT_THAT(plaintexts.size(), Eq(kBatchSize));
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      EXPECT_THAT(plaintexts[i], ElementsAreArray(messages[i]));
+    }
+  }
+}
+
+TEST(RsaOaepEncryptionKeyTest, DecryptBatchInvalidInputFails) {
+  std::unique_ptr<RsaOaepDecryptionKey> decryption_key;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      decryption_key, CreateDecryptionKeyFromTestDer(HashAlgorithm::SHA256));
+
+  std::unique_ptr<AsymmetricEncryptionKey> encryption_key;
+  ASYLO_ASSERT_OK_AND_ASSIGN(encryption_key,
+                             decryption_key->GetEncryptionKey());
+
+  std::vector<std::vector<uint8_t>> ciphertexts(2);
+  ASYLO_ASSERT_OK(encryption_key->Encrypt(kPlaintext, &ciphertexts[0]));
+  ASYLO_ASSERT_OK(encryption_key->Encrypt(kPlaintext, &ciphertexts[1]));
+
+  // Flip a bit to make one ciphertext in the batch invalid.
+  ciphertexts[1][0] ^= 1;
+  std::vector<ByteContainerView> ciphertext_views(ciphertexts.begin(),
+                                                  ciphertexts.end());
+  std::vector<CleansingVector<uint8_t>> plaintexts;
+  EXPECT_THAT(decryption_key->DecryptBatch(ciphertext_views, /*max_threads=*/2,
+                                           &plaintexts),
+              StatusIs(absl::StatusCode::kInternal));
+}
+
 TEST(RsaOaepEncryptionKeyTest, CreateRsa3072OaepDecryptionKeySuccess) {
   std::unique_ptr<AsymmetricDecryptionKey> decryption_key;
   ASYLO_ASSERT_OK_AND_ASSIGN(
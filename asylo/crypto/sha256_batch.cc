@@ -0,0 +1,85 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/crypto/sha256_batch.h"
+
+#include <openssl/sha.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "asylo/crypto/sha256_hash.h"
+#include "asylo/crypto/util/bssl_util.h"
+#include "asylo/crypto/util/byte_container_view.h"
+#include "asylo/util/status.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+namespace {
+
+// Hashes |message| into |digest_data|, which must hold kSha256DigestLength
+// bytes. SHA256() routes through BoringSSL's runtime CPU dispatch, so the
+// SHA-extension compression function is used when available. The global-scope
+// qualification keeps the call from resolving to the HashAlgorithm::SHA256
+// proto enumerator, which is also visible here as asylo::SHA256.
+Status Sha256Digest(ByteContainerView message, uint8_t *digest_data) {
+  if (::SHA256(message.data(), message.size(), digest_data) == nullptr) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
+  return Status::OkStatus();
+}
+
+}  // namespace
+
+Status Sha256HashOneShot(ByteContainerView message,
+                         std::vector<uint8_t> *digest) {
+  digest->resize(kSha256DigestLength);
+  return Sha256Digest(message, digest->data());
+}
+
+Status Sha256HashMultiPart(absl::Span<const ByteContainerView> parts,
+                           std::vector<uint8_t> *digest) {
+  SHA256_CTX context;
+  if (SHA256_Init(&context) != 1) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
+  for (ByteContainerView part : parts) {
+    if (SHA256_Update(&context, part.data(), part.size()) != 1) {
+      return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+    }
+  }
+  digest->resize(kSha256DigestLength);
+  if (SHA256_Final(digest->data(), &context) != 1) {
+    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
+  }
+  return Status::OkStatus();
+}
+
+Status Sha256HashBatch(absl::Span<const ByteContainerView> messages,
+                       std::vector<std::vector<uint8_t>> *digests) {
+  digests->resize(messages.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    (*digests)[i].resize(kSha256DigestLength);
+    ASYLO_RETURN_IF_ERROR(Sha256Digest(messages[i], (*digests)[i].data()));
+  }
+  return Status::OkStatus();
+}
+
+}  // namespace asylo
@@ -0,0 +1,60 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_CRYPTO_SHA256_BATCH_H_
+#define ASYLO_CRYPTO_SHA256_BATCH_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "asylo/crypto/util/byte_container_view.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+
+// One-shot and batch SHA-256 hashing for workloads that digest many small,
+// independent messages, such as attestation verification. Both entry points
+// hash through BoringSSL's low-level SHA-256, which dispatches at runtime to
+// the hardware-accelerated (x86 SHA extension) compression function when the
+// CPU provides one, and neither allocates or tears down an EVP context per
+// message the way a fresh Sha256Hash does.
+
+// Writes the SHA-256 digest of |message| to |digest|. Returns a non-OK status
+// on failure.
+Status Sha256HashOneShot(ByteContainerView message,
+                         std::vector<uint8_t> *digest);
+
+// Writes the SHA-256 digest of the concatenation of |parts| to |digest|. The
+// parts are hashed in order through one streaming context, so callers hashing
+// a message composed of discontiguous spans (e.g. a certificate chain's
+// length-prefixed fields) need not assemble them into an intermediate buffer.
+// Returns a non-OK status on failure.
+Status Sha256HashMultiPart(absl::Span<const ByteContainerView> parts,
+                           std::vector<uint8_t> *digest);
+
+// Writes the SHA-256 digest of each entry of |messages| to the corresponding
+// entry of |digests|, resizing |digests| to match. The messages are
+// independent - this is not a cumulative hash over the batch. Returns a
+// non-OK status on failure.
+Status Sha256HashBatch(absl::Span<const ByteContainerView> messages,
+                       std::vector<std::vector<uint8_t>> *digests);
+
+}  // namespace asylo
+
+#endif  // ASYLO_CRYPTO_SHA256_BATCH_H_
@@ -0,0 +1,106 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/crypto/sha256_batch.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/strings/escaping.h"
+#include "absl/types/span.h"
+#include "asylo/crypto/sha256_hash.h"
+#include "asylo/crypto/util/byte_container_view.h"
+#include "asylo/test/util/status_matchers.h"
+
+namespace asylo {
+namespace {
+
+// NIST test vector for SHA-256 of "abc".
+constexpr char kAbcDigestHex[] =
+    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+
+TEST(Sha256BatchTest, OneShotMatchesTestVector) {
+  std::vector<uint8_t> digest;
+  ASYLO_ASSERT_OK(Sha256HashOneShot(ByteContainerView("abc", 3), &digest));
+  EXPECT_EQ(absl::BytesToHexString(absl::string_view(
+                reinterpret_cast<const char *>(digest.data()), digest.size())),
+            kAbcDigestHex);
+}
+
+TEST(Sha256BatchTest, OneShotMatchesSha256Hash) {
+  const std::string message = "attestation assertion payload";
+
+  Sha256Hash reference;
+  reference.Update(message);
+  std::vector<uint8_t> expected;
+  ASYLO_ASSERT_OK(reference.CumulativeHash(&expected));
+
+  std::vector<uint8_t> digest;
+  ASYLO_ASSERT_OK(Sha256HashOneShot(message, &digest));
+  EXPECT_EQ(digest, expected);
+}
+
+TEST(Sha256BatchTest, EmptyBatchProducesNoDigests) {
+  std::vector<std::vector<uint8_t>> digests(3);
+  ASYLO_ASSERT_OK(
+      Sha256HashBatch(absl::Span<const ByteContainerView>(), &digests));
+  EXPECT_TRUE(digests.empty());
+}
+
+TEST(Sha256BatchTest, MultiPartMatchesConcatenation) {
+  const std::vector<std::string> parts = {"a", "b", "", "c"};
+  std::vector<ByteContainerView> views(parts.begin(), parts.end());
+
+  std::vector<uint8_t> multi_part_digest;
+  ASYLO_ASSERT_OK(Sha256HashMultiPart(views, &multi_part_digest));
+
+  std::vector<uint8_t> expected;
+  ASYLO_ASSERT_OK(Sha256HashOneShot(ByteContainerView("abc", 3), &expected));
+  EXPECT_EQ(multi_part_digest, expected);
+}
+
+TEST(Sha256BatchTest, MultiPartOfNoPartsMatchesEmptyMessage) {
+  std::vector<uint8_t> multi_part_digest;
+  ASYLO_ASSERT_OK(Sha256HashMultiPart(absl::Span<const ByteContainerView>(),
+                                      &multi_part_digest));
+
+  std::vector<uint8_t> expected;
+  ASYLO_ASSERT_OK(Sha256HashOneShot(ByteContainerView("", 0), &expected));
+  EXPECT_EQ(multi_part_digest, expected);
+}
+
+TEST(Sha256BatchTest, BatchMatchesPerMessageHashes) {
+  const std::vector<std::string> messages = {"", "a", "abc",
+                                             std::string(1000, 'q')};
+  std::vector<ByteContainerView> views(messages.begin(), messages.end());
+
+  std::vector<std::vector<uint8_t>> digests;
+  ASYLO_ASSERT_OK(Sha256HashBatch(views, &digests));
+  ASSERT_EQ(digests.size(), messages.size());
+
+  for (size_t i = 0; i < messages.size(); ++i) {
+    std::vector<uint8_t> expected;
+    ASYLO_ASSERT_OK(Sha256HashOneShot(views[i], &expected));
+    EXPECT_EQ(digests[i], expected) << "message " << i;
+  }
+}
+
+}  // namespace
+}  // namespace asylo
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/types/span.h"
 #include "asylo/crypto/hash_interface.h"
 #include "asylo/crypto/sha256_hash.pb.h"
 #include "asylo/crypto/util/bssl_util.h"
@@ -45,7 +46,11 @@ namespace asylo {
 template <typename HashOptions>
 class ShaHash : public HashInterface {
  public:
-  ShaHash() : context_(CHECK_NOTNULL(EVP_MD_CTX_new())) { Init(); }
+  ShaHash()
+      : context_(CHECK_NOTNULL(EVP_MD_CTX_new())),
+        snapshot_context_(CHECK_NOTNULL(EVP_MD_CTX_new())) {
+    Init();
+  }
 
   // From HashInterface.
   HashAlgorithm GetHashAlgorithm() const override {
@@ -58,10 +63,29 @@ class ShaHash : public HashInterface {
   }
   Status CumulativeHash(std::vector<uint8_t>* digest) const override;
 
+  // Re-initializes the context and writes the digest of the concatenation of
+  // |parts| to |digest|. Equivalent to Init(), one Update() per part, and
+  // CumulativeHash(), so callers that hash a sequence of discontiguous spans
+  // (e.g. length-prefixed certificate fields) can reuse one hash object
+  // without assembling the input into a contiguous buffer.
+  Status HashMultiPart(absl::Span<const ByteContainerView> parts,
+                       std::vector<uint8_t>* digest) {
+    Init();
+    for (ByteContainerView part : parts) {
+      Update(part);
+    }
+    return CumulativeHash(digest);
+  }
+
   const EVP_MD* GetBsslHashFunction() { return HashOptions::EvpMd(); }
 
  private:
   bssl::UniquePtr<EVP_MD_CTX> context_;
+
+  // A scratch context used by CumulativeHash to finalize a copy of |context_|.
+  // The context is allocated once and reused across calls so that computing an
+  // intermediate digest does not allocate.
+  mutable bssl::UniquePtr<EVP_MD_CTX> snapshot_context_;
 };
 
 template <typename HashOptions>
@@ -75,19 +99,18 @@ Status ShaHash<HashOptions>::CumulativeHash(
     std::vector<uint8_t>* digest) const {
   // Do not finalize the internally stored hash context. Instead, finalize a
   // copy of the current context so that the current context can be updated in
-  // future calls to Update.
-  bssl::UniquePtr<EVP_MD_CTX> context_snapshot(EVP_MD_CTX_new());
-  if (context_snapshot == nullptr) {
-    return Status(absl::StatusCode::kInternal, BsslLastErrorString());
-  }
-
-  if (EVP_MD_CTX_copy_ex(context_snapshot.get(), context_.get()) != 1) {
+  // future calls to Update. The copy reuses the pre-allocated
+  // |snapshot_context_|; after the first call its digest state matches
+  // |context_|, so the copy does not allocate.
+  if (EVP_MD_CTX_copy_ex(snapshot_context_.get(), context_.get()) != 1) {
     return Status(absl::StatusCode::kInternal, BsslLastErrorString());
   }
   digest->resize(DigestSize());
   unsigned int digest_len;
-  if (EVP_DigestFinal(context_snapshot.get(), digest->data(), &digest_len) !=
-          1 ||
+  // Use EVP_DigestFinal_ex, which, unlike EVP_DigestFinal, leaves the digest
+  // state of |snapshot_context_| allocated for the next call.
+  if (EVP_DigestFinal_ex(snapshot_context_.get(), digest->data(),
+                         &digest_len) != 1 ||
       digest_len != DigestSize()) {
     return Status(absl::StatusCode::kInternal, BsslLastErrorString());
   }
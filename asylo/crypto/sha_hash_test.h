@@ -30,6 +30,7 @@
 #include "asylo/crypto/algorithms.pb.h"
 #include "asylo/crypto/sha_hash.h"
 #include "asylo/crypto/util/byte_container_util.h"
+#include "asylo/crypto/util/byte_container_view.h"
 #include "asylo/test/util/status_matchers.h"
 
 namespace asylo {
@@ -139,6 +140,20 @@ TYPED_TEST_P(HashTest, MultipleUpdates) {
             this->result_2_);
 }
 
+// Verify that HashMultiPart hashes the concatenation of its parts and resets
+// any state left over from earlier updates.
+TYPED_TEST_P(HashTest, HashMultiPart) {
+  typename TestFixture::ShaHashType hash;
+  hash.Update(this->suffix_);
+
+  const ByteContainerView parts[] = {ByteContainerView(this->test_vector_1_),
+                                     ByteContainerView(this->suffix_)};
+  std::vector<uint8_t> digest;
+  ASYLO_ASSERT_OK(hash.HashMultiPart(parts, &digest));
+  EXPECT_EQ(absl::BytesToHexString(CopyToByteContainer<std::string>(digest)),
+            this->result_2_);
+}
+
 // Verify that the correct Bssl hash function is returned.
 TYPED_TEST_P(HashTest, BsslHashFunction) {
   typename TestFixture::ShaHashType hash;
@@ -149,7 +164,7 @@ TYPED_TEST_P(HashTest, BsslHashFunction) {
 
 REGISTER_TYPED_TEST_SUITE_P(HashTest, Algorithm, DigestSize, TestVector1,
                             TestVector2, InitBetweenUpdates, MultipleUpdates,
-                            BsslHashFunction);
+                            HashMultiPart, BsslHashFunction);
 
 }  // namespace asylo
 
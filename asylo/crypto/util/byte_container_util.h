@@ -19,11 +19,14 @@
 #ifndef ASYLO_CRYPTO_UTIL_BYTE_CONTAINER_UTIL_H_
 #define ASYLO_CRYPTO_UTIL_BYTE_CONTAINER_UTIL_H_
 
+#include <cstdint>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "asylo/crypto/util/byte_container_util_internal.h"
 #include "asylo/crypto/util/byte_container_view.h"
 #include "asylo/util/status.h"
+#include "asylo/util/statusor.h"
 
 namespace asylo {
 
@@ -64,6 +67,102 @@ Status SerializeByteContainers(ByteContainerT *serialized, Args... args) {
   return internal::AppendSerializedByteContainers(views, serialized);
 }
 
+// Returns the exact number of bytes that SerializeByteContainers() would
+// produce for |args|, or an INVALID_ARGUMENT Status if any of |args| exceeds
+// the 32-bit length limit of the serialization format. Callers can use the
+// returned size to pre-allocate an output buffer for
+// SerializeByteContainersToBuffer().
+//
+// Each of |args| must be implicitly convertible to a ByteContainerView.
+template <typename... Args>
+StatusOr<size_t> SerializedByteContainersSize(Args... args) {
+  return internal::SerializedByteContainersSize(
+      internal::CreateByteContainerViewVector(std::forward<Args>(args)...));
+}
+
+// Serializes |args| into the caller-provided |buffer| and returns the number
+// of bytes written. The serialized bytes are identical to those produced by
+// SerializeByteContainers(), but the output is written directly into |buffer|
+// with no heap allocation, so a caller serializing on a hot path can reuse one
+// appropriately sized arena across messages. Returns an INVALID_ARGUMENT
+// Status if |buffer| is smaller than the serialization or if any of |args|
+// exceeds the 32-bit length limit; |buffer| contents are unspecified on error.
+//
+// Each of |args| must be implicitly convertible to a ByteContainerView.
+template <typename... Args>
+StatusOr<size_t> SerializeByteContainersToBuffer(absl::Span<uint8_t> buffer,
+                                                 Args... args) {
+  return internal::SerializeByteContainersToBuffer(
+      internal::CreateByteContainerViewVector(std::forward<Args>(args)...),
+      buffer);
+}
+
+// An iovec-style serialization of a sequence of byte containers that defers
+// concatenation. Reset() records the serialization as a list of segments:
+// alternating length-prefix segments, which are stored inline in this object,
+// and data segments, which alias the input containers. Consumers that accept
+// scattered input — vectored IO, or incremental hash/AAD updates — can walk
+// segments() directly and never pay for a flattened copy; AssembleTo()
+// produces a flat serialization identical to SerializeByteContainers() when
+// one is needed. The input containers must outlive any use of segments().
+class SerializedByteContainerSegments {
+ public:
+  // Re-populates this object with the serialization of |args|, replacing any
+  // previous contents. Returns an INVALID_ARGUMENT Status if any of |args|
+  // exceeds the 32-bit length limit, in which case this object is left empty.
+  //
+  // Each of |args| must be implicitly convertible to a ByteContainerView.
+  template <typename... Args>
+  Status Reset(Args... args) {
+    std::vector<ByteContainerView> views =
+        internal::CreateByteContainerViewVector(std::forward<Args>(args)...);
+
+    segments_.clear();
+    size_prefixes_.clear();
+    total_size_ = 0;
+    ASYLO_ASSIGN_OR_RETURN(total_size_,
+                           internal::SerializedByteContainersSize(views));
+
+    // Reserve up front so that pushing size prefixes does not reallocate
+    // size_prefixes_ and invalidate the segments that alias its elements.
+    size_prefixes_.reserve(views.size());
+    segments_.reserve(2 * views.size());
+    for (const ByteContainerView &view : views) {
+      size_prefixes_.push_back(htole32(view.size()));
+      segments_.emplace_back(&size_prefixes_.back(), sizeof(uint32_t));
+      segments_.emplace_back(view);
+    }
+    return Status::OkStatus();
+  }
+
+  // The serialization as an ordered list of segments. Concatenating the
+  // segments yields exactly the bytes SerializeByteContainers() would produce.
+  const std::vector<ByteContainerView> &segments() const { return segments_; }
+
+  // The total number of bytes across all segments.
+  size_t total_size() const { return total_size_; }
+
+  // Appends a flat copy of the serialization to |serialized|.
+  //
+  // ByteContainerT must have a 1-byte value_type and support push_back().
+  template <class ByteContainerT>
+  void AssembleTo(ByteContainerT *serialized) const {
+    static_assert(sizeof(typename ByteContainerT::value_type) == 1,
+                  "ByteContainerT must have a 1-byte value_type");
+    for (const ByteContainerView &segment : segments_) {
+      std::copy(segment.cbegin(), segment.cend(),
+                std::back_inserter(*serialized));
+    }
+  }
+
+ private:
+  // Backing storage for the little-endian length prefixes. The prefix
+  // segments in segments_ point into this vector.
+  std::vector<uint32_t> size_prefixes_;
+  std::vector<ByteContainerView> segments_;
+  size_t total_size_ = 0;
+};
+
 // Copies the contents of a ByteContainerView to a newly created object of type
 // ByteContainerT and returns the object by value.
 //
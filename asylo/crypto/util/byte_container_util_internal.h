@@ -23,14 +23,18 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <limits>
 #include <string>
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/types/span.h"
 #include "asylo/crypto/util/byte_container_view.h"
 #include "asylo/util/status.h"
+#include "asylo/util/status_macros.h"
+#include "asylo/util/statusor.h"
 
 namespace asylo {
 namespace internal {
@@ -70,6 +74,50 @@ Status AppendSerializedByteContainers(
   return Status::OkStatus();
 }
 
+// Returns the exact number of bytes occupied by the serialization of |views|,
+// or an INVALID_ARGUMENT Status if any view exceeds the 32-bit length limit.
+inline StatusOr<size_t> SerializedByteContainersSize(
+    const std::vector<ByteContainerView> &views) {
+  size_t total = 0;
+  for (const ByteContainerView &view : views) {
+    if (view.size() > std::numeric_limits<uint32_t>::max()) {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    "Container size exceeds max size");
+    }
+    total += sizeof(uint32_t) + view.size();
+  }
+  return total;
+}
+
+// Writes the serialization of |views| into the caller-provided |buffer|
+// without allocating. Returns the number of bytes written, or an
+// INVALID_ARGUMENT Status if |buffer| is too small or a view exceeds the
+// 32-bit length limit. The serialized format is identical to that produced by
+// AppendSerializedByteContainers().
+inline StatusOr<size_t> SerializeByteContainersToBuffer(
+    const std::vector<ByteContainerView> &views, absl::Span<uint8_t> buffer) {
+  size_t required;
+  ASYLO_ASSIGN_OR_RETURN(required, SerializedByteContainersSize(views));
+  if (buffer.size() < required) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "Output buffer is smaller than the serialization");
+  }
+
+  uint8_t *out = buffer.data();
+  for (const ByteContainerView &view : views) {
+    // Write the size as a little-endian 32-bit integer.
+    uint32_t size_le = htole32(view.size());
+    memcpy(out, &size_le, sizeof(size_le));
+    out += sizeof(size_le);
+    if (!view.empty()) {
+      memcpy(out, view.data(), view.size());
+      out += view.size();
+    }
+  }
+
+  return required;
+}
+
 // The following overloads of CreateByteContainerViewVector() package their
 // input arguments into a vector of ByteContainerView objects and return the
 // vector. Seven explicit implementations and one recursive variadic
@@ -28,6 +28,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/base/macros.h"
+#include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "asylo/crypto/util/byte_container_view.h"
@@ -119,6 +120,76 @@ TYPED_TEST(ByteContainerUtilTypedTest, SerializeLargeNumberOfInputs) {
   EXPECT_EQ(ByteContainerView(output1), ByteContainerView(output2));
 }
 
+// Verify that the buffer-based writer produces byte-for-byte the same
+// serialization as SerializeByteContainers() without touching bytes beyond
+// the reported size.
+TYPED_TEST(ByteContainerUtilTypedTest, SerializeToBufferMatchesSerialize) {
+  TypeParam expected;
+  ASSERT_THAT(SerializeByteContainers(&expected, kStr1, kStr2, kStr3), IsOk());
+
+  size_t required;
+  ASYLO_ASSERT_OK_AND_ASSIGN(required,
+                             SerializedByteContainersSize(kStr1, kStr2, kStr3));
+  EXPECT_EQ(required, expected.size());
+
+  std::vector<uint8_t> buffer(required + 1, 0xa5);
+  size_t written;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      written, SerializeByteContainersToBuffer(absl::MakeSpan(buffer), kStr1,
+                                               kStr2, kStr3));
+  EXPECT_EQ(written, expected.size());
+  EXPECT_EQ(ByteContainerView(buffer.data(), written),
+            ByteContainerView(expected));
+  EXPECT_EQ(buffer.back(), 0xa5);
+}
+
+// Verify that the buffer-based writer rejects an undersized buffer.
+TEST(ByteContainerUtilTest, SerializeToBufferRejectsSmallBuffer) {
+  std::vector<uint8_t> buffer(sizeof(uint32_t) + sizeof(kStr1) - 2);
+  EXPECT_THAT(
+      SerializeByteContainersToBuffer(absl::MakeSpan(buffer), kStr1).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+// Verify that the deferred-concatenation segments concatenate to the same
+// bytes as SerializeByteContainers() and report the matching total size.
+TYPED_TEST(ByteContainerUtilTypedTest, SegmentsMatchSerialize) {
+  TypeParam expected;
+  ASSERT_THAT(SerializeByteContainers(&expected, kStr1, kStr2, kStr3), IsOk());
+
+  SerializedByteContainerSegments segments;
+  ASSERT_THAT(segments.Reset(kStr1, kStr2, kStr3), IsOk());
+  EXPECT_EQ(segments.total_size(), expected.size());
+  EXPECT_EQ(segments.segments().size(), 6);
+
+  // Concatenating the segments manually reproduces the flat serialization.
+  std::vector<uint8_t> concatenated;
+  for (const ByteContainerView &segment : segments.segments()) {
+    concatenated.insert(concatenated.end(), segment.begin(), segment.end());
+  }
+  EXPECT_EQ(ByteContainerView(concatenated), ByteContainerView(expected));
+
+  // AssembleTo() appends the same bytes.
+  TypeParam assembled;
+  segments.AssembleTo(&assembled);
+  EXPECT_EQ(ByteContainerView(assembled), ByteContainerView(expected));
+}
+
+// Verify that Reset() replaces previous contents.
+TEST(ByteContainerUtilTest, SegmentsReset) {
+  SerializedByteContainerSegments segments;
+  ASSERT_THAT(segments.Reset(kStr1, kStr2), IsOk());
+  ASSERT_THAT(segments.Reset(kStr3), IsOk());
+
+  std::string expected;
+  ASSERT_THAT(SerializeByteContainers(&expected, kStr3), IsOk());
+  EXPECT_EQ(segments.total_size(), expected.size());
+
+  std::string assembled;
+  segments.AssembleTo(&assembled);
+  EXPECT_EQ(ByteContainerView(assembled), ByteContainerView(expected));
+}
+
 // Verify that serializations are unambiguous, and unique per set of input
 // strings.
 TYPED_TEST(ByteContainerUtilTypedTest, SerializationsAreUnique) {
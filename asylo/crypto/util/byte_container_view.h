@@ -19,12 +19,12 @@
 #ifndef ASYLO_CRYPTO_UTIL_BYTE_CONTAINER_VIEW_H_
 #define ASYLO_CRYPTO_UTIL_BYTE_CONTAINER_VIEW_H_
 
-#include <openssl/mem.h>
 #include <string.h>
 #include <cstdint>
 #include <cstdlib>
 #include <iterator>
 #include <type_traits>
+#include <utility>
 
 #include "absl/strings/string_view.h"
 #include "asylo/crypto/util/byte_container_view_internal.h"
@@ -149,10 +149,23 @@ class ByteContainerView {
 
   // Performs a side-channel-resistant comparison of contents of this
   // ByteContainerView with the contents of |other|. Returns true if the
-  // contents are equal.
+  // contents are equal. The comparison reads word-at-a-time but its memory
+  // accesses and loop bounds depend only on the view sizes, never on the
+  // bytes themselves.
   bool SafeEquals(ByteContainerView other) const {
     return (size_ == other.size_) &&
-           (CRYPTO_memcmp(data_, other.data_, size_) == 0);
+           internal::ConstantTimeEquals(data_, other.data_, size_);
+  }
+
+  // Hashing support for the absl hashing framework, which consumes the viewed
+  // bytes word-at-a-time. Two views hash identically if and only if they view
+  // equal byte sequences. Do not hash views of secret data; hash values are
+  // not side-channel-resistant.
+  template <typename H>
+  friend H AbslHashValue(H hash_state, ByteContainerView view) {
+    return H::combine(
+        H::combine_contiguous(std::move(hash_state), view.data_, view.size_),
+        view.size_);
   }
 
  private:
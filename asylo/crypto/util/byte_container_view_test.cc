@@ -25,6 +25,7 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/hash/hash.h"
 #include "absl/strings/string_view.h"
 #include "asylo/crypto/util/byte_container_view_internal.h"
 #include "asylo/crypto/util/bytes.h"
@@ -250,5 +251,39 @@ TEST(ByteContainerViewTest, SafeEqualsNegative) {
   EXPECT_FALSE(view1.SafeEquals(view2));
 }
 
+// Exercises the word-wide comparison across buffer lengths straddling word
+// boundaries and across all single-byte mismatch positions, including
+// mismatches confined to the sub-word tail.
+TEST(ByteContainerViewTest, SafeEqualsAllLengthsAndMismatchPositions) {
+  for (size_t length = 0; length <= 2 * sizeof(uint64_t) + 1; ++length) {
+    std::vector<uint8_t> lhs(length);
+    for (size_t i = 0; i < length; ++i) {
+      lhs[i] = static_cast<uint8_t>(i + 1);
+    }
+    std::vector<uint8_t> rhs = lhs;
+    EXPECT_TRUE(ByteContainerView(lhs).SafeEquals(ByteContainerView(rhs)))
+        << "length = " << length;
+
+    for (size_t flip = 0; flip < length; ++flip) {
+      rhs = lhs;
+      rhs[flip] ^= 0x80;
+      EXPECT_FALSE(ByteContainerView(lhs).SafeEquals(ByteContainerView(rhs)))
+          << "length = " << length << ", flip = " << flip;
+    }
+  }
+}
+
+TEST(ByteContainerViewTest, AbslHashValue) {
+  std::string copy(kData1, kSize1);
+  ByteContainerView view1(kData1);
+  ByteContainerView view2(copy);
+  ByteContainerView view3(kData2);
+
+  absl::Hash<ByteContainerView> hasher;
+  EXPECT_EQ(hasher(view1), hasher(view2));
+  EXPECT_NE(hasher(view1), hasher(view3));
+  EXPECT_NE(hasher(view1), hasher(ByteContainerView(kData1, kSize1 - 1)));
+}
+
 }  // namespace
 }  // namespace asylo
@@ -237,8 +237,10 @@ class Bytes {
     }
     if (Policy::policy == DataSafety::SAFE) {
       // Since Policy parameter is set to SAFE, perform constant-time comparison
-      // to defend against side-channel leakage.
-      return (CRYPTO_memcmp(data_, data, Size) == 0);
+      // to defend against side-channel leakage. The comparison is word-wide
+      // but its memory-access pattern does not depend on the compared bytes.
+      return internal::ConstantTimeEquals(
+          data_, reinterpret_cast<const uint8_t *>(data), Size);
     } else {
       // Since Policy parameter is set to UNSAFE, use memcmp for fast
       // comparison.
@@ -0,0 +1,114 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Microbenchmarks for ByteContainerView comparison and hashing. The sizes
+// model identity comparisons (32-byte MRENCLAVE/MRSIGNER values) and key
+// material checked per connection.
+//
+// The SafeEquals benchmarks double as a constant-time regression check: the
+// Match, DiffFirstByte, and DiffLastByte variants compare inputs whose first
+// mismatch (if any) sits at opposite ends of the buffer. A data-independent
+// comparison reports the same time for all three; an early-exit comparison
+// shows DiffFirstByte running measurably faster than DiffLastByte.
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/hash/hash.h"
+#include "asylo/crypto/util/byte_container_view.h"
+
+namespace asylo {
+namespace {
+
+std::vector<uint8_t> MakeBuffer(size_t size) {
+  std::vector<uint8_t> buffer(size);
+  for (size_t i = 0; i < size; ++i) {
+    buffer[i] = static_cast<uint8_t>(i * 131 + 17);
+  }
+  return buffer;
+}
+
+void RunSafeEquals(benchmark::State &state, const std::vector<uint8_t> &lhs,
+                   const std::vector<uint8_t> &rhs) {
+  ByteContainerView lhs_view(lhs);
+  ByteContainerView rhs_view(rhs);
+  for (auto _ : state) {
+    bool equal = lhs_view.SafeEquals(rhs_view);
+    benchmark::DoNotOptimize(equal);
+  }
+  state.SetBytesProcessed(state.iterations() * lhs.size());
+}
+
+// Compares equal buffers.
+void BM_SafeEqualsMatch(benchmark::State &state) {
+  const std::vector<uint8_t> lhs = MakeBuffer(state.range(0));
+  RunSafeEquals(state, lhs, lhs);
+}
+BENCHMARK(BM_SafeEqualsMatch)->Arg(32)->Arg(48)->Arg(256)->Arg(4096);
+
+// Compares buffers whose only mismatch is in the first byte. An early-exit
+// comparison would return almost immediately here.
+void BM_SafeEqualsDiffFirstByte(benchmark::State &state) {
+  const std::vector<uint8_t> lhs = MakeBuffer(state.range(0));
+  std::vector<uint8_t> rhs = lhs;
+  rhs.front() ^= 0x80;
+  RunSafeEquals(state, lhs, rhs);
+}
+BENCHMARK(BM_SafeEqualsDiffFirstByte)->Arg(32)->Arg(48)->Arg(256)->Arg(4096);
+
+// Compares buffers whose only mismatch is in the last byte.
+void BM_SafeEqualsDiffLastByte(benchmark::State &state) {
+  const std::vector<uint8_t> lhs = MakeBuffer(state.range(0));
+  std::vector<uint8_t> rhs = lhs;
+  rhs.back() ^= 0x80;
+  RunSafeEquals(state, lhs, rhs);
+}
+BENCHMARK(BM_SafeEqualsDiffLastByte)->Arg(32)->Arg(48)->Arg(256)->Arg(4096);
+
+// Baseline: the non-constant-time equality operator, which uses memcmp and is
+// free to exit early. Run on equal buffers so it scans the full length.
+void BM_OperatorEqualsMatch(benchmark::State &state) {
+  const std::vector<uint8_t> lhs = MakeBuffer(state.range(0));
+  ByteContainerView lhs_view(lhs);
+  ByteContainerView rhs_view(lhs);
+  for (auto _ : state) {
+    bool equal = (lhs_view == rhs_view);
+    benchmark::DoNotOptimize(equal);
+  }
+  state.SetBytesProcessed(state.iterations() * lhs.size());
+}
+BENCHMARK(BM_OperatorEqualsMatch)->Arg(32)->Arg(48)->Arg(256)->Arg(4096);
+
+// Hashes the viewed bytes through the absl hashing framework.
+void BM_AbslHash(benchmark::State &state) {
+  const std::vector<uint8_t> buffer = MakeBuffer(state.range(0));
+  ByteContainerView view(buffer);
+  absl::Hash<ByteContainerView> hasher;
+  for (auto _ : state) {
+    size_t hash = hasher(view);
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_AbslHash)->Arg(32)->Arg(48)->Arg(256)->Arg(4096);
+
+}  // namespace
+}  // namespace asylo
+
+BENCHMARK_MAIN();
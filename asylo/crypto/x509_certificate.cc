@@ -155,6 +155,46 @@ StatusOr<CrlDistributionPoints::Reasons> BitvecToReasons(
   return reasons;
 }
 
+// Returns a kUnimplemented Status naming the unsupported signature algorithm
+// |signature_id|.
+Status UnsupportedSignatureAlgorithmError(int signature_id) {
+  std::string signature_name;
+  const char *data = OBJ_nid2sn(signature_id);
+  if (data == nullptr) {
+    signature_name = absl::StrCat("signature with NID ", signature_id);
+    LOG(ERROR) << "Could not parse name for " << signature_name;
+  } else {
+    signature_name = data;
+  }
+  return Status(
+      absl::StatusCode::kUnimplemented,
+      absl::StrCat("Signature algorithm not supported: ", signature_name));
+}
+
+// Checks that the signature algorithm of |certificate| is supported and that
+// |public_key| has the matching key type. Mirrors the checks that
+// CreatePublicKey() performs when parsing a DER-encoded key.
+Status CheckPublicKeyMatchesSignatureAlgorithm(const X509 *certificate,
+                                               const EVP_PKEY *public_key) {
+  int signature_id = X509_get_signature_nid(certificate);
+  switch (signature_id) {
+    case NID_ecdsa_with_SHA256:
+      if (EVP_PKEY_id(public_key) != EVP_PKEY_EC) {
+        return Status(absl::StatusCode::kInternal,
+                      "Issuer public key is not an EC key");
+      }
+      return Status::OkStatus();
+    case NID_sha256WithRSAEncryption:
+      if (EVP_PKEY_id(public_key) != EVP_PKEY_RSA) {
+        return Status(absl::StatusCode::kInternal,
+                      "Issuer public key is not an RSA key");
+      }
+      return Status::OkStatus();
+    default:
+      return UnsupportedSignatureAlgorithmError(signature_id);
+  }
+}
+
 // Creates a public key object using the signature algorithm in |certificate|
 // and the public key data in |public_key_der|. Returns a non-OK Status if the
 // signature algorithm or key type are unsupported, or if an error occurred.
@@ -203,19 +243,8 @@ StatusOr<bssl::UniquePtr<EVP_PKEY>> CreatePublicKey(
 
       return std::move(evp_key);
     }
-    default: {
-      std::string signature_name;
-      const char *data = OBJ_nid2sn(signature_id);
-      if (data == nullptr) {
-        signature_name = absl::StrCat("signature with NID ", signature_id);
-        LOG(ERROR) << "Could not parse name for " << signature_name;
-      } else {
-        signature_name = data;
-      }
-      return Status(
-          absl::StatusCode::kUnimplemented,
-          absl::StrCat("Signature algorithm not supported: ", signature_name));
-    }
+    default:
+      return UnsupportedSignatureAlgorithmError(signature_id);
   }
 }
 
@@ -856,15 +885,28 @@ StatusOr<std::string> ExtractPkcs10SubjectKeyDer(
 
 Status X509Certificate::Verify(const CertificateInterface &issuer_certificate,
                                const VerificationConfig &config) const {
-  std::string issuer_public_key_der;
-  ASYLO_ASSIGN_OR_RETURN(issuer_public_key_der,
-                         issuer_certificate.SubjectKeyDer());
-
-  bssl::UniquePtr<EVP_PKEY> public_key;
-  ASYLO_ASSIGN_OR_RETURN(public_key,
-                         CreatePublicKey(x509_.get(), issuer_public_key_der));
+  EVP_PKEY *issuer_key = nullptr;
+  bssl::UniquePtr<EVP_PKEY> parsed_issuer_key;
+
+  // When the issuer is also an X509Certificate, use its cached parsed key
+  // rather than round-tripping the key through its DER encoding on every
+  // verification.
+  const X509Certificate *x509_issuer =
+      dynamic_cast<const X509Certificate *>(&issuer_certificate);
+  if (x509_issuer != nullptr) {
+    ASYLO_ASSIGN_OR_RETURN(issuer_key, x509_issuer->SubjectPublicKey());
+    ASYLO_RETURN_IF_ERROR(
+        CheckPublicKeyMatchesSignatureAlgorithm(x509_.get(), issuer_key));
+  } else {
+    std::string issuer_public_key_der;
+    ASYLO_ASSIGN_OR_RETURN(issuer_public_key_der,
+                           issuer_certificate.SubjectKeyDer());
+    ASYLO_ASSIGN_OR_RETURN(
+        parsed_issuer_key, CreatePublicKey(x509_.get(), issuer_public_key_der));
+    issuer_key = parsed_issuer_key.get();
+  }
 
-  if (X509_verify(x509_.get(), public_key.get()) != 1) {
+  if (X509_verify(x509_.get(), issuer_key) != 1) {
     return Status(absl::StatusCode::kInternal, BsslLastErrorString());
   }
 
@@ -901,12 +943,19 @@ Status X509Certificate::Verify(const CertificateInterface &issuer_certificate,
 }
 
 StatusOr<std::string> X509Certificate::SubjectKeyDer() const {
-  bssl::UniquePtr<EVP_PKEY> evp_key(X509_get_pubkey(x509_.get()));
-  if (evp_key == nullptr) {
+  EVP_PKEY *evp_key;
+  ASYLO_ASSIGN_OR_RETURN(evp_key, SubjectPublicKey());
+  return EvpPkeyToDer(*evp_key);
+}
+
+StatusOr<EVP_PKEY *> X509Certificate::SubjectPublicKey() const {
+  absl::call_once(subject_key_once_, [this] {
+    subject_key_.reset(X509_get_pubkey(x509_.get()));
+  });
+  if (subject_key_ == nullptr) {
     return Status(absl::StatusCode::kInternal, BsslLastErrorString());
   }
-
-  return EvpPkeyToDer(*evp_key);
+  return subject_key_.get();
 }
 
 absl::optional<std::string> X509Certificate::SubjectName() const {
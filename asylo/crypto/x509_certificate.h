@@ -30,6 +30,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/call_once.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
@@ -300,7 +301,18 @@ class X509Certificate : public CertificateInterface {
   // nullptr if |x509_| contains no such extension.
   StatusOr<X509_EXTENSION *> GetExtensionByNid(int nid) const;
 
+  // Returns this certificate's public key, parsing it on the first call and
+  // serving it from |subject_key_| afterwards. The returned pointer is owned
+  // by this object and is valid for this object's lifetime.
+  StatusOr<EVP_PKEY *> SubjectPublicKey() const;
+
   bssl::UniquePtr<X509> x509_;
+
+  // Lazily-initialized cache of the certificate's parsed public key, so that
+  // repeated verifications against the same issuer certificate do not re-parse
+  // its key each time.
+  mutable absl::once_flag subject_key_once_;
+  mutable bssl::UniquePtr<EVP_PKEY> subject_key_;
 };
 
 // Creates and returns an X509_REQ object equivalent to the data in |csr|.
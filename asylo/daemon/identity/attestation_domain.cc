@@ -31,6 +31,7 @@
 
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/strings/str_format.h"
 #include "asylo/crypto/sha256_hash.h"
 #include "asylo/crypto/util/bssl_util.h"
@@ -81,9 +82,8 @@ StatusOr<std::string> GetPerBootUuid() {
   return std::string(uuid.data(), uuid.size());
 }
 
-}  // namespace
-
-StatusOr<std::string> GetAttestationDomain() {
+// Derives the attestation domain from the per-boot machine UUID.
+StatusOr<std::string> ComputeAttestationDomain() {
   std::string boot_uuid;
   ASYLO_ASSIGN_OR_RETURN(boot_uuid, GetPerBootUuid());
 
@@ -106,4 +106,25 @@ StatusOr<std::string> GetAttestationDomain() {
                      kAttestationDomainSize);
 }
 
+}  // namespace
+
+StatusOr<std::string> GetAttestationDomain() {
+  // The boot UUID is fixed for the lifetime of a boot and the derivation is
+  // deterministic, so the domain is computed once per process and served from
+  // memory afterwards. SGX local attestation consults the domain per
+  // assertion during handshake negotiation, which makes the repeated file
+  // read and HMAC measurable. Failures are not cached, so a transient error
+  // reading the boot UUID is retried on the next call.
+  static absl::Mutex mu(absl::kConstInit);
+  static std::string *cached_domain = nullptr;
+
+  absl::MutexLock lock(&mu);
+  if (cached_domain == nullptr) {
+    std::string domain;
+    ASYLO_ASSIGN_OR_RETURN(domain, ComputeAttestationDomain());
+    cached_domain = new std::string(std::move(domain));
+  }
+  return *cached_domain;
+}
+
 }  // namespace asylo
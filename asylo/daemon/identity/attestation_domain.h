@@ -36,6 +36,10 @@ constexpr size_t kAttestationDomainNameSize = 16;
 // to verify each other's identity.
 //
 // Note that the attestation domain value may change per boot.
+//
+// The domain is derived once per process and served from memory on
+// subsequent calls, so callers on the local assertion flow may invoke this
+// per assertion without paying for file I/O. This function is thread-safe.
 StatusOr<std::string> GetAttestationDomain();
 
 }  // namespace asylo
@@ -0,0 +1,309 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/flags/flag.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "tools/cpp/runfiles/runfiles.h"
+#include "asylo/test/util/exec_tester.h"
+#include "asylo/test/util/test_flags.h"
+
+ABSL_FLAG(
+    std::string, server_path, "",
+    "The path to the binary that loads the Redis server inside an enclave");
+ABSL_FLAG(std::string, client_path, "",
+          "The path to the binary that launches the Redis client");
+ABSL_FLAG(std::string, benchmark_path, "",
+          "The path to the redis-benchmark binary");
+ABSL_FLAG(int, requests, 10000, "Requests issued per benchmark test");
+ABSL_FLAG(int, clients, 8, "Number of parallel benchmark connections");
+ABSL_FLAG(std::string, tests, "set,get",
+          "Comma-separated redis-benchmark tests to run");
+
+constexpr char kServerInitializedMessage[] = "Server initialized";
+constexpr int kTimeout = 30;
+constexpr uint64_t kNanoSecondsPerSecond = 1000000000;
+constexpr uint64_t kWaitStep = 100000000;
+
+using bazel::tools::cpp::runfiles::Runfiles;
+
+namespace asylo {
+namespace {
+
+// An ExecTester that scans stdout for the "Server initialized" log message
+// from the Redis server inside an enclave, and sets an external bool when the
+// server is ready to accept requests.
+class RedisServerEnclaveExecTester : public asylo::experimental::ExecTester {
+ public:
+  RedisServerEnclaveExecTester(const std::vector<std::string> &args,
+                               std::atomic<bool> *server_initialized)
+      : ExecTester(args), server_initialized_(server_initialized) {}
+
+ protected:
+  bool CheckLine(const std::string &line) override {
+    if (absl::StrContains(line, kServerInitializedMessage)) {
+      *server_initialized_ = true;
+    }
+    // Print the line back to stdout in case it's needed for debugging.
+    std::cout << line << std::endl;
+    return true;
+  }
+
+  std::atomic<bool> *server_initialized_;
+};
+
+// An ExecTester that captures every stdout line of a subprocess, for parsing
+// redis-benchmark CSV output after the run completes.
+class LineCapturingExecTester : public asylo::experimental::ExecTester {
+ public:
+  LineCapturingExecTester(const std::vector<std::string> &args,
+                          std::vector<std::string> *lines)
+      : ExecTester(args), lines_(lines) {}
+
+ protected:
+  bool CheckLine(const std::string &line) override {
+    lines_->push_back(line);
+    std::cout << line << std::endl;
+    return true;
+  }
+
+  std::vector<std::string> *lines_;
+};
+
+std::string GetPath(const std::string &flag) {
+  std::string error;
+  std::unique_ptr<Runfiles> runfiles(Runfiles::CreateForTest(&error));
+  return runfiles->Rlocation(absl::StrCat("com_google_asylo/", flag));
+}
+
+// One parsed "test name, requests per second" row of redis-benchmark --csv
+// output.
+struct ThroughputResult {
+  std::string name;
+  double requests_per_second;
+};
+
+// Benchmark harness that drives redis-benchmark against a Redis server
+// running inside an enclave, and correlates the measured throughput with the
+// per-selector exit statistics dumped by the application wrapper (see
+// ASYLO_EXIT_STATS_FILE in application_wrapper_driver_main.cc). The headline
+// metric is exits per operation: the exit counts cover server startup and
+// shutdown as well, so drive enough requests to amortize that fixed cost.
+class RedisBenchmarkTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    // Redis accesses files in the current working directory for snapshots.
+    ASSERT_EQ(chdir(absl::GetFlag(FLAGS_test_tmpdir).c_str()), 0);
+
+    // Use the parent process ID to make sure the socket path is unique across
+    // all tests running on the current machine.
+    domain_socket_path_ = absl::StrCat("/tmp/redis_bench_", getpid(), ".sock");
+    exit_stats_path_ =
+        absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/exit_stats.txt");
+
+    // The environment is inherited by the server subprocess and instructs the
+    // application wrapper to record and dump exit statistics.
+    ASSERT_EQ(setenv("ASYLO_EXIT_STATS_FILE", exit_stats_path_.c_str(),
+                     /*overwrite=*/1),
+              0);
+
+    StartServer();
+    client_path_ = GetPath(absl::GetFlag(FLAGS_client_path));
+    benchmark_path_ = GetPath(absl::GetFlag(FLAGS_benchmark_path));
+  }
+
+  void TearDown() override {
+    // Make sure the server comes down even if the benchmark failed early.
+    if (!server_shut_down_) {
+      ShutdownServer();
+    }
+    unsetenv("ASYLO_EXIT_STATS_FILE");
+  }
+
+ protected:
+  // Spawns the Redis server subprocess and waits for it to inform it's ready.
+  // Fails if the log message is not seen in 30 seconds.
+  void StartServer() {
+    std::string server_path = GetPath(absl::GetFlag(FLAGS_server_path));
+    const std::vector<std::string> server_argv({server_path, "--port", "0",
+                                                "--unixsocket",
+                                                domain_socket_path_.c_str()});
+    server_initialized_ = false;
+
+    server_thread_ = absl::make_unique<std::thread>(
+        [this](const std::vector<std::string> &argv) {
+          RedisServerEnclaveExecTester server_runner(argv,
+                                                     &server_initialized_);
+          server_runner.Run(/*input=*/"", &server_exit_status_);
+        },
+        server_argv);
+
+    for (uint64_t i = 0; i < kTimeout * kNanoSecondsPerSecond / kWaitStep;
+         ++i) {
+      if (server_initialized_) {
+        break;
+      }
+      struct timespec tm;
+      tm.tv_sec = 0;
+      tm.tv_nsec = kWaitStep;
+      nanosleep(&tm, /*rem=*/nullptr);
+    }
+
+    ASSERT_TRUE(server_initialized_) << "Server initialize timeout";
+  }
+
+  // Shuts the server down through the client and waits for the wrapper to
+  // dump the exit statistics.
+  void ShutdownServer() {
+    server_shut_down_ = true;
+    int client_exit_status;
+    std::vector<std::string> ignored_lines;
+    const std::vector<std::string> client_shutdown_argv(
+        {client_path_, "-s", domain_socket_path_.c_str(), "shutdown",
+         "nosave"});
+    LineCapturingExecTester client_runner(client_shutdown_argv,
+                                          &ignored_lines);
+    client_runner.Run(/*input=*/"", &client_exit_status);
+    server_thread_->join();
+    CheckExitStatus(server_exit_status_);
+  }
+
+  // Checks whether the subprocess exited normally.
+  void CheckExitStatus(int exit_status) {
+    ASSERT_TRUE(WIFEXITED(exit_status))
+        << (WIFSIGNALED(exit_status)
+                ? absl::StrCat("Subprocess killed by signal ",
+                               WTERMSIG(exit_status))
+                : "Subprocess ended abnormally");
+    EXPECT_EQ(WEXITSTATUS(exit_status), 0)
+        << absl::StrCat("Subprocess exited with non-zero status ",
+                        WEXITSTATUS(exit_status));
+  }
+
+  // Runs redis-benchmark in CSV mode and returns the parsed per-test
+  // throughput rows.
+  std::vector<ThroughputResult> RunBenchmark() {
+    const std::vector<std::string> benchmark_argv(
+        {benchmark_path_, "-s", domain_socket_path_.c_str(), "-n",
+         absl::StrCat(absl::GetFlag(FLAGS_requests)), "-c",
+         absl::StrCat(absl::GetFlag(FLAGS_clients)), "-t",
+         absl::GetFlag(FLAGS_tests), "--csv"});
+
+    int benchmark_exit_status;
+    std::vector<std::string> output_lines;
+    LineCapturingExecTester benchmark_runner(benchmark_argv, &output_lines);
+    benchmark_runner.Run(/*input=*/"", &benchmark_exit_status);
+    CheckExitStatus(benchmark_exit_status);
+
+    // CSV rows have the form: "SET","85034.02"
+    std::vector<ThroughputResult> results;
+    for (const std::string &line : output_lines) {
+      std::vector<std::string> fields =
+          absl::StrSplit(line, ',', absl::SkipEmpty());
+      if (fields.size() != 2) {
+        continue;
+      }
+      for (std::string &field : fields) {
+        field.erase(std::remove(field.begin(), field.end(), '"'),
+                    field.end());
+      }
+      double requests_per_second;
+      if (absl::SimpleAtod(fields[1], &requests_per_second)) {
+        results.push_back({fields[0], requests_per_second});
+      }
+    }
+    return results;
+  }
+
+  // Reads the exit statistics dumped by the application wrapper and returns
+  // the total number of enclave exits across all selectors.
+  uint64_t ReadTotalExits() {
+    std::ifstream stats(exit_stats_path_);
+    EXPECT_TRUE(stats.is_open())
+        << "Missing exit stats file " << exit_stats_path_;
+    uint64_t total_exits = 0;
+    std::string tag;
+    uint64_t selector, count, total_nanos;
+    while (stats >> tag >> selector >> count >> total_nanos) {
+      if (tag == "exit") {
+        total_exits += count;
+      }
+    }
+    return total_exits;
+  }
+
+  std::unique_ptr<std::thread> server_thread_;
+  std::atomic<bool> server_initialized_;
+  std::string client_path_;
+  std::string benchmark_path_;
+  std::string domain_socket_path_;
+  std::string exit_stats_path_;
+  bool server_shut_down_ = false;
+  int server_exit_status_;
+};
+
+// Drives redis-benchmark against the enclave server and reports throughput
+// alongside enclave exits per operation.
+TEST_F(RedisBenchmarkTest, ThroughputAndExitRate) {
+  std::vector<ThroughputResult> results = RunBenchmark();
+  ASSERT_FALSE(results.empty()) << "No throughput rows parsed from "
+                                   "redis-benchmark CSV output";
+
+  uint64_t total_operations = 0;
+  for (const ThroughputResult &result : results) {
+    EXPECT_GT(result.requests_per_second, 0.0) << result.name;
+    total_operations += absl::GetFlag(FLAGS_requests);
+  }
+
+  // The wrapper dumps the statistics when the server exits.
+  ShutdownServer();
+  uint64_t total_exits = ReadTotalExits();
+  EXPECT_GT(total_exits, 0);
+
+  std::cout << "---- redis-on-asylo benchmark summary ----" << std::endl;
+  for (const ThroughputResult &result : results) {
+    std::cout << result.name << ": " << result.requests_per_second
+              << " requests/sec" << std::endl;
+  }
+  std::cout << "total operations: " << total_operations << std::endl;
+  std::cout << "total enclave exits: " << total_exits << std::endl;
+  std::cout << "exits per operation: "
+            << static_cast<double>(total_exits) / total_operations
+            << std::endl;
+}
+
+}  // namespace
+}  // namespace asylo
@@ -22,6 +22,7 @@
 #include <openssl/rand.h>
 
 #include <algorithm>
+#include <utility>
 
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include "absl/memory/memory.h"
@@ -57,6 +58,7 @@ ClientEkepHandshaker::ClientEkepHandshaker(const EkepHandshakerOptions &options)
       available_record_protocols_({ALTSRP_AES128_GCM}),
       available_ekep_versions_({"EKEP v1"}),
       additional_authenticated_data_(options.additional_authenticated_data),
+      resumption_state_(options.resumption_state),
       selected_cipher_suite_(UNKNOWN_HANDSHAKE_CIPHER),
       selected_record_protocol_(UNKNOWN_RECORD_PROTOCOL),
       expected_message_type_(SERVER_PRECOMMIT),
@@ -226,6 +228,40 @@ Status ClientEkepHandshaker::HandleServerPrecommit(
                                server_precommit.challenge().size()));
   }
 
+  if (server_precommit.resumption_accepted()) {
+    if (resumption_state_ == nullptr) {
+      return Status(Abort::PROTOCOL_ERROR,
+                    "Server accepted a resumption that was not offered");
+    }
+    if (selected_ekep_version_ != resumption_state_->ekep_version ||
+        selected_cipher_suite_ != resumption_state_->cipher_suite ||
+        selected_record_protocol_ != resumption_state_->record_protocol) {
+      return Status(Abort::PROTOCOL_ERROR,
+                    "Server resumed the session with parameters that do not "
+                    "match the original session");
+    }
+
+    // The peer's identities were verified during the original handshake.
+    for (const EnclaveIdentity &identity : resumption_state_->peer_identities) {
+      AddPeerIdentity(identity);
+    }
+
+    // Derive the EKEP secrets for the abbreviated handshake from the
+    // resumption master secret and the current transcript:
+    //   hash(ClientPrecommit || ServerPrecommit)
+    std::string transcript_hash;
+    ASYLO_RETURN_IF_ERROR(GetTranscriptHash(&transcript_hash));
+    ASYLO_RETURN_IF_ERROR(DeriveResumptionSecrets(
+        selected_cipher_suite_, transcript_hash,
+        resumption_state_->resumption_master_secret, &primary_secret_,
+        &authenticator_secret_));
+
+    // The server skips the ServerId message and sends a ServerFinish
+    // immediately after the ServerPrecommit. No ClientId is sent.
+    expected_message_type_ = SERVER_FINISH;
+    return Status::OkStatus();
+  }
+
   // Verify that the server requested a non-empty subset of the assertions that
   // were offered by the client.
   if (server_precommit.server_requests().empty()) {
@@ -360,6 +396,13 @@ Status ClientEkepHandshaker::HandleServerFinish(const google::protobuf::Message
                   "Server handshake authenticator value is incorrect");
   }
 
+  // If the server issued a resumption ticket, save the state needed to resume
+  // this session in a future handshake.
+  if (server_finish.has_resumption_ticket()) {
+    ASYLO_RETURN_IF_ERROR(
+        SaveResumptionState(server_finish.resumption_ticket()));
+  }
+
   return WriteClientFinish(output);
 }
 
@@ -391,6 +434,13 @@ Status ClientEkepHandshaker::WriteClientPrecommit(std::string *output) {
   }
   client_precommit.set_challenge(challenge.data(), challenge.size());
 
+  // Offer to resume a previous session, if the client has resumption state.
+  // The server may silently decline the offer, in which case the handshake
+  // proceeds as a full handshake.
+  if (resumption_state_ != nullptr) {
+    client_precommit.set_resumption_ticket(resumption_state_->ticket);
+  }
+
   for (const AssertionDescription &description : self_assertions_) {
     // Note that assertion generators were verified during creation of the
     // handshaker so there is no need to check whether the call to
@@ -500,6 +550,22 @@ Status ClientEkepHandshaker::WriteClientFinish(std::string *output) {
   return WriteFrameAndUpdateTranscript(CLIENT_FINISH, client_finish, output);
 }
 
+Status ClientEkepHandshaker::SaveResumptionState(const std::string &ticket) {
+  auto resumption_state = absl::make_unique<EkepResumptionState>();
+  resumption_state->ticket = ticket;
+  ASYLO_RETURN_IF_ERROR(DeriveResumptionMasterSecret(
+      selected_cipher_suite_, primary_secret_,
+      &resumption_state->resumption_master_secret));
+  resumption_state->ekep_version = selected_ekep_version_;
+  resumption_state->cipher_suite = selected_cipher_suite_;
+  resumption_state->record_protocol = selected_record_protocol_;
+  for (const EnclaveIdentity &identity : PeerIdentities().identities()) {
+    resumption_state->peer_identities.push_back(identity);
+  }
+  SetResumptionState(std::move(resumption_state));
+  return Status::OkStatus();
+}
+
 bool ClientEkepHandshaker::SetSelectedEkepVersion(
     const std::string &ekep_version) {
   // Verify that the selected EKEP version was offered by the client.
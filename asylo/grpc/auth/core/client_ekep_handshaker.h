@@ -106,6 +106,11 @@ class ClientEkepHandshaker final : public EkepHandshaker {
   // transcript.
   Status WriteClientFinish(std::string *output);
 
+  // Derives the resumption master secret for the current session and makes
+  // the resulting resumption state, including |ticket|, available through
+  // GetResumptionState().
+  Status SaveResumptionState(const std::string &ticket);
+
   // Sets the handshaker's selected EKEP version to |ekep_version|. Returns
   // false if |ekep_version| is not a valid EKEP version for this handshaker.
   bool SetSelectedEkepVersion(const std::string &ekep_version);
@@ -140,6 +145,10 @@ class ClientEkepHandshaker final : public EkepHandshaker {
   // Additional data that is authenticated during the handshake.
   const std::string additional_authenticated_data_;
 
+  // State from a previous session that the client offers to resume, or
+  // nullptr if the client only performs full handshakes.
+  const std::shared_ptr<const EkepResumptionState> resumption_state_;
+
   // Assertions expected from the peer. This field is populated after validation
   // of the ServerPrecommit message.
   std::vector<AssertionDescription> expected_peer_assertions_;
@@ -29,6 +29,7 @@
 #include <memory>
 
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "asylo/crypto/sha256_hash.h"
 #include "asylo/crypto/util/bssl_util.h"
 #include "asylo/crypto/util/byte_container_view.h"
@@ -45,6 +46,11 @@ constexpr size_t kEkepSecretSize =
 
 constexpr char kEkepHkdfSalt[] = "EKEP Handshake v1";
 constexpr char kEkepHkdfSaltRecordProtocol[] = "EKEP Record Protocol v1";
+constexpr char kEkepHkdfSaltResumptionMaster[] =
+    "EKEP Resumption Master Secret v1";
+constexpr char kEkepHkdfSaltResumption[] = "EKEP Resumption v1";
+constexpr char kEkepHkdfSaltSharedMemoryChannel[] =
+    "EKEP Shared Memory Channel v1";
 constexpr char kServerAuthenticatedText[] = "EKEP Handshake v1: Server Finish";
 constexpr char kClientAuthenticatedText[] = "EKEP Handshake v1: Client Finish";
 
@@ -123,7 +129,7 @@ Status DeriveSecrets(const HandshakeCipher &ciphersuite,
   }
 
   // Derive the primary and authenticator secrets using HKDF.
-  std::string salt(kEkepHkdfSalt);
+  constexpr absl::string_view salt = kEkepHkdfSalt;
   CleansingVector<uint8_t> output_key;
   output_key.resize(kEkepSecretSize);
   if (!HKDF(output_key.data(), kEkepSecretSize, digest, shared_secret.data(),
@@ -135,10 +141,13 @@ Status DeriveSecrets(const HandshakeCipher &ciphersuite,
   }
 
   // Copy the primary secret.
+  primary_secret->reserve(primary_secret->size() + kEkepPrimarySecretSize);
   std::copy(output_key.cbegin(), output_key.cbegin() + kEkepPrimarySecretSize,
             std::back_inserter(*primary_secret));
 
   // Copy the authenticator secret.
+  authenticator_secret->reserve(authenticator_secret->size() +
+                                kEkepAuthenticatorSecretSize);
   std::copy(output_key.cbegin() + kEkepPrimarySecretSize, output_key.cend(),
             std::back_inserter(*authenticator_secret));
 
@@ -182,7 +191,7 @@ Status DeriveRecordProtocolKey(const HandshakeCipher &ciphersuite,
                         ProtoEnumValueName(record_protocol));
   }
 
-  std::string salt(kEkepHkdfSaltRecordProtocol);
+  constexpr absl::string_view salt = kEkepHkdfSaltRecordProtocol;
   if (!HKDF(record_protocol_key->data(), record_protocol_key->size(), digest,
             primary_secret.data(), primary_secret.size(),
             reinterpret_cast<const uint8_t *>(salt.data()), salt.size(),
@@ -193,18 +202,127 @@ Status DeriveRecordProtocolKey(const HandshakeCipher &ciphersuite,
   return Status::OkStatus();
 }
 
+Status DeriveSharedMemoryChannelKeys(ByteContainerView record_protocol_key,
+                                     CleansingVector<uint8_t> *client_key,
+                                     CleansingVector<uint8_t> *server_key) {
+  constexpr absl::string_view salt = kEkepHkdfSaltSharedMemoryChannel;
+  constexpr absl::string_view client_info = "client";
+  constexpr absl::string_view server_info = "server";
+
+  // As in DeriveRecordProtocolKey(), randomize the key bytes so that a key
+  // mistakenly used after a failed derivation does not contain predictable
+  // uninitialized memory.
+  client_key->resize(kAltsRecordProtocolAes128GcmKeySize);
+  RAND_bytes(client_key->data(), client_key->size());
+  server_key->resize(kAltsRecordProtocolAes128GcmKeySize);
+  RAND_bytes(server_key->data(), server_key->size());
+
+  if (!HKDF(client_key->data(), client_key->size(), EVP_sha256(),
+            record_protocol_key.data(), record_protocol_key.size(),
+            reinterpret_cast<const uint8_t *>(salt.data()), salt.size(),
+            reinterpret_cast<const uint8_t *>(client_info.data()),
+            client_info.size()) ||
+      !HKDF(server_key->data(), server_key->size(), EVP_sha256(),
+            record_protocol_key.data(), record_protocol_key.size(),
+            reinterpret_cast<const uint8_t *>(salt.data()), salt.size(),
+            reinterpret_cast<const uint8_t *>(server_info.data()),
+            server_info.size())) {
+    LOG(ERROR) << "HKDF failed: " << BsslLastErrorString();
+    return Status(Abort::INTERNAL_ERROR, "Internal error");
+  }
+  return Status::OkStatus();
+}
+
+Status DeriveResumptionMasterSecret(
+    const HandshakeCipher &ciphersuite, ByteContainerView primary_secret,
+    CleansingVector<uint8_t> *resumption_master_secret) {
+  resumption_master_secret->clear();
+  const EVP_MD *digest = nullptr;
+  switch (ciphersuite) {
+    case CURVE25519_SHA256:
+      digest = EVP_sha256();
+      break;
+    default:
+      return Status(
+          Abort::BAD_HANDSHAKE_CIPHER,
+          "Ciphersuite not supported: " + ProtoEnumValueName(ciphersuite));
+  }
+
+  constexpr absl::string_view salt = kEkepHkdfSaltResumptionMaster;
+  resumption_master_secret->resize(kEkepResumptionMasterSecretSize);
+  if (!HKDF(resumption_master_secret->data(), kEkepResumptionMasterSecretSize,
+            digest, primary_secret.data(), primary_secret.size(),
+            reinterpret_cast<const uint8_t *>(salt.data()), salt.size(),
+            /*info=*/nullptr, /*info_len=*/0)) {
+    LOG(ERROR) << "HKDF failed: " << BsslLastErrorString();
+    return Status(Abort::INTERNAL_ERROR, "Internal error");
+  }
+  return Status::OkStatus();
+}
+
+Status DeriveResumptionSecrets(const HandshakeCipher &ciphersuite,
+                               ByteContainerView transcript_hash,
+                               ByteContainerView resumption_master_secret,
+                               CleansingVector<uint8_t> *primary_secret,
+                               CleansingVector<uint8_t> *authenticator_secret) {
+  const EVP_MD *digest = nullptr;
+  switch (ciphersuite) {
+    case CURVE25519_SHA256:
+      digest = EVP_sha256();
+      break;
+    default:
+      return Status(
+          Abort::BAD_HANDSHAKE_CIPHER,
+          "Ciphersuite not supported: " + ProtoEnumValueName(ciphersuite));
+  }
+
+  if (resumption_master_secret.size() != kEkepResumptionMasterSecretSize) {
+    return Status(
+        Abort::PROTOCOL_ERROR,
+        absl::StrCat("Resumption master secret has incorrect size: ",
+                     resumption_master_secret.size()));
+  }
+
+  // Derive the primary and authenticator secrets using HKDF, with the
+  // resumption master secret taking the place of the Diffie-Hellman shared
+  // secret used by DeriveSecrets().
+  constexpr absl::string_view salt = kEkepHkdfSaltResumption;
+  CleansingVector<uint8_t> output_key;
+  output_key.resize(kEkepSecretSize);
+  if (!HKDF(output_key.data(), kEkepSecretSize, digest,
+            resumption_master_secret.data(), resumption_master_secret.size(),
+            reinterpret_cast<const uint8_t *>(salt.data()), salt.size(),
+            transcript_hash.data(), transcript_hash.size())) {
+    LOG(ERROR) << "HKDF failed: " << BsslLastErrorString();
+    return Status(Abort::INTERNAL_ERROR, "Internal error");
+  }
+
+  // Copy the primary secret.
+  primary_secret->reserve(primary_secret->size() + kEkepPrimarySecretSize);
+  std::copy(output_key.cbegin(), output_key.cbegin() + kEkepPrimarySecretSize,
+            std::back_inserter(*primary_secret));
+
+  // Copy the authenticator secret.
+  authenticator_secret->reserve(authenticator_secret->size() +
+                                kEkepAuthenticatorSecretSize);
+  std::copy(output_key.cbegin() + kEkepPrimarySecretSize, output_key.cend(),
+            std::back_inserter(*authenticator_secret));
+
+  return Status::OkStatus();
+}
+
 Status ComputeClientHandshakeAuthenticator(
     const HandshakeCipher &ciphersuite, ByteContainerView authenticator_secret,
     CleansingVector<uint8_t> *authenticator) {
-  std::string input(kClientAuthenticatedText);
-  return Hmac(ciphersuite, authenticator_secret, input, authenticator);
+  return Hmac(ciphersuite, authenticator_secret, kClientAuthenticatedText,
+              authenticator);
 }
 
 Status ComputeServerHandshakeAuthenticator(
     const HandshakeCipher &ciphersuite, ByteContainerView authenticator_secret,
     CleansingVector<uint8_t> *authenticator) {
-  std::string input(kServerAuthenticatedText);
-  return Hmac(ciphersuite, authenticator_secret, input, authenticator);
+  return Hmac(ciphersuite, authenticator_secret, kServerAuthenticatedText,
+              authenticator);
 }
 
 bool CheckMacEquality(CleansingVector<uint8_t> mac1,
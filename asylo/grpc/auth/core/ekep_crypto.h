@@ -32,6 +32,7 @@ namespace asylo {
 
 constexpr size_t kEkepPrimarySecretSize = 64;
 constexpr size_t kEkepAuthenticatorSecretSize = 64;
+constexpr size_t kEkepResumptionMasterSecretSize = 32;
 constexpr size_t kAltsRecordProtocolAes128GcmKeySize = 16;
 
 // Derives EKEP secrets based on the selected |ciphersuite| and the input
@@ -73,6 +74,58 @@ Status DeriveRecordProtocolKey(const HandshakeCipher &ciphersuite,
                                ByteContainerView primary_secret,
                                CleansingVector<uint8_t> *record_protocol_key);
 
+// Derives the pair of direction keys protecting an attested shared-memory
+// channel from |record_protocol_key| using HKDF with SHA-256. The client
+// seals outbound traffic with |client_key| and opens inbound traffic with
+// |server_key|; the server does the reverse. Separate keys per direction keep
+// the two senders' nonce spaces disjoint. Both keys are sized for AES-128-GCM.
+//
+// Note that |record_protocol_key| is a ByteContainerView, which does not
+// enforce any data safety policy on the underlying container. The caller
+// should take care to pass the key using a self-cleansing container.
+//
+// Returns INTERNAL_ERROR on derivation failure.
+Status DeriveSharedMemoryChannelKeys(ByteContainerView record_protocol_key,
+                                     CleansingVector<uint8_t> *client_key,
+                                     CleansingVector<uint8_t> *server_key);
+
+// Derives a resumption master secret from |primary_secret| using HKDF
+// initialized with the hash function from |ciphersuite|. On success, writes
+// the resumption master secret to |resumption_master_secret|. Both
+// participants of a handshake derive the same resumption master secret, which
+// can later be used to resume the session via DeriveResumptionSecrets().
+//
+// Note that |primary_secret| is a ByteContainerView, which does not enforce
+// any data safety policy on the underlying container. The caller should take
+// care to pass their primary secret using a self-cleansing container.
+//
+// If the ciphersuite is unsupported, returns BAD_HANDSHAKE_CIPHER.
+// Returns INTERNAL_ERROR on other errors.
+Status DeriveResumptionMasterSecret(
+    const HandshakeCipher &ciphersuite, ByteContainerView primary_secret,
+    CleansingVector<uint8_t> *resumption_master_secret);
+
+// Derives EKEP secrets for a resumed handshake based on the selected
+// |ciphersuite| and the input |transcript_hash| and
+// |resumption_master_secret|. On success, writes the primary secret to
+// |primary_secret| and the authenticator secret to |authenticator_secret|.
+// This function replaces DeriveSecrets() in a resumed handshake, which has no
+// Diffie-Hellman exchange.
+//
+// Note that |resumption_master_secret| is a ByteContainerView, which does not
+// enforce any data safety policy on the underlying container. The caller
+// should take care to pass their resumption master secret using a
+// self-cleansing container.
+//
+// If the ciphersuite is unsupported, returns BAD_HANDSHAKE_CIPHER.
+// If the resumption master secret has an invalid size, returns PROTOCOL_ERROR.
+// Returns INTERNAL_ERROR on other errors.
+Status DeriveResumptionSecrets(const HandshakeCipher &ciphersuite,
+                               ByteContainerView transcript_hash,
+                               ByteContainerView resumption_master_secret,
+                               CleansingVector<uint8_t> *primary_secret,
+                               CleansingVector<uint8_t> *authenticator_secret);
+
 // The following two methods compute the handshake authenticator for the
 // client and the server using HMAC initialized with the hash function from
 // |ciphersuite|, and the key in |authenticator_secret|. On success they write
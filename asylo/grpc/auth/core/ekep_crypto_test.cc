@@ -185,6 +185,108 @@ TEST(EkepCryptoTest, DeriveSecretsWithCurve25519Sha256) {
   EXPECT_EQ(*actual_authenticator_secret, expected_authenticator_secret);
 }
 
+// Verify that DeriveResumptionMasterSecret fails and returns
+// BAD_HANDSHAKE_CIPHER when passed an unsupported ciphersuite.
+TEST(EkepCryptoTest, DeriveResumptionMasterSecretBadCiphersuite) {
+  std::vector<uint8_t> primary_secret;
+  CleansingVector<uint8_t> resumption_master_secret;
+
+  Status status = DeriveResumptionMasterSecret(
+      UNKNOWN_HANDSHAKE_CIPHER, primary_secret, &resumption_master_secret);
+  EXPECT_THAT(status, Not(IsOk()));
+  EXPECT_THAT(status, StatusIs(Abort::BAD_HANDSHAKE_CIPHER));
+}
+
+// Verify that DeriveResumptionMasterSecret produces a secret of the expected
+// size and that the derivation is deterministic in the primary secret.
+TEST(EkepCryptoTest, DeriveResumptionMasterSecretIsDeterministic) {
+  SafeBytes<kEkepPrimarySecretSize> primary_secret;
+  ASYLO_ASSERT_OK(
+      SetTrivialObjectFromHexString(kTestPrimarySecret, &primary_secret));
+
+  CleansingVector<uint8_t> resumption_master_secret1;
+  ASYLO_ASSERT_OK(DeriveResumptionMasterSecret(CURVE25519_SHA256,
+                                               primary_secret,
+                                               &resumption_master_secret1));
+  EXPECT_EQ(resumption_master_secret1.size(), kEkepResumptionMasterSecretSize);
+
+  CleansingVector<uint8_t> resumption_master_secret2;
+  ASYLO_ASSERT_OK(DeriveResumptionMasterSecret(CURVE25519_SHA256,
+                                               primary_secret,
+                                               &resumption_master_secret2));
+  EXPECT_EQ(resumption_master_secret1, resumption_master_secret2);
+}
+
+// Verify that DeriveResumptionSecrets fails and returns BAD_HANDSHAKE_CIPHER
+// when passed an unsupported ciphersuite.
+TEST(EkepCryptoTest, DeriveResumptionSecretsBadCiphersuite) {
+  std::string transcript_hash;
+  std::vector<uint8_t> resumption_master_secret(
+      kEkepResumptionMasterSecretSize);
+  CleansingVector<uint8_t> authenticator_secret;
+  CleansingVector<uint8_t> primary_secret;
+
+  Status status = DeriveResumptionSecrets(
+      UNKNOWN_HANDSHAKE_CIPHER, transcript_hash, resumption_master_secret,
+      &primary_secret, &authenticator_secret);
+  EXPECT_THAT(status, Not(IsOk()));
+  EXPECT_THAT(status, StatusIs(Abort::BAD_HANDSHAKE_CIPHER));
+}
+
+// Verify that DeriveResumptionSecrets fails and returns PROTOCOL_ERROR when
+// passed a resumption master secret that has an invalid size.
+TEST(EkepCryptoTest, DeriveResumptionSecretsBadMasterSecretSize) {
+  UnsafeBytes<kSha256DigestLength> transcript_hash;
+  ASYLO_ASSERT_OK(
+      SetTrivialObjectFromHexString(kTestTranscriptHash, &transcript_hash));
+
+  // Resumption master secret is empty.
+  std::vector<uint8_t> resumption_master_secret;
+
+  CleansingVector<uint8_t> authenticator_secret;
+  CleansingVector<uint8_t> primary_secret;
+
+  Status status = DeriveResumptionSecrets(
+      CURVE25519_SHA256, transcript_hash, resumption_master_secret,
+      &primary_secret, &authenticator_secret);
+  EXPECT_THAT(status, Not(IsOk()));
+  EXPECT_THAT(status, StatusIs(Abort::PROTOCOL_ERROR));
+}
+
+// Verify that DeriveResumptionSecrets produces secrets of the expected sizes
+// and that two derivations with the same inputs agree, as the client and
+// server of a resumed handshake must.
+TEST(EkepCryptoTest, DeriveResumptionSecretsWithCurve25519Sha256) {
+  UnsafeBytes<kSha256DigestLength> transcript_hash;
+  ASYLO_ASSERT_OK(
+      SetTrivialObjectFromHexString(kTestTranscriptHash, &transcript_hash));
+
+  SafeBytes<kEkepPrimarySecretSize> original_primary_secret;
+  ASYLO_ASSERT_OK(SetTrivialObjectFromHexString(kTestPrimarySecret,
+                                                &original_primary_secret));
+
+  CleansingVector<uint8_t> resumption_master_secret;
+  ASYLO_ASSERT_OK(DeriveResumptionMasterSecret(CURVE25519_SHA256,
+                                               original_primary_secret,
+                                               &resumption_master_secret));
+
+  CleansingVector<uint8_t> client_primary_secret;
+  CleansingVector<uint8_t> client_authenticator_secret;
+  ASYLO_ASSERT_OK(DeriveResumptionSecrets(
+      CURVE25519_SHA256, transcript_hash, resumption_master_secret,
+      &client_primary_secret, &client_authenticator_secret));
+  EXPECT_EQ(client_primary_secret.size(), kEkepPrimarySecretSize);
+  EXPECT_EQ(client_authenticator_secret.size(), kEkepAuthenticatorSecretSize);
+
+  CleansingVector<uint8_t> server_primary_secret;
+  CleansingVector<uint8_t> server_authenticator_secret;
+  ASYLO_ASSERT_OK(DeriveResumptionSecrets(
+      CURVE25519_SHA256, transcript_hash, resumption_master_secret,
+      &server_primary_secret, &server_authenticator_secret));
+  EXPECT_EQ(client_primary_secret, server_primary_secret);
+  EXPECT_EQ(client_authenticator_secret, server_authenticator_secret);
+}
+
 // Verify that DeriveRecordProtocolKey fails and returns BAD_HANDSHAKE_CIPHER
 // when passed an unsupported ciphersuite.
 TEST(EkepCryptoTest, DeriveRecordProtocolKeyBadCiphersuite) {
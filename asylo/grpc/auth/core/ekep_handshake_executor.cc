@@ -0,0 +1,95 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/grpc/auth/core/ekep_handshake_executor.h"
+
+#include <thread>
+#include <utility>
+
+#include "absl/status/status.h"
+
+namespace asylo {
+namespace {
+
+// The number of worker threads in the default executor when the hardware
+// concurrency cannot be determined.
+constexpr size_t kDefaultNumWorkers = 4;
+
+// The queue depth of the default executor. Tasks beyond this limit are run
+// inline by the caller, so the limit only bounds how much handshake work can
+// be deferred, not how many handshakes can be in flight.
+constexpr size_t kDefaultMaxQueuedTasks = 256;
+
+}  // namespace
+
+EkepHandshakeExecutor::EkepHandshakeExecutor(size_t num_workers,
+                                             size_t max_queued_tasks)
+    : max_queued_tasks_(max_queued_tasks), shutting_down_(false) {
+  workers_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+EkepHandshakeExecutor::~EkepHandshakeExecutor() {
+  {
+    absl::MutexLock lock(&mu_);
+    shutting_down_ = true;
+  }
+  for (Thread &worker : workers_) {
+    worker.Join();
+  }
+}
+
+Status EkepHandshakeExecutor::Schedule(std::function<void()> task) {
+  absl::MutexLock lock(&mu_);
+  if (tasks_.size() >= max_queued_tasks_) {
+    return absl::ResourceExhaustedError("Handshake executor queue is full");
+  }
+  tasks_.push(std::move(task));
+  return Status::OkStatus();
+}
+
+EkepHandshakeExecutor *EkepHandshakeExecutor::Default() {
+  static EkepHandshakeExecutor *executor = [] {
+    size_t num_workers = std::thread::hardware_concurrency();
+    if (num_workers == 0) {
+      num_workers = kDefaultNumWorkers;
+    }
+    return new EkepHandshakeExecutor(num_workers, kDefaultMaxQueuedTasks);
+  }();
+  return executor;
+}
+
+void EkepHandshakeExecutor::WorkerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      absl::MutexLock lock(&mu_);
+      mu_.Await(absl::Condition(this, &EkepHandshakeExecutor::HasWork));
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
+
+}  // namespace asylo
@@ -0,0 +1,88 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_GRPC_AUTH_CORE_EKEP_HANDSHAKE_EXECUTOR_H_
+#define ASYLO_GRPC_AUTH_CORE_EKEP_HANDSHAKE_EXECUTOR_H_
+
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "asylo/util/status.h"
+#include "asylo/util/thread.h"
+
+namespace asylo {
+
+// Executes EKEP handshake steps on a bounded pool of worker threads.
+//
+// Offloading handshake cryptography from the threads that drive established
+// streams keeps a burst of incoming connections, such as a reconnect storm
+// after a rolling restart, from starving stream processing, and allows the
+// asymmetric crypto and assertion work of concurrent handshakes to run in
+// parallel on multi-core hosts.
+//
+// The executor queues at most |max_queued_tasks| tasks beyond those already
+// running. Scheduling fails once the queue is full, leaving the caller to run
+// the task inline or reject the connection.
+//
+// This class is thread-safe.
+class EkepHandshakeExecutor {
+ public:
+  // Creates an executor with |num_workers| worker threads and room for
+  // |max_queued_tasks| queued tasks.
+  EkepHandshakeExecutor(size_t num_workers, size_t max_queued_tasks);
+
+  // Runs any queued tasks to completion and joins the worker threads.
+  ~EkepHandshakeExecutor();
+
+  EkepHandshakeExecutor(const EkepHandshakeExecutor &) = delete;
+  EkepHandshakeExecutor &operator=(const EkepHandshakeExecutor &) = delete;
+
+  // Enqueues |task| for execution on a worker thread. Returns a
+  // RESOURCE_EXHAUSTED Status without enqueueing if the queue is full.
+  Status Schedule(std::function<void()> task);
+
+  // Returns the process-wide executor used for EKEP handshakes. The executor
+  // is created on first use and is never destroyed.
+  static EkepHandshakeExecutor *Default();
+
+ private:
+  // The work loop run by each worker thread. Returns when the executor is
+  // shutting down and the queue is empty.
+  void WorkerLoop();
+
+  // Returns true if a worker thread has a task to run or should shut down.
+  bool HasWork() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return shutting_down_ || !tasks_.empty();
+  }
+
+  const size_t max_queued_tasks_;
+
+  absl::Mutex mu_;
+  std::queue<std::function<void()>> tasks_ ABSL_GUARDED_BY(mu_);
+  bool shutting_down_ ABSL_GUARDED_BY(mu_);
+
+  std::vector<Thread> workers_;
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_GRPC_AUTH_CORE_EKEP_HANDSHAKE_EXECUTOR_H_
@@ -0,0 +1,78 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/grpc/auth/core/ekep_handshake_executor.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/notification.h"
+#include "asylo/test/util/status_matchers.h"
+
+namespace asylo {
+namespace {
+
+// Verify that scheduled tasks run to completion before the executor is
+// destroyed.
+TEST(EkepHandshakeExecutorTest, RunsAllScheduledTasks) {
+  constexpr int kNumTasks = 32;
+  absl::BlockingCounter counter(kNumTasks);
+  {
+    EkepHandshakeExecutor executor(/*num_workers=*/4,
+                                   /*max_queued_tasks=*/kNumTasks);
+    for (int i = 0; i < kNumTasks; ++i) {
+      ASYLO_ASSERT_OK(
+          executor.Schedule([&counter] { counter.DecrementCount(); }));
+    }
+  }
+  counter.Wait();
+}
+
+// Verify that Schedule fails with RESOURCE_EXHAUSTED once the queue is full,
+// and that scheduling succeeds again after the queue drains.
+TEST(EkepHandshakeExecutorTest, RejectsTasksWhenQueueIsFull) {
+  absl::Notification unblock_worker;
+  absl::Notification worker_running;
+  EkepHandshakeExecutor executor(/*num_workers=*/1, /*max_queued_tasks=*/1);
+
+  // Occupy the single worker so that subsequently scheduled tasks queue up.
+  ASYLO_ASSERT_OK(executor.Schedule([&unblock_worker, &worker_running] {
+    worker_running.Notify();
+    unblock_worker.WaitForNotification();
+  }));
+  worker_running.WaitForNotification();
+
+  // The first queued task fills the queue; the second is rejected.
+  ASYLO_ASSERT_OK(executor.Schedule([] {}));
+  EXPECT_THAT(executor.Schedule([] {}),
+              StatusIs(absl::StatusCode::kResourceExhausted));
+
+  unblock_worker.Notify();
+}
+
+// Verify that the process-wide default executor exists and accepts tasks.
+TEST(EkepHandshakeExecutorTest, DefaultExecutorRunsTasks) {
+  absl::Notification done;
+  ASYLO_ASSERT_OK(
+      EkepHandshakeExecutor::Default()->Schedule([&done] { done.Notify(); }));
+  done.WaitForNotification();
+}
+
+}  // namespace
+}  // namespace asylo
@@ -243,6 +243,26 @@ StatusOr<CleansingVector<uint8_t>> EkepHandshaker::GetRecordProtocolKey() {
   return record_protocol_key_;
 }
 
+StatusOr<std::unique_ptr<EkepResumptionState>>
+EkepHandshaker::GetResumptionState() {
+  if (!IsHandshakeCompleted()) {
+    return Status(::absl::StatusCode::kFailedPrecondition,
+                  "Cannot retrieve resumption state before handshake is "
+                  "complete");
+  }
+  if (resumption_state_ == nullptr) {
+    return Status(::absl::StatusCode::kNotFound,
+                  "Peer did not issue a resumption ticket");
+  }
+
+  return std::move(resumption_state_);
+}
+
+void EkepHandshaker::SetResumptionState(
+    std::unique_ptr<EkepResumptionState> resumption_state) {
+  resumption_state_ = std::move(resumption_state);
+}
+
 EkepHandshaker::EkepHandshaker(int max_frame_size)
     : max_frame_size_(max_frame_size) {
   peer_identities_ = absl::make_unique<EnclaveIdentities>();
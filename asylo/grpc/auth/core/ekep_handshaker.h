@@ -25,6 +25,7 @@
 #include <google/protobuf/message.h>
 #include "asylo/crypto/hash_interface.h"
 #include "asylo/crypto/util/byte_container_view.h"
+#include "asylo/grpc/auth/core/ekep_resumption.h"
 #include "asylo/grpc/auth/core/handshake.pb.h"
 #include "asylo/grpc/auth/core/transcript.h"
 #include "asylo/grpc/auth/util/multi_buffer_input_stream.h"
@@ -154,6 +155,13 @@ class EkepHandshaker {
   // GoogleError::FAILED_PRECONDITION.
   StatusOr<CleansingVector<uint8_t>> GetRecordProtocolKey();
 
+  // Returns the state with which a future session with the same peer can be
+  // resumed, given that the handshake has successfully completed. If the
+  // handshake has not yet completed, returns GoogleError::FAILED_PRECONDITION.
+  // If the peer did not issue a resumption ticket during the handshake,
+  // returns GoogleError::NOT_FOUND.
+  StatusOr<std::unique_ptr<EkepResumptionState>> GetResumptionState();
+
  protected:
   enum class HandshakeState {
     NOT_STARTED = 0,
@@ -198,6 +206,14 @@ class EkepHandshaker {
   // Adds an identity to the list of peer identities.
   void AddPeerIdentity(const EnclaveIdentity &identity);
 
+  // Returns the peer identities collected so far. Unlike GetPeerIdentities(),
+  // this method may be called before the handshake completes.
+  const EnclaveIdentities &PeerIdentities() const { return *peer_identities_; }
+
+  // Makes |resumption_state| available through GetResumptionState().
+  void SetResumptionState(
+      std::unique_ptr<EkepResumptionState> resumption_state);
+
   // Sets the record protocol to use after the handshake completes.
   void SetRecordProtocol(RecordProtocol record_protocol);
 
@@ -286,6 +302,10 @@ class EkepHandshaker {
 
   // The key used in the record protocol.
   CleansingVector<uint8_t> record_protocol_key_;
+
+  // State with which a future session can be resumed, if the peer issued a
+  // resumption ticket during the handshake.
+  std::unique_ptr<EkepResumptionState> resumption_state_;
 };
 
 }  // namespace asylo
@@ -18,7 +18,6 @@
 
 #include "asylo/grpc/auth/core/ekep_handshaker_util.h"
 
-#include <google/protobuf/util/message_differencer.h>
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -71,6 +70,14 @@ Status EkepHandshakerOptions::Validate() const {
         "Must supply at least one accepted peer assertion");
   }
 
+  if (resumption_state != nullptr &&
+      (resumption_state->ticket.empty() ||
+       resumption_state->resumption_master_secret.empty())) {
+    return absl::InvalidArgumentError(
+        "resumption_state must have a non-empty ticket and resumption master "
+        "secret");
+  }
+
   for (const AssertionDescription &description : self_assertions) {
     StatusOr<std::string> authority_id_result =
         EnclaveAssertionAuthority::GenerateAuthorityId(
@@ -111,10 +118,15 @@ Status EkepHandshakerOptions::Validate() const {
 std::vector<AssertionDescription>::const_iterator FindAssertionDescription(
     const std::vector<AssertionDescription> &list,
     const AssertionDescription &description) {
+  // Compare the two fields directly rather than through MessageDifferencer;
+  // this runs once per offered or requested assertion on every handshake, and
+  // reflection-based comparison dominated its cost.
   return std::find_if(list.cbegin(), list.cend(),
                       [&description](const AssertionDescription &desc) -> bool {
-                        return google::protobuf::util::MessageDifferencer::Equals(
-                            desc, description);
+                        return desc.identity_type() ==
+                                   description.identity_type() &&
+                               desc.authority_type() ==
+                                   description.authority_type();
                       });
 }
 
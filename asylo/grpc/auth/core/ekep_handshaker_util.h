@@ -19,9 +19,11 @@
 #ifndef ASYLO_GRPC_AUTH_CORE_EKEP_HANDSHAKER_UTIL_H_
 #define ASYLO_GRPC_AUTH_CORE_EKEP_HANDSHAKER_UTIL_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "asylo/grpc/auth/core/ekep_resumption.h"
 #include "asylo/identity/attestation/enclave_assertion_generator.h"
 #include "asylo/identity/attestation/enclave_assertion_verifier.h"
 #include "asylo/identity/identity.pb.h"
@@ -45,6 +47,16 @@ struct EkepHandshakerOptions {
   // Additional data presented by the EKEP participant during the handshake.
   std::string additional_authenticated_data;
 
+  // State from a previous session with the server that the participant wants
+  // to resume. Only meaningful for client handshakers. If null, the client
+  // performs a full handshake.
+  std::shared_ptr<const EkepResumptionState> resumption_state;
+
+  // Sealer used to issue and redeem resumption tickets. Only meaningful for
+  // server handshakers. If null, the server neither issues tickets nor
+  // accepts resumption attempts.
+  std::shared_ptr<EkepResumptionTicketSealer> resumption_ticket_sealer;
+
   // Validates the handshaker options. All of the following conditions must
   // hold, otherwise returns INVALID_ARGUMENT:
   //   * max_frame_size is non-zero and does not exceed
@@ -57,6 +69,8 @@ struct EkepHandshakerOptions {
   //   appropriate assertion-verification library available
   //   * The size of additional_authenticated_data is less than or equal to
   //   max_frame_size
+  //   * If resumption_state is set, its ticket and resumption master secret
+  //   are non-empty
   Status Validate() const;
 };
 
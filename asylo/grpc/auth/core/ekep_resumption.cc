@@ -0,0 +1,123 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/grpc/auth/core/ekep_resumption.h"
+
+#include <openssl/rand.h>
+
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/time/clock.h"
+#include "absl/types/span.h"
+#include "asylo/grpc/auth/core/ekep_error_space.h"
+#include "asylo/util/cleansing_types.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+namespace {
+
+// The size of the randomly-generated AES-256-GCM-SIV ticket sealing key.
+constexpr size_t kTicketSealingKeySize = 32;
+
+// Additional authenticated data bound to every sealed ticket.
+constexpr char kTicketAad[] = "EKEP Resumption Ticket v1";
+
+}  // namespace
+
+StatusOr<std::unique_ptr<EkepResumptionTicketSealer>>
+EkepResumptionTicketSealer::Create(absl::Duration ticket_lifetime) {
+  CleansingVector<uint8_t> key(kTicketSealingKeySize);
+  if (RAND_bytes(key.data(), key.size()) != 1) {
+    return Status(Abort::INTERNAL_ERROR,
+                  "Failed to generate ticket sealing key");
+  }
+
+  std::unique_ptr<AeadCryptor> cryptor;
+  ASYLO_ASSIGN_OR_RETURN(
+      cryptor, AeadCryptor::CreateAesGcmSivCryptor(
+                   ByteContainerView(key.data(), key.size())));
+  return absl::WrapUnique(
+      new EkepResumptionTicketSealer(std::move(cryptor), ticket_lifetime));
+}
+
+EkepResumptionTicketSealer::EkepResumptionTicketSealer(
+    std::unique_ptr<AeadCryptor> cryptor, absl::Duration ticket_lifetime)
+    : ticket_lifetime_(ticket_lifetime), cryptor_(std::move(cryptor)) {}
+
+Status EkepResumptionTicketSealer::Seal(EkepResumptionTicketPayload payload,
+                                        std::string *ticket) {
+  payload.set_expiration_time(
+      absl::ToUnixSeconds(absl::Now() + ticket_lifetime_));
+
+  CleansingVector<uint8_t> plaintext(payload.ByteSizeLong());
+  if (!payload.SerializeToArray(plaintext.data(), plaintext.size())) {
+    return Status(Abort::INTERNAL_ERROR,
+                  "Failed to serialize resumption ticket payload");
+  }
+
+  absl::MutexLock lock(&mu_);
+
+  // A ticket consists of the nonce used by the Seal() operation followed by
+  // the authenticated ciphertext.
+  std::vector<uint8_t> buffer(cryptor_->NonceSize() + plaintext.size() +
+                              cryptor_->MaxSealOverhead());
+  absl::Span<uint8_t> nonce(buffer.data(), cryptor_->NonceSize());
+  absl::Span<uint8_t> ciphertext(buffer.data() + cryptor_->NonceSize(),
+                                 buffer.size() - cryptor_->NonceSize());
+  size_t ciphertext_size;
+  ASYLO_RETURN_IF_ERROR(cryptor_->Seal(
+      ByteContainerView(plaintext.data(), plaintext.size()),
+      ByteContainerView(kTicketAad, sizeof(kTicketAad) - 1), nonce, ciphertext,
+      &ciphertext_size));
+
+  ticket->assign(reinterpret_cast<const char *>(buffer.data()),
+                 cryptor_->NonceSize() + ciphertext_size);
+  return Status::OkStatus();
+}
+
+Status EkepResumptionTicketSealer::Open(
+    ByteContainerView ticket, EkepResumptionTicketPayload *payload) const {
+  absl::MutexLock lock(&mu_);
+
+  if (ticket.size() <= cryptor_->NonceSize()) {
+    return Status(Abort::PROTOCOL_ERROR, "Resumption ticket is too short");
+  }
+  ByteContainerView nonce(ticket.data(), cryptor_->NonceSize());
+  ByteContainerView ciphertext(ticket.data() + cryptor_->NonceSize(),
+                               ticket.size() - cryptor_->NonceSize());
+
+  CleansingVector<uint8_t> plaintext(ciphertext.size());
+  size_t plaintext_size;
+  ASYLO_RETURN_IF_ERROR(cryptor_->Open(
+      ciphertext, ByteContainerView(kTicketAad, sizeof(kTicketAad) - 1), nonce,
+      absl::MakeSpan(plaintext.data(), plaintext.size()), &plaintext_size));
+
+  if (!payload->ParseFromArray(plaintext.data(), plaintext_size)) {
+    return Status(Abort::PROTOCOL_ERROR,
+                  "Failed to parse resumption ticket payload");
+  }
+
+  if (absl::FromUnixSeconds(payload->expiration_time()) < absl::Now()) {
+    return Status(Abort::PROTOCOL_ERROR, "Resumption ticket has expired");
+  }
+  return Status::OkStatus();
+}
+
+}  // namespace asylo
@@ -0,0 +1,98 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_GRPC_AUTH_CORE_EKEP_RESUMPTION_H_
+#define ASYLO_GRPC_AUTH_CORE_EKEP_RESUMPTION_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "asylo/crypto/aead_cryptor.h"
+#include "asylo/crypto/util/byte_container_view.h"
+#include "asylo/grpc/auth/core/handshake.pb.h"
+#include "asylo/identity/identity.pb.h"
+#include "asylo/util/cleansing_types.h"
+#include "asylo/util/status.h"
+#include "asylo/util/statusor.h"
+
+namespace asylo {
+
+// The client-side state needed to resume a previous EKEP session. The |ticket|
+// field is opaque to the client; the remaining fields mirror what the issuing
+// server stored inside the ticket.
+struct EkepResumptionState {
+  // The sealed ticket to present in a ClientPrecommit when resuming.
+  std::string ticket;
+
+  // The secret shared with the issuing server, from which the secrets of the
+  // resumed handshake are derived.
+  CleansingVector<uint8_t> resumption_master_secret;
+
+  // Parameters that were negotiated during the original handshake.
+  std::string ekep_version;
+  HandshakeCipher cipher_suite = UNKNOWN_HANDSHAKE_CIPHER;
+  RecordProtocol record_protocol = UNKNOWN_RECORD_PROTOCOL;
+
+  // The peer identities that were verified during the original handshake.
+  std::vector<EnclaveIdentity> peer_identities;
+};
+
+// Issues and validates sealed EKEP resumption tickets on behalf of a server.
+//
+// Tickets are sealed with an AEAD cipher under a key that is generated at
+// random when the sealer is created and never leaves the sealer. As a
+// consequence, tickets can only be redeemed at the server that issued them and
+// become unredeemable when the issuing server restarts, which bounds the
+// lifetime of the resumption master secrets they contain.
+//
+// This class is thread-safe.
+class EkepResumptionTicketSealer {
+ public:
+  // Creates a sealer whose tickets expire |ticket_lifetime| after issuance.
+  // Returns a non-OK Status if the underlying cryptor could not be created.
+  static StatusOr<std::unique_ptr<EkepResumptionTicketSealer>> Create(
+      absl::Duration ticket_lifetime);
+
+  // Seals |payload| into an opaque ticket and writes it to |ticket|. The
+  // |expiration_time| field of |payload| is set by this method; any value
+  // provided by the caller is overwritten.
+  Status Seal(EkepResumptionTicketPayload payload, std::string *ticket);
+
+  // Unseals |ticket| into |payload|. Returns a non-OK Status if the ticket
+  // was not issued by this sealer, was tampered with, or has expired.
+  Status Open(ByteContainerView ticket,
+              EkepResumptionTicketPayload *payload) const;
+
+ private:
+  explicit EkepResumptionTicketSealer(std::unique_ptr<AeadCryptor> cryptor,
+                                      absl::Duration ticket_lifetime);
+
+  const absl::Duration ticket_lifetime_;
+
+  mutable absl::Mutex mu_;
+  std::unique_ptr<AeadCryptor> cryptor_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_GRPC_AUTH_CORE_EKEP_RESUMPTION_H_
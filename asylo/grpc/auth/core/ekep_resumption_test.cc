@@ -0,0 +1,130 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/grpc/auth/core/ekep_resumption.h"
+
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/time/time.h"
+#include "asylo/grpc/auth/core/handshake.pb.h"
+#include "asylo/test/util/status_matchers.h"
+
+namespace asylo {
+namespace {
+
+using ::testing::Not;
+
+constexpr char kEkepVersion[] = "EKEP v1";
+constexpr char kResumptionMasterSecret[] = "0123456789abcdef0123456789abcdef";
+constexpr absl::Duration kTicketLifetime = absl::Hours(1);
+
+// Returns a ticket payload populated with test values.
+EkepResumptionTicketPayload MakeTestPayload() {
+  EkepResumptionTicketPayload payload;
+  payload.mutable_ekep_version()->set_name(kEkepVersion);
+  payload.set_cipher_suite(CURVE25519_SHA256);
+  payload.set_record_protocol(ALTSRP_AES128_GCM);
+  payload.set_resumption_master_secret(kResumptionMasterSecret);
+  payload.add_peer_identities()->set_identity("test identity");
+  return payload;
+}
+
+// Verify that a sealed ticket can be opened by the issuing sealer and that the
+// payload survives the round trip.
+TEST(EkepResumptionTest, SealOpenRoundTrip) {
+  std::unique_ptr<EkepResumptionTicketSealer> sealer;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      sealer, EkepResumptionTicketSealer::Create(kTicketLifetime));
+
+  std::string ticket;
+  ASYLO_ASSERT_OK(sealer->Seal(MakeTestPayload(), &ticket));
+  EXPECT_FALSE(ticket.empty());
+
+  EkepResumptionTicketPayload payload;
+  ASYLO_ASSERT_OK(sealer->Open(ticket, &payload));
+
+  EXPECT_EQ(payload.ekep_version().name(), kEkepVersion);
+  EXPECT_EQ(payload.cipher_suite(), CURVE25519_SHA256);
+  EXPECT_EQ(payload.record_protocol(), ALTSRP_AES128_GCM);
+  EXPECT_EQ(payload.resumption_master_secret(), kResumptionMasterSecret);
+  ASSERT_EQ(payload.peer_identities_size(), 1);
+  EXPECT_EQ(payload.peer_identities(0).identity(), "test identity");
+  EXPECT_TRUE(payload.has_expiration_time());
+}
+
+// Verify that a ticket cannot be opened if any of its bytes were modified.
+TEST(EkepResumptionTest, OpenFailsOnTamperedTicket) {
+  std::unique_ptr<EkepResumptionTicketSealer> sealer;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      sealer, EkepResumptionTicketSealer::Create(kTicketLifetime));
+
+  std::string ticket;
+  ASYLO_ASSERT_OK(sealer->Seal(MakeTestPayload(), &ticket));
+
+  ticket.back() ^= 1;
+
+  EkepResumptionTicketPayload payload;
+  EXPECT_THAT(sealer->Open(ticket, &payload), Not(IsOk()));
+}
+
+// Verify that a ticket issued by one sealer cannot be opened by another.
+TEST(EkepResumptionTest, OpenFailsWithDifferentSealer) {
+  std::unique_ptr<EkepResumptionTicketSealer> sealer;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      sealer, EkepResumptionTicketSealer::Create(kTicketLifetime));
+
+  std::unique_ptr<EkepResumptionTicketSealer> other_sealer;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      other_sealer, EkepResumptionTicketSealer::Create(kTicketLifetime));
+
+  std::string ticket;
+  ASYLO_ASSERT_OK(sealer->Seal(MakeTestPayload(), &ticket));
+
+  EkepResumptionTicketPayload payload;
+  EXPECT_THAT(other_sealer->Open(ticket, &payload), Not(IsOk()));
+}
+
+// Verify that a ticket that is too short to contain a nonce is rejected.
+TEST(EkepResumptionTest, OpenFailsOnTruncatedTicket) {
+  std::unique_ptr<EkepResumptionTicketSealer> sealer;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      sealer, EkepResumptionTicketSealer::Create(kTicketLifetime));
+
+  EkepResumptionTicketPayload payload;
+  EXPECT_THAT(sealer->Open("short", &payload), Not(IsOk()));
+}
+
+// Verify that an expired ticket is rejected.
+TEST(EkepResumptionTest, OpenFailsOnExpiredTicket) {
+  // A negative lifetime produces tickets that are expired at issuance.
+  std::unique_ptr<EkepResumptionTicketSealer> sealer;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      sealer, EkepResumptionTicketSealer::Create(-absl::Minutes(5)));
+
+  std::string ticket;
+  ASYLO_ASSERT_OK(sealer->Seal(MakeTestPayload(), &ticket));
+
+  EkepResumptionTicketPayload payload;
+  EXPECT_THAT(sealer->Open(ticket, &payload), Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace asylo
@@ -0,0 +1,185 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/grpc/auth/core/ekep_shared_memory_channel.h"
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "asylo/grpc/auth/core/ekep_crypto.h"
+#include "asylo/util/cleansing_types.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+namespace {
+
+// Encodes |sequence| in little-endian order as the associated data binding a
+// frame to its position in the direction's send sequence.
+void EncodeSequence(uint64_t sequence, uint8_t (&encoded)[sizeof(uint64_t)]) {
+  for (size_t i = 0; i < sizeof(encoded); ++i) {
+    encoded[i] = static_cast<uint8_t>(sequence >> (8 * i));
+  }
+}
+
+// Sends |frame| over |channel|, mapping a closed channel to an error status.
+Status SendFrame(SharedMemoryChannel *channel, const std::string &frame) {
+  if (!channel->Send(reinterpret_cast<const uint8_t *>(frame.data()),
+                     frame.size())) {
+    return absl::InternalError("Shared-memory channel closed while sending");
+  }
+  return Status::OkStatus();
+}
+
+}  // namespace
+
+StatusOr<std::unique_ptr<EkepSharedMemoryChannel>>
+EkepSharedMemoryChannel::Establish(std::unique_ptr<EkepHandshaker> handshaker,
+                                   bool is_client,
+                                   SharedMemoryChannel *send_channel,
+                                   SharedMemoryChannel *receive_channel) {
+  // Pump the handshake over the plaintext rings. The client opens the
+  // exchange by stepping the handshaker with no incoming bytes; both sides
+  // then alternate between reading the peer's frames and flushing their
+  // responses until the handshaker reports a terminal state.
+  std::string outgoing;
+  EkepHandshaker::Result result = EkepHandshaker::Result::IN_PROGRESS;
+  if (is_client) {
+    result = handshaker->NextHandshakeStep(nullptr, 0, &outgoing);
+    if (!outgoing.empty()) {
+      ASYLO_RETURN_IF_ERROR(SendFrame(send_channel, outgoing));
+    }
+  }
+  std::vector<uint8_t> incoming;
+  while (result == EkepHandshaker::Result::IN_PROGRESS ||
+         result == EkepHandshaker::Result::NOT_ENOUGH_DATA) {
+    if (!receive_channel->Receive(&incoming)) {
+      return Status(absl::StatusCode::kInternal,
+                    "Shared-memory channel closed during EKEP handshake");
+    }
+    result = handshaker->NextHandshakeStep(
+        reinterpret_cast<const char *>(incoming.data()), incoming.size(),
+        &outgoing);
+    if (!outgoing.empty()) {
+      // An outgoing frame accompanies IN_PROGRESS steps, the final COMPLETED
+      // step on the server, and ABORTED steps, which produce an Abort frame
+      // owed to the peer.
+      ASYLO_RETURN_IF_ERROR(SendFrame(send_channel, outgoing));
+    }
+  }
+  if (result != EkepHandshaker::Result::COMPLETED) {
+    return Status(absl::StatusCode::kInternal, "EKEP handshake aborted");
+  }
+
+  CleansingVector<uint8_t> record_protocol_key;
+  ASYLO_ASSIGN_OR_RETURN(record_protocol_key,
+                         handshaker->GetRecordProtocolKey());
+  CleansingVector<uint8_t> client_key;
+  CleansingVector<uint8_t> server_key;
+  ASYLO_RETURN_IF_ERROR(DeriveSharedMemoryChannelKeys(record_protocol_key,
+                                                      &client_key,
+                                                      &server_key));
+
+  std::unique_ptr<AeadCryptor> seal_cryptor;
+  ASYLO_ASSIGN_OR_RETURN(seal_cryptor, AeadCryptor::CreateAesGcmCryptor(
+                                           is_client ? client_key
+                                                     : server_key));
+  std::unique_ptr<AeadCryptor> open_cryptor;
+  ASYLO_ASSIGN_OR_RETURN(open_cryptor, AeadCryptor::CreateAesGcmCryptor(
+                                           is_client ? server_key
+                                                     : client_key));
+
+  std::unique_ptr<EnclaveIdentities> peer_identities;
+  ASYLO_ASSIGN_OR_RETURN(peer_identities, handshaker->GetPeerIdentities());
+
+  return absl::WrapUnique(new EkepSharedMemoryChannel(
+      std::move(seal_cryptor), std::move(open_cryptor),
+      std::move(*peer_identities), send_channel, receive_channel));
+}
+
+EkepSharedMemoryChannel::EkepSharedMemoryChannel(
+    std::unique_ptr<AeadCryptor> seal_cryptor,
+    std::unique_ptr<AeadCryptor> open_cryptor,
+    EnclaveIdentities peer_identities, SharedMemoryChannel *send_channel,
+    SharedMemoryChannel *receive_channel)
+    : seal_cryptor_(std::move(seal_cryptor)),
+      open_cryptor_(std::move(open_cryptor)),
+      peer_identities_(std::move(peer_identities)),
+      send_channel_(send_channel),
+      receive_channel_(receive_channel) {}
+
+Status EkepSharedMemoryChannel::Send(ByteContainerView plaintext) {
+  if (plaintext.size() > seal_cryptor_->MaxMessageSize()) {
+    return absl::InvalidArgumentError("Message too large to seal");
+  }
+  const size_t nonce_size = seal_cryptor_->NonceSize();
+
+  // The sealed frame carries the nonce followed by the ciphertext; the frame
+  // counter travels implicitly as associated data.
+  std::vector<uint8_t> frame(nonce_size + plaintext.size() +
+                             seal_cryptor_->MaxSealOverhead());
+  uint8_t sequence[sizeof(uint64_t)];
+  EncodeSequence(send_sequence_, sequence);
+  size_t ciphertext_size;
+  ASYLO_RETURN_IF_ERROR(seal_cryptor_->Seal(
+      plaintext, ByteContainerView(sequence, sizeof(sequence)),
+      absl::MakeSpan(frame.data(), nonce_size),
+      absl::MakeSpan(frame.data() + nonce_size, frame.size() - nonce_size),
+      &ciphertext_size));
+  frame.resize(nonce_size + ciphertext_size);
+
+  if (!send_channel_->Send(frame.data(), frame.size())) {
+    return absl::InternalError("Shared-memory channel closed while sending");
+  }
+  ++send_sequence_;
+  return Status::OkStatus();
+}
+
+Status EkepSharedMemoryChannel::Receive(std::vector<uint8_t> *plaintext) {
+  std::vector<uint8_t> frame;
+  if (!receive_channel_->Receive(&frame)) {
+    return absl::InternalError("Shared-memory channel closed while receiving");
+  }
+  const size_t nonce_size = open_cryptor_->NonceSize();
+  if (frame.size() < nonce_size) {
+    return absl::InternalError("Received frame too short to carry a nonce");
+  }
+
+  uint8_t sequence[sizeof(uint64_t)];
+  EncodeSequence(receive_sequence_, sequence);
+  plaintext->resize(frame.size() - nonce_size);
+  size_t plaintext_size;
+  ASYLO_RETURN_IF_ERROR(open_cryptor_->Open(
+      ByteContainerView(frame.data() + nonce_size, frame.size() - nonce_size),
+      ByteContainerView(sequence, sizeof(sequence)),
+      ByteContainerView(frame.data(), nonce_size),
+      absl::MakeSpan(plaintext->data(), plaintext->size()), &plaintext_size));
+  plaintext->resize(plaintext_size);
+  ++receive_sequence_;
+  return Status::OkStatus();
+}
+
+void EkepSharedMemoryChannel::Close() {
+  send_channel_->Close();
+  receive_channel_->Close();
+}
+
+}  // namespace asylo
@@ -0,0 +1,101 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_GRPC_AUTH_CORE_EKEP_SHARED_MEMORY_CHANNEL_H_
+#define ASYLO_GRPC_AUTH_CORE_EKEP_SHARED_MEMORY_CHANNEL_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "asylo/crypto/aead_cryptor.h"
+#include "asylo/crypto/util/byte_container_view.h"
+#include "asylo/grpc/auth/core/ekep_handshaker.h"
+#include "asylo/identity/identity.pb.h"
+#include "asylo/platform/common/shared_memory_channel.h"
+#include "asylo/util/status.h"
+#include "asylo/util/statusor.h"
+
+namespace asylo {
+
+// An EKEP-authenticated, AEAD-protected message channel between two enclaves
+// on the same host, carried over a pair of shared-memory rings instead of a
+// gRPC connection. A channel established this way delivers messages without a
+// network round trip or a protobuf-over-HTTP/2 encode, so cooperating local
+// enclaves pay microseconds per hop rather than milliseconds.
+//
+// Each endpoint constructs an EkepHandshaker (client or server), allocates or
+// maps the two SharedMemoryChannel objects in memory visible to both
+// enclaves, and calls Establish(). The handshake frames are exchanged in
+// plaintext over the rings - EKEP authenticates both parties and produces the
+// channel secrets - after which all traffic is sealed with AES-128-GCM under
+// per-direction keys derived from the record protocol key. The two endpoints
+// must pass the same pair of rings with |send_channel| and |receive_channel|
+// swapped.
+//
+// Each endpoint supports one concurrent Send() and one concurrent Receive();
+// neither call may race with itself from two threads.
+class EkepSharedMemoryChannel {
+ public:
+  // Runs |handshaker| to completion over the ring pair and returns the
+  // established channel. |is_client| selects which endpoint opens the
+  // handshake and which direction key protects outbound traffic. The rings
+  // must outlive the returned channel. Returns a non-OK Status if the
+  // handshake is aborted or a ring is closed mid-handshake.
+  static StatusOr<std::unique_ptr<EkepSharedMemoryChannel>> Establish(
+      std::unique_ptr<EkepHandshaker> handshaker, bool is_client,
+      SharedMemoryChannel *send_channel, SharedMemoryChannel *receive_channel);
+
+  // Seals |plaintext| under the outbound direction key and writes the sealed
+  // frame to the outbound ring, blocking while the ring is full. The frame's
+  // position in the send sequence is authenticated, so a peer cannot reorder
+  // or replay frames undetected.
+  Status Send(ByteContainerView plaintext);
+
+  // Reads the next sealed frame from the inbound ring, blocking while the
+  // ring is empty, and opens it into |plaintext|. Returns a non-OK Status if
+  // the channel was closed or the frame fails authentication.
+  Status Receive(std::vector<uint8_t> *plaintext);
+
+  // The peer's identities, as asserted during the EKEP handshake.
+  const EnclaveIdentities &peer_identities() const { return peer_identities_; }
+
+  // Closes both rings and wakes any blocked endpoint on either side.
+  void Close();
+
+ private:
+  EkepSharedMemoryChannel(std::unique_ptr<AeadCryptor> seal_cryptor,
+                          std::unique_ptr<AeadCryptor> open_cryptor,
+                          EnclaveIdentities peer_identities,
+                          SharedMemoryChannel *send_channel,
+                          SharedMemoryChannel *receive_channel);
+
+  std::unique_ptr<AeadCryptor> seal_cryptor_;
+  std::unique_ptr<AeadCryptor> open_cryptor_;
+  EnclaveIdentities peer_identities_;
+  SharedMemoryChannel *send_channel_;
+  SharedMemoryChannel *receive_channel_;
+
+  // Per-direction frame counters, bound into each frame as associated data.
+  uint64_t send_sequence_ = 0;
+  uint64_t receive_sequence_ = 0;
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_GRPC_AUTH_CORE_EKEP_SHARED_MEMORY_CHANNEL_H_
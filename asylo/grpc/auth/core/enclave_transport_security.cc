@@ -29,6 +29,7 @@
 #include "absl/types/optional.h"
 #include "absl/types/span.h"
 #include "asylo/grpc/auth/core/client_ekep_handshaker.h"
+#include "asylo/grpc/auth/core/ekep_handshake_executor.h"
 #include "asylo/grpc/auth/core/ekep_handshaker.h"
 #include "asylo/grpc/auth/core/ekep_handshaker_util.h"
 #include "asylo/grpc/auth/core/handshake.pb.h"
@@ -257,24 +258,16 @@ void enclave_handshaker_destroy(tsi_handshaker *self) {
   delete (impl);
 }
 
-tsi_result enclave_handshaker_next(
-    tsi_handshaker *self, const unsigned char *received_bytes,
-    size_t received_bytes_size, const unsigned char **bytes_to_send,
-    size_t *bytes_to_send_size, tsi_handshaker_result **handshaker_result,
-    tsi_handshaker_on_next_done_cb cb, void *user_data) {
-  if ((received_bytes_size > 0 && !received_bytes) || !bytes_to_send ||
-      !bytes_to_send_size || !handshaker_result) {
-    return TSI_INVALID_ARGUMENT;
-  }
-  gpr_log(GPR_INFO,
-          "enclave_handshaker_next(self=%p, received_bytes=%p, "
-          "received_bytes_size=%zu, bytes_to_send=%p, bytes_to_send_size=%p "
-          "handshaker_result=%p, cb=%p, user_data=%p)",
-          self, received_bytes, received_bytes_size, bytes_to_send,
-          bytes_to_send_size, handshaker_result, cb, user_data);
-
-  tsi_enclave_handshaker *tsi_handshaker =
-      reinterpret_cast<tsi_enclave_handshaker *>(self);
+// Runs the next step of the handshake driven by |tsi_handshaker| and, on
+// completion of the handshake, extracts the handshaker result. This contains
+// the cryptographic work of enclave_handshaker_next() and may run on a
+// handshake executor thread rather than the calling thread.
+tsi_result enclave_handshaker_do_next(tsi_enclave_handshaker *tsi_handshaker,
+                                      const unsigned char *received_bytes,
+                                      size_t received_bytes_size,
+                                      const unsigned char **bytes_to_send,
+                                      size_t *bytes_to_send_size,
+                                      tsi_handshaker_result **handshaker_result) {
   EkepHandshaker *handshaker = tsi_handshaker->handshaker.get();
 
   // Run the next step of the handshake.
@@ -348,7 +341,7 @@ tsi_result enclave_handshaker_next(
               unused_bytes_result.ValueOrDie()),
           handshaker_result);
       if (result == TSI_OK) {
-        self->handshaker_result_created = true;
+        tsi_handshaker->base.handshaker_result_created = true;
       }
       return result;
     }
@@ -358,6 +351,61 @@ tsi_result enclave_handshaker_next(
   }
 }
 
+tsi_result enclave_handshaker_next(
+    tsi_handshaker *self, const unsigned char *received_bytes,
+    size_t received_bytes_size, const unsigned char **bytes_to_send,
+    size_t *bytes_to_send_size, tsi_handshaker_result **handshaker_result,
+    tsi_handshaker_on_next_done_cb cb, void *user_data) {
+  if ((received_bytes_size > 0 && !received_bytes) || !bytes_to_send ||
+      !bytes_to_send_size || !handshaker_result) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  gpr_log(GPR_INFO,
+          "enclave_handshaker_next(self=%p, received_bytes=%p, "
+          "received_bytes_size=%zu, bytes_to_send=%p, bytes_to_send_size=%p "
+          "handshaker_result=%p, cb=%p, user_data=%p)",
+          self, received_bytes, received_bytes_size, bytes_to_send,
+          bytes_to_send_size, handshaker_result, cb, user_data);
+
+  tsi_enclave_handshaker *tsi_handshaker =
+      reinterpret_cast<tsi_enclave_handshaker *>(self);
+
+  // If the caller supports asynchronous handshakes, offload the handshake
+  // cryptography to the handshake executor so that it does not run on the
+  // threads that process established streams. If the executor's queue is full,
+  // fall back to running the handshake step inline: during a reconnect storm
+  // this degrades to the synchronous behavior rather than failing handshakes.
+  if (cb != nullptr) {
+    // Copy the received bytes, which are only guaranteed to be valid for the
+    // duration of this call. The caller guarantees that the handshaker is not
+    // destroyed while a next operation is pending.
+    std::string received(reinterpret_cast<const char *>(received_bytes),
+                         received_bytes_size);
+    Status status = EkepHandshakeExecutor::Default()->Schedule(
+        [tsi_handshaker, received, cb, user_data] {
+          const unsigned char *bytes_to_send = nullptr;
+          size_t bytes_to_send_size = 0;
+          tsi_handshaker_result *handshaker_result = nullptr;
+          tsi_result result = enclave_handshaker_do_next(
+              tsi_handshaker,
+              reinterpret_cast<const unsigned char *>(received.data()),
+              received.size(), &bytes_to_send, &bytes_to_send_size,
+              &handshaker_result);
+          cb(result, user_data, bytes_to_send, bytes_to_send_size,
+             handshaker_result);
+        });
+    if (status.ok()) {
+      return TSI_ASYNC;
+    }
+    gpr_log(GPR_INFO, "Handshake executor is saturated, running inline: %s",
+            status.ToString().c_str());
+  }
+
+  return enclave_handshaker_do_next(tsi_handshaker, received_bytes,
+                                    received_bytes_size, bytes_to_send,
+                                    bytes_to_send_size, handshaker_result);
+}
+
 const tsi_handshaker_vtable handshaker_vtable = {
     nullptr /* get_bytes_to_send_to_peer -- deprecated */,
     nullptr /* process_bytes_from_peer   -- deprecated */,
@@ -21,6 +21,8 @@
 #include <openssl/curve25519.h>
 #include <openssl/rand.h>
 
+#include <utility>
+
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include "absl/memory/memory.h"
 #include "asylo/crypto/sha256_hash.h"
@@ -63,8 +65,10 @@ ServerEkepHandshaker::ServerEkepHandshaker(const EkepHandshakerOptions &options)
       available_record_protocols_({ALTSRP_AES128_GCM}),
       available_ekep_versions_({"EKEP v1"}),
       additional_authenticated_data_(options.additional_authenticated_data),
+      ticket_sealer_(options.resumption_ticket_sealer),
       selected_cipher_suite_(UNKNOWN_HANDSHAKE_CIPHER),
       selected_record_protocol_(UNKNOWN_RECORD_PROTOCOL),
+      is_resumed_handshake_(false),
       expected_message_type_(CLIENT_PRECOMMIT),
       // The handshake is in progress for the server because it relies on the
       // client to act first.
@@ -230,6 +234,41 @@ Status ServerEkepHandshaker::HandleClientPrecommit(
                   "Received a challenge with incorrect size");
   }
 
+  // If the client offered to resume a previous session and the ticket is
+  // valid for the negotiated handshake parameters, skip the identity exchange
+  // and complete an abbreviated handshake. Unusable tickets silently fall back
+  // to a full handshake.
+  if (ticket_sealer_ != nullptr && client_precommit.has_resumption_ticket()) {
+    EkepResumptionTicketPayload payload;
+    Status status =
+        ticket_sealer_->Open(client_precommit.resumption_ticket(), &payload);
+    if (status.ok() && payload.ekep_version().name() == selected_ekep_version_ &&
+        payload.cipher_suite() == selected_cipher_suite_ &&
+        payload.record_protocol() == selected_record_protocol_) {
+      is_resumed_handshake_ = true;
+
+      // The peer's identities were verified during the original handshake.
+      for (const EnclaveIdentity &identity : payload.peer_identities()) {
+        AddPeerIdentity(identity);
+      }
+      resumption_master_secret_.assign(
+          payload.resumption_master_secret().cbegin(),
+          payload.resumption_master_secret().cend());
+
+      // The server skips the ServerId message and the client skips the
+      // ClientId message, so the next message from the client is ClientFinish.
+      expected_message_type_ = CLIENT_FINISH;
+      return WriteServerPrecommit(output);
+    }
+    if (!status.ok()) {
+      LOG(INFO) << "Could not redeem resumption ticket, falling back to a "
+                << "full handshake: " << status;
+    } else {
+      LOG(INFO) << "Resumption ticket does not match the negotiated handshake "
+                << "parameters, falling back to a full handshake";
+    }
+  }
+
   for (const AssertionOffer &offer : client_precommit.client_offers()) {
     const AssertionDescription &offer_desc = offer.description();
     // Request any assertion that the peer offered and that this handshaker is
@@ -374,26 +413,46 @@ Status ServerEkepHandshaker::WriteServerPrecommit(std::string *output) {
   }
   server_precommit.set_challenge(challenge.data(), challenge.size());
 
-  for (const AssertionRequest &request : promised_assertions_) {
-    const AssertionDescription &description = request.description();
-    // Note that assertion generators were verified during creation of the
-    // handshaker so there is no need to check whether the call to
-    // GetEnclaveAssertionGenerator() returns nullptr.
-    GetEnclaveAssertionGenerator(description)
-        ->CreateAssertionOffer(server_precommit.add_server_offers());
-  }
+  if (is_resumed_handshake_) {
+    // In a resumed handshake there is no identity exchange, so no assertions
+    // are offered or requested.
+    server_precommit.set_resumption_accepted(true);
+  } else {
+    for (const AssertionRequest &request : promised_assertions_) {
+      const AssertionDescription &description = request.description();
+      // Note that assertion generators were verified during creation of the
+      // handshaker so there is no need to check whether the call to
+      // GetEnclaveAssertionGenerator() returns nullptr.
+      GetEnclaveAssertionGenerator(description)
+          ->CreateAssertionOffer(server_precommit.add_server_offers());
+    }
 
-  for (const AssertionDescription &description : expected_peer_assertions_) {
-    // Note that assertion verifiers were verified during creation of the
-    // handshaker so there is no need to check whether the call to
-    // GetEnclaveAssertionVerifier() returns nullptr.
-    GetEnclaveAssertionVerifier(description)
-        ->CreateAssertionRequest(server_precommit.add_server_requests());
+    for (const AssertionDescription &description : expected_peer_assertions_) {
+      // Note that assertion verifiers were verified during creation of the
+      // handshaker so there is no need to check whether the call to
+      // GetEnclaveAssertionVerifier() returns nullptr.
+      GetEnclaveAssertionVerifier(description)
+          ->CreateAssertionRequest(server_precommit.add_server_requests());
+    }
   }
 
   ASYLO_RETURN_IF_ERROR(WriteFrameAndUpdateTranscript(
       SERVER_PRECOMMIT, server_precommit, output));
 
+  if (is_resumed_handshake_) {
+    // In a resumed handshake, the EKEP secrets are derived from the resumption
+    // master secret and the transcript:
+    //   hash(ClientPrecommit || ServerPrecommit)
+    //
+    // The ServerFinish is sent immediately after the ServerPrecommit.
+    std::string transcript_hash;
+    ASYLO_RETURN_IF_ERROR(GetTranscriptHash(&transcript_hash));
+    ASYLO_RETURN_IF_ERROR(DeriveResumptionSecrets(
+        selected_cipher_suite_, transcript_hash, resumption_master_secret_,
+        &primary_secret_, &authenticator_secret_));
+    return WriteServerFinish(output);
+  }
+
   // At this stage in the protocol, the transcript is:
   //   hash(ClientPrecommit || ServerPrecommit)
   //
@@ -458,17 +517,20 @@ Status ServerEkepHandshaker::WriteServerId(std::string *output) {
 }
 
 Status ServerEkepHandshaker::WriteServerFinish(std::string *output) {
-  // At this stage in the protocol, the transcript is:
-  //   hash(ClientPrecommit || ServerPrecommit || ClientId || ServerId)
-  //
-  // This transcript is used by both the client and server to derive the EKEP
-  // secrets.
-  std::string transcript_hash;
-  ASYLO_RETURN_IF_ERROR(GetTranscriptHash(&transcript_hash));
+  if (!is_resumed_handshake_) {
+    // At this stage in the protocol, the transcript is:
+    //   hash(ClientPrecommit || ServerPrecommit || ClientId || ServerId)
+    //
+    // This transcript is used by both the client and server to derive the EKEP
+    // secrets. In a resumed handshake, the secrets were already derived from
+    // the resumption master secret.
+    std::string transcript_hash;
+    ASYLO_RETURN_IF_ERROR(GetTranscriptHash(&transcript_hash));
 
-  ASYLO_RETURN_IF_ERROR(
-      DeriveSecrets(selected_cipher_suite_, transcript_hash, client_public_key_,
-                    dh_private_key_, &primary_secret_, &authenticator_secret_));
+    ASYLO_RETURN_IF_ERROR(DeriveSecrets(
+        selected_cipher_suite_, transcript_hash, client_public_key_,
+        dh_private_key_, &primary_secret_, &authenticator_secret_));
+  }
 
   CleansingVector<uint8_t> authenticator;
   ASYLO_RETURN_IF_ERROR(ComputeServerHandshakeAuthenticator(
@@ -478,9 +540,41 @@ Status ServerEkepHandshaker::WriteServerFinish(std::string *output) {
   server_finish.set_handshake_authenticator(authenticator.data(),
                                             authenticator.size());
 
+  // Issue a fresh resumption ticket on every handshake, if the server supports
+  // session resumption. Ticket issuance is best-effort: a failure to issue a
+  // ticket does not abort the handshake.
+  if (ticket_sealer_ != nullptr) {
+    std::string ticket;
+    Status status = MakeResumptionTicket(&ticket);
+    if (status.ok()) {
+      server_finish.set_resumption_ticket(ticket);
+    } else {
+      LOG(WARNING) << "Failed to issue resumption ticket: " << status;
+    }
+  }
+
   return WriteFrameAndUpdateTranscript(SERVER_FINISH, server_finish, output);
 }
 
+Status ServerEkepHandshaker::MakeResumptionTicket(std::string *ticket) {
+  EkepResumptionTicketPayload payload;
+  payload.mutable_ekep_version()->set_name(selected_ekep_version_);
+  payload.set_cipher_suite(selected_cipher_suite_);
+  payload.set_record_protocol(selected_record_protocol_);
+
+  CleansingVector<uint8_t> resumption_master_secret;
+  ASYLO_RETURN_IF_ERROR(DeriveResumptionMasterSecret(
+      selected_cipher_suite_, primary_secret_, &resumption_master_secret));
+  payload.set_resumption_master_secret(resumption_master_secret.data(),
+                                       resumption_master_secret.size());
+
+  for (const EnclaveIdentity &identity : PeerIdentities().identities()) {
+    *payload.add_peer_identities() = identity;
+  }
+
+  return ticket_sealer_->Seal(std::move(payload), ticket);
+}
+
 bool ServerEkepHandshaker::SetSelectedEkepVersion(
     const google::protobuf::RepeatedPtrField<EkepVersion> &ekep_versions) {
   // Choose the first compatible EKEP version available.
@@ -100,6 +100,11 @@ class ServerEkepHandshaker final : public EkepHandshaker {
   // transcript.
   Status WriteServerFinish(std::string *output);
 
+  // Creates a sealed resumption ticket for the current session and writes it
+  // to |ticket|. The ticket allows the client to resume the session with an
+  // abbreviated handshake.
+  Status MakeResumptionTicket(std::string *ticket);
+
   // Sets the handshaker's selected EKEP version to first compatible EKEP
   // version in |ekep_versions|. Returns false if there is no compatible EKEP
   // version in |ekep_versions|.
@@ -136,6 +141,10 @@ class ServerEkepHandshaker final : public EkepHandshaker {
   // Additional data that is authenticated during the handshake.
   const std::string additional_authenticated_data_;
 
+  // Sealer used to issue and redeem resumption tickets, or nullptr if the
+  // server does not support session resumption.
+  const std::shared_ptr<EkepResumptionTicketSealer> ticket_sealer_;
+
   // Assertions requested by the client that the server is willing to offer.
   // This field is populated after validation of the ClientPrecommit message.
   std::vector<AssertionRequest> promised_assertions_;
@@ -169,6 +178,15 @@ class ServerEkepHandshaker final : public EkepHandshaker {
   CleansingVector<uint8_t> primary_secret_;
   CleansingVector<uint8_t> authenticator_secret_;
 
+  // True if the server accepted the client's offer to resume a previous
+  // session. This field is populated after validation of the ClientPrecommit
+  // message.
+  bool is_resumed_handshake_;
+
+  // The resumption master secret from the session being resumed. This field is
+  // only populated if |is_resumed_handshake_| is true.
+  CleansingVector<uint8_t> resumption_master_secret_;
+
   // A snapshot of the transcript to which the client's assertions are bound:
   //   hash(ClientPrecommit || ServerPrecommit)
   std::string client_assertion_transcript_;
@@ -24,7 +24,6 @@
 
 #include <google/protobuf/io/zero_copy_stream.h>
 #include "asylo/crypto/hash_interface.h"
-#include "asylo/crypto/util/byte_container_util.h"
 #include "asylo/util/status.h"
 
 namespace asylo {
@@ -52,13 +51,13 @@ bool Transcript::Hash(std::string *digest) {
   if (!hasher_) {
     return false;
   }
-  std::vector<uint8_t> tmp_digest;
-  Status status = hasher_->CumulativeHash(&tmp_digest);
+  Status status = hasher_->CumulativeHash(&digest_buffer_);
   if (!status.ok()) {
     LOG(ERROR) << "Error while generating transcript hash: " << status;
     return false;
   }
-  *digest = CopyToByteContainer<std::string>(tmp_digest);
+  digest->assign(reinterpret_cast<const char *>(digest_buffer_.data()),
+                 digest_buffer_.size());
   return true;
 }
 
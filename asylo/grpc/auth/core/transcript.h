@@ -19,9 +19,11 @@
 #ifndef ASYLO_GRPC_AUTH_CORE_TRANSCRIPT_H_
 #define ASYLO_GRPC_AUTH_CORE_TRANSCRIPT_H_
 
+#include <cstdint>
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <google/protobuf/io/zero_copy_stream.h>
 #include "asylo/crypto/hash_interface.h"
@@ -71,6 +73,11 @@ class Transcript {
   // this buffer are added to the hashing object and the buffer is cleared.
   std::string bytes_to_hash_;
 
+  // A scratch buffer for the transcript digest. The buffer is reused across
+  // calls to Hash so that hashing the transcript after each handshake message
+  // does not allocate.
+  std::vector<uint8_t> digest_buffer_;
+
   // The hash function used to hash the transcript.
   std::unique_ptr<HashInterface> hasher_;
 };
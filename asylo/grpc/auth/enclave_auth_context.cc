@@ -18,9 +18,14 @@
 
 #include "asylo/grpc/auth/enclave_auth_context.h"
 
+#include <memory>
+#include <utility>
+
 #include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "asylo/grpc/auth/core/enclave_grpc_security_constants.h"
 #include "asylo/identity/identity_acl_evaluator.h"
 #include "asylo/util/status.h"
@@ -28,6 +33,21 @@
 #include "src/core/tsi/transport_security_interface.h"
 
 namespace asylo {
+namespace {
+
+// Serializes |acl| deterministically and writes the result to |serialized|.
+// Returns false if serialization fails, in which case the evaluation of |acl|
+// is not memoized.
+bool SerializeAclForCacheKey(const IdentityAclPredicate &acl,
+                             std::string *serialized) {
+  serialized->clear();
+  google::protobuf::io::StringOutputStream string_stream(serialized);
+  google::protobuf::io::CodedOutputStream coded_stream(&string_stream);
+  coded_stream.SetSerializationDeterministic(true);
+  return acl.SerializeToCodedStream(&coded_stream);
+}
+
+}  // namespace
 
 StatusOr<EnclaveAuthContext> EnclaveAuthContext::CreateFromServerContext(
     const ::grpc::ServerContext &server_context) {
@@ -96,7 +116,8 @@ EnclaveAuthContext::EnclaveAuthContext(EnclaveIdentities identities,
                                        RecordProtocol record_protocol)
     : identities_(
           {identities.identities().begin(), identities.identities().end()}),
-      record_protocol_(record_protocol) {}
+      record_protocol_(record_protocol),
+      acl_result_cache_(std::make_shared<AclResultCache>()) {}
 
 RecordProtocol EnclaveAuthContext::GetRecordProtocol() const {
   return record_protocol_;
@@ -130,8 +151,37 @@ StatusOr<bool> EnclaveAuthContext::EvaluateAcl(
 
 StatusOr<bool> EnclaveAuthContext::EvaluateAcl(const IdentityAclPredicate &acl,
                                                std::string *explanation) const {
-  return EvaluateIdentityAcl(identities_, acl, matcher_,
-                             /*explanation=*/explanation);
+  // The peer's identities are fixed for the lifetime of the channel, so the
+  // result of a previous evaluation of |acl| can be returned directly.
+  std::string cache_key;
+  bool cacheable = acl_result_cache_ != nullptr &&
+                   SerializeAclForCacheKey(acl, &cache_key);
+  if (cacheable) {
+    absl::MutexLock lock(&acl_result_cache_->mu);
+    auto it = acl_result_cache_->results.find(cache_key);
+    if (it != acl_result_cache_->results.end()) {
+      if (explanation != nullptr) {
+        *explanation = it->second.second;
+      }
+      return it->second.first;
+    }
+  }
+
+  // Evaluate with a local explanation so that a mismatch explanation can be
+  // memoized alongside the result.
+  std::string local_explanation;
+  StatusOr<bool> result =
+      EvaluateIdentityAcl(identities_, acl, matcher_, &local_explanation);
+  if (result.ok() && cacheable) {
+    absl::MutexLock lock(&acl_result_cache_->mu);
+    acl_result_cache_->results.emplace(
+        std::move(cache_key),
+        std::make_pair(result.ValueOrDie(), local_explanation));
+  }
+  if (explanation != nullptr) {
+    *explanation = std::move(local_explanation);
+  }
+  return result;
 }
 
 StatusOr<bool> EnclaveAuthContext::EvaluateAcl(
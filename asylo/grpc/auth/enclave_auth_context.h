@@ -19,9 +19,14 @@
 #ifndef ASYLO_GRPC_AUTH_ENCLAVE_AUTH_CONTEXT_H_
 #define ASYLO_GRPC_AUTH_ENCLAVE_AUTH_CONTEXT_H_
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "asylo/grpc/auth/core/handshake.pb.h"
 #include "asylo/identity/delegating_identity_expectation_matcher.h"
 #include "asylo/identity/identity.pb.h"
@@ -122,6 +127,21 @@ class EnclaveAuthContext {
       std::string *explanation) const;
 
  private:
+  // Memoized ACL evaluation results, keyed by a deterministic serialization of
+  // the ACL. The peer's identities are fixed for the lifetime of the channel,
+  // so the result of evaluating a given ACL never changes and repeated per-RPC
+  // authorization checks reduce to a single hash lookup. The cache is shared
+  // by copies of this context, which all describe the same channel, and is
+  // bounded in practice by the number of distinct ACLs used by call sites.
+  struct AclResultCache {
+    absl::Mutex mu;
+
+    // Maps serialized ACLs to the evaluation result and, for non-matching
+    // ACLs, the explanation of the mismatch.
+    absl::flat_hash_map<std::string, std::pair<bool, std::string>> results
+        ABSL_GUARDED_BY(mu);
+  };
+
   // Creates an EnclaveAuthContext for the given peer's |identities| and the
   // session |record_protocol|.
   EnclaveAuthContext(EnclaveIdentities identities,
@@ -135,6 +155,10 @@ class EnclaveAuthContext {
 
   // Matcher used to evaluate ACLs against the authenticated peer's identities.
   DelegatingIdentityExpectationMatcher matcher_;
+
+  // Cache of ACL evaluation results for this channel, or nullptr for
+  // default-constructed contexts, which do not memoize.
+  std::shared_ptr<AclResultCache> acl_result_cache_;
 };
 
 }  // namespace asylo
@@ -330,6 +330,39 @@ TEST_F(EnclaveAuthContextTest, EvaluateAclFailure) {
   }
 }
 
+// Verify that repeated evaluations of the same ACL, which are served from the
+// per-channel result cache after the first evaluation, return the same result
+// and explanation as the first evaluation.
+TEST_F(EnclaveAuthContextTest, EvaluateAclRepeatedEvaluationsAreConsistent) {
+  EnclaveAuthContext auth_context;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      auth_context,
+      EnclaveAuthContext::CreateFromAuthContext(*secure_auth_context_));
+
+  // The ACL does not match the peer's identities.
+  IdentityAclPredicate acl;
+  EnclaveIdentityExpectation *expectation = acl.mutable_expectation();
+  *expectation->mutable_reference_identity()->mutable_description() =
+      good_identity_description_;
+  expectation->set_match_spec(kMatchSpec2);
+
+  for (int i = 0; i < 3; ++i) {
+    std::string explanation;
+    ASSERT_THAT(auth_context.EvaluateAcl(acl, &explanation),
+                IsOkAndHolds(false));
+    EXPECT_THAT(explanation, HasSubstr(kIdentityMismatchError));
+  }
+
+  // A matching ACL is unaffected by the cached result of the first ACL.
+  expectation->set_match_spec(kMatchSpec1);
+  for (int i = 0; i < 3; ++i) {
+    std::string explanation;
+    ASSERT_THAT(auth_context.EvaluateAcl(acl, &explanation),
+                IsOkAndHolds(true));
+    EXPECT_THAT(explanation, IsEmpty());
+  }
+}
+
 // Verify that EvaluateAcl() returns true when the ACL passes.
 TEST_F(EnclaveAuthContextTest, EvaluateAclSuccess) {
   EnclaveAuthContext auth_context;
@@ -18,9 +18,12 @@
 
 #include "asylo/grpc/util/grpc_server_launcher.h"
 
+#include <utility>
+
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include "asylo/util/logging.h"
+#include "asylo/util/thread.h"
 
 namespace asylo {
 
@@ -36,6 +39,26 @@ Status GrpcServerLauncher::RegisterService(
   return Status::OkStatus();
 }
 
+Status GrpcServerLauncher::RegisterServiceFactory(ServiceFactory factory) {
+  absl::MutexLock lock(&mu_);
+  if (state_ != State::NOT_LAUNCHED) {
+    return MakeStatus(absl::StatusCode::kFailedPrecondition,
+                      "Cannot add services after the server has started");
+  }
+  service_factories_.emplace_back(std::move(factory));
+  return Status::OkStatus();
+}
+
+Status GrpcServerLauncher::AddStateObserver(StateObserver observer) {
+  absl::MutexLock lock(&mu_);
+  if (state_ != State::NOT_LAUNCHED) {
+    return MakeStatus(absl::StatusCode::kFailedPrecondition,
+                      "Cannot add observers after the server has started");
+  }
+  observers_.emplace_back(std::move(observer));
+  return Status::OkStatus();
+}
+
 Status GrpcServerLauncher::AddListeningPort(
     const std::string &address,
     std::shared_ptr<::grpc::ServerCredentials> creds, int *selected_port) {
@@ -51,35 +74,98 @@ Status GrpcServerLauncher::AddListeningPort(
 }
 
 Status GrpcServerLauncher::Start() {
-  absl::MutexLock lock(&mu_);
-  if (state_ != State::NOT_LAUNCHED) {
-    return MakeStatus(absl::StatusCode::kFailedPrecondition,
-                      "Cannot start server more than once");
+  std::vector<ServiceFactory> factories;
+  std::vector<StateObserver> observers;
+  {
+    absl::MutexLock lock(&mu_);
+    if (state_ != State::NOT_LAUNCHED) {
+      return MakeStatus(absl::StatusCode::kFailedPrecondition,
+                        "Cannot start server more than once");
+    }
+    state_ = State::LAUNCHING;
+    factories = std::move(service_factories_);
+    service_factories_.clear();
+    observers = observers_;
+  }
+  NotifyObservers(observers, State::LAUNCHING);
+
+  // Run all registered service factories concurrently, without holding mu_,
+  // so that a server whose services are expensive to construct (e.g. each
+  // service loads its own enclave) boots in the time of its slowest service
+  // rather than the sum of all of them. The first factory runs on the calling
+  // thread.
+  std::vector<StatusOr<std::unique_ptr<::grpc::Service>>> results(
+      factories.size());
+  if (!factories.empty()) {
+    std::vector<Thread> threads;
+    threads.reserve(factories.size() - 1);
+    for (size_t i = 1; i < factories.size(); ++i) {
+      threads.emplace_back(
+          [&factories, &results, i] { results[i] = factories[i](); });
+    }
+    results[0] = factories[0]();
+    for (Thread &thread : threads) {
+      thread.Join();
+    }
   }
-  server_ = builder_.BuildAndStart();
-  if (!server_) {
-    state_ = State::TERMINATED;
-    return MakeStatus(absl::StatusCode::kInternal,
-                      "Failed to start the server ");
+
+  Status status = Status::OkStatus();
+  for (auto &result : results) {
+    if (!result.ok()) {
+      status = result.status();
+      break;
+    }
   }
-  state_ = State::LAUNCHED;
-  return Status::OkStatus();
+
+  {
+    absl::MutexLock lock(&mu_);
+    if (state_ != State::LAUNCHING) {
+      // Shutdown() raced with this call while the factories were running and
+      // has already moved the launcher to TERMINATED and notified observers.
+      return MakeStatus(absl::StatusCode::kFailedPrecondition,
+                        "Server was shut down while starting");
+    }
+    if (status.ok()) {
+      for (auto &result : results) {
+        std::unique_ptr<::grpc::Service> service =
+            std::move(result).ValueOrDie();
+        builder_.RegisterService(service.get());
+        services_.emplace_back(std::move(service));
+      }
+      server_ = builder_.BuildAndStart();
+      if (!server_) {
+        status = MakeStatus(absl::StatusCode::kInternal,
+                            "Failed to start the server ");
+      }
+    }
+    state_ = status.ok() ? State::LAUNCHED : State::TERMINATED;
+    observers = observers_;
+  }
+  NotifyObservers(observers,
+                  status.ok() ? State::LAUNCHED : State::TERMINATED);
+  return status;
 }
 
 Status GrpcServerLauncher::Shutdown() {
-  absl::MutexLock lock(&mu_);
-  if (state_ != State::LAUNCHED) {
-    // Prevent further attempts to launch the server once Shutdown() has been
-    // called.
-    state_ = State::TERMINATED;
-    return MakeStatus(absl::StatusCode::kFailedPrecondition,
-                      "Cannot shutdown, the server has not started");
+  Status status = Status::OkStatus();
+  std::vector<StateObserver> observers;
+  {
+    absl::MutexLock lock(&mu_);
+    if (state_ != State::LAUNCHED) {
+      // Prevent further attempts to launch the server once Shutdown() has been
+      // called. A Start() call that is still running its service factories
+      // observes the state change and aborts.
+      state_ = State::TERMINATED;
+      status = MakeStatus(absl::StatusCode::kFailedPrecondition,
+                          "Cannot shutdown, the server has not started");
+    } else {
+      server_->Shutdown();
+      state_ = State::TERMINATED;
+    }
+    observers = observers_;
   }
-
-  server_->Shutdown();
-  state_ = State::TERMINATED;
-
-  return Status::OkStatus();
+  NotifyObservers(observers, State::TERMINATED);
+  return status;
 }
 
 Status GrpcServerLauncher::Wait() const {
@@ -100,6 +186,14 @@ Status GrpcServerLauncher::Wait() const {
   return Status::OkStatus();
 }
 
+bool GrpcServerLauncher::WaitForState(State state,
+                                      absl::Duration timeout) const {
+  absl::MutexLock lock(&mu_);
+  auto reached_state = [this, state] { return state_ >= state; };
+  mu_.AwaitWithTimeout(absl::Condition(&reached_state), timeout);
+  return state_ == state;
+}
+
 GrpcServerLauncher::State GrpcServerLauncher::GetState() {
   absl::MutexLock lock(&mu_);
   // Reading the member variable state_ from inside a critical section ensures
@@ -107,4 +201,11 @@ GrpcServerLauncher::State GrpcServerLauncher::GetState() {
   return state_;
 }
 
+void GrpcServerLauncher::NotifyObservers(
+    const std::vector<StateObserver> &observers, State state) {
+  for (const StateObserver &observer : observers) {
+    observer(state);
+  }
+}
+
 }  // namespace asylo
@@ -19,13 +19,16 @@
 #ifndef ASYLO_GRPC_UTIL_GRPC_SERVER_LAUNCHER_H_
 #define ASYLO_GRPC_UTIL_GRPC_SERVER_LAUNCHER_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "asylo/util/status.h"
+#include "asylo/util/statusor.h"
 #include "include/grpcpp/impl/codegen/service_type.h"
 #include "include/grpcpp/security/server_credentials.h"
 #include "include/grpcpp/server.h"
@@ -83,7 +86,20 @@ namespace asylo {
 //  failure to launch the server.
 class GrpcServerLauncher {
  public:
-  enum class State { NOT_LAUNCHED, LAUNCHED, TERMINATED };
+  // States are ordered by progress through the launcher's lifecycle:
+  // LAUNCHING covers the window in which Start() is constructing registered
+  // services and building the server.
+  enum class State { NOT_LAUNCHED, LAUNCHING, LAUNCHED, TERMINATED };
+
+  // A factory producing one of the server's services. Factories registered
+  // via RegisterServiceFactory() are invoked concurrently during Start(), so
+  // they must not depend on one another.
+  using ServiceFactory =
+      std::function<StatusOr<std::unique_ptr<::grpc::Service>>()>;
+
+  // An observer of launcher state transitions registered via
+  // AddStateObserver().
+  using StateObserver = std::function<void(State)>;
 
   GrpcServerLauncher(std::string name)
       : name_{std::move(name)}, state_{State::NOT_LAUNCHED} {}
@@ -91,6 +107,23 @@ class GrpcServerLauncher {
   // Registers a gRPC service with the server. Takes ownership of |service|.
   Status RegisterService(std::unique_ptr<::grpc::Service> service);
 
+  // Registers a factory that produces one of the server's services. All
+  // registered factories are invoked concurrently when Start() is called, so
+  // a server hosting several services whose construction is expensive (e.g.
+  // each loads an enclave) boots in the time of its slowest service rather
+  // than the sum of all of them. If any factory fails, Start() fails with
+  // that factory's status.
+  Status RegisterServiceFactory(ServiceFactory factory);
+
+  // Registers an observer that is notified of every subsequent state
+  // transition, so callers can react to readiness instead of polling
+  // GetState(). Observers are invoked without the launcher's internal lock
+  // held, in the order they were added, from the thread driving the
+  // transition (e.g. the caller of Start() or Shutdown()); they may therefore
+  // call back into the launcher, but must not block. Observers cannot be
+  // added once the server has started.
+  Status AddStateObserver(StateObserver observer);
+
   // Adds a listening port and associated credentials to the server. If
   // |selected_port| is not nullptr, then populates this value with the port
   // used once the server is started (i.e. via a call to Start()). The value of
@@ -108,6 +141,14 @@ class GrpcServerLauncher {
   // Waits for server to shut down.
   Status Wait() const;
 
+  // Blocks until the launcher reaches |state| or a later state in the
+  // lifecycle order, or until |timeout| expires. Returns true if the
+  // launcher's state was exactly |state| when the wait completed, and false
+  // on timeout or if the launcher had already moved past |state| (e.g.
+  // waiting for LAUNCHED on a launcher that failed to start and went straight
+  // to TERMINATED).
+  bool WaitForState(State state, absl::Duration timeout) const;
+
   // Shuts down the server started by this object.
   Status Shutdown();
 
@@ -124,13 +165,21 @@ class GrpcServerLauncher {
     return Status(code, absl::StrCat("Server ", name_, ": ", message));
   }
 
+  // Invokes every observer in |observers| with |state|. Must be called
+  // without mu_ held.
+  static void NotifyObservers(const std::vector<StateObserver> &observers,
+                              State state);
+
   // Identifier for the server which is used for logging and debugging purposes.
   std::string name_;
 
-  // Mutex to protect server_, state_, services_, and builder_.
+  // Mutex to protect server_, state_, services_, service_factories_,
+  // observers_, and builder_.
   mutable absl::Mutex mu_;
   State state_;
   std::vector<std::unique_ptr<::grpc::Service>> services_;
+  std::vector<ServiceFactory> service_factories_;
+  std::vector<StateObserver> observers_;
   std::unique_ptr<::grpc::Server> server_;
   ::grpc::ServerBuilder builder_;
 };
@@ -221,6 +221,98 @@ TEST_F(GrpcServerLauncherTest, DoubleWait) {
   EXPECT_THAT(launcher_.Wait(), Not(IsOk()));
 }
 
+// Verifies that services produced by registered factories are hosted by the
+// server just like directly-registered services.
+TEST_F(GrpcServerLauncherTest, ServiceFactories) {
+  ASSERT_THAT(launcher_.RegisterServiceFactory(
+                  []() -> StatusOr<std::unique_ptr<::grpc::Service>> {
+                    return absl::make_unique<test::MessengerServer1>();
+                  }),
+              IsOk());
+  ASSERT_THAT(launcher_.RegisterServiceFactory(
+                  []() -> StatusOr<std::unique_ptr<::grpc::Service>> {
+                    return absl::make_unique<test::MessengerServer2>();
+                  }),
+              IsOk());
+
+  int port;
+  ASSERT_THAT(launcher_.AddListeningPort(
+                  server_address_, ::grpc::InsecureServerCredentials(), &port),
+              IsOk());
+  ASSERT_THAT(launcher_.Start(), IsOk());
+  server_address_ = absl::StrCat(kLocalhostAddress, ":", port);
+
+  ASSERT_TRUE(ConnectChannel());
+  EXPECT_THAT(CallServices(), IsOk());
+
+  AsyncDelayedShutdownInvoker shutdown_invoker(&launcher_);
+  EXPECT_THAT(launcher_.Wait(), IsOk());
+}
+
+// Verifies that a failing service factory fails the launch with the factory's
+// status and leaves the launcher terminated.
+TEST_F(GrpcServerLauncherTest, FailingServiceFactory) {
+  GrpcServerLauncher launcher("FailingServiceFactory");
+  const Status failure(absl::StatusCode::kInternal, "enclave failed to load");
+  ASSERT_THAT(launcher.RegisterServiceFactory(
+                  [failure]() -> StatusOr<std::unique_ptr<::grpc::Service>> {
+                    return failure;
+                  }),
+              IsOk());
+
+  EXPECT_THAT(launcher.Start(), StatusIs(absl::StatusCode::kInternal));
+  EXPECT_EQ(launcher.GetState(), GrpcServerLauncher::State::TERMINATED);
+}
+
+// Verifies that state observers see every transition of the launcher's
+// lifecycle, in order.
+TEST_F(GrpcServerLauncherTest, StateObservers) {
+  std::vector<GrpcServerLauncher::State> transitions;
+  ASSERT_THAT(launcher_.AddStateObserver(
+                  [&transitions](GrpcServerLauncher::State state) {
+                    transitions.push_back(state);
+                  }),
+              IsOk());
+
+  ASSERT_THAT(LaunchServer(), IsOk());
+  ASSERT_THAT(launcher_.Shutdown(), IsOk());
+
+  EXPECT_THAT(transitions,
+              ::testing::ElementsAre(GrpcServerLauncher::State::LAUNCHING,
+                                     GrpcServerLauncher::State::LAUNCHED,
+                                     GrpcServerLauncher::State::TERMINATED));
+
+  // Observers cannot be added once the server has started.
+  EXPECT_THAT(launcher_.AddStateObserver([](GrpcServerLauncher::State) {}),
+              Not(IsOk()));
+}
+
+// Verifies that WaitForState() unblocks when the requested state is reached
+// and distinguishes an exact match from a state that has already passed.
+TEST_F(GrpcServerLauncherTest, WaitForState) {
+  // NOT_LAUNCHED is already satisfied; LAUNCHED has not been reached yet.
+  EXPECT_TRUE(launcher_.WaitForState(GrpcServerLauncher::State::NOT_LAUNCHED,
+                                     absl::ZeroDuration()));
+  EXPECT_FALSE(launcher_.WaitForState(GrpcServerLauncher::State::LAUNCHED,
+                                      absl::Milliseconds(100)));
+
+  std::thread waiter([this] {
+    EXPECT_TRUE(launcher_.WaitForState(GrpcServerLauncher::State::LAUNCHED,
+                                       absl::Seconds(10)));
+  });
+  ASSERT_THAT(LaunchServer(), IsOk());
+  waiter.join();
+
+  ASSERT_THAT(launcher_.Shutdown(), IsOk());
+
+  // The launcher has moved past LAUNCHED, so waiting for it reports false
+  // immediately rather than blocking for the full timeout.
+  EXPECT_FALSE(launcher_.WaitForState(GrpcServerLauncher::State::LAUNCHED,
+                                      absl::Seconds(10)));
+  EXPECT_TRUE(launcher_.WaitForState(GrpcServerLauncher::State::TERMINATED,
+                                     absl::ZeroDuration()));
+}
+
 // Ensures that an attempt to launch a server after shutdown fails.
 TEST_F(GrpcServerLauncherTest, LaunchAfterShutdown) {
   ASSERT_THAT(LaunchServer(), IsOk());
@@ -19,10 +19,13 @@
 #include "asylo/identity/additional_authenticated_data_generator.h"
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "asylo/crypto/sha256_hash.h"
 #include "asylo/crypto/util/byte_container_util.h"
 #include "asylo/crypto/util/bytes.h"
@@ -55,12 +58,30 @@ constexpr uint8_t kEkepPurpose[kAdditionalAuthenticatedDataPurposeSize] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
+// Offsets of the purpose and UUID suffixes within the AAD layout.
+constexpr size_t kAadPurposeOffset = kAdditionalAuthenticatedDataSize -
+                                     kAdditionalAuthenticatedDataPurposeSize -
+                                     kAdditionalAuthenticatedDataUuidSize;
+constexpr size_t kAadUuidOffset =
+    kAdditionalAuthenticatedDataSize - kAdditionalAuthenticatedDataUuidSize;
+
+// Maximum number of memoized AAD values per generator. The cache exists for
+// hot, repeated inputs such as the EKEP context, so a handful of entries is
+// enough.
+constexpr size_t kAadCacheMaxEntries = 16;
+
 }  // namespace
 
 AdditionalAuthenticatedDataGenerator::AdditionalAuthenticatedDataGenerator(
     UnsafeBytes<kAdditionalAuthenticatedDataUuidSize> uuid,
     UnsafeBytes<kAdditionalAuthenticatedDataPurposeSize> purpose)
-    : uuid_(uuid), purpose_(purpose) {}
+    : uuid_(uuid), purpose_(purpose) {
+  // Precompute the constant suffix once so that Generate() only has to fill
+  // in the hash portion.
+  aad_template_.fill(0);
+  aad_template_.replace(kAadPurposeOffset, purpose_);
+  aad_template_.replace(kAadUuidOffset, uuid_);
+}
 
 std::unique_ptr<AdditionalAuthenticatedDataGenerator>
 AdditionalAuthenticatedDataGenerator::CreateGetPceInfoAadGenerator() {
@@ -82,23 +103,35 @@ AdditionalAuthenticatedDataGenerator::CreateEkepAadGenerator() {
 
 StatusOr<UnsafeBytes<kAdditionalAuthenticatedDataSize>>
 AdditionalAuthenticatedDataGenerator::Generate(ByteContainerView data) const {
+  absl::string_view key(reinterpret_cast<const char *>(data.data()),
+                        data.size());
+  {
+    absl::MutexLock lock(&aad_cache_mu_);
+    auto it = aad_cache_.find(key);
+    if (it != aad_cache_.end()) {
+      return it->second;
+    }
+  }
+
   Sha256Hash hasher;
   hasher.Init();
   hasher.Update(data);
   std::vector<uint8_t> hash;
   ASYLO_RETURN_IF_ERROR(hasher.CumulativeHash(&hash));
-  UnsafeBytes<kAdditionalAuthenticatedDataSize> aad;
+
+  // Start from the template, which already carries the purpose and UUID
+  // suffixes.
+  UnsafeBytes<kAdditionalAuthenticatedDataSize> aad = aad_template_;
   if (aad.replace(0, hash) != hasher.DigestSize()) {
     return absl::InternalError("Setting hash data failed");
   }
-  if (aad.replace(hasher.DigestSize(), purpose_) !=
-      kAdditionalAuthenticatedDataPurposeSize) {
-    return absl::InternalError("Setting purpose data failed");
-  }
-  if (aad.replace(hasher.DigestSize() + kAdditionalAuthenticatedDataPurposeSize,
-                  uuid_) != kAdditionalAuthenticatedDataUuidSize) {
-    return absl::InternalError("Setting UUID data failed");
+
+  absl::MutexLock lock(&aad_cache_mu_);
+  if (aad_cache_.size() >= kAadCacheMaxEntries) {
+    // Wholesale eviction is fine for a memo this small.
+    aad_cache_.clear();
   }
+  aad_cache_.emplace(std::string(key), aad);
   return aad;
 }
 
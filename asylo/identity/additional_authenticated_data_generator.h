@@ -20,7 +20,10 @@
 #define ASYLO_IDENTITY_ADDITIONAL_AUTHENTICATED_DATA_GENERATOR_H_
 
 #include <memory>
+#include <string>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "asylo/crypto/util/byte_container_view.h"
 #include "asylo/crypto/util/bytes.h"
 #include "asylo/util/statusor.h"
@@ -59,6 +62,10 @@ class AdditionalAuthenticatedDataGenerator {
 
   // Generates a formatted additional authenticated data value using |data|.
   // Returns a non-OK Status if AAD generation fails.
+  //
+  // Recently generated values are memoized, so regenerating the AAD for an
+  // input seen before costs a hash lookup and a copy rather than a SHA256
+  // computation.
   StatusOr<UnsafeBytes<kAdditionalAuthenticatedDataSize>> Generate(
       ByteContainerView data) const;
 
@@ -68,6 +75,19 @@ class AdditionalAuthenticatedDataGenerator {
 
   // Defines the purpose of the AAD generated by this object.
   const UnsafeBytes<kAdditionalAuthenticatedDataPurposeSize> purpose_;
+
+  // AAD value with the purpose and UUID suffixes already in place. Generate()
+  // copies this template and fills in only the hash portion.
+  UnsafeBytes<kAdditionalAuthenticatedDataSize> aad_template_;
+
+  // Guards aad_cache_.
+  mutable absl::Mutex aad_cache_mu_;
+
+  // Memoizes generated AAD values by input data. Bounded to a handful of
+  // entries; AAD values are not secret, so caching them is safe.
+  mutable absl::flat_hash_map<std::string,
+                              UnsafeBytes<kAdditionalAuthenticatedDataSize>>
+      aad_cache_ ABSL_GUARDED_BY(aad_cache_mu_);
 };
 
 }  // namespace asylo
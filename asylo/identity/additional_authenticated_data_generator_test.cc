@@ -102,5 +102,20 @@ TEST(AdditionalAuthenticatedDataGeneratorTest, EkepGeneratorSuccess) {
       absl::HexStringToBytes(kEkepPurposeHex));
 }
 
+// Verifies that repeated generation for the same input, which is served from
+// the generator's memo after the first call, produces the same value as the
+// first generation.
+TEST(AdditionalAuthenticatedDataGeneratorTest, RepeatedGenerationIsStable) {
+  std::unique_ptr<AdditionalAuthenticatedDataGenerator> generator =
+      AdditionalAuthenticatedDataGenerator::CreateEkepAadGenerator();
+  std::string data = absl::HexStringToBytes(kDataHex);
+
+  UnsafeBytes<kAdditionalAuthenticatedDataSize> first;
+  ASYLO_ASSERT_OK_AND_ASSIGN(first, generator->Generate(data));
+  UnsafeBytes<kAdditionalAuthenticatedDataSize> second;
+  ASYLO_ASSERT_OK_AND_ASSIGN(second, generator->Generate(data));
+  EXPECT_EQ(first, second);
+}
+
 }  // namespace
 }  // namespace asylo
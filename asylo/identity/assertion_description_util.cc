@@ -16,9 +16,9 @@
  *
  */
 
-#include <functional>
 #include <string>
 
+#include "absl/hash/hash.h"
 #include "asylo/crypto/util/byte_container_util.h"
 #include "asylo/crypto/util/byte_container_view.h"
 #include "asylo/identity/assertion_description_util.h"
@@ -30,8 +30,10 @@ namespace asylo {
 
 size_t AssertionDescriptionHasher::operator()(
     const AssertionDescription &description) const {
-  return std::hash<std::string>()(
-      SerializeAssertionDescription(description).ValueOrDie());
+  // Hash the two fields that AssertionDescriptionEq compares, without
+  // materializing a serialized form of the proto.
+  return absl::HashOf(description.identity_type(),
+                      description.authority_type());
 }
 
 bool AssertionDescriptionEq::operator()(const AssertionDescription &lhs,
@@ -24,6 +24,7 @@
 
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "asylo/crypto/algorithms.pb.h"
 #include "asylo/crypto/certificate_util.h"
 #include "asylo/crypto/x509_certificate.h"
@@ -216,7 +217,18 @@ Status DcapIntelArchitecturalEnclaveInterface::SetPckCertificateChain(
   config.cert_data_size = cert_data.size();
   config.p_cert_data =
       reinterpret_cast<uint8_t *>(const_cast<char *>(cert_data.data()));
-  return Quote3ErrorToStatus(dcap_library_->SetQuoteConfig(config));
+  quote3_error_t result = dcap_library_->SetQuoteConfig(config);
+
+  // The new certificate chain may reflect a TCB change, which can alter the
+  // QE's target info and quote size. Drop the cached values so that they are
+  // re-fetched on the next quote request.
+  {
+    absl::MutexLock lock(&qe_cache_mu_);
+    qe_targetinfo_cache_.reset();
+    qe_quote_size_cache_.reset();
+  }
+
+  return Quote3ErrorToStatus(result);
 }
 
 Status DcapIntelArchitecturalEnclaveInterface::SetEnclaveDir(
@@ -287,10 +299,19 @@ Status DcapIntelArchitecturalEnclaveInterface::PceSignReport(
 }
 
 StatusOr<Targetinfo> DcapIntelArchitecturalEnclaveInterface::GetQeTargetinfo() {
+  {
+    absl::MutexLock lock(&qe_cache_mu_);
+    if (qe_targetinfo_cache_.has_value()) {
+      return qe_targetinfo_cache_.value();
+    }
+  }
+
   Targetinfo target_info;
   quote3_error_t result = dcap_library_->QeGetTargetInfo(
       CheckedPointerCast<sgx_target_info_t *>(&target_info));
   if (result == SGX_QL_SUCCESS) {
+    absl::MutexLock lock(&qe_cache_mu_);
+    qe_targetinfo_cache_ = target_info;
     return target_info;
   }
   return Quote3ErrorToStatus(result);
@@ -298,17 +319,38 @@ StatusOr<Targetinfo> DcapIntelArchitecturalEnclaveInterface::GetQeTargetinfo() {
 
 StatusOr<std::vector<uint8_t>>
 DcapIntelArchitecturalEnclaveInterface::GetQeQuote(const Report &report) {
-  uint32_t quote_size;
-  quote3_error_t result = dcap_library_->QeGetQuoteSize(&quote_size);
-  if (result != SGX_QL_SUCCESS) {
-    return Quote3ErrorToStatus(result);
+  uint32_t quote_size = 0;
+  bool quote_size_cached = false;
+  {
+    absl::MutexLock lock(&qe_cache_mu_);
+    if (qe_quote_size_cache_.has_value()) {
+      quote_size = qe_quote_size_cache_.value();
+      quote_size_cached = true;
+    }
+  }
+
+  if (!quote_size_cached) {
+    quote3_error_t result = dcap_library_->QeGetQuoteSize(&quote_size);
+    if (result != SGX_QL_SUCCESS) {
+      return Quote3ErrorToStatus(result);
+    }
+    absl::MutexLock lock(&qe_cache_mu_);
+    qe_quote_size_cache_ = quote_size;
   }
 
+  // The quote call itself is made outside the cache lock so that concurrent
+  // quote requests overlap their QE enclave calls.
   std::vector<uint8_t> quote(quote_size);
-  result = dcap_library_->QeGetQuote(
+  quote3_error_t result = dcap_library_->QeGetQuote(
       CheckedPointerCast<const sgx_report_t *>(&report), quote_size,
       quote.data());
   if (result != SGX_QL_SUCCESS) {
+    // The failure may be due to a stale quote size (e.g. the platform TCB
+    // changed underneath us). Invalidate the cache so that the next request
+    // re-fetches the QE's current values.
+    absl::MutexLock lock(&qe_cache_mu_);
+    qe_targetinfo_cache_.reset();
+    qe_quote_size_cache_.reset();
     return Quote3ErrorToStatus(result);
   }
 
@@ -25,6 +25,8 @@
 #include <string>
 #include <vector>
 
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
 #include "absl/types/span.h"
 #include "asylo/crypto/algorithms.pb.h"
 #include "asylo/crypto/util/bytes.h"
@@ -76,6 +78,17 @@ class DcapIntelArchitecturalEnclaveInterface
 
  private:
   std::unique_ptr<DcapLibraryInterface> dcap_library_;
+
+  // Serializes access to the cached quoting enclave (QE) values below.
+  absl::Mutex qe_cache_mu_;
+
+  // The QE reports the same target info and quote size until the platform TCB
+  // or quoting configuration changes, so both values are fetched once and
+  // reused across quote requests. SetPckCertificateChain() invalidates the
+  // cache, as does a quote-generation failure, since either indicates that the
+  // QE's view of the platform may have changed.
+  absl::optional<Targetinfo> qe_targetinfo_cache_ ABSL_GUARDED_BY(qe_cache_mu_);
+  absl::optional<uint32_t> qe_quote_size_cache_ ABSL_GUARDED_BY(qe_cache_mu_);
 };
 
 }  // namespace sgx
@@ -435,6 +435,19 @@ TEST_F(DcapIntelArchitecturalEnclaveInterfaceTests, QeGetTargetinfoFailure) {
   EXPECT_THAT(dcap_.GetQeTargetinfo(), StatusIs(absl::StatusCode::kInternal));
 }
 
+TEST_F(DcapIntelArchitecturalEnclaveInterfaceTests,
+       QeGetTargetinfoCachesResultAcrossCalls) {
+  const Targetinfo kExpectedTargetinfo = TrivialRandomObject<Targetinfo>();
+
+  EXPECT_CALL(*dcap_library_, QeGetTargetInfo(NotNull()))
+      .WillOnce(DoAll(
+          SetArgBuffer<0>(&kExpectedTargetinfo, sizeof(kExpectedTargetinfo)),
+          Return(SGX_QL_SUCCESS)));
+
+  EXPECT_THAT(dcap_.GetQeTargetinfo(), IsOkAndHolds(kExpectedTargetinfo));
+  EXPECT_THAT(dcap_.GetQeTargetinfo(), IsOkAndHolds(kExpectedTargetinfo));
+}
+
 TEST_F(DcapIntelArchitecturalEnclaveInterfaceTests,
        GetQeQuoteSucceedsWithCompleteQuoteData) {
   const Report kReport = TrivialRandomObject<Report>();
@@ -467,6 +480,41 @@ TEST_F(DcapIntelArchitecturalEnclaveInterfaceTests, GetQeQuoteFailure) {
               StatusIs(absl::StatusCode::kPermissionDenied));
 }
 
+TEST_F(DcapIntelArchitecturalEnclaveInterfaceTests,
+       GetQeQuoteReusesCachedQuoteSize) {
+  const Report kReport = TrivialRandomObject<Report>();
+  std::vector<uint8_t> quote(4321);  // arbitrary quote size
+  std::iota(quote.begin(), quote.end(), 0);
+  EXPECT_CALL(*dcap_library_, QeGetQuoteSize(NotNull()))
+      .WillOnce(DoAll(SetArgPointee<0>(quote.size()), Return(SGX_QL_SUCCESS)));
+  EXPECT_CALL(*dcap_library_, QeGetQuote(Pointee(TrivialObjectEq(kReport)),
+                                         quote.size(), NotNull()))
+      .Times(2)
+      .WillRepeatedly(DoAll(SetArgContainer<2>(quote), Return(SGX_QL_SUCCESS)));
+
+  EXPECT_THAT(dcap_.GetQeQuote(kReport), IsOkAndHolds(quote));
+  EXPECT_THAT(dcap_.GetQeQuote(kReport), IsOkAndHolds(quote));
+}
+
+TEST_F(DcapIntelArchitecturalEnclaveInterfaceTests,
+       SetPckCertificateChainInvalidatesCachedQuoteSize) {
+  const Report kReport = TrivialRandomObject<Report>();
+  constexpr uint32_t kFakeQuoteSize = 32;  // size is arbitrary
+  EXPECT_CALL(*dcap_library_, QeGetQuoteSize(NotNull()))
+      .Times(2)
+      .WillRepeatedly(
+          DoAll(SetArgPointee<0>(kFakeQuoteSize), Return(SGX_QL_SUCCESS)));
+  EXPECT_CALL(*dcap_library_, QeGetQuote(NotNull(), kFakeQuoteSize, NotNull()))
+      .Times(2)
+      .WillRepeatedly(Return(SGX_QL_SUCCESS));
+  EXPECT_CALL(*dcap_library_, SetQuoteConfig(_))
+      .WillOnce(Return(SGX_QL_SUCCESS));
+
+  ASYLO_EXPECT_OK(dcap_.GetQeQuote(kReport));
+  ASYLO_EXPECT_OK(dcap_.SetPckCertificateChain(GetFakePckCertificateChain()));
+  ASYLO_EXPECT_OK(dcap_.GetQeQuote(kReport));
+}
+
 }  // namespace
 }  // namespace sgx
 }  // namespace asylo
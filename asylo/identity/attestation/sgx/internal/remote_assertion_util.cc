@@ -193,17 +193,35 @@ Status MakeRemoteAssertion(const std::string &user_data,
                            const SigningKey &signing_key,
                            const std::vector<CertificateChain> &cert_chains,
                            RemoteAssertion *assertion) {
-  assertion->Clear();
+  RemoteAssertion assertion_template;
+  ASYLO_ASSIGN_OR_RETURN(assertion_template,
+                         MakeRemoteAssertionTemplate(signing_key, cert_chains));
+  return FinalizeRemoteAssertion(user_data, identity, signing_key,
+                                 assertion_template, assertion);
+}
+
+StatusOr<RemoteAssertion> MakeRemoteAssertionTemplate(
+    const SigningKey &signing_key,
+    const std::vector<CertificateChain> &cert_chains) {
+  RemoteAssertion assertion_template;
   std::unique_ptr<VerifyingKey> verifying_key;
   ASYLO_ASSIGN_OR_RETURN(verifying_key, signing_key.GetVerifyingKey());
   ASYLO_ASSIGN_OR_RETURN(
-      *assertion->mutable_verifying_key(),
+      *assertion_template.mutable_verifying_key(),
       verifying_key->SerializeToKeyProto(ASYMMETRIC_KEY_DER));
 
   for (const auto &chain : cert_chains) {
-    *assertion->add_certificate_chains() = chain;
+    *assertion_template.add_certificate_chains() = chain;
   }
+  return assertion_template;
+}
 
+Status FinalizeRemoteAssertion(const std::string &user_data,
+                               const SgxIdentity &identity,
+                               const SigningKey &signing_key,
+                               const RemoteAssertion &assertion_template,
+                               RemoteAssertion *assertion) {
+  *assertion = assertion_template;
   RemoteAssertionPayload payload;
   payload.set_version(kRemoteAssertionVersion);
   payload.set_signature_scheme(signing_key.GetSignatureScheme());
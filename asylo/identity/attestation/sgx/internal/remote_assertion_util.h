@@ -31,6 +31,7 @@
 #include "asylo/identity/identity_acl.pb.h"
 #include "asylo/identity/platform/sgx/sgx_identity.pb.h"
 #include "asylo/util/status.h"
+#include "asylo/util/statusor.h"
 
 namespace asylo {
 namespace sgx {
@@ -45,6 +46,26 @@ Status MakeRemoteAssertion(const std::string &user_data,
                            const std::vector<CertificateChain> &cert_chains,
                            RemoteAssertion *assertion);
 
+// Creates a partial RemoteAssertion containing the verifying key derived from
+// |signing_key| and all certificate chains in |cert_chains|, but no payload or
+// signature. The result may be cached and reused across many calls to
+// FinalizeRemoteAssertion() for as long as |signing_key| and |cert_chains|
+// remain unchanged, which avoids re-deriving the verifying key and re-loading
+// the certificate chains for every assertion.
+StatusOr<RemoteAssertion> MakeRemoteAssertionTemplate(
+    const SigningKey &signing_key,
+    const std::vector<CertificateChain> &cert_chains);
+
+// Completes a copy of |assertion_template|, as produced by
+// MakeRemoteAssertionTemplate() from |signing_key|, by binding |user_data| to a
+// statement about |identity| and signing the result with |signing_key|. Places
+// the completed assertion in |assertion|.
+Status FinalizeRemoteAssertion(const std::string &user_data,
+                               const SgxIdentity &identity,
+                               const SigningKey &signing_key,
+                               const RemoteAssertion &assertion_template,
+                               RemoteAssertion *assertion);
+
 // Verifies |assertion| by verifying the following:
 //   * |assertion| is cryptographically-bound to |user_data|
 //   * The payload in |assertion| is signed by |assertion|.verifying_key()
@@ -384,6 +384,33 @@ TEST(RemoteAssertionUtilTest, MakeAndVerifyRemoteAssertionSucceeds) {
   EXPECT_THAT(actual_identity, EqualsProto(inputs.self_identity));
 }
 
+TEST(RemoteAssertionUtilTest, FinalizeRemoteAssertionFromTemplateSucceeds) {
+  RemoteAssertionInputs inputs;
+  ASYLO_ASSERT_OK_AND_ASSIGN(inputs, GenerateRemoteAssertionInputs());
+
+  RemoteAssertion assertion_template;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      assertion_template,
+      MakeRemoteAssertionTemplate(*inputs.attestation_signing_key,
+                                  inputs.certificate_chains));
+
+  // A single template can be reused for assertions over different user data.
+  const std::string user_data_values[] = {"first user data",
+                                          "second user data"};
+  for (const std::string &user_data : user_data_values) {
+    RemoteAssertion assertion;
+    ASYLO_ASSERT_OK(FinalizeRemoteAssertion(
+        user_data, inputs.self_identity, *inputs.attestation_signing_key,
+        assertion_template, &assertion));
+
+    SgxIdentity actual_identity;
+    ASYLO_ASSERT_OK(VerifyRemoteAssertion(
+        user_data, assertion, *inputs.intel_root, inputs.required_roots,
+        inputs.age_expectation, &actual_identity));
+    EXPECT_THAT(actual_identity, EqualsProto(inputs.self_identity));
+  }
+}
+
 TEST(RemoteAssertionUtilTest, VerifyRemoteAssertionMissingRequiredChain) {
   RemoteAssertionInputs inputs;
   ASYLO_ASSERT_OK_AND_ASSIGN(inputs, GenerateRemoteAssertionInputs());
@@ -18,10 +18,13 @@
 
 #include "asylo/identity/attestation/sgx/internal/sgx_infrastructural_enclave_manager.h"
 
+#include <queue>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "asylo/crypto/util/trivial_object_util.h"
 #include "asylo/enclave.pb.h"
 #include "asylo/enclave_manager.h"
@@ -34,6 +37,7 @@
 #include "asylo/identity/sealing/sealed_secret.pb.h"
 #include "asylo/platform/primitives/sgx/loader.pb.h"
 #include "asylo/util/status_macros.h"
+#include "asylo/util/thread.h"
 
 namespace asylo {
 namespace {
@@ -47,6 +51,28 @@ Status CheckEnclaveOutputExtension(EnclaveOutput output) {
   return absl::OkStatus();
 }
 
+// One unit of work handed from the AGE stage of CertifyAgeBatch() to the PCE
+// stage: a REPORT bound to a freshly-generated attestation key, tagged with
+// the index of the target it belongs to.
+struct PendingCertification {
+  int index;
+  sgx::ReportProto report;
+  std::string pce_sign_report_payload;
+};
+
+// State shared between the two stages of CertifyAgeBatch().
+struct CertificationPipeline {
+  absl::Mutex mu;
+  std::queue<PendingCertification> pending ABSL_GUARDED_BY(mu);
+  bool age_done ABSL_GUARDED_BY(mu) = false;
+};
+
+// Returns true once the PCE stage has work to pick up or the AGE stage has
+// finished producing.
+bool PceStageCanProceed(CertificationPipeline *pipeline) {
+  return !pipeline->pending.empty() || pipeline->age_done;
+}
+
 }  // namespace
 
 const char *SgxInfrastructuralEnclaveManager::kAgeClientName =
@@ -133,6 +159,82 @@ StatusOr<Certificate> SgxInfrastructuralEnclaveManager::CertifyAge() {
                     pce_svn, age_identity.machine_configuration().cpu_svn());
 }
 
+StatusOr<std::vector<Certificate>>
+SgxInfrastructuralEnclaveManager::CertifyAgeBatch(
+    const std::vector<CertifyAgeTarget> &targets) {
+  const int num_targets = targets.size();
+  std::vector<Certificate> certificates(num_targets);
+  std::vector<Status> statuses(num_targets);
+  if (num_targets == 0) {
+    return certificates;
+  }
+
+  // Get the PCE's target info once for the whole batch.
+  sgx::TargetInfoProto pce_target_info;
+  sgx::PceSvn pce_svn;
+  ASYLO_RETURN_IF_ERROR(PceGetTargetInfo(&pce_target_info, &pce_svn));
+
+  CertificationPipeline pipeline;
+
+  // PCE stage: signs each REPORT produced by the AGE stage and assembles the
+  // attestation key certificate. The AGE and PCE are separate enclaves, so
+  // this overlaps with the AGE stage generating the next key.
+  Thread pce_stage([this, &targets, &pipeline, &certificates, &statuses] {
+    while (true) {
+      PendingCertification work;
+      {
+        absl::MutexLock lock(&pipeline.mu);
+        pipeline.mu.Await(absl::Condition(PceStageCanProceed, &pipeline));
+        if (pipeline.pending.empty()) {
+          return;
+        }
+        work = std::move(pipeline.pending.front());
+        pipeline.pending.pop();
+      }
+      StatusOr<Certificate> certificate_result = CertifyAge(
+          std::move(work.report), std::move(work.pce_sign_report_payload),
+          targets[work.index].pce_svn, targets[work.index].cpu_svn);
+      if (certificate_result.ok()) {
+        certificates[work.index] = std::move(certificate_result).ValueOrDie();
+      } else {
+        statuses[work.index] = certificate_result.status();
+      }
+    }
+  });
+
+  // AGE stage: generates one attestation key and REPORT per target and hands
+  // them to the PCE stage.
+  for (int i = 0; i < num_targets; ++i) {
+    PendingCertification work;
+    work.index = i;
+    sgx::TargetedCertificateSigningRequest unused_signing_request;
+    Status status =
+        AgeGenerateKeyAndCsr(pce_target_info, &work.report,
+                             &work.pce_sign_report_payload,
+                             &unused_signing_request);
+    if (!status.ok()) {
+      // Without a REPORT there is nothing to hand to the PCE stage for this
+      // or any later target.
+      statuses[i] = status;
+      break;
+    }
+    absl::MutexLock lock(&pipeline.mu);
+    pipeline.pending.push(std::move(work));
+  }
+  {
+    absl::MutexLock lock(&pipeline.mu);
+    pipeline.age_done = true;
+  }
+  pce_stage.Join();
+
+  // Assemble results in target order; the earliest failing target determines
+  // the returned status, as if the targets had been certified sequentially.
+  for (int i = 0; i < num_targets; ++i) {
+    ASYLO_RETURN_IF_ERROR(statuses[i]);
+  }
+  return certificates;
+}
+
 StatusOr<Certificate> SgxInfrastructuralEnclaveManager::CertifyAge(
     sgx::ReportProto age_report, std::string pce_sign_report_payload,
     const sgx::PceSvn &target_pce_svn, const sgx::CpuSvn &target_cpu_svn) {
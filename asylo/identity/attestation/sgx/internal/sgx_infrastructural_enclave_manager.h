@@ -93,6 +93,23 @@ class SgxInfrastructuralEnclaveManager {
   // attestation key certificate.
   StatusOr<Certificate> CertifyAge();
 
+  // Describes one certificate to issue in CertifyAgeBatch(): the generated
+  // attestation key is certified with the PCK at |pce_svn| and |cpu_svn|.
+  struct CertifyAgeTarget {
+    sgx::PceSvn pce_svn;
+    sgx::CpuSvn cpu_svn;
+  };
+
+  // Issues one attestation key certificate per entry of |targets| and returns
+  // the certificates in the same order. Each entry is certified exactly as by
+  // CertifyAge(pce_svn, cpu_svn), but the AGE and PCE entries are pipelined:
+  // while the PCE signs the REPORT for one target, the AGE generates the key
+  // for the next, so a large batch costs roughly the slower of the two stages
+  // rather than their sum. On failure, returns the status of the earliest
+  // failing target.
+  StatusOr<std::vector<Certificate>> CertifyAgeBatch(
+      const std::vector<CertifyAgeTarget> &targets);
+
   /////////////////////////////////////////////
   //    Assertion Generator Enclave (AGE)    //
   /////////////////////////////////////////////
@@ -51,6 +51,7 @@ namespace {
 
 using ::testing::_;
 using ::testing::DoAll;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::Not;
 using ::testing::NotNull;
@@ -156,6 +157,18 @@ void SetCertificateChain(std::vector<CertificateChain> *certificate_chains) {
   certificate->set_data(kCertificate);
 }
 
+EnclaveOutput GenerateKeyAndCsrEnclaveOutput(const sgx::ReportProto &report) {
+  EnclaveOutput enclave_output;
+  sgx::GenerateKeyAndCsrOutput *output =
+      enclave_output
+          .MutableExtension(sgx::remote_assertion_generator_enclave_output)
+          ->mutable_generate_key_and_csr_output();
+  *output->mutable_report() = report;
+  output->set_pce_sign_report_payload(kPceSignReportPayload);
+  *output->mutable_targeted_csr() = TargetedCertificateSigningRequest();
+  return enclave_output;
+}
+
 asylo::AsymmetricEncryptionKeyProto Ppidek() {
   AsymmetricEncryptionKeyProto ppidek;
   ppidek.set_encryption_scheme(AsymmetricEncryptionScheme::RSA3072_OAEP);
@@ -714,5 +727,135 @@ TEST_F(SgxInfrastructuralEnclaveManagerTest,
               IsOkAndHolds(EqualsProto(expected_certificate)));
 }
 
+TEST_F(SgxInfrastructuralEnclaveManagerTest, CertifyAgeBatchSuccess) {
+  EXPECT_CALL(*mock_intel_ae_, GetPceTargetinfo(NotNull(), NotNull()))
+      .WillOnce(DoAll(SetArgPointee<0>(PceTargetinfo()),
+                      SetArgPointee<1>(PceSvn().value()),
+                      Return(Status::OkStatus())));
+
+  std::vector<SgxInfrastructuralEnclaveManager::CertifyAgeTarget> targets(2);
+  targets[0].pce_svn.set_value(kPceSvn);
+  targets[0].cpu_svn = CreateCpuSvn();
+  targets[1].pce_svn.set_value(kPceSvn + 1);
+  targets[1].cpu_svn = CreateCpuSvn();
+
+  std::vector<sgx::ReportProto> reports = {Report(), Report()};
+  EXPECT_CALL(*mock_assertion_generator_enclave_, EnterAndRun)
+      .WillOnce(DoAll(SetArgPointee<1>(GenerateKeyAndCsrEnclaveOutput(
+                          reports[0])),
+                      Return(Status::OkStatus())))
+      .WillOnce(DoAll(SetArgPointee<1>(GenerateKeyAndCsrEnclaveOutput(
+                          reports[1])),
+                      Return(Status::OkStatus())));
+
+  for (int i = 0; i < 2; ++i) {
+    sgx::Report expected_report;
+    SetTrivialObjectFromBinaryString(reports[i].value(), &expected_report);
+    EXPECT_CALL(
+        *mock_intel_ae_,
+        PceSignReport(TrivialObjectEq(expected_report),
+                      targets[i].pce_svn.value(),
+                      UnsafeBytes<sgx::kCpusvnSize>(targets[i].cpu_svn.value()),
+                      NotNull()))
+        .WillOnce(DoAll(SetArgPointee<3>(PckSignature()),
+                        Return(Status::OkStatus())));
+  }
+
+  Certificate expected_certificate_0;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      expected_certificate_0,
+      CreateAttestationKeyCertificate(reports[0], EcdsaSignature(),
+                                      kPceSignReportPayload));
+  Certificate expected_certificate_1;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      expected_certificate_1,
+      CreateAttestationKeyCertificate(reports[1], EcdsaSignature(),
+                                      kPceSignReportPayload));
+
+  std::vector<Certificate> certificates;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      certificates, sgx_infrastructural_enclave_manager_->CertifyAgeBatch(
+                        targets));
+  EXPECT_THAT(certificates, ElementsAre(EqualsProto(expected_certificate_0),
+                                        EqualsProto(expected_certificate_1)));
+}
+
+TEST_F(SgxInfrastructuralEnclaveManagerTest,
+       CertifyAgeBatchReturnsEarliestFailingTarget) {
+  EXPECT_CALL(*mock_intel_ae_, GetPceTargetinfo(NotNull(), NotNull()))
+      .WillOnce(DoAll(SetArgPointee<0>(PceTargetinfo()),
+                      SetArgPointee<1>(PceSvn().value()),
+                      Return(Status::OkStatus())));
+
+  std::vector<SgxInfrastructuralEnclaveManager::CertifyAgeTarget> targets(2);
+  targets[0].pce_svn.set_value(kPceSvn);
+  targets[0].cpu_svn = CreateCpuSvn();
+  targets[1].pce_svn.set_value(kPceSvn + 1);
+  targets[1].cpu_svn = CreateCpuSvn();
+
+  std::vector<sgx::ReportProto> reports = {Report(), Report()};
+  EXPECT_CALL(*mock_assertion_generator_enclave_, EnterAndRun)
+      .WillOnce(DoAll(SetArgPointee<1>(GenerateKeyAndCsrEnclaveOutput(
+                          reports[0])),
+                      Return(Status::OkStatus())))
+      .WillOnce(DoAll(SetArgPointee<1>(GenerateKeyAndCsrEnclaveOutput(
+                          reports[1])),
+                      Return(Status::OkStatus())));
+
+  // The first target fails in the PCE while the second succeeds; the batch
+  // must report the failure of the earliest target.
+  sgx::Report expected_report_0;
+  SetTrivialObjectFromBinaryString(reports[0].value(), &expected_report_0);
+  EXPECT_CALL(*mock_intel_ae_,
+              PceSignReport(TrivialObjectEq(expected_report_0),
+                            targets[0].pce_svn.value(), _, NotNull()))
+      .WillOnce(
+          Return(Status(absl::StatusCode::kUnknown, kUnknownErrorMessage)));
+  sgx::Report expected_report_1;
+  SetTrivialObjectFromBinaryString(reports[1].value(), &expected_report_1);
+  EXPECT_CALL(*mock_intel_ae_,
+              PceSignReport(TrivialObjectEq(expected_report_1),
+                            targets[1].pce_svn.value(), _, NotNull()))
+      .WillOnce(
+          DoAll(SetArgPointee<3>(PckSignature()), Return(Status::OkStatus())));
+
+  EXPECT_THAT(sgx_infrastructural_enclave_manager_->CertifyAgeBatch(targets),
+              StatusIs(absl::StatusCode::kUnknown, kUnknownErrorMessage));
+}
+
+TEST_F(SgxInfrastructuralEnclaveManagerTest,
+       CertifyAgeBatchStopsAfterAgeFailure) {
+  EXPECT_CALL(*mock_intel_ae_, GetPceTargetinfo(NotNull(), NotNull()))
+      .WillOnce(DoAll(SetArgPointee<0>(PceTargetinfo()),
+                      SetArgPointee<1>(PceSvn().value()),
+                      Return(Status::OkStatus())));
+
+  std::vector<SgxInfrastructuralEnclaveManager::CertifyAgeTarget> targets(2);
+  targets[0].pce_svn.set_value(kPceSvn);
+  targets[0].cpu_svn = CreateCpuSvn();
+  targets[1].pce_svn.set_value(kPceSvn + 1);
+  targets[1].cpu_svn = CreateCpuSvn();
+
+  // The AGE fails to generate the second key; the already-generated first
+  // REPORT is still signed, but the batch reports the AGE failure.
+  sgx::ReportProto report = Report();
+  EXPECT_CALL(*mock_assertion_generator_enclave_, EnterAndRun)
+      .WillOnce(DoAll(SetArgPointee<1>(GenerateKeyAndCsrEnclaveOutput(report)),
+                      Return(Status::OkStatus())))
+      .WillOnce(
+          Return(Status(absl::StatusCode::kUnknown, kUnknownErrorMessage)));
+
+  sgx::Report expected_report;
+  SetTrivialObjectFromBinaryString(report.value(), &expected_report);
+  EXPECT_CALL(*mock_intel_ae_,
+              PceSignReport(TrivialObjectEq(expected_report),
+                            targets[0].pce_svn.value(), _, NotNull()))
+      .WillOnce(
+          DoAll(SetArgPointee<3>(PckSignature()), Return(Status::OkStatus())));
+
+  EXPECT_THAT(sgx_infrastructural_enclave_manager_->CertifyAgeBatch(targets),
+              StatusIs(absl::StatusCode::kUnknown, kUnknownErrorMessage));
+}
+
 }  // namespace
 }  // namespace asylo
@@ -18,6 +18,10 @@
 
 #include "asylo/identity/attestation/sgx/internal/sgx_remote_assertion_generator_client.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "asylo/util/status.h"
 #include "asylo/util/status_helpers.h"
 #include "include/grpcpp/client_context.h"
@@ -50,4 +54,25 @@ SgxRemoteAssertionGeneratorClient::GenerateSgxRemoteAssertion(
   return response.assertion();
 }
 
+StatusOr<std::vector<sgx::RemoteAssertion>>
+SgxRemoteAssertionGeneratorClient::GenerateSgxRemoteAssertions(
+    const std::vector<std::string> &user_data) {
+  ::grpc::ClientContext context;
+
+  GenerateSgxRemoteAssertionsRequest request;
+  for (const std::string &data : user_data) {
+    request.add_user_data(data);
+  }
+  GenerateSgxRemoteAssertionsResponse response;
+
+  ::grpc::Status status =
+      stub_->GenerateSgxRemoteAssertions(&context, request, &response);
+  if (!status.ok()) {
+    return ConvertStatus<asylo::Status>(status);
+  }
+
+  return std::vector<sgx::RemoteAssertion>(response.assertions().begin(),
+                                           response.assertions().end());
+}
+
 }  // namespace asylo
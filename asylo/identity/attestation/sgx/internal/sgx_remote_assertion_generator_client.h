@@ -20,6 +20,8 @@
 #define ASYLO_IDENTITY_ATTESTATION_SGX_INTERNAL_SGX_REMOTE_ASSERTION_GENERATOR_CLIENT_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "asylo/crypto/util/byte_container_view.h"
 #include "asylo/identity/attestation/sgx/internal/remote_assertion.pb.h"
@@ -48,6 +50,13 @@ class SgxRemoteAssertionGeneratorClient {
   StatusOr<sgx::RemoteAssertion> GenerateSgxRemoteAssertion(
       ByteContainerView user_data);
 
+  // Requests one SGX remote assertion for each entry in |user_data| from the
+  // remote server. All assertions are generated in a single RPC, which
+  // amortizes the cost of an enclave round-trip across the batch. On success,
+  // returns the assertions in the same order as |user_data|.
+  StatusOr<std::vector<sgx::RemoteAssertion>> GenerateSgxRemoteAssertions(
+      const std::vector<std::string> &user_data);
+
  private:
   std::unique_ptr<SgxRemoteAssertionGenerator::StubInterface> stub_;
 };
@@ -99,5 +99,60 @@ TEST(SgxRemoteAssertionGeneratorClientTest, GenerateSgxRemoteAssertionFails) {
               StatusIs(absl::StatusCode::kPermissionDenied));
 }
 
+// Tests that the SgxRemoteAssertionGeneratorClient correctly propagates the
+// result from a successful GenerateSgxRemoteAssertions RPC.
+TEST(SgxRemoteAssertionGeneratorClientTest,
+     GenerateSgxRemoteAssertionsSucceeds) {
+  auto mock_stub =
+      absl::make_unique<MockSgxRemoteAssertionGeneratorStub>();
+
+  GenerateSgxRemoteAssertionsRequest request;
+  request.add_user_data("first user data");
+  request.add_user_data("second user data");
+  GenerateSgxRemoteAssertionsResponse response;
+  sgx::RemoteAssertion &assertion1 = *response.add_assertions();
+  assertion1.set_payload("payload1");
+  assertion1.set_signature("signature1");
+  sgx::RemoteAssertion &assertion2 = *response.add_assertions();
+  assertion2.set_payload("payload2");
+  assertion2.set_signature("signature2");
+
+  EXPECT_CALL(*mock_stub,
+              GenerateSgxRemoteAssertions(_, EqualsProto(request), _))
+      .WillOnce(DoAll(SetArgPointee<2>(response), Return(::grpc::Status::OK)));
+
+  SgxRemoteAssertionGeneratorClient client(
+      std::unique_ptr<SgxRemoteAssertionGenerator::StubInterface>(
+          std::move(mock_stub)));
+  auto result = client.GenerateSgxRemoteAssertions(
+      {"first user data", "second user data"});
+
+  ASSERT_THAT(result, IsOk());
+  ASSERT_EQ(result.ValueOrDie().size(), 2);
+  EXPECT_THAT(result.ValueOrDie()[0], EqualsProto(assertion1));
+  EXPECT_THAT(result.ValueOrDie()[1], EqualsProto(assertion2));
+}
+
+// Tests that the SgxRemoteAssertionGeneratorClient correctly propagates the
+// RPC status from a failed GenerateSgxRemoteAssertions RPC.
+TEST(SgxRemoteAssertionGeneratorClientTest, GenerateSgxRemoteAssertionsFails) {
+  auto mock_stub =
+      absl::make_unique<MockSgxRemoteAssertionGeneratorStub>();
+
+  GenerateSgxRemoteAssertionsRequest request;
+  request.add_user_data(kUserData);
+
+  EXPECT_CALL(*mock_stub,
+              GenerateSgxRemoteAssertions(_, EqualsProto(request), _))
+      .WillOnce(Return(::grpc::Status(::grpc::StatusCode::PERMISSION_DENIED,
+                                      "Peer does not have SGX code identity")));
+
+  SgxRemoteAssertionGeneratorClient client(
+      std::unique_ptr<SgxRemoteAssertionGenerator::StubInterface>(
+          std::move(mock_stub)));
+  EXPECT_THAT(client.GenerateSgxRemoteAssertions({kUserData}),
+              StatusIs(absl::StatusCode::kPermissionDenied));
+}
+
 }  // namespace
 }  // namespace asylo
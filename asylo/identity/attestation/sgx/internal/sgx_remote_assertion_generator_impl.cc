@@ -19,10 +19,12 @@
 #include "asylo/identity/attestation/sgx/internal/sgx_remote_assertion_generator_impl.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "asylo/grpc/auth/enclave_auth_context.h"
+#include "asylo/identity/attestation/sgx/internal/remote_assertion.pb.h"
 #include "asylo/identity/attestation/sgx/internal/remote_assertion_util.h"
 #include "asylo/identity/descriptions.h"
 #include "asylo/identity/platform/sgx/sgx_identity_util.h"
@@ -30,6 +32,7 @@
 #include "asylo/util/status.h"
 #include "asylo/util/status_helpers.h"
 #include "asylo/util/status_macros.h"
+#include "asylo/util/statusor.h"
 #include "include/grpcpp/support/status.h"
 
 namespace asylo {
@@ -52,17 +55,40 @@ Status ExtractSgxIdentity(const EnclaveAuthContext &auth_context,
   return Status::OkStatus();
 }
 
+// Returns a partial assertion for |signing_key| and |certificate_chains| that
+// can be completed with FinalizeRemoteAssertion(). Returns an empty
+// RemoteAssertion if |signing_key| is null or the template cannot be built.
+sgx::RemoteAssertion BuildAssertionTemplate(
+    const SigningKey *signing_key,
+    const std::vector<CertificateChain> &certificate_chains) {
+  if (signing_key == nullptr) {
+    return sgx::RemoteAssertion();
+  }
+
+  StatusOr<sgx::RemoteAssertion> template_result =
+      sgx::MakeRemoteAssertionTemplate(*signing_key, certificate_chains);
+  if (!template_result.ok()) {
+    LOG(ERROR) << "MakeRemoteAssertionTemplate failed: "
+               << template_result.status();
+    return sgx::RemoteAssertion();
+  }
+  return std::move(template_result).ValueOrDie();
+}
+
 }  // namespace
 
 SgxRemoteAssertionGeneratorImpl::SgxRemoteAssertionGeneratorImpl()
     : signing_key_(nullptr),
-      certificate_chains_(std::vector<CertificateChain>()) {}
+      certificate_chains_(std::vector<CertificateChain>()),
+      assertion_template_(sgx::RemoteAssertion()) {}
 
 SgxRemoteAssertionGeneratorImpl::SgxRemoteAssertionGeneratorImpl(
     std::unique_ptr<SigningKey> signing_key,
     const std::vector<CertificateChain> &certificate_chains)
     : signing_key_(std::move(signing_key)),
-      certificate_chains_(certificate_chains) {}
+      certificate_chains_(certificate_chains),
+      assertion_template_(BuildAssertionTemplate(
+          signing_key_.ReaderLock()->get(), certificate_chains)) {}
 
 ::grpc::Status SgxRemoteAssertionGeneratorImpl::GenerateSgxRemoteAssertion(
     ::grpc::ServerContext *context,
@@ -91,10 +117,19 @@ SgxRemoteAssertionGeneratorImpl::SgxRemoteAssertionGeneratorImpl(
                           "No attestation key available");
   }
 
-  auto certificate_chains_locked = certificate_chains_.ReaderLock();
-  status = MakeRemoteAssertion(request->user_data(), sgx_identity,
-                               **signing_key_locked, *certificate_chains_locked,
-                               response->mutable_assertion());
+  auto assertion_template_locked = assertion_template_.ReaderLock();
+  if (assertion_template_locked->has_verifying_key()) {
+    status = FinalizeRemoteAssertion(request->user_data(), sgx_identity,
+                                     **signing_key_locked,
+                                     *assertion_template_locked,
+                                     response->mutable_assertion());
+  } else {
+    auto certificate_chains_locked = certificate_chains_.ReaderLock();
+    status = MakeRemoteAssertion(request->user_data(), sgx_identity,
+                                 **signing_key_locked,
+                                 *certificate_chains_locked,
+                                 response->mutable_assertion());
+  }
   if (!status.ok()) {
     LOG(ERROR) << "MakeRemoteAssertion failed: " << status;
     return ::grpc::Status(::grpc::StatusCode::INTERNAL,
@@ -103,13 +138,70 @@ SgxRemoteAssertionGeneratorImpl::SgxRemoteAssertionGeneratorImpl(
   return ::grpc::Status::OK;
 }
 
+::grpc::Status SgxRemoteAssertionGeneratorImpl::GenerateSgxRemoteAssertions(
+    ::grpc::ServerContext *context,
+    const GenerateSgxRemoteAssertionsRequest *request,
+    GenerateSgxRemoteAssertionsResponse *response) {
+  StatusOr<EnclaveAuthContext> auth_context_result =
+      EnclaveAuthContext::CreateFromAuthContext(*context->auth_context());
+  if (!auth_context_result.ok()) {
+    LOG(ERROR) << "CreateFromServerContext failed: "
+               << auth_context_result.status();
+    return ::grpc::Status(
+        ::grpc::StatusCode::INTERNAL,
+        "Failed to retrieve enclave authentication information");
+  }
+  EnclaveAuthContext auth_context = auth_context_result.ValueOrDie();
+
+  // The caller's identity is extracted once and bound to every assertion in
+  // the batch.
+  SgxIdentity sgx_identity;
+  Status status = ExtractSgxIdentity(auth_context, &sgx_identity);
+  if (!status.ok()) {
+    return ConvertStatus<::grpc::Status>(status);
+  }
+  auto signing_key_locked = signing_key_.ReaderLock();
+
+  if (*signing_key_locked == nullptr) {
+    return ::grpc::Status(::grpc::StatusCode::FAILED_PRECONDITION,
+                          "No attestation key available");
+  }
+
+  auto assertion_template_locked = assertion_template_.ReaderLock();
+  sgx::RemoteAssertion assertion_template = *assertion_template_locked;
+  if (!assertion_template.has_verifying_key()) {
+    auto certificate_chains_locked = certificate_chains_.ReaderLock();
+    assertion_template = BuildAssertionTemplate(signing_key_locked->get(),
+                                                *certificate_chains_locked);
+    if (!assertion_template.has_verifying_key()) {
+      return ::grpc::Status(::grpc::StatusCode::INTERNAL,
+                            "Failed to generate SGX remote assertion");
+    }
+  }
+
+  for (const std::string &user_data : request->user_data()) {
+    status = FinalizeRemoteAssertion(user_data, sgx_identity,
+                                     **signing_key_locked, assertion_template,
+                                     response->add_assertions());
+    if (!status.ok()) {
+      LOG(ERROR) << "FinalizeRemoteAssertion failed: " << status;
+      return ::grpc::Status(::grpc::StatusCode::INTERNAL,
+                            "Failed to generate SGX remote assertion");
+    }
+  }
+  return ::grpc::Status::OK;
+}
+
 void SgxRemoteAssertionGeneratorImpl::UpdateSigningKeyAndCertificateChains(
     std::unique_ptr<SigningKey> signing_key,
     const std::vector<CertificateChain> &certificate_chains) {
   auto signing_key_locked = signing_key_.Lock();
+  auto assertion_template_locked = assertion_template_.Lock();
   auto certificate_chains_locked = certificate_chains_.Lock();
   *signing_key_locked = std::move(signing_key);
   *certificate_chains_locked = certificate_chains;
+  *assertion_template_locked =
+      BuildAssertionTemplate(signing_key_locked->get(), certificate_chains);
 }
 
 }  // namespace asylo
@@ -24,6 +24,7 @@
 
 #include "asylo/crypto/certificate.pb.h"
 #include "asylo/crypto/signing_key.h"
+#include "asylo/identity/attestation/sgx/internal/remote_assertion.pb.h"
 #include "asylo/identity/attestation/sgx/internal/sgx_remote_assertion_generator.grpc.pb.h"
 #include "asylo/util/mutex_guarded.h"
 #include "asylo/util/status.h"
@@ -58,6 +59,18 @@ class SgxRemoteAssertionGeneratorImpl
       const GenerateSgxRemoteAssertionRequest *request,
       GenerateSgxRemoteAssertionResponse *response) override;
 
+  // Generates one SGX remote assertion for each user-data value in |request|
+  // for the caller described in |context|, if that caller is an authenticated
+  // local SGX enclave entity. The caller's identity is extracted and the
+  // attestation key certification material is loaded once for the whole batch.
+  // On success, writes the assertions to |response| in request order. Returns
+  // an UNAUTHENTICATED error if the caller does not authenticate with their
+  // SGX identity.
+  ::grpc::Status GenerateSgxRemoteAssertions(
+      ::grpc::ServerContext *context,
+      const GenerateSgxRemoteAssertionsRequest *request,
+      GenerateSgxRemoteAssertionsResponse *response) override;
+
   // Updates |signing_key_| and |certificate_chains_| with |signing_key| and
   // |certificate_chains| respectively.
   void UpdateSigningKeyAndCertificateChains(
@@ -71,6 +84,12 @@ class SgxRemoteAssertionGeneratorImpl
   // Certificate chains that serve to prove the authenticity of signatures
   // produced by |signing_key_|.
   MutexGuarded<std::vector<CertificateChain>> certificate_chains_;
+
+  // A partial RemoteAssertion containing the verifying key for |signing_key_|
+  // and a copy of |certificate_chains_|. It is rebuilt whenever the signing key
+  // is installed so that per-assertion generation only needs to construct and
+  // sign the payload. Cleared if no signing key is available.
+  MutexGuarded<sgx::RemoteAssertion> assertion_template_;
 };
 
 }  // namespace asylo
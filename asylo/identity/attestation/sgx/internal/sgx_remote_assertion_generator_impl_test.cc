@@ -159,6 +159,27 @@ class SgxRemoteAssertionGeneratorImplTest : public testing::Test {
     return client.GenerateSgxRemoteAssertion(kUserData);
   }
 
+  // Starts a gRPC client that connects to the server using
+  // |channel_credentials|. Uses the client to make a
+  // GenerateSgxRemoteAssertions RPC for |user_data| and returns the result of
+  // the RPC.
+  StatusOr<std::vector<RemoteAssertion>> GenerateSgxRemoteAssertions(
+      const std::shared_ptr<::grpc::ChannelCredentials> &channel_credentials,
+      const std::vector<std::string> &user_data) {
+    std::shared_ptr<::grpc::Channel> channel =
+        ::grpc::CreateChannel(server_address_, channel_credentials);
+
+    gpr_timespec absolute_deadline =
+        gpr_time_add(gpr_now(GPR_CLOCK_REALTIME),
+                     gpr_time_from_micros(kDeadlineMicros, GPR_TIMESPAN));
+    if (!channel->WaitForConnected(absolute_deadline)) {
+      return Status(absl::StatusCode::kInternal, "Failed to connect to server");
+    }
+
+    SgxRemoteAssertionGeneratorClient client(channel);
+    return client.GenerateSgxRemoteAssertions(user_data);
+  }
+
   bool CheckCertificateChainsEqual(
       const std::vector<CertificateChain> &certificate_chains1,
       const google::protobuf::RepeatedPtrField<CertificateChain> &certificate_chains2) {
@@ -208,7 +229,8 @@ class SgxRemoteAssertionGeneratorImplTest : public testing::Test {
   void VerifyRemoteAssertion(
       const RemoteAssertion &assertion,
       const std::vector<CertificateChain> &certificate_chains,
-      const VerifyingKey &verifying_key) {
+      const VerifyingKey &verifying_key,
+      const std::string &user_data = kUserData) {
     EXPECT_EQ(assertion.verifying_key().signature_scheme(), signature_scheme_);
     EXPECT_EQ(assertion.certificate_chains().size(), certificate_chains.size());
     for (size_t i = 0; i < assertion.certificate_chains().size(); ++i) {
@@ -218,7 +240,7 @@ class SgxRemoteAssertionGeneratorImplTest : public testing::Test {
     RemoteAssertionPayload payload;
     EXPECT_TRUE(payload.ParseFromString(assertion.payload()));
     EXPECT_THAT(payload.identity(), EqualsProto(self_identity_->sgx_identity));
-    EXPECT_EQ(payload.user_data(), kUserData);
+    EXPECT_EQ(payload.user_data(), user_data);
     EXPECT_EQ(payload.signature_scheme(), signature_scheme_);
 
     ASYLO_EXPECT_OK(verifying_key.Verify(payload.SerializeAsString(),
@@ -269,6 +291,47 @@ TEST_F(SgxRemoteAssertionGeneratorImplTest,
       VerifyRemoteAssertion(assertion, certificate_chains_, *verifying_key_));
 }
 
+TEST_F(SgxRemoteAssertionGeneratorImplTest,
+       ServerWithoutAttestationKeyGenerateSgxRemoteAssertionsFails) {
+  // Configure the server and the peer to use bidirectional authentication based
+  // on SGX local attestation. SGX-remote-assertion generation is authorized in
+  // this case, but the server has no attestation key.
+  std::shared_ptr<::grpc::ServerCredentials> server_credentials =
+      EnclaveServerCredentials(BidirectionalSgxLocalCredentialsOptions());
+  auto service = absl::make_unique<SgxRemoteAssertionGeneratorImpl>();
+  SetUpServer(service.get(), server_credentials);
+
+  std::shared_ptr<::grpc::ChannelCredentials> channel_credentials =
+      EnclaveChannelCredentials(BidirectionalSgxLocalCredentialsOptions());
+  EXPECT_THAT(GenerateSgxRemoteAssertions(channel_credentials, {kUserData}),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+TEST_F(SgxRemoteAssertionGeneratorImplTest,
+       GenerateSgxRemoteAssertionsSucceeds) {
+  // Configure the server and the peer to use bidirectional authentication based
+  // on SGX local attestation. A batch request should produce one valid remote
+  // assertion per user-data value, in request order.
+  std::shared_ptr<::grpc::ServerCredentials> server_credentials =
+      EnclaveServerCredentials(BidirectionalSgxLocalCredentialsOptions());
+  std::unique_ptr<SgxRemoteAssertionGeneratorImpl> service;
+  ASYLO_ASSERT_OK_AND_ASSIGN(service, CreateServiceWithKeyAndCertificate());
+  SetUpServer(service.get(), server_credentials);
+
+  std::shared_ptr<::grpc::ChannelCredentials> channel_credentials =
+      EnclaveChannelCredentials(BidirectionalSgxLocalCredentialsOptions());
+  const std::vector<std::string> user_data = {"user data 1", "user data 2",
+                                              "user data 3"};
+  std::vector<RemoteAssertion> assertions;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      assertions, GenerateSgxRemoteAssertions(channel_credentials, user_data));
+  ASSERT_EQ(assertions.size(), user_data.size());
+  for (size_t i = 0; i < assertions.size(); ++i) {
+    EXPECT_NO_FATAL_FAILURE(VerifyRemoteAssertion(
+        assertions[i], certificate_chains_, *verifying_key_, user_data[i]));
+  }
+}
+
 TEST_F(SgxRemoteAssertionGeneratorImplTest,
        UpdateSigningKeyAndCertificateChainsOnNoKeyServerSucceeds) {
   // Configure the server and the peer to use bidirectional authentication based
@@ -23,8 +23,11 @@
 #include <algorithm>
 #include <iterator>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -70,6 +73,11 @@
 namespace asylo {
 namespace {
 
+// The maximum number of platforms tracked by the verification cache. Fleets
+// verifying assertions from more platforms than this within one TTL period
+// simply see extra cache misses.
+constexpr size_t kVerificationCacheMaxEntries = 1024;
+
 StatusOr<std::unique_ptr<EcdsaP256Sha256VerifyingKey>>
 ToEcdsaP256Sha256VerifyingKey(UnsafeBytes<64> big_endian_key_bytes) {
   EccP256CurvePoint public_key_point;
@@ -281,6 +289,27 @@ Status ParseEnclaveIdentityFromQuote(const sgx::ReportBody &report_body,
                       cert_data.qe_cert_data_type));
 }
 
+// Returns a cache key covering every input to the platform verification
+// checks: the quote-signing key, the QE's report and authenticated data, the
+// PCK signature over the QE report, and the certification data itself. Two
+// quotes with the same key are certified by exactly the same chain, so a
+// successful verification of one covers the other.
+StatusOr<std::string> PlatformVerificationCacheKey(
+    const sgx::IntelQeQuote &quote) {
+  Sha256Hash sha256;
+  sha256.Update(quote.signature.public_key);
+  sha256.Update(ConvertTrivialObjectToBinaryString(quote.signature.qe_report));
+  sha256.Update(quote.signature.qe_report_signature);
+  sha256.Update(quote.qe_authn_data);
+  sha256.Update(
+      ConvertTrivialObjectToBinaryString(quote.cert_data.qe_cert_data_type));
+  sha256.Update(quote.cert_data.qe_cert_data);
+
+  std::vector<uint8_t> digest;
+  ASYLO_RETURN_IF_ERROR(sha256.CumulativeHash(&digest));
+  return CopyToByteContainer<std::string>(digest);
+}
+
 Status VerifyQeIdentityMatchesExpectation(
     const sgx::IntelQeQuote &quote,
     const IdentityAclPredicate &qe_expectation) {
@@ -312,7 +341,8 @@ SgxIntelEcdsaQeRemoteAssertionVerifier::SgxIntelEcdsaQeRemoteAssertionVerifier()
 
 SgxIntelEcdsaQeRemoteAssertionVerifier::SgxIntelEcdsaQeRemoteAssertionVerifier(
     std::unique_ptr<AdditionalAuthenticatedDataGenerator> aad_generator)
-    : members_(Members(std::move(aad_generator))) {}
+    : members_(Members(std::move(aad_generator))),
+      verification_cache_(VerificationCache()) {}
 
 Status SgxIntelEcdsaQeRemoteAssertionVerifier::Initialize(
     const std::string &serialized_config) {
@@ -346,6 +376,8 @@ Status SgxIntelEcdsaQeRemoteAssertionVerifier::Initialize(
   members_view->qe_identity_expectation = std::move(
       *config.mutable_verifier_info()->mutable_qe_identity_expectation());
   members_view->root_certificates = std::move(root_certificates);
+  members_view->verification_cache_ttl =
+      absl::Seconds(config.verifier_info().verification_cache_ttl_seconds());
   members_view->is_initialized = true;
 
   return Status::OkStatus();
@@ -391,14 +423,34 @@ Status SgxIntelEcdsaQeRemoteAssertionVerifier::Verify(
 
   auto members_view = members_.ReaderLock();
   ASYLO_RETURN_IF_ERROR(VerifyQuoteHeader(quote));
+
+  // The quote signature covers the per-assertion user data and must always be
+  // verified.
   ASYLO_RETURN_IF_ERROR(
       VerifyQuoteBodySignature(*members_view->aad_generator, user_data, quote));
-  ASYLO_RETURN_IF_ERROR(VerifyQeReportDataMatchesQuoteSigningKey(quote));
-  ASYLO_RETURN_IF_ERROR(VerifyPckSignatureOverQuotingEnclave(quote));
-  ASYLO_RETURN_IF_ERROR(
-      VerifyPckCertificateChain(quote, members_view->root_certificates));
-  ASYLO_RETURN_IF_ERROR(VerifyQeIdentityMatchesExpectation(
-      quote, members_view->qe_identity_expectation));
+
+  // The remaining checks only depend on the platform's certification data,
+  // which is stable across assertions from the same platform, so their result
+  // can be cached.
+  std::string cache_key;
+  bool platform_verification_cached = false;
+  if (members_view->verification_cache_ttl > absl::ZeroDuration()) {
+    ASYLO_ASSIGN_OR_RETURN(cache_key, PlatformVerificationCacheKey(quote));
+    platform_verification_cached = IsPlatformVerificationCached(cache_key);
+  }
+
+  if (!platform_verification_cached) {
+    ASYLO_RETURN_IF_ERROR(VerifyQeReportDataMatchesQuoteSigningKey(quote));
+    ASYLO_RETURN_IF_ERROR(VerifyPckSignatureOverQuotingEnclave(quote));
+    ASYLO_RETURN_IF_ERROR(
+        VerifyPckCertificateChain(quote, members_view->root_certificates));
+    ASYLO_RETURN_IF_ERROR(VerifyQeIdentityMatchesExpectation(
+        quote, members_view->qe_identity_expectation));
+    if (!cache_key.empty()) {
+      CachePlatformVerification(cache_key,
+                                members_view->verification_cache_ttl);
+    }
+  }
 
   ASYLO_RETURN_IF_ERROR(ParseEnclaveIdentityFromQuote(
       quote.body, quote.cert_data, peer_identity));
@@ -406,6 +458,43 @@ Status SgxIntelEcdsaQeRemoteAssertionVerifier::Verify(
   return Status::OkStatus();
 }
 
+bool SgxIntelEcdsaQeRemoteAssertionVerifier::IsPlatformVerificationCached(
+    const std::string &cache_key) const {
+  auto cache = verification_cache_.Lock();
+  auto it = cache->verified_platforms.find(cache_key);
+  if (it == cache->verified_platforms.end()) {
+    return false;
+  }
+  if (absl::Now() >= it->second) {
+    cache->verified_platforms.erase(it);
+    return false;
+  }
+  return true;
+}
+
+void SgxIntelEcdsaQeRemoteAssertionVerifier::CachePlatformVerification(
+    const std::string &cache_key, absl::Duration ttl) const {
+  auto cache = verification_cache_.Lock();
+  if (cache->verified_platforms.size() >= kVerificationCacheMaxEntries) {
+    // Drop expired entries; if the cache is still full, drop everything
+    // rather than letting it grow without bound.
+    const absl::Time now = absl::Now();
+    std::vector<std::string> expired_keys;
+    for (const auto &entry : cache->verified_platforms) {
+      if (now >= entry.second) {
+        expired_keys.push_back(entry.first);
+      }
+    }
+    for (const std::string &expired_key : expired_keys) {
+      cache->verified_platforms.erase(expired_key);
+    }
+    if (cache->verified_platforms.size() >= kVerificationCacheMaxEntries) {
+      cache->verified_platforms.clear();
+    }
+  }
+  cache->verified_platforms[cache_key] = absl::Now() + ttl;
+}
+
 Status SgxIntelEcdsaQeRemoteAssertionVerifier::CheckInitialization(
     absl::string_view caller) const {
   return IsInitialized() ? absl::OkStatus()
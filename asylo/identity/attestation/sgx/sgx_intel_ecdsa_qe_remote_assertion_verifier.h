@@ -25,6 +25,8 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/time/time.h"
 #include "asylo/crypto/certificate_interface.h"
 #include "asylo/identity/additional_authenticated_data_generator.h"
 #include "asylo/identity/attestation/enclave_assertion_verifier.h"
@@ -83,11 +85,33 @@ class SgxIntelEcdsaQeRemoteAssertionVerifier : public EnclaveAssertionVerifier {
     std::vector<std::unique_ptr<CertificateInterface>> root_certificates;
     std::unique_ptr<AdditionalAuthenticatedDataGenerator> aad_generator;
     IdentityAclPredicate qe_identity_expectation;
+
+    // How long a successful platform verification stays cached. Caching is
+    // disabled when this is zero.
+    absl::Duration verification_cache_ttl = absl::ZeroDuration();
+  };
+
+  // Tracks platforms whose quote certification data has already been
+  // verified. Keys are hashes of the quote-signing key and its certification
+  // data; values are entry expiration times.
+  struct VerificationCache {
+    absl::flat_hash_map<std::string, absl::Time> verified_platforms;
   };
 
   Status CheckInitialization(absl::string_view caller) const;
 
+  // Returns true if |cache_key| names a platform whose certification data was
+  // verified recently enough to still be fresh. Erases the entry if it has
+  // expired.
+  bool IsPlatformVerificationCached(const std::string &cache_key) const;
+
+  // Records a successful verification of the platform named by |cache_key|.
+  // The cache entry expires |ttl| from now.
+  void CachePlatformVerification(const std::string &cache_key,
+                                 absl::Duration ttl) const;
+
   MutexGuarded<Members> members_;
+  mutable MutexGuarded<VerificationCache> verification_cache_;
 };
 
 }  // namespace asylo
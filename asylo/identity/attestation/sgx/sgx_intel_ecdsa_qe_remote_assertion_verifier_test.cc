@@ -631,5 +631,54 @@ TEST_F(SgxIntelEcdsaQeRemoteAssertionVerifierTest, VerifySuccess) {
             quote.body.isvsvn);
 }
 
+TEST_F(SgxIntelEcdsaQeRemoteAssertionVerifierTest,
+       VerifySucceedsRepeatedlyWithVerificationCacheEnabled) {
+  valid_config_proto_.mutable_verifier_info()
+      ->set_verification_cache_ttl_seconds(600);
+  ASSERT_TRUE(valid_config_proto_.SerializeToString(&valid_config_));
+
+  SgxIntelEcdsaQeRemoteAssertionVerifier verifier;
+  ASYLO_ASSERT_OK(verifier.Initialize(valid_config_));
+
+  Assertion assertion =
+      CreateAssertion(GenerateValidQuote("important data"));
+
+  // The first call verifies the full certification chain and caches the
+  // result; the second is served from the cache. Both must produce the same
+  // peer identity.
+  EnclaveIdentity first_identity;
+  ASYLO_ASSERT_OK(verifier.Verify("important data", assertion,
+                                  &first_identity));
+
+  EnclaveIdentity second_identity;
+  ASYLO_ASSERT_OK(verifier.Verify("important data", assertion,
+                                  &second_identity));
+  EXPECT_THAT(second_identity, EqualsProto(first_identity));
+}
+
+TEST_F(SgxIntelEcdsaQeRemoteAssertionVerifierTest,
+       VerifyAlwaysChecksQuoteSignatureEvenWithCachedPlatform) {
+  valid_config_proto_.mutable_verifier_info()
+      ->set_verification_cache_ttl_seconds(600);
+  ASSERT_TRUE(valid_config_proto_.SerializeToString(&valid_config_));
+
+  SgxIntelEcdsaQeRemoteAssertionVerifier verifier;
+  ASYLO_ASSERT_OK(verifier.Initialize(valid_config_));
+
+  sgx::IntelQeQuote quote = GenerateValidQuote("user data");
+
+  EnclaveIdentity identity;
+  ASYLO_ASSERT_OK(
+      verifier.Verify("user data", CreateAssertion(quote), &identity));
+
+  // Corrupting the quote signature must fail verification even though the
+  // platform's certification data is now cached, since the signature covers
+  // the per-assertion user data.
+  quote.signature.body_signature[0] ^= 0xff;
+  EXPECT_THAT(
+      verifier.Verify("user data", CreateAssertion(quote), &identity),
+      StatusIs(absl::StatusCode::kInternal, HasSubstr("BAD_SIGNATURE")));
+}
+
 }  // namespace
 }  // namespace asylo
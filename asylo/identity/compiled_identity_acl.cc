@@ -0,0 +1,242 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/identity/compiled_identity_acl.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "asylo/util/status.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+namespace {
+
+// String used to separate individual explanations in an accumulation of
+// explanation strings.
+constexpr char kSeparator[] = "\n  ";
+
+}  // namespace
+
+StatusOr<std::unique_ptr<CompiledIdentityAcl>> CompiledIdentityAcl::Compile(
+    const IdentityAclPredicate &acl) {
+  auto compiled_acl = absl::WrapUnique(new CompiledIdentityAcl());
+  ASYLO_RETURN_IF_ERROR(compiled_acl->CompilePredicate(acl).status());
+  return std::move(compiled_acl);
+}
+
+StatusOr<bool> CompiledIdentityAcl::Evaluate(
+    const std::vector<EnclaveIdentity> &identities,
+    const IdentityExpectationMatcher &matcher, std::string *explanation) const {
+  auto result = EvaluateNode(/*index=*/0, identities, matcher, explanation);
+  if (result.ok() && explanation != nullptr && !explanation->empty()) {
+    *explanation =
+        absl::StrCat("ACL failed to match:", kSeparator, *explanation);
+  }
+  return result;
+}
+
+StatusOr<size_t> CompiledIdentityAcl::CompilePredicate(
+    const IdentityAclPredicate &acl) {
+  switch (acl.item_case()) {
+    case IdentityAclPredicate::kExpectation: {
+      Instruction instruction;
+      instruction.op = Instruction::Op::kExpectation;
+      instruction.subtree_size = 1;
+      instruction.operand_count = 0;
+      instruction.expectation = acl.expectation();
+      instructions_.push_back(std::move(instruction));
+      return 1;
+    }
+    case IdentityAclPredicate::kAclGroup: {
+      const IdentityAclGroup &acl_group = acl.acl_group();
+      if (acl_group.predicates().empty()) {
+        return absl::InvalidArgumentError(
+            "ACL predicate groups cannot be empty");
+      }
+
+      Instruction::Op op;
+      switch (acl_group.type()) {
+        case IdentityAclGroup::OR:
+          op = Instruction::Op::kOr;
+          break;
+        case IdentityAclGroup::AND:
+          op = Instruction::Op::kAnd;
+          break;
+        case IdentityAclGroup::NOT:
+          if (acl_group.predicates().size() != 1) {
+            return absl::InvalidArgumentError(
+                "NOT predicate groups must have exactly one element");
+          }
+          op = Instruction::Op::kNot;
+          break;
+        default:
+          return absl::InvalidArgumentError(
+              absl::StrCat("Unknown acl_group type: ", acl_group.type()));
+      }
+
+      const size_t group_index = instructions_.size();
+      Instruction group_instruction;
+      group_instruction.op = op;
+      group_instruction.operand_count = acl_group.predicates().size();
+      instructions_.push_back(std::move(group_instruction));
+
+      // Compile each operand into its own buffer so that operands can be
+      // reordered by cost before being appended to the instruction vector.
+      std::vector<CompiledIdentityAcl> operands;
+      std::vector<size_t> costs;
+      size_t total_cost = 0;
+      for (const IdentityAclPredicate &predicate : acl_group.predicates()) {
+        CompiledIdentityAcl operand;
+        size_t cost;
+        ASYLO_ASSIGN_OR_RETURN(cost, operand.CompilePredicate(predicate));
+        total_cost += cost;
+        operands.push_back(std::move(operand));
+        costs.push_back(cost);
+      }
+
+      // Place cheap operands first so that short-circuiting settles AND and
+      // OR groups with as little matching work as possible. The sort is
+      // stable, so operands of equal cost keep their relative order from the
+      // ACL proto.
+      std::vector<size_t> order(operands.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(),
+                       [&costs](size_t lhs, size_t rhs) {
+                         return costs[lhs] < costs[rhs];
+                       });
+      for (size_t operand_index : order) {
+        std::vector<Instruction> &operand_instructions =
+            operands[operand_index].instructions_;
+        instructions_.insert(
+            instructions_.end(),
+            std::make_move_iterator(operand_instructions.begin()),
+            std::make_move_iterator(operand_instructions.end()));
+      }
+
+      instructions_[group_index].subtree_size =
+          instructions_.size() - group_index;
+      return total_cost;
+    }
+    case IdentityAclPredicate::ITEM_NOT_SET:
+      return absl::InvalidArgumentError(
+          "Invalid ACL predicate: must be either a group or an expectation.");
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("Unknown acl item: ", acl.item_case()));
+  }
+}
+
+StatusOr<bool> CompiledIdentityAcl::EvaluateNode(
+    size_t index, const std::vector<EnclaveIdentity> &identities,
+    const IdentityExpectationMatcher &matcher, std::string *explanation) const {
+  const Instruction &instruction = instructions_[index];
+  switch (instruction.op) {
+    case Instruction::Op::kExpectation: {
+      // The expectation is satisfied if any identity matches it.
+      std::vector<std::string> explanations;
+      for (const EnclaveIdentity &identity : identities) {
+        std::string local_explanation;
+        const StatusOr<bool> result = matcher.MatchAndExplain(
+            identity, instruction.expectation, &local_explanation);
+        if (!result.ok()) {
+          return result;
+        }
+
+        if (result.ValueOrDie()) {
+          return true;
+        }
+
+        if (!local_explanation.empty()) {
+          explanations.push_back(std::move(local_explanation));
+        }
+      }
+      if (explanation != nullptr) {
+        *explanation = absl::StrJoin(explanations, kSeparator);
+      }
+      return false;
+    }
+    case Instruction::Op::kNot: {
+      // Don't pass an explanation parameter to this call because the NOT group
+      // takes the inverse of the result.
+      const StatusOr<bool> result =
+          EvaluateNode(index + 1, identities, matcher, /*explanation=*/nullptr);
+      if (!result.ok()) {
+        return result;
+      }
+
+      if (result.ValueOrDie() && explanation != nullptr) {
+        *explanation =
+            "NOT predicate was satisfied when it should not have been";
+      }
+      return !result.ValueOrDie();
+    }
+    case Instruction::Op::kAnd:
+    case Instruction::Op::kOr: {
+      const bool is_and = instruction.op == Instruction::Op::kAnd;
+      std::vector<std::string> explanations;
+      size_t operand_index = index + 1;
+      for (size_t i = 0; i < instruction.operand_count; ++i) {
+        std::string local_explanation;
+        const StatusOr<bool> result =
+            EvaluateNode(operand_index, identities, matcher,
+                         explanation != nullptr ? &local_explanation : nullptr);
+        if (!result.ok()) {
+          return result;
+        }
+
+        if (result.ValueOrDie() != is_and) {
+          // Short-circuit: an OR group is settled by its first matching
+          // operand, and an AND group by its first non-matching operand.
+          if (is_and) {
+            if (explanation != nullptr) {
+              *explanation = std::move(local_explanation);
+            }
+            return false;
+          }
+          return true;
+        }
+
+        if (!local_explanation.empty()) {
+          explanations.push_back(std::move(local_explanation));
+        }
+        operand_index += instructions_[operand_index].subtree_size;
+      }
+
+      // Every operand of an AND group matched, or no operand of an OR group
+      // matched.
+      if (is_and) {
+        return true;
+      }
+      if (explanation != nullptr) {
+        *explanation = absl::StrJoin(explanations, kSeparator);
+      }
+      return false;
+    }
+  }
+
+  // Unreachable: every instruction is one of the cases above.
+  return absl::InternalError("Invalid compiled ACL instruction");
+}
+
+}  // namespace asylo
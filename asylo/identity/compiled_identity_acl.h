@@ -0,0 +1,115 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_IDENTITY_COMPILED_IDENTITY_ACL_H_
+#define ASYLO_IDENTITY_COMPILED_IDENTITY_ACL_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "asylo/identity/identity.pb.h"
+#include "asylo/identity/identity_acl.pb.h"
+#include "asylo/identity/identity_expectation_matcher.h"
+#include "asylo/util/statusor.h"
+
+namespace asylo {
+
+/// An `IdentityAclPredicate` compiled into a flat instruction vector for
+/// repeated evaluation.
+///
+/// Compiling an ACL validates its structure once, flattens the nested
+/// `IdentityAclGroup` protos into a contiguous vector of instructions, and
+/// orders the operands of each AND and OR group so that cheap operands (those
+/// containing fewer expectations) are evaluated first. Evaluation
+/// short-circuits: an OR group stops at the first operand that matches and an
+/// AND group stops at the first operand that does not. Reordering and
+/// short-circuiting do not change the result of a well-formed ACL, but a
+/// mismatch explanation only describes the operands that were actually
+/// evaluated, and a matcher error in an operand that was skipped due to
+/// short-circuiting is not reported. Callers that need the exhaustive
+/// explanations of `EvaluateIdentityAcl()` should continue to use it.
+///
+/// Compile an ACL once, at configuration load, and reuse the resulting
+/// evaluator for every authorization check. This class is thread-safe; a
+/// compiled ACL is immutable.
+class CompiledIdentityAcl {
+ public:
+  /// Compiles `acl` into an evaluator.
+  ///
+  /// \param acl An ACL specifying expectations on an identity. The
+  ///        structural constraints are those documented for
+  ///        `EvaluateIdentityAcl()`.
+  /// \return A compiled evaluator, or a non-OK Status if `acl` is malformed.
+  static StatusOr<std::unique_ptr<CompiledIdentityAcl>> Compile(
+      const IdentityAclPredicate &acl);
+
+  /// Uses `matcher` to evaluate whether `identities` satisfies this ACL.
+  ///
+  /// \param identities A list of identities to match against the ACL.
+  /// \param matcher The matcher to use to evaluate `identities`.
+  /// \param[out] explanation An explanation of why the match failed, if the
+  ///             result is false.
+  /// \return A bool indicating whether the ACL evaluated to true, or a non-OK
+  ///         Status if `matcher.MatchAndExplain()` returned a non-OK status
+  ///         for an evaluated expectation.
+  StatusOr<bool> Evaluate(const std::vector<EnclaveIdentity> &identities,
+                          const IdentityExpectationMatcher &matcher,
+                          std::string *explanation = nullptr) const;
+
+ private:
+  // A node of the flattened ACL. Nodes are stored in pre-order: the operands
+  // of a group node immediately follow it, and |subtree_size| gives the total
+  // number of nodes in the subtree rooted at a node so that evaluation can
+  // skip an operand's subtree without recursing through it.
+  struct Instruction {
+    enum class Op { kExpectation, kAnd, kOr, kNot };
+
+    Op op;
+
+    // The number of nodes in the subtree rooted at this node, including the
+    // node itself.
+    size_t subtree_size;
+
+    // The number of direct operands of a group node. Zero for kExpectation.
+    size_t operand_count;
+
+    // The expectation matched by a kExpectation node. Unused for group nodes.
+    EnclaveIdentityExpectation expectation;
+  };
+
+  CompiledIdentityAcl() = default;
+
+  // Validates the subtree of |acl| and appends its instructions to
+  // |instructions_| in pre-order. On success, returns the number of
+  // expectations in the subtree, which is used to order sibling operands.
+  StatusOr<size_t> CompilePredicate(const IdentityAclPredicate &acl);
+
+  // Evaluates the subtree rooted at |index| against |identities|.
+  StatusOr<bool> EvaluateNode(size_t index,
+                              const std::vector<EnclaveIdentity> &identities,
+                              const IdentityExpectationMatcher &matcher,
+                              std::string *explanation) const;
+
+  std::vector<Instruction> instructions_;
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_IDENTITY_COMPILED_IDENTITY_ACL_H_
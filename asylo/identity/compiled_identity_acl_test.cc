@@ -0,0 +1,187 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/identity/compiled_identity_acl.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "asylo/identity/identity.pb.h"
+#include "asylo/identity/identity_acl.pb.h"
+#include "asylo/identity/identity_acl_evaluator.h"
+#include "asylo/identity/identity_expectation_matcher.h"
+#include "asylo/test/util/status_matchers.h"
+
+namespace asylo {
+namespace {
+
+using ::testing::HasSubstr;
+
+constexpr char kMatchingIdentity[] = "matching identity";
+constexpr char kNonMatchingIdentity[] = "non-matching identity";
+constexpr char kMismatchExplanation[] = "identity does not match";
+
+// A matcher that compares the identity bytes against the reference identity
+// bytes in the expectation.
+class ByteEqualityMatcher final : public IdentityExpectationMatcher {
+ public:
+  StatusOr<bool> MatchAndExplain(const EnclaveIdentity &identity,
+                                 const EnclaveIdentityExpectation &expectation,
+                                 std::string *explanation) const override {
+    if (identity.identity() == expectation.reference_identity().identity()) {
+      return true;
+    }
+    if (explanation != nullptr) {
+      *explanation = kMismatchExplanation;
+    }
+    return false;
+  }
+};
+
+// Returns a predicate whose expectation matches an identity with bytes
+// |identity|.
+IdentityAclPredicate MakeExpectationPredicate(const std::string &identity) {
+  IdentityAclPredicate predicate;
+  predicate.mutable_expectation()
+      ->mutable_reference_identity()
+      ->set_identity(identity);
+  return predicate;
+}
+
+// Returns a single identity with bytes |identity|.
+std::vector<EnclaveIdentity> MakeIdentities(const std::string &identity) {
+  EnclaveIdentity enclave_identity;
+  enclave_identity.set_identity(identity);
+  return {enclave_identity};
+}
+
+// Verify that compilation fails on the same malformed ACLs that
+// EvaluateIdentityAcl() rejects.
+TEST(CompiledIdentityAclTest, CompileRejectsMalformedAcls) {
+  IdentityAclPredicate empty_predicate;
+  EXPECT_THAT(CompiledIdentityAcl::Compile(empty_predicate),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  IdentityAclPredicate empty_group;
+  empty_group.mutable_acl_group();
+  EXPECT_THAT(CompiledIdentityAcl::Compile(empty_group),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  IdentityAclPredicate bad_not_group;
+  IdentityAclGroup *group = bad_not_group.mutable_acl_group();
+  group->set_type(IdentityAclGroup::NOT);
+  *group->add_predicates() = MakeExpectationPredicate(kMatchingIdentity);
+  *group->add_predicates() = MakeExpectationPredicate(kNonMatchingIdentity);
+  EXPECT_THAT(CompiledIdentityAcl::Compile(bad_not_group),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+// Verify that a compiled single-expectation ACL evaluates like the
+// interpreter and explains mismatches.
+TEST(CompiledIdentityAclTest, EvaluatesSingleExpectation) {
+  std::unique_ptr<CompiledIdentityAcl> acl;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      acl, CompiledIdentityAcl::Compile(
+               MakeExpectationPredicate(kMatchingIdentity)));
+
+  ByteEqualityMatcher matcher;
+  EXPECT_THAT(acl->Evaluate(MakeIdentities(kMatchingIdentity), matcher),
+              IsOkAndHolds(true));
+
+  std::string explanation;
+  EXPECT_THAT(acl->Evaluate(MakeIdentities(kNonMatchingIdentity), matcher,
+                            &explanation),
+              IsOkAndHolds(false));
+  EXPECT_THAT(explanation, HasSubstr(kMismatchExplanation));
+}
+
+// Verify that a compiled ACL with nested AND, OR, and NOT groups produces the
+// same result as EvaluateIdentityAcl() for matching and non-matching
+// identities.
+TEST(CompiledIdentityAclTest, MatchesInterpreterOnNestedGroups) {
+  // (matching AND (NOT non-matching)) OR non-matching
+  IdentityAclPredicate acl;
+  IdentityAclGroup *or_group = acl.mutable_acl_group();
+  or_group->set_type(IdentityAclGroup::OR);
+
+  IdentityAclGroup *and_group =
+      or_group->add_predicates()->mutable_acl_group();
+  and_group->set_type(IdentityAclGroup::AND);
+  *and_group->add_predicates() = MakeExpectationPredicate(kMatchingIdentity);
+  IdentityAclGroup *not_group =
+      and_group->add_predicates()->mutable_acl_group();
+  not_group->set_type(IdentityAclGroup::NOT);
+  *not_group->add_predicates() =
+      MakeExpectationPredicate(kNonMatchingIdentity);
+
+  *or_group->add_predicates() =
+      MakeExpectationPredicate(kNonMatchingIdentity);
+
+  std::unique_ptr<CompiledIdentityAcl> compiled_acl;
+  ASYLO_ASSERT_OK_AND_ASSIGN(compiled_acl, CompiledIdentityAcl::Compile(acl));
+
+  ByteEqualityMatcher matcher;
+  for (const std::string &identity :
+       {std::string(kMatchingIdentity), std::string(kNonMatchingIdentity)}) {
+    std::vector<EnclaveIdentity> identities = MakeIdentities(identity);
+
+    StatusOr<bool> interpreted_result =
+        EvaluateIdentityAcl(identities, acl, matcher);
+    ASYLO_ASSERT_OK(interpreted_result.status());
+
+    EXPECT_THAT(compiled_acl->Evaluate(identities, matcher),
+                IsOkAndHolds(interpreted_result.ValueOrDie()));
+  }
+}
+
+// Verify that operand reordering does not change the result of an AND group
+// whose expensive operand fails and whose cheap operand succeeds, and vice
+// versa.
+TEST(CompiledIdentityAclTest, ShortCircuitsReorderedOperands) {
+  // The first operand is an expensive group, the second a cheap expectation
+  // that does not match. The compiled ACL evaluates the cheap operand first.
+  IdentityAclPredicate acl;
+  IdentityAclGroup *and_group = acl.mutable_acl_group();
+  and_group->set_type(IdentityAclGroup::AND);
+
+  IdentityAclGroup *nested_or =
+      and_group->add_predicates()->mutable_acl_group();
+  nested_or->set_type(IdentityAclGroup::OR);
+  *nested_or->add_predicates() = MakeExpectationPredicate(kMatchingIdentity);
+  *nested_or->add_predicates() = MakeExpectationPredicate(kMatchingIdentity);
+
+  *and_group->add_predicates() =
+      MakeExpectationPredicate(kNonMatchingIdentity);
+
+  std::unique_ptr<CompiledIdentityAcl> compiled_acl;
+  ASYLO_ASSERT_OK_AND_ASSIGN(compiled_acl, CompiledIdentityAcl::Compile(acl));
+
+  ByteEqualityMatcher matcher;
+  std::string explanation;
+  EXPECT_THAT(compiled_acl->Evaluate(MakeIdentities(kMatchingIdentity),
+                                     matcher, &explanation),
+              IsOkAndHolds(false));
+  EXPECT_THAT(explanation, HasSubstr(kMismatchExplanation));
+}
+
+}  // namespace
+}  // namespace asylo
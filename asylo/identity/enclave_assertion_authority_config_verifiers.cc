@@ -91,6 +91,10 @@ Status VerifySgxIntelEcdsaQeRemoteAssertionAuthorityConfig(
           "Verifier configuration must contain at least one trusted "
           "root certificate");
     }
+    if (config.verifier_info().verification_cache_ttl_seconds() < 0) {
+      return absl::InvalidArgumentError(
+          "Verification cache TTL must not be negative");
+    }
     if (!config.verifier_info().has_qe_identity_expectation()) {
       return absl::InvalidArgumentError(
           "Verifier configuration is missing QE identity expectation");
@@ -118,6 +118,24 @@ TEST(EnclaveAssertionAuthorityConfigVerifiersTest,
                        HasSubstr("root certificate")));
 }
 
+TEST(EnclaveAssertionAuthorityConfigVerifiersTest,
+     VerifySgxIntelEcdsaQeRemoteAssertionVerifierConfigNegativeCacheTtl) {
+  SgxIntelEcdsaQeRemoteAssertionAuthorityConfig config =
+      ParseTextProtoOrDie(R"pb(
+        verifier_info: {
+          qe_identity_expectation: {}
+          root_certificates:
+          [ { format: X509_PEM data: "" }]
+          verification_cache_ttl_seconds: -1
+        })pb");
+  config.mutable_verifier_info()->mutable_root_certificates(0)->set_data(
+      {sgx::kFakeSgxRootCa.certificate_pem.begin(),
+       sgx::kFakeSgxRootCa.certificate_pem.end()});
+  EXPECT_THAT(VerifySgxIntelEcdsaQeRemoteAssertionAuthorityConfig(config),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("cache TTL")));
+}
+
 TEST(EnclaveAssertionAuthorityConfigVerifiersTest,
      VerifySgxIntelEcdsaQeRemoteAssertionVerifierConfigNoQeExpectation) {
   SgxIntelEcdsaQeRemoteAssertionAuthorityConfig config =
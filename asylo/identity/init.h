@@ -19,7 +19,10 @@
 #ifndef ASYLO_IDENTITY_INIT_H_
 #define ASYLO_IDENTITY_INIT_H_
 
+#include <atomic>
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "asylo/util/logging.h"
@@ -29,6 +32,7 @@
 #include "asylo/identity/enclave_assertion_authority_config.pb.h"
 #include "asylo/identity/init_internal.h"
 #include "asylo/util/status.h"
+#include "asylo/util/thread.h"
 
 namespace asylo {
 
@@ -79,47 +83,65 @@ Status InitializeEnclaveAssertionGenerator(
 //
 // Note that if this method has already been called successfully, future calls
 // will have no effect.
+//
+// Authorities may be initialized concurrently on separate threads, so the
+// referenced configs must remain valid until this function returns.
 template <class ConfigIteratorT>
 Status InitializeEnclaveAssertionAuthorities(ConfigIteratorT configs_begin,
                                              ConfigIteratorT configs_end) {
-  bool ok = true;
+  std::atomic<bool> ok(true);
 
-  // Initialize assertion authorities with provided configs.
-  for (auto it = configs_begin; it != configs_end; ++it) {
-    const EnclaveAssertionAuthorityConfig &config = *it;
+  // Initializes the assertion generator and verifier matching one config.
+  auto initialize_authorities =
+      [&ok](const EnclaveAssertionAuthorityConfig &config) {
+        const AssertionDescription &description = config.description();
+        StatusOr<std::string> authority_id_result =
+            EnclaveAssertionAuthority::GenerateAuthorityId(
+                description.identity_type(), description.authority_type());
+        if (!authority_id_result.ok()) {
+          ok = false;
+          LOG(ERROR) << authority_id_result.status();
+          return;
+        }
 
-    const AssertionDescription &description = config.description();
-    StatusOr<std::string> authority_id_result =
-        EnclaveAssertionAuthority::GenerateAuthorityId(
-            description.identity_type(), description.authority_type());
-    if (!authority_id_result.ok()) {
-      ok = false;
-      LOG(ERROR) << authority_id_result.status();
-      continue;
-    }
+        std::string authority_id = authority_id_result.ValueOrDie();
 
-    std::string authority_id = authority_id_result.ValueOrDie();
+        auto generator_it = AssertionGeneratorMap::GetValue(authority_id);
+        if (generator_it != AssertionGeneratorMap::value_end()) {
+          if (!internal::TryInitialize(config.config(), generator_it).ok()) {
+            ok = false;
+          }
+        } else {
+          ok = false;
+          LOG(WARNING) << "Config for " << description.ShortDebugString()
+                       << " does not match any known assertion generator";
+        }
 
-    auto generator_it = AssertionGeneratorMap::GetValue(authority_id);
-    if (generator_it != AssertionGeneratorMap::value_end()) {
-      if (!internal::TryInitialize(config.config(), generator_it).ok()) {
-        ok = false;
-      }
-    } else {
-      ok = false;
-      LOG(WARNING) << "Config for " << description.ShortDebugString()
-                   << " does not match any known assertion generator";
-    }
+        auto verifier_it = AssertionVerifierMap::GetValue(authority_id);
+        if (verifier_it != AssertionVerifierMap::value_end()) {
+          if (!internal::TryInitialize(config.config(), verifier_it).ok()) {
+            ok = false;
+          }
+        } else {
+          ok = false;
+          LOG(WARNING) << "Config for " << description.ShortDebugString()
+                       << " does not match any known assertion verifier";
+        }
+      };
 
-    auto verifier_it = AssertionVerifierMap::GetValue(authority_id);
-    if (verifier_it != AssertionVerifierMap::value_end()) {
-      if (!internal::TryInitialize(config.config(), verifier_it).ok()) {
-        ok = false;
-      }
-    } else {
-      ok = false;
-      LOG(WARNING) << "Config for " << description.ShortDebugString()
-                   << " does not match any known assertion verifier";
+  // Initializing an authority can do real work (certificate parsing, key
+  // generation), so authorities are initialized concurrently, one thread per
+  // config beyond the first. The first config runs on the calling thread,
+  // which keeps the common single-config case single-threaded.
+  if (configs_begin != configs_end) {
+    std::vector<Thread> threads;
+    auto rest = configs_begin;
+    for (++rest; rest != configs_end; ++rest) {
+      threads.emplace_back(initialize_authorities, std::cref(*rest));
+    }
+    initialize_authorities(*configs_begin);
+    for (Thread &thread : threads) {
+      thread.Join();
     }
   }
 
@@ -257,6 +257,99 @@ bool IsIdentityCompatibleWithMatchSpec(const SgxIdentity &identity,
 
 }  // namespace
 
+StatusOr<CompiledSgxIdentityExpectation> CompiledSgxIdentityExpectation::Create(
+    const SgxIdentityExpectation &expectation) {
+  if (!IsValidExpectation(expectation)) {
+    return Status(::absl::StatusCode::kInvalidArgument,
+                  "Expectation parameter is invalid");
+  }
+
+  const CodeIdentity &expected =
+      expectation.reference_identity().code_identity();
+  const CodeIdentityMatchSpec &spec =
+      expectation.match_spec().code_identity_match_spec();
+  const MachineConfiguration &expected_config =
+      expectation.reference_identity().machine_configuration();
+  const MachineConfigurationMatchSpec &machine_config_match_spec =
+      expectation.match_spec().machine_configuration_match_spec();
+
+  CompiledSgxIdentityExpectation compiled;
+  compiled.mrenclave_match_required_ = spec.is_mrenclave_match_required();
+  compiled.mrsigner_match_required_ = spec.is_mrsigner_match_required();
+  compiled.expected_mrenclave_hash_ = expected.mrenclave().hash();
+  compiled.expected_mrsigner_hash_ =
+      expected.signer_assigned_identity().mrsigner().hash();
+  compiled.expected_isvprodid_ = expected.signer_assigned_identity().isvprodid();
+  compiled.expected_isvsvn_ = expected.signer_assigned_identity().isvsvn();
+  compiled.miscselect_match_mask_ = spec.miscselect_match_mask();
+  compiled.expected_miscselect_masked_ =
+      spec.miscselect_match_mask() & expected.miscselect();
+  compiled.attributes_match_mask_ =
+      SecsAttributeSet(spec.attributes_match_mask());
+  compiled.expected_attributes_masked_ =
+      compiled.attributes_match_mask_ & SecsAttributeSet(expected.attributes());
+  compiled.cpu_svn_match_required_ =
+      machine_config_match_spec.is_cpu_svn_match_required();
+  compiled.sgx_type_match_required_ =
+      machine_config_match_spec.is_sgx_type_match_required();
+  compiled.expected_cpu_svn_ = expected_config.cpu_svn().value();
+  compiled.expected_sgx_type_ = expected_config.sgx_type();
+  return compiled;
+}
+
+StatusOr<bool> CompiledSgxIdentityExpectation::Match(
+    const SgxIdentity &identity) const {
+  if (!IsValidSgxIdentity(identity)) {
+    return Status(::absl::StatusCode::kInvalidArgument,
+                  "Identity parameter is invalid");
+  }
+
+  const CodeIdentity &code_identity = identity.code_identity();
+  const SignerAssignedIdentity &signer_identity =
+      code_identity.signer_assigned_identity();
+  const MachineConfiguration &machine_config = identity.machine_configuration();
+
+  if ((mrenclave_match_required_ && !code_identity.has_mrenclave()) ||
+      (mrsigner_match_required_ && !signer_identity.has_mrsigner()) ||
+      (cpu_svn_match_required_ && !machine_config.has_cpu_svn()) ||
+      (sgx_type_match_required_ && !machine_config.has_sgx_type())) {
+    return Status(::absl::StatusCode::kInvalidArgument,
+                  "Identity is not compatible with specified match spec");
+  }
+
+  if (cpu_svn_match_required_ &&
+      machine_config.cpu_svn().value() != expected_cpu_svn_) {
+    return false;
+  }
+  if (sgx_type_match_required_ &&
+      machine_config.sgx_type() != expected_sgx_type_) {
+    return false;
+  }
+  if (mrenclave_match_required_ &&
+      code_identity.mrenclave().hash() != expected_mrenclave_hash_) {
+    return false;
+  }
+  if (mrsigner_match_required_ &&
+      signer_identity.mrsigner().hash() != expected_mrsigner_hash_) {
+    return false;
+  }
+  if (signer_identity.isvprodid() != expected_isvprodid_) {
+    return false;
+  }
+  if (signer_identity.isvsvn() < expected_isvsvn_) {
+    return false;
+  }
+  if ((code_identity.miscselect() & miscselect_match_mask_) !=
+      expected_miscselect_masked_) {
+    return false;
+  }
+  if ((SecsAttributeSet(code_identity.attributes()) & attributes_match_mask_) !=
+      expected_attributes_masked_) {
+    return false;
+  }
+  return true;
+}
+
 StatusOr<bool> MatchIdentityToExpectation(
     const SgxIdentity &identity, const SgxIdentityExpectation &expectation,
     std::string *explanation) {
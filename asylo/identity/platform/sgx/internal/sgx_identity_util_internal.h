@@ -19,12 +19,15 @@
 #ifndef ASYLO_IDENTITY_PLATFORM_SGX_INTERNAL_SGX_IDENTITY_UTIL_INTERNAL_H_
 #define ASYLO_IDENTITY_PLATFORM_SGX_INTERNAL_SGX_IDENTITY_UTIL_INTERNAL_H_
 
+#include <cstdint>
 #include <string>
 
 #include "asylo/identity/identity.pb.h"
 #include "asylo/identity/platform/sgx/code_identity.pb.h"
 #include "asylo/identity/platform/sgx/internal/code_identity_constants.h"
 #include "asylo/identity/platform/sgx/internal/identity_key_management_structs.h"
+#include "asylo/identity/platform/sgx/internal/secs_attributes.h"
+#include "asylo/identity/platform/sgx/machine_configuration.pb.h"
 #include "asylo/identity/platform/sgx/sgx_identity.pb.h"
 #include "asylo/util/status.h"
 #include "asylo/util/statusor.h"
@@ -39,6 +42,49 @@ StatusOr<bool> MatchIdentityToExpectation(
     const SgxIdentity &identity, const SgxIdentityExpectation &expectation,
     std::string *explanation);
 
+// A compiled form of an SgxIdentityExpectation. Create() validates the
+// expectation once and extracts the comparison inputs into flat values, so
+// that Match() reduces to a handful of masked integer and byte compares
+// instead of re-validating and re-walking the expectation protos on every
+// comparison.
+//
+// Match() returns the same verdict as MatchIdentityToExpectation() with a
+// null explanation. Callers that need an explanation of a mismatch should
+// fall back to MatchIdentityToExpectation().
+class CompiledSgxIdentityExpectation {
+ public:
+  // Compiles |expectation|. Returns an INVALID_ARGUMENT error if
+  // |expectation| is invalid.
+  static StatusOr<CompiledSgxIdentityExpectation> Create(
+      const SgxIdentityExpectation &expectation);
+
+  // Matches |identity| against the compiled expectation. Returns an
+  // INVALID_ARGUMENT error if |identity| is invalid or is incompatible with
+  // the compiled match spec.
+  StatusOr<bool> Match(const SgxIdentity &identity) const;
+
+ private:
+  CompiledSgxIdentityExpectation() = default;
+
+  // Compiled CodeIdentity comparison inputs.
+  bool mrenclave_match_required_ = false;
+  bool mrsigner_match_required_ = false;
+  std::string expected_mrenclave_hash_;
+  std::string expected_mrsigner_hash_;
+  uint32_t expected_isvprodid_ = 0;
+  uint32_t expected_isvsvn_ = 0;
+  uint32_t miscselect_match_mask_ = 0;
+  uint32_t expected_miscselect_masked_ = 0;
+  SecsAttributeSet attributes_match_mask_ = {0, 0};
+  SecsAttributeSet expected_attributes_masked_ = {0, 0};
+
+  // Compiled MachineConfiguration comparison inputs.
+  bool cpu_svn_match_required_ = false;
+  bool sgx_type_match_required_ = false;
+  std::string expected_cpu_svn_;
+  SgxType expected_sgx_type_ = SGX_TYPE_UNKNOWN;
+};
+
 // Sets |expectation| based on |identity| and |match_spec|, checking the
 // validity of both components.
 Status SetExpectation(const SgxIdentityMatchSpec &match_spec,
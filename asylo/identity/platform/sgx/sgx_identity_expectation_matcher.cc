@@ -18,12 +18,25 @@
 
 #include "asylo/identity/platform/sgx/sgx_identity_expectation_matcher.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
 #include "asylo/identity/descriptions.h"
 #include "asylo/identity/platform/sgx/internal/sgx_identity_util_internal.h"
 #include "asylo/identity/platform/sgx/sgx_identity.pb.h"
 #include "asylo/util/status_macros.h"
 
 namespace asylo {
+namespace {
+
+// Maximum number of compiled expectations retained by the matcher. Peers
+// present a small, stable set of expectations, so a handful of entries is
+// enough.
+constexpr size_t kCompiledExpectationCacheMaxEntries = 16;
+
+}  // namespace
 
 StatusOr<bool> SgxIdentityExpectationMatcher::MatchAndExplain(
     const EnclaveIdentity &identity,
@@ -34,14 +47,60 @@ StatusOr<bool> SgxIdentityExpectationMatcher::MatchAndExplain(
   SgxIdentity sgx_identity;
   ASYLO_RETURN_IF_ERROR(sgx::ParseSgxIdentity(identity, &sgx_identity));
 
-  // If this call fails, then |expectation|.reference_identity() either does not
-  // have the correct description, or is malformed.
+  std::shared_ptr<const sgx::CompiledSgxIdentityExpectation> compiled;
+  ASYLO_ASSIGN_OR_RETURN(compiled, GetCompiledExpectation(expectation));
+
+  bool match_result;
+  ASYLO_ASSIGN_OR_RETURN(match_result, compiled->Match(sgx_identity));
+  if (!match_result && explanation != nullptr) {
+    // The compiled fast path only produces a verdict. Rerun the full match to
+    // explain the mismatch; mismatches are the rare case on this path.
+    SgxIdentityExpectation sgx_identity_expectation;
+    ASYLO_RETURN_IF_ERROR(
+        sgx::ParseSgxExpectation(expectation, &sgx_identity_expectation));
+    return sgx::MatchIdentityToExpectation(
+        sgx_identity, sgx_identity_expectation, explanation);
+  }
+
+  if (explanation != nullptr) {
+    explanation->clear();
+  }
+  return match_result;
+}
+
+StatusOr<std::shared_ptr<const sgx::CompiledSgxIdentityExpectation>>
+SgxIdentityExpectationMatcher::GetCompiledExpectation(
+    const EnclaveIdentityExpectation &expectation) const {
+  std::string cache_key = expectation.SerializeAsString();
+  {
+    absl::MutexLock lock(&compiled_expectation_cache_mu_);
+    auto it = compiled_expectation_cache_.find(cache_key);
+    if (it != compiled_expectation_cache_.end()) {
+      return it->second;
+    }
+  }
+
+  // If this call fails, then |expectation|.reference_identity() either does
+  // not have the correct description, or is malformed.
   SgxIdentityExpectation sgx_identity_expectation;
   ASYLO_RETURN_IF_ERROR(
       sgx::ParseSgxExpectation(expectation, &sgx_identity_expectation));
 
-  return sgx::MatchIdentityToExpectation(sgx_identity, sgx_identity_expectation,
-                                         explanation);
+  StatusOr<sgx::CompiledSgxIdentityExpectation> compiled_result =
+      sgx::CompiledSgxIdentityExpectation::Create(sgx_identity_expectation);
+  if (!compiled_result.ok()) {
+    return compiled_result.status();
+  }
+  auto compiled = std::make_shared<const sgx::CompiledSgxIdentityExpectation>(
+      std::move(compiled_result).ValueOrDie());
+
+  absl::MutexLock lock(&compiled_expectation_cache_mu_);
+  if (compiled_expectation_cache_.size() >=
+      kCompiledExpectationCacheMaxEntries) {
+    compiled_expectation_cache_.clear();
+  }
+  compiled_expectation_cache_.emplace(std::move(cache_key), compiled);
+  return compiled;
 }
 
 EnclaveIdentityDescription SgxIdentityExpectationMatcher::Description() const {
@@ -19,10 +19,14 @@
 #ifndef ASYLO_IDENTITY_PLATFORM_SGX_SGX_IDENTITY_EXPECTATION_MATCHER_H_
 #define ASYLO_IDENTITY_PLATFORM_SGX_SGX_IDENTITY_EXPECTATION_MATCHER_H_
 
+#include <memory>
 #include <string>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "asylo/identity/identity.pb.h"
 #include "asylo/identity/named_identity_expectation_matcher.h"
+#include "asylo/identity/platform/sgx/internal/sgx_identity_util_internal.h"
 #include "asylo/util/statusor.h"
 
 namespace asylo {
@@ -52,6 +56,23 @@ class SgxIdentityExpectationMatcher final
   /// \return A description of the enclave identities/enclave identity
   ///         expectations this matcher is able to match.
   EnclaveIdentityDescription Description() const override;
+
+ private:
+  // Returns the compiled form of |expectation|, reusing a previously compiled
+  // form when the same expectation was seen before. Matching the same peer
+  // expectation on every RPC then costs a cache lookup plus a handful of
+  // masked compares instead of a full parse and validation.
+  StatusOr<std::shared_ptr<const sgx::CompiledSgxIdentityExpectation>>
+  GetCompiledExpectation(const EnclaveIdentityExpectation &expectation) const;
+
+  // Guards compiled_expectation_cache_.
+  mutable absl::Mutex compiled_expectation_cache_mu_;
+
+  // Maps serialized expectations to their compiled forms.
+  mutable absl::flat_hash_map<
+      std::string, std::shared_ptr<const sgx::CompiledSgxIdentityExpectation>>
+      compiled_expectation_cache_
+          ABSL_GUARDED_BY(compiled_expectation_cache_mu_);
 };
 
 }  // namespace asylo
@@ -0,0 +1,371 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/identity/provisioning/sgx/internal/caching_sgx_pcs_client.h"
+
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "asylo/crypto/sha256_hash.h"
+#include "asylo/identity/provisioning/sgx/internal/platform_provisioning.h"
+#include "asylo/util/logging.h"
+#include "asylo/util/path.h"
+#include "asylo/util/posix_errors.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+namespace sgx {
+
+StatusOr<std::unique_ptr<SgxPcsClient>> CachingSgxPcsClient::Create(
+    std::unique_ptr<SgxPcsClient> delegate, Options options) {
+  if (delegate == nullptr) {
+    return absl::InvalidArgumentError("Delegate client must not be nullptr");
+  }
+  if (options.cache_dir.empty()) {
+    return absl::InvalidArgumentError("Options must specify a cache directory");
+  }
+  if (mkdir(options.cache_dir.c_str(), /*mode=*/0700) != 0 &&
+      errno != EEXIST) {
+    return LastPosixError(
+        absl::StrCat("Failed to create cache directory ", options.cache_dir));
+  }
+  // Using `new` to access a non-public constructor.
+  return absl::WrapUnique<SgxPcsClient>(
+      new CachingSgxPcsClient(std::move(delegate), std::move(options)));
+}
+
+CachingSgxPcsClient::CachingSgxPcsClient(std::unique_ptr<SgxPcsClient> delegate,
+                                         Options options)
+    : delegate_(std::move(delegate)), options_(std::move(options)) {}
+
+CachingSgxPcsClient::~CachingSgxPcsClient() {
+  std::vector<Thread> threads;
+  {
+    absl::MutexLock lock(&mu_);
+    threads = std::move(refresh_threads_);
+  }
+  for (Thread &thread : threads) {
+    thread.Join();
+  }
+}
+
+StatusOr<GetPckCertificateResult> CachingSgxPcsClient::GetPckCertificate(
+    const Ppid &ppid, const CpuSvn &cpu_svn, const PceSvn &pce_svn,
+    const PceId &pce_id) {
+  ASYLO_RETURN_IF_ERROR(ValidatePpid(ppid));
+  ASYLO_RETURN_IF_ERROR(ValidateCpuSvn(cpu_svn));
+  ASYLO_RETURN_IF_ERROR(ValidatePceSvn(pce_svn));
+  ASYLO_RETURN_IF_ERROR(ValidatePceId(pce_id));
+
+  const std::string key = absl::StrCat(
+      "pck_cert_", absl::BytesToHexString(ppid.value()), "_",
+      absl::BytesToHexString(cpu_svn.value()), "_", pce_svn.value(), "_",
+      pce_id.value());
+  StatusOr<SgxPcsClientCacheEntry> entry_result = ReadEntry(key);
+  if (entry_result.ok()) {
+    const SgxPcsClientCacheEntry &entry = entry_result.ValueOrDie();
+    if (entry.has_pck_certificate_result() && IsFresh(entry)) {
+      if (NeedsRefresh(entry)) {
+        MaybeScheduleRefresh(key, [this, key, ppid, cpu_svn, pce_svn, pce_id] {
+          Status status =
+              FetchAndStorePckCertificate(key, ppid, cpu_svn, pce_svn, pce_id)
+                  .status();
+          if (!status.ok()) {
+            LOG(WARNING) << "Background refresh of PCK certificate failed: "
+                         << status;
+          }
+        });
+      }
+      GetPckCertificateResult result;
+      result.pck_cert = entry.pck_certificate_result().pck_cert();
+      result.issuer_cert_chain =
+          entry.pck_certificate_result().issuer_cert_chain();
+      result.tcbm = entry.pck_certificate_result().tcbm();
+      return result;
+    }
+  }
+  return FetchAndStorePckCertificate(key, ppid, cpu_svn, pce_svn, pce_id);
+}
+
+StatusOr<GetPckCertificatesResult> CachingSgxPcsClient::GetPckCertificates(
+    const Ppid &ppid, const PceId &pce_id) {
+  ASYLO_RETURN_IF_ERROR(ValidatePpid(ppid));
+  ASYLO_RETURN_IF_ERROR(ValidatePceId(pce_id));
+
+  const std::string key =
+      absl::StrCat("pck_certs_", absl::BytesToHexString(ppid.value()), "_",
+                   pce_id.value());
+  StatusOr<SgxPcsClientCacheEntry> entry_result = ReadEntry(key);
+  if (entry_result.ok()) {
+    const SgxPcsClientCacheEntry &entry = entry_result.ValueOrDie();
+    if (entry.has_pck_certificates_result() && IsFresh(entry)) {
+      if (NeedsRefresh(entry)) {
+        MaybeScheduleRefresh(key, [this, key, ppid, pce_id] {
+          Status status =
+              FetchAndStorePckCertificates(key, ppid, pce_id).status();
+          if (!status.ok()) {
+            LOG(WARNING) << "Background refresh of PCK certificates failed: "
+                         << status;
+          }
+        });
+      }
+      GetPckCertificatesResult result;
+      result.pck_certs = entry.pck_certificates_result().pck_certs();
+      result.issuer_cert_chain =
+          entry.pck_certificates_result().issuer_cert_chain();
+      return result;
+    }
+  }
+  return FetchAndStorePckCertificates(key, ppid, pce_id);
+}
+
+StatusOr<GetCrlResult> CachingSgxPcsClient::GetCrl(SgxCaType sgx_ca_type) {
+  if (sgx_ca_type == SGX_CA_TYPE_UNKNOWN) {
+    return absl::InvalidArgumentError("Input CA type cannot be unknown");
+  }
+
+  const std::string key = absl::StrCat("crl_", SgxCaType_Name(sgx_ca_type));
+  StatusOr<SgxPcsClientCacheEntry> entry_result = ReadEntry(key);
+  if (entry_result.ok()) {
+    const SgxPcsClientCacheEntry &entry = entry_result.ValueOrDie();
+    if (entry.has_crl_result() && IsFresh(entry)) {
+      if (NeedsRefresh(entry)) {
+        MaybeScheduleRefresh(key, [this, key, sgx_ca_type] {
+          Status status = FetchAndStoreCrl(key, sgx_ca_type).status();
+          if (!status.ok()) {
+            LOG(WARNING) << "Background refresh of PCK CRL failed: " << status;
+          }
+        });
+      }
+      GetCrlResult result;
+      result.pck_crl = entry.crl_result().pck_crl();
+      result.issuer_cert_chain = entry.crl_result().issuer_cert_chain();
+      return result;
+    }
+  }
+  return FetchAndStoreCrl(key, sgx_ca_type);
+}
+
+StatusOr<GetTcbInfoResult> CachingSgxPcsClient::GetTcbInfo(const Fmspc &fmspc) {
+  ASYLO_RETURN_IF_ERROR(ValidateFmspc(fmspc));
+
+  const std::string key =
+      absl::StrCat("tcb_info_", absl::BytesToHexString(fmspc.value()));
+  StatusOr<SgxPcsClientCacheEntry> entry_result = ReadEntry(key);
+  if (entry_result.ok()) {
+    const SgxPcsClientCacheEntry &entry = entry_result.ValueOrDie();
+    if (entry.has_tcb_info_result() && IsFresh(entry)) {
+      if (NeedsRefresh(entry)) {
+        MaybeScheduleRefresh(key, [this, key, fmspc] {
+          Status status = FetchAndStoreTcbInfo(key, fmspc).status();
+          if (!status.ok()) {
+            LOG(WARNING) << "Background refresh of TCB info failed: "
+                         << status;
+          }
+        });
+      }
+      GetTcbInfoResult result;
+      result.tcb_info = entry.tcb_info_result().tcb_info();
+      result.issuer_cert_chain = entry.tcb_info_result().issuer_cert_chain();
+      return result;
+    }
+  }
+  return FetchAndStoreTcbInfo(key, fmspc);
+}
+
+StatusOr<GetPckCertificateResult>
+CachingSgxPcsClient::FetchAndStorePckCertificate(const std::string &key,
+                                                 const Ppid &ppid,
+                                                 const CpuSvn &cpu_svn,
+                                                 const PceSvn &pce_svn,
+                                                 const PceId &pce_id) {
+  GetPckCertificateResult result;
+  ASYLO_ASSIGN_OR_RETURN(
+      result, delegate_->GetPckCertificate(ppid, cpu_svn, pce_svn, pce_id));
+
+  SgxPcsClientCacheEntry entry;
+  CachedPckCertificateResult *cached = entry.mutable_pck_certificate_result();
+  *cached->mutable_pck_cert() = result.pck_cert;
+  *cached->mutable_issuer_cert_chain() = result.issuer_cert_chain;
+  *cached->mutable_tcbm() = result.tcbm;
+  Status status = WriteEntry(key, std::move(entry));
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to write PCS cache entry: " << status;
+  }
+  return result;
+}
+
+StatusOr<GetPckCertificatesResult>
+CachingSgxPcsClient::FetchAndStorePckCertificates(const std::string &key,
+                                                  const Ppid &ppid,
+                                                  const PceId &pce_id) {
+  GetPckCertificatesResult result;
+  ASYLO_ASSIGN_OR_RETURN(result, delegate_->GetPckCertificates(ppid, pce_id));
+
+  SgxPcsClientCacheEntry entry;
+  CachedPckCertificatesResult *cached =
+      entry.mutable_pck_certificates_result();
+  *cached->mutable_pck_certs() = result.pck_certs;
+  *cached->mutable_issuer_cert_chain() = result.issuer_cert_chain;
+  Status status = WriteEntry(key, std::move(entry));
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to write PCS cache entry: " << status;
+  }
+  return result;
+}
+
+StatusOr<GetCrlResult> CachingSgxPcsClient::FetchAndStoreCrl(
+    const std::string &key, SgxCaType sgx_ca_type) {
+  GetCrlResult result;
+  ASYLO_ASSIGN_OR_RETURN(result, delegate_->GetCrl(sgx_ca_type));
+
+  SgxPcsClientCacheEntry entry;
+  CachedCrlResult *cached = entry.mutable_crl_result();
+  *cached->mutable_pck_crl() = result.pck_crl;
+  *cached->mutable_issuer_cert_chain() = result.issuer_cert_chain;
+  Status status = WriteEntry(key, std::move(entry));
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to write PCS cache entry: " << status;
+  }
+  return result;
+}
+
+StatusOr<GetTcbInfoResult> CachingSgxPcsClient::FetchAndStoreTcbInfo(
+    const std::string &key, const Fmspc &fmspc) {
+  GetTcbInfoResult result;
+  ASYLO_ASSIGN_OR_RETURN(result, delegate_->GetTcbInfo(fmspc));
+
+  SgxPcsClientCacheEntry entry;
+  CachedTcbInfoResult *cached = entry.mutable_tcb_info_result();
+  *cached->mutable_tcb_info() = result.tcb_info;
+  *cached->mutable_issuer_cert_chain() = result.issuer_cert_chain;
+  Status status = WriteEntry(key, std::move(entry));
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to write PCS cache entry: " << status;
+  }
+  return result;
+}
+
+StatusOr<SgxPcsClientCacheEntry> CachingSgxPcsClient::ReadEntry(
+    const std::string &key) const {
+  std::string path;
+  ASYLO_ASSIGN_OR_RETURN(path, EntryPath(key));
+  std::ifstream input(path, std::ios::binary);
+  if (!input) {
+    return Status(absl::StatusCode::kNotFound,
+                  absl::StrCat("No cache entry at ", path));
+  }
+  SgxPcsClientCacheEntry entry;
+  if (!entry.ParseFromIstream(&input)) {
+    return Status(absl::StatusCode::kInternal,
+                  absl::StrCat("Failed to parse cache entry at ", path));
+  }
+  return entry;
+}
+
+Status CachingSgxPcsClient::WriteEntry(const std::string &key,
+                                       SgxPcsClientCacheEntry entry) const {
+  std::string path;
+  ASYLO_ASSIGN_OR_RETURN(path, EntryPath(key));
+  entry.set_expiration_timestamp_seconds(
+      absl::ToUnixSeconds(absl::Now() + options_.ttl));
+
+  // Write to a thread-specific temporary file and rename it into place so
+  // that concurrent readers and writers never observe a partial entry.
+  const std::string tmp_path =
+      absl::StrCat(path, ".tmp.", Thread::this_thread_id());
+  {
+    std::ofstream output(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+      return LastPosixError(absl::StrCat("Failed to open ", tmp_path));
+    }
+    if (!entry.SerializeToOstream(&output)) {
+      return Status(
+          absl::StatusCode::kInternal,
+          absl::StrCat("Failed to serialize cache entry to ", tmp_path));
+    }
+  }
+  if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+    return LastPosixError(
+        absl::StrCat("Failed to rename ", tmp_path, " to ", path));
+  }
+  return Status::OkStatus();
+}
+
+StatusOr<std::string> CachingSgxPcsClient::EntryPath(
+    const std::string &key) const {
+  Sha256Hash hasher;
+  hasher.Update(key);
+  std::vector<uint8_t> digest;
+  ASYLO_RETURN_IF_ERROR(hasher.CumulativeHash(&digest));
+  const absl::string_view digest_view(
+      reinterpret_cast<const char *>(digest.data()), digest.size());
+  return JoinPath(options_.cache_dir,
+                  absl::StrCat(absl::BytesToHexString(digest_view), ".pb"));
+}
+
+bool CachingSgxPcsClient::IsFresh(const SgxPcsClientCacheEntry &entry) const {
+  return absl::FromUnixSeconds(entry.expiration_timestamp_seconds()) >
+         absl::Now();
+}
+
+bool CachingSgxPcsClient::NeedsRefresh(
+    const SgxPcsClientCacheEntry &entry) const {
+  return options_.enable_background_refresh &&
+         absl::FromUnixSeconds(entry.expiration_timestamp_seconds()) -
+                 absl::Now() <=
+             options_.refresh_leeway;
+}
+
+void CachingSgxPcsClient::MaybeScheduleRefresh(const std::string &key,
+                                               std::function<void()> refresh) {
+  absl::MutexLock lock(&mu_);
+  if (refreshes_in_flight_.empty()) {
+    // Every previously scheduled refresh has finished, so joining here cannot
+    // block on in-flight work. Reap the threads so that the list does not
+    // grow without bound on a long-lived client.
+    for (Thread &thread : refresh_threads_) {
+      thread.Join();
+    }
+    refresh_threads_.clear();
+  }
+  if (!refreshes_in_flight_.insert(key).second) {
+    return;
+  }
+  refresh_threads_.emplace_back([this, key, refresh] {
+    refresh();
+    absl::MutexLock lock(&mu_);
+    refreshes_in_flight_.erase(key);
+  });
+}
+
+}  // namespace sgx
+}  // namespace asylo
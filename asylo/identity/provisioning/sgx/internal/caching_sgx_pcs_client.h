@@ -0,0 +1,161 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_IDENTITY_PROVISIONING_SGX_INTERNAL_CACHING_SGX_PCS_CLIENT_H_
+#define ASYLO_IDENTITY_PROVISIONING_SGX_INTERNAL_CACHING_SGX_PCS_CLIENT_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "asylo/identity/platform/sgx/machine_configuration.pb.h"
+#include "asylo/identity/provisioning/sgx/internal/caching_sgx_pcs_client.pb.h"
+#include "asylo/identity/provisioning/sgx/internal/platform_provisioning.pb.h"
+#include "asylo/identity/provisioning/sgx/internal/sgx_pcs_client.h"
+#include "asylo/identity/provisioning/sgx/internal/sgx_pcs_client.pb.h"
+#include "asylo/util/status.h"
+#include "asylo/util/statusor.h"
+#include "asylo/util/thread.h"
+
+namespace asylo {
+namespace sgx {
+
+// An SgxPcsClient that caches the responses of a delegate client in a
+// directory on disk. PCK certificates and TCB info change rarely, so caching
+// them keeps machine provisioning and re-attestation from blocking on WAN
+// round trips to the PCS, and keeps a PCS outage from stalling attestation for
+// platforms that have been provisioned before.
+//
+// Each response is stored in its own file, keyed by the request parameters
+// (PPID, CPUSVN, PCESVN, PCEID, CA type, or FMSPC, depending on the call) and
+// stamped with an expiration time. A fresh cached response is served without
+// contacting the delegate. An expired or unreadable entry falls back to the
+// delegate, and the new response replaces the entry; failures to write the
+// cache are logged and do not fail the call.
+//
+// When background refresh is enabled, a cached response that is still fresh
+// but within |refresh_leeway| of expiring is served immediately while a
+// background thread re-fetches it from the delegate, so steady-state callers
+// do not observe PCS latency even as entries age out.
+//
+// This class is thread-safe.
+class CachingSgxPcsClient : public SgxPcsClient {
+ public:
+  struct Options {
+    // Directory in which cache entries are stored. The directory is created
+    // if it does not exist. Required.
+    std::string cache_dir;
+
+    // How long a cached response may be served before it must be re-fetched
+    // from the delegate.
+    absl::Duration ttl = absl::Hours(24);
+
+    // Whether to re-fetch entries nearing expiration in the background.
+    bool enable_background_refresh = false;
+
+    // How long before expiration a cached entry becomes eligible for
+    // background refresh. Only used if |enable_background_refresh| is true.
+    absl::Duration refresh_leeway = absl::Hours(1);
+  };
+
+  // Creates a caching client that forwards cache misses to |delegate|, which
+  // must not be nullptr. Fails if |options|.cache_dir is empty or cannot be
+  // created.
+  static StatusOr<std::unique_ptr<SgxPcsClient>> Create(
+      std::unique_ptr<SgxPcsClient> delegate, Options options);
+
+  // Joins any in-flight background refreshes.
+  ~CachingSgxPcsClient() override;
+
+  // From SgxPcsClient.
+
+  StatusOr<GetPckCertificateResult> GetPckCertificate(
+      const Ppid &ppid, const CpuSvn &cpu_svn, const PceSvn &pce_svn,
+      const PceId &pce_id) override;
+
+  StatusOr<GetPckCertificatesResult> GetPckCertificates(
+      const Ppid &ppid, const PceId &pce_id) override;
+
+  StatusOr<GetCrlResult> GetCrl(SgxCaType sgx_ca_type) override;
+
+  StatusOr<GetTcbInfoResult> GetTcbInfo(const Fmspc &fmspc) override;
+
+ private:
+  CachingSgxPcsClient(std::unique_ptr<SgxPcsClient> delegate, Options options);
+
+  // Fetches a result from |delegate_| and, on success, replaces the cache
+  // entry for |key| with the new response. One method per SgxPcsClient call.
+  StatusOr<GetPckCertificateResult> FetchAndStorePckCertificate(
+      const std::string &key, const Ppid &ppid, const CpuSvn &cpu_svn,
+      const PceSvn &pce_svn, const PceId &pce_id);
+  StatusOr<GetPckCertificatesResult> FetchAndStorePckCertificates(
+      const std::string &key, const Ppid &ppid, const PceId &pce_id);
+  StatusOr<GetCrlResult> FetchAndStoreCrl(const std::string &key,
+                                          SgxCaType sgx_ca_type);
+  StatusOr<GetTcbInfoResult> FetchAndStoreTcbInfo(const std::string &key,
+                                                  const Fmspc &fmspc);
+
+  // Reads and parses the cache entry for |key|. Returns a NOT_FOUND Status if
+  // no entry exists.
+  StatusOr<SgxPcsClientCacheEntry> ReadEntry(const std::string &key) const;
+
+  // Stamps |entry| with an expiration time of |ttl| from now and writes it as
+  // the cache entry for |key|. The entry is written to a temporary file and
+  // renamed into place so that concurrent readers never observe a partial
+  // entry.
+  Status WriteEntry(const std::string &key, SgxPcsClientCacheEntry entry) const;
+
+  // Returns the path of the cache file for |key|. The file name is a digest
+  // of |key| so that platform identifiers such as PPIDs do not appear in
+  // directory listings.
+  StatusOr<std::string> EntryPath(const std::string &key) const;
+
+  // Returns true if |entry| has not yet expired.
+  bool IsFresh(const SgxPcsClientCacheEntry &entry) const;
+
+  // Returns true if background refresh is enabled and |entry| is within
+  // |refresh_leeway| of expiring.
+  bool NeedsRefresh(const SgxPcsClientCacheEntry &entry) const;
+
+  // Runs |refresh| on a background thread unless a refresh for |key| is
+  // already in flight.
+  void MaybeScheduleRefresh(const std::string &key,
+                            std::function<void()> refresh);
+
+  const std::unique_ptr<SgxPcsClient> delegate_;
+  const Options options_;
+
+  absl::Mutex mu_;
+
+  // Keys whose entries are currently being refreshed in the background.
+  absl::flat_hash_set<std::string> refreshes_in_flight_ ABSL_GUARDED_BY(mu_);
+
+  // Background refresh threads. Joined opportunistically when no refresh is
+  // in flight, and unconditionally by the destructor.
+  std::vector<Thread> refresh_threads_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace sgx
+}  // namespace asylo
+
+#endif  // ASYLO_IDENTITY_PROVISIONING_SGX_INTERNAL_CACHING_SGX_PCS_CLIENT_H_
@@ -0,0 +1,283 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/identity/provisioning/sgx/internal/caching_sgx_pcs_client.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/flags/flag.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/time.h"
+#include "asylo/identity/provisioning/sgx/internal/mock_sgx_pcs_client.h"
+#include "asylo/identity/provisioning/sgx/internal/platform_provisioning.pb.h"
+#include "asylo/identity/provisioning/sgx/internal/sgx_pcs_client.h"
+#include "asylo/test/util/proto_matchers.h"
+#include "asylo/test/util/status_matchers.h"
+#include "asylo/test/util/test_flags.h"
+#include "asylo/util/logging.h"
+#include "asylo/util/path.h"
+
+namespace asylo {
+namespace sgx {
+namespace {
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::StrictMock;
+
+Ppid GetValidPpid() {
+  Ppid ppid;
+  ppid.set_value(
+      "\x7b\x97\xbe\x77\xc6\x2d\x42\x46"
+      "\xc6\x03\xd0\xf4\xf1\x1b\x31\xbb",
+      16);
+  return ppid;
+}
+
+CpuSvn GetValidCpuSvn() {
+  CpuSvn cpu_svn;
+  cpu_svn.set_value(
+      "\x05\x05\x02\x04\x01\x80\x00\x00"
+      "\x00\x00\x00\x00\x00\x00\x00\x00",
+      16);
+  return cpu_svn;
+}
+
+PceSvn GetValidPceSvn() {
+  PceSvn pce_svn;
+  pce_svn.set_value(7);
+  return pce_svn;
+}
+
+PceId GetValidPceId() {
+  PceId pce_id;
+  pce_id.set_value(0);
+  return pce_id;
+}
+
+Fmspc GetValidFmspc() {
+  Fmspc fmspc;
+  fmspc.set_value("\x00\x90\x6e\xa1\x00\x00", 6);
+  return fmspc;
+}
+
+GetPckCertificateResult GetTestPckCertificateResult() {
+  GetPckCertificateResult result;
+  result.pck_cert.set_format(Certificate::X509_PEM);
+  result.pck_cert.set_data("test pck certificate");
+  result.issuer_cert_chain.add_certificates()->set_data("test issuer");
+  result.tcbm.mutable_cpu_svn()->set_value(GetValidCpuSvn().value());
+  result.tcbm.mutable_pce_svn()->set_value(GetValidPceSvn().value());
+  return result;
+}
+
+GetCrlResult GetTestCrlResult() {
+  GetCrlResult result;
+  result.pck_crl.set_format(CertificateRevocationList::X509_PEM);
+  result.pck_crl.set_data("test crl");
+  result.issuer_cert_chain.add_certificates()->set_data("test issuer");
+  return result;
+}
+
+GetTcbInfoResult GetTestTcbInfoResult(const std::string &tcb_info_json) {
+  GetTcbInfoResult result;
+  result.tcb_info.set_tcb_info_json(tcb_info_json);
+  result.tcb_info.set_signature("test signature");
+  result.issuer_cert_chain.add_certificates()->set_data("test issuer");
+  return result;
+}
+
+class CachingSgxPcsClientTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::string dir_template = JoinPath(absl::GetFlag(FLAGS_test_tmpdir),
+                                        "caching_sgx_pcs_client_XXXXXX");
+    std::vector<char> buffer(dir_template.begin(), dir_template.end());
+    buffer.push_back('\0');
+    CHECK(mkdtemp(buffer.data()) != nullptr);
+    cache_dir_ = buffer.data();
+  }
+
+  // Returns options with |cache_dir_| set and the given |ttl|.
+  CachingSgxPcsClient::Options OptionsWithTtl(absl::Duration ttl) {
+    CachingSgxPcsClient::Options options;
+    options.cache_dir = cache_dir_;
+    options.ttl = ttl;
+    return options;
+  }
+
+  std::string cache_dir_;
+};
+
+TEST_F(CachingSgxPcsClientTest, CreateFailsWithNullDelegate) {
+  EXPECT_THAT(CachingSgxPcsClient::Create(/*delegate=*/nullptr,
+                                          OptionsWithTtl(absl::Hours(1)))
+                  .status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(CachingSgxPcsClientTest, CreateFailsWithEmptyCacheDir) {
+  CachingSgxPcsClient::Options options;
+  EXPECT_THAT(
+      CachingSgxPcsClient::Create(absl::make_unique<MockSgxPcsClient>(),
+                                  std::move(options))
+          .status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(CachingSgxPcsClientTest, ServesPckCertificateFromCache) {
+  auto mock = absl::make_unique<StrictMock<MockSgxPcsClient>>();
+  const GetPckCertificateResult expected = GetTestPckCertificateResult();
+  EXPECT_CALL(*mock, GetPckCertificate(_, _, _, _))
+      .Times(1)
+      .WillOnce(Return(expected));
+
+  std::unique_ptr<SgxPcsClient> client;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      client, CachingSgxPcsClient::Create(std::move(mock),
+                                          OptionsWithTtl(absl::Hours(1))));
+
+  for (int i = 0; i < 2; ++i) {
+    GetPckCertificateResult result;
+    ASYLO_ASSERT_OK_AND_ASSIGN(
+        result,
+        client->GetPckCertificate(GetValidPpid(), GetValidCpuSvn(),
+                                  GetValidPceSvn(), GetValidPceId()));
+    EXPECT_THAT(result.pck_cert, EqualsProto(expected.pck_cert));
+    EXPECT_THAT(result.issuer_cert_chain,
+                EqualsProto(expected.issuer_cert_chain));
+    EXPECT_THAT(result.tcbm, EqualsProto(expected.tcbm));
+  }
+}
+
+TEST_F(CachingSgxPcsClientTest, CacheSurvivesClientRestart) {
+  const GetTcbInfoResult expected = GetTestTcbInfoResult("test tcb info");
+  {
+    auto mock = absl::make_unique<StrictMock<MockSgxPcsClient>>();
+    EXPECT_CALL(*mock, GetTcbInfo(_)).Times(1).WillOnce(Return(expected));
+    std::unique_ptr<SgxPcsClient> client;
+    ASYLO_ASSERT_OK_AND_ASSIGN(
+        client, CachingSgxPcsClient::Create(std::move(mock),
+                                            OptionsWithTtl(absl::Hours(1))));
+    ASYLO_EXPECT_OK(client->GetTcbInfo(GetValidFmspc()).status());
+  }
+
+  // A new client backed by the same directory must not contact the delegate.
+  std::unique_ptr<SgxPcsClient> client;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      client, CachingSgxPcsClient::Create(
+                  absl::make_unique<StrictMock<MockSgxPcsClient>>(),
+                  OptionsWithTtl(absl::Hours(1))));
+  GetTcbInfoResult result;
+  ASYLO_ASSERT_OK_AND_ASSIGN(result, client->GetTcbInfo(GetValidFmspc()));
+  EXPECT_THAT(result.tcb_info, EqualsProto(expected.tcb_info));
+  EXPECT_THAT(result.issuer_cert_chain,
+              EqualsProto(expected.issuer_cert_chain));
+}
+
+TEST_F(CachingSgxPcsClientTest, ExpiredEntryIsRefetched) {
+  auto mock = absl::make_unique<StrictMock<MockSgxPcsClient>>();
+  EXPECT_CALL(*mock, GetTcbInfo(_))
+      .Times(2)
+      .WillRepeatedly(Return(GetTestTcbInfoResult("test tcb info")));
+
+  // Entries are stamped with an expiration in the past, so every lookup
+  // misses.
+  std::unique_ptr<SgxPcsClient> client;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      client, CachingSgxPcsClient::Create(std::move(mock),
+                                          OptionsWithTtl(-absl::Minutes(5))));
+  ASYLO_EXPECT_OK(client->GetTcbInfo(GetValidFmspc()).status());
+  ASYLO_EXPECT_OK(client->GetTcbInfo(GetValidFmspc()).status());
+}
+
+TEST_F(CachingSgxPcsClientTest, ErrorsAreNotCached) {
+  auto mock = absl::make_unique<StrictMock<MockSgxPcsClient>>();
+  EXPECT_CALL(*mock, GetCrl(_))
+      .Times(2)
+      .WillOnce(Return(absl::UnavailableError("PCS unavailable")))
+      .WillOnce(Return(GetTestCrlResult()));
+
+  std::unique_ptr<SgxPcsClient> client;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      client, CachingSgxPcsClient::Create(std::move(mock),
+                                          OptionsWithTtl(absl::Hours(1))));
+  EXPECT_THAT(client->GetCrl(SgxCaType::PLATFORM).status(),
+              StatusIs(absl::StatusCode::kUnavailable));
+  ASYLO_EXPECT_OK(client->GetCrl(SgxCaType::PLATFORM).status());
+}
+
+TEST_F(CachingSgxPcsClientTest, BackgroundRefreshRefetchesAgingEntry) {
+  absl::Notification refreshed;
+  const GetTcbInfoResult original = GetTestTcbInfoResult("original tcb info");
+  const GetTcbInfoResult refresh = GetTestTcbInfoResult("refreshed tcb info");
+  {
+    auto mock = absl::make_unique<StrictMock<MockSgxPcsClient>>();
+    EXPECT_CALL(*mock, GetTcbInfo(_))
+        .Times(2)
+        .WillOnce(Return(original))
+        .WillOnce(Invoke([&refreshed, &refresh](const Fmspc & /*fmspc*/) {
+          refreshed.Notify();
+          return refresh;
+        }));
+
+    // The refresh leeway exceeds the TTL, so every cache hit is eligible for
+    // background refresh.
+    CachingSgxPcsClient::Options options = OptionsWithTtl(absl::Hours(1));
+    options.enable_background_refresh = true;
+    options.refresh_leeway = absl::Hours(2);
+
+    std::unique_ptr<SgxPcsClient> client;
+    ASYLO_ASSERT_OK_AND_ASSIGN(client, CachingSgxPcsClient::Create(
+                                           std::move(mock),
+                                           std::move(options)));
+
+    // The first call fetches from the delegate; the second is served from the
+    // cache and schedules a background refresh.
+    GetTcbInfoResult result;
+    ASYLO_ASSERT_OK_AND_ASSIGN(result, client->GetTcbInfo(GetValidFmspc()));
+    EXPECT_THAT(result.tcb_info, EqualsProto(original.tcb_info));
+    ASYLO_ASSERT_OK_AND_ASSIGN(result, client->GetTcbInfo(GetValidFmspc()));
+    EXPECT_THAT(result.tcb_info, EqualsProto(original.tcb_info));
+
+    refreshed.WaitForNotification();
+  }
+
+  // After the refresh completes, the cache holds the refreshed response.
+  std::unique_ptr<SgxPcsClient> client;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      client, CachingSgxPcsClient::Create(
+                  absl::make_unique<StrictMock<MockSgxPcsClient>>(),
+                  OptionsWithTtl(absl::Hours(1))));
+  GetTcbInfoResult result;
+  ASYLO_ASSERT_OK_AND_ASSIGN(result, client->GetTcbInfo(GetValidFmspc()));
+  EXPECT_THAT(result.tcb_info, EqualsProto(refresh.tcb_info));
+}
+
+}  // namespace
+}  // namespace sgx
+}  // namespace asylo
@@ -20,16 +20,20 @@
 
 #include <endian.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <vector>
 
 #include "google/protobuf/struct.pb.h"
 #include <google/protobuf/util/json_util.h>
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "asylo/crypto/certificate.pb.h"
 #include "asylo/crypto/certificate_util.h"
 #include "asylo/identity/platform/sgx/internal/identity_key_management_structs.h"
@@ -43,6 +47,7 @@
 #include "asylo/util/proto_struct_util.h"
 #include "asylo/util/status.h"
 #include "asylo/util/status_macros.h"
+#include "asylo/util/thread.h"
 #include "asylo/util/url_util.h"
 
 namespace asylo {
@@ -56,14 +61,49 @@ constexpr uint32_t kPcesvnSize = 2;
 // Size of the RawTcb in bytes.
 constexpr uint32_t kRawTcbSize = kCpusvnSize + kPcesvnSize;
 
-// Parses a Certificate proto from JSON string |cert_json|.
+// Number of entries below which a PCK certificate list is parsed inline.
+// Thread setup costs more than it saves on short lists.
+constexpr int kMinEntriesForParallelParse = 16;
+
+// Maximum number of worker threads used to parse a PCK certificate list.
+constexpr int kMaxParseThreads = 8;
+
+// Cache of parsed "cert" fields, keyed by the URL-encoded PEM string from the
+// JSON. Intel's PCK certificate lists repeat issuer certificates across TCB
+// levels, so identical strings are decoded and validated only once. Safe for
+// concurrent use.
+class CertificateParseCache {
+ public:
+  StatusOr<Certificate> CertificateFromPemString(const std::string &cert_str) {
+    {
+      absl::MutexLock lock(&mu_);
+      auto it = parsed_.find(cert_str);
+      if (it != parsed_.end()) {
+        return it->second;
+      }
+    }
+    std::string cert_str_unescaped;
+    ASYLO_ASSIGN_OR_RETURN(cert_str_unescaped, UrlDecode(cert_str));
+    Certificate cert;
+    ASYLO_ASSIGN_OR_RETURN(cert, GetCertificateFromPem(cert_str_unescaped));
+    absl::MutexLock lock(&mu_);
+    parsed_.emplace(cert_str, cert);
+    return cert;
+  }
+
+ private:
+  absl::Mutex mu_;
+  absl::flat_hash_map<std::string, Certificate> parsed_ ABSL_GUARDED_BY(mu_);
+};
+
+// Parses a Certificate proto from JSON string |cert_json|. Identical strings
+// are served from |cert_cache| after the first parse.
 StatusOr<Certificate> CertificateFromJsonValue(
-    const google::protobuf::Value &cert_json) {
+    const google::protobuf::Value &cert_json,
+    CertificateParseCache *cert_cache) {
   const std::string *cert_str;
   ASYLO_ASSIGN_OR_RETURN(cert_str, JsonGetString(cert_json));
-  std::string cert_str_unescaped;
-  ASYLO_ASSIGN_OR_RETURN(cert_str_unescaped, UrlDecode(*cert_str));
-  return GetCertificateFromPem(cert_str_unescaped);
+  return cert_cache->CertificateFromPemString(*cert_str);
 }
 
 // Parses a RawTcb proto from JSON string |raw_tcb_json|.
@@ -88,9 +128,11 @@ StatusOr<RawTcb> RawTcbFromJsonValue(
   return raw_tcb_proto;
 }
 
-// Parses PckCertificateInfo proto from |pck_cert_json|.
+// Parses PckCertificateInfo proto from |pck_cert_json|, resolving the "cert"
+// field through |cert_cache|.
 StatusOr<PckCertificates::PckCertificateInfo> PckCertificateInfoFromJsonValue(
-    const google::protobuf::Value &pck_cert_json) {
+    const google::protobuf::Value &pck_cert_json,
+    CertificateParseCache *cert_cache) {
   const google::protobuf::Struct *pck_cert_object;
   ASYLO_ASSIGN_OR_RETURN(pck_cert_object, JsonGetObject(pck_cert_json));
   PckCertificates::PckCertificateInfo pck_cert_proto;
@@ -113,7 +155,7 @@ StatusOr<PckCertificates::PckCertificateInfo> PckCertificateInfoFromJsonValue(
   ASYLO_ASSIGN_OR_RETURN(cert_json,
                          JsonObjectGetField(*pck_cert_object, "cert"));
   ASYLO_ASSIGN_OR_RETURN(*pck_cert_proto.mutable_cert(),
-                         CertificateFromJsonValue(*cert_json));
+                         CertificateFromJsonValue(*cert_json, cert_cache));
 
   // We only expect three fields in |pck_cert_json|: "tcb", "tcbm", and "cert".
   // Log warning if there exist additional fields.
@@ -128,15 +170,56 @@ StatusOr<PckCertificates::PckCertificateInfo> PckCertificateInfoFromJsonValue(
   return pck_cert_proto;
 }
 
-// Parses PckCertificates proto from |pck_certs_json|.
+// Parses PckCertificates proto from |pck_certs_json|. Entries are independent
+// of each other, so long lists are parsed and validated on multiple threads.
+// The merge is deterministic: entries are assembled in list order and, on
+// failure, the status of the earliest failing entry is returned, matching the
+// sequential parse.
 StatusOr<PckCertificates> PckCertificatesFromJsonValue(
     const google::protobuf::Value &pck_certs_json) {
   const google::protobuf::ListValue *pck_certs_array;
   ASYLO_ASSIGN_OR_RETURN(pck_certs_array, JsonGetArray(pck_certs_json));
+  const int num_entries = pck_certs_array->values_size();
+
+  CertificateParseCache cert_cache;
+  std::vector<PckCertificates::PckCertificateInfo> entries(num_entries);
+  std::vector<Status> statuses(num_entries);
+
+  auto parse_entry = [&](int i) {
+    StatusOr<PckCertificates::PckCertificateInfo> entry_result =
+        PckCertificateInfoFromJsonValue(pck_certs_array->values(i),
+                                        &cert_cache);
+    if (entry_result.ok()) {
+      entries[i] = std::move(entry_result).ValueOrDie();
+    } else {
+      statuses[i] = entry_result.status();
+    }
+  };
+
+  if (num_entries < kMinEntriesForParallelParse) {
+    for (int i = 0; i < num_entries; ++i) {
+      parse_entry(i);
+    }
+  } else {
+    const int num_threads = std::min(kMaxParseThreads, num_entries);
+    std::vector<Thread> workers;
+    workers.reserve(num_threads);
+    for (int worker = 0; worker < num_threads; ++worker) {
+      workers.emplace_back([&parse_entry, worker, num_threads, num_entries] {
+        for (int i = worker; i < num_entries; i += num_threads) {
+          parse_entry(i);
+        }
+      });
+    }
+    for (Thread &thread : workers) {
+      thread.Join();
+    }
+  }
+
   PckCertificates pck_certs;
-  for (const auto &pck_cert_json : pck_certs_array->values()) {
-    ASYLO_ASSIGN_OR_RETURN(*pck_certs.add_certs(),
-                           PckCertificateInfoFromJsonValue(pck_cert_json));
+  for (int i = 0; i < num_entries; ++i) {
+    ASYLO_RETURN_IF_ERROR(statuses[i]);
+    *pck_certs.add_certs() = std::move(entries[i]);
   }
   return pck_certs;
 }
@@ -0,0 +1,834 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/identity/provisioning/sgx/internal/streaming_tcb_info_from_json.h"
+
+#include <endian.h>
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "google/protobuf/timestamp.pb.h"
+#include <google/protobuf/util/message_differencer.h>
+#include <google/protobuf/util/time_util.h>
+#include "absl/base/call_once.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/strip.h"
+#include "absl/time/civil_time.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
+#include "asylo/util/logging.h"
+#include "asylo/identity/provisioning/sgx/internal/container_util.h"
+#include "asylo/identity/provisioning/sgx/internal/platform_provisioning.h"
+#include "asylo/identity/provisioning/sgx/internal/platform_provisioning.pb.h"
+#include "asylo/identity/provisioning/sgx/internal/tcb.h"
+#include "asylo/identity/provisioning/sgx/internal/tcb.pb.h"
+#include "asylo/util/hex_util.h"
+#include "asylo/util/status.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+namespace sgx {
+namespace {
+
+// Parses an ISO 8601 time string from |time_string|.
+StatusOr<absl::Time> ParseIso8601TimeString(const std::string &time_string) {
+  absl::Time time;
+  std::string error;
+  if (!absl::ParseTime("%Y-%m-%dT%H:%M:%SZ", time_string, &time, &error)) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrCat("Could not parse time string: ", error));
+  }
+
+  return time;
+}
+
+// Returns true if |time| can be represented by a valid
+// google.protobuf.Timestamp and false otherwise.
+bool CanBeTimestampProto(absl::Time time) {
+  const absl::TimeZone utc = absl::UTCTimeZone();
+  const absl::Time timestamp_proto_minimum =
+      absl::FromCivil(absl::CivilSecond(1, 1, 1, 0, 0, 0), utc);
+  const absl::Time timestamp_proto_maximum =
+      absl::FromCivil(absl::CivilSecond(9999, 12, 31, 23, 59, 59), utc);
+  return time >= timestamp_proto_minimum && time <= timestamp_proto_maximum;
+}
+
+// Returns a map from known Intel TCB status strings to TcbStatus.StatusType
+// values.
+const absl::flat_hash_map<std::string, TcbStatus::StatusType>
+    &KnownStatusesMap() {
+  static absl::once_flag once_init;
+  static absl::flat_hash_map<std::string, TcbStatus::StatusType> *map = nullptr;
+
+  absl::call_once(once_init, [] {
+    map = new absl::flat_hash_map<std::string, TcbStatus::StatusType>({
+        {"UpToDate", TcbStatus::UP_TO_DATE},
+        {"OutOfDate", TcbStatus::OUT_OF_DATE},
+        {"ConfigurationNeeded", TcbStatus::CONFIGURATION_NEEDED},
+        {"Revoked", TcbStatus::REVOKED},
+    });
+  });
+  return *map;
+}
+
+// Returns the same error that the DOM-based parser produces when a required
+// |field_name| is missing from a JSON object.
+Status MissingFieldError(absl::string_view field_name) {
+  return Status(
+      absl::StatusCode::kInvalidArgument,
+      absl::StrCat("JSON object does not have a ", field_name, " field"));
+}
+
+// Returns |value| if it is within the range of a 32-bit integer. Otherwise,
+// returns an error, using |value_name| to name the value.
+StatusOr<int32_t> Int32FromDouble(double value, absl::string_view value_name) {
+  if (value < static_cast<double>(std::numeric_limits<int32_t>::min()) ||
+      value > static_cast<double>(std::numeric_limits<int32_t>::max()) ||
+      round(value) != value) {
+    return Status(
+        absl::StatusCode::kOutOfRange,
+        absl::StrFormat("%s JSON %f cannot be represented as a 32-bit integer",
+                        value_name, value));
+  }
+  return value;
+}
+
+// Parses a valid google.protobuf.Timestamp from |timestamp_string|, which must
+// be in ISO 8601 format.
+StatusOr<google::protobuf::Timestamp> TimestampFromString(
+    const std::string &timestamp_string) {
+  absl::Time time;
+  ASYLO_ASSIGN_OR_RETURN(time, ParseIso8601TimeString(timestamp_string));
+  if (!CanBeTimestampProto(time)) {
+    return Status(
+        absl::StatusCode::kOutOfRange,
+        absl::StrFormat(
+            "Timestamp %s cannot be represented as a google.protobuf.Timestamp",
+            timestamp_string));
+  }
+
+  google::protobuf::Timestamp timestamp;
+  absl::Duration remainder;
+  int64_t num_seconds = absl::IDivDuration(time - absl::UnixEpoch(),
+                                           absl::Seconds(1), &remainder);
+  timestamp.set_seconds(num_seconds);
+  timestamp.set_nanos(absl::ToInt64Nanoseconds(remainder));
+  return timestamp;
+}
+
+// Parses a valid TcbStatus from |status_string|.
+TcbStatus TcbStatusFromString(const std::string &status_string) {
+  TcbStatus status;
+  if (KnownStatusesMap().contains(status_string)) {
+    status.set_known_status(KnownStatusesMap().at(status_string));
+  } else {
+    status.set_unknown_status(status_string);
+  }
+  return status;
+}
+
+// Parses a valid Fmspc from |fmspc_hex_string|.
+StatusOr<Fmspc> FmspcFromString(const std::string &fmspc_hex_string) {
+  if (!IsHexEncoded(fmspc_hex_string)) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "FMSPC JSON is not a hex encoding string");
+  }
+
+  std::string fmspc_bytes = absl::HexStringToBytes(fmspc_hex_string);
+  if (fmspc_bytes.size() != kFmspcSize) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrCat("FMSPC JSON does not represent a ", kFmspcSize,
+                               "-byte value"));
+  }
+
+  Fmspc fmspc;
+  fmspc.set_value(fmspc_bytes);
+  return fmspc;
+}
+
+// Parses a valid PceId from |pce_id_hex_string|.
+StatusOr<PceId> PceIdFromString(const std::string &pce_id_hex_string) {
+  constexpr int kPceIdNumBytes = 2;
+
+  if (!IsHexEncoded(pce_id_hex_string)) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "PCE ID JSON is not a hex encoding string");
+  }
+
+  std::string pce_id_bytes = absl::HexStringToBytes(pce_id_hex_string);
+  if (pce_id_bytes.size() != kPceIdNumBytes) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrCat("PCE ID JSON does not represent a ",
+                               kPceIdNumBytes, "-byte value"));
+  }
+
+  PceId pce_id;
+  pce_id.set_value(
+      le16toh(*reinterpret_cast<const uint16_t *>(pce_id_bytes.data())));
+  return pce_id;
+}
+
+// Logs a warning about an unrecognized field |name| in the JSON object
+// described by |context|. Unlike the DOM-based parser, the streaming parser
+// cannot reproduce the whole enclosing object, so the warning names the field
+// instead.
+void LogUnrecognizedField(absl::string_view name, absl::string_view context) {
+  LOG(WARNING) << "Encountered unrecognized field \"" << name << "\" in "
+               << context;
+}
+
+// Returns the value of hex digit |c|, or -1 if |c| is not a hex digit.
+int HexDigitValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+// Appends the UTF-8 encoding of |code_point| to |out|.
+void AppendUtf8(uint32_t code_point, std::string *out) {
+  if (code_point <= 0x7f) {
+    out->push_back(static_cast<char>(code_point));
+  } else if (code_point <= 0x7ff) {
+    out->push_back(static_cast<char>(0xc0 | (code_point >> 6)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  } else if (code_point <= 0xffff) {
+    out->push_back(static_cast<char>(0xe0 | (code_point >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  } else {
+    out->push_back(static_cast<char>(0xf0 | (code_point >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  }
+}
+
+// A single-pass JSON walker. The walker consumes the input exactly once and
+// invokes callbacks for object members and array elements; it never
+// materializes a parse tree. Callers drive it by consuming values in document
+// order.
+class JsonWalker {
+ public:
+  // A callback invoked for each member of a JSON object. The callback must
+  // consume the member's value from the walker.
+  using MemberHandler = std::function<Status(const std::string &name)>;
+
+  // A callback invoked for each element of a JSON array. The callback must
+  // consume the element from the walker.
+  using ElementHandler = std::function<Status()>;
+
+  explicit JsonWalker(absl::string_view input)
+      : input_(input), original_size_(input.size()) {}
+
+  // Consumes a JSON object, invoking |handler| for each of its members.
+  Status WalkObject(const MemberHandler &handler) {
+    char next;
+    ASYLO_ASSIGN_OR_RETURN(next, Peek());
+    if (next != '{') {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    "JSON value is not an object");
+    }
+    input_.remove_prefix(1);
+    ASYLO_ASSIGN_OR_RETURN(next, Peek());
+    if (next == '}') {
+      input_.remove_prefix(1);
+      return Status::OkStatus();
+    }
+    while (true) {
+      ASYLO_ASSIGN_OR_RETURN(next, Peek());
+      if (next != '"') {
+        return MalformedError("expected object member name");
+      }
+      std::string name;
+      ASYLO_ASSIGN_OR_RETURN(name, ConsumeString());
+      ASYLO_ASSIGN_OR_RETURN(next, Peek());
+      if (next != ':') {
+        return MalformedError("expected ':' after object member name");
+      }
+      input_.remove_prefix(1);
+      ASYLO_RETURN_IF_ERROR(handler(name));
+      ASYLO_ASSIGN_OR_RETURN(next, Peek());
+      input_.remove_prefix(1);
+      if (next == '}') {
+        return Status::OkStatus();
+      }
+      if (next != ',') {
+        return MalformedError("expected ',' or '}' in object");
+      }
+    }
+  }
+
+  // Consumes a JSON array, invoking |handler| for each of its elements.
+  Status WalkArray(const ElementHandler &handler) {
+    char next;
+    ASYLO_ASSIGN_OR_RETURN(next, Peek());
+    if (next != '[') {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    "JSON value is not an array");
+    }
+    input_.remove_prefix(1);
+    ASYLO_ASSIGN_OR_RETURN(next, Peek());
+    if (next == ']') {
+      input_.remove_prefix(1);
+      return Status::OkStatus();
+    }
+    while (true) {
+      ASYLO_RETURN_IF_ERROR(handler());
+      ASYLO_ASSIGN_OR_RETURN(next, Peek());
+      input_.remove_prefix(1);
+      if (next == ']') {
+        return Status::OkStatus();
+      }
+      if (next != ',') {
+        return MalformedError("expected ',' or ']' in array");
+      }
+    }
+  }
+
+  // Consumes a JSON string value.
+  StatusOr<std::string> ConsumeString() {
+    char next;
+    ASYLO_ASSIGN_OR_RETURN(next, Peek());
+    if (next != '"') {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    "JSON value is not a string");
+    }
+    input_.remove_prefix(1);
+    std::string result;
+    while (true) {
+      if (input_.empty()) {
+        return MalformedError("unterminated string");
+      }
+      char c = input_.front();
+      input_.remove_prefix(1);
+      if (c == '"') {
+        return result;
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+        return MalformedError("unescaped control character in string");
+      }
+      if (c != '\\') {
+        result.push_back(c);
+        continue;
+      }
+      if (input_.empty()) {
+        return MalformedError("unterminated escape sequence");
+      }
+      char escape = input_.front();
+      input_.remove_prefix(1);
+      switch (escape) {
+        case '"':
+        case '\\':
+        case '/':
+          result.push_back(escape);
+          break;
+        case 'b':
+          result.push_back('\b');
+          break;
+        case 'f':
+          result.push_back('\f');
+          break;
+        case 'n':
+          result.push_back('\n');
+          break;
+        case 'r':
+          result.push_back('\r');
+          break;
+        case 't':
+          result.push_back('\t');
+          break;
+        case 'u': {
+          uint32_t code_point;
+          ASYLO_ASSIGN_OR_RETURN(code_point, ConsumeUnicodeEscape());
+          if (code_point >= 0xd800 && code_point <= 0xdbff) {
+            // A high surrogate must be followed by an escaped low surrogate.
+            if (!absl::ConsumePrefix(&input_, "\\u")) {
+              return MalformedError("unpaired surrogate in \\u escape");
+            }
+            uint32_t low_surrogate;
+            ASYLO_ASSIGN_OR_RETURN(low_surrogate, ConsumeUnicodeEscape());
+            if (low_surrogate < 0xdc00 || low_surrogate > 0xdfff) {
+              return MalformedError("unpaired surrogate in \\u escape");
+            }
+            code_point = 0x10000 + ((code_point - 0xd800) << 10) +
+                         (low_surrogate - 0xdc00);
+          } else if (code_point >= 0xdc00 && code_point <= 0xdfff) {
+            return MalformedError("unpaired surrogate in \\u escape");
+          }
+          AppendUtf8(code_point, &result);
+          break;
+        }
+        default:
+          return MalformedError("invalid escape sequence");
+      }
+    }
+  }
+
+  // Consumes a JSON number value.
+  StatusOr<double> ConsumeNumber() {
+    char next;
+    ASYLO_ASSIGN_OR_RETURN(next, Peek());
+    if (next != '-' && !absl::ascii_isdigit(next)) {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    "JSON value is not an integer");
+    }
+    size_t length = 0;
+    while (length < input_.size() &&
+           (absl::ascii_isdigit(input_[length]) || input_[length] == '-' ||
+            input_[length] == '+' || input_[length] == '.' ||
+            input_[length] == 'e' || input_[length] == 'E')) {
+      ++length;
+    }
+    double value;
+    if (!absl::SimpleAtod(input_.substr(0, length), &value)) {
+      return MalformedError("invalid number");
+    }
+    input_.remove_prefix(length);
+    return value;
+  }
+
+  // Consumes and discards a value of any type.
+  Status SkipValue() {
+    char next;
+    ASYLO_ASSIGN_OR_RETURN(next, Peek());
+    switch (next) {
+      case '{':
+        return WalkObject(
+            [this](const std::string & /*name*/) { return SkipValue(); });
+      case '[':
+        return WalkArray([this] { return SkipValue(); });
+      case '"':
+        return ConsumeString().status();
+      case 't':
+        return ConsumeLiteral("true");
+      case 'f':
+        return ConsumeLiteral("false");
+      case 'n':
+        return ConsumeLiteral("null");
+      default:
+        if (next == '-' || absl::ascii_isdigit(next)) {
+          return ConsumeNumber().status();
+        }
+        return MalformedError("unexpected character");
+    }
+  }
+
+  // Returns an error if non-whitespace input remains.
+  Status ExpectEndOfInput() {
+    SkipWhitespace();
+    if (!input_.empty()) {
+      return MalformedError("unexpected data after JSON value");
+    }
+    return Status::OkStatus();
+  }
+
+ private:
+  // Returns the next non-whitespace character without consuming it.
+  StatusOr<char> Peek() {
+    SkipWhitespace();
+    if (input_.empty()) {
+      return MalformedError("unexpected end of input");
+    }
+    return input_.front();
+  }
+
+  void SkipWhitespace() {
+    while (!input_.empty() &&
+           (input_.front() == ' ' || input_.front() == '\t' ||
+            input_.front() == '\n' || input_.front() == '\r')) {
+      input_.remove_prefix(1);
+    }
+  }
+
+  // Consumes |literal|, which must match the input exactly.
+  Status ConsumeLiteral(absl::string_view literal) {
+    if (!absl::ConsumePrefix(&input_, literal)) {
+      return MalformedError(absl::StrCat("invalid ", literal, " literal"));
+    }
+    return Status::OkStatus();
+  }
+
+  // Consumes the four hex digits of a \u escape and returns the code point.
+  StatusOr<uint32_t> ConsumeUnicodeEscape() {
+    if (input_.size() < 4) {
+      return MalformedError("truncated \\u escape");
+    }
+    uint32_t code_point = 0;
+    for (int i = 0; i < 4; ++i) {
+      int digit = HexDigitValue(input_[i]);
+      if (digit < 0) {
+        return MalformedError("invalid \\u escape");
+      }
+      code_point = code_point * 16 + digit;
+    }
+    input_.remove_prefix(4);
+    return code_point;
+  }
+
+  // Returns an error naming the current input offset.
+  Status MalformedError(absl::string_view message) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  absl::StrCat("JSON is malformed at offset ",
+                               original_size_ - input_.size(), ": ", message));
+  }
+
+  absl::string_view input_;
+  const size_t original_size_;
+};
+
+// Matches field names of the form "sgxtcbcomp##svn", where ## is a two-digit
+// number between 01 and kTcbComponentsSize. On a match, sets |*index| to the
+// zero-based component index and returns true.
+bool MatchSgxTcbComponentFieldName(absl::string_view name, int *index) {
+  if (!absl::ConsumePrefix(&name, "sgxtcbcomp") ||
+      !absl::ConsumeSuffix(&name, "svn") || name.size() != 2 ||
+      !absl::ascii_isdigit(name[0]) || !absl::ascii_isdigit(name[1])) {
+    return false;
+  }
+  int component_number = (name[0] - '0') * 10 + (name[1] - '0');
+  if (component_number < 1 || component_number > kTcbComponentsSize) {
+    return false;
+  }
+  *index = component_number - 1;
+  return true;
+}
+
+// Consumes a TCB JSON object from |walker| into a Tcb proto.
+StatusOr<Tcb> WalkTcb(JsonWalker *walker) {
+  Tcb tcb;
+  tcb.set_components(std::string(kTcbComponentsSize, 0));
+  bool seen_components[kTcbComponentsSize] = {false};
+  bool seen_pce_svn = false;
+  ASYLO_RETURN_IF_ERROR(
+      walker->WalkObject([&](const std::string &name) -> Status {
+        if (name == "pcesvn") {
+          double pce_svn_raw;
+          ASYLO_ASSIGN_OR_RETURN(pce_svn_raw, walker->ConsumeNumber());
+          if (pce_svn_raw < 0. || pce_svn_raw > kPceSvnMaxValue) {
+            return Status(absl::StatusCode::kInvalidArgument,
+                          "pcesvn is out of bounds");
+          }
+          tcb.mutable_pce_svn()->set_value(pce_svn_raw);
+          seen_pce_svn = true;
+          return Status::OkStatus();
+        }
+        int index;
+        if (MatchSgxTcbComponentFieldName(name, &index)) {
+          double component;
+          ASYLO_ASSIGN_OR_RETURN(component, walker->ConsumeNumber());
+          if (component < 0. || component > 255.) {
+            return Status(absl::StatusCode::kInvalidArgument,
+                          "An SGX TCB component SVN is out of bounds");
+          }
+          (*tcb.mutable_components())[index] = static_cast<int>(component);
+          seen_components[index] = true;
+          return Status::OkStatus();
+        }
+        LogUnrecognizedField(name, "TCB JSON");
+        return walker->SkipValue();
+      }));
+  for (int i = 0; i < kTcbComponentsSize; ++i) {
+    if (!seen_components[i]) {
+      return MissingFieldError(absl::StrFormat("sgxtcbcomp%02dsvn", i + 1));
+    }
+  }
+  if (!seen_pce_svn) {
+    return MissingFieldError("pcesvn");
+  }
+  return tcb;
+}
+
+// Holds the fields of one "tcbLevels" entry until the TCB info version is
+// known. The version determines which fields are required and which are
+// unrecognized, and may appear after "tcbLevels" in the document, so
+// version-dependent validation is deferred until the whole document has been
+// consumed.
+struct PendingTcbLevel {
+  Tcb tcb;
+  bool has_tcb = false;
+  absl::optional<std::string> status;
+  absl::optional<std::string> tcb_status;
+  absl::optional<std::string> tcb_date;
+  absl::optional<std::vector<std::string>> advisory_ids;
+};
+
+// Consumes one "tcbLevels" entry from |walker|.
+StatusOr<PendingTcbLevel> WalkTcbLevel(JsonWalker *walker) {
+  PendingTcbLevel level;
+  ASYLO_RETURN_IF_ERROR(
+      walker->WalkObject([&](const std::string &name) -> Status {
+        if (name == "tcb") {
+          ASYLO_ASSIGN_OR_RETURN(level.tcb, WalkTcb(walker));
+          level.has_tcb = true;
+        } else if (name == "status") {
+          ASYLO_ASSIGN_OR_RETURN(level.status, walker->ConsumeString());
+        } else if (name == "tcbStatus") {
+          ASYLO_ASSIGN_OR_RETURN(level.tcb_status, walker->ConsumeString());
+        } else if (name == "tcbDate") {
+          ASYLO_ASSIGN_OR_RETURN(level.tcb_date, walker->ConsumeString());
+        } else if (name == "advisoryIDs") {
+          std::vector<std::string> advisory_ids;
+          ASYLO_RETURN_IF_ERROR(walker->WalkArray([&]() -> Status {
+            std::string advisory_id;
+            ASYLO_ASSIGN_OR_RETURN(advisory_id, walker->ConsumeString());
+            advisory_ids.push_back(std::move(advisory_id));
+            return Status::OkStatus();
+          }));
+          level.advisory_ids = std::move(advisory_ids);
+        } else {
+          LogUnrecognizedField(name, "TCB level JSON");
+          return walker->SkipValue();
+        }
+        return Status::OkStatus();
+      }));
+  return level;
+}
+
+// Converts |pending| into a TcbLevel according to the field rules of TCB info
+// version |version|, which must be either 1 or 2.
+StatusOr<TcbLevel> FinalizeTcbLevel(int32_t version, PendingTcbLevel pending) {
+  if (!pending.has_tcb) {
+    return MissingFieldError("tcb");
+  }
+  TcbLevel tcb_level;
+  *tcb_level.mutable_tcb() = std::move(pending.tcb);
+  if (version == 1) {
+    if (!pending.status.has_value()) {
+      return MissingFieldError("status");
+    }
+    *tcb_level.mutable_status() = TcbStatusFromString(*pending.status);
+    // A version 1 TCB level only recognizes "tcb" and "status".
+    if (pending.tcb_status.has_value()) {
+      LogUnrecognizedField("tcbStatus", "TCB level JSON");
+    }
+    if (pending.tcb_date.has_value()) {
+      LogUnrecognizedField("tcbDate", "TCB level JSON");
+    }
+    if (pending.advisory_ids.has_value()) {
+      LogUnrecognizedField("advisoryIDs", "TCB level JSON");
+    }
+  } else {
+    if (!pending.tcb_status.has_value()) {
+      return MissingFieldError("tcbStatus");
+    }
+    *tcb_level.mutable_status() = TcbStatusFromString(*pending.tcb_status);
+    if (!pending.tcb_date.has_value()) {
+      return MissingFieldError("tcbDate");
+    }
+    ASYLO_ASSIGN_OR_RETURN(*tcb_level.mutable_tcb_date(),
+                           TimestampFromString(*pending.tcb_date));
+    // The "advisoryIDs" field is optional, but may not be empty.
+    if (pending.advisory_ids.has_value()) {
+      if (pending.advisory_ids->empty()) {
+        return Status(absl::StatusCode::kInvalidArgument,
+                      "\"advisoryIDs\" array may not be empty");
+      }
+      for (std::string &advisory_id : *pending.advisory_ids) {
+        tcb_level.add_advisory_ids(std::move(advisory_id));
+      }
+    }
+    if (pending.status.has_value()) {
+      LogUnrecognizedField("status", "TCB level JSON");
+    }
+  }
+  return tcb_level;
+}
+
+}  // namespace
+
+StatusOr<Tcb> StreamingTcbFromJson(absl::string_view json_string) {
+  JsonWalker walker(json_string);
+  Tcb tcb;
+  ASYLO_ASSIGN_OR_RETURN(tcb, WalkTcb(&walker));
+  ASYLO_RETURN_IF_ERROR(walker.ExpectEndOfInput());
+  return tcb;
+}
+
+StatusOr<TcbInfo> StreamingTcbInfoFromJson(absl::string_view json_string) {
+  JsonWalker walker(json_string);
+  absl::optional<int32_t> version;
+  absl::optional<std::string> issue_date;
+  absl::optional<std::string> next_update;
+  absl::optional<std::string> fmspc;
+  absl::optional<std::string> pce_id;
+  absl::optional<double> tcb_type;
+  absl::optional<double> tcb_evaluation_data_number;
+  absl::optional<std::vector<PendingTcbLevel>> tcb_levels;
+  ASYLO_RETURN_IF_ERROR(
+      walker.WalkObject([&](const std::string &name) -> Status {
+        if (name == "version") {
+          double version_raw;
+          ASYLO_ASSIGN_OR_RETURN(version_raw, walker.ConsumeNumber());
+          int32_t version_value;
+          ASYLO_ASSIGN_OR_RETURN(
+              version_value, Int32FromDouble(version_raw, "TCB info version"));
+          version = version_value;
+        } else if (name == "issueDate") {
+          ASYLO_ASSIGN_OR_RETURN(issue_date, walker.ConsumeString());
+        } else if (name == "nextUpdate") {
+          ASYLO_ASSIGN_OR_RETURN(next_update, walker.ConsumeString());
+        } else if (name == "fmspc") {
+          ASYLO_ASSIGN_OR_RETURN(fmspc, walker.ConsumeString());
+        } else if (name == "pceId") {
+          ASYLO_ASSIGN_OR_RETURN(pce_id, walker.ConsumeString());
+        } else if (name == "tcbType") {
+          ASYLO_ASSIGN_OR_RETURN(tcb_type, walker.ConsumeNumber());
+        } else if (name == "tcbEvaluationDataNumber") {
+          ASYLO_ASSIGN_OR_RETURN(tcb_evaluation_data_number,
+                                 walker.ConsumeNumber());
+        } else if (name == "tcbLevels") {
+          std::vector<PendingTcbLevel> levels;
+          ASYLO_RETURN_IF_ERROR(walker.WalkArray([&]() -> Status {
+            PendingTcbLevel level;
+            ASYLO_ASSIGN_OR_RETURN(level, WalkTcbLevel(&walker));
+            levels.push_back(std::move(level));
+            return Status::OkStatus();
+          }));
+          tcb_levels = std::move(levels);
+        } else {
+          LogUnrecognizedField(name, "TCB info JSON");
+          return walker.SkipValue();
+        }
+        return Status::OkStatus();
+      }));
+  ASYLO_RETURN_IF_ERROR(walker.ExpectEndOfInput());
+
+  if (!version.has_value()) {
+    return MissingFieldError("version");
+  }
+  if (*version != 1 && *version != 2) {
+    return Status(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Unrecognized version of TCB info JSON: ", *version));
+  }
+
+  TcbInfo tcb_info;
+  TcbInfoImpl *tcb_info_impl = tcb_info.mutable_impl();
+  tcb_info_impl->set_version(*version);
+
+  if (!issue_date.has_value()) {
+    return MissingFieldError("issueDate");
+  }
+  ASYLO_ASSIGN_OR_RETURN(*tcb_info_impl->mutable_issue_date(),
+                         TimestampFromString(*issue_date));
+  if (!next_update.has_value()) {
+    return MissingFieldError("nextUpdate");
+  }
+  ASYLO_ASSIGN_OR_RETURN(*tcb_info_impl->mutable_next_update(),
+                         TimestampFromString(*next_update));
+  if (tcb_info_impl->issue_date() >= tcb_info_impl->next_update()) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "Issue date does not come before next update");
+  }
+
+  if (!fmspc.has_value()) {
+    return MissingFieldError("fmspc");
+  }
+  ASYLO_ASSIGN_OR_RETURN(*tcb_info_impl->mutable_fmspc(),
+                         FmspcFromString(*fmspc));
+  if (!pce_id.has_value()) {
+    return MissingFieldError("pceId");
+  }
+  ASYLO_ASSIGN_OR_RETURN(*tcb_info_impl->mutable_pce_id(),
+                         PceIdFromString(*pce_id));
+
+  if (*version == 2) {
+    if (!tcb_type.has_value()) {
+      return MissingFieldError("tcbType");
+    }
+    int32_t tcb_type_value;
+    ASYLO_ASSIGN_OR_RETURN(tcb_type_value,
+                           Int32FromDouble(*tcb_type, "TCB type"));
+    switch (tcb_type_value) {
+      case 0:
+        tcb_info_impl->set_tcb_type(TcbType::TCB_TYPE_0);
+        break;
+      default:
+        return Status(
+            absl::StatusCode::kInvalidArgument,
+            absl::StrCat("Unknown TCB type value: ", tcb_type_value));
+    }
+
+    if (!tcb_evaluation_data_number.has_value()) {
+      return MissingFieldError("tcbEvaluationDataNumber");
+    }
+    int32_t tcb_evaluation_data_number_value;
+    ASYLO_ASSIGN_OR_RETURN(tcb_evaluation_data_number_value,
+                           Int32FromDouble(*tcb_evaluation_data_number,
+                                           "TCB evaluation data number"));
+    tcb_info_impl->set_tcb_evaluation_data_number(
+        tcb_evaluation_data_number_value);
+  } else {
+    if (tcb_type.has_value()) {
+      LogUnrecognizedField("tcbType", "TCB info JSON");
+    }
+    if (tcb_evaluation_data_number.has_value()) {
+      LogUnrecognizedField("tcbEvaluationDataNumber", "TCB info JSON");
+    }
+  }
+
+  if (!tcb_levels.has_value()) {
+    return MissingFieldError("tcbLevels");
+  }
+  absl::flat_hash_map<Tcb, TcbStatus, absl::Hash<Tcb>, MessageEqual>
+      tcb_to_status_map;
+  for (PendingTcbLevel &pending : *tcb_levels) {
+    TcbLevel tcb_level;
+    ASYLO_ASSIGN_OR_RETURN(tcb_level,
+                           FinalizeTcbLevel(*version, std::move(pending)));
+    auto insert_pair =
+        tcb_to_status_map.insert({tcb_level.tcb(), tcb_level.status()});
+    if (!insert_pair.second) {
+      if (!google::protobuf::util::MessageDifferencer::Equals(insert_pair.first->second,
+                                                    tcb_level.status())) {
+        return Status(
+            absl::StatusCode::kInvalidArgument,
+            "TCB info JSON contains the same TCB level multiple times with "
+            "different statuses");
+      }
+      LOG(WARNING) << "Encountered duplicate TCB entries in TCB levels JSON";
+      continue;
+    }
+    *tcb_info_impl->add_tcb_levels() = std::move(tcb_level);
+  }
+  return tcb_info;
+}
+
+}  // namespace sgx
+}  // namespace asylo
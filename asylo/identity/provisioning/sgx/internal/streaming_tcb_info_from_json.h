@@ -0,0 +1,59 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_IDENTITY_PROVISIONING_SGX_INTERNAL_STREAMING_TCB_INFO_FROM_JSON_H_
+#define ASYLO_IDENTITY_PROVISIONING_SGX_INTERNAL_STREAMING_TCB_INFO_FROM_JSON_H_
+
+#include "absl/strings/string_view.h"
+#include "asylo/identity/provisioning/sgx/internal/tcb.pb.h"
+#include "asylo/util/statusor.h"
+
+namespace asylo {
+namespace sgx {
+
+// Single-pass alternatives to TcbFromJson() and TcbInfoFromJson() from
+// tcb_info_from_json.h. The streaming parsers walk the input exactly once and
+// fill the output proto directly, without materializing an intermediate
+// google::protobuf::Value tree. This makes them considerably cheaper on large
+// TCB info documents, which matters when many verifiers re-parse the same
+// documents during mass re-attestation.
+//
+// For valid inputs, the streaming parsers produce the same protos as their
+// DOM-based counterparts and apply the same validation rules, including the
+// same warnings for unrecognized fields and the same handling of duplicate
+// TCB levels. They differ from the DOM-based parsers in two ways:
+//
+//   * Error messages for structurally malformed JSON name the point of
+//     failure rather than reproducing protobuf's JSON parser errors.
+//   * Values of recognized field names (e.g. "tcbDate" in a version 1 TCB
+//     info, where the DOM-based parser ignores the field as unrecognized)
+//     must still be well-typed; ill-typed values are rejected rather than
+//     ignored.
+
+// Parses |json_string| into a Tcb proto with the same semantics as
+// TcbFromJson().
+StatusOr<Tcb> StreamingTcbFromJson(absl::string_view json_string);
+
+// Parses |json_string| into a TcbInfo proto with the same semantics as
+// TcbInfoFromJson().
+StatusOr<TcbInfo> StreamingTcbInfoFromJson(absl::string_view json_string);
+
+}  // namespace sgx
+}  // namespace asylo
+
+#endif  // ASYLO_IDENTITY_PROVISIONING_SGX_INTERNAL_STREAMING_TCB_INFO_FROM_JSON_H_
@@ -0,0 +1,281 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/identity/provisioning/sgx/internal/streaming_tcb_info_from_json.h"
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "absl/strings/string_view.h"
+#include "asylo/identity/provisioning/sgx/internal/tcb.pb.h"
+#include "asylo/identity/provisioning/sgx/internal/tcb_info_from_json.h"
+#include "asylo/test/util/proto_matchers.h"
+#include "asylo/test/util/status_matchers.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+namespace sgx {
+namespace {
+
+using ::testing::Eq;
+using ::testing::HasSubstr;
+
+// A valid Tcb JSON object.
+constexpr char kValidTcbJson[] = R"json({
+      "sgxtcbcomp01svn": 0,
+      "sgxtcbcomp02svn": 1,
+      "sgxtcbcomp03svn": 2,
+      "sgxtcbcomp04svn": 3,
+      "sgxtcbcomp05svn": 4,
+      "sgxtcbcomp06svn": 5,
+      "sgxtcbcomp07svn": 6,
+      "sgxtcbcomp08svn": 7,
+      "sgxtcbcomp09svn": 8,
+      "sgxtcbcomp10svn": 9,
+      "sgxtcbcomp11svn": 10,
+      "sgxtcbcomp12svn": 11,
+      "sgxtcbcomp13svn": 12,
+      "sgxtcbcomp14svn": 13,
+      "sgxtcbcomp15svn": 14,
+      "sgxtcbcomp16svn": 15,
+      "pcesvn": 2
+    })json";
+
+// A valid version 1 TCB info JSON object with one TCB level.
+constexpr char kValidTcbInfoV1Json[] = R"json({
+      "version": 1,
+      "issueDate": "2020-02-20T20:20:20Z",
+      "nextUpdate": "2020-03-20T20:20:20Z",
+      "fmspc": "0123456789ab",
+      "pceId": "0000",
+      "tcbLevels": [{
+        "tcb": {
+          "sgxtcbcomp01svn": 0,
+          "sgxtcbcomp02svn": 1,
+          "sgxtcbcomp03svn": 2,
+          "sgxtcbcomp04svn": 3,
+          "sgxtcbcomp05svn": 4,
+          "sgxtcbcomp06svn": 5,
+          "sgxtcbcomp07svn": 6,
+          "sgxtcbcomp08svn": 7,
+          "sgxtcbcomp09svn": 8,
+          "sgxtcbcomp10svn": 9,
+          "sgxtcbcomp11svn": 10,
+          "sgxtcbcomp12svn": 11,
+          "sgxtcbcomp13svn": 12,
+          "sgxtcbcomp14svn": 13,
+          "sgxtcbcomp15svn": 14,
+          "sgxtcbcomp16svn": 15,
+          "pcesvn": 2
+        },
+        "status": "UpToDate"
+      }]
+    })json";
+
+// A valid version 2 TCB info JSON object with one TCB level.
+constexpr char kValidTcbInfoV2Json[] = R"json({
+      "version": 2,
+      "issueDate": "2020-02-20T20:20:20Z",
+      "nextUpdate": "2020-03-20T20:20:20Z",
+      "fmspc": "0123456789ab",
+      "pceId": "0000",
+      "tcbType": 0,
+      "tcbEvaluationDataNumber": 2,
+      "tcbLevels": [{
+        "tcb": {
+          "sgxtcbcomp01svn": 0,
+          "sgxtcbcomp02svn": 1,
+          "sgxtcbcomp03svn": 2,
+          "sgxtcbcomp04svn": 3,
+          "sgxtcbcomp05svn": 4,
+          "sgxtcbcomp06svn": 5,
+          "sgxtcbcomp07svn": 6,
+          "sgxtcbcomp08svn": 7,
+          "sgxtcbcomp09svn": 8,
+          "sgxtcbcomp10svn": 9,
+          "sgxtcbcomp11svn": 10,
+          "sgxtcbcomp12svn": 11,
+          "sgxtcbcomp13svn": 12,
+          "sgxtcbcomp14svn": 13,
+          "sgxtcbcomp15svn": 14,
+          "sgxtcbcomp16svn": 15,
+          "pcesvn": 2
+        },
+        "tcbDate": "2020-02-20T20:20:20Z",
+        "tcbStatus": "UpToDate",
+        "advisoryIDs": ["Some advisory ID"]
+      }]
+    })json";
+
+// Returns a version 1 TCB info JSON object whose "tcbLevels" array contains
+// one entry per element of |statuses|, all with the same TCB.
+std::string TcbInfoV1JsonWithLevelStatuses(
+    const std::vector<absl::string_view> &statuses) {
+  std::string levels;
+  for (absl::string_view status : statuses) {
+    if (!levels.empty()) {
+      absl::StrAppend(&levels, ", ");
+    }
+    absl::StrAppend(&levels, "{\"tcb\": ", kValidTcbJson, ", \"status\": \"",
+                    status, "\"}");
+  }
+  return absl::StrCat(R"json({
+      "version": 1,
+      "issueDate": "2020-02-20T20:20:20Z",
+      "nextUpdate": "2020-03-20T20:20:20Z",
+      "fmspc": "0123456789ab",
+      "pceId": "0000",
+      "tcbLevels": [)json",
+                      levels, "]}");
+}
+
+TEST(StreamingTcbInfoFromJsonTest, ParsesSameTcbAsDomParser) {
+  Tcb expected_tcb;
+  ASYLO_ASSERT_OK_AND_ASSIGN(expected_tcb, TcbFromJson(kValidTcbJson));
+  EXPECT_THAT(StreamingTcbFromJson(kValidTcbJson),
+              IsOkAndHolds(EqualsProto(expected_tcb)));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, ParsesSameTcbInfoV1AsDomParser) {
+  TcbInfo expected_tcb_info;
+  ASYLO_ASSERT_OK_AND_ASSIGN(expected_tcb_info,
+                             TcbInfoFromJson(kValidTcbInfoV1Json));
+  EXPECT_THAT(StreamingTcbInfoFromJson(kValidTcbInfoV1Json),
+              IsOkAndHolds(EqualsProto(expected_tcb_info)));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, ParsesSameTcbInfoV2AsDomParser) {
+  TcbInfo expected_tcb_info;
+  ASYLO_ASSERT_OK_AND_ASSIGN(expected_tcb_info,
+                             TcbInfoFromJson(kValidTcbInfoV2Json));
+  EXPECT_THAT(StreamingTcbInfoFromJson(kValidTcbInfoV2Json),
+              IsOkAndHolds(EqualsProto(expected_tcb_info)));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, ParsesTcbInfoWithVersionAfterTcbLevels) {
+  // The "version" field determines how TCB levels are interpreted, but may
+  // appear after "tcbLevels" in the document.
+  std::string json = absl::StrReplaceAll(
+      kValidTcbInfoV2Json,
+      {{"\"version\": 2,", ""}, {"}]\n    }", "}],\n      \"version\": 2\n    }"}});
+  TcbInfo expected_tcb_info;
+  ASYLO_ASSERT_OK_AND_ASSIGN(expected_tcb_info, TcbInfoFromJson(json));
+  EXPECT_THAT(StreamingTcbInfoFromJson(json),
+              IsOkAndHolds(EqualsProto(expected_tcb_info)));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, DecodesEscapeSequencesInStrings) {
+  std::string json = absl::StrReplaceAll(kValidTcbInfoV2Json,
+                                         {{"\"UpToDate\"", "\"\\u0055pToDate\""}});
+  TcbInfo tcb_info;
+  ASYLO_ASSERT_OK_AND_ASSIGN(tcb_info, StreamingTcbInfoFromJson(json));
+  EXPECT_THAT(tcb_info.impl().tcb_levels(0).status().known_status(),
+              Eq(TcbStatus::UP_TO_DATE));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, FailsOnTruncatedJson) {
+  EXPECT_THAT(StreamingTcbInfoFromJson("{\"version\": 1,").status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, FailsOnTrailingData) {
+  std::string json = absl::StrCat(kValidTcbInfoV1Json, " trailing");
+  EXPECT_THAT(StreamingTcbInfoFromJson(json).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, FailsOnNonObjectInput) {
+  EXPECT_THAT(StreamingTcbInfoFromJson("[\"an array\"]").status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       "JSON value is not an object"));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, FailsOnUnknownVersion) {
+  std::string json = absl::StrReplaceAll(kValidTcbInfoV1Json,
+                                         {{"\"version\": 1", "\"version\": 3"}});
+  EXPECT_THAT(StreamingTcbInfoFromJson(json).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       "Unrecognized version of TCB info JSON: 3"));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, FailsOnMissingField) {
+  std::string json = absl::StrReplaceAll(kValidTcbInfoV1Json,
+                                         {{"\"pceId\": \"0000\",", ""}});
+  EXPECT_THAT(StreamingTcbInfoFromJson(json).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       "JSON object does not have a pceId field"));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, FailsOnOutOfBoundsTcbComponentSvn) {
+  std::string json = absl::StrReplaceAll(
+      kValidTcbInfoV1Json, {{"\"sgxtcbcomp16svn\": 15", "\"sgxtcbcomp16svn\": 256"}});
+  EXPECT_THAT(StreamingTcbInfoFromJson(json).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       "An SGX TCB component SVN is out of bounds"));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, FailsOnOutOfBoundsPceSvn) {
+  std::string json = absl::StrReplaceAll(kValidTcbInfoV1Json,
+                                         {{"\"pcesvn\": 2", "\"pcesvn\": 65536"}});
+  EXPECT_THAT(StreamingTcbInfoFromJson(json).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       "pcesvn is out of bounds"));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, FailsOnIssueDateAfterNextUpdate) {
+  std::string json = absl::StrReplaceAll(
+      kValidTcbInfoV1Json,
+      {{"\"nextUpdate\": \"2020-03-20T20:20:20Z\"",
+        "\"nextUpdate\": \"2020-01-20T20:20:20Z\""}});
+  EXPECT_THAT(StreamingTcbInfoFromJson(json).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       "Issue date does not come before next update"));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, FailsOnEmptyAdvisoryIds) {
+  std::string json = absl::StrReplaceAll(
+      kValidTcbInfoV2Json,
+      {{"\"advisoryIDs\": [\"Some advisory ID\"]", "\"advisoryIDs\": []"}});
+  EXPECT_THAT(StreamingTcbInfoFromJson(json).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       "\"advisoryIDs\" array may not be empty"));
+}
+
+TEST(StreamingTcbInfoFromJsonTest,
+     FailsOnDuplicateTcbLevelsWithDifferentStatuses) {
+  std::string json = TcbInfoV1JsonWithLevelStatuses({"UpToDate", "OutOfDate"});
+  EXPECT_THAT(StreamingTcbInfoFromJson(json).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("same TCB level multiple times")));
+}
+
+TEST(StreamingTcbInfoFromJsonTest, DeduplicatesTcbLevelsWithSameStatus) {
+  std::string json = TcbInfoV1JsonWithLevelStatuses({"UpToDate", "UpToDate"});
+  TcbInfo tcb_info;
+  ASYLO_ASSERT_OK_AND_ASSIGN(tcb_info, StreamingTcbInfoFromJson(json));
+  EXPECT_THAT(tcb_info.impl().tcb_levels_size(), Eq(1));
+}
+
+}  // namespace
+}  // namespace sgx
+}  // namespace asylo
@@ -171,7 +171,10 @@ StatusOr<std::unique_ptr<AeadCryptor>> MakeCryptor(AeadScheme aead_scheme,
                                                    ByteContainerView key) {
   switch (aead_scheme) {
     case AeadScheme::AES256_GCM_SIV:
-      return AeadCryptor::CreateAesGcmSivCryptor(key);
+      // Seal and unseal construct a cryptor per operation, so fetch the
+      // underlying key from the pool to avoid re-expanding the AES key
+      // schedule for the same derived key material.
+      return AeadCryptor::CreateAesGcmSivCryptorWithPooledKey(key);
     default:
       return absl::InvalidArgumentError("Unsupported cipher suite");
   }
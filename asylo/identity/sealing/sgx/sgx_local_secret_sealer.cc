@@ -19,10 +19,13 @@
 #include "asylo/identity/sealing/sgx/sgx_local_secret_sealer.h"
 
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
 #include "asylo/crypto/aead_cryptor.h"
 #include "asylo/crypto/algorithms.pb.h"
 #include "asylo/crypto/util/byte_container_util.h"
@@ -145,9 +148,7 @@ Status SgxLocalSecretSealer::Seal(
                           additional_authenticated_data);
 
   CleansingVector<uint8_t> key;
-  ASYLO_RETURN_IF_ERROR(sgx::internal::GenerateCryptorKey(
-      aead_scheme, "default_key_id", sgx_expectation, kAes256GcmSivKeySize,
-      &key));
+  ASYLO_RETURN_IF_ERROR(GetCryptorKey(aead_scheme, sgx_expectation, &key));
 
   std::unique_ptr<AeadCryptor> cryptor;
   ASYLO_ASSIGN_OR_RETURN(cryptor, sgx::internal::MakeCryptor(aead_scheme, key));
@@ -175,9 +176,7 @@ Status SgxLocalSecretSealer::Unseal(const SealedSecret &sealed_secret,
                           sealed_secret.additional_authenticated_data());
 
   CleansingVector<uint8_t> key;
-  ASYLO_RETURN_IF_ERROR(sgx::internal::GenerateCryptorKey(
-      aead_scheme, "default_key_id", sgx_expectation, kAes256GcmSivKeySize,
-      &key));
+  ASYLO_RETURN_IF_ERROR(GetCryptorKey(aead_scheme, sgx_expectation, &key));
 
   std::unique_ptr<AeadCryptor> cryptor;
   ASYLO_ASSIGN_OR_RETURN(cryptor, sgx::internal::MakeCryptor(aead_scheme, key));
@@ -185,4 +184,93 @@ Status SgxLocalSecretSealer::Unseal(const SealedSecret &sealed_secret,
                              final_additional_data, secret);
 }
 
+Status SgxLocalSecretSealer::SealAll(
+    const SealedSecretHeader &header,
+    const std::vector<ByteContainerView> &additional_authenticated_data,
+    const std::vector<ByteContainerView> &secrets,
+    std::vector<SealedSecret> *sealed_secrets) {
+  if (additional_authenticated_data.size() != secrets.size()) {
+    return absl::InvalidArgumentError(
+        "Number of additional authenticated data entries does not match the "
+        "number of secrets");
+  }
+  sealed_secrets->clear();
+
+  AeadScheme aead_scheme;
+  SgxIdentityExpectation sgx_expectation;
+  ASYLO_RETURN_IF_ERROR(
+      sgx::internal::ParseKeyGenerationParamsFromSealedSecretHeader(
+          header, &aead_scheme, &sgx_expectation));
+
+  std::string serialized_header;
+  if (!header.SerializeToString(&serialized_header)) {
+    return absl::InternalError("Header serialization to string failed");
+  }
+
+  // All secrets in the batch share one policy, so the key is derived and the
+  // cryptor constructed exactly once.
+  CleansingVector<uint8_t> key;
+  ASYLO_RETURN_IF_ERROR(GetCryptorKey(aead_scheme, sgx_expectation, &key));
+  std::unique_ptr<AeadCryptor> cryptor;
+  ASYLO_ASSIGN_OR_RETURN(cryptor, sgx::internal::MakeCryptor(aead_scheme, key));
+
+  sealed_secrets->resize(secrets.size());
+  for (size_t i = 0; i < secrets.size(); ++i) {
+    SealedSecret *sealed_secret = &(*sealed_secrets)[i];
+    sealed_secret->set_sealed_secret_header(serialized_header);
+    sealed_secret->set_additional_authenticated_data(
+        reinterpret_cast<const char *>(additional_authenticated_data[i].data()),
+        additional_authenticated_data[i].size());
+
+    std::string final_additional_data;
+    SerializeByteContainers(&final_additional_data, serialized_header,
+                            additional_authenticated_data[i]);
+    ASYLO_RETURN_IF_ERROR(sgx::internal::Seal(
+        cryptor.get(), secrets[i], final_additional_data, sealed_secret));
+  }
+  return Status::OkStatus();
+}
+
+Status SgxLocalSecretSealer::UnsealAll(
+    const std::vector<SealedSecret> &sealed_secrets,
+    std::vector<CleansingVector<uint8_t>> *secrets) {
+  // Each sealed secret carries its own header, so the batch may mix policies.
+  // The derived-key cache makes consecutive secrets under one policy share a
+  // single key derivation.
+  secrets->clear();
+  secrets->resize(sealed_secrets.size());
+  for (size_t i = 0; i < sealed_secrets.size(); ++i) {
+    ASYLO_RETURN_IF_ERROR(Unseal(sealed_secrets[i], &(*secrets)[i]));
+  }
+  return Status::OkStatus();
+}
+
+Status SgxLocalSecretSealer::GetCryptorKey(
+    AeadScheme aead_scheme, const SgxIdentityExpectation &sgx_expectation,
+    CleansingVector<uint8_t> *key) {
+  std::string cache_key;
+  ASYLO_RETURN_IF_ERROR(SerializeByteContainers(
+      &cache_key, AeadScheme_Name(aead_scheme),
+      sgx_expectation.SerializeAsString()));
+
+  {
+    absl::MutexLock lock(&derived_key_cache_lock_);
+    auto it = derived_key_cache_.find(cache_key);
+    if (it != derived_key_cache_.end()) {
+      *key = it->second;
+      return Status::OkStatus();
+    }
+  }
+
+  // Derive outside the lock so that concurrent derivations of distinct keys
+  // do not serialize on the hardware interface.
+  ASYLO_RETURN_IF_ERROR(sgx::internal::GenerateCryptorKey(
+      aead_scheme, "default_key_id", sgx_expectation, kAes256GcmSivKeySize,
+      key));
+
+  absl::MutexLock lock(&derived_key_cache_lock_);
+  derived_key_cache_.emplace(std::move(cache_key), *key);
+  return Status::OkStatus();
+}
+
 }  // namespace asylo
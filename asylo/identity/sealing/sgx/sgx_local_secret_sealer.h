@@ -20,7 +20,12 @@
 #define ASYLO_IDENTITY_SEALING_SGX_SGX_LOCAL_SECRET_SEALER_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "asylo/crypto/algorithms.pb.h"
 #include "asylo/crypto/util/byte_container_view.h"
 #include "asylo/identity/identity.pb.h"
 #include "asylo/identity/platform/sgx/code_identity.pb.h"
@@ -139,13 +144,62 @@ class SgxLocalSecretSealer : public SecretSealer {
   Status Unseal(const SealedSecret &sealed_secret,
                 CleansingVector<uint8_t> *secret) override;
 
+  /// Seals each entry of `secrets` to `header`, pairing it with the entry of
+  /// `additional_authenticated_data` at the same index. The sealing key is
+  /// derived and the cryptor constructed once for the entire batch, so sealing
+  /// a bundle of secrets under one policy performs a single key derivation.
+  ///
+  /// \param header The metadata to guide the sealing of every secret.
+  /// \param additional_authenticated_data One entry of unencrypted data per
+  ///        secret. Must be the same size as `secrets`.
+  /// \param secrets The data to encrypt and seal.
+  /// \param[out] sealed_secrets The output sealed secrets, in the same order
+  ///             as `secrets`. Cleared on entry.
+  /// \return A non-OK status if sealing any secret fails.
+  Status SealAll(const SealedSecretHeader &header,
+                 const std::vector<ByteContainerView>
+                     &additional_authenticated_data,
+                 const std::vector<ByteContainerView> &secrets,
+                 std::vector<SealedSecret> *sealed_secrets);
+
+  /// Unseals each entry of `sealed_secrets`. Secrets sealed under the same
+  /// policy share one key derivation through the sealer's derived-key cache,
+  /// so unsealing a bundle does not repeat the hardware key request per
+  /// secret.
+  ///
+  /// \param sealed_secrets The input secrets to unseal.
+  /// \param[out] secrets The destination for the unsealed secrets, in the same
+  ///             order as `sealed_secrets`. Cleared on entry.
+  /// \return A non-OK status if unsealing any secret fails.
+  Status UnsealAll(const std::vector<SealedSecret> &sealed_secrets,
+                   std::vector<CleansingVector<uint8_t>> *secrets);
+
  private:
   // Instantiates LocalSecretSealer that sets client_acl in the default sealed
   // secret header per |default_client_acl|.
   SgxLocalSecretSealer(const SgxIdentityExpectation &default_client_acl);
 
+  // Writes the cryptor key derived from |aead_scheme| and |sgx_expectation|
+  // to |key|, consulting the derived-key cache before falling back to
+  // hardware key derivation. Derived keys are deterministic functions of the
+  // header policy fields, so caching them is safe; it saves the EGETKEY
+  // round trips when many secrets share one sealing policy.
+  Status GetCryptorKey(AeadScheme aead_scheme,
+                       const SgxIdentityExpectation &sgx_expectation,
+                       CleansingVector<uint8_t> *key);
+
   // The default client ACL for this SecretSealer.
   SgxIdentityExpectation default_client_acl_;
+
+  // Guards derived_key_cache_.
+  absl::Mutex derived_key_cache_lock_;
+
+  // Maps a serialization of the key-generation parameters to the derived key.
+  // Entries are cleansed on destruction. The serialization is not guaranteed
+  // canonical, so equal policies may occasionally miss, which costs an extra
+  // derivation but never affects correctness.
+  absl::flat_hash_map<std::string, CleansingVector<uint8_t>> derived_key_cache_
+      ABSL_GUARDED_BY(derived_key_cache_lock_);
 };
 
 }  // namespace asylo
@@ -23,6 +23,7 @@
 #include <sys/types.h>
 
 #include <memory>
+#include <vector>
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/text_format.h>
@@ -462,6 +463,59 @@ TEST_F(SgxLocalSecretSealerTest, SealUnsealMrsignerSuccessSameEnclave) {
   EXPECT_EQ(input_secret, output_secret);
 }
 
+// Verify that a batch of secrets sealed with SealAll round-trips through
+// UnsealAll, and that batch-sealed secrets can also be unsealed one at a time.
+TEST_F(SgxLocalSecretSealerTest, SealAllUnsealAllSuccessSameEnclave) {
+  CleansingVector<uint8_t> input_secret(kTestSecret,
+                                        kTestSecret + kTestSecretSize);
+  std::string input_aad(kTestAad);
+
+  std::unique_ptr<SgxLocalSecretSealer> sealer =
+      SgxLocalSecretSealer::CreateMrsignerSecretSealer();
+  SealedSecretHeader header;
+  PrepareSealedSecretHeader(*sealer, &header);
+
+  std::vector<ByteContainerView> aads(3, ByteContainerView(input_aad));
+  std::vector<ByteContainerView> secrets(
+      3, ByteContainerView(input_secret.data(), input_secret.size()));
+  std::vector<SealedSecret> sealed_secrets;
+  ASSERT_THAT(sealer->SealAll(header, aads, secrets, &sealed_secrets), IsOk());
+  ASSERT_EQ(sealed_secrets.size(), 3);
+
+  std::unique_ptr<SgxLocalSecretSealer> sealer2 =
+      SgxLocalSecretSealer::CreateMrsignerSecretSealer();
+  std::vector<CleansingVector<uint8_t>> output_secrets;
+  ASSERT_THAT(sealer2->UnsealAll(sealed_secrets, &output_secrets), IsOk());
+  ASSERT_EQ(output_secrets.size(), 3);
+  for (const CleansingVector<uint8_t> &output_secret : output_secrets) {
+    EXPECT_EQ(input_secret, output_secret);
+  }
+
+  CleansingVector<uint8_t> single_output_secret;
+  ASSERT_THAT(sealer2->Unseal(sealed_secrets[0], &single_output_secret),
+              IsOk());
+  EXPECT_EQ(input_secret, single_output_secret);
+}
+
+// Verify that SealAll rejects mismatched batch sizes.
+TEST_F(SgxLocalSecretSealerTest, SealAllFailureMismatchedBatchSizes) {
+  CleansingVector<uint8_t> input_secret(kTestSecret,
+                                        kTestSecret + kTestSecretSize);
+  std::string input_aad(kTestAad);
+
+  std::unique_ptr<SgxLocalSecretSealer> sealer =
+      SgxLocalSecretSealer::CreateMrsignerSecretSealer();
+  SealedSecretHeader header;
+  PrepareSealedSecretHeader(*sealer, &header);
+
+  std::vector<ByteContainerView> aads(2, ByteContainerView(input_aad));
+  std::vector<ByteContainerView> secrets(
+      3, ByteContainerView(input_secret.data(), input_secret.size()));
+  std::vector<SealedSecret> sealed_secrets;
+  EXPECT_THAT(sealer->SealAll(header, aads, secrets, &sealed_secrets),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 // Verify that a secret sealed to MRSIGNER can be unsealed from different
 // enclave with the same MRSIGNER value but a different MRENCLAVE value.
 TEST_F(SgxLocalSecretSealerTest, SealUnsealMrsignerSuccessSameMrsigner) {
@@ -52,6 +52,15 @@ int sys_futex_wait(int32_t *futex, int32_t expected, int64_t timeout_microsec) {
 int sys_futex_wake(int32_t *futex, int32_t num) {
   return sys_futex(futex, FUTEX_WAKE, num, nullptr, nullptr, 0);
 }
+
+int sys_futex_requeue(int32_t *futex, int32_t num_wake, int32_t num_move,
+                      int32_t *requeue_futex) {
+  // FUTEX_REQUEUE passes the requeue limit in place of the timeout pointer.
+  return sys_futex(futex, FUTEX_REQUEUE, num_wake,
+                   reinterpret_cast<const struct timespec *>(
+                       static_cast<uintptr_t>(num_move)),
+                   requeue_futex, 0);
+}
 }
 
 }  // namespace asylo
@@ -36,5 +36,12 @@ int sys_futex_wait(int32_t *futex, int32_t expected, int64_t timeout_microsec);
 // Wakes at most `num` of the threads waiting on `futex`. Returns the number of
 // threads awakened.
 int sys_futex_wake(int32_t *futex, int32_t num);
+
+// Wakes at most `num_wake` of the threads waiting on `futex` and moves up to
+// `num_move` of the remaining waiters to `requeue_futex` without waking them.
+// The moved threads are woken by later wakes on `requeue_futex`. Returns the
+// number of threads awakened.
+int sys_futex_requeue(int32_t *futex, int32_t num_wake, int32_t num_move,
+                      int32_t *requeue_futex);
 }
 #endif  // ASYLO_PLATFORM_COMMON_FUTEX_H_
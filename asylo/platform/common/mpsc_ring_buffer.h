@@ -0,0 +1,180 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_COMMON_MPSC_RING_BUFFER_H_
+#define ASYLO_PLATFORM_COMMON_MPSC_RING_BUFFER_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace asylo {
+
+// A bounded lock-free queue of fixed-size records supporting multiple
+// simultaneous writers and exactly one reader. It complements RingBuffer,
+// which moves bytes between exactly one writer and one reader: this type
+// moves whole records and lets any number of threads push concurrently, so a
+// single drain thread can collect records — profiler samples, queued
+// switchless calls — produced across many threads.
+//
+// NOTE: This code is written with security sensitive applications in mind,
+// and care should be taken to ensure it never reads or writes outside the
+// object itself. All slot accesses index modulo a slot count fixed at compile
+// time, so corruption of the shared control words can reorder, drop or
+// garble records but cannot cause out-of-bounds access. Consumers must copy
+// records out of the buffer before interpreting them.
+//
+// Like RingBuffer, only atomic instructions are used for synchronization and
+// no operating system primitives are assumed. Operations never block: a push
+// against a full buffer and a pop against an empty one simply fail, which is
+// the desired behavior for lossy export channels such as the profiler.
+//
+// Each slot carries a sequence word that hands the slot back and forth
+// between producers and the consumer (Vyukov's bounded queue scheme). A
+// batch of records is claimed with a single compare-and-swap on the producer
+// cursor and released with a single store of the consumer cursor, so pushing
+// or popping N records costs one contended atomic update, not N.
+template <typename T, size_t kSlots>
+class MpscRingBuffer {
+ public:
+  static_assert(kSlots >= 2 && (kSlots & (kSlots - 1)) == 0,
+                "Slot count must be a power of two, at least two.");
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Element type must be trivially copyable.");
+  static_assert(sizeof(std::atomic<size_t>) == sizeof(size_t),
+                "std::atomic<size_t> is not lock free.");
+
+  MpscRingBuffer() : enqueue_pos_(0), dequeue_pos_(0) {
+    for (size_t i = 0; i < kSlots; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscRingBuffer(const MpscRingBuffer &) = delete;
+  MpscRingBuffer &operator=(const MpscRingBuffer &) = delete;
+
+  // Pushes one record. Returns false if the buffer is full.
+  bool TryPush(const T &element) { return TryPushN(&element, 1); }
+
+  // Pushes |count| records as one contiguous batch, claiming all of their
+  // slots with a single compare-and-swap. Returns false without pushing
+  // anything if |count| free slots are not available. May be called from any
+  // number of threads concurrently.
+  bool TryPushN(const T *elements, size_t count) {
+    if (count == 0) {
+      return true;
+    }
+    if (count > kSlots) {
+      return false;
+    }
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      // The consumer recycles slots in FIFO order, so if the last slot of the
+      // batch is free then every earlier slot of the batch is free as well.
+      const size_t last_seq =
+          slots_[(pos + count - 1) % kSlots].sequence.load(
+              std::memory_order_acquire);
+      const intptr_t dif = static_cast<intptr_t>(last_seq) -
+                           static_cast<intptr_t>(pos + count - 1);
+      if (dif == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + count,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        // The batch does not fit in the free slots.
+        return false;
+      } else {
+        // Another producer claimed slots first; retry from its cursor.
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    for (size_t i = 0; i < count; ++i) {
+      Slot *slot = &slots_[(pos + i) % kSlots];
+      slot->element = elements[i];
+      // Publishes the record to the consumer.
+      slot->sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    return true;
+  }
+
+  // Pops one record into |element|. Returns false if the buffer is empty.
+  // Must only be called from the single consumer thread.
+  bool TryPop(T *element) { return TryPopN(element, 1) == 1; }
+
+  // Pops up to |max_count| records into |elements|, returning the number
+  // popped. The consumer cursor is updated once for the whole batch. Must
+  // only be called from the single consumer thread.
+  size_t TryPopN(T *elements, size_t max_count) {
+    const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    size_t popped = 0;
+    while (popped < max_count) {
+      Slot *slot = &slots_[(pos + popped) % kSlots];
+      if (slot->sequence.load(std::memory_order_acquire) != pos + popped + 1) {
+        // The next record has not been published yet.
+        break;
+      }
+      elements[popped] = slot->element;
+      // Recycles the slot for the producer one lap ahead.
+      slot->sequence.store(pos + popped + kSlots, std::memory_order_release);
+      ++popped;
+    }
+    if (popped > 0) {
+      dequeue_pos_.store(pos + popped, std::memory_order_relaxed);
+    }
+    return popped;
+  }
+
+  // Returns the maximum number of records the buffer can hold.
+  constexpr size_t capacity() const { return kSlots; }
+
+  // Returns the approximate number of records in the buffer. The value is
+  // exact only when no producer is running concurrently.
+  size_t size() const {
+    return enqueue_pos_.load(std::memory_order_relaxed) -
+           dequeue_pos_.load(std::memory_order_relaxed);
+  }
+
+  // Returns true if the buffer was empty at the time of the call.
+  bool empty() const { return size() == 0; }
+
+ private:
+  // One queue slot. The sequence word is |index| while the slot is free for
+  // the producer claiming |index|, and |index| + 1 once the record at |index|
+  // is published for the consumer.
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T element;
+  };
+
+  // Size in bytes of a cache line on the architectures Asylo supports. Used
+  // to pad fields written by different threads apart from each other.
+  static constexpr size_t kCacheLineSize = 64;
+
+  // Next position to be claimed by a producer.
+  alignas(kCacheLineSize) std::atomic<size_t> enqueue_pos_;
+  // Next position to be drained by the consumer.
+  alignas(kCacheLineSize) std::atomic<size_t> dequeue_pos_;
+  alignas(kCacheLineSize) std::array<Slot, kSlots> slots_;
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_COMMON_MPSC_RING_BUFFER_H_
@@ -0,0 +1,179 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/common/mpsc_ring_buffer.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace asylo {
+namespace {
+
+// One test record: a producer identifier and a per-producer sequence number.
+struct TestRecord {
+  uint64_t producer;
+  uint64_t sequence;
+};
+
+TEST(MpscRingBufferTest, BasicProperties) {
+  MpscRingBuffer<TestRecord, 8> buf;
+  EXPECT_EQ(buf.capacity(), 8);
+  EXPECT_EQ(buf.size(), 0);
+  EXPECT_TRUE(buf.empty());
+
+  ASSERT_TRUE(buf.TryPush(TestRecord{1, 2}));
+  EXPECT_EQ(buf.size(), 1);
+  EXPECT_FALSE(buf.empty());
+
+  TestRecord record;
+  ASSERT_TRUE(buf.TryPop(&record));
+  EXPECT_EQ(record.producer, 1);
+  EXPECT_EQ(record.sequence, 2);
+  EXPECT_TRUE(buf.empty());
+  EXPECT_FALSE(buf.TryPop(&record));
+}
+
+TEST(MpscRingBufferTest, PreservesFifoOrder) {
+  MpscRingBuffer<TestRecord, 8> buf;
+  for (uint64_t i = 0; i < buf.capacity(); ++i) {
+    ASSERT_TRUE(buf.TryPush(TestRecord{0, i}));
+  }
+
+  TestRecord record;
+  for (uint64_t i = 0; i < buf.capacity(); ++i) {
+    ASSERT_TRUE(buf.TryPop(&record));
+    EXPECT_EQ(record.sequence, i);
+  }
+}
+
+TEST(MpscRingBufferTest, PushFullBuffer) {
+  MpscRingBuffer<TestRecord, 4> buf;
+  for (uint64_t i = 0; i < buf.capacity(); ++i) {
+    ASSERT_TRUE(buf.TryPush(TestRecord{0, i}));
+  }
+  EXPECT_EQ(buf.size(), buf.capacity());
+  EXPECT_FALSE(buf.TryPush(TestRecord{0, 99}));
+
+  // Draining one record makes room for exactly one more.
+  TestRecord record;
+  ASSERT_TRUE(buf.TryPop(&record));
+  EXPECT_TRUE(buf.TryPush(TestRecord{0, 4}));
+  EXPECT_FALSE(buf.TryPush(TestRecord{0, 99}));
+}
+
+TEST(MpscRingBufferTest, BatchPushIsAllOrNothing) {
+  MpscRingBuffer<TestRecord, 4> buf;
+  std::vector<TestRecord> batch;
+  for (uint64_t i = 0; i < 3; ++i) {
+    batch.push_back(TestRecord{0, i});
+  }
+  ASSERT_TRUE(buf.TryPushN(batch.data(), batch.size()));
+  EXPECT_EQ(buf.size(), 3);
+
+  // Only one slot remains; a three-record batch must leave it untouched.
+  EXPECT_FALSE(buf.TryPushN(batch.data(), batch.size()));
+  EXPECT_EQ(buf.size(), 3);
+
+  // A batch larger than the whole buffer can never fit.
+  std::vector<TestRecord> oversized(buf.capacity() + 1, TestRecord{0, 0});
+  EXPECT_FALSE(buf.TryPushN(oversized.data(), oversized.size()));
+
+  // An empty batch always succeeds.
+  EXPECT_TRUE(buf.TryPushN(batch.data(), 0));
+  EXPECT_EQ(buf.size(), 3);
+}
+
+TEST(MpscRingBufferTest, BatchPopDrainsInOrder) {
+  MpscRingBuffer<TestRecord, 8> buf;
+  for (uint64_t i = 0; i < 6; ++i) {
+    ASSERT_TRUE(buf.TryPush(TestRecord{0, i}));
+  }
+
+  // Popping more than is available returns only what is there.
+  TestRecord records[8];
+  ASSERT_EQ(buf.TryPopN(records, 4), 4);
+  for (uint64_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(records[i].sequence, i);
+  }
+  ASSERT_EQ(buf.TryPopN(records, 8), 2);
+  EXPECT_EQ(records[0].sequence, 4);
+  EXPECT_EQ(records[1].sequence, 5);
+  EXPECT_EQ(buf.TryPopN(records, 8), 0);
+}
+
+TEST(MpscRingBufferTest, WrapsAroundRepeatedly) {
+  MpscRingBuffer<TestRecord, 4> buf;
+  TestRecord record;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(buf.TryPush(TestRecord{0, i}));
+    ASSERT_TRUE(buf.TryPop(&record));
+    EXPECT_EQ(record.sequence, i);
+  }
+  EXPECT_TRUE(buf.empty());
+}
+
+// Several producers push concurrently while one consumer drains. Every record
+// must arrive exactly once and records from each producer must stay in their
+// production order.
+TEST(MpscRingBufferTest, MultiProducerStressTest) {
+  constexpr size_t kProducers = 4;
+  constexpr uint64_t kRecordsPerProducer = 100000;
+  MpscRingBuffer<TestRecord, 256> buf;
+
+  std::vector<std::thread> producers;
+  for (size_t producer = 0; producer < kProducers; ++producer) {
+    producers.emplace_back([&buf, producer]() {
+      for (uint64_t i = 0; i < kRecordsPerProducer; ++i) {
+        while (!buf.TryPush(TestRecord{producer, i})) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<uint64_t> next_expected(kProducers, 0);
+  uint64_t drained = 0;
+  while (drained < kProducers * kRecordsPerProducer) {
+    TestRecord records[64];
+    size_t popped = buf.TryPopN(records, 64);
+    if (popped == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    for (size_t i = 0; i < popped; ++i) {
+      ASSERT_LT(records[i].producer, kProducers);
+      EXPECT_EQ(records[i].sequence, next_expected[records[i].producer]);
+      ++next_expected[records[i].producer];
+    }
+    drained += popped;
+  }
+
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  EXPECT_TRUE(buf.empty());
+  for (size_t producer = 0; producer < kProducers; ++producer) {
+    EXPECT_EQ(next_expected[producer], kRecordsPerProducer);
+  }
+}
+
+}  // namespace
+}  // namespace asylo
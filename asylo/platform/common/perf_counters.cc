@@ -0,0 +1,103 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/common/perf_counters.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace asylo {
+namespace {
+
+// The name of the reserved overflow counter in slot 0.
+constexpr char kOverflowCounterName[] = "perf.overflow";
+
+// Serializes registrations and page binding. Registration is rare and happens
+// at initialization, so a minimal spin keeps this leaf library free of
+// runtime dependencies; counter increments never take this lock.
+std::atomic_flag registry_lock = ATOMIC_FLAG_INIT;
+
+class RegistryLockGuard {
+ public:
+  RegistryLockGuard() {
+    while (registry_lock.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+  ~RegistryLockGuard() { registry_lock.clear(std::memory_order_release); }
+};
+
+// Copies |name| into |slot|, truncating it to the slot's name capacity.
+void SetSlotName(PerfCounterSlot *slot, const char *name) {
+  strncpy(slot->name, name, kPerfCounterNameCapacity - 1);
+  slot->name[kPerfCounterNameCapacity - 1] = '\0';
+}
+
+}  // namespace
+
+PerfCounterRegistry *PerfCounterRegistry::GetInstance() {
+  static PerfCounterRegistry *instance = new PerfCounterRegistry();
+  return instance;
+}
+
+PerfCounterRegistry::PerfCounterRegistry() : internal_page_{} {
+  internal_page_.header.magic = kPerfCounterPageMagic;
+  internal_page_.header.version = kPerfCounterPageVersion;
+  SetSlotName(&internal_page_.slots[0], kOverflowCounterName);
+  internal_page_.header.slot_count.store(1, std::memory_order_relaxed);
+  active_page_.store(&internal_page_, std::memory_order_release);
+}
+
+PerfCounter PerfCounterRegistry::Register(const char *name) {
+  RegistryLockGuard lock;
+  PerfCounterPage *page = active_page_.load(std::memory_order_acquire);
+  const uint32_t slot_count =
+      page->header.slot_count.load(std::memory_order_relaxed);
+
+  // Registration is idempotent: return the existing slot if |name| (after
+  // truncation) is already registered.
+  char truncated[kPerfCounterNameCapacity];
+  strncpy(truncated, name, kPerfCounterNameCapacity - 1);
+  truncated[kPerfCounterNameCapacity - 1] = '\0';
+  for (uint32_t index = 1; index < slot_count; ++index) {
+    if (strcmp(page->slots[index].name, truncated) == 0) {
+      return PerfCounter(index);
+    }
+  }
+
+  // Out of slots: alias the overflow counter so increments still land
+  // somewhere visible.
+  if (slot_count >= kPerfCounterMaxSlots) {
+    return PerfCounter(0);
+  }
+
+  SetSlotName(&page->slots[slot_count], truncated);
+  page->slots[slot_count].value.store(0, std::memory_order_relaxed);
+  // Publish the slot only after its name is in place: scrapers treat
+  // slot_count as the limit of valid slots.
+  page->header.slot_count.store(slot_count + 1, std::memory_order_release);
+  return PerfCounter(slot_count);
+}
+
+void PerfCounterRegistry::BindExportPage(PerfCounterPage *page) {
+  RegistryLockGuard lock;
+  PerfCounterPage *current = active_page_.load(std::memory_order_acquire);
+  memcpy(page, current, kPerfCounterPageSize);
+  active_page_.store(page, std::memory_order_release);
+}
+
+}  // namespace asylo
@@ -0,0 +1,208 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_COMMON_PERF_COUNTERS_H_
+#define ASYLO_PLATFORM_COMMON_PERF_COUNTERS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace asylo {
+
+// A registry of enclave-wide performance counters with a single-page export
+// format.
+//
+// Subsystems (the IO manager, the thread manager, the host call layer, ...)
+// register named counters during initialization and increment them from hot
+// paths. Every counter occupies its own 64-byte slot, so concurrent
+// increments of different counters never contend on a cache line, and an
+// increment is a single relaxed atomic add.
+//
+// All counters live in one page laid out as described below. The page is
+// self-describing - a header followed by fixed-size slots that each carry the
+// counter name alongside its value - so the untrusted side can scrape every
+// counter by reading a single page of memory without entering the enclave.
+// The registry initially accumulates into an internal page; BindExportPage()
+// migrates the counters onto a caller-provided page (typically untrusted
+// memory) during enclave initialization. Counter values are plain
+// monotonically increasing totals, so exposing them to the host leaks no more
+// than the host can already observe from enclave exits; the host corrupting
+// the page corrupts only metrics.
+
+// The size of the export page and of each counter slot within it.
+constexpr size_t kPerfCounterPageSize = 4096;
+constexpr size_t kPerfCounterSlotSize = 64;
+
+// The value of PerfCounterPageHeader::magic ("ASYLOCTR", little-endian).
+constexpr uint64_t kPerfCounterPageMagic = UINT64_C(0x5254434f4c595341);
+
+// The layout version described by this header.
+constexpr uint32_t kPerfCounterPageVersion = 1;
+
+// The number of counter slots on a page. Slot 0 is reserved for the overflow
+// counter, which absorbs increments of counters that could not be registered
+// because the page was full.
+constexpr size_t kPerfCounterMaxSlots =
+    kPerfCounterPageSize / kPerfCounterSlotSize - 1;
+
+// The capacity of a slot's name field, including the terminating NUL. Longer
+// names are truncated at registration.
+constexpr size_t kPerfCounterNameCapacity =
+    kPerfCounterSlotSize - sizeof(uint64_t);
+
+// The first 64 bytes of the export page.
+struct PerfCounterPageHeader {
+  // Always kPerfCounterPageMagic. Scrapers must check this before trusting
+  // the rest of the page.
+  uint64_t magic;
+
+  // Always kPerfCounterPageVersion.
+  uint32_t version;
+
+  // The number of slots in use, including the reserved overflow slot. Only
+  // ever increases.
+  std::atomic<uint32_t> slot_count;
+
+  uint8_t reserved[kPerfCounterSlotSize - 2 * sizeof(uint64_t)];
+};
+
+static_assert(sizeof(PerfCounterPageHeader) == kPerfCounterSlotSize,
+              "PerfCounterPageHeader must fill exactly one slot");
+
+// One counter: its running total followed by its NUL-terminated name. The
+// name is written once at registration and never changes afterwards, so
+// sharing the value's cache line costs nothing.
+struct PerfCounterSlot {
+  std::atomic<uint64_t> value;
+  char name[kPerfCounterNameCapacity];
+};
+
+static_assert(sizeof(PerfCounterSlot) == kPerfCounterSlotSize,
+              "PerfCounterSlot must be exactly one cache line");
+
+// The full export page: a header followed by the counter slots.
+struct PerfCounterPage {
+  PerfCounterPageHeader header;
+  PerfCounterSlot slots[kPerfCounterMaxSlots];
+};
+
+static_assert(sizeof(PerfCounterPage) == kPerfCounterPageSize,
+              "PerfCounterPage must be exactly one page");
+
+// Returns true if |page| carries the expected magic and version. Usable from
+// either side of the enclave boundary.
+inline bool IsValidPerfCounterPage(const PerfCounterPage &page) {
+  return page.header.magic == kPerfCounterPageMagic &&
+         page.header.version == kPerfCounterPageVersion;
+}
+
+class PerfCounterRegistry;
+
+// A cheap, copyable handle to one registered counter. Obtained from
+// PerfCounterRegistry::Register(); remains valid for the lifetime of the
+// enclave, including across BindExportPage().
+class PerfCounter {
+ public:
+  // Adds |delta| to the counter. Safe to call from any thread; a single
+  // relaxed atomic add on the counter's dedicated cache line.
+  void IncrementBy(uint64_t delta);
+
+  // Adds one to the counter.
+  void Increment() { IncrementBy(1); }
+
+  // Returns the current running total.
+  uint64_t Value() const;
+
+ private:
+  friend class PerfCounterRegistry;
+
+  explicit PerfCounter(size_t slot_index) : slot_index_(slot_index) {}
+
+  // Index of the counter's slot on the active page.
+  size_t slot_index_;
+};
+
+// The process-wide counter registry. All members are safe to call from
+// multiple threads, but see the BindExportPage() constraint below.
+class PerfCounterRegistry {
+ public:
+  // Returns the singleton instance of PerfCounterRegistry.
+  static PerfCounterRegistry *GetInstance();
+
+  PerfCounterRegistry(const PerfCounterRegistry &) = delete;
+  PerfCounterRegistry &operator=(const PerfCounterRegistry &) = delete;
+
+  // Registers the counter named |name| and returns a handle to it, starting
+  // at zero. Registration is idempotent: a second registration under the same
+  // name returns a handle to the same slot. If all slots are taken the
+  // returned handle aliases the reserved overflow counter, so increments are
+  // never lost silently - a nonzero overflow counter on the page flags the
+  // exhaustion to scrapers.
+  PerfCounter Register(const char *name);
+
+  // Copies the current counters onto |page| and redirects all subsequent
+  // updates to it, making |page| the live export page. |page| is typically a
+  // page of untrusted memory obtained by the caller, which the host can then
+  // scrape with plain reads and no enclave entry.
+  //
+  // Must be called during enclave initialization, before counters are updated
+  // concurrently: increments racing with the migration may be dropped from
+  // the copied totals. May be called at most once.
+  void BindExportPage(PerfCounterPage *page);
+
+  // Returns the live export page, for in-enclave readers and tests.
+  const PerfCounterPage *active_page() const {
+    return active_page_.load(std::memory_order_acquire);
+  }
+
+ private:
+  friend class PerfCounter;
+
+  PerfCounterRegistry();
+
+  // Returns the slot backing |slot_index| on the live page.
+  PerfCounterSlot *slot(size_t slot_index) {
+    return &active_page_.load(std::memory_order_acquire)->slots[slot_index];
+  }
+  const PerfCounterSlot *slot(size_t slot_index) const {
+    return &active_page_.load(std::memory_order_acquire)->slots[slot_index];
+  }
+
+  // The page counters currently accumulate into: internal_page_ until
+  // BindExportPage() is called, the caller's page afterwards.
+  std::atomic<PerfCounterPage *> active_page_;
+
+  // In-enclave backing page used before (or in lieu of) BindExportPage().
+  alignas(kPerfCounterPageSize) PerfCounterPage internal_page_;
+};
+
+inline void PerfCounter::IncrementBy(uint64_t delta) {
+  PerfCounterRegistry::GetInstance()->slot(slot_index_)->value.fetch_add(
+      delta, std::memory_order_relaxed);
+}
+
+inline uint64_t PerfCounter::Value() const {
+  return PerfCounterRegistry::GetInstance()
+      ->slot(slot_index_)
+      ->value.load(std::memory_order_relaxed);
+}
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_COMMON_PERF_COUNTERS_H_
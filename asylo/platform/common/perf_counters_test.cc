@@ -0,0 +1,144 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/common/perf_counters.h"
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace asylo {
+namespace {
+
+// The registry is a process-wide singleton, so these tests share it and use
+// distinct counter names. BindExportPage() may be called at most once per
+// process; only BindExportPageMigratesCounters calls it, last.
+
+TEST(PerfCountersTest, PageLayoutIsOnePage) {
+  EXPECT_EQ(sizeof(PerfCounterPage), kPerfCounterPageSize);
+  EXPECT_EQ(sizeof(PerfCounterSlot), kPerfCounterSlotSize);
+}
+
+TEST(PerfCountersTest, InternalPageIsValidAndHasOverflowSlot) {
+  const PerfCounterPage *page =
+      PerfCounterRegistry::GetInstance()->active_page();
+  ASSERT_NE(page, nullptr);
+  EXPECT_TRUE(IsValidPerfCounterPage(*page));
+  EXPECT_GE(page->header.slot_count.load(), 1);
+  EXPECT_STREQ(page->slots[0].name, "perf.overflow");
+}
+
+TEST(PerfCountersTest, RegisteredCounterStartsAtZeroAndCounts) {
+  PerfCounter counter =
+      PerfCounterRegistry::GetInstance()->Register("test.basic");
+  EXPECT_EQ(counter.Value(), 0);
+  counter.Increment();
+  counter.IncrementBy(41);
+  EXPECT_EQ(counter.Value(), 42);
+}
+
+TEST(PerfCountersTest, RegistrationIsIdempotent) {
+  PerfCounter first =
+      PerfCounterRegistry::GetInstance()->Register("test.idempotent");
+  first.IncrementBy(7);
+  PerfCounter second =
+      PerfCounterRegistry::GetInstance()->Register("test.idempotent");
+  EXPECT_EQ(second.Value(), 7);
+  second.Increment();
+  EXPECT_EQ(first.Value(), 8);
+}
+
+TEST(PerfCountersTest, LongNamesAreTruncatedConsistently) {
+  std::string long_name(2 * kPerfCounterNameCapacity, 'x');
+  PerfCounter first =
+      PerfCounterRegistry::GetInstance()->Register(long_name.c_str());
+  first.Increment();
+  // A name that differs only past the truncation point maps to the same slot.
+  long_name.back() = 'y';
+  PerfCounter second =
+      PerfCounterRegistry::GetInstance()->Register(long_name.c_str());
+  EXPECT_EQ(second.Value(), 1);
+}
+
+TEST(PerfCountersTest, CounterNameAppearsOnPage) {
+  PerfCounter counter =
+      PerfCounterRegistry::GetInstance()->Register("test.named");
+  counter.IncrementBy(3);
+  const PerfCounterPage *page =
+      PerfCounterRegistry::GetInstance()->active_page();
+  const uint32_t slot_count = page->header.slot_count.load();
+  bool found = false;
+  for (uint32_t index = 1; index < slot_count; ++index) {
+    if (strcmp(page->slots[index].name, "test.named") == 0) {
+      EXPECT_EQ(page->slots[index].value.load(), 3);
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST(PerfCountersTest, ConcurrentIncrementsAreNotLost) {
+  PerfCounter counter =
+      PerfCounterRegistry::GetInstance()->Register("test.concurrent");
+  constexpr int kThreads = 8;
+  constexpr int kIncrementsPerThread = 10000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([counter]() mutable {
+      for (int j = 0; j < kIncrementsPerThread; ++j) {
+        counter.Increment();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.Value(), kThreads * kIncrementsPerThread);
+}
+
+TEST(PerfCountersTest, BindExportPageMigratesCounters) {
+  PerfCounter counter =
+      PerfCounterRegistry::GetInstance()->Register("test.migrated");
+  counter.IncrementBy(5);
+
+  // Deliberately leaked: the registry points at the bound page for the
+  // remainder of the process.
+  PerfCounterPage *page = new PerfCounterPage();
+  PerfCounterRegistry::GetInstance()->BindExportPage(page);
+
+  // Existing totals carry over and new increments land on the bound page.
+  EXPECT_EQ(counter.Value(), 5);
+  counter.Increment();
+  EXPECT_EQ(PerfCounterRegistry::GetInstance()->active_page(), page);
+  EXPECT_TRUE(IsValidPerfCounterPage(*page));
+  const uint32_t slot_count = page->header.slot_count.load();
+  bool found = false;
+  for (uint32_t index = 1; index < slot_count; ++index) {
+    if (strcmp(page->slots[index].name, "test.migrated") == 0) {
+      EXPECT_EQ(page->slots[index].value.load(), 6);
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+}  // namespace
+}  // namespace asylo
@@ -56,6 +56,9 @@ namespace asylo {
 //
 // RingBuffer<kCapacity>::TypeVersion() == instance->InstanceVersion();
 //
+// The shared byte counter and the reader- and writer-owned indices are each
+// placed on their own cache line, so that index updates by one side do not
+// invalidate the line holding the other side's index (false sharing).
 
 // Exposes NonBlockingRead/Write for testing.
 template <size_t kCapacity>
@@ -167,19 +170,26 @@ class RingBuffer {
   // Returns a signature reflecting the layout of this concrete instance.
   uint64_t InstanceVersion() const { return instance_version_; }
 
-  // Returns a signature reflecting the layout of this abstract type.
+  // Returns a signature reflecting the layout of this abstract type. The
+  // capacity is mixed in explicitly because cache-line padding rounds the
+  // sizes of small instances to the same value.
   static constexpr uint64_t TypeVersion() {
     return offsetof(RingBuffer, count_) << 0 |
            offsetof(RingBuffer, closed_for_read_) << 8 |
            offsetof(RingBuffer, closed_for_write_) << 16 |
            offsetof(RingBuffer, read_pos_) << 24 |
            offsetof(RingBuffer, write_pos_) << 32 |
-           offsetof(RingBuffer, buffer_) << 40 | sizeof(RingBuffer) << 48;
+           offsetof(RingBuffer, buffer_) << 40 | sizeof(RingBuffer) << 48 |
+           kCapacity << 56;
   }
 
  private:
   friend class RingBufferForTest<kCapacity>;
 
+  // Size in bytes of a cache line on the architectures Asylo supports. Used to
+  // pad fields written by different threads apart from each other.
+  static constexpr size_t kCacheLineSize = 64;
+
   // Reads up to |nbyte| bytes without blocking, returning the number
   // successfully read.
   size_t NonBlockingRead(uint8_t *buf, size_t nbyte) {
@@ -251,9 +261,12 @@ class RingBuffer {
   const uint64_t instance_version_;         // Layout of the struct.
   std::atomic<uint32_t> closed_for_read_;   // Reader is done reading.
   std::atomic<uint32_t> closed_for_write_;  // Writer is done writing.
-  std::atomic<size_t> count_;  // Number of bytes waiting in the queue.
-  volatile size_t read_pos_;   // Read index into buffer_.
-  volatile size_t write_pos_;  // Write index into buffer_.
+  // Number of bytes waiting in the queue. Updated by both sides.
+  alignas(kCacheLineSize) std::atomic<size_t> count_;
+  // Read index into buffer_. Updated only by the reader.
+  alignas(kCacheLineSize) volatile size_t read_pos_;
+  // Write index into buffer_. Updated only by the writer.
+  alignas(kCacheLineSize) volatile size_t write_pos_;
   std::array<uint8_t, kCapacity> buffer_;
 } __attribute__((aligned(8)));  // Ensure 64-bit alignment;
 
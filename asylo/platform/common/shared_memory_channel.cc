@@ -0,0 +1,123 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/common/shared_memory_channel.h"
+
+#include <cstring>
+
+#include "asylo/platform/common/futex.h"
+
+namespace asylo {
+
+namespace {
+
+// Reinterprets an atomic sequence word as the bare int32_t the futex calls
+// expect. The static_assert in the class definition guarantees the layouts
+// match.
+int32_t *FutexWord(std::atomic<int32_t> *sequence) {
+  return reinterpret_cast<int32_t *>(sequence);
+}
+
+}  // namespace
+
+bool SharedMemoryChannel::Send(const uint8_t *data, size_t size) {
+  if (size > kMaxMessageSize) {
+    return false;
+  }
+  const size_t frame_size = kHeaderSize + size;
+
+  // Sleep until the whole frame fits. Space only grows while the single
+  // sender is not writing, so re-checking after recording the sequence closes
+  // the race against a concurrent receiver reclaiming space before the wait.
+  while (ring_.available() < frame_size) {
+    if (ring_.is_closed_for_read() || ring_.is_closed_for_write()) {
+      return false;
+    }
+    int32_t seen = space_sequence_.load(std::memory_order_acquire);
+    if (ring_.available() < frame_size) {
+      sys_futex_wait(FutexWord(&space_sequence_), seen,
+                     /*timeout_microsec=*/0);
+    }
+  }
+
+  uint64_t header = size;
+  if (ring_.Write(reinterpret_cast<const uint8_t *>(&header), kHeaderSize) !=
+      kHeaderSize) {
+    return false;
+  }
+  if (ring_.Write(data, size) != size) {
+    return false;
+  }
+  data_sequence_.fetch_add(1, std::memory_order_release);
+  sys_futex_wake(FutexWord(&data_sequence_), 1);
+  return true;
+}
+
+bool SharedMemoryChannel::Receive(std::vector<uint8_t> *message) {
+  // Sleep while the channel is idle rather than spinning in RingBuffer::Read.
+  while (ring_.empty()) {
+    if (ring_.is_closed_for_write()) {
+      return false;
+    }
+    int32_t seen = data_sequence_.load(std::memory_order_acquire);
+    if (ring_.empty() && !ring_.is_closed_for_write()) {
+      sys_futex_wait(FutexWord(&data_sequence_), seen, /*timeout_microsec=*/0);
+    }
+  }
+
+  uint64_t header;
+  if (ring_.Read(reinterpret_cast<uint8_t *>(&header), kHeaderSize) !=
+      kHeaderSize) {
+    return false;
+  }
+  // The length prefix comes out of shared memory and is untrusted. A value
+  // the sender could not have written means the ring was corrupted; close the
+  // channel rather than resynchronize on attacker-controlled framing.
+  if (header > kMaxMessageSize) {
+    Close();
+    return false;
+  }
+  message->resize(header);
+  if (ring_.Read(message->data(), header) != header) {
+    return false;
+  }
+  space_sequence_.fetch_add(1, std::memory_order_release);
+  sys_futex_wake(FutexWord(&space_sequence_), 1);
+  return true;
+}
+
+void SharedMemoryChannel::Close() {
+  ring_.close_for_read();
+  ring_.close_for_write();
+  // Bump both sequences before waking so that an endpoint racing toward
+  // sys_futex_wait observes a stale expected value and returns immediately.
+  data_sequence_.fetch_add(1, std::memory_order_release);
+  space_sequence_.fetch_add(1, std::memory_order_release);
+  sys_futex_wake(FutexWord(&data_sequence_), INT32_MAX);
+  sys_futex_wake(FutexWord(&space_sequence_), INT32_MAX);
+}
+
+void SharedMemoryChannel::CloseForSend() {
+  // Only the write side closes, so a receiver still drains buffered frames
+  // before Receive() reports end-of-stream.
+  ring_.close_for_write();
+  data_sequence_.fetch_add(1, std::memory_order_release);
+  sys_futex_wake(FutexWord(&data_sequence_), INT32_MAX);
+}
+
+}  // namespace asylo
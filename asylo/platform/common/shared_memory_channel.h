@@ -0,0 +1,102 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_COMMON_SHARED_MEMORY_CHANNEL_H_
+#define ASYLO_PLATFORM_COMMON_SHARED_MEMORY_CHANNEL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "asylo/platform/common/ring_buffer.h"
+
+namespace asylo {
+
+// Capacity in bytes of one direction of a shared-memory message channel.
+constexpr size_t kSharedMemoryChannelCapacity = 64 * 1024;
+
+// One direction of a message-oriented channel between two endpoints that share
+// physical memory, such as two enclaves on the same host. The object must be
+// allocated in memory addressable by both endpoints, and supports exactly one
+// sender and one receiver.
+//
+// Messages are length-prefixed byte strings carried over a RingBuffer. Unlike
+// the bare RingBuffer, which spins when it has nothing to do, endpoints park
+// in the kernel on a futex: an idle receiver sleeps until a message arrives,
+// and a sender blocked on a full ring sleeps until the receiver reclaims
+// space.
+//
+// The channel inherits the security posture of RingBuffer: the buffer contents
+// are untrusted, and nothing a peer writes into shared memory can cause this
+// code to access memory outside the channel object or a caller-supplied
+// buffer.
+class SharedMemoryChannel {
+ public:
+  using Buffer = RingBuffer<kSharedMemoryChannelCapacity>;
+
+  // Size in bytes of the length prefix preceding each message in the ring.
+  static constexpr size_t kHeaderSize = sizeof(uint64_t);
+
+  // The largest message Send() accepts. A message and its length prefix must
+  // fit in the ring in one piece.
+  static constexpr size_t kMaxMessageSize =
+      kSharedMemoryChannelCapacity - kHeaderSize;
+
+  SharedMemoryChannel() = default;
+
+  SharedMemoryChannel(const SharedMemoryChannel &) = delete;
+  SharedMemoryChannel &operator=(const SharedMemoryChannel &) = delete;
+
+  // Writes one message of |size| bytes from |data| to the channel, blocking
+  // until the ring has space for the whole frame. Returns false if |size|
+  // exceeds kMaxMessageSize or the channel was closed.
+  bool Send(const uint8_t *data, size_t size);
+
+  // Reads one whole message from the channel into |message|, resizing it to
+  // fit, and blocks while the channel is empty. Returns false if the channel
+  // was closed or the ring contents were corrupted.
+  bool Receive(std::vector<uint8_t> *message);
+
+  // Closes the channel in both directions and wakes any blocked endpoint.
+  // Either endpoint may call Close(); subsequent Send() and Receive() calls
+  // fail. Messages still buffered in the ring are discarded.
+  void Close();
+
+  // Marks the end of the message stream from the sender side and wakes a
+  // blocked receiver. Unlike Close(), messages already buffered in the ring
+  // remain receivable; Receive() returns false once they are drained.
+  void CloseForSend();
+
+ private:
+  Buffer ring_;
+
+  // Futex words signalling, respectively, that the sender produced data and
+  // that the receiver reclaimed space. Each is incremented by one side and
+  // slept on by the other, so neither line ping-pongs in the common
+  // non-blocking case.
+  std::atomic<int32_t> data_sequence_{0};
+  std::atomic<int32_t> space_sequence_{0};
+
+  static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t),
+                "std::atomic<int32_t> is not lock free.");
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_COMMON_SHARED_MEMORY_CHANNEL_H_
@@ -0,0 +1,147 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/common/shared_memory_channel.h"
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/memory/memory.h"
+
+namespace asylo {
+namespace {
+
+std::vector<uint8_t> MakeMessage(size_t size, uint8_t seed) {
+  std::vector<uint8_t> message(size);
+  for (size_t i = 0; i < size; ++i) {
+    message[i] = static_cast<uint8_t>(seed + i);
+  }
+  return message;
+}
+
+TEST(SharedMemoryChannelTest, SendThenReceive) {
+  auto channel = absl::make_unique<SharedMemoryChannel>();
+  const std::vector<uint8_t> sent = MakeMessage(100, 7);
+  ASSERT_TRUE(channel->Send(sent.data(), sent.size()));
+
+  std::vector<uint8_t> received;
+  ASSERT_TRUE(channel->Receive(&received));
+  EXPECT_EQ(received, sent);
+}
+
+TEST(SharedMemoryChannelTest, EmptyMessageRoundTrips) {
+  auto channel = absl::make_unique<SharedMemoryChannel>();
+  ASSERT_TRUE(channel->Send(nullptr, 0));
+
+  std::vector<uint8_t> received(10, 1);
+  ASSERT_TRUE(channel->Receive(&received));
+  EXPECT_TRUE(received.empty());
+}
+
+TEST(SharedMemoryChannelTest, OversizedMessageIsRejected) {
+  auto channel = absl::make_unique<SharedMemoryChannel>();
+  const std::vector<uint8_t> message =
+      MakeMessage(SharedMemoryChannel::kMaxMessageSize + 1, 0);
+  EXPECT_FALSE(channel->Send(message.data(), message.size()));
+}
+
+TEST(SharedMemoryChannelTest, ReceiverBlocksUntilMessageArrives) {
+  auto channel = absl::make_unique<SharedMemoryChannel>();
+  const std::vector<uint8_t> sent = MakeMessage(1000, 3);
+
+  std::vector<uint8_t> received;
+  std::thread receiver(
+      [&]() { ASSERT_TRUE(channel->Receive(&received)); });
+  std::thread sender(
+      [&]() { ASSERT_TRUE(channel->Send(sent.data(), sent.size())); });
+  sender.join();
+  receiver.join();
+  EXPECT_EQ(received, sent);
+}
+
+TEST(SharedMemoryChannelTest, BackpressureBlocksSenderUntilSpaceReclaimed) {
+  auto channel = absl::make_unique<SharedMemoryChannel>();
+  // More traffic than the ring holds at once, so the sender must block on a
+  // full ring and be woken as the receiver drains it.
+  constexpr size_t kMessageSize = SharedMemoryChannel::kMaxMessageSize / 2;
+  constexpr int kMessageCount = 64;
+
+  std::thread sender([&]() {
+    for (int i = 0; i < kMessageCount; ++i) {
+      const std::vector<uint8_t> message =
+          MakeMessage(kMessageSize, static_cast<uint8_t>(i));
+      ASSERT_TRUE(channel->Send(message.data(), message.size()));
+    }
+  });
+
+  for (int i = 0; i < kMessageCount; ++i) {
+    std::vector<uint8_t> received;
+    ASSERT_TRUE(channel->Receive(&received));
+    EXPECT_EQ(received, MakeMessage(kMessageSize, static_cast<uint8_t>(i)));
+  }
+  sender.join();
+}
+
+TEST(SharedMemoryChannelTest, CloseUnblocksReceiver) {
+  auto channel = absl::make_unique<SharedMemoryChannel>();
+
+  std::thread receiver([&]() {
+    std::vector<uint8_t> received;
+    EXPECT_FALSE(channel->Receive(&received));
+  });
+  channel->Close();
+  receiver.join();
+}
+
+TEST(SharedMemoryChannelTest, CloseForSendDrainsBufferedMessages) {
+  auto channel = absl::make_unique<SharedMemoryChannel>();
+  const std::vector<uint8_t> first = MakeMessage(50, 1);
+  const std::vector<uint8_t> second = MakeMessage(60, 2);
+  ASSERT_TRUE(channel->Send(first.data(), first.size()));
+  ASSERT_TRUE(channel->Send(second.data(), second.size()));
+  channel->CloseForSend();
+
+  // Buffered messages survive the close; only then does the receiver see
+  // end-of-stream.
+  std::vector<uint8_t> received;
+  ASSERT_TRUE(channel->Receive(&received));
+  EXPECT_EQ(received, first);
+  ASSERT_TRUE(channel->Receive(&received));
+  EXPECT_EQ(received, second);
+  EXPECT_FALSE(channel->Receive(&received));
+}
+
+TEST(SharedMemoryChannelTest, SendAfterCloseForSendFails) {
+  auto channel = absl::make_unique<SharedMemoryChannel>();
+  channel->CloseForSend();
+  const std::vector<uint8_t> message = MakeMessage(10, 0);
+  EXPECT_FALSE(channel->Send(message.data(), message.size()));
+}
+
+TEST(SharedMemoryChannelTest, SendAfterCloseFails) {
+  auto channel = absl::make_unique<SharedMemoryChannel>();
+  channel->Close();
+  const std::vector<uint8_t> message = MakeMessage(10, 0);
+  EXPECT_FALSE(channel->Send(message.data(), message.size()));
+}
+
+}  // namespace
+}  // namespace asylo
@@ -109,6 +109,7 @@
 //
 //   DEFINE_STATIC_MAP_OF_BASE_TYPE(BaseMap, Base, BaseNamer)
 
+#include <atomic>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -156,6 +157,16 @@ struct Namer;
 // might not be available, we use std::unordered_map instead of
 // absl::flat_hash_map to prevent unsafe system calls made by absl based
 // containers.
+//
+// Elements are only ever inserted, by static initializers. Each insertion
+// publishes a new immutable snapshot of the map through an atomic pointer, so
+// lookups and iteration never take a lock: they read the current snapshot,
+// which is never mutated after publication. This matters for registries
+// queried on hot paths, such as the error-space map consulted for every
+// non-OK Status and the assertion authority maps consulted on every
+// handshake. Superseded snapshots are intentionally leaked, which bounds the
+// leak by the number of registered types and keeps outstanding iterators
+// valid forever.
 template <class MapName, class T, class N = Namer<T>>
 class StaticMap {
  public:
@@ -178,113 +189,108 @@ class StaticMap {
 
       absl::MutexLock lock(&StaticMap::mu_);
 
-      // First-time map initialization.
-      StaticMap::Initialize();
+      // Build a new snapshot containing the existing entries plus |value|,
+      // then publish it. The superseded snapshot is intentionally leaked:
+      // readers may still be consulting it, and insertions only happen during
+      // static initialization, so the leak is bounded by the number of
+      // registered types.
+      std::unordered_map<std::string, T *> *old_map =
+          StaticMap::map_.load(std::memory_order_relaxed);
+      auto *new_map = old_map == nullptr
+                          ? new std::unordered_map<std::string, T *>()
+                          : new std::unordered_map<std::string, T *>(*old_map);
 
       // Retrieve a unique string identifier for this object that can be used as
       // a key in the map.
       std::string key = StaticMap::namer_(*value);
-      if (!StaticMap::map_->emplace(key, value).second) {
+      if (!new_map->emplace(key, value).second) {
         LOG(FATAL) << "Adding duplicate key " << key << " to static map";
       }
+
+      StaticMap::map_.store(new_map, std::memory_order_release);
     }
   };
 
-  // ValueCollection is a zero-byte helper class that represents the collection
-  // of values stored in a static map. This class defines various iterator
-  // generators that enable iterating over the collection of values.
+  // ValueCollection is a helper class that represents the collection of
+  // values stored in a static map. It captures the map snapshot that is
+  // current at construction time, so all iterators it generates refer to one
+  // consistent view of the map and never require locking.
   class ValueCollection {
    public:
     using iterator = StaticMap::value_iterator;
     using const_iterator = StaticMap::const_value_iterator;
 
-    ValueCollection() ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-      absl::MutexLock lock(&StaticMap::mu_);
+    ValueCollection() : map_(StaticMap::CurrentMap()) {}
 
-      // First-time map initialization.
-      StaticMap::Initialize();
-    }
+    iterator begin() { return iterator(map_->begin()); }
+    const_iterator begin() const { return const_iterator(map_->cbegin()); }
+    const_iterator cbegin() const { return const_iterator(map_->cbegin()); }
+    iterator end() { return iterator(map_->end()); }
+    const_iterator end() const { return const_iterator(map_->cend()); }
+    const_iterator cend() const { return const_iterator(map_->cend()); }
 
-    iterator begin() ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-      absl::MutexLock lock(&StaticMap::mu_);
-      return iterator(StaticMap::map_->begin());
-    }
-    const_iterator begin() const ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-      absl::MutexLock lock(&StaticMap::mu_);
-      return const_iterator(StaticMap::map_->cbegin());
-    }
-    const_iterator cbegin() const ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-      absl::MutexLock lock(&StaticMap::mu_);
-      return const_iterator(StaticMap::map_->cbegin());
-    }
-    iterator end() ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-      absl::MutexLock lock(&StaticMap::mu_);
-      return iterator(StaticMap::map_->end());
-    }
-    const_iterator end() const ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-      absl::MutexLock lock(&StaticMap::mu_);
-      return const_iterator(StaticMap::map_->cend());
-    }
-    const_iterator cend() const ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-      absl::MutexLock lock(&StaticMap::mu_);
-      return const_iterator(StaticMap::map_->cend());
-    }
+   private:
+    // The snapshot captured at construction time. Snapshots are never
+    // destroyed, so the pointer remains valid indefinitely.
+    std::unordered_map<std::string, T *> *map_;
   };
 
   // Returns a ValueCollection object representing the values stored in the
   // static map.
-  static ValueCollection Values() ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-    return ValueCollection();
-  }
+  static ValueCollection Values() { return ValueCollection(); }
 
-  static value_iterator value_begin() ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-    return Values().begin();
-  }
-  static value_iterator value_end() ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-    return Values().end();
-  }
-  static const_value_iterator value_cbegin()
-      ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-    return Values().cbegin();
-  }
-  static const_value_iterator value_cend() ABSL_LOCKS_EXCLUDED(StaticMap::mu_) {
-    return Values().cend();
-  }
+  static value_iterator value_begin() { return Values().begin(); }
+  static value_iterator value_end() { return Values().end(); }
+  static const_value_iterator value_cbegin() { return Values().cbegin(); }
+  static const_value_iterator value_cend() { return Values().cend(); }
 
   // Returns the value_iterator pointing to the T value associated with |key|.
   // Returns value_end() if |key| is not present.
+  //
+  // Lookups are lock-free: they consult the snapshot that is current when the
+  // call is made. Iterators obtained from different snapshots compare
+  // correctly once static initialization has finished, since no further
+  // snapshots are published after that point.
   static value_iterator GetValue(const std::string &key) {
-    absl::MutexLock lock(&StaticMap::mu_);
-
-    // First-time map initialization.
-    Initialize();
-
-    return value_iterator(StaticMap::map_->find(key));
+    return value_iterator(CurrentMap()->find(key));
   }
 
-  static size_t Size() {
-    absl::MutexLock lock(&StaticMap::mu_);
-
-    // First-time map initialization.
-    Initialize();
-
-    return StaticMap::map_->size();
-  }
+  static size_t Size() { return CurrentMap()->size(); }
 
  private:
-  static void Initialize() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    if (map_ == nullptr) {
-      map_ = new std::unordered_map<std::string, T *>();
+  // Returns the current map snapshot without locking, publishing an empty
+  // snapshot first if no value has been inserted yet.
+  static std::unordered_map<std::string, T *> *CurrentMap() {
+    std::unordered_map<std::string, T *> *map =
+        map_.load(std::memory_order_acquire);
+    if (map != nullptr) {
+      return map;
     }
+
+    // First-time initialization of an empty map. Synchronizes with
+    // ValueInserter in case a static initializer is registering a value
+    // concurrently.
+    absl::MutexLock lock(&mu_);
+    map = map_.load(std::memory_order_relaxed);
+    if (map == nullptr) {
+      map = new std::unordered_map<std::string, T *>();
+      map_.store(map, std::memory_order_release);
+    }
+    return map;
   }
-  static std::unordered_map<std::string, T *> *map_ ABSL_GUARDED_BY(mu_)
-      ABSL_PT_GUARDED_BY(mu_);
+
+  // The current map snapshot. Never modified after publication; replaced
+  // wholesale by ValueInserter.
+  static std::atomic<std::unordered_map<std::string, T *> *> map_;
+
+  // Serializes snapshot publication. Lookups do not take this lock.
   static absl::Mutex mu_;
   static N namer_;
 };
 
 template <class MapName, class T, class N>
-std::unordered_map<std::string, T *> *StaticMap<MapName, T, N>::map_ = nullptr;
+std::atomic<std::unordered_map<std::string, T *> *>
+    StaticMap<MapName, T, N>::map_{nullptr};
 
 template <class MapName, class T, class N>
 absl::Mutex StaticMap<MapName, T, N>::mu_;
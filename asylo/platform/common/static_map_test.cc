@@ -18,6 +18,8 @@
 
 #include <algorithm>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "asylo/platform/common/static_map.h"
@@ -203,6 +205,28 @@ TEST(StaticMapTest, TestAlgorithmIterator) {
   EXPECT_EQ(yam_it, values.end());
 }
 
+// Tests that lookups from many threads are safe and all succeed. Lookups on an
+// initialized map share the lock, so concurrent readers do not serialize.
+TEST(StaticMapTest, TestConcurrentLookups) {
+  constexpr int kThreads = 8;
+  constexpr int kLookupsPerThread = 1000;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < kLookupsPerThread; ++j) {
+        auto bar = FooMap::GetValue("Bar");
+        ASSERT_NE(bar, FooMap::value_end());
+        EXPECT_EQ(bar->Name(), "Bar");
+        EXPECT_EQ(FooMap::GetValue("BadFoo"), FooMap::value_end());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
 // Tests that an input-iterator-based algorithm can be called using the
 // immutable static-map iterator.
 TEST(StaticMapTest, TestAlgorithmConstIterator) {
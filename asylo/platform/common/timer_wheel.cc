@@ -0,0 +1,175 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/common/timer_wheel.h"
+
+#include <atomic>
+
+namespace asylo {
+namespace {
+
+// Serializes slot list manipulation. Critical sections are short pointer
+// updates, so a minimal spin keeps this leaf library free of runtime
+// dependencies; wake functions are always invoked outside the lock.
+std::atomic_flag wheel_lock = ATOMIC_FLAG_INIT;
+
+class WheelLockGuard {
+ public:
+  WheelLockGuard() {
+    while (wheel_lock.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+  ~WheelLockGuard() { wheel_lock.clear(std::memory_order_release); }
+};
+
+// Expired entries are unlinked under the lock and woken after it is released,
+// in batches of this size. A sweep that fills a batch runs again, so the cap
+// bounds stack usage rather than the number of timers fired per tick.
+constexpr int kMaxWakesPerSweep = 64;
+
+}  // namespace
+
+TimerWheel *TimerWheel::GetInstance() {
+  static TimerWheel *instance = new TimerWheel();
+  return instance;
+}
+
+void TimerWheel::Schedule(TimerWheelEntry *entry, int32_t *futex,
+                          TimerWheelWakeFunction wake,
+                          uint64_t deadline_micros) {
+  WheelLockGuard lock;
+  entry->futex = futex;
+  entry->wake = wake;
+  entry->deadline_micros = deadline_micros;
+  entry->linked = true;
+
+  // An already-due deadline hashes to a slot the cursor may have passed, so
+  // clamp it to the cursor's slot; the sweep visits that slot on every tick.
+  uint64_t slot_tick = deadline_micros >> kTimerWheelSlotShift;
+  if (slot_tick < cursor_) {
+    slot_tick = cursor_;
+  }
+  TimerWheelEntry **slot = &slots_[slot_tick & (kTimerWheelSlots - 1)];
+  entry->prev = nullptr;
+  entry->next = *slot;
+  if (*slot) {
+    (*slot)->prev = entry;
+  }
+  *slot = entry;
+  ++num_pending_;
+}
+
+void TimerWheel::Cancel(TimerWheelEntry *entry) {
+  WheelLockGuard lock;
+  if (!entry->linked) {
+    return;
+  }
+  if (entry->prev) {
+    entry->prev->next = entry->next;
+  } else {
+    // The entry heads its slot list. The slot it was clamped into depends on
+    // the cursor position at Schedule() time, so locate it by scanning the
+    // slot heads rather than recomputing the hash.
+    for (size_t i = 0; i < kTimerWheelSlots; ++i) {
+      if (slots_[i] == entry) {
+        slots_[i] = entry->next;
+        break;
+      }
+    }
+  }
+  if (entry->next) {
+    entry->next->prev = entry->prev;
+  }
+  entry->prev = nullptr;
+  entry->next = nullptr;
+  entry->linked = false;
+  --num_pending_;
+}
+
+int TimerWheel::Advance(uint64_t now_micros) {
+  int total_fired = 0;
+  FiredWake fired[kMaxWakesPerSweep];
+  while (true) {
+    const int count = CollectExpired(now_micros, fired, kMaxWakesPerSweep);
+    for (int i = 0; i < count; ++i) {
+      fired[i].wake(fired[i].futex);
+    }
+    total_fired += count;
+    if (count < kMaxWakesPerSweep) {
+      return total_fired;
+    }
+  }
+}
+
+int TimerWheel::CollectExpired(uint64_t now_micros, FiredWake *fired,
+                               int capacity) {
+  WheelLockGuard lock;
+  now_micros_.store(now_micros, std::memory_order_relaxed);
+  const uint64_t now_tick = now_micros >> kTimerWheelSlotShift;
+  if (now_tick < cursor_) {
+    // Time regressed (e.g. a host clock step); resume sweeping from the new
+    // position. Pending entries ahead of it fire once time catches up again.
+    cursor_ = now_tick;
+  }
+
+  // Sweep every slot between the cursor and now, inclusive on both ends so
+  // that entries clamped onto the cursor's slot are picked up. A gap longer
+  // than one revolution revisits slots, which is harmless.
+  uint64_t steps = now_tick - cursor_ + 1;
+  if (steps > kTimerWheelSlots) {
+    steps = kTimerWheelSlots;
+  }
+  int count = 0;
+  for (uint64_t i = 0; i < steps; ++i) {
+    TimerWheelEntry **slot = &slots_[(cursor_ + i) & (kTimerWheelSlots - 1)];
+    TimerWheelEntry *entry = *slot;
+    while (entry) {
+      TimerWheelEntry *next = entry->next;
+      if (entry->deadline_micros <= now_micros) {
+        if (entry->prev) {
+          entry->prev->next = entry->next;
+        } else {
+          *slot = entry->next;
+        }
+        if (entry->next) {
+          entry->next->prev = entry->prev;
+        }
+        entry->prev = nullptr;
+        entry->next = nullptr;
+        entry->linked = false;
+        --num_pending_;
+        fired[count++] = {entry->wake, entry->futex};
+        if (count == capacity) {
+          // Leave the cursor untouched; the next sweep revisits this range
+          // and collects the remaining expired entries.
+          return count;
+        }
+      }
+      entry = next;
+    }
+  }
+  cursor_ = now_tick;
+  return count;
+}
+
+size_t TimerWheel::NumPending() {
+  WheelLockGuard lock;
+  return num_pending_;
+}
+
+}  // namespace asylo
@@ -0,0 +1,137 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_COMMON_TIMER_WHEEL_H_
+#define ASYLO_PLATFORM_COMMON_TIMER_WHEEL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace asylo {
+
+// Hashed timing wheel for in-enclave timeout management. Timed waiters hash
+// their deadline into one of the wheel's slots and park without arming a host
+// timer; a single coarse periodic tick advances the wheel and wakes every
+// expired waiter, so thousands of concurrent timeouts consume one tick per
+// interval instead of one host timer each.
+//
+// The wheel is a pure data structure with no runtime dependencies: waiters
+// supply their own wake function with each entry, and whoever drives the tick
+// supplies the current time to Advance(). Entries are intrusive and owned by
+// the scheduling thread, which must keep the entry alive until Cancel()
+// returns or the wheel fires it.
+
+// Number of slots in the wheel. Must be a power of two.
+constexpr size_t kTimerWheelSlots = 256;
+
+// Width of one slot in microseconds, expressed as a shift so that slot
+// selection is a shift and mask. 1 << 13 microseconds is ~8.2ms, giving the
+// wheel a revolution of ~2.1 seconds; longer deadlines simply stay in their
+// slot across revolutions until they come due.
+constexpr int kTimerWheelSlotShift = 13;
+constexpr uint64_t kTimerWheelSlotMicros = 1ull << kTimerWheelSlotShift;
+
+// One revolution of the wheel in microseconds.
+constexpr uint64_t kTimerWheelRevolutionMicros =
+    kTimerWheelSlotMicros * kTimerWheelSlots;
+
+// Wakes the waiters parked on |futex| after their deadline expired.
+using TimerWheelWakeFunction = void (*)(int32_t *futex);
+
+// An intrusive timer record, typically stack-allocated by the waiting thread.
+// All fields are managed by the wheel; callers only pass the entry to
+// Schedule() and Cancel().
+struct TimerWheelEntry {
+  int32_t *futex = nullptr;
+  TimerWheelWakeFunction wake = nullptr;
+  uint64_t deadline_micros = 0;
+  TimerWheelEntry *prev = nullptr;
+  TimerWheelEntry *next = nullptr;
+
+  // True while the entry is linked into a slot. Distinguishes a pending entry
+  // from one that already fired or was cancelled.
+  bool linked = false;
+};
+
+class TimerWheel {
+ public:
+  TimerWheel() = default;
+  TimerWheel(const TimerWheel &) = delete;
+  TimerWheel &operator=(const TimerWheel &) = delete;
+
+  // Returns the process-wide wheel driven by the runtime's tick entry point.
+  static TimerWheel *GetInstance();
+
+  // Links |entry| into the wheel to wake |futex| via |wake| once Advance()
+  // observes a time of at least |deadline_micros|. |entry| must be unlinked
+  // and must outlive the wait; the caller unlinks it with Cancel() after
+  // waking. A deadline at or before the latest Advance() time fires on the
+  // next tick.
+  void Schedule(TimerWheelEntry *entry, int32_t *futex,
+                TimerWheelWakeFunction wake, uint64_t deadline_micros);
+
+  // Unlinks |entry| if it is still pending. A no-op for an entry that already
+  // fired or was never scheduled, so waiters may call this unconditionally
+  // after waking.
+  void Cancel(TimerWheelEntry *entry);
+
+  // Advances the wheel to |now_micros|, firing every pending entry whose
+  // deadline has been reached. Wake functions are invoked without the wheel's
+  // internal lock held. Returns the number of entries fired.
+  int Advance(uint64_t now_micros);
+
+  // Time of the latest Advance() call, in microseconds. Serves as the wheel's
+  // coarse notion of "now" so waiters can form absolute deadlines without a
+  // clock read of their own; its error is bounded by the tick interval.
+  uint64_t Now() const { return now_micros_.load(std::memory_order_relaxed); }
+
+  // True once the wheel has received at least one tick. Waiters fall back to
+  // host-side timeouts until a tick source is running.
+  bool active() const { return Now() != 0; }
+
+  // Number of entries currently linked into the wheel.
+  size_t NumPending();
+
+ private:
+  // A fired entry's wake call, copied out under the lock. Once an entry is
+  // unlinked its owner may wake for other reasons and reclaim it, so the wake
+  // must not dereference the entry after the lock is released.
+  struct FiredWake {
+    TimerWheelWakeFunction wake;
+    int32_t *futex;
+  };
+
+  // Unlinks expired entries starting at the slot cursor, up to the capacity
+  // of |fired|. Returns the number collected; a full batch leaves the cursor
+  // in place so the next sweep revisits the remaining expired entries.
+  int CollectExpired(uint64_t now_micros, FiredWake *fired, int capacity);
+
+  std::atomic<uint64_t> now_micros_{0};
+
+  // Slot index (in units of slot widths, not yet masked) up to which the
+  // wheel has been swept.
+  uint64_t cursor_ = 0;
+
+  TimerWheelEntry *slots_[kTimerWheelSlots] = {};
+  size_t num_pending_ = 0;
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_COMMON_TIMER_WHEEL_H_
@@ -0,0 +1,156 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/common/timer_wheel.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace asylo {
+namespace {
+
+// Futex words woken by the fake wake function, in firing order. The wheel
+// takes a plain function pointer, so the recorder is a file-level variable
+// reset by the test fixture.
+std::vector<int32_t *> woken;
+
+void RecordWake(int32_t *futex) { woken.push_back(futex); }
+
+class TimerWheelTest : public ::testing::Test {
+ protected:
+  void SetUp() override { woken.clear(); }
+
+  TimerWheel wheel_;
+  int32_t futex_a_ = 0;
+  int32_t futex_b_ = 0;
+};
+
+TEST_F(TimerWheelTest, InactiveUntilFirstAdvance) {
+  EXPECT_FALSE(wheel_.active());
+  EXPECT_EQ(wheel_.Now(), 0);
+  wheel_.Advance(1000);
+  EXPECT_TRUE(wheel_.active());
+  EXPECT_EQ(wheel_.Now(), 1000);
+}
+
+TEST_F(TimerWheelTest, FiresOnceDeadlineReached) {
+  wheel_.Advance(1000);
+  TimerWheelEntry entry;
+  wheel_.Schedule(&entry, &futex_a_, RecordWake, 50000);
+  EXPECT_EQ(wheel_.NumPending(), 1);
+
+  EXPECT_EQ(wheel_.Advance(49999), 0);
+  EXPECT_TRUE(woken.empty());
+  EXPECT_EQ(wheel_.Advance(50000), 1);
+  ASSERT_EQ(woken.size(), 1);
+  EXPECT_EQ(woken[0], &futex_a_);
+  EXPECT_EQ(wheel_.NumPending(), 0);
+}
+
+TEST_F(TimerWheelTest, CancelPreventsFiring) {
+  wheel_.Advance(1000);
+  TimerWheelEntry entry;
+  wheel_.Schedule(&entry, &futex_a_, RecordWake, 50000);
+  wheel_.Cancel(&entry);
+  EXPECT_EQ(wheel_.NumPending(), 0);
+  EXPECT_EQ(wheel_.Advance(100000), 0);
+  EXPECT_TRUE(woken.empty());
+}
+
+TEST_F(TimerWheelTest, CancelAfterFiringIsANoOp) {
+  wheel_.Advance(1000);
+  TimerWheelEntry entry;
+  wheel_.Schedule(&entry, &futex_a_, RecordWake, 50000);
+  EXPECT_EQ(wheel_.Advance(60000), 1);
+  wheel_.Cancel(&entry);
+  EXPECT_EQ(wheel_.NumPending(), 0);
+}
+
+TEST_F(TimerWheelTest, PastDeadlineFiresOnNextAdvance) {
+  wheel_.Advance(100000);
+  TimerWheelEntry entry;
+  wheel_.Schedule(&entry, &futex_a_, RecordWake, 90000);
+  EXPECT_EQ(wheel_.Advance(100001), 1);
+  ASSERT_EQ(woken.size(), 1);
+  EXPECT_EQ(woken[0], &futex_a_);
+}
+
+TEST_F(TimerWheelTest, LongDeadlineSurvivesRevolutions) {
+  wheel_.Advance(1000);
+  TimerWheelEntry entry;
+  const uint64_t deadline = 1000 + 3 * kTimerWheelRevolutionMicros;
+  wheel_.Schedule(&entry, &futex_a_, RecordWake, deadline);
+
+  // Sweep the wheel several full revolutions before the deadline; the entry
+  // hashes to a visited slot each revolution but must not fire early.
+  uint64_t now = 1000;
+  while (now + kTimerWheelSlotMicros < deadline) {
+    now += kTimerWheelSlotMicros;
+    EXPECT_EQ(wheel_.Advance(now), 0);
+  }
+  EXPECT_TRUE(woken.empty());
+  EXPECT_EQ(wheel_.Advance(deadline), 1);
+  ASSERT_EQ(woken.size(), 1);
+}
+
+TEST_F(TimerWheelTest, EntriesWithDistinctDeadlinesFireSeparately) {
+  wheel_.Advance(1000);
+  TimerWheelEntry entry_a;
+  TimerWheelEntry entry_b;
+  wheel_.Schedule(&entry_a, &futex_a_, RecordWake, 50000);
+  wheel_.Schedule(&entry_b, &futex_b_, RecordWake, 500000);
+
+  EXPECT_EQ(wheel_.Advance(60000), 1);
+  ASSERT_EQ(woken.size(), 1);
+  EXPECT_EQ(woken[0], &futex_a_);
+  EXPECT_EQ(wheel_.NumPending(), 1);
+
+  EXPECT_EQ(wheel_.Advance(500000), 1);
+  ASSERT_EQ(woken.size(), 2);
+  EXPECT_EQ(woken[1], &futex_b_);
+}
+
+TEST_F(TimerWheelTest, FiresMoreEntriesThanOneWakeBatch) {
+  wheel_.Advance(1000);
+  constexpr int kEntries = 200;
+  std::vector<TimerWheelEntry> entries(kEntries);
+  std::vector<int32_t> futexes(kEntries);
+  for (int i = 0; i < kEntries; ++i) {
+    wheel_.Schedule(&entries[i], &futexes[i], RecordWake, 2000 + i);
+  }
+  EXPECT_EQ(wheel_.Advance(10000), kEntries);
+  EXPECT_EQ(woken.size(), kEntries);
+  EXPECT_EQ(wheel_.NumPending(), 0);
+}
+
+TEST_F(TimerWheelTest, ClockRegressionDelaysButDoesNotDropEntries) {
+  wheel_.Advance(10 * kTimerWheelRevolutionMicros);
+  TimerWheelEntry entry;
+  wheel_.Schedule(&entry, &futex_a_, RecordWake,
+                  10 * kTimerWheelRevolutionMicros + 50000);
+
+  // Step the clock backwards, then forward past the deadline again.
+  EXPECT_EQ(wheel_.Advance(kTimerWheelRevolutionMicros), 0);
+  EXPECT_EQ(wheel_.Advance(11 * kTimerWheelRevolutionMicros), 1);
+  ASSERT_EQ(woken.size(), 1);
+}
+
+}  // namespace
+}  // namespace asylo
@@ -91,6 +91,13 @@ inline void AtomicClear(volatile T *location, std::memory_order memorder =
   __atomic_clear(location, internal::GetGCCMemOrder(memorder));
 }
 
+// Returns the value at `location`.
+template <typename T>
+inline T AtomicLoad(volatile T *location, std::memory_order memorder =
+                                              std::memory_order_seq_cst) {
+  return __atomic_load_n(location, internal::GetGCCMemOrder(memorder));
+}
+
 // Sets the value at `location` to `value`.
 template <typename T>
 inline void AtomicStore(
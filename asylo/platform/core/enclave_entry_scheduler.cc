@@ -0,0 +1,120 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/core/enclave_entry_scheduler.h"
+
+namespace asylo {
+
+EnclaveEntryScheduler::EnclaveEntryScheduler(
+    const EnclaveAffinityConfig &config)
+    : restricted_(config.allowed_cpus_size() > 0),
+      prefer_recent_(config.prefer_recent_cpus()),
+      next_slot_(0) {
+  CPU_ZERO(&allowed_);
+  for (uint32_t cpu : config.allowed_cpus()) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &allowed_);
+    }
+  }
+  for (std::atomic<int> &slot : recent_cpus_) {
+    slot.store(-1, std::memory_order_relaxed);
+  }
+}
+
+EnclaveEntryScheduler::ScopedEntryAffinity::ScopedEntryAffinity(
+    EnclaveEntryScheduler *scheduler) {
+  if (!scheduler) {
+    return;
+  }
+  const int current_cpu = sched_getcpu();
+  const int target_cpu = scheduler->PickEntryCpu(current_cpu);
+  if (target_cpu >= 0 && target_cpu != current_cpu &&
+      sched_getaffinity(0, sizeof(saved_mask_), &saved_mask_) == 0) {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(target_cpu, &mask);
+    restore_ = sched_setaffinity(0, sizeof(mask), &mask) == 0;
+  }
+  scheduler->RecordCpu(restore_ ? target_cpu : current_cpu);
+}
+
+EnclaveEntryScheduler::ScopedEntryAffinity::~ScopedEntryAffinity() {
+  if (restore_) {
+    sched_setaffinity(0, sizeof(saved_mask_), &saved_mask_);
+  }
+}
+
+int EnclaveEntryScheduler::PickEntryCpu(int current_cpu) const {
+  // A thread already on an allowed CPU that recently ran the enclave — or on
+  // any allowed CPU when no placement has been recorded yet — stays put.
+  if (current_cpu >= 0 && IsAllowed(current_cpu) &&
+      (!prefer_recent_ || IsRecent(current_cpu))) {
+    return -1;
+  }
+
+  // Otherwise prefer the most recently recorded allowed CPU: it is the most
+  // likely to still hold the enclave's working set.
+  if (prefer_recent_) {
+    const size_t latest = next_slot_.load(std::memory_order_relaxed);
+    for (size_t i = 1; i <= kRecentCpuSlots; ++i) {
+      const int cpu =
+          recent_cpus_[(latest + kRecentCpuSlots - i) % kRecentCpuSlots].load(
+              std::memory_order_relaxed);
+      if (cpu >= 0 && cpu != current_cpu && IsAllowed(cpu)) {
+        return cpu;
+      }
+    }
+  }
+
+  if (current_cpu >= 0 && IsAllowed(current_cpu)) {
+    return -1;
+  }
+
+  // The thread is on a disallowed CPU and no recent CPU is available: any
+  // allowed CPU beats staying off the configured set.
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &allowed_)) {
+      return cpu;
+    }
+  }
+  return -1;
+}
+
+void EnclaveEntryScheduler::RecordCpu(int cpu) {
+  if (cpu < 0 || IsRecent(cpu)) {
+    return;
+  }
+  const size_t slot =
+      next_slot_.fetch_add(1, std::memory_order_relaxed) % kRecentCpuSlots;
+  recent_cpus_[slot].store(cpu, std::memory_order_relaxed);
+}
+
+bool EnclaveEntryScheduler::IsAllowed(int cpu) const {
+  return !restricted_ || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed_));
+}
+
+bool EnclaveEntryScheduler::IsRecent(int cpu) const {
+  for (const std::atomic<int> &slot : recent_cpus_) {
+    if (slot.load(std::memory_order_relaxed) == cpu) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace asylo
@@ -0,0 +1,106 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_CORE_ENCLAVE_ENTRY_SCHEDULER_H_
+#define ASYLO_PLATFORM_CORE_ENCLAVE_ENTRY_SCHEDULER_H_
+
+#include <sched.h>
+
+#include <atomic>
+#include <cstddef>
+
+#include "asylo/enclave.pb.h"
+
+namespace asylo {
+
+/// Topology-aware CPU placement for threads entering one enclave.
+///
+/// An enclave's code and data stay cache- and EPC-resident on the cores that
+/// recently ran it. Host threads, however, enter from whatever core the host
+/// scheduler chose — on multi-socket machines, frequently the wrong socket —
+/// so every entry may start cold. The scheduler keeps a small ring of the
+/// CPUs that most recently entered its enclave and, guided by an
+/// EnclaveAffinityConfig, migrates entering threads toward those CPUs (and
+/// away from disallowed ones) for the duration of a call.
+///
+/// All placement is best-effort: if the thread's CPU cannot be determined or
+/// migration fails, the call proceeds from wherever the thread is.
+/// Thread-safe.
+class EnclaveEntryScheduler {
+ public:
+  explicit EnclaveEntryScheduler(const EnclaveAffinityConfig &config);
+
+  EnclaveEntryScheduler(const EnclaveEntryScheduler &) = delete;
+  EnclaveEntryScheduler &operator=(const EnclaveEntryScheduler &) = delete;
+
+  /// Scoped placement of the calling thread for one enclave entry. The
+  /// constructor may pin the thread to a preferred CPU; the destructor
+  /// restores the thread's original affinity mask. Construction with a null
+  /// scheduler is a no-op, so callers without an affinity configuration pay
+  /// nothing.
+  class ScopedEntryAffinity {
+   public:
+    explicit ScopedEntryAffinity(EnclaveEntryScheduler *scheduler);
+    ~ScopedEntryAffinity();
+
+    ScopedEntryAffinity(const ScopedEntryAffinity &) = delete;
+    ScopedEntryAffinity &operator=(const ScopedEntryAffinity &) = delete;
+
+   private:
+    // Whether the destructor must restore |saved_mask_|.
+    bool restore_ = false;
+    cpu_set_t saved_mask_;
+  };
+
+ private:
+  // Number of recently-used CPUs remembered per enclave. Sized to cover the
+  // handful of cores a busy enclave's entry threads cycle through without
+  // remembering placements stale enough to be cold again.
+  static constexpr size_t kRecentCpuSlots = 8;
+
+  // Returns the CPU the calling thread should be pinned to for this entry,
+  // or -1 to leave the thread where it is. |current_cpu| is the thread's
+  // CPU, or -1 if unknown.
+  int PickEntryCpu(int current_cpu) const;
+
+  // Records |cpu| as having just entered the enclave.
+  void RecordCpu(int cpu);
+
+  // Returns true if the configuration permits entering from |cpu|.
+  bool IsAllowed(int cpu) const;
+
+  // Returns true if |cpu| is in the recently-used ring.
+  bool IsRecent(int cpu) const;
+
+  friend class ScopedEntryAffinity;
+
+  // CPUs entry is restricted to; covers all CPUs when |restricted_| is
+  // false.
+  cpu_set_t allowed_;
+  bool restricted_;
+  bool prefer_recent_;
+
+  // Ring of the CPUs that most recently entered the enclave, -1 when empty.
+  // |next_slot_| indexes the slot the next entry overwrites.
+  std::atomic<int> recent_cpus_[kRecentCpuSlots];
+  std::atomic<size_t> next_slot_;
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_CORE_ENCLAVE_ENTRY_SCHEDULER_H_
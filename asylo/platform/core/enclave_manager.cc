@@ -22,6 +22,7 @@
 #include <sys/ucontext.h>
 #include <time.h>
 
+#include <future>
 #include <thread>
 
 #include "absl/status/status.h"
@@ -170,6 +171,15 @@ Status EnclaveManager::Configure(const EnclaveManagerOptions & /*options*/) {
   return Status::OkStatus();
 }
 
+Status EnclaveManager::ReserveClientName(absl::string_view name) {
+  absl::WriterMutexLock lock(&client_table_lock_);
+  if (client_by_name_.find(name) != client_by_name_.end()) {
+    return absl::AlreadyExistsError(absl::StrCat("Name already exists: ", name));
+  }
+  client_by_name_.emplace(name, nullptr);
+  return Status::OkStatus();
+}
+
 Status EnclaveManager::LoadEnclave(absl::string_view name,
                                    const EnclaveLoader &loader,
                                    void *base_address,
@@ -226,15 +236,12 @@ Status EnclaveManager::LoadFakeEnclave(absl::string_view name,
                                        const EnclaveConfig &config,
                                        void *base_address,
                                        const size_t enclave_size) {
-  // Check whether a client with this name already exists.
-  {
-    absl::ReaderMutexLock lock(&client_table_lock_);
-    if (client_by_name_.find(name) != client_by_name_.end()) {
-      Status status =
-          absl::AlreadyExistsError(absl::StrCat("Name already exists: ", name));
-      LOG(ERROR) << "LoadEnclave failed: " << status;
-      return status;
-    }
+  // Reserve the name so that concurrent loads of the same name fail fast,
+  // while the load itself proceeds outside the table lock.
+  Status reserve_status = ReserveClientName(name);
+  if (!reserve_status.ok()) {
+    LOG(ERROR) << "LoadEnclave failed: " << reserve_status;
+    return reserve_status;
   }
 
   // Attempt to load the enclave.
@@ -242,14 +249,16 @@ Status EnclaveManager::LoadFakeEnclave(absl::string_view name,
       loader.LoadEnclave(name, base_address, enclave_size, config);
   if (!result.ok()) {
     LOG(ERROR) << "LoadEnclave failed: " << result.status();
+    absl::WriterMutexLock lock(&client_table_lock_);
+    client_by_name_.erase(name);
     return result.status();
   }
 
-  // Add the client to the lookup tables.
+  // Add the client to the lookup tables, replacing the reservation.
   EnclaveClient *client = result.ValueOrDie().get();
   {
     absl::WriterMutexLock lock(&client_table_lock_);
-    client_by_name_.emplace(name, std::move(result).ValueOrDie());
+    client_by_name_[std::string(name)] = std::move(result).ValueOrDie();
     name_by_client_.emplace(client, name);
   }
 
@@ -298,32 +307,40 @@ Status EnclaveManager::LoadEnclave(const EnclaveLoadConfig &load_config) {
     // that points to the enclave in the parent process.
     RemoveEnclaveReference(name);
   }
-  // Check whether a client with this name already exists.
-  {
-    absl::ReaderMutexLock lock(&client_table_lock_);
-    if (client_by_name_.find(name) != client_by_name_.end()) {
-      Status status =
-          absl::AlreadyExistsError(absl::StrCat("Name already exists: ", name));
-      LOG(ERROR) << "LoadEnclave failed: " << status;
-      return status;
-    }
+  // Reserve the name so that concurrent loads of the same name fail fast,
+  // while the expensive backend load below proceeds outside the table lock
+  // and loads of distinct enclaves run fully in parallel.
+  Status reserve_status = ReserveClientName(name);
+  if (!reserve_status.ok()) {
+    LOG(ERROR) << "LoadEnclave failed: " << reserve_status;
+    return reserve_status;
   }
-  std::shared_ptr<primitives::Client> primitive_client;
-  ASYLO_ASSIGN_OR_RETURN(primitive_client,
-                         asylo::primitives::LoadEnclave(load_config));
 
-  StatusOr<std::unique_ptr<EnclaveClient>> result =
-      GenericEnclaveClient::Create(name, primitive_client);
+  auto primitive_client_result = asylo::primitives::LoadEnclave(load_config);
+  if (!primitive_client_result.ok()) {
+    absl::WriterMutexLock lock(&client_table_lock_);
+    client_by_name_.erase(name);
+    return primitive_client_result.status();
+  }
+  std::shared_ptr<primitives::Client> primitive_client =
+      std::move(primitive_client_result).ValueOrDie();
+
+  StatusOr<std::unique_ptr<EnclaveClient>> result = GenericEnclaveClient::Create(
+      name, primitive_client,
+      load_config.has_affinity_config() ? &load_config.affinity_config()
+                                        : nullptr);
   if (!result.ok()) {
     LOG(ERROR) << "LoadEnclave failed: " << result.status();
+    absl::WriterMutexLock lock(&client_table_lock_);
+    client_by_name_.erase(name);
     return result.status();
   }
 
-  // Add the client to the lookup tables.
+  // Add the client to the lookup tables, replacing the reservation.
   EnclaveClient *client = result.ValueOrDie().get();
   {
     absl::WriterMutexLock lock(&client_table_lock_);
-    client_by_name_.emplace(name, std::move(result).ValueOrDie());
+    client_by_name_[name] = std::move(result).ValueOrDie();
     name_by_client_.emplace(client, name);
 
     if (config.enable_fork()) {
@@ -350,6 +367,13 @@ Status EnclaveManager::LoadEnclave(const EnclaveLoadConfig &load_config) {
   return status;
 }
 
+std::future<Status> EnclaveManager::LoadEnclaveAsync(
+    const EnclaveLoadConfig &load_config) {
+  return std::async(std::launch::async, [this, load_config] {
+    return LoadEnclave(load_config);
+  });
+}
+
 void EnclaveManager::RemoveEnclaveReference(absl::string_view name) {
   absl::WriterMutexLock lock(&client_table_lock_);
   EnclaveClient *client = client_by_name_[name].get();
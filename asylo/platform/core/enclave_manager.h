@@ -22,6 +22,7 @@
 // Declares the enclave client API, providing types and methods for loading,
 // accessing, and finalizing enclaves.
 
+#include <future>
 #include <string>
 #include <utility>
 
@@ -113,6 +114,20 @@ class EnclaveManager {
   /// \param load_config Backend configuration options to load an enclave
   Status LoadEnclave(const EnclaveLoadConfig &load_config);
 
+  /// Loads an enclave asynchronously.
+  ///
+  /// Starts loading a new enclave on a separate thread, as by
+  /// LoadEnclave(const EnclaveLoadConfig &load_config), and returns a future
+  /// holding the result of the load. Loads of distinct enclaves proceed fully
+  /// in parallel, so loading a fleet of enclaves takes the time of the slowest
+  /// single load rather than the sum. If the same name is loaded concurrently,
+  /// exactly one of the loads succeeds and the others fail with an
+  /// already-exists error.
+  ///
+  /// \param load_config Backend configuration options to load an enclave
+  /// \return A future holding the Status of the completed load.
+  std::future<Status> LoadEnclaveAsync(const EnclaveLoadConfig &load_config);
+
   /// Loads an enclave.
   ///
   /// Loads a new enclave with default enclave config settings and binds it to a
@@ -241,6 +256,14 @@ class EnclaveManager {
   void RemoveEnclaveReference(absl::string_view name)
       ABSL_LOCKS_EXCLUDED(client_table_lock_);
 
+  // Reserves |name| in the client table by inserting a placeholder entry, so
+  // that concurrent loads of the same name fail fast while the load itself
+  // proceeds outside the table lock. GetClient() returns nullptr for a
+  // reserved name until the load completes. Returns an already-exists error if
+  // the name is registered or reserved.
+  Status ReserveClientName(absl::string_view name)
+      ABSL_LOCKS_EXCLUDED(client_table_lock_);
+
   // Manager object for untrusted resources shared with enclaves.
   SharedResourceManager shared_resource_manager_;
 
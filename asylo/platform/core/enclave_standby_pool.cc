@@ -0,0 +1,138 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/core/enclave_standby_pool.h"
+
+#include <chrono>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "asylo/util/logging.h"
+#include "asylo/util/status.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+
+EnclaveStandbyPool::EnclaveStandbyPool(EnclaveManager *manager,
+                                       EnclaveLoadConfig template_config,
+                                       absl::string_view name_prefix,
+                                       size_t target_size)
+    : manager_(manager),
+      template_config_(std::move(template_config)),
+      name_prefix_(name_prefix),
+      target_size_(target_size) {}
+
+EnclaveStandbyPool::~EnclaveStandbyPool() {
+  absl::MutexLock lock(&mu_);
+
+  // Wait out loads still in flight so their instances can be destroyed too.
+  for (auto &load : in_flight_) {
+    Status status = load.second.get();
+    if (status.ok()) {
+      ready_.push_back(load.first);
+    }
+  }
+  in_flight_.clear();
+
+  for (const std::string &name : ready_) {
+    EnclaveClient *client = manager_->GetClient(name);
+    if (!client) {
+      continue;
+    }
+    Status status = manager_->DestroyEnclave(client, EnclaveFinal());
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to destroy standby enclave " << name << ": "
+                 << status;
+    }
+  }
+  ready_.clear();
+}
+
+void EnclaveStandbyPool::Start() {
+  absl::MutexLock lock(&mu_);
+  TriggerRefills();
+}
+
+StatusOr<EnclaveClient *> EnclaveStandbyPool::CheckOut() {
+  absl::MutexLock lock(&mu_);
+  ReapFinishedLoads();
+
+  if (ready_.empty()) {
+    // Nothing warmed up: load synchronously so the caller gets an enclave at
+    // cold-load latency rather than an error. The refill below still tops the
+    // pool back up for subsequent callers.
+    std::string name = NextName();
+    EnclaveLoadConfig load_config = template_config_;
+    load_config.set_name(name);
+    ASYLO_RETURN_IF_ERROR(manager_->LoadEnclave(load_config));
+    ready_.push_back(std::move(name));
+  }
+
+  std::string name = std::move(ready_.front());
+  ready_.pop_front();
+  TriggerRefills();
+
+  EnclaveClient *client = manager_->GetClient(name);
+  if (!client) {
+    return absl::InternalError(
+        absl::StrCat("Standby enclave ", name, " disappeared before handout"));
+  }
+  return client;
+}
+
+size_t EnclaveStandbyPool::NumReady() {
+  absl::MutexLock lock(&mu_);
+  ReapFinishedLoads();
+  return ready_.size();
+}
+
+std::string EnclaveStandbyPool::NextName() {
+  return absl::StrCat(name_prefix_, "/standby/", next_sequence_++);
+}
+
+void EnclaveStandbyPool::ReapFinishedLoads() {
+  auto load = in_flight_.begin();
+  while (load != in_flight_.end()) {
+    if (load->second.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      ++load;
+      continue;
+    }
+    Status status = load->second.get();
+    if (status.ok()) {
+      ready_.push_back(std::move(load->first));
+    } else {
+      LOG(ERROR) << "Standby load of " << load->first
+                 << " failed: " << status;
+    }
+    load = in_flight_.erase(load);
+  }
+}
+
+void EnclaveStandbyPool::TriggerRefills() {
+  while (ready_.size() + in_flight_.size() < target_size_) {
+    std::string name = NextName();
+    EnclaveLoadConfig load_config = template_config_;
+    load_config.set_name(name);
+    in_flight_.emplace_back(std::move(name),
+                            manager_->LoadEnclaveAsync(load_config));
+  }
+}
+
+}  // namespace asylo
@@ -0,0 +1,120 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_CORE_ENCLAVE_STANDBY_POOL_H_
+#define ASYLO_PLATFORM_CORE_ENCLAVE_STANDBY_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "asylo/enclave.pb.h"
+#include "asylo/platform/core/enclave_client.h"
+#include "asylo/platform/core/enclave_manager.h"
+#include "asylo/util/statusor.h"
+
+namespace asylo {
+
+/// A warm standby pool of pre-loaded enclave instances.
+///
+/// Loading and initializing an enclave takes seconds for large binaries, so
+/// services that scale by adding enclave instances must either overprovision
+/// or absorb that latency on every scale-up. The pool keeps a target number
+/// of instances fully loaded and initialized ahead of demand; CheckOut()
+/// hands one out at the cost of a table lookup and starts a background load
+/// to replace it.
+///
+/// Every instance is a complete load through EnclaveManager — loaded,
+/// initialized, registered under a pool-generated name — so a handed-out
+/// client is immediately ready for EnterAndRun(). Fork-based cloning is not
+/// used for the standby instances: a forked enclave must be placed at its
+/// parent's base address in a child process, which does not fit a pool of
+/// independent instances in one address space.
+///
+/// Thread-safe. Instances still pooled when the pool is destroyed are
+/// finalized and destroyed.
+class EnclaveStandbyPool {
+ public:
+  /// Constructs a pool of |target_size| instances loaded through |manager|
+  /// from |template_config|. The template's `name` field is ignored:
+  /// instances are registered as "<name_prefix>/standby/<sequence>".
+  /// |manager| must outlive the pool. No loads start until Start() or the
+  /// first CheckOut().
+  EnclaveStandbyPool(EnclaveManager *manager,
+                     EnclaveLoadConfig template_config,
+                     absl::string_view name_prefix, size_t target_size);
+
+  ~EnclaveStandbyPool();
+
+  EnclaveStandbyPool(const EnclaveStandbyPool &) = delete;
+  EnclaveStandbyPool &operator=(const EnclaveStandbyPool &) = delete;
+
+  /// Starts filling the pool in the background. Loads of distinct instances
+  /// proceed in parallel; Start() itself returns immediately.
+  void Start() ABSL_LOCKS_EXCLUDED(mu_);
+
+  /// Hands out a ready instance and starts a background load to replace it.
+  /// When the pool is empty — before the first background load completes, or
+  /// under demand outrunning refill — falls back to a synchronous load, so
+  /// the caller sees cold-load latency instead of an error. The returned
+  /// client remains owned by the EnclaveManager; dispose of it with
+  /// EnclaveManager::DestroyEnclave() as usual.
+  StatusOr<EnclaveClient *> CheckOut() ABSL_LOCKS_EXCLUDED(mu_);
+
+  /// Number of instances currently ready for handout. Does not count loads
+  /// still in flight.
+  size_t NumReady() ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  // Returns the name for the next instance, advancing the sequence counter.
+  std::string NextName() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Moves completed background loads into the ready list, dropping failed
+  // ones with a logged error.
+  void ReapFinishedLoads() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Starts background loads until ready plus in-flight instances reach the
+  // target size.
+  void TriggerRefills() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  EnclaveManager *const manager_;
+  const EnclaveLoadConfig template_config_;
+  const std::string name_prefix_;
+  const size_t target_size_;
+
+  absl::Mutex mu_;
+  uint64_t next_sequence_ ABSL_GUARDED_BY(mu_) = 0;
+
+  // Names of instances loaded, initialized and ready for handout.
+  std::deque<std::string> ready_ ABSL_GUARDED_BY(mu_);
+
+  // Background loads not yet known to have completed, by instance name.
+  std::vector<std::pair<std::string, std::future<Status>>> in_flight_
+      ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_CORE_ENCLAVE_STANDBY_POOL_H_
@@ -35,6 +35,13 @@ static constexpr uint64_t kSelectorAsyloRun = primitives::kSelectorUser + 1;
 // Enclave finalization entry point selector.
 static constexpr uint64_t kSelectorAsyloFini = primitives::kSelectorUser + 2;
 
+// Streaming variant of the enclave run entry point selector. The input
+// carries the serialized EnclaveInput and the untrusted address of a
+// SharedMemoryChannel that chunked EnclaveOutput messages are delivered over
+// while the call is still running.
+static constexpr uint64_t kSelectorAsyloRunStreaming =
+    primitives::kSelectorUser + 3;
+
 }  // namespace asylo
 
 #endif  // ASYLO_PLATFORM_CORE_ENTRY_SELECTORS_H_
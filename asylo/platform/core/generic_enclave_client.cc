@@ -19,11 +19,20 @@
 #include "asylo/platform/core/generic_enclave_client.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include <google/protobuf/arena.h>
+
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "asylo/enclave.pb.h"  // IWYU pragma: export
+#include "asylo/platform/common/shared_memory_channel.h"
+#include "asylo/platform/core/enclave_entry_scheduler.h"
 #include "asylo/platform/core/entry_selectors.h"
 #include "asylo/platform/host_call/untrusted/host_call_handlers_initializer.h"
 #include "asylo/platform/primitives/extent.h"
@@ -33,15 +42,21 @@
 #include "asylo/util/status.h"
 #include "asylo/util/status_helpers.h"
 #include "asylo/util/status_macros.h"
+#include "asylo/util/thread.h"
 
 namespace asylo {
 
 std::unique_ptr<GenericEnclaveClient> GenericEnclaveClient::Create(
     const absl::string_view name,
-    const std::shared_ptr<primitives::Client> primitive_client) {
+    const std::shared_ptr<primitives::Client> primitive_client,
+    const EnclaveAffinityConfig *affinity_config) {
   auto client =
       std::unique_ptr<GenericEnclaveClient>(new GenericEnclaveClient(name));
   client->primitive_client_ = primitive_client;
+  if (affinity_config) {
+    client->entry_scheduler_ =
+        absl::make_unique<EnclaveEntryScheduler>(*affinity_config);
+  }
   return client;
 }
 
@@ -67,22 +82,6 @@ Status GenericEnclaveClient::Initialize(const char *name, size_t name_len,
   return Status::OkStatus();
 }
 
-Status GenericEnclaveClient::Run(const char *input, size_t input_len,
-                                 std::unique_ptr<char[]> *output,
-                                 size_t *output_len) {
-  primitives::MessageWriter in;
-  in.PushByReference(primitives::Extent{input, input_len});
-  primitives::MessageReader out;
-  ASYLO_RETURN_IF_ERROR(
-      primitive_client_->EnclaveCall(kSelectorAsyloRun, &in, &out));
-  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(out, 1);
-  auto output_extent = out.next();
-  *output_len = output_extent.size();
-  output->reset(new char[*output_len]);
-  memcpy(output->get(), output_extent.As<char>(), *output_len);
-  return Status::OkStatus();
-}
-
 Status GenericEnclaveClient::Finalize(const char *input, size_t input_len,
                                       std::unique_ptr<char[]> *output,
                                       size_t *output_len) {
@@ -124,26 +123,101 @@ Status GenericEnclaveClient::EnterAndInitialize(const EnclaveConfig &config) {
 
 Status GenericEnclaveClient::EnterAndRun(const EnclaveInput &input,
                                          EnclaveOutput *output) {
-  std::string buf;
+  // Place the calling thread on a CPU that recently ran this enclave for the
+  // duration of the call. A no-op when no affinity was configured.
+  EnclaveEntryScheduler::ScopedEntryAffinity entry_affinity(
+      entry_scheduler_.get());
+
+  // This is the hot enclave entry path, so per-call allocations are kept off
+  // it: the serialization buffer retains its capacity across calls on each
+  // thread.
+  thread_local std::string buf;
   if (!input.SerializeToString(&buf)) {
     return absl::InvalidArgumentError("Failed to serialize EnclaveInput");
   }
 
-  std::unique_ptr<char[]> output_buf;
-  size_t output_len = 0;
-  ASYLO_RETURN_IF_ERROR(Run(buf.data(), buf.size(), &output_buf, &output_len));
+  primitives::MessageWriter in;
+  in.PushByReference(primitives::Extent{buf.data(), buf.size()});
+  primitives::MessageReader out;
+  ASYLO_RETURN_IF_ERROR(
+      primitive_client_->EnclaveCall(kSelectorAsyloRun, &in, &out));
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(out, 1);
 
-  // Enclave entry-point was successfully invoked. |output_buf| is guaranteed to
-  // have a value.
-  EnclaveOutput local_output;
-  local_output.ParseFromArray(output_buf.get(), output_len);
+  // Parse straight from the response extent while the reader still owns it,
+  // rather than staging the response in an intermediate heap buffer.
+  auto output_extent = out.next();
+  EnclaveOutput *parsed = output;
+  if (parsed == nullptr) {
+    // The caller does not want the response message, only the embedded
+    // status. Parse into an arena-backed message whose memory is reused
+    // across calls instead of constructing a temporary on the heap.
+    thread_local google::protobuf::Arena arena;
+    arena.Reset();
+    parsed = google::protobuf::Arena::CreateMessage<EnclaveOutput>(&arena);
+  }
+  parsed->ParseFromArray(output_extent.As<char>(), output_extent.size());
+
+  return StatusFromProto(parsed->status());
+}
+
+Status GenericEnclaveClient::EnterAndRunStreaming(
+    const EnclaveInput &input,
+    const std::function<void(EnclaveOutput chunk)> &consumer,
+    EnclaveOutput *output) {
+  EnclaveEntryScheduler::ScopedEntryAffinity entry_affinity(
+      entry_scheduler_.get());
+
+  std::string buf;
+  if (!input.SerializeToString(&buf)) {
+    return absl::InvalidArgumentError("Failed to serialize EnclaveInput");
+  }
+
+  // The channel lives on the untrusted heap so the enclave can address the
+  // ring directly.
+  auto channel = absl::make_unique<SharedMemoryChannel>();
+
+  // Drain chunks concurrently with the running entry-point. The thread exits
+  // once the enclave closes its end of the channel and the ring is empty, or
+  // on the first frame that does not parse. |drain_status| is only written
+  // by the drain thread, which is joined before it is read.
+  Status drain_status;
+  Thread drain([&channel, &consumer, &drain_status] {
+    std::vector<uint8_t> frame;
+    while (channel->Receive(&frame)) {
+      EnclaveOutput chunk;
+      if (!chunk.ParseFromArray(frame.data(), frame.size())) {
+        drain_status =
+            absl::InternalError("Failed to parse streamed EnclaveOutput chunk");
+        channel->Close();
+        return;
+      }
+      consumer(std::move(chunk));
+    }
+  });
 
-  // Set the output parameter if necessary.
-  if (output) {
-    *output = local_output;
+  primitives::MessageWriter in;
+  in.PushByReference(primitives::Extent{buf.data(), buf.size()});
+  in.Push<uint64_t>(reinterpret_cast<uint64_t>(channel.get()));
+  primitives::MessageReader out;
+  Status status =
+      primitive_client_->EnclaveCall(kSelectorAsyloRunStreaming, &in, &out);
+
+  // The trusted handler closes its end of the channel before returning.
+  // Close here as well so the drain thread is never left blocked when the
+  // call failed before the handler ran.
+  if (!status.ok()) {
+    channel->Close();
   }
+  drain.Join();
+  ASYLO_RETURN_IF_ERROR(status);
+  ASYLO_RETURN_IF_ERROR(drain_status);
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(out, 1);
 
-  return StatusFromProto(local_output.status());
+  auto output_extent = out.next();
+  EnclaveOutput local_output;
+  EnclaveOutput *parsed = output != nullptr ? output : &local_output;
+  parsed->ParseFromArray(output_extent.As<char>(), output_extent.size());
+  return StatusFromProto(parsed->status());
 }
 
 Status GenericEnclaveClient::EnterAndFinalize(const EnclaveFinal &final_input) {
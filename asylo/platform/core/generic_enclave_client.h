@@ -19,8 +19,11 @@
 #ifndef ASYLO_PLATFORM_CORE_GENERIC_ENCLAVE_CLIENT_H_
 #define ASYLO_PLATFORM_CORE_GENERIC_ENCLAVE_CLIENT_H_
 
+#include <functional>
+
 #include "asylo/enclave.pb.h"  // IWYU pragma: export
 #include "asylo/platform/core/enclave_client.h"
+#include "asylo/platform/core/enclave_entry_scheduler.h"
 #include "asylo/platform/primitives/untrusted_primitives.h"
 #include "asylo/util/status.h"  // IWYU pragma: export
 
@@ -29,12 +32,30 @@ namespace asylo {
 // Default implementation of EnclaveClient.
 class GenericEnclaveClient : public EnclaveClient {
  public:
+  // Creates a client for the enclave |name| entered through
+  // |primitive_client|. If |affinity_config| is non-null, threads calling
+  // EnterAndRun() are placed according to it; otherwise they enter from
+  // whatever CPU they are running on.
   static std::unique_ptr<GenericEnclaveClient> Create(
       const absl::string_view name,
-      const std::shared_ptr<primitives::Client> primitive_client);
+      const std::shared_ptr<primitives::Client> primitive_client,
+      const EnclaveAffinityConfig *affinity_config = nullptr);
 
   Status EnterAndRun(const EnclaveInput &input, EnclaveOutput *output) override;
 
+  // Enters the enclave and invokes the run entry-point in streaming mode.
+  // Chunks the enclave emits through EmitEnclaveOutput() are delivered over a
+  // ring in untrusted memory and passed to |consumer| on a drain thread while
+  // the entry-point is still running, so the caller consumes results as they
+  // are produced instead of receiving one buffered response. |consumer| must
+  // not re-enter this enclave. The final EnclaveOutput returned by Run() is
+  // written to |output| as in EnterAndRun() after the last chunk has been
+  // consumed.
+  Status EnterAndRunStreaming(const EnclaveInput &input,
+                              const std::function<void(EnclaveOutput chunk)>
+                                  &consumer,
+                              EnclaveOutput *output);
+
   std::shared_ptr<primitives::Client> GetPrimitiveClient() const {
     return primitive_client_;
   }
@@ -46,6 +67,10 @@ class GenericEnclaveClient : public EnclaveClient {
   // Primitive enclave client. Populated by the implementation of EnclaveLoader.
   std::shared_ptr<primitives::Client> primitive_client_;
 
+  // CPU placement for threads entering through this client, or null when no
+  // affinity was configured.
+  std::unique_ptr<EnclaveEntryScheduler> entry_scheduler_;
+
  private:
   Status EnterAndInitialize(const EnclaveConfig &config) override;
   Status EnterAndFinalize(const EnclaveFinal &final_input) override;
@@ -60,14 +85,6 @@ class GenericEnclaveClient : public EnclaveClient {
                     size_t input_len, std::unique_ptr<char[]> *output,
                     size_t *output_len);
 
-  // Enters the enclave and invokes the execution entry-point. If the ecall
-  // fails, or the enclave does not return any output, returns a non-OK status.
-  // In this case, the caller cannot make any assumptions about the contents of
-  // |output|. Otherwise, |output| points to a buffer of length *|output_len|
-  // that contains output from the enclave.
-  Status Run(const char *input, size_t input_len,
-             std::unique_ptr<char[]> *output, size_t *output_len);
-
   // Enters the enclave and invokes the finalization entry-point. If the ecall
   // fails, or the enclave does not return any output, returns a non-OK status.
   // In this case, the caller cannot make any assumptions about the contents of
@@ -18,6 +18,8 @@
 
 #include "asylo/platform/core/shared_resource_manager.h"
 
+#include <atomic>
+
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
@@ -38,20 +40,98 @@ Status SharedResourceManager::InstallResource(ResourceHandle *handle) {
         "Cannot install resource \"", name, "\": Resource already exists."));
   }
   shared_resources_[handle->resource_name] = absl::WrapUnique(handle);
+  auto interned = interned_names_.find(handle->resource_name);
+  if (interned != interned_names_.end()) {
+    interned_slots_[interned->second] = handle;
+  }
   return Status::OkStatus();
 }
 
+void *SharedResourceManager::AcquireLocked(ResourceHandle *handle) {
+  if (!handle) {
+    return nullptr;
+  }
+  int count = handle->reference_count.load(std::memory_order_relaxed);
+  do {
+    if (count == 0) {
+      return nullptr;
+    }
+  } while (!handle->reference_count.compare_exchange_weak(
+      count, count + 1, std::memory_order_acq_rel));
+  return handle->get();
+}
+
+SharedResourceManager::NameHandle SharedResourceManager::InternName(
+    const SharedName &name) {
+  {
+    absl::ReaderMutexLock lock(&mu_);
+    auto it = interned_names_.find(name);
+    if (it != interned_names_.end()) {
+      return it->second;
+    }
+  }
+
+  absl::WriterMutexLock lock(&mu_);
+  auto insert = interned_names_.emplace(name, interned_slots_.size());
+  if (insert.second) {
+    auto it = shared_resources_.find(name);
+    interned_slots_.push_back(
+        it == shared_resources_.end() ? nullptr : it->second.get());
+  }
+  return insert.first->second;
+}
+
 bool SharedResourceManager::ReleaseResource(const SharedName &name) {
-  absl::MutexLock lock(&mu_);
-  auto it = shared_resources_.find(name);
-  if (it == shared_resources_.end()) {
-    return false;
+  {
+    absl::ReaderMutexLock lock(&mu_);
+    auto it = shared_resources_.find(name);
+    if (it == shared_resources_.end()) {
+      return false;
+    }
+    if (it->second->reference_count.fetch_sub(1, std::memory_order_acq_rel) !=
+        1) {
+      return true;
+    }
   }
-  it->second->reference_count--;
-  if (it->second->reference_count == 0) {
-    shared_resources_.erase(it);
+
+  RemoveIfUnreferenced(name);
+  return true;
+}
+
+bool SharedResourceManager::ReleaseResource(NameHandle handle) {
+  SharedName name;
+  {
+    absl::ReaderMutexLock lock(&mu_);
+    if (handle >= interned_slots_.size() || !interned_slots_[handle]) {
+      return false;
+    }
+    ResourceHandle *resource = interned_slots_[handle];
+    if (resource->reference_count.fetch_sub(1, std::memory_order_acq_rel) !=
+        1) {
+      return true;
+    }
+    name = resource->resource_name;
   }
+
+  RemoveIfUnreferenced(name);
   return true;
 }
 
+void SharedResourceManager::RemoveIfUnreferenced(const SharedName &name) {
+  // A release dropped the last reference. Reacquire the lock exclusively to
+  // remove the entry; acquisition refuses to revive a zero-count resource, so
+  // the only way the count can be nonzero here is if the name was released
+  // and re-registered in the interim, in which case the new entry stays.
+  absl::WriterMutexLock lock(&mu_);
+  auto it = shared_resources_.find(name);
+  if (it != shared_resources_.end() &&
+      it->second->reference_count.load(std::memory_order_acquire) == 0) {
+    auto interned = interned_names_.find(name);
+    if (interned != interned_names_.end()) {
+      interned_slots_[interned->second] = nullptr;
+    }
+    shared_resources_.erase(it);
+  }
+}
+
 }  // namespace asylo
@@ -19,7 +19,10 @@
 #ifndef ASYLO_PLATFORM_CORE_SHARED_RESOURCE_MANAGER_H_
 #define ASYLO_PLATFORM_CORE_SHARED_RESOURCE_MANAGER_H_
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
@@ -34,6 +37,15 @@ namespace asylo {
 /// are shared between trusted and untrusted code.
 class SharedResourceManager {
  public:
+  /// An interned integer handle for a SharedName.
+  ///
+  /// Handles returned by InternName are stable for the lifetime of the
+  /// manager and remain valid across deregistration and re-registration of
+  /// the named resource. Callers that resolve the same name repeatedly can
+  /// intern it once and use the handle thereafter, skipping string hashing
+  /// and comparison on every operation.
+  using NameHandle = size_t;
+
   /// Registers a shared resource and passes ownership to the
   /// SharedResourceManager.
   ///
@@ -53,7 +65,7 @@ class SharedResourceManager {
   ///                dispose of once it is no longer referenced.
   template <typename T, typename Deleter = std::default_delete<T>>
   Status RegisterManagedResource(const SharedName &name, T *pointer) {
-    absl::MutexLock lock(&mu_);
+    absl::WriterMutexLock lock(&mu_);
     auto *resource = new ManagedResource<T, Deleter>(name, pointer);
     return InstallResource(resource);
   }
@@ -69,7 +81,7 @@ class SharedResourceManager {
   /// \param pointer A pointer to a value owned by the caller.
   template <typename T>
   Status RegisterUnmanagedResource(const SharedName &name, T *pointer) {
-    absl::MutexLock lock(&mu_);
+    absl::WriterMutexLock lock(&mu_);
     auto *resource = new UnmanagedResource<T>(name, pointer);
     return InstallResource(resource);
   }
@@ -78,16 +90,45 @@ class SharedResourceManager {
   ///
   /// Acquires a named resource by incrementing its reference count and
   /// returning a pointer to an object owned by the EnclaveManager. Returns
-  /// nullptr if the named resource does not exist.
+  /// nullptr if the named resource does not exist or is being finalized by a
+  /// concurrent release of its last reference.
+  ///
+  /// Acquisition takes the resource table lock in shared mode and adjusts the
+  /// reference count atomically, so concurrent acquisitions and releases never
+  /// serialize against each other.
   template <typename T>
   T *AcquireResource(const SharedName &name) {
-    absl::MutexLock lock(&mu_);
+    absl::ReaderMutexLock lock(&mu_);
     auto it = shared_resources_.find(name);
     if (it == shared_resources_.end()) {
       return nullptr;
     }
-    it->second->reference_count++;
-    return static_cast<T *>(it->second->get());
+    return static_cast<T *>(AcquireLocked(it->second.get()));
+  }
+
+  /// Interns a name, returning its integer handle.
+  ///
+  /// Interning hashes the name string once; the returned handle resolves to
+  /// whatever resource is currently registered under the name. A name may be
+  /// interned before any resource is registered under it.
+  ///
+  /// \param name The name to intern.
+  /// \returns The stable handle associated with the name.
+  NameHandle InternName(const SharedName &name);
+
+  /// Acquires a resource by interned handle.
+  ///
+  /// Has the same behavior as the name-based overload, but resolves the
+  /// resource through the interning table with no string hashing or
+  /// comparison. Returns nullptr if no resource is currently registered under
+  /// the interned name.
+  template <typename T>
+  T *AcquireResource(NameHandle handle) {
+    absl::ReaderMutexLock lock(&mu_);
+    if (handle >= interned_slots_.size()) {
+      return nullptr;
+    }
+    return static_cast<T *>(AcquireLocked(interned_slots_[handle]));
   }
 
   /// Releases a named resource.
@@ -98,6 +139,12 @@ class SharedResourceManager {
   /// resource does not exist.
   bool ReleaseResource(const SharedName &name);
 
+  /// Releases a resource by interned handle.
+  ///
+  /// Has the same behavior as the name-based overload, but resolves the
+  /// resource through the interning table.
+  bool ReleaseResource(NameHandle handle);
+
  private:
   // Implements a handle wrapping a pointer to a shared resource. This is
   // provided to allow different resource types to implement their own cleanup
@@ -115,7 +162,7 @@ class SharedResourceManager {
     virtual void release() = 0;
 
     SharedName resource_name;
-    int reference_count;
+    std::atomic<int> reference_count;
   };
 
   // A resource owned by the EnclaveManager.
@@ -143,10 +190,33 @@ class SharedResourceManager {
   Status InstallResource(ResourceHandle *handle)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Increments the reference count of |handle| and returns the underlying
+  // resource pointer. Returns nullptr if |handle| is null or its count has
+  // already dropped to zero, in which case the resource is awaiting removal
+  // and must not be revived.
+  void *AcquireLocked(ResourceHandle *handle) ABSL_SHARED_LOCKS_REQUIRED(mu_);
+
+  // Removes the entry for |name| if its reference count has reached zero.
+  // Called after a release drops the last reference.
+  void RemoveIfUnreferenced(const SharedName &name) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Guards the table itself. Lookups take the lock in shared mode; only
+  // insertion and removal of entries require it exclusively. Reference counts
+  // are atomic and are adjusted under the shared lock.
   absl::Mutex mu_;
   absl::flat_hash_map<SharedName, std::unique_ptr<ResourceHandle>,
                       SharedName::Hash, SharedName::Eq>
-      shared_resources_;
+      shared_resources_ ABSL_GUARDED_BY(mu_);
+
+  // Interning table mapping names to handles. Entries are never removed, so
+  // handles stay valid for the lifetime of the manager.
+  absl::flat_hash_map<SharedName, NameHandle, SharedName::Hash, SharedName::Eq>
+      interned_names_ ABSL_GUARDED_BY(mu_);
+
+  // Resolves each interned handle to the resource currently registered under
+  // the interned name, or nullptr if there is none. Indexed by NameHandle;
+  // maintained by resource installation and removal.
+  std::vector<ResourceHandle *> interned_slots_ ABSL_GUARDED_BY(mu_);
 };
 
 }  // namespace asylo
@@ -0,0 +1,162 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/core/enclave_entry_scheduler.h"
+
+#include <sched.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "asylo/enclave.pb.h"
+
+namespace asylo {
+namespace {
+
+// Returns the CPUs the test process may run on.
+std::vector<int> AvailableCpus() {
+  std::vector<int> cpus;
+  cpu_set_t mask;
+  if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+    return cpus;
+  }
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &mask)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+TEST(EnclaveEntrySchedulerTest, UnrestrictedEntryStaysPut) {
+  EnclaveAffinityConfig config;
+  EnclaveEntryScheduler scheduler(config);
+
+  cpu_set_t before;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(before), &before), 0);
+  {
+    EnclaveEntryScheduler::ScopedEntryAffinity affinity(&scheduler);
+    // The first entry has no recorded placement to prefer: the thread keeps
+    // its affinity mask.
+    cpu_set_t during;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(during), &during), 0);
+    EXPECT_TRUE(CPU_EQUAL(&before, &during));
+  }
+}
+
+TEST(EnclaveEntrySchedulerTest, NullSchedulerIsNoOp) {
+  cpu_set_t before;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(before), &before), 0);
+  {
+    EnclaveEntryScheduler::ScopedEntryAffinity affinity(nullptr);
+    cpu_set_t during;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(during), &during), 0);
+    EXPECT_TRUE(CPU_EQUAL(&before, &during));
+  }
+}
+
+TEST(EnclaveEntrySchedulerTest, MigratesToAllowedCpuAndRestores) {
+  std::vector<int> cpus = AvailableCpus();
+  if (cpus.size() < 2) {
+    GTEST_SKIP() << "Test requires at least two CPUs";
+  }
+
+  // Pin the thread to one CPU and allow entry only from another.
+  const int home_cpu = cpus[0];
+  const int allowed_cpu = cpus[1];
+  cpu_set_t home_mask;
+  CPU_ZERO(&home_mask);
+  CPU_SET(home_cpu, &home_mask);
+  ASSERT_EQ(sched_setaffinity(0, sizeof(home_mask), &home_mask), 0);
+
+  EnclaveAffinityConfig config;
+  config.add_allowed_cpus(allowed_cpu);
+  EnclaveEntryScheduler scheduler(config);
+  {
+    EnclaveEntryScheduler::ScopedEntryAffinity affinity(&scheduler);
+    EXPECT_EQ(sched_getcpu(), allowed_cpu);
+  }
+
+  // The guard restored the original placement.
+  cpu_set_t after;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+  EXPECT_TRUE(CPU_EQUAL(&home_mask, &after));
+  EXPECT_EQ(sched_getcpu(), home_cpu);
+}
+
+TEST(EnclaveEntrySchedulerTest, PrefersRecentlyUsedCpu) {
+  std::vector<int> cpus = AvailableCpus();
+  if (cpus.size() < 2) {
+    GTEST_SKIP() << "Test requires at least two CPUs";
+  }
+
+  EnclaveAffinityConfig config;
+  EnclaveEntryScheduler scheduler(config);
+
+  // Record an entry from one CPU, then enter from another: the scheduler
+  // steers the second entry back to the first CPU.
+  const int recent_cpu = cpus[0];
+  const int other_cpu = cpus[1];
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(recent_cpu, &mask);
+  ASSERT_EQ(sched_setaffinity(0, sizeof(mask), &mask), 0);
+  {
+    EnclaveEntryScheduler::ScopedEntryAffinity affinity(&scheduler);
+    EXPECT_EQ(sched_getcpu(), recent_cpu);
+  }
+
+  CPU_ZERO(&mask);
+  CPU_SET(other_cpu, &mask);
+  ASSERT_EQ(sched_setaffinity(0, sizeof(mask), &mask), 0);
+  {
+    EnclaveEntryScheduler::ScopedEntryAffinity affinity(&scheduler);
+    EXPECT_EQ(sched_getcpu(), recent_cpu);
+  }
+
+  // Outside the entry the thread is back on its own placement.
+  EXPECT_EQ(sched_getcpu(), other_cpu);
+}
+
+TEST(EnclaveEntrySchedulerTest, RecentPlacementNotPreferredWhenDisabled) {
+  std::vector<int> cpus = AvailableCpus();
+  if (cpus.size() < 2) {
+    GTEST_SKIP() << "Test requires at least two CPUs";
+  }
+
+  EnclaveAffinityConfig config;
+  config.set_prefer_recent_cpus(false);
+  EnclaveEntryScheduler scheduler(config);
+
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpus[0], &mask);
+  ASSERT_EQ(sched_setaffinity(0, sizeof(mask), &mask), 0);
+  { EnclaveEntryScheduler::ScopedEntryAffinity affinity(&scheduler); }
+
+  CPU_ZERO(&mask);
+  CPU_SET(cpus[1], &mask);
+  ASSERT_EQ(sched_setaffinity(0, sizeof(mask), &mask), 0);
+  {
+    EnclaveEntryScheduler::ScopedEntryAffinity affinity(&scheduler);
+    EXPECT_EQ(sched_getcpu(), cpus[1]);
+  }
+}
+
+}  // namespace
+}  // namespace asylo
@@ -37,7 +37,15 @@ class LockTest : public ::testing::Test {
   LockType non_recursive_;
 };
 
-typedef ::testing::Types<TrustedSpinLock, TrustedMutex> Implementations;
+// Drop-in wrapper selecting the spin lock's ticket fairness mode.
+class FairTrustedSpinLock : public TrustedSpinLock {
+ public:
+  explicit FairTrustedSpinLock(bool is_recursive)
+      : TrustedSpinLock(is_recursive, /*is_fair=*/true) {}
+};
+
+typedef ::testing::Types<TrustedSpinLock, TrustedMutex, FairTrustedSpinLock>
+    Implementations;
 
 TYPED_TEST_SUITE(LockTest, Implementations);
 
@@ -99,6 +99,51 @@ TEST(EnclaveResourcesTest, ResourceLifeCycle) {
           .ok());
 }
 
+TEST(EnclaveResourcesTest, InternedHandleLifeCycle) {
+  const SharedName name(kUnspecifiedName, "interned resource");
+
+  EnclaveManager::Configure(EnclaveManagerOptions());
+  SharedResourceManager *resources =
+      EnclaveManager::Instance().ValueOrDie()->shared_resources();
+
+  // A name may be interned before any resource is registered under it, and
+  // re-interning returns the same handle.
+  SharedResourceManager::NameHandle handle = resources->InternName(name);
+  EXPECT_EQ(resources->InternName(name), handle);
+  EXPECT_EQ(resources->AcquireResource<TestResource>(handle), nullptr);
+  EXPECT_FALSE(resources->ReleaseResource(handle));
+
+  // Once a resource is registered under the name, the handle resolves to it.
+  bool is_resource_alive;
+  auto *resource = new TestResource(&is_resource_alive);
+  resource->value = "interned resource";
+  EXPECT_TRUE(resources->RegisterManagedResource(name, resource).ok());
+  for (int i = 0; i < 100; i++) {
+    TestResource *acquired = resources->AcquireResource<TestResource>(handle);
+    ASSERT_NE(acquired, nullptr);
+    EXPECT_EQ(acquired->value, "interned resource");
+  }
+  for (int i = 0; i < 100; i++) {
+    EXPECT_TRUE(resources->ReleaseResource(handle));
+    EXPECT_TRUE(is_resource_alive);
+  }
+
+  // Dropping the registration reference destroys the resource; the handle no
+  // longer resolves but remains valid.
+  EXPECT_TRUE(resources->ReleaseResource(handle));
+  EXPECT_FALSE(is_resource_alive);
+  EXPECT_EQ(resources->AcquireResource<TestResource>(handle), nullptr);
+
+  // Re-registering under the same name revives the handle.
+  resource = new TestResource(&is_resource_alive);
+  resource->value = "interned resource";
+  EXPECT_TRUE(resources->RegisterManagedResource(name, resource).ok());
+  EXPECT_EQ(resources->AcquireResource<TestResource>(handle), resource);
+  EXPECT_TRUE(resources->ReleaseResource(handle));
+  EXPECT_TRUE(resources->ReleaseResource(handle));
+  EXPECT_FALSE(is_resource_alive);
+}
+
 TEST(EnclaveResourcesTest, CustomDeleter) {
   EnclaveManager::Configure(EnclaveManagerOptions());
   SharedResourceManager *resources =
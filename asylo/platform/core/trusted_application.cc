@@ -28,23 +28,30 @@
 #include <string>
 #include <utility>
 
+#include <google/protobuf/arena.h>
+
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "asylo/util/logging.h"
 #include "asylo/identity/init.h"
 #include "asylo/platform/common/enclave_state.h"
+#include "asylo/platform/common/shared_memory_channel.h"
 #include "asylo/platform/core/entry_selectors.h"
 #include "asylo/platform/core/shared_name_kind.h"
 #include "asylo/platform/core/trusted_global_state.h"
 #include "asylo/platform/posix/io/io_manager.h"
 #include "asylo/platform/posix/io/native_paths.h"
 #include "asylo/platform/posix/io/random_devices.h"
+#include "asylo/platform/posix/memory/malloc_arena.h"
+#include "asylo/platform/posix/stdio_buffering.h"
 #include "asylo/platform/posix/threading/thread_manager.h"
 #include "asylo/platform/primitives/extent.h"
 #include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/primitives.h"
 #include "asylo/platform/primitives/trusted_primitives.h"
 #include "asylo/platform/primitives/trusted_runtime.h"
 #include "asylo/platform/primitives/util/message.h"
+#include "asylo/platform/primitives/util/trusted_init_timing.h"
 #include "asylo/platform/primitives/util/status_conversions.h"
 #include "asylo/platform/primitives/util/status_serializer.h"
 #include "asylo/util/posix_error_space.h"
@@ -135,6 +142,49 @@ PrimitiveStatus Run(void *context, MessageReader *in, MessageWriter *out) {
   return PrimitiveStatus(result);
 }
 
+// The untrusted channel that chunks emitted by the current thread's streaming
+// run are delivered over, or null when the current entry is an ordinary run.
+thread_local SharedMemoryChannel *streaming_output_channel = nullptr;
+
+// Handler installed by the runtime to invoke the enclave run entry point in
+// streaming mode. The second input extent carries the untrusted address of
+// the SharedMemoryChannel that EmitEnclaveOutput() delivers chunks over while
+// the entry point runs.
+PrimitiveStatus RunStreaming(void *context, MessageReader *in,
+                             MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 2);
+  auto input_extent = in->next();
+  auto *channel =
+      reinterpret_cast<SharedMemoryChannel *>(in->next<uint64_t>());
+  if (!channel ||
+      !TrustedPrimitives::IsOutsideEnclave(channel, sizeof(*channel))) {
+    return PrimitiveStatus(
+        primitives::AbslStatusCode::kInvalidArgument,
+        "Streaming output channel must reside in untrusted memory.");
+  }
+
+  char *output = nullptr;
+  size_t output_len = 0;
+  int result = 0;
+  streaming_output_channel = channel;
+  try {
+    result = asylo::__asylo_user_run(input_extent.As<char>(),
+                                     input_extent.size(), &output, &output_len);
+  } catch (...) {
+    TrustedPrimitives::BestEffortAbort("Uncaught exception in enclave");
+  }
+  streaming_output_channel = nullptr;
+  // Ends the stream. The untrusted consumer drains any chunks still buffered
+  // in the ring before it observes end-of-stream and accepts the final
+  // output.
+  channel->CloseForSend();
+  if (!result) {
+    out->PushByCopy(Extent{output, output_len});
+  }
+  free(output);
+  return PrimitiveStatus(result);
+}
+
 // Handler installed by the runtime to invoke the enclave finalization entry
 // point.
 PrimitiveStatus Finalize(void *context, MessageReader *in, MessageWriter *out) {
@@ -156,6 +206,27 @@ PrimitiveStatus Finalize(void *context, MessageReader *in, MessageWriter *out) {
   return PrimitiveStatus(result);
 }
 
+// Size of the retained block backing each thread's run-message arena. Inputs
+// and outputs that fit never touch the heap allocator after a thread's first
+// call.
+constexpr size_t kRunArenaBlockSize = 4096;
+
+// Returns this thread's reusable message arena for the run entry point.
+// Arena::Reset() frees everything except the initial block supplied at
+// construction, so resetting the arena between calls recycles the block
+// instead of returning it to the allocator. The arena is intentionally leaked
+// because the enclave runtime does not run thread-local destructors.
+google::protobuf::Arena *RunMessageArena() {
+  thread_local google::protobuf::Arena *arena = nullptr;
+  if (arena == nullptr) {
+    google::protobuf::ArenaOptions options;
+    options.initial_block = static_cast<char *>(malloc(kRunArenaBlockSize));
+    options.initial_block_size = kRunArenaBlockSize;
+    arena = new google::protobuf::Arena(options);
+  }
+  return arena;
+}
+
 }  // namespace
 
 Status VerifyOutputArguments(char **output, size_t *output_len) {
@@ -185,6 +256,29 @@ TrustedApplication *GetApplicationInstance() {
   return global_trusted_application;
 }
 
+Status EmitEnclaveOutput(const EnclaveOutput &chunk) {
+  SharedMemoryChannel *channel = streaming_output_channel;
+  if (channel == nullptr) {
+    return absl::FailedPreconditionError(
+        "EmitEnclaveOutput() called outside a streaming run");
+  }
+  // Serialize into trusted memory first; Send() copies the bytes into the
+  // untrusted ring.
+  std::string buf;
+  if (!chunk.SerializeToString(&buf)) {
+    return absl::InvalidArgumentError("Failed to serialize EnclaveOutput");
+  }
+  if (buf.size() > SharedMemoryChannel::kMaxMessageSize) {
+    return absl::InvalidArgumentError(
+        "EnclaveOutput chunk exceeds the channel message size limit");
+  }
+  if (!channel->Send(reinterpret_cast<const uint8_t *>(buf.data()),
+                     buf.size())) {
+    return absl::InternalError("Streaming output channel was closed");
+  }
+  return Status::OkStatus();
+}
+
 Status InitializeEnvironmentVariables(
     const RepeatedPtrField<EnvironmentVariable> &variables) {
   for (const auto &variable : variables) {
@@ -200,7 +294,12 @@ Status InitializeEnvironmentVariables(
 }
 
 Status TrustedApplication::InitializeInternal(const EnclaveConfig &config) {
+  primitives::RecordInitPhase(primitives::kInitPhaseUserInitBegin);
+  // Enable per-thread malloc arenas before user code starts allocating from
+  // multiple threads.
+  enc_enable_malloc_arenas();
   InitializeIO(config);
+  primitives::RecordInitPhase(primitives::kInitPhaseIOInitialized);
   Status status =
       InitializeEnvironmentVariables(config.environment_variables());
   const char *log_directory = config.logging_config().log_directory().c_str();
@@ -208,6 +307,7 @@ Status TrustedApplication::InitializeInternal(const EnclaveConfig &config) {
   if(!InitLogging(log_directory, GetEnclaveName().c_str(), vlog_level)) {
     fprintf(stderr, "Initialization of enclave logging failed\n");
   }
+  primitives::RecordInitPhase(primitives::kInitPhaseLoggingInitialized);
   if (!status.ok()) {
     LOG(WARNING) << "Initialization of enclave environment variables failed: "
                  << status;
@@ -221,10 +321,14 @@ Status TrustedApplication::InitializeInternal(const EnclaveConfig &config) {
     LOG(WARNING) << "Initialization of enclave assertion authorities failed: "
                  << status;
   }
+  primitives::RecordInitPhase(
+      primitives::kInitPhaseAssertionAuthoritiesInitialized);
 
   ASYLO_RETURN_IF_ERROR(VerifyAndSetState(EnclaveState::kInternalInitializing,
                                           EnclaveState::kUserInitializing));
-  return Initialize(config);
+  status = Initialize(config);
+  primitives::RecordInitPhase(primitives::kInitPhaseUserInitialized);
+  return status;
 }
 
 void InitializeIO(const EnclaveConfig &config) {
@@ -243,22 +347,34 @@ void InitializeIO(const EnclaveConfig &config) {
     io_manager.RegisterHostFileDescriptor(config.stderr_fd());
   }
 
-  // Register handler for / so paths without other handlers are forwarded on to
-  // the host system. Paths are registered without the trailing slash, so an
-  // empty string is used.
-  io_manager.RegisterVirtualPathHandler(
-      "", ::absl::make_unique<io::NativePathHandler>());
-
-  // Register handlers for /dev/random and /dev/urandom so they can be opened
-  // and read like regular files without exiting the enclave.
-  io_manager.RegisterVirtualPathHandler(
-      RandomPathHandler::kRandomPath, ::absl::make_unique<RandomPathHandler>());
-  io_manager.RegisterVirtualPathHandler(
-      RandomPathHandler::kURandomPath,
-      ::absl::make_unique<RandomPathHandler>());
+  // Defer registration of the default path handlers to the first path-based
+  // operation, so that enclaves which never touch the filesystem do not pay
+  // for it during initialization.
+  io_manager.SetDefaultHandlerInitializer([] {
+    auto &io_manager = io::IOManager::GetInstance();
+
+    // Register handler for / so paths without other handlers are forwarded on
+    // to the host system. Paths are registered without the trailing slash, so
+    // an empty string is used.
+    io_manager.RegisterVirtualPathHandler(
+        "", ::absl::make_unique<io::NativePathHandler>());
+
+    // Register handlers for /dev/random and /dev/urandom so they can be opened
+    // and read like regular files without exiting the enclave.
+    io_manager.RegisterVirtualPathHandler(
+        RandomPathHandler::kRandomPath,
+        ::absl::make_unique<RandomPathHandler>());
+    io_manager.RegisterVirtualPathHandler(
+        RandomPathHandler::kURandomPath,
+        ::absl::make_unique<RandomPathHandler>());
+  });
 
   // Set the current working directory so that relative paths can be handled.
   io_manager.SetCurrentWorkingDirectory(config.current_working_directory());
+
+  // With the standard descriptors registered, switch stdio to the enclave's
+  // buffering defaults so that stream output does not exit per line.
+  InitializeStdioBuffering();
 }
 
 // Asylo enclave entry points.
@@ -307,12 +423,20 @@ int __asylo_user_run(const char *input, size_t input_len, char **output,
     return 1;
   }
 
-  EnclaveOutput enclave_output;
+  // Allocate the input and output messages on a reusable per-thread arena.
+  // This entry point runs at RPC rates, and rebuilding the message trees on
+  // the heap for every call is measurable; resetting the arena releases the
+  // previous call's messages while retaining their memory.
+  google::protobuf::Arena *arena = RunMessageArena();
+  arena->Reset();
+  EnclaveOutput *enclave_output =
+      google::protobuf::Arena::CreateMessage<EnclaveOutput>(arena);
   StatusSerializer<EnclaveOutput> status_serializer(
-      &enclave_output, enclave_output.mutable_status(), output, output_len);
+      enclave_output, enclave_output->mutable_status(), output, output_len);
 
-  EnclaveInput enclave_input;
-  if (!enclave_input.ParseFromArray(input, input_len)) {
+  EnclaveInput *enclave_input =
+      google::protobuf::Arena::CreateMessage<EnclaveInput>(arena);
+  if (!enclave_input->ParseFromArray(input, input_len)) {
     status = absl::InvalidArgumentError("Failed to parse EnclaveInput");
     return status_serializer.Serialize(status);
   }
@@ -323,7 +447,7 @@ int __asylo_user_run(const char *input, size_t input_len, char **output,
   }
 
   // Invoke the enclave entry-point.
-  status = GetApplicationInstance()->Run(enclave_input, &enclave_output);
+  status = GetApplicationInstance()->Run(*enclave_input, enclave_output);
   return status_serializer.Serialize(status);
 }
 
@@ -350,6 +474,11 @@ int __asylo_user_fini(const char *input, size_t input_len, char **output,
   // Invoke the enclave entry-point.
   status = GetApplicationInstance()->Finalize(enclave_final);
 
+  // Finalization does not run exit(3), so flush whatever stdio buffered -
+  // including output from the user's Finalize() above - while host-backed
+  // descriptors are still usable.
+  FlushStdioBuffers();
+
   ThreadManager *thread_manager = ThreadManager::GetInstance();
   thread_manager->Finalize();
 
@@ -378,6 +507,14 @@ extern "C" PrimitiveStatus asylo_enclave_init() {
     TrustedPrimitives::BestEffortAbort("Could not register entry handler");
   }
 
+  // Register the streaming variant of the run entry handler.
+  EntryHandler run_streaming_handler{asylo::RunStreaming};
+  if (!TrustedPrimitives::RegisterEntryHandler(
+           asylo::kSelectorAsyloRunStreaming, run_streaming_handler)
+           .ok()) {
+    TrustedPrimitives::BestEffortAbort("Could not register entry handler");
+  }
+
   // Register the enclave finalization entry handler.
   EntryHandler finalize_handler{asylo::Finalize};
   if (!TrustedPrimitives::RegisterEntryHandler(asylo::kSelectorAsyloFini,
@@ -130,6 +130,29 @@ TrustedApplication *BuildTrustedApplication();
 /// \relates TrustedApplication
 TrustedApplication *GetApplicationInstance();
 
+/// Sends `chunk` to the untrusted caller of a streaming run without returning
+/// from the enclave.
+///
+/// When the enclave was entered through
+/// EnclaveClient::EnterAndRunStreaming(), Run() may call this any number of
+/// times to deliver partial output as it is produced, instead of buffering the
+/// whole result in enclave memory for the final return value. Chunks are
+/// copied into a ring in untrusted memory and consumed by the caller
+/// concurrently with the running entry-point; the call blocks while the ring
+/// is full, which bounds the enclave memory a long-running job spends on
+/// output. The final EnclaveOutput returned from Run() is delivered to the
+/// caller as usual after the last chunk.
+///
+/// Like any enclave output, the contents of `chunk` leave the enclave in
+/// plaintext.
+///
+/// \param chunk Output message to deliver. Must serialize to at most
+///        SharedMemoryChannel::kMaxMessageSize bytes.
+/// \return An OK status, or FAILED_PRECONDITION when the current entry is not
+///         a streaming run, or an error if the chunk could not be delivered.
+/// \relates TrustedApplication
+Status EmitEnclaveOutput(const EnclaveOutput &chunk);
+
 }  // namespace asylo
 
 #endif  // ASYLO_PLATFORM_CORE_TRUSTED_APPLICATION_H_
@@ -18,44 +18,59 @@
 
 #include "asylo/platform/core/trusted_global_state.h"
 
+#include <memory>
 #include <string>
 
 #include "absl/status/status.h"
 #include "asylo/enclave.pb.h"
+#include "asylo/util/frozen_snapshot.h"
 #include "asylo/util/status.h"
 #include "asylo/util/statusor.h"
 
 namespace asylo {
 
 // Name of the enclave, as specified at the time the enclave was loaded.
-static std::string *global_enclave_name = nullptr;
+// Published once during initialization and read without locks afterwards.
+static FrozenSnapshot<std::string> *GlobalEnclaveName() {
+  static FrozenSnapshot<std::string> *name = new FrozenSnapshot<std::string>();
+  return name;
+}
 
 // Enclave configuration, as specified at the time the enclave was loaded.
-static asylo::EnclaveConfig *global_enclave_config = nullptr;
+// Frozen after initialization, so reads on per-request paths are a single
+// atomic load.
+static FrozenSnapshot<EnclaveConfig> *GlobalEnclaveConfig() {
+  static FrozenSnapshot<EnclaveConfig> *config =
+      new FrozenSnapshot<EnclaveConfig>();
+  return config;
+}
 
 void SetEnclaveName(const std::string &name) {
-  delete global_enclave_name;
-  global_enclave_name = new std::string(name);
+  GlobalEnclaveName()->Publish(std::make_shared<const std::string>(name));
 }
 
-const std::string &GetEnclaveName() { return *global_enclave_name; }
+const std::string &GetEnclaveName() { return *GlobalEnclaveName()->Get(); }
 
 Status SetEnclaveConfig(const EnclaveConfig &config) {
   // EnclaveConfig may only be set once and additional calls will return an
   // error.
-  if (global_enclave_config) {
+  if (!GlobalEnclaveConfig()->PublishIfUnset(
+          std::make_shared<const EnclaveConfig>(config))) {
     return absl::FailedPreconditionError("EnclaveConfig is already set");
   }
-  global_enclave_config = new EnclaveConfig(config);
   return Status::OkStatus();
 }
 
 StatusOr<const EnclaveConfig *> GetEnclaveConfig() {
-  if (!global_enclave_config) {
+  // The config is never republished once set, and the global holder retains a
+  // reference for the lifetime of the enclave, so handing out the raw pointer
+  // is safe.
+  std::shared_ptr<const EnclaveConfig> config = GlobalEnclaveConfig()->Get();
+  if (!config) {
     return absl::FailedPreconditionError("EnclaveConfig is not set");
   }
 
-  return global_enclave_config;
+  return config.get();
 }
 
 }  // namespace asylo
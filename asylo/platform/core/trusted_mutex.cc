@@ -18,34 +18,69 @@
 
 #include "asylo/platform/core/trusted_mutex.h"
 
+#include <algorithm>
+
 #include "asylo/platform/core/atomic.h"
 #include "asylo/platform/core/trusted_spin_lock.h"
 #include "asylo/platform/host_call/trusted/host_calls.h"
+#include "asylo/platform/primitives/util/trusted_spin_calibration.h"
 
 namespace asylo {
 
 namespace {
-// Value below was roughly experimentally determined using test/lock_test on SGX
-// hardware.
-static constexpr int64_t kLockAttemptThreshhold = 10000;
+// Lower bound on the adaptive spin budget, so that even heavily contended
+// locks probe briefly before paying an enclave exit.
+static constexpr int64_t kMinSpinBudget = 256;
+
+// Maximum number of waiters woken by a single Unlock(). Waking a small batch
+// in one exit leaves the extra woken threads spinning on the lock, letting
+// the next few unlocks hand the lock over without a wake exit each.
+static constexpr int32_t kWakeBatchSize = 4;
 }  // namespace
 
 TrustedMutex::TrustedMutex(bool is_recursive = false)
     : trusted_spin_lock_(is_recursive),
       wait_queue_(enc_untrusted_create_wait_queue()),
-      number_threads_asleep_(0) {
+      number_threads_asleep_(0),
+      spin_budget_(
+          static_cast<int64_t>(primitives::MaxSpinPausesBeforeWait())) {
   // ensure that waiting is currently disabled
   enc_untrusted_disable_waiting(wait_queue_);
 }
 
 void TrustedMutex::Lock() {
   while (true) {
-    for (int i = 0; i < kLockAttemptThreshhold; i++) {
+    // The spin window is capped by the calibrated cost of an enclave
+    // transition: spinning longer than one exit-and-reenter round trip can
+    // never beat waiting. Locks constructed before calibration ran pick up
+    // the tighter cap here on their first contended acquisition.
+    const int64_t max_budget =
+        static_cast<int64_t>(primitives::MaxSpinPausesBeforeWait());
+    const int64_t current_budget = spin_budget_;
+    const int64_t budget = std::min(current_budget, max_budget);
+    const int64_t max_backoff =
+        static_cast<int64_t>(primitives::MaxBackoffPauses());
+    int64_t pauses = 1;
+    for (int64_t spent = 0; spent <= budget; spent += pauses) {
       if (TryLock()) {
+        if (spent > 0) {
+          // The lock was handed over within the spin window; spend more
+          // time spinning before the next futex wait.
+          spin_budget_ = std::min(budget * 2, max_budget);
+        }
         return;
       }
-      enc_pause();
+      // Back off exponentially between probes to reduce the cache line
+      // traffic of contended spinning.
+      for (int64_t i = 0; i < pauses; i++) {
+        enc_pause();
+      }
+      pauses = std::min(pauses * 2, max_backoff);
     }
+    // Spinning did not acquire the lock within the budget; shrink the budget
+    // so that heavily contended locks stop burning cycles before the
+    // unavoidable wait.
+    spin_budget_ = std::max(budget / 2, kMinSpinBudget);
     // This increment and decrement can be relaxed, as the thread
     // count doesn't serve as a lock word for any other data.
     AtomicIncrement(&number_threads_asleep_, std::memory_order_relaxed);
@@ -83,7 +118,12 @@ void TrustedMutex::Unlock() {
   // only need to wake up another thread if the lock has changed state
   // to Unlocked, and there is a thread waiting on the queue.
   if (getting_unlocked && number_threads_asleep_ > 0) {
-    enc_untrusted_notify(wait_queue_);
+    // Wake a small batch of waiters in a single exit; the extra woken
+    // threads probe the lock within their spin budget, so subsequent
+    // unlocks can hand the lock over without a wake exit each.
+    enc_untrusted_notify(wait_queue_,
+                         std::min<int32_t>(number_threads_asleep_,
+                                           kWakeBatchSize));
   }
 }
 
@@ -69,6 +69,13 @@ class TrustedMutex {
   // queue, we can avoid an expensive wake operation in some common
   // cases.
   volatile uint32_t number_threads_asleep_;
+  // Adaptive budget of enc_pause() iterations spent probing the lock
+  // before falling back to a futex wait. Grows when spinning acquires
+  // the lock and shrinks when a wait was needed, capped by the
+  // boot-time spin calibration at the measured cost of an enclave
+  // transition. Updated racily under contention; a lost update only
+  // delays adaptation.
+  volatile int64_t spin_budget_;
 };
 
 }  // namespace asylo
@@ -0,0 +1,130 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/core/trusted_rwlock.h"
+
+#include <atomic>
+
+#include "asylo/platform/primitives/trusted_runtime.h"
+
+namespace asylo {
+
+namespace {
+// Longest enc_pause() burst issued between lock probes while spinning.
+constexpr uint64_t kMaxBackoffPauses = 64;
+}  // namespace
+
+TrustedRWLock::ReaderSlot *TrustedRWLock::SlotForThread() {
+  // Mix the thread identifier so that threads with nearby identifiers spread
+  // across slots; the multiplier is the 64-bit finalizer from MurmurHash3.
+  uint64_t id = enc_thread_self();
+  id ^= id >> 33;
+  id *= UINT64_C(0xff51afd7ed558ccd);
+  id ^= id >> 33;
+  return &reader_slots_[id & (kReaderSlots - 1)];
+}
+
+void TrustedRWLock::ReadLock() {
+  ReaderSlot *slot = SlotForThread();
+  uint64_t backoff = 1;
+  for (;;) {
+    // Register as a reader first, then check for a writer. Both operations
+    // are sequentially consistent, so a writer that announces itself before
+    // reading the counters cannot miss this registration while this reader
+    // also misses the announcement.
+    AtomicIncrement(&slot->count);
+    if (AtomicLoad(&writer_present_) == 0) {
+      return;
+    }
+
+    // A writer holds the lock or is draining readers. Back the registration
+    // out so the writer can proceed, and wait for the write phase to end.
+    AtomicDecrement(&slot->count, std::memory_order_relaxed);
+    while (AtomicLoad(&writer_present_, std::memory_order_acquire) != 0) {
+      for (uint64_t i = 0; i < backoff; i++) {
+        enc_pause();
+      }
+      if (backoff < kMaxBackoffPauses) {
+        backoff *= 2;
+      }
+    }
+  }
+}
+
+bool TrustedRWLock::TryReadLock() {
+  ReaderSlot *slot = SlotForThread();
+  AtomicIncrement(&slot->count);
+  if (AtomicLoad(&writer_present_) == 0) {
+    return true;
+  }
+  AtomicDecrement(&slot->count, std::memory_order_relaxed);
+  return false;
+}
+
+void TrustedRWLock::ReadUnlock() {
+  AtomicDecrement(&SlotForThread()->count, std::memory_order_release);
+}
+
+void TrustedRWLock::WriteLock() {
+  // Writers take turns in ticket order, so a writer never starves behind
+  // other writers.
+  writer_lock_.Lock();
+
+  // Announce the write phase. Readers that register after this store back
+  // themselves out; this writer only has to wait for readers that were
+  // already in their critical sections.
+  AtomicStore(&writer_present_, 1u);
+  for (size_t i = 0; i < kReaderSlots; ++i) {
+    uint64_t backoff = 1;
+    while (AtomicLoad(&reader_slots_[i].count, std::memory_order_acquire) !=
+           0) {
+      for (uint64_t j = 0; j < backoff; j++) {
+        enc_pause();
+      }
+      if (backoff < kMaxBackoffPauses) {
+        backoff *= 2;
+      }
+    }
+  }
+}
+
+bool TrustedRWLock::TryWriteLock() {
+  if (!writer_lock_.TryLock()) {
+    return false;
+  }
+  AtomicStore(&writer_present_, 1u);
+  for (size_t i = 0; i < kReaderSlots; ++i) {
+    if (AtomicLoad(&reader_slots_[i].count, std::memory_order_acquire) != 0) {
+      // An active reader holds the lock; undo the announcement.
+      AtomicStore(&writer_present_, 0u, std::memory_order_release);
+      writer_lock_.Unlock();
+      return false;
+    }
+  }
+  return true;
+}
+
+void TrustedRWLock::WriteUnlock() {
+  // Clearing the announcement admits every reader spinning on it as a batch;
+  // releasing the ticket lock hands exclusivity to the next queued writer,
+  // which will in turn wait for that reader batch to drain.
+  AtomicStore(&writer_present_, 0u, std::memory_order_release);
+  writer_lock_.Unlock();
+}
+
+}  // namespace asylo
@@ -0,0 +1,107 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_CORE_TRUSTED_RWLOCK_H_
+#define ASYLO_PLATFORM_CORE_TRUSTED_RWLOCK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "asylo/platform/core/atomic.h"
+#include "asylo/platform/core/trusted_spin_lock.h"
+
+namespace asylo {
+
+// A scalable reader-writer lock depending on only trusted resources.
+//
+// Reader acquisitions register in one of kReaderSlots cache-line-padded
+// counters selected by hashing the calling thread, so concurrent readers on
+// different slots never touch a shared cache line and read-mostly workloads
+// scale with core count instead of serializing on a single lock word.
+//
+// Writers serialize through a fair ticket lock, announce a write phase, and
+// wait for in-flight readers to drain. Readers arriving after the
+// announcement back their registration out and spin until the write phase
+// ends, at which point all of them are admitted as a batch. Under contention
+// read and write phases therefore alternate and neither side starves, in the
+// style of a phase-fair lock.
+//
+// The lock is not recursive, and a thread must release a read lock from the
+// same thread that acquired it (the release must find the reader counter the
+// acquisition incremented).
+class TrustedRWLock {
+ public:
+  // Number of cache-line-padded reader counters. A power of two so slot
+  // selection is a mask, sized to cover the core counts enclaves run on.
+  static constexpr size_t kReaderSlots = 16;
+
+  constexpr TrustedRWLock()
+      : reader_slots_(),
+        writer_present_(0),
+        writer_lock_(/*is_recursive=*/false, /*is_fair=*/true) {}
+
+  ~TrustedRWLock() = default;
+
+  // Blocks until a read lock is acquired. Multiple threads may hold read
+  // locks concurrently.
+  void ReadLock();
+
+  // Tries to acquire a read lock without blocking. Returns true on success.
+  bool TryReadLock();
+
+  // Releases a read lock held by the calling thread.
+  void ReadUnlock();
+
+  // Blocks until the write lock is acquired. The write lock excludes both
+  // readers and other writers.
+  void WriteLock();
+
+  // Tries to acquire the write lock without blocking. Returns true on
+  // success.
+  bool TryWriteLock();
+
+  // Releases the write lock, admitting any readers that queued behind it.
+  void WriteUnlock();
+
+ private:
+  // A per-slot reader counter occupying a full cache line so that readers
+  // hashing to different slots never share a line.
+  struct alignas(kCacheLineSize) ReaderSlot {
+    volatile uint64_t count;
+  };
+
+  static_assert(sizeof(ReaderSlot) == kCacheLineSize,
+                "ReaderSlot must be sizeof a cache line.");
+
+  // Returns the reader counter slot for the calling thread.
+  ReaderSlot *SlotForThread();
+
+  // Reader registration counters, indexed by hashed thread identity.
+  ReaderSlot reader_slots_[kReaderSlots];
+
+  // Nonzero while a writer holds the lock or is draining readers. Readers
+  // check it after registering; a nonzero value makes them back out and wait.
+  volatile uint32_t writer_present_;
+
+  // Serializes writers in FIFO order so writers cannot starve each other.
+  TrustedSpinLock writer_lock_;
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_CORE_TRUSTED_RWLOCK_H_
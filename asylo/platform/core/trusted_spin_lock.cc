@@ -23,12 +23,52 @@
 #include <cstdlib>
 
 #include "asylo/platform/primitives/trusted_primitives.h"
+#include "asylo/platform/primitives/util/trusted_spin_calibration.h"
 
 namespace asylo {
 
 void TrustedSpinLock::Lock() {
+  if (is_recursive_ && owner_ == enc_thread_self()) {
+    recursive_lock_count_++;
+    return;
+  }
+
+  if (is_fair_) {
+    // Draw the next ticket and wait for it to be served. Tickets hand the
+    // lock over in FIFO order, so no waiter can be starved by later arrivals.
+    const uint32_t ticket =
+        AtomicIncrement(&next_ticket_, std::memory_order_relaxed);
+    const uint64_t max_backoff = primitives::MaxBackoffPauses();
+    uint64_t backoff = 1;
+    while (AtomicLoad(&serving_ticket_, std::memory_order_acquire) != ticket) {
+      for (uint64_t i = 0; i < backoff; i++) {
+        enc_pause();
+      }
+      if (backoff < max_backoff) {
+        backoff *= 2;
+      }
+    }
+    owner_ = enc_thread_self();
+    recursive_lock_count_ = 1;
+    return;
+  }
+
+  // The burst cap comes from the boot-time spin calibration, so the latency
+  // of noticing an unlock tracks the actual pause cost on this hardware.
+  const uint64_t max_backoff = primitives::MaxBackoffPauses();
+  uint64_t backoff = 1;
   while (!TryLock()) {
-    enc_pause();
+    // Spin on a plain read until the lock looks free, with exponentially
+    // increasing enc_pause() bursts between probes, so that waiters do not
+    // hammer the lock's cache line with compare-and-swap traffic.
+    while (spin_lock_ != kUnlocked) {
+      for (uint64_t i = 0; i < backoff; i++) {
+        enc_pause();
+      }
+      if (backoff < max_backoff) {
+        backoff *= 2;
+      }
+    }
   }
 }
 
@@ -40,6 +80,24 @@ bool TrustedSpinLock::TryLock() {
     return true;
   }
 
+  if (is_fair_) {
+    // The lock is free exactly when the next ticket is the one being served;
+    // claim the lock by drawing that ticket.
+    uint32_t expected =
+        AtomicLoad(&serving_ticket_, std::memory_order_relaxed);
+    if (AtomicLoad(&next_ticket_, std::memory_order_relaxed) != expected) {
+      return false;
+    }
+    if (AtomicCompareExchange(&next_ticket_, &expected, expected + 1,
+                              /*weak=*/true, std::memory_order_acquire,
+                              std::memory_order_relaxed)) {
+      owner_ = enc_thread_self();
+      recursive_lock_count_ = 1;
+      return true;
+    }
+    return false;
+  }
+
   // This read of spin_lock_ does not need any atomicity. There are 3
   // cases to consider: 1) this thread holds the lock, 2) another
   // thread holds the lock, or 3) no thread holds the lock.
@@ -85,7 +143,12 @@ void TrustedSpinLock::Unlock() {
   recursive_lock_count_--;
   if (recursive_lock_count_ == 0) {
     owner_ = kInvalidThread;
-    AtomicClear(&spin_lock_, std::memory_order_release);
+    if (is_fair_) {
+      // Serve the next ticket, handing the lock to the oldest waiter.
+      AtomicIncrement(&serving_ticket_, std::memory_order_release);
+    } else {
+      AtomicClear(&spin_lock_, std::memory_order_release);
+    }
   }
 }
 
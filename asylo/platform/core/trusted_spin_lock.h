@@ -48,11 +48,17 @@ class alignas(kCacheLineSize) TrustedSpinLock {
   // mutex is a recursive lock and may 1) be locked more than once by the caller
   // and 2) does not become free until it is unlocked a corresponding number of
   // times. This optional functionality is provided for compatibility with
-  // pthread_mutex.
-  constexpr explicit TrustedSpinLock(bool is_recursive)
+  // pthread_mutex. If |is_fair| is true, the lock grants ownership in ticket
+  // order: waiters acquire the lock in the order they arrived rather than
+  // racing for the lock word, at the cost of serializing handoff under
+  // contention.
+  constexpr explicit TrustedSpinLock(bool is_recursive, bool is_fair = false)
       : spin_lock_(kUnlocked),
+        next_ticket_(0),
+        serving_ticket_(0),
         owner_(kInvalidThread),
         is_recursive_(is_recursive),
+        is_fair_(is_fair),
         recursive_lock_count_(0) {}
 
   ~TrustedSpinLock() = default;
@@ -88,6 +94,12 @@ class alignas(kCacheLineSize) TrustedSpinLock {
   // A synchronization value in untrusted memory, aligned to a cache line.
   volatile uint32_t spin_lock_;
 
+  // Ticket dispenser and display used when the lock is configured as fair.
+  // The lock is free when the two are equal; a waiter owns the lock while
+  // serving_ticket_ equals the ticket it drew.
+  volatile uint32_t next_ticket_;
+  volatile uint32_t serving_ticket_;
+
   // The enc_thread_self() value of the thread that owns the lock, or zero if
   // the mutex is unlocked.
   volatile uint64_t owner_;
@@ -95,6 +107,9 @@ class alignas(kCacheLineSize) TrustedSpinLock {
   // True if this mutex has been configured as a recursive lock.
   const bool is_recursive_;
 
+  // True if this mutex grants ownership in ticket (FIFO) order.
+  const bool is_fair_;
+
   // The number of times this lock has been locked recursively.
   uint64_t recursive_lock_count_;
 };
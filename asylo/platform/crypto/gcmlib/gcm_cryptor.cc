@@ -150,40 +150,51 @@ bool GcmCryptor::EncryptBlock(const uint8_t *plaintext_data, uint8_t *token,
     return false;
   }
 
-  absl::MutexLock lock(&mu_);
-
-  if (1 != RAND_bytes(next_token_.nonce, kNonceLength)) {
-    LOG(ERROR)
-        << "Failed to generate random nonce for GcmCryptor::EncryptBlock: "
-        << BsslLastErrorString();
-    return false;
-  }
-
-  if (key_id_counter_ % kKeyIdCycle == 0) {
-    key_id_counter_ = 0;
+  // Generate the per-block token and snapshot the derived key under the lock,
+  // but perform the AEAD seal outside of it so that independent blocks can be
+  // encrypted concurrently.
+  Token block_token;
+  GcmCryptorKey derived_key;
+  {
+    absl::MutexLock lock(&mu_);
 
-    if (1 != RAND_bytes(next_token_.key_id, kKeyIdLength)) {
+    if (1 != RAND_bytes(next_token_.nonce, kNonceLength)) {
       LOG(ERROR)
-          << "Failed to generate random token for GcmCryptor::EncryptBlock: "
+          << "Failed to generate random nonce for GcmCryptor::EncryptBlock: "
           << BsslLastErrorString();
       return false;
     }
 
-    if (!GenerateDerivedGcmKey(next_token_.key_id, &next_derived_key_)) {
-      LOG(ERROR) << "Failed to derive key for GcmCryptor::EncryptBlock: "
-                 << BsslLastErrorString();
-      return false;
+    if (key_id_counter_ % kKeyIdCycle == 0) {
+      key_id_counter_ = 0;
+
+      if (1 != RAND_bytes(next_token_.key_id, kKeyIdLength)) {
+        LOG(ERROR)
+            << "Failed to generate random token for GcmCryptor::EncryptBlock: "
+            << BsslLastErrorString();
+        return false;
+      }
+
+      if (!GenerateDerivedGcmKey(next_token_.key_id, &next_derived_key_)) {
+        LOG(ERROR) << "Failed to derive key for GcmCryptor::EncryptBlock: "
+                   << BsslLastErrorString();
+        return false;
+      }
     }
-  }
 
-  // Increment the key reuse counter only if the key was successfully generated.
-  key_id_counter_++;
+    // Increment the key reuse counter only if the key was successfully
+    // generated.
+    key_id_counter_++;
+
+    block_token = next_token_;
+    derived_key = next_derived_key_;
+  }
 
   EVP_AEAD_CTX context;
   if (!EVP_AEAD_CTX_init(
           &context, EVP_aead_aes_256_gcm(),
-          reinterpret_cast<const uint8_t *>(next_derived_key_.data()),
-          kKeyLength, kTagLength, nullptr)) {
+          reinterpret_cast<const uint8_t *>(derived_key.data()), kKeyLength,
+          kTagLength, nullptr)) {
     LOG(ERROR) << "EVP_AEAD_CTX_init failed: " << BsslLastErrorString();
     EVP_AEAD_CTX_cleanup(&context);
     return false;
@@ -192,8 +203,9 @@ bool GcmCryptor::EncryptBlock(const uint8_t *plaintext_data, uint8_t *token,
   size_t ciphertext_length;
   size_t max_ciphertext_length = kBlockLength + kTagLength;
   if (!EVP_AEAD_CTX_seal(&context, ciphertext_data, &ciphertext_length,
-                         max_ciphertext_length, next_token_.nonce, kNonceLength,
-                         plaintext_data, kBlockLength, nullptr, 0)) {
+                         max_ciphertext_length, block_token.nonce,
+                         kNonceLength, plaintext_data, kBlockLength, nullptr,
+                         0)) {
     LOG(ERROR) << "EVP_AEAD_CTX_seal failed: " << BsslLastErrorString();
     EVP_AEAD_CTX_cleanup(&context);
     return false;
@@ -207,7 +219,7 @@ bool GcmCryptor::EncryptBlock(const uint8_t *plaintext_data, uint8_t *token,
     return false;
   }
 
-  memcpy(token, next_token_.data(), kTokenLength);
+  memcpy(token, block_token.data(), kTokenLength);
 
   EVP_AEAD_CTX_cleanup(&context);
   return true;
@@ -0,0 +1,77 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_HOST_CALL_EPOLL_EVENT_RING_H_
+#define ASYLO_PLATFORM_HOST_CALL_EPOLL_EVENT_RING_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "asylo/platform/common/ring_buffer.h"
+
+namespace asylo {
+namespace host_call {
+
+// This file defines the shared-memory completion channel between an untrusted
+// epoll event engine and its trusted consumer. The ring is allocated in
+// untrusted memory; the engine's poller thread is its only writer and the
+// trusted IOContextEpoll draining it is its only reader. Ready epoll events
+// flow through the ring as fixed-size records, so that in steady state the
+// enclave observes events without an enclave exit per epoll_wait().
+//
+// The records inherit the security posture of RingBuffer: their content is
+// untrusted, and trusted consumers must copy each record out of the ring
+// before interpreting it.
+
+// Capacity in bytes of an epoll completion ring.
+constexpr size_t kEpollEventRingCapacity = 64 * 1024;
+
+// A single ready epoll event deposited by the untrusted poller thread.
+struct EpollEventRecord {
+  uint64_t data;      // epoll_data as registered with EPOLL_CTL_ADD.
+  uint32_t events;    // klinux epoll event mask reported by the host.
+  uint32_t reserved;  // Padding; always zero.
+} __attribute__((aligned(8)));
+
+using EpollEventRing = RingBuffer<kEpollEventRingCapacity>;
+
+// Writes |record| to |ring|, blocking while the ring is full. The caller must
+// be the only writer of |ring|. Returns false if the ring was closed for
+// reading before the full record could be written.
+inline bool EnqueueEpollEventRecord(EpollEventRing *ring,
+                                    const EpollEventRecord &record) {
+  return ring->Write(reinterpret_cast<const uint8_t *>(&record),
+                     sizeof(record)) == sizeof(record);
+}
+
+// Copies one record out of |ring| into |*record| without blocking. The caller
+// must be the only reader of |ring|. Returns false if the ring does not hold
+// a complete record.
+inline bool DequeueEpollEventRecord(EpollEventRing *ring,
+                                    EpollEventRecord *record) {
+  if (ring->size() < sizeof(*record)) {
+    return false;
+  }
+  return ring->Read(reinterpret_cast<uint8_t *>(record), sizeof(*record)) ==
+         sizeof(*record);
+}
+
+}  // namespace host_call
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_HOST_CALL_EPOLL_EVENT_RING_H_
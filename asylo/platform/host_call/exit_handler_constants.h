@@ -139,9 +139,99 @@ static constexpr uint64_t kSysFutexWakeHandler =
 static constexpr uint64_t kLocalLifetimeAllocHandler =
     primitives::kSelectorHostCall + 30;
 
+// Exit handler constant for |WritevHandler|.
+static constexpr uint64_t kWritevHandler = primitives::kSelectorHostCall + 31;
+
+// Exit handler constant for |ReadvHandler|.
+static constexpr uint64_t kReadvHandler = primitives::kSelectorHostCall + 32;
+
+// Exit handler constant for |AsyncSystemCallSubmitHandler|.
+static constexpr uint64_t kAsyncSystemCallSubmitHandler =
+    primitives::kSelectorHostCall + 33;
+
+// Exit handler constant for |AsyncSystemCallCollectHandler|.
+static constexpr uint64_t kAsyncSystemCallCollectHandler =
+    primitives::kSelectorHostCall + 34;
+
+// Exit handler constant for |EpollEventEngineSetupHandler|.
+static constexpr uint64_t kEpollEventEngineSetupHandler =
+    primitives::kSelectorHostCall + 35;
+
+// Exit handler constant for |EpollEventEngineWaitHandler|.
+static constexpr uint64_t kEpollEventEngineWaitHandler =
+    primitives::kSelectorHostCall + 36;
+
+// Exit handler constant for |EpollEventEngineTeardownHandler|.
+static constexpr uint64_t kEpollEventEngineTeardownHandler =
+    primitives::kSelectorHostCall + 37;
+
+// Exit handler constant for |SysFutexRequeueHandler|.
+static constexpr uint64_t kSysFutexRequeueHandler =
+    primitives::kSelectorHostCall + 38;
+
+// Exit handler constant for |SendMMsgHandler|.
+static constexpr uint64_t kSendMMsgHandler = primitives::kSelectorHostCall + 39;
+
+// Exit handler constant for |RecvMMsgHandler|.
+static constexpr uint64_t kRecvMMsgHandler = primitives::kSelectorHostCall + 40;
+
+// Exit handler constant for |FdReadinessSetupHandler|.
+static constexpr uint64_t kFdReadinessSetupHandler =
+    primitives::kSelectorHostCall + 41;
+
+// Exit handler constant for |FdReadinessSubscribeHandler|.
+static constexpr uint64_t kFdReadinessSubscribeHandler =
+    primitives::kSelectorHostCall + 42;
+
+// Exit handler constant for |FdReadinessUnsubscribeHandler|.
+static constexpr uint64_t kFdReadinessUnsubscribeHandler =
+    primitives::kSelectorHostCall + 43;
+
+// Exit handler constant for |FdReadinessTeardownHandler|.
+static constexpr uint64_t kFdReadinessTeardownHandler =
+    primitives::kSelectorHostCall + 44;
+
+// Exit handler constant for |RecvBufRingSetupHandler|.
+static constexpr uint64_t kRecvBufRingSetupHandler =
+    primitives::kSelectorHostCall + 45;
+
+// Exit handler constant for |RecvBufRingRecvHandler|.
+static constexpr uint64_t kRecvBufRingRecvHandler =
+    primitives::kSelectorHostCall + 46;
+
+// Exit handler constant for |RecvBufRingTeardownHandler|.
+static constexpr uint64_t kRecvBufRingTeardownHandler =
+    primitives::kSelectorHostCall + 47;
+
+// Exit handler constant for |PWritevHandler|.
+static constexpr uint64_t kPWritevHandler = primitives::kSelectorHostCall + 48;
+
+// Exit handler constant for |PReadvHandler|.
+static constexpr uint64_t kPReadvHandler = primitives::kSelectorHostCall + 49;
+
+// Exit handler constant for |PIoSubmitHandler|.
+static constexpr uint64_t kPIoSubmitHandler =
+    primitives::kSelectorHostCall + 50;
+
+// Exit handler constant for |TimedSystemCallHandler|.
+static constexpr uint64_t kTimedSystemCallHandler =
+    primitives::kSelectorHostCall + 51;
+
+// Maximum number of messages moved by one batched sendmsg/recvmsg host call
+// (|kSendMMsgHandler|/|kRecvMMsgHandler|). Both ends of the serialized call
+// protocol rely on this bound: the trusted side clamps its batch to it and
+// the untrusted handler rejects anything larger as malformed.
+static constexpr uint64_t kMaxMmsgBatch = 64;
+
+// Maximum number of operations moved by one batched positional I/O host call
+// (|kPIoSubmitHandler|). As with kMaxMmsgBatch, the trusted side clamps its
+// batch to this bound and the untrusted handler rejects anything larger as
+// malformed.
+static constexpr uint64_t kMaxPIoBatch = 64;
+
 // Assert that the largest host call handler lies in
 // [kSelectorHostCall, kSelectorRemote).
-static_assert(kLocalLifetimeAllocHandler < primitives::kSelectorRemote,
+static_assert(kTimedSystemCallHandler < primitives::kSelectorRemote,
               "Cannot have host call handler constant spill over into "
               "|kSelectorRemote|.");
 
@@ -0,0 +1,125 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_HOST_CALL_FD_READINESS_MAP_H_
+#define ASYLO_PLATFORM_HOST_CALL_FD_READINESS_MAP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace asylo {
+namespace host_call {
+
+// This file defines the shared-memory readiness map between an untrusted fd
+// readiness engine and its trusted consumers. The map is allocated in
+// untrusted memory; the engine's poller thread sets readiness bits for
+// subscribed host file descriptors as their edges arrive, and trusted pollers
+// (the IOManager select/poll fast paths) test and clear them without an
+// enclave exit.
+//
+// The map carries hints, not ground truth: a trusted consumer that finds no
+// bits set must fall back to a real host poll, and one that finds stale bits
+// merely reports a spurious readiness, which poll(2) semantics already
+// require callers to tolerate. A misbehaving host can therefore delay or
+// fabricate readiness reports, but could do the same to the host calls the
+// map replaces.
+
+// Number of host file descriptors the map can track. File descriptors at or
+// above this bound cannot be subscribed and always take the host call path.
+constexpr size_t kFdReadinessMapSlots = 1024;
+
+// Readiness bits deposited per file descriptor. The map defines its own bits
+// instead of reusing POLL* constants because the enclave C library and the
+// host may disagree on their values.
+constexpr uint32_t kFdReadinessReadable = 1u << 0;
+constexpr uint32_t kFdReadinessWritable = 1u << 1;
+constexpr uint32_t kFdReadinessError = 1u << 2;
+constexpr uint32_t kFdReadinessHangup = 1u << 3;
+
+// Shared readiness state, one atomic event word per host file descriptor.
+// The untrusted poller thread ORs bits in; trusted consumers clear the bits
+// they report, so an unconsumed hint survives until somebody acts on it.
+struct FdReadinessMap {
+  FdReadinessMap() : instance_version(TypeVersion()) {
+    for (size_t i = 0; i < kFdReadinessMapSlots; ++i) {
+      events[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // A signature of the layout this header was compiled against, mixing the
+  // slot count and object size. Trusted consumers compare a candidate map's
+  // |instance_version| against their own TypeVersion() before using it.
+  static constexpr uint64_t TypeVersion() {
+    return kFdReadinessMapSlots |
+           static_cast<uint64_t>(sizeof(std::atomic<uint32_t>)) << 32;
+  }
+
+  uint64_t InstanceVersion() const { return instance_version; }
+
+  const uint64_t instance_version;
+  std::atomic<uint32_t> events[kFdReadinessMapSlots];
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "FdReadinessMap is shared across the enclave boundary and "
+              "requires plain 32-bit atomic words.");
+
+// Returns true if |fd| falls inside the range the map tracks.
+inline bool FdReadinessInRange(int fd) {
+  return fd >= 0 && static_cast<size_t>(fd) < kFdReadinessMapSlots;
+}
+
+// ORs |bits| into the event word of |fd|. Called by the untrusted poller
+// thread; a no-op for out-of-range descriptors.
+inline void MarkFdReadiness(FdReadinessMap *map, int fd, uint32_t bits) {
+  if (FdReadinessInRange(fd)) {
+    map->events[fd].fetch_or(bits, std::memory_order_release);
+  }
+}
+
+// Returns the pending readiness bits of |fd| without consuming them, or 0 for
+// out-of-range descriptors.
+inline uint32_t TestFdReadiness(const FdReadinessMap *map, int fd) {
+  if (!FdReadinessInRange(fd)) {
+    return 0;
+  }
+  return map->events[fd].load(std::memory_order_acquire);
+}
+
+// Clears |bits| from the event word of |fd|, so a consumer can retire exactly
+// the hints it reported while leaving concurrently-deposited ones pending.
+inline void ClearFdReadiness(FdReadinessMap *map, int fd, uint32_t bits) {
+  if (FdReadinessInRange(fd)) {
+    map->events[fd].fetch_and(~bits, std::memory_order_acq_rel);
+  }
+}
+
+// Clears all pending bits of |fd|, returning the bits that were set. Used
+// when a slot is recycled for a new subscription.
+inline uint32_t ConsumeFdReadiness(FdReadinessMap *map, int fd) {
+  if (!FdReadinessInRange(fd)) {
+    return 0;
+  }
+  return map->events[fd].exchange(0, std::memory_order_acq_rel);
+}
+
+}  // namespace host_call
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_HOST_CALL_FD_READINESS_MAP_H_
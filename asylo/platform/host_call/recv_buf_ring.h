@@ -0,0 +1,108 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_HOST_CALL_RECV_BUF_RING_H_
+#define ASYLO_PLATFORM_HOST_CALL_RECV_BUF_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace asylo {
+namespace host_call {
+
+// This file defines the pre-registered untrusted receive buffer ring shared
+// between the untrusted recv handlers and their trusted callers. A ring is
+// pinned per socket for the socket's lifetime; the host recv lands directly
+// in one of its reusable slots, so a large read costs one copy from the slot
+// into the trusted caller buffer instead of an untrusted scratch allocation,
+// a serialization into the exit message and a copy out of it. Callers that
+// opt into untrusted-placement semantics borrow the slot itself and skip the
+// final copy too.
+//
+// Slot claiming is a host-side concern; the trusted side only ever copies
+// out of a slot it was handed and then releases it. As with every structure
+// in untrusted memory, a misbehaving host can corrupt slot contents, but it
+// could equally corrupt the serialized payloads the ring replaces.
+
+// Number of receive slots per ring. Bounds the recvs that can be in flight
+// on one socket before the handlers fall back to the serializing path.
+constexpr size_t kRecvBufRingSlots = 8;
+
+// Capacity of each receive slot in bytes. Host recvs through the ring are
+// clamped to this size; sockets deliver the remainder to the next call.
+constexpr size_t kRecvBufRingSlotSize = 64 * 1024;
+
+// Per-slot claim states.
+constexpr uint32_t kRecvBufSlotFree = 0;
+constexpr uint32_t kRecvBufSlotClaimed = 1;
+
+// A ring of reusable untrusted receive buffers for one socket. The untrusted
+// recv handler claims a slot, receives into it and hands its index back; the
+// consumer releases the slot once it is done with the payload.
+struct RecvBufRing {
+  RecvBufRing() : instance_version(TypeVersion()) {
+    for (size_t i = 0; i < kRecvBufRingSlots; ++i) {
+      slot_state[i].store(kRecvBufSlotFree, std::memory_order_relaxed);
+    }
+  }
+
+  // A signature of the layout this header was compiled against, mixing the
+  // slot count and slot size. Trusted consumers compare a candidate ring's
+  // |instance_version| against their own TypeVersion() before using it.
+  static constexpr uint64_t TypeVersion() {
+    return kRecvBufRingSlots | static_cast<uint64_t>(kRecvBufRingSlotSize)
+                                   << 32;
+  }
+
+  uint64_t InstanceVersion() const { return instance_version; }
+
+  const uint64_t instance_version;
+  std::atomic<uint32_t> slot_state[kRecvBufRingSlots];
+  char slots[kRecvBufRingSlots][kRecvBufRingSlotSize];
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "RecvBufRing is shared across the enclave boundary and "
+              "requires plain 32-bit atomic words.");
+
+// Claims a free slot of |ring| for an in-flight recv, returning its index or
+// -1 when every slot is claimed.
+inline int ClaimRecvBufSlot(RecvBufRing *ring) {
+  for (size_t i = 0; i < kRecvBufRingSlots; ++i) {
+    uint32_t expected = kRecvBufSlotFree;
+    if (ring->slot_state[i].compare_exchange_strong(
+            expected, kRecvBufSlotClaimed, std::memory_order_acq_rel)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+// Returns slot |index| of |ring| to the free pool. Called by the consumer
+// after it has copied the payload out or finished reading it in place.
+inline void ReleaseRecvBufSlot(RecvBufRing *ring, int index) {
+  if (index >= 0 && static_cast<size_t>(index) < kRecvBufRingSlots) {
+    ring->slot_state[index].store(kRecvBufSlotFree, std::memory_order_release);
+  }
+}
+
+}  // namespace host_call
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_HOST_CALL_RECV_BUF_RING_H_
@@ -118,6 +118,8 @@ constexpr uint64_t kTestPread64 =
     kFirstSelector + asylo::system_call::kSYS_pread64;
 constexpr uint64_t kTestPwrite64 =
     kFirstSelector + asylo::system_call::kSYS_pwrite64;
+constexpr uint64_t kTestSendfile =
+    kFirstSelector + asylo::system_call::kSYS_sendfile;
 constexpr uint64_t kTestPipe2 = kFirstSelector + asylo::system_call::kSYS_pipe2;
 constexpr uint64_t kTestNanosleep =
     kFirstSelector + asylo::system_call::kSYS_nanosleep;
@@ -153,6 +155,16 @@ constexpr uint64_t kTestRaise = kHostLibCSelector + 11;
 constexpr uint64_t kTestGetSockOpt = kHostLibCSelector + 12;
 constexpr uint64_t kTestGetAddrInfo = kHostLibCSelector + 13;
 constexpr uint64_t kTestClockGettime = kHostLibCSelector + 14;
+constexpr uint64_t kTestWritev = kHostLibCSelector + 15;
+constexpr uint64_t kTestReadv = kHostLibCSelector + 16;
+constexpr uint64_t kTestBufferedWrite = kHostLibCSelector + 17;
+constexpr uint64_t kTestFlushBufferedWrites = kHostLibCSelector + 18;
+constexpr uint64_t kTestSendMMsg = kHostLibCSelector + 19;
+constexpr uint64_t kTestRecvMMsg = kHostLibCSelector + 20;
+constexpr uint64_t kTestRecvBufRing = kHostLibCSelector + 21;
+constexpr uint64_t kTestPWritev = kHostLibCSelector + 22;
+constexpr uint64_t kTestPReadv = kHostLibCSelector + 23;
+constexpr uint64_t kTestPIoSubmit = kHostLibCSelector + 24;
 
 }  // namespace host_call
 }  // namespace asylo
@@ -553,6 +553,115 @@ TEST_F(HostCallTest, TestRecvMsg) {
   close(connection_socket);
 }
 
+// Tests enc_untrusted_sendmmsg() by sending a batch of 2 datagrams from inside
+// the enclave with a single host call, and verifying that both datagrams
+// arrive intact on the host end of the socket pair.
+TEST_F(HostCallTest, TestSendMMsg) {
+  int socket_fds[2];
+  ASSERT_THAT(socketpair(AF_UNIX, SOCK_DGRAM, 0, socket_fds), Not(Eq(-1)));
+
+  constexpr char kMsg1[] = "First sendmmsg datagram.";
+  constexpr char kMsg2[] = "Second sendmmsg datagram.";
+
+  MessageWriter in;
+  in.Push<int>(/*value=sockfd=*/socket_fds[0]);
+  in.PushByReference(Extent{kMsg1, sizeof(kMsg1)});
+  in.PushByReference(Extent{kMsg2, sizeof(kMsg2)});
+  in.Push<int>(/*value=flags=*/0);
+  MessageReader out;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestSendMMsg, &in, &out));
+  ASSERT_THAT(out, SizeIs(3));  // Contains message count and per-message size.
+  EXPECT_THAT(out.next<int64_t>(), Eq(2));
+  EXPECT_THAT(out.next<uint64_t>(), Eq(sizeof(kMsg1)));
+  EXPECT_THAT(out.next<uint64_t>(), Eq(sizeof(kMsg2)));
+
+  // Each datagram preserves its own boundary on the receiving side.
+  char read_buf[64];
+  ASSERT_THAT(recv(socket_fds[1], read_buf, sizeof(read_buf), 0),
+              Eq(sizeof(kMsg1)));
+  EXPECT_THAT(read_buf, StrEq(kMsg1));
+  ASSERT_THAT(recv(socket_fds[1], read_buf, sizeof(read_buf), 0),
+              Eq(sizeof(kMsg2)));
+  EXPECT_THAT(read_buf, StrEq(kMsg2));
+
+  close(socket_fds[0]);
+  close(socket_fds[1]);
+}
+
+// Tests enc_untrusted_recvmmsg() by queueing 2 datagrams on a socket pair and
+// receiving both from inside the enclave with a single host call, verifying
+// that each datagram lands in its own buffer.
+TEST_F(HostCallTest, TestRecvMMsg) {
+  int socket_fds[2];
+  ASSERT_THAT(socketpair(AF_UNIX, SOCK_DGRAM, 0, socket_fds), Not(Eq(-1)));
+
+  constexpr char kMsg1[] = "First recvmmsg datagram.";
+  constexpr char kMsg2[] = "Second recvmmsg datagram.";
+  ASSERT_THAT(send(socket_fds[0], kMsg1, sizeof(kMsg1), 0), Eq(sizeof(kMsg1)));
+  ASSERT_THAT(send(socket_fds[0], kMsg2, sizeof(kMsg2), 0), Eq(sizeof(kMsg2)));
+
+  MessageWriter in;
+  in.Push<int>(/*value=sockfd=*/socket_fds[1]);
+  in.Push<int>(sizeof(kMsg1));
+  in.Push<int>(sizeof(kMsg2));
+  in.Push<int>(/*value=flags=*/0);
+  MessageReader out;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestRecvMMsg, &in, &out));
+  ASSERT_THAT(out, SizeIs(3));  // Contains message count and both datagrams.
+  EXPECT_THAT(out.next<int64_t>(), Eq(2));
+  auto msg1_extent = out.next();
+  EXPECT_THAT(std::string(msg1_extent.As<char>(), msg1_extent.size()),
+              StrEq(std::string(kMsg1, sizeof(kMsg1))));
+  auto msg2_extent = out.next();
+  EXPECT_THAT(std::string(msg2_extent.As<char>(), msg2_extent.size()),
+              StrEq(std::string(kMsg2, sizeof(kMsg2))));
+
+  close(socket_fds[0]);
+  close(socket_fds[1]);
+}
+
+// Tests the pre-registered receive buffer ring: pins a ring to a socket from
+// inside the enclave, then receives one large datagram through the copying
+// recvfrom() path and one through the zero-copy borrow/release path, and
+// verifies both payloads arrive intact.
+TEST_F(HostCallTest, TestRecvBufRing) {
+  int socket_fds[2];
+  ASSERT_THAT(socketpair(AF_UNIX, SOCK_DGRAM, 0, socket_fds), Not(Eq(-1)));
+
+  // Large enough to cross the ring threshold inside the enclave.
+  constexpr size_t kPayloadSize = 8192;
+  std::string payload1(kPayloadSize, 'a');
+  std::string payload2(kPayloadSize, 'b');
+  for (size_t i = 0; i < kPayloadSize; i += 7) {
+    payload1[i] = static_cast<char>('0' + i % 10);
+  }
+  ASSERT_THAT(send(socket_fds[0], payload1.data(), payload1.size(), 0),
+              Eq(payload1.size()));
+  ASSERT_THAT(send(socket_fds[0], payload2.data(), payload2.size(), 0),
+              Eq(payload2.size()));
+
+  MessageWriter in;
+  in.Push<int>(/*value=sockfd=*/socket_fds[1]);
+  in.Push<uint64_t>(kPayloadSize);
+  in.Push<int>(/*value=flags=*/0);
+  MessageReader out;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestRecvBufRing, &in, &out));
+  ASSERT_THAT(out, SizeIs(6));
+  EXPECT_THAT(out.next<int>(), Eq(0));  // Ring enabled.
+  EXPECT_THAT(out.next<int64_t>(), Eq(kPayloadSize));
+  auto recv_extent = out.next();
+  EXPECT_THAT(std::string(recv_extent.As<char>(), recv_extent.size()),
+              StrEq(payload1));
+  EXPECT_THAT(out.next<int64_t>(), Eq(kPayloadSize));
+  auto borrow_extent = out.next();
+  EXPECT_THAT(std::string(borrow_extent.As<char>(), borrow_extent.size()),
+              StrEq(payload2));
+  EXPECT_THAT(out.next<int>(), Eq(0));  // Ring disabled.
+
+  close(socket_fds[0]);
+  close(socket_fds[1]);
+}
+
 // Tests enc_untrusted_link() by creating a file (|oldpath|) and calling
 // enc_untrusted_link() from inside the enclave to link it to |newpath|, then
 // verifying that |newpath| is indeed accessible.
@@ -818,6 +927,257 @@ TEST_F(HostCallTest, TestWrite) {
   EXPECT_THAT(read_buf, StrEq(write_buf));
 }
 
+// Tests enc_untrusted_writev() by making a host call from inside the enclave
+// to gather two separate buffers into a file, and verifying that the content
+// read from the file on the host matches their concatenation.
+TEST_F(HostCallTest, TestWritev) {
+  std::string test_file =
+      absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/test_file.tmp");
+
+  int fd =
+      open(test_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  platform::storage::FdCloser fd_closer(fd);
+  ASSERT_GE(fd, 0);
+  ASSERT_NE(access(test_file.c_str(), F_OK), -1);
+
+  std::string buf1 = "scattered ";
+  std::string buf2 = "segments";
+  MessageWriter in;
+  in.Push<int>(/*value=fd=*/fd);
+  in.PushByReference(Extent{buf1.c_str(), buf1.length()});
+  in.PushByReference(Extent{buf2.c_str(), buf2.length()});
+
+  MessageReader out;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestWritev, &in, &out));
+  ASSERT_THAT(out, SizeIs(1));  // Should only contain return value.
+  EXPECT_THAT(out.next<ssize_t>(), Eq(buf1.length() + buf2.length()));
+
+  ASSERT_THAT(lseek(fd, 0, SEEK_SET), Eq(0));
+  char read_buf[20];
+  ASSERT_THAT(read(fd, read_buf, buf1.length() + buf2.length()),
+              Eq(buf1.length() + buf2.length()));
+  read_buf[buf1.length() + buf2.length()] = '\0';
+  EXPECT_THAT(read_buf, StrEq(absl::StrCat(buf1, buf2)));
+}
+
+// Tests enc_untrusted_readv() by making a host call from inside the enclave to
+// scatter the content of a file across two separate buffers, and verifying
+// that each buffer received its slice of the content.
+TEST_F(HostCallTest, TestReadv) {
+  std::string test_file =
+      absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/test_file.tmp");
+
+  int fd =
+      open(test_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  platform::storage::FdCloser fd_closer(fd);
+  ASSERT_GE(fd, 0);
+  ASSERT_NE(access(test_file.c_str(), F_OK), -1);
+
+  std::string content = "first halfsecond half";
+  std::string buf1 = "first half";
+  std::string buf2 = "second half";
+  ASSERT_THAT(write(fd, content.c_str(), content.length()),
+              Eq(content.length()));
+  ASSERT_THAT(lseek(fd, 0, SEEK_SET), Eq(0));
+
+  MessageWriter in;
+  in.Push<int>(/*value=fd=*/fd);
+  in.Push<int>(/*value=buf1_size=*/buf1.length());
+  in.Push<int>(/*value=buf2_size=*/buf2.length());
+
+  MessageReader out;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestReadv, &in, &out));
+  ASSERT_THAT(out, SizeIs(3));  // Contains return value and both buffers.
+  EXPECT_THAT(out.next<ssize_t>(), Eq(content.length()));
+  auto buf1_extent = out.next();
+  EXPECT_THAT(std::string(buf1_extent.As<char>(), buf1_extent.size()),
+              StrEq(buf1));
+  auto buf2_extent = out.next();
+  EXPECT_THAT(std::string(buf2_extent.As<char>(), buf2_extent.size()),
+              StrEq(buf2));
+}
+
+// Tests enc_untrusted_pwritev() by making a host call from inside the enclave
+// to gather two buffers into a file at an explicit offset, and verifying that
+// the file offset of the descriptor is left untouched.
+TEST_F(HostCallTest, TestPWritev) {
+  std::string test_file =
+      absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/test_file.tmp");
+
+  int fd =
+      open(test_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  platform::storage::FdCloser fd_closer(fd);
+  ASSERT_GE(fd, 0);
+  ASSERT_NE(access(test_file.c_str(), F_OK), -1);
+
+  std::string prefix = "0123";
+  ASSERT_THAT(write(fd, prefix.c_str(), prefix.length()), Eq(prefix.length()));
+
+  std::string buf1 = "positional ";
+  std::string buf2 = "segments";
+  MessageWriter in;
+  in.Push<int>(/*value=fd=*/fd);
+  in.Push<int64_t>(/*value=offset=*/prefix.length());
+  in.PushByReference(Extent{buf1.c_str(), buf1.length()});
+  in.PushByReference(Extent{buf2.c_str(), buf2.length()});
+
+  MessageReader out;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestPWritev, &in, &out));
+  ASSERT_THAT(out, SizeIs(1));  // Should only contain return value.
+  EXPECT_THAT(out.next<ssize_t>(), Eq(buf1.length() + buf2.length()));
+
+  // The host-side file offset must still sit after the initial write.
+  EXPECT_THAT(lseek(fd, 0, SEEK_CUR), Eq(prefix.length()));
+
+  ASSERT_THAT(lseek(fd, 0, SEEK_SET), Eq(0));
+  std::string expected = absl::StrCat(prefix, buf1, buf2);
+  char read_buf[30];
+  ASSERT_THAT(read(fd, read_buf, expected.length()), Eq(expected.length()));
+  read_buf[expected.length()] = '\0';
+  EXPECT_THAT(read_buf, StrEq(expected));
+}
+
+// Tests enc_untrusted_preadv() by making a host call from inside the enclave
+// to scatter file content from an explicit offset across two buffers, and
+// verifying that the file offset of the descriptor is left untouched.
+TEST_F(HostCallTest, TestPReadv) {
+  std::string test_file =
+      absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/test_file.tmp");
+
+  int fd =
+      open(test_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  platform::storage::FdCloser fd_closer(fd);
+  ASSERT_GE(fd, 0);
+  ASSERT_NE(access(test_file.c_str(), F_OK), -1);
+
+  std::string content = "skip:first halfsecond half";
+  off_t offset = 5;  // Past "skip:".
+  std::string buf1 = "first half";
+  std::string buf2 = "second half";
+  ASSERT_THAT(write(fd, content.c_str(), content.length()),
+              Eq(content.length()));
+  ASSERT_THAT(lseek(fd, 0, SEEK_SET), Eq(0));
+
+  MessageWriter in;
+  in.Push<int>(/*value=fd=*/fd);
+  in.Push<int64_t>(/*value=offset=*/offset);
+  in.Push<int>(/*value=buf1_size=*/buf1.length());
+  in.Push<int>(/*value=buf2_size=*/buf2.length());
+
+  MessageReader out;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestPReadv, &in, &out));
+  ASSERT_THAT(out, SizeIs(3));  // Contains return value and both buffers.
+  EXPECT_THAT(out.next<ssize_t>(), Eq(buf1.length() + buf2.length()));
+  auto buf1_extent = out.next();
+  EXPECT_THAT(std::string(buf1_extent.As<char>(), buf1_extent.size()),
+              StrEq(buf1));
+  auto buf2_extent = out.next();
+  EXPECT_THAT(std::string(buf2_extent.As<char>(), buf2_extent.size()),
+              StrEq(buf2));
+
+  // The host-side file offset must be untouched by the positional read.
+  EXPECT_THAT(lseek(fd, 0, SEEK_CUR), Eq(0));
+}
+
+// Tests enc_untrusted_pio_submit() by issuing a positional write to one file
+// and a positional read from another as a single batched host call.
+TEST_F(HostCallTest, TestPIoSubmit) {
+  std::string write_file =
+      absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/pio_write.tmp");
+  std::string read_file =
+      absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/pio_read.tmp");
+
+  int write_fd =
+      open(write_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  platform::storage::FdCloser write_fd_closer(write_fd);
+  ASSERT_GE(write_fd, 0);
+  int read_fd =
+      open(read_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  platform::storage::FdCloser read_fd_closer(read_fd);
+  ASSERT_GE(read_fd, 0);
+
+  std::string write_buf = "batched write";
+  off_t write_offset = 3;
+  std::string read_content = "at:batched read";
+  off_t read_offset = 3;  // Past "at:".
+  std::string expected_read = "batched read";
+  ASSERT_THAT(write(read_fd, read_content.c_str(), read_content.length()),
+              Eq(read_content.length()));
+
+  MessageWriter in;
+  in.Push<int>(/*value=write_fd=*/write_fd);
+  in.PushByReference(Extent{write_buf.c_str(), write_buf.length()});
+  in.Push<int64_t>(/*value=write_offset=*/write_offset);
+  in.Push<int>(/*value=read_fd=*/read_fd);
+  in.Push<int>(/*value=read_count=*/expected_read.length());
+  in.Push<int64_t>(/*value=read_offset=*/read_offset);
+
+  MessageReader out;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestPIoSubmit, &in, &out));
+  ASSERT_THAT(out, SizeIs(4));  // Return value, both results, read buffer.
+  EXPECT_THAT(out.next<int>(), Eq(2));  // Both operations completed.
+  EXPECT_THAT(out.next<ssize_t>(), Eq(write_buf.length()));
+  EXPECT_THAT(out.next<ssize_t>(), Eq(expected_read.length()));
+  auto read_extent = out.next();
+  EXPECT_THAT(std::string(read_extent.As<char>(), read_extent.size()),
+              StrEq(expected_read));
+
+  // Verify the write landed at its offset.
+  ASSERT_THAT(lseek(write_fd, write_offset, SEEK_SET), Eq(write_offset));
+  char read_buf[20];
+  ASSERT_THAT(read(write_fd, read_buf, write_buf.length()),
+              Eq(write_buf.length()));
+  read_buf[write_buf.length()] = '\0';
+  EXPECT_THAT(read_buf, StrEq(write_buf));
+}
+
+// Tests write buffering by enabling it for a file from inside the enclave,
+// performing two small writes, and verifying that nothing reaches the host
+// until the buffer is explicitly flushed.
+TEST_F(HostCallTest, TestWriteBuffering) {
+  std::string test_file =
+      absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/test_file.tmp");
+
+  int fd =
+      open(test_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  platform::storage::FdCloser fd_closer(fd);
+  ASSERT_GE(fd, 0);
+  ASSERT_NE(access(test_file.c_str(), F_OK), -1);
+
+  std::string buf1 = "buffered ";
+  std::string buf2 = "writes";
+  MessageWriter in;
+  in.Push<int>(/*value=fd=*/fd);
+  in.PushByReference(Extent{buf1.c_str(), buf1.length()});
+  in.PushByReference(Extent{buf2.c_str(), buf2.length()});
+  in.Push<uint64_t>(/*value=capacity=*/64);
+
+  MessageReader out;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestBufferedWrite, &in, &out));
+  ASSERT_THAT(out, SizeIs(3));  // Enable result and two write results.
+  EXPECT_THAT(out.next<int>(), Eq(0));
+  EXPECT_THAT(out.next<ssize_t>(), Eq(buf1.length()));
+  EXPECT_THAT(out.next<ssize_t>(), Eq(buf2.length()));
+
+  // The writes are held in trusted memory: nothing has reached the host yet.
+  EXPECT_THAT(lseek(fd, 0, SEEK_END), Eq(0));
+
+  MessageWriter in2;
+  in2.Push<int>(/*value=fd=*/fd);
+  MessageReader out2;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestFlushBufferedWrites, &in2, &out2));
+  ASSERT_THAT(out2, SizeIs(2));  // Flush result and disable result.
+  EXPECT_THAT(out2.next<int>(), Eq(0));
+  EXPECT_THAT(out2.next<int>(), Eq(0));
+
+  ASSERT_THAT(lseek(fd, 0, SEEK_SET), Eq(0));
+  char read_buf[20];
+  ASSERT_THAT(read(fd, read_buf, buf1.length() + buf2.length()),
+              Eq(buf1.length() + buf2.length()));
+  read_buf[buf1.length() + buf2.length()] = '\0';
+  EXPECT_THAT(read_buf, StrEq(absl::StrCat(buf1, buf2)));
+}
+
 // Tests enc_untrusted_symlink() by attempting to create a symlink from inside
 // the enclave and verifying that the created symlink is accessible.
 TEST_F(HostCallTest, TestSymlink) {
@@ -1854,6 +2214,56 @@ TEST_F(HostCallTest, TestPwrite64) {
   EXPECT_THAT(read_buf, StrEq("hello world!"));
 }
 
+// Tests enc_untrusted_sendfile() by copying a byte range between two host
+// files, ensuring that the return value, the updated offset and the contents
+// of the destination file all match expectations.
+TEST_F(HostCallTest, TestSendfile) {
+  std::string in_path =
+      absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/sendfile_in.tmp");
+  std::string out_path =
+      absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/sendfile_out.tmp");
+  std::string content = "hello world!";
+
+  // Make sure the files do not exist.
+  for (const std::string &path : {in_path, out_path}) {
+    if (access(path.c_str(), F_OK) == 0) {
+      EXPECT_NE(unlink(path.c_str()), -1);
+    }
+  }
+
+  int in_fd =
+      open(in_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  platform::storage::FdCloser in_fd_closer(in_fd);
+  ASSERT_GE(in_fd, 0);
+  ASSERT_THAT(write(in_fd, content.c_str(), content.length()),
+              Eq(content.length()));
+
+  int out_fd =
+      open(out_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  platform::storage::FdCloser out_fd_closer(out_fd);
+  ASSERT_GE(out_fd, 0);
+
+  off_t offset = 6;
+  size_t count = 5;
+
+  MessageWriter in;
+  in.Push<int>(out_fd);
+  in.Push<int>(in_fd);
+  in.Push<off_t>(offset);
+  in.Push<size_t>(count);
+  MessageReader out;
+  ASYLO_ASSERT_OK(client_->EnclaveCall(kTestSendfile, &in, &out));
+  ASSERT_THAT(out, SizeIs(2));  // Contains return value and updated offset.
+  EXPECT_THAT(out.next<ssize_t>(), Eq(count));
+  EXPECT_THAT(out.next<off_t>(), Eq(offset + count));
+
+  char read_buf[20];
+  EXPECT_THAT(pread64(out_fd, read_buf, sizeof(read_buf), 0), Eq(count));
+  read_buf[count] = '\0';
+  // Bytes [6, 11) of 'hello world!' spell 'world'.
+  EXPECT_THAT(read_buf, StrEq("world"));
+}
+
 // Tests enc_untrusted_wait() by forking the current process, and having the
 // child process sleep for 5 seconds, then exit. The parent process performs a
 // wait, and once the wait completes, we make sure that the wait returns the pid
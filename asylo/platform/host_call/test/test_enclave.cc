@@ -401,6 +401,262 @@ PrimitiveStatus TestRecvMsg(void *context, MessageReader *in,
   return primitives::PrimitiveStatus::OkStatus();
 }
 
+PrimitiveStatus TestWritev(void *context, MessageReader *in,
+                           MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 3);
+
+  int fd = in->next<int>();
+  const auto buf1 = in->next();
+  const auto buf2 = in->next();
+
+  struct iovec iov[2];
+  memset(iov, 0, sizeof(iov));
+  iov[0].iov_base = reinterpret_cast<void *>(const_cast<char *>(buf1.As<char>()));
+  iov[0].iov_len = buf1.size();
+  iov[1].iov_base = reinterpret_cast<void *>(const_cast<char *>(buf2.As<char>()));
+  iov[1].iov_len = buf2.size();
+
+  out->Push<int64_t>(enc_untrusted_writev(fd, iov, /*iovcnt=*/2));
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+PrimitiveStatus TestReadv(void *context, MessageReader *in,
+                          MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 3);
+
+  int fd = in->next<int>();
+  int buf1_size = in->next<int>();
+  int buf2_size = in->next<int>();
+
+  std::unique_ptr<char[]> buf1(new char[buf1_size]);
+  std::unique_ptr<char[]> buf2(new char[buf2_size]);
+  struct iovec iov[2];
+  memset(iov, 0, sizeof(iov));
+  iov[0].iov_base = buf1.get();
+  iov[0].iov_len = buf1_size;
+  iov[1].iov_base = buf2.get();
+  iov[1].iov_len = buf2_size;
+
+  out->Push<int64_t>(enc_untrusted_readv(fd, iov, /*iovcnt=*/2));
+  out->PushByCopy(Extent{iov[0].iov_base, iov[0].iov_len});
+  out->PushByCopy(Extent{iov[1].iov_base, iov[1].iov_len});
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+PrimitiveStatus TestPWritev(void *context, MessageReader *in,
+                            MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 4);
+
+  int fd = in->next<int>();
+  off_t offset = in->next<int64_t>();
+  const auto buf1 = in->next();
+  const auto buf2 = in->next();
+
+  struct iovec iov[2];
+  memset(iov, 0, sizeof(iov));
+  iov[0].iov_base = reinterpret_cast<void *>(const_cast<char *>(buf1.As<char>()));
+  iov[0].iov_len = buf1.size();
+  iov[1].iov_base = reinterpret_cast<void *>(const_cast<char *>(buf2.As<char>()));
+  iov[1].iov_len = buf2.size();
+
+  out->Push<int64_t>(enc_untrusted_pwritev(fd, iov, /*iovcnt=*/2, offset));
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+PrimitiveStatus TestPReadv(void *context, MessageReader *in,
+                           MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 4);
+
+  int fd = in->next<int>();
+  off_t offset = in->next<int64_t>();
+  int buf1_size = in->next<int>();
+  int buf2_size = in->next<int>();
+
+  std::unique_ptr<char[]> buf1(new char[buf1_size]);
+  std::unique_ptr<char[]> buf2(new char[buf2_size]);
+  struct iovec iov[2];
+  memset(iov, 0, sizeof(iov));
+  iov[0].iov_base = buf1.get();
+  iov[0].iov_len = buf1_size;
+  iov[1].iov_base = buf2.get();
+  iov[1].iov_len = buf2_size;
+
+  out->Push<int64_t>(enc_untrusted_preadv(fd, iov, /*iovcnt=*/2, offset));
+  out->PushByCopy(Extent{iov[0].iov_base, iov[0].iov_len});
+  out->PushByCopy(Extent{iov[1].iov_base, iov[1].iov_len});
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+PrimitiveStatus TestPIoSubmit(void *context, MessageReader *in,
+                              MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 6);
+
+  // One positional write and one positional read on two different file
+  // descriptors, issued as a single batched host call.
+  int write_fd = in->next<int>();
+  const auto write_buf = in->next();
+  off_t write_offset = in->next<int64_t>();
+  int read_fd = in->next<int>();
+  int read_count = in->next<int>();
+  off_t read_offset = in->next<int64_t>();
+
+  std::unique_ptr<char[]> read_buf(new char[read_count]);
+  struct enc_positional_io_op ops[2];
+  memset(ops, 0, sizeof(ops));
+  ops[0].fd = write_fd;
+  ops[0].is_write = 1;
+  ops[0].buf = reinterpret_cast<void *>(const_cast<char *>(write_buf.As<char>()));
+  ops[0].count = write_buf.size();
+  ops[0].offset = write_offset;
+  ops[1].fd = read_fd;
+  ops[1].is_write = 0;
+  ops[1].buf = read_buf.get();
+  ops[1].count = read_count;
+  ops[1].offset = read_offset;
+
+  out->Push<int>(enc_untrusted_pio_submit(ops, /*op_count=*/2));
+  out->Push<int64_t>(ops[0].result);
+  out->Push<int64_t>(ops[1].result);
+  out->PushByCopy(Extent{read_buf.get(), static_cast<size_t>(read_count)});
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+PrimitiveStatus TestSendMMsg(void *context, MessageReader *in,
+                             MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 4);
+
+  int sockfd = in->next<int>();
+  const auto msg1 = in->next();
+  const auto msg2 = in->next();
+  int flags = in->next<int>();
+
+  constexpr size_t kNumMsgs = 2;
+  struct msghdr msgs[kNumMsgs];
+  memset(msgs, 0, sizeof(msgs));
+  struct iovec msg_iov[kNumMsgs];
+  memset(msg_iov, 0, sizeof(msg_iov));
+  msg_iov[0].iov_base =
+      reinterpret_cast<void *>(const_cast<char *>(msg1.As<char>()));
+  msg_iov[0].iov_len = msg1.size();
+  msg_iov[1].iov_base =
+      reinterpret_cast<void *>(const_cast<char *>(msg2.As<char>()));
+  msg_iov[1].iov_len = msg2.size();
+  msgs[0].msg_iov = &msg_iov[0];
+  msgs[0].msg_iovlen = 1;
+  msgs[1].msg_iov = &msg_iov[1];
+  msgs[1].msg_iovlen = 1;
+
+  unsigned int msg_lens[kNumMsgs] = {0, 0};
+  int result = enc_untrusted_sendmmsg(sockfd, msgs, kNumMsgs, flags, msg_lens);
+  out->Push<int64_t>(result);
+  for (int i = 0; i < result; ++i) {
+    out->Push<uint64_t>(msg_lens[i]);
+  }
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+PrimitiveStatus TestRecvMMsg(void *context, MessageReader *in,
+                             MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 4);
+
+  int sockfd = in->next<int>();
+  int msg1_size = in->next<int>();
+  int msg2_size = in->next<int>();
+  int flags = in->next<int>();
+
+  constexpr size_t kNumMsgs = 2;
+  struct msghdr msgs[kNumMsgs];
+  memset(msgs, 0, sizeof(msgs));
+  struct iovec msg_iov[kNumMsgs];
+  memset(msg_iov, 0, sizeof(msg_iov));
+  std::unique_ptr<char[]> msg1_buffer(new char[msg1_size]);
+  std::unique_ptr<char[]> msg2_buffer(new char[msg2_size]);
+  msg_iov[0].iov_base = msg1_buffer.get();
+  msg_iov[0].iov_len = msg1_size;
+  msg_iov[1].iov_base = msg2_buffer.get();
+  msg_iov[1].iov_len = msg2_size;
+  msgs[0].msg_iov = &msg_iov[0];
+  msgs[0].msg_iovlen = 1;
+  msgs[1].msg_iov = &msg_iov[1];
+  msgs[1].msg_iovlen = 1;
+
+  unsigned int msg_lens[kNumMsgs] = {0, 0};
+  int result = enc_untrusted_recvmmsg(sockfd, msgs, kNumMsgs, flags, msg_lens);
+  out->Push<int64_t>(result);
+  for (int i = 0; i < result; ++i) {
+    out->PushByCopy(Extent{msg_iov[i].iov_base, msg_lens[i]});
+  }
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+PrimitiveStatus TestRecvBufRing(void *context, MessageReader *in,
+                                MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 3);
+
+  int sockfd = in->next<int>();
+  auto recv_size = in->next<uint64_t>();
+  int flags = in->next<int>();
+
+  out->Push<int>(enc_enable_recv_buf_ring(sockfd));
+
+  // A large recvfrom() on the ring-enabled socket; the payload crosses into
+  // trusted memory through the pinned ring.
+  std::unique_ptr<char[]> buffer(new char[recv_size]);
+  int64_t received =
+      enc_untrusted_recvfrom(sockfd, buffer.get(), recv_size, flags,
+                             /*src_addr=*/nullptr, /*addrlen=*/nullptr);
+  out->Push<int64_t>(received);
+  out->PushByCopy(Extent{buffer.get(), received > 0 ? received : 0});
+
+  // A borrowed recv with untrusted-placement semantics; the payload stays in
+  // the untrusted slot until released.
+  void *slot = nullptr;
+  int64_t borrowed =
+      enc_untrusted_recv_buf_ring_borrow(sockfd, &slot, recv_size, flags);
+  out->Push<int64_t>(borrowed);
+  out->PushByCopy(Extent{slot, borrowed > 0 ? borrowed : 0});
+  if (borrowed >= 0) {
+    enc_recv_buf_ring_release(sockfd, slot);
+  }
+
+  out->Push<int>(enc_disable_recv_buf_ring(sockfd));
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+PrimitiveStatus TestBufferedWrite(void *context, MessageReader *in,
+                                  MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 4);
+
+  int fd = in->next<int>();
+  const auto buf1 = in->next();
+  const auto buf2 = in->next();
+  auto capacity = in->next<uint64_t>();
+
+  out->Push<int>(enc_enable_write_buffering(fd, capacity));
+  out->Push<int64_t>(enc_untrusted_write(fd, buf1.As<char>(), buf1.size()));
+  out->Push<int64_t>(enc_untrusted_write(fd, buf2.As<char>(), buf2.size()));
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+PrimitiveStatus TestFlushBufferedWrites(void *context, MessageReader *in,
+                                        MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 1);
+
+  int fd = in->next<int>();
+  out->Push<int>(enc_flush_buffered_writes(fd));
+  out->Push<int>(enc_disable_write_buffering(fd));
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
 PrimitiveStatus TestFcntl(void *context, MessageReader *in,
                           MessageWriter *out) {
   ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 3);
@@ -709,6 +965,20 @@ PrimitiveStatus TestPwrite64(void *context, MessageReader *in,
   return PrimitiveStatus::OkStatus();
 }
 
+PrimitiveStatus TestSendfile(void *context, MessageReader *in,
+                             MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 4);
+
+  int out_fd = in->next<int>();
+  int in_fd = in->next<int>();
+  off_t offset = in->next<off_t>();
+  size_t count = in->next<size_t>();
+
+  out->Push<ssize_t>(enc_untrusted_sendfile(out_fd, in_fd, &offset, count));
+  out->Push<off_t>(offset);
+  return PrimitiveStatus::OkStatus();
+}
+
 PrimitiveStatus TestWait(void *context, MessageReader *in, MessageWriter *out) {
   ASYLO_RETURN_IF_READER_NOT_EMPTY(*in);
 
@@ -1135,6 +1405,36 @@ extern "C" PrimitiveStatus asylo_enclave_init() {
   ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
       asylo::host_call::kTestRecvMsg,
       EntryHandler{asylo::host_call::TestRecvMsg}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestWritev,
+      EntryHandler{asylo::host_call::TestWritev}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestReadv,
+      EntryHandler{asylo::host_call::TestReadv}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestPWritev,
+      EntryHandler{asylo::host_call::TestPWritev}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestPReadv,
+      EntryHandler{asylo::host_call::TestPReadv}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestPIoSubmit,
+      EntryHandler{asylo::host_call::TestPIoSubmit}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestSendMMsg,
+      EntryHandler{asylo::host_call::TestSendMMsg}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestRecvMMsg,
+      EntryHandler{asylo::host_call::TestRecvMMsg}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestRecvBufRing,
+      EntryHandler{asylo::host_call::TestRecvBufRing}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestBufferedWrite,
+      EntryHandler{asylo::host_call::TestBufferedWrite}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestFlushBufferedWrites,
+      EntryHandler{asylo::host_call::TestFlushBufferedWrites}));
   ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
       asylo::host_call::kTestFcntl, EntryHandler{asylo::host_call::TestFcntl}));
   ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
@@ -1193,6 +1493,9 @@ extern "C" PrimitiveStatus asylo_enclave_init() {
   ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
       asylo::host_call::kTestPwrite64,
       EntryHandler{asylo::host_call::TestPwrite64}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::host_call::kTestSendfile,
+      EntryHandler{asylo::host_call::TestSendfile}));
   ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
       asylo::host_call::kTestWait, EntryHandler{asylo::host_call::TestWait}));
   ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
@@ -17,7 +17,9 @@
  */
 
 #include <errno.h>
+#include <limits.h>
 
+#include "asylo/platform/common/timer_wheel.h"
 #include "asylo/platform/host_call/exit_handler_constants.h"
 #include "asylo/platform/host_call/trusted/host_call_dispatcher.h"
 #include "asylo/platform/host_call/trusted/host_calls.h"
@@ -32,6 +34,19 @@ using ::asylo::primitives::TrustedPrimitives;
 static constexpr int32_t kWaitQueueEnabled = 0;
 static constexpr int32_t kWaitQueueDisabled = 1;
 
+namespace {
+
+// Wakes every waiter parked on |futex| when a timer wheel entry expires. The
+// waiters sharing a wait queue word can have distinct deadlines, so all of
+// them are woken and the ones whose deadlines have not passed re-enter their
+// waits; every caller of the wait functions below already treats a return as
+// possibly spurious.
+void WakeExpiredWaiters(int32_t *futex) {
+  enc_untrusted_sys_futex_wake(futex, INT_MAX);
+}
+
+}  // namespace
+
 extern "C" {
 
 int enc_untrusted_sys_futex_wait(int32_t *futex, int32_t expected,
@@ -84,6 +99,33 @@ int enc_untrusted_sys_futex_wake(int32_t *futex, int32_t num) {
   return result;
 }
 
+int enc_untrusted_sys_futex_requeue(int32_t *futex, int32_t num_wake,
+                                    int32_t num_move, int32_t *requeue_futex) {
+  if (!TrustedPrimitives::IsOutsideEnclave(futex, sizeof(int32_t)) ||
+      !TrustedPrimitives::IsOutsideEnclave(requeue_futex, sizeof(int32_t))) {
+    TrustedPrimitives::BestEffortAbort(
+        "enc_untrusted_sys_futex_requeue: futex words should be in untrusted "
+        "local memory.");
+  }
+
+  MessageWriter input;
+  MessageReader output;
+  input.Push<uint64_t>(reinterpret_cast<uint64_t>(futex));
+  input.Push<int32_t>(num_wake);
+  input.Push<int32_t>(num_move);
+  input.Push<uint64_t>(reinterpret_cast<uint64_t>(requeue_futex));
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kSysFutexRequeueHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_sys_futex_requeue",
+                           2);
+  int result = output.next<int>();
+  int klinux_errno = output.next<int>();
+  if (result == -1) {
+    errno = FromkLinuxErrorNumber(klinux_errno);
+  }
+  return result;
+}
+
 int32_t *enc_untrusted_create_wait_queue() {
   MessageWriter input;
   MessageReader output;
@@ -119,6 +161,11 @@ void enc_untrusted_notify(int32_t *const queue, int32_t num_threads) {
   enc_untrusted_sys_futex_wake(queue, num_threads);
 }
 
+void enc_untrusted_notify_and_requeue(int32_t *const queue, int32_t num_wake,
+                                      int32_t *const target_queue) {
+  enc_untrusted_sys_futex_requeue(queue, num_wake, INT_MAX, target_queue);
+}
+
 void enc_untrusted_disable_waiting(int32_t *const queue) {
   enc_untrusted_wait_queue_set_value(queue, kWaitQueueDisabled);
 }
@@ -133,7 +180,24 @@ void enc_untrusted_wait_queue_set_value(int32_t *const queue, int32_t value) {
 
 void enc_untrusted_thread_wait_value(int32_t *const queue, int32_t value,
                                      uint64_t timeout_microsec) {
-  enc_untrusted_sys_futex_wait(queue, value, timeout_microsec);
+  asylo::TimerWheel *wheel = asylo::TimerWheel::GetInstance();
+  if (timeout_microsec == 0 || !wheel->active()) {
+    enc_untrusted_sys_futex_wait(queue, value, timeout_microsec);
+    return;
+  }
+
+  // A tick source is running: park on the wheel instead of arming a host
+  // timer for this wait. The host futex wait still carries a backstop timeout
+  // one wheel revolution past the deadline, covering the narrow window where
+  // the deadline expires before this thread reaches the kernel and the wake
+  // finds no sleeper; the backstop is coarse enough for the host to coalesce
+  // and almost never fires.
+  asylo::TimerWheelEntry entry;
+  wheel->Schedule(&entry, queue, &WakeExpiredWaiters,
+                  wheel->Now() + timeout_microsec);
+  enc_untrusted_sys_futex_wait(
+      queue, value, timeout_microsec + asylo::kTimerWheelRevolutionMicros);
+  wheel->Cancel(&entry);
 }
 
 }  // extern "C"
@@ -23,6 +23,7 @@
 #include "asylo/platform/primitives/primitive_status.h"
 #include "asylo/platform/primitives/trusted_primitives.h"
 #include "asylo/platform/primitives/util/message.h"
+#include "asylo/platform/system_call/system_call.h"
 #include "asylo/util/status_macros.h"
 
 namespace asylo {
@@ -44,9 +45,20 @@ primitives::PrimitiveStatus SystemCallDispatcher(const uint8_t* request_buffer,
   // untrusted code.
   primitives::MessageWriter input;
   input.PushByReference(primitives::Extent{request_buffer, request_size});
+
+  // When the calling thread has a syscall timeout installed, route through
+  // the deadline-enforcing exit so the untrusted side bounds the call and
+  // reports -1/ETIMEDOUT through the regular response message on overrun.
+  uint64_t selector = kSystemCallHandler;
+  const uint64_t timeout_micros = enc_get_syscall_timeout();
+  if (timeout_micros != 0) {
+    input.Push<uint64_t>(timeout_micros);
+    selector = kTimedSystemCallHandler;
+  }
+
   primitives::MessageReader output;
-  ASYLO_RETURN_IF_ERROR(primitives::TrustedPrimitives::UntrustedCall(
-      kSystemCallHandler, &input, &output));
+  ASYLO_RETURN_IF_ERROR(
+      primitives::TrustedPrimitives::UntrustedCall(selector, &input, &output));
 
   // The output should only contain the serialized response.
   ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(output, 1);
@@ -68,6 +80,104 @@ primitives::PrimitiveStatus SystemCallDispatcher(const uint8_t* request_buffer,
   return primitives::PrimitiveStatus::OkStatus();
 }
 
+primitives::PrimitiveStatus SystemCallSgDispatcher(
+    const primitives::Extent* request_extents, size_t num_request_extents,
+    primitives::MessageReader* response) {
+  if (num_request_extents == 0 || request_extents == nullptr) {
+    return primitives::PrimitiveStatus{
+        primitives::AbslStatusCode::kFailedPrecondition,
+        "Zero-sized request or null request provided. Need a valid request to "
+        "dispatch the host call."};
+  }
+
+  // The extents are owned by the caller and only accessible inside the
+  // enclave; pushing them by reference copies each into the exit call
+  // parameters exactly once.
+  primitives::MessageWriter input;
+  for (size_t i = 0; i < num_request_extents; ++i) {
+    input.PushByReference(request_extents[i]);
+  }
+  ASYLO_RETURN_IF_ERROR(primitives::TrustedPrimitives::UntrustedCall(
+      kSystemCallHandler, &input, response));
+
+  // The output should at least contain the serialized response message.
+  if (response->empty()) {
+    return primitives::PrimitiveStatus{
+        primitives::AbslStatusCode::kFailedPrecondition,
+        "No response received for the host call, or response lost while "
+        "crossing the enclave boundary."};
+  }
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+primitives::PrimitiveStatus AsyncSystemCallSubmitDispatcher(
+    const uint8_t* request_buffer, size_t request_size, uint64_t* ticket) {
+  if (request_size == 0 || request_buffer == nullptr) {
+    return primitives::PrimitiveStatus{
+        primitives::AbslStatusCode::kFailedPrecondition,
+        "Zero-sized request or null request provided. Need a valid request to "
+        "dispatch the host call."};
+  }
+
+  // |request_buffer| is owned by the caller and only accessible inside the
+  // enclave; have parameters own the request to make it accessible by the
+  // untrusted code, which copies it for the lifetime of the submitted call.
+  primitives::MessageWriter input;
+  input.PushByReference(primitives::Extent{request_buffer, request_size});
+  primitives::MessageReader output;
+  ASYLO_RETURN_IF_ERROR(primitives::TrustedPrimitives::UntrustedCall(
+      kAsyncSystemCallSubmitHandler, &input, &output));
+
+  // The output should only contain the ticket.
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(output, 1);
+  *ticket = output.next<uint64_t>();
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
+primitives::PrimitiveStatus AsyncSystemCallCollectDispatcher(
+    uint64_t ticket, bool wait, uint8_t** response_buffer,
+    size_t* response_size, bool* ready) {
+  primitives::MessageWriter input;
+  input.Push<uint64_t>(ticket);
+  input.Push<int>(wait ? 1 : 0);
+  primitives::MessageReader output;
+  ASYLO_RETURN_IF_ERROR(primitives::TrustedPrimitives::UntrustedCall(
+      kAsyncSystemCallCollectHandler, &input, &output));
+
+  // The output contains the ready flag, followed by the serialized response
+  // when the call has completed.
+  if (output.empty()) {
+    return primitives::PrimitiveStatus{
+        primitives::AbslStatusCode::kFailedPrecondition,
+        "No response received for the host call, or response lost while "
+        "crossing the enclave boundary."};
+  }
+  *ready = output.next<int>() != 0;
+  if (!*ready) {
+    ASYLO_RETURN_IF_READER_NOT_EMPTY(output);
+    return primitives::PrimitiveStatus::OkStatus();
+  }
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(output, 1);
+
+  auto response = output.next();
+  *response_size = response.size();
+
+  // Copy |response| to *response_buffer before it goes out of scope.
+  // *response_buffer is expected to be owned by the caller, so we wouldn't
+  // worry about freeing the memory we allocate here.
+  *response_buffer = reinterpret_cast<uint8_t*>(malloc(*response_size));
+  if (!response_buffer) {
+    return primitives::PrimitiveStatus{
+        primitives::AbslStatusCode::kResourceExhausted,
+        "Failed to malloc response buffer"};
+  }
+  memcpy(*response_buffer, response.As<uint8_t>(), *response_size);
+
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
 primitives::PrimitiveStatus NonSystemCallDispatcher(
     uint64_t exit_selector, primitives::MessageWriter* input,
     primitives::MessageReader* output) {
@@ -23,6 +23,7 @@
 
 #include <cstdint>
 
+#include "asylo/platform/primitives/extent.h"
 #include "asylo/platform/primitives/primitive_status.h"
 #include "asylo/platform/primitives/trusted_primitives.h"
 #include "asylo/platform/primitives/util/message.h"
@@ -37,12 +38,42 @@ namespace host_call {
 // arguments), and provides a serialized |response_buffer| (containing the
 // system call return value and the response arguments). Returns ok status when
 // successful, otherwise a status containing the error code and error message
-// when serialization, dispatch or other errors occur.
+// when serialization, dispatch or other errors occur. When the calling thread
+// has a timeout installed with enc_set_syscall_timeout(), the call is
+// dispatched through the deadline-enforcing exit handler instead and the
+// response reports -1/ETIMEDOUT when the host call overruns the timeout.
 primitives::PrimitiveStatus SystemCallDispatcher(const uint8_t* request_buffer,
                                                  size_t request_size,
                                                  uint8_t** response_buffer,
                                                  size_t* response_size);
 
+// Scatter-gather variant of SystemCallDispatcher. Takes the serialized
+// request as a list of extents (the fixed-layout message followed by one
+// extent per bulk input parameter) and pushes each across the boundary by
+// reference, so bulk parameter contents are copied only once, into the exit
+// call parameters. On success, `response` holds the response message extents.
+primitives::PrimitiveStatus SystemCallSgDispatcher(
+    const primitives::Extent* request_extents, size_t num_request_extents,
+    primitives::MessageReader* response);
+
+// Submits a serialized system call request to the untrusted worker pool for
+// asynchronous completion. This dispatcher is installed as the submit half of
+// the asynchronous callback pair by the |system_call| library. On success,
+// `ticket` identifies the submitted call for later collection with
+// |AsyncSystemCallCollectDispatcher|.
+primitives::PrimitiveStatus AsyncSystemCallSubmitDispatcher(
+    const uint8_t* request_buffer, size_t request_size, uint64_t* ticket);
+
+// Collects the response of a system call previously submitted with
+// |AsyncSystemCallSubmitDispatcher|. When `wait` is true, blocks until the
+// call identified by `ticket` completes. On return with `*ready` set,
+// `response_buffer` holds the malloc()-allocated serialized response on the
+// trusted heap, owned by the caller, and the ticket is consumed; with
+// `*ready` unset, the call is still in flight and the ticket remains valid.
+primitives::PrimitiveStatus AsyncSystemCallCollectDispatcher(
+    uint64_t ticket, bool wait, uint8_t** response_buffer,
+    size_t* response_size, bool* ready);
+
 // Provides a dispatcher to wrap the UntrustedCall function and perform basic
 // validations. Used for host calls which are not implemented using syscalls.
 primitives::PrimitiveStatus NonSystemCallDispatcher(
@@ -24,13 +24,19 @@
 #include <netdb.h>
 #include <signal.h>
 #include <sys/statfs.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 
+#include "asylo/platform/core/trusted_spin_lock.h"
 #include "asylo/platform/host_call/exit_handler_constants.h"
+#include "asylo/platform/host_call/recv_buf_ring.h"
 #include "asylo/platform/host_call/serializer_functions.h"
 #include "asylo/platform/primitives/trusted_primitives.h"
 #include "asylo/platform/system_call/type_conversions/types_functions.h"
+#include "asylo/util/lock_guard.h"
 
 using ::asylo::host_call::NonSystemCallDispatcher;
 using ::asylo::primitives::Extent;
@@ -65,6 +71,245 @@ void CheckStatusAndParamCount(const asylo::primitives::PrimitiveStatus &status,
 
 namespace {
 
+// Cached result of an idempotent host call. The cached value cannot change
+// for the life of the host process: the runtime exposes no host call that
+// modifies it. The caches are invalidated in the child after fork(), where
+// the process identity changes.
+struct IdempotentResultCache {
+  std::atomic<bool> valid{false};
+  std::atomic<int64_t> value{0};
+
+  // Returns the cached result, computing it with |compute| on the first call.
+  // Negative results are treated as failures and not cached. Concurrent first
+  // callers may each dispatch the host call; they cache the same value.
+  int64_t Get(int64_t (*compute)()) {
+    if (valid.load(std::memory_order_acquire)) {
+      return value.load(std::memory_order_relaxed);
+    }
+    int64_t result = compute();
+    if (result >= 0) {
+      value.store(result, std::memory_order_relaxed);
+      valid.store(true, std::memory_order_release);
+    }
+    return result;
+  }
+
+  void Invalidate() { valid.store(false, std::memory_order_release); }
+};
+
+IdempotentResultCache getpid_cache;
+IdempotentResultCache getuid_cache;
+IdempotentResultCache geteuid_cache;
+IdempotentResultCache getgid_cache;
+IdempotentResultCache getegid_cache;
+IdempotentResultCache pagesize_cache;
+
+// Dispatches sysconf for an already-converted kLinux name.
+int64_t DispatchSysconf(int kLinux_name) {
+  MessageWriter input;
+  input.Push(kLinux_name);
+  MessageReader output;
+  asylo::primitives::PrimitiveStatus status =
+      asylo::host_call::NonSystemCallDispatcher(
+          asylo::host_call::kSysconfHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_sysconf", 2);
+
+  int64_t result = output.next<int>();
+  int klinux_errno = output.next<int>();
+  if (result == -1) {
+    errno = FromkLinuxErrorNumber(klinux_errno);
+  }
+
+  return result;
+}
+
+// Number of file descriptors that can have write buffering enabled at once.
+constexpr int kMaxBufferedWriteFds = 16;
+
+// State of one write-buffered file descriptor. Small sequential writes to a
+// buffered fd accumulate in trusted memory and cross the enclave boundary
+// only when the buffer fills, or on an explicit flush, fsync() or close().
+struct WriteBuffer {
+  asylo::TrustedSpinLock lock{/*is_recursive=*/false};
+  std::atomic<int> fd{-1};  // -1 marks a free slot.
+  char *data = nullptr;
+  size_t capacity = 0;
+  size_t used = 0;
+};
+
+WriteBuffer write_buffers[kMaxBufferedWriteFds];
+
+// Guards slot assignment and release in |write_buffers|. Always acquired
+// before any per-slot lock.
+asylo::TrustedSpinLock write_buffers_table_lock{/*is_recursive=*/false};
+
+// Number of fds with buffering enabled, letting the write fast path skip the
+// slot scan entirely when the feature is unused.
+std::atomic<int> buffered_write_fd_count{0};
+
+// Dispatches a write syscall directly to the host, bypassing any buffering.
+ssize_t DispatchWrite(int fd, const void *buf, size_t count) {
+  ssize_t ret = static_cast<ssize_t>(EnsureInitializedAndDispatchSyscall(
+      asylo::system_call::kSYS_write, fd, buf, count));
+  if (ret != -1 && ret > count) {
+    ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+        "enc_untrusted_write: write result exceeds requested");
+  }
+  return ret;
+}
+
+// Returns the buffering slot for |fd| with its lock held, or nullptr when the
+// fd is not buffered.
+WriteBuffer *AcquireWriteBuffer(int fd) {
+  if (buffered_write_fd_count.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+  for (WriteBuffer &buffer : write_buffers) {
+    if (buffer.fd.load(std::memory_order_relaxed) != fd) {
+      continue;
+    }
+    buffer.lock.Lock();
+    if (buffer.fd.load(std::memory_order_relaxed) == fd) {
+      return &buffer;
+    }
+    buffer.lock.Unlock();
+  }
+  return nullptr;
+}
+
+// Writes out the buffered bytes of |buffer|, whose lock must be held. Returns
+// 0 on success. On failure the unwritten remainder is kept in the buffer and
+// -1 is returned with errno set by the failed write.
+int FlushWriteBufferLocked(WriteBuffer *buffer) {
+  size_t offset = 0;
+  while (offset < buffer->used) {
+    ssize_t result = DispatchWrite(buffer->fd.load(std::memory_order_relaxed),
+                                   buffer->data + offset,
+                                   buffer->used - offset);
+    if (result <= 0) {
+      memmove(buffer->data, buffer->data + offset, buffer->used - offset);
+      buffer->used -= offset;
+      return -1;
+    }
+    offset += result;
+  }
+  buffer->used = 0;
+  return 0;
+}
+
+// Appends |count| bytes to |buffer|, whose lock must be held, flushing first
+// when they do not fit. Writes at or above the buffer capacity flush and then
+// go to the host directly.
+ssize_t BufferedWriteLocked(WriteBuffer *buffer, const void *buf,
+                            size_t count) {
+  if (count >= buffer->capacity) {
+    if (FlushWriteBufferLocked(buffer) != 0) {
+      return -1;
+    }
+    return DispatchWrite(buffer->fd.load(std::memory_order_relaxed), buf,
+                         count);
+  }
+  if (buffer->used + count > buffer->capacity &&
+      FlushWriteBufferLocked(buffer) != 0) {
+    return -1;
+  }
+  memcpy(buffer->data + buffer->used, buf, count);
+  buffer->used += count;
+  return count;
+}
+
+// Number of sockets that can have a receive buffer ring pinned at once.
+constexpr int kMaxRecvBufRingFds = 16;
+
+// Reads at or above this size on a ring-enabled socket go through the ring;
+// smaller reads stay on the serializing path, whose copy cost is negligible.
+constexpr size_t kRecvBufRingThresholdBytes = 4096;
+
+// Trusted view of one ring-enabled socket: the host fd and the validated
+// untrusted ring pinned to it.
+struct RecvBufRingEntry {
+  std::atomic<int> fd{-1};  // -1 marks a free slot.
+  asylo::host_call::RecvBufRing *ring = nullptr;
+};
+
+RecvBufRingEntry recv_buf_ring_table[kMaxRecvBufRingFds];
+
+// Guards slot assignment and release in |recv_buf_ring_table|.
+asylo::TrustedSpinLock recv_buf_ring_table_lock{/*is_recursive=*/false};
+
+// Number of sockets with a ring pinned, letting the recv fast path skip the
+// table scan entirely when the feature is unused.
+std::atomic<int> recv_buf_ring_fd_count{0};
+
+// Returns the validated ring pinned to |sockfd|, or nullptr. Callers must
+// not race lookups with enc_disable_recv_buf_ring() on the same socket.
+asylo::host_call::RecvBufRing *GetRecvBufRing(int sockfd) {
+  if (recv_buf_ring_fd_count.load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+  for (RecvBufRingEntry &entry : recv_buf_ring_table) {
+    if (entry.fd.load(std::memory_order_acquire) == sockfd) {
+      return entry.ring;
+    }
+  }
+  return nullptr;
+}
+
+// Value RecvViaBufRing() returns when the host had no free ring slot and the
+// caller should fall back to the serializing recv path.
+constexpr ssize_t kRecvBufRingNoSlot = -2;
+
+// Receives up to |len| bytes from |sockfd| into a slot of the socket's ring.
+// On success returns the byte count and stores the claimed slot index in
+// |*slot_out|; the caller copies or reads the payload out of the slot and
+// releases it. Returns -1 with errno set on recv failure, or
+// kRecvBufRingNoSlot when every slot is claimed. |src_addr| and |addrlen|
+// follow recvfrom() semantics.
+ssize_t RecvViaBufRing(int sockfd, size_t len, int klinux_flags, int *slot_out,
+                       struct sockaddr *src_addr, socklen_t *addrlen) {
+  *slot_out = -1;
+
+  MessageWriter input;
+  input.Push<int>(sockfd);
+  input.Push<uint64_t>(len);
+  input.Push<int>(klinux_flags);
+  MessageReader output;
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kRecvBufRingRecvHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_recvfrom", 4);
+
+  int result = output.next<int>();
+  int klinux_errno = output.next<int>();
+  int slot = output.next<int>();
+  auto klinux_sockaddr_buf = output.next();
+
+  if (slot < 0) {
+    if (result == -1) {
+      errno = FromkLinuxErrorNumber(klinux_errno);
+      return -1;
+    }
+    return kRecvBufRingNoSlot;
+  }
+  if (static_cast<size_t>(slot) >= asylo::host_call::kRecvBufRingSlots ||
+      result < 0 ||
+      static_cast<size_t>(result) >
+          std::min(len, asylo::host_call::kRecvBufRingSlotSize)) {
+    ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+        "enc_untrusted_recvfrom: invalid ring slot or result from host");
+    return -1;
+  }
+
+  if (src_addr != nullptr && addrlen != nullptr) {
+    const struct klinux_sockaddr *klinux_addr =
+        klinux_sockaddr_buf.As<struct klinux_sockaddr>();
+    FromkLinuxSockAddr(klinux_addr, klinux_sockaddr_buf.size(), src_addr,
+                       addrlen, TrustedPrimitives::BestEffortAbort);
+  }
+
+  *slot_out = slot;
+  return result;
+}
+
 // A global passwd struct. The address of it is used as the return value of
 // getpwuid.
 struct passwd global_passwd;
@@ -148,7 +393,9 @@ int enc_untrusted_access(const char *path_name, int mode) {
 }
 
 pid_t enc_untrusted_getpid() {
-  return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_getpid);
+  return getpid_cache.Get([]() -> int64_t {
+    return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_getpid);
+  });
 }
 
 pid_t enc_untrusted_getppid() {
@@ -160,19 +407,29 @@ pid_t enc_untrusted_setsid() {
 }
 
 uid_t enc_untrusted_getuid() {
-  return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_getuid);
+  return getuid_cache.Get([]() -> int64_t {
+    return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_getuid);
+  });
 }
 
 gid_t enc_untrusted_getgid() {
-  return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_getgid);
+  return getgid_cache.Get([]() -> int64_t {
+    return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_getgid);
+  });
 }
 
 uid_t enc_untrusted_geteuid() {
-  return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_geteuid);
+  return geteuid_cache.Get([]() -> int64_t {
+    return EnsureInitializedAndDispatchSyscall(
+        asylo::system_call::kSYS_geteuid);
+  });
 }
 
 gid_t enc_untrusted_getegid() {
-  return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_getegid);
+  return getegid_cache.Get([]() -> int64_t {
+    return EnsureInitializedAndDispatchSyscall(
+        asylo::system_call::kSYS_getegid);
+  });
 }
 
 int enc_untrusted_kill(pid_t pid, int sig) {
@@ -196,6 +453,11 @@ off_t enc_untrusted_lseek(int fd, off_t offset, int whence) {
                                              offset, whence);
 }
 
+int enc_untrusted_getdents64(int fd, void *dirp, unsigned int count) {
+  return EnsureInitializedAndDispatchSyscall(
+      asylo::system_call::kSYS_getdents64, fd, dirp, count);
+}
+
 int enc_untrusted_mkdir(const char *pathname, mode_t mode) {
   return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_mkdir,
                                              pathname, mode);
@@ -236,13 +498,13 @@ ssize_t enc_untrusted_read(int fd, void *buf, size_t count) {
 }
 
 ssize_t enc_untrusted_write(int fd, const void *buf, size_t count) {
-  ssize_t ret = static_cast<ssize_t>(EnsureInitializedAndDispatchSyscall(
-      asylo::system_call::kSYS_write, fd, buf, count));
-  if (ret != -1 && ret > count) {
-    ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
-        "enc_untrusted_read: read result exceeds requested");
+  WriteBuffer *buffer = AcquireWriteBuffer(fd);
+  if (buffer) {
+    ssize_t result = BufferedWriteLocked(buffer, buf, count);
+    buffer->lock.Unlock();
+    return result;
   }
-  return ret;
+  return DispatchWrite(fd, buf, count);
 }
 
 int enc_untrusted_symlink(const char *target, const char *linkpath) {
@@ -476,6 +738,33 @@ int enc_untrusted_pwrite64(int fd, const void *buf, size_t count,
   return ret;
 }
 
+ssize_t enc_untrusted_sendfile(int out_fd, int in_fd, off_t *offset,
+                               size_t count) {
+  // The serializer materializes a null pointer as a zeroed host-side buffer,
+  // which would silently transfer from file offset 0. Emulate the null-offset
+  // form of sendfile(2) around an explicit offset instead.
+  off_t local_offset = 0;
+  const bool use_file_offset = (offset == nullptr);
+  if (use_file_offset) {
+    local_offset = enc_untrusted_lseek(in_fd, 0, SEEK_CUR);
+    if (local_offset == -1) {
+      return -1;
+    }
+    offset = &local_offset;
+  }
+  ssize_t ret = EnsureInitializedAndDispatchSyscall(
+      asylo::system_call::kSYS_sendfile, out_fd, in_fd, offset, count);
+  if (ret != -1 && ret > count) {
+    ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+        "enc_untrusted_sendfile: transfer result exceeds requested");
+  }
+  if (ret != -1 && use_file_offset &&
+      enc_untrusted_lseek(in_fd, local_offset, SEEK_SET) == -1) {
+    return -1;
+  }
+  return ret;
+}
+
 int enc_untrusted_isatty(int fd) {
   MessageWriter input;
   input.Push(fd);
@@ -628,24 +917,23 @@ int64_t enc_untrusted_sysconf(int name) {
     return -1;
   }
 
-  MessageWriter input;
-  input.Push(kLinux_name);
-  MessageReader output;
-  asylo::primitives::PrimitiveStatus status =
-      asylo::host_call::NonSystemCallDispatcher(
-          asylo::host_call::kSysconfHandler, &input, &output);
-  CheckStatusAndParamCount(status, output, "enc_untrusted_sysconf", 2);
-
-  int64_t result = output.next<int>();
-  int klinux_errno = output.next<int>();
-  if (result == -1) {
-    errno = FromkLinuxErrorNumber(klinux_errno);
+  // The page size is immutable for the life of the process; serve it from the
+  // trusted cache after the first read.
+  if (name == _SC_PAGESIZE) {
+    return pagesize_cache.Get([]() -> int64_t {
+      return DispatchSysconf(TokLinuxSysconfConstant(_SC_PAGESIZE));
+    });
   }
 
-  return result;
+  return DispatchSysconf(kLinux_name);
 }
 
 int enc_untrusted_close(int fd) {
+  // Release any write buffering for the fd, flushing pending bytes first.
+  enc_disable_write_buffering(fd);
+  // Unpin any receive buffer ring; a no-op host-call-free scan for fds
+  // without one.
+  enc_disable_recv_buf_ring(fd);
   return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_close,
                                              fd);
 }
@@ -793,22 +1081,19 @@ int enc_untrusted_connect(int sockfd, const struct sockaddr *addr,
 }
 
 ssize_t enc_untrusted_sendmsg(int sockfd, const struct msghdr *msg, int flags) {
-  size_t total_message_size = CalculateTotalMessageSize(msg);
-  std::unique_ptr<char[]> msg_iov_buffer(new char[total_message_size]);
-  size_t copied_bytes = 0;
-  for (int i = 0; i < msg->msg_iovlen; ++i) {
-    memcpy(msg_iov_buffer.get() + copied_bytes, msg->msg_iov[i].iov_base,
-           msg->msg_iov[i].iov_len);
-    copied_bytes += msg->msg_iov[i].iov_len;
-  }
-
   MessageWriter input;
   input.Push(sockfd);
   input.PushByReference(Extent{msg->msg_name, msg->msg_namelen});
-  input.PushByReference(Extent{msg_iov_buffer.get(), total_message_size});
   input.PushByReference(Extent{msg->msg_control, msg->msg_controllen});
   input.Push(msg->msg_flags);
   input.Push(flags);
+  // Push each |msg_iov| segment as its own extent; each segment is copied into
+  // untrusted memory exactly once and the host gathers them natively, so no
+  // flattened intermediate buffer is needed.
+  for (int i = 0; i < msg->msg_iovlen; ++i) {
+    input.PushByReference(
+        Extent{msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len});
+  }
   MessageReader output;
 
   const auto status = NonSystemCallDispatcher(
@@ -831,10 +1116,14 @@ ssize_t enc_untrusted_recvmsg(int sockfd, struct msghdr *msg, int flags) {
   MessageWriter input;
   input.Push(sockfd);
   input.Push<uint64_t>(msg->msg_namelen);
-  input.Push<uint64_t>(total_buffer_size);
   input.Push<uint64_t>(msg->msg_controllen);
   input.Push(msg->msg_flags);
   input.Push(flags);
+  // Push the length of each |msg_iov| segment so the untrusted handler can
+  // receive directly into a matching scatter layout.
+  for (int i = 0; i < msg->msg_iovlen; ++i) {
+    input.Push<uint64_t>(msg->msg_iov[i].iov_len);
+  }
 
   MessageReader output;
 
@@ -865,19 +1154,6 @@ ssize_t enc_untrusted_recvmsg(int sockfd, struct msghdr *msg, int flags) {
   }
   memcpy(msg->msg_name, msg_name_extent.As<char>(), msg->msg_namelen);
 
-  // A single buffer is passed from the untrusted side, copy it into the
-  // scattered buffers inside the enclave.
-  auto msg_iov_extent = output.next();
-  size_t total_bytes = msg_iov_extent.size();
-  size_t bytes_copied = 0;
-  for (int i = 0; i < msg->msg_iovlen && bytes_copied < total_bytes; ++i) {
-    size_t bytes_to_copy =
-        std::min(msg->msg_iov[i].iov_len, total_bytes - bytes_copied);
-    memcpy(msg->msg_iov[i].iov_base, msg_iov_extent.As<char>() + bytes_copied,
-           bytes_to_copy);
-    bytes_copied += bytes_to_copy;
-  }
-
   auto msg_control_extent = output.next();
   // The returned |msg_controllen| should not exceed the buffer size.
   if (msg_control_extent.size() <= msg->msg_controllen) {
@@ -885,9 +1161,393 @@ ssize_t enc_untrusted_recvmsg(int sockfd, struct msghdr *msg, int flags) {
   }
   memcpy(msg->msg_control, msg_control_extent.As<char>(), msg->msg_controllen);
 
+  // One extent per |msg_iov| segment follows, trimmed by the handler to the
+  // bytes received into that segment; copy each into its enclave buffer.
+  for (int i = 0; i < msg->msg_iovlen && output.hasNext(); ++i) {
+    auto segment = output.next();
+    if (segment.size() > msg->msg_iov[i].iov_len) {
+      ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+          "enc_untrusted_recvmsg: segment exceeds requested");
+    }
+    memcpy(msg->msg_iov[i].iov_base, segment.As<char>(), segment.size());
+  }
+
+  return result;
+}
+
+int enc_untrusted_sendmmsg(int sockfd, struct msghdr *msgvec, unsigned int vlen,
+                           int flags, unsigned int *msg_lens) {
+  if (!msgvec || vlen == 0) {
+    errno = EINVAL;
+    return -1;
+  }
+  // The untrusted handler accepts at most kMaxMmsgBatch messages per call;
+  // like sendmmsg(2), transmit fewer than |vlen| rather than failing.
+  if (vlen > ::asylo::host_call::kMaxMmsgBatch) {
+    vlen = ::asylo::host_call::kMaxMmsgBatch;
+  }
+
+  MessageWriter input;
+  input.Push(sockfd);
+  input.Push(flags);
+  input.Push<uint64_t>(vlen);
+  // Frame each message as [iovcnt, name, control, msg_flags, segments...];
+  // every segment crosses into untrusted memory exactly once and the host
+  // gathers them natively, so no flattened intermediate buffer is needed.
+  for (unsigned int i = 0; i < vlen; ++i) {
+    const struct msghdr *msg = &msgvec[i];
+    input.Push<uint64_t>(msg->msg_iovlen);
+    input.PushByReference(Extent{msg->msg_name, msg->msg_namelen});
+    input.PushByReference(Extent{msg->msg_control, msg->msg_controllen});
+    input.Push(msg->msg_flags);
+    for (int j = 0; j < msg->msg_iovlen; ++j) {
+      input.PushByReference(
+          Extent{msg->msg_iov[j].iov_base, msg->msg_iov[j].iov_len});
+    }
+  }
+  MessageReader output;
+
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kSendMMsgHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_sendmmsg", 2,
+                           /*match_exact_params=*/false);
+
+  int result = output.next<int64_t>();
+  int klinux_errno = output.next<int>();
+  if (result == -1) {
+    errno = FromkLinuxErrorNumber(klinux_errno);
+    return result;
+  }
+
+  if (result > vlen) {
+    ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+        "enc_untrusted_sendmmsg: result exceeds requested");
+  }
+
+  // One value per sent message follows, holding the bytes transmitted for it.
+  for (int i = 0; i < result && output.hasNext(); ++i) {
+    uint64_t nbytes = output.next<uint64_t>();
+    if (msg_lens) {
+      msg_lens[i] = nbytes;
+    }
+  }
+  return result;
+}
+
+int enc_untrusted_recvmmsg(int sockfd, struct msghdr *msgvec, unsigned int vlen,
+                           int flags, unsigned int *msg_lens) {
+  if (!msgvec || vlen == 0) {
+    errno = EINVAL;
+    return -1;
+  }
+  // The untrusted handler accepts at most kMaxMmsgBatch messages per call;
+  // like recvmmsg(2), receive fewer than |vlen| rather than failing.
+  if (vlen > ::asylo::host_call::kMaxMmsgBatch) {
+    vlen = ::asylo::host_call::kMaxMmsgBatch;
+  }
+
+  MessageWriter input;
+  input.Push(sockfd);
+  input.Push(flags);
+  input.Push<uint64_t>(vlen);
+  // Frame each message as [namelen, controllen, iovcnt, segment lengths...]
+  // so the untrusted handler can receive directly into a matching scatter
+  // layout per message.
+  for (unsigned int i = 0; i < vlen; ++i) {
+    const struct msghdr *msg = &msgvec[i];
+    input.Push<uint64_t>(msg->msg_namelen);
+    input.Push<uint64_t>(msg->msg_controllen);
+    input.Push<uint64_t>(msg->msg_iovlen);
+    for (int j = 0; j < msg->msg_iovlen; ++j) {
+      input.Push<uint64_t>(msg->msg_iov[j].iov_len);
+    }
+  }
+  MessageReader output;
+
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kRecvMMsgHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_recvmmsg", 2,
+                           /*match_exact_params=*/false);
+
+  int result = output.next<int64_t>();
+  int klinux_errno = output.next<int>();
+  if (result == -1) {
+    errno = FromkLinuxErrorNumber(klinux_errno);
+    return result;
+  }
+
+  if (result > vlen) {
+    ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+        "enc_untrusted_recvmmsg: result exceeds requested");
+  }
+
+  // [name, control, msg_flags, segments...] follow for each received message,
+  // every segment trimmed by the handler to the bytes received into it; copy
+  // each piece into the matching enclave buffer.
+  for (int i = 0; i < result; ++i) {
+    struct msghdr *msg = &msgvec[i];
+
+    auto msg_name_extent = output.next();
+    // The returned |msg_namelen| should not exceed the buffer size.
+    if (msg_name_extent.size() <= msg->msg_namelen) {
+      msg->msg_namelen = msg_name_extent.size();
+    }
+    memcpy(msg->msg_name, msg_name_extent.As<char>(), msg->msg_namelen);
+
+    auto msg_control_extent = output.next();
+    // The returned |msg_controllen| should not exceed the buffer size.
+    if (msg_control_extent.size() <= msg->msg_controllen) {
+      msg->msg_controllen = msg_control_extent.size();
+    }
+    memcpy(msg->msg_control, msg_control_extent.As<char>(), msg->msg_controllen);
+
+    msg->msg_flags = output.next<int>();
+
+    unsigned int received = 0;
+    for (int j = 0; j < msg->msg_iovlen && output.hasNext(); ++j) {
+      auto segment = output.next();
+      if (segment.size() > msg->msg_iov[j].iov_len) {
+        ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+            "enc_untrusted_recvmmsg: segment exceeds requested");
+      }
+      memcpy(msg->msg_iov[j].iov_base, segment.As<char>(), segment.size());
+      received += segment.size();
+    }
+    if (msg_lens) {
+      msg_lens[i] = received;
+    }
+  }
+  return result;
+}
+
+ssize_t enc_untrusted_writev(int fd, const struct iovec *iov, int iovcnt) {
+  if (!iov || iovcnt <= 0) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  // Preserve ordering with any writes buffered for the fd.
+  if (enc_flush_buffered_writes(fd) != 0) {
+    return -1;
+  }
+
+  MessageWriter input;
+  input.Push(fd);
+  // Push each segment as its own extent; each one is copied into untrusted
+  // memory exactly once and written natively with writev() on the host.
+  for (int i = 0; i < iovcnt; ++i) {
+    input.PushByReference(Extent{iov[i].iov_base, iov[i].iov_len});
+  }
+  MessageReader output;
+
+  const auto status = NonSystemCallDispatcher(::asylo::host_call::kWritevHandler,
+                                              &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_writev", 2);
+
+  ssize_t result = output.next<ssize_t>();
+  int klinux_errno = output.next<int>();
+  if (result == -1) {
+    errno = FromkLinuxErrorNumber(klinux_errno);
+  }
   return result;
 }
 
+ssize_t enc_untrusted_readv(int fd, const struct iovec *iov, int iovcnt) {
+  if (!iov || iovcnt <= 0) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  size_t total_size = 0;
+  MessageWriter input;
+  input.Push(fd);
+  // Push the length of each segment so the untrusted handler can read directly
+  // into a matching scatter layout.
+  for (int i = 0; i < iovcnt; ++i) {
+    input.Push<uint64_t>(iov[i].iov_len);
+    total_size += iov[i].iov_len;
+  }
+  MessageReader output;
+
+  const auto status = NonSystemCallDispatcher(::asylo::host_call::kReadvHandler,
+                                              &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_readv", 2,
+                           /*match_exact_params=*/false);
+
+  ssize_t result = output.next<ssize_t>();
+  int klinux_errno = output.next<int>();
+  if (result == -1) {
+    errno = FromkLinuxErrorNumber(klinux_errno);
+    return result;
+  }
+
+  if (result > total_size) {
+    ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+        "enc_untrusted_readv: result exceeds requested");
+  }
+
+  // One extent per segment follows, trimmed by the handler to the bytes read
+  // into that segment; copy each into its enclave buffer.
+  for (int i = 0; i < iovcnt && output.hasNext(); ++i) {
+    auto segment = output.next();
+    if (segment.size() > iov[i].iov_len) {
+      ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+          "enc_untrusted_readv: segment exceeds requested");
+    }
+    memcpy(iov[i].iov_base, segment.As<char>(), segment.size());
+  }
+
+  return result;
+}
+
+ssize_t enc_untrusted_pwritev(int fd, const struct iovec *iov, int iovcnt,
+                              off_t offset) {
+  if (!iov || iovcnt <= 0 || offset < 0) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  // Preserve ordering with any writes buffered for the fd.
+  if (enc_flush_buffered_writes(fd) != 0) {
+    return -1;
+  }
+
+  MessageWriter input;
+  input.Push(fd);
+  input.Push<uint64_t>(offset);
+  // As in enc_untrusted_writev, each segment travels as its own extent and is
+  // gathered natively on the host, here with pwritev().
+  for (int i = 0; i < iovcnt; ++i) {
+    input.PushByReference(Extent{iov[i].iov_base, iov[i].iov_len});
+  }
+  MessageReader output;
+
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kPWritevHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_pwritev", 2);
+
+  ssize_t result = output.next<ssize_t>();
+  int klinux_errno = output.next<int>();
+  if (result == -1) {
+    errno = FromkLinuxErrorNumber(klinux_errno);
+  }
+  return result;
+}
+
+ssize_t enc_untrusted_preadv(int fd, const struct iovec *iov, int iovcnt,
+                             off_t offset) {
+  if (!iov || iovcnt <= 0 || offset < 0) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  // Keep reads coherent with any writes buffered for the fd.
+  if (enc_flush_buffered_writes(fd) != 0) {
+    return -1;
+  }
+
+  size_t total_size = 0;
+  MessageWriter input;
+  input.Push(fd);
+  input.Push<uint64_t>(offset);
+  for (int i = 0; i < iovcnt; ++i) {
+    input.Push<uint64_t>(iov[i].iov_len);
+    total_size += iov[i].iov_len;
+  }
+  MessageReader output;
+
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kPReadvHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_preadv", 2,
+                           /*match_exact_params=*/false);
+
+  ssize_t result = output.next<ssize_t>();
+  int klinux_errno = output.next<int>();
+  if (result == -1) {
+    errno = FromkLinuxErrorNumber(klinux_errno);
+    return result;
+  }
+
+  if (result > total_size) {
+    ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+        "enc_untrusted_preadv: result exceeds requested");
+  }
+
+  for (int i = 0; i < iovcnt && output.hasNext(); ++i) {
+    auto segment = output.next();
+    if (segment.size() > iov[i].iov_len) {
+      ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+          "enc_untrusted_preadv: segment exceeds requested");
+    }
+    memcpy(iov[i].iov_base, segment.As<char>(), segment.size());
+  }
+
+  return result;
+}
+
+int enc_untrusted_pio_submit(struct enc_positional_io_op *ops, int op_count) {
+  if (!ops || op_count <= 0 ||
+      op_count > ::asylo::host_call::kMaxPIoBatch) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  MessageWriter input;
+  input.Push<uint64_t>(op_count);
+  for (int i = 0; i < op_count; ++i) {
+    if (!ops[i].buf || ops[i].offset < 0) {
+      errno = EINVAL;
+      return -1;
+    }
+    // Keep the batch ordered against any writes buffered for its fds.
+    if (enc_flush_buffered_writes(ops[i].fd) != 0) {
+      return -1;
+    }
+    input.Push(ops[i].fd);
+    input.Push(ops[i].is_write ? 1 : 0);
+    input.Push<uint64_t>(ops[i].offset);
+    if (ops[i].is_write) {
+      input.PushByReference(Extent{ops[i].buf, ops[i].count});
+    } else {
+      input.Push<uint64_t>(ops[i].count);
+    }
+  }
+  MessageReader output;
+
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kPIoSubmitHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_pio_submit",
+                           2 * op_count,
+                           /*match_exact_params=*/false);
+
+  int completed = 0;
+  for (int i = 0; i < op_count; ++i) {
+    ops[i].result = output.next<ssize_t>();
+    int klinux_errno = output.next<int>();
+    ops[i].error_number =
+        ops[i].result == -1 ? FromkLinuxErrorNumber(klinux_errno) : 0;
+    if (ops[i].result != -1) {
+      ++completed;
+    }
+    if (!ops[i].is_write) {
+      if (!output.hasNext()) {
+        ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+            "enc_untrusted_pio_submit: missing read segment");
+      }
+      auto segment = output.next();
+      if (segment.size() > ops[i].count) {
+        ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+            "enc_untrusted_pio_submit: segment exceeds requested");
+      }
+      memcpy(ops[i].buf, segment.As<char>(), segment.size());
+    } else if (ops[i].result > ops[i].count) {
+      ::asylo::primitives::TrustedPrimitives::BestEffortAbort(
+          "enc_untrusted_pio_submit: result exceeds requested");
+    }
+  }
+  return completed;
+}
+
 int enc_untrusted_getsockname(int sockfd, struct sockaddr *addr,
                               socklen_t *addrlen) {
   if (!addr || !addrlen) {
@@ -999,6 +1659,24 @@ ssize_t enc_untrusted_recvfrom(int sockfd, void *buf, size_t len, int flags,
     return -1;
   }
 
+  // Large reads on a ring-enabled socket land directly in a pinned untrusted
+  // slot, so only the copy into |buf| remains. When the host has no free slot
+  // the serializing path below still applies.
+  asylo::host_call::RecvBufRing *ring = GetRecvBufRing(sockfd);
+  if (ring != nullptr && len >= kRecvBufRingThresholdBytes) {
+    int slot = -1;
+    ssize_t ret =
+        RecvViaBufRing(sockfd, len, klinux_flags, &slot, src_addr, addrlen);
+    if (ret >= 0) {
+      memcpy(buf, ring->slots[slot], ret);
+      asylo::host_call::ReleaseRecvBufSlot(ring, slot);
+      return ret;
+    }
+    if (ret != kRecvBufRingNoSlot) {
+      return ret;
+    }
+  }
+
   MessageWriter input;
   input.Push<int>(sockfd);
   input.Push<uint64_t>(len);
@@ -1074,10 +1752,21 @@ int enc_untrusted_gettimeofday(struct timeval *tv, struct timezone *tz) {
 }
 
 int enc_untrusted_fsync(int fd) {
+  if (enc_flush_buffered_writes(fd) != 0) {
+    return -1;
+  }
   return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_fsync,
                                              fd);
 }
 
+int enc_untrusted_fdatasync(int fd) {
+  if (enc_flush_buffered_writes(fd) != 0) {
+    return -1;
+  }
+  return EnsureInitializedAndDispatchSyscall(asylo::system_call::kSYS_fdatasync,
+                                             fd);
+}
+
 int enc_untrusted_raise(int sig) {
   int klinux_sig = TokLinuxSignalNumber(sig);
   if (klinux_sig < 0) {
@@ -1498,6 +2187,207 @@ int enc_untrusted_epoll_wait(int epfd, struct epoll_event *events,
   return result;
 }
 
+uint64_t enc_untrusted_epoll_engine_setup(int epfd) {
+  MessageWriter input;
+  input.Push<int>(epfd);
+  MessageReader output;
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kEpollEventEngineSetupHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_epoll_engine_setup",
+                           1);
+  return output.next<uint64_t>();
+}
+
+int enc_untrusted_epoll_engine_wait(int epfd, int timeout_ms) {
+  MessageWriter input;
+  input.Push<int>(epfd);
+  input.Push<int>(timeout_ms);
+  MessageReader output;
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kEpollEventEngineWaitHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_epoll_engine_wait",
+                           1);
+  return output.next<int>();
+}
+
+int enc_untrusted_epoll_engine_teardown(int epfd) {
+  MessageWriter input;
+  input.Push<int>(epfd);
+  MessageReader output;
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kEpollEventEngineTeardownHandler, &input, &output);
+  CheckStatusAndParamCount(status, output,
+                           "enc_untrusted_epoll_engine_teardown", 1);
+  return output.next<int>();
+}
+
+uint64_t enc_untrusted_fd_readiness_setup() {
+  MessageWriter input;
+  MessageReader output;
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kFdReadinessSetupHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_untrusted_fd_readiness_setup",
+                           1);
+  return output.next<uint64_t>();
+}
+
+int enc_untrusted_fd_readiness_subscribe(int fd) {
+  MessageWriter input;
+  input.Push<int>(fd);
+  MessageReader output;
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kFdReadinessSubscribeHandler, &input, &output);
+  CheckStatusAndParamCount(status, output,
+                           "enc_untrusted_fd_readiness_subscribe", 1);
+  return output.next<int>();
+}
+
+int enc_untrusted_fd_readiness_unsubscribe(int fd) {
+  MessageWriter input;
+  input.Push<int>(fd);
+  MessageReader output;
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kFdReadinessUnsubscribeHandler, &input, &output);
+  CheckStatusAndParamCount(status, output,
+                           "enc_untrusted_fd_readiness_unsubscribe", 1);
+  return output.next<int>();
+}
+
+int enc_untrusted_fd_readiness_teardown() {
+  MessageWriter input;
+  MessageReader output;
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kFdReadinessTeardownHandler, &input, &output);
+  CheckStatusAndParamCount(status, output,
+                           "enc_untrusted_fd_readiness_teardown", 1);
+  return output.next<int>();
+}
+
+int enc_enable_recv_buf_ring(int sockfd) {
+  if (sockfd < 0) {
+    errno = EBADF;
+    return -1;
+  }
+  LockGuard guard(&recv_buf_ring_table_lock);
+  RecvBufRingEntry *free_entry = nullptr;
+  for (RecvBufRingEntry &entry : recv_buf_ring_table) {
+    int entry_fd = entry.fd.load(std::memory_order_relaxed);
+    if (entry_fd == sockfd) {
+      return 0;  // The socket already has a ring.
+    }
+    if (entry_fd == -1 && free_entry == nullptr) {
+      free_entry = &entry;
+    }
+  }
+  if (free_entry == nullptr) {
+    errno = ENOBUFS;
+    return -1;
+  }
+
+  MessageWriter input;
+  input.Push<int>(sockfd);
+  MessageReader output;
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kRecvBufRingSetupHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_enable_recv_buf_ring", 1);
+
+  auto *ring = reinterpret_cast<asylo::host_call::RecvBufRing *>(
+      output.next<uint64_t>());
+  if (ring == nullptr ||
+      !TrustedPrimitives::IsOutsideEnclave(ring, sizeof(*ring)) ||
+      ring->InstanceVersion() !=
+          asylo::host_call::RecvBufRing::TypeVersion()) {
+    // Release whatever the host pinned; a ring that fails validation is
+    // never used.
+    MessageWriter teardown_input;
+    teardown_input.Push<int>(sockfd);
+    MessageReader teardown_output;
+    NonSystemCallDispatcher(::asylo::host_call::kRecvBufRingTeardownHandler,
+                            &teardown_input, &teardown_output);
+    errno = ENOMEM;
+    return -1;
+  }
+
+  free_entry->ring = ring;
+  free_entry->fd.store(sockfd, std::memory_order_release);
+  recv_buf_ring_fd_count.fetch_add(1, std::memory_order_release);
+  return 0;
+}
+
+int enc_disable_recv_buf_ring(int sockfd) {
+  if (recv_buf_ring_fd_count.load(std::memory_order_acquire) == 0) {
+    return -1;
+  }
+  {
+    LockGuard guard(&recv_buf_ring_table_lock);
+    RecvBufRingEntry *found = nullptr;
+    for (RecvBufRingEntry &entry : recv_buf_ring_table) {
+      if (entry.fd.load(std::memory_order_relaxed) == sockfd) {
+        found = &entry;
+        break;
+      }
+    }
+    if (found == nullptr) {
+      return -1;
+    }
+    found->fd.store(-1, std::memory_order_release);
+    found->ring = nullptr;
+    recv_buf_ring_fd_count.fetch_sub(1, std::memory_order_release);
+  }
+
+  MessageWriter input;
+  input.Push<int>(sockfd);
+  MessageReader output;
+  const auto status = NonSystemCallDispatcher(
+      ::asylo::host_call::kRecvBufRingTeardownHandler, &input, &output);
+  CheckStatusAndParamCount(status, output, "enc_disable_recv_buf_ring", 1);
+  return output.next<int>();
+}
+
+ssize_t enc_untrusted_recv_buf_ring_borrow(int sockfd, void **slot, size_t len,
+                                           int flags) {
+  int klinux_flags = TokLinuxRecvSendFlag(flags);
+  if (klinux_flags == 0 && flags != 0) {
+    errno = EINVAL;
+    return -1;
+  }
+  asylo::host_call::RecvBufRing *ring = GetRecvBufRing(sockfd);
+  if (ring == nullptr) {
+    errno = ENOSYS;
+    return -1;
+  }
+  int slot_index = -1;
+  ssize_t ret = RecvViaBufRing(sockfd, len, klinux_flags, &slot_index,
+                               /*src_addr=*/nullptr, /*addrlen=*/nullptr);
+  if (ret == kRecvBufRingNoSlot) {
+    errno = ENOBUFS;
+    return -1;
+  }
+  if (ret >= 0) {
+    *slot = ring->slots[slot_index];
+  }
+  return ret;
+}
+
+void enc_recv_buf_ring_release(int sockfd, const void *slot) {
+  asylo::host_call::RecvBufRing *ring = GetRecvBufRing(sockfd);
+  if (ring == nullptr) {
+    return;
+  }
+  const char *payload = static_cast<const char *>(slot);
+  const char *base = &ring->slots[0][0];
+  if (payload < base ||
+      payload >= base + asylo::host_call::kRecvBufRingSlots *
+                            asylo::host_call::kRecvBufRingSlotSize ||
+      (payload - base) % asylo::host_call::kRecvBufRingSlotSize != 0) {
+    return;
+  }
+  asylo::host_call::ReleaseRecvBufSlot(
+      ring,
+      static_cast<int>((payload - base) /
+                       asylo::host_call::kRecvBufRingSlotSize));
+}
+
 int enc_untrusted_getifaddrs(struct ifaddrs **ifap) {
   MessageWriter input;
   MessageReader output;
@@ -1698,4 +2588,75 @@ int enc_untrusted_ioctl1(int fd, uint64_t request) {
                                              request);
 }
 
+void enc_invalidate_idempotent_call_cache() {
+  getpid_cache.Invalidate();
+  getuid_cache.Invalidate();
+  geteuid_cache.Invalidate();
+  getgid_cache.Invalidate();
+  getegid_cache.Invalidate();
+  pagesize_cache.Invalidate();
+}
+
+int enc_enable_write_buffering(int fd, size_t capacity) {
+  if (fd < 0 || capacity == 0) {
+    errno = EINVAL;
+    return -1;
+  }
+  LockGuard table_lock(&write_buffers_table_lock);
+  WriteBuffer *free_slot = nullptr;
+  for (WriteBuffer &buffer : write_buffers) {
+    int slot_fd = buffer.fd.load(std::memory_order_relaxed);
+    if (slot_fd == fd) {
+      errno = EBUSY;
+      return -1;
+    }
+    if (slot_fd == -1 && !free_slot) {
+      free_slot = &buffer;
+    }
+  }
+  if (!free_slot) {
+    errno = ENOMEM;
+    return -1;
+  }
+  LockGuard slot_lock(&free_slot->lock);
+  free_slot->data = new char[capacity];
+  free_slot->capacity = capacity;
+  free_slot->used = 0;
+  free_slot->fd.store(fd, std::memory_order_release);
+  buffered_write_fd_count.fetch_add(1, std::memory_order_release);
+  return 0;
+}
+
+int enc_disable_write_buffering(int fd) {
+  if (buffered_write_fd_count.load(std::memory_order_acquire) == 0) {
+    return 0;
+  }
+  LockGuard table_lock(&write_buffers_table_lock);
+  for (WriteBuffer &buffer : write_buffers) {
+    if (buffer.fd.load(std::memory_order_relaxed) != fd) {
+      continue;
+    }
+    LockGuard slot_lock(&buffer.lock);
+    int result = FlushWriteBufferLocked(&buffer);
+    delete[] buffer.data;
+    buffer.data = nullptr;
+    buffer.capacity = 0;
+    buffer.used = 0;
+    buffer.fd.store(-1, std::memory_order_release);
+    buffered_write_fd_count.fetch_sub(1, std::memory_order_release);
+    return result;
+  }
+  return 0;
+}
+
+int enc_flush_buffered_writes(int fd) {
+  WriteBuffer *buffer = AcquireWriteBuffer(fd);
+  if (!buffer) {
+    return 0;
+  }
+  int result = FlushWriteBufferLocked(buffer);
+  buffer->lock.Unlock();
+  return result;
+}
+
 }  // extern "C"
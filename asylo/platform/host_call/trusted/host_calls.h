@@ -31,6 +31,7 @@
 #include <sched.h>
 #include <sys/epoll.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <cstdarg>
 #include <cstddef>
@@ -48,6 +49,14 @@ int64_t EnsureInitializedAndDispatchSyscall(int sysno, Ts... args) {
   if (!enc_is_syscall_dispatcher_set()) {
     enc_set_dispatch_syscall(asylo::host_call::SystemCallDispatcher);
   }
+  if (!enc_is_sg_syscall_dispatcher_set()) {
+    enc_set_dispatch_sg_syscall(asylo::host_call::SystemCallSgDispatcher);
+  }
+  if (!enc_is_async_syscall_dispatcher_set()) {
+    enc_set_dispatch_async_syscall(
+        asylo::host_call::AsyncSystemCallSubmitDispatcher,
+        asylo::host_call::AsyncSystemCallCollectDispatcher);
+  }
   if (!enc_is_error_handler_set()) {
     enc_set_error_handler(
         asylo::primitives::TrustedPrimitives::BestEffortAbort);
@@ -79,6 +88,12 @@ gid_t enc_untrusted_getegid();
 int enc_untrusted_kill(pid_t pid, int sig);
 int enc_untrusted_link(const char *oldpath, const char *newpath);
 off_t enc_untrusted_lseek(int fd, off_t offset, int whence);
+
+// Reads directory entries from the host into |dirp|, which holds |count|
+// bytes. Entries are returned in the host kernel's linux_dirent64 record
+// format, untranslated; returns the number of bytes read, 0 at end of
+// directory, or -1 with errno set.
+int enc_untrusted_getdents64(int fd, void *dirp, unsigned int count);
 int enc_untrusted_mkdir(const char *pathname, mode_t mode);
 int enc_untrusted_open(const char *pathname, int flags, ...);
 int enc_untrusted_unlink(const char *pathname);
@@ -133,6 +148,14 @@ ssize_t enc_untrusted_llistxattr(const char *path, char *list, size_t size);
 ssize_t enc_untrusted_flistxattr(int fd, char *list, size_t size);
 int enc_untrusted_pread64(int fd, void *buf, size_t count, off_t offset);
 int enc_untrusted_pwrite64(int fd, const void *buf, size_t count, off_t offset);
+
+// Kernel-side transfer modeled on sendfile(2): up to |count| bytes move from
+// |in_fd| to |out_fd| on the host without entering the enclave. Passing an
+// explicit |offset| takes a single host call; the null-offset form (use and
+// advance the file offset of |in_fd|) is emulated with additional lseek()
+// host calls, since a null pointer does not survive serialization.
+ssize_t enc_untrusted_sendfile(int out_fd, int in_fd, off_t *offset,
+                               size_t count);
 int enc_untrusted_wait(int *wstatus);
 int enc_untrusted_close(int fd);
 int enc_untrusted_nanosleep(const struct timespec *req, struct timespec *rem);
@@ -143,6 +166,7 @@ int enc_untrusted_connect(int sockfd, const struct sockaddr *addr,
                           socklen_t addrlen);
 int enc_untrusted_gettimeofday(struct timeval *tv, struct timezone *tz);
 int enc_untrusted_fsync(int fd);
+int enc_untrusted_fdatasync(int fd);
 int enc_untrusted_getitimer(int which, struct itimerval *curr_value);
 int enc_untrusted_setitimer(int which, const struct itimerval *new_value,
                             struct itimerval *old_value);
@@ -153,6 +177,64 @@ int enc_untrusted_epoll_ctl(int epfd, int op, int fd,
                             struct epoll_event *event);
 int enc_untrusted_epoll_wait(int epfd, struct epoll_event *events,
                              int maxevents, int timeout);
+
+// Starts an untrusted epoll event engine for the host epoll file descriptor
+// |epfd| and returns the untrusted address of its completion ring, or 0 if the
+// engine could not be started. The returned address is untrusted input and
+// must be validated before use.
+uint64_t enc_untrusted_epoll_engine_setup(int epfd);
+
+// Blocks on the untrusted side until the completion ring of the engine for
+// |epfd| holds a record, the engine shuts down, or |timeout_ms| milliseconds
+// elapse (negative waits indefinitely). Returns 0 on success, -1 if no engine
+// is running for |epfd|.
+int enc_untrusted_epoll_engine_wait(int epfd, int timeout_ms);
+
+// Stops the untrusted epoll event engine for |epfd|.
+int enc_untrusted_epoll_engine_teardown(int epfd);
+
+// Starts (or returns) the process-wide untrusted fd readiness engine,
+// returning the untrusted address of its shared readiness map, or 0 on
+// failure. The trusted caller must validate the address before use.
+uint64_t enc_untrusted_fd_readiness_setup();
+
+// Subscribes host file descriptor |fd| to the fd readiness engine, watching
+// it edge-triggered for readability, writability and error conditions.
+int enc_untrusted_fd_readiness_subscribe(int fd);
+
+// Removes host file descriptor |fd| from the fd readiness engine's watch set.
+int enc_untrusted_fd_readiness_unsubscribe(int fd);
+
+// Stops the untrusted fd readiness engine.
+int enc_untrusted_fd_readiness_teardown();
+
+// Pins an untrusted receive buffer ring to host socket |sockfd|. Large
+// enc_untrusted_recvfrom() calls on a ring-enabled socket land directly in a
+// reusable untrusted slot, leaving one copy into the trusted caller buffer
+// instead of an untrusted scratch allocation plus a serialized round trip.
+// Returns 0 on success, -1 on failure. The ring is released on close().
+int enc_enable_recv_buf_ring(int sockfd);
+
+// Unpins and frees the receive buffer ring of |sockfd|, if any. Must not race
+// with in-flight recvs or borrowed slots on the socket. Returns 0 on success,
+// -1 if the socket has no ring.
+int enc_disable_recv_buf_ring(int sockfd);
+
+// Receives up to |len| bytes from ring-enabled socket |sockfd| without
+// copying them into trusted memory: on success points |*slot| at the payload
+// inside the socket's untrusted ring slot and returns the byte count. The
+// payload is UNTRUSTED MEMORY the host can modify while it is read; callers
+// opting into these placement semantics must treat it accordingly and return
+// the slot with enc_recv_buf_ring_release() when done, or the ring will run
+// out of slots. Falls back to errno == ENOSYS when the socket has no ring
+// and EAGAIN-style failure semantics otherwise match recvfrom().
+ssize_t enc_untrusted_recv_buf_ring_borrow(int sockfd, void **slot, size_t len,
+                                           int flags);
+
+// Returns a slot obtained from enc_untrusted_recv_buf_ring_borrow() to the
+// ring of |sockfd|. Does not exit the enclave.
+void enc_recv_buf_ring_release(int sockfd, const void *slot);
+
 int enc_untrusted_utimes(const char *filename, const struct timeval times[2]);
 int enc_untrusted_utime(const char *filename, const struct utimbuf *times);
 int enc_untrusted_getrusage(int who, struct rusage *usage);
@@ -169,6 +251,52 @@ void *enc_untrusted_realloc(void *ptr, size_t size);
 uint32_t enc_untrusted_sleep(uint32_t seconds);
 ssize_t enc_untrusted_sendmsg(int sockfd, const struct msghdr *msg, int flags);
 ssize_t enc_untrusted_recvmsg(int sockfd, struct msghdr *msg, int flags);
+
+// Batched equivalents of sendmsg/recvmsg modeled on sendmmsg(2)/recvmmsg(2),
+// moving up to |vlen| messages per host call so a batch of datagrams costs one
+// enclave exit instead of one per message. The messages are passed as an array
+// of standard msghdr structs (the enclave C library does not define struct
+// mmsghdr); the bytes transferred for message |i| are reported in
+// |msg_lens[i]| when |msg_lens| is non-null. Both return the number of
+// messages transferred, which may be less than |vlen| (at most kMaxMmsgBatch
+// messages move per call), or -1 with errno set if no message could be
+// transferred. enc_untrusted_recvmmsg blocks (subject to |flags|) only for the
+// first message and drains the rest of the batch without waiting.
+int enc_untrusted_sendmmsg(int sockfd, struct msghdr *msgvec, unsigned int vlen,
+                           int flags, unsigned int *msg_lens);
+int enc_untrusted_recvmmsg(int sockfd, struct msghdr *msgvec, unsigned int vlen,
+                           int flags, unsigned int *msg_lens);
+ssize_t enc_untrusted_writev(int fd, const struct iovec *iov, int iovcnt);
+ssize_t enc_untrusted_readv(int fd, const struct iovec *iov, int iovcnt);
+
+// Positional vectored I/O modeled on pwritev(2)/preadv(2). The file offset of
+// |fd| is not consulted or changed, so no lseek() host call is needed and
+// concurrent callers do not race on the shared offset.
+ssize_t enc_untrusted_pwritev(int fd, const struct iovec *iov, int iovcnt,
+                              off_t offset);
+ssize_t enc_untrusted_preadv(int fd, const struct iovec *iov, int iovcnt,
+                             off_t offset);
+
+// One positional read or write for enc_untrusted_pio_submit(). |fd| may
+// differ per operation. On completion |result| holds the bytes transferred,
+// or -1 with the error in |error_number|.
+struct enc_positional_io_op {
+  int fd;
+  int is_write;  // Nonzero writes |count| bytes from |buf|; zero reads into
+                 // |buf|.
+  void *buf;
+  size_t count;
+  off_t offset;
+  ssize_t result;
+  int error_number;
+};
+
+// Issues up to kMaxPIoBatch positional reads and writes - across any mix of
+// file descriptors - in a single enclave exit, filling in each operation's
+// |result| and |error_number|. Returns the number of operations that
+// completed successfully, or -1 with errno set if the batch itself is
+// malformed. A failed operation does not stop the rest of the batch.
+int enc_untrusted_pio_submit(struct enc_positional_io_op *ops, int op_count);
 int enc_untrusted_getsockname(int sockfd, struct sockaddr *addr,
                               socklen_t *addrlen);
 int enc_untrusted_accept(int sockfd, struct sockaddr *addr, socklen_t *addrlen);
@@ -207,6 +335,8 @@ int enc_untrusted_inotify_read(int fd, size_t count, char **serialized_events,
 int enc_untrusted_sys_futex_wait(int32_t *futex, int32_t expected,
                                  int64_t timeout_microsec);
 int enc_untrusted_sys_futex_wake(int32_t *futex, int32_t num);
+int enc_untrusted_sys_futex_requeue(int32_t *futex, int32_t num_wake,
+                                    int32_t num_move, int32_t *requeue_futex);
 
 // Calls that are not delegated to the host or depend on other host calls are
 // defined below.
@@ -230,6 +360,13 @@ void enc_untrusted_thread_wait(int32_t *const queue,
 // Wake |num_threads| threads currently waiting on the |queue|.
 void enc_untrusted_notify(int32_t *const queue, int32_t num_threads = 1);
 
+// Wakes up to |num_wake| threads waiting on the |queue| and moves the
+// remaining waiters to |target_queue| without waking them, all in a single
+// enclave exit. The moved threads are woken by later notifies on
+// |target_queue|.
+void enc_untrusted_notify_and_requeue(int32_t *const queue, int32_t num_wake,
+                                      int32_t *const target_queue);
+
 // Disable waiting on the given |queue|.
 void enc_untrusted_disable_waiting(int32_t *const queue);
 
@@ -244,6 +381,31 @@ void enc_untrusted_wait_queue_set_value(int32_t *const queue, int32_t value);
 void enc_untrusted_thread_wait_value(int32_t *const queue, int32_t value,
                                      uint64_t timeout_microsec = 0);
 
+// Drops cached results of idempotent host calls (process and user identity,
+// page size), forcing the next call of each to exit the enclave again. Called
+// in the child after fork(), where the cached process identity no longer
+// applies.
+void enc_invalidate_idempotent_call_cache();
+
+// Enables write buffering for |fd|: subsequent enc_untrusted_write() calls
+// accumulate up to |capacity| bytes in trusted memory and cross the enclave
+// boundary only when the buffer fills, or on enc_flush_buffered_writes(),
+// fsync() or close() of the fd. A buffered write reports success when the
+// bytes are accepted into the buffer; errors from the deferred host writes
+// surface on the call that flushes them. Returns 0 on success; returns -1
+// with EBUSY if the fd is already buffered or ENOMEM if no buffering slot is
+// free.
+int enc_enable_write_buffering(int fd, size_t capacity);
+
+// Disables write buffering for |fd|, flushing any pending bytes first.
+// Returns the result of the flush, or 0 when the fd was not buffered.
+int enc_disable_write_buffering(int fd);
+
+// Flushes the pending buffered writes of |fd| to the host. Returns 0 on
+// success or when the fd is not buffered; on failure returns -1 with errno
+// set by the failed write, retaining the unwritten bytes.
+int enc_flush_buffered_writes(int fd);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,200 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/host_call/untrusted/epoll_event_engine.h"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/time/time.h"
+
+namespace asylo {
+namespace host_call {
+namespace {
+
+// epoll data value identifying the engine's wakeup event file descriptor. An
+// enclave-chosen key colliding with this value would have its events
+// suppressed, but the enclave draws its keys from a 64-bit random space, so a
+// collision is vanishingly unlikely.
+constexpr uint64_t kWakeupKey = 0x9e3779b97f4a7c15;
+
+// Guards the running engine registry.
+absl::Mutex *EnginesLock() {
+  static absl::Mutex *lock = new absl::Mutex();
+  return lock;
+}
+
+// Running engines, keyed by host epoll file descriptor.
+std::map<int, std::shared_ptr<EpollEventEngine>> *Engines() {
+  static auto *engines = new std::map<int, std::shared_ptr<EpollEventEngine>>;
+  return engines;
+}
+
+// Returns true once |ring| holds data to drain or will never hold more.
+bool RingHasRecords(EpollEventRing *ring) {
+  return !ring->empty() || ring->is_closed_for_write();
+}
+
+}  // namespace
+
+uint64_t EpollEventEngine::Setup(int epfd) {
+  absl::MutexLock lock(EnginesLock());
+  auto *engines = Engines();
+  if (engines->find(epfd) != engines->end()) {
+    return 0;
+  }
+  std::shared_ptr<EpollEventEngine> engine(new EpollEventEngine(epfd));
+  if (!engine->Start()) {
+    return 0;
+  }
+  uint64_t ring_address = reinterpret_cast<uint64_t>(engine->ring_.get());
+  (*engines)[epfd] = std::move(engine);
+  return ring_address;
+}
+
+int EpollEventEngine::Wait(int epfd, int timeout_ms) {
+  std::shared_ptr<EpollEventEngine> engine;
+  {
+    absl::MutexLock lock(EnginesLock());
+    auto it = Engines()->find(epfd);
+    if (it == Engines()->end()) {
+      return -1;
+    }
+    engine = it->second;
+  }
+  engine->WaitForRecords(timeout_ms);
+  return 0;
+}
+
+void EpollEventEngine::Teardown(int epfd) {
+  std::shared_ptr<EpollEventEngine> engine;
+  {
+    absl::MutexLock lock(EnginesLock());
+    auto it = Engines()->find(epfd);
+    if (it == Engines()->end()) {
+      return;
+    }
+    engine = std::move(it->second);
+    Engines()->erase(it);
+  }
+  engine->Stop();
+}
+
+EpollEventEngine::~EpollEventEngine() {
+  if (wakeup_fd_ >= 0) {
+    close(wakeup_fd_);
+  }
+}
+
+bool EpollEventEngine::Start() {
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK);
+  if (wakeup_fd_ < 0) {
+    return false;
+  }
+  struct epoll_event event;
+  event.events = EPOLLIN;
+  event.data.u64 = kWakeupKey;
+  if (epoll_ctl(epfd_, EPOLL_CTL_ADD, wakeup_fd_, &event) != 0) {
+    close(wakeup_fd_);
+    wakeup_fd_ = -1;
+    return false;
+  }
+  ring_ = absl::make_unique<EpollEventRing>();
+  thread_ = absl::make_unique<Thread>(&EpollEventEngine::PollLoop, this);
+  return true;
+}
+
+void EpollEventEngine::Stop() {
+  if (!thread_) {
+    return;
+  }
+  stop_.store(true, std::memory_order_release);
+  // Unblock a poller parked writing into a full ring, then wake it from
+  // epoll_wait() through the wakeup event file descriptor.
+  ring_->close_for_read();
+  uint64_t value = 1;
+  if (write(wakeup_fd_, &value, sizeof(value)) < 0) {
+    // Nothing to do; the poller will still observe the closed ring on its
+    // next deposit.
+  }
+  thread_->Join();
+  thread_.reset();
+  // Wake trusted waiters parked on an engine that produces no more records.
+  ring_->close_for_write();
+  absl::MutexLock lock(&mu_);
+}
+
+void EpollEventEngine::PollLoop() {
+  constexpr int kMaxEvents = 64;
+  struct epoll_event events[kMaxEvents];
+  while (!stop_.load(std::memory_order_acquire)) {
+    int count = epoll_wait(epfd_, events, kMaxEvents, /*timeout=*/-1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;  // The epoll file descriptor went away; shut the channel down.
+    }
+    bool deposited = false;
+    for (int i = 0; i < count; ++i) {
+      if (events[i].data.u64 == kWakeupKey) {
+        uint64_t drained;
+        while (read(wakeup_fd_, &drained, sizeof(drained)) > 0) {
+        }
+        continue;
+      }
+      EpollEventRecord record;
+      record.data = events[i].data.u64;
+      record.events = events[i].events;
+      record.reserved = 0;
+      if (!EnqueueEpollEventRecord(ring_.get(), record)) {
+        // The ring was closed for reading; teardown is in progress.
+        stop_.store(true, std::memory_order_release);
+        break;
+      }
+      deposited = true;
+    }
+    if (deposited) {
+      // Acquire and release the wait mutex so that parked WaitForRecords()
+      // callers re-evaluate the ring.
+      absl::MutexLock lock(&mu_);
+    }
+  }
+  ring_->close_for_write();
+  absl::MutexLock lock(&mu_);
+}
+
+void EpollEventEngine::WaitForRecords(int timeout_ms) {
+  absl::MutexLock lock(&mu_);
+  absl::Condition has_records(RingHasRecords, ring_.get());
+  if (timeout_ms < 0) {
+    mu_.Await(has_records);
+  } else {
+    mu_.AwaitWithTimeout(has_records, absl::Milliseconds(timeout_ms));
+  }
+}
+
+}  // namespace host_call
+}  // namespace asylo
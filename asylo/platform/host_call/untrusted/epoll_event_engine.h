@@ -0,0 +1,101 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_EPOLL_EVENT_ENGINE_H_
+#define ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_EPOLL_EVENT_ENGINE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "absl/synchronization/mutex.h"
+#include "asylo/platform/host_call/epoll_event_ring.h"
+#include "asylo/util/thread.h"
+
+namespace asylo {
+namespace host_call {
+
+// An untrusted event engine servicing one enclave epoll instance without an
+// enclave exit per ready event. A dedicated poller thread blocks in
+// epoll_wait() on the host epoll file descriptor and deposits every ready
+// event into an EpollEventRing, which the trusted side drains in place of
+// issuing epoll_wait host calls. While an engine is running it is the only
+// consumer of its host epoll file descriptor.
+class EpollEventEngine {
+ public:
+  // Creates and starts an engine for the host epoll file descriptor |epfd|.
+  // Returns the untrusted address of the engine's completion ring, or 0 if
+  // the engine could not be started or one is already running for |epfd|.
+  static uint64_t Setup(int epfd);
+
+  // Blocks until the completion ring of the engine for |epfd| holds at least
+  // one record, the engine shuts down, or |timeout_ms| milliseconds elapse (a
+  // negative timeout waits indefinitely). Returns 0 on success or -1 if no
+  // engine is running for |epfd|.
+  static int Wait(int epfd, int timeout_ms);
+
+  // Stops and destroys the engine for |epfd|, joining its poller thread. A
+  // no-op if no engine is running for |epfd|.
+  static void Teardown(int epfd);
+
+  ~EpollEventEngine();
+
+  EpollEventEngine(const EpollEventEngine &) = delete;
+  EpollEventEngine &operator=(const EpollEventEngine &) = delete;
+
+ private:
+  explicit EpollEventEngine(int epfd) : epfd_(epfd) {}
+
+  // Registers the wakeup event file descriptor with the epoll set and starts
+  // the poller thread. Returns false on failure.
+  bool Start();
+
+  // Closes the ring, unblocks the poller thread and joins it.
+  void Stop();
+
+  // Poller thread body: forwards ready events into the ring until stopped.
+  void PollLoop();
+
+  // Blocks until the ring holds a record or is closed for writing, bounded by
+  // |timeout_ms| when non-negative.
+  void WaitForRecords(int timeout_ms);
+
+  // Host epoll file descriptor this engine serves.
+  int epfd_;
+
+  // Event file descriptor registered with the epoll set to unblock the poller
+  // thread on Stop().
+  int wakeup_fd_ = -1;
+
+  // Completion ring shared with the trusted side.
+  std::unique_ptr<EpollEventRing> ring_;
+
+  std::unique_ptr<Thread> thread_;
+
+  // Asks the poller thread to exit.
+  std::atomic<bool> stop_{false};
+
+  // Acquired and released by the poller thread after depositing records, so
+  // that WaitForRecords() callers re-evaluate the ring.
+  absl::Mutex mu_;
+};
+
+}  // namespace host_call
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_EPOLL_EVENT_ENGINE_H_
@@ -0,0 +1,89 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/host_call/untrusted/epoll_event_engine.h"
+
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "asylo/platform/host_call/epoll_event_ring.h"
+
+namespace asylo {
+namespace host_call {
+namespace {
+
+TEST(EpollEventEngineTest, DepositsReadyEventsIntoRing) {
+  int epfd = epoll_create1(0);
+  ASSERT_GE(epfd, 0);
+  int event_fd = eventfd(0, 0);
+  ASSERT_GE(event_fd, 0);
+
+  constexpr uint64_t kKey = 0x1234567890abcdef;
+  struct epoll_event event;
+  event.events = EPOLLIN;
+  event.data.u64 = kKey;
+  ASSERT_EQ(epoll_ctl(epfd, EPOLL_CTL_ADD, event_fd, &event), 0);
+
+  uint64_t ring_address = EpollEventEngine::Setup(epfd);
+  ASSERT_NE(ring_address, 0);
+
+  // A second engine cannot be attached to the same epoll file descriptor.
+  EXPECT_EQ(EpollEventEngine::Setup(epfd), 0);
+
+  // Making the registered file descriptor readable deposits a completion
+  // record carrying the registered epoll data.
+  auto *ring = reinterpret_cast<EpollEventRing *>(ring_address);
+  uint64_t value = 1;
+  ASSERT_EQ(write(event_fd, &value, sizeof(value)), sizeof(value));
+  EXPECT_EQ(EpollEventEngine::Wait(epfd, /*timeout_ms=*/5000), 0);
+
+  EpollEventRecord record;
+  ASSERT_TRUE(DequeueEpollEventRecord(ring, &record));
+  EXPECT_EQ(record.data, kKey);
+  EXPECT_NE(record.events & EPOLLIN, 0);
+
+  // Clear the readiness before tearing down so that the poller stops
+  // redepositing the level-triggered event.
+  ASSERT_EQ(read(event_fd, &value, sizeof(value)), sizeof(value));
+  EpollEventEngine::Teardown(epfd);
+
+  // After teardown the epoll file descriptor can host a fresh engine.
+  EXPECT_NE(EpollEventEngine::Setup(epfd), 0);
+  EpollEventEngine::Teardown(epfd);
+
+  close(event_fd);
+  close(epfd);
+}
+
+TEST(EpollEventEngineTest, WaitWithoutEngineFails) {
+  int epfd = epoll_create1(0);
+  ASSERT_GE(epfd, 0);
+  EXPECT_EQ(EpollEventEngine::Wait(epfd, /*timeout_ms=*/0), -1);
+
+  // Tearing down a descriptor without an engine is a no-op.
+  EpollEventEngine::Teardown(epfd);
+  close(epfd);
+}
+
+}  // namespace
+}  // namespace host_call
+}  // namespace asylo
@@ -0,0 +1,215 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/host_call/untrusted/fd_readiness_engine.h"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+
+namespace asylo {
+namespace host_call {
+namespace {
+
+// epoll data value identifying the engine's wakeup event file descriptor.
+// Subscribed descriptors carry their own fd number as data, which can never
+// collide with this value.
+constexpr uint64_t kWakeupKey = ~uint64_t{0};
+
+// Guards the running engine singleton.
+absl::Mutex *EngineLock() {
+  static absl::Mutex *lock = new absl::Mutex();
+  return lock;
+}
+
+// The running engine, if any.
+std::shared_ptr<FdReadinessEngine> *Engine() {
+  static auto *engine = new std::shared_ptr<FdReadinessEngine>;
+  return engine;
+}
+
+// Translates a host epoll event mask into readiness bits.
+uint32_t ReadinessBitsFromEpollEvents(uint32_t events) {
+  uint32_t bits = 0;
+  if (events & (EPOLLIN | EPOLLPRI)) {
+    bits |= kFdReadinessReadable;
+  }
+  if (events & EPOLLOUT) {
+    bits |= kFdReadinessWritable;
+  }
+  if (events & EPOLLERR) {
+    bits |= kFdReadinessError;
+  }
+  if (events & (EPOLLHUP | EPOLLRDHUP)) {
+    bits |= kFdReadinessHangup;
+  }
+  return bits;
+}
+
+}  // namespace
+
+uint64_t FdReadinessEngine::Setup() {
+  absl::MutexLock lock(EngineLock());
+  auto *engine = Engine();
+  if (*engine) {
+    return reinterpret_cast<uint64_t>((*engine)->map_.get());
+  }
+  std::shared_ptr<FdReadinessEngine> candidate(new FdReadinessEngine());
+  if (!candidate->Start()) {
+    return 0;
+  }
+  uint64_t map_address = reinterpret_cast<uint64_t>(candidate->map_.get());
+  *engine = std::move(candidate);
+  return map_address;
+}
+
+int FdReadinessEngine::Subscribe(int fd) {
+  if (!FdReadinessInRange(fd)) {
+    return -1;
+  }
+  std::shared_ptr<FdReadinessEngine> engine;
+  {
+    absl::MutexLock lock(EngineLock());
+    engine = *Engine();
+  }
+  if (!engine) {
+    return -1;
+  }
+  // Discard hints a previous user of this descriptor number left behind.
+  ConsumeFdReadiness(engine->map_.get(), fd);
+  struct epoll_event event;
+  event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+  event.data.u64 = fd;
+  if (epoll_ctl(engine->epfd_, EPOLL_CTL_ADD, fd, &event) == 0) {
+    return 0;
+  }
+  if (errno == EEXIST &&
+      epoll_ctl(engine->epfd_, EPOLL_CTL_MOD, fd, &event) == 0) {
+    return 0;
+  }
+  return -1;
+}
+
+int FdReadinessEngine::Unsubscribe(int fd) {
+  std::shared_ptr<FdReadinessEngine> engine;
+  {
+    absl::MutexLock lock(EngineLock());
+    engine = *Engine();
+  }
+  if (!engine) {
+    return -1;
+  }
+  int result = epoll_ctl(engine->epfd_, EPOLL_CTL_DEL, fd, nullptr);
+  ConsumeFdReadiness(engine->map_.get(), fd);
+  return result;
+}
+
+void FdReadinessEngine::Teardown() {
+  std::shared_ptr<FdReadinessEngine> engine;
+  {
+    absl::MutexLock lock(EngineLock());
+    engine = std::move(*Engine());
+    Engine()->reset();
+  }
+  if (engine) {
+    engine->Stop();
+  }
+}
+
+FdReadinessEngine::~FdReadinessEngine() {
+  if (wakeup_fd_ >= 0) {
+    close(wakeup_fd_);
+  }
+  if (epfd_ >= 0) {
+    close(epfd_);
+  }
+}
+
+bool FdReadinessEngine::Start() {
+  epfd_ = epoll_create1(0);
+  if (epfd_ < 0) {
+    return false;
+  }
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK);
+  if (wakeup_fd_ < 0) {
+    close(epfd_);
+    epfd_ = -1;
+    return false;
+  }
+  struct epoll_event event;
+  event.events = EPOLLIN;
+  event.data.u64 = kWakeupKey;
+  if (epoll_ctl(epfd_, EPOLL_CTL_ADD, wakeup_fd_, &event) != 0) {
+    close(wakeup_fd_);
+    close(epfd_);
+    wakeup_fd_ = -1;
+    epfd_ = -1;
+    return false;
+  }
+  map_ = absl::make_unique<FdReadinessMap>();
+  thread_ = absl::make_unique<Thread>(&FdReadinessEngine::PollLoop, this);
+  return true;
+}
+
+void FdReadinessEngine::Stop() {
+  if (!thread_) {
+    return;
+  }
+  stop_.store(true, std::memory_order_release);
+  uint64_t value = 1;
+  if (write(wakeup_fd_, &value, sizeof(value)) < 0) {
+    // Nothing to do; the poller is not blocked and will observe |stop_| on
+    // its next iteration.
+  }
+  thread_->Join();
+  thread_.reset();
+}
+
+void FdReadinessEngine::PollLoop() {
+  constexpr int kMaxEvents = 64;
+  struct epoll_event events[kMaxEvents];
+  while (!stop_.load(std::memory_order_acquire)) {
+    int count = epoll_wait(epfd_, events, kMaxEvents, /*timeout=*/-1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;  // The epoll file descriptor went away; stop maintaining state.
+    }
+    for (int i = 0; i < count; ++i) {
+      if (events[i].data.u64 == kWakeupKey) {
+        uint64_t drained;
+        while (read(wakeup_fd_, &drained, sizeof(drained)) > 0) {
+        }
+        continue;
+      }
+      MarkFdReadiness(map_.get(), static_cast<int>(events[i].data.u64),
+                      ReadinessBitsFromEpollEvents(events[i].events));
+    }
+  }
+}
+
+}  // namespace host_call
+}  // namespace asylo
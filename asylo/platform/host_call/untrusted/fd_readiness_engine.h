@@ -0,0 +1,100 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_FD_READINESS_ENGINE_H_
+#define ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_FD_READINESS_ENGINE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "asylo/platform/host_call/fd_readiness_map.h"
+#include "asylo/util/thread.h"
+
+namespace asylo {
+namespace host_call {
+
+// An untrusted event engine maintaining per-fd readiness state for an enclave
+// in a shared FdReadinessMap, so busy trusted event loops can poll subscribed
+// file descriptors without an enclave exit. One process-wide engine owns a
+// host epoll set; subscribed host file descriptors are registered
+// edge-triggered, and a dedicated poller thread translates each edge into
+// readiness bits in the map. The trusted side clears the bits it consumes,
+// which arms the slot for the next edge.
+class FdReadinessEngine {
+ public:
+  // Starts the process-wide engine if it is not running and returns the
+  // untrusted address of its readiness map, or 0 if the engine could not be
+  // started. Idempotent: subsequent calls return the running engine's map.
+  static uint64_t Setup();
+
+  // Subscribes host file descriptor |fd| to the running engine, watching it
+  // edge-triggered for readability, writability and error conditions.
+  // Resubscribing an already-watched descriptor discards its stale readiness
+  // bits. Returns 0 on success or -1 if the engine is not running, |fd| lies
+  // outside the map's range, or the epoll registration fails.
+  static int Subscribe(int fd);
+
+  // Removes host file descriptor |fd| from the engine's watch set and clears
+  // its readiness bits. Returns 0 on success or -1 if the engine is not
+  // running or |fd| was not subscribed.
+  static int Unsubscribe(int fd);
+
+  // Stops and destroys the engine, joining its poller thread. A no-op if no
+  // engine is running.
+  static void Teardown();
+
+  ~FdReadinessEngine();
+
+  FdReadinessEngine(const FdReadinessEngine &) = delete;
+  FdReadinessEngine &operator=(const FdReadinessEngine &) = delete;
+
+ private:
+  FdReadinessEngine() = default;
+
+  // Creates the epoll set and wakeup event file descriptor, allocates the
+  // readiness map and starts the poller thread. Returns false on failure.
+  bool Start();
+
+  // Asks the poller thread to exit, wakes it and joins it.
+  void Stop();
+
+  // Poller thread body: translates ready epoll events into readiness bits
+  // until stopped.
+  void PollLoop();
+
+  // Host epoll set holding the subscribed file descriptors.
+  int epfd_ = -1;
+
+  // Event file descriptor registered with the epoll set to unblock the poller
+  // thread on Stop().
+  int wakeup_fd_ = -1;
+
+  // Readiness map shared with the trusted side.
+  std::unique_ptr<FdReadinessMap> map_;
+
+  std::unique_ptr<Thread> thread_;
+
+  // Asks the poller thread to exit.
+  std::atomic<bool> stop_{false};
+};
+
+}  // namespace host_call
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_FD_READINESS_ENGINE_H_
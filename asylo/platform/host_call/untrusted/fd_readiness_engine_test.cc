@@ -0,0 +1,113 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/host_call/untrusted/fd_readiness_engine.h"
+
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "asylo/platform/host_call/fd_readiness_map.h"
+
+namespace asylo {
+namespace host_call {
+namespace {
+
+// Polls the readiness map until |fd| carries all of |bits| or five seconds
+// elapse, returning the bits observed last. The engine's poller thread
+// deposits bits asynchronously, so tests must wait for them.
+uint32_t AwaitReadiness(const FdReadinessMap *map, int fd, uint32_t bits) {
+  uint32_t observed = 0;
+  for (int i = 0; i < 5000; ++i) {
+    observed = TestFdReadiness(map, fd);
+    if ((observed & bits) == bits) {
+      break;
+    }
+    struct timespec delay = {0, 1000000};  // 1ms.
+    nanosleep(&delay, nullptr);
+  }
+  return observed;
+}
+
+TEST(FdReadinessEngineTest, DepositsReadinessBitsForSubscribedFds) {
+  uint64_t map_address = FdReadinessEngine::Setup();
+  ASSERT_NE(map_address, 0);
+
+  // Setup is idempotent and returns the running engine's map.
+  EXPECT_EQ(FdReadinessEngine::Setup(), map_address);
+
+  auto *map = reinterpret_cast<FdReadinessMap *>(map_address);
+  EXPECT_EQ(map->InstanceVersion(), FdReadinessMap::TypeVersion());
+
+  int event_fd = eventfd(0, 0);
+  ASSERT_GE(event_fd, 0);
+  ASSERT_EQ(FdReadinessEngine::Subscribe(event_fd), 0);
+
+  // An eventfd with a zero counter is writable but not readable, so the
+  // subscription's first edge reports writability alone.
+  EXPECT_EQ(AwaitReadiness(map, event_fd, kFdReadinessWritable),
+            kFdReadinessWritable);
+
+  // Making the descriptor readable deposits the readable bit.
+  uint64_t value = 1;
+  ASSERT_EQ(write(event_fd, &value, sizeof(value)), sizeof(value));
+  EXPECT_NE(AwaitReadiness(map, event_fd, kFdReadinessReadable) &
+                kFdReadinessReadable,
+            0);
+
+  // Clearing a consumed bit arms the slot for the next edge rather than
+  // resurrecting the old one.
+  ClearFdReadiness(map, event_fd, kFdReadinessReadable);
+  ASSERT_EQ(write(event_fd, &value, sizeof(value)), sizeof(value));
+  EXPECT_NE(AwaitReadiness(map, event_fd, kFdReadinessReadable) &
+                kFdReadinessReadable,
+            0);
+
+  // Unsubscribing clears the descriptor's pending bits.
+  EXPECT_EQ(FdReadinessEngine::Unsubscribe(event_fd), 0);
+  EXPECT_EQ(TestFdReadiness(map, event_fd), 0);
+
+  close(event_fd);
+  FdReadinessEngine::Teardown();
+
+  // After teardown a fresh engine can be started.
+  EXPECT_NE(FdReadinessEngine::Setup(), 0);
+  FdReadinessEngine::Teardown();
+}
+
+TEST(FdReadinessEngineTest, RejectsCallsWithoutEngineOrOutOfRangeFds) {
+  EXPECT_EQ(FdReadinessEngine::Subscribe(0), -1);
+  EXPECT_EQ(FdReadinessEngine::Unsubscribe(0), -1);
+
+  // Tearing down without an engine is a no-op.
+  FdReadinessEngine::Teardown();
+
+  ASSERT_NE(FdReadinessEngine::Setup(), 0);
+  EXPECT_EQ(FdReadinessEngine::Subscribe(-1), -1);
+  EXPECT_EQ(
+      FdReadinessEngine::Subscribe(static_cast<int>(kFdReadinessMapSlots)),
+      -1);
+  FdReadinessEngine::Teardown();
+}
+
+}  // namespace
+}  // namespace host_call
+}  // namespace asylo
@@ -0,0 +1,176 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/host_call/untrusted/host_call_completion_queue.h"
+
+#include <cstdlib>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "asylo/platform/primitives/util/status_conversions.h"
+#include "asylo/platform/system_call/untrusted_invoke.h"
+#include "asylo/util/thread.h"
+
+namespace asylo {
+namespace host_call {
+
+HostCallCompletionQueue &HostCallCompletionQueue::GetInstance() {
+  static HostCallCompletionQueue *instance = new HostCallCompletionQueue;
+  return *instance;
+}
+
+uint64_t HostCallCompletionQueue::Submit(primitives::Extent request) {
+  absl::MutexLock lock(&mu_);
+  EnsureWorkersStarted();
+  uint64_t ticket = next_ticket_++;
+  auto operation = absl::make_unique<Operation>();
+  operation->request.assign(request.As<uint8_t>(),
+                            request.As<uint8_t>() + request.size());
+  operations_.emplace(ticket, std::move(operation));
+  pending_.push(ticket);
+  return ticket;
+}
+
+Status HostCallCompletionQueue::Collect(uint64_t ticket, bool wait, bool *ready,
+                                        primitives::Extent *response) {
+  absl::MutexLock lock(&mu_);
+  auto it = operations_.find(ticket);
+  if (it == operations_.end()) {
+    return absl::InvalidArgumentError(
+        "HostCallCompletionQueue::Collect: unknown ticket.");
+  }
+  Operation *operation = it->second.get();
+  if (wait) {
+    mu_.Await(absl::Condition(&operation->done));
+  } else if (!operation->done) {
+    *ready = false;
+    return absl::OkStatus();
+  }
+  *ready = true;
+  primitives::PrimitiveStatus status = operation->status;
+  *response = operation->response;
+  operations_.erase(it);
+  if (!status.ok()) {
+    return primitives::MakeStatus(status);
+  }
+  return absl::OkStatus();
+}
+
+Status HostCallCompletionQueue::CollectWithTimeout(
+    uint64_t ticket, uint64_t timeout_micros, bool *ready,
+    primitives::Extent *response) {
+  absl::MutexLock lock(&mu_);
+  auto it = operations_.find(ticket);
+  if (it == operations_.end()) {
+    return absl::InvalidArgumentError(
+        "HostCallCompletionQueue::CollectWithTimeout: unknown ticket.");
+  }
+  Operation *operation = it->second.get();
+  if (!mu_.AwaitWithTimeout(absl::Condition(&operation->done),
+                            absl::Microseconds(timeout_micros))) {
+    // Deadline passed: abandon the call. Its worker discards the eventual
+    // result and exits; start a replacement so a call wedged in the host
+    // kernel pins only its own thread, not a pool slot. A call no worker has
+    // picked up yet is dropped from the queue when it reaches the front.
+    operation->abandoned = true;
+    if (operation->running) {
+      Thread::StartDetached([this] { WorkerLoop(); });
+    }
+    *ready = false;
+    return absl::OkStatus();
+  }
+  *ready = true;
+  primitives::PrimitiveStatus status = operation->status;
+  *response = operation->response;
+  operations_.erase(it);
+  if (!status.ok()) {
+    return primitives::MakeStatus(status);
+  }
+  return absl::OkStatus();
+}
+
+void HostCallCompletionQueue::EnsureWorkersStarted() {
+  if (workers_started_) {
+    return;
+  }
+  workers_started_ = true;
+  for (size_t i = 0; i < kNumWorkers; ++i) {
+    Thread::StartDetached([this] { WorkerLoop(); });
+  }
+}
+
+bool HostCallCompletionQueue::HasPendingLocked() const {
+  return !pending_.empty();
+}
+
+void HostCallCompletionQueue::WorkerLoop() {
+  while (true) {
+    uint64_t ticket;
+    Operation *operation;
+    {
+      absl::MutexLock lock(&mu_);
+      mu_.Await(
+          absl::Condition(this, &HostCallCompletionQueue::HasPendingLocked));
+      ticket = pending_.front();
+      pending_.pop();
+      auto it = operations_.find(ticket);
+      if (it == operations_.end()) {
+        continue;
+      }
+      operation = it->second.get();
+      if (operation->abandoned) {
+        // Abandoned before execution: nobody will collect it, so do not
+        // bother running the call.
+        operations_.erase(it);
+        continue;
+      }
+      operation->running = true;
+    }
+
+    // The operation stays alive until collected or abandoned; execute the
+    // call without holding the queue lock so a blocking host call occupies
+    // only this worker.
+    primitives::Extent request(operation->request.data(),
+                               operation->request.size());
+    primitives::Extent response;  // Owned here until handed off.
+    primitives::PrimitiveStatus status =
+        system_call::UntrustedInvoke(request, &response);
+
+    {
+      absl::MutexLock lock(&mu_);
+      if (operation->abandoned) {
+        // The collector gave up on this call and started a replacement
+        // worker; discard the result and retire this thread to keep the pool
+        // at its configured size.
+        if (status.ok()) {
+          free(response.data());
+        }
+        operations_.erase(ticket);
+        return;
+      }
+      operation->status = status;
+      operation->response = status.ok() ? response : primitives::Extent{};
+      operation->done = true;
+    }
+  }
+}
+
+}  // namespace host_call
+}  // namespace asylo
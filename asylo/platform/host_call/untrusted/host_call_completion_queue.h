@@ -0,0 +1,110 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_HOST_CALL_COMPLETION_QUEUE_H_
+#define ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_HOST_CALL_COMPLETION_QUEUE_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "asylo/platform/primitives/extent.h"
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+namespace host_call {
+
+// A pool of untrusted worker threads executing serialized system call
+// requests asynchronously. A serialized request is submitted for a ticket,
+// executed on a dedicated worker thread, and its serialized response collected
+// later, so that a blocking host call (poll, accept, a read on a slow file
+// descriptor) does not pin the enclave-entered thread that issued it.
+class HostCallCompletionQueue {
+ public:
+  // Number of worker threads servicing submitted calls. Workers are started
+  // lazily on first submission and live for the lifetime of the process.
+  static constexpr size_t kNumWorkers = 4;
+
+  // Accessor to the singleton instance.
+  static HostCallCompletionQueue &GetInstance();
+
+  HostCallCompletionQueue(const HostCallCompletionQueue &) = delete;
+  HostCallCompletionQueue &operator=(const HostCallCompletionQueue &) = delete;
+
+  // Enqueues a copy of |request| for execution on a worker thread and returns
+  // a ticket identifying the submitted call.
+  uint64_t Submit(primitives::Extent request);
+
+  // Collects the response of a previously submitted call. When |wait| is
+  // true, blocks until the call identified by |ticket| completes. On return
+  // with |*ready| set, |*response| holds the malloc()-allocated serialized
+  // response, owned by the caller, and the ticket is consumed; with |*ready|
+  // unset, the call is still in flight and the ticket remains valid. Returns
+  // a non-ok status if |ticket| is unknown or the call itself failed to
+  // dispatch; a failed ticket is consumed.
+  Status Collect(uint64_t ticket, bool wait, bool *ready,
+                 primitives::Extent *response);
+
+  // Like Collect() with |wait| set, but gives up after |timeout_micros|
+  // microseconds. On return with |*ready| unset, the call has been abandoned
+  // and the ticket consumed: the call keeps executing on its worker thread
+  // and its eventual result is discarded. A worker stuck on an abandoned call
+  // is replaced, so abandoned calls do not shrink the usable pool; a call
+  // abandoned before any worker picked it up is never executed.
+  Status CollectWithTimeout(uint64_t ticket, uint64_t timeout_micros,
+                            bool *ready, primitives::Extent *response);
+
+ private:
+  // A submitted call and its eventual result.
+  struct Operation {
+    std::vector<uint8_t> request;
+    bool running = false;
+    bool abandoned = false;
+    bool done = false;
+    primitives::PrimitiveStatus status;
+    primitives::Extent response;
+  };
+
+  HostCallCompletionQueue() = default;
+
+  // Starts the worker threads if they are not running yet.
+  void EnsureWorkersStarted() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Returns true if a submitted call is waiting for a worker.
+  bool HasPendingLocked() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Worker thread body: executes submitted calls until process exit.
+  void WorkerLoop();
+
+  absl::Mutex mu_;
+  bool workers_started_ ABSL_GUARDED_BY(mu_) = false;
+  uint64_t next_ticket_ ABSL_GUARDED_BY(mu_) = 1;
+  std::queue<uint64_t> pending_ ABSL_GUARDED_BY(mu_);
+  std::map<uint64_t, std::unique_ptr<Operation>> operations_
+      ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace host_call
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_HOST_CALL_COMPLETION_QUEUE_H_
@@ -26,18 +26,30 @@
 #include <pwd.h>
 #include <signal.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <syslog.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <ctime>
+#include <memory>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "asylo/platform/common/memory.h"
+#include "asylo/platform/host_call/exit_handler_constants.h"
+#include "asylo/platform/host_call/recv_buf_ring.h"
 #include "asylo/platform/host_call/serializer_functions.h"
+#include "asylo/platform/host_call/untrusted/epoll_event_engine.h"
+#include "asylo/platform/host_call/untrusted/fd_readiness_engine.h"
+#include "asylo/platform/host_call/untrusted/host_call_completion_queue.h"
+#include "asylo/platform/host_call/untrusted/recv_buf_ring_pool.h"
 #include "asylo/platform/host_call/untrusted/host_call_handlers_util.h"
 #include "asylo/platform/primitives/util/message.h"
 #include "asylo/platform/primitives/util/status_conversions.h"
+#include "asylo/platform/system_call/message.h"
 #include "asylo/platform/system_call/untrusted_invoke.h"
 #include "asylo/util/hex_util.h"
 #include "asylo/util/status_macros.h"
@@ -58,6 +70,28 @@ void untrusted_abort_handler(const char *message) {
 Status SystemCallHandler(const std::shared_ptr<primitives::Client> &client,
                          void *context, primitives::MessageReader *input,
                          primitives::MessageWriter *output) {
+  // Scatter-gather requests carry bulk input parameters as extra extents and
+  // expect a scatter-gather response.
+  if (!input->empty() &&
+      input->peek().size() >= sizeof(system_call::MessageHeader) &&
+      system_call::MessageReader(input->peek()).is_scatter_gather()) {
+    std::vector<Extent> request_extents;
+    while (input->hasNext()) {
+      request_extents.push_back(input->next());
+    }
+    std::vector<Extent> response_extents;  // Each extent owned here.
+    primitives::PrimitiveStatus status =
+        system_call::UntrustedInvoke(request_extents, &response_extents);
+    if (!status.ok()) {
+      return primitives::MakeStatus(status);
+    }
+    for (Extent &response : response_extents) {
+      output->PushByCopy(response);
+      free(response.data());
+    }
+    return Status::OkStatus();
+  }
+
   ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
   auto request = input->next();
 
@@ -73,6 +107,187 @@ Status SystemCallHandler(const std::shared_ptr<primitives::Client> &client,
   return Status::OkStatus();
 }
 
+Status TimedSystemCallHandler(const std::shared_ptr<primitives::Client> &client,
+                              void *context, primitives::MessageReader *input,
+                              primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 2);
+  auto request = input->next();
+  uint64_t timeout_micros = input->next<uint64_t>();
+
+  // Execute on the worker pool so the deadline can be enforced from here:
+  // when the call overruns it, the worker is left to finish (and discard) it
+  // while this exit returns a synthesized failure response.
+  HostCallCompletionQueue &queue = HostCallCompletionQueue::GetInstance();
+  uint64_t ticket = queue.Submit(request);
+  bool ready = false;
+  Extent response;  // To be owned by untrusted call parameters.
+  ASYLO_RETURN_IF_ERROR(
+      queue.CollectWithTimeout(ticket, timeout_micros, &ready, &response));
+  if (!ready) {
+    primitives::PrimitiveStatus status =
+        system_call::SerializeFailureResponse(request, ETIMEDOUT, &response);
+    if (!status.ok()) {
+      return primitives::MakeStatus(status);
+    }
+  }
+  output->PushByCopy(response);
+  free(response.data());
+  return Status::OkStatus();
+}
+
+Status AsyncSystemCallSubmitHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
+  auto request = input->next();
+  output->Push<uint64_t>(
+      HostCallCompletionQueue::GetInstance().Submit(request));
+  return Status::OkStatus();
+}
+
+Status AsyncSystemCallCollectHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 2);
+  auto ticket = input->next<uint64_t>();
+  bool wait = input->next<int>() != 0;
+
+  bool ready = false;
+  Extent response;  // To be owned by untrusted call parameters.
+  ASYLO_RETURN_IF_ERROR(HostCallCompletionQueue::GetInstance().Collect(
+      ticket, wait, &ready, &response));
+  output->Push<int>(ready ? 1 : 0);
+  if (ready) {
+    output->PushByCopy(response);
+    free(response.data());
+  }
+  return Status::OkStatus();
+}
+
+Status EpollEventEngineSetupHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
+  int epfd = input->next<int>();
+  output->Push<uint64_t>(EpollEventEngine::Setup(epfd));
+  return Status::OkStatus();
+}
+
+Status EpollEventEngineWaitHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 2);
+  int epfd = input->next<int>();
+  int timeout_ms = input->next<int>();
+  output->Push<int>(EpollEventEngine::Wait(epfd, timeout_ms));
+  return Status::OkStatus();
+}
+
+Status EpollEventEngineTeardownHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
+  int epfd = input->next<int>();
+  EpollEventEngine::Teardown(epfd);
+  output->Push<int>(0);
+  return Status::OkStatus();
+}
+
+Status FdReadinessSetupHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 0);
+  output->Push<uint64_t>(FdReadinessEngine::Setup());
+  return Status::OkStatus();
+}
+
+Status FdReadinessSubscribeHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
+  int fd = input->next<int>();
+  output->Push<int>(FdReadinessEngine::Subscribe(fd));
+  return Status::OkStatus();
+}
+
+Status FdReadinessUnsubscribeHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
+  int fd = input->next<int>();
+  output->Push<int>(FdReadinessEngine::Unsubscribe(fd));
+  return Status::OkStatus();
+}
+
+Status FdReadinessTeardownHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 0);
+  FdReadinessEngine::Teardown();
+  output->Push<int>(0);
+  return Status::OkStatus();
+}
+
+Status RecvBufRingSetupHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
+  int sockfd = input->next<int>();
+  output->Push<uint64_t>(RecvBufRingPool::Create(sockfd));
+  return Status::OkStatus();
+}
+
+Status RecvBufRingRecvHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 3);
+  int sockfd = input->next<int>();
+  size_t len = input->next<uint64_t>();
+  int klinux_flags = input->next<int>();
+
+  struct sockaddr_storage sock_addr = {};
+  socklen_t sock_len = sizeof(sock_addr);
+
+  RecvBufRing *ring = RecvBufRingPool::Get(sockfd);
+  int slot = ring != nullptr ? ClaimRecvBufSlot(ring) : -1;
+  if (slot < 0) {
+    // No ring or every slot is claimed by an in-flight recv; tell the caller
+    // to fall back to the serializing path.
+    output->Push<int>(0);
+    output->Push<int>(errno);
+    output->Push<int>(-1);
+    output->Push<struct sockaddr_storage>(sock_addr);
+    return Status::OkStatus();
+  }
+
+  ssize_t ret = recvfrom(sockfd, ring->slots[slot],
+                         std::min(len, kRecvBufRingSlotSize), klinux_flags,
+                         reinterpret_cast<struct sockaddr *>(&sock_addr),
+                         &sock_len);
+  if (ret < 0) {
+    ReleaseRecvBufSlot(ring, slot);
+    slot = -1;
+  }
+
+  LOG_IF(FATAL, sock_len > sizeof(sock_addr))
+      << "Insufficient sockaddr buf space encountered for recvfrom host call.";
+
+  output->Push<int>(ret);
+  output->Push<int>(errno);
+  output->Push<int>(slot);
+  output->Push<struct sockaddr_storage>(sock_addr);
+  return Status::OkStatus();
+}
+
+Status RecvBufRingTeardownHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
+  int sockfd = input->next<int>();
+  output->Push<int>(RecvBufRingPool::Destroy(sockfd));
+  return Status::OkStatus();
+}
+
 Status IsAttyHandler(const std::shared_ptr<primitives::Client> &client,
                      void *context, primitives::MessageReader *input,
                      primitives::MessageWriter *output) {
@@ -90,11 +305,7 @@ Status IsAttyHandler(const std::shared_ptr<primitives::Client> &client,
 Status USleepHandler(const std::shared_ptr<primitives::Client> &client,
                      void *context, primitives::MessageReader *input,
                      primitives::MessageWriter *output) {
-  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
-  auto usec = input->next<useconds_t>();
-  output->Push<int>(usleep(usec));  // Push return value first.
-  output->Push<int>(errno);         // Push errno next.
-  return Status::OkStatus();
+  return USleepHelper(input, output);
 }
 
 Status SysconfHandler(const std::shared_ptr<primitives::Client> &client,
@@ -122,40 +333,42 @@ Status ReallocHandler(const std::shared_ptr<primitives::Client> &client,
 Status SleepHandler(const std::shared_ptr<primitives::Client> &client,
                     void *context, primitives::MessageReader *input,
                     primitives::MessageWriter *output) {
-  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
-  auto seconds = input->next<uint32_t>();
-  output->Push<uint32_t>(sleep(seconds));  // Push return value first.
-  output->Push<int>(errno);                // Push errno next.
-  return Status::OkStatus();
+  return SleepHelper(input, output);
 }
 
 Status SendMsgHandler(const std::shared_ptr<primitives::Client> &client,
                       void *context, primitives::MessageReader *input,
                       primitives::MessageWriter *output) {
-  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 6);
+  if (input->size() < 6) {
+    return absl::InvalidArgumentError(
+        "SendMsgHandler: expected at least 6 arguments on the reader.");
+  }
   struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
   int sockfd = input->next<int>();
 
   auto msg_name_extent = input->next();
   msg.msg_name = msg_name_extent.As<char>();
   msg.msg_namelen = msg_name_extent.size();
 
-  auto msg_iov_extent = input->next();
-  // The message is serialized into a single buffer on the trusted side.
-  struct iovec msg_iov[1];
-  memset(msg_iov, 0, sizeof(*msg_iov));
-  msg_iov[0].iov_base = msg_iov_extent.As<char>();
-  msg_iov[0].iov_len = msg_iov_extent.size();
-  msg.msg_iov = msg_iov;
-  msg.msg_iovlen = 1;
-
   auto msg_control_extent = input->next();
   msg.msg_control = msg_control_extent.As<char>();
   msg.msg_controllen = msg_control_extent.size();
 
   msg.msg_flags = input->next<int>();
-
   int flags = input->next<int>();
+
+  // Each remaining extent is one |msg_iov| segment, already resident in
+  // untrusted memory; the iovec entries alias the extents so the host call
+  // gathers them without another copy.
+  std::vector<struct iovec> msg_iov;
+  while (input->hasNext()) {
+    auto segment = input->next();
+    msg_iov.push_back({segment.As<char>(), segment.size()});
+  }
+  msg.msg_iov = msg_iov.data();
+  msg.msg_iovlen = msg_iov.size();
+
   output->Push<int64_t>(sendmsg(sockfd, &msg, flags));  // Push return value.
   output->Push<int>(errno);                             // Push errno.
   return Status::OkStatus();
@@ -164,7 +377,10 @@ Status SendMsgHandler(const std::shared_ptr<primitives::Client> &client,
 Status RecvMsgHandler(const std::shared_ptr<primitives::Client> &client,
                       void *context, primitives::MessageReader *input,
                       primitives::MessageWriter *output) {
-  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 6);
+  if (input->size() < 6) {
+    return absl::InvalidArgumentError(
+        "RecvMsgHandler: expected at least 6 arguments on the reader.");
+  }
   int sockfd = input->next<int>();
 
   // An upper bound of buffer size for name/control to avoid allocating memory
@@ -172,6 +388,7 @@ Status RecvMsgHandler(const std::shared_ptr<primitives::Client> &client,
   constexpr size_t kMaxBufferSize = 1024;
 
   struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
   msg.msg_namelen = input->next<uint64_t>();
   std::unique_ptr<char[]> msg_name_buffer(nullptr);
   if (msg.msg_namelen > 0 && msg.msg_namelen < kMaxBufferSize) {
@@ -181,19 +398,6 @@ Status RecvMsgHandler(const std::shared_ptr<primitives::Client> &client,
   }
   msg.msg_name = msg_name_buffer.get();
 
-  // Receive message in a single buffer, which will be copied into the scattered
-  // buffers once back inside the enclave.
-  msg.msg_iovlen = 1;
-  struct iovec msg_iov[1];
-  memset(msg_iov, 0, sizeof(*msg_iov));
-  msg_iov[0].iov_len = input->next<uint64_t>();
-  std::unique_ptr<char[]> msg_iov_buffer(nullptr);
-  if (msg_iov[0].iov_len > 0) {
-    msg_iov_buffer.reset(new char[msg_iov[0].iov_len]);
-  }
-  msg_iov[0].iov_base = msg_iov_buffer.get();
-  msg.msg_iov = msg_iov;
-
   msg.msg_controllen = input->next<uint64_t>();
   std::unique_ptr<char[]> msg_control_buffer(nullptr);
   if (msg.msg_controllen > 0 && msg.msg_controllen < kMaxBufferSize) {
@@ -206,14 +410,384 @@ Status RecvMsgHandler(const std::shared_ptr<primitives::Client> &client,
   msg.msg_flags = input->next<int>();
   int flags = input->next<int>();
 
-  output->Push<int64_t>(recvmsg(sockfd, &msg, flags));  // Push return value.
-  output->Push<int>(errno);                             // Push errno.
+  // Each remaining value is the length of one |msg_iov| segment; receive into
+  // a matching buffer per segment so the scatter layout is preserved.
+  std::vector<std::unique_ptr<char[]>> segment_buffers;
+  std::vector<struct iovec> msg_iov;
+  while (input->hasNext()) {
+    size_t segment_len = input->next<uint64_t>();
+    segment_buffers.emplace_back(segment_len > 0 ? new char[segment_len]
+                                                 : nullptr);
+    msg_iov.push_back({segment_buffers.back().get(), segment_len});
+  }
+  msg.msg_iov = msg_iov.data();
+  msg.msg_iovlen = msg_iov.size();
+
+  ssize_t result = recvmsg(sockfd, &msg, flags);
+  output->Push<int64_t>(result);  // Push return value.
+  output->Push<int>(errno);       // Push errno.
   output->PushByCopy(Extent{msg.msg_name, msg.msg_namelen});  // Push msg name.
-  output->PushByCopy(Extent{msg.msg_iov[0].iov_base,
-                            msg.msg_iov[0].iov_len});  // Push received msg.
   output->PushByCopy(
       Extent{msg.msg_control, msg.msg_controllen});  // Push control msg.
 
+  // Push each segment trimmed to the bytes recvmsg() actually placed in it;
+  // the message fills the iovec array in order.
+  size_t bytes_left = result > 0 ? result : 0;
+  for (const auto &segment : msg_iov) {
+    size_t filled = std::min(bytes_left, segment.iov_len);
+    output->PushByCopy(Extent{segment.iov_base, filled});
+    bytes_left -= filled;
+  }
+
+  return Status::OkStatus();
+}
+
+Status SendMMsgHandler(const std::shared_ptr<primitives::Client> &client,
+                       void *context, primitives::MessageReader *input,
+                       primitives::MessageWriter *output) {
+  if (input->size() < 3) {
+    return absl::InvalidArgumentError(
+        "SendMMsgHandler: expected at least 3 arguments on the reader.");
+  }
+  int sockfd = input->next<int>();
+  int flags = input->next<int>();
+  uint64_t vlen = input->next<uint64_t>();
+  if (vlen == 0 || vlen > kMaxMmsgBatch) {
+    return absl::InvalidArgumentError(
+        "SendMMsgHandler: message count outside [1, kMaxMmsgBatch].");
+  }
+
+  // Rebuild each message from its framed header and segments. The iovec
+  // entries alias the extents, so every sendmsg() below gathers the enclave's
+  // data without another copy; |msg_iovs| keeps the segment arrays stable.
+  std::vector<struct msghdr> msgs(vlen);
+  std::vector<std::vector<struct iovec>> msg_iovs(vlen);
+  size_t remaining = input->size() - 3;
+  for (uint64_t i = 0; i < vlen; ++i) {
+    if (remaining < 4) {
+      return absl::InvalidArgumentError(
+          "SendMMsgHandler: fewer messages on the reader than |vlen|.");
+    }
+    struct msghdr *msg = &msgs[i];
+    memset(msg, 0, sizeof(*msg));
+
+    uint64_t iovcnt = input->next<uint64_t>();
+    auto msg_name_extent = input->next();
+    msg->msg_name = msg_name_extent.As<char>();
+    msg->msg_namelen = msg_name_extent.size();
+
+    auto msg_control_extent = input->next();
+    msg->msg_control = msg_control_extent.As<char>();
+    msg->msg_controllen = msg_control_extent.size();
+
+    msg->msg_flags = input->next<int>();
+    remaining -= 4;
+
+    if (remaining < iovcnt) {
+      return absl::InvalidArgumentError(
+          "SendMMsgHandler: fewer segments on the reader than |iovcnt|.");
+    }
+    for (uint64_t j = 0; j < iovcnt; ++j) {
+      auto segment = input->next();
+      msg_iovs[i].push_back({segment.As<char>(), segment.size()});
+    }
+    remaining -= iovcnt;
+    msg->msg_iov = msg_iovs[i].data();
+    msg->msg_iovlen = msg_iovs[i].size();
+  }
+
+  // One sendmsg() per message, stopping at the first failure like sendmmsg(2).
+  // The caller paid a single enclave exit for the whole batch; the native
+  // syscalls issued here are cheap by comparison.
+  std::vector<uint64_t> bytes_sent;
+  int saved_errno = 0;
+  for (uint64_t i = 0; i < vlen; ++i) {
+    ssize_t nbytes = sendmsg(sockfd, &msgs[i], flags);
+    if (nbytes == -1) {
+      saved_errno = errno;
+      break;
+    }
+    bytes_sent.push_back(nbytes);
+  }
+
+  if (bytes_sent.empty()) {
+    output->Push<int64_t>(-1);           // Push return value.
+    output->Push<int>(saved_errno);      // Push errno.
+    return Status::OkStatus();
+  }
+  output->Push<int64_t>(bytes_sent.size());  // Push messages sent.
+  output->Push<int>(0);                      // Push errno.
+  for (uint64_t nbytes : bytes_sent) {
+    output->Push<uint64_t>(nbytes);  // Push bytes sent per message.
+  }
+  return Status::OkStatus();
+}
+
+Status RecvMMsgHandler(const std::shared_ptr<primitives::Client> &client,
+                       void *context, primitives::MessageReader *input,
+                       primitives::MessageWriter *output) {
+  if (input->size() < 3) {
+    return absl::InvalidArgumentError(
+        "RecvMMsgHandler: expected at least 3 arguments on the reader.");
+  }
+  int sockfd = input->next<int>();
+  int flags = input->next<int>();
+  uint64_t vlen = input->next<uint64_t>();
+  if (vlen == 0 || vlen > kMaxMmsgBatch) {
+    return absl::InvalidArgumentError(
+        "RecvMMsgHandler: message count outside [1, kMaxMmsgBatch].");
+  }
+
+  // An upper bound of buffer size for name/control to avoid allocating memory
+  // for a non-initialized random size.
+  constexpr size_t kMaxBufferSize = 1024;
+
+  // Allocate a receive layout per message mirroring RecvMsgHandler; the
+  // buffers live in the vectors so their addresses stay stable while later
+  // messages are parsed.
+  std::vector<struct msghdr> msgs(vlen);
+  std::vector<std::unique_ptr<char[]>> name_buffers(vlen);
+  std::vector<std::unique_ptr<char[]>> control_buffers(vlen);
+  std::vector<std::vector<std::unique_ptr<char[]>>> segment_buffers(vlen);
+  std::vector<std::vector<struct iovec>> msg_iovs(vlen);
+  size_t remaining = input->size() - 3;
+  for (uint64_t i = 0; i < vlen; ++i) {
+    if (remaining < 3) {
+      return absl::InvalidArgumentError(
+          "RecvMMsgHandler: fewer messages on the reader than |vlen|.");
+    }
+    struct msghdr *msg = &msgs[i];
+    memset(msg, 0, sizeof(*msg));
+
+    msg->msg_namelen = input->next<uint64_t>();
+    if (msg->msg_namelen > 0 && msg->msg_namelen < kMaxBufferSize) {
+      name_buffers[i].reset(new char[msg->msg_namelen]);
+    } else {
+      msg->msg_namelen = 0;
+    }
+    msg->msg_name = name_buffers[i].get();
+
+    msg->msg_controllen = input->next<uint64_t>();
+    if (msg->msg_controllen > 0 && msg->msg_controllen < kMaxBufferSize) {
+      control_buffers[i].reset(new char[msg->msg_controllen]);
+    } else {
+      msg->msg_controllen = 0;
+    }
+    msg->msg_control = control_buffers[i].get();
+
+    uint64_t iovcnt = input->next<uint64_t>();
+    remaining -= 3;
+    if (remaining < iovcnt) {
+      return absl::InvalidArgumentError(
+          "RecvMMsgHandler: fewer segment lengths on the reader than "
+          "|iovcnt|.");
+    }
+    for (uint64_t j = 0; j < iovcnt; ++j) {
+      size_t segment_len = input->next<uint64_t>();
+      segment_buffers[i].emplace_back(segment_len > 0 ? new char[segment_len]
+                                                      : nullptr);
+      msg_iovs[i].push_back({segment_buffers[i].back().get(), segment_len});
+    }
+    remaining -= iovcnt;
+    msg->msg_iov = msg_iovs[i].data();
+    msg->msg_iovlen = msg_iovs[i].size();
+  }
+
+  // Block (per |flags|) only for the first message, then drain whatever else
+  // is already queued with MSG_DONTWAIT, so one enclave exit collects every
+  // pending datagram without stalling on an empty socket.
+  std::vector<ssize_t> bytes_received;
+  int saved_errno = 0;
+  for (uint64_t i = 0; i < vlen; ++i) {
+    int msg_flags = i == 0 ? flags : flags | MSG_DONTWAIT;
+    ssize_t nbytes = recvmsg(sockfd, &msgs[i], msg_flags);
+    if (nbytes == -1) {
+      saved_errno = errno;
+      break;
+    }
+    bytes_received.push_back(nbytes);
+  }
+
+  if (bytes_received.empty()) {
+    output->Push<int64_t>(-1);           // Push return value.
+    output->Push<int>(saved_errno);      // Push errno.
+    return Status::OkStatus();
+  }
+  output->Push<int64_t>(bytes_received.size());  // Push messages received.
+  output->Push<int>(0);                          // Push errno.
+  for (size_t i = 0; i < bytes_received.size(); ++i) {
+    const struct msghdr &msg = msgs[i];
+    output->PushByCopy(Extent{msg.msg_name, msg.msg_namelen});
+    output->PushByCopy(Extent{msg.msg_control, msg.msg_controllen});
+    output->Push<int>(msg.msg_flags);
+
+    // Push each segment trimmed to the bytes recvmsg() actually placed in it;
+    // the message fills the iovec array in order.
+    size_t bytes_left = bytes_received[i];
+    for (const auto &segment : msg_iovs[i]) {
+      size_t filled = std::min(bytes_left, segment.iov_len);
+      output->PushByCopy(Extent{segment.iov_base, filled});
+      bytes_left -= filled;
+    }
+  }
+  return Status::OkStatus();
+}
+
+Status WritevHandler(const std::shared_ptr<primitives::Client> &client,
+                     void *context, primitives::MessageReader *input,
+                     primitives::MessageWriter *output) {
+  if (input->size() < 2) {
+    return absl::InvalidArgumentError(
+        "WritevHandler: expected at least 2 arguments on the reader.");
+  }
+  int fd = input->next<int>();
+
+  // Each remaining extent is one iovec segment; the iovec entries alias the
+  // extents so writev() gathers them without another copy.
+  std::vector<struct iovec> iov;
+  while (input->hasNext()) {
+    auto segment = input->next();
+    iov.push_back({segment.As<char>(), segment.size()});
+  }
+
+  output->Push<int64_t>(writev(fd, iov.data(), iov.size()));  // Return value.
+  output->Push<int>(errno);                                   // Push errno.
+  return Status::OkStatus();
+}
+
+Status ReadvHandler(const std::shared_ptr<primitives::Client> &client,
+                    void *context, primitives::MessageReader *input,
+                    primitives::MessageWriter *output) {
+  if (input->size() < 2) {
+    return absl::InvalidArgumentError(
+        "ReadvHandler: expected at least 2 arguments on the reader.");
+  }
+  int fd = input->next<int>();
+
+  // Each remaining value is the length of one iovec segment; read into a
+  // matching buffer per segment so the scatter layout is preserved.
+  std::vector<std::unique_ptr<char[]>> segment_buffers;
+  std::vector<struct iovec> iov;
+  while (input->hasNext()) {
+    size_t segment_len = input->next<uint64_t>();
+    segment_buffers.emplace_back(segment_len > 0 ? new char[segment_len]
+                                                 : nullptr);
+    iov.push_back({segment_buffers.back().get(), segment_len});
+  }
+
+  ssize_t result = readv(fd, iov.data(), iov.size());
+  output->Push<int64_t>(result);  // Push return value.
+  output->Push<int>(errno);       // Push errno.
+
+  // Push each segment trimmed to the bytes readv() actually placed in it.
+  size_t bytes_left = result > 0 ? result : 0;
+  for (const auto &segment : iov) {
+    size_t filled = std::min(bytes_left, segment.iov_len);
+    output->PushByCopy(Extent{segment.iov_base, filled});
+    bytes_left -= filled;
+  }
+
+  return Status::OkStatus();
+}
+
+Status PWritevHandler(const std::shared_ptr<primitives::Client> &client,
+                      void *context, primitives::MessageReader *input,
+                      primitives::MessageWriter *output) {
+  if (input->size() < 3) {
+    return absl::InvalidArgumentError(
+        "PWritevHandler: expected at least 3 arguments on the reader.");
+  }
+  int fd = input->next<int>();
+  off_t offset = input->next<uint64_t>();
+
+  // As in WritevHandler, the iovec entries alias the extents so pwritev()
+  // gathers them without another copy.
+  std::vector<struct iovec> iov;
+  while (input->hasNext()) {
+    auto segment = input->next();
+    iov.push_back({segment.As<char>(), segment.size()});
+  }
+
+  output->Push<int64_t>(
+      pwritev(fd, iov.data(), iov.size(), offset));  // Return value.
+  output->Push<int>(errno);                          // Push errno.
+  return Status::OkStatus();
+}
+
+Status PReadvHandler(const std::shared_ptr<primitives::Client> &client,
+                     void *context, primitives::MessageReader *input,
+                     primitives::MessageWriter *output) {
+  if (input->size() < 3) {
+    return absl::InvalidArgumentError(
+        "PReadvHandler: expected at least 3 arguments on the reader.");
+  }
+  int fd = input->next<int>();
+  off_t offset = input->next<uint64_t>();
+
+  std::vector<std::unique_ptr<char[]>> segment_buffers;
+  std::vector<struct iovec> iov;
+  while (input->hasNext()) {
+    size_t segment_len = input->next<uint64_t>();
+    segment_buffers.emplace_back(segment_len > 0 ? new char[segment_len]
+                                                 : nullptr);
+    iov.push_back({segment_buffers.back().get(), segment_len});
+  }
+
+  ssize_t result = preadv(fd, iov.data(), iov.size(), offset);
+  output->Push<int64_t>(result);  // Push return value.
+  output->Push<int>(errno);       // Push errno.
+
+  size_t bytes_left = result > 0 ? result : 0;
+  for (const auto &segment : iov) {
+    size_t filled = std::min(bytes_left, segment.iov_len);
+    output->PushByCopy(Extent{segment.iov_base, filled});
+    bytes_left -= filled;
+  }
+
+  return Status::OkStatus();
+}
+
+Status PIoSubmitHandler(const std::shared_ptr<primitives::Client> &client,
+                        void *context, primitives::MessageReader *input,
+                        primitives::MessageWriter *output) {
+  if (input->size() < 1) {
+    return absl::InvalidArgumentError(
+        "PIoSubmitHandler: expected at least 1 argument on the reader.");
+  }
+  uint64_t op_count = input->next<uint64_t>();
+  if (op_count < 1 || op_count > kMaxPIoBatch) {
+    return absl::InvalidArgumentError(
+        "PIoSubmitHandler: operation count outside [1, kMaxPIoBatch].");
+  }
+
+  size_t remaining = input->size() - 1;
+  for (uint64_t i = 0; i < op_count; ++i) {
+    if (remaining < 4) {
+      return absl::InvalidArgumentError(
+          "PIoSubmitHandler: fewer operations on the reader than |op_count|.");
+    }
+    remaining -= 4;
+    int fd = input->next<int>();
+    int is_write = input->next<int>();
+    off_t offset = input->next<uint64_t>();
+
+    if (is_write) {
+      auto segment = input->next();
+      output->Push<int64_t>(
+          pwrite(fd, segment.As<char>(), segment.size(), offset));
+      output->Push<int>(errno);
+    } else {
+      size_t count = input->next<uint64_t>();
+      std::unique_ptr<char[]> buffer(count > 0 ? new char[count] : nullptr);
+      ssize_t result = pread(fd, buffer.get(), count, offset);
+      output->Push<int64_t>(result);
+      output->Push<int>(errno);
+      // Always push the read segment - empty on failure - so the trusted
+      // side's framing stays aligned with its operation list.
+      output->PushByCopy(
+          Extent{buffer.get(), result > 0 ? static_cast<size_t>(result) : 0});
+    }
+  }
   return Status::OkStatus();
 }
 
@@ -377,43 +951,13 @@ Status GetAddrInfoHandler(const std::shared_ptr<primitives::Client> &client,
 Status InetPtonHandler(const std::shared_ptr<primitives::Client> &client,
                        void *context, primitives::MessageReader *input,
                        primitives::MessageWriter *output) {
-  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 2);
-  int klinux_af = input->next<int>();
-  auto src_buffer = input->next();
-
-  size_t dst_len = 0;
-  if (klinux_af == AF_INET) {
-    dst_len = sizeof(struct in_addr);
-  } else if (klinux_af == AF_INET6) {
-    dst_len = sizeof(struct in6_addr);
-  } else {
-    return {absl::StatusCode::kInvalidArgument,
-            "InetPtonHandler: Unrecognized af_family encountered."};
-  }
-  auto dst = absl::make_unique<char[]>(dst_len);
-  output->Push<int>(inet_pton(klinux_af, src_buffer.As<char>(),
-                              reinterpret_cast<void *>(dst.get())));
-  output->Push<int>(errno);
-  output->PushByCopy(Extent{dst.get(), dst_len});
-
-  return Status::OkStatus();
+  return InetPtonHelper(input, output);
 }
 
 Status InetNtopHandler(const std::shared_ptr<primitives::Client> &client,
                        void *context, primitives::MessageReader *input,
                        primitives::MessageWriter *output) {
-  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 3);
-  int klinux_af = input->next<int>();
-  auto src_buffer = input->next();
-  auto size = input->next<socklen_t>();
-
-  auto dst = absl::make_unique<char[]>(size);
-  inet_ntop(klinux_af, src_buffer.data(), dst.get(), size);
-
-  output->PushByCopy(Extent{dst.get(), size});
-  output->Push<int>(errno);
-
-  return Status::OkStatus();
+  return InetNtopHelper(input, output);
 }
 
 Status SigprocmaskHandler(const std::shared_ptr<primitives::Client> &client,
@@ -579,6 +1123,12 @@ Status SysFutexWakeHandler(const std::shared_ptr<primitives::Client> &client,
   return SysFutexWakeHelper(input, output);
 }
 
+Status SysFutexRequeueHandler(const std::shared_ptr<primitives::Client> &client,
+                              void *context, primitives::MessageReader *input,
+                              primitives::MessageWriter *output) {
+  return SysFutexRequeueHelper(input, output);
+}
+
 Status LocalLifetimeAllocHandler(
     const std::shared_ptr<primitives::Client> &client, void *context,
     primitives::MessageReader *input, primitives::MessageWriter *output) {
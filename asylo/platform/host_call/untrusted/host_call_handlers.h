@@ -37,6 +37,101 @@ Status SystemCallHandler(const std::shared_ptr<primitives::Client> &client,
                          void *context, primitives::MessageReader *input,
                          primitives::MessageWriter *output);
 
+// Deadline-bounded variant of |SystemCallHandler|; expects [Extent request,
+// uint64_t timeout_micros] and always returns [Extent /*response*/] on the
+// MessageWriter. The call executes on the worker pool; when it does not
+// complete within the timeout it is abandoned there and the returned response
+// reports -1/ETIMEDOUT, so the enclave thread's exit is bounded even when the
+// host call hangs.
+Status TimedSystemCallHandler(const std::shared_ptr<primitives::Client> &client,
+                              void *context, primitives::MessageReader *input,
+                              primitives::MessageWriter *output);
+
+// Submits a serialized system call request for asynchronous completion on the
+// worker pool; expects [Extent request] and returns [uint64_t /*ticket*/] on
+// the MessageWriter. The call executes on a dedicated untrusted thread and its
+// response is retrieved with |AsyncSystemCallCollectHandler|.
+Status AsyncSystemCallSubmitHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Collects the response of a system call previously submitted for asynchronous
+// completion; expects [uint64_t ticket, int wait] and returns [int /*ready*/]
+// followed, when ready, by [Extent /*response*/] on the MessageWriter.
+Status AsyncSystemCallCollectHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Starts an untrusted epoll event engine for a host epoll file descriptor;
+// expects [int epfd] and returns [uint64_t /*ring address*/] on the
+// MessageWriter, 0 if the engine could not be started.
+Status EpollEventEngineSetupHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Blocks until the completion ring of the epoll event engine for a host epoll
+// file descriptor holds a record, the engine shuts down, or the timeout
+// elapses; expects [int epfd, int timeout_ms] and returns [int /*result*/] on
+// the MessageWriter, -1 if no engine is running for the descriptor.
+Status EpollEventEngineWaitHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Stops the epoll event engine for a host epoll file descriptor; expects
+// [int epfd] and returns [int /*result*/] on the MessageWriter.
+Status EpollEventEngineTeardownHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Starts the process-wide untrusted fd readiness engine; expects no arguments
+// and returns [uint64_t /*map address*/] on the MessageWriter, 0 if the
+// engine could not be started. Idempotent while the engine is running.
+Status FdReadinessSetupHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Subscribes a host file descriptor to the fd readiness engine; expects
+// [int fd] and returns [int /*result*/] on the MessageWriter.
+Status FdReadinessSubscribeHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Removes a host file descriptor from the fd readiness engine's watch set;
+// expects [int fd] and returns [int /*result*/] on the MessageWriter.
+Status FdReadinessUnsubscribeHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Stops the fd readiness engine; expects no arguments and returns
+// [int /*result*/] on the MessageWriter.
+Status FdReadinessTeardownHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Pins a receive buffer ring to a host socket; expects [int sockfd] and
+// returns [uint64_t /*ring address*/] on the MessageWriter, 0 on allocation
+// failure. Idempotent while the socket keeps its ring.
+Status RecvBufRingSetupHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Receives into a slot of the ring pinned to a host socket; expects
+// [int sockfd, uint64_t len, int klinux_flags] and returns
+// [int /*result*/, int /*errno*/, int /*slot index*/,
+// struct sockaddr_storage] on the MessageWriter. A slot index of -1 with a
+// zero result means no ring or no free slot; the caller should fall back to
+// the serializing recv path. On success the payload is in the indexed slot
+// of the ring and the caller releases the slot when done with it.
+Status RecvBufRingRecvHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
+// Unpins and frees the receive buffer ring of a host socket; expects
+// [int sockfd] and returns [int /*result*/] on the MessageWriter.
+Status RecvBufRingTeardownHandler(
+    const std::shared_ptr<primitives::Client> &client, void *context,
+    primitives::MessageReader *input, primitives::MessageWriter *output);
+
 // isatty library call handler on the host; expects [int fd] and returns [int].
 Status IsAttyHandler(const std::shared_ptr<primitives::Client> &client,
                      void *context, primitives::MessageReader *input,
@@ -66,18 +161,97 @@ Status SleepHandler(const std::shared_ptr<primitives::Client> &client,
                     void *context, primitives::MessageReader *input,
                     primitives::MessageWriter *output);
 
-// sendmsg syscall handler on the host; expects [int sockfd, const struct msghdr
-// *msg, int flags] and returns [ssize_t].
+// sendmsg syscall handler on the host; expects [int sockfd, Extent msg_name,
+// Extent msg_control, int msg_flags, int flags, Extent...] where the trailing
+// extents are the |msg_iov| segments, passed through to the host sendmsg()
+// without flattening. Returns [ssize_t /*result*/, int /*errno*/] on the
+// MessageWriter.
 Status SendMsgHandler(const std::shared_ptr<primitives::Client> &client,
                       void *context, primitives::MessageReader *input,
                       primitives::MessageWriter *output);
 
-// recvmsg syscall handler on the host; expects [int sockfd, struct msghdr *msg,
-// int flags] and returns [ssize_t].
+// recvmsg syscall handler on the host; expects [int sockfd, uint64_t namelen,
+// uint64_t controllen, int msg_flags, int flags, uint64_t...] where the
+// trailing values are the |msg_iov| segment lengths. Returns [ssize_t
+// /*result*/, int /*errno*/, Extent /*msg_name*/, Extent /*msg_control*/,
+// Extent...] on the MessageWriter, one trailing extent per segment trimmed to
+// the bytes received into it.
 Status RecvMsgHandler(const std::shared_ptr<primitives::Client> &client,
                       void *context, primitives::MessageReader *input,
                       primitives::MessageWriter *output);
 
+// writev syscall handler on the host; expects [int fd, Extent...] where the
+// trailing extents are the iovec segments, written natively with writev().
+// Returns [ssize_t /*result*/, int /*errno*/] on the MessageWriter.
+Status WritevHandler(const std::shared_ptr<primitives::Client> &client,
+                     void *context, primitives::MessageReader *input,
+                     primitives::MessageWriter *output);
+
+// readv syscall handler on the host; expects [int fd, uint64_t...] where the
+// trailing values are the iovec segment lengths. Returns [ssize_t /*result*/,
+// int /*errno*/, Extent...] on the MessageWriter, one extent per segment
+// trimmed to the bytes read into it.
+Status ReadvHandler(const std::shared_ptr<primitives::Client> &client,
+                    void *context, primitives::MessageReader *input,
+                    primitives::MessageWriter *output);
+
+// pwritev syscall handler on the host; expects [int fd, uint64_t offset,
+// Extent...] where the trailing extents are the iovec segments, written
+// natively with pwritev() so the fd's file offset is left untouched. Returns
+// [ssize_t /*result*/, int /*errno*/] on the MessageWriter.
+Status PWritevHandler(const std::shared_ptr<primitives::Client> &client,
+                      void *context, primitives::MessageReader *input,
+                      primitives::MessageWriter *output);
+
+// preadv syscall handler on the host; expects [int fd, uint64_t offset,
+// uint64_t...] where the trailing values are the iovec segment lengths.
+// Returns [ssize_t /*result*/, int /*errno*/, Extent...] on the
+// MessageWriter, one extent per segment trimmed to the bytes read into it.
+Status PReadvHandler(const std::shared_ptr<primitives::Client> &client,
+                     void *context, primitives::MessageReader *input,
+                     primitives::MessageWriter *output);
+
+// Batched positional I/O handler on the host; expects [uint64_t op_count]
+// followed, for each operation, by [int fd, int is_write, uint64_t offset,
+// ...] where a write carries its data as one Extent and a read carries its
+// length as one uint64_t. Performs each operation with pwrite()/pread() - the
+// per-syscall cost is small next to the enclave exit the batch saves - and a
+// failed operation does not stop the rest. Returns, for each operation,
+// [ssize_t /*result*/, int /*errno*/] followed for reads by one Extent
+// trimmed to the bytes read (empty on failure). At most |kMaxPIoBatch|
+// operations are accepted per call.
+Status PIoSubmitHandler(const std::shared_ptr<primitives::Client> &client,
+                        void *context, primitives::MessageReader *input,
+                        primitives::MessageWriter *output);
+
+// Batched sendmsg handler on the host; expects [int sockfd, int flags,
+// uint64_t vlen] followed, for each of the |vlen| messages, by [uint64_t
+// iovcnt, Extent msg_name, Extent msg_control, int msg_flags, Extent...]
+// where the trailing extents are that message's |msg_iov| segments. Sends the
+// messages in order with one sendmsg() each, stopping at the first failure
+// like sendmmsg(2), so the enclave pays a single exit for the whole batch.
+// Returns [int64_t /*messages sent*/, int /*errno*/, uint64_t...] on the
+// MessageWriter, one trailing value per sent message holding the bytes
+// transmitted for it. At most |kMaxMmsgBatch| messages are accepted per call.
+Status SendMMsgHandler(const std::shared_ptr<primitives::Client> &client,
+                       void *context, primitives::MessageReader *input,
+                       primitives::MessageWriter *output);
+
+// Batched recvmsg handler on the host; expects [int sockfd, int flags,
+// uint64_t vlen] followed, for each of the |vlen| messages, by [uint64_t
+// namelen, uint64_t controllen, uint64_t iovcnt, uint64_t...] where the
+// trailing values are that message's |msg_iov| segment lengths. Receives up to
+// |vlen| messages, blocking (per |flags|) only for the first and draining the
+// rest with MSG_DONTWAIT, so one enclave exit collects every queued datagram.
+// Returns [int64_t /*messages received*/, int /*errno*/, ...] on the
+// MessageWriter followed, for each received message, by [Extent msg_name,
+// Extent msg_control, int msg_flags, Extent...] with one trailing extent per
+// segment trimmed to the bytes received into it. At most |kMaxMmsgBatch|
+// messages are accepted per call.
+Status RecvMMsgHandler(const std::shared_ptr<primitives::Client> &client,
+                       void *context, primitives::MessageReader *input,
+                       primitives::MessageWriter *output);
+
 // getsockname syscall handler on the host; expects [int sockfd] and returns
 // [int /*result*/, int /*errno*/, sockaddr] on the MessageWriter.
 Status GetSocknameHandler(const std::shared_ptr<primitives::Client> &client,
@@ -229,6 +403,13 @@ Status SysFutexWakeHandler(const std::shared_ptr<primitives::Client> &client,
                            void *context, primitives::MessageReader *input,
                            primitives::MessageWriter *output);
 
+// Handler for host call enc_untrusted_sys_futex_requeue(). Expects [int32_t
+// *futex, int32_t num_wake, int32_t num_move, int32_t *requeue_futex] and
+// returns [int result, int errno] on the MessageWriter.
+Status SysFutexRequeueHandler(const std::shared_ptr<primitives::Client> &client,
+                              void *context, primitives::MessageReader *input,
+                              primitives::MessageWriter *output);
+
 // Handler for host call helper LocalLifetimeAlloc. Expects [size_t
 // bytes] and returns [uintptr_t result, int errno] on the
 // MessageWriter.
@@ -25,11 +25,39 @@
 
 namespace asylo {
 namespace host_call {
+namespace {
+
+// Plain-function trampolines for the hottest host calls, registered on the
+// direct-dispatch fast path. The wrapped handlers use neither the client nor
+// the context argument, so the trampolines pass null for both.
+#define ASYLO_DIRECT_HOST_CALL(handler)                                   \
+  Status Direct##handler(primitives::MessageReader *input,                \
+                         primitives::MessageWriter *output) {             \
+    return handler(/*client=*/nullptr, /*context=*/nullptr, input,        \
+                   output);                                               \
+  }
+
+ASYLO_DIRECT_HOST_CALL(SystemCallHandler)
+ASYLO_DIRECT_HOST_CALL(SendMsgHandler)
+ASYLO_DIRECT_HOST_CALL(RecvMsgHandler)
+ASYLO_DIRECT_HOST_CALL(RecvFromHandler)
+ASYLO_DIRECT_HOST_CALL(ClockGettimeHandler)
+ASYLO_DIRECT_HOST_CALL(SysFutexWaitHandler)
+ASYLO_DIRECT_HOST_CALL(SysFutexWakeHandler)
+ASYLO_DIRECT_HOST_CALL(SysFutexRequeueHandler)
+ASYLO_DIRECT_HOST_CALL(WritevHandler)
+ASYLO_DIRECT_HOST_CALL(ReadvHandler)
+ASYLO_DIRECT_HOST_CALL(PWritevHandler)
+ASYLO_DIRECT_HOST_CALL(PReadvHandler)
+
+#undef ASYLO_DIRECT_HOST_CALL
+
+}  // namespace
 
 Status AddHostCallHandlersToExitCallProvider(
     primitives::Client::ExitCallProvider *exit_call_provider) {
-  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
-      kSystemCallHandler, primitives::ExitHandler{SystemCallHandler}));
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kSystemCallHandler, DirectSystemCallHandler));
 
   ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
       kIsAttyHandler, primitives::ExitHandler{IsAttyHandler}));
@@ -46,11 +74,11 @@ Status AddHostCallHandlersToExitCallProvider(
   ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
       kSleepHandler, primitives::ExitHandler{SleepHandler}));
 
-  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
-      kSendMsgHandler, primitives::ExitHandler{SendMsgHandler}));
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kSendMsgHandler, DirectSendMsgHandler));
 
-  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
-      kRecvMsgHandler, primitives::ExitHandler{RecvMsgHandler}));
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kRecvMsgHandler, DirectRecvMsgHandler));
 
   ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
       kGetSocknameHandler, primitives::ExitHandler{GetSocknameHandler}));
@@ -61,8 +89,8 @@ Status AddHostCallHandlersToExitCallProvider(
   ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
       kGetPeernameHandler, primitives::ExitHandler{GetPeernameHandler}));
 
-  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
-      kRecvFromHandler, primitives::ExitHandler{RecvFromHandler}));
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kRecvFromHandler, DirectRecvFromHandler));
 
   ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
       kRaiseHandler, primitives::ExitHandler{RaiseHandler}));
@@ -106,18 +134,93 @@ Status AddHostCallHandlersToExitCallProvider(
   ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
       kInotifyReadHandler, primitives::ExitHandler{InotifyReadHandler}));
 
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kClockGettimeHandler, DirectClockGettimeHandler));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kSysFutexWaitHandler, DirectSysFutexWaitHandler));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kSysFutexWakeHandler, DirectSysFutexWakeHandler));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kSysFutexRequeueHandler, DirectSysFutexRequeueHandler));
+
   ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
-      kClockGettimeHandler, primitives::ExitHandler{ClockGettimeHandler}));
+      kLocalLifetimeAllocHandler,
+      primitives::ExitHandler{LocalLifetimeAllocHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kWritevHandler, DirectWritevHandler));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kReadvHandler, DirectReadvHandler));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kPWritevHandler, DirectPWritevHandler));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterDirectExitHandler(
+      kPReadvHandler, DirectPReadvHandler));
 
   ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
-      kSysFutexWaitHandler, primitives::ExitHandler{SysFutexWaitHandler}));
+      kPIoSubmitHandler, primitives::ExitHandler{PIoSubmitHandler}));
 
   ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
-      kSysFutexWakeHandler, primitives::ExitHandler{SysFutexWakeHandler}));
+      kSendMMsgHandler, primitives::ExitHandler{SendMMsgHandler}));
 
   ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
-      kLocalLifetimeAllocHandler,
-      primitives::ExitHandler{LocalLifetimeAllocHandler}));
+      kRecvMMsgHandler, primitives::ExitHandler{RecvMMsgHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kTimedSystemCallHandler,
+      primitives::ExitHandler{TimedSystemCallHandler}));
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kAsyncSystemCallSubmitHandler,
+      primitives::ExitHandler{AsyncSystemCallSubmitHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kAsyncSystemCallCollectHandler,
+      primitives::ExitHandler{AsyncSystemCallCollectHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kEpollEventEngineSetupHandler,
+      primitives::ExitHandler{EpollEventEngineSetupHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kEpollEventEngineWaitHandler,
+      primitives::ExitHandler{EpollEventEngineWaitHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kEpollEventEngineTeardownHandler,
+      primitives::ExitHandler{EpollEventEngineTeardownHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kFdReadinessSetupHandler,
+      primitives::ExitHandler{FdReadinessSetupHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kFdReadinessSubscribeHandler,
+      primitives::ExitHandler{FdReadinessSubscribeHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kFdReadinessUnsubscribeHandler,
+      primitives::ExitHandler{FdReadinessUnsubscribeHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kFdReadinessTeardownHandler,
+      primitives::ExitHandler{FdReadinessTeardownHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kRecvBufRingSetupHandler,
+      primitives::ExitHandler{RecvBufRingSetupHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kRecvBufRingRecvHandler,
+      primitives::ExitHandler{RecvBufRingRecvHandler}));
+
+  ASYLO_RETURN_IF_ERROR(exit_call_provider->RegisterExitHandler(
+      kRecvBufRingTeardownHandler,
+      primitives::ExitHandler{RecvBufRingTeardownHandler}));
 
   return Status::OkStatus();
 }
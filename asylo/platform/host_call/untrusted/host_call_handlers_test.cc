@@ -18,7 +18,10 @@
 
 #include "asylo/platform/host_call/untrusted/host_call_handlers.h"
 
+#include <errno.h>
 #include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
 
 #include <functional>
 
@@ -135,6 +138,77 @@ TEST(HostCallHandlersTest, SyscallHandlerInvalidRequestTest) {
   EXPECT_THAT(output, IsEmpty());
 }
 
+// Invokes the timed syscall handler with the wrong number of input items and
+// checks that the request is rejected before any call is submitted.
+TEST(HostCallHandlersTest, TimedSyscallHandlerIncorrectSizeTest) {
+  MessageReader input;
+  MessageWriter output;
+  EXPECT_THAT(TimedSystemCallHandler(nullptr, nullptr, &input, &output),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       "2 item(s) expected on the MessageReader."));
+}
+
+// Invokes a host call through the timed handler with a deadline it easily
+// meets, and verifies that the regular response comes back.
+TEST(HostCallHandlersTest, TimedSyscallHandlerCompletesWithinDeadlineTest) {
+  std::array<uint64_t, system_call::kParameterMax> request_params;
+  primitives::Extent request;  // To be allocated by Serialize.
+  ASYLO_ASSERT_OK(primitives::MakeStatus(
+      system_call::SerializeRequest(SYS_getpid, request_params, &request)));
+  MessageReader input;
+  FillInput(
+      [&request](MessageWriter *params) {
+        params->PushByCopy(request);
+        params->Push<uint64_t>(10000000);  // 10s deadline.
+        free(request.data());
+      },
+      &input);
+  MessageWriter output;
+  ASSERT_THAT(TimedSystemCallHandler(nullptr, nullptr, &input, &output),
+              StatusIs(absl::StatusCode::kOk));
+  ASSERT_THAT(output, SizeIs(1));
+  VerifyOutput(
+      [](MessageReader *results) {
+        system_call::MessageReader response(results->next());
+        ASYLO_EXPECT_OK(primitives::MakeStatus(response.Validate()));
+        EXPECT_EQ(response.header()->result, getpid());
+      },
+      &output);
+}
+
+// Invokes a host call that outlives its deadline through the timed handler,
+// and verifies that a response reporting ETIMEDOUT comes back instead of the
+// handler blocking for the duration of the call.
+TEST(HostCallHandlersTest, TimedSyscallHandlerTimesOutTest) {
+  struct timespec duration = {2, 0};  // Sleeps well past the deadline.
+  std::array<uint64_t, system_call::kParameterMax> request_params;
+  request_params[0] = reinterpret_cast<uint64_t>(&duration);
+  request_params[1] = 0;
+  primitives::Extent request;  // To be allocated by Serialize.
+  ASYLO_ASSERT_OK(primitives::MakeStatus(
+      system_call::SerializeRequest(SYS_nanosleep, request_params, &request)));
+  MessageReader input;
+  FillInput(
+      [&request](MessageWriter *params) {
+        params->PushByCopy(request);
+        params->Push<uint64_t>(100000);  // 100ms deadline.
+        free(request.data());
+      },
+      &input);
+  MessageWriter output;
+  ASSERT_THAT(TimedSystemCallHandler(nullptr, nullptr, &input, &output),
+              StatusIs(absl::StatusCode::kOk));
+  ASSERT_THAT(output, SizeIs(1));
+  VerifyOutput(
+      [](MessageReader *results) {
+        system_call::MessageReader response(results->next());
+        ASYLO_EXPECT_OK(primitives::MakeStatus(response.Validate()));
+        EXPECT_EQ(response.header()->result, static_cast<uint64_t>(-1));
+        EXPECT_EQ(response.header()->error_number, ETIMEDOUT);
+      },
+      &output);
+}
+
 // Invokes an IsAtty hostcall for an invalid request. It tests that the correct
 // error is returned for an empty input or for an input with more than one item.
 TEST(HostCallHandlersTest, IsAttyIncorrectSizeTest) {
@@ -18,11 +18,19 @@
 
 #include "asylo/platform/host_call/untrusted/host_call_handlers_util.h"
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
 #include "asylo/platform/common/futex.h"
 
 namespace asylo {
 namespace host_call {
 
+using primitives::Extent;
+
 Status SysFutexWaitHelper(primitives::MessageReader *input,
                           primitives::MessageWriter *output) {
   ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 3);
@@ -45,5 +53,76 @@ Status SysFutexWakeHelper(primitives::MessageReader *input,
   return Status::OkStatus();
 }
 
+Status SysFutexRequeueHelper(primitives::MessageReader *input,
+                             primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 4);
+  int32_t *futex = input->next<int32_t *>();
+  int32_t num_wake = input->next<int32_t>();
+  int32_t num_move = input->next<int32_t>();
+  int32_t *requeue_futex = input->next<int32_t *>();
+  output->Push<int>(
+      sys_futex_requeue(futex, num_wake, num_move, requeue_futex));
+  output->Push<int>(errno);
+  return Status::OkStatus();
+}
+
+Status USleepHelper(primitives::MessageReader *input,
+                    primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
+  auto usec = input->next<useconds_t>();
+  output->Push<int>(usleep(usec));  // Push return value first.
+  output->Push<int>(errno);         // Push errno next.
+  return Status::OkStatus();
+}
+
+Status SleepHelper(primitives::MessageReader *input,
+                   primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 1);
+  auto seconds = input->next<uint32_t>();
+  output->Push<uint32_t>(sleep(seconds));  // Push return value first.
+  output->Push<int>(errno);                // Push errno next.
+  return Status::OkStatus();
+}
+
+Status InetPtonHelper(primitives::MessageReader *input,
+                      primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 2);
+  int klinux_af = input->next<int>();
+  auto src_buffer = input->next();
+
+  size_t dst_len = 0;
+  if (klinux_af == AF_INET) {
+    dst_len = sizeof(struct in_addr);
+  } else if (klinux_af == AF_INET6) {
+    dst_len = sizeof(struct in6_addr);
+  } else {
+    return {absl::StatusCode::kInvalidArgument,
+            "InetPtonHelper: Unrecognized af_family encountered."};
+  }
+  auto dst = absl::make_unique<char[]>(dst_len);
+  output->Push<int>(inet_pton(klinux_af, src_buffer.As<char>(),
+                              reinterpret_cast<void *>(dst.get())));
+  output->Push<int>(errno);
+  output->PushByCopy(Extent{dst.get(), dst_len});
+
+  return Status::OkStatus();
+}
+
+Status InetNtopHelper(primitives::MessageReader *input,
+                      primitives::MessageWriter *output) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*input, 3);
+  int klinux_af = input->next<int>();
+  auto src_buffer = input->next();
+  auto size = input->next<socklen_t>();
+
+  auto dst = absl::make_unique<char[]>(size);
+  inet_ntop(klinux_af, src_buffer.data(), dst.get(), size);
+
+  output->PushByCopy(Extent{dst.get(), size});
+  output->Push<int>(errno);
+
+  return Status::OkStatus();
+}
+
 }  // namespace host_call
 }  // namespace asylo
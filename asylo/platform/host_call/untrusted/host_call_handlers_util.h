@@ -29,6 +29,16 @@ Status SysFutexWaitHelper(primitives::MessageReader *input,
                           primitives::MessageWriter *output);
 Status SysFutexWakeHelper(primitives::MessageReader *input,
                           primitives::MessageWriter *output);
+Status SysFutexRequeueHelper(primitives::MessageReader *input,
+                             primitives::MessageWriter *output);
+Status USleepHelper(primitives::MessageReader *input,
+                    primitives::MessageWriter *output);
+Status SleepHelper(primitives::MessageReader *input,
+                   primitives::MessageWriter *output);
+Status InetPtonHelper(primitives::MessageReader *input,
+                      primitives::MessageWriter *output);
+Status InetNtopHelper(primitives::MessageReader *input,
+                      primitives::MessageWriter *output);
 
 }  // namespace host_call
 }  // namespace asylo
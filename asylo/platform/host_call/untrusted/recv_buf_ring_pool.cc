@@ -0,0 +1,67 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/host_call/untrusted/recv_buf_ring_pool.h"
+
+#include <unordered_map>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+
+namespace asylo {
+namespace host_call {
+namespace {
+
+// Guards the ring registry.
+absl::Mutex *PoolLock() {
+  static absl::Mutex *lock = new absl::Mutex();
+  return lock;
+}
+
+// Registry of rings by host socket file descriptor.
+std::unordered_map<int, std::unique_ptr<RecvBufRing>> *Rings() {
+  static auto *rings = new std::unordered_map<int, std::unique_ptr<RecvBufRing>>;
+  return rings;
+}
+
+}  // namespace
+
+uint64_t RecvBufRingPool::Create(int sockfd) {
+  absl::MutexLock lock(PoolLock());
+  auto *rings = Rings();
+  auto it = rings->find(sockfd);
+  if (it == rings->end()) {
+    it = rings->emplace(sockfd, absl::make_unique<RecvBufRing>()).first;
+  }
+  return reinterpret_cast<uint64_t>(it->second.get());
+}
+
+RecvBufRing *RecvBufRingPool::Get(int sockfd) {
+  absl::MutexLock lock(PoolLock());
+  auto *rings = Rings();
+  auto it = rings->find(sockfd);
+  return it != rings->end() ? it->second.get() : nullptr;
+}
+
+int RecvBufRingPool::Destroy(int sockfd) {
+  absl::MutexLock lock(PoolLock());
+  return Rings()->erase(sockfd) != 0 ? 0 : -1;
+}
+
+}  // namespace host_call
+}  // namespace asylo
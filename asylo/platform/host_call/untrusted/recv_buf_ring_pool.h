@@ -0,0 +1,56 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_RECV_BUF_RING_POOL_H_
+#define ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_RECV_BUF_RING_POOL_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "asylo/platform/host_call/recv_buf_ring.h"
+
+namespace asylo {
+namespace host_call {
+
+// The untrusted registry of per-socket receive buffer rings. A ring stays
+// pinned to its socket from Create() until Destroy(), so the recv handlers
+// can receive into its slots across calls without reallocating untrusted
+// scratch.
+class RecvBufRingPool {
+ public:
+  // Creates a ring for host socket |sockfd| if it does not have one and
+  // returns the untrusted address of its ring, or 0 on allocation failure.
+  // Idempotent: a socket that already has a ring keeps it.
+  static uint64_t Create(int sockfd);
+
+  // Returns the ring pinned to |sockfd|, or nullptr if it has none. The ring
+  // stays valid until Destroy(), which callers must not race with recvs on
+  // the same socket.
+  static RecvBufRing *Get(int sockfd);
+
+  // Unpins and frees the ring of |sockfd|. Returns 0 on success or -1 if the
+  // socket has no ring.
+  static int Destroy(int sockfd);
+
+  RecvBufRingPool() = delete;
+};
+
+}  // namespace host_call
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_HOST_CALL_UNTRUSTED_RECV_BUF_RING_POOL_H_
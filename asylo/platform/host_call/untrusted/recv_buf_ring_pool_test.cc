@@ -0,0 +1,75 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/host_call/untrusted/recv_buf_ring_pool.h"
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+#include "asylo/platform/host_call/recv_buf_ring.h"
+
+namespace asylo {
+namespace host_call {
+namespace {
+
+TEST(RecvBufRingPoolTest, CreateIsIdempotentPerSocket) {
+  uint64_t ring_address = RecvBufRingPool::Create(3);
+  ASSERT_NE(ring_address, 0);
+  EXPECT_EQ(RecvBufRingPool::Create(3), ring_address);
+
+  auto *ring = reinterpret_cast<RecvBufRing *>(ring_address);
+  EXPECT_EQ(ring->InstanceVersion(), RecvBufRing::TypeVersion());
+  EXPECT_EQ(RecvBufRingPool::Get(3), ring);
+
+  // A different socket gets its own ring.
+  uint64_t other_address = RecvBufRingPool::Create(4);
+  ASSERT_NE(other_address, 0);
+  EXPECT_NE(other_address, ring_address);
+
+  EXPECT_EQ(RecvBufRingPool::Destroy(3), 0);
+  EXPECT_EQ(RecvBufRingPool::Destroy(4), 0);
+  EXPECT_EQ(RecvBufRingPool::Get(3), nullptr);
+  EXPECT_EQ(RecvBufRingPool::Destroy(3), -1);
+}
+
+TEST(RecvBufRingPoolTest, SlotsClaimExclusivelyAndRecycle) {
+  uint64_t ring_address = RecvBufRingPool::Create(5);
+  ASSERT_NE(ring_address, 0);
+  auto *ring = reinterpret_cast<RecvBufRing *>(ring_address);
+
+  // Every slot can be claimed exactly once.
+  bool claimed[kRecvBufRingSlots] = {};
+  for (size_t i = 0; i < kRecvBufRingSlots; ++i) {
+    int slot = ClaimRecvBufSlot(ring);
+    ASSERT_GE(slot, 0);
+    ASSERT_LT(static_cast<size_t>(slot), kRecvBufRingSlots);
+    EXPECT_FALSE(claimed[slot]);
+    claimed[slot] = true;
+  }
+  EXPECT_EQ(ClaimRecvBufSlot(ring), -1);
+
+  // A released slot becomes claimable again.
+  ReleaseRecvBufSlot(ring, 2);
+  EXPECT_EQ(ClaimRecvBufSlot(ring), 2);
+
+  EXPECT_EQ(RecvBufRingPool::Destroy(5), 0);
+}
+
+}  // namespace
+}  // namespace host_call
+}  // namespace asylo
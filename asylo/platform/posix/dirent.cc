@@ -17,32 +17,352 @@
  */
 
 #include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+
+#include "asylo/platform/common/perf_counters.h"
+#include "asylo/platform/host_call/trusted/host_calls.h"
+#include "asylo/platform/posix/dirent_prefetch.h"
+
+namespace {
+
+// One record as returned by the host getdents64 system call. The name field
+// extends to d_reclen bytes from the start of the record.
+struct KLinuxDirent64 {
+  uint64_t d_ino;
+  int64_t d_off;
+  uint16_t d_reclen;
+  uint8_t d_type;
+  char d_name[1];
+};
+
+constexpr size_t kKLinuxDirent64HeaderSize = offsetof(KLinuxDirent64, d_name);
+
+// Size of the per-directory batch buffer filled by one getdents64 host call.
+// Large enough that even sizable directories are consumed in a few exits.
+constexpr size_t kDirentBufferSize = 64 * 1024;
+
+// In-enclave state backing a DIR handle. DIR is treated as an opaque pointer
+// to this structure.
+struct EnclaveDir {
+  // Host file descriptor of the open directory. Not registered with the IO
+  // manager; the handle is never exposed as an enclave file descriptor.
+  int host_fd;
+
+  // Batch buffer of raw host records, refilled one host call at a time, or
+  // the prefetch arena holding the remainder of the directory when
+  // |prefetched| is set.
+  char *records;
+  size_t capacity;
+  size_t length;  // Bytes of validated records in |records|.
+  size_t pos;     // Offset of the next unconsumed record.
+  bool prefetched;
+  bool end_of_directory;
+
+  // Directory stream position reported by telldir(): the host d_off of the
+  // last record handed out, designating its successor.
+  int64_t tell_off;
+
+  // Storage returned by readdir(); overwritten by each call.
+  struct dirent entry;
+};
+
+// Counters exposed on the enclave performance counter page. Dividing entries
+// by exits gives the achieved entries-per-exit batching factor.
+asylo::PerfCounter ReaddirExitsCounter() {
+  static asylo::PerfCounter counter =
+      asylo::PerfCounterRegistry::GetInstance()->Register(
+          "posix.readdir.exits");
+  return counter;
+}
+
+asylo::PerfCounter ReaddirEntriesCounter() {
+  static asylo::PerfCounter counter =
+      asylo::PerfCounterRegistry::GetInstance()->Register(
+          "posix.readdir.entries");
+  return counter;
+}
+
+// Validates |length| bytes of host-written getdents64 records in |records|
+// and counts them. The host is untrusted: reject records that are truncated,
+// overrun the buffer, or lack a name terminator, so iteration can trust
+// d_reclen afterwards. Returns false on malformed input.
+bool ValidateRecords(const char *records, size_t length, uint64_t *count) {
+  size_t pos = 0;
+  uint64_t entries = 0;
+  while (pos < length) {
+    if (length - pos < kKLinuxDirent64HeaderSize) {
+      return false;
+    }
+    const KLinuxDirent64 *record =
+        reinterpret_cast<const KLinuxDirent64 *>(records + pos);
+    if (record->d_reclen < kKLinuxDirent64HeaderSize + 1 ||
+        record->d_reclen > length - pos) {
+      return false;
+    }
+    const size_t name_capacity = record->d_reclen - kKLinuxDirent64HeaderSize;
+    if (strnlen(record->d_name, name_capacity) == name_capacity) {
+      return false;
+    }
+    pos += record->d_reclen;
+    entries++;
+  }
+  *count = entries;
+  return true;
+}
+
+// Refills the batch buffer with one getdents64 host call, validating and
+// counting the returned records. Returns the byte count read, 0 at end of
+// directory, or -1 with errno set.
+int FillRecords(EnclaveDir *dir) {
+  int bytes =
+      enc_untrusted_getdents64(dir->host_fd, dir->records, dir->capacity);
+  if (bytes < 0) {
+    return -1;
+  }
+  uint64_t entries = 0;
+  if (!ValidateRecords(dir->records, bytes, &entries)) {
+    errno = EIO;
+    return -1;
+  }
+  dir->pos = 0;
+  dir->length = bytes;
+  if (bytes == 0) {
+    dir->end_of_directory = true;
+  }
+  ReaddirExitsCounter().Increment();
+  ReaddirEntriesCounter().IncrementBy(entries);
+  return bytes;
+}
+
+// Copies the record at |dir->pos| into |entry| and advances past it.
+// Over-long names are truncated to the dirent name capacity.
+struct dirent *ConsumeRecord(EnclaveDir *dir, struct dirent *entry) {
+  const KLinuxDirent64 *record =
+      reinterpret_cast<const KLinuxDirent64 *>(dir->records + dir->pos);
+  dir->pos += record->d_reclen;
+  dir->tell_off = record->d_off;
+
+  entry->d_ino = record->d_ino;
+  entry->d_off = record->d_off;
+  entry->d_reclen = sizeof(struct dirent);
+  entry->d_type = record->d_type;
+  strncpy(entry->d_name, record->d_name, sizeof(entry->d_name) - 1);
+  entry->d_name[sizeof(entry->d_name) - 1] = '\0';
+  return entry;
+}
+
+// Returns the next entry of |dir| in |entry|, refilling the batch buffer as
+// needed, or nullptr at end of directory or on error (with errno set).
+struct dirent *NextEntry(EnclaveDir *dir, struct dirent *entry) {
+  if (dir->pos >= dir->length) {
+    if (dir->prefetched || dir->end_of_directory) {
+      return nullptr;
+    }
+    if (FillRecords(dir) <= 0) {
+      return nullptr;
+    }
+  }
+  return ConsumeRecord(dir, entry);
+}
+
+// Drops a prefetch arena, restoring the regular batch buffer. The host
+// directory offset is unaffected: prefetching already advanced it to the end.
+bool DropPrefetch(EnclaveDir *dir) {
+  char *buffer = static_cast<char *>(malloc(kDirentBufferSize));
+  if (!buffer) {
+    errno = ENOMEM;
+    return false;
+  }
+  free(dir->records);
+  dir->records = buffer;
+  dir->capacity = kDirentBufferSize;
+  dir->length = 0;
+  dir->pos = 0;
+  dir->prefetched = false;
+  dir->end_of_directory = false;
+  return true;
+}
+
+}  // namespace
 
 extern "C" {
 
-int getdents (int fd, void *dirp, unsigned int count) {
+int getdents(int fd, void *dirp, unsigned int count) {
   abort();
 }
 
-int __attribute__((weak)) closedir(DIR *) { abort(); }
+DIR *__attribute__((weak)) opendir(const char *name) {
+  int host_fd = enc_untrusted_open(name, O_RDONLY | O_CLOEXEC);
+  if (host_fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (enc_untrusted_fstat(host_fd, &st) < 0) {
+    enc_untrusted_close(host_fd);
+    return nullptr;
+  }
+  if (!S_ISDIR(st.st_mode)) {
+    enc_untrusted_close(host_fd);
+    errno = ENOTDIR;
+    return nullptr;
+  }
 
-DIR * __attribute__((weak)) opendir(const char *) { abort(); }
+  EnclaveDir *dir = static_cast<EnclaveDir *>(calloc(1, sizeof(EnclaveDir)));
+  char *buffer = static_cast<char *>(malloc(kDirentBufferSize));
+  if (!dir || !buffer) {
+    free(dir);
+    free(buffer);
+    enc_untrusted_close(host_fd);
+    errno = ENOMEM;
+    return nullptr;
+  }
+  dir->host_fd = host_fd;
+  dir->records = buffer;
+  dir->capacity = kDirentBufferSize;
+  return reinterpret_cast<DIR *>(dir);
+}
 
-struct dirent * __attribute__((weak)) readdir(DIR *) {
-  abort();
+int __attribute__((weak)) closedir(DIR *dirp) {
+  if (!dirp) {
+    errno = EBADF;
+    return -1;
+  }
+  EnclaveDir *dir = reinterpret_cast<EnclaveDir *>(dirp);
+  int result = enc_untrusted_close(dir->host_fd);
+  free(dir->records);
+  free(dir);
+  return result;
 }
 
-int __attribute__((weak)) readdir_r(DIR *, struct dirent *, struct dirent **) {
-  abort();
+struct dirent *__attribute__((weak)) readdir(DIR *dirp) {
+  if (!dirp) {
+    errno = EBADF;
+    return nullptr;
+  }
+  EnclaveDir *dir = reinterpret_cast<EnclaveDir *>(dirp);
+  return NextEntry(dir, &dir->entry);
 }
 
-void __attribute__((weak)) rewinddir(DIR *) { abort(); }
+int __attribute__((weak)) readdir_r(DIR *dirp, struct dirent *entry,
+                                    struct dirent **result) {
+  if (!dirp) {
+    return EBADF;
+  }
+  EnclaveDir *dir = reinterpret_cast<EnclaveDir *>(dirp);
+  errno = 0;
+  *result = NextEntry(dir, entry);
+  return (!*result && errno != 0) ? errno : 0;
+}
 
-void __attribute__((weak)) seekdir(DIR *, int64_t) { abort(); }
+void __attribute__((weak)) rewinddir(DIR *dirp) {
+  if (!dirp) {
+    return;
+  }
+  EnclaveDir *dir = reinterpret_cast<EnclaveDir *>(dirp);
+  dir->pos = 0;
+  dir->tell_off = 0;
+  if (dir->prefetched) {
+    // The whole directory is already in the arena; restart on it in-enclave.
+    return;
+  }
+  dir->length = 0;
+  dir->end_of_directory = false;
+  enc_untrusted_lseek(dir->host_fd, 0, SEEK_SET);
+}
+
+void __attribute__((weak)) seekdir(DIR *dirp, int64_t loc) {
+  if (!dirp) {
+    return;
+  }
+  EnclaveDir *dir = reinterpret_cast<EnclaveDir *>(dirp);
+  if (dir->prefetched && !DropPrefetch(dir)) {
+    return;
+  }
+  dir->length = 0;
+  dir->pos = 0;
+  dir->end_of_directory = false;
+  dir->tell_off = loc;
+  enc_untrusted_lseek(dir->host_fd, loc, SEEK_SET);
+}
+
+int64_t __attribute__((weak)) telldir(DIR *dirp) {
+  if (!dirp) {
+    errno = EBADF;
+    return -1;
+  }
+  return reinterpret_cast<EnclaveDir *>(dirp)->tell_off;
+}
 
-int64_t __attribute__((weak)) telldir(DIR *) { abort(); }
+int enc_prefetch_directory(DIR *dirp) {
+  if (!dirp) {
+    errno = EBADF;
+    return -1;
+  }
+  EnclaveDir *dir = reinterpret_cast<EnclaveDir *>(dirp);
+  if (dir->prefetched) {
+    return 0;
+  }
+
+  // Move unconsumed records from the batch buffer into a growing arena, then
+  // append the remainder of the directory in full-buffer host calls.
+  size_t arena_capacity = kDirentBufferSize;
+  size_t arena_length = dir->length - dir->pos;
+  while (arena_capacity < arena_length + kDirentBufferSize) {
+    arena_capacity *= 2;
+  }
+  char *arena = static_cast<char *>(malloc(arena_capacity));
+  if (!arena) {
+    errno = ENOMEM;
+    return -1;
+  }
+  memcpy(arena, dir->records + dir->pos, arena_length);
+
+  while (!dir->end_of_directory) {
+    if (arena_capacity - arena_length < kDirentBufferSize) {
+      char *grown = static_cast<char *>(realloc(arena, arena_capacity * 2));
+      if (!grown) {
+        free(arena);
+        errno = ENOMEM;
+        return -1;
+      }
+      arena = grown;
+      arena_capacity *= 2;
+    }
+    int bytes = enc_untrusted_getdents64(dir->host_fd, arena + arena_length,
+                                         kDirentBufferSize);
+    if (bytes < 0) {
+      free(arena);
+      return -1;
+    }
+    if (bytes == 0) {
+      dir->end_of_directory = true;
+      break;
+    }
+    uint64_t entries = 0;
+    if (!ValidateRecords(arena + arena_length, bytes, &entries)) {
+      free(arena);
+      errno = EIO;
+      return -1;
+    }
+    arena_length += bytes;
+    ReaddirExitsCounter().Increment();
+    ReaddirEntriesCounter().IncrementBy(entries);
+  }
+
+  free(dir->records);
+  dir->records = arena;
+  dir->capacity = arena_capacity;
+  dir->length = arena_length;
+  dir->pos = 0;
+  dir->prefetched = true;
+  return 0;
+}
 
 }  // extern "C"
@@ -0,0 +1,45 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_POSIX_DIRENT_PREFETCH_H_
+#define ASYLO_PLATFORM_POSIX_DIRENT_PREFETCH_H_
+
+#include <dirent.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Reads all remaining entries of |dirp| from the host into an in-enclave
+// arena in large batches, so that subsequent readdir() calls iterate the
+// arena without further enclave exits. An Asylo extension for code that
+// scans large directories: a directory of thousands of entries is consumed
+// in a handful of exits instead of one exit per buffer refill.
+//
+// Entries already consumed before the call are not re-read; rewinddir()
+// restarts iteration over the prefetched entries without touching the host.
+// seekdir() discards the prefetched entries and resumes host-backed
+// iteration. Returns 0 on success or -1 with errno set, in which case |dirp|
+// remains usable for regular iteration.
+int enc_prefetch_directory(DIR *dirp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ASYLO_PLATFORM_POSIX_DIRENT_PREFETCH_H_
@@ -26,6 +26,7 @@
 
 #define O_CLOEXEC 0x10000
 #define O_DIRECT 0x20000
+#define O_READAHEAD 0x20000000
 #define O_SECURE 0x40000000
 
 #endif  // ASYLO_PLATFORM_POSIX_INCLUDE_FCNTL_H_
@@ -60,7 +60,9 @@ int sched_getaffinity(pid_t pid, size_t cpusetsize, cpu_set_t *mask);
 
 int sched_setaffinity(pid_t pid, size_t cpusetsize, const cpu_set_t *cpuset);
 
-// Implemented as call to host sched_yield().
+// Yields cooperatively inside the enclave while other enclave threads are
+// runnable, and escalates to the host sched_yield() after a budget of
+// in-enclave yields.
 int sched_yield(void);
 
 int sched_getcpu(void);
@@ -23,9 +23,25 @@
 
 #include "absl/memory/memory.h"
 #include "asylo/platform/host_call/trusted/host_calls.h"
+#include "asylo/platform/primitives/trusted_primitives.h"
+#include "asylo/platform/primitives/trusted_runtime.h"
+#include "asylo/platform/system_call/type_conversions/types_functions.h"
 
 namespace asylo {
 namespace io {
+namespace {
+
+// Sentinel return value of EngineEpollWait() indicating that the event engine
+// shut down and the caller should fall back to exit-based waits.
+constexpr int kEngineDetached = -2;
+
+// Number of enc_pause() iterations spent spinning on an empty completion ring
+// before parking the wait on the untrusted side. Under load the poller
+// deposits the next record within the spin window and the wait completes
+// without an enclave exit.
+constexpr int kEngineSpinCount = 1000;
+
+}  // namespace
 
 int IOContextEpoll::EpollCtl(int op, int hostfd, struct epoll_event *event) {
   struct epoll_event event_copy;
@@ -69,6 +85,22 @@ int IOContextEpoll::EpollCtl(int op, int hostfd, struct epoll_event *event) {
 
 int IOContextEpoll::EpollWait(struct epoll_event *events, int maxevents,
                               int timeout) {
+  host_call::EpollEventRing *ring = GetCompletionRing();
+  if (ring != nullptr) {
+    int result = EngineEpollWait(ring, events, maxevents, timeout);
+    if (result != kEngineDetached) {
+      return result;
+    }
+    // The engine shut down; detach from its ring and fall back to exit-based
+    // waits for the rest of this context's lifetime.
+    absl::MutexLock lock(&ring_lock_);
+    completion_ring_ = nullptr;
+  }
+  return HostEpollWait(events, maxevents, timeout);
+}
+
+int IOContextEpoll::HostEpollWait(struct epoll_event *events, int maxevents,
+                                  int timeout) {
   int ret = enc_untrusted_epoll_wait(host_fd_, events, maxevents, timeout);
   if (ret == -1) {
     // errno is set in enc_untrusted_epoll_wait.
@@ -87,6 +119,88 @@ int IOContextEpoll::EpollWait(struct epoll_event *events, int maxevents,
   return ret;
 }
 
+host_call::EpollEventRing *IOContextEpoll::GetCompletionRing() {
+  absl::MutexLock lock(&ring_lock_);
+  if (!engine_checked_) {
+    engine_checked_ = true;
+    uint64_t ring_address = enc_untrusted_epoll_engine_setup(host_fd_);
+    auto *ring = reinterpret_cast<host_call::EpollEventRing *>(ring_address);
+    // The ring address is untrusted input: only accept a ring lying entirely
+    // outside the enclave whose layout matches the expected type.
+    if (ring != nullptr &&
+        primitives::TrustedPrimitives::IsOutsideEnclave(ring, sizeof(*ring)) &&
+        ring->InstanceVersion() == host_call::EpollEventRing::TypeVersion()) {
+      engine_attached_ = true;
+      completion_ring_ = ring;
+    } else if (ring != nullptr) {
+      enc_untrusted_epoll_engine_teardown(host_fd_);
+    }
+  }
+  return completion_ring_;
+}
+
+int IOContextEpoll::EngineEpollWait(host_call::EpollEventRing *ring,
+                                    struct epoll_event *events, int maxevents,
+                                    int timeout) {
+  if (maxevents <= 0) {
+    errno = EINVAL;
+    return -1;
+  }
+  int count = DrainCompletionRing(ring, events, maxevents);
+  if (count != 0 || timeout == 0) {
+    return count;
+  }
+  while (true) {
+    for (int i = 0; i < kEngineSpinCount && ring->empty() &&
+                    !ring->is_closed_for_write();
+         ++i) {
+      enc_pause();
+    }
+    if (ring->empty() && !ring->is_closed_for_write()) {
+      enc_untrusted_epoll_engine_wait(host_fd_, timeout);
+    }
+    count = DrainCompletionRing(ring, events, maxevents);
+    if (count != 0) {
+      return count;
+    }
+    if (ring->is_closed_for_write()) {
+      return kEngineDetached;
+    }
+    if (timeout > 0) {
+      // The untrusted wait bounded the full timeout; report no events ready.
+      return 0;
+    }
+  }
+}
+
+int IOContextEpoll::DrainCompletionRing(host_call::EpollEventRing *ring,
+                                        struct epoll_event *events,
+                                        int maxevents) {
+  absl::MutexLock lock(&ring_lock_);
+  int count = 0;
+  host_call::EpollEventRecord record;
+  while (count < maxevents &&
+         host_call::DequeueEpollEventRecord(ring, &record)) {
+    struct klinux_epoll_event klinux_event;
+    klinux_event.events = record.events;
+    klinux_event.data.u64 = record.data;
+    if (!FromkLinuxEpollEvent(&klinux_event, &events[count])) {
+      errno = EBADE;
+      return -1;
+    }
+    // Translate the random bits in the data field back to the original data
+    // using the key_to_data map. Records whose key is no longer registered
+    // were deposited before an EPOLL_CTL_DEL and are dropped.
+    auto it = key_to_data.find(events[count].data.u64);
+    if (it == key_to_data.end()) {
+      continue;
+    }
+    events[count].data.u64 = it->second;
+    ++count;
+  }
+  return count;
+}
+
 int IOContextEpoll::GetHostFileDescriptor() { return host_fd_; }
 
 // Read and Write should never be called on an epoll fd.
@@ -100,7 +214,19 @@ ssize_t IOContextEpoll::Write(const void *buf, size_t count) {
   return -1;
 }
 
-int IOContextEpoll::Close() { return enc_untrusted_close(host_fd_); }
+int IOContextEpoll::Close() {
+  bool engine_attached;
+  {
+    absl::MutexLock lock(&ring_lock_);
+    engine_attached = engine_attached_;
+    engine_attached_ = false;
+    completion_ring_ = nullptr;
+  }
+  if (engine_attached) {
+    enc_untrusted_epoll_engine_teardown(host_fd_);
+  }
+  return enc_untrusted_close(host_fd_);
+}
 
 }  // namespace io
 }  // namespace asylo
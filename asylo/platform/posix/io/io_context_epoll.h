@@ -21,6 +21,9 @@
 
 #include <unordered_map>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "asylo/platform/host_call/epoll_event_ring.h"
 #include "asylo/platform/posix/io/io_manager.h"
 
 namespace asylo {
@@ -40,12 +43,46 @@ class IOContextEpoll : public IOManager::IOContext {
   int Close();
 
  private:
+  // Lazily attaches the untrusted epoll event engine for this epoll instance
+  // and returns its completion ring, or nullptr if the engine is unavailable.
+  // The returned ring lies in untrusted memory; its records are untrusted
+  // input.
+  host_call::EpollEventRing *GetCompletionRing();
+
+  // Performs EpollWait() against the engine's completion ring without an
+  // enclave exit per wait. Returns the number of events written to |events|,
+  // 0 on timeout, -1 with errno set on error, or kEngineDetached (declared in
+  // the translation unit) if the engine shut down and the caller should fall
+  // back to exit-based waits.
+  int EngineEpollWait(host_call::EpollEventRing *ring,
+                      struct epoll_event *events, int maxevents, int timeout);
+
+  // Drains up to |maxevents| completion records from |ring| into |events|,
+  // translating engine keys back to registered user data. Returns the number
+  // of events written, 0 if the ring holds no records, or -1 with errno set.
+  int DrainCompletionRing(host_call::EpollEventRing *ring,
+                          struct epoll_event *events, int maxevents);
+
+  // Performs EpollWait() with one enclave exit per wait; used when no event
+  // engine is available.
+  int HostEpollWait(struct epoll_event *events, int maxevents, int timeout);
+
   // Host file descriptor implementing this stream.
   int host_fd_;
   std::unordered_map<uint64_t, uint64_t> key_to_data;
   // Manages a mapping from the host file descriptor to a random key to enable
   // updates to the above map durring deletions/modifications.
   std::unordered_map<int, uint64_t> fd_to_key;
+
+  // Serializes engine attachment and ring draining; the completion ring
+  // supports only a single reader.
+  absl::Mutex ring_lock_;
+  bool engine_checked_ ABSL_GUARDED_BY(ring_lock_) = false;
+  // True while an untrusted engine exists for this epoll instance; it must be
+  // torn down on Close() even after the trusted side detaches from its ring.
+  bool engine_attached_ ABSL_GUARDED_BY(ring_lock_) = false;
+  host_call::EpollEventRing *completion_ring_ ABSL_GUARDED_BY(ring_lock_) =
+      nullptr;
 };
 
 }  // namespace io
@@ -23,26 +23,73 @@ constexpr ssize_t kCounterBufSize = sizeof(uint64_t);
 namespace asylo {
 namespace io {
 
+bool IOContextEventFd::TryClaim(uint64_t *value) {
+  uint64_t current = counter_.load();
+  while (current > 0) {
+    const uint64_t desired = semaphore_ ? current - 1 : 0;
+    if (counter_.compare_exchange_weak(current, desired)) {
+      *value = semaphore_ ? 1 : current;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IOContextEventFd::TryAdd(uint64_t add) {
+  uint64_t current = counter_.load();
+  while (add <= kMaxCounter - current) {
+    if (counter_.compare_exchange_weak(current, current + add)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void IOContextEventFd::WakeWaiters() {
+  if (waiters_.load() == 0) {
+    return;
+  }
+
+  // Acquiring and releasing the mutex forces the Await() conditions of
+  // blocked callers to be re-evaluated.
+  absl::MutexLock counter_mutex_lock(&counter_mutex_);
+}
+
 ssize_t IOContextEventFd::Read(void *buf, size_t count) {
   if (count < kCounterBufSize) {
     errno = EINVAL;
     return -1;
   }
-  absl::MutexLock counter_mutex_lock(&counter_mutex_);
-  if (nonblock_ && (counter_ == 0)) {
+
+  // Fast path: claim a value with a lock-free update. This is the common case
+  // for producer/consumer signalling, where the counter is usually non-zero
+  // by the time the consumer reads.
+  uint64_t value;
+  if (TryClaim(&value)) {
+    *reinterpret_cast<uint64_t *>(buf) = value;
+    WakeWaiters();
+    return kCounterBufSize;
+  }
+
+  if (nonblock_) {
     errno = EAGAIN;
     return -1;
-  } else {
-    auto ready = [this]() { return counter_ > 0; };
-    counter_mutex_.Await(absl::Condition(&ready));
-  }
-  if (semaphore_) {
-    *reinterpret_cast<uint64_t *>(buf) = 1;
-    --counter_;
-  } else {
-    *reinterpret_cast<uint64_t *>(buf) = counter_;
-    counter_ = 0;
   }
+
+  // Slow path: block until the counter becomes non-zero. Claims can race with
+  // fast-path readers that do not take the mutex, so re-wait if the counter
+  // is drained between wakeup and claim.
+  absl::MutexLock counter_mutex_lock(&counter_mutex_);
+  waiters_.fetch_add(1);
+  auto ready = [this]() {
+    return counter_.load() > 0;
+  };
+  do {
+    counter_mutex_.Await(absl::Condition(&ready));
+  } while (!TryClaim(&value));
+  waiters_.fetch_sub(1);
+
+  *reinterpret_cast<uint64_t *>(buf) = value;
   return kCounterBufSize;
 }
 
@@ -56,15 +103,29 @@ ssize_t IOContextEventFd::Write(const void *buf, size_t count) {
     errno = EINVAL;
     return -1;
   }
-  absl::MutexLock counter_mutex_lock(&counter_mutex_);
-  if (nonblock_ && (counter_ + add > kMaxCounter)) {
+
+  // Fast path: add to the counter with a lock-free update.
+  if (TryAdd(add)) {
+    WakeWaiters();
+    return kCounterBufSize;
+  }
+
+  if (nonblock_) {
     errno = EAGAIN;
     return -1;
-  } else {
-    auto ready = [this, add]() { return (counter_ + add) <= kMaxCounter; };
-    counter_mutex_.Await(absl::Condition(&ready));
   }
-  counter_ += add;
+
+  // Slow path: block until the addition no longer overflows the counter.
+  // Additions can race with fast-path writers that do not take the mutex, so
+  // re-wait if the room is consumed between wakeup and addition.
+  absl::MutexLock counter_mutex_lock(&counter_mutex_);
+  waiters_.fetch_add(1);
+  auto ready = [this, add]() { return add <= kMaxCounter - counter_.load(); };
+  do {
+    counter_mutex_.Await(absl::Condition(&ready));
+  } while (!TryAdd(add));
+  waiters_.fetch_sub(1);
+
   return kCounterBufSize;
 }
 
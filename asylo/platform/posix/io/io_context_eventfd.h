@@ -21,6 +21,7 @@
 
 #include <sys/eventfd.h>
 
+#include <atomic>
 #include <thread>
 
 #include "absl/synchronization/mutex.h"
@@ -28,11 +29,17 @@
 
 namespace asylo {
 namespace io {
-// IOContext implementation wrapping an epoll file descriptor
+// IOContext implementation of an enclave-internal eventfd counter.
+//
+// The counter is updated with lock-free atomic operations on the fast path,
+// so the common producer/consumer signalling pattern - write while a reader
+// is not blocked, read while the counter is non-zero - never touches the
+// mutex. The mutex is only taken when a caller must block, and by its
+// counterpart to wake blocked callers.
 class IOContextEventFd : public IOManager::IOContext {
  public:
   explicit IOContextEventFd(unsigned int initval, int flags)
-      : counter_(initval) {
+      : counter_(initval), waiters_(0) {
     if (flags & EFD_SEMAPHORE) {
       semaphore_ = true;
     } else {
@@ -50,10 +57,30 @@ class IOContextEventFd : public IOManager::IOContext {
   int Close() override;
 
  private:
-  // Host file descriptor implementing this stream.
-  uint64_t counter_;
+  // Attempts to claim a value from the counter without blocking. On success,
+  // stores the value to report to the caller in |*value| and returns true.
+  bool TryClaim(uint64_t *value);
+
+  // Attempts to add |add| to the counter without exceeding the maximum
+  // counter value and without blocking. Returns true on success.
+  bool TryAdd(uint64_t add);
+
+  // Forces blocked callers to re-evaluate their wait conditions. A no-op
+  // unless some caller is blocked.
+  void WakeWaiters();
+
+  // Value of the eventfd counter.
+  std::atomic<uint64_t> counter_;
+
+  // Number of callers blocked in Read() or Write() waiting for the counter to
+  // change.
+  std::atomic<int> waiters_;
+
   bool semaphore_;
   bool nonblock_;
+
+  // Serializes blocking and wakeup only; fast-path reads and writes do not
+  // take this mutex.
   absl::Mutex counter_mutex_;
 };
 
@@ -19,20 +19,61 @@
 
 #include <sys/inotify.h>
 
+#include <algorithm>
+
 #include "asylo/platform/common/memory.h"
 #include "asylo/platform/host_call/serializer_functions.h"
 #include "asylo/platform/host_call/trusted/host_calls.h"
 
 namespace asylo {
 namespace io {
+namespace {
+
+// Number of bytes of serialized events requested from the host per exit. The
+// host returns whatever is already pending without waiting to fill the
+// buffer, so requesting a large batch drains an event burst in one exit and
+// lets later reads be served from the trusted event queue.
+constexpr size_t kPrefetchBytes = 64 * 1024;
+
+}  // namespace
 
 int IOContextInotify::GetHostFileDescriptor() { return host_fd_; }
 
 int IOContextInotify::InotifyAddWatch(const char *pathname, uint32_t mask) {
-  return enc_untrusted_inotify_add_watch(host_fd_, pathname, mask);
+  // Re-adding a watch with an unchanged mask is a no-op on the host, so serve
+  // it from the cache without exiting. Masks with IN_MASK_ADD or IN_ONESHOT
+  // are never cached: the former accumulates on the host and the latter
+  // auto-removes after one event.
+  const bool cacheable = (mask & (IN_MASK_ADD | IN_ONESHOT)) == 0;
+  std::string path(pathname);
+  auto watch_lookup = path_to_watch_.find(path);
+  if (cacheable && watch_lookup != path_to_watch_.end() &&
+      watch_lookup->second.mask == mask) {
+    return watch_lookup->second.wd;
+  }
+
+  int wd = enc_untrusted_inotify_add_watch(host_fd_, pathname, mask);
+  if (wd == -1) {
+    return -1;
+  }
+
+  if (cacheable) {
+    path_to_watch_[path] = {wd, mask};
+    wd_to_path_[wd] = std::move(path);
+  } else if (watch_lookup != path_to_watch_.end()) {
+    // The host-side mask no longer matches the cached one.
+    wd_to_path_.erase(watch_lookup->second.wd);
+    path_to_watch_.erase(watch_lookup);
+  }
+  return wd;
 }
 
 int IOContextInotify::InotifyRmWatch(int wd) {
+  auto path_lookup = wd_to_path_.find(wd);
+  if (path_lookup != wd_to_path_.end()) {
+    path_to_watch_.erase(path_lookup->second);
+    wd_to_path_.erase(path_lookup);
+  }
   return enc_untrusted_inotify_rm_watch(host_fd_, wd);
 }
 
@@ -45,6 +86,15 @@ size_t IOContextInotify::TransferFromQueueToBuffer(char *buf_ptr,
     if (count < front_event_len) {
       return num_bytes_written;
     }
+    // The kernel removed this watch (deleted file, unmounted filesystem, or
+    // explicit removal), so the cached entry is stale.
+    if (front_event->mask & IN_IGNORED) {
+      auto path_lookup = wd_to_path_.find(front_event->wd);
+      if (path_lookup != wd_to_path_.end()) {
+        path_to_watch_.erase(path_lookup->second);
+        wd_to_path_.erase(path_lookup);
+      }
+    }
     memcpy(buf_ptr, front_event, front_event_len);
     buf_ptr += front_event_len;
     num_bytes_written += front_event_len;
@@ -69,10 +119,13 @@ ssize_t IOContextInotify::Read(void *buf, size_t count) {
     // No need to read events from the host if the queue is not empty.
     return num_bytes_written;
   }
-  // Read serialized events from the host, adjusting for space left in buffer.
+  // Read serialized events from the host. Request a full prefetch batch
+  // rather than just what fits in the caller's remaining buffer; surplus
+  // events stay queued and are returned by later reads without another exit.
   char *serialized_events = nullptr;
   size_t serialized_events_len = 0;
-  if (enc_untrusted_inotify_read(host_fd_, count, &serialized_events,
+  if (enc_untrusted_inotify_read(host_fd_, std::max(count, kPrefetchBytes),
+                                 &serialized_events,
                                  &serialized_events_len) < 0) {
     // errno is set by enc_untrusted_inotify_read.
     return -1;
@@ -21,12 +21,21 @@
 
 #include <sys/inotify.h>
 
+#include <cstdint>
 #include <queue>
+#include <string>
+#include <unordered_map>
 #include "asylo/platform/posix/io/io_manager.h"
 
 namespace asylo {
 namespace io {
-// IOContext implementation wrapping an epoll file descriptor
+// IOContext implementation wrapping a host inotify file descriptor.
+//
+// Reads drain a large batch of events from the host per exit, regardless of
+// the size of the caller's buffer; surplus events are queued on the trusted
+// side and returned by later reads without exiting the enclave. Watches are
+// cached by path, so re-adding an existing watch with an unchanged mask does
+// not exit either.
 class IOContextInotify : public IOManager::IOContext {
  public:
   explicit IOContextInotify(int host_fd) : host_fd_(host_fd) {}
@@ -40,10 +49,24 @@ class IOContextInotify : public IOManager::IOContext {
   int Close() override;
 
  private:
+  // The state of an active watch.
+  struct WatchState {
+    int wd;
+    uint32_t mask;
+  };
+
   size_t TransferFromQueueToBuffer(char *buf_ptr, size_t count);
   // Host file descriptor implementing this stream.
   int host_fd_;
   std::queue<struct inotify_event *> event_queue_;
+
+  // A map from watched paths to their watch state, consulted by
+  // InotifyAddWatch() to elide host calls for already-active watches.
+  std::unordered_map<std::string, WatchState> path_to_watch_;
+
+  // A map from watch descriptors back to watched paths, used to clean up
+  // path_to_watch_ when a watch is removed.
+  std::unordered_map<int, std::string> wd_to_path_;
 };
 
 }  // namespace io
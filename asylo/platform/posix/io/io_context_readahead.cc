@@ -0,0 +1,187 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/posix/io/io_context_readahead.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace asylo {
+namespace io {
+
+int IOContextReadahead::DiscardBufferLocked() {
+  off_t buffered = buffer_len_ - buffer_pos_;
+  buffer_pos_ = 0;
+  buffer_len_ = 0;
+  if (buffered == 0) {
+    return 0;
+  }
+  return delegate_->LSeek(-buffered, SEEK_CUR) < 0 ? -1 : 0;
+}
+
+ssize_t IOContextReadahead::Read(void *buf, size_t count) {
+  absl::MutexLock lock(&mu_);
+  char *out = static_cast<char *>(buf);
+  size_t copied = 0;
+
+  // Serve as much as possible from the buffered window.
+  size_t buffered = buffer_len_ - buffer_pos_;
+  if (buffered > 0) {
+    size_t take = std::min(count, buffered);
+    memcpy(out, buffer_.get() + buffer_pos_, take);
+    buffer_pos_ += take;
+    copied = take;
+  }
+  if (copied == count) {
+    return copied;
+  }
+
+  size_t remaining = count - copied;
+  if (remaining >= kReadaheadBufferSize) {
+    // The request is at least as large as the readahead window; staging it
+    // through the buffer would not save any host calls.
+    ssize_t result = delegate_->Read(out + copied, remaining);
+    if (result < 0) {
+      return copied > 0 ? copied : result;
+    }
+    return copied + result;
+  }
+
+  // Refill the buffer with one large read and serve the remainder from it.
+  ssize_t result = delegate_->Read(buffer_.get(), kReadaheadBufferSize);
+  buffer_pos_ = 0;
+  buffer_len_ = result > 0 ? result : 0;
+  if (result < 0) {
+    return copied > 0 ? copied : result;
+  }
+  size_t take = std::min(remaining, buffer_len_);
+  memcpy(out + copied, buffer_.get(), take);
+  buffer_pos_ = take;
+  return copied + take;
+}
+
+ssize_t IOContextReadahead::Readv(const struct iovec *iov, int iovcnt) {
+  ssize_t total = 0;
+  for (int i = 0; i < iovcnt; ++i) {
+    if (iov[i].iov_len == 0) {
+      continue;
+    }
+    ssize_t result = Read(iov[i].iov_base, iov[i].iov_len);
+    if (result < 0) {
+      return total > 0 ? total : result;
+    }
+    total += result;
+    if (static_cast<size_t>(result) < iov[i].iov_len) {
+      break;
+    }
+  }
+  return total;
+}
+
+ssize_t IOContextReadahead::Write(const void *buf, size_t count) {
+  absl::MutexLock lock(&mu_);
+  if (DiscardBufferLocked() != 0) {
+    return -1;
+  }
+  return delegate_->Write(buf, count);
+}
+
+ssize_t IOContextReadahead::Writev(const struct iovec *iov, int iovcnt) {
+  absl::MutexLock lock(&mu_);
+  if (DiscardBufferLocked() != 0) {
+    return -1;
+  }
+  return delegate_->Writev(iov, iovcnt);
+}
+
+ssize_t IOContextReadahead::PRead(void *buf, size_t count, off_t offset) {
+  // PRead does not consume the file offset, so the buffered window stays
+  // valid.
+  return delegate_->PRead(buf, count, offset);
+}
+
+int IOContextReadahead::LSeek(off_t offset, int whence) {
+  absl::MutexLock lock(&mu_);
+  // The delegate's offset runs ahead of the offset observed by the application
+  // by the number of buffered bytes that have not been consumed yet.
+  if (whence == SEEK_CUR) {
+    offset -= buffer_len_ - buffer_pos_;
+  }
+  buffer_pos_ = 0;
+  buffer_len_ = 0;
+  return delegate_->LSeek(offset, whence);
+}
+
+int IOContextReadahead::FCntl(int cmd, int64_t arg) {
+  return delegate_->FCntl(cmd, arg);
+}
+
+int IOContextReadahead::FSync() { return delegate_->FSync(); }
+
+int IOContextReadahead::FStat(struct stat *stat_buffer) {
+  return delegate_->FStat(stat_buffer);
+}
+
+int IOContextReadahead::FStatFs(struct statfs *statfs_buffer) {
+  return delegate_->FStatFs(statfs_buffer);
+}
+
+ssize_t IOContextReadahead::FGetXattr(const char *name, void *value,
+                                      size_t size) {
+  return delegate_->FGetXattr(name, value, size);
+}
+
+int IOContextReadahead::FSetXattr(const char *name, const void *value,
+                                  size_t size, int flags) {
+  return delegate_->FSetXattr(name, value, size, flags);
+}
+
+ssize_t IOContextReadahead::FListXattr(char *list, size_t size) {
+  return delegate_->FListXattr(list, size);
+}
+
+int IOContextReadahead::Isatty() { return delegate_->Isatty(); }
+
+int IOContextReadahead::FLock(int operation) {
+  return delegate_->FLock(operation);
+}
+
+int IOContextReadahead::FChMod(mode_t mode) { return delegate_->FChMod(mode); }
+
+int IOContextReadahead::FChOwn(uid_t owner, gid_t group) {
+  return delegate_->FChOwn(owner, group);
+}
+
+int IOContextReadahead::FTruncate(off_t length) {
+  absl::MutexLock lock(&mu_);
+  // Truncation may move the end of the file inside the buffered window, so
+  // drop the buffer before delegating.
+  if (DiscardBufferLocked() != 0) {
+    return -1;
+  }
+  return delegate_->FTruncate(length);
+}
+
+int IOContextReadahead::Close() { return delegate_->Close(); }
+
+int IOContextReadahead::GetHostFileDescriptor() {
+  return delegate_->GetHostFileDescriptor();
+}
+
+}  // namespace io
+}  // namespace asylo
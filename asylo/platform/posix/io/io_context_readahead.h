@@ -0,0 +1,94 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_POSIX_IO_IO_CONTEXT_READAHEAD_H_
+#define ASYLO_PLATFORM_POSIX_IO_IO_CONTEXT_READAHEAD_H_
+
+#include <memory>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "asylo/platform/posix/io/io_manager.h"
+
+namespace asylo {
+namespace io {
+
+// IOContext implementation layering a sequential readahead cache over another
+// IOContext. Data is fetched from the delegate context in large aligned chunks
+// and small application reads are served from trusted memory, so scanning a
+// file with many small reads costs one host call per chunk rather than one per
+// read. The delegate's file offset runs ahead of the offset observed by the
+// application; seeks and writes account for the difference before delegating.
+class IOContextReadahead : public IOManager::IOContext {
+ public:
+  // Size of the trusted readahead buffer. Each refill issues a single read of
+  // this size to the delegate context.
+  static constexpr size_t kReadaheadBufferSize = 64 * 1024;
+
+  explicit IOContextReadahead(std::unique_ptr<IOManager::IOContext> delegate)
+      : delegate_(std::move(delegate)),
+        buffer_(new char[kReadaheadBufferSize]) {}
+
+  ssize_t Read(void *buf, size_t count) override;
+  ssize_t Write(const void *buf, size_t count) override;
+  ssize_t Readv(const struct iovec *iov, int iovcnt) override;
+  ssize_t Writev(const struct iovec *iov, int iovcnt) override;
+  ssize_t PRead(void *buf, size_t count, off_t offset) override;
+  int LSeek(off_t offset, int whence) override;
+  int FCntl(int cmd, int64_t arg) override;
+  int FSync() override;
+  int FStat(struct stat *stat_buffer) override;
+  int FStatFs(struct statfs *statfs_buffer) override;
+  ssize_t FGetXattr(const char *name, void *value, size_t size) override;
+  int FSetXattr(const char *name, const void *value, size_t size,
+                int flags) override;
+  ssize_t FListXattr(char *list, size_t size) override;
+  int Isatty() override;
+  int FLock(int operation) override;
+  int FChMod(mode_t mode) override;
+  int FChOwn(uid_t owner, gid_t group) override;
+  int FTruncate(off_t length) override;
+  int Close() override;
+  int GetHostFileDescriptor() override;
+
+ private:
+  // Drops any buffered bytes and rewinds the delegate to the offset observed
+  // by the application. Returns 0 on success or -1 if the rewind fails.
+  int DiscardBufferLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // The underlying stream the readahead buffer is filled from.
+  std::unique_ptr<IOManager::IOContext> delegate_;
+
+  // Serializes access to the buffer state below.
+  absl::Mutex mu_;
+
+  // Chunk of the file prefetched from the delegate context.
+  std::unique_ptr<char[]> buffer_ ABSL_GUARDED_BY(mu_);
+
+  // Offset of the next unconsumed byte in |buffer_|.
+  size_t buffer_pos_ ABSL_GUARDED_BY(mu_) = 0;
+
+  // Number of valid bytes in |buffer_|.
+  size_t buffer_len_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace io
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_POSIX_IO_IO_CONTEXT_READAHEAD_H_
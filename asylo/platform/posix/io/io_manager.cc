@@ -21,20 +21,24 @@
 #include <fcntl.h>
 #include <poll.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdint>
+#include <cstring>
 #include <memory>
-#include <unordered_set>
+#include <vector>
 
-#include "absl/algorithm/container.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "asylo/platform/host_call/exit_handler_constants.h"
 #include "asylo/platform/host_call/trusted/host_calls.h"
 #include "asylo/platform/posix/io/io_context_epoll.h"
 #include "asylo/platform/posix/io/io_context_eventfd.h"
 #include "asylo/platform/posix/io/io_context_inotify.h"
 #include "asylo/platform/posix/io/native_paths.h"
 #include "asylo/platform/posix/io/util.h"
+#include "asylo/platform/primitives/trusted_primitives.h"
 #include "asylo/util/posix_error_space.h"
 #include "asylo/util/statusor.h"
 
@@ -47,53 +51,80 @@ IOManager::FileDescriptorTable::FileDescriptorTable()
 
 std::shared_ptr<IOManager::IOContext> IOManager::FileDescriptorTable::Get(
     int fd) {
-  if (!IsFileDescriptorValid(fd) || !fd_table_[fd]) return nullptr;
-  return fd_table_[fd]->Get();
+  if (!IsFileDescriptorValid(fd)) return nullptr;
+  std::shared_ptr<AutoCloseIOContext> entry = std::atomic_load(&fd_table_[fd]);
+  if (!entry) return nullptr;
+  return entry->Get();
 }
 
 int IOManager::FileDescriptorTable::Delete(int fd) {
-  if (!IsFileDescriptorValid(fd)) return 0;
+  if (!IsFileDescriptorValid(fd)) {
+    errno = EBADF;
+    return -1;
+  }
+  // Atomically claim the entry so concurrent closes of the same descriptor
+  // destroy the context exactly once.
+  std::shared_ptr<AutoCloseIOContext> entry = std::atomic_exchange(
+      &fd_table_[fd], std::shared_ptr<AutoCloseIOContext>());
+  if (!entry) {
+    errno = EBADF;
+    return -1;
+  }
   int close_result = 0;
-  fd_table_[fd]->WriteCloseResultTo(&close_result);
-  fd_table_[fd] = nullptr;
+  entry->WriteCloseResultTo(&close_result);
+  entry.reset();
   return close_result;
 }
 
 bool IOManager::FileDescriptorTable::IsFileDescriptorUnused(int fd) {
   if (!IsFileDescriptorValid(fd)) return false;
-  return !fd_table_[fd];
+  return !std::atomic_load(&fd_table_[fd]);
 }
 
 int IOManager::FileDescriptorTable::Insert(IOContext *context) {
+  absl::MutexLock lock(&allocation_lock_);
   int fd = GetNextFreeFileDescriptor(0);
   if (fd < 0) {
     return -1;
   }
-  fd_table_[fd] = std::make_shared<AutoCloseIOContext>(context);
+  std::atomic_store(&fd_table_[fd],
+                    std::make_shared<AutoCloseIOContext>(context));
   return fd;
 }
 
 int IOManager::FileDescriptorTable::CopyFileDescriptor(int oldfd, int startfd) {
+  if (!IsFileDescriptorValid(oldfd)) {
+    return -1;
+  }
+  std::shared_ptr<AutoCloseIOContext> entry =
+      std::atomic_load(&fd_table_[oldfd]);
+  absl::MutexLock lock(&allocation_lock_);
   int newfd = GetNextFreeFileDescriptor(startfd);
-  if (!IsFileDescriptorValid(oldfd) || newfd == -1) {
+  if (!entry || newfd == -1) {
     return -1;
   }
-  fd_table_[newfd] = fd_table_[oldfd];
+  std::atomic_store(&fd_table_[newfd], entry);
   return newfd;
 }
 
 int IOManager::FileDescriptorTable::CopyFileDescriptorToSpecifiedTarget(
     int oldfd, int newfd) {
-  if (!IsFileDescriptorValid(oldfd) || !IsFileDescriptorValid(newfd) ||
-      fd_table_[newfd]) {
+  if (!IsFileDescriptorValid(oldfd) || !IsFileDescriptorValid(newfd)) {
     return -1;
   }
-  fd_table_[newfd] = fd_table_[oldfd];
+  std::shared_ptr<AutoCloseIOContext> entry =
+      std::atomic_load(&fd_table_[oldfd]);
+  absl::MutexLock lock(&allocation_lock_);
+  if (!entry || std::atomic_load(&fd_table_[newfd])) {
+    return -1;
+  }
+  std::atomic_store(&fd_table_[newfd], entry);
   return newfd;
 }
 
 bool IOManager::FileDescriptorTable::SetFileDescriptorLimits(
     const struct rlimit *rlim) {
+  absl::MutexLock lock(&allocation_lock_);
   // The new limit should not exceed the absolute max file limit, and
   // unprivileged process should not be allowed to increase the hard limit.
   if (rlim->rlim_max <= GetHighestFileDescriptorUsed()) {
@@ -111,10 +142,12 @@ bool IOManager::FileDescriptorTable::SetFileDescriptorLimits(
 }
 
 int IOManager::FileDescriptorTable::get_maximum_fd_soft_limit() {
+  absl::MutexLock lock(&allocation_lock_);
   return maximum_fd_soft_limit;
 }
 
 int IOManager::FileDescriptorTable::get_maximum_fd_hard_limit() {
+  absl::MutexLock lock(&allocation_lock_);
   return maximum_fd_hard_limit;
 }
 
@@ -124,7 +157,7 @@ bool IOManager::FileDescriptorTable::IsFileDescriptorValid(int fd) {
 
 int IOManager::FileDescriptorTable::GetHighestFileDescriptorUsed() {
   for (int i = kMaxOpenFiles - 1; i >= 0; --i) {
-    if (fd_table_[i]) {
+    if (std::atomic_load(&fd_table_[i])) {
       return i;
     }
   }
@@ -137,7 +170,7 @@ int IOManager::FileDescriptorTable::GetNextFreeFileDescriptor(int startfd) {
   }
   int fd = -1;
   for (int i = startfd; i < maximum_fd_soft_limit; ++i) {
-    if (!fd_table_[i]) {
+    if (!std::atomic_load(&fd_table_[i])) {
       fd = i;
       break;
     }
@@ -152,68 +185,65 @@ int IOManager::Access(const char *path, int mode) {
       });
 }
 
-int IOManager::CloseFileDescriptor(int fd) {
-  std::shared_ptr<IOContext> context = fd_table_.Get(fd);
-  if (context) {
-    return fd_table_.Delete(fd);
-  }
-  errno = EBADF;
-  return -1;
-}
+int IOManager::CloseFileDescriptor(int fd) { return fd_table_.Delete(fd); }
 
-int IOManager::Close(int fd) {
-  absl::WriterMutexLock lock(&fd_table_lock_);
-  return CloseFileDescriptor(fd);
-}
+int IOManager::Close(int fd) { return CloseFileDescriptor(fd); }
 
 IOManager::VirtualPathHandler *IOManager::HandlerForPath(
     absl::string_view path) const {
-  // Start by looking for a full match.
-  std::string current_prefix(path);
-
-  // Keep looking until we find a match or run out of handlers to check.
+  // Walk the prefix trie one directory component at a time, remembering the
+  // handler of the deepest matching registered prefix. The snapshot taken
+  // here stays valid even if the registry is republished mid-walk.
+  std::shared_ptr<const PathTrieNode> root = path_trie_.Get();
+  if (!root) {
+    return nullptr;
+  }
+  const PathTrieNode *node = root.get();
+  VirtualPathHandler *handler = node->handler;
+  absl::string_view remaining = path;
   while (true) {
-    // Find the first handler with a prefix greater or equal to this path.
-    // If there is an exact match, this will be it.  Otherwise, any match must
-    // be before this.
-    auto iter = prefix_to_handler_.lower_bound(current_prefix);
-
-    // iter->first is the registered prefix.
-    // iter->second.get() is a pointer to the registered handler.
-
-    // lower_bound can land directory on a match.
-    if (iter != prefix_to_handler_.end() && current_prefix == iter->first) {
-      return iter->second.get();
+    while (!remaining.empty() && remaining.front() == '/') {
+      remaining.remove_prefix(1);
     }
-
-    // Since we started with the lower_bound, any prefixes will be found
-    // before that iterator.  If there are none, we're done.
-    if (iter == prefix_to_handler_.begin()) break;
-    --iter;
-
-    // Determine how much this handler's prefix and the current prefix have in
-    // common.
-    std::string::const_iterator end_prefix, end_path;
-    std::tie(end_prefix, end_path) =
-        absl::c_mismatch(iter->first, current_prefix);
-
-    // If the entire prefix is in the current prefix up to a /, it's a match.
-    if (end_prefix == iter->first.end() && *end_path == '/') {
-      return iter->second.get();
+    if (remaining.empty()) break;
+    size_t end = remaining.find('/');
+    absl::string_view component = remaining.substr(0, end);
+    auto iter = node->children.find(component);
+    if (iter == node->children.end()) break;
+    node = iter->second.get();
+    if (node->handler) {
+      handler = node->handler;
     }
-
-    // Back up the prefix to nearest directory.  We know there can't be a
-    // matching handler with a longer prefix match or we would have found it by
-    // now.
-    while (*end_prefix != '/') --end_prefix;
-
-    // The next iteration of the loop will look for a matching handler using
-    // that directory prefix.
-    current_prefix = std::string(iter->first.begin(), end_prefix);
+    if (end == absl::string_view::npos) break;
+    remaining.remove_prefix(end);
   }
+  return handler;
+}
+
+void IOManager::RebuildPathTrie() {
+  // Build the replacement trie off to the side and publish it atomically;
+  // concurrent lookups keep walking the previous snapshot until they finish.
+  auto new_root = std::make_shared<PathTrieNode>();
+  for (const auto &entry : prefix_to_handler_) {
+    PathTrieNode *node = new_root.get();
+    for (absl::string_view component :
+         absl::StrSplit(entry.first, '/', absl::SkipEmpty())) {
+      std::unique_ptr<PathTrieNode> &child =
+          node->children[std::string(component)];
+      if (!child) {
+        child = ::absl::make_unique<PathTrieNode>();
+      }
+      node = child.get();
+    }
+    node->handler = entry.second.get();
+  }
+  path_trie_.Publish(std::move(new_root));
+}
 
-  // Didn't find a handler.
-  return nullptr;
+void IOManager::InvalidatePathCache() {
+  absl::MutexLock lock(&path_cache_lock_);
+  path_cache_.clear();
+  path_cache_order_.clear();
 }
 
 int IOManager::Open(const char *path, int flags, mode_t mode) {
@@ -223,7 +253,6 @@ int IOManager::Open(const char *path, int flags, mode_t mode) {
         handler->Open(canonical_path, flags, mode);
 
     if (context) {
-      absl::WriterMutexLock lock(&fd_table_lock_);
       int fd = fd_table_.Insert(context.get());
       if (fd >= 0) {
         context.release();
@@ -236,7 +265,6 @@ int IOManager::Open(const char *path, int flags, mode_t mode) {
 }
 
 int IOManager::Dup(int oldfd) {
-  absl::WriterMutexLock lock(&fd_table_lock_);
   if (!fd_table_.IsFileDescriptorUnused(oldfd)) {
     int ret = fd_table_.CopyFileDescriptor(oldfd, 0);
     if (ret < 0) {
@@ -249,7 +277,6 @@ int IOManager::Dup(int oldfd) {
 }
 
 int IOManager::Dup2(int oldfd, int newfd) {
-  absl::WriterMutexLock lock(&fd_table_lock_);
   if (!fd_table_.IsFileDescriptorUnused(oldfd)) {
     if (oldfd == newfd) {
       return newfd;
@@ -281,12 +308,133 @@ int IOManager::Pipe(int pipefd[2], int flags) {
   return res;
 }
 
+namespace {
+
+// An fd_set is a plain bit array in both the enclave and host ABIs; viewing
+// it as machine words lets the translation loops below skip over runs of
+// absent descriptors a word at a time instead of probing every fd.
+using FdMaskWord = unsigned long;
+constexpr int kFdBitsPerWord = 8 * sizeof(FdMaskWord);
+constexpr int kFdSetWords = FD_SETSIZE / kFdBitsPerWord;
+
+// Copies |set| into |words|, or zeroes |words| if |set| is null. Bits at or
+// above |nfds| are cleared so the walk stops at the caller's limit.
+void FdSetToWords(const fd_set *set, int nfds, FdMaskWord *words) {
+  if (!set) {
+    memset(words, 0, kFdSetWords * sizeof(FdMaskWord));
+    return;
+  }
+  memcpy(words, set, kFdSetWords * sizeof(FdMaskWord));
+  for (int word = 0; word < kFdSetWords; ++word) {
+    const int first_fd = word * kFdBitsPerWord;
+    if (first_fd >= nfds) {
+      words[word] = 0;
+    } else if (nfds - first_fd < kFdBitsPerWord) {
+      words[word] &= (FdMaskWord{1} << (nfds - first_fd)) - 1;
+    }
+  }
+}
+
+}  // namespace
+
 int IOManager::Select(int nfds, fd_set *readfds, fd_set *writefds,
                       fd_set *exceptfds, struct timeval *timeout) {
   if (nfds < 0) {
     errno = EINVAL;
     return -1;
   }
+  nfds = std::min(nfds, FD_SETSIZE);
+
+  // View the three requested sets as bitmap words and snapshot the
+  // enclave-to-host descriptor mapping once for every requested fd. The
+  // per-slot descriptor table lookup then happens one time per fd, instead
+  // of once per set and translation pass.
+  FdMaskWord read_words[kFdSetWords], write_words[kFdSetWords],
+      except_words[kFdSetWords];
+  FdSetToWords(readfds, nfds, read_words);
+  FdSetToWords(writefds, nfds, write_words);
+  FdSetToWords(exceptfds, nfds, except_words);
+
+  int host_fd_of[FD_SETSIZE];
+  for (int word = 0; word < kFdSetWords; ++word) {
+    FdMaskWord pending =
+        read_words[word] | write_words[word] | except_words[word];
+    while (pending != 0) {
+      const int fd = word * kFdBitsPerWord + __builtin_ctzl(pending);
+      pending &= pending - 1;
+      std::shared_ptr<IOContext> context = fd_table_.Get(fd);
+      host_fd_of[fd] = context ? context->GetHostFileDescriptor() : -1;
+    }
+  }
+
+  // Fast path: report pending readiness hints of subscribed descriptors
+  // straight from the shared map, leaving the enclave only when nothing is
+  // ready.
+  host_call::FdReadinessMap *readiness_map =
+      readiness_map_.load(std::memory_order_acquire);
+  if (readiness_map) {
+    fd_set ready_readfds, ready_writefds, ready_exceptfds;
+    FD_ZERO(&ready_readfds);
+    FD_ZERO(&ready_writefds);
+    FD_ZERO(&ready_exceptfds);
+    int ready_bits = 0;
+    for (int word = 0; word < kFdSetWords; ++word) {
+      FdMaskWord pending =
+          read_words[word] | write_words[word] | except_words[word];
+      while (pending != 0) {
+        const int bit = __builtin_ctzl(pending);
+        const int fd = word * kFdBitsPerWord + bit;
+        const FdMaskWord mask = FdMaskWord{1} << bit;
+        pending &= pending - 1;
+        if (host_fd_of[fd] < 0) {
+          continue;
+        }
+        const bool want_read = (read_words[word] & mask) != 0;
+        const bool want_write = (write_words[word] & mask) != 0;
+        const bool want_except = (except_words[word] & mask) != 0;
+        // select(2) reports hangups through the read set and error conditions
+        // through the except set.
+        uint32_t wanted_bits = 0;
+        if (want_read) {
+          wanted_bits |= host_call::kFdReadinessReadable |
+                         host_call::kFdReadinessHangup;
+        }
+        if (want_write) {
+          wanted_bits |= host_call::kFdReadinessWritable;
+        }
+        if (want_except) {
+          wanted_bits |= host_call::kFdReadinessError;
+        }
+        uint32_t hints =
+            ConsumeReadinessHints(readiness_map, host_fd_of[fd], wanted_bits);
+        if (want_read && (hints & (host_call::kFdReadinessReadable |
+                                   host_call::kFdReadinessHangup))) {
+          FD_SET(fd, &ready_readfds);
+          ++ready_bits;
+        }
+        if (want_write && (hints & host_call::kFdReadinessWritable)) {
+          FD_SET(fd, &ready_writefds);
+          ++ready_bits;
+        }
+        if (want_except && (hints & host_call::kFdReadinessError)) {
+          FD_SET(fd, &ready_exceptfds);
+          ++ready_bits;
+        }
+      }
+    }
+    if (ready_bits > 0) {
+      if (readfds) {
+        *readfds = ready_readfds;
+      }
+      if (writefds) {
+        *writefds = ready_writefds;
+      }
+      if (exceptfds) {
+        *exceptfds = ready_exceptfds;
+      }
+      return ready_bits;
+    }
+  }
 
   // Translate the fd_sets into host file descriptors.
   fd_set host_readfds, host_writefds, host_exceptfds;
@@ -295,30 +443,28 @@ int IOManager::Select(int nfds, fd_set *readfds, fd_set *writefds,
   FD_ZERO(&host_exceptfds);
 
   int host_nfds = 0;
-  for (int fd = 0; fd < nfds; ++fd) {
-    if (readfds && FD_ISSET(fd, readfds)) {
-      std::shared_ptr<IOContext> context = fd_table_.Get(fd);
-      if (context) {
-        int host_fd = context->GetHostFileDescriptor();
+  for (int word = 0; word < kFdSetWords; ++word) {
+    FdMaskWord pending =
+        read_words[word] | write_words[word] | except_words[word];
+    while (pending != 0) {
+      const int bit = __builtin_ctzl(pending);
+      const int fd = word * kFdBitsPerWord + bit;
+      const FdMaskWord mask = FdMaskWord{1} << bit;
+      pending &= pending - 1;
+      const int host_fd = host_fd_of[fd];
+      if (host_fd < 0 || host_fd >= FD_SETSIZE) {
+        continue;
+      }
+      if (read_words[word] & mask) {
         FD_SET(host_fd, &host_readfds);
-        host_nfds = std::max(host_nfds, host_fd + 1);
       }
-    }
-    if (writefds && FD_ISSET(fd, writefds)) {
-      std::shared_ptr<IOContext> context = fd_table_.Get(fd);
-      if (context) {
-        int host_fd = context->GetHostFileDescriptor();
+      if (write_words[word] & mask) {
         FD_SET(host_fd, &host_writefds);
-        host_nfds = std::max(host_nfds, host_fd + 1);
       }
-    }
-    if (exceptfds && FD_ISSET(fd, exceptfds)) {
-      std::shared_ptr<IOContext> context = fd_table_.Get(fd);
-      if (context) {
-        int host_fd = context->GetHostFileDescriptor();
+      if (except_words[word] & mask) {
         FD_SET(host_fd, &host_exceptfds);
-        host_nfds = std::max(host_nfds, host_fd + 1);
       }
+      host_nfds = std::max(host_nfds, host_fd + 1);
     }
   }
   int ret = enc_untrusted_select(host_nfds, &host_readfds, &host_writefds,
@@ -329,28 +475,6 @@ int IOManager::Select(int nfds, fd_set *readfds, fd_set *writefds,
     return ret;
   }
 
-  // Add the returned fd_sets into an unordered set. IOManager is used in
-  // trusted contexts where system calls might not be available; avoid using
-  // absl based containers which may perform system calls.
-  std::unordered_set<int> host_readfds_set, host_writefds_set,
-      host_exceptfds_set;
-  for (int fd = 0; fd < nfds; ++fd) {
-    std::shared_ptr<IOContext> context = fd_table_.Get(fd);
-    if (context) {
-      int host_fd = context->GetHostFileDescriptor();
-      if (host_fd < 0) continue;
-      if (FD_ISSET(host_fd, &host_readfds)) {
-        host_readfds_set.insert(host_fd);
-      }
-      if (FD_ISSET(host_fd, &host_writefds)) {
-        host_writefds_set.insert(host_fd);
-      }
-      if (FD_ISSET(host_fd, &host_exceptfds)) {
-        host_exceptfds_set.insert(host_fd);
-      }
-    }
-  }
-
   if (readfds) {
     FD_ZERO(readfds);
   }
@@ -360,22 +484,32 @@ int IOManager::Select(int nfds, fd_set *readfds, fd_set *writefds,
   if (exceptfds) {
     FD_ZERO(exceptfds);
   }
-  // Go through the file descriptor table, if any host file descriptor is
-  // included in any of the sets, add the corresponding enclave fd to the
-  // enclave fd_set.
-  for (int fd = 0; fd < nfds; ++fd) {
-    std::shared_ptr<IOContext> context = fd_table_.Get(fd);
-    if (context) {
-      int host_fd = context->GetHostFileDescriptor();
-      if (readfds && host_readfds_set.find(host_fd) != host_readfds_set.end()) {
+  // Walk the requested bits again and report each enclave fd whose host
+  // descriptor came back ready in the corresponding host set. Only requested
+  // descriptors are reported, so an alias of a ready host descriptor (e.g. a
+  // dup) cannot appear in a set it was never asked about.
+  for (int word = 0; word < kFdSetWords; ++word) {
+    FdMaskWord pending =
+        read_words[word] | write_words[word] | except_words[word];
+    while (pending != 0) {
+      const int bit = __builtin_ctzl(pending);
+      const int fd = word * kFdBitsPerWord + bit;
+      const FdMaskWord mask = FdMaskWord{1} << bit;
+      pending &= pending - 1;
+      const int host_fd = host_fd_of[fd];
+      if (host_fd < 0 || host_fd >= FD_SETSIZE) {
+        continue;
+      }
+      if (readfds && (read_words[word] & mask) &&
+          FD_ISSET(host_fd, &host_readfds)) {
         FD_SET(fd, readfds);
       }
-      if (writefds &&
-          host_writefds_set.find(host_fd) != host_writefds_set.end()) {
+      if (writefds && (write_words[word] & mask) &&
+          FD_ISSET(host_fd, &host_writefds)) {
         FD_SET(fd, writefds);
       }
-      if (exceptfds &&
-          host_exceptfds_set.find(host_fd) != host_exceptfds_set.end()) {
+      if (exceptfds && (except_words[word] & mask) &&
+          FD_ISSET(host_fd, &host_exceptfds)) {
         FD_SET(fd, exceptfds);
       }
     }
@@ -385,18 +519,65 @@ int IOManager::Select(int nfds, fd_set *readfds, fd_set *writefds,
 
 int IOManager::Poll(struct pollfd *fds, nfds_t nfds, int timeout) {
   std::vector<int> enclave_fd(nfds);
-  {
-    absl::ReaderMutexLock lock(&fd_table_lock_);
+  for (int i = 0; i < nfds; ++i) {
+    enclave_fd[i] = fds[i].fd;
+    std::shared_ptr<IOContext> context = fd_table_.Get(enclave_fd[i]);
+    if (context) {
+      fds[i].fd = context->GetHostFileDescriptor();
+    } else {
+      fds[i].fd = -1;
+    }
+  }
+
+  // Fast path: report pending readiness hints of subscribed descriptors
+  // straight from the shared map, leaving the enclave only when nothing is
+  // ready.
+  host_call::FdReadinessMap *readiness_map =
+      readiness_map_.load(std::memory_order_acquire);
+  if (readiness_map) {
+    int ready_count = 0;
     for (int i = 0; i < nfds; ++i) {
-      enclave_fd[i] = fds[i].fd;
-      std::shared_ptr<IOContext> context = fd_table_.Get(enclave_fd[i]);
-      if (context) {
-        fds[i].fd = context->GetHostFileDescriptor();
-      } else {
-        fds[i].fd = -1;
+      fds[i].revents = 0;
+      if (fds[i].fd < 0) {
+        continue;
+      }
+      // poll(2) always reports error and hangup conditions, regardless of
+      // the requested events.
+      uint32_t wanted_bits =
+          host_call::kFdReadinessError | host_call::kFdReadinessHangup;
+      if (fds[i].events & POLLIN) {
+        wanted_bits |= host_call::kFdReadinessReadable;
+      }
+      if (fds[i].events & POLLOUT) {
+        wanted_bits |= host_call::kFdReadinessWritable;
+      }
+      uint32_t hints =
+          ConsumeReadinessHints(readiness_map, fds[i].fd, wanted_bits);
+      if (hints == 0) {
+        continue;
       }
+      if (hints & host_call::kFdReadinessReadable) {
+        fds[i].revents |= POLLIN;
+      }
+      if (hints & host_call::kFdReadinessWritable) {
+        fds[i].revents |= POLLOUT;
+      }
+      if (hints & host_call::kFdReadinessError) {
+        fds[i].revents |= POLLERR;
+      }
+      if (hints & host_call::kFdReadinessHangup) {
+        fds[i].revents |= POLLHUP;
+      }
+      ++ready_count;
+    }
+    if (ready_count > 0) {
+      for (int i = 0; i < nfds; ++i) {
+        fds[i].fd = enclave_fd[i];
+      }
+      return ready_count;
     }
   }
+
   int ret = enc_untrusted_poll(fds, nfds, timeout);
   for (int i = 0; i < nfds; ++i) {
     fds[i].fd = enclave_fd[i];
@@ -404,6 +585,74 @@ int IOManager::Poll(struct pollfd *fds, nfds_t nfds, int timeout) {
   return ret;
 }
 
+int IOManager::SubscribeFdEvents(int fd) {
+  std::shared_ptr<IOContext> context = fd_table_.Get(fd);
+  int host_fd = context ? context->GetHostFileDescriptor() : -1;
+  if (host_fd < 0) {
+    errno = EBADF;
+    return -1;
+  }
+  if (!GetReadinessMap()) {
+    errno = ENOSYS;
+    return -1;
+  }
+  if (enc_untrusted_fd_readiness_subscribe(host_fd) != 0) {
+    errno = EINVAL;
+    return -1;
+  }
+  return 0;
+}
+
+int IOManager::UnsubscribeFdEvents(int fd) {
+  std::shared_ptr<IOContext> context = fd_table_.Get(fd);
+  int host_fd = context ? context->GetHostFileDescriptor() : -1;
+  if (host_fd < 0) {
+    errno = EBADF;
+    return -1;
+  }
+  if (enc_untrusted_fd_readiness_unsubscribe(host_fd) != 0) {
+    errno = EINVAL;
+    return -1;
+  }
+  return 0;
+}
+
+host_call::FdReadinessMap *IOManager::GetReadinessMap() {
+  host_call::FdReadinessMap *map =
+      readiness_map_.load(std::memory_order_acquire);
+  if (map) {
+    return map;
+  }
+  absl::MutexLock lock(&readiness_lock_);
+  map = readiness_map_.load(std::memory_order_relaxed);
+  if (map || readiness_checked_) {
+    return map;
+  }
+  readiness_checked_ = true;
+  auto *candidate = reinterpret_cast<host_call::FdReadinessMap *>(
+      enc_untrusted_fd_readiness_setup());
+  // Accept only a map the untrusted side placed wholly outside the enclave
+  // and built against the layout this enclave was compiled with.
+  if (candidate &&
+      primitives::TrustedPrimitives::IsOutsideEnclave(candidate,
+                                                      sizeof(*candidate)) &&
+      candidate->InstanceVersion() ==
+          host_call::FdReadinessMap::TypeVersion()) {
+    readiness_map_.store(candidate, std::memory_order_release);
+    return candidate;
+  }
+  return nullptr;
+}
+
+uint32_t IOManager::ConsumeReadinessHints(host_call::FdReadinessMap *map,
+                                          int host_fd, uint32_t wanted_bits) {
+  uint32_t report = host_call::TestFdReadiness(map, host_fd) & wanted_bits;
+  if (report != 0) {
+    host_call::ClearFdReadiness(map, host_fd, report);
+  }
+  return report;
+}
+
 int IOManager::EpollCreate(int size) {
   if (size < 1) {
     errno = EINVAL;
@@ -414,7 +663,6 @@ int IOManager::EpollCreate(int size) {
     return -1;
   }
   auto context = ::absl::make_unique<IOContextEpoll>(hostfd);
-  absl::WriterMutexLock lock(&fd_table_lock_);
   int fd = fd_table_.Insert(context.get());
   if (fd >= 0) {
     context.release();
@@ -425,11 +673,7 @@ int IOManager::EpollCreate(int size) {
 }
 
 int IOManager::EpollCtl(int epfd, int op, int fd, struct epoll_event *event) {
-  std::shared_ptr<IOContext> context;
-  {
-    absl::ReaderMutexLock lock(&fd_table_lock_);
-    context = fd_table_.Get(fd);
-  }
+  std::shared_ptr<IOContext> context = fd_table_.Get(fd);
   int hostfd = context ? context->GetHostFileDescriptor() : -1;
   if (hostfd == -1) {
     errno = EBADF;
@@ -451,7 +695,6 @@ int IOManager::EpollWait(int epfd, struct epoll_event *events, int maxevents,
 
 int IOManager::EventFd(unsigned int initval, int flags) {
   auto context = ::absl::make_unique<IOContextEventFd>(initval, flags);
-  absl::WriterMutexLock lock(&fd_table_lock_);
   int fd = fd_table_.Insert(context.get());
   if (fd >= 0) {
     context.release();
@@ -467,7 +710,6 @@ int IOManager::InotifyInit(bool non_block) {
     return -1;
   }
   auto context = ::absl::make_unique<IOContextInotify>(hostfd);
-  absl::WriterMutexLock lock(&fd_table_lock_);
   int fd = fd_table_.Insert(context.get());
   if (fd >= 0) {
     context.release();
@@ -520,11 +762,7 @@ struct ErrorValue<Type,
 
 template <typename IOAction, typename ReturnType>
 ReturnType IOManager::CallWithContext(int fd, IOAction action) {
-  std::shared_ptr<IOContext> context;
-  {
-    absl::ReaderMutexLock lock(&fd_table_lock_);
-    context = fd_table_.Get(fd);
-  }
+  std::shared_ptr<IOContext> context = fd_table_.Get(fd);
   if (context) {
     return action(context);
   }
@@ -534,6 +772,7 @@ ReturnType IOManager::CallWithContext(int fd, IOAction action) {
 
 template <typename IOAction, typename ReturnType>
 ReturnType IOManager::CallWithHandler(const char *path, IOAction action) {
+  EnsureDefaultHandlersRegistered();
   StatusOr<std::string> status = CanonicalizePath(path);
   if (!status.ok()) {
     errno = status.status().error_code();
@@ -554,6 +793,7 @@ ReturnType IOManager::CallWithHandler(const char *path, IOAction action) {
 template <typename IOAction, typename ReturnType>
 ReturnType IOManager::CallWithHandler(const char *path1, const char *path2,
                                       IOAction action) {
+  EnsureDefaultHandlersRegistered();
   StatusOr<std::string> status1 = CanonicalizePath(path1);
   if (!status1.ok()) {
     errno = status1.status().error_code();
@@ -589,20 +829,47 @@ int IOManager::Read(int fd, char *buf, size_t count) {
   });
 }
 
+void IOManager::SetDefaultHandlerInitializer(
+    std::function<void()> initializer) {
+  absl::MutexLock lock(&default_handler_lock_);
+  default_handler_initializer_ = std::move(initializer);
+}
+
+void IOManager::EnsureDefaultHandlersRegistered() {
+  std::function<void()> initializer;
+  {
+    absl::MutexLock lock(&default_handler_lock_);
+    if (!default_handler_initializer_) {
+      return;
+    }
+    // Clear the initializer before running it, so that handler registrations
+    // made by the initializer itself do not recurse into it.
+    initializer = std::move(default_handler_initializer_);
+    default_handler_initializer_ = nullptr;
+  }
+  initializer();
+}
+
 bool IOManager::RegisterVirtualPathHandler(
     const std::string &path_prefix,
     std::unique_ptr<VirtualPathHandler> handler) {
+  EnsureDefaultHandlersRegistered();
   if (!handler || (!path_prefix.empty() &&
                    (path_prefix.front() != '/' || path_prefix.back() == '/'))) {
     return false;
   }
 
-  prefix_to_handler_.emplace(path_prefix, std::move(handler));
+  prefix_to_handler_[path_prefix] = std::move(handler);
+  RebuildPathTrie();
+  InvalidatePathCache();
   return true;
 }
 
 void IOManager::DeregisterVirtualPathHandler(const std::string &path_prefix) {
+  EnsureDefaultHandlersRegistered();
   prefix_to_handler_.erase(path_prefix);
+  RebuildPathTrie();
+  InvalidatePathCache();
 }
 
 Status IOManager::SetCurrentWorkingDirectory(absl::string_view path) {
@@ -610,6 +877,8 @@ Status IOManager::SetCurrentWorkingDirectory(absl::string_view path) {
   Status status = working_directory.status();
   if (status.ok()) {
     current_working_directory_ = working_directory.ValueOrDie();
+    // Relative paths resolve against the new working directory.
+    InvalidatePathCache();
   }
 
   return status;
@@ -627,6 +896,20 @@ StatusOr<std::string> IOManager::CanonicalizePath(
                   "Cannot canonicalize empty path");
   }
 
+  // Serve repeated resolutions of the same path from the cache. Entries are
+  // only valid for the working directory and handler registry they were
+  // computed under; both invalidate the cache when they change.
+  std::string cache_key(path);
+  {
+    absl::MutexLock lock(&path_cache_lock_);
+    auto iter = path_cache_.find(cache_key);
+    if (iter != path_cache_.end()) {
+      path_cache_order_.splice(path_cache_order_.begin(), path_cache_order_,
+                               iter->second.second);
+      return iter->second.first;
+    }
+  }
+
   // In some cases, the handler may be restricted for a given path.
   // By default, though, any handler is fine.
   VirtualPathHandler *required_handler = nullptr;
@@ -663,6 +946,19 @@ StatusOr<std::string> IOManager::CanonicalizePath(
                   "Relative path resolution across access domains");
   }
 
+  {
+    absl::MutexLock lock(&path_cache_lock_);
+    if (path_cache_.find(cache_key) == path_cache_.end()) {
+      path_cache_order_.push_front(cache_key);
+      path_cache_.emplace(cache_key,
+                          std::make_pair(ret, path_cache_order_.begin()));
+      if (path_cache_.size() > kPathCacheCapacity) {
+        path_cache_.erase(path_cache_order_.back());
+        path_cache_order_.pop_back();
+      }
+    }
+  }
+
   return ret;
 }
 
@@ -837,7 +1133,6 @@ int IOManager::LSeek(int fd, off_t offset, int whence) {
 
 int IOManager::FCntl(int fd, int cmd, int64_t arg) {
   if (cmd == F_DUPFD) {
-    absl::WriterMutexLock lock(&fd_table_lock_);
     if (!fd_table_.IsFileDescriptorUnused(fd)) {
       int ret = fd_table_.CopyFileDescriptor(fd, arg);
       if (ret < 0) {
@@ -973,6 +1268,139 @@ ssize_t IOManager::PRead(int fd, void *buf, size_t count, off_t offset) {
       });
 }
 
+ssize_t IOManager::PWritev(int fd, const struct iovec *iov, int iovcnt,
+                           off_t offset) {
+  return CallWithContext(
+      fd, [iov, iovcnt, offset](std::shared_ptr<IOContext> context) {
+        return context->PWritev(iov, iovcnt, offset);
+      });
+}
+
+ssize_t IOManager::PReadv(int fd, const struct iovec *iov, int iovcnt,
+                          off_t offset) {
+  return CallWithContext(
+      fd, [iov, iovcnt, offset](std::shared_ptr<IOContext> context) {
+        return context->PReadv(iov, iovcnt, offset);
+      });
+}
+
+ssize_t IOManager::SendFile(int out_fd, int in_fd, off_t *offset,
+                            size_t count) {
+  std::shared_ptr<IOContext> out_context = fd_table_.Get(out_fd);
+  std::shared_ptr<IOContext> in_context = fd_table_.Get(in_fd);
+  if (!out_context || !in_context) {
+    errno = EBADF;
+    return -1;
+  }
+
+  const int host_out_fd = out_context->GetHostFileDescriptor();
+  const int host_in_fd = in_context->GetHostFileDescriptor();
+  if (host_out_fd >= 0 && host_in_fd >= 0) {
+    return enc_untrusted_sendfile(host_out_fd, host_in_fd, offset, count);
+  }
+
+  // At least one descriptor is not a plain host file, so the bytes must pass
+  // through the enclave; copy them one bounded chunk at a time.
+  constexpr size_t kChunkSize = 8192;
+  char buf[kChunkSize];
+  off_t position = offset ? *offset : 0;
+  size_t total = 0;
+  while (total < count) {
+    const size_t chunk = std::min(count - total, kChunkSize);
+    const ssize_t bytes_read = offset
+                                   ? in_context->PRead(buf, chunk, position)
+                                   : in_context->Read(buf, chunk);
+    if (bytes_read == 0) {
+      break;  // End of input.
+    }
+    if (bytes_read == -1) {
+      return total > 0 ? total : -1;
+    }
+    ssize_t written = 0;
+    while (written < bytes_read) {
+      const ssize_t result =
+          out_context->Write(buf + written, bytes_read - written);
+      if (result == -1) {
+        total += written;
+        position += written;
+        if (offset) {
+          *offset = position;
+        }
+        return total > 0 ? static_cast<ssize_t>(total) : -1;
+      }
+      written += result;
+    }
+    total += written;
+    position += written;
+  }
+  if (offset) {
+    *offset = position;
+  }
+  return total;
+}
+
+int IOManager::PositionalIoSubmit(PositionalIoOp *ops, int op_count) {
+  if (!ops || op_count <= 0) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  int completed = 0;
+
+  // Partition the operations: those backed by host files join the batched
+  // host call; the rest go through their context's positional I/O, one at a
+  // time.
+  std::vector<struct enc_positional_io_op> host_ops;
+  std::vector<int> host_op_index;
+  for (int i = 0; i < op_count; ++i) {
+    PositionalIoOp &op = ops[i];
+    std::shared_ptr<IOContext> context = fd_table_.Get(op.fd);
+    if (!context) {
+      op.result = -1;
+      op.error_number = EBADF;
+      continue;
+    }
+    int host_fd = context->GetHostFileDescriptor();
+    if (host_fd < 0) {
+      struct iovec segment = {op.buf, op.count};
+      op.result = op.is_write ? context->PWritev(&segment, 1, op.offset)
+                              : context->PReadv(&segment, 1, op.offset);
+      op.error_number = op.result == -1 ? errno : 0;
+      if (op.result != -1) {
+        ++completed;
+      }
+      continue;
+    }
+    host_ops.push_back({host_fd, op.is_write ? 1 : 0, op.buf, op.count,
+                        op.offset, /*result=*/0, /*error_number=*/0});
+    host_op_index.push_back(i);
+  }
+
+  // Issue the host-backed operations, at most kMaxPIoBatch per enclave exit.
+  for (size_t start = 0; start < host_ops.size();
+       start += host_call::kMaxPIoBatch) {
+    size_t batch_size = std::min<size_t>(host_ops.size() - start,
+                                         host_call::kMaxPIoBatch);
+    if (enc_untrusted_pio_submit(&host_ops[start], batch_size) == -1) {
+      int batch_errno = errno;
+      for (size_t i = start; i < start + batch_size; ++i) {
+        ops[host_op_index[i]].result = -1;
+        ops[host_op_index[i]].error_number = batch_errno;
+      }
+      continue;
+    }
+    for (size_t i = start; i < start + batch_size; ++i) {
+      PositionalIoOp &op = ops[host_op_index[i]];
+      op.result = host_ops[i].result;
+      op.error_number = host_ops[i].error_number;
+      if (op.result != -1) {
+        ++completed;
+      }
+    }
+  }
+  return completed;
+}
+
 mode_t IOManager::Umask(mode_t mask) { return enc_untrusted_umask(mask); }
 
 int IOManager::GetRLimit(int resource, struct rlimit *rlim) {
@@ -982,7 +1410,6 @@ int IOManager::GetRLimit(int resource, struct rlimit *rlim) {
   }
   switch (resource) {
     case RLIMIT_NOFILE: {
-      absl::ReaderMutexLock lock(&fd_table_lock_);
       rlim->rlim_cur = fd_table_.get_maximum_fd_soft_limit();
       rlim->rlim_max = fd_table_.get_maximum_fd_hard_limit();
       return 0;
@@ -1004,7 +1431,6 @@ int IOManager::SetRLimit(int resource, const struct rlimit *rlim) {
   }
   switch (resource) {
     case RLIMIT_NOFILE: {
-      absl::WriterMutexLock lock(&fd_table_lock_);
       if (!fd_table_.SetFileDescriptorLimits(rlim)) {
         return -1;
       }
@@ -1134,7 +1560,6 @@ ssize_t IOManager::RecvFrom(int sockfd, void *buf, size_t len, int flags,
 }
 
 int IOManager::RegisterHostFileDescriptor(int host_fd) {
-  absl::WriterMutexLock lock(&fd_table_lock_);
   auto context = ::absl::make_unique<IOContextNative>(host_fd);
   int fd = fd_table_.Insert(context.get());
   if (fd >= 0) {
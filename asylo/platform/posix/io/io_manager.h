@@ -34,16 +34,20 @@
 #include <cstdint>
 #include <cstdlib>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <queue>
 #include <type_traits>
+#include <utility>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "asylo/platform/host_call/fd_readiness_map.h"
 #include "asylo/platform/storage/secure/enclave_storage_secure.h"
+#include "asylo/util/frozen_snapshot.h"
 #include "asylo/util/statusor.h"
 
 namespace asylo {
@@ -65,6 +69,21 @@ class IOManager {
    public:
     virtual ~IOContext() = default;
 
+    // Attribute bits describing a stream, cached by a concrete context at
+    // creation time so that per-operation capability checks are a single
+    // member load instead of a host round trip. kAttributeCached must be set
+    // for the remaining bits to be meaningful.
+    enum DescriptorAttribute : uint32_t {
+      kAttributeCached = 1 << 0,           // Remaining bits are valid.
+      kAttributeHostBacked = 1 << 1,       // Wraps a host file descriptor.
+      kAttributeSeekable = 1 << 2,         // Not a pipe or socket.
+      kAttributeRegularFile = 1 << 3,      // Regular file on the host.
+      kAttributeSocket = 1 << 4,           // Host socket.
+      kAttributeCharacterDevice = 1 << 5,  // Character device (may be a tty).
+      kAttributeSecure = 1 << 6,           // Contents protected by the
+                                           // secure storage layer.
+    };
+
    protected:
     virtual ssize_t Read(void *buf, size_t count) = 0;
 
@@ -144,6 +163,16 @@ class IOManager {
       return -1;
     }
 
+    virtual ssize_t PWritev(const struct iovec *iov, int iovcnt, off_t offset) {
+      errno = ENOSYS;
+      return -1;
+    }
+
+    virtual ssize_t PReadv(const struct iovec *iov, int iovcnt, off_t offset) {
+      errno = ENOSYS;
+      return -1;
+    }
+
     virtual ssize_t FGetXattr(const char *name, void *value, size_t size) {
       errno = ENOSYS;
       return -1;
@@ -253,8 +282,14 @@ class IOManager {
 
     virtual int GetHostFileDescriptor() { return -1; }
 
+    // Returns the DescriptorAttribute bits for this stream, or 0 if the
+    // context does not cache attributes. Attributes are immutable once the
+    // context is constructed, so reads require no synchronization.
+    virtual uint32_t GetDescriptorAttributes() { return 0; }
+
    private:
     friend class IOManager;
+    friend class IOContextReadahead;
     friend class NativePathHandler;
   };
 
@@ -393,8 +428,11 @@ class IOManager {
   };
 
   // A table of virtual file descriptors managed by the IOManager.
-  // This class is not thread safe. IOManager is responsible for locking the
-  // access to objects of this class.
+  // This class is thread safe. Per-descriptor lookup and removal operate on
+  // reference-counted table slots accessed with atomic shared_ptr operations
+  // and take no table-wide lock, so threads performing I/O on distinct
+  // descriptors do not contend; only descriptor allocation and limit updates
+  // are serialized by an internal mutex.
   class FileDescriptorTable {
    public:
     FileDescriptorTable();
@@ -405,8 +443,9 @@ class IOManager {
 
     // Removes an entry from the table, destroying the associated IOContext if
     // this is the last reference to the IOContext, and returns the file
-    // descriptor to the free list. If close() is called on the host and that
-    // call fails, returns -1; otherwise, returns 0.
+    // descriptor to the free list. Returns -1 with errno set to EBADF if |fd|
+    // is not an open file descriptor, or -1 if close() is called on the host
+    // and that call fails; otherwise, returns 0.
     int Delete(int fd);
 
     // Returns true if a specified file descriptor is available.
@@ -485,19 +524,26 @@ class IOManager {
 
     // Returns current highest file descriptor number. Returns -1 if no file
     // descriptors are used.
-    int GetHighestFileDescriptorUsed();
+    int GetHighestFileDescriptorUsed()
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(allocation_lock_);
 
     // Returns the lowest available file descriptor greater than or equal to
     // |startfd|. Returns -1 if there is no file descriptor available.
-    int GetNextFreeFileDescriptor(int startfd);
+    int GetNextFreeFileDescriptor(int startfd)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(allocation_lock_);
+
+    // Serializes descriptor allocation and limit updates. Individual table
+    // slots are accessed with atomic shared_ptr operations and are not
+    // guarded by this mutex.
+    absl::Mutex allocation_lock_;
 
     std::array<std::shared_ptr<AutoCloseIOContext>, kMaxOpenFiles> fd_table_;
 
     // The maximum file descriptor number allowed.
-    int maximum_fd_soft_limit;
+    int maximum_fd_soft_limit ABSL_GUARDED_BY(allocation_lock_);
 
     // The ceiling for |maximum_fd_soft_limit|.
-    int maximum_fd_hard_limit;
+    int maximum_fd_hard_limit ABSL_GUARDED_BY(allocation_lock_);
   };
 
   // Accessor to the singleton instance.
@@ -545,12 +591,12 @@ class IOManager {
 
   // Creates a copy of the file descriptor |oldfd| using the next available file
   // descriptor. Returns the new file descriptors on success, and -1 on error.
-  virtual int Dup(int oldfd) ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  virtual int Dup(int oldfd);
 
   // Creates a copy of the file descriptor |oldfd| using the file descriptor
   // specified by |newfd|. Returns the new file descriptor on success, and -1 on
   // error.
-  virtual int Dup2(int oldfd, int newfd) ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  virtual int Dup2(int oldfd, int newfd);
 
   // Creates a pipe with the given |flags|, which must be a bitwise-or of any
   // combination of O_CLOEXEC, O_DIRECT, and O_NONBLOCK. The array |pipefd| is
@@ -568,7 +614,7 @@ class IOManager {
   virtual int Write(int fd, const char *buf, size_t count);
 
   // Closes and finalizes the stream, returning 0 on success or -1 on error.
-  virtual int Close(int fd) ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  virtual int Close(int fd);
 
   // Implements fchown(2).
   virtual int FChOwn(int fd, uid_t owner, gid_t group);
@@ -620,11 +666,23 @@ class IOManager {
                      fd_set *exceptfds, struct timeval *timeout);
 
   // Implements poll(2).
-  virtual int Poll(struct pollfd *fds, nfds_t nfds, int timeout)
-      ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  virtual int Poll(struct pollfd *fds, nfds_t nfds, int timeout);
+
+  // Subscribes |fd| to the untrusted fd readiness engine, which thereafter
+  // maintains its readiness state in a shared map the enclave can consult
+  // without exiting. Select() and Poll() report pending readiness of
+  // subscribed descriptors straight from the map and only issue a host call
+  // when no subscribed descriptor is ready. Returns 0 on success or -1 with
+  // errno set on failure.
+  virtual int SubscribeFdEvents(int fd);
+
+  // Removes |fd| from the untrusted fd readiness engine's watch set. Callers
+  // should unsubscribe a descriptor before closing it, as the engine cannot
+  // observe the close. Returns 0 on success or -1 with errno set on failure.
+  virtual int UnsubscribeFdEvents(int fd);
 
   // Implements epoll_create(2).
-  virtual int EpollCreate(int size) ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  virtual int EpollCreate(int size);
 
   // Implements epoll_ctl(2);
   virtual int EpollCtl(int epfd, int op, int fd, struct epoll_event *event);
@@ -651,6 +709,44 @@ class IOManager {
   // Implements pread(2).
   virtual ssize_t PRead(int fd, void *buf, size_t count, off_t offset);
 
+  // Implements pwritev(2).
+  virtual ssize_t PWritev(int fd, const struct iovec *iov, int iovcnt,
+                          off_t offset);
+
+  // Implements preadv(2).
+  virtual ssize_t PReadv(int fd, const struct iovec *iov, int iovcnt,
+                         off_t offset);
+
+  // One positional read or write for PositionalIoSubmit(). |fd| is an enclave
+  // file descriptor and may differ per operation. On completion |result|
+  // holds the bytes transferred, or -1 with the error in |error_number|.
+  struct PositionalIoOp {
+    int fd;
+    bool is_write;  // True writes |count| bytes from |buf|; false reads into
+                    // |buf|.
+    void *buf;
+    size_t count;
+    off_t offset;
+    ssize_t result;
+    int error_number;
+  };
+
+  // Implements sendfile(2). When both descriptors are backed by host files,
+  // the transfer is one host call and the bytes move in the host kernel
+  // without ever entering the enclave. Otherwise the data must pass through
+  // the enclave (e.g. one side is a secure stream), and the call falls back
+  // to a bounded read/write loop.
+  virtual ssize_t SendFile(int out_fd, int in_fd, off_t *offset, size_t count);
+
+  // Issues |op_count| positional reads and writes, batching the operations
+  // whose descriptors are backed by host files into a single enclave exit -
+  // seek+read pairs over several descriptors collapse into one host call.
+  // Operations on descriptors without host backing fall back to the context's
+  // positional I/O, one at a time. Returns the number of operations that
+  // completed successfully, or -1 with errno set if the arguments are
+  // malformed; a failed operation does not stop the rest of the batch.
+  virtual int PositionalIoSubmit(PositionalIoOp *ops, int op_count);
+
   // Implements umask(2).
   virtual mode_t Umask(mode_t mask);
 
@@ -664,12 +760,10 @@ class IOManager {
   virtual int Utimes(const char *filename, const struct timeval times[2]);
 
   // Implements getrlimit(2).
-  virtual int GetRLimit(int resource, struct rlimit *rlim)
-      ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  virtual int GetRLimit(int resource, struct rlimit *rlim);
 
   // Implements setrlimit(2).
-  virtual int SetRLimit(int resource, const struct rlimit *rlim)
-      ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  virtual int SetRLimit(int resource, const struct rlimit *rlim);
 
   // Implements getxattr(2).
   virtual ssize_t GetXattr(const char *path, const char *name, void *value,
@@ -748,11 +842,10 @@ class IOManager {
   virtual int Socket(int domain, int type, int protocol);
 
   // Implements eventfd(2).
-  virtual int EventFd(unsigned int initval, int flags)
-      ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  virtual int EventFd(unsigned int initval, int flags);
 
   // Implements inotify_init(2).
-  virtual int InotifyInit(bool non_block) ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  virtual int InotifyInit(bool non_block);
 
   // Implements inotify_add_watch(2).
   virtual int InotifyAddWatch(int fd, const char *pathname, uint32_t mask);
@@ -766,8 +859,7 @@ class IOManager {
   // Binds an enclave file descriptor to a host file descriptor, returning an
   // enclave file descriptor which will delegate all I/O operations to the host
   // operating system.
-  int RegisterHostFileDescriptor(int host_fd)
-      ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  int RegisterHostFileDescriptor(int host_fd);
 
   // Registers the handler responsible for a given path prefix.
   // When processing a path, the handler with the longest prefix shared with the
@@ -782,6 +874,14 @@ class IOManager {
   // Deregisters the handler responsible for a given path prefix
   void DeregisterVirtualPathHandler(const std::string &path_prefix);
 
+  // Defers registration of the runtime's default path handlers until the
+  // first path-based operation. |initializer| is invoked exactly once, before
+  // the first handler lookup or handler (de)registration following this call,
+  // so that the deferred defaults cannot replace handlers registered by user
+  // code in the meantime. Installing a new initializer replaces one that has
+  // not run yet.
+  void SetDefaultHandlerInitializer(std::function<void()> initializer);
+
   Status SetCurrentWorkingDirectory(absl::string_view path);
   std::string GetCurrentWorkingDirectory() const;
 
@@ -789,29 +889,63 @@ class IOManager {
   IOManager() = default;
 
  private:
+  // Number of canonicalized paths retained by the normalized-path cache.
+  static const constexpr size_t kPathCacheCapacity = 64;
+
+  // A node in the compiled prefix trie used for handler resolution. Each edge
+  // is a whole directory component, so a registered prefix can only match a
+  // path on directory boundaries.
+  struct PathTrieNode {
+    std::map<std::string, std::unique_ptr<PathTrieNode>, std::less<>> children;
+    VirtualPathHandler *handler = nullptr;
+  };
+
   IOManager(IOManager const &) = delete;
   void operator=(IOManager const &) = delete;
 
   // Converts a (possibly user-provided) path and converts it to a canonical
   // representation.  This includes current working directory handling for
-  // relative paths and path normalization.
+  // relative paths and path normalization. Successful resolutions are
+  // memoized in a small LRU cache, which is invalidated whenever the working
+  // directory or the handler registry changes.
   StatusOr<std::string> CanonicalizePath(absl::string_view path) const;
 
+  // Rebuilds the prefix trie from the registered handlers.
+  void RebuildPathTrie();
+
+  // Drops all memoized path resolutions.
+  void InvalidatePathCache();
+
   // Closes a file descriptor by removing it from |fd_table_|, and closing the
   // corresponding host file descriptor if this is the last reference to it.
-  // This method does not obtain a locker. Caller of this method is responsible
-  // for obtaining |fd_table_lock_|.
-  int CloseFileDescriptor(int fd) ABSL_EXCLUSIVE_LOCKS_REQUIRED(fd_table_lock_);
+  int CloseFileDescriptor(int fd);
 
   // Fetches the VirtualFileHandler associated with a given path, or
   // nullptr if no entry is found.
   VirtualPathHandler *HandlerForPath(absl::string_view path) const;
 
-  // Locks the mutex corresponding to |fd| and performs thread safe action.
+  // Runs the deferred default handler initializer, if one is installed and
+  // has not run yet.
+  void EnsureDefaultHandlersRegistered();
+
+  // Returns the shared fd readiness map, attaching to the untrusted engine on
+  // first use. Returns nullptr if the engine could not be started or its map
+  // failed validation; the failure is remembered and not retried.
+  host_call::FdReadinessMap *GetReadinessMap();
+
+  // Reports and retires the pending readiness hints of |host_fd|. Returns the
+  // subset of |wanted_bits| currently set for the descriptor, clearing
+  // exactly the returned bits from the map so unreported hints stay pending.
+  uint32_t ConsumeReadinessHints(host_call::FdReadinessMap *map, int host_fd,
+                                 uint32_t wanted_bits);
+
+  // Looks up the IOContext registered for |fd| and performs an action on it.
+  // The lookup takes a reference on the context without acquiring any
+  // table-wide lock, so concurrent actions on distinct descriptors proceed in
+  // parallel.
   template <typename IOAction, typename ReturnType = typename std::result_of<
                                    IOAction(std::shared_ptr<IOContext>)>::type>
-  ReturnType CallWithContext(int fd, IOAction action)
-      ABSL_LOCKS_EXCLUDED(fd_table_lock_);
+  ReturnType CallWithContext(int fd, IOAction action);
 
   // Looks up the appropriate VirtualPathHandler and calls the given function on
   // it.  Errors related to path resolution and handler lookups are handled.
@@ -831,15 +965,45 @@ class IOManager {
   ReturnType CallWithHandler(const char *path1, const char *path2,
                              IOAction action);
 
-  // A map from path prefix to VirtualPathHandler.
+  // Deferred registration of the runtime's default path handlers, run before
+  // the first handler lookup or handler (de)registration.
+  absl::Mutex default_handler_lock_;
+  std::function<void()> default_handler_initializer_
+      ABSL_GUARDED_BY(default_handler_lock_);
+
+  // A map from path prefix to VirtualPathHandler. Owns the handlers; the
+  // prefix trie below holds non-owning pointers into this map.
   std::map<std::string, std::unique_ptr<VirtualPathHandler>> prefix_to_handler_;
 
+  // Prefix trie compiled from |prefix_to_handler_|, republished wholesale on
+  // each (rare) registry change so lookups read a consistent snapshot without
+  // a lock. The root handler, if any, is the handler registered for the empty
+  // prefix.
+  FrozenSnapshot<PathTrieNode> path_trie_;
+
   FileDescriptorTable fd_table_;
 
-  // A mutex that locks the fd_table_.
-  absl::Mutex fd_table_lock_;
+  // Shared fd readiness map, non-null once the untrusted engine is attached.
+  // Read lock-free on every Select()/Poll(); written once under
+  // |readiness_lock_|.
+  std::atomic<host_call::FdReadinessMap *> readiness_map_{nullptr};
+
+  // Serializes attachment to the untrusted fd readiness engine.
+  absl::Mutex readiness_lock_;
+  bool readiness_checked_ ABSL_GUARDED_BY(readiness_lock_) = false;
 
   std::string current_working_directory_;
+
+  // An LRU cache of successful path canonicalizations, keyed by the path as
+  // given by the caller. |path_cache_order_| lists the keys from most to
+  // least recently used; each cache entry holds the canonical path and the
+  // key's position in that list.
+  mutable absl::Mutex path_cache_lock_;
+  mutable std::map<std::string,
+                   std::pair<std::string, std::list<std::string>::iterator>>
+      path_cache_ ABSL_GUARDED_BY(path_cache_lock_);
+  mutable std::list<std::string> path_cache_order_
+      ABSL_GUARDED_BY(path_cache_lock_);
 };
 
 }  // namespace io
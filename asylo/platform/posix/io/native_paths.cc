@@ -22,14 +22,63 @@
 
 #include <cerrno>
 #include <cstring>
+#include <utility>
 
 #include "asylo/platform/host_call/trusted/host_calls.h"
 #include "asylo/platform/posix/io/secure_paths.h"
 #include "asylo/platform/posix/io/io_context_inotify.h"
+#include "asylo/platform/posix/io/io_context_readahead.h"
+#include "asylo/platform/posix/io/sync_coordinator.h"
 
 namespace asylo {
 namespace io {
 
+namespace {
+
+// Flushes |fd| on the host on behalf of the coordinator.
+int HostSync(int fd, bool data_only) {
+  return data_only ? enc_untrusted_fdatasync(fd) : enc_untrusted_fsync(fd);
+}
+
+// Returns the process-wide coordinator batching host flushes per host file
+// descriptor. Concurrent fsync()/fdatasync() callers on the same file share a
+// single enclave exit and device flush instead of paying one each.
+SyncCoordinator *HostSyncCoordinator() {
+  static SyncCoordinator *coordinator = new SyncCoordinator(HostSync);
+  return coordinator;
+}
+
+// Classifies |host_fd| with a single fstat() so later capability checks read
+// cached attribute bits instead of paying an enclave exit each. Returns 0,
+// leaving the descriptor unclassified, if the host query fails; operations
+// then fall back to asking the host per call.
+uint32_t ClassifyHostDescriptor(int host_fd) {
+  struct stat stat_buffer;
+  if (enc_untrusted_fstat(host_fd, &stat_buffer) != 0) {
+    return 0;
+  }
+  uint32_t attributes = IOManager::IOContext::kAttributeCached |
+                        IOManager::IOContext::kAttributeHostBacked;
+  mode_t mode = stat_buffer.st_mode;
+  if (S_ISREG(mode)) {
+    attributes |= IOManager::IOContext::kAttributeRegularFile;
+  }
+  if (S_ISSOCK(mode)) {
+    attributes |= IOManager::IOContext::kAttributeSocket;
+  }
+  if (S_ISCHR(mode)) {
+    attributes |= IOManager::IOContext::kAttributeCharacterDevice;
+  }
+  // Only pipes and sockets are categorically unseekable; character devices
+  // are device-dependent, so give them the benefit of the doubt.
+  if (!S_ISFIFO(mode) && !S_ISSOCK(mode)) {
+    attributes |= IOManager::IOContext::kAttributeSeekable;
+  }
+  return attributes;
+}
+
+}  // namespace
+
 int IOContextNative::Close() { return enc_untrusted_close(host_fd_); }
 
 ssize_t IOContextNative::Read(void *buf, size_t count) {
@@ -45,6 +94,12 @@ int IOContextNative::FChOwn(uid_t owner, gid_t group) {
 }
 
 int IOContextNative::LSeek(off_t offset, int whence) {
+  // A cached classification lets a seek on a pipe or socket fail inside the
+  // enclave; the host would only return ESPIPE anyway.
+  if ((attributes_ & kAttributeCached) && !(attributes_ & kAttributeSeekable)) {
+    errno = ESPIPE;
+    return -1;
+  }
   return enc_untrusted_lseek(host_fd_, offset, whence);
 }
 
@@ -52,7 +107,13 @@ int IOContextNative::FCntl(int cmd, int64_t arg) {
   return enc_untrusted_fcntl(host_fd_, cmd, arg);
 }
 
-int IOContextNative::FSync() { return enc_untrusted_fsync(host_fd_); }
+int IOContextNative::FSync() {
+  return HostSyncCoordinator()->Sync(host_fd_, /*data_only=*/false);
+}
+
+int IOContextNative::FDataSync() {
+  return HostSyncCoordinator()->Sync(host_fd_, /*data_only=*/true);
+}
 
 int IOContextNative::FStat(struct stat *stat_buffer) {
   return enc_untrusted_fstat(host_fd_, stat_buffer);
@@ -83,68 +144,43 @@ int IOContextNative::FChMod(mode_t mode) {
   return enc_untrusted_fchmod(host_fd_, mode);
 }
 
-int IOContextNative::Isatty() { return enc_untrusted_isatty(host_fd_); }
+int IOContextNative::Isatty() {
+  // Only a character device can be a terminal; answer for everything else
+  // from the cached classification without exiting the enclave.
+  if ((attributes_ & kAttributeCached) &&
+      !(attributes_ & kAttributeCharacterDevice)) {
+    errno = ENOTTY;
+    return 0;
+  }
+  return enc_untrusted_isatty(host_fd_);
+}
 
 int IOContextNative::FLock(int operation) {
   return enc_untrusted_flock(host_fd_, operation);
 }
 
-void IOContextNative::FillIov(const char *buf, int size,
-                              const struct iovec *iov, int iovcnt) {
-  size_t bytes_left = size;
-  for (int i = 0; i < iovcnt; ++i) {
-    if (bytes_left == 0) {
-      break;
-    }
-    int bytes_to_copy = std::min(bytes_left, iov[i].iov_len);
-    memcpy(iov[i].iov_base, buf, bytes_to_copy);
-    buf += bytes_to_copy;
-    bytes_left -= bytes_to_copy;
-  }
-}
-
 ssize_t IOContextNative::Writev(const struct iovec *iov, int iovcnt) {
-  if (iovcnt <= 0) {
-    errno = EINVAL;
-    return -1;
-  }
-
-  size_t total_size = 0;
-  for (int i = 0; i < iovcnt; ++i) {
-    total_size += iov[i].iov_len;
-  }
-  std::unique_ptr<char[]> trusted_buf(new char[total_size]);
-  size_t copied_bytes = 0;
-  for (int i = 0; i < iovcnt; ++i) {
-    memcpy(trusted_buf.get() + copied_bytes, iov[i].iov_base, iov[i].iov_len);
-    copied_bytes += iov[i].iov_len;
-  }
-
-  return enc_untrusted_write(host_fd_, trusted_buf.get(), total_size);
+  return enc_untrusted_writev(host_fd_, iov, iovcnt);
 }
 
 ssize_t IOContextNative::Readv(const struct iovec *iov, int iovcnt) {
-  if (iovcnt <= 0) {
-    errno = EINVAL;
-    return -1;
-  }
-
-  size_t total_size = 0;
-  for (int i = 0; i < iovcnt; ++i) {
-    total_size += iov[i].iov_len;
-  }
-  std::unique_ptr<char[]> trusted_buf(new char[total_size]);
-
-  ssize_t ret = enc_untrusted_read(host_fd_, trusted_buf.get(), total_size);
-  FillIov(trusted_buf.get(), ret, iov, iovcnt);
-
-  return ret;
+  return enc_untrusted_readv(host_fd_, iov, iovcnt);
 }
 
 ssize_t IOContextNative::PRead(void *buf, size_t count, off_t offset) {
   return enc_untrusted_pread64(host_fd_, buf, count, offset);
 }
 
+ssize_t IOContextNative::PWritev(const struct iovec *iov, int iovcnt,
+                                 off_t offset) {
+  return enc_untrusted_pwritev(host_fd_, iov, iovcnt, offset);
+}
+
+ssize_t IOContextNative::PReadv(const struct iovec *iov, int iovcnt,
+                                off_t offset) {
+  return enc_untrusted_preadv(host_fd_, iov, iovcnt, offset);
+}
+
 int IOContextNative::SetSockOpt(int level, int option_name,
                                 const void *option_value,
                                 socklen_t option_len) {
@@ -205,6 +241,8 @@ ssize_t IOContextNative::RecvFrom(void *buf, size_t len, int flags,
 
 int IOContextNative::GetHostFileDescriptor() { return host_fd_; }
 
+uint32_t IOContextNative::GetDescriptorAttributes() { return attributes_; }
+
 std::unique_ptr<IOManager::IOContext> NativePathHandler::Open(const char *path,
                                                               int flags,
                                                               mode_t mode) {
@@ -212,12 +250,22 @@ std::unique_ptr<IOManager::IOContext> NativePathHandler::Open(const char *path,
     return IOContextSecure::Create(path, flags, mode);
   }
 
-  int host_fd = enc_untrusted_open(path, flags, mode);
+  int host_fd = enc_untrusted_open(path, flags & ~O_READAHEAD, mode);
   if (host_fd < 0) {
     return nullptr;
   }
 
-  return ::absl::make_unique<IOContextNative>(host_fd);
+  std::unique_ptr<IOManager::IOContext> context =
+      ::absl::make_unique<IOContextNative>(host_fd,
+                                           ClassifyHostDescriptor(host_fd));
+
+  // The readahead hint only applies to read-only streams: a write through a
+  // readahead context would have to discard the buffered window anyway.
+  if ((flags & O_READAHEAD) && (flags & O_ACCMODE) == O_RDONLY) {
+    context = ::absl::make_unique<IOContextReadahead>(std::move(context));
+  }
+
+  return context;
 }
 
 int NativePathHandler::Chown(const char *path, uid_t owner, gid_t group) {
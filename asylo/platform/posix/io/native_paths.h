@@ -30,7 +30,12 @@ namespace io {
 // operations to the host operating system.
 class IOContextNative : public IOManager::IOContext {
  public:
-  explicit IOContextNative(int host_fd) : host_fd_(host_fd) {}
+  // Constructs a context for |host_fd|. |attributes| is a set of
+  // DescriptorAttribute bits classifying the descriptor, or 0 if the caller
+  // did not classify it; cached attributes let capability checks such as
+  // seekability short-circuit without exiting the enclave.
+  explicit IOContextNative(int host_fd, uint32_t attributes = 0)
+      : host_fd_(host_fd), attributes_(attributes) {}
 
   ssize_t Read(void *buf, size_t count) override;
   ssize_t Write(const void *buf, size_t count) override;
@@ -38,6 +43,7 @@ class IOContextNative : public IOManager::IOContext {
   int LSeek(off_t offset, int whence) override;
   int FCntl(int cmd, int64_t arg) override;
   int FSync() override;
+  int FDataSync() override;
   int FStat(struct stat *stat_buffer) override;
   int FStatFs(struct statfs *statfs_buffer) override;
   ssize_t FGetXattr(const char *name, void *value, size_t size) override;
@@ -52,6 +58,8 @@ class IOContextNative : public IOManager::IOContext {
   ssize_t Writev(const struct iovec *iov, int iovcnt) override;
   ssize_t Readv(const struct iovec *iov, int iovcnt) override;
   ssize_t PRead(void *buf, size_t count, off_t offset) override;
+  ssize_t PWritev(const struct iovec *iov, int iovcnt, off_t offset) override;
+  ssize_t PReadv(const struct iovec *iov, int iovcnt, off_t offset) override;
   int SetSockOpt(int level, int option_name, const void *option_value,
                  socklen_t option_len) override;
   int Connect(const struct sockaddr *addr, socklen_t addrlen) override;
@@ -69,11 +77,15 @@ class IOContextNative : public IOManager::IOContext {
   ssize_t RecvFrom(void *buf, size_t len, int flags, struct sockaddr *src_addr,
                    socklen_t *addrlen) override;
   int GetHostFileDescriptor() override;
+  uint32_t GetDescriptorAttributes() override;
 
  private:
   // Host file descriptor implementing this stream.
   int host_fd_;
-  void FillIov(const char *buf, int size, const struct iovec *iov, int iovcnt);
+
+  // DescriptorAttribute bits recorded at creation time, or 0 if the
+  // descriptor was never classified. Immutable, so reads are lock-free.
+  const uint32_t attributes_;
 };
 
 // VirtualPathHandler implementation handling paths to be forwarded to the host.
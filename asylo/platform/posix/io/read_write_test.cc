@@ -123,6 +123,53 @@ TEST_F(ReadWriteTest, ReadWriteUntrustedTest) {
   EXPECT_EQ(close(fd), 0);
 }
 
+TEST_F(ReadWriteTest, ReadaheadReadTest) {
+  // Write a file spanning several readahead chunks.
+  int fd = open(test_file_.get(), O_CREAT | O_RDWR, 0644);
+  ASSERT_GE(fd, 0);
+  std::string contents;
+  while (contents.size() < 3 * 64 * 1024 + 17) {
+    absl::StrAppend(&contents, "0123456789abcdef-");
+  }
+  size_t rc = write(fd, contents.data(), contents.size());
+  ASSERT_EQ(rc, contents.size());
+  ASSERT_EQ(close(fd), 0);
+
+  // Check that small sequential reads through a readahead stream return the
+  // same bytes as the plain stream would.
+  fd = open(test_file_.get(), O_RDONLY | O_READAHEAD);
+  ASSERT_GE(fd, 0);
+  std::string read_back(contents.size(), '\0');
+  size_t total = 0;
+  while (total < contents.size()) {
+    ssize_t bytes_read = read(fd, &read_back[total], 4096);
+    ASSERT_GT(bytes_read, 0);
+    total += bytes_read;
+  }
+  EXPECT_EQ(read_back, contents);
+
+  // Check that the end of the file is reported at the right offset.
+  char buf[64];
+  EXPECT_EQ(read(fd, buf, sizeof(buf)), 0);
+
+  // Check that seeks observe the application's offset rather than the
+  // prefetched one.
+  off_t offset = 12345;
+  ASSERT_EQ(lseek(fd, offset, SEEK_SET), offset);
+  rc = read(fd, buf, sizeof(buf));
+  ASSERT_EQ(rc, sizeof(buf));
+  EXPECT_EQ(memcmp(buf, contents.data() + offset, sizeof(buf)), 0);
+  EXPECT_EQ(lseek(fd, 0, SEEK_CUR), offset + sizeof(buf));
+
+  // Check that pread bypasses the buffered window without disturbing it.
+  rc = pread(fd, buf, sizeof(buf), 0);
+  ASSERT_EQ(rc, sizeof(buf));
+  EXPECT_EQ(memcmp(buf, contents.data(), sizeof(buf)), 0);
+  EXPECT_EQ(lseek(fd, 0, SEEK_CUR), offset + sizeof(buf));
+
+  EXPECT_EQ(close(fd), 0);
+}
+
 TEST_F(ReadWriteTest, ReadWriteSecureTest) {
   // Generate secure key.
   CleansingVector<uint8_t> secure_key;
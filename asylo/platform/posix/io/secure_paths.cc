@@ -50,7 +50,9 @@ int IOContextSecure::LSeek(off_t offset, int whence) {
   return platform::storage::secure_lseek(host_fd_, offset, whence);
 }
 
-int IOContextSecure::FSync() { return enc_untrusted_fsync(host_fd_); }
+int IOContextSecure::FSync() {
+  return platform::storage::secure_fsync(host_fd_);
+}
 
 int IOContextSecure::FStat(struct stat *st) {
   return platform::storage::secure_fstat(host_fd_, st);
@@ -58,6 +60,14 @@ int IOContextSecure::FStat(struct stat *st) {
 
 int IOContextSecure::Isatty() { return enc_untrusted_isatty(host_fd_); }
 
+uint32_t IOContextSecure::GetDescriptorAttributes() {
+  // Secure streams are always regular files on a seekable backing store, so
+  // the classification is static; the host descriptor is deliberately not
+  // advertised because all access must go through the secure layer.
+  return kAttributeCached | kAttributeSecure | kAttributeRegularFile |
+         kAttributeSeekable;
+}
+
 int IOContextSecure::Ioctl(int request, void *argp) {
   switch (request) {
     case ENCLAVE_STORAGE_SET_KEY: {
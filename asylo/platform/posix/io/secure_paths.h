@@ -46,6 +46,7 @@ class IOContextSecure : public IOManager::IOContext {
   int FStat(struct stat *st) override;
   int Isatty() override;
   int Ioctl(int request, void *argp) override;
+  uint32_t GetDescriptorAttributes() override;
 
  private:
   explicit IOContextSecure(int host_fd) : host_fd_(host_fd) {}
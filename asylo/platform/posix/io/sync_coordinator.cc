@@ -0,0 +1,109 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/posix/io/sync_coordinator.h"
+
+#include <cerrno>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+
+namespace asylo {
+namespace io {
+
+int SyncCoordinator::Sync(int fd, bool data_only) {
+  // Arguments threaded through the absl::Condition a waiter blocks on: wake
+  // when a flush strong enough for the request and numbered at least |target|
+  // has completed, or when no flush is in flight and the waiter can lead one.
+  struct WaitArgs {
+    FdSyncState *state;
+    uint64_t target;
+    bool data_only;
+  };
+
+  FdSyncState *state = GetState(fd);
+  absl::MutexLock lock(&state->mu);
+
+  // A flush already in flight may have started before this caller's writes
+  // were issued, so only a flush with a generation strictly greater than the
+  // latest started one is known to cover them.
+  const uint64_t target = state->started_generation + 1;
+  if (!data_only) {
+    ++state->full_sync_waiters;
+  }
+
+  auto satisfied = [state, target, data_only]() {
+    const uint64_t completed = data_only ? state->completed_data_generation
+                                         : state->completed_full_generation;
+    return completed >= target;
+  };
+
+  while (!satisfied()) {
+    if (!state->flush_in_progress) {
+      // Lead a flush on behalf of everyone enqueued so far. Any full-sync
+      // waiter upgrades the batch to fsync().
+      const uint64_t generation = ++state->started_generation;
+      const bool full = state->full_sync_waiters > 0;
+      state->flush_in_progress = true;
+      state->mu.Unlock();
+      const int result = sync_function_(fd, !full);
+      const int error_number = result == -1 ? errno : 0;
+      state->mu.Lock();
+      state->flush_in_progress = false;
+      state->completed_data_generation = generation;
+      if (full) {
+        state->completed_full_generation = generation;
+      }
+      state->last_result = result;
+      state->last_error = error_number;
+      continue;
+    }
+    // Another thread is flushing. Wait until that flush completes; it either
+    // satisfies this request or leaves the leader role open for this thread.
+    WaitArgs args = {state, target, data_only};
+    state->mu.Await(absl::Condition(
+        +[](WaitArgs *args) {
+          const uint64_t completed = args->data_only
+                                         ? args->state->completed_data_generation
+                                         : args->state->completed_full_generation;
+          return completed >= args->target || !args->state->flush_in_progress;
+        },
+        &args));
+  }
+
+  if (!data_only) {
+    --state->full_sync_waiters;
+  }
+  if (state->last_result == -1) {
+    errno = state->last_error;
+    return -1;
+  }
+  return 0;
+}
+
+SyncCoordinator::FdSyncState *SyncCoordinator::GetState(int fd) {
+  absl::MutexLock lock(&map_mu_);
+  std::unique_ptr<FdSyncState> &state = states_[fd];
+  if (!state) {
+    state = absl::make_unique<FdSyncState>();
+  }
+  return state.get();
+}
+
+}  // namespace io
+}  // namespace asylo
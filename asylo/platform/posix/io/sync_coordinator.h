@@ -0,0 +1,113 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_POSIX_IO_SYNC_COORDINATOR_H_
+#define ASYLO_PLATFORM_POSIX_IO_SYNC_COORDINATOR_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace asylo {
+namespace io {
+
+// Group-commit coordinator for fsync() and fdatasync(). Each sync of a
+// host-backed file costs an enclave exit and a device flush, so concurrent
+// writers syncing the same file pay that cost once per caller. The coordinator
+// serializes flushes per file descriptor: while one thread's flush is in
+// flight, later arrivals enqueue instead of issuing their own, and a single
+// follow-up flush started after they arrived satisfies the whole batch. Under
+// contention a group of N syncing threads performs O(1) host flushes instead
+// of N; an uncontended sync pays only a mutex acquisition on top of the flush
+// it would have performed anyway.
+//
+// Correctness rests on the flush-start ordering rule: a caller's writes are
+// covered only by a flush that *started* after the caller entered Sync(), so
+// a flush already in flight on arrival is never counted and the caller waits
+// for (or leads) the next one.
+class SyncCoordinator {
+ public:
+  // Performs the actual flush of |fd|. |data_only| distinguishes fdatasync()
+  // from fsync(). Returns 0 on success or -1 with errno set, like the
+  // underlying calls.
+  using SyncFunction = int (*)(int fd, bool data_only);
+
+  explicit SyncCoordinator(SyncFunction sync_function)
+      : sync_function_(sync_function) {}
+
+  SyncCoordinator(const SyncCoordinator &) = delete;
+  SyncCoordinator &operator=(const SyncCoordinator &) = delete;
+
+  // Flushes |fd|, either by leading a flush or by joining one led by another
+  // thread. A fdatasync() request (|data_only| true) is satisfied by either
+  // flavor of flush; an fsync() request is only satisfied by a full fsync(),
+  // and its presence in a batch upgrades the batch's flush to fsync(). Returns
+  // 0 on success or -1 with errno set from the flush that satisfied the
+  // request.
+  int Sync(int fd, bool data_only);
+
+ private:
+  // Per-file-descriptor flush state. Flushes are numbered by a generation
+  // counter that increments when a flush starts; a caller snapshots the
+  // counter on entry and is satisfied once a strictly later generation has
+  // completed.
+  struct FdSyncState {
+    absl::Mutex mu;
+
+    // True while a thread is outside the lock performing the host flush.
+    bool flush_in_progress ABSL_GUARDED_BY(mu) = false;
+
+    // Generation number of the most recently started flush.
+    uint64_t started_generation ABSL_GUARDED_BY(mu) = 0;
+
+    // Generation numbers of the most recently completed flush of each
+    // strength. A full fsync() advances both.
+    uint64_t completed_data_generation ABSL_GUARDED_BY(mu) = 0;
+    uint64_t completed_full_generation ABSL_GUARDED_BY(mu) = 0;
+
+    // Number of callers currently in Sync() that require a full fsync().
+    int full_sync_waiters ABSL_GUARDED_BY(mu) = 0;
+
+    // Result of the most recently completed flush. A waiter may observe the
+    // result of a flush later than the one that satisfied it; reporting the
+    // newer result is conservative, since the waiter's data was already
+    // durable when the newer flush failed.
+    int last_result ABSL_GUARDED_BY(mu) = 0;
+    int last_error ABSL_GUARDED_BY(mu) = 0;
+  };
+
+  // Returns the flush state for |fd|, creating it on first use. States are
+  // never removed: file descriptor numbers are densely reused, so the map is
+  // bounded by the peak descriptor count, and stale generation counters are
+  // harmless across a close()/open() reuse of the same number.
+  FdSyncState *GetState(int fd) ABSL_LOCKS_EXCLUDED(map_mu_);
+
+  const SyncFunction sync_function_;
+
+  absl::Mutex map_mu_;
+  absl::flat_hash_map<int, std::unique_ptr<FdSyncState>> states_
+      ABSL_GUARDED_BY(map_mu_);
+};
+
+}  // namespace io
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_POSIX_IO_SYNC_COORDINATOR_H_
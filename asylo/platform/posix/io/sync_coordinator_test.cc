@@ -0,0 +1,154 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/posix/io/sync_coordinator.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/synchronization/notification.h"
+
+namespace asylo {
+namespace io {
+namespace {
+
+// State observed and manipulated by the fake sync functions. The coordinator
+// takes a plain function pointer, so the fakes communicate through file-level
+// variables reset by the test fixture.
+std::atomic<int> sync_calls(0);
+std::atomic<int> full_sync_calls(0);
+std::atomic<int> last_synced_fd(-1);
+std::atomic<int> forced_result(0);
+std::atomic<int> forced_errno(0);
+
+// Set by the batching test; the first flush blocks on it so follower threads
+// can pile up behind the in-flight flush.
+absl::Notification *first_flush_gate = nullptr;
+
+int FakeSync(int fd, bool data_only) {
+  if (sync_calls.fetch_add(1) == 0 && first_flush_gate != nullptr) {
+    first_flush_gate->WaitForNotification();
+  }
+  if (!data_only) {
+    ++full_sync_calls;
+  }
+  last_synced_fd = fd;
+  if (forced_result == -1) {
+    errno = forced_errno;
+    return -1;
+  }
+  return 0;
+}
+
+class SyncCoordinatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    sync_calls = 0;
+    full_sync_calls = 0;
+    last_synced_fd = -1;
+    forced_result = 0;
+    forced_errno = 0;
+    first_flush_gate = nullptr;
+  }
+};
+
+TEST_F(SyncCoordinatorTest, UncontendedSyncFlushesOnce) {
+  SyncCoordinator coordinator(FakeSync);
+  EXPECT_EQ(coordinator.Sync(3, /*data_only=*/false), 0);
+  EXPECT_EQ(sync_calls, 1);
+  EXPECT_EQ(full_sync_calls, 1);
+  EXPECT_EQ(last_synced_fd, 3);
+}
+
+TEST_F(SyncCoordinatorTest, DataOnlyRequestIssuesDataOnlyFlush) {
+  SyncCoordinator coordinator(FakeSync);
+  EXPECT_EQ(coordinator.Sync(3, /*data_only=*/true), 0);
+  EXPECT_EQ(sync_calls, 1);
+  EXPECT_EQ(full_sync_calls, 0);
+}
+
+TEST_F(SyncCoordinatorTest, FlushErrorIsReportedWithErrno) {
+  SyncCoordinator coordinator(FakeSync);
+  forced_result = -1;
+  forced_errno = EIO;
+  errno = 0;
+  EXPECT_EQ(coordinator.Sync(3, /*data_only=*/false), -1);
+  EXPECT_EQ(errno, EIO);
+}
+
+TEST_F(SyncCoordinatorTest, DistinctDescriptorsFlushIndependently) {
+  SyncCoordinator coordinator(FakeSync);
+  EXPECT_EQ(coordinator.Sync(3, /*data_only=*/true), 0);
+  EXPECT_EQ(last_synced_fd, 3);
+  EXPECT_EQ(coordinator.Sync(4, /*data_only=*/true), 0);
+  EXPECT_EQ(last_synced_fd, 4);
+  EXPECT_EQ(sync_calls, 2);
+}
+
+TEST_F(SyncCoordinatorTest, ConcurrentSyncsShareFlushes) {
+  SyncCoordinator coordinator(FakeSync);
+  absl::Notification gate;
+  first_flush_gate = &gate;
+
+  // The leader's flush blocks on the gate while the followers enqueue behind
+  // it; all of them are then satisfied by the flush started after they
+  // arrived, so the whole group costs a handful of flushes rather than one
+  // per thread.
+  constexpr int kFollowers = 8;
+  std::thread leader(
+      [&coordinator] { EXPECT_EQ(coordinator.Sync(3, false), 0); });
+  std::vector<std::thread> followers;
+  for (int i = 0; i < kFollowers; ++i) {
+    followers.emplace_back(
+        [&coordinator] { EXPECT_EQ(coordinator.Sync(3, true), 0); });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  gate.Notify();
+  leader.join();
+  for (auto &follower : followers) {
+    follower.join();
+  }
+  EXPECT_GE(sync_calls, 1);
+  EXPECT_LT(sync_calls, 1 + kFollowers);
+}
+
+TEST_F(SyncCoordinatorTest, FullSyncWaiterUpgradesBatchedFlush) {
+  SyncCoordinator coordinator(FakeSync);
+  absl::Notification gate;
+  first_flush_gate = &gate;
+
+  // The leader issues a data-only flush; while it is in flight a full-sync
+  // request arrives, so the batched follow-up flush must be a full fsync().
+  std::thread leader(
+      [&coordinator] { EXPECT_EQ(coordinator.Sync(3, true), 0); });
+  std::thread full_waiter(
+      [&coordinator] { EXPECT_EQ(coordinator.Sync(3, false), 0); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  gate.Notify();
+  leader.join();
+  full_waiter.join();
+  EXPECT_GE(full_sync_calls, 1);
+}
+
+}  // namespace
+}  // namespace io
+}  // namespace asylo
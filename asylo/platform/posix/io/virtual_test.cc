@@ -216,6 +216,26 @@ TEST_F(VirtualHandlerTest, NoMatch) {
   DeregisterVirtualPathHandler(path4);
 }
 
+TEST_F(VirtualHandlerTest, ResolutionFollowsRegistryChanges) {
+  const std::string path = "/test/cached";
+  const std::string label1 = "ResolutionFollowsRegistryChanges1";
+  const std::string label2 = "ResolutionFollowsRegistryChanges2";
+
+  // Register a handler and resolve the same path repeatedly, priming the
+  // normalized-path cache.
+  RegisterVirtualPathHandler(path, label1);
+  EXPECT_THAT(Read(path), IsOkAndHolds(label1));
+  EXPECT_THAT(Read(path), IsOkAndHolds(label1));
+
+  // Re-registering the prefix replaces the handler for subsequent lookups.
+  RegisterVirtualPathHandler(path, label2);
+  EXPECT_THAT(Read(path), IsOkAndHolds(label2));
+
+  // Deregistering the prefix stops the handler from matching.
+  DeregisterVirtualPathHandler(path);
+  ASSERT_THAT(Read(path), Not(IsOk()));
+}
+
 TEST_F(VirtualHandlerTest, SiblingMatch) {
   const std::string path1 = "/test";
   const std::string path2 = "/test/fake";
@@ -0,0 +1,168 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/posix/memory/heap_stats.h"
+
+#include <malloc.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/reent.h>
+
+#include <atomic>
+#include <cstddef>
+
+#include "asylo/platform/posix/memory/malloc_arena.h"
+
+extern "C" void set_malloc_hook(void *(*hook)(size_t, void *), void *);
+extern "C" void set_realloc_hook(void *(*hook)(void *, size_t, void *), void *);
+extern "C" void set_free_hook(void (*hook)(void *, void *), void *);
+
+namespace {
+
+// Whether enc_enable_heap_stats() has been called. Written once during
+// enclave initialization before the counters are consulted.
+bool heap_stats_enabled = false;
+
+// All counters use relaxed atomics: snapshots only need each counter to be a
+// coherent value, not a cross-counter consistent cut, and relaxed updates
+// keep the per-allocation cost to a handful of uncontended RMW operations.
+std::atomic<uint64_t> in_use_bytes{0};
+std::atomic<uint64_t> peak_in_use_bytes{0};
+std::atomic<uint64_t> alloc_count{0};
+std::atomic<uint64_t> free_count{0};
+std::atomic<uint64_t> failed_alloc_count{0};
+std::atomic<uint64_t> alloc_size_buckets[kHeapStatsNumBuckets] = {};
+
+// Returns the histogram bucket for an allocation of |usable_size| bytes:
+// bucket |i| covers sizes up to 16 << |i|, and the last bucket is unbounded.
+int BucketForSize(size_t usable_size) {
+  uint64_t bound = 16;
+  for (int i = 0; i < kHeapStatsNumBuckets - 1; ++i) {
+    if (usable_size <= bound) {
+      return i;
+    }
+    bound <<= 1;
+  }
+  return kHeapStatsNumBuckets - 1;
+}
+
+// Instrumented malloc hooks, installed when the per-thread malloc arenas are
+// not in use. With the arenas enabled the arena hooks own the hook slots and
+// report into the counters through the enc_heap_stats_record_* entry points
+// instead.
+void *StatsMallocHook(size_t size, void *pool) {
+  void *ret = _malloc_r(_REENT, size);
+  if (ret != nullptr) {
+    enc_heap_stats_record_alloc(malloc_usable_size(ret));
+  } else {
+    enc_heap_stats_record_failed_alloc();
+  }
+  return ret;
+}
+
+void *StatsReallocHook(void *ptr, size_t size, void *pool) {
+  size_t old_size = ptr != nullptr ? malloc_usable_size(ptr) : 0;
+  void *ret = _realloc_r(_REENT, ptr, size);
+  if (ret != nullptr) {
+    if (ptr != nullptr) {
+      enc_heap_stats_record_free(old_size);
+    }
+    enc_heap_stats_record_alloc(malloc_usable_size(ret));
+  } else if (size != 0) {
+    enc_heap_stats_record_failed_alloc();
+  }
+  return ret;
+}
+
+void StatsFreeHook(void *address, void *pool) {
+  if (address == nullptr) {
+    return;
+  }
+  enc_heap_stats_record_free(malloc_usable_size(address));
+  _free_r(_REENT, address);
+}
+
+}  // namespace
+
+void enc_enable_heap_stats() {
+  heap_stats_enabled = true;
+  if (!enc_malloc_arenas_enabled()) {
+    set_malloc_hook(&StatsMallocHook, /*pool=*/nullptr);
+    set_realloc_hook(&StatsReallocHook, /*pool=*/nullptr);
+    set_free_hook(&StatsFreeHook, /*pool=*/nullptr);
+  }
+}
+
+bool enc_heap_stats_enabled() { return heap_stats_enabled; }
+
+void enc_snapshot_heap_stats(struct HeapStatsSnapshot *snapshot) {
+  snapshot->in_use_bytes = in_use_bytes.load(std::memory_order_relaxed);
+  snapshot->peak_in_use_bytes =
+      peak_in_use_bytes.load(std::memory_order_relaxed);
+  snapshot->alloc_count = alloc_count.load(std::memory_order_relaxed);
+  snapshot->free_count = free_count.load(std::memory_order_relaxed);
+  snapshot->failed_alloc_count =
+      failed_alloc_count.load(std::memory_order_relaxed);
+  for (int i = 0; i < kHeapStatsNumBuckets; ++i) {
+    snapshot->alloc_size_buckets[i] =
+        alloc_size_buckets[i].load(std::memory_order_relaxed);
+  }
+
+  // Fragmentation numbers come from the allocator itself and are only
+  // computed at snapshot time, so they add no per-allocation cost.
+  struct mallinfo info = mallinfo();
+  snapshot->heap_bytes = info.arena;
+  snapshot->heap_free_bytes = info.fordblks;
+  snapshot->heap_free_chunks = info.ordblks;
+}
+
+void enc_reset_heap_stats_peak() {
+  peak_in_use_bytes.store(in_use_bytes.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+}
+
+void enc_heap_stats_record_alloc(size_t usable_size) {
+  if (!heap_stats_enabled) {
+    return;
+  }
+  alloc_count.fetch_add(1, std::memory_order_relaxed);
+  alloc_size_buckets[BucketForSize(usable_size)].fetch_add(
+      1, std::memory_order_relaxed);
+  uint64_t now =
+      in_use_bytes.fetch_add(usable_size, std::memory_order_relaxed) +
+      usable_size;
+  uint64_t peak = peak_in_use_bytes.load(std::memory_order_relaxed);
+  while (now > peak && !peak_in_use_bytes.compare_exchange_weak(
+                           peak, now, std::memory_order_relaxed)) {
+  }
+}
+
+void enc_heap_stats_record_free(size_t usable_size) {
+  if (!heap_stats_enabled) {
+    return;
+  }
+  free_count.fetch_add(1, std::memory_order_relaxed);
+  in_use_bytes.fetch_sub(usable_size, std::memory_order_relaxed);
+}
+
+void enc_heap_stats_record_failed_alloc() {
+  if (!heap_stats_enabled) {
+    return;
+  }
+  failed_alloc_count.fetch_add(1, std::memory_order_relaxed);
+}
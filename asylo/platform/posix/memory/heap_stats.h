@@ -0,0 +1,94 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_POSIX_MEMORY_HEAP_STATS_H_
+#define ASYLO_PLATFORM_POSIX_MEMORY_HEAP_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Number of allocation-size histogram buckets. Bucket |i| counts allocations
+// whose usable size is at most 16 << |i| bytes; the last bucket counts
+// everything larger.
+enum { kHeapStatsNumBuckets = 16 };
+
+// A point-in-time copy of the enclave heap counters. Counter fields are
+// cumulative since enc_enable_heap_stats() was called; the heap_* fields are
+// sampled from the allocator at snapshot time.
+struct HeapStatsSnapshot {
+  // Usable bytes currently allocated and not yet freed.
+  uint64_t in_use_bytes;
+
+  // Highest value in_use_bytes has reached since instrumentation was enabled
+  // or the peak was last reset.
+  uint64_t peak_in_use_bytes;
+
+  // Number of successful allocations, frees, and failed allocations.
+  uint64_t alloc_count;
+  uint64_t free_count;
+  uint64_t failed_alloc_count;
+
+  // Successful allocations binned by usable size; see kHeapStatsNumBuckets.
+  uint64_t alloc_size_buckets[kHeapStatsNumBuckets];
+
+  // Total bytes the in-enclave heap has obtained from the enclave address
+  // space, bytes of that sitting on the allocator's free lists, and the number
+  // of free chunks holding them. A large heap_free_bytes spread over many
+  // chunks while allocations fail or the heap keeps growing indicates
+  // fragmentation.
+  uint64_t heap_bytes;
+  uint64_t heap_free_bytes;
+  uint64_t heap_free_chunks;
+};
+
+// Enables heap usage instrumentation. Every subsequent allocation and free
+// updates the counters read by enc_snapshot_heap_stats(). The per-operation
+// cost is a few relaxed atomic updates, so instrumentation may be left on in
+// production. Enabling is idempotent; instrumentation cannot be disabled.
+void enc_enable_heap_stats();
+
+// Returns true if enc_enable_heap_stats() has been called.
+bool enc_heap_stats_enabled();
+
+// Fills |snapshot| with the current counter values. Counters are read without
+// mutual exclusion against concurrent allocations, so a snapshot is
+// internally consistent only to within the operations in flight while it was
+// taken.
+void enc_snapshot_heap_stats(struct HeapStatsSnapshot *snapshot);
+
+// Resets peak_in_use_bytes to the current in_use_bytes, starting a new
+// high-water measurement interval.
+void enc_reset_heap_stats_peak();
+
+// Recording entry points for allocator hooks that bypass the instrumented
+// malloc hooks (e.g. the per-thread malloc arenas). |usable_size| is the
+// usable size of the block as reported by malloc_usable_size(). All three are
+// no-ops until enc_enable_heap_stats() is called.
+void enc_heap_stats_record_alloc(size_t usable_size);
+void enc_heap_stats_record_free(size_t usable_size);
+void enc_heap_stats_record_failed_alloc();
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // ASYLO_PLATFORM_POSIX_MEMORY_HEAP_STATS_H_
@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "asylo/platform/posix/memory/heap_stats.h"
+
+namespace asylo {
+namespace {
+
+// Sized above the arena size classes so allocations in these tests always hit
+// the global heap, and well inside its histogram bucket so allocator size
+// rounding cannot move it across a bucket boundary.
+constexpr size_t kProbeSize = 20000;
+
+class HeapStatsTest : public ::testing::Test {
+ protected:
+  void SetUp() override { enc_enable_heap_stats(); }
+};
+
+TEST_F(HeapStatsTest, EnableIsIdempotentAndReported) {
+  EXPECT_TRUE(enc_heap_stats_enabled());
+  enc_enable_heap_stats();
+  EXPECT_TRUE(enc_heap_stats_enabled());
+}
+
+// A malloc/free pair moves the live-byte count and operation counters by at
+// least the allocation, and the freed bytes come back off the live count.
+TEST_F(HeapStatsTest, TracksLiveBytesAndCounts) {
+  struct HeapStatsSnapshot before, after_alloc, after_free;
+  enc_snapshot_heap_stats(&before);
+  char *block = static_cast<char *>(malloc(kProbeSize));
+  enc_snapshot_heap_stats(&after_alloc);
+  memset(block, 0xa5, kProbeSize);
+  free(block);
+  enc_snapshot_heap_stats(&after_free);
+
+  EXPECT_GE(after_alloc.in_use_bytes, before.in_use_bytes + kProbeSize);
+  EXPECT_GE(after_alloc.alloc_count, before.alloc_count + 1);
+  EXPECT_GE(after_free.free_count, after_alloc.free_count + 1);
+  EXPECT_LE(after_free.in_use_bytes, after_alloc.in_use_bytes - kProbeSize);
+  EXPECT_GE(after_free.peak_in_use_bytes, after_alloc.in_use_bytes);
+}
+
+// The peak survives the free of the allocation that set it, and resetting
+// brings it back down to the current live-byte count.
+TEST_F(HeapStatsTest, PeakIsHighWaterAndResettable) {
+  constexpr size_t kLargeSize = 1 << 20;
+  void *block = malloc(kLargeSize);
+  ASSERT_NE(block, nullptr);
+  free(block);
+
+  struct HeapStatsSnapshot after_free;
+  enc_snapshot_heap_stats(&after_free);
+  EXPECT_GE(after_free.peak_in_use_bytes, after_free.in_use_bytes + kLargeSize);
+
+  enc_reset_heap_stats_peak();
+  struct HeapStatsSnapshot after_reset;
+  enc_snapshot_heap_stats(&after_reset);
+  EXPECT_LT(after_reset.peak_in_use_bytes, after_free.peak_in_use_bytes);
+  EXPECT_GE(after_reset.peak_in_use_bytes, after_reset.in_use_bytes);
+}
+
+// Allocations land in the histogram bucket covering their size.
+TEST_F(HeapStatsTest, HistogramBinsAllocationsBySize) {
+  // kProbeSize falls in the bucket covering (16 << 10, 16 << 11] bytes.
+  constexpr int kProbeBucket = 11;
+  struct HeapStatsSnapshot before, after;
+  enc_snapshot_heap_stats(&before);
+  void *block = malloc(kProbeSize);
+  enc_snapshot_heap_stats(&after);
+  free(block);
+
+  EXPECT_GE(after.alloc_size_buckets[kProbeBucket],
+            before.alloc_size_buckets[kProbeBucket] + 1);
+}
+
+// The allocator-level fragmentation fields are populated and self-consistent.
+TEST_F(HeapStatsTest, ReportsAllocatorFragmentationFields) {
+  struct HeapStatsSnapshot snapshot;
+  enc_snapshot_heap_stats(&snapshot);
+  EXPECT_GT(snapshot.heap_bytes, 0);
+  EXPECT_LE(snapshot.heap_free_bytes, snapshot.heap_bytes);
+}
+
+}  // namespace
+}  // namespace asylo
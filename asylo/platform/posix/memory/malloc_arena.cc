@@ -0,0 +1,189 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/posix/memory/malloc_arena.h"
+
+#include <malloc.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/reent.h>
+
+#include <cstddef>
+
+#include "asylo/platform/posix/memory/heap_stats.h"
+
+extern "C" void set_malloc_hook(void *(*hook)(size_t, void *), void *);
+extern "C" void set_realloc_hook(void *(*hook)(void *, size_t, void *), void *);
+extern "C" void set_free_hook(void (*hook)(void *, void *), void *);
+
+namespace {
+
+// Size classes served from the per-thread arena cache, in bytes. Requests
+// larger than the largest class go straight to the global heap.
+constexpr size_t kSizeClasses[] = {16, 32, 64, 128, 256, 512, 1024};
+constexpr int kNumSizeClasses =
+    sizeof(kSizeClasses) / sizeof(kSizeClasses[0]);
+
+// Maximum number of cached blocks per size class per thread. When a class
+// fills up, half of it is returned to the global heap so that one rebalancing
+// pass amortizes over several subsequent frees.
+constexpr int kMaxBlocksPerClass = 32;
+
+// Per-thread cache of freed blocks: one singly linked list per size class,
+// threaded through the first word of each freed block. The struct is
+// trivially destructible on purpose so thread exit needs no TLS destructor;
+// enc_flush_malloc_arena() empties the cache instead.
+struct ArenaCache {
+  void *free_lists[kNumSizeClasses];
+  int counts[kNumSizeClasses];
+};
+
+thread_local ArenaCache arena_cache = {};
+
+// Whether enc_enable_malloc_arenas() has been called. Written once during
+// enclave initialization before user threads start allocating.
+bool malloc_arenas_enabled = false;
+
+// Returns the index of the smallest size class that holds a request of |size|
+// bytes, or -1 if the request is larger than every class.
+int SizeClassForRequest(size_t size) {
+  for (int i = 0; i < kNumSizeClasses; ++i) {
+    if (size <= kSizeClasses[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Returns the index of the size class a freed block of |usable_size| bytes is
+// cached under, or -1 if the block should go back to the global heap. The
+// block is binned by the largest class it can satisfy, so any block in a bin
+// is large enough for any request of that class regardless of which
+// allocation path created it. Blocks much larger than the largest class are
+// not cached at all to avoid retaining big buffers behind small requests.
+int SizeClassForBlock(size_t usable_size) {
+  if (usable_size >= 2 * kSizeClasses[kNumSizeClasses - 1]) {
+    return -1;
+  }
+  for (int i = kNumSizeClasses - 1; i >= 0; --i) {
+    if (usable_size >= kSizeClasses[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void *ArenaMallocHook(size_t size, void *pool) {
+  int size_class = SizeClassForRequest(size);
+  if (size_class >= 0) {
+    void *block = arena_cache.free_lists[size_class];
+    if (block != nullptr) {
+      arena_cache.free_lists[size_class] = *reinterpret_cast<void **>(block);
+      arena_cache.counts[size_class]--;
+      if (enc_heap_stats_enabled()) {
+        enc_heap_stats_record_alloc(malloc_usable_size(block));
+      }
+      return block;
+    }
+    // Cache miss: allocate the full class size so that the block can later be
+    // recycled for any request of its class.
+    size = kSizeClasses[size_class];
+  }
+  void *ret = _malloc_r(_REENT, size);
+  if (enc_heap_stats_enabled()) {
+    if (ret != nullptr) {
+      enc_heap_stats_record_alloc(malloc_usable_size(ret));
+    } else {
+      enc_heap_stats_record_failed_alloc();
+    }
+  }
+  return ret;
+}
+
+void ArenaFreeHook(void *address, void *pool) {
+  if (address == nullptr) {
+    return;
+  }
+  // Blocks deposited in the arena cache are free from the application's point
+  // of view, so they leave the in-use count here even though they are not
+  // returned to the global heap yet.
+  if (enc_heap_stats_enabled()) {
+    enc_heap_stats_record_free(malloc_usable_size(address));
+  }
+  int size_class = SizeClassForBlock(malloc_usable_size(address));
+  if (size_class < 0) {
+    _free_r(_REENT, address);
+    return;
+  }
+  if (arena_cache.counts[size_class] >= kMaxBlocksPerClass) {
+    // Rebalance an overfull class by returning half of it to the global heap.
+    for (int i = 0; i < kMaxBlocksPerClass / 2; ++i) {
+      void *block = arena_cache.free_lists[size_class];
+      arena_cache.free_lists[size_class] = *reinterpret_cast<void **>(block);
+      _free_r(_REENT, block);
+    }
+    arena_cache.counts[size_class] -= kMaxBlocksPerClass / 2;
+  }
+  *reinterpret_cast<void **>(address) = arena_cache.free_lists[size_class];
+  arena_cache.free_lists[size_class] = address;
+  arena_cache.counts[size_class]++;
+}
+
+// realloc always operates on the underlying allocator. Every cached block is
+// a real heap block allocated at its full class size, so this is safe for
+// blocks served from the cache as well.
+void *ArenaReallocHook(void *ptr, size_t size, void *pool) {
+  if (!enc_heap_stats_enabled()) {
+    return _realloc_r(_REENT, ptr, size);
+  }
+  size_t old_size = ptr != nullptr ? malloc_usable_size(ptr) : 0;
+  void *ret = _realloc_r(_REENT, ptr, size);
+  if (ret != nullptr) {
+    if (ptr != nullptr) {
+      enc_heap_stats_record_free(old_size);
+    }
+    enc_heap_stats_record_alloc(malloc_usable_size(ret));
+  } else if (size != 0) {
+    enc_heap_stats_record_failed_alloc();
+  }
+  return ret;
+}
+
+}  // namespace
+
+void enc_enable_malloc_arenas() {
+  malloc_arenas_enabled = true;
+  set_malloc_hook(&ArenaMallocHook, /*pool=*/nullptr);
+  set_realloc_hook(&ArenaReallocHook, /*pool=*/nullptr);
+  set_free_hook(&ArenaFreeHook, /*pool=*/nullptr);
+}
+
+bool enc_malloc_arenas_enabled() { return malloc_arenas_enabled; }
+
+void enc_flush_malloc_arena() {
+  for (int size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+    void *block = arena_cache.free_lists[size_class];
+    while (block != nullptr) {
+      void *next = *reinterpret_cast<void **>(block);
+      _free_r(_REENT, block);
+      block = next;
+    }
+    arena_cache.free_lists[size_class] = nullptr;
+    arena_cache.counts[size_class] = 0;
+  }
+}
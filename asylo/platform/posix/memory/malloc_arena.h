@@ -0,0 +1,46 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_POSIX_MEMORY_MALLOC_ARENA_H_
+#define ASYLO_PLATFORM_POSIX_MEMORY_MALLOC_ARENA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Layers per-thread caches of small freed blocks over the global in-enclave
+// heap. Small allocations are served from the calling thread's cache without
+// taking the global malloc lock; cache misses and large requests fall through
+// to the underlying allocator. Installing the hooks is idempotent, so this may
+// also be called to reinstate the arenas after heap_switch() temporarily
+// replaced the malloc hooks.
+void enc_enable_malloc_arenas();
+
+// Returns true if enc_enable_malloc_arenas() has been called.
+bool enc_malloc_arenas_enabled();
+
+// Returns all blocks cached by the calling thread to the global heap. Must be
+// called before a donated thread leaves the enclave for good; otherwise its
+// cached blocks would be retained until the enclave is destroyed.
+void enc_flush_malloc_arena();
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // ASYLO_PLATFORM_POSIX_MEMORY_MALLOC_ARENA_H_
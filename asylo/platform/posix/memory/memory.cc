@@ -19,6 +19,9 @@
 #include "asylo/platform/posix/memory/memory.h"
 
 #include <malloc.h>
+
+#include "asylo/platform/posix/memory/heap_stats.h"
+#include "asylo/platform/posix/memory/malloc_arena.h"
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -95,8 +98,17 @@ void heap_switch(void *base, size_t size) {
   } else {
     switched_heap_next = nullptr;
     switched_heap_remaining = 0;
-    set_malloc_hook(/*hook=*/nullptr, /*pool=*/nullptr);
-    set_realloc_hook(/*hook=*/nullptr, /*pool=*/nullptr);
-    set_free_hook(/*hook=*/nullptr, /*pool=*/nullptr);
+    if (enc_malloc_arenas_enabled()) {
+      // The switched heap temporarily replaced the arena hooks; reinstate
+      // them rather than dropping back to unhooked malloc.
+      enc_enable_malloc_arenas();
+    } else if (enc_heap_stats_enabled()) {
+      // Likewise for the standalone heap instrumentation hooks.
+      enc_enable_heap_stats();
+    } else {
+      set_malloc_hook(/*hook=*/nullptr, /*pool=*/nullptr);
+      set_realloc_hook(/*hook=*/nullptr, /*pool=*/nullptr);
+      set_free_hook(/*hook=*/nullptr, /*pool=*/nullptr);
+    }
   }
 }
@@ -0,0 +1,380 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// End-to-end macrobenchmarks for the enclave POSIX layer. Unlike the
+// primitives-layer microbenchmarks, these run whole workloads through the
+// public POSIX surface: fio-style file I/O patterns, socket echo round trips
+// over UNIX domain and IPv6 loopback transports via SocketClient and
+// SocketServer, and pthread mutex and condition variable contention.
+// Each scenario reports ops/sec and per-operation latency percentiles via
+// LOG(INFO); the assertions only check that the measured operations succeed.
+// Running the same binary under each backend (and as a plain host test)
+// yields the per-backend comparison.
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/flags/flag.h"
+#include "absl/strings/str_cat.h"
+#include "asylo/util/logging.h"
+#include "asylo/platform/posix/sockets/socket_client.h"
+#include "asylo/platform/posix/sockets/socket_server.h"
+#include "asylo/test/util/status_matchers.h"
+#include "asylo/test/util/test_flags.h"
+
+namespace asylo {
+namespace {
+
+constexpr char kLoopbackIpv6AddrStr[] = "::1";
+
+// Logical file size exercised by the file I/O scenarios.
+constexpr size_t kFileSize = 2 * 1024 * 1024;
+
+// I/O sizes exercised by the file I/O scenarios.
+constexpr size_t kFileIoSizes[] = {128, 4096, 65536};
+
+// Message sizes exercised by the socket echo scenarios.
+constexpr size_t kEchoMessageSizes[] = {64, 1024, 16384};
+
+// Echo round trips per (transport, message size) configuration.
+constexpr int kEchoRoundTrips = 2000;
+
+// Thread counts exercised by the mutex contention scenario.
+constexpr int kContentionThreadCounts[] = {1, 2, 4, 8};
+
+// Lock acquisitions per thread in the mutex contention scenario.
+constexpr int kAcquisitionsPerThread = 20000;
+
+// Condition variable ping-pong round trips.
+constexpr int kPingPongRoundTrips = 5000;
+
+// Returns the current monotonic time in microseconds. Note that reading the
+// clock from the enclave is itself a host call, so it bounds the resolution
+// of individual latency samples.
+double NowMicros() {
+  struct timespec ts;
+  CHECK_EQ(clock_gettime(CLOCK_MONOTONIC, &ts), 0);
+  return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+// Returns the |fraction| percentile of |latencies|, sorting them in place.
+double Percentile(std::vector<double> *latencies, double fraction) {
+  CHECK(!latencies->empty());
+  std::sort(latencies->begin(), latencies->end());
+  const size_t index =
+      static_cast<size_t>(fraction * (latencies->size() - 1) + 0.5);
+  return (*latencies)[index];
+}
+
+// Reports throughput for |ops| operations over |total_micros|, with latency
+// percentiles when per-operation samples were collected. |latencies| may be
+// null for scenarios whose per-operation cost is below clock resolution.
+void ReportStats(const std::string &scenario, size_t ops, double total_micros,
+                 std::vector<double> *latencies) {
+  std::string line = absl::StrCat(scenario, ": ops = ", ops, ", ops/sec = ",
+                                  static_cast<double>(ops) * 1e6 /
+                                      total_micros);
+  if (latencies != nullptr) {
+    absl::StrAppend(&line, ", p50 = ", Percentile(latencies, 0.5),
+                    " us, p95 = ", Percentile(latencies, 0.95),
+                    " us, p99 = ", Percentile(latencies, 0.99), " us");
+  }
+  LOG(INFO) << line;
+}
+
+// Runs the four fio-style access patterns for one I/O size: sequential
+// write, random overwrite, sequential read and random read.
+void RunFileIoConfiguration(const std::string &path, size_t io_size) {
+  const size_t num_ops = kFileSize / io_size;
+  ASSERT_GT(num_ops, 0);
+
+  std::vector<char> io_buffer(io_size, 0x5a);
+  std::vector<double> latencies;
+  latencies.reserve(num_ops);
+
+  // Offsets visited by the random patterns - a deterministic shuffle so runs
+  // are comparable.
+  std::vector<off_t> random_offsets(num_ops);
+  for (size_t op = 0; op < num_ops; op++) {
+    random_offsets[op] = op * io_size;
+  }
+  std::mt19937 generator(20260829);
+  std::shuffle(random_offsets.begin(), random_offsets.end(), generator);
+
+  unlink(path.c_str());
+  int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  ASSERT_GE(fd, 0);
+
+  // Sequential write populates the file.
+  double start = NowMicros();
+  for (size_t op = 0; op < num_ops; op++) {
+    const double op_start = NowMicros();
+    ASSERT_EQ(write(fd, io_buffer.data(), io_size), io_size);
+    latencies.push_back(NowMicros() - op_start);
+  }
+  ReportStats(absl::StrCat("file sequential write io_size=", io_size), num_ops,
+              NowMicros() - start, &latencies);
+
+  // Random overwrite.
+  latencies.clear();
+  start = NowMicros();
+  for (const off_t offset : random_offsets) {
+    const double op_start = NowMicros();
+    ASSERT_EQ(lseek(fd, offset, SEEK_SET), offset);
+    ASSERT_EQ(write(fd, io_buffer.data(), io_size), io_size);
+    latencies.push_back(NowMicros() - op_start);
+  }
+  ReportStats(absl::StrCat("file random write io_size=", io_size), num_ops,
+              NowMicros() - start, &latencies);
+
+  // Sequential read.
+  latencies.clear();
+  ASSERT_EQ(lseek(fd, 0, SEEK_SET), 0);
+  start = NowMicros();
+  for (size_t op = 0; op < num_ops; op++) {
+    const double op_start = NowMicros();
+    ASSERT_EQ(read(fd, io_buffer.data(), io_size), io_size);
+    latencies.push_back(NowMicros() - op_start);
+  }
+  ReportStats(absl::StrCat("file sequential read io_size=", io_size), num_ops,
+              NowMicros() - start, &latencies);
+
+  // Random read.
+  latencies.clear();
+  start = NowMicros();
+  for (const off_t offset : random_offsets) {
+    const double op_start = NowMicros();
+    ASSERT_EQ(lseek(fd, offset, SEEK_SET), offset);
+    ASSERT_EQ(read(fd, io_buffer.data(), io_size), io_size);
+    latencies.push_back(NowMicros() - op_start);
+  }
+  ReportStats(absl::StrCat("file random read io_size=", io_size), num_ops,
+              NowMicros() - start, &latencies);
+
+  ASSERT_EQ(close(fd), 0);
+  unlink(path.c_str());
+}
+
+// Parameters for the echo server thread.
+struct EchoServerArgs {
+  SocketServer *server;
+  size_t message_size;
+  int round_trips;
+};
+
+// Accepts one connection and echoes |round_trips| messages back to the
+// client. Runs on its own pthread; returns the iteration count on which a
+// socket operation first failed, or nullptr on full success.
+void *EchoServerThread(void *raw_args) {
+  auto *args = static_cast<EchoServerArgs *>(raw_args);
+  if (!args->server->ServerAccept().ok()) {
+    return args;
+  }
+  std::vector<char> buffer(args->message_size);
+  for (int round = 0; round < args->round_trips; round++) {
+    if (!args->server->Read(buffer.data(), buffer.size()).ok() ||
+        !args->server->Write(buffer.data(), buffer.size()).ok()) {
+      return args;
+    }
+  }
+  return nullptr;
+}
+
+// Runs the echo round trips against an already set up server, measuring each
+// write+read round trip on the client side.
+void RunEchoClient(SocketClient *client, const std::string &scenario,
+                   size_t message_size) {
+  std::vector<char> buffer(message_size, 0x5a);
+  std::vector<double> latencies;
+  latencies.reserve(kEchoRoundTrips);
+
+  const double start = NowMicros();
+  for (int round = 0; round < kEchoRoundTrips; round++) {
+    const double op_start = NowMicros();
+    ASSERT_THAT(client->Write(buffer.data(), buffer.size()), IsOk());
+    ASSERT_THAT(client->Read(buffer.data(), buffer.size()), IsOk());
+    latencies.push_back(NowMicros() - op_start);
+  }
+  ReportStats(scenario, kEchoRoundTrips, NowMicros() - start, &latencies);
+}
+
+// Shared state for the pthread contention scenarios.
+struct ContentionArgs {
+  pthread_mutex_t mu = PTHREAD_MUTEX_INITIALIZER;
+  int64_t counter = 0;
+};
+
+void *ContentionThread(void *raw_args) {
+  auto *args = static_cast<ContentionArgs *>(raw_args);
+  for (int op = 0; op < kAcquisitionsPerThread; op++) {
+    pthread_mutex_lock(&args->mu);
+    args->counter++;
+    pthread_mutex_unlock(&args->mu);
+  }
+  return nullptr;
+}
+
+// Shared state for the condition variable ping-pong scenario.
+struct PingPongArgs {
+  pthread_mutex_t mu = PTHREAD_MUTEX_INITIALIZER;
+  pthread_cond_t cv = PTHREAD_COND_INITIALIZER;
+  // Whose turn it is: false = ping (measuring thread), true = pong.
+  bool pong_turn = false;
+};
+
+void *PongThread(void *raw_args) {
+  auto *args = static_cast<PingPongArgs *>(raw_args);
+  pthread_mutex_lock(&args->mu);
+  for (int round = 0; round < kPingPongRoundTrips; round++) {
+    while (!args->pong_turn) {
+      pthread_cond_wait(&args->cv, &args->mu);
+    }
+    args->pong_turn = false;
+    pthread_cond_signal(&args->cv);
+  }
+  pthread_mutex_unlock(&args->mu);
+  return nullptr;
+}
+
+TEST(PosixBenchmarks, FileIo) {
+  const std::string path =
+      absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir), "/PosixBenchmarks.dat");
+  for (const size_t io_size : kFileIoSizes) {
+    RunFileIoConfiguration(path, io_size);
+  }
+}
+
+TEST(PosixBenchmarks, DomainSocketEcho) {
+  for (const size_t message_size : kEchoMessageSizes) {
+    const std::string socket_name =
+        absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir),
+                     "/PosixBenchmarks_echo_", message_size);
+    unlink(socket_name.c_str());
+
+    SocketServer server;
+    ASSERT_THAT(server.ServerSetup(socket_name, /*use_path_len=*/false),
+                IsOk());
+    EchoServerArgs args = {&server, message_size, kEchoRoundTrips};
+    pthread_t server_thread;
+    ASSERT_EQ(pthread_create(&server_thread, nullptr, EchoServerThread, &args),
+              0);
+
+    SocketClient client;
+    ASSERT_THAT(client.ClientSetup(socket_name, /*out_addr=*/nullptr,
+                                   /*use_path_len=*/false),
+                IsOk());
+    RunEchoClient(&client,
+                  absl::StrCat("domain socket echo message_size=",
+                               message_size),
+                  message_size);
+
+    void *server_result;
+    ASSERT_EQ(pthread_join(server_thread, &server_result), 0);
+    EXPECT_EQ(server_result, nullptr);
+    unlink(socket_name.c_str());
+  }
+}
+
+TEST(PosixBenchmarks, Inet6SocketEcho) {
+  for (const size_t message_size : kEchoMessageSizes) {
+    SocketServer server;
+    ASSERT_THAT(server.ServerSetup(/*server_port=*/0), IsOk());
+    const int port = server.GetPort();
+    ASSERT_GT(port, 0);
+    EchoServerArgs args = {&server, message_size, kEchoRoundTrips};
+    pthread_t server_thread;
+    ASSERT_EQ(pthread_create(&server_thread, nullptr, EchoServerThread, &args),
+              0);
+
+    SocketClient client;
+    ASSERT_THAT(client.ClientSetup(kLoopbackIpv6AddrStr, port,
+                                   /*out_addr=*/nullptr),
+                IsOk());
+    RunEchoClient(
+        &client,
+        absl::StrCat("inet6 socket echo message_size=", message_size),
+        message_size);
+
+    void *server_result;
+    ASSERT_EQ(pthread_join(server_thread, &server_result), 0);
+    EXPECT_EQ(server_result, nullptr);
+  }
+}
+
+TEST(PosixBenchmarks, MutexContention) {
+  for (const int num_threads : kContentionThreadCounts) {
+    ContentionArgs args;
+    std::vector<pthread_t> threads(num_threads);
+
+    const double start = NowMicros();
+    for (pthread_t &thread : threads) {
+      ASSERT_EQ(pthread_create(&thread, nullptr, ContentionThread, &args), 0);
+    }
+    for (pthread_t &thread : threads) {
+      ASSERT_EQ(pthread_join(thread, nullptr), 0);
+    }
+    const double total_micros = NowMicros() - start;
+
+    const size_t total_ops =
+        static_cast<size_t>(num_threads) * kAcquisitionsPerThread;
+    ASSERT_EQ(args.counter, total_ops);
+    // Individual acquisitions are below clock resolution, so only aggregate
+    // throughput is reported.
+    ReportStats(absl::StrCat("mutex contention threads=", num_threads),
+                total_ops, total_micros, nullptr);
+  }
+}
+
+TEST(PosixBenchmarks, CondvarPingPong) {
+  PingPongArgs args;
+  pthread_t pong_thread;
+  ASSERT_EQ(pthread_create(&pong_thread, nullptr, PongThread, &args), 0);
+
+  std::vector<double> latencies;
+  latencies.reserve(kPingPongRoundTrips);
+
+  const double start = NowMicros();
+  pthread_mutex_lock(&args.mu);
+  for (int round = 0; round < kPingPongRoundTrips; round++) {
+    const double op_start = NowMicros();
+    args.pong_turn = true;
+    pthread_cond_signal(&args.cv);
+    while (args.pong_turn) {
+      pthread_cond_wait(&args.cv, &args.mu);
+    }
+    latencies.push_back(NowMicros() - op_start);
+  }
+  pthread_mutex_unlock(&args.mu);
+  const double total_micros = NowMicros() - start;
+
+  ASSERT_EQ(pthread_join(pong_thread, nullptr), 0);
+  ReportStats("condvar ping-pong", kPingPongRoundTrips, total_micros,
+              &latencies);
+}
+
+}  // namespace
+}  // namespace asylo
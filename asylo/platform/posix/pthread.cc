@@ -19,7 +19,6 @@
 #include <pthread.h>
 #include <sched.h>
 #include <signal.h>
-#include <sys/mman.h>
 
 #include <array>
 #include <bitset>
@@ -50,6 +49,18 @@ static pthread_rwlock_t key_lock = PTHREAD_RWLOCK_INITIALIZER;
 static void NoDestructor(void *placeholder) {}
 size_t __pthread_tsd_size = sizeof(void *) * PTHREAD_KEYS_MAX;
 
+using asylo::pthread_impl::kNumReservedTsdKeys;
+
+static_assert(kNumReservedTsdKeys < PTHREAD_KEYS_MAX,
+              "Reserved TSD keys must leave room for application keys.");
+
+// Fixed per-thread storage for the reserved runtime-internal keys. Because
+// this is a thread_local array with a compile-time size, a getspecific() on a
+// reserved key is a TLS-register-relative load with no allocation check and
+// no pthread_self() indirection. The heap-allocated tsd block hanging off
+// __pthread_info is only consulted for application keys.
+thread_local void *reserved_tsd[kNumReservedTsdKeys] = {};
+
 inline int pthread_spin_lock(pthread_spinlock_t *lock) {
   constexpr unsigned int kLocked = 1;
   constexpr unsigned int kUnlocked = 0;
@@ -101,6 +112,37 @@ class LockableGuard {
   pthread_spinlock_t *const lock_;
 };
 
+// Maps a condition variable to the mutex most recently passed with it to
+// pthread_cond_timedwait(). pthread_cond_t has no field recording the
+// association, so a small fixed-size hash table keeps it on the side. A
+// collision simply evicts an older binding, which only costs a missed requeue
+// optimization on the next broadcast of the evicted condition variable.
+constexpr size_t kCondMutexTableSize = 64;
+
+struct CondMutexBinding {
+  pthread_cond_t *cond;
+  pthread_mutex_t *mutex;
+};
+
+CondMutexBinding cond_mutex_table[kCondMutexTableSize] = {};
+pthread_spinlock_t cond_mutex_table_lock = PTHREAD_SPINLOCK_INITIALIZER;
+
+size_t cond_mutex_table_slot(const pthread_cond_t *cond) {
+  return (reinterpret_cast<uintptr_t>(cond) >> 4) % kCondMutexTableSize;
+}
+
+void record_cond_mutex(pthread_cond_t *cond, pthread_mutex_t *mutex) {
+  LockableGuard lock_guard(&cond_mutex_table_lock);
+  cond_mutex_table[cond_mutex_table_slot(cond)] = {cond, mutex};
+}
+
+pthread_mutex_t *lookup_cond_mutex(pthread_cond_t *cond) {
+  LockableGuard lock_guard(&cond_mutex_table_lock);
+  const CondMutexBinding &binding =
+      cond_mutex_table[cond_mutex_table_slot(cond)];
+  return binding.cond == cond ? binding.mutex : nullptr;
+}
+
 __pthread_list_node_t *alloc_list_node(pthread_t thread_id) {
   __pthread_list_node_t *node = new __pthread_list_node_t;
   node->_thread_id = thread_id;
@@ -282,9 +324,17 @@ void pthread_tsd_run_destructors() {
       reinterpret_cast<struct __pthread_info *>(pthread_self());
   pthread_rwlock_rdlock(&key_lock);
   for (int i = 0; i < PTHREAD_KEYS_MAX; ++i) {
-    void *val = self->tsd[i];
+    void *val;
+    if (i < kNumReservedTsdKeys) {
+      val = reserved_tsd[i];
+      reserved_tsd[i] = nullptr;
+    } else if (self->tsd) {
+      val = self->tsd[i];
+      self->tsd[i] = nullptr;
+    } else {
+      continue;
+    }
     void (*destructor)(void *) = tsd_destructors[i];
-    self->tsd[i] = nullptr;
     if (val && destructor && destructor != NoDestructor) {
       destructor(val);
     }
@@ -406,11 +456,46 @@ void QueueOperations::Clear() {
   }
 }
 
+void QueueOperations::MoveAllTo(QueueOperations *target) {
+  if (!list_->_first) {
+    return;
+  }
+
+  if (!target->list_->_first) {
+    target->list_->_first = list_->_first;
+  } else {
+    __pthread_list_node_t *current = target->list_->_first;
+    while (current->_next) {
+      current = current->_next;
+    }
+    current->_next = list_->_first;
+  }
+  list_->_first = nullptr;
+}
+
 bool QueueOperations::Empty() const {
   const __pthread_list_node_t *current = list_->_first;
   return current == nullptr;
 }
 
+int ReservedKeyCreate(pthread_key_t *key, void (*destructor)(void *)) {
+  if (!destructor) {
+    destructor = NoDestructor;
+  }
+  pthread_rwlock_wrlock(&key_lock);
+  for (pthread_key_t next_key = 0; next_key < kNumReservedTsdKeys;
+       ++next_key) {
+    if (!tsd_destructors[next_key]) {
+      tsd_destructors[next_key] = destructor;
+      *key = next_key;
+      pthread_rwlock_unlock(&key_lock);
+      return 0;
+    }
+  }
+  pthread_rwlock_unlock(&key_lock);
+  return EAGAIN;
+}
+
 }  //  namespace pthread_impl
 }  //  namespace asylo
 
@@ -433,12 +518,13 @@ int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
   // The order is __pthread_info struct, then start function.
   size_t size = sizeof(struct __pthread_info) + sizeof(struct start_args) +
                 __pthread_tsd_size;
-  void *tls = mmap(/*addr=*/nullptr, size, PROT_READ | PROT_WRITE,
-                   MAP_PRIVATE | MAP_ANON, /*fd=*/-1, /*offset=*/0);
-  if (tls == MAP_FAILED) {
+  // Allocated through the ThreadManager's TLS block pool so burst-parallel
+  // workloads reuse the block of a completed thread instead of mapping fresh
+  // enclave memory per pthread_create(). The block is returned zeroed.
+  void *tls = asylo::ThreadManager::GetInstance()->AllocateThreadTls(size);
+  if (tls == nullptr) {
     return -1;
   }
-  memset(tls, 0, size);
   auto thread_data = reinterpret_cast<struct __pthread_info *>(tls);
   thread_data->self = thread_data;
   thread_data->tls_size = size;
@@ -486,7 +572,10 @@ int pthread_key_create(pthread_key_t *key, void (*destructor)(void *)) {
     destructor = NoDestructor;
   }
   pthread_rwlock_wrlock(&key_lock);
-  for (pthread_key_t next_key = 0; next_key < PTHREAD_KEYS_MAX; ++next_key) {
+  // Keys below kNumReservedTsdKeys belong to the runtime-internal reserved
+  // block and are handed out by asylo::pthread_impl::ReservedKeyCreate().
+  for (pthread_key_t next_key = kNumReservedTsdKeys;
+       next_key < PTHREAD_KEYS_MAX; ++next_key) {
     if (!tsd_destructors[next_key]) {
       tsd_destructors[next_key] = destructor;
       *key = next_key;
@@ -509,20 +598,33 @@ int pthread_key_delete(pthread_key_t key) {
 }
 
 void *pthread_getspecific(pthread_key_t key) {
+  // Reserved runtime-internal keys resolve directly against the fixed
+  // thread_local block: a bounds check and a TLS-relative load.
+  if (key < kNumReservedTsdKeys) {
+    return reserved_tsd[key];
+  }
+
   // Behavior if the key wasn't obtained through pthread_key_create is
   // undefined.
   if (key >= PTHREAD_KEYS_MAX) {
     return nullptr;
   }
 
-  if (!CheckAndAllocateThreadSpecificData()) {
+  // If the tsd block has not been allocated, no value has ever been stored
+  // for this thread, so the value is the initial NULL; reads never allocate.
+  auto self = reinterpret_cast<struct __pthread_info *>(pthread_self());
+  if (!self->tsd) {
     return nullptr;
   }
-  auto self = reinterpret_cast<struct __pthread_info *>(pthread_self());
   return self->tsd[key];
 }
 
 int pthread_setspecific(pthread_key_t key, const void *value) {
+  if (key < kNumReservedTsdKeys) {
+    reserved_tsd[key] = const_cast<void *>(value);
+    return 0;
+  }
+
   // Behavior if the key wasn't obtained through pthread_key_create is
   // undefined.
   if (key >= PTHREAD_KEYS_MAX) {
@@ -718,6 +820,10 @@ int pthread_cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *mutex,
     LockableGuard lock_guard(cond);
     initialize_wait_queue(&cond->_untrusted_wait_queue);
   }
+
+  // Remember which mutex guards this condition variable so that a broadcast
+  // can requeue the sleeping waiters onto the mutex's wait queue.
+  record_cond_mutex(cond, mutex);
 #endif
 
   asylo::pthread_impl::QueueOperations list(cond);
@@ -775,6 +881,14 @@ int pthread_cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *mutex,
     LockableGuard lock_guard(cond);
     list.Remove(self);
   }
+  // A broadcast may have transplanted this thread's list entry onto the mutex
+  // while requeueing it; drop the entry now that the thread is awake so that
+  // pthread_mutex_unlock() stops notifying on its behalf.
+  {
+    LockableGuard lock_guard(mutex);
+    asylo::pthread_impl::QueueOperations mutex_list(mutex);
+    mutex_list.Remove(self);
+  }
 
   if (deadline) {
     // Check if awoken up due to timeout.
@@ -859,10 +973,33 @@ int pthread_cond_notify_internal(pthread_cond_t *cond, int num_threads) {
   if (cond->_untrusted_wait_queue != nullptr) {
     asylo::pthread_impl::QueueOperations list(cond);
     const int32_t self = static_cast<int32_t>(pthread_self());
+    // A broadcast tries to morph all but one waiter onto the associated
+    // mutex's wait queue instead of waking them, so that the woken threads do
+    // not all re-enter the enclave at once just to block on the mutex again.
+    pthread_mutex_t *mutex =
+        num_threads > 1 ? lookup_cond_mutex(cond) : nullptr;
     LockableGuard lock_guard(cond);
     enc_untrusted_wait_queue_set_value(cond->_untrusted_wait_queue, self);
     if (!list.Empty()) {
-      enc_untrusted_notify(cond->_untrusted_wait_queue, num_threads);
+      bool requeued = false;
+      if (mutex != nullptr && mutex->_untrusted_wait_queue != nullptr) {
+        LockableGuard mutex_guard(mutex);
+        // Requeueing is only safe while the broadcaster holds the mutex; a
+        // later pthread_mutex_unlock() is then guaranteed to wake the moved
+        // waiters. Transplant the waiters' trusted list entries onto the
+        // mutex so that unlock keeps notifying while any of them sleep.
+        if (mutex->_owner == pthread_self()) {
+          asylo::pthread_impl::QueueOperations mutex_list(mutex);
+          list.MoveAllTo(&mutex_list);
+          enc_untrusted_notify_and_requeue(cond->_untrusted_wait_queue,
+                                           /*num_wake=*/1,
+                                           mutex->_untrusted_wait_queue);
+          requeued = true;
+        }
+      }
+      if (!requeued) {
+        enc_untrusted_notify(cond->_untrusted_wait_queue, num_threads);
+      }
     }
   }
 #else
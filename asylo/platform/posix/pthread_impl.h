@@ -51,6 +51,9 @@ class QueueOperations {
   // Removes all ids from the list.
   void Clear();
 
+  // Appends every id in this list to |target| and leaves this list empty.
+  void MoveAllTo(QueueOperations *target);
+
   // Returns true of the |id| is in the list.
   bool Contains(const pthread_t id) const;
 
@@ -84,6 +87,23 @@ class PthreadMutexLock {
   pthread_mutex_t *const mutex_;
 };
 
+// Number of pthread keys reserved for runtime-internal use. Values for keys
+// in [0, kNumReservedTsdKeys) live in a fixed thread_local array rather than
+// the heap-allocated per-thread TSD block, so pthread_getspecific() on a
+// reserved key compiles down to a bounds check and a TLS-relative load with
+// no allocation check or pthread_self() indirection. Runtime components with
+// TLS reads on hot paths (arena allocators, per-thread metrics) should
+// allocate their keys through ReservedKeyCreate(). Application keys created
+// with pthread_key_create() are assigned from kNumReservedTsdKeys upward.
+constexpr pthread_key_t kNumReservedTsdKeys = 8;
+
+// Creates a pthread key in the reserved runtime-internal block. Semantics
+// match pthread_key_create(), including destructor handling at thread exit;
+// the returned key works with the standard pthread_getspecific() and
+// pthread_setspecific() entry points. Returns EAGAIN if all reserved keys are
+// in use.
+int ReservedKeyCreate(pthread_key_t *key, void (*destructor)(void *));
+
 }  // namespace pthread_impl
 }  // namespace asylo
 
@@ -23,6 +23,19 @@
 #include <bitset>
 
 #include "asylo/platform/host_call/trusted/host_calls.h"
+#include "asylo/platform/posix/threading/thread_manager.h"
+#include "asylo/platform/primitives/trusted_runtime.h"
+
+namespace {
+
+// Number of sched_yield() calls served by spinning inside the enclave before a
+// call is allowed to escalate to the host.
+constexpr int kInEnclaveYieldBudget = 64;
+
+// Number of enc_pause() executions per in-enclave yield.
+constexpr int kPausesPerYield = 64;
+
+}  // namespace
 
 inline size_t WordNum(int cpu) { return cpu / (8 * sizeof(CpuSetWord)); }
 
@@ -78,7 +91,23 @@ int sched_setaffinity(pid_t pid, size_t cpusetsize, const cpu_set_t *cpuset) {
   return -1;
 }
 
-int sched_yield() { return enc_untrusted_sched_yield(); }
+int sched_yield() {
+  // Yielding to the host costs a full enclave exit, which turns spin-wait
+  // loops built on sched_yield() into exit storms. While other enclave threads
+  // are running and can make progress, yield cooperatively by pausing inside
+  // the enclave, and only escalate to the host once the caller exhausts its
+  // in-enclave budget.
+  thread_local int yield_budget = kInEnclaveYieldBudget;
+  if (asylo::ThreadManager::GetInstance()->RunningThreadCount() > 0 &&
+      --yield_budget > 0) {
+    for (int i = 0; i < kPausesPerYield; ++i) {
+      enc_pause();
+    }
+    return 0;
+  }
+  yield_budget = kInEnclaveYieldBudget;
+  return enc_untrusted_sched_yield();
+}
 
 int sched_getcpu(void) {
   errno = ENOSYS;
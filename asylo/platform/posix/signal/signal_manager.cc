@@ -40,6 +40,11 @@ sigset_t EmptySigSet() {
 
 thread_local sigset_t SignalManager::signal_mask_ = EmptySigSet();
 
+thread_local sigset_t SignalManager::pending_signals_ = EmptySigSet();
+
+thread_local std::array<siginfo_t, kNumberSignals>
+    SignalManager::pending_signal_info_ = {};
+
 // Initialize the spin locks to be recursive so that signal handling does not
 // cause deadlock if a signal arrives while the thread is registering a signal.
 SignalManager::SignalManager() : signal_maps_lock_(/*is_recursive=*/true) {
@@ -52,6 +57,12 @@ SignalManager *SignalManager::GetInstance() {
 }
 
 void SignalManager::HandleSignal(int signum, siginfo_t *info, void *ucontext) {
+  // The trusted mask is authoritative: a signal blocked by this thread is
+  // queued here rather than delivered, regardless of the host's mask state.
+  if (IsSignalBlocked(signum)) {
+    EnqueuePendingSignal(signum, info);
+    return;
+  }
   struct sigaction act;
   // Return if the signal handler is already reset to default.
   if (GetResetStatus(signum) == ResetStatus::RESET ||
@@ -72,6 +83,9 @@ void SignalManager::HandleSignal(int signum, siginfo_t *info, void *ucontext) {
     act.sa_handler(signum);
   }
   SetSignalMask(old_mask);
+  // Signals masked while the handler ran may have queued; restore them now
+  // that the previous mask is back in effect.
+  DeliverPendingSignals();
 }
 
 void SignalManager::SetSigAction(int signum, const struct sigaction &act) {
@@ -119,6 +133,45 @@ void SignalManager::UnblockSignals(const sigset_t &set) {
   }
 }
 
+bool SignalManager::IsSignalBlocked(int signum) const {
+  return signum >= 0 && signum < kNumberSignals &&
+         sigismember(&signal_mask_, signum) == 1;
+}
+
+void SignalManager::EnqueuePendingSignal(int signum, const siginfo_t *info) {
+  if (signum < 0 || signum >= kNumberSignals) {
+    return;
+  }
+  if (info) {
+    pending_signal_info_[signum] = *info;
+  } else {
+    pending_signal_info_[signum] = {};
+    pending_signal_info_[signum].si_signo = signum;
+  }
+  sigaddset(&pending_signals_, signum);
+}
+
+void SignalManager::DeliverPendingSignals() {
+  // A handler run below may itself adjust the mask and re-enter here; deliver
+  // from the outermost call only.
+  thread_local static bool delivering = false;
+  if (delivering) {
+    return;
+  }
+  delivering = true;
+  for (int signum = 0; signum < kNumberSignals; ++signum) {
+    if (sigismember(&pending_signals_, signum) == 1 &&
+        !IsSignalBlocked(signum)) {
+      sigdelset(&pending_signals_, signum);
+      siginfo_t info = pending_signal_info_[signum];
+      // The interrupted context is long gone, so deferred delivery passes a
+      // null ucontext, as for a signal arriving while outside the enclave.
+      HandleSignal(signum, &info, /*ucontext=*/nullptr);
+    }
+  }
+  delivering = false;
+}
+
 sigset_t SignalManager::GetSignalMask() const { return signal_mask_; }
 
 void SignalManager::SetSignalMask(const sigset_t &mask) { signal_mask_ = mask; }
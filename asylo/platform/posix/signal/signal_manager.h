@@ -21,6 +21,7 @@
 
 #include <signal.h>
 
+#include <array>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -47,9 +48,19 @@ class SignalManager {
 
   static SignalManager *GetInstance();
 
-  // Locates and calls the handler registered for |signum|.
+  // Locates and calls the handler registered for |signum|. The thread-local
+  // signal mask is authoritative at delivery time: if the calling thread
+  // blocks |signum|, the signal is queued and delivered once a mask change
+  // unblocks it.
   void HandleSignal(int signum, siginfo_t *info, void *ucontext);
 
+  // Returns true if the calling thread's signal mask blocks |signum|.
+  bool IsSignalBlocked(int signum) const;
+
+  // Delivers any signals queued on the calling thread that are no longer
+  // blocked by its signal mask. Called after mask updates.
+  void DeliverPendingSignals();
+
   // Sets a signal handler pointer for a specific signal |signum|.
   void SetSigAction(int signum, const struct sigaction &act);
 
@@ -81,6 +92,11 @@ class SignalManager {
   ResetStatus GetResetStatus(int signum);
 
  private:
+  // Queues |signum| and its delivery information on the calling thread until
+  // the thread's mask stops blocking it. Queuing follows standard (non
+  // real-time) signal semantics: at most one instance of each signal is held.
+  void EnqueuePendingSignal(int signum, const siginfo_t *info);
+
   SignalManager();  // Private to enforce singleton.
   SignalManager(SignalManager const &) = delete;
   void operator=(SignalManager const &) = delete;
@@ -95,6 +111,13 @@ class SignalManager {
   std::array<ResetStatus, kNumberSignals> signal_to_reset_;
 
   thread_local static sigset_t signal_mask_;
+
+  // Signals that arrived while blocked by the calling thread's mask, and the
+  // delivery information recorded when each was queued. Thread-local, so no
+  // locking is needed.
+  thread_local static sigset_t pending_signals_;
+  thread_local static std::array<siginfo_t, kNumberSignals>
+      pending_signal_info_;
 };
 
 }  // namespace asylo
@@ -0,0 +1,233 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/posix/sockets/addrinfo_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <utility>
+
+namespace asylo {
+namespace {
+
+// Returns the monotonic clock reading in seconds, or -1 on failure. A failed
+// reading disables the cache for that call rather than serving an entry of
+// unknown age.
+int64_t MonotonicSeconds() {
+  struct timespec now;
+  if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+    return -1;
+  }
+  return static_cast<int64_t>(now.tv_sec);
+}
+
+// Frees an addrinfo chain laid out the way this cache and
+// enc_untrusted_getaddrinfo() allocate them: every node, ai_addr and
+// ai_canonname is an individual malloc() allocation.
+void FreeAddrinfoChain(struct addrinfo *info) {
+  while (info != nullptr) {
+    struct addrinfo *next = info->ai_next;
+    free(info->ai_addr);
+    free(info->ai_canonname);
+    free(info);
+    info = next;
+  }
+}
+
+// Returns a deep copy of |info| with the allocation layout described above,
+// or nullptr if any allocation fails.
+struct addrinfo *CopyAddrinfoChain(const struct addrinfo *info) {
+  struct addrinfo *head = nullptr;
+  struct addrinfo **tail = &head;
+  for (; info != nullptr; info = info->ai_next) {
+    auto *copy =
+        static_cast<struct addrinfo *>(malloc(sizeof(struct addrinfo)));
+    if (copy == nullptr) {
+      FreeAddrinfoChain(head);
+      return nullptr;
+    }
+    memset(copy, 0, sizeof(*copy));
+    copy->ai_flags = info->ai_flags;
+    copy->ai_family = info->ai_family;
+    copy->ai_socktype = info->ai_socktype;
+    copy->ai_protocol = info->ai_protocol;
+    *tail = copy;
+    tail = &copy->ai_next;
+    if (info->ai_addr != nullptr && info->ai_addrlen > 0) {
+      copy->ai_addr = static_cast<struct sockaddr *>(malloc(info->ai_addrlen));
+      if (copy->ai_addr == nullptr) {
+        FreeAddrinfoChain(head);
+        return nullptr;
+      }
+      memcpy(copy->ai_addr, info->ai_addr, info->ai_addrlen);
+      copy->ai_addrlen = info->ai_addrlen;
+    }
+    if (info->ai_canonname != nullptr) {
+      copy->ai_canonname = strdup(info->ai_canonname);
+      if (copy->ai_canonname == nullptr) {
+        FreeAddrinfoChain(head);
+        return nullptr;
+      }
+    }
+  }
+  return head;
+}
+
+// Builds the key shared by all hints variants of a |node| and |service| pair.
+// A null pointer and an empty string must key differently, so null is encoded
+// as a marker byte that cannot appear in a C string.
+std::string MakeNameKey(const char *node, const char *service) {
+  std::string key;
+  key.append(node != nullptr ? node : "\1");
+  key.push_back('\0');
+  key.append(service != nullptr ? service : "\1");
+  return key;
+}
+
+// Appends the hints fields that affect the host's answer to |name_key|. Only
+// the four fields enc_untrusted_getaddrinfo() forwards participate.
+std::string MakeEntryKey(std::string name_key, const struct addrinfo *hints) {
+  name_key.push_back('\0');
+  if (hints == nullptr) {
+    name_key.push_back('\1');
+    return name_key;
+  }
+  const int fields[] = {hints->ai_flags, hints->ai_family, hints->ai_socktype,
+                        hints->ai_protocol};
+  name_key.append(reinterpret_cast<const char *>(fields), sizeof(fields));
+  return name_key;
+}
+
+}  // namespace
+
+AddrinfoCache &AddrinfoCache::GetInstance() {
+  static AddrinfoCache *instance = new AddrinfoCache();
+  return *instance;
+}
+
+bool AddrinfoCache::Lookup(const char *node, const char *service,
+                           const struct addrinfo *hints,
+                           struct addrinfo **res) {
+  const std::string key = MakeEntryKey(MakeNameKey(node, service), hints);
+  const int64_t now = MonotonicSeconds();
+  if (now < 0) {
+    return false;
+  }
+  absl::MutexLock lock(&mu_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return false;
+  }
+  if (it->second->expiry <= now) {
+    EvictLocked(it->second);
+    return false;
+  }
+  struct addrinfo *copy = CopyAddrinfoChain(it->second->result);
+  if (copy == nullptr) {
+    return false;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  *res = copy;
+  return true;
+}
+
+void AddrinfoCache::Insert(const char *node, const char *service,
+                           const struct addrinfo *hints,
+                           const struct addrinfo *res) {
+  const int64_t now = MonotonicSeconds();
+  if (now < 0) {
+    return;
+  }
+  std::string name_key = MakeNameKey(node, service);
+  std::string key = MakeEntryKey(name_key, hints);
+  struct addrinfo *copy = CopyAddrinfoChain(res);
+  if (copy == nullptr) {
+    return;
+  }
+  absl::MutexLock lock(&mu_);
+  if (ttl_seconds_ == 0 || capacity_ == 0) {
+    FreeAddrinfoChain(copy);
+    return;
+  }
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    EvictLocked(it->second);
+  }
+  lru_.emplace_front(
+      Entry{std::move(key), std::move(name_key), copy, now + ttl_seconds_});
+  index_.emplace(lru_.front().key, lru_.begin());
+  while (lru_.size() > capacity_) {
+    EvictLocked(--lru_.end());
+  }
+}
+
+void AddrinfoCache::Invalidate(const char *node, const char *service) {
+  const std::string name_key = MakeNameKey(node, service);
+  absl::MutexLock lock(&mu_);
+  for (auto it = lru_.begin(); it != lru_.end();) {
+    auto current = it++;
+    if (current->name_key == name_key) {
+      EvictLocked(current);
+    }
+  }
+}
+
+void AddrinfoCache::Clear() {
+  absl::MutexLock lock(&mu_);
+  while (!lru_.empty()) {
+    EvictLocked(lru_.begin());
+  }
+}
+
+void AddrinfoCache::set_ttl_seconds(int64_t ttl_seconds) {
+  absl::MutexLock lock(&mu_);
+  ttl_seconds_ = ttl_seconds;
+}
+
+int64_t AddrinfoCache::ttl_seconds() const {
+  absl::MutexLock lock(&mu_);
+  return ttl_seconds_;
+}
+
+void AddrinfoCache::set_capacity(size_t capacity) {
+  absl::MutexLock lock(&mu_);
+  capacity_ = capacity;
+  while (lru_.size() > capacity_) {
+    EvictLocked(--lru_.end());
+  }
+}
+
+size_t AddrinfoCache::capacity() const {
+  absl::MutexLock lock(&mu_);
+  return capacity_;
+}
+
+size_t AddrinfoCache::size() const {
+  absl::MutexLock lock(&mu_);
+  return lru_.size();
+}
+
+void AddrinfoCache::EvictLocked(std::list<Entry>::iterator it) {
+  FreeAddrinfoChain(it->result);
+  index_.erase(it->key);
+  lru_.erase(it);
+}
+
+}  // namespace asylo
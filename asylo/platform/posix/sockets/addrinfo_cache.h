@@ -0,0 +1,144 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_POSIX_SOCKETS_ADDRINFO_CACHE_H_
+#define ASYLO_PLATFORM_POSIX_SOCKETS_ADDRINFO_CACHE_H_
+
+#include <netdb.h>
+#include <stdint.h>
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace asylo {
+
+// Default lifetime of a cached resolution result, in seconds. getaddrinfo()
+// does not surface the resolver's record TTLs, so the cache applies one
+// configurable lifetime to every entry.
+constexpr int64_t kDefaultAddrinfoCacheTtlSeconds = 30;
+
+// Default capacity of the resolution cache, in entries.
+constexpr size_t kDefaultAddrinfoCacheCapacity = 64;
+
+// A trusted-side cache of getaddrinfo() resolution results. Every resolution
+// costs an enclave exit plus serialization of the returned addrinfo chain;
+// clients that resolve the same small set of service names continuously pay
+// that cost on every call. The cache keeps a deep copy of each successful
+// result, keyed by node, service and the hints fields that affect the host's
+// answer, and serves repeat lookups without leaving the enclave until the
+// entry's TTL lapses.
+//
+// Entries are evicted least recently used when the cache is over capacity and
+// lazily when a lookup finds them expired. A name whose address changed
+// before its TTL lapsed can be dropped explicitly with Invalidate(), or the
+// whole cache with Clear(). A TTL or capacity of zero disables caching.
+//
+// The cache is thread-safe. Lookup results are deep copies allocated with
+// malloc(), laid out exactly like the chains enc_untrusted_getaddrinfo()
+// deserializes, so callers release them with freeaddrinfo() as usual.
+class AddrinfoCache {
+ public:
+  // Returns the process-wide resolution cache shared by all getaddrinfo()
+  // callers.
+  static AddrinfoCache &GetInstance();
+
+  // Looks up an unexpired cached result for |node|, |service| and |hints|. On
+  // a hit, points |*res| at a freshly allocated deep copy of the cached chain
+  // and returns true. Returns false on a miss, on an expired entry, or when
+  // copying the chain fails.
+  bool Lookup(const char *node, const char *service,
+              const struct addrinfo *hints, struct addrinfo **res);
+
+  // Caches a deep copy of the successful resolution |res| for |node|,
+  // |service| and |hints|, evicting the least recently used entries while the
+  // cache is over capacity. A no-op when the TTL or capacity is zero or the
+  // copy fails; the caller's chain is never taken over.
+  void Insert(const char *node, const char *service,
+              const struct addrinfo *hints, const struct addrinfo *res);
+
+  // Drops every cached result for the |node| and |service| pair, across all
+  // hints it was resolved with.
+  void Invalidate(const char *node, const char *service);
+
+  // Drops all cached results.
+  void Clear();
+
+  // Sets the lifetime applied to entries cached from now on. Zero disables
+  // caching; already-cached entries keep their original expiry.
+  void set_ttl_seconds(int64_t ttl_seconds);
+  int64_t ttl_seconds() const;
+
+  // Caps the cache at |capacity| entries, evicting the least recently used
+  // ones if it is currently larger. Zero disables caching.
+  void set_capacity(size_t capacity);
+  size_t capacity() const;
+
+  // Returns the number of entries currently cached, including any whose TTL
+  // has lapsed but which no lookup has retired yet.
+  size_t size() const;
+
+  AddrinfoCache(const AddrinfoCache &) = delete;
+  AddrinfoCache &operator=(const AddrinfoCache &) = delete;
+
+ private:
+  struct Entry {
+    // Full cache key: name key plus the hints fields.
+    std::string key;
+
+    // Key shared by all hints variants of a node/service pair, matched by
+    // Invalidate().
+    std::string name_key;
+
+    // Deep copy of the resolution result, owned by the cache.
+    struct addrinfo *result;
+
+    // Monotonic deadline after which the entry no longer serves lookups.
+    int64_t expiry;
+  };
+
+  AddrinfoCache() = default;
+  ~AddrinfoCache() = default;  // The singleton is never destroyed.
+
+  // Frees |entry|'s result chain and removes it from the index and the LRU
+  // list.
+  void EvictLocked(std::list<Entry>::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  mutable absl::Mutex mu_;
+
+  // Entries ordered from most to least recently used. Avoid using absl based
+  // containers which may perform system calls, as this class is used below
+  // the layers that implement them.
+  std::list<Entry> lru_ ABSL_GUARDED_BY(mu_);
+
+  // Index from full cache key to the entry's position in lru_.
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_
+      ABSL_GUARDED_BY(mu_);
+
+  int64_t ttl_seconds_ ABSL_GUARDED_BY(mu_) = kDefaultAddrinfoCacheTtlSeconds;
+  size_t capacity_ ABSL_GUARDED_BY(mu_) = kDefaultAddrinfoCacheCapacity;
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_POSIX_SOCKETS_ADDRINFO_CACHE_H_
@@ -0,0 +1,182 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/posix/sockets/addrinfo_cache.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include <gtest/gtest.h>
+
+namespace asylo {
+namespace {
+
+// Builds a one-node resolution result on the stack. |storage| and |addr| must
+// outlive the returned addrinfo.
+struct addrinfo MakeResult(struct sockaddr_in *addr, uint16_t port,
+                           char *canonname) {
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_family = AF_INET;
+  addr->sin_port = htons(port);
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  struct addrinfo result;
+  memset(&result, 0, sizeof(result));
+  result.ai_family = AF_INET;
+  result.ai_socktype = SOCK_STREAM;
+  result.ai_protocol = IPPROTO_TCP;
+  result.ai_addrlen = sizeof(*addr);
+  result.ai_addr = reinterpret_cast<struct sockaddr *>(addr);
+  result.ai_canonname = canonname;
+  return result;
+}
+
+class AddrinfoCacheTest : public ::testing::Test {
+ protected:
+  // The cache is a process-wide singleton, so each test starts from a clean,
+  // default-configured instance.
+  void SetUp() override {
+    AddrinfoCache &cache = AddrinfoCache::GetInstance();
+    cache.Clear();
+    cache.set_ttl_seconds(kDefaultAddrinfoCacheTtlSeconds);
+    cache.set_capacity(kDefaultAddrinfoCacheCapacity);
+  }
+};
+
+TEST_F(AddrinfoCacheTest, LookupReturnsIndependentCopyOfInsertedResult) {
+  AddrinfoCache &cache = AddrinfoCache::GetInstance();
+  struct sockaddr_in addr;
+  char canonname[] = "service-a.example.com";
+  struct addrinfo result = MakeResult(&addr, 443, canonname);
+
+  struct addrinfo *res = nullptr;
+  EXPECT_FALSE(cache.Lookup("service-a", "https", nullptr, &res));
+
+  cache.Insert("service-a", "https", nullptr, &result);
+  EXPECT_EQ(cache.size(), 1);
+
+  ASSERT_TRUE(cache.Lookup("service-a", "https", nullptr, &res));
+  ASSERT_NE(res, nullptr);
+  EXPECT_EQ(res->ai_family, AF_INET);
+  EXPECT_EQ(res->ai_socktype, SOCK_STREAM);
+  ASSERT_EQ(res->ai_addrlen, sizeof(addr));
+  EXPECT_EQ(memcmp(res->ai_addr, &addr, sizeof(addr)), 0);
+  EXPECT_STREQ(res->ai_canonname, canonname);
+  EXPECT_EQ(res->ai_next, nullptr);
+
+  // The copy is independent of both the caller's chain and the cache's.
+  EXPECT_NE(res->ai_addr, result.ai_addr);
+  EXPECT_NE(res->ai_canonname, result.ai_canonname);
+  freeaddrinfo(res);
+
+  // The entry survives its copies being released.
+  ASSERT_TRUE(cache.Lookup("service-a", "https", nullptr, &res));
+  freeaddrinfo(res);
+}
+
+TEST_F(AddrinfoCacheTest, KeyDistinguishesNodeServiceAndHints) {
+  AddrinfoCache &cache = AddrinfoCache::GetInstance();
+  struct sockaddr_in addr;
+  struct addrinfo result = MakeResult(&addr, 80, /*canonname=*/nullptr);
+  cache.Insert("service-a", "http", nullptr, &result);
+
+  struct addrinfo *res = nullptr;
+  EXPECT_FALSE(cache.Lookup("service-b", "http", nullptr, &res));
+  EXPECT_FALSE(cache.Lookup("service-a", "https", nullptr, &res));
+  EXPECT_FALSE(cache.Lookup("service-a", nullptr, nullptr, &res));
+
+  // Different hints resolve separately from the hints-less entry.
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET6;
+  EXPECT_FALSE(cache.Lookup("service-a", "http", &hints, &res));
+
+  ASSERT_TRUE(cache.Lookup("service-a", "http", nullptr, &res));
+  freeaddrinfo(res);
+}
+
+TEST_F(AddrinfoCacheTest, InvalidateDropsAllHintsVariantsOfAName) {
+  AddrinfoCache &cache = AddrinfoCache::GetInstance();
+  struct sockaddr_in addr;
+  struct addrinfo result = MakeResult(&addr, 80, /*canonname=*/nullptr);
+
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  cache.Insert("service-a", "http", nullptr, &result);
+  cache.Insert("service-a", "http", &hints, &result);
+  cache.Insert("service-b", "http", nullptr, &result);
+  EXPECT_EQ(cache.size(), 3);
+
+  cache.Invalidate("service-a", "http");
+  EXPECT_EQ(cache.size(), 1);
+
+  struct addrinfo *res = nullptr;
+  EXPECT_FALSE(cache.Lookup("service-a", "http", nullptr, &res));
+  EXPECT_FALSE(cache.Lookup("service-a", "http", &hints, &res));
+  ASSERT_TRUE(cache.Lookup("service-b", "http", nullptr, &res));
+  freeaddrinfo(res);
+}
+
+TEST_F(AddrinfoCacheTest, ZeroTtlExpiresImmediatelyAndZeroTtlDisablesInserts) {
+  AddrinfoCache &cache = AddrinfoCache::GetInstance();
+  struct sockaddr_in addr;
+  struct addrinfo result = MakeResult(&addr, 80, /*canonname=*/nullptr);
+
+  // An entry inserted with a zero TTL is never cached at all.
+  cache.set_ttl_seconds(0);
+  cache.Insert("service-a", "http", nullptr, &result);
+  EXPECT_EQ(cache.size(), 0);
+
+  // An entry whose deadline has already arrived is retired by the lookup that
+  // finds it. A negative TTL backdates the deadline without sleeping.
+  cache.set_ttl_seconds(-1);
+  cache.Insert("service-a", "http", nullptr, &result);
+  EXPECT_EQ(cache.size(), 1);
+  struct addrinfo *res = nullptr;
+  EXPECT_FALSE(cache.Lookup("service-a", "http", nullptr, &res));
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(AddrinfoCacheTest, CapacityEvictsLeastRecentlyUsed) {
+  AddrinfoCache &cache = AddrinfoCache::GetInstance();
+  struct sockaddr_in addr;
+  struct addrinfo result = MakeResult(&addr, 80, /*canonname=*/nullptr);
+  cache.set_capacity(2);
+
+  cache.Insert("service-a", "http", nullptr, &result);
+  cache.Insert("service-b", "http", nullptr, &result);
+
+  // Touch service-a so service-b becomes the eviction candidate.
+  struct addrinfo *res = nullptr;
+  ASSERT_TRUE(cache.Lookup("service-a", "http", nullptr, &res));
+  freeaddrinfo(res);
+
+  cache.Insert("service-c", "http", nullptr, &result);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_FALSE(cache.Lookup("service-b", "http", nullptr, &res));
+  ASSERT_TRUE(cache.Lookup("service-a", "http", nullptr, &res));
+  freeaddrinfo(res);
+  ASSERT_TRUE(cache.Lookup("service-c", "http", nullptr, &res));
+  freeaddrinfo(res);
+}
+
+}  // namespace
+}  // namespace asylo
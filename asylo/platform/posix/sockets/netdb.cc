@@ -20,6 +20,7 @@
 #include <stdlib.h>
 
 #include "asylo/platform/host_call/trusted/host_calls.h"
+#include "asylo/platform/posix/sockets/addrinfo_cache.h"
 
 extern "C" {
 
@@ -28,7 +29,18 @@ const char *gai_strerror(int ecode) { abort(); }
 
 int getaddrinfo(const char *node, const char *service,
                 const struct addrinfo *hints, struct addrinfo **res) {
-  return enc_untrusted_getaddrinfo(node, service, hints, res);
+  // Serve repeated resolutions of the same name from the trusted-side cache
+  // rather than paying an enclave exit and an addrinfo chain serialization
+  // per call. Only successful resolutions are cached.
+  asylo::AddrinfoCache &cache = asylo::AddrinfoCache::GetInstance();
+  if (cache.Lookup(node, service, hints, res)) {
+    return 0;
+  }
+  int ret = enc_untrusted_getaddrinfo(node, service, hints, res);
+  if (ret == 0) {
+    cache.Insert(node, service, hints, *res);
+  }
+  return ret;
 }
 
 void freeaddrinfo(struct addrinfo *res) { enc_freeaddrinfo(res); }
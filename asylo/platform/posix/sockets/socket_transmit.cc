@@ -23,9 +23,17 @@
 
 #include "asylo/util/posix_error_space.h"
 
+#ifdef __ASYLO__
+#include "asylo/platform/host_call/trusted/host_calls.h"
+#endif  // __ASYLO__
+
 namespace asylo {
 
-SocketTransmit::SocketTransmit() : write_count_(0), read_count_(0) {}
+SocketTransmit::SocketTransmit()
+    : write_count_(0),
+      read_count_(0),
+      msg_sent_count_(0),
+      msg_received_count_(0) {}
 
 Status SocketTransmit::Read(int fd, void *buf, size_t read_len) {
   int read_bytes = 0;
@@ -84,6 +92,8 @@ Status SocketTransmit::RecvMsg(int sockfd, struct msghdr *msg, int flags) {
     return Status(static_cast<error::PosixError>(errno),
                   std::string("recvmsg error:") + strerror(errno));
   }
+  ++read_count_;
+  ++msg_received_count_;
   return Status::OkStatus();
 }
 
@@ -93,6 +103,8 @@ Status SocketTransmit::SendMsg(int sockfd, const struct msghdr *msg,
     return Status(static_cast<error::PosixError>(errno),
                   std::string("sendmsg error:") + strerror(errno));
   }
+  ++write_count_;
+  ++msg_sent_count_;
   return Status::OkStatus();
 }
 
@@ -103,6 +115,92 @@ Status SocketTransmit::RecvFrom(int socket, void *buffer, size_t length,
     return Status(static_cast<error::PosixError>(errno),
                   std::string("recvfrom error:") + strerror(errno));
   }
+  ++read_count_;
+  ++msg_received_count_;
+  return Status::OkStatus();
+}
+
+Status SocketTransmit::SendMMsg(int sockfd, struct msghdr *msgs,
+                                unsigned int vlen, int flags,
+                                unsigned int *msg_lens,
+                                unsigned int *num_sent) {
+  int result;
+#ifdef __ASYLO__
+  // One host call moves the whole batch out of the enclave.
+  result = enc_untrusted_sendmmsg(sockfd, msgs, vlen, flags, msg_lens);
+  if (result != -1) {
+    ++write_count_;
+  }
+#else   // __ASYLO__
+  // Without an enclave boundary to amortize, send the batch with one sendmsg
+  // syscall per message, stopping at the first failure like sendmmsg(2).
+  result = 0;
+  for (unsigned int i = 0; i < vlen; ++i) {
+    ssize_t nbytes = sendmsg(sockfd, &msgs[i], flags);
+    if (nbytes == -1) {
+      if (result == 0) {
+        result = -1;
+      }
+      break;
+    }
+    if (msg_lens) {
+      msg_lens[i] = nbytes;
+    }
+    ++result;
+    ++write_count_;
+  }
+#endif  // __ASYLO__
+  if (result == -1) {
+    return Status(static_cast<error::PosixError>(errno),
+                  std::string("sendmmsg error:") + strerror(errno));
+  }
+  msg_sent_count_ += result;
+  if (num_sent) {
+    *num_sent = result;
+  }
+  return Status::OkStatus();
+}
+
+Status SocketTransmit::RecvMMsg(int sockfd, struct msghdr *msgs,
+                                unsigned int vlen, int flags,
+                                unsigned int *msg_lens,
+                                unsigned int *num_received) {
+  int result;
+#ifdef __ASYLO__
+  // One host call drains the whole batch into the enclave.
+  result = enc_untrusted_recvmmsg(sockfd, msgs, vlen, flags, msg_lens);
+  if (result != -1) {
+    ++read_count_;
+  }
+#else   // __ASYLO__
+  // Without an enclave boundary to amortize, receive the batch with one
+  // recvmsg syscall per message, blocking (subject to |flags|) only for the
+  // first message and draining the rest without waiting.
+  result = 0;
+  for (unsigned int i = 0; i < vlen; ++i) {
+    int msg_flags = i == 0 ? flags : flags | MSG_DONTWAIT;
+    ssize_t nbytes = recvmsg(sockfd, &msgs[i], msg_flags);
+    if (nbytes == -1) {
+      if (result == 0) {
+        result = -1;
+      }
+      break;
+    }
+    if (msg_lens) {
+      msg_lens[i] = nbytes;
+    }
+    ++result;
+    ++read_count_;
+  }
+#endif  // __ASYLO__
+  if (result == -1) {
+    return Status(static_cast<error::PosixError>(errno),
+                  std::string("recvmmsg error:") + strerror(errno));
+  }
+  msg_received_count_ += result;
+  if (num_received) {
+    *num_received = result;
+  }
   return Status::OkStatus();
 }
 
@@ -110,9 +208,15 @@ int SocketTransmit::GetWrite() const { return write_count_; }
 
 int SocketTransmit::GetRead() const { return read_count_; }
 
+int SocketTransmit::GetMsgSent() const { return msg_sent_count_; }
+
+int SocketTransmit::GetMsgReceived() const { return msg_received_count_; }
+
 void SocketTransmit::reset() {
   write_count_ = 0;
   read_count_ = 0;
+  msg_sent_count_ = 0;
+  msg_received_count_ = 0;
 }
 
 }  // namespace asylo
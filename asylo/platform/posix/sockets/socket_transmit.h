@@ -29,11 +29,12 @@ namespace asylo {
 // SocketTransmit is a wrapper around socket read/write. A SocketTransmit object
 // provides interfaces of sending/receiving a buffer through sockets and records
 // how many read/write syscalls are actually executed to fulfil the buffer
-// transmission.
+// transmission, as well as how many messages the message-oriented interfaces
+// moved, so callers can observe their syscall-per-message ratio.
 class SocketTransmit {
  public:
   // Constructs a SocketTrasmit object and sets the counts of executed
-  // read/write syscalls to 0.
+  // read/write syscalls and transferred messages to 0.
   SocketTransmit();
 
   // Reads |read_len| bytes from |fd| into |buf|.
@@ -65,18 +66,48 @@ class SocketTransmit {
   Status RecvFrom(int socket, void *buffer, size_t length, int flags,
                   struct sockaddr *address, socklen_t *address_len);
 
+  // Transmits up to |vlen| messages from |msgs| to socket |sockfd| in one
+  // batch, stopping at the first message that fails to send. Inside an enclave
+  // the whole batch crosses the enclave boundary in a single host call;
+  // otherwise one sendmsg syscall is issued per message. The number of
+  // messages sent is stored in |num_sent| and the bytes transmitted for
+  // message i in |msg_lens[i]|; either pointer may be null. Returns a non-OK
+  // Status only if no message could be sent.
+  Status SendMMsg(int sockfd, struct msghdr *msgs, unsigned int vlen, int flags,
+                  unsigned int *msg_lens, unsigned int *num_sent);
+
+  // Receives up to |vlen| messages from socket |sockfd| into |msgs| in one
+  // batch, blocking (subject to |flags|) only for the first message and
+  // draining the rest without waiting. Inside an enclave the whole batch
+  // crosses the enclave boundary in a single host call; otherwise one recvmsg
+  // syscall is issued per message. The number of messages received is stored
+  // in |num_received| and the bytes received for message i in |msg_lens[i]|;
+  // either pointer may be null. Returns a non-OK Status only if no message
+  // could be received.
+  Status RecvMMsg(int sockfd, struct msghdr *msgs, unsigned int vlen, int flags,
+                  unsigned int *msg_lens, unsigned int *num_received);
+
   // Gets the number of times the write syscall has been executed.
   int GetWrite() const;
 
   // Gets the number of times the read syscall has been executed.
   int GetRead() const;
 
-  // Resets the counts of executed read/write syscalls to 0.
+  // Gets the number of messages sent by SendMsg and SendMMsg.
+  int GetMsgSent() const;
+
+  // Gets the number of messages received by RecvMsg, RecvFrom and RecvMMsg.
+  int GetMsgReceived() const;
+
+  // Resets the counts of executed read/write syscalls and transferred
+  // messages to 0.
   void reset();
 
  private:
   int write_count_;
   int read_count_;
+  int msg_sent_count_;
+  int msg_received_count_;
 };
 
 }  // namespace asylo
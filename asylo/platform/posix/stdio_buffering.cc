@@ -0,0 +1,52 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/posix/stdio_buffering.h"
+
+#include <stdio.h>
+#include <unistd.h>
+
+namespace asylo {
+namespace {
+
+// Buffer size for fully buffered streams. Large enough that printf-style
+// telemetry amortizes to a small fraction of an enclave exit per line,
+// without a noticeable memory cost per stream.
+constexpr size_t kStdioBufferSize = 64 * 1024;
+
+}  // namespace
+
+void InitializeStdioBuffering() {
+  // Newlib defaults stdout to line buffering, which turns every line of
+  // output into an enclave exit. Switch non-terminal stdout to full
+  // buffering with an enclave-resident buffer; keep terminals line buffered
+  // so interactive output appears per line. The buffer is static because the
+  // stream keeps referencing it for the lifetime of the enclave.
+  static char stdout_buffer[kStdioBufferSize];
+  if (isatty(STDOUT_FILENO)) {
+    setvbuf(stdout, nullptr, _IOLBF, BUFSIZ);
+  } else {
+    setvbuf(stdout, stdout_buffer, _IOFBF, kStdioBufferSize);
+  }
+  // stderr intentionally keeps newlib's unbuffered default: diagnostics must
+  // reach the host even if the enclave aborts before a flush.
+}
+
+void FlushStdioBuffers() { fflush(nullptr); }
+
+}  // namespace asylo
@@ -0,0 +1,39 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_POSIX_STDIO_BUFFERING_H_
+#define ASYLO_PLATFORM_POSIX_STDIO_BUFFERING_H_
+
+namespace asylo {
+
+// Installs the enclave's default stdio buffering. Every write on a
+// host-backed descriptor costs an enclave exit, so stdout gets a large fully
+// buffered stream when it is not a terminal; terminals stay line buffered so
+// interactive output appears promptly, and stderr stays unbuffered so
+// diagnostics are never lost. Runs during enclave initialization, before user
+// code: a later setvbuf(3) call by the application replaces these defaults.
+void InitializeStdioBuffering();
+
+// Flushes all open stdio streams. Enclave finalization does not run exit(3),
+// so buffered output would otherwise be dropped; call this before tearing
+// down the runtime.
+void FlushStdioBuffers();
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_POSIX_STDIO_BUFFERING_H_
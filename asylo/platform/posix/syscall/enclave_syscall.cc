@@ -200,6 +200,9 @@ int64_t EnclaveSyscallWithDeps(int sysno, uint64_t* args, size_t nargs,
     case asylo::system_call::kSYS_pread64:
       return io_manager->PRead(args[0], reinterpret_cast<void*>(args[1]),
                                args[2], args[3]);
+    case asylo::system_call::kSYS_sendfile:
+      return io_manager->SendFile(args[0], args[1],
+                                  reinterpret_cast<off_t*>(args[2]), args[3]);
     case asylo::system_call::kSYS_umask:
       return io_manager->Umask(args[0]);
     case asylo::system_call::kSYS_getrlimit:
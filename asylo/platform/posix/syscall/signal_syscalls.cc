@@ -18,9 +18,54 @@
 
 #include "asylo/platform/posix/syscall/signal_syscalls.h"
 
+#include <cstring>
+
+#include "absl/base/const_init.h"
 #include "absl/synchronization/mutex.h"
 #include "asylo/platform/host_call/trusted/host_calls.h"
 namespace asylo {
+namespace {
+
+// Host signal mask last imposed by SyncHostSignalMask, so a sync can be
+// skipped when the mask the enclave wants on the host is already in place.
+// Starts empty, matching the host mask of a freshly launched enclave. Guarded
+// by |host_mask_lock|, which is held across the host call so two concurrent
+// syncs cannot leave the shadow disagreeing with the host.
+ABSL_CONST_INIT absl::Mutex host_mask_lock(absl::kConstInit);
+sigset_t last_host_mask;
+
+// Recomputes the mask the enclave wants imposed on the host - the signals
+// blocked by the trusted mask whose disposition still lives on the host - and
+// imposes it if it differs from the mask last imposed. Signals with an
+// enclave-registered handler are gated by the trusted mask at delivery time
+// instead, so the host mask for them is deliberately left unblocked and a
+// trusted-only mask change never waits on a host exit. Returns the result of
+// the host call, or 0 when no call was needed.
+int SyncHostSignalMask() {
+  SignalManager *signal_manager = SignalManager::GetInstance();
+  sigset_t trusted_mask = signal_manager->GetSignalMask();
+  sigset_t desired_mask;
+  sigemptyset(&desired_mask);
+  for (int signum = 0; signum < kNumberSignals; ++signum) {
+    struct sigaction act;
+    if (sigismember(&trusted_mask, signum) == 1 &&
+        !signal_manager->GetSigAction(signum, &act)) {
+      sigaddset(&desired_mask, signum);
+    }
+  }
+  absl::MutexLock lock(&host_mask_lock);
+  if (memcmp(&desired_mask, &last_host_mask, sizeof(sigset_t)) == 0) {
+    return 0;
+  }
+  int res = enc_untrusted_sigprocmask(SIG_SETMASK, &desired_mask,
+                                      /*oldset=*/nullptr);
+  if (res == 0) {
+    last_host_mask = desired_mask;
+  }
+  return res;
+}
+
+}  // namespace
 
 // Registers a signal handler for |signum|.
 //
@@ -78,20 +123,25 @@ int RtSigaction(int signum, const struct sigaction* act,
     signal_manager->SetResetStatus(signum,
                                    asylo::SignalManager::ResetStatus::NO_RESET);
   }
-  return enc_register_signal(signum, mask, flags);
+  int res = enc_register_signal(signum, mask, flags);
+  if (res == 0) {
+    // Registering the handler moved |signum|'s disposition into the enclave.
+    // If the host still blocks it from a sync taken while it was unhandled,
+    // lift that block now so the host forwards it instead of holding it
+    // behind a mask the enclave no longer wants.
+    SyncHostSignalMask();
+  }
+  return res;
 }
 
 // Sets the signal mask with |set|.
 //
-// This method sets the signal mask both inside the enclave and on the host.
-// If |how| is SIG_UNBLOCK, the signals to unblock are unblocked inside the
-// enclave first, then on the host.
-// If |how| is SIG_BLOCK, the signals to block are blocked on the host first,
-// then inside the enclave.
-// If |how| is SIG_SETMASK, |set| is separated to signals to block and to
-// unblock. The signals to unblock are processed inside the enclave first, then
-// on the host, and the signals to block are processed on the host first, then
-// inside the enclave.
+// The mask maintained inside the enclave is authoritative: SignalManager
+// consults it at delivery time and queues blocked signals, so most mask
+// changes complete without leaving the enclave. The host mask only matters
+// for signals with no enclave-registered handler, whose default action is
+// taken by the host; the host is synced lazily, only when the desired host
+// mask differs from the one last imposed.
 // |oldset| is set to the signal mask used inside the enclave prior to this
 // call.
 int RtSigprocmask(int how, const sigset_t* set, sigset_t* oldset,
@@ -107,8 +157,9 @@ int RtSigprocmask(int how, const sigset_t* set, sigset_t* oldset,
   }
 
   asylo::SignalManager* signal_manager = asylo::SignalManager::GetInstance();
+  sigset_t old_mask = signal_manager->GetSignalMask();
   if (oldset) {
-    *oldset = signal_manager->GetSignalMask();
+    *oldset = old_mask;
   }
   if (!set) {
     return 0;
@@ -127,14 +178,18 @@ int RtSigprocmask(int how, const sigset_t* set, sigset_t* oldset,
     signals_to_unblock = signal_manager->GetUnblockedSet(*set);
   }
 
-  // Unblock signals inside the enclave before unblocking signals on the host.
   signal_manager->UnblockSignals(signals_to_unblock);
+  signal_manager->BlockSignals(signals_to_block);
 
-  // |oldset| is already filled with the signal mask inside the enclave.
-  int res = enc_untrusted_sigprocmask(how, set, /*oldset=*/nullptr);
+  // Exit the enclave only if the mask the host should carry changed. The
+  // shadow comparison, not this call's delta, decides: a signal blocked here
+  // while unhandled and given an enclave handler before being unblocked still
+  // gets its stale host block lifted, because the desired host mask no longer
+  // contains it.
+  int res = SyncHostSignalMask();
 
-  // Block signals inside the enclave after the host.
-  signal_manager->BlockSignals(signals_to_block);
+  // A mask change may have unblocked signals queued at delivery time.
+  signal_manager->DeliverPendingSignals();
 
   return res;
 }
@@ -24,8 +24,10 @@
 #include <algorithm>
 #include <atomic>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 
+#include "asylo/platform/posix/memory/malloc_arena.h"
 #include "asylo/platform/posix/pthread_impl.h"
 #include "asylo/platform/primitives/trusted_primitives.h"
 #include "asylo/platform/primitives/trusted_runtime.h"
@@ -166,6 +168,54 @@ ThreadManager *ThreadManager::GetInstance() {
   return instance;
 }
 
+void *ThreadManager::AllocateThreadTls(size_t size) {
+  tls_allocations_.fetch_add(1, std::memory_order_relaxed);
+
+  void *tls = nullptr;
+  {
+    PthreadMutexLock lock(&tls_pool_lock_);
+    // All callers request the same layout, so the top block fits whenever the
+    // pool is non-empty; the size check keeps reuse correct regardless.
+    if (!tls_block_pool_.empty() && tls_block_pool_.top().size >= size) {
+      tls = tls_block_pool_.top().address;
+      tls_block_pool_.pop();
+    }
+  }
+  if (tls != nullptr) {
+    tls_pool_hits_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    tls = mmap(/*addr=*/nullptr, size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANON, /*fd=*/-1, /*offset=*/0);
+    if (tls == MAP_FAILED) {
+      return nullptr;
+    }
+  }
+
+  // Reused blocks must be re-zeroed so thread-specific data starts cleared;
+  // the savings come from skipping the enclave page allocation and mapping,
+  // not the memset of this small block.
+  memset(tls, 0, size);
+  return tls;
+}
+
+void ThreadManager::ReleaseThreadTls(void *tls, size_t size) {
+  {
+    PthreadMutexLock lock(&tls_pool_lock_);
+    if (!finalizing_.load() && tls_block_pool_.size() < kMaxPooledTlsBlocks) {
+      tls_block_pool_.push(TlsBlock{tls, size});
+      return;
+    }
+  }
+  munmap(tls, size);
+}
+
+ThreadManager::TlsBlockPoolStats ThreadManager::GetTlsBlockPoolStats() const {
+  TlsBlockPoolStats stats;
+  stats.allocations = tls_allocations_.load(std::memory_order_relaxed);
+  stats.pool_hits = tls_pool_hits_.load(std::memory_order_relaxed);
+  return stats;
+}
+
 std::shared_ptr<ThreadManager::Thread> ThreadManager::EnqueueThread(
     const ThreadOptions &options, const std::function<int()> &start_routine,
     void *tls) {
@@ -193,8 +243,14 @@ std::shared_ptr<ThreadManager::Thread> ThreadManager::DequeueThread(pid_t tid) {
   std::shared_ptr<Thread> thread = queued_threads_.front();
   queued_threads_.pop();
 
-  // Bind the Thread we just took off the queue to the thread id of the donated
-  // enclave thread we're running under.
+  BindThreadToSelf(thread, tid);
+  return thread;
+}
+
+void ThreadManager::BindThreadToSelf(const std::shared_ptr<Thread> &thread,
+                                     pid_t tid) {
+  // Bind the Thread to the thread id of the donated enclave thread we're
+  // running under.
   const pthread_t thread_id = pthread_self();
   thread->UpdateThreadId(thread_id);
 
@@ -204,7 +260,6 @@ std::shared_ptr<ThreadManager::Thread> ThreadManager::DequeueThread(pid_t tid) {
       thread_id;
 
   pthread_cond_broadcast(&threads_cond_);
-  return thread;
 }
 
 int ThreadManager::CreateThread(const std::function<int()> &start_routine,
@@ -214,11 +269,34 @@ int ThreadManager::CreateThread(const std::function<int()> &start_routine,
   if (attr && attr->detach_state == PTHREAD_CREATE_DETACHED) {
     options.detached = true;
   }
-  std::shared_ptr<Thread> thread = EnqueueThread(options, start_routine, tls);
+  std::shared_ptr<Thread> thread;
+  bool use_pooled_thread = false;
+  {
+    PthreadMutexLock lock(&threads_lock_);
+    // Hand the start_routine to an idle donated thread parked in the reuse
+    // pool, if one is available, instead of requesting a fresh host thread.
+    // The reservation is taken under threads_lock_ so that each pooled
+    // start_routine is matched to exactly one parked thread.
+    if (idle_pooled_threads_ > 0) {
+      --idle_pooled_threads_;
+      thread = std::make_shared<Thread>(options, start_routine, tls);
+
+      // If a Thread object cannot be allocated, abort.
+      CHECK(thread != nullptr);
+
+      pooled_threads_.push(thread);
+      use_pooled_thread = true;
+      pthread_cond_broadcast(&threads_cond_);
+    }
+  }
+
+  if (!use_pooled_thread) {
+    thread = EnqueueThread(options, start_routine, tls);
 
-  // Exit and create a thread to enter with EnclaveCall DonateThread.
-  if (asylo::primitives::TrustedPrimitives::CreateThread()) {
-    return ECHILD;
+    // Exit and create a thread to enter with EnclaveCall DonateThread.
+    if (asylo::primitives::TrustedPrimitives::CreateThread()) {
+      return ECHILD;
+    }
   }
 
   // Wait until a thread enters and executes the job.
@@ -234,13 +312,30 @@ int ThreadManager::CreateThread(const std::function<int()> &start_routine,
 // StartThread is called from trusted_application.cc as the start routine when
 // a new thread is donated to the Enclave.
 int ThreadManager::StartThread(pid_t tid) {
-  std::shared_ptr<Thread> thread = DequeueThread(tid);
+  RunDonatedThread(DequeueThread(tid));
+
+  // Rather than returning the donated thread to the host as soon as its
+  // start_routine completes, park it in the reuse pool and serve further
+  // start_routines on it until the pool is full or the enclave is finalizing.
+  std::shared_ptr<Thread> thread;
+  while ((thread = WaitForPooledThread(tid)) != nullptr) {
+    RunDonatedThread(thread);
+  }
 
+  // Return this thread's cached malloc arena blocks to the global heap before
+  // the donated thread leaves the enclave for good.
+  enc_flush_malloc_arena();
+  return 0;
+}
+
+void ThreadManager::RunDonatedThread(const std::shared_ptr<Thread> &thread) {
   // Update the thread info in pthread_self.
   enc_update_pthread_info(thread->GetThreadTls());
 
   // Run the start_routine.
+  running_threads_++;
   thread->Run();
+  running_threads_--;
 
   // Wait for the caller to join before releasing the thread if the thread is
   // joinable.
@@ -273,10 +368,43 @@ int ThreadManager::StartThread(pid_t tid) {
     pthread_cond_broadcast(&threads_cond_);
   }
 
-  // Thread finished execution, reset the thread ID and release the TLS memory.
-  munmap(reinterpret_cast<struct __pthread_info *>(pthread_self())->self,
-         reinterpret_cast<struct __pthread_info *>(pthread_self())->tls_size);
-  return 0;
+  // Thread finished execution, reset the thread ID and return the TLS memory
+  // to the reuse pool for a future thread.
+  ReleaseThreadTls(
+      reinterpret_cast<struct __pthread_info *>(pthread_self())->self,
+      reinterpret_cast<struct __pthread_info *>(pthread_self())->tls_size);
+}
+
+std::shared_ptr<ThreadManager::Thread> ThreadManager::WaitForPooledThread(
+    pid_t tid) {
+  PthreadMutexLock lock(&threads_lock_);
+  if (finalizing_.load() || idle_pooled_threads_ >= kMaxPooledThreads) {
+    return nullptr;
+  }
+
+  ++idle_pooled_threads_;
+  WaitFor([this]() { return !pooled_threads_.empty() || finalizing_.load(); },
+          &threads_cond_, &threads_lock_);
+
+  if (pooled_threads_.empty()) {
+    // Finalizing with no start_routine reserved for this thread; withdraw
+    // from the pool so Finalize() stops waiting on it.
+    --idle_pooled_threads_;
+    pthread_cond_broadcast(&threads_cond_);
+    return nullptr;
+  }
+
+  // CreateThread() already took this thread's reservation out of
+  // idle_pooled_threads_ when it queued the start_routine.
+  std::shared_ptr<Thread> thread = pooled_threads_.front();
+  pooled_threads_.pop();
+
+  BindThreadToSelf(thread, tid);
+  return thread;
+}
+
+size_t ThreadManager::RunningThreadCount() const {
+  return running_threads_.load(std::memory_order_relaxed);
 }
 
 void ThreadManager::UpdateThreadResult(const pthread_t thread_id, void *ret) {
@@ -375,10 +503,25 @@ void ThreadManager::Finalize() {
     thread.second->SignalStateWaiters();
   }
 
-  // Wait for any expected threads to be donated and all threads to return from
-  // start_routine.
-  WaitFor([this]() { return queued_threads_.empty() && threads_.empty(); },
-          &threads_cond_, &threads_lock_);
+  // Wake any donated threads parked in the reuse pool so they can exit the
+  // enclave.
+  pthread_cond_broadcast(&threads_cond_);
+
+  // Wait for any expected threads to be donated, all threads to return from
+  // start_routine, and all pooled threads to exit.
+  WaitFor(
+      [this]() {
+        return queued_threads_.empty() && threads_.empty() &&
+               pooled_threads_.empty() && idle_pooled_threads_ == 0;
+      },
+      &threads_cond_, &threads_lock_);
+
+  // All threads have completed; unmap any TLS blocks still held for reuse.
+  PthreadMutexLock tls_lock(&tls_pool_lock_);
+  while (!tls_block_pool_.empty()) {
+    munmap(tls_block_pool_.top().address, tls_block_pool_.top().size);
+    tls_block_pool_.pop();
+  }
 }
 
 }  // namespace asylo
@@ -22,6 +22,8 @@
 #include <pthread.h>
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <queue>
@@ -36,6 +38,9 @@ bool ReturnFalse();
 
 // ThreadManager class is a singleton responsible for:
 // - Maintaining a queue of thread start_routine functions.
+// - Reusing donated enclave threads across start_routines so that short-lived
+//   threads do not pay host thread creation and enclave entry setup per
+//   pthread_create().
 class ThreadManager {
  public:
   static ThreadManager *GetInstance();
@@ -46,6 +51,28 @@ class ThreadManager {
     bool detached = false;
   };
 
+  // Counters for the per-thread TLS block reuse pool. The hit rate is
+  // pool_hits / allocations.
+  struct TlsBlockPoolStats {
+    // Total AllocateThreadTls() calls and how many were served from the pool
+    // instead of a fresh enclave mapping.
+    uint64_t allocations;
+    uint64_t pool_hits;
+  };
+
+  // Returns a zeroed block of at least |size| bytes for a new thread's pthread
+  // TLS area, reusing a block released by a completed thread when one of
+  // sufficient size is pooled and mapping fresh enclave memory otherwise.
+  // Returns nullptr on allocation failure.
+  void *AllocateThreadTls(size_t size);
+
+  // Returns a block obtained from AllocateThreadTls() to the pool for reuse by
+  // a future thread, unmapping it instead if the pool is full.
+  void ReleaseThreadTls(void *tls, size_t size);
+
+  // Returns a snapshot of the TLS block pool counters.
+  TlsBlockPoolStats GetTlsBlockPoolStats() const;
+
   // Adds the given |function| to a start_routine queue of functions waiting to
   // be run by the pthreads implementation. |tid| updates the system thread ID
   // of the new thread. |tls| specifies the pthread TLS address for the new
@@ -75,6 +102,11 @@ class ThreadManager {
   // |execute| is true.
   void PopCleanupRoutine(bool execute);
 
+  // Returns the number of threads currently running a start_routine. Used as
+  // a cheap signal of whether other enclave threads could make progress if the
+  // caller spins instead of yielding to the host.
+  size_t RunningThreadCount() const;
+
   // Finalizes the ThreadManager. This means no new threads may be created using
   // pthread_create(). This function will block until all pending
   // pthread_create() created threads have entered the enclave, and all of
@@ -192,6 +224,22 @@ class ThreadManager {
   // Guaranteed to return a valid std::shared_ptr or this function will abort.
   std::shared_ptr<Thread> DequeueThread(pid_t tid);
 
+  // Binds |thread| to the donated enclave thread calling this function and
+  // adds it to the threads_ map. threads_lock_ must be held.
+  void BindThreadToSelf(const std::shared_ptr<Thread> &thread, pid_t tid);
+
+  // Runs |thread| on the calling donated enclave thread: runs its
+  // start_routine, waits for the thread to be joined if it is joinable, and
+  // releases its TLS memory.
+  void RunDonatedThread(const std::shared_ptr<Thread> &thread);
+
+  // Parks the calling donated enclave thread in the reuse pool until
+  // CreateThread() reserves it for a new start_routine. Returns the Thread
+  // bound to the caller, or nullptr if the pool is already full or the
+  // ThreadManager is finalizing, in which case the caller should exit the
+  // enclave.
+  std::shared_ptr<Thread> WaitForPooledThread(pid_t tid);
+
   // Returns a Thread pointer for a given |thread_id|.
   std::shared_ptr<Thread> GetThread(pthread_t thread_id);
 
@@ -199,11 +247,46 @@ class ThreadManager {
   pthread_mutex_t threads_lock_ = PTHREAD_MUTEX_INITIALIZER;
   pthread_cond_t threads_cond_ = PTHREAD_COND_INITIALIZER;
 
+  // Maximum number of idle donated threads retained in the reuse pool.
+  static constexpr size_t kMaxPooledThreads = 8;
+
+  // Maximum number of released TLS blocks retained for reuse. Sized to match
+  // the thread reuse pool, since each pooled thread lifetime retires at most
+  // one block.
+  static constexpr size_t kMaxPooledTlsBlocks = kMaxPooledThreads;
+
+  // A TLS block released by a completed thread, available for reuse.
+  struct TlsBlock {
+    void *address;
+    size_t size;
+  };
+
+  // Guards tls_block_pool_. Separate from threads_lock_ so TLS allocation on
+  // the pthread_create() path never contends with thread state transitions.
+  mutable pthread_mutex_t tls_pool_lock_ = PTHREAD_MUTEX_INITIALIZER;
+
+  // Released TLS blocks available for reuse, most recently released first so
+  // a burst of short-lived threads keeps cycling the same warm blocks.
+  std::stack<TlsBlock> tls_block_pool_;
+
+  // TLS block pool counters; see TlsBlockPoolStats.
+  std::atomic<uint64_t> tls_allocations_{0};
+  std::atomic<uint64_t> tls_pool_hits_{0};
+
   // Queue of start_routines waiting to be run.
   // std::shared_ptr is documented to use atomic increments/decrements to manage
   // a refcount instead of using a mutex.
   std::queue<std::shared_ptr<Thread>> queued_threads_;
 
+  // Queue of start_routines reserved for donated threads parked in the reuse
+  // pool. Each entry corresponds to one reservation CreateThread() took out of
+  // idle_pooled_threads_.
+  std::queue<std::shared_ptr<Thread>> pooled_threads_;
+
+  // Number of donated threads parked in the reuse pool that have not yet been
+  // reserved by CreateThread().
+  size_t idle_pooled_threads_ = 0;
+
   // List of currently running threads or threads waiting to be joined.
   // ThreadManager is used in trusted contexts where system calls might not be
   // available; avoid using absl based containers which may perform system
@@ -219,6 +302,9 @@ class ThreadManager {
   // that don't join all their threads. While finalizing, join becomes a noop
   // and threads are treated as detached as they complete.
   std::atomic<bool> finalizing_{false};
+
+  // Number of threads currently inside their start_routine.
+  std::atomic<size_t> running_threads_{0};
 };
 
 }  // namespace asylo
@@ -0,0 +1,260 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/posix/threading/thread_pool.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "asylo/platform/posix/pthread_impl.h"
+#include "asylo/util/logging.h"
+
+namespace asylo {
+namespace {
+
+using pthread_impl::PthreadMutexLock;
+
+// Returns when |predicate| returns true. |mutex| must be locked.
+void WaitFor(const std::function<bool()> &predicate, pthread_cond_t *cond,
+             pthread_mutex_t *mutex) {
+  while (!predicate()) {
+    int ret = pthread_cond_wait(cond, mutex);
+    CHECK_EQ(ret, 0);
+  }
+}
+
+// Number of chunks a ParallelFor() range is split into per worker. More
+// chunks than workers smooths out uneven iteration costs without paying
+// per-iteration scheduling overhead.
+constexpr size_t kChunksPerWorker = 4;
+
+// Identifies the pool and worker index of the calling thread, if the caller
+// is a pool worker.
+thread_local ThreadPool *current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+// Arguments passed to a worker's start routine.
+struct WorkerStartArgs {
+  ThreadPool *pool;
+  size_t worker_index;
+};
+
+}  // namespace
+
+ThreadPool::ThreadPool(size_t num_workers)
+    : workers_(std::max<size_t>(1, num_workers)) {
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    WorkerStartArgs *args = new WorkerStartArgs{this, i};
+    int ret = pthread_create(&workers_[i].thread_id, /*attr=*/nullptr,
+                             WorkerMain, args);
+    CHECK_EQ(ret, 0);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    PthreadMutexLock lock(&pool_lock_);
+    WaitFor([this] { return unfinished_tasks_ == 0; }, &done_cond_,
+            &pool_lock_);
+    shutting_down_ = true;
+    int ret = pthread_cond_broadcast(&wake_cond_);
+    CHECK_EQ(ret, 0);
+  }
+
+  for (Worker &worker : workers_) {
+    int ret = pthread_join(worker.thread_id, /*value_ptr=*/nullptr);
+    CHECK_EQ(ret, 0);
+  }
+}
+
+void ThreadPool::Schedule(const std::function<void()> &task) {
+  size_t target;
+  if (current_pool == this) {
+    target = current_worker;
+  } else {
+    target = next_worker_.fetch_add(1, std::memory_order_relaxed) %
+             workers_.size();
+  }
+
+  // Account for the task before it becomes visible to the workers, so that it
+  // cannot finish (and decrement unfinished_tasks_) before it was counted.
+  {
+    PthreadMutexLock lock(&pool_lock_);
+    ++unfinished_tasks_;
+  }
+
+  {
+    PthreadMutexLock lock(&workers_[target].lock);
+    workers_[target].tasks.push_back(task);
+  }
+
+  PthreadMutexLock lock(&pool_lock_);
+  ++work_epoch_;
+  int ret = pthread_cond_signal(&wake_cond_);
+  CHECK_EQ(ret, 0);
+}
+
+void ThreadPool::ParallelFor(size_t begin, size_t end,
+                             const std::function<void(size_t)> &body) {
+  if (begin >= end) {
+    return;
+  }
+
+  const size_t range = end - begin;
+  const size_t num_chunks =
+      std::min(range, workers_.size() * kChunksPerWorker);
+
+  // Completion state shared with the scheduled chunks. ParallelFor() blocks
+  // until every chunk has run, so stack storage outlives them.
+  struct ParallelForState {
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t done = PTHREAD_COND_INITIALIZER;
+    size_t remaining;
+  };
+  ParallelForState state;
+  state.remaining = num_chunks - 1;
+  ParallelForState *shared = &state;
+
+  for (size_t chunk = 1; chunk < num_chunks; ++chunk) {
+    const size_t chunk_begin = begin + range * chunk / num_chunks;
+    const size_t chunk_end = begin + range * (chunk + 1) / num_chunks;
+    Schedule([shared, chunk_begin, chunk_end, &body] {
+      for (size_t i = chunk_begin; i < chunk_end; ++i) {
+        body(i);
+      }
+      PthreadMutexLock lock(&shared->lock);
+      if (--shared->remaining == 0) {
+        int ret = pthread_cond_broadcast(&shared->done);
+        CHECK_EQ(ret, 0);
+      }
+    });
+  }
+
+  // Run the first chunk on the calling thread.
+  const size_t first_chunk_end = begin + range / num_chunks;
+  for (size_t i = begin; i < first_chunk_end; ++i) {
+    body(i);
+  }
+
+  if (current_pool == this) {
+    // A worker must not sleep while chunks it scheduled may still sit in its
+    // own deque; keep running queued tasks until the range is complete so
+    // nested ParallelFor() calls cannot deadlock the pool.
+    std::function<void()> task;
+    while (true) {
+      {
+        PthreadMutexLock lock(&state.lock);
+        if (state.remaining == 0) {
+          return;
+        }
+      }
+      if (TryGetTask(current_worker, &task)) {
+        RunTask(&task);
+      } else {
+        sched_yield();
+      }
+    }
+  }
+
+  PthreadMutexLock lock(&state.lock);
+  WaitFor([shared] { return shared->remaining == 0; }, &state.done,
+          &state.lock);
+}
+
+void *ThreadPool::WorkerMain(void *args) {
+  WorkerStartArgs *start_args = static_cast<WorkerStartArgs *>(args);
+  ThreadPool *pool = start_args->pool;
+  const size_t worker_index = start_args->worker_index;
+  delete start_args;
+
+  pool->WorkerLoop(worker_index);
+  return nullptr;
+}
+
+void ThreadPool::WorkerLoop(size_t worker_index) {
+  current_pool = this;
+  current_worker = worker_index;
+
+  std::function<void()> task;
+  while (true) {
+    // Read the epoch before scanning the deques: work scheduled after the
+    // read bumps the epoch and defeats the wait below, and work scheduled
+    // before the read is found by the scan.
+    uint64_t epoch;
+    {
+      PthreadMutexLock lock(&pool_lock_);
+      if (shutting_down_) {
+        return;
+      }
+      epoch = work_epoch_;
+    }
+
+    if (TryGetTask(worker_index, &task)) {
+      RunTask(&task);
+      continue;
+    }
+
+    PthreadMutexLock lock(&pool_lock_);
+    WaitFor([this, epoch] { return work_epoch_ != epoch || shutting_down_; },
+            &wake_cond_, &pool_lock_);
+  }
+}
+
+bool ThreadPool::TryGetTask(size_t worker_index, std::function<void()> *task) {
+  // The worker's own deque runs newest-first for cache locality.
+  Worker *self = &workers_[worker_index];
+  {
+    PthreadMutexLock lock(&self->lock);
+    if (!self->tasks.empty()) {
+      *task = std::move(self->tasks.back());
+      self->tasks.pop_back();
+      return true;
+    }
+  }
+
+  // Steal oldest-first from the other workers, starting past the caller so
+  // thieves spread across victims.
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    Worker *victim = &workers_[(worker_index + i) % workers_.size()];
+    PthreadMutexLock lock(&victim->lock);
+    if (!victim->tasks.empty()) {
+      *task = std::move(victim->tasks.front());
+      victim->tasks.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ThreadPool::RunTask(std::function<void()> *task) {
+  (*task)();
+  // Release any captures before blocking elsewhere.
+  *task = nullptr;
+
+  PthreadMutexLock lock(&pool_lock_);
+  if (--unfinished_tasks_ == 0) {
+    int ret = pthread_cond_broadcast(&done_cond_);
+    CHECK_EQ(ret, 0);
+  }
+}
+
+}  // namespace asylo
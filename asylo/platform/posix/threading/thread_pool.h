@@ -0,0 +1,130 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_POSIX_THREADING_THREAD_POOL_H_
+#define ASYLO_PLATFORM_POSIX_THREADING_THREAD_POOL_H_
+
+#include <pthread.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace asylo {
+
+// A fixed-size pool of enclave threads with per-worker task deques and work
+// stealing. The workers are created once at construction, so applications can
+// parallelize CPU-bound work without paying the donated-thread setup cost of
+// pthread_create() per task. Each worker pops its own deque in LIFO order for
+// cache locality and steals from the front of other workers' deques when its
+// own runs dry; once the pool is running, scheduling and stealing stay inside
+// the enclave and the boundary is only crossed when an idle worker has to
+// sleep.
+//
+// ThreadPool is thread-safe: any enclave thread may schedule work, including
+// the pool's own workers. No new tasks may be scheduled once destruction has
+// begun.
+class ThreadPool {
+ public:
+  // Creates a pool with |num_workers| worker threads, started eagerly. At
+  // least one worker is always created.
+  explicit ThreadPool(size_t num_workers);
+
+  // Blocks until every scheduled task has finished, then joins the workers.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Schedules |task| to run on some worker. Tasks scheduled from a worker
+  // thread go to that worker's own deque, where they run in LIFO order unless
+  // stolen; tasks scheduled from other threads are distributed round-robin.
+  void Schedule(const std::function<void()> &task);
+
+  // Runs |body|(i) for every i in [|begin|, |end|), splitting the range into
+  // chunks across the workers, and blocks until every iteration has run. The
+  // calling thread runs the first chunk itself, and a calling worker keeps
+  // running queued tasks while it waits, so nested calls cannot deadlock the
+  // pool.
+  void ParallelFor(size_t begin, size_t end,
+                   const std::function<void(size_t)> &body);
+
+  // Returns the number of worker threads in the pool.
+  size_t NumWorkers() const { return workers_.size(); }
+
+ private:
+  // A worker's task deque and the lock guarding it.
+  struct Worker {
+    // Guards |tasks|.
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+    // Pending tasks. The owning worker pops from the back; thieves steal from
+    // the front.
+    std::deque<std::function<void()>> tasks;
+
+    pthread_t thread_id;
+  };
+
+  // Start routine passed to pthread_create(), bound to a pool and worker
+  // index pair.
+  static void *WorkerMain(void *args);
+
+  // Worker main loop: drain the worker's own deque, steal from the others,
+  // and sleep until new work arrives or the pool shuts down.
+  void WorkerLoop(size_t worker_index);
+
+  // Pops a task from the back of worker |worker_index|'s own deque, or steals
+  // one from the front of another worker's deque. Returns false if every
+  // deque is empty.
+  bool TryGetTask(size_t worker_index, std::function<void()> *task);
+
+  // Runs |*task|, releases it, and retires it from unfinished_tasks_.
+  void RunTask(std::function<void()> *task);
+
+  // Fixed set of workers; never resized after construction.
+  std::vector<Worker> workers_;
+
+  // Guards work_epoch_, unfinished_tasks_ and shutting_down_.
+  pthread_mutex_t pool_lock_ = PTHREAD_MUTEX_INITIALIZER;
+
+  // Signaled when new work is scheduled or the pool begins shutting down.
+  pthread_cond_t wake_cond_ = PTHREAD_COND_INITIALIZER;
+
+  // Broadcast when unfinished_tasks_ drops to zero.
+  pthread_cond_t done_cond_ = PTHREAD_COND_INITIALIZER;
+
+  // Bumped on every Schedule() so that a worker which finds all deques empty
+  // can detect work scheduled after its scan, without a lost-wakeup race.
+  uint64_t work_epoch_ = 0;
+
+  // Tasks scheduled but not yet finished running.
+  size_t unfinished_tasks_ = 0;
+
+  // Set by the destructor once all outstanding tasks have finished.
+  bool shutting_down_ = false;
+
+  // Round-robin target for tasks scheduled from outside the pool.
+  std::atomic<size_t> next_worker_{0};
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_POSIX_THREADING_THREAD_POOL_H_
@@ -24,10 +24,13 @@
 
 #include "asylo/platform/common/time_util.h"
 #include "asylo/platform/host_call/trusted/host_calls.h"
+#include "asylo/platform/primitives/util/trusted_clock.h"
 
 using asylo::NanosecondsToTimeSpec;
 using asylo::NanosecondsToTimeVal;
 using asylo::TimeSpecToNanoseconds;
+using asylo::primitives::SharedClockReadMonotonic;
+using asylo::primitives::SharedClockReadRealtime;
 
 namespace {
 
@@ -35,6 +38,25 @@ namespace {
 static_assert(sizeof(std::atomic<int64_t>) == sizeof(int64_t),
               "lockfree int64_t is unavailable.");
 
+// Largest CLOCK_MONOTONIC value returned so far, across both the shared
+// clock page and the host-call fallback. The page lags the host clock by up
+// to the updater's refresh interval, and either source may serve any given
+// call - a page reading taken after a host reading (or vice versa) must not
+// appear to move the clock backwards.
+std::atomic<int64_t> monotonic_floor{0};
+
+// Raises the floor to |reading_ns| and returns the larger of the two, so
+// every CLOCK_MONOTONIC result is at least as large as all previous ones
+// from either source.
+int64_t ClampMonotonic(int64_t reading_ns) {
+  int64_t floor = monotonic_floor.load(std::memory_order_relaxed);
+  while (reading_ns > floor &&
+         !monotonic_floor.compare_exchange_weak(floor, reading_ns,
+                                                std::memory_order_relaxed)) {
+  }
+  return reading_ns > floor ? reading_ns : floor;
+}
+
 }  // namespace
 
 extern "C" {
@@ -51,6 +73,14 @@ int enclave_gettimeofday(struct timeval *__restrict time, void *timezone) {
     return -1;
   }
 
+  // Serve the read from the shared clock page when one is installed, without
+  // leaving the enclave.
+  int64_t shared_ns;
+  if (SharedClockReadRealtime(&shared_ns)) {
+    NanosecondsToTimeVal(time, shared_ns);
+    return 0;
+  }
+
   struct timeval tval {};
   int result = enc_untrusted_gettimeofday(&tval, nullptr);
   time->tv_sec = tval.tv_sec;
@@ -61,6 +91,18 @@ int enclave_gettimeofday(struct timeval *__restrict time, void *timezone) {
 int enclave_times(struct tms *buf) { return enc_untrusted_times(buf); }
 
 int clock_gettime(clockid_t clock_id, struct timespec *time) {
+  // Serve CLOCK_REALTIME and CLOCK_MONOTONIC from the shared clock page when
+  // one is installed, without leaving the enclave.
+  int64_t shared_ns;
+  if (clock_id == CLOCK_REALTIME && SharedClockReadRealtime(&shared_ns)) {
+    NanosecondsToTimeSpec(time, shared_ns);
+    return 0;
+  }
+  if (clock_id == CLOCK_MONOTONIC && SharedClockReadMonotonic(&shared_ns)) {
+    NanosecondsToTimeSpec(time, ClampMonotonic(shared_ns));
+    return 0;
+  }
+
   int result = enc_untrusted_clock_gettime(clock_id, time);
   if (clock_id == CLOCK_MONOTONIC) {
     int64_t clock_monotonic = TimeSpecToNanoseconds(time);
@@ -68,6 +110,10 @@ int clock_gettime(clockid_t clock_id, struct timespec *time) {
     // CLOCK_MONOTONIC should never go backwards.
     if (clock_monotonic < last_tick) abort();
     last_tick = clock_monotonic;
+    // Feed the host reading into the shared floor as well: this path also
+    // serves calls that lose a seqlock race with the page updater, so a
+    // subsequent page reading must not be allowed to lag behind it.
+    NanosecondsToTimeSpec(time, ClampMonotonic(clock_monotonic));
   }
   return result;
 }
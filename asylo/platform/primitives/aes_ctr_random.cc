@@ -0,0 +1,115 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/aes_ctr_random.h"
+
+#include <cpuid.h>
+#include <immintrin.h>
+#include <string.h>
+
+namespace asylo {
+namespace {
+
+// Zeroes |len| bytes at |buf| through a volatile pointer so the compiler
+// cannot elide the wipe of dead key material.
+void Cleanse(void *buf, size_t len) {
+  volatile uint8_t *bytes = static_cast<volatile uint8_t *>(buf);
+  while (len--) {
+    *bytes++ = 0;
+  }
+}
+
+// One step of the AES-128 key schedule. |keygened| is the output of
+// _mm_aeskeygenassist_si128 on the previous round key.
+__m128i KeyExpandStep(__m128i key, __m128i keygened) {
+  keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3, 3, 3, 3));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, keygened);
+}
+
+// _mm_aeskeygenassist_si128 requires an immediate round constant, so the
+// expansion step is spelled as a macro over KeyExpandStep.
+#define ASYLO_AES_EXPAND(key, rcon) \
+  KeyExpandStep(key, _mm_aeskeygenassist_si128(key, rcon))
+
+// Encrypts the single block |block| under the expanded key |round_keys|.
+__m128i EncryptBlock(__m128i block, const __m128i round_keys[11]) {
+  block = _mm_xor_si128(block, round_keys[0]);
+  for (int round = 1; round < 10; ++round) {
+    block = _mm_aesenc_si128(block, round_keys[round]);
+  }
+  return _mm_aesenclast_si128(block, round_keys[10]);
+}
+
+bool cpuid_aesni() {
+  unsigned int eax, ebx, ecx, edx;
+  __cpuid(1, eax, ebx, ecx, edx);
+  // Bit 25 of ECX is set => machine supports AES-NI.
+  return !!(ecx & (1 << 25));
+}
+
+}  // namespace
+
+bool aesni_supported() {
+  static bool supported = cpuid_aesni();
+  return supported;
+}
+
+void AesCtrFill(const uint8_t seed[kAesCtrSeedSize], uint8_t *out,
+                size_t count) {
+  __m128i round_keys[11];
+  round_keys[0] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(seed));
+  round_keys[1] = ASYLO_AES_EXPAND(round_keys[0], 0x01);
+  round_keys[2] = ASYLO_AES_EXPAND(round_keys[1], 0x02);
+  round_keys[3] = ASYLO_AES_EXPAND(round_keys[2], 0x04);
+  round_keys[4] = ASYLO_AES_EXPAND(round_keys[3], 0x08);
+  round_keys[5] = ASYLO_AES_EXPAND(round_keys[4], 0x10);
+  round_keys[6] = ASYLO_AES_EXPAND(round_keys[5], 0x20);
+  round_keys[7] = ASYLO_AES_EXPAND(round_keys[6], 0x40);
+  round_keys[8] = ASYLO_AES_EXPAND(round_keys[7], 0x80);
+  round_keys[9] = ASYLO_AES_EXPAND(round_keys[8], 0x1B);
+  round_keys[10] = ASYLO_AES_EXPAND(round_keys[9], 0x36);
+
+  __m128i counter =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(seed + 16));
+  // Incrementing only the low 64-bit lane keeps counter blocks unique for the
+  // 2^64 blocks permitted per seed.
+  const __m128i one = _mm_set_epi64x(0, 1);
+
+  while (count >= 16) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                     EncryptBlock(counter, round_keys));
+    counter = _mm_add_epi64(counter, one);
+    out += 16;
+    count -= 16;
+  }
+  if (count > 0) {
+    uint8_t last_block[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(last_block),
+                     EncryptBlock(counter, round_keys));
+    memcpy(out, last_block, count);
+    Cleanse(last_block, sizeof(last_block));
+  }
+
+  Cleanse(round_keys, sizeof(round_keys));
+  Cleanse(&counter, sizeof(counter));
+}
+
+}  // namespace asylo
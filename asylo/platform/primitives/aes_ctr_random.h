@@ -0,0 +1,46 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_AES_CTR_RANDOM_H_
+#define ASYLO_PLATFORM_PRIMITIVES_AES_CTR_RANDOM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace asylo {
+
+// Number of seed bytes consumed by AesCtrFill(): a 16-byte AES-128 key
+// followed by a 16-byte initial counter block.
+constexpr size_t kAesCtrSeedSize = 32;
+
+// Returns whether the CPU supports the AES-NI instructions AesCtrFill() is
+// built on.
+bool aesni_supported();
+
+// Expands the 32-byte |seed| into |count| bytes of AES-128-CTR keystream
+// written to |out|. The expansion is stateless: key schedule and counter live
+// on the stack and are wiped before returning, so each seed yields one
+// independent output stream and leaves nothing recoverable in memory. The
+// caller must provide a fresh, uniformly random seed per call and must not
+// request more than 2^64 blocks from one seed. Requires aesni_supported().
+void AesCtrFill(const uint8_t seed[kAesCtrSeedSize], uint8_t *out,
+                size_t count);
+
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_AES_CTR_RANDOM_H_
@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <type_traits>
 
+#include "asylo/platform/primitives/extent.h"
 #include "asylo/platform/primitives/primitive_status.h"
 
 namespace asylo {
@@ -34,7 +35,7 @@ constexpr uint64_t dlopen_trampoline_address = 0x7e0000000000;
 // Trampoline magic number and version.
 constexpr uint64_t kTrampolineMagicNumber =
     0x446c4f54724d6167;  // "DlOTrMag"
-constexpr uint64_t kTrampolineVersion = 0;
+constexpr uint64_t kTrampolineVersion = 1;
 
 // Collection of handlers implemented by untrusted dlopen component and passed
 // to the trusted one to use. The trusted component is statically built shared
@@ -53,6 +54,16 @@ struct DlopenTrampoline {
                                      void **output, size_t *output_size);
   void *(*asylo_local_alloc_handler)(size_t size);
   void (*asylo_local_free_handler)(void *ptr);
+
+  // Version 1: same-address-space fast path for exit calls. Takes the
+  // MessageWriter's extents by pointer instead of a serialized copy of their
+  // payloads; both sides share one address space in this backend, so the
+  // handler reads the payloads in place. |extents| only needs to stay valid
+  // for the duration of the call.
+  PrimitiveStatus (*asylo_exit_call_fast)(uint64_t untrusted_selector,
+                                          const Extent *extents,
+                                          size_t extent_count, void **output,
+                                          size_t *output_size);
 };
 
 // Global accessor to DlopenTrampoline (can be used by both trusted and
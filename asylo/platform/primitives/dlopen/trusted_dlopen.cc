@@ -20,6 +20,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 #include "asylo/platform/primitives/dlopen/shared_dlopen.h"
 #include "asylo/platform/primitives/primitive_status.h"
@@ -138,6 +139,45 @@ extern "C" PrimitiveStatus asylo_enclave_call(uint64_t selector,
   return status;
 }
 
+// Same-address-space fast entry point: the caller passes the MessageWriter's
+// extents by pointer and the reader aliases their payloads in place. This
+// skips the serialized copy and the trusted-buffer copy of asylo_enclave_call;
+// since this backend shares one address space with the untrusted application
+// and provides no isolation, the dropped copy is simulation fidelity, not a
+// security boundary. |extents| only needs to stay valid for the call.
+extern "C" PrimitiveStatus asylo_enclave_call_fast(uint64_t selector,
+                                                   const Extent *extents,
+                                                   size_t extent_count,
+                                                   void **output,
+                                                   size_t *output_len) {
+  if (GetDlopenTrampoline()->magic_number != kTrampolineMagicNumber ||
+      GetDlopenTrampoline()->version != kTrampolineVersion) {
+    TrustedPrimitives::BestEffortAbort(
+        "DlopenState trampoline version or magic number mismatch");
+    return PrimitiveStatus::OkStatus();
+  }
+
+  MessageReader in;
+  MessageWriter out;
+  if (extent_count > 0) {
+    in.DeserializeAliased(
+        extent_count, [extents](size_t i) { return extents[i]; },
+        /*releaser=*/[]() {});
+  }
+
+  PrimitiveStatus status = InvokeEntryHandler(selector, &in, &out);
+  size_t output_size = out.MessageSize();
+
+  if (output && output_size > 0) {
+    // Serialize |out| to untrusted memory. The untrusted caller is still
+    // responsible for freeing |*output|.
+    *output = TrustedPrimitives::UntrustedLocalAlloc(output_size);
+    out.Serialize(*output);
+  }
+  *output_len = output_size;
+  return status;
+}
+
 bool TrustedPrimitives::IsInsideEnclave(const void *addr, size_t size) {
   auto enclave_begin =
       reinterpret_cast<const uint8_t *>(DlopenState::GetInstance());
@@ -182,19 +222,19 @@ void *TrustedPrimitives::UntrustedLocalMemcpy(void *dest, const void *src,
 PrimitiveStatus TrustedPrimitives::UntrustedCall(uint64_t untrusted_selector,
                                                  MessageWriter *input,
                                                  MessageReader *output) {
-  size_t input_size = 0;
-  void *input_buffer = nullptr;
+  // Both sides of this backend share one address space, so hand |input|'s
+  // extents to the untrusted handler by pointer instead of serializing their
+  // payloads into an untrusted copy. The extents stay valid for the duration
+  // of the synchronous exit call.
+  std::vector<Extent> extents;
   if (input) {
-    input_size = input->MessageSize();
-    if (input_size > 0) {
-      input_buffer = TrustedPrimitives::UntrustedLocalAlloc(input_size);
-      input->Serialize(input_buffer);
-    }
+    extents.reserve(input->size());
+    input->Serialize([&extents](Extent extent) { extents.push_back(extent); });
   }
   size_t output_size = 0;
   void *output_buffer = nullptr;
-  auto status = GetDlopenTrampoline()->asylo_exit_call(
-      untrusted_selector, input_buffer, input_size, &output_buffer,
+  auto status = GetDlopenTrampoline()->asylo_exit_call_fast(
+      untrusted_selector, extents.data(), extents.size(), &output_buffer,
       &output_size);
   if (output_buffer) {
     // For the results obtained in |output_buffer|, copy them to |output| before
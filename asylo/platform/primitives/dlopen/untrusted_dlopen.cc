@@ -26,6 +26,7 @@
 #include <cstdlib>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/base/call_once.h"
 #include "absl/debugging/leak_check.h"
@@ -69,6 +70,33 @@ PrimitiveStatus dlopen_asylo_exit_call(uint64_t untrusted_selector,
   return status;
 }
 
+// Same-address-space fast path for exit calls: the extents alias trusted
+// memory directly and are only guaranteed valid for the duration of the call,
+// so the reader aliases them without copying and is drained before returning.
+PrimitiveStatus dlopen_asylo_exit_call_fast(uint64_t untrusted_selector,
+                                            const Extent *extents,
+                                            size_t extent_count, void **output,
+                                            size_t *output_size) {
+  MessageReader in;
+  if (extent_count > 0) {
+    in.DeserializeAliased(
+        extent_count, [extents](size_t i) { return extents[i]; },
+        /*releaser=*/[]() {});
+  }
+  *output_size = 0;
+  *output = nullptr;
+  MessageWriter out;
+  const auto status = Client::ExitCallback(untrusted_selector, &in, &out);
+  if (status.ok()) {
+    *output_size = out.MessageSize();
+    if (*output_size > 0) {
+      *output = malloc(*output_size);
+      out.Serialize(*output);
+    }
+  }
+  return status;
+}
+
 void *dlopen_asylo_local_alloc_handler(size_t size) { return malloc(size); }
 
 void dlopen_asylo_local_free_handler(void *ptr) { return free(ptr); }
@@ -101,6 +129,7 @@ void InitTrampolineOnce() {
       &dlopen_asylo_local_alloc_handler;
   GetDlopenTrampoline()->asylo_local_free_handler =
       &dlopen_asylo_local_free_handler;
+  GetDlopenTrampoline()->asylo_exit_call_fast = &dlopen_asylo_exit_call_fast;
 }
 
 }  // namespace
@@ -153,6 +182,12 @@ StatusOr<std::shared_ptr<Client>> DlopenBackend::Load(
   }
   client->enclave_call_ = reinterpret_cast<EnclaveCallPtr>(asylo_enclave_call);
 
+  // Resolve the optional same-address-space fast entry point. Enclave
+  // binaries built before the fast path keep working through the serialized
+  // entry point above.
+  client->enclave_call_fast_ = reinterpret_cast<EnclaveCallFastPtr>(
+      dlsym(client->dl_handle_, "asylo_enclave_call_fast"));
+
   return client;
 }
 
@@ -173,19 +208,33 @@ Status DlopenEnclaveClient::EnclaveCallInternal(uint64_t selector,
         "Enclave client closed or uninitialized.");
   }
 
-  size_t input_size = 0;
-  std::unique_ptr<char[]> input_buffer;
-  if (input) {
-    input_size = input->MessageSize();
-    if (input_size > 0) {
-      input_buffer = absl::make_unique<char[]>(input_size);
-      input->Serialize(input_buffer.get());
-    }
-  }
   size_t output_size = 0;
   void *output_buffer = nullptr;
-  const auto status = enclave_call_(selector, input_buffer.get(), input_size,
-                                    &output_buffer, &output_size);
+  PrimitiveStatus status;
+  if (enclave_call_fast_) {
+    // Same address space: hand the writer's extents to the enclave by pointer
+    // instead of serializing their payloads into a flat copy. The extents
+    // vector and the payloads it points to outlive the synchronous call.
+    std::vector<Extent> extents;
+    if (input) {
+      extents.reserve(input->size());
+      input->Serialize([&extents](Extent extent) { extents.push_back(extent); });
+    }
+    status = enclave_call_fast_(selector, extents.data(), extents.size(),
+                                &output_buffer, &output_size);
+  } else {
+    size_t input_size = 0;
+    std::unique_ptr<char[]> input_buffer;
+    if (input) {
+      input_size = input->MessageSize();
+      if (input_size > 0) {
+        input_buffer = absl::make_unique<char[]>(input_size);
+        input->Serialize(input_buffer.get());
+      }
+    }
+    status = enclave_call_(selector, input_buffer.get(), input_size,
+                           &output_buffer, &output_size);
+  }
   if (output_buffer) {
     output->Deserialize(output_buffer, output_size);
     free(output_buffer);
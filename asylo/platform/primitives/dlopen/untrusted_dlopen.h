@@ -49,6 +49,15 @@ using EnclaveCallPtr = PrimitiveStatus (*)(uint64_t trusted_selector,
                                            const void *input, size_t input_size,
                                            void **output, size_t *output_size);
 
+// Type signature of the same-address-space fast entry function pointer. The
+// input message's extents are passed by pointer with their payloads read in
+// place, with no serialized copy; see asylo_enclave_call_fast.
+using EnclaveCallFastPtr = PrimitiveStatus (*)(uint64_t trusted_selector,
+                                               const Extent *extents,
+                                               size_t extent_count,
+                                               void **output,
+                                               size_t *output_size);
+
 // dlopen implementation of the generic "EnclaveBackend" concept.
 struct DlopenBackend {
   // Loads a dlopen enclave from a file system path for the untrusted
@@ -84,6 +93,11 @@ class DlopenEnclaveClient : public Client {
   // execution mode and entering the enclave with a selector and message
   // buffers.
   EnclaveCallPtr enclave_call_ = nullptr;
+
+  // Fast entry point passing message extents by pointer without copies, or
+  // nullptr when the loaded enclave binary predates it. Used in preference to
+  // enclave_call_ when available.
+  EnclaveCallFastPtr enclave_call_fast_ = nullptr;
 };
 
 }  // namespace primitives
@@ -41,6 +41,70 @@ static constexpr uint64_t kSelectorAsyloDonateThread = 2;
 /// Enclave finalization entry point selector.
 static constexpr uint64_t kSelectorAsyloFini = 3;
 
+/// Switchless call worker entry point selector. Threads entering here stay
+/// resident in the enclave serving calls from a shared-memory queue.
+static constexpr uint64_t kSelectorAsyloSwitchlessWorker = 4;
+
+/// Entry point selector for configuring the switchless exit call channel.
+static constexpr uint64_t kSelectorAsyloSwitchlessExitInit = 5;
+
+/// Entry point selector for executing a batch of enclave calls in a single
+/// enclave transition.
+static constexpr uint64_t kSelectorAsyloBatchCall = 6;
+
+/// Entry point selector for configuring the in-enclave sampling profiler.
+static constexpr uint64_t kSelectorAsyloProfilerInit = 7;
+
+/// Entry point selector for installing the shared clock page, which serves
+/// in-enclave clock reads without an enclave exit.
+static constexpr uint64_t kSelectorAsyloSharedClockInit = 8;
+
+/// Entry point selector for controlling and snapshotting the per-sysno
+/// system call statistics accumulated inside the enclave.
+static constexpr uint64_t kSelectorAsyloSyscallStats = 9;
+
+/// Commands accepted by the `kSelectorAsyloSyscallStats` entry handler.
+static constexpr uint64_t kSyscallStatsEnable = 1;
+static constexpr uint64_t kSyscallStatsDisable = 2;
+static constexpr uint64_t kSyscallStatsSnapshot = 3;
+static constexpr uint64_t kSyscallStatsReset = 4;
+
+/// Entry point selector for reading the phase-stamped initialization timeline
+/// recorded by the trusted runtime.
+static constexpr uint64_t kSelectorAsyloInitTiming = 10;
+
+/// Initialization phases stamped by the trusted runtime and reported by the
+/// `kSelectorAsyloInitTiming` entry handler.
+static constexpr uint64_t kInitPhaseFirstEntry = 1;
+static constexpr uint64_t kInitPhaseRuntimeHandlersRegistered = 2;
+static constexpr uint64_t kInitPhaseRuntimeInitialized = 3;
+static constexpr uint64_t kInitPhaseUserInitBegin = 4;
+static constexpr uint64_t kInitPhaseIOInitialized = 5;
+static constexpr uint64_t kInitPhaseLoggingInitialized = 6;
+static constexpr uint64_t kInitPhaseAssertionAuthoritiesInitialized = 7;
+static constexpr uint64_t kInitPhaseUserInitialized = 8;
+
+/// Entry point selector for configuring priority-aware entry admission
+/// control and reading its queueing statistics.
+static constexpr uint64_t kSelectorAsyloEntryThrottle = 11;
+
+/// Commands accepted by the `kSelectorAsyloEntryThrottle` entry handler.
+static constexpr uint64_t kEntryThrottleSetPriority = 1;
+static constexpr uint64_t kEntryThrottleSetBulkLimit = 2;
+static constexpr uint64_t kEntryThrottleSnapshot = 3;
+static constexpr uint64_t kEntryThrottleReset = 4;
+
+/// Entry priority classes accepted by `kEntryThrottleSetPriority`. Control
+/// entries are never throttled; bulk entries are subject to the configured
+/// concurrency limit.
+static constexpr uint64_t kEntryPriorityControl = 0;
+static constexpr uint64_t kEntryPriorityBulk = 1;
+
+/// Entry point selector for the periodic timer tick driving the in-enclave
+/// timer wheel, which wakes expired timed waiters without a host timer per
+/// wait.
+static constexpr uint64_t kSelectorAsyloTimerTick = 12;
+
 //////////////////////////////////////
 //      Exit handler selectors      //
 //////////////////////////////////////
@@ -55,11 +119,11 @@ static constexpr uint64_t kSelectorHostCall = 88;
 
 /// Selector values in [`kSelectorRemote`, `kSelectorUser`) range are reserved
 /// for remote backend needs and cannot be used by any other component.
-static constexpr uint64_t kSelectorRemote = 120;
+static constexpr uint64_t kSelectorRemote = 160;
 
 /// Selector values less than `kSelectorUser` are reserved by the runtime and
 /// may not be registered by the applications.
-static constexpr uint64_t kSelectorUser = 128;
+static constexpr uint64_t kSelectorUser = 168;
 
 }  // namespace primitives
 }  // namespace asylo
@@ -21,7 +21,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <algorithm>
+#include <atomic>
 
+#include "asylo/platform/primitives/aes_ctr_random.h"
 #include "asylo/platform/primitives/trusted_runtime.h"
 
 namespace {
@@ -65,6 +67,78 @@ static bool cpuid_rdrand() {
   return !!(ecx & (1 << 30));
 }
 
+// Per-thread pool of pre-generated random bytes for small requests. Crypto
+// code requests tiny amounts (e.g. 12-byte AEAD nonces) constantly, and each
+// RDRAND instruction costs hundreds of cycles; the pool pays four RDRANDs per
+// refill to seed an AES-128-CTR expansion (RDRAND's own output is itself a
+// hardware AES-CTR DRBG, so one software expansion of a 256-bit RDRAND seed
+// preserves the same security level) and then serves requests with a memcpy.
+//
+// Every refill takes a fresh hardware seed, and nothing but the pool persists
+// between refills, so compromise of one refill's output reveals nothing about
+// earlier or later refills. Consumed bytes are wiped as they are handed out.
+static constexpr size_t kRandPoolSize = 1024;
+
+// Requests larger than this bypass the pool and get a dedicated AES-CTR
+// expansion from a fresh seed straight into the caller's buffer.
+static constexpr size_t kRandPoolMaxRequest = 256;
+
+// Trivially destructible on purpose so thread exit needs no TLS destructor;
+// unconsumed bytes are simply dropped. |available| counts the unconsumed
+// bytes at the tail of |bytes|; |generation| records the value of
+// |rand_pool_generation| at the refill that produced them.
+struct ThreadRandPool {
+  uint8_t bytes[kRandPoolSize];
+  size_t available;
+  uint64_t generation;
+};
+
+thread_local ThreadRandPool thread_rand_pool = {};
+
+// Fork generation of the pre-generated pools. A restored enclave bumps this
+// through enc_invalidate_rand_pools, and PooledRandom discards any pool
+// refilled under an older generation. Invalidation has to work this way
+// because the pools are thread-local: the thread that restores a snapshot
+// runs on a different TCS than the threads whose pools were captured in it,
+// so no flush issued from the restore path could reach them directly.
+std::atomic<uint64_t> rand_pool_generation(0);
+
+// Draws a fresh 256-bit seed from RDRAND and expands |count| bytes of
+// AES-CTR keystream into |out|.
+static void SeededCtrFill(uint8_t *out, size_t count) {
+  uint64_t seed[asylo::kAesCtrSeedSize / sizeof(uint64_t)];
+  for (uint64_t &word : seed) {
+    rdrand64(&word);
+  }
+  asylo::AesCtrFill(reinterpret_cast<uint8_t *>(seed), out, count);
+  // Wipe the seed so the pool contents cannot be re-derived from it.
+  volatile uint64_t *words = seed;
+  for (size_t i = 0; i < sizeof(seed) / sizeof(seed[0]); ++i) {
+    words[i] = 0;
+  }
+}
+
+// Serves |count| <= kRandPoolMaxRequest bytes from the calling thread's pool,
+// refilling it first if it holds too few bytes or was filled before the last
+// fork. A stale pool is overwritten in full by the refill, so bytes the
+// parent pre-generated before a snapshot are destroyed, never handed out.
+static void PooledRandom(uint8_t *buf, size_t count) {
+  ThreadRandPool *pool = &thread_rand_pool;
+  const uint64_t generation =
+      rand_pool_generation.load(std::memory_order_relaxed);
+  if (pool->generation != generation || pool->available < count) {
+    SeededCtrFill(pool->bytes, kRandPoolSize);
+    pool->available = kRandPoolSize;
+    pool->generation = generation;
+  }
+  uint8_t *source = &pool->bytes[kRandPoolSize - pool->available];
+  memcpy(buf, source, count);
+  // Wipe the consumed bytes so the handed-out values cannot be read back out
+  // of the pool afterwards.
+  memset(source, 0, count);
+  pool->available -= count;
+}
+
 }  // namespace
 
 namespace asylo {
@@ -83,10 +157,22 @@ extern "C" int enc_hardware_random_entropy() {
   return 0;
 }
 
+extern "C" void enc_invalidate_rand_pools() {
+  rand_pool_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
 extern "C" ssize_t enc_hardware_random(uint8_t *buf, size_t count) {
   if (!asylo::rdrand_supported()) {
     return count;
   }
+  if (asylo::aesni_supported()) {
+    if (count <= kRandPoolMaxRequest) {
+      PooledRandom(buf, count);
+    } else {
+      SeededCtrFill(buf, count);
+    }
+    return count;
+  }
   size_t unaligned_bytes;
   size_t aligned_count;
   size_t partial_bytes;
@@ -18,11 +18,13 @@
 
 #include "asylo/platform/primitives/remote/communicator.h"
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <queue>
 #include <utility>
 
+#include "absl/base/optimization.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
@@ -138,22 +140,45 @@ class Communicator::ThreadActivityWorkQueue {
   ThreadActivityWorkQueue &operator=(const ThreadActivityWorkQueue &other) =
       delete;
 
-  // Static map of per-thread activity thread contexts: each participating
-  // thread is added when the thread first shows up on Communicator. Keyed by
-  // the thread id which made the outermost Invoke call. While processing that
-  // call, nested Invokes could have been sent by this Communicator or its
-  // counterpart with an expectation that they will be handled by the same
-  // thread on each side. 'invocation_thread_id' is passed with every Invoke RPC
-  // request and allows Communicator to assign the handling to the matching
-  // worker thread.
-  static MutexGuarded<
-      absl::flat_hash_map<Thread::Id, std::unique_ptr<ThreadActivityWorkQueue>>>
-      *map() {
-    static const auto static_map = new MutexGuarded<absl::flat_hash_map<
-        Thread::Id, std::unique_ptr<ThreadActivityWorkQueue>>>(
-        absl::flat_hash_map<Thread::Id,
-                            std::unique_ptr<ThreadActivityWorkQueue>>());
-    return static_map;
+  using ThreadMap =
+      absl::flat_hash_map<Thread::Id, std::unique_ptr<ThreadActivityWorkQueue>>;
+
+  // Number of shards the static thread context map is split into.
+  static constexpr size_t kMapShards = 16;
+
+  // Static sharded map of per-thread activity thread contexts: each
+  // participating thread is added when the thread first shows up on
+  // Communicator. Keyed by the thread id which made the outermost Invoke call.
+  // While processing that call, nested Invokes could have been sent by this
+  // Communicator or its counterpart with an expectation that they will be
+  // handled by the same thread on each side. 'invocation_thread_id' is passed
+  // with every Invoke RPC request and allows Communicator to assign the
+  // handling to the matching worker thread.
+  //
+  // The map is consulted on every dispatched message, so it is sharded by
+  // invocation thread id: dispatch for unrelated invocation threads contends
+  // on different mutexes and touches different buckets, instead of bouncing
+  // one hot map and its lock between cores.
+  static MutexGuarded<ThreadMap> *map_shard(Thread::Id invocation_thread_id) {
+    static const std::array<MutexGuarded<ThreadMap> *, kMapShards>
+        *const static_shards = [] {
+          auto shards =
+              new std::array<MutexGuarded<ThreadMap> *, kMapShards>();
+          for (auto &shard : *shards) {
+            shard = new MutexGuarded<ThreadMap>(ThreadMap());
+          }
+          return shards;
+        }();
+    return (*static_shards)[invocation_thread_id % kMapShards];
+  }
+
+  // Signals all registered thread contexts to exit and destructs them,
+  // releasing each shard's lock before the contexts (and their worker
+  // threads) are destroyed.
+  static void ClearAllShards() {
+    for (size_t shard = 0; shard < kMapShards; ++shard) {
+      map_shard(shard)->Release().clear();
+    }
   }
 
  private:
@@ -173,7 +198,11 @@ class Communicator::ThreadActivityWorkQueue {
     // Flag inidicating that the thread needs to exit.
     bool is_exiting = false;
   };
-  MutexGuarded<WrappedMessageQueue> wrapped_messages_queue_;
+  // Cache-line aligned: the queue and its mutex are written by the dispatch
+  // thread and read by the matching worker thread, so they must not share a
+  // line with this context's cold members below.
+  ABSL_CACHELINE_ALIGNED MutexGuarded<WrappedMessageQueue>
+      wrapped_messages_queue_;
 
   // Host thread id (for host side it matches the current thread).
   const Thread::Id host_thread_id_;
@@ -187,7 +216,8 @@ class Communicator::ThreadActivityWorkQueue {
 StatusOr<Communicator::ThreadActivityWorkQueue *>
 Communicator::LocateOrCreateThreadActivityWorkQueue(
     Thread::Id invocation_thread_id) {
-  auto locked_threads_map = ThreadActivityWorkQueue::map()->Lock();
+  auto locked_threads_map =
+      ThreadActivityWorkQueue::map_shard(invocation_thread_id)->Lock();
   auto it = locked_threads_map->find(invocation_thread_id);
   if (it == locked_threads_map->end()) {
     auto ins = locked_threads_map->emplace(
@@ -214,6 +244,10 @@ Communicator::LocateOrCreateThreadActivityWorkQueue(
       // Create new thread to handle requests associated with that thread_id.
       // On a host side we are always called by that very thread (when we first
       // send something from it).
+      // The worker is created by the dispatch thread that received the first
+      // invocation for this host thread and so inherits that thread's CPU
+      // affinity mask, keeping the handler close to the cache domain where
+      // its messages are deserialized.
       auto *const thread_activity_context = it->second.get();
       auto new_worker =
           absl::make_unique<Thread>([this, thread_activity_context] {
@@ -322,7 +356,7 @@ Communicator::~Communicator() {
   // For target Communicator or the last active Communicator in host: signal
   // created threads that they need to stop (when thread contexts are
   // destructed on target, they will wait for stoppage to occur).
-  ThreadActivityWorkQueue::map()->Release().clear();
+  ThreadActivityWorkQueue::ClearAllShards();
 }
 
 void Communicator::set_handler(
@@ -351,7 +385,8 @@ void Communicator::DisposeOfThread(Thread::Id exiting_thread_id) {
   CHECK(!is_host());
   std::unique_ptr<ThreadActivityWorkQueue> thread_context;
   {
-    auto locked_threads_map = ThreadActivityWorkQueue::map()->Lock();
+    auto locked_threads_map =
+        ThreadActivityWorkQueue::map_shard(exiting_thread_id)->Lock();
     auto it = locked_threads_map->find(exiting_thread_id);
     if (it == locked_threads_map->end()) {
       return;
@@ -414,6 +449,10 @@ Status Communicator::SendCommunication(const CommunicationMessage &message) {
   return client_->SendCommunication(message);
 }
 
+void Communicator::SendCommunicationAsync(const CommunicationMessage &message) {
+  client_->SendCommunicationAsync(message);
+}
+
 int Communicator::server_port() const { return service_->server_port(); }
 
 Status Communicator::IsMessageValid(const CommunicationMessage &message) {
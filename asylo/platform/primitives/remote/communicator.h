@@ -221,6 +221,12 @@ class Communicator {
   // Sends |message| (request or response) to the counterpart Communicator.
   Status SendCommunication(const CommunicationMessage &message);
 
+  // Sends |message| to the counterpart Communicator without waiting for the
+  // delivery confirmation, allowing the calling thread to pipeline further
+  // work (such as processing the next queued message) with the confirmation
+  // round trip. Delivery failures are logged rather than returned.
+  void SendCommunicationAsync(const CommunicationMessage &message);
+
   // Assigns |wrapped_message| to be processed on the thread that matches its
   // invocation_thread_id.
   void QueueMessageForThread(CommunicationMessagePtr wrapped_message);
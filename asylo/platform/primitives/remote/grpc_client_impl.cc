@@ -20,9 +20,12 @@
 
 #include <cstdint>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <utility>
 
+#include "absl/flags/flag.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -40,12 +43,20 @@
 #include "asylo/util/status_macros.h"
 #include "asylo/util/statusor.h"
 #include "asylo/util/thread.h"
+#include "include/grpc/impl/codegen/compression_types.h"
 #include "include/grpc/support/time.h"
 #include "include/grpcpp/support/status.h"
 #include "include/grpcpp/create_channel.h"
+#include "include/grpcpp/impl/codegen/async_unary_call.h"
 #include "include/grpcpp/security/credentials.h"
 #include "include/grpcpp/support/channel_arguments.h"
 
+ABSL_FLAG(int64_t, communication_compression_threshold_bytes, 4096,
+          "Minimal serialized CommunicationMessage size, in bytes, at which "
+          "the message is sent compressed (negative value disables "
+          "compression). Compression is negotiated by gRPC; a counterpart "
+          "that does not support it receives the message uncompressed.");
+
 namespace asylo {
 namespace primitives {
 
@@ -67,20 +78,54 @@ void SerializeIntoRequest(CommunicationMessage *request,
   });
 }
 
-void DeserializeFromReply(const CommunicationMessage &reply,
+void DeserializeFromReply(Communicator::CommunicationMessagePtr reply,
                           Communicator::Invocation *invocation) {
-  if (reply.has_status()) {
-    invocation->status = StatusFromProto(reply.status());
+  if (reply->has_status()) {
+    invocation->status = StatusFromProto(reply->status());
     return;
   }
 
-  // Derialize results from response.
-  invocation->reader.Deserialize(reply.items_size(), [&reply](size_t i) {
-    const auto &item = reply.items(i);
-    return Extent{item.data(), item.size()};
-  });
+  // Deserialize results from response without copying the payloads: the
+  // extents alias the reply message, which is kept alive by the reader and
+  // released (letting the underlying RPC complete) once the invocation
+  // results have been consumed.
+  const CommunicationMessage *raw_reply = reply.get();
+  auto reply_holder =
+      std::make_shared<Communicator::CommunicationMessagePtr>(std::move(reply));
+  invocation->reader.DeserializeAliased(
+      raw_reply->items_size(),
+      [raw_reply](size_t i) {
+        const auto &item = raw_reply->items(i);
+        return Extent{item.data(), item.size()};
+      },
+      [reply_holder]() mutable { reply_holder.reset(); });
 }
 
+// Requests compression of |message| from gRPC when the message is large
+// enough to be worth the CPU cost. Small messages (confirmations, short
+// invocations) are sent uncompressed. gRPC negotiates the algorithm with the
+// counterpart, falling back to an uncompressed transfer if unsupported.
+void MaybeRequestCompression(const CommunicationMessage &message,
+                             ::grpc::ClientContext *context) {
+  const int64_t threshold =
+      absl::GetFlag(FLAGS_communication_compression_threshold_bytes);
+  if (threshold >= 0 &&
+      message.ByteSizeLong() >= static_cast<size_t>(threshold)) {
+    context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
+  }
+}
+
+// State of one message sent with SendCommunicationAsync, owned by the
+// completion queue event tagged with its address and deallocated by
+// AsyncQueueLoop once the delivery confirmation (or failure) arrives.
+struct AsyncCommunication {
+  ::grpc::ClientContext context;
+  CommunicationConfirmation confirmation;
+  ::grpc::Status grpc_status;
+  std::unique_ptr<::grpc::ClientAsyncResponseReader<CommunicationConfirmation>>
+      reader;
+};
+
 }  // namespace
 
 Status Communicator::ClientImpl::RunInvocation(
@@ -114,13 +159,21 @@ Status Communicator::ClientImpl::RunInvocation(
     }
 
     // Response received, store it.
-    DeserializeFromReply(*wrapped_message, invocation);
+    DeserializeFromReply(std::move(wrapped_message), invocation);
   }
 
   return invocation->status;
 }
 
-Communicator::ClientImpl::~ClientImpl() = default;
+Communicator::ClientImpl::~ClientImpl() {
+  // Stop accepting new confirmations and wait for the ones still in flight to
+  // be drained before the stub and channel are destructed.
+  async_queue_.Shutdown();
+  if (async_queue_thread_) {
+    async_queue_thread_->Join();
+  }
+}
+
 Communicator::ClientImpl::ClientImpl(Communicator *communicator)
     : sequence_number_(0), communicator_(CHECK_NOTNULL(communicator)) {}
 
@@ -140,6 +193,10 @@ Communicator::ClientImpl::Create(const RemoteProxyConfig &config,
   client->grpc_stub_ =
       CommunicatorService::NewStub(client->grpc_channel_);
 
+  auto *const raw_client = client.get();
+  client->async_queue_thread_ =
+      absl::make_unique<Thread>([raw_client] { raw_client->AsyncQueueLoop(); });
+
   if (communicator->is_host()) {
     const RemoteProxyClientConfig &client_config =
         dynamic_cast<const RemoteProxyClientConfig &>(config);
@@ -165,6 +222,7 @@ Status Communicator::ClientImpl::SendCommunication(
   gpr_timespec absolute_deadline = gpr_time_add(
       gpr_now(GPR_CLOCK_REALTIME), gpr_time_from_seconds(5, GPR_TIMESPAN));
   context.set_deadline(absolute_deadline);
+  MaybeRequestCompression(message, &context);
   auto grpc_status = grpc_stub_->Communicate(&context, message, &confirmation);
   if (!grpc_status.ok()) {
     return Status{absl::StatusCode::kInternal,
@@ -179,6 +237,43 @@ Status Communicator::ClientImpl::SendCommunication(
   return Status::OkStatus();
 }
 
+void Communicator::ClientImpl::SendCommunicationAsync(
+    const CommunicationMessage &message) {
+  {
+    const Status message_status = IsMessageValid(message);
+    if (!message_status.ok()) {
+      LOG(ERROR) << "Malformed message not sent, status=" << message_status;
+      return;
+    }
+  }
+  auto *call = new AsyncCommunication;
+  gpr_timespec absolute_deadline = gpr_time_add(
+      gpr_now(GPR_CLOCK_REALTIME), gpr_time_from_seconds(5, GPR_TIMESPAN));
+  call->context.set_deadline(absolute_deadline);
+  MaybeRequestCompression(message, &call->context);
+  call->reader =
+      grpc_stub_->AsyncCommunicate(&call->context, message, &async_queue_);
+  call->reader->Finish(&call->confirmation, &call->grpc_status, call);
+}
+
+void Communicator::ClientImpl::AsyncQueueLoop() {
+  void *tag;
+  bool ok;
+  while (async_queue_.Next(&tag, &ok)) {
+    std::unique_ptr<AsyncCommunication> call(
+        static_cast<AsyncCommunication *>(tag));
+    if (!ok || !call->grpc_status.ok()) {
+      LOG(ERROR) << "Failed to deliver message, status="
+                 << ConvertStatus<absl::Status>(call->grpc_status);
+      continue;
+    }
+    // If host responded with time stamp, process it.
+    if (!communicator_->is_host() && call->confirmation.has_host_time_nanos()) {
+      communicator_->set_host_time_nanos(call->confirmation.host_time_nanos());
+    }
+  }
+}
+
 void Communicator::ClientImpl::SendDisconnect() {
   DisconnectRequest request;
   DisconnectReply reply;
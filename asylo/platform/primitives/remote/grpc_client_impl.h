@@ -34,6 +34,7 @@
 #include "asylo/util/statusor.h"
 #include "asylo/util/thread.h"
 #include "include/grpcpp/channel.h"
+#include "include/grpcpp/completion_queue.h"
 #include "include/grpcpp/security/credentials.h"
 #include "include/grpcpp/support/channel_arguments.h"
 
@@ -57,6 +58,14 @@ class Communicator::ClientImpl {
   // Communicator.
   Status SendCommunication(const CommunicationMessage &message);
 
+  // Sends CommunicationMessage to the counterpart Communicator without
+  // blocking the calling thread until the delivery confirmation arrives.
+  // Multiple calls may be in flight at once; confirmations are drained by a
+  // dedicated thread, and delivery failures are logged. Used for responses,
+  // where the caller has nothing to do with a failure status: the counterpart
+  // detects a lost response by its sequence numbering.
+  void SendCommunicationAsync(const CommunicationMessage &message);
+
   // Sends disconnect request to the Communicator counterpart, triggering it to
   // shut down.
   void SendDisconnect();
@@ -82,6 +91,10 @@ class Communicator::ClientImpl {
   // for request-response match verification.
   uint64_t GenerateSequenceNumber();
 
+  // Drains delivery confirmations of asynchronously sent messages until
+  // async_queue_ is shut down by the destructor.
+  void AsyncQueueLoop();
+
   // gRPC client stub used for writing messages over gRPC.
   std::shared_ptr<::grpc::Channel> grpc_channel_;
   std::unique_ptr<CommunicatorService::Stub> grpc_stub_;
@@ -89,6 +102,11 @@ class Communicator::ClientImpl {
   // SequenceNumber generation.
   std::atomic<uint64_t> sequence_number_;
 
+  // Completion queue for messages sent with SendCommunicationAsync and the
+  // thread that drains their delivery confirmations.
+  ::grpc::CompletionQueue async_queue_;
+  std::unique_ptr<Thread> async_queue_thread_;
+
   // Metrics OpenCensusClient for ProcSystemService. Exports metrics via
   // OpenCensus.
   // Note: Exporters still need to be setup per the OpenCensus documentation. An
@@ -125,9 +125,11 @@ void Communicator::ServiceImpl::StartInvocation(
     CommunicationMessagePtr wrapped_message) {
   auto invocation = absl::make_unique<ServerInvocation>(
       *wrapped_message, [this](const CommunicationMessage &response) {
-        const Status send_status = communicator_->SendCommunication(response);
-        LOG_IF(ERROR, !send_status.ok())
-            << "Failed to send response, status=" << send_status;
+        // Responses are sent without waiting for the delivery confirmation, so
+        // that the worker thread can pick up the next queued message while the
+        // confirmation is still in flight. Delivery failures are logged by the
+        // client.
+        communicator_->SendCommunicationAsync(response);
       });
   // The request message has been deserialized, drop it letting the RPC finish
   // and send confirmation to the caller.
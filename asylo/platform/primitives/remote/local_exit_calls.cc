@@ -76,32 +76,52 @@ class GetTimeExitCallHandler
   Communicator *const communicator_;
 };
 
-class SysFutexWaitExitCallHandler
+// Handler for a selector that can always be processed on the proxy server
+// side by a stateless helper operating on the serialized parameters alone.
+class HelperExitCallHandler
     : public LocalExitCallForwarder::LocalExitCallHandler {
  public:
-  explicit SysFutexWaitExitCallHandler(LocalExitCallForwarder *forwarder)
-      : LocalExitCallForwarder::LocalExitCallHandler(
-            host_call::kSysFutexWaitHandler, forwarder) {}
+  using Helper = Status (*)(MessageReader *input, MessageWriter *output);
+
+  HelperExitCallHandler(uint64_t selector, Helper helper,
+                        LocalExitCallForwarder *forwarder)
+      : LocalExitCallForwarder::LocalExitCallHandler(selector, forwarder),
+        helper_(helper) {}
 
   absl::optional<Status> AttemptExecute(MessageReader *input,
                                         MessageWriter *output) override {
-    // Process futex_wait selector locally.
-    return host_call::SysFutexWaitHelper(input, output);
+    // Process the selector locally.
+    return helper_(input, output);
   }
+
+ private:
+  const Helper helper_;
 };
 
-class SysFutexWakeExitCallHandler
-    : public LocalExitCallForwarder::LocalExitCallHandler {
- public:
-  explicit SysFutexWakeExitCallHandler(LocalExitCallForwarder *forwarder)
-      : LocalExitCallForwarder::LocalExitCallHandler(
-            host_call::kSysFutexWakeHandler, forwarder) {}
+// Declarative locality policy: each entry maps a selector to the helper that
+// services it in the proxy server process, short-circuiting the remote
+// connector. A selector qualifies only if its semantics do not depend on
+// proxy client state: futexes operate on enclave memory shared with the
+// server, sleeps block the calling thread (which lives on the server),
+// and the inet conversions are pure computation.
+//
+// Selectors absent from this table - notably every file and socket selector -
+// must be forwarded: their host file descriptors are owned by the proxy
+// client process, so they cannot be serviced here even when the proxy runs
+// on the same machine.
+struct LocalSelectorPolicy {
+  uint64_t selector;
+  HelperExitCallHandler::Helper helper;
+};
 
-  absl::optional<Status> AttemptExecute(MessageReader *input,
-                                        MessageWriter *output) override {
-    // Process futex_wake selector locally.
-    return host_call::SysFutexWakeHelper(input, output);
-  }
+constexpr LocalSelectorPolicy kLocalSelectorPolicies[] = {
+    {host_call::kSysFutexWaitHandler, &host_call::SysFutexWaitHelper},
+    {host_call::kSysFutexWakeHandler, &host_call::SysFutexWakeHelper},
+    {host_call::kSysFutexRequeueHandler, &host_call::SysFutexRequeueHelper},
+    {host_call::kUSleepHandler, &host_call::USleepHelper},
+    {host_call::kSleepHandler, &host_call::SleepHelper},
+    {host_call::kInetPtonHandler, &host_call::InetPtonHelper},
+    {host_call::kInetNtopHandler, &host_call::InetNtopHelper},
 };
 
 }  // namespace
@@ -144,13 +164,11 @@ LocalExitCallForwarder::Create(bool exit_logging,
   exit_call_forwarder->handlers_.emplace_back(
       absl::make_unique<GetTimeExitCallHandler>(server->communicator(),
                                                 exit_call_forwarder.get()));
-  exit_call_forwarder->handlers_.emplace_back(
-      absl::make_unique<SysFutexWaitExitCallHandler>(
-          exit_call_forwarder.get()));
-
-  exit_call_forwarder->handlers_.emplace_back(
-      absl::make_unique<SysFutexWakeExitCallHandler>(
-          exit_call_forwarder.get()));
+  for (const LocalSelectorPolicy &policy : kLocalSelectorPolicies) {
+    exit_call_forwarder->handlers_.emplace_back(
+        absl::make_unique<HelperExitCallHandler>(policy.selector, policy.helper,
+                                                 exit_call_forwarder.get()));
+  }
 
   // Register all exit call handlers.
   for (const auto &handler : exit_call_forwarder->handlers_) {
@@ -18,6 +18,10 @@
 
 #include "asylo/platform/primitives/remote/metrics/clients/proc_system_service_client.h"
 
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "asylo/util/logging.h"
 #include "asylo/platform/primitives/remote/metrics/proc_system.grpc.pb.h"
@@ -47,6 +51,43 @@ ProcSystemServiceClient::ProcSystemServiceClient(
   return response;
 }
 
+std::unique_ptr<ProcSystemServiceClient::ProcStatStream>
+ProcSystemServiceClient::WatchProcStat(
+    const ProcStatStreamRequest &request) const {
+  auto context = absl::make_unique<::grpc::ClientContext>();
+  std::unique_ptr<::grpc::ClientReaderInterface<ProcStatResponse>> reader(
+      stub_->WatchProcStat(context.get(), request));
+  return absl::WrapUnique(
+      new ProcStatStream(std::move(context), std::move(reader)));
+}
+
+ProcSystemServiceClient::ProcStatStream::ProcStatStream(
+    std::unique_ptr<::grpc::ClientContext> context,
+    std::unique_ptr<::grpc::ClientReaderInterface<ProcStatResponse>> reader)
+    : context_(std::move(context)), reader_(std::move(reader)) {}
+
+bool ProcSystemServiceClient::ProcStatStream::Next(
+    ProcStatResponse *response) {
+  ProcStatResponse pushed;
+  if (!reader_->Read(&pushed)) {
+    return false;
+  }
+  // With delta encoding the server only sets the fields that changed;
+  // merging them over the previous snapshot restores the full response.
+  // Full responses overwrite every field, so the merge is a no-op for them.
+  snapshot_.MergeFrom(pushed);
+  *response = snapshot_;
+  return true;
+}
+
+void ProcSystemServiceClient::ProcStatStream::Cancel() {
+  context_->TryCancel();
+}
+
+::asylo::Status ProcSystemServiceClient::ProcStatStream::Finish() {
+  return ConvertStatus<absl::Status>(reader_->Finish());
+}
+
 ProcSystemServiceClient::ProcSystemServiceClient(
     const std::shared_ptr<::grpc::Channel> &channel)
     : stub_(std::make_shared<ProcSystemService::Stub>(channel)) {}
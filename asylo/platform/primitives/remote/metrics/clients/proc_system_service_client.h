@@ -19,18 +19,55 @@
 #ifndef ASYLO_PLATFORM_PRIMITIVES_REMOTE_METRICS_CLIENTS_PROC_SYSTEM_SERVICE_CLIENT_H_
 #define ASYLO_PLATFORM_PRIMITIVES_REMOTE_METRICS_CLIENTS_PROC_SYSTEM_SERVICE_CLIENT_H_
 
+#include <memory>
+
 #include "asylo/platform/primitives/remote/metrics/proc_system.grpc.pb.h"
 #include "asylo/platform/primitives/remote/metrics/proc_system.pb.h"
+#include "asylo/util/status.h"
 #include "asylo/util/statusor.h"
 #include "include/grpc/support/time.h"
 #include "include/grpcpp/support/status.h"
 #include "include/grpcpp/channel.h"
+#include "include/grpcpp/client_context.h"
 
 namespace asylo {
 namespace primitives {
 
 class ProcSystemServiceClient {
  public:
+  // Server-push alternative to polling GetProcStat: one long-lived stream
+  // delivering samples at the cadence set in the ProcStatStreamRequest.
+  // Responses pushed with delta encoding are merged into the previous
+  // snapshot, so Next() always produces a full ProcStatResponse.
+  class ProcStatStream {
+   public:
+    ProcStatStream(const ProcStatStream &other) = delete;
+    ProcStatStream &operator=(const ProcStatStream &other) = delete;
+
+    // Blocks for the next sample; returns false once the stream ends, after
+    // which Finish() reports the final status.
+    bool Next(ProcStatResponse *response);
+
+    // Asks the server to stop pushing samples; the stream then ends.
+    void Cancel();
+
+    // Must be called after Next() returns false; returns the stream status.
+    ::asylo::Status Finish();
+
+   private:
+    friend class ProcSystemServiceClient;
+
+    ProcStatStream(
+        std::unique_ptr<::grpc::ClientContext> context,
+        std::unique_ptr<::grpc::ClientReaderInterface<ProcStatResponse>>
+            reader);
+
+    const std::unique_ptr<::grpc::ClientContext> context_;
+    const std::unique_ptr<::grpc::ClientReaderInterface<ProcStatResponse>>
+        reader_;
+    ProcStatResponse snapshot_;
+  };
+
   // Constructor for when a specific StubInterface is required.
   explicit ProcSystemServiceClient(
       std::shared_ptr<ProcSystemService::StubInterface> stub);
@@ -41,6 +78,9 @@ class ProcSystemServiceClient {
 
   ::asylo::StatusOr<ProcStatResponse> GetProcStat() const;
 
+  std::unique_ptr<ProcStatStream> WatchProcStat(
+      const ProcStatStreamRequest &request) const;
+
  private:
   const std::shared_ptr<ProcSystemService::StubInterface> stub_;
 };
@@ -18,7 +18,10 @@
 
 #include "asylo/platform/primitives/remote/metrics/clients/proc_system_service_client.h"
 
+#include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -34,6 +37,7 @@
 #include "asylo/util/status_helpers.h"
 #include "include/grpc/support/time.h"
 #include "include/grpcpp/support/status.h"
+#include "include/grpcpp/support/sync_stream.h"
 
 namespace asylo {
 namespace primitives {
@@ -45,6 +49,39 @@ using ::testing::Eq;
 using ::testing::Return;
 using ::testing::SetArgPointee;
 
+// Serves a canned sequence of responses in place of a live WatchProcStat
+// stream. Ownership passes to the client, matching WatchProcStatRaw.
+class FakeProcStatReader
+    : public ::grpc::ClientReaderInterface<ProcStatResponse> {
+ public:
+  explicit FakeProcStatReader(std::vector<ProcStatResponse> responses,
+                              ::grpc::Status finish_status = ::grpc::Status::OK)
+      : responses_(std::move(responses)),
+        finish_status_(std::move(finish_status)) {}
+
+  void WaitForInitialMetadata() override {}
+
+  bool NextMessageSize(uint32_t *sz) override {
+    *sz = 0;
+    return true;
+  }
+
+  bool Read(ProcStatResponse *response) override {
+    if (next_ >= responses_.size()) {
+      return false;
+    }
+    *response = responses_[next_++];
+    return true;
+  }
+
+  ::grpc::Status Finish() override { return finish_status_; }
+
+ private:
+  const std::vector<ProcStatResponse> responses_;
+  const ::grpc::Status finish_status_;
+  size_t next_ = 0;
+};
+
 class ProcSystemServiceClientTest : public ::testing::Test {
  public:
   void SetUp() override {
@@ -81,6 +118,51 @@ TEST_F(ProcSystemServiceClientTest, ReturnsProcStat) {
   EXPECT_THAT(proc_stat_response_, EqualsProto(response));
 }
 
+TEST_F(ProcSystemServiceClientTest, WatchProcStatMergesDeltaResponses) {
+  ProcStatResponse full = proc_stat_response_;
+  full.set_sample_time_nanos(100);
+
+  // A delta carries only the fields that changed since |full|.
+  ProcStatResponse delta;
+  delta.set_sample_time_nanos(200);
+  delta.mutable_proc_stat()->set_utime(full.proc_stat().utime() + 7);
+
+  ProcStatResponse merged = full;
+  merged.set_sample_time_nanos(200);
+  merged.mutable_proc_stat()->set_utime(full.proc_stat().utime() + 7);
+
+  auto mock_stub = std::make_shared<MockProcSystemServiceStub>();
+  EXPECT_CALL(*mock_stub, WatchProcStatRaw)
+      .WillOnce(Return(new FakeProcStatReader({full, delta})));
+  ProcSystemServiceClient proc_client(mock_stub);
+
+  ProcStatStreamRequest stream_request;
+  stream_request.set_delta_encoding(true);
+  auto stream = proc_client.WatchProcStat(stream_request);
+
+  ProcStatResponse response;
+  ASSERT_TRUE(stream->Next(&response));
+  EXPECT_THAT(response, EqualsProto(full));
+  ASSERT_TRUE(stream->Next(&response));
+  EXPECT_THAT(response, EqualsProto(merged));
+  EXPECT_FALSE(stream->Next(&response));
+  ASYLO_EXPECT_OK(stream->Finish());
+}
+
+TEST(ProcSystemServiceClientTestNoFixture, WatchProcStatReportsStreamError) {
+  auto mock_stub = std::make_shared<MockProcSystemServiceStub>();
+  EXPECT_CALL(*mock_stub, WatchProcStatRaw)
+      .WillOnce(Return(new FakeProcStatReader(
+          {}, ::grpc::Status(::grpc::StatusCode::UNKNOWN, "BadError"))));
+  ProcSystemServiceClient proc_client(mock_stub);
+
+  auto stream = proc_client.WatchProcStat(ProcStatStreamRequest());
+  ProcStatResponse response;
+  EXPECT_FALSE(stream->Next(&response));
+  EXPECT_THAT(stream->Finish(),
+              Eq(::asylo::Status(absl::StatusCode::kUnknown, "BadError")));
+}
+
 TEST(ProcSystemServiceClientTestNoFixture, HandlesGetProcStatError) {
   auto mock_stub = std::make_shared<MockProcSystemServiceStub>();
   EXPECT_CALL(*mock_stub, GetProcStat)
@@ -18,7 +18,15 @@
 
 #include "asylo/platform/primitives/remote/metrics/proc_system_service.h"
 
+#include <algorithm>
+#include <utility>
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+#include "absl/flags/flag.h"
 #include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
 #include "asylo/platform/primitives/remote/metrics/proc_system.grpc.pb.h"
 #include "asylo/platform/primitives/remote/metrics/proc_system.pb.h"
 #include "asylo/platform/primitives/remote/metrics/proc_system_parser.h"
@@ -27,18 +35,147 @@
 #include "include/grpc/support/time.h"
 #include "include/grpcpp/support/status.h"
 
+ABSL_FLAG(int64_t, proc_system_sample_interval_ms, 0,
+          "Minimal age, in milliseconds, a served /proc snapshot must reach "
+          "before a new one is parsed; requests arriving earlier are served "
+          "the cached snapshot. 0 parses /proc on every request.");
+
 namespace asylo {
 namespace primitives {
 
+namespace {
+
+// Floor for the cadence of a WatchProcStat stream, so that a misconfigured
+// client cannot make the service busy-loop over /proc.
+constexpr int64_t kMinStreamPeriodNanos = 100 * 1000 * 1000;  // 100ms.
+
+// Clears from |current| every singular field whose value matches |previous|,
+// recursing into submessages, so that only changed fields stay on the wire.
+// |sample_time_nanos| always differs between samples and thus always remains
+// set, letting the consumer rebuild full snapshots with MergeFrom().
+void ClearUnchangedFields(const google::protobuf::Message &previous,
+                          google::protobuf::Message *current) {
+  const google::protobuf::Descriptor *descriptor = current->GetDescriptor();
+  const google::protobuf::Reflection *reflection = current->GetReflection();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const google::protobuf::FieldDescriptor *field = descriptor->field(i);
+    if (field->is_repeated() || !reflection->HasField(*current, field) ||
+        !reflection->HasField(previous, field)) {
+      continue;
+    }
+    switch (field->cpp_type()) {
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+        if (reflection->GetInt32(previous, field) ==
+            reflection->GetInt32(*current, field)) {
+          reflection->ClearField(current, field);
+        }
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+        if (reflection->GetInt64(previous, field) ==
+            reflection->GetInt64(*current, field)) {
+          reflection->ClearField(current, field);
+        }
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+        if (reflection->GetUInt32(previous, field) ==
+            reflection->GetUInt32(*current, field)) {
+          reflection->ClearField(current, field);
+        }
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+        if (reflection->GetUInt64(previous, field) ==
+            reflection->GetUInt64(*current, field)) {
+          reflection->ClearField(current, field);
+        }
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+        if (reflection->GetBool(previous, field) ==
+            reflection->GetBool(*current, field)) {
+          reflection->ClearField(current, field);
+        }
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
+        if (reflection->GetString(previous, field) ==
+            reflection->GetString(*current, field)) {
+          reflection->ClearField(current, field);
+        }
+        break;
+      case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE: {
+        ClearUnchangedFields(reflection->GetMessage(previous, field),
+                             reflection->MutableMessage(current, field));
+        if (reflection->GetMessage(*current, field).ByteSizeLong() == 0) {
+          reflection->ClearField(current, field);
+        }
+        break;
+      }
+      default:
+        // Floats and enums do not occur in ProcStatResponse; keep them as is.
+        break;
+    }
+  }
+}
+
+}  // namespace
+
 ::grpc::Status ProcSystemServiceImpl::GetProcStat(
     grpc::ServerContext *context, const ProcStatRequest *request,
     ProcStatResponse *response) {
+  return SampleProcStat(response);
+}
+
+::grpc::Status ProcSystemServiceImpl::WatchProcStat(
+    grpc::ServerContext *context, const ProcStatStreamRequest *request,
+    ::grpc::ServerWriter<ProcStatResponse> *writer) {
+  const int64_t period_nanos =
+      std::max(request->period_nanos(), kMinStreamPeriodNanos);
+  const bool delta_encoding = request->delta_encoding();
+  ProcStatResponse previous;
+  bool have_previous = false;
+  while (!context->IsCancelled()) {
+    ProcStatResponse response;
+    const ::grpc::Status status = SampleProcStat(&response);
+    if (!status.ok()) {
+      return status;
+    }
+    ProcStatResponse pushed = response;
+    if (delta_encoding && have_previous) {
+      ClearUnchangedFields(previous, &pushed);
+    }
+    if (!writer->Write(pushed)) {
+      break;  // Client went away.
+    }
+    previous = std::move(response);
+    have_previous = true;
+    absl::SleepFor(absl::Nanoseconds(period_nanos));
+  }
+  return ::grpc::Status::OK;
+}
+
+::grpc::Status ProcSystemServiceImpl::SampleProcStat(
+    ProcStatResponse *response) {
+  const int64_t interval_nanos =
+      absl::GetFlag(FLAGS_proc_system_sample_interval_ms) * 1000000;
+  const int64_t now_nanos = absl::GetCurrentTimeNanos();
+  if (interval_nanos > 0) {
+    absl::MutexLock lock(&cache_mu_);
+    if (cached_proc_stat_time_nanos_ != 0 &&
+        now_nanos - cached_proc_stat_time_nanos_ < interval_nanos) {
+      *response = cached_proc_stat_;
+      return ::grpc::Status::OK;
+    }
+  }
+
   auto status = BuildProcStatResponse(response);
   if (!status.ok()) {
     LOG(ERROR) << status;
     return ::grpc::Status(static_cast<::grpc::StatusCode>(status.error_code()),
                           std::string(status.error_message()));
   }
+  response->set_sample_time_nanos(now_nanos);
+
+  absl::MutexLock lock(&cache_mu_);
+  cached_proc_stat_ = *response;
+  cached_proc_stat_time_nanos_ = now_nanos;
   return ::grpc::Status::OK;
 }
 
@@ -19,6 +19,9 @@
 #ifndef ASYLO_PLATFORM_PRIMITIVES_REMOTE_METRICS_PROC_SYSTEM_SERVICE_H_
 #define ASYLO_PLATFORM_PRIMITIVES_REMOTE_METRICS_PROC_SYSTEM_SERVICE_H_
 
+#include <cstdint>
+
+#include "absl/synchronization/mutex.h"
 #include "asylo/platform/primitives/remote/metrics/proc_system.grpc.pb.h"
 #include "asylo/platform/primitives/remote/metrics/proc_system.pb.h"
 #include "asylo/platform/primitives/remote/metrics/proc_system_parser.h"
@@ -40,6 +43,15 @@ class ProcSystemServiceImpl : public ProcSystemService::Service {
                              const ProcStatRequest *request,
                              ProcStatResponse *response) override;
 
+  // Pushes ProcStat samples on a long-lived stream at the cadence requested
+  // by the client (clamped to the service minimum), until the client cancels
+  // or sampling fails. With delta encoding requested, every response after
+  // the first carries only the fields that changed since the previous one.
+  ::grpc::Status WatchProcStat(::grpc::ServerContext *context,
+                               const ProcStatStreamRequest *request,
+                               ::grpc::ServerWriter<ProcStatResponse> *writer)
+      override;
+
  protected:
   ProcSystemServiceImpl(std::unique_ptr<ProcSystemParser> proc_system_parser,
                         pid_t pid)
@@ -50,8 +62,19 @@ class ProcSystemServiceImpl : public ProcSystemService::Service {
 
   ::asylo::Status BuildProcStatResponse(ProcStatResponse *response) const;
 
+  // Produces one ProcStat sample, honoring the snapshot cache. Shared by
+  // GetProcStat and WatchProcStat.
+  ::grpc::Status SampleProcStat(ProcStatResponse *response);
+
   std::unique_ptr<ProcSystemParser> proc_system_parser_;
   const pid_t pid_;
+
+  // Snapshot served to requests arriving before it reaches the sampling
+  // interval (--proc_system_sample_interval_ms), so that frequent scraping
+  // does not pay for a /proc parse on every RPC.
+  absl::Mutex cache_mu_;
+  ProcStatResponse cached_proc_stat_ ABSL_GUARDED_BY(cache_mu_);
+  int64_t cached_proc_stat_time_nanos_ ABSL_GUARDED_BY(cache_mu_) = 0;
 };
 
 }  // namespace primitives
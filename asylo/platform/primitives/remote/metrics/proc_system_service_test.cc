@@ -18,16 +18,21 @@
 
 #include "asylo/platform/primitives/remote/metrics/proc_system_service.h"
 
+#include <cstdint>
 #include <memory>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
 #include "absl/memory/memory.h"
 #include "asylo/platform/primitives/remote/metrics/mocks/mock_proc_system_parser.h"
 #include "asylo/platform/primitives/remote/metrics/mocks/mock_proc_system_service.h"
 #include "asylo/test/util/status_matchers.h"
 #include "asylo/util/status_helpers.h"
 
+ABSL_DECLARE_FLAG(int64_t, proc_system_sample_interval_ms);
+
 namespace asylo {
 namespace primitives {
 namespace {
@@ -188,6 +193,33 @@ TEST_F(ProcSystemServiceTest, ResponseIsSuccessfulParse) {
               Eq(comparison_parser->kExpectedExitCode));
 }
 
+TEST_F(ProcSystemServiceTest, ServesCachedSnapshotWithinSampleInterval) {
+  auto mock_parser = absl::make_unique<MockProcSystemParser>();
+  // The parser must be consulted only once: the second request arrives well
+  // within the sampling interval and is served the cached snapshot.
+  EXPECT_CALL(*mock_parser, ReadProcStat(_))
+      .WillOnce(Return(mock_parser->stat_contents()));
+
+  const auto comparison_parser = mock_parser.get();
+  MockProcSystemService mock_service(std::move(mock_parser),
+                                     comparison_parser->kExpectedPid);
+
+  absl::SetFlag(&FLAGS_proc_system_sample_interval_ms, 60000);
+  ASYLO_ASSERT_OK(ConvertStatus<asylo::Status>(mock_service.GetProcStat(
+      &context_, &proc_stat_request_, &proc_stat_response_)));
+  EXPECT_THAT(proc_stat_response_.sample_time_nanos(), Gt(0));
+
+  ProcStatResponse second_response;
+  ASYLO_ASSERT_OK(ConvertStatus<asylo::Status>(mock_service.GetProcStat(
+      &context_, &proc_stat_request_, &second_response)));
+  absl::SetFlag(&FLAGS_proc_system_sample_interval_ms, 0);
+
+  EXPECT_THAT(second_response.sample_time_nanos(),
+              Eq(proc_stat_response_.sample_time_nanos()));
+  EXPECT_THAT(second_response.proc_stat().pid(),
+              Eq(comparison_parser->kExpectedPid));
+}
+
 }  // namespace
 }  // namespace primitives
 }  // namespace asylo
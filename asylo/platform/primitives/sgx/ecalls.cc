@@ -103,6 +103,59 @@ int ecall_transfer_secure_snapshot_key(const char *input, uint64_t input_len,
   return result;
 }
 
+// Invokes the warm-start snapshot preparation entry-point. Returns a non-zero
+// error code on failure.
+int ecall_prepare_warm_start_snapshot(char **output, uint64_t *output_len) {
+  int result = 0;
+  size_t tmp_output_len;
+  try {
+    result = asylo::PrepareWarmStartSnapshot(output, &tmp_output_len);
+  } catch (...) {
+    LOG(FATAL) << "Uncaught exception in enclave";
+  }
+
+  if (output_len) {
+    *output_len = static_cast<uint64_t>(tmp_output_len);
+  }
+  return result;
+}
+
+// Invokes the enclave snapshot key sealing entry-point. Returns a non-zero
+// error code on failure.
+int ecall_seal_snapshot_key(char **output, uint64_t *output_len) {
+  int result = 0;
+  size_t tmp_output_len;
+  try {
+    result = asylo::SealSnapshotKey(output, &tmp_output_len);
+  } catch (...) {
+    LOG(FATAL) << "Uncaught exception in enclave";
+  }
+
+  if (output_len) {
+    *output_len = static_cast<uint64_t>(tmp_output_len);
+  }
+  return result;
+}
+
+// Invokes the enclave snapshot key restoring entry-point. Returns a non-zero
+// error code on failure.
+int ecall_restore_snapshot_key(const char *input, uint64_t input_len,
+                               char **output, uint64_t *output_len) {
+  int result = 0;
+  size_t tmp_output_len;
+  try {
+    result = asylo::RestoreSnapshotKey(input, static_cast<size_t>(input_len),
+                                       output, &tmp_output_len);
+  } catch (...) {
+    LOG(FATAL) << "Uncaught exception in enclave";
+  }
+
+  if (output_len) {
+    *output_len = static_cast<uint64_t>(tmp_output_len);
+  }
+  return result;
+}
+
 // Invokes the trusted entry point designated by |selector|. Returns a
 // non-zero error code on failure.
 int ecall_dispatch_trusted_call(uint64_t selector, void *buffer) {
@@ -20,6 +20,7 @@
 
 #include "absl/status/status.h"
 #include "asylo/enclave.pb.h"
+#include "asylo/platform/primitives/sgx/launch_token_cache.h"
 #include "asylo/platform/primitives/sgx/loader.pb.h"
 #include "asylo/platform/primitives/sgx/untrusted_sgx.h"
 #include "asylo/platform/primitives/untrusted_primitives.h"
@@ -63,15 +64,29 @@ StatusOr<std::shared_ptr<Client>> LoadEnclave(
             enclave_name, base_address, section_name, enclave_size,
             enclave_config, debug, std::move(exit_call_provider)));
   } else if (is_file_enclave) {
-    std::string enclave_path = sgx_config.file_enclave_config().enclave_path();
+    const auto &file_config = sgx_config.file_enclave_config();
+    LaunchTokenCache *launch_token_cache = nullptr;
+    if (file_config.has_launch_token_cache_directory()) {
+      launch_token_cache = LaunchTokenCache::ForDirectory(
+          file_config.launch_token_cache_directory());
+    }
     ASYLO_ASSIGN_OR_RETURN(
         primitive_client,
-        LoadEnclave<SgxBackend>(enclave_name, base_address, enclave_path,
-                                enclave_size, enclave_config, debug,
-                                std::move(exit_call_provider)));
+        LoadEnclave<SgxBackend>(
+            enclave_name, base_address, file_config.enclave_path(),
+            enclave_size, enclave_config, debug, std::move(exit_call_provider),
+            file_config.map_enclave_binary(), launch_token_cache));
   } else {
     return absl::InvalidArgumentError("SGX enclave source not set");
   }
+
+  if (sgx_config.has_sim_performance_parity_config()) {
+    const auto &parity_config = sgx_config.sim_performance_parity_config();
+    static_cast<SgxEnclaveClient *>(primitive_client.get())
+        ->SetSimulatedTransitionCosts(parity_config.enclave_entry_cycles(),
+                                      parity_config.exit_call_cycles(),
+                                      parity_config.payload_cycles_per_page());
+  }
   return std::move(primitive_client);
 }
 
@@ -0,0 +1,61 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_SGX_EXCEPTION_HANDLER_REGISTRY_H_
+#define ASYLO_PLATFORM_PRIMITIVES_SGX_EXCEPTION_HANDLER_REGISTRY_H_
+
+#include "include/sgx_trts_exception.h"
+
+namespace asylo {
+namespace primitives {
+
+// A registry of trusted first-chance handlers for in-enclave hardware
+// exceptions, keyed by exception vector. Handlers registered here run inside
+// the enclave before the exception escalates to the untrusted runtime, so an
+// exception class the trusted runtime can fully resolve (an emulated
+// instruction, an expected page-touch probe) costs no exit at all. Only
+// exceptions every registered handler declines continue down the SGX SDK
+// handler chain toward the untrusted side.
+//
+// The registry dispatches from exception context: handlers must not acquire
+// locks, allocate, or exit the enclave, and must return promptly.
+
+// A trusted first-chance exception handler. Receives the faulting CPU context
+// and returns EXCEPTION_CONTINUE_EXECUTION after fully resolving the
+// exception (typically after fixing up registers and advancing the
+// instruction pointer), or EXCEPTION_CONTINUE_SEARCH to pass it to the next
+// handler.
+typedef int (*TrustedExceptionHandler)(sgx_exception_info_t *info);
+
+// Registers |handler| as a first-chance handler for hardware exceptions with
+// vector |vector| (an SGX_EXCEPTION_VECTOR_* value). Handlers for one vector
+// run in registration order. Returns false when |vector| is out of range,
+// |handler| is null, or the vector's handler table is full.
+bool RegisterTrustedExceptionHandler(int vector,
+                                     TrustedExceptionHandler handler);
+
+// Removes a previously registered |handler| for |vector|. Returns false when
+// no such registration exists. Handlers already dispatching finish their
+// current exception.
+bool UnregisterTrustedExceptionHandler(int vector,
+                                       TrustedExceptionHandler handler);
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_SGX_EXCEPTION_HANDLER_REGISTRY_H_
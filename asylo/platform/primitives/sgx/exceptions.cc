@@ -19,11 +19,46 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <atomic>
+
+#include "asylo/platform/primitives/sgx/exception_handler_registry.h"
 #include "include/sgx_cpuid.h"
 #include "include/sgx_trts_exception.h"
 
 namespace {
 
+// Highest exception vector the trusted handler registry covers and the number
+// of first-chance handler slots per vector. Registration is rare and dispatch
+// runs in exception context, so the table is a fixed array of atomics: lookups
+// are plain acquire loads with no locks or allocation.
+constexpr int kMaxTrustedExceptionVector = 31;
+constexpr int kTrustedHandlersPerVector = 4;
+
+std::atomic<asylo::primitives::TrustedExceptionHandler>
+    trusted_exception_handlers[kMaxTrustedExceptionVector +
+                               1][kTrustedHandlersPerVector] = {};
+
+// Called by the SGX SDK for every in-enclave hardware exception. Offers the
+// exception to each trusted first-chance handler registered for its vector;
+// the first handler to resolve it keeps the exception entirely inside the
+// enclave. Exceptions no handler resolves continue down the SDK handler chain
+// and may escalate to the untrusted runtime.
+int dispatch_trusted_exception_handlers(sgx_exception_info_t *info) {
+  int vector = static_cast<int>(info->exception_vector);
+  if (vector < 0 || vector > kMaxTrustedExceptionVector) {
+    return EXCEPTION_CONTINUE_SEARCH;
+  }
+  for (int slot = 0; slot < kTrustedHandlersPerVector; ++slot) {
+    asylo::primitives::TrustedExceptionHandler handler =
+        trusted_exception_handlers[vector][slot].load(
+            std::memory_order_acquire);
+    if (handler && handler(info) == EXCEPTION_CONTINUE_EXECUTION) {
+      return EXCEPTION_CONTINUE_EXECUTION;
+    }
+  }
+  return EXCEPTION_CONTINUE_SEARCH;
+}
+
 // Handled opcodes
 constexpr uint16_t kCpuidOpcode = 0xA20F;
 constexpr uint16_t kRdtscOpcode = 0x310F;
@@ -160,14 +195,58 @@ int handle_rdtsc_exception(sgx_exception_info_t *info) {
   return EXCEPTION_CONTINUE_EXECUTION;
 }
 
-// Register an exception handler with the SGX SDK.
+// Register the trusted handler dispatcher with the SGX SDK and install the
+// built-in instruction emulation handlers through the registry.
 // Other constructors already issue these instructions, so use the highest
 // priority to make this one run first.
 void register_exception_handlers() __attribute__((constructor(101)));
 void register_exception_handlers() {
   initialize_cpuid_results();
-  sgx_register_exception_handler(true, handle_cpuid_exception);
-  sgx_register_exception_handler(true, handle_rdtsc_exception);
+  sgx_register_exception_handler(true, dispatch_trusted_exception_handlers);
+  if (!asylo::primitives::RegisterTrustedExceptionHandler(
+          SGX_EXCEPTION_VECTOR_UD, handle_cpuid_exception) ||
+      !asylo::primitives::RegisterTrustedExceptionHandler(
+          SGX_EXCEPTION_VECTOR_UD, handle_rdtsc_exception)) {
+    abort();
+  }
 }
 
 }  // namespace
+
+namespace asylo {
+namespace primitives {
+
+bool RegisterTrustedExceptionHandler(int vector,
+                                     TrustedExceptionHandler handler) {
+  if (vector < 0 || vector > kMaxTrustedExceptionVector || !handler) {
+    return false;
+  }
+  for (int slot = 0; slot < kTrustedHandlersPerVector; ++slot) {
+    TrustedExceptionHandler expected = nullptr;
+    if (trusted_exception_handlers[vector][slot].compare_exchange_strong(
+            expected, handler, std::memory_order_release,
+            std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool UnregisterTrustedExceptionHandler(int vector,
+                                       TrustedExceptionHandler handler) {
+  if (vector < 0 || vector > kMaxTrustedExceptionVector || !handler) {
+    return false;
+  }
+  for (int slot = 0; slot < kTrustedHandlersPerVector; ++slot) {
+    TrustedExceptionHandler expected = handler;
+    if (trusted_exception_handlers[vector][slot].compare_exchange_strong(
+            expected, nullptr, std::memory_order_release,
+            std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace primitives
+}  // namespace asylo
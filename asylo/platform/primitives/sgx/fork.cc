@@ -20,6 +20,7 @@
 #include "absl/status/status.h"
 #include "asylo/enclave.pb.h"
 #include "asylo/platform/core/trusted_global_state.h"
+#include "asylo/platform/host_call/trusted/host_calls.h"
 #include "asylo/platform/posix/threading/thread_manager.h"
 #include "asylo/platform/primitives/sgx/fork.pb.h"
 #include "asylo/platform/primitives/sgx/fork_internal.h"
@@ -107,7 +108,18 @@ int Restore(const char *snapshot_layout, size_t snapshot_layout_len,
   status = RestoreForFork(snapshot_layout, snapshot_layout_len);
   int ret = status_serializer.Serialize(status);
 
-  if (!status.ok()) {
+  if (status.ok()) {
+    // The restored enclave runs in a new process: drop cached idempotent host
+    // call results (such as the process ID) inherited from the snapshot.
+    enc_invalidate_idempotent_call_cache();
+
+    // Invalidate the pre-generated random bytes inherited from the snapshot
+    // so the child cannot emit the same random stream as the parent. This
+    // runs on a different TCS than the restored thread, so the restored
+    // thread's own pool can only be discarded by generation, not flushed
+    // from here.
+    enc_invalidate_rand_pools();
+  } else {
     // Delete instance of the global memory pool singleton freeing all memory
     // held by the pool.
     delete UntrustedCacheMalloc::Instance();
@@ -127,6 +139,102 @@ int Restore(const char *snapshot_layout, size_t snapshot_layout_len,
   return ret;
 }
 
+int PrepareWarmStartSnapshot(char **output, size_t *output_len) {
+  Status status = VerifyOutputArguments(output, output_len);
+  if (!status.ok()) {
+    return 1;
+  }
+
+  StatusSerializer<StatusProto> status_serializer(
+      output, output_len, &primitives::TrustedPrimitives::UntrustedLocalAlloc);
+
+  asylo::StatusOr<const asylo::EnclaveConfig *> config_result =
+      asylo::GetEnclaveConfig();
+
+  if (!config_result.ok()) {
+    return status_serializer.Serialize(config_result.status());
+  }
+
+  const asylo::EnclaveConfig *config = config_result.ValueOrDie();
+  if (!config->has_enable_fork() || !config->enable_fork()) {
+    status = absl::FailedPreconditionError("Insecure fork not enabled");
+    return status_serializer.Serialize(status);
+  }
+
+  // Save the calling thread's layout and permit a snapshot, as enc_fork()
+  // does for fork(). The saved thread state is never resumed on a warm-start
+  // restore; it only completes the snapshot so that the existing snapshot and
+  // restore entry-points can be reused unchanged.
+  SaveThreadLayoutForSnapshot();
+  SetForkRequested();
+  return status_serializer.Serialize(Status::OkStatus());
+}
+
+int SealSnapshotKey(char **output, size_t *output_len) {
+  Status status = VerifyOutputArguments(output, output_len);
+  if (!status.ok()) {
+    return 1;
+  }
+  EnclaveOutput enclave_output;
+  // Sealing the snapshot key should not change any enclave states. Call
+  // UntrustedLocalAlloc directly to create the StatusSerializer.
+  StatusSerializer<EnclaveOutput> status_serializer(
+      &enclave_output, enclave_output.mutable_status(), output, output_len,
+      &primitives::TrustedPrimitives::UntrustedLocalAlloc);
+
+  asylo::StatusOr<const asylo::EnclaveConfig *> config_result =
+      asylo::GetEnclaveConfig();
+
+  if (!config_result.ok()) {
+    return status_serializer.Serialize(config_result.status());
+  }
+
+  const asylo::EnclaveConfig *config = config_result.ValueOrDie();
+  if (!config->has_enable_fork() || !config->enable_fork()) {
+    status = absl::FailedPreconditionError("Insecure fork not enabled");
+    return status_serializer.Serialize(status);
+  }
+
+  std::string serialized_sealed_secret;
+  status = SealSnapshotKeyForWarmStart(&serialized_sealed_secret);
+  enclave_output.MutableExtension(sealed_snapshot_key)
+      ->set_sealed_secret(serialized_sealed_secret);
+  return status_serializer.Serialize(status);
+}
+
+int RestoreSnapshotKey(const char *input, size_t input_len, char **output,
+                       size_t *output_len) {
+  Status status = VerifyOutputArguments(output, output_len);
+  if (!status.ok()) {
+    return 1;
+  }
+
+  StatusSerializer<StatusProto> status_serializer(
+      output, output_len, &primitives::TrustedPrimitives::UntrustedLocalAlloc);
+
+  asylo::StatusOr<const asylo::EnclaveConfig *> config_result =
+      asylo::GetEnclaveConfig();
+
+  if (!config_result.ok()) {
+    return status_serializer.Serialize(config_result.status());
+  }
+
+  const asylo::EnclaveConfig *config = config_result.ValueOrDie();
+  if (!config->has_enable_fork() || !config->enable_fork()) {
+    status = absl::FailedPreconditionError("Insecure fork not enabled");
+    return status_serializer.Serialize(status);
+  }
+
+  asylo::SealedSnapshotKey sealed_key;
+  if (!sealed_key.ParseFromArray(input, input_len)) {
+    status = absl::InvalidArgumentError("Failed to parse SealedSnapshotKey");
+    return status_serializer.Serialize(status);
+  }
+
+  status = RestoreSnapshotKeyForWarmStart(sealed_key.sealed_secret());
+  return status_serializer.Serialize(status);
+}
+
 int TransferSecureSnapshotKey(const char *input, size_t input_len,
                               char **output, size_t *output_len) {
   Status status = VerifyOutputArguments(output, output_len);
@@ -31,6 +31,13 @@ int Restore(const char *snapshot_layout, size_t snapshot_layout_len,
 int TransferSecureSnapshotKey(const char *input, size_t input_len,
                               char **output, size_t *output_len);
 
+int PrepareWarmStartSnapshot(char **output, size_t *output_len);
+
+int SealSnapshotKey(char **output, size_t *output_len);
+
+int RestoreSnapshotKey(const char *input, size_t input_len, char **output,
+                       size_t *output_len);
+
 }  // namespace asylo
 
 #endif  // ASYLO_PLATFORM_PRIMITIVES_SGX_FORK_H_
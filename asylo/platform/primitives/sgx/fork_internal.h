@@ -21,6 +21,8 @@
 
 #include <sys/types.h>
 
+#include <string>
+
 #include "asylo/enclave.pb.h"
 #include "asylo/platform/primitives/sgx/fork.pb.h"
 #include "asylo/util/status.h"
@@ -46,6 +48,21 @@ Status RestoreForFork(const char *input, size_t input_len);
 Status TransferSecureSnapshotKey(
     const ForkHandshakeConfig &fork_handshake_config);
 
+// Seals the snapshot key of the most recent snapshot to the code identity
+// (MRENCLAVE) of the calling enclave, and writes the serialized
+// asylo.SealedSecret to |serialized_sealed_secret|. The sealed key can only be
+// unsealed by the same enclave binary on the same machine, so a snapshot
+// stored with it can be restored by a later process without a live parent
+// enclave to transfer the key. Returns an error Status if no snapshot key is
+// present, i.e. no snapshot has been taken.
+Status SealSnapshotKeyForWarmStart(std::string *serialized_sealed_secret);
+
+// Unseals the snapshot key from |serialized_sealed_secret| (a serialized
+// asylo.SealedSecret produced by SealSnapshotKeyForWarmStart()) and installs
+// it as the snapshot key for a subsequent restore.
+Status RestoreSnapshotKeyForWarmStart(
+    const std::string &serialized_sealed_secret);
+
 // Saves the thread memory layout, including the base address and size of the
 // stack/thread info of the calling TCS. Returns error Status if not in SGX
 // hardware mode.
@@ -16,11 +16,15 @@
  *
  */
 
+#include <openssl/err.h>
 #include <openssl/rand.h>
+#include <pthread.h>
 #include <sys/socket.h>
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,6 +42,8 @@
 #include "asylo/identity/identity_acl_evaluator.h"
 #include "asylo/identity/platform/sgx/sgx_identity_expectation_matcher.h"
 #include "asylo/identity/platform/sgx/sgx_identity_util.h"
+#include "asylo/identity/sealing/sealed_secret.pb.h"
+#include "asylo/identity/sealing/sgx/sgx_local_secret_sealer.h"
 #include "asylo/platform/host_call/trusted/host_calls.h"
 #include "asylo/platform/posix/memory/memory.h"
 #include "asylo/platform/primitives/sgx/fork_internal.h"
@@ -207,6 +213,129 @@ Status EncryptToUntrustedMemory(AeadCryptor *cryptor, const void *source_base,
   return Status::OkStatus();
 }
 
+// Associated-data suffix that distinguishes sealed all-zero chunk markers
+// from encrypted chunk contents, so that neither can be reinterpreted as the
+// other by the untrusted side.
+constexpr char kZeroChunkAssociatedDataSuffix[] = "all-zero chunk";
+
+// Returns true if the |size| bytes starting at |base| are all zero.
+bool IsAllZero(const uint8_t *base, size_t size) {
+  size_t i = 0;
+  // Scan byte-by-byte until the address is word-aligned, then word-by-word,
+  // since the regions being scanned are large.
+  for (; i < size &&
+         reinterpret_cast<uintptr_t>(base + i) % sizeof(uint64_t) != 0;
+       ++i) {
+    if (base[i] != 0) {
+      return false;
+    }
+  }
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    if (*reinterpret_cast<const uint64_t *>(base + i) != 0) {
+      return false;
+    }
+  }
+  for (; i < size; ++i) {
+    if (base[i] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Records the enclave memory chunk at |source_base| with |source_size|, which
+// contains only zero bytes, as an all-zero entry in |snapshot_entry|. Instead
+// of encrypting the chunk contents, a short marker holding the chunk size is
+// sealed and bound to the chunk address, so that the claim that the chunk is
+// zero carries the same authenticity as an encrypted chunk. This avoids
+// encrypting and copying out memory that was never written, which typically
+// dominates the heap during periodic checkpointing.
+Status EncryptZeroChunkMarker(AeadCryptor *cryptor, const void *source_base,
+                              const size_t source_size,
+                              SnapshotLayoutEntry *snapshot_entry) {
+  uint64_t marker = static_cast<uint64_t>(source_size);
+  ByteContainerView plaintext(&marker, sizeof(marker));
+  int maximum_ciphertext_size = sizeof(marker) + cryptor->MaxSealOverhead();
+  void *destination_base = primitives::TrustedPrimitives::UntrustedLocalAlloc(
+      maximum_ciphertext_size);
+  size_t destination_size;
+  if (!destination_base) {
+    return Status(absl::StatusCode::kInternal,
+                  "Failed to allocate untrusted memory for snapshot");
+  }
+  size_t nonce_size = cryptor->NonceSize();
+  void *nonce_base =
+      primitives::TrustedPrimitives::UntrustedLocalAlloc(nonce_size);
+  if (!nonce_base) {
+    return Status(absl::StatusCode::kInternal,
+                  "Failed to allocate untrusted memory for snapshot nonce");
+  }
+
+  std::string associated_data =
+      ConvertTrivialObjectToBinaryString(source_base);
+  associated_data.append(kZeroChunkAssociatedDataSuffix);
+  ASYLO_RETURN_IF_ERROR(cryptor->Seal(
+      plaintext, associated_data,
+      absl::MakeSpan(reinterpret_cast<uint8_t *>(nonce_base), nonce_size),
+      absl::MakeSpan(reinterpret_cast<uint8_t *>(destination_base),
+                     maximum_ciphertext_size),
+      &destination_size));
+
+  snapshot_entry->set_ciphertext_base(
+      reinterpret_cast<uint64_t>(destination_base));
+  snapshot_entry->set_ciphertext_size(static_cast<uint64_t>(destination_size));
+  snapshot_entry->set_nonce_base(reinterpret_cast<uint64_t>(nonce_base));
+  snapshot_entry->set_nonce_size(static_cast<uint64_t>(nonce_size));
+  snapshot_entry->set_all_zero(true);
+  return Status::OkStatus();
+}
+
+// Verifies the all-zero entry |snapshot_entry| with |cryptor| and zero-fills
+// the enclave memory at |destination_base| with |destination_size|. The sealed
+// marker must open under the chunk address and hold the expected chunk size.
+Status DecryptZeroChunkMarker(AeadCryptor *cryptor,
+                              SnapshotLayoutEntry snapshot_entry,
+                              void *destination_base,
+                              size_t destination_size) {
+  void *source_base =
+      reinterpret_cast<void *>(snapshot_entry.ciphertext_base());
+  size_t source_size = static_cast<size_t>(snapshot_entry.ciphertext_size());
+  if (!primitives::TrustedPrimitives::IsOutsideEnclave(source_base,
+                                                       source_size)) {
+    return Status(absl::StatusCode::kInternal,
+                  "snapshot is not outside the enclave");
+  }
+  void *nonce_base = reinterpret_cast<void *>(snapshot_entry.nonce_base());
+  size_t nonce_size = static_cast<size_t>(snapshot_entry.nonce_size());
+  if (!primitives::TrustedPrimitives::IsOutsideEnclave(nonce_base,
+                                                       nonce_size)) {
+    return Status(absl::StatusCode::kInternal,
+                  "snapshot nonce is not outside the enclave");
+  }
+  ByteContainerView ciphertext(source_base, source_size);
+  std::vector<uint8_t> nonce(
+      reinterpret_cast<uint8_t *>(nonce_base),
+      reinterpret_cast<uint8_t *>(nonce_base) + nonce_size);
+
+  std::string associated_data =
+      ConvertTrivialObjectToBinaryString(destination_base);
+  associated_data.append(kZeroChunkAssociatedDataSuffix);
+  uint64_t marker;
+  size_t marker_size;
+  ASYLO_RETURN_IF_ERROR(cryptor->Open(
+      ciphertext, associated_data, nonce,
+      absl::MakeSpan(reinterpret_cast<uint8_t *>(&marker), sizeof(marker)),
+      &marker_size));
+  if (marker_size != sizeof(marker) ||
+      marker != static_cast<uint64_t>(destination_size)) {
+    return Status(absl::StatusCode::kInternal,
+                  "The all-zero chunk marker does not match the snapshot");
+  }
+
+  memset(destination_base, 0, destination_size);
+  return Status::OkStatus();
+}
+
 // Decrypts the untrusted source from |snapshot_entry| with |cryptor| to the
 // enclave memory location at |destination_base| with |destination_size|.
 // |snapshot_entry| is a protobuf that is passed from untrusted side, it
@@ -256,26 +385,170 @@ void CopyNonOkStatus(const Status &non_ok_status, absl::StatusCode *error_code,
           std::min(message_buffer_size, non_ok_status.error_message().size()));
 }
 
-// Encrypts a whole memory region of size |source_size| at |source_base| in the
-// enclave with |cryptor|. The memory could be data, bss, heap, thread or data.
-// The encryption may result in multiple snapshot entries if the memory size is
-// greater than the maximum message size supported by |cryptor|. The result is
-// written to |entry|.
-Status EncryptToSnapshot(AeadCryptor *cryptor, void *source_base,
-                         size_t source_size,
-                         google::protobuf::RepeatedPtrField<SnapshotLayoutEntry> *entry) {
-  size_t bytes_left = source_size;
-  uint8_t *current_position = reinterpret_cast<uint8_t *>(source_base);
-
-  while (bytes_left > 0) {
-    size_t plaintext_size = std::min(cryptor->MaxMessageSize(), bytes_left);
-    ASYLO_RETURN_IF_ERROR(EncryptToUntrustedMemory(
-        cryptor, current_position, plaintext_size, entry->Add()));
-
-    bytes_left -= plaintext_size;
-    current_position += plaintext_size;
+// Number of extra enclave threads used to encrypt the snapshot in parallel
+// with the snapshot thread. Each worker needs its own TCS, so this is kept
+// small enough to fit a modest enclave thread budget.
+constexpr int kSnapshotEncryptionWorkers = 3;
+
+// Number of memory regions encrypted into a snapshot: data, bss, thread, heap
+// and stack.
+constexpr int kSnapshotRegionCount = 5;
+
+// Size of the per-worker buffers holding encryption error messages.
+constexpr size_t kWorkerErrorMessageSize = 1024;
+
+// Interval at which the snapshot thread and the workers poll the shared pool
+// state below.
+constexpr uint64_t kWorkerPollNanoseconds = 1000000;
+
+// Time the snapshot thread waits for the workers to enter the enclave, and
+// time it waits for them to finish their share of the encryption.
+constexpr uint64_t kWorkerReadyTimeoutNanoseconds = 1000000000;
+constexpr uint64_t kWorkerDoneTimeoutNanoseconds = UINT64_C(10000000000);
+
+// One contiguous enclave memory region to be encrypted into the snapshot. The
+// region is encrypted in chunks of the cryptor's maximum message size, each
+// chunk producing one snapshot entry.
+struct SnapshotRegion {
+  uint8_t *base;
+  size_t size;
+  // Snapshot entries for this region, pre-sized to |chunk_count| so that the
+  // workers fill independent entries without mutating shared protobuf state.
+  google::protobuf::RepeatedPtrField<SnapshotLayoutEntry> *entries;
+  // Index of this region's first chunk in the global chunk numbering.
+  int first_chunk;
+  int chunk_count;
+};
+
+// State shared between the snapshot thread and the encryption workers. The
+// pool is synchronized with atomics and polling rather than locks so that
+// taking the snapshot does not depend on lock or heap state that the snapshot
+// itself is capturing. This state is reset by the snapshot thread at the
+// beginning of every snapshot, before any worker is created.
+struct SnapshotWorkerPool {
+  // Set when the regions and entries below are published and encryption may
+  // begin.
+  std::atomic<bool> start;
+  // Set when the workers should return, either because the encryption is done
+  // or because the snapshot thread is falling back to sequential encryption.
+  std::atomic<bool> exit;
+  // Set by a worker whose cryptor creation failed during warm-up.
+  std::atomic<bool> spawn_failed;
+  // Set when any thread fails to encrypt a chunk, so that the others stop
+  // claiming work.
+  std::atomic<bool> failed;
+  // Number of workers that have entered the enclave and finished warm-up.
+  std::atomic<int> ready_count;
+  // Number of workers that have finished claiming chunks.
+  std::atomic<int> done_count;
+  // Next chunk to be claimed, in the global chunk numbering.
+  std::atomic<int> next_chunk;
+  int total_chunks;
+  size_t chunk_size;
+  // The snapshot key, valid for the duration of TakeSnapshotForFork(). It is
+  // read by the workers during warm-up only.
+  const CleansingVector<uint8_t> *snapshot_key;
+  SnapshotRegion regions[kSnapshotRegionCount];
+  absl::StatusCode worker_error_codes[kSnapshotEncryptionWorkers];
+  char worker_error_messages[kSnapshotEncryptionWorkers]
+                            [kWorkerErrorMessageSize];
+};
+
+SnapshotWorkerPool snapshot_worker_pool;
+
+// Sleeps briefly between polls of the worker-pool state. nanosleep() exits the
+// enclave, but returns from host calls may re-enter even while entries are
+// blocked, so polling is safe during the whole snapshot window.
+void PollSleep() {
+  struct timespec ts;
+  ts.tv_sec = 0;
+  ts.tv_nsec = kWorkerPollNanoseconds;
+  nanosleep(&ts, /*rem=*/nullptr);
+}
+
+// Returns the region containing the global chunk index |chunk|.
+const SnapshotRegion *RegionForChunk(const SnapshotWorkerPool *pool,
+                                     int chunk) {
+  for (int i = 0; i < kSnapshotRegionCount; ++i) {
+    const SnapshotRegion *region = &pool->regions[i];
+    if (chunk < region->first_chunk + region->chunk_count) {
+      return region;
+    }
   }
-  return Status::OkStatus();
+  return nullptr;
+}
+
+// Claims chunks from the pool until they run out or any thread fails, and
+// encrypts each claimed chunk with |cryptor| into its snapshot entry. On
+// failure, the error is recorded in |error_code| and |error_message| and the
+// pool is marked failed. Runs on both the snapshot thread and the workers.
+void EncryptClaimedChunks(AeadCryptor *cryptor, absl::StatusCode *error_code,
+                          char *error_message, size_t message_buffer_size) {
+  SnapshotWorkerPool *pool = &snapshot_worker_pool;
+  int chunk;
+  while (!pool->failed.load() &&
+         (chunk = pool->next_chunk.fetch_add(1)) < pool->total_chunks) {
+    const SnapshotRegion *region = RegionForChunk(pool, chunk);
+    int chunk_in_region = chunk - region->first_chunk;
+    uint8_t *source = region->base + chunk_in_region * pool->chunk_size;
+    size_t plaintext_size =
+        std::min(pool->chunk_size,
+                 region->size - chunk_in_region * pool->chunk_size);
+    // Chunks that contain only zero bytes are recorded as a short sealed
+    // marker instead of being encrypted and copied out, so that successive
+    // snapshots pay only for memory that has actually been written.
+    SnapshotLayoutEntry *entry = region->entries->Mutable(chunk_in_region);
+    Status status =
+        IsAllZero(source, plaintext_size)
+            ? EncryptZeroChunkMarker(cryptor, source, plaintext_size, entry)
+            : EncryptToUntrustedMemory(cryptor, source, plaintext_size, entry);
+    if (!status.ok()) {
+      CopyNonOkStatus(status, error_code, error_message, message_buffer_size);
+      pool->failed = true;
+      return;
+    }
+  }
+}
+
+// Entry point of a snapshot encryption worker. The worker creates its own
+// cryptor and primes its thread-local BoringSSL state while the normal heap is
+// still active, since any memory acquired while the heap is switched would be
+// freed after the heap is switched back. It then polls until the snapshot
+// thread publishes work or asks it to exit.
+void *SnapshotEncryptionWorker(void *arg) {
+  int index = static_cast<int>(reinterpret_cast<uintptr_t>(arg));
+  SnapshotWorkerPool *pool = &snapshot_worker_pool;
+
+  auto cryptor_result =
+      AeadCryptor::CreateAesGcmSivCryptor(*pool->snapshot_key);
+  if (!cryptor_result.ok()) {
+    pool->spawn_failed = true;
+    return nullptr;
+  }
+  std::unique_ptr<AeadCryptor> cryptor = std::move(cryptor_result.ValueOrDie());
+  // Prime the thread-local state used by the cryptor during encryption, so
+  // that it is allocated on the normal heap.
+  uint8_t dummy;
+  RAND_bytes(&dummy, sizeof(dummy));
+  ERR_clear_error();
+
+  pool->ready_count.fetch_add(1);
+  while (!pool->start.load() && !pool->exit.load()) {
+    PollSleep();
+  }
+
+  if (pool->start.load()) {
+    EncryptClaimedChunks(cryptor.get(), &pool->worker_error_codes[index],
+                         pool->worker_error_messages[index],
+                         kWorkerErrorMessageSize);
+    pool->done_count.fetch_add(1);
+    // Park until asked to exit, so that no heap operations happen on this
+    // thread while the temporary heap is active.
+    while (!pool->exit.load()) {
+      PollSleep();
+    }
+  }
+  return nullptr;
 }
 
 // Decrypts a whole memory region with |cryptor| from |entry|. The memory region
@@ -301,6 +574,14 @@ Status DecryptFromSnapshot(
                     "enclave memory is not found or unexpected");
     }
 
+    if (entry[i].all_zero()) {
+      ASYLO_RETURN_IF_ERROR(DecryptZeroChunkMarker(
+          cryptor, entry[i], current_position, expected_plaintext_size));
+      bytes_left -= expected_plaintext_size;
+      current_position += expected_plaintext_size;
+      continue;
+    }
+
     size_t actual_plaintext_size;
     ASYLO_RETURN_IF_ERROR(DecryptFromUntrustedMemory(
         cryptor, entry[i], current_position, expected_plaintext_size,
@@ -396,14 +677,110 @@ Status TakeSnapshotForFork(SnapshotLayout *snapshot_layout) {
                   "Failed to save snapshot key inside enclave");
   }
 
+  // Create a cryptor based on the AES256-GCM-SIV snapshot key to encrypt the
+  // whole enclave memory. It is created before the heap is switched below so
+  // that it is allocated on the normal heap.
+  auto cryptor_result = AeadCryptor::CreateAesGcmSivCryptor(snapshot_key);
+  if (!cryptor_result.ok()) {
+    return cryptor_result.status();
+  }
+  std::unique_ptr<AeadCryptor> cryptor = std::move(cryptor_result.ValueOrDie());
+
+  // Describe the regions to be encrypted and their chunking, so that the
+  // encryption work can be split across worker threads. The data and bss
+  // regions point at the reserved sections, which receive copies of the live
+  // sections after all other entries are blocked below.
+  SnapshotWorkerPool *pool = &snapshot_worker_pool;
+  pool->start = false;
+  pool->exit = false;
+  pool->spawn_failed = false;
+  pool->failed = false;
+  pool->ready_count = 0;
+  pool->done_count = 0;
+  pool->next_chunk = 0;
+  pool->snapshot_key = &snapshot_key;
+  pool->chunk_size = cryptor->MaxMessageSize();
+  size_t stack_size = reinterpret_cast<size_t>(thread_layout.stack_base) -
+                      reinterpret_cast<size_t>(thread_layout.stack_limit);
+  pool->regions[0] = {
+      reinterpret_cast<uint8_t *>(enclave_layout.reserved_data_base),
+      enclave_layout.data_size, nullptr, 0, 0};
+  pool->regions[1] = {
+      reinterpret_cast<uint8_t *>(enclave_layout.reserved_bss_base),
+      enclave_layout.bss_size, nullptr, 0, 0};
+  pool->regions[2] = {reinterpret_cast<uint8_t *>(thread_layout.thread_base),
+                      thread_layout.thread_size, nullptr, 0, 0};
+  pool->regions[3] = {reinterpret_cast<uint8_t *>(enclave_layout.heap_base),
+                      enclave_layout.heap_size, nullptr, 0, 0};
+  pool->regions[4] = {reinterpret_cast<uint8_t *>(thread_layout.stack_limit),
+                      stack_size, nullptr, 0, 0};
+  pool->total_chunks = 0;
+  for (SnapshotRegion &region : pool->regions) {
+    region.first_chunk = pool->total_chunks;
+    region.chunk_count =
+        (region.size + pool->chunk_size - 1) / pool->chunk_size;
+    pool->total_chunks += region.chunk_count;
+  }
+  memset(pool->worker_error_messages, 0, sizeof(pool->worker_error_messages));
+  for (absl::StatusCode &code : pool->worker_error_codes) {
+    code = absl::StatusCode::kOk;
+  }
+
+  // Spawn the encryption workers. They must enter the enclave before entries
+  // are blocked below, since a new entry would be blocked until fork()
+  // completes on the host.
+  pthread_t worker_threads[kSnapshotEncryptionWorkers];
+  int num_spawned = 0;
+  while (num_spawned < kSnapshotEncryptionWorkers &&
+         pthread_create(&worker_threads[num_spawned], /*attr=*/nullptr,
+                        SnapshotEncryptionWorker,
+                        reinterpret_cast<void *>(
+                            static_cast<uintptr_t>(num_spawned))) == 0) {
+    ++num_spawned;
+  }
+
+  // Wait until every spawned worker has entered the enclave and finished its
+  // warm-up. Workers that are not ready cannot take part in the snapshot: once
+  // entries are blocked they could neither enter nor be woken reliably. If any
+  // worker fails to become ready in time, fall back to encrypting the snapshot
+  // on the calling thread alone.
+  bool use_workers = num_spawned > 0;
+  for (uint64_t waited = 0;
+       use_workers && pool->ready_count.load() < num_spawned &&
+       !pool->spawn_failed.load();
+       waited += kWorkerPollNanoseconds) {
+    if (waited >= kWorkerReadyTimeoutNanoseconds) {
+      use_workers = false;
+      break;
+    }
+    PollSleep();
+  }
+  if (pool->spawn_failed.load()) {
+    use_workers = false;
+  }
+  if (!use_workers && num_spawned > 0) {
+    // The workers are joined before the heap is switched so that all of their
+    // teardown happens on the normal heap.
+    pool->exit = true;
+    for (int i = 0; i < num_spawned; ++i) {
+      pthread_join(worker_threads[i], /*value_ptr=*/nullptr);
+    }
+  }
+  int num_workers = use_workers ? num_spawned : 0;
+
   // Block and check for other entries inside the enclave. Currently there
   // should be two entries inside the enclave: snapshot ecall and the run ecall
-  // which calls fork. If other TCS are running inside the enclave, they may
-  // modify data/bss/heap and cause an inconsistent snapshot. In that case wait
-  // till all other TCS exit the enclave and get blocked from re-entering.
-  // Timeout at 3 seconds.
-  Status status = BlockAndWaitOnEntries(/*allowed_entries=*/2, /*timeout=*/3);
+  // which calls fork, plus one entry per encryption worker spawned above. If
+  // other TCS are running inside the enclave, they may modify data/bss/heap
+  // and cause an inconsistent snapshot. In that case wait till all other TCS
+  // exit the enclave and get blocked from re-entering. Timeout at 3 seconds.
+  Status status =
+      BlockAndWaitOnEntries(/*allowed_entries=*/2 + num_workers, /*timeout=*/3);
   if (!status.ok()) {
+    pool->exit = true;
+    for (int i = 0; i < num_workers; ++i) {
+      pthread_join(worker_threads[i], /*value_ptr=*/nullptr);
+    }
     return status;
   }
 
@@ -437,71 +814,56 @@ Status TakeSnapshotForFork(SnapshotLayout *snapshot_layout) {
     // Create a temporary snapshot object on the switched heap.
     SnapshotLayout tmp_snapshot_layout;
 
-    // Create a cryptor based on the AES256-GCM-SIV snapshot key to encrypt
-    // the whole enclave memory.
-    auto cryptor_result = AeadCryptor::CreateAesGcmSivCryptor(snapshot_key);
-    if (!cryptor_result.ok()) {
-      CopyNonOkStatus(cryptor_result.status(), &error_code, error_message,
-                      ABSL_ARRAYSIZE(error_message));
-      break;
-    }
-    std::unique_ptr<AeadCryptor> cryptor =
-        std::move(cryptor_result.ValueOrDie());
-
-    // Allocate and encrypt reserved data section to an untrusted snapshot.
-    status = EncryptToSnapshot(cryptor.get(), enclave_layout.reserved_data_base,
-                               enclave_layout.data_size,
-                               tmp_snapshot_layout.mutable_data());
-
-    if (!status.ok()) {
-      CopyNonOkStatus(status, &error_code, error_message,
-                      ABSL_ARRAYSIZE(error_message));
-      break;
+    // Pre-size the snapshot entries of every region so that each chunk has an
+    // independent entry to fill during the parallel encryption.
+    google::protobuf::RepeatedPtrField<SnapshotLayoutEntry>
+        *entry_fields[kSnapshotRegionCount] = {
+            tmp_snapshot_layout.mutable_data(),
+            tmp_snapshot_layout.mutable_bss(),
+            tmp_snapshot_layout.mutable_thread(),
+            tmp_snapshot_layout.mutable_heap(),
+            tmp_snapshot_layout.mutable_stack()};
+    for (int i = 0; i < kSnapshotRegionCount; ++i) {
+      pool->regions[i].entries = entry_fields[i];
+      for (int j = 0; j < pool->regions[i].chunk_count; ++j) {
+        entry_fields[i]->Add();
+      }
     }
 
-    // Allocate and encrypt reserved bss section to an untrusted snapshot.
-    status = EncryptToSnapshot(cryptor.get(), enclave_layout.reserved_bss_base,
-                               enclave_layout.bss_size,
-                               tmp_snapshot_layout.mutable_bss());
-
-    if (!status.ok()) {
-      CopyNonOkStatus(status, &error_code, error_message,
-                      ABSL_ARRAYSIZE(error_message));
-      break;
+    // Publish the work to the workers and take part in the encryption on the
+    // calling thread.
+    pool->start = true;
+    EncryptClaimedChunks(cryptor.get(), &error_code, error_message,
+                         ABSL_ARRAYSIZE(error_message));
+
+    // Wait for the workers to finish their remaining chunks.
+    bool workers_done = false;
+    for (uint64_t waited = 0; waited < kWorkerDoneTimeoutNanoseconds;
+         waited += kWorkerPollNanoseconds) {
+      if (pool->done_count.load() >= num_workers) {
+        workers_done = true;
+        break;
+      }
+      PollSleep();
     }
-
-    // Allocate and encrypt thread data for the calling thread.
-    status = EncryptToSnapshot(cryptor.get(), thread_layout.thread_base,
-                               thread_layout.thread_size,
-                               tmp_snapshot_layout.mutable_thread());
-
-    if (!status.ok()) {
-      CopyNonOkStatus(status, &error_code, error_message,
-                      ABSL_ARRAYSIZE(error_message));
+    if (!workers_done) {
+      error_code = absl::StatusCode::kInternal;
+      strncpy(error_message, "Timeout waiting for snapshot encryption workers",
+              ABSL_ARRAYSIZE(error_message));
       break;
     }
 
-    // Allocate and encrypt heap to an untrusted snapshot.
-    status = EncryptToSnapshot(cryptor.get(), enclave_layout.heap_base,
-                               enclave_layout.heap_size,
-                               tmp_snapshot_layout.mutable_heap());
-
-    if (!status.ok()) {
-      CopyNonOkStatus(status, &error_code, error_message,
-                      ABSL_ARRAYSIZE(error_message));
-      break;
+    // Collect the first worker error, if any. The calling thread's own error,
+    // if it had one, is already in |error_code| and |error_message|.
+    for (int i = 0; error_code == absl::StatusCode::kOk && i < num_workers;
+         ++i) {
+      if (pool->worker_error_codes[i] != absl::StatusCode::kOk) {
+        error_code = pool->worker_error_codes[i];
+        memcpy(error_message, pool->worker_error_messages[i],
+               ABSL_ARRAYSIZE(error_message));
+      }
     }
-
-    // Allocate and encrypt stack for the calling thread.
-    size_t stack_size = reinterpret_cast<size_t>(thread_layout.stack_base) -
-                        reinterpret_cast<size_t>(thread_layout.stack_limit);
-
-    status = EncryptToSnapshot(cryptor.get(), thread_layout.stack_limit,
-                               stack_size, tmp_snapshot_layout.mutable_stack());
-
-    if (!status.ok()) {
-      CopyNonOkStatus(status, &error_code, error_message,
-                      ABSL_ARRAYSIZE(error_message));
+    if (error_code != absl::StatusCode::kOk) {
       break;
     }
 
@@ -518,6 +880,16 @@ Status TakeSnapshotForFork(SnapshotLayout *snapshot_layout) {
 
   // Switch heap back before creating the return status.
   heap_switch(/*address=*/nullptr, /*size=*/0);
+
+  // Ask the workers to exit and reclaim their threads. This is done after the
+  // heap is switched back so that all thread teardown happens on the normal
+  // heap. The workers are parked polling for the exit bit, so joining them
+  // does not require any new enclave entry.
+  pool->exit = true;
+  for (int i = 0; i < num_workers; ++i) {
+    pthread_join(worker_threads[i], /*value_ptr=*/nullptr);
+  }
+
   if (error_code != absl::StatusCode::kOk) {
     enc_unblock_entries();
     return Status(error_code, error_message);
@@ -969,6 +1341,73 @@ Status TransferSecureSnapshotKey(
   }
 }
 
+Status SealSnapshotKeyForWarmStart(std::string *serialized_sealed_secret) {
+  // Sealing takes the place of the key transfer to a forked child: it is only
+  // allowed right after a snapshot, and it consumes the transfer request so a
+  // snapshot key leaves the enclave exactly once per snapshot.
+  if (!ClearSnapshotKeyTransferRequested()) {
+    return Status(absl::StatusCode::kPermissionDenied,
+                  "Snapshot key sealing is not allowed unless a snapshot has "
+                  "been taken");
+  }
+
+  // The snapshot and its sealing are done; it is safe to let other entries
+  // back into the enclave.
+  enc_unblock_entries();
+
+  Cleanup delete_snapshot_key(DeleteSnapshotKey);
+  CleansingVector<uint8_t> snapshot_key;
+  if (!GetSnapshotKey(&snapshot_key)) {
+    return Status(absl::StatusCode::kInternal, "Failed to get snapshot key");
+  }
+
+  // Seal to MRENCLAVE so that only the identical enclave binary can decrypt
+  // the snapshot. Sealing to MRSIGNER would let any enclave from the same
+  // signer read the full memory image of this one.
+  std::unique_ptr<SgxLocalSecretSealer> sealer =
+      SgxLocalSecretSealer::CreateMrenclaveSecretSealer();
+  SealedSecretHeader header;
+  ASYLO_RETURN_IF_ERROR(sealer->SetDefaultHeader(&header));
+  header.set_secret_name("warm-start snapshot key");
+  header.set_secret_version("v1");
+  header.set_secret_purpose("Decrypt a sealed warm-start enclave snapshot");
+
+  SealedSecret sealed_secret;
+  ASYLO_RETURN_IF_ERROR(
+      sealer->Seal(header,
+                   ByteContainerView(kSnapshotKeyAssociatedDataBuf,
+                                     sizeof(kSnapshotKeyAssociatedDataBuf)),
+                   snapshot_key, &sealed_secret));
+
+  if (!sealed_secret.SerializeToString(serialized_sealed_secret)) {
+    return Status(absl::StatusCode::kInternal,
+                  "Failed to serialize SealedSecret");
+  }
+  return Status::OkStatus();
+}
+
+Status RestoreSnapshotKeyForWarmStart(
+    const std::string &serialized_sealed_secret) {
+  SealedSecret sealed_secret;
+  if (!sealed_secret.ParseFromString(serialized_sealed_secret)) {
+    return Status(absl::StatusCode::kInvalidArgument,
+                  "Failed to parse SealedSecret");
+  }
+
+  std::unique_ptr<SgxLocalSecretSealer> sealer =
+      SgxLocalSecretSealer::CreateMrenclaveSecretSealer();
+  CleansingVector<uint8_t> snapshot_key;
+  ASYLO_RETURN_IF_ERROR(sealer->Unseal(sealed_secret, &snapshot_key));
+
+  // Save the snapshot key inside the enclave for decrypting and restoring the
+  // enclave.
+  if (!SetSnapshotKey(snapshot_key)) {
+    return Status(absl::StatusCode::kInternal,
+                  "Failed to save snapshot key inside enclave");
+  }
+  return Status::OkStatus();
+}
+
 pid_t enc_fork(const char *enclave_name) {
   // Saves the current stack/thread address info for snapshot.
   asylo::SaveThreadLayoutForSnapshot();
@@ -44,6 +44,17 @@ Status TransferSecureSnapshotKey(
   abort();
 }
 
+Status SealSnapshotKeyForWarmStart(std::string *serialized_sealed_secret) {
+  // Only supported in the SGX hardware backend.
+  abort();
+}
+
+Status RestoreSnapshotKeyForWarmStart(
+    const std::string &serialized_sealed_secret) {
+  // Only supported in the SGX hardware backend.
+  abort();
+}
+
 void SaveThreadLayoutForSnapshot() {
   // Only supported in the SGX hardware backend.
   abort();
@@ -0,0 +1,180 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/sgx/launch_token_cache.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "asylo/crypto/sha256_hash.h"
+#include "asylo/platform/storage/utils/fd_closer.h"
+#include "asylo/util/logging.h"
+
+namespace asylo {
+namespace primitives {
+namespace {
+
+// Returns a file's modification time in nanoseconds since the epoch.
+int64_t MtimeNanos(const struct stat &file_stat) {
+  return file_stat.st_mtim.tv_sec * int64_t{1000000000} +
+         file_stat.st_mtim.tv_nsec;
+}
+
+// Reads the file at |fd| in chunks into a SHA-256 hash, returning the hex
+// digest or an empty string on read failure.
+std::string HexSha256OfFd(int fd) {
+  Sha256Hash hash;
+  char buffer[64 * 1024];
+  ssize_t bytes_read;
+  while ((bytes_read = read(fd, buffer, sizeof(buffer))) > 0) {
+    hash.Update(ByteContainerView(buffer, bytes_read));
+  }
+  if (bytes_read < 0) {
+    return "";
+  }
+  std::vector<uint8_t> digest;
+  if (!hash.CumulativeHash(&digest).ok()) {
+    return "";
+  }
+  return absl::BytesToHexString(
+      absl::string_view(reinterpret_cast<const char *>(digest.data()),
+                        digest.size()));
+}
+
+}  // namespace
+
+LaunchTokenCache *LaunchTokenCache::ForDirectory(absl::string_view directory) {
+  static absl::Mutex caches_mu(absl::kConstInit);
+  static auto *caches =
+      new absl::flat_hash_map<std::string, LaunchTokenCache *>();
+  absl::MutexLock lock(&caches_mu);
+  auto it = caches->find(directory);
+  if (it != caches->end()) {
+    return it->second;
+  }
+  std::string dir(directory);
+  if (mkdir(dir.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+    LOG(WARNING) << "Failed to create launch token cache directory " << dir
+                 << "; caching disabled for this directory";
+  }
+  LaunchTokenCache *cache = new LaunchTokenCache(std::move(dir));
+  caches->emplace(std::string(directory), cache);
+  return cache;
+}
+
+bool LaunchTokenCache::GetLaunchToken(absl::string_view enclave_path,
+                                      sgx_launch_token_t *token) {
+  const std::string hex_hash = HashEnclaveFile(enclave_path);
+  if (hex_hash.empty()) {
+    return false;
+  }
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = tokens_.find(hex_hash);
+    if (it != tokens_.end()) {
+      memcpy(token, it->second.data(), sizeof(sgx_launch_token_t));
+      return true;
+    }
+  }
+
+  platform::storage::FdCloser fd(open(TokenPath(hex_hash).c_str(), O_RDONLY));
+  if (fd.get() < 0) {
+    return false;
+  }
+  std::string contents(sizeof(sgx_launch_token_t), '\0');
+  if (read(fd.get(), &contents[0], contents.size()) !=
+      static_cast<ssize_t>(contents.size())) {
+    return false;
+  }
+  memcpy(token, contents.data(), sizeof(sgx_launch_token_t));
+  absl::MutexLock lock(&mu_);
+  tokens_.emplace(hex_hash, std::move(contents));
+  return true;
+}
+
+void LaunchTokenCache::PutLaunchToken(absl::string_view enclave_path,
+                                      const sgx_launch_token_t &token) {
+  const std::string hex_hash = HashEnclaveFile(enclave_path);
+  if (hex_hash.empty()) {
+    return;
+  }
+  std::string contents(reinterpret_cast<const char *>(&token),
+                       sizeof(sgx_launch_token_t));
+  {
+    absl::MutexLock lock(&mu_);
+    tokens_[hex_hash] = contents;
+  }
+
+  // Write through a temporary file and rename so concurrent readers never
+  // observe a partial token.
+  const std::string token_path = TokenPath(hex_hash);
+  const std::string temp_path = absl::StrCat(token_path, ".tmp.", getpid());
+  platform::storage::FdCloser fd(open(
+      temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR));
+  if (fd.get() < 0 ||
+      write(fd.get(), contents.data(), contents.size()) !=
+          static_cast<ssize_t>(contents.size()) ||
+      rename(temp_path.c_str(), token_path.c_str()) != 0) {
+    LOG(WARNING) << "Failed to persist launch token to " << token_path;
+    unlink(temp_path.c_str());
+  }
+}
+
+std::string LaunchTokenCache::HashEnclaveFile(absl::string_view enclave_path) {
+  struct stat file_stat;
+  const std::string path(enclave_path);
+  if (stat(path.c_str(), &file_stat) != 0) {
+    return "";
+  }
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = digests_.find(path);
+    if (it != digests_.end() && it->second.size == file_stat.st_size &&
+        it->second.mtime_nanos == MtimeNanos(file_stat)) {
+      return it->second.hex_hash;
+    }
+  }
+
+  platform::storage::FdCloser fd(open(path.c_str(), O_RDONLY));
+  if (fd.get() < 0) {
+    return "";
+  }
+  std::string hex_hash = HexSha256OfFd(fd.get());
+  if (hex_hash.empty()) {
+    return "";
+  }
+  absl::MutexLock lock(&mu_);
+  digests_[path] =
+      FileDigest{file_stat.st_size, MtimeNanos(file_stat), hex_hash};
+  return hex_hash;
+}
+
+std::string LaunchTokenCache::TokenPath(absl::string_view hex_hash) const {
+  return absl::StrCat(directory_, "/", hex_hash, ".token");
+}
+
+}  // namespace primitives
+}  // namespace asylo
@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_SGX_LAUNCH_TOKEN_CACHE_H_
+#define ASYLO_PLATFORM_PRIMITIVES_SGX_LAUNCH_TOKEN_CACHE_H_
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "include/sgx_urts.h"
+
+namespace asylo {
+namespace primitives {
+
+// Disk-backed cache of SGX launch tokens keyed by enclave binary content.
+//
+// Creating an enclave from a file path negotiates a launch token with the
+// launch enclave on every load, and validating which token applies means
+// re-reading the identical binary on every process restart. The cache stores
+// the negotiated token under the binary's SHA-256 content hash in a
+// directory that outlives the process, so repeated loads of the same binary
+// — across restarts and across processes sharing the directory — skip the
+// negotiation. The content hash itself is memoized per file size and
+// modification time, so steady-state lookups do not re-read the binary
+// either.
+//
+// A cached token is a hint: the SGX SDK validates the token during enclave
+// creation and renegotiates if it is stale, so cache corruption or reuse
+// against a changed binary costs one negotiation, never correctness. All
+// cache failures are silent misses. Thread-safe.
+class LaunchTokenCache {
+ public:
+  // Returns the process-wide cache rooted at |directory|, creating the
+  // directory (mode 0700) on first use. Caches are shared by every load
+  // naming the same directory and are never destroyed.
+  static LaunchTokenCache *ForDirectory(absl::string_view directory);
+
+  // Looks up the token cached for the binary at |enclave_path|. Returns true
+  // and fills |token| on a hit.
+  bool GetLaunchToken(absl::string_view enclave_path,
+                      sgx_launch_token_t *token) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Stores |token| as the launch token for the binary at |enclave_path|.
+  void PutLaunchToken(absl::string_view enclave_path,
+                      const sgx_launch_token_t &token) ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  explicit LaunchTokenCache(std::string directory)
+      : directory_(std::move(directory)) {}
+
+  LaunchTokenCache(const LaunchTokenCache &) = delete;
+  LaunchTokenCache &operator=(const LaunchTokenCache &) = delete;
+
+  // The memoized content hash of one enclave binary, valid while the file's
+  // size and modification time are unchanged.
+  struct FileDigest {
+    off_t size;
+    int64_t mtime_nanos;
+    std::string hex_hash;
+  };
+
+  // Returns the hex SHA-256 content hash of |enclave_path|, reusing the
+  // memoized hash when the file is unchanged. Returns an empty string if the
+  // file cannot be read.
+  std::string HashEnclaveFile(absl::string_view enclave_path)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Returns the path of the token file for content hash |hex_hash|.
+  std::string TokenPath(absl::string_view hex_hash) const;
+
+  const std::string directory_;
+
+  absl::Mutex mu_;
+  // Memoized content hashes keyed by binary path.
+  absl::flat_hash_map<std::string, FileDigest> digests_ ABSL_GUARDED_BY(mu_);
+  // In-memory copy of tokens keyed by content hash, saving the disk read
+  // within one process.
+  absl::flat_hash_map<std::string, std::string> tokens_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_SGX_LAUNCH_TOKEN_CACHE_H_
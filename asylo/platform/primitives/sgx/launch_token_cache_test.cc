@@ -0,0 +1,116 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/sgx/launch_token_cache.h"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/strings/str_cat.h"
+
+namespace asylo {
+namespace primitives {
+namespace {
+
+// Writes |contents| as the fake enclave binary at |path|.
+void WriteBinary(const std::string &path, const std::string &contents) {
+  std::ofstream file(path, std::ios::trunc);
+  file << contents;
+}
+
+// Fills every byte of |token| with |fill|.
+void FillToken(sgx_launch_token_t *token, uint8_t fill) {
+  memset(token, fill, sizeof(sgx_launch_token_t));
+}
+
+class LaunchTokenCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const auto *test_info =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+    cache_dir_ = absl::StrCat(::testing::TempDir(), "/token_cache_",
+                              test_info->name());
+    binary_path_ = absl::StrCat(::testing::TempDir(), "/enclave_",
+                                test_info->name(), ".so");
+    cache_ = LaunchTokenCache::ForDirectory(cache_dir_);
+  }
+
+  std::string cache_dir_;
+  std::string binary_path_;
+  LaunchTokenCache *cache_;
+};
+
+TEST_F(LaunchTokenCacheTest, MissForUncachedBinary) {
+  WriteBinary(binary_path_, "enclave contents");
+  sgx_launch_token_t token;
+  EXPECT_FALSE(cache_->GetLaunchToken(binary_path_, &token));
+}
+
+TEST_F(LaunchTokenCacheTest, MissForMissingBinary) {
+  sgx_launch_token_t token;
+  EXPECT_FALSE(cache_->GetLaunchToken("/no/such/enclave.so", &token));
+}
+
+TEST_F(LaunchTokenCacheTest, RoundTrip) {
+  WriteBinary(binary_path_, "enclave contents");
+  sgx_launch_token_t stored;
+  FillToken(&stored, 0xa5);
+  cache_->PutLaunchToken(binary_path_, stored);
+
+  sgx_launch_token_t loaded;
+  FillToken(&loaded, 0);
+  ASSERT_TRUE(cache_->GetLaunchToken(binary_path_, &loaded));
+  EXPECT_EQ(memcmp(stored, loaded, sizeof(sgx_launch_token_t)), 0);
+}
+
+TEST_F(LaunchTokenCacheTest, ChangedBinaryMisses) {
+  WriteBinary(binary_path_, "enclave contents");
+  sgx_launch_token_t stored;
+  FillToken(&stored, 0x5a);
+  cache_->PutLaunchToken(binary_path_, stored);
+
+  // A binary with different contents hashes to a different key.
+  WriteBinary(binary_path_, "different enclave contents");
+  sgx_launch_token_t loaded;
+  EXPECT_FALSE(cache_->GetLaunchToken(binary_path_, &loaded));
+}
+
+TEST_F(LaunchTokenCacheTest, SameDirectorySharesCache) {
+  EXPECT_EQ(LaunchTokenCache::ForDirectory(cache_dir_), cache_);
+  EXPECT_NE(LaunchTokenCache::ForDirectory(absl::StrCat(cache_dir_, "_other")),
+            cache_);
+}
+
+TEST_F(LaunchTokenCacheTest, TokenPersistedToDisk) {
+  WriteBinary(binary_path_, "enclave contents");
+  sgx_launch_token_t stored;
+  FillToken(&stored, 0x42);
+  cache_->PutLaunchToken(binary_path_, stored);
+
+  // A token file appeared in the cache directory; a cache in a later process
+  // would read it back.
+  sgx_launch_token_t loaded;
+  ASSERT_TRUE(cache_->GetLaunchToken(binary_path_, &loaded));
+  EXPECT_EQ(memcmp(stored, loaded, sizeof(sgx_launch_token_t)), 0);
+}
+
+}  // namespace
+}  // namespace primitives
+}  // namespace asylo
@@ -42,6 +42,7 @@
 #include "asylo/platform/primitives/sgx/generated_bridge_u.h"
 #include "asylo/platform/primitives/sgx/sgx_params.h"
 #include "asylo/platform/primitives/sgx/signal_dispatcher.h"
+#include "asylo/platform/primitives/sgx/untrusted_alloc_policy.h"
 #include "asylo/platform/primitives/sgx/untrusted_sgx.h"
 #include "asylo/platform/primitives/untrusted_primitives.h"
 #include "asylo/platform/primitives/util/message.h"
@@ -175,7 +176,8 @@ int ocall_untrusted_debug_puts(const char *str) {
 }
 
 void *ocall_untrusted_local_alloc(uint64_t size) {
-  void *ret = malloc(static_cast<size_t>(size));
+  void *ret = asylo::primitives::UntrustedAllocWithPolicy(
+      static_cast<size_t>(size));
   return ret;
 }
 
@@ -183,7 +185,7 @@ void **ocall_enc_untrusted_allocate_buffers(uint64_t count, uint64_t size) {
   void **buffers = reinterpret_cast<void **>(
       malloc(static_cast<size_t>(count) * sizeof(void *)));
   for (int i = 0; i < count; i++) {
-    buffers[i] = malloc(size);
+    buffers[i] = asylo::primitives::UntrustedAllocWithPolicy(size);
   }
   return buffers;
 }
@@ -482,6 +484,13 @@ int32_t ocall_enc_untrusted_fork(const char *enclave_name,
 int ocall_dispatch_untrusted_call(uint64_t selector, void *buffer) {
   asylo::SgxParams *const sgx_params =
       reinterpret_cast<asylo::SgxParams *>(buffer);
+  // Charge the modeled exit transition cost when the client is configured for
+  // simulation performance parity; a no-op otherwise.
+  auto *parity_client = dynamic_cast<asylo::primitives::SgxEnclaveClient *>(
+      asylo::primitives::Client::GetCurrentClient());
+  if (parity_client) {
+    parity_client->InjectSimulatedExitDelay(sgx_params->input_size);
+  }
   ::asylo::primitives::MessageReader in;
   if (sgx_params->input) {
     in.Deserialize(sgx_params->input, sgx_params->input_size);
@@ -100,11 +100,55 @@ Status EnclaveSignalDispatcher::DeregisterAllSignalsForClient(
 int EnclaveSignalDispatcher::EnterEnclaveAndHandleSignal(int signum,
                                                          siginfo_t *info,
                                                          void *ucontext) {
-  SgxEnclaveClient *client = GetClientForSignal(signum);
-  if (!client) {
-    return -1;
+  if (signum <= 0 || signum > kMaxSignalNumber) {
+    // Outside the pending set's range; deliver directly without coalescing.
+    SgxEnclaveClient *client = GetClientForSignal(signum);
+    if (!client) {
+      return -1;
+    }
+    return client->EnterAndHandleSignal(signum, info->si_code);
+  }
+
+  // Record the signal. A signal number that is already pending coalesces into
+  // the recorded delivery and just refreshes the si_code.
+  pending_sigcodes_[signum - 1].store(info->si_code,
+                                      std::memory_order_relaxed);
+  pending_signals_.fetch_or(uint64_t{1} << (signum - 1),
+                            std::memory_order_release);
+
+  // Only one thread at a time performs the draining entries; everyone else's
+  // signals ride along with the active drain. After releasing the flag,
+  // re-check the set so a signal recorded between the final drain pass and
+  // the release is picked up by somebody.
+  int result = 0;
+  while (!delivery_in_progress_.exchange(true, std::memory_order_acq_rel)) {
+    result = DrainPendingSignals();
+    delivery_in_progress_.store(false, std::memory_order_release);
+    if (pending_signals_.load(std::memory_order_acquire) == 0) {
+      break;
+    }
+  }
+  return result;
+}
+
+int EnclaveSignalDispatcher::DrainPendingSignals() {
+  int result = 0;
+  uint64_t pending;
+  while ((pending = pending_signals_.exchange(0, std::memory_order_acq_rel)) !=
+         0) {
+    for (int signum = 1; signum <= kMaxSignalNumber; ++signum) {
+      if ((pending & (uint64_t{1} << (signum - 1))) == 0) {
+        continue;
+      }
+      int sigcode =
+          pending_sigcodes_[signum - 1].load(std::memory_order_relaxed);
+      SgxEnclaveClient *client = GetClientForSignal(signum);
+      if (!client || client->EnterAndHandleSignal(signum, sigcode) != 0) {
+        result = -1;
+      }
+    }
   }
-  return client->EnterAndHandleSignal(signum, info->si_code);
+  return result;
 }
 
 }  // namespace primitives
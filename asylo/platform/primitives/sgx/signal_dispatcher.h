@@ -21,6 +21,8 @@
 
 #include <signal.h>
 
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <unordered_map>
 
@@ -51,19 +53,48 @@ class EnclaveSignalDispatcher {
   // Deregisters all the signals registered by |client|.
   Status DeregisterAllSignalsForClient(SgxEnclaveClient *client);
 
-  // Looks for the enclave client that registered |signum|, and calls
-  // EnterAndHandleSignal() with that enclave client. |signum|, |info| and
-  // |ucontext| are passed into the enclave.
+  // Records |signum| in the pending signal set and drains the set into the
+  // enclave. Only one thread at a time performs the draining entries; signals
+  // arriving on other threads (or on the same thread while an entry is in
+  // progress) just mark their pending bit and ride along with the active
+  // drain. Repeated arrivals of one signal number coalesce into a single
+  // delivery carrying the latest si_code, mirroring how the kernel already
+  // coalesces pending standard signals, so a flood of one signal costs one
+  // enclave entry per drain cycle instead of one per arrival.
+  //
+  // Returns the result of the drain this call performed, or 0 when delivery
+  // was left to the thread already draining.
   int EnterEnclaveAndHandleSignal(int signum, siginfo_t *info, void *ucontext);
 
  private:
+  // Highest signal number the pending set can record; signals outside
+  // [1, kMaxSignalNumber] are delivered directly without coalescing.
+  static constexpr int kMaxSignalNumber = 64;
   EnclaveSignalDispatcher() = default;  // Private to enforce singleton.
   EnclaveSignalDispatcher(EnclaveSignalDispatcher const &) = delete;
   void operator=(EnclaveSignalDispatcher const &) = delete;
 
+  // Delivers every signal currently in the pending set, entering the enclave
+  // once per pending signal number and looping until the set stays empty.
+  // Returns 0 if every delivery succeeded.
+  int DrainPendingSignals();
+
   // Mapping of signal number to the enclave client that registered it.
   std::unordered_map<int, SgxEnclaveClient *> signal_to_client_map_;
 
+  // Pending-delivery bit per signal number (bit |signum| - 1). Set from the
+  // host signal handler, cleared by the draining thread.
+  std::atomic<uint64_t> pending_signals_{0};
+
+  // Latest si_code recorded for each pending signal number, indexed by
+  // |signum| - 1. Only meaningful while the signal's pending bit is set.
+  std::atomic<int> pending_sigcodes_[kMaxSignalNumber] = {};
+
+  // True while a thread is draining the pending set into the enclave. The
+  // draining thread re-checks the set after clearing this flag, so a signal
+  // recorded concurrently is never stranded.
+  std::atomic<bool> delivery_in_progress_{false};
+
   // A mutex that guards signal_to_client_map_ and client_to_signal_map_.
   // This is a recursive mutex so that a signal entering the enclave won't cause
   // deadlock while the same thread is holding the lock.
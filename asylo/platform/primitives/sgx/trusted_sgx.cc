@@ -41,6 +41,7 @@
 #include "asylo/platform/primitives/util/message.h"
 #include "asylo/platform/primitives/util/trusted_memory.h"
 #include "asylo/platform/primitives/util/trusted_runtime_helper.h"
+#include "asylo/platform/primitives/util/trusted_switchless.h"
 #include "asylo/platform/system_call/type_conversions/types_functions.h"
 #include "asylo/util/cleanup.h"
 #include "asylo/util/status.h"
@@ -264,6 +265,14 @@ PrimitiveStatus TrustedPrimitives::UntrustedCall(uint64_t untrusted_selector,
                                                  MessageReader *output) {
   int ret;
 
+  // Complete hot exit calls through the switchless channel, when one is
+  // configured for this selector, without an EEXIT/EENTER round trip.
+  PrimitiveStatus switchless_status;
+  if (SwitchlessUntrustedCall(untrusted_selector, input, output,
+                              &switchless_status)) {
+    return switchless_status;
+  }
+
   UntrustedCacheMalloc *untrusted_cache = UntrustedCacheMalloc::Instance();
 
   SgxParams *const sgx_params =
@@ -0,0 +1,101 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/sgx/untrusted_alloc_policy.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "absl/synchronization/mutex.h"
+
+namespace asylo {
+namespace primitives {
+
+namespace {
+
+// Linux memory policy modes, mirrored here to avoid a libnuma dependency.
+constexpr int kMpolPreferred = 1;
+
+// Maximum NUMA node supported by the nodemask passed to mbind(2).
+constexpr int kMaxNumaNode = 63;
+
+absl::Mutex *PolicyMutex() {
+  static absl::Mutex *mutex = new absl::Mutex();
+  return mutex;
+}
+
+UntrustedAllocPolicy *MutablePolicy() {
+  static UntrustedAllocPolicy *policy = new UntrustedAllocPolicy();
+  return policy;
+}
+
+// Binds [addr, addr + length) to the preferred NUMA node. Best-effort: a
+// failure leaves the region under the kernel's default placement.
+void BindToNode(void *addr, size_t length, int node) {
+  if (node < 0 || node > kMaxNumaNode) {
+    return;
+  }
+  uint64_t nodemask = UINT64_C(1) << node;
+  syscall(SYS_mbind, addr, length, kMpolPreferred, &nodemask,
+          kMaxNumaNode + 2, /*flags=*/0);
+}
+
+}  // namespace
+
+void SetUntrustedAllocPolicy(const UntrustedAllocPolicy &policy) {
+  absl::MutexLock lock(PolicyMutex());
+  *MutablePolicy() = policy;
+}
+
+UntrustedAllocPolicy GetUntrustedAllocPolicy() {
+  absl::MutexLock lock(PolicyMutex());
+  return *MutablePolicy();
+}
+
+void *UntrustedAllocWithPolicy(size_t size) {
+  UntrustedAllocPolicy policy = GetUntrustedAllocPolicy();
+  const bool huge = policy.use_huge_pages && size >= kHugePageSize;
+  if (policy.numa_node < 0 && !huge) {
+    return malloc(size);
+  }
+
+  // Align the buffer so that madvise() and mbind() cover exactly the pages
+  // backing it; posix_memalign() memory remains compatible with free().
+  const size_t alignment =
+      huge ? kHugePageSize : static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  void *buffer = nullptr;
+  if (posix_memalign(&buffer, alignment, size) != 0) {
+    // Fall back to an unplaced allocation rather than failing the caller.
+    return malloc(size);
+  }
+  if (huge) {
+    // Request transparent huge pages rather than MAP_HUGETLB, since the
+    // buffer must remain free()-compatible and must not depend on a
+    // preallocated hugetlbfs pool.
+    madvise(buffer, size, MADV_HUGEPAGE);
+  }
+  BindToNode(buffer, size, policy.numa_node);
+  return buffer;
+}
+
+}  // namespace primitives
+}  // namespace asylo
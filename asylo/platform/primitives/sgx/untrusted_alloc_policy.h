@@ -0,0 +1,65 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_SGX_UNTRUSTED_ALLOC_POLICY_H_
+#define ASYLO_PLATFORM_PRIMITIVES_SGX_UNTRUSTED_ALLOC_POLICY_H_
+
+#include <cstddef>
+
+namespace asylo {
+namespace primitives {
+
+// Placement policy for untrusted memory shared with an enclave: the buffers
+// returned by TrustedPrimitives::UntrustedLocalAlloc() and the pools backing
+// UntrustedCacheMalloc. On multi-socket hosts, binding these buffers to the
+// NUMA node running the enclave's host threads avoids cross-node transfers on
+// every enclave boundary crossing, and backing large buffers with 2MB pages
+// reduces TLB pressure for bulk I/O.
+struct UntrustedAllocPolicy {
+  // NUMA node to place shared buffers on, or -1 to leave placement to the
+  // kernel's default (first-touch) policy.
+  int numa_node = -1;
+
+  // Whether to request transparent 2MB huge pages for buffers of at least
+  // kHugePageSize bytes.
+  bool use_huge_pages = false;
+};
+
+// Size of a 2MB huge page; allocations at least this large are eligible for
+// huge page backing.
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+// Installs `policy` for subsequent shared buffer allocations. Thread-safe;
+// typically called once before loading an enclave. Existing allocations are
+// unaffected.
+void SetUntrustedAllocPolicy(const UntrustedAllocPolicy &policy);
+
+// Returns the currently installed policy.
+UntrustedAllocPolicy GetUntrustedAllocPolicy();
+
+// Allocates `size` bytes of untrusted memory placed according to the
+// installed policy. The returned buffer is always compatible with free(),
+// since shared buffers are released through the regular untrusted free paths.
+// Returns nullptr on allocation failure; placement is best-effort and failure
+// to bind or back with huge pages degrades to a plain allocation.
+void *UntrustedAllocWithPolicy(size_t size);
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_SGX_UNTRUSTED_ALLOC_POLICY_H_
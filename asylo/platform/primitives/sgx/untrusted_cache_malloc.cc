@@ -51,6 +51,15 @@ using primitives::TrustedPrimitives;
 
 bool UntrustedCacheMalloc::is_destroyed_ = false;
 
+thread_local UntrustedCacheMalloc::ThreadMagazine
+    UntrustedCacheMalloc::magazine_;
+
+UntrustedCacheMalloc::ThreadMagazine::~ThreadMagazine() {
+  if (!is_destroyed_ && count > 0) {
+    Instance()->DrainMagazine(this);
+  }
+}
+
 UntrustedCacheMalloc *UntrustedCacheMalloc::Instance() {
   static TrustedSpinLock lock(/*is_recursive=*/false);
   static UntrustedCacheMalloc *instance = nullptr;
@@ -115,6 +124,15 @@ void *UntrustedCacheMalloc::GetBuffer() {
     buffer = buffer_pool_.top();
     buffer_pool_.pop();
     busy_buffers_.insert(buffer);
+
+    // While the lock is held, move a batch of buffers into the calling
+    // thread's magazine so subsequent small allocations need no lock.
+    while (magazine_.count < kMagazineRefillBatch && !buffer_pool_.empty()) {
+      void *cached = buffer_pool_.top();
+      buffer_pool_.pop();
+      busy_buffers_.insert(cached);
+      magazine_.buffers[magazine_.count++] = cached;
+    }
   }
 
   if (is_pool_empty) {
@@ -132,6 +150,11 @@ void *UntrustedCacheMalloc::Malloc(size_t size) {
   if (is_destroyed_ || (size > kPoolEntrySize) || GetSwitchedHeapNext()) {
     return primitives::TrustedPrimitives::UntrustedLocalAlloc(size);
   }
+  // Lock-free fast path: serve the allocation from the calling thread's
+  // magazine. Magazine buffers are already recorded as busy in the pool.
+  if (magazine_.count > 0) {
+    return magazine_.buffers[--magazine_.count];
+  }
   return GetBuffer();
 }
 
@@ -160,8 +183,23 @@ void UntrustedCacheMalloc::Free(void *buffer) {
     PushToFreeList(buffer);
     return;
   }
+  // Prefer returning pool buffers to the calling thread's magazine, where
+  // they stay marked busy and can be reallocated without contention.
+  if (magazine_.count < ThreadMagazine::kCapacity) {
+    magazine_.buffers[magazine_.count++] = buffer;
+    return;
+  }
   busy_buffers_.erase(buffer);
   buffer_pool_.push(buffer);
 }
 
+void UntrustedCacheMalloc::DrainMagazine(ThreadMagazine *magazine) {
+  LockGuard spin_lock(&lock_);
+  for (size_t i = 0; i < magazine->count; i++) {
+    busy_buffers_.erase(magazine->buffers[i]);
+    buffer_pool_.push(magazine->buffers[i]);
+  }
+  magazine->count = 0;
+}
+
 }  // namespace asylo
@@ -68,6 +68,20 @@ class UntrustedCacheMalloc {
     int count;
   };
 
+  // A small per-thread cache of pool buffers. Buffers held in a magazine
+  // remain recorded as busy in the global pool, so a magazine hit in Malloc()
+  // requires no lock acquisition at all. The magazine returns its contents to
+  // the global pool when the owning thread exits.
+  struct ThreadMagazine {
+    // Maximum buffers cached per thread.
+    static constexpr size_t kCapacity = 16;
+
+    ~ThreadMagazine();
+
+    void *buffers[kCapacity];
+    size_t count = 0;
+  };
+
   TrustedSpinLock lock_;
 
   // Number of entries added to the buffer pool when it's depleted.
@@ -98,6 +112,17 @@ class UntrustedCacheMalloc {
   // the list.
   void PushToFreeList(void *buffer);
 
+  // Returns all buffers held by |magazine| to the global buffer pool. Called
+  // on thread exit.
+  void DrainMagazine(ThreadMagazine *magazine);
+
+  // The calling thread's buffer magazine.
+  static thread_local ThreadMagazine magazine_;
+
+  // Number of buffers moved from the pool to a depleted magazine while the
+  // lock is already held for a pool allocation.
+  static constexpr size_t kMagazineRefillBatch = 8;
+
   // List of pointers to untrusted buffers which need to be freed.
   std::unique_ptr<FreeList> free_list_;
 
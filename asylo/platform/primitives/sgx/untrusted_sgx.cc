@@ -20,13 +20,18 @@
 
 #include <sys/mman.h>
 #include <unistd.h>
+#include <x86intrin.h>
 
+#include <chrono>
+#include <cinttypes>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
@@ -36,6 +41,7 @@
 #include "asylo/platform/primitives/sgx/sgx_params.h"
 #include "asylo/platform/primitives/sgx/signal_dispatcher.h"
 #include "asylo/platform/primitives/untrusted_primitives.h"
+#include "asylo/platform/primitives/util/call_metrics.h"
 #include "asylo/platform/primitives/util/message.h"
 #include "asylo/util/cleanup.h"
 #include "asylo/util/elf_reader.h"
@@ -46,6 +52,7 @@
 #include "asylo/util/status_helpers.h"
 #include "asylo/util/status_macros.h"
 #include "asylo/util/statusor.h"
+#include "asylo/util/thread.h"
 
 namespace asylo {
 namespace primitives {
@@ -67,6 +74,75 @@ forked_loader_callback_t forked_loader_callback;
 constexpr int kMaxEnclaveCreateAttempts = 5;
 constexpr size_t kPageSize = 4096;
 
+// Busy-waits for approximately |cycles| timestamp-counter cycles. Used by the
+// simulation performance-parity mode to charge modeled transition costs; a
+// spin rather than a sleep because real transition costs burn CPU and do not
+// yield the core.
+void SpinForCycles(uint64_t cycles) {
+  if (cycles == 0) {
+    return;
+  }
+  const uint64_t start = __rdtsc();
+  while (__rdtsc() - start < cycles) {
+  }
+}
+
+// Reads the cumulative major page fault count of the calling process from
+// /proc/self/stat. Major faults are the tenth field after the parenthesized
+// command name; parsing starts from the closing parenthesis since the command
+// itself may contain spaces.
+StatusOr<uint64_t> ReadProcessMajorFaults() {
+  FILE *stat_file = fopen("/proc/self/stat", "r");
+  if (!stat_file) {
+    return absl::InternalError("Failed to open /proc/self/stat");
+  }
+  char line[1024];
+  char *result = fgets(line, sizeof(line), stat_file);
+  fclose(stat_file);
+  if (!result) {
+    return absl::InternalError("Failed to read /proc/self/stat");
+  }
+  char *cursor = strrchr(line, ')');
+  if (!cursor) {
+    return absl::InternalError("Malformed /proc/self/stat");
+  }
+  ++cursor;
+  // Fields after the command name: state ppid pgrp session tty_nr tpgid flags
+  // minflt cminflt majflt.
+  uint64_t majflt;
+  if (sscanf(cursor, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %" SCNu64,
+             &majflt) != 1) {
+    return absl::InternalError("Malformed /proc/self/stat");
+  }
+  return majflt;
+}
+
+// Sums the resident (Rss) bytes of every /proc/self/smaps mapping that lies
+// within [|range_start|, |range_end|), i.e. the portion of an enclave's
+// address range currently backed by physical pages.
+StatusOr<uint64_t> ReadResidentBytesInRange(uintptr_t range_start,
+                                            uintptr_t range_end) {
+  FILE *smaps_file = fopen("/proc/self/smaps", "r");
+  if (!smaps_file) {
+    return absl::InternalError("Failed to open /proc/self/smaps");
+  }
+  uint64_t resident_bytes = 0;
+  bool in_range = false;
+  char line[1024];
+  while (fgets(line, sizeof(line), smaps_file)) {
+    uintptr_t vma_start, vma_end;
+    uint64_t rss_kb;
+    if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR " ", &vma_start, &vma_end) ==
+        2) {
+      in_range = vma_start >= range_start && vma_end <= range_end;
+    } else if (in_range && sscanf(line, "Rss: %" SCNu64 " kB", &rss_kb) == 1) {
+      resident_bytes += rss_kb * 1024;
+    }
+  }
+  fclose(smaps_file);
+  return resident_bytes;
+}
+
 // Enters the enclave and invokes the secure snapshot key transfer entry-point.
 // If the ecall fails, return a non-OK status.
 static Status TransferSecureSnapshotKey(sgx_enclave_id_t eid, const char *input,
@@ -139,6 +215,107 @@ static Status Restore(sgx_enclave_id_t eid, const char *input, size_t input_len,
   return Status::OkStatus();
 }
 
+// Enters the enclave and invokes the warm-start snapshot preparation
+// entry-point. If the ecall fails, return a non-OK status.
+static Status PrepareWarmStartSnapshot(sgx_enclave_id_t eid, char **output,
+                                       size_t *output_len) {
+  uint64_t bridge_output_len;
+  int retval = 0;
+  sgx_status_t sgx_status = ecall_prepare_warm_start_snapshot(
+      eid, &retval, output, &bridge_output_len);
+
+  if (output_len) {
+    *output_len = static_cast<size_t>(bridge_output_len);
+  }
+  if (sgx_status != SGX_SUCCESS) {
+    // Return a Status object in the SGX error space.
+    return Status(sgx_status,
+                  "Call to ecall_prepare_warm_start_snapshot failed");
+  } else if (retval || !output_len || *output_len == 0) {
+    // Ecall succeeded but did not return a value. This indicates that the
+    // trusted code failed to propagate error information over the enclave
+    // boundary.
+    return absl::InternalError("No output from enclave");
+  }
+  return Status::OkStatus();
+}
+
+// Enters the enclave and invokes the snapshot key sealing entry-point. If the
+// ecall fails, return a non-OK status.
+static Status SealSnapshotKey(sgx_enclave_id_t eid, char **output,
+                              size_t *output_len) {
+  uint64_t bridge_output_len;
+  int retval = 0;
+  sgx_status_t sgx_status =
+      ecall_seal_snapshot_key(eid, &retval, output, &bridge_output_len);
+
+  if (output_len) {
+    *output_len = static_cast<size_t>(bridge_output_len);
+  }
+  if (sgx_status != SGX_SUCCESS) {
+    // Return a Status object in the SGX error space.
+    return Status(sgx_status, "Call to ecall_seal_snapshot_key failed");
+  } else if (retval || !output_len || *output_len == 0) {
+    // Ecall succeeded but did not return a value. This indicates that the
+    // trusted code failed to propagate error information over the enclave
+    // boundary.
+    return absl::InternalError("No output from enclave");
+  }
+
+  return Status::OkStatus();
+}
+
+// Enters the enclave and invokes the snapshot key restoring entry-point. If
+// the ecall fails, return a non-OK status.
+static Status RestoreSnapshotKey(sgx_enclave_id_t eid, const char *input,
+                                 size_t input_len, char **output,
+                                 size_t *output_len) {
+  uint64_t bridge_output_len;
+  int retval = 0;
+  sgx_status_t sgx_status = ecall_restore_snapshot_key(
+      eid, &retval, input, input_len, output, &bridge_output_len);
+  if (output_len) {
+    *output_len = static_cast<size_t>(bridge_output_len);
+  }
+  if (sgx_status != SGX_SUCCESS) {
+    // Return a Status object in the SGX error space.
+    return Status(sgx_status, "Call to ecall_restore_snapshot_key failed");
+  } else if (retval || !output_len || *output_len == 0) {
+    // Ecall succeeded but did not return a value. This indicates that the
+    // trusted code failed to propagate error information over the enclave
+    // boundary.
+    return absl::InternalError("No output from enclave");
+  }
+  return Status::OkStatus();
+}
+
+// Number of threads walking a mapped enclave binary ahead of page addition.
+// Reads hit the page cache or a handful of parallel I/O streams; more threads
+// than this mostly contend on the backing device.
+constexpr int kPrefaultThreads = 4;
+
+// Touches every kPrefaultThreads-th page of |buffer| starting at page
+// |stripe|, pulling the backing file into the page cache. Striping spreads
+// the threads across the file so all of them contribute readahead from the
+// start of the load.
+void PrefaultBuffer(absl::Span<const uint8_t> buffer, int stripe) {
+  uint8_t sink = 0;
+  for (size_t offset = static_cast<size_t>(stripe) * kPageSize;
+       offset < buffer.size();
+       offset += static_cast<size_t>(kPrefaultThreads) * kPageSize) {
+    sink ^= buffer[offset];
+  }
+  // Keep the reads from being optimized away.
+  asm volatile("" : : "r"(sink));
+}
+
+// Returns the wall time elapsed since |start| in microseconds.
+uint64_t ElapsedMicros(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
 }  // namespace
 
 SgxEnclaveClient::~SgxEnclaveClient() = default;
@@ -147,13 +324,42 @@ StatusOr<std::shared_ptr<Client>> SgxBackend::Load(
     const absl::string_view enclave_name, void *base_address,
     absl::string_view enclave_path, size_t enclave_size,
     const EnclaveConfig &config, bool debug,
-    std::unique_ptr<Client::ExitCallProvider> exit_call_provider) {
+    std::unique_ptr<Client::ExitCallProvider> exit_call_provider,
+    bool map_enclave_binary, LaunchTokenCache *launch_token_cache) {
   std::shared_ptr<SgxEnclaveClient> client(
       new SgxEnclaveClient(enclave_name, std::move(exit_call_provider)));
   client->RegisterExitHandlers();
   client->base_address_ = base_address;
 
-  int updated;
+  // Seed the launch token from the cache when one is known for this binary;
+  // the in-memory creation path takes no token, so the cache only applies to
+  // path-based creation.
+  bool token_from_cache = false;
+  if (launch_token_cache && !map_enclave_binary) {
+    token_from_cache =
+        launch_token_cache->GetLaunchToken(enclave_path, &client->token_);
+  }
+
+  // When requested, map the enclave binary and walk the mapping with prefault
+  // threads while the enclave is created from the buffer, so the SDK's
+  // sequential page-add-and-measure loop consumes pages that are already in
+  // the page cache instead of stalling on file reads.
+  FileMapping enclave_mapping;
+  std::vector<Thread> prefault_threads;
+  const auto map_start = std::chrono::steady_clock::now();
+  if (map_enclave_binary) {
+    ASYLO_ASSIGN_OR_RETURN(enclave_mapping,
+                           FileMapping::CreateFromFile(enclave_path));
+    client->load_timings_.map_micros = ElapsedMicros(map_start);
+    absl::Span<const uint8_t> buffer = enclave_mapping.buffer();
+    prefault_threads.reserve(kPrefaultThreads);
+    for (int stripe = 0; stripe < kPrefaultThreads; ++stripe) {
+      prefault_threads.emplace_back(
+          [buffer, stripe] { PrefaultBuffer(buffer, stripe); });
+    }
+  }
+
+  int updated = 0;
   sgx_status_t status;
   const uint32_t ex_features = SGX_CREATE_ENCLAVE_EX_ASYLO;
   asylo_sgx_config_t create_config = {
@@ -162,10 +368,18 @@ StatusOr<std::shared_ptr<Client>> SgxBackend::Load(
       .enable_user_utility = config.enable_fork()};
   const void *ex_features_p[32] = {nullptr};
   ex_features_p[SGX_CREATE_ENCLAVE_EX_ASYLO_BIT_IDX] = &create_config;
+  const auto create_start = std::chrono::steady_clock::now();
   for (int i = 0; i < kMaxEnclaveCreateAttempts; ++i) {
-    status = sgx_create_enclave_ex(
-        std::string(enclave_path).c_str(), debug, &client->token_, &updated,
-        &client->id_, /*misc_attr=*/nullptr, ex_features, ex_features_p);
+    if (map_enclave_binary) {
+      status = sgx_create_enclave_from_buffer_ex(
+          enclave_mapping.buffer().data(), enclave_mapping.buffer().size(),
+          debug, &client->id_, /*misc_attr=*/nullptr, ex_features,
+          ex_features_p);
+    } else {
+      status = sgx_create_enclave_ex(
+          std::string(enclave_path).c_str(), debug, &client->token_, &updated,
+          &client->id_, /*misc_attr=*/nullptr, ex_features, ex_features_p);
+    }
 
     LOG_IF(WARNING, status != SGX_SUCCESS)
         << "Failed to create an enclave, attempt=" << i
@@ -174,12 +388,30 @@ StatusOr<std::shared_ptr<Client>> SgxBackend::Load(
       break;
     }
   }
+  if (map_enclave_binary) {
+    client->load_timings_.create_micros = ElapsedMicros(create_start);
+    for (Thread &thread : prefault_threads) {
+      thread.Join();
+    }
+    client->load_timings_.prefault_micros = ElapsedMicros(map_start) -
+                                            client->load_timings_.map_micros;
+    LOG(INFO) << "Mapped enclave load of " << enclave_path
+              << ": map=" << client->load_timings_.map_micros
+              << "us prefault=" << client->load_timings_.prefault_micros
+              << "us create=" << client->load_timings_.create_micros << "us";
+  }
 
   if (status != SGX_SUCCESS) {
     return Status(
         status, absl::StrCat("Failed to create an enclave for ", enclave_path));
   }
 
+  // Persist the negotiated token when the SDK minted or refreshed one.
+  if (launch_token_cache && !map_enclave_binary &&
+      (updated || !token_from_cache)) {
+    launch_token_cache->PutLaunchToken(enclave_path, client->token_);
+  }
+
   client->size_ = sgx_enclave_size(client->id_);
   client->is_destroyed_ = false;
   return client;
@@ -321,10 +553,18 @@ Status SgxEnclaveClient::EnclaveCallInternal(uint64_t selector,
       input->Serialize(const_cast<void *>(params.input));
     }
   }
+  InjectSimulatedEntryDelay(static_cast<size_t>(params.input_size));
   int retval = 0;
+  // The entry occupies a TCS from dispatch until return; the concurrency
+  // gauge around it is the live TCS pool occupancy.
+  CallMetrics::BeginEnclaveEntry();
   sgx_status_t status =
       ecall_dispatch_trusted_call(id_, &retval, selector, &params);
+  CallMetrics::EndEnclaveEntry();
   if (status != SGX_SUCCESS) {
+    if (status == SGX_ERROR_OUT_OF_TCS) {
+      CallMetrics::RecordOutOfTcs();
+    }
     // Return a Status object in the SGX error space.
     return Status(status, "Call to primitives ecall endpoint failed");
   }
@@ -332,11 +572,42 @@ Status SgxEnclaveClient::EnclaveCallInternal(uint64_t selector,
     return absl::InternalError("Enclave call failed inside enclave");
   }
   if (params.output) {
-    output->Deserialize(params.output, static_cast<size_t>(params.output_size));
+    // Charge the payload cost of moving the result back across the boundary;
+    // the entry cost itself was charged before the ecall.
+    if (sim_payload_cycles_per_page_ > 0) {
+      SpinForCycles(sim_payload_cycles_per_page_ *
+                    ((static_cast<size_t>(params.output_size) + kPageSize - 1) /
+                     kPageSize));
+    }
+    // Transfer the enclave-allocated result buffer to the reader instead of
+    // copying it; the extents handed to the caller alias the buffer directly.
+    output->DeserializeOwned(params.output,
+                             static_cast<size_t>(params.output_size), &free);
+    params.output = nullptr;
   }
   return Status::OkStatus();
 }
 
+void SgxEnclaveClient::SetSimulatedTransitionCosts(
+    uint64_t enclave_entry_cycles, uint64_t exit_call_cycles,
+    uint64_t payload_cycles_per_page) {
+  sim_enclave_entry_cycles_ = enclave_entry_cycles;
+  sim_exit_call_cycles_ = exit_call_cycles;
+  sim_payload_cycles_per_page_ = payload_cycles_per_page;
+}
+
+void SgxEnclaveClient::InjectSimulatedEntryDelay(size_t payload_bytes) const {
+  SpinForCycles(sim_enclave_entry_cycles_ +
+                sim_payload_cycles_per_page_ *
+                    ((payload_bytes + kPageSize - 1) / kPageSize));
+}
+
+void SgxEnclaveClient::InjectSimulatedExitDelay(size_t payload_bytes) const {
+  SpinForCycles(sim_exit_call_cycles_ +
+                sim_payload_cycles_per_page_ *
+                    ((payload_bytes + kPageSize - 1) / kPageSize));
+}
+
 int SgxEnclaveClient::EnterAndHandleSignal(int signum, int sigcode) {
   if (is_destroyed_) {
     return -1;
@@ -352,6 +623,16 @@ int SgxEnclaveClient::EnterAndHandleSignal(int signum, int sigcode) {
   return 0;
 }
 
+Status SgxEnclaveClient::GetEpcPagingStats(SgxEpcPagingStats *stats) const {
+  ASYLO_ASSIGN_OR_RETURN(stats->process_major_faults,
+                         ReadProcessMajorFaults());
+  uintptr_t base = reinterpret_cast<uintptr_t>(base_address_);
+  ASYLO_ASSIGN_OR_RETURN(stats->enclave_resident_bytes,
+                         ReadResidentBytesInRange(base, base + size_));
+  stats->enclave_size_bytes = size_;
+  return Status::OkStatus();
+}
+
 Status SgxEnclaveClient::EnterAndTakeSnapshot(SnapshotLayout *snapshot_layout) {
   char *output_buf = nullptr;
   size_t output_len = 0;
@@ -434,6 +715,81 @@ Status SgxEnclaveClient::EnterAndTransferSecureSnapshotKey(
   return status;
 }
 
+Status SgxEnclaveClient::EnterAndPrepareWarmStartSnapshot() {
+  char *output = nullptr;
+  size_t output_len = 0;
+
+  ScopedCurrentClient scoped_client(this);
+  ASYLO_RETURN_IF_ERROR(PrepareWarmStartSnapshot(id_, &output, &output_len));
+
+  // Enclave entry-point was successfully invoked. |output| is guaranteed to
+  // have a value.
+  StatusProto status_proto;
+  status_proto.ParseFromArray(output, output_len);
+  Status status = StatusFromProto(status_proto);
+
+  // |output| points to an untrusted memory buffer allocated by the enclave. It
+  // is the untrusted caller's responsibility to free this buffer.
+  free(output);
+
+  return status;
+}
+
+Status SgxEnclaveClient::EnterAndSealSnapshotKey(
+    std::string *serialized_sealed_secret) {
+  char *output_buf = nullptr;
+  size_t output_len = 0;
+
+  ScopedCurrentClient scoped_client(this);
+  ASYLO_RETURN_IF_ERROR(SealSnapshotKey(id_, &output_buf, &output_len));
+
+  // Enclave entry-point was successfully invoked. |output_buf| is guaranteed
+  // to have a value.
+  EnclaveOutput local_output;
+  local_output.ParseFromArray(output_buf, output_len);
+  Status status = StatusFromProto(local_output.status());
+
+  // |output_buf| points to an untrusted memory buffer allocated by the
+  // enclave. It is the untrusted caller's responsibility to free this buffer.
+  free(output_buf);
+
+  if (serialized_sealed_secret) {
+    *serialized_sealed_secret =
+        local_output.GetExtension(sealed_snapshot_key).sealed_secret();
+  }
+
+  return status;
+}
+
+Status SgxEnclaveClient::EnterAndRestoreSnapshotKey(
+    const std::string &serialized_sealed_secret) {
+  SealedSnapshotKey sealed_key;
+  sealed_key.set_sealed_secret(serialized_sealed_secret);
+  std::string buf;
+  if (!sealed_key.SerializeToString(&buf)) {
+    return absl::InvalidArgumentError("Failed to serialize SealedSnapshotKey");
+  }
+
+  char *output = nullptr;
+  size_t output_len = 0;
+
+  ScopedCurrentClient scoped_client(this);
+  ASYLO_RETURN_IF_ERROR(
+      RestoreSnapshotKey(id_, buf.data(), buf.size(), &output, &output_len));
+
+  // Enclave entry-point was successfully invoked. |output| is guaranteed to
+  // have a value.
+  StatusProto status_proto;
+  status_proto.ParseFromArray(output, output_len);
+  Status status = StatusFromProto(status_proto);
+
+  // |output| points to an untrusted memory buffer allocated by the enclave. It
+  // is the untrusted caller's responsibility to free this buffer.
+  free(output);
+
+  return status;
+}
+
 void SgxEnclaveClient::SetProcessId() { sgx_set_process_id(id_); }
 
 void SgxEnclaveClient::SetForkedEnclaveLoader(
@@ -20,11 +20,14 @@
 #define ASYLO_PLATFORM_PRIMITIVES_SGX_UNTRUSTED_SGX_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string>
 
 #include "absl/strings/string_view.h"
 #include "asylo/enclave.pb.h"  // IWYU pragma: export
 #include "asylo/platform/primitives/sgx/fork.pb.h"
+#include "asylo/platform/primitives/sgx/launch_token_cache.h"
 #include "asylo/platform/primitives/untrusted_primitives.h"
 #include "asylo/platform/primitives/util/message.h"
 #include "asylo/util/status.h"
@@ -43,12 +46,21 @@ typedef Client *(*forked_loader_callback_t)(absl::string_view enclave_name,
 // from the file system.
 struct SgxBackend {
   // Loads an SGX enclave and returns a client to the loaded enclave or an
-  // error status on failure.
+  // error status on failure. When |map_enclave_binary| is true the enclave
+  // file is mapped into memory and loaded through the in-memory creation
+  // path, with prefault threads walking the mapping in parallel with page
+  // addition so the page-add-and-measure loop never stalls on file reads;
+  // see SgxLoadConfig.FileEnclaveConfig.map_enclave_binary. A non-null
+  // |launch_token_cache| supplies and collects launch tokens for the enclave
+  // binary, skipping launch-token negotiation for binaries loaded before;
+  // see SgxLoadConfig.FileEnclaveConfig.launch_token_cache_directory.
   static StatusOr<std::shared_ptr<Client>> Load(
       const absl::string_view enclave_name, void *base_address,
       absl::string_view enclave_path, size_t enclave_size,
       const EnclaveConfig &config, bool debug,
-      std::unique_ptr<Client::ExitCallProvider> exit_call_provider);
+      std::unique_ptr<Client::ExitCallProvider> exit_call_provider,
+      bool map_enclave_binary = false,
+      LaunchTokenCache *launch_token_cache = nullptr);
 };
 
 // Implementation of the generic "EnclaveBackend" concept for Intel Software
@@ -64,6 +76,42 @@ struct SgxEmbeddedBackend {
       std::unique_ptr<Client::ExitCallProvider> exit_call_provider);
 };
 
+// A point-in-time sample of EPC (Enclave Page Cache) paging pressure signals
+// for one loaded enclave. When an enclave's working set exceeds EPC the kernel
+// driver evicts enclave pages, and touching an evicted page faults it back in
+// as a major fault on the enclave's address range. A rising
+// process_major_faults rate while enclave_resident_bytes falls below
+// enclave_size_bytes is the signature of the paging cliff; callers should
+// sample periodically and act on deltas between samples.
+struct SgxEpcPagingStats {
+  // Cumulative major page faults taken by this process, read from
+  // /proc/self/stat. Process-wide: the kernel exposes no per-VMA fault
+  // counter, so a host running several enclaves should correlate the fault
+  // rate with each enclave's resident share below.
+  uint64_t process_major_faults;
+
+  // Bytes of the enclave's virtual address range currently resident, summed
+  // over the enclave's mappings in /proc/self/smaps, and the total size of
+  // that range. Their ratio is the enclave's resident share.
+  uint64_t enclave_resident_bytes;
+  uint64_t enclave_size_bytes;
+};
+
+// Wall-clock durations of the load phases of a mapped enclave load, recorded
+// by SgxBackend::Load when map_enclave_binary is set. All values are zero for
+// loads that hand the SDK a file path.
+struct SgxLoadTimings {
+  // Time spent mapping the enclave binary into memory.
+  uint64_t map_micros = 0;
+
+  // Time until the prefault threads finished walking the mapping. Overlaps
+  // with create_micros, since the threads run while the enclave is created.
+  uint64_t prefault_micros = 0;
+
+  // Time spent in enclave creation (page addition, measurement and EINIT).
+  uint64_t create_micros = 0;
+};
+
 // SGX implementation of Client.
 class SgxEnclaveClient : public Client {
  public:
@@ -101,8 +149,50 @@ class SgxEnclaveClient : public Client {
   Status EnterAndTransferSecureSnapshotKey(
       const ForkHandshakeConfig &fork_handshake_config);
 
+  // Enters the enclave and requests a warm-start snapshot, permitting a
+  // subsequent EnterAndTakeSnapshot() without a fork() from inside the
+  // enclave.
+  Status EnterAndPrepareWarmStartSnapshot();
+
+  // Enters the enclave and seals the key of the most recent snapshot to the
+  // enclave's code identity. On success |serialized_sealed_secret| holds a
+  // serialized asylo.SealedSecret that a later process can hand back through
+  // EnterAndRestoreSnapshotKey() to restore the snapshot without a live
+  // parent enclave.
+  Status EnterAndSealSnapshotKey(std::string *serialized_sealed_secret);
+
+  // Enters the enclave and installs the snapshot key unsealed from
+  // |serialized_sealed_secret| for a subsequent EnterAndRestore().
+  Status EnterAndRestoreSnapshotKey(
+      const std::string &serialized_sealed_secret);
+
   int EnterAndHandleSignal(int signum, int sigcode);
 
+  // Samples EPC paging pressure counters for this enclave into |stats|.
+  // Cheap enough to poll periodically from a monitoring thread; reachable for
+  // a managed enclave via EnclaveManager::GetClient() and
+  // GenericEnclaveClient::GetPrimitiveClient(). Returns a non-OK status if
+  // the /proc interfaces cannot be read. Under the simulation backend the
+  // counters describe ordinary memory residency of the enclave range.
+  Status GetEpcPagingStats(SgxEpcPagingStats *stats) const;
+
+  // Configures simulation performance-parity delay injection. All values are
+  // cycle counts, zero meaning no delay: |enclave_entry_cycles| is charged per
+  // enclave entry and |exit_call_cycles| per exit call, each plus
+  // |payload_cycles_per_page| for every 4 KiB page of call payload crossing
+  // the boundary. Intended for clients loaded in simulation mode, where real
+  // transitions are nearly free; set from
+  // SgxLoadConfig.sim_performance_parity_config by the loader.
+  void SetSimulatedTransitionCosts(uint64_t enclave_entry_cycles,
+                                   uint64_t exit_call_cycles,
+                                   uint64_t payload_cycles_per_page);
+
+  // Busy-waits for the configured enclave entry or exit call cost plus the
+  // per-page payload cost for |payload_bytes|. No-ops when the corresponding
+  // cost is unset.
+  void InjectSimulatedEntryDelay(size_t payload_bytes) const;
+  void InjectSimulatedExitDelay(size_t payload_bytes) const;
+
   // Sets a new expected process ID for an existing SGX enclave.
   void SetProcessId();
 
@@ -114,6 +204,10 @@ class SgxEnclaveClient : public Client {
   // parent when fork() is called.
   static forked_loader_callback_t GetForkedEnclaveLoader();
 
+  // Returns the load-phase timings of this enclave's load. Nonzero only for
+  // loads performed with map_enclave_binary set.
+  const SgxLoadTimings &load_timings() const { return load_timings_; }
+
  protected:
   Status EnclaveCallInternal(uint64_t selector, MessageWriter *input,
                              MessageReader *output) override;
@@ -133,6 +227,14 @@ class SgxEnclaveClient : public Client {
   void *base_address_;              // Enclave base address.
   size_t size_;                     // Enclave size.
   bool is_destroyed_ = true;        // Whether enclave is destroyed.
+
+  // Load-phase timings; see load_timings().
+  SgxLoadTimings load_timings_;
+
+  // Simulation performance-parity costs; see SetSimulatedTransitionCosts().
+  uint64_t sim_enclave_entry_cycles_ = 0;
+  uint64_t sim_exit_call_cycles_ = 0;
+  uint64_t sim_payload_cycles_per_page_ = 0;
 };
 
 }  // namespace primitives
@@ -0,0 +1,165 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/sgx/warm_start.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "asylo/platform/common/memory.h"
+#include "asylo/platform/primitives/sgx/fork.pb.h"
+#include "asylo/platform/storage/utils/fd_closer.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+namespace primitives {
+namespace {
+
+// Returns pointers to every entry of |layout| in field order (data, bss,
+// heap, thread, stack), the order in which chunks are stored in a
+// WarmStartImage.
+std::vector<SnapshotLayoutEntry *> LayoutEntries(SnapshotLayout *layout) {
+  std::vector<SnapshotLayoutEntry *> entries;
+  for (auto *field :
+       {layout->mutable_data(), layout->mutable_bss(), layout->mutable_heap(),
+        layout->mutable_thread(), layout->mutable_stack()}) {
+    for (SnapshotLayoutEntry &entry : *field) {
+      entries.push_back(&entry);
+    }
+  }
+  return entries;
+}
+
+}  // namespace
+
+Status SaveWarmStartImage(SgxEnclaveClient *client, const std::string &path) {
+  ASYLO_RETURN_IF_ERROR(client->EnterAndPrepareWarmStartSnapshot());
+
+  SnapshotLayout layout;
+  ASYLO_RETURN_IF_ERROR(client->EnterAndTakeSnapshot(&layout));
+
+  // Sealing the key also unblocks the enclave entries that the snapshot
+  // blocked, so it must happen even if assembling the image fails below.
+  WarmStartImage image;
+  Status seal_status =
+      client->EnterAndSealSnapshotKey(image.mutable_sealed_snapshot_key());
+
+  // Copy each chunk (the nonce followed by the ciphertext) out of the
+  // snapshot buffers, and free the buffers: unlike fork, no child process
+  // inherits them.
+  for (SnapshotLayoutEntry *entry : LayoutEntries(&layout)) {
+    MallocUniquePtr<void> ciphertext_deleter(
+        reinterpret_cast<void *>(entry->ciphertext_base()));
+    MallocUniquePtr<void> nonce_deleter(
+        reinterpret_cast<void *>(entry->nonce_base()));
+    std::string *chunk = image.add_chunks();
+    chunk->reserve(entry->nonce_size() + entry->ciphertext_size());
+    chunk->append(reinterpret_cast<const char *>(entry->nonce_base()),
+                  entry->nonce_size());
+    chunk->append(reinterpret_cast<const char *>(entry->ciphertext_base()),
+                  entry->ciphertext_size());
+  }
+  ASYLO_RETURN_IF_ERROR(seal_status);
+
+  *image.mutable_layout() = layout;
+  image.set_enclave_base_address(
+      reinterpret_cast<uint64_t>(client->GetBaseAddress()));
+  image.set_enclave_size(client->GetEnclaveSize());
+
+  platform::storage::FdCloser fd(
+      open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR));
+  if (fd.get() < 0) {
+    return absl::InternalError(
+        absl::StrCat("Failed to open warm-start image file: ", path));
+  }
+  if (!image.SerializeToFileDescriptor(fd.get())) {
+    return absl::InternalError(
+        absl::StrCat("Failed to write warm-start image file: ", path));
+  }
+  return Status::OkStatus();
+}
+
+Status RestoreFromWarmStartImage(SgxEnclaveClient *client,
+                                 const std::string &path) {
+  platform::storage::FdCloser fd(open(path.c_str(), O_RDONLY));
+  if (fd.get() < 0) {
+    return absl::InternalError(
+        absl::StrCat("Failed to open warm-start image file: ", path));
+  }
+  WarmStartImage image;
+  if (!image.ParseFromFileDescriptor(fd.get())) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Failed to parse warm-start image file: ", path));
+  }
+
+  // The snapshot contains pointers into the enclave's address range, so it
+  // can only be restored into an enclave occupying the same range.
+  if (reinterpret_cast<uint64_t>(client->GetBaseAddress()) !=
+          image.enclave_base_address() ||
+      client->GetEnclaveSize() != image.enclave_size()) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "Enclave is not loaded at the address range of the warm-start image; "
+        "expected base address ",
+        image.enclave_base_address(), " and size ", image.enclave_size()));
+  }
+
+  ASYLO_RETURN_IF_ERROR(
+      client->EnterAndRestoreSnapshotKey(image.sealed_snapshot_key()));
+
+  // Load the chunks into freshly allocated untrusted buffers and point the
+  // layout at them. The buffers only need to live until the restore
+  // entry-point returns; the enclave copies the chunks in during the call.
+  SnapshotLayout layout = image.layout();
+  std::vector<SnapshotLayoutEntry *> entries = LayoutEntries(&layout);
+  if (image.chunks_size() != static_cast<int>(entries.size())) {
+    return absl::InvalidArgumentError(
+        "Warm-start image chunk count does not match its layout");
+  }
+  std::vector<MallocUniquePtr<void>> buffers;
+  buffers.reserve(entries.size());
+  for (int i = 0; i < static_cast<int>(entries.size()); ++i) {
+    SnapshotLayoutEntry *entry = entries[i];
+    const std::string &chunk = image.chunks(i);
+    if (chunk.size() != entry->nonce_size() + entry->ciphertext_size()) {
+      return absl::InvalidArgumentError(
+          "Warm-start image chunk size does not match its layout entry");
+    }
+    char *buffer = static_cast<char *>(malloc(chunk.size()));
+    if (!buffer) {
+      return absl::ResourceExhaustedError(
+          "Failed to allocate warm-start snapshot buffer");
+    }
+    buffers.emplace_back(buffer);
+    memcpy(buffer, chunk.data(), chunk.size());
+    entry->set_nonce_base(reinterpret_cast<uint64_t>(buffer));
+    entry->set_ciphertext_base(
+        reinterpret_cast<uint64_t>(buffer + entry->nonce_size()));
+  }
+
+  return client->EnterAndRestore(layout);
+}
+
+}  // namespace primitives
+}  // namespace asylo
@@ -0,0 +1,64 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_SGX_WARM_START_H_
+#define ASYLO_PLATFORM_PRIMITIVES_SGX_WARM_START_H_
+
+#include <string>
+
+#include "asylo/platform/primitives/sgx/untrusted_sgx.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+namespace primitives {
+
+// Warm-start images let an enclave that spends seconds in deterministic
+// initialization (authority setup, config parsing, allocator warmup) skip
+// that work on subsequent process starts. The host snapshots the
+// fully-initialized enclave once, using the fork snapshot machinery: the
+// snapshot is encrypted inside the enclave with a fresh key, and the key is
+// sealed to the enclave's code identity (MRENCLAVE) instead of being
+// transferred to a forked child. A later process loads the same enclave
+// binary, hands back the sealed key, and restores the image - a decrypt and
+// copy in place of the full initialization.
+//
+// Warm start shares the security posture of fork: it requires enable_fork in
+// the EnclaveConfig, and an image lets the host roll the enclave back to the
+// checkpointed state at will. It is therefore only suitable for enclaves
+// whose initialization is deterministic and holds no state whose rollback
+// matters. Only supported in the SGX hardware backend.
+
+// Snapshots |client|'s fully-initialized enclave and writes a warm-start
+// image to the file at |path|. The enclave must have been loaded with
+// enable_fork set, and no other thread may be inside the enclave while the
+// snapshot is taken. The enclave keeps running normally afterwards.
+Status SaveWarmStartImage(SgxEnclaveClient *client, const std::string &path);
+
+// Restores |client|'s enclave from the warm-start image at |path|. The
+// enclave must be the same binary, loaded with enable_fork at the base
+// address and size recorded in the image, and the restoring thread must be
+// the only one inside the enclave. On success the enclave's memory matches
+// the checkpointed state; on failure the enclave rejects further entries and
+// must be reloaded.
+Status RestoreFromWarmStartImage(SgxEnclaveClient *client,
+                                 const std::string &path);
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_SGX_WARM_START_H_
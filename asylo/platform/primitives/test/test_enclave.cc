@@ -196,6 +196,29 @@ PrimitiveStatus StressMallocs(void *context, MessageReader *in,
   return PrimitiveStatus::OkStatus();
 }
 
+// Message handler that returns immediately. Used by the transition cost
+// benchmarks to measure an empty enclave entry round trip.
+PrimitiveStatus Noop(void *context, MessageReader *in, MessageWriter *out) {
+  ASYLO_RETURN_IF_READER_NOT_EMPTY(*in);
+  return PrimitiveStatus::OkStatus();
+}
+
+// Message handler making the requested number of no-op exit calls. Used by
+// the transition cost benchmarks to measure an exit call round trip without
+// paying an enclave entry per measurement.
+PrimitiveStatus OcallLoop(void *context, MessageReader *in,
+                          MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 1);
+  const uint64_t count = in->next<uint64_t>();
+  for (uint64_t i = 0; i < count; ++i) {
+    MessageWriter empty_input;
+    MessageReader empty_output;
+    ASYLO_RETURN_IF_ERROR(TrustedPrimitives::UntrustedCall(
+        kUntrustedNoop, &empty_input, &empty_output));
+  }
+  return PrimitiveStatus::OkStatus();
+}
+
 PrimitiveStatus InsideOutsideTest(void *context, MessageReader *in,
                                   MessageWriter *out) {
   struct EnclaveMemoryLayout layout;
@@ -299,6 +322,12 @@ extern "C" PrimitiveStatus asylo_enclave_init() {
   ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
       asylo::primitives::kInsideOutsideTest,
       EntryHandler{asylo::primitives::InsideOutsideTest}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::primitives::kNoopSelector,
+      EntryHandler{asylo::primitives::Noop}));
+  ASYLO_RETURN_IF_ERROR(TrustedPrimitives::RegisterEntryHandler(
+      asylo::primitives::kOcallLoopSelector,
+      EntryHandler{asylo::primitives::OcallLoop}));
   return asylo::primitives::initialized
              ? PrimitiveStatus::OkStatus()
              : PrimitiveStatus{
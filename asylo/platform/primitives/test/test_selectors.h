@@ -36,6 +36,8 @@ constexpr uint64_t kAveragePerThreadSelector = kSelectorUser + 6;
 constexpr uint64_t kCopyMultipleParamsSelector = kSelectorUser + 7;
 constexpr uint64_t kStressMallocs = kSelectorUser + 8;
 constexpr uint64_t kInsideOutsideTest = kSelectorUser + 9;
+constexpr uint64_t kNoopSelector = kSelectorUser + 10;
+constexpr uint64_t kOcallLoopSelector = kSelectorUser + 11;
 
 // Entry point with no registered handler.
 constexpr uint64_t kNotRegisteredSelector = kSelectorUser + 100;
@@ -43,6 +45,7 @@ constexpr uint64_t kNotRegisteredSelector = kSelectorUser + 100;
 // Exit points registered by untrusted code.
 constexpr uint64_t kUntrustedInit = kSelectorUser + 1;
 constexpr uint64_t kUntrustedFibonacci = kSelectorUser + 2;
+constexpr uint64_t kUntrustedNoop = kSelectorUser + 3;
 
 }  // namespace primitives
 }  // namespace asylo
@@ -50,6 +50,15 @@ ssize_t enc_hardware_random(uint8_t *buf, size_t count);
 // enc_hardware_random.
 int enc_hardware_random_entropy();
 
+// Invalidates every thread's pool of pre-generated random bytes, forcing a
+// fresh hardware reseed on each thread's next enc_hardware_random call.
+// Called in a restored enclave after fork so the child never emits random
+// bytes that the parent pre-generated before the snapshot. Invalidation is by
+// generation tag rather than a direct flush because the pools are
+// thread-local and the restore path runs on a different TCS than the threads
+// that own them.
+void enc_invalidate_rand_pools();
+
 // Registers a signal handler on the host.
 int enc_register_signal(int signum, const sigset_t mask, int flags);
 
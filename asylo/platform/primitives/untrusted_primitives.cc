@@ -23,14 +23,17 @@
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "asylo/platform/primitives/extent.h"
 #include "asylo/platform/primitives/primitive_status.h"
 #include "asylo/platform/primitives/primitives.h"
+#include "asylo/platform/primitives/util/call_metrics.h"
 #include "asylo/platform/primitives/util/status_conversions.h"
 #include "asylo/util/asylo_macros.h"
 #include "asylo/util/status.h"
+#include "asylo/util/status_macros.h"
 #include "asylo/util/statusor.h"
 
 namespace asylo {
@@ -38,6 +41,16 @@ namespace primitives {
 
 thread_local Client *Client::current_client_ = nullptr;
 
+Status Client::ExitCallProvider::RegisterDirectExitHandler(
+    uint64_t untrusted_selector, DirectExitHandler handler) {
+  return RegisterExitHandler(
+      untrusted_selector,
+      ExitHandler{[handler](std::shared_ptr<Client> client, void *context,
+                            MessageReader *input, MessageWriter *output) {
+        return handler(input, output);
+      }});
+}
+
 Client::ScopedCurrentClient::~ScopedCurrentClient() {
   if (pid_ != getpid()) {
     // This is a process forked during an enclave entry, we should not restore
@@ -58,8 +71,62 @@ Status Client::EnclaveCall(uint64_t selector, MessageWriter *input,
     return absl::FailedPreconditionError(
         "Cannot make an enclave call to a closed enclave.");
   }
+  if (entry_quota_) {
+    ASYLO_RETURN_IF_ERROR(entry_quota_->Admit(EntryQuota::CallerTag()));
+  }
   ScopedCurrentClient scoped_client(this);
-  return EnclaveCallInternal(selector, input, output);
+  uint64_t start_nanos = CallMetrics::Start();
+  Status status = EnclaveCallInternal(selector, input, output);
+  CallMetrics::RecordEnclaveCall(selector, start_nanos);
+  return status;
+}
+
+Status Client::EnclaveCallBatch(
+    const std::vector<std::pair<uint64_t, MessageWriter *>> &calls,
+    std::vector<MessageReader> *outputs, std::vector<Status> *statuses) {
+  outputs->clear();
+  statuses->clear();
+  if (calls.empty()) {
+    return absl::OkStatus();
+  }
+
+  // Flatten the batch into pairs of extents: the call selector followed by
+  // the serialized form of the call's own MessageWriter.
+  MessageWriter input;
+  for (const auto &call : calls) {
+    input.Push<uint64_t>(call.first);
+    size_t payload_size = call.second ? call.second->MessageSize() : 0;
+    std::vector<char> payload(payload_size);
+    if (payload_size > 0) {
+      call.second->Serialize(payload.data());
+    }
+    input.PushByCopy(Extent{payload.data(), payload.size()});
+  }
+
+  MessageReader output;
+  ASYLO_RETURN_IF_ERROR(EnclaveCall(kSelectorAsyloBatchCall, &input, &output));
+
+  // Demultiplex per-call results: a status code and message followed by the
+  // serialized call outputs.
+  if (output.size() != 3 * calls.size()) {
+    return absl::InternalError(
+        "Malformed batch call response from the enclave.");
+  }
+  outputs->reserve(calls.size());
+  statuses->reserve(calls.size());
+  for (size_t i = 0; i < calls.size(); ++i) {
+    auto code = output.next<uint32_t>();
+    Extent message = output.next();
+    Extent payload = output.next();
+    statuses->push_back(MakeStatus(PrimitiveStatus(
+        code, reinterpret_cast<const char *>(message.data()),
+        message.size())));
+    outputs->emplace_back();
+    if (payload.size() > 0) {
+      outputs->back().Deserialize(payload.data(), payload.size());
+    }
+  }
+  return absl::OkStatus();
 }
 
 PrimitiveStatus Client::ExitCallback(uint64_t untrusted_selector,
@@ -68,9 +135,12 @@ PrimitiveStatus Client::ExitCallback(uint64_t untrusted_selector,
     return PrimitiveStatus{primitives::AbslStatusCode::kFailedPrecondition,
                            "Exit call provider not set yet"};
   }
-  return MakePrimitiveStatus(
+  uint64_t start_nanos = CallMetrics::Start();
+  PrimitiveStatus status = MakePrimitiveStatus(
       current_client_->exit_call_provider()->InvokeExitHandler(
           untrusted_selector, in, out, current_client_));
+  CallMetrics::RecordExitCall(untrusted_selector, start_nanos);
+  return status;
 }
 
 // This provides a default, no-op implementation if this function is not
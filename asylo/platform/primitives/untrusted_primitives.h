@@ -24,11 +24,13 @@
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "asylo/platform/primitives/extent.h"
 #include "asylo/platform/primitives/primitive_status.h"
 #include "asylo/platform/primitives/primitives.h"
+#include "asylo/platform/primitives/util/entry_quota.h"
 #include "asylo/platform/primitives/util/message.h"
 #include "asylo/util/asylo_macros.h"
 #include "asylo/util/mutex_guarded.h"
@@ -86,6 +88,13 @@ struct ExitHandler {
   void *context;
 };
 
+/// A plain-function exit handler for hot, stateless exit points. Direct
+/// handlers receive no client reference and no context pointer, which lets
+/// providers with a direct-dispatch fast path invoke them without
+/// constructing a std::function or taking a reference on the client.
+using DirectExitHandler = Status (*)(MessageReader *input,
+                                     MessageWriter *output);
+
 /// \class Client untrusted_primitives.h @untrusted_primitives
 /// A reference to an enclave held by untrusted code.
 ///
@@ -122,6 +131,25 @@ class Client : public std::enable_shared_from_this<Client> {
                                        const ExitHandler &handler)
         ASYLO_MUST_USE_RESULT = 0;
 
+    /// Registers a plain-function handler routine for an enclave exit point
+    /// `untrusted_selector`. Intended for the hottest exit points, whose
+    /// handlers use neither the client nor a context pointer: providers with
+    /// a direct-dispatch fast path invoke direct handlers without the
+    /// per-call overhead of the generic handler representation. The default
+    /// implementation wraps the handler and registers it through
+    /// RegisterExitHandler(), so providers without a fast path behave
+    /// identically.
+    ///
+    /// \param untrusted_selector The identification number an enclave will use
+    ///    to select the registered handler, `handler`.
+    /// \param handler The plain handler function.
+    /// \returns If a handler has already been registered for
+    /// `untrusted_selector` or if an invalid selector value is passed, returns
+    /// an error status, otherwise Ok.
+    virtual Status RegisterDirectExitHandler(uint64_t untrusted_selector,
+                                             DirectExitHandler handler)
+        ASYLO_MUST_USE_RESULT;
+
     /// Finds and invokes an exit handler.
     ///
     /// \param untrusted_selector The identification number for the called
@@ -218,6 +246,26 @@ class Client : public std::enable_shared_from_this<Client> {
   Status EnclaveCall(uint64_t selector, MessageWriter *input,
                      MessageReader *output) ASYLO_MUST_USE_RESULT;
 
+  /// Enters the enclave once and executes several calls back-to-back,
+  /// amortizing the cost of the enclave transition across the batch.
+  ///
+  /// The calls execute sequentially in the order given. Failure of one call
+  /// does not prevent the execution of subsequent calls; each call's own
+  /// result is reported through `statuses`.
+  ///
+  /// \param calls A vector of (selector, input MessageWriter) pairs, one per
+  ///    call. The writers must remain valid for the duration of the batch.
+  /// \param outputs A pointer to a vector populated with one MessageReader of
+  ///    call results per call, in call order.
+  /// \param statuses A pointer to a vector populated with the per-call
+  ///    statuses, in call order.
+  /// \returns A status for the batch transition itself; per-call failures are
+  ///    reported in `statuses` instead.
+  Status EnclaveCallBatch(
+      const std::vector<std::pair<uint64_t, MessageWriter *>> &calls,
+      std::vector<MessageReader> *outputs,
+      std::vector<Status> *statuses) ASYLO_MUST_USE_RESULT;
+
   /// Enclave exit callback function shared with the enclave.
   ///
   /// \param untrusted_selector The identification number to select a registered
@@ -235,6 +283,26 @@ class Client : public std::enable_shared_from_this<Client> {
   /// \returns A mutable pointer to the client's ExitCallProvider.
   ExitCallProvider *exit_call_provider() { return exit_call_provider_.get(); }
 
+  /// Installs per-caller-tag admission control in front of EnclaveCall().
+  ///
+  /// Once installed, every enclave call is admitted through `entry_quota`
+  /// under the calling thread's EntryQuota caller tag, so one tenant of a
+  /// shared enclave cannot monopolize the entry layer. Calls the quota sheds
+  /// fail with a ResourceExhausted status without entering the enclave. Must
+  /// not be called concurrently with enclave calls.
+  ///
+  /// \param entry_quota The quota the client takes ownership of, or nullptr
+  ///    to remove admission control.
+  void SetEntryQuota(std::unique_ptr<EntryQuota> entry_quota) {
+    entry_quota_ = std::move(entry_quota);
+  }
+
+  /// Accessor to the client's entry quota.
+  ///
+  /// \returns A mutable pointer to the installed EntryQuota, or nullptr if
+  ///    none is installed.
+  EntryQuota *entry_quota() { return entry_quota_.get(); }
+
   /// Register memory to be freed upon enclave destruction.
   ///
   /// \param mem A pointer to be passed to free on enclave exit.
@@ -287,6 +355,9 @@ class Client : public std::enable_shared_from_this<Client> {
   // Can be set by EnclaveCall, enclave loader.
   static thread_local Client *current_client_;
 
+  // Per-caller-tag admission control, or null when none is installed.
+  std::unique_ptr<EntryQuota> entry_quota_;
+
   // Enclave name.
   absl::string_view name_;
 
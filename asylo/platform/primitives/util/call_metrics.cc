@@ -0,0 +1,93 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/call_metrics.h"
+
+#include <time.h>
+
+namespace asylo {
+namespace primitives {
+
+std::atomic<bool> CallMetrics::enabled_{false};
+CallMetrics::Block CallMetrics::block_;
+
+uint64_t CallMetrics::MonotonicNanos() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+void CallMetrics::Record(SelectorCounters *table, uint64_t selector,
+                         uint64_t nanos) {
+  SelectorCounters &counters =
+      table[selector < kMaxTrackedSelectors ? selector : kMaxTrackedSelectors];
+  counters.count.fetch_add(1, std::memory_order_relaxed);
+  counters.total_nanos.fetch_add(nanos, std::memory_order_relaxed);
+  size_t bucket = 0;
+  while (bucket + 1 < kNumLatencyBuckets && (nanos >> (bucket + 1)) != 0) {
+    ++bucket;
+  }
+  counters.latency_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void CallMetrics::BeginEnclaveEntry() {
+  ConcurrencyCounters &gauge = block_.entry_concurrency;
+  gauge.total.fetch_add(1, std::memory_order_relaxed);
+  uint64_t active = gauge.active.fetch_add(1, std::memory_order_relaxed) + 1;
+  uint64_t peak = gauge.peak_active.load(std::memory_order_relaxed);
+  while (active > peak && !gauge.peak_active.compare_exchange_weak(
+                              peak, active, std::memory_order_relaxed)) {
+  }
+}
+
+CallMetrics::ConcurrencySnapshot CallMetrics::SnapshotConcurrency() {
+  const ConcurrencyCounters &gauge = block_.entry_concurrency;
+  ConcurrencySnapshot snapshot;
+  snapshot.active = gauge.active.load(std::memory_order_relaxed);
+  snapshot.peak_active = gauge.peak_active.load(std::memory_order_relaxed);
+  snapshot.total = gauge.total.load(std::memory_order_relaxed);
+  snapshot.out_of_tcs = gauge.out_of_tcs.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+std::vector<CallMetrics::SelectorSnapshot> CallMetrics::Snapshot(
+    bool exit_calls) {
+  const SelectorCounters *table =
+      exit_calls ? block_.exit_calls : block_.enclave_calls;
+  std::vector<SelectorSnapshot> result;
+  for (size_t i = 0; i <= kMaxTrackedSelectors; ++i) {
+    uint64_t count = table[i].count.load(std::memory_order_relaxed);
+    if (count == 0) {
+      continue;
+    }
+    SelectorSnapshot snapshot;
+    snapshot.selector = i;
+    snapshot.count = count;
+    snapshot.total_nanos =
+        table[i].total_nanos.load(std::memory_order_relaxed);
+    for (size_t b = 0; b < kNumLatencyBuckets; ++b) {
+      snapshot.latency_buckets[b] =
+          table[i].latency_buckets[b].load(std::memory_order_relaxed);
+    }
+    result.push_back(snapshot);
+  }
+  return result;
+}
+
+}  // namespace primitives
+}  // namespace asylo
@@ -0,0 +1,161 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_CALL_METRICS_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_CALL_METRICS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace asylo {
+namespace primitives {
+
+// Low-overhead instrumentation of enclave entry and exit calls.
+//
+// When enabled, Client::EnclaveCall() and Client::ExitCallback() record an
+// invocation count and a power-of-two latency histogram per selector into a
+// statically allocated block of relaxed atomics. The hot-path cost is one
+// branch when disabled, and a timestamp pair plus three relaxed atomic
+// increments when enabled — cheap enough to leave on in production, unlike
+// the per-call logging of ExitLogHook.
+//
+// The metrics block is a contiguous POD region (see block()) so external
+// collectors can map or copy it wholesale; Snapshot() provides an in-process
+// view that reads the counters without locking or disturbing recording
+// threads.
+class CallMetrics {
+ public:
+  // Number of selectors tracked individually. Calls with selectors at or
+  // above this bound are accumulated in the final overflow slot.
+  static constexpr size_t kMaxTrackedSelectors = 512;
+
+  // Number of power-of-two latency buckets; bucket i counts calls with
+  // latency in [2^i, 2^(i+1)) nanoseconds.
+  static constexpr size_t kNumLatencyBuckets = 32;
+
+  // Per-selector counters. All fields are updated with relaxed atomics and
+  // may be torn relative to one another in a snapshot; they are monotonally
+  // increasing, so successive snapshots can be differenced safely.
+  struct SelectorCounters {
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> total_nanos;
+    std::atomic<uint64_t> latency_buckets[kNumLatencyBuckets];
+  };
+
+  // Entry concurrency gauge. Each enclave entry occupies one TCS for its
+  // duration, so |active| is the instantaneous TCS pool occupancy and
+  // |peak_active| its high-water mark; |out_of_tcs| counts entries the SGX
+  // runtime rejected because the pool was exhausted. Unlike latency
+  // recording, the gauge is maintained regardless of SetEnabled(): toggling
+  // recording around an in-flight entry must not skew it, and two relaxed
+  // increments are noise next to the transition itself.
+  struct ConcurrencyCounters {
+    std::atomic<uint64_t> active;
+    std::atomic<uint64_t> peak_active;
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> out_of_tcs;
+  };
+
+  // The shared metrics block: enclave entry calls and exit calls are
+  // tracked in separate selector tables.
+  struct Block {
+    SelectorCounters enclave_calls[kMaxTrackedSelectors + 1];
+    SelectorCounters exit_calls[kMaxTrackedSelectors + 1];
+    ConcurrencyCounters entry_concurrency;
+  };
+
+  // A plain-value copy of one selector's counters.
+  struct SelectorSnapshot {
+    uint64_t selector;
+    uint64_t count;
+    uint64_t total_nanos;
+    uint64_t latency_buckets[kNumLatencyBuckets];
+  };
+
+  // Enables or disables recording. Recording is disabled at startup.
+  static void SetEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  // Returns true if recording is enabled.
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  // Returns the current monotonic time in nanoseconds, or 0 when recording
+  // is disabled. Callers pass the value to the matching Record function.
+  static uint64_t Start() { return enabled() ? MonotonicNanos() : 0; }
+
+  // Records one enclave entry call for |selector| started at |start_nanos|.
+  // A zero |start_nanos| (recording disabled at call start) is ignored.
+  static void RecordEnclaveCall(uint64_t selector, uint64_t start_nanos) {
+    if (start_nanos != 0) {
+      Record(block_.enclave_calls, selector, MonotonicNanos() - start_nanos);
+    }
+  }
+
+  // Records one exit call for |selector| started at |start_nanos|.
+  static void RecordExitCall(uint64_t selector, uint64_t start_nanos) {
+    if (start_nanos != 0) {
+      Record(block_.exit_calls, selector, MonotonicNanos() - start_nanos);
+    }
+  }
+
+  // Marks one enclave entry in flight; pair with EndEnclaveEntry() when the
+  // entry returns.
+  static void BeginEnclaveEntry();
+  static void EndEnclaveEntry() {
+    block_.entry_concurrency.active.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // Records one entry rejected by the SGX runtime for lack of a free TCS.
+  static void RecordOutOfTcs() {
+    block_.entry_concurrency.out_of_tcs.fetch_add(1,
+                                                  std::memory_order_relaxed);
+  }
+
+  // A plain-value copy of the entry concurrency gauge.
+  struct ConcurrencySnapshot {
+    uint64_t active;
+    uint64_t peak_active;
+    uint64_t total;
+    uint64_t out_of_tcs;
+  };
+  static ConcurrencySnapshot SnapshotConcurrency();
+
+  // Returns the raw metrics block.
+  static const Block *block() { return &block_; }
+
+  // Returns copies of the counters for all selectors with a nonzero count.
+  // |exit_calls| selects the exit-call table over the enclave-call table.
+  static std::vector<SelectorSnapshot> Snapshot(bool exit_calls);
+
+ private:
+  static uint64_t MonotonicNanos();
+
+  static void Record(SelectorCounters *table, uint64_t selector,
+                     uint64_t nanos);
+
+  static std::atomic<bool> enabled_;
+  static Block block_;
+};
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_CALL_METRICS_H_
@@ -0,0 +1,101 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/call_metrics.h"
+
+#include <gtest/gtest.h>
+
+namespace asylo {
+namespace primitives {
+namespace {
+
+TEST(CallMetricsTest, DisabledRecordsNothing) {
+  CallMetrics::SetEnabled(false);
+  uint64_t start = CallMetrics::Start();
+  EXPECT_EQ(start, 0);
+  CallMetrics::RecordEnclaveCall(/*selector=*/1, start);
+  for (const auto &snapshot : CallMetrics::Snapshot(/*exit_calls=*/false)) {
+    EXPECT_NE(snapshot.selector, 1);
+  }
+}
+
+TEST(CallMetricsTest, RecordsCountsAndLatency) {
+  CallMetrics::SetEnabled(true);
+  uint64_t start = CallMetrics::Start();
+  ASSERT_NE(start, 0);
+  CallMetrics::RecordEnclaveCall(/*selector=*/7, start);
+  CallMetrics::RecordEnclaveCall(/*selector=*/7, CallMetrics::Start());
+  CallMetrics::SetEnabled(false);
+
+  bool found = false;
+  for (const auto &snapshot : CallMetrics::Snapshot(/*exit_calls=*/false)) {
+    if (snapshot.selector != 7) {
+      continue;
+    }
+    found = true;
+    EXPECT_EQ(snapshot.count, 2);
+    uint64_t bucketed = 0;
+    for (uint64_t bucket_count : snapshot.latency_buckets) {
+      bucketed += bucket_count;
+    }
+    EXPECT_EQ(bucketed, snapshot.count);
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST(CallMetricsTest, ConcurrencyGaugeTracksEntriesAndPeak) {
+  const auto before = CallMetrics::SnapshotConcurrency();
+  CallMetrics::BeginEnclaveEntry();
+  CallMetrics::BeginEnclaveEntry();
+  const auto during = CallMetrics::SnapshotConcurrency();
+  EXPECT_EQ(during.active, before.active + 2);
+  EXPECT_GE(during.peak_active, before.active + 2);
+  EXPECT_EQ(during.total, before.total + 2);
+
+  CallMetrics::EndEnclaveEntry();
+  CallMetrics::EndEnclaveEntry();
+  const auto after = CallMetrics::SnapshotConcurrency();
+  EXPECT_EQ(after.active, before.active);
+  EXPECT_EQ(after.peak_active, during.peak_active);
+
+  CallMetrics::RecordOutOfTcs();
+  EXPECT_EQ(CallMetrics::SnapshotConcurrency().out_of_tcs,
+            after.out_of_tcs + 1);
+}
+
+TEST(CallMetricsTest, OverflowSelectorsShareSlot) {
+  CallMetrics::SetEnabled(true);
+  CallMetrics::RecordExitCall(CallMetrics::kMaxTrackedSelectors + 100,
+                              CallMetrics::Start());
+  CallMetrics::RecordExitCall(CallMetrics::kMaxTrackedSelectors + 200,
+                              CallMetrics::Start());
+  CallMetrics::SetEnabled(false);
+
+  bool found = false;
+  for (const auto &snapshot : CallMetrics::Snapshot(/*exit_calls=*/true)) {
+    if (snapshot.selector == CallMetrics::kMaxTrackedSelectors) {
+      found = true;
+      EXPECT_GE(snapshot.count, 2);
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+}  // namespace
+}  // namespace primitives
+}  // namespace asylo
@@ -29,8 +29,27 @@
 namespace asylo {
 namespace primitives {
 
+Status DispatchTable::InstallDirectSlot(uint64_t untrusted_selector,
+                                        const ExitHandler &handler) {
+  // Publish the handler with a compare-and-swap so that concurrent
+  // registrations of the same selector cannot both succeed.
+  auto *new_handler = new ExitHandler(handler);
+  const ExitHandler *expected = nullptr;
+  if (!direct_table_[untrusted_selector].compare_exchange_strong(
+          expected, new_handler, std::memory_order_release,
+          std::memory_order_relaxed)) {
+    delete new_handler;
+    return absl::AlreadyExistsError("Invalid selector in RegisterExitHandler.");
+  }
+  return Status::OkStatus();
+}
+
 Status DispatchTable::RegisterExitHandler(uint64_t untrusted_selector,
                                           const ExitHandler &handler) {
+  if (untrusted_selector < kDirectTableSize) {
+    return InstallDirectSlot(untrusted_selector, handler);
+  }
+
   // Ensure no handler is installed for untrusted_selector.
   auto locked_exit_table = exit_table_.Lock();
   if (locked_exit_table->count(untrusted_selector)) {
@@ -40,6 +59,28 @@ Status DispatchTable::RegisterExitHandler(uint64_t untrusted_selector,
   return Status::OkStatus();
 }
 
+Status DispatchTable::RegisterDirectExitHandler(uint64_t untrusted_selector,
+                                                DirectExitHandler handler) {
+  if (untrusted_selector >= kDirectTableSize) {
+    // Selectors beyond the direct table have no fast path; fall back to the
+    // base implementation, which wraps the handler in the generic
+    // representation.
+    return ExitCallProvider::RegisterDirectExitHandler(untrusted_selector,
+                                                       handler);
+  }
+  // The generic slot stays authoritative for duplicate detection and serves
+  // dispatchers that observe it before the function pointer is published.
+  ASYLO_RETURN_IF_ERROR(InstallDirectSlot(
+      untrusted_selector,
+      ExitHandler{[handler](std::shared_ptr<Client> client, void *context,
+                            MessageReader *input, MessageWriter *output) {
+        return handler(input, output);
+      }}));
+  direct_fn_table_[untrusted_selector].store(handler,
+                                             std::memory_order_release);
+  return Status::OkStatus();
+}
+
 Status DispatchTable::PerformUnknownExit(uint64_t untrusted_selector,
                                          MessageReader *input,
                                          MessageWriter *output,
@@ -50,6 +91,25 @@ Status DispatchTable::PerformUnknownExit(uint64_t untrusted_selector,
 Status DispatchTable::PerformExit(uint64_t untrusted_selector,
                                   MessageReader *input, MessageWriter *output,
                                   Client *client) {
+  // Hot path: selectors in the direct table dispatch with a single atomic
+  // load and no lock acquisition.
+  if (untrusted_selector < kDirectTableSize) {
+    // Hottest path: plain-function handlers additionally skip the
+    // std::function invocation and the reference count on the client.
+    DirectExitHandler direct_handler =
+        direct_fn_table_[untrusted_selector].load(std::memory_order_acquire);
+    if (direct_handler) {
+      return direct_handler(input, output);
+    }
+    const ExitHandler *handler =
+        direct_table_[untrusted_selector].load(std::memory_order_acquire);
+    if (!handler) {
+      return PerformUnknownExit(untrusted_selector, input, output, client);
+    }
+    return handler->callback(client->shared_from_this(), handler->context,
+                             input, output);
+  }
+
   absl::optional<ExitHandler> handler;
   {
     auto locked_exit_table = exit_table_.ReaderLock();
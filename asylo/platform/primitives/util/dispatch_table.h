@@ -19,6 +19,8 @@
 #ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_DISPATCH_TABLE_H_
 #define ASYLO_PLATFORM_PRIMITIVES_UTIL_DISPATCH_TABLE_H_
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 
 #include "asylo/platform/primitives/untrusted_primitives.h"
@@ -72,6 +74,12 @@ class DispatchTable : public Client::ExitCallProvider {
       : exit_table_(std::unordered_map<uint64_t, ExitHandler>()),
         exit_hook_factory_(std::move(exit_hook_factory)) {}
 
+  ~DispatchTable() override {
+    for (auto &slot : direct_table_) {
+      delete slot.load(std::memory_order_acquire);
+    }
+  }
+
   // Registers a callback as the handler routine for an enclave exit point
   // `untrusted_selector`. Returns an error code if a handler has already been
   // registered for `trusted_selector` or if an invalid selector value is
@@ -79,6 +87,13 @@ class DispatchTable : public Client::ExitCallProvider {
   Status RegisterExitHandler(uint64_t untrusted_selector,
                              const ExitHandler &handler) override;
 
+  // Registers a plain-function handler for `untrusted_selector`. Selectors
+  // below kDirectTableSize dispatch to direct handlers with a single atomic
+  // load and a plain function call: no lock, no std::function invocation and
+  // no reference taken on the client.
+  Status RegisterDirectExitHandler(uint64_t untrusted_selector,
+                                   DirectExitHandler handler) override;
+
   // Finds and invokes an exit handler, setting an error status on failure.
   Status InvokeExitHandler(uint64_t untrusted_selector, MessageReader *input,
                            MessageWriter *output,
@@ -96,6 +111,31 @@ class DispatchTable : public Client::ExitCallProvider {
                                     MessageReader *input, MessageWriter *output,
                                     Client *client);
 
+  // Number of selectors dispatched through the lock-free direct table. The
+  // runtime and host-call selectors, which dominate exit traffic, all fall in
+  // this range; selectors past the end use the mutex-guarded map.
+  static constexpr size_t kDirectTableSize = 512;
+
+  // Installs `handler` in the direct-table slot for `untrusted_selector`,
+  // failing if the slot is already populated. The caller must have checked
+  // that the selector is below kDirectTableSize.
+  Status InstallDirectSlot(uint64_t untrusted_selector,
+                           const ExitHandler &handler);
+
+  // Lock-free dispatch slots for selectors below kDirectTableSize. Slots are
+  // populated at most once with a heap-allocated handler owned by the table;
+  // handlers are never replaced or removed, so dispatching threads can read
+  // the slot with a bare atomic load and no reference counting.
+  std::array<std::atomic<const ExitHandler *>, kDirectTableSize> direct_table_ =
+      {};
+
+  // Plain-function handlers for selectors below kDirectTableSize, populated
+  // by RegisterDirectExitHandler(). A non-null entry shadows the
+  // corresponding direct_table_ slot, which stays authoritative for duplicate
+  // detection and holds a wrapped fallback copy of the handler.
+  std::array<std::atomic<DirectExitHandler>, kDirectTableSize>
+      direct_fn_table_ = {};
+
   // DispatchTable is used in trusted primitives layer where system calls might
   // not be available; avoid using absl based containers which may perform
   // system calls.
@@ -111,6 +111,41 @@ TEST(DispatchTableTest, HandlersInvocation) {
               StatusIs(absl::StatusCode::kOutOfRange));
 }
 
+int direct_handler_calls = 0;
+
+Status TestDirectHandler(MessageReader *in, MessageWriter *out) {
+  ++direct_handler_calls;
+  return Status::OkStatus();
+}
+
+TEST(DispatchTableTest, DirectHandlersRegistrationAndInvocation) {
+  const auto client = std::make_shared<MockedEnclaveClient>();
+  MockedEnclaveClient::MockExitHandlerCallback callback;
+  direct_handler_calls = 0;
+  ASSERT_THAT(client->exit_call_provider()->RegisterDirectExitHandler(
+                  5, TestDirectHandler),
+              IsOk());
+  // The direct slot conflicts with generic and direct registrations alike.
+  ASSERT_THAT(client->exit_call_provider()->RegisterExitHandler(
+                  5, ExitHandler{callback.AsStdFunction()}),
+              StatusIs(absl::StatusCode::kAlreadyExists));
+  ASSERT_THAT(client->exit_call_provider()->RegisterDirectExitHandler(
+                  5, TestDirectHandler),
+              StatusIs(absl::StatusCode::kAlreadyExists));
+  // Selectors beyond the direct table fall back to a wrapped registration.
+  ASSERT_THAT(client->exit_call_provider()->RegisterDirectExitHandler(
+                  1000, TestDirectHandler),
+              IsOk());
+  MessageWriter out;
+  EXPECT_THAT(client->exit_call_provider()->InvokeExitHandler(5, nullptr, &out,
+                                                              client.get()),
+              IsOk());
+  EXPECT_THAT(client->exit_call_provider()->InvokeExitHandler(
+                  1000, nullptr, &out, client.get()),
+              IsOk());
+  EXPECT_THAT(direct_handler_calls, Eq(2));
+}
+
 TEST(DispatchTableTest, HandlersInMultipleThreads) {
   const size_t kThreads = 64;
   const size_t kCount = 256;
@@ -0,0 +1,198 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/entry_quota.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+
+namespace asylo {
+namespace primitives {
+namespace {
+
+// The calling thread's caller tag.
+thread_local std::string caller_tag;  // NOLINT(runtime/string)
+
+}  // namespace
+
+EntryQuota::ScopedCallerTag::ScopedCallerTag(absl::string_view tag)
+    : saved_tag_(std::move(caller_tag)) {
+  caller_tag = std::string(tag);
+}
+
+EntryQuota::ScopedCallerTag::~ScopedCallerTag() {
+  caller_tag = std::move(saved_tag_);
+}
+
+absl::string_view EntryQuota::CallerTag() { return caller_tag; }
+
+void EntryQuota::SetTagPolicy(absl::string_view tag, const TagPolicy &policy) {
+  absl::MutexLock lock(&mu_);
+  Tag &state = tags_[std::string(tag)];
+  state.policy = policy;
+  state.tokens = policy.burst;
+  state.last_refill = absl::Now();
+}
+
+Status EntryQuota::Admit(absl::string_view tag) {
+  absl::MutexLock lock(&mu_);
+  Tag &state = GetTagLocked(tag);
+  const bool tag_limited = state.policy.entries_per_second > 0.0;
+  const bool total_limited = options_.total_entries_per_second > 0.0;
+  absl::Time now = absl::Now();
+  RefillLocked(&state, now);
+
+  // Fast path: nothing limits this call, or tokens in hand with nobody
+  // queued ahead.
+  if (!tag_limited && !total_limited) {
+    ++state.stats.admitted;
+    return absl::OkStatus();
+  }
+  if (waiters_.empty() && CanAdmitLocked(state)) {
+    ConsumeLocked(&state);
+    ++state.stats.admitted;
+    return absl::OkStatus();
+  }
+
+  if (waiters_.size() >= options_.max_queued_calls) {
+    ++state.stats.shed;
+    return absl::ResourceExhaustedError(
+        absl::StrCat("Enclave entry queue is full; shedding call for tag \"",
+                     tag, "\""));
+  }
+
+  // Queue behind the tag's previous call at a virtual finish time that
+  // spaces the tag's calls inversely to its weight: lighter tags finish
+  // later and are admitted less often under contention.
+  const double weight = std::max<uint32_t>(state.policy.weight, 1);
+  state.virtual_finish =
+      std::max(virtual_time_, state.virtual_finish) + 1.0 / weight;
+  const WaiterKey key(state.virtual_finish, next_sequence_++);
+  waiters_.insert(key);
+  ++state.stats.delayed;
+
+  const absl::Time deadline = now + options_.max_queue_delay;
+  while (true) {
+    now = absl::Now();
+    RefillLocked(&state, now);
+    if (*waiters_.begin() == key && CanAdmitLocked(state)) {
+      waiters_.erase(key);
+      ConsumeLocked(&state);
+      virtual_time_ = std::max(virtual_time_, key.first);
+      ++state.stats.admitted;
+      return absl::OkStatus();
+    }
+    if (now >= deadline) {
+      waiters_.erase(key);
+      ++state.stats.shed;
+      return absl::ResourceExhaustedError(
+          absl::StrCat("Enclave entry for tag \"", tag, "\" queued longer ",
+                       "than the quota's maximum delay; shedding call"));
+    }
+    const WaiterKey *key_ptr = &key;
+    const std::set<WaiterKey> *waiters = &waiters_;
+    if (*waiters_.begin() == key) {
+      // Head of the queue: sleep until this call is due its tokens, unless a
+      // smaller-virtual-finish call overtakes the head in the meantime. The
+      // wait must not hold the queue head awake: competing calls need the
+      // lock to take their place in line.
+      double wait_seconds = 0.0;
+      if (tag_limited && state.tokens < 1.0) {
+        wait_seconds = std::max(
+            wait_seconds,
+            (1.0 - state.tokens) / state.policy.entries_per_second);
+      }
+      if (total_limited && total_tokens_ < 1.0) {
+        wait_seconds =
+            std::max(wait_seconds,
+                     (1.0 - total_tokens_) / options_.total_entries_per_second);
+      }
+      const absl::Time wake = std::min(deadline, now + absl::Seconds(wait_seconds));
+      const auto overtaken = [key_ptr, waiters] {
+        return *waiters->begin() != *key_ptr;
+      };
+      mu_.AwaitWithTimeout(absl::Condition(&overtaken), wake - now);
+    } else {
+      // Behind other calls: sleep until this call reaches the head or its
+      // deadline passes.
+      const auto is_front = [key_ptr, waiters] {
+        return *waiters->begin() == *key_ptr;
+      };
+      mu_.AwaitWithTimeout(absl::Condition(&is_front), deadline - now);
+    }
+  }
+}
+
+EntryQuota::TagStats EntryQuota::GetStats(absl::string_view tag) const {
+  absl::MutexLock lock(&mu_);
+  auto it = tags_.find(tag);
+  return it != tags_.end() ? it->second.stats : TagStats();
+}
+
+EntryQuota::Tag &EntryQuota::GetTagLocked(absl::string_view tag) {
+  auto it = tags_.find(tag);
+  if (it != tags_.end()) {
+    return it->second;
+  }
+  Tag &state = tags_[std::string(tag)];
+  state.policy = options_.default_policy;
+  state.tokens = state.policy.burst;
+  state.last_refill = absl::Now();
+  return state;
+}
+
+void EntryQuota::RefillLocked(Tag *tag, absl::Time now) {
+  if (tag->policy.entries_per_second > 0.0 && now > tag->last_refill) {
+    const double elapsed = absl::ToDoubleSeconds(now - tag->last_refill);
+    tag->tokens =
+        std::min(tag->policy.burst,
+                 tag->tokens + elapsed * tag->policy.entries_per_second);
+    tag->last_refill = now;
+  }
+  if (options_.total_entries_per_second > 0.0 && now > total_last_refill_) {
+    if (total_last_refill_ == absl::InfinitePast()) {
+      total_last_refill_ = now;
+    }
+    const double elapsed = absl::ToDoubleSeconds(now - total_last_refill_);
+    total_tokens_ =
+        std::min(options_.total_burst,
+                 total_tokens_ + elapsed * options_.total_entries_per_second);
+    total_last_refill_ = now;
+  }
+}
+
+bool EntryQuota::CanAdmitLocked(const Tag &tag) const {
+  return (tag.policy.entries_per_second <= 0.0 || tag.tokens >= 1.0) &&
+         (options_.total_entries_per_second <= 0.0 || total_tokens_ >= 1.0);
+}
+
+void EntryQuota::ConsumeLocked(Tag *tag) {
+  if (tag->policy.entries_per_second > 0.0) {
+    tag->tokens -= 1.0;
+  }
+  if (options_.total_entries_per_second > 0.0) {
+    total_tokens_ -= 1.0;
+  }
+}
+
+}  // namespace primitives
+}  // namespace asylo
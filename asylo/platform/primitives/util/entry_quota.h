@@ -0,0 +1,188 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_ENTRY_QUOTA_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_ENTRY_QUOTA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "asylo/util/asylo_macros.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+namespace primitives {
+
+// Per-caller-tag admission control for enclave entries.
+//
+// A shared enclave serves several tenants through one Client, and entry
+// capacity (TCS slots, EPC-resident working set) is a shared resource: one
+// tenant's call storm starves the rest at the entry layer. EntryQuota sits
+// in front of EnclaveCall() and admits calls through two token buckets: a
+// per-caller-tag bucket capping each tenant and an aggregate bucket modeling
+// the enclave's shared entry capacity. When calls must wait for the
+// aggregate, weighted fair queuing across tags decides who goes next, and
+// calls are shed when the wait queue is full or a call has waited too long.
+//
+// Callers label their threads with ScopedCallerTag; calls from unlabeled
+// threads are accounted under the empty tag. Tags without an explicit policy
+// use the default policy, so a quota whose default policy is unlimited only
+// constrains the tags it names. Thread-safe.
+class EntryQuota {
+ public:
+  // Admission policy for one caller tag.
+  struct TagPolicy {
+    // Sustained admission rate in entries per second. Zero admits without
+    // rate limiting.
+    double entries_per_second = 0.0;
+
+    // Token bucket capacity: the number of entries admissible in a burst
+    // above the sustained rate.
+    double burst = 1.0;
+
+    // Relative share of admission capacity when calls from several tags are
+    // queued. A tag with twice the weight of another is admitted twice as
+    // often from the queue.
+    uint32_t weight = 1;
+  };
+
+  // Quota-wide limits.
+  struct Options {
+    // Policy for tags without an explicit TagPolicy.
+    TagPolicy default_policy;
+
+    // Aggregate admission rate across all tags in entries per second, the
+    // shared bucket that weighted fair queuing arbitrates. Zero leaves the
+    // aggregate unlimited, so only per-tag rates constrain admission.
+    double total_entries_per_second = 0.0;
+
+    // Aggregate token bucket capacity.
+    double total_burst = 1.0;
+
+    // Calls waiting for admission across all tags; a call arriving when this
+    // many are already queued is shed.
+    size_t max_queued_calls = 128;
+
+    // Longest a call waits for admission before it is shed.
+    absl::Duration max_queue_delay = absl::Milliseconds(100);
+  };
+
+  // Cumulative per-tag counters. A delayed call that is eventually admitted
+  // counts under both |delayed| and |admitted|.
+  struct TagStats {
+    uint64_t admitted = 0;
+    uint64_t delayed = 0;
+    uint64_t shed = 0;
+  };
+
+  // Labels the calling thread's enclave entries with a caller tag for the
+  // lifetime of the object; restores the previous tag on destruction.
+  class ScopedCallerTag {
+   public:
+    explicit ScopedCallerTag(absl::string_view tag);
+    ~ScopedCallerTag();
+
+    ScopedCallerTag(const ScopedCallerTag &) = delete;
+    ScopedCallerTag &operator=(const ScopedCallerTag &) = delete;
+
+   private:
+    std::string saved_tag_;
+  };
+
+  // Returns the calling thread's caller tag; empty when unlabeled.
+  static absl::string_view CallerTag();
+
+  explicit EntryQuota(const Options &options)
+      : options_(options), total_tokens_(options.total_burst) {}
+
+  EntryQuota(const EntryQuota &) = delete;
+  EntryQuota &operator=(const EntryQuota &) = delete;
+
+  // Sets the admission policy for |tag|, replacing any previous policy. The
+  // tag's token bucket starts full.
+  void SetTagPolicy(absl::string_view tag, const TagPolicy &policy)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Admits one entry for |tag|, blocking fairly behind other queued tags
+  // until the tag's bucket has a token. Returns ResourceExhausted without
+  // blocking further when the queue is full or the call has waited
+  // max_queue_delay.
+  Status Admit(absl::string_view tag) ASYLO_MUST_USE_RESULT
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Returns the counters for |tag|; zeros for a tag never admitted.
+  TagStats GetStats(absl::string_view tag) const ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  // Per-tag admission state.
+  struct Tag {
+    TagPolicy policy;
+    // Tokens currently in the bucket and when they were last replenished.
+    double tokens = 0.0;
+    absl::Time last_refill = absl::InfinitePast();
+    // Virtual finish time of the tag's most recently queued call.
+    double virtual_finish = 0.0;
+    TagStats stats;
+  };
+
+  // Waiting calls ordered by (virtual finish time, arrival sequence); the
+  // front waiter is admitted next.
+  using WaiterKey = std::pair<double, uint64_t>;
+
+  // Returns the state for |tag|, creating it under the default policy.
+  Tag &GetTagLocked(absl::string_view tag) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Replenishes |tag|'s bucket and the aggregate bucket for the time elapsed
+  // through |now|.
+  void RefillLocked(Tag *tag, absl::Time now)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Returns true if |tag| and the aggregate both have a token for one entry,
+  // counting a bucket with no rate limit as always full.
+  bool CanAdmitLocked(const Tag &tag) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Consumes the tokens for one admitted entry.
+  void ConsumeLocked(Tag *tag) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const Options options_;
+
+  mutable absl::Mutex mu_;
+  absl::flat_hash_map<std::string, Tag> tags_ ABSL_GUARDED_BY(mu_);
+  // The aggregate token bucket shared by all tags.
+  double total_tokens_ ABSL_GUARDED_BY(mu_);
+  absl::Time total_last_refill_ ABSL_GUARDED_BY(mu_) = absl::InfinitePast();
+  std::set<WaiterKey> waiters_ ABSL_GUARDED_BY(mu_);
+  // Arrival sequence breaking virtual-finish ties in FIFO order.
+  uint64_t next_sequence_ ABSL_GUARDED_BY(mu_) = 0;
+  // The fair-queuing virtual clock: advances to the virtual finish time of
+  // each admitted waiter.
+  double virtual_time_ ABSL_GUARDED_BY(mu_) = 0.0;
+};
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_ENTRY_QUOTA_H_
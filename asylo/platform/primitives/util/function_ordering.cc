@@ -0,0 +1,86 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/function_ordering.h"
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+
+namespace asylo {
+namespace primitives {
+
+std::vector<std::string> HotFunctionOrdering(
+    const std::vector<ProfilerSampleRecord> &records,
+    const std::function<std::string(uint64_t)> &symbolize) {
+  absl::flat_hash_map<std::string, uint64_t> counts;
+  for (const ProfilerSampleRecord &record : records) {
+    const uint64_t depth = std::min<uint64_t>(record.depth, kProfilerMaxFrames);
+    for (uint64_t i = 0; i < depth; ++i) {
+      std::string name = symbolize(record.pcs[i]);
+      // Symbolize() renders addresses with no covering function symbol as
+      // hex; those cannot be placed by the linker.
+      if (name.empty() || absl::StartsWith(name, "0x")) {
+        continue;
+      }
+      ++counts[std::move(name)];
+    }
+  }
+
+  std::vector<std::pair<std::string, uint64_t>> functions(counts.begin(),
+                                                          counts.end());
+  std::sort(functions.begin(), functions.end(),
+            [](const std::pair<std::string, uint64_t> &lhs,
+               const std::pair<std::string, uint64_t> &rhs) {
+              return lhs.second != rhs.second ? lhs.second > rhs.second
+                                              : lhs.first < rhs.first;
+            });
+
+  std::vector<std::string> ordering;
+  ordering.reserve(functions.size());
+  for (std::pair<std::string, uint64_t> &function : functions) {
+    ordering.push_back(std::move(function.first));
+  }
+  return ordering;
+}
+
+Status WriteFunctionOrderingFile(const std::vector<std::string> &ordering,
+                                 const std::string &path) {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.is_open()) {
+    return absl::InternalError(
+        absl::StrCat("Failed to open function ordering file: ", path));
+  }
+  for (const std::string &symbol : ordering) {
+    file << symbol << "\n";
+  }
+  file.close();
+  if (file.fail()) {
+    return absl::InternalError(
+        absl::StrCat("Failed to write function ordering file: ", path));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace primitives
+}  // namespace asylo
@@ -0,0 +1,67 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_FUNCTION_ORDERING_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_FUNCTION_ORDERING_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "asylo/platform/primitives/util/profiler_sample.h"
+#include "asylo/util/asylo_macros.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+namespace primitives {
+
+// Profile-guided function ordering for enclave binaries.
+//
+// An enclave's resident EPC footprint depends on how many code pages its hot
+// paths touch, and with arbitrary link order hot functions are scattered
+// across the whole text segment. The pipeline here turns in-enclave sampling
+// profiler output into a symbol ordering file: run a representative workload
+// with the profiler enabled, aggregate the drained samples with
+// HotFunctionOrdering(), write the result with WriteFunctionOrderingFile(),
+// check the file in, and pass it as the function_ordering_file of the
+// enclave's sgx build rule so the linker lays hot functions out first on a
+// compact set of pages.
+
+// Aggregates |records| into a hot-first function ordering. Every captured
+// frame contributes one count to its containing function, resolved through
+// |symbolize| (typically SamplingProfilerCollector::Symbolize bound to a
+// collector that has loaded the enclave's symbols); frames that do not
+// resolve to a symbol are skipped. Functions are returned most-sampled
+// first, with ties broken by name so the ordering is deterministic across
+// profiling runs.
+std::vector<std::string> HotFunctionOrdering(
+    const std::vector<ProfilerSampleRecord> &records,
+    const std::function<std::string(uint64_t)> &symbolize);
+
+// Writes |ordering| to the file at |path|, one symbol per line — the format
+// accepted by the linker's --symbol-ordering-file flag and consumed by the
+// function_ordering_file attribute of the sgx build rules.
+Status WriteFunctionOrderingFile(const std::vector<std::string> &ordering,
+                                 const std::string &path)
+    ASYLO_MUST_USE_RESULT;
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_FUNCTION_ORDERING_H_
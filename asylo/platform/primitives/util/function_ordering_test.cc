@@ -0,0 +1,125 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/function_ordering.h"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/str_cat.h"
+#include "asylo/test/util/status_matchers.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+namespace asylo {
+namespace primitives {
+namespace {
+
+// Maps a pc to a synthetic function name: pcs in [100, 200) belong to "f1",
+// [200, 300) to "f2", and so on. Other pcs render as unresolved hex.
+std::string FakeSymbolize(uint64_t pc) {
+  if (pc >= 100 && pc < 1000) {
+    return absl::StrCat("f", pc / 100);
+  }
+  return absl::StrCat("0x", absl::Hex(pc));
+}
+
+// Builds a single-frame sample record at |pc|.
+ProfilerSampleRecord MakeSample(uint64_t pc) {
+  ProfilerSampleRecord record = {};
+  record.depth = 1;
+  record.pcs[0] = pc;
+  return record;
+}
+
+TEST(FunctionOrderingTest, EmptySamples) {
+  EXPECT_THAT(HotFunctionOrdering({}, FakeSymbolize), IsEmpty());
+}
+
+TEST(FunctionOrderingTest, OrdersHottestFirst) {
+  std::vector<ProfilerSampleRecord> records;
+  records.push_back(MakeSample(110));
+  records.push_back(MakeSample(210));
+  records.push_back(MakeSample(220));
+  records.push_back(MakeSample(230));
+  records.push_back(MakeSample(310));
+  records.push_back(MakeSample(320));
+
+  EXPECT_THAT(HotFunctionOrdering(records, FakeSymbolize),
+              ElementsAre("f2", "f3", "f1"));
+}
+
+TEST(FunctionOrderingTest, CountsEveryFrame) {
+  // One sample with f2 calling f1 and one leaf sample in f2: f2 outweighs f1.
+  ProfilerSampleRecord stacked = {};
+  stacked.depth = 2;
+  stacked.pcs[0] = 110;
+  stacked.pcs[1] = 210;
+  std::vector<ProfilerSampleRecord> records = {stacked, MakeSample(220)};
+
+  EXPECT_THAT(HotFunctionOrdering(records, FakeSymbolize),
+              ElementsAre("f2", "f1"));
+}
+
+TEST(FunctionOrderingTest, BreaksTiesByName) {
+  std::vector<ProfilerSampleRecord> records = {
+      MakeSample(310), MakeSample(110), MakeSample(210)};
+
+  EXPECT_THAT(HotFunctionOrdering(records, FakeSymbolize),
+              ElementsAre("f1", "f2", "f3"));
+}
+
+TEST(FunctionOrderingTest, SkipsUnresolvedFrames) {
+  std::vector<ProfilerSampleRecord> records = {MakeSample(42),
+                                               MakeSample(110)};
+
+  EXPECT_THAT(HotFunctionOrdering(records, FakeSymbolize),
+              ElementsAre("f1"));
+}
+
+TEST(FunctionOrderingTest, ClampsRecordDepth) {
+  ProfilerSampleRecord record = {};
+  record.depth = kProfilerMaxFrames + 4;
+  for (uint64_t i = 0; i < kProfilerMaxFrames; ++i) {
+    record.pcs[i] = 110;
+  }
+
+  EXPECT_THAT(HotFunctionOrdering({record}, FakeSymbolize),
+              ElementsAre("f1"));
+}
+
+TEST(FunctionOrderingTest, WritesOneSymbolPerLine) {
+  const std::string path =
+      absl::StrCat(::testing::TempDir(), "/function_ordering");
+  ASYLO_EXPECT_OK(WriteFunctionOrderingFile({"f2", "f1"}, path));
+
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  EXPECT_EQ(contents.str(), "f2\nf1\n");
+}
+
+}  // namespace
+}  // namespace primitives
+}  // namespace asylo
@@ -0,0 +1,56 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/init_timing_reader.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "asylo/platform/primitives/primitives.h"
+#include "asylo/platform/primitives/untrusted_primitives.h"
+#include "asylo/platform/primitives/util/message.h"
+#include "asylo/util/status_macros.h"
+#include "asylo/util/statusor.h"
+
+namespace asylo {
+namespace primitives {
+
+StatusOr<std::vector<InitPhaseTimestamp>> ReadEnclaveInitTiming(
+    Client *client) {
+  MessageWriter input;
+  MessageReader output;
+  ASYLO_RETURN_IF_ERROR(
+      client->EnclaveCall(kSelectorAsyloInitTiming, &input, &output));
+  if (output.size() % 2 != 0) {
+    return absl::InternalError("Malformed init timing response.");
+  }
+
+  std::vector<InitPhaseTimestamp> phases;
+  phases.reserve(output.size() / 2);
+  while (output.hasNext()) {
+    InitPhaseTimestamp phase;
+    phase.phase = output.next<uint64_t>();
+    phase.nanoseconds = output.next<uint64_t>();
+    phases.push_back(phase);
+  }
+  return phases;
+}
+
+}  // namespace primitives
+}  // namespace asylo
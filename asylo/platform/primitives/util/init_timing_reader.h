@@ -0,0 +1,50 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_INIT_TIMING_READER_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_INIT_TIMING_READER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "asylo/platform/primitives/untrusted_primitives.h"
+#include "asylo/util/statusor.h"
+
+namespace asylo {
+namespace primitives {
+
+// A single stamped enclave initialization phase.
+struct InitPhaseTimestamp {
+  // One of the kInitPhase constants in primitives.h.
+  uint64_t phase;
+
+  // Host wall clock in nanoseconds when the phase completed, or 0 if the
+  // enclave could not read a clock at that point.
+  uint64_t nanoseconds;
+};
+
+// Reads the phase-stamped initialization timeline recorded by the trusted
+// runtime of |client|'s enclave. Phases are returned in the order recorded,
+// so the difference between consecutive timestamps attributes cold-start
+// latency to individual initialization steps.
+StatusOr<std::vector<InitPhaseTimestamp>> ReadEnclaveInitTiming(Client *client);
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_INIT_TIMING_READER_H_
@@ -28,6 +28,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
@@ -184,13 +185,22 @@ class MessageReader {
  public:
   MessageReader() = default;
 
+  ~MessageReader() { ReleaseOwnedBuffers(); }
+
   // Disallow copying.
   MessageReader(const MessageReader &other) = delete;
   MessageReader operator=(const MessageReader &other) = delete;
 
   // Allow moving.
   MessageReader(MessageReader &&other) noexcept = default;
-  MessageReader &operator=(MessageReader &&other) = default;
+  MessageReader &operator=(MessageReader &&other) {
+    ReleaseOwnedBuffers();
+    extents_ = std::move(other.extents_);
+    owned_buffers_ = std::move(other.owned_buffers_);
+    releasers_ = std::move(other.releasers_);
+    pos_ = other.pos_;
+    return *this;
+  }
 
   // Deserializes a data buffer of provided size into owned extents. |buffer| is
   // the serialized buffer originally written by the MessageWriter, and is owned
@@ -213,24 +223,61 @@ class MessageReader {
         abort();
       }
       char *extent_data = new char[extent_len];
-      extents_.emplace_back(std::unique_ptr<char[]>(extent_data), extent_len);
+      extents_.emplace_back(std::unique_ptr<char[]>(extent_data),
+                            Extent{extent_data, extent_len});
       memcpy(extent_data, ptr, extent_len);
       ptr += extent_len;
     }
   }
 
+  // Deserializes |buffer| without copying extent payloads; the produced
+  // extents alias |buffer| directly. The caller retains ownership of |buffer|
+  // and must keep it valid and unmodified for the lifetime of the
+  // MessageReader.
+  //
+  // This must never be used on buffers in memory writable by a less trusted
+  // party (e.g. trusted code aliasing untrusted memory), since the payloads
+  // could then change after validation.
+  void DeserializeInPlace(void *buffer, size_t size) {
+    ParseAliased(reinterpret_cast<char *>(buffer), size);
+  }
+
+  // Deserializes |buffer| without copying extent payloads, taking ownership
+  // of the buffer. The buffer is released with |deleter| when the
+  // MessageReader is destroyed. The same trust caveats as DeserializeInPlace
+  // apply.
+  void DeserializeOwned(void *buffer, size_t size, void (*deleter)(void *)) {
+    ParseAliased(reinterpret_cast<char *>(buffer), size);
+    owned_buffers_.emplace_back(buffer, deleter);
+  }
+
   // Deserializes data using a given deserializer.
   void Deserialize(const size_t size,
                    const std::function<Extent(size_t i)> &deserializer) {
     extents_.reserve(size);
     for (size_t i = 0; i < size; ++i) {
       auto extent = deserializer(i);
-      extents_.emplace_back(absl::make_unique<char[]>(extent.size()),
-                            extent.size());
+      auto owner = absl::make_unique<char[]>(extent.size());
+      Extent owned_extent{owner.get(), extent.size()};
       if (extent.size() > 0) {
-        memcpy(extents_.back().first.get(), extent.data(), extent.size());
+        memcpy(owner.get(), extent.data(), extent.size());
       }
+      extents_.emplace_back(std::move(owner), owned_extent);
+    }
+  }
+
+  // Deserializes extents produced by |deserializer| without copying payloads.
+  // The produced extents alias memory kept alive by |releaser|'s captures;
+  // |releaser| is invoked when the MessageReader is destroyed. The same trust
+  // caveats as DeserializeInPlace apply.
+  void DeserializeAliased(const size_t size,
+                          const std::function<Extent(size_t i)> &deserializer,
+                          std::function<void()> releaser) {
+    extents_.reserve(extents_.size() + size);
+    for (size_t i = 0; i < size; ++i) {
+      extents_.emplace_back(nullptr, deserializer(i));
     }
+    releasers_.emplace_back(std::move(releaser));
   }
 
   // Returns the number of extents read.
@@ -256,9 +303,7 @@ class MessageReader {
   // Peeks at the next extent in the MessageReader; the ensuing next() call will
   // return the same extent. The extent remains owned by the MessageReader and
   // its lifetime is the lifetime of the MessageReader.
-  Extent peek() {
-    return Extent{extents_[pos_].first.get(), extents_[pos_].second};
-  }
+  Extent peek() { return extents_[pos_].second; }
 
   // Interprets the peek item in the MessageReader as a pointer to a value of
   // type T, consumes it, and returns its value by const reference.
@@ -309,7 +354,49 @@ class MessageReader {
   } while (false)
 
  private:
-  std::vector<std::pair<std::unique_ptr<char[]>, size_t>> extents_;
+  // Releases buffers whose ownership was transferred by DeserializeOwned()
+  // and invokes releasers recorded by DeserializeAliased().
+  void ReleaseOwnedBuffers() {
+    for (auto &buffer : owned_buffers_) {
+      buffer.second(buffer.first);
+    }
+    owned_buffers_.clear();
+    for (auto &releaser : releasers_) {
+      releaser();
+    }
+    releasers_.clear();
+  }
+
+  // Walks a serialized buffer and records extents aliasing it, without
+  // copying payloads.
+  void ParseAliased(char *buffer, size_t size) {
+    char *ptr = buffer;
+    char *end_ptr = ptr + size;
+    while (ptr < end_ptr) {
+      uint64_t extent_len;
+      memcpy(&extent_len, ptr, sizeof(uint64_t));
+      ptr += sizeof(uint64_t);
+      if (ptr + extent_len > end_ptr) {
+        // |extent_len| overflows size. This indicates an invalid/modified
+        // buffer.
+        abort();
+      }
+      extents_.emplace_back(nullptr, Extent{ptr, extent_len});
+      ptr += extent_len;
+    }
+  }
+
+  // Extents in traversal order. The unique_ptr owner is null for extents
+  // aliasing an external or reader-owned buffer.
+  std::vector<std::pair<std::unique_ptr<char[]>, Extent>> extents_;
+
+  // Whole deserialized buffers owned by the reader, with their deleters.
+  std::vector<std::pair<void *, void (*)(void *)>> owned_buffers_;
+
+  // Releasers keeping alive external objects whose memory is aliased by
+  // extents recorded with DeserializeAliased().
+  std::vector<std::function<void()>> releasers_;
+
   size_t pos_ = 0;
 };
 
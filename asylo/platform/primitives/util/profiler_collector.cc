@@ -0,0 +1,144 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/profiler_collector.h"
+
+#include <elf.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "asylo/platform/primitives/primitives.h"
+#include "asylo/platform/primitives/util/message.h"
+#include "asylo/util/elf_reader.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+namespace primitives {
+
+SamplingProfilerCollector::~SamplingProfilerCollector() {
+  if (buffer_) {
+    const bool stopped = Stop().ok();
+    (void)stopped;
+  }
+}
+
+Status SamplingProfilerCollector::Start(uint64_t period) {
+  if (buffer_) {
+    return absl::FailedPreconditionError(
+        "SamplingProfilerCollector::Start() may only be called once.");
+  }
+  if (period == 0) {
+    return absl::InvalidArgumentError("Sampling period must be nonzero.");
+  }
+  buffer_ = absl::make_unique<ProfilerSampleBuffer>();
+
+  MessageWriter input;
+  input.Push<uint64_t>(reinterpret_cast<uint64_t>(buffer_.get()));
+  input.Push<uint64_t>(period);
+  MessageReader output;
+  Status status = client_->EnclaveCall(kSelectorAsyloProfilerInit, &input,
+                                       &output);
+  if (!status.ok()) {
+    buffer_.reset();
+  }
+  return status;
+}
+
+Status SamplingProfilerCollector::Stop() {
+  if (!buffer_) {
+    return absl::OkStatus();
+  }
+  MessageWriter input;
+  input.Push<uint64_t>(0);
+  input.Push<uint64_t>(0);
+  MessageReader output;
+  return client_->EnclaveCall(kSelectorAsyloProfilerInit, &input, &output);
+}
+
+std::vector<ProfilerSampleRecord> SamplingProfilerCollector::Drain() {
+  std::vector<ProfilerSampleRecord> records;
+  if (!buffer_) {
+    return records;
+  }
+  ProfilerSampleRecord record;
+  while (buffer_->size() >= sizeof(record)) {
+    if (buffer_->Read(reinterpret_cast<uint8_t *>(&record), sizeof(record)) !=
+        sizeof(record)) {
+      break;
+    }
+    // Clamp the untrusted-resident depth field before callers index pcs.
+    if (record.depth > kProfilerMaxFrames) {
+      record.depth = kProfilerMaxFrames;
+    }
+    records.push_back(record);
+  }
+  return records;
+}
+
+Status SamplingProfilerCollector::LoadSymbols(
+    absl::Span<const uint8_t> elf_file, uint64_t load_bias) {
+  ElfReader reader;
+  ASYLO_ASSIGN_OR_RETURN(reader, ElfReader::CreateFromSpan(elf_file));
+  absl::Span<const uint8_t> symtab;
+  ASYLO_ASSIGN_OR_RETURN(symtab, reader.GetSectionData(".symtab"));
+  absl::Span<const uint8_t> strtab;
+  ASYLO_ASSIGN_OR_RETURN(strtab, reader.GetSectionData(".strtab"));
+
+  symbols_.clear();
+  const size_t num_symbols = symtab.size() / sizeof(Elf64_Sym);
+  for (size_t i = 0; i < num_symbols; ++i) {
+    Elf64_Sym symbol;
+    memcpy(&symbol, symtab.data() + i * sizeof(Elf64_Sym), sizeof(Elf64_Sym));
+    if (ELF64_ST_TYPE(symbol.st_info) != STT_FUNC || symbol.st_size == 0 ||
+        symbol.st_name >= strtab.size()) {
+      continue;
+    }
+    const char *name =
+        reinterpret_cast<const char *>(strtab.data()) + symbol.st_name;
+    FunctionSymbol function;
+    function.address = symbol.st_value + load_bias;
+    function.size = symbol.st_size;
+    function.name = std::string(
+        name, strnlen(name, strtab.size() - symbol.st_name));
+    symbols_.push_back(std::move(function));
+  }
+  std::sort(symbols_.begin(), symbols_.end());
+  return absl::OkStatus();
+}
+
+std::string SamplingProfilerCollector::Symbolize(uint64_t pc) const {
+  FunctionSymbol key;
+  key.address = pc;
+  auto it = std::upper_bound(symbols_.begin(), symbols_.end(), key);
+  if (it != symbols_.begin()) {
+    --it;
+    if (pc >= it->address && pc < it->address + it->size) {
+      return it->name;
+    }
+  }
+  return absl::StrCat("0x", absl::Hex(pc));
+}
+
+}  // namespace primitives
+}  // namespace asylo
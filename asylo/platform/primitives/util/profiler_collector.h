@@ -0,0 +1,99 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_PROFILER_COLLECTOR_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_PROFILER_COLLECTOR_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "asylo/platform/primitives/untrusted_primitives.h"
+#include "asylo/platform/primitives/util/profiler_sample.h"
+#include "asylo/util/asylo_macros.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+namespace primitives {
+
+// Untrusted collector for the in-enclave sampling profiler.
+//
+// The collector owns the ProfilerSampleBuffer in untrusted memory, registers
+// it with the enclave, and drains sample records on demand. Samples can be
+// symbolized against the enclave binary's ELF symbol table using the
+// enclave's load bias.
+class SamplingProfilerCollector {
+ public:
+  // Constructs a collector for profiling samples from |client|. The wrapped
+  // client must outlive the SamplingProfilerCollector.
+  explicit SamplingProfilerCollector(std::shared_ptr<Client> client)
+      : client_(std::move(client)) {}
+
+  ~SamplingProfilerCollector();
+
+  SamplingProfilerCollector(const SamplingProfilerCollector &) = delete;
+  SamplingProfilerCollector &operator=(const SamplingProfilerCollector &) =
+      delete;
+
+  // Allocates the sample buffer and enables in-enclave sampling with one
+  // sample per |period| checkpoints. May be called at most once.
+  Status Start(uint64_t period) ASYLO_MUST_USE_RESULT;
+
+  // Disables in-enclave sampling. Records already exported remain available
+  // to Drain().
+  Status Stop();
+
+  // Drains and returns all complete sample records currently in the buffer.
+  std::vector<ProfilerSampleRecord> Drain();
+
+  // Indexes the function symbols of |elf_file| (the enclave binary) for
+  // symbolization. |load_bias| is the difference between the enclave's
+  // runtime load address and the ELF link-time addresses. The buffer must
+  // outlive the collector.
+  Status LoadSymbols(absl::Span<const uint8_t> elf_file,
+                     uint64_t load_bias) ASYLO_MUST_USE_RESULT;
+
+  // Returns the name of the function containing |pc|, or a hex rendering of
+  // the address if no covering symbol was loaded.
+  std::string Symbolize(uint64_t pc) const;
+
+ private:
+  // A function symbol covering [address, address + size).
+  struct FunctionSymbol {
+    uint64_t address;
+    uint64_t size;
+    std::string name;
+
+    bool operator<(const FunctionSymbol &other) const {
+      return address < other.address;
+    }
+  };
+
+  std::shared_ptr<Client> client_;
+  std::unique_ptr<ProfilerSampleBuffer> buffer_;
+
+  // Function symbols sorted by address, adjusted for the load bias.
+  std::vector<FunctionSymbol> symbols_;
+};
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_PROFILER_COLLECTOR_H_
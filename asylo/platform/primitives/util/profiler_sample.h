@@ -0,0 +1,58 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_PROFILER_SAMPLE_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_PROFILER_SAMPLE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "asylo/platform/common/ring_buffer.h"
+
+namespace asylo {
+namespace primitives {
+
+// Shared record format of the in-enclave sampling profiler. Samples are
+// captured inside the enclave and exported through a RingBuffer residing in
+// untrusted shared memory, where the untrusted collector drains and
+// symbolizes them. The records carry only code addresses and hashes — no
+// argument or data values — but still reveal control flow, so profiling
+// should only be enabled on debug builds or with that disclosure in mind.
+
+// Maximum stack frames captured per sample.
+constexpr size_t kProfilerMaxFrames = 16;
+
+// Capacity in bytes of the sample export ring.
+constexpr size_t kProfilerBufferCapacity = 64 * 1024;
+
+// One captured stack sample. The record has fixed size; unused frame slots
+// beyond |depth| are undefined.
+struct ProfilerSampleRecord {
+  uint64_t stack_hash;  // FNV-1a hash over the captured return addresses.
+  uint64_t thread_id;   // Trusted thread identifier of the sampled thread.
+  uint64_t depth;       // Number of valid entries in |pcs|.
+  uint64_t pcs[kProfilerMaxFrames];  // Return addresses, innermost first.
+} __attribute__((aligned(8)));
+
+// The sample export channel: one trusted writer, one untrusted reader.
+using ProfilerSampleBuffer = RingBuffer<kProfilerBufferCapacity>;
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_PROFILER_SAMPLE_H_
@@ -0,0 +1,94 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_SHARED_CLOCK_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_SHARED_CLOCK_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace asylo {
+namespace primitives {
+
+// A vDSO-style clock page in untrusted shared memory. A single untrusted
+// writer thread periodically publishes a pair of host clock readings, and any
+// number of trusted readers consume them without leaving the enclave. The
+// page is protected by a seqlock: the sequence number is odd while an update
+// is in progress, and a reader retries until it observes the same even
+// sequence number on both sides of its reads.
+//
+// The readings are as stale as the writer's update interval, which is the
+// coarse-clock tradeoff this mechanism makes. Readers must treat the page as
+// untrusted input: a stalled or malicious writer can at worst serve stale or
+// inconsistent values, which TryRead() bounds by giving up after a fixed
+// number of retries.
+struct SharedClockPage {
+  // Number of read attempts before TryRead() gives up, so that a writer
+  // parked mid-update cannot wedge a trusted reader.
+  static constexpr int kMaxReadAttempts = 64;
+
+  // Seqlock generation counter; odd while an update is in progress.
+  std::atomic<uint64_t> sequence{0};
+
+  // CLOCK_REALTIME reading, in nanoseconds since the epoch.
+  std::atomic<int64_t> realtime_nanoseconds{0};
+
+  // CLOCK_MONOTONIC reading, in nanoseconds.
+  std::atomic<int64_t> monotonic_nanoseconds{0};
+
+  // Publishes a new pair of clock readings. Must be called from a single
+  // writer thread.
+  void Update(int64_t realtime_ns, int64_t monotonic_ns) {
+    uint64_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    realtime_nanoseconds.store(realtime_ns, std::memory_order_relaxed);
+    monotonic_nanoseconds.store(monotonic_ns, std::memory_order_relaxed);
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  // Reads a consistent snapshot of both clocks into |realtime_ns| and
+  // |monotonic_ns|. Returns false if no consistent snapshot could be
+  // observed within kMaxReadAttempts, in which case the outputs are left
+  // unmodified and the caller should fall back to another time source.
+  bool TryRead(int64_t *realtime_ns, int64_t *monotonic_ns) const {
+    for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+      uint64_t before = sequence.load(std::memory_order_acquire);
+      if (before & 1) {
+        continue;
+      }
+      int64_t realtime = realtime_nanoseconds.load(std::memory_order_relaxed);
+      int64_t monotonic = monotonic_nanoseconds.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == before) {
+        *realtime_ns = realtime;
+        *monotonic_ns = monotonic;
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+static_assert(sizeof(std::atomic<int64_t>) == sizeof(int64_t),
+              "lockfree int64_t is unavailable.");
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_SHARED_CLOCK_H_
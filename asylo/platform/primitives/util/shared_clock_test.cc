@@ -0,0 +1,74 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/shared_clock.h"
+
+#include <cstdint>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace asylo {
+namespace primitives {
+namespace {
+
+using testing::Eq;
+
+TEST(SharedClockTest, ReadReturnsPublishedValues) {
+  SharedClockPage page;
+  page.Update(/*realtime_ns=*/1000, /*monotonic_ns=*/2000);
+
+  int64_t realtime = 0;
+  int64_t monotonic = 0;
+  ASSERT_TRUE(page.TryRead(&realtime, &monotonic));
+  EXPECT_THAT(realtime, Eq(1000));
+  EXPECT_THAT(monotonic, Eq(2000));
+}
+
+TEST(SharedClockTest, ReadReturnsLatestUpdate) {
+  SharedClockPage page;
+  page.Update(/*realtime_ns=*/1000, /*monotonic_ns=*/2000);
+  page.Update(/*realtime_ns=*/3000, /*monotonic_ns=*/4000);
+
+  int64_t realtime = 0;
+  int64_t monotonic = 0;
+  ASSERT_TRUE(page.TryRead(&realtime, &monotonic));
+  EXPECT_THAT(realtime, Eq(3000));
+  EXPECT_THAT(monotonic, Eq(4000));
+}
+
+TEST(SharedClockTest, ReadFailsWhileUpdateInProgress) {
+  SharedClockPage page;
+  page.Update(/*realtime_ns=*/1000, /*monotonic_ns=*/2000);
+
+  // Simulate a writer parked in the middle of an update: the sequence number
+  // stays odd, so a reader must give up rather than spin forever.
+  page.sequence.fetch_add(1);
+
+  int64_t realtime = -1;
+  int64_t monotonic = -1;
+  EXPECT_FALSE(page.TryRead(&realtime, &monotonic));
+
+  // The outputs are left unmodified on failure.
+  EXPECT_THAT(realtime, Eq(-1));
+  EXPECT_THAT(monotonic, Eq(-1));
+}
+
+}  // namespace
+}  // namespace primitives
+}  // namespace asylo
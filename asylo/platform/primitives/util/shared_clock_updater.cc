@@ -0,0 +1,109 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/shared_clock_updater.h"
+
+#include <time.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "asylo/util/logging.h"
+#include "asylo/platform/common/time_util.h"
+#include "asylo/platform/primitives/primitives.h"
+#include "asylo/platform/primitives/util/message.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+namespace primitives {
+
+namespace {
+
+// Reads the host clocks and publishes them to |page|.
+void RefreshClockPage(SharedClockPage *page) {
+  struct timespec realtime;
+  struct timespec monotonic;
+  clock_gettime(CLOCK_REALTIME, &realtime);
+  clock_gettime(CLOCK_MONOTONIC, &monotonic);
+  page->Update(TimeSpecToNanoseconds(&realtime),
+               TimeSpecToNanoseconds(&monotonic));
+}
+
+}  // namespace
+
+Status SharedClockUpdater::Start(absl::Duration update_interval) {
+  if (page_) {
+    return absl::FailedPreconditionError(
+        "SharedClockUpdater::Start() may only be called once.");
+  }
+  if (update_interval <= absl::ZeroDuration()) {
+    return absl::InvalidArgumentError(
+        "SharedClockUpdater requires a positive update interval.");
+  }
+  page_ = absl::make_unique<SharedClockPage>();
+
+  // Populate the page before registering it, so the enclave never observes
+  // zero-valued clocks.
+  RefreshClockPage(page_.get());
+
+  MessageWriter input;
+  input.Push<uint64_t>(reinterpret_cast<uint64_t>(page_.get()));
+  MessageReader output;
+  Status status = client_->EnclaveCall(kSelectorAsyloSharedClockInit, &input,
+                                       &output);
+  if (!status.ok()) {
+    page_.reset();
+    return status;
+  }
+
+  SharedClockPage *page = page_.get();
+  std::atomic<bool> *stop = &stop_;
+  thread_ = absl::make_unique<Thread>([page, stop, update_interval] {
+    while (!stop->load(std::memory_order_relaxed)) {
+      RefreshClockPage(page);
+      absl::SleepFor(update_interval);
+    }
+  });
+  return absl::OkStatus();
+}
+
+void SharedClockUpdater::Stop() {
+  if (!thread_) {
+    return;
+  }
+  // Uninstall the page first so that no trusted reader remains when the page
+  // is torn down.
+  MessageWriter input;
+  input.Push<uint64_t>(0);
+  MessageReader output;
+  Status status = client_->EnclaveCall(kSelectorAsyloSharedClockInit, &input,
+                                       &output);
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to uninstall shared clock page: " << status;
+  }
+  stop_ = true;
+  thread_->Join();
+  thread_.reset();
+}
+
+}  // namespace primitives
+}  // namespace asylo
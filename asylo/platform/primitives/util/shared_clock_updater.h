@@ -0,0 +1,75 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_SHARED_CLOCK_UPDATER_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_SHARED_CLOCK_UPDATER_H_
+
+#include <atomic>
+#include <memory>
+
+#include "absl/time/time.h"
+#include "asylo/platform/primitives/untrusted_primitives.h"
+#include "asylo/platform/primitives/util/shared_clock.h"
+#include "asylo/util/asylo_macros.h"
+#include "asylo/util/status.h"
+#include "asylo/util/thread.h"
+
+namespace asylo {
+namespace primitives {
+
+// An untrusted updater thread publishing host clock readings to a
+// SharedClockPage, so that trusted clock_gettime() and gettimeofday() calls
+// complete without an enclave exit.
+//
+// On Start(), the updater allocates a SharedClockPage in untrusted memory,
+// registers it with the enclave, and refreshes it from the host clocks every
+// update interval. Clock reads inside the enclave are then served from the
+// page with a staleness bounded by that interval; the enclave falls back to
+// host calls whenever the page cannot be read consistently.
+class SharedClockUpdater {
+ public:
+  // Constructs an updater serving clock reads for |client|. The wrapped
+  // client must outlive the SharedClockUpdater.
+  explicit SharedClockUpdater(std::shared_ptr<Client> client)
+      : client_(std::move(client)) {}
+
+  ~SharedClockUpdater() { Stop(); }
+
+  SharedClockUpdater(const SharedClockUpdater &) = delete;
+  SharedClockUpdater &operator=(const SharedClockUpdater &) = delete;
+
+  // Registers the clock page with the enclave and starts the updater thread,
+  // refreshing the page every |update_interval|. May be called at most once.
+  Status Start(absl::Duration update_interval) ASYLO_MUST_USE_RESULT;
+
+  // Uninstalls the clock page from the enclave, restoring host call dispatch
+  // for clock reads, and joins the updater thread. Safe to call multiple
+  // times, or without a prior Start().
+  void Stop();
+
+ private:
+  std::shared_ptr<Client> client_;
+  std::unique_ptr<SharedClockPage> page_;
+  std::unique_ptr<Thread> thread_;
+  std::atomic<bool> stop_{false};
+};
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_SHARED_CLOCK_UPDATER_H_
@@ -21,6 +21,8 @@
 
 #include <sys/types.h>
 
+#include <string>
+
 #include "asylo/platform/primitives/trusted_primitives.h"
 #include "asylo/util/status.h"
 
@@ -67,10 +69,15 @@ class StatusSerializer {
     status.SaveTo(status_proto_);
 
     // Serialize to a trusted buffer instead of an untrusted buffer because the
-    // serialization routine may rely on read backs for correctness.
+    // serialization routine may rely on read backs for correctness. The buffer
+    // retains its capacity across calls on each thread, so entry points that
+    // serialize at RPC rates do not allocate here in steady state. It is
+    // intentionally leaked because the enclave runtime does not run
+    // thread-local destructors.
+    thread_local std::string *trusted_output = new std::string;
     *output_len_ = output_proto_->ByteSizeLong();
-    std::unique_ptr<char[]> trusted_output(new char[*output_len_]);
-    if (!output_proto_->SerializeToArray(trusted_output.get(), *output_len_)) {
+    trusted_output->resize(*output_len_);
+    if (!output_proto_->SerializeToArray(&(*trusted_output)[0], *output_len_)) {
       *output_ = nullptr;
       *output_len_ = 0;
       primitives::TrustedPrimitives::DebugPuts(status.ToString().c_str());
@@ -78,7 +85,7 @@ class StatusSerializer {
     }
 
     *output_ = reinterpret_cast<char *>(allocator_(*output_len_));
-    memcpy(*output_, trusted_output.get(), *output_len_);
+    memcpy(*output_, trusted_output->data(), *output_len_);
     return 0;
   }
 
@@ -0,0 +1,193 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_SWITCHLESS_CALL_QUEUE_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_SWITCHLESS_CALL_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "asylo/platform/common/ring_buffer.h"
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/message.h"
+
+namespace asylo {
+namespace primitives {
+
+// This file defines the shared-memory channel used by the switchless call
+// mechanism. A SwitchlessCallQueue lives in untrusted memory and is shared
+// between exactly one untrusted caller thread and exactly one trusted worker
+// thread which is resident inside the enclave. Serialized enclave call
+// requests flow through the request ring and serialized results flow back
+// through the response ring, so that neither side performs an enclave
+// transition per call.
+//
+// The framing and synchronization here inherit the security posture of
+// RingBuffer: the data in the rings is untrusted, and all trusted-side
+// consumers must copy records out of the rings before interpreting them.
+
+// Capacity in bytes of each direction of a switchless call channel. Requests
+// or responses larger than this (including framing) cannot go switchless and
+// must fall back to a regular enclave transition.
+constexpr size_t kSwitchlessQueueCapacity = 64 * 1024;
+
+// Framing header preceding each serialized call request in the request ring.
+struct SwitchlessCallHeader {
+  uint64_t selector;      // Entry handler selector for the call.
+  uint64_t payload_size;  // Size in bytes of the serialized MessageWriter.
+} __attribute__((aligned(8)));
+
+// Framing header preceding each serialized call result in the response ring.
+struct SwitchlessResponseHeader {
+  uint32_t status_code;   // PrimitiveStatus error code of the call.
+  uint32_t message_size;  // Size in bytes of the status error message.
+  uint64_t payload_size;  // Size in bytes of the serialized results.
+} __attribute__((aligned(8)));
+
+// A pair of single-reader single-writer rings forming one switchless call
+// channel. The object must be allocated in memory addressable by both the
+// untrusted application and the enclave worker thread.
+class SwitchlessCallQueue {
+ public:
+  using Buffer = RingBuffer<kSwitchlessQueueCapacity>;
+
+  SwitchlessCallQueue() = default;
+
+  SwitchlessCallQueue(const SwitchlessCallQueue &) = delete;
+  SwitchlessCallQueue &operator=(const SwitchlessCallQueue &) = delete;
+
+  Buffer *requests() { return &requests_; }
+  Buffer *responses() { return &responses_; }
+
+ private:
+  Buffer requests_;
+  Buffer responses_;
+} __attribute__((aligned(8)));
+
+// Writes a framed call request to |ring|. The caller must be the only writer
+// of |ring|. Returns false without writing anything if the serialized request
+// can never fit in the ring, in which case the caller should fall back to a
+// regular enclave call.
+inline bool SwitchlessEnqueueRequest(SwitchlessCallQueue::Buffer *ring,
+                                     uint64_t selector, MessageWriter *input) {
+  SwitchlessCallHeader header;
+  header.selector = selector;
+  header.payload_size = input ? input->MessageSize() : 0;
+  if (sizeof(header) + header.payload_size > ring->capacity()) {
+    return false;
+  }
+  std::vector<uint8_t> buffer(sizeof(header) + header.payload_size);
+  memcpy(buffer.data(), &header, sizeof(header));
+  if (header.payload_size > 0) {
+    input->Serialize(buffer.data() + sizeof(header));
+  }
+  return ring->Write(buffer.data(), buffer.size()) == buffer.size();
+}
+
+// Reads a framed call request from |ring|, blocking until a full record is
+// available. The caller must be the only reader of |ring|. The payload is
+// copied into caller-owned memory before deserialization, so |output| never
+// aliases ring storage. Returns false if the ring was closed for writing.
+inline bool SwitchlessDequeueRequest(SwitchlessCallQueue::Buffer *ring,
+                                     uint64_t *selector,
+                                     MessageReader *output) {
+  SwitchlessCallHeader header;
+  if (ring->Read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) !=
+      sizeof(header)) {
+    return false;
+  }
+  // Bound the payload read by the ring capacity so that a corrupted header
+  // cannot induce an unbounded allocation.
+  if (header.payload_size > ring->capacity()) {
+    return false;
+  }
+  *selector = header.selector;
+  if (header.payload_size > 0) {
+    std::vector<uint8_t> payload(header.payload_size);
+    if (ring->Read(payload.data(), payload.size()) != payload.size()) {
+      return false;
+    }
+    output->Deserialize(payload.data(), payload.size());
+  }
+  return true;
+}
+
+// Writes a framed call result to |ring|. The caller must be the only writer
+// of |ring|. Returns false if the serialized result cannot fit in the ring.
+inline bool SwitchlessEnqueueResponse(SwitchlessCallQueue::Buffer *ring,
+                                      const PrimitiveStatus &status,
+                                      MessageWriter *output) {
+  SwitchlessResponseHeader header;
+  header.status_code = status.error_code();
+  header.message_size = strlen(status.error_message());
+  header.payload_size = status.ok() && output ? output->MessageSize() : 0;
+  if (sizeof(header) + header.message_size + header.payload_size >
+      ring->capacity()) {
+    return false;
+  }
+  std::vector<uint8_t> buffer(sizeof(header) + header.message_size +
+                              header.payload_size);
+  memcpy(buffer.data(), &header, sizeof(header));
+  if (header.message_size > 0) {
+    memcpy(buffer.data() + sizeof(header), status.error_message(),
+           header.message_size);
+  }
+  if (header.payload_size > 0) {
+    output->Serialize(buffer.data() + sizeof(header) + header.message_size);
+  }
+  return ring->Write(buffer.data(), buffer.size()) == buffer.size();
+}
+
+// Reads a framed call result from |ring|, blocking until a full record is
+// available. The caller must be the only reader of |ring|. Returns false if
+// the ring was closed for writing.
+inline bool SwitchlessDequeueResponse(SwitchlessCallQueue::Buffer *ring,
+                                      PrimitiveStatus *status,
+                                      MessageReader *output) {
+  SwitchlessResponseHeader header;
+  if (ring->Read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) !=
+      sizeof(header)) {
+    return false;
+  }
+  if (header.message_size + header.payload_size > ring->capacity()) {
+    return false;
+  }
+  std::string message(header.message_size, '\0');
+  if (header.message_size > 0 &&
+      ring->Read(reinterpret_cast<uint8_t *>(&message[0]),
+                 header.message_size) != header.message_size) {
+    return false;
+  }
+  *status = PrimitiveStatus(header.status_code, message);
+  if (header.payload_size > 0) {
+    std::vector<uint8_t> payload(header.payload_size);
+    if (ring->Read(payload.data(), payload.size()) != payload.size()) {
+      return false;
+    }
+    output->Deserialize(payload.data(), payload.size());
+  }
+  return true;
+}
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_SWITCHLESS_CALL_QUEUE_H_
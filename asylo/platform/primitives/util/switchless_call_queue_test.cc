@@ -0,0 +1,124 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/switchless_call_queue.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/memory/memory.h"
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/message.h"
+
+namespace asylo {
+namespace primitives {
+namespace {
+
+TEST(SwitchlessCallQueueTest, RequestRoundTrip) {
+  auto queue = absl::make_unique<SwitchlessCallQueue>();
+
+  MessageWriter input;
+  input.Push<uint64_t>(42);
+  input.PushString("hello");
+  ASSERT_TRUE(SwitchlessEnqueueRequest(queue->requests(), /*selector=*/17,
+                                       &input));
+
+  uint64_t selector;
+  MessageReader output;
+  ASSERT_TRUE(SwitchlessDequeueRequest(queue->requests(), &selector, &output));
+  EXPECT_EQ(selector, 17);
+  ASSERT_EQ(output.size(), 2);
+  EXPECT_EQ(output.next<uint64_t>(), 42);
+  EXPECT_STREQ(output.next().As<char>(), "hello");
+}
+
+TEST(SwitchlessCallQueueTest, EmptyRequestRoundTrip) {
+  auto queue = absl::make_unique<SwitchlessCallQueue>();
+
+  ASSERT_TRUE(SwitchlessEnqueueRequest(queue->requests(), /*selector=*/3,
+                                       /*input=*/nullptr));
+
+  uint64_t selector;
+  MessageReader output;
+  ASSERT_TRUE(SwitchlessDequeueRequest(queue->requests(), &selector, &output));
+  EXPECT_EQ(selector, 3);
+  EXPECT_TRUE(output.empty());
+}
+
+TEST(SwitchlessCallQueueTest, OversizedRequestRejected) {
+  auto queue = absl::make_unique<SwitchlessCallQueue>();
+
+  std::string large(kSwitchlessQueueCapacity, 'x');
+  MessageWriter input;
+  input.PushByReference(Extent{large.data(), large.size()});
+  EXPECT_FALSE(SwitchlessEnqueueRequest(queue->requests(), /*selector=*/1,
+                                        &input));
+  EXPECT_TRUE(queue->requests()->empty());
+}
+
+TEST(SwitchlessCallQueueTest, ResponseRoundTripOk) {
+  auto queue = absl::make_unique<SwitchlessCallQueue>();
+
+  MessageWriter results;
+  results.Push<int32_t>(-5);
+  ASSERT_TRUE(SwitchlessEnqueueResponse(queue->responses(),
+                                        PrimitiveStatus::OkStatus(),
+                                        &results));
+
+  PrimitiveStatus status;
+  MessageReader output;
+  ASSERT_TRUE(
+      SwitchlessDequeueResponse(queue->responses(), &status, &output));
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(output.size(), 1);
+  EXPECT_EQ(output.next<int32_t>(), -5);
+}
+
+TEST(SwitchlessCallQueueTest, ResponseRoundTripError) {
+  auto queue = absl::make_unique<SwitchlessCallQueue>();
+
+  PrimitiveStatus failure{primitives::AbslStatusCode::kInvalidArgument,
+                          "bad argument"};
+  ASSERT_TRUE(SwitchlessEnqueueResponse(queue->responses(), failure,
+                                        /*output=*/nullptr));
+
+  PrimitiveStatus status;
+  MessageReader output;
+  ASSERT_TRUE(
+      SwitchlessDequeueResponse(queue->responses(), &status, &output));
+  EXPECT_EQ(status.error_code(),
+            primitives::AbslStatusCode::kInvalidArgument);
+  EXPECT_STREQ(status.error_message(), "bad argument");
+  EXPECT_TRUE(output.empty());
+}
+
+TEST(SwitchlessCallQueueTest, DequeueReturnsFalseWhenClosed) {
+  auto queue = absl::make_unique<SwitchlessCallQueue>();
+  queue->requests()->close_for_write();
+
+  uint64_t selector;
+  MessageReader output;
+  EXPECT_FALSE(
+      SwitchlessDequeueRequest(queue->requests(), &selector, &output));
+}
+
+}  // namespace
+}  // namespace primitives
+}  // namespace asylo
@@ -0,0 +1,109 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/switchless_client.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "asylo/util/logging.h"
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/primitives.h"
+#include "asylo/platform/primitives/util/status_conversions.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+namespace primitives {
+
+Status SwitchlessClient::Start(size_t num_workers) {
+  if (!channels_.empty()) {
+    return absl::FailedPreconditionError(
+        "SwitchlessClient::Start() may only be called once.");
+  }
+  if (num_workers == 0) {
+    return absl::InvalidArgumentError(
+        "SwitchlessClient requires at least one worker.");
+  }
+  for (size_t i = 0; i < num_workers; ++i) {
+    auto channel = absl::make_unique<WorkerChannel>();
+    channel->queue = absl::make_unique<SwitchlessCallQueue>();
+    SwitchlessCallQueue *queue = channel->queue.get();
+    std::shared_ptr<Client> client = client_;
+    // The donated thread enters the enclave once and stays resident inside
+    // the worker entry handler until the request ring is closed by Stop().
+    channel->thread = absl::make_unique<Thread>([client, queue] {
+      MessageWriter input;
+      input.Push<uint64_t>(reinterpret_cast<uint64_t>(queue));
+      MessageReader output;
+      Status status = client->EnclaveCall(kSelectorAsyloSwitchlessWorker,
+                                          &input, &output);
+      if (!status.ok()) {
+        LOG(ERROR) << "Switchless worker exited with status: " << status;
+      }
+    });
+    channels_.emplace_back(std::move(channel));
+  }
+  return absl::OkStatus();
+}
+
+Status SwitchlessClient::Call(uint64_t selector, MessageWriter *input,
+                              MessageReader *output) {
+  const size_t num_channels = channels_.size();
+  if (num_channels > 0) {
+    size_t start = next_channel_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < num_channels; ++i) {
+      WorkerChannel *channel = channels_[(start + i) % num_channels].get();
+      if (!channel->mu.TryLock()) {
+        continue;
+      }
+      SwitchlessCallQueue *queue = channel->queue.get();
+      if (queue->requests()->is_closed_for_write() ||
+          !SwitchlessEnqueueRequest(queue->requests(), selector, input)) {
+        // Oversized request or a stopped channel; use the regular path.
+        channel->mu.Unlock();
+        break;
+      }
+      PrimitiveStatus primitive_status;
+      if (!SwitchlessDequeueResponse(queue->responses(), &primitive_status,
+                                     output)) {
+        channel->mu.Unlock();
+        return absl::InternalError(
+            "Switchless call channel closed while awaiting a response.");
+      }
+      channel->mu.Unlock();
+      return MakeStatus(primitive_status);
+    }
+  }
+  return client_->EnclaveCall(selector, input, output);
+}
+
+void SwitchlessClient::Stop() {
+  for (auto &channel : channels_) {
+    if (channel->thread) {
+      channel->queue->requests()->close_for_write();
+      channel->thread->Join();
+      channel->thread.reset();
+    }
+  }
+}
+
+}  // namespace primitives
+}  // namespace asylo
@@ -0,0 +1,98 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_SWITCHLESS_CLIENT_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_SWITCHLESS_CLIENT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "asylo/platform/primitives/untrusted_primitives.h"
+#include "asylo/platform/primitives/util/message.h"
+#include "asylo/platform/primitives/util/switchless_call_queue.h"
+#include "asylo/util/asylo_macros.h"
+#include "asylo/util/status.h"
+#include "asylo/util/thread.h"
+
+namespace asylo {
+namespace primitives {
+
+// A wrapper around a primitives Client which executes enclave calls without
+// an enclave transition per call.
+//
+// On Start(), the wrapper donates a pool of untrusted threads to the enclave
+// via a single regular enclave call each. Each donated thread remains resident
+// inside the enclave, polling a SwitchlessCallQueue allocated in shared
+// untrusted memory. Call() serializes the request into a free worker's queue
+// and spins for the result, so that high-frequency small calls bypass the
+// backend's enclave entry and exit path entirely.
+//
+// Calls issued when no worker channel is free, when Start() has not been
+// called, or whose serialized form does not fit in a queue fall back to
+// Client::EnclaveCall() transparently.
+class SwitchlessClient {
+ public:
+  // Constructs a wrapper around |client|. The wrapped client must outlive the
+  // SwitchlessClient.
+  explicit SwitchlessClient(std::shared_ptr<Client> client)
+      : client_(std::move(client)) {}
+
+  ~SwitchlessClient() { Stop(); }
+
+  SwitchlessClient(const SwitchlessClient &) = delete;
+  SwitchlessClient &operator=(const SwitchlessClient &) = delete;
+
+  // Starts |num_workers| enclave-resident worker threads, each with its own
+  // call channel. May be called at most once.
+  Status Start(size_t num_workers) ASYLO_MUST_USE_RESULT;
+
+  // Executes an enclave call, switchlessly when a worker channel is
+  // available, and via Client::EnclaveCall() otherwise. The arguments have
+  // the same semantics as Client::EnclaveCall().
+  Status Call(uint64_t selector, MessageWriter *input,
+              MessageReader *output) ASYLO_MUST_USE_RESULT;
+
+  // Shuts down the worker pool, returning the donated threads from the
+  // enclave and joining them. Pending calls complete before the workers
+  // return. Safe to call multiple times, or without a prior Start().
+  void Stop();
+
+ private:
+  // One enclave-resident worker thread and its dedicated call channel. Each
+  // channel has exactly one untrusted writer (the caller holding |mu|) and
+  // one trusted reader (the worker), matching the RingBuffer contract.
+  struct WorkerChannel {
+    absl::Mutex mu;
+    std::unique_ptr<SwitchlessCallQueue> queue;
+    std::unique_ptr<Thread> thread;
+  };
+
+  std::shared_ptr<Client> client_;
+  std::vector<std::unique_ptr<WorkerChannel>> channels_;
+
+  // Round-robin hint for the first channel to try in Call().
+  std::atomic<size_t> next_channel_{0};
+};
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_SWITCHLESS_CLIENT_H_
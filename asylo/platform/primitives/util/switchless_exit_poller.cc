@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/switchless_exit_poller.h"
+
+#include <cstdint>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "asylo/util/logging.h"
+#include "asylo/platform/primitives/extent.h"
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/primitives.h"
+#include "asylo/platform/primitives/util/message.h"
+#include "asylo/platform/primitives/util/status_conversions.h"
+#include "asylo/util/status.h"
+
+namespace asylo {
+namespace primitives {
+
+Status SwitchlessExitPoller::Start(const std::vector<uint64_t> &selectors) {
+  if (queue_) {
+    return absl::FailedPreconditionError(
+        "SwitchlessExitPoller::Start() may only be called once.");
+  }
+  if (selectors.empty()) {
+    return absl::InvalidArgumentError(
+        "SwitchlessExitPoller requires at least one selector.");
+  }
+  queue_ = absl::make_unique<SwitchlessCallQueue>();
+
+  MessageWriter input;
+  input.Push<uint64_t>(reinterpret_cast<uint64_t>(queue_.get()));
+  input.PushByCopy(Extent{selectors.data(),
+                          selectors.size() * sizeof(uint64_t)});
+  MessageReader output;
+  Status status = client_->EnclaveCall(kSelectorAsyloSwitchlessExitInit,
+                                       &input, &output);
+  if (!status.ok()) {
+    queue_.reset();
+    return status;
+  }
+
+  SwitchlessCallQueue *queue = queue_.get();
+  std::shared_ptr<Client> client = client_;
+  thread_ = absl::make_unique<Thread>([client, queue] {
+    Client::ScopedCurrentClient scoped_client(client.get());
+    uint64_t selector;
+    MessageReader request;
+    while (SwitchlessDequeueRequest(queue->requests(), &selector, &request)) {
+      MessageWriter response;
+      Status handler_status = client->exit_call_provider()->InvokeExitHandler(
+          selector, &request, &response, client.get());
+      if (!SwitchlessEnqueueResponse(queue->responses(),
+                                     MakePrimitiveStatus(handler_status),
+                                     &response)) {
+        LOG(ERROR) << "Switchless exit response did not fit in the ring; "
+                      "closing the channel.";
+        break;
+      }
+      request = MessageReader();
+    }
+    queue->responses()->close_for_write();
+  });
+  return absl::OkStatus();
+}
+
+void SwitchlessExitPoller::Stop() {
+  if (!thread_) {
+    return;
+  }
+  // Disable switchless dispatch in the enclave first so that no trusted
+  // writer remains when the queue is torn down.
+  MessageWriter input;
+  input.Push<uint64_t>(0);
+  input.PushByCopy(Extent{nullptr, 0});
+  MessageReader output;
+  Status status = client_->EnclaveCall(kSelectorAsyloSwitchlessExitInit,
+                                       &input, &output);
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to disable switchless exit channel: " << status;
+  }
+  queue_->requests()->close_for_write();
+  thread_->Join();
+  thread_.reset();
+}
+
+}  // namespace primitives
+}  // namespace asylo
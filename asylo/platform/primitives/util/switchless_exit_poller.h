@@ -0,0 +1,77 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_SWITCHLESS_EXIT_POLLER_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_SWITCHLESS_EXIT_POLLER_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "asylo/platform/primitives/untrusted_primitives.h"
+#include "asylo/platform/primitives/util/switchless_call_queue.h"
+#include "asylo/util/asylo_macros.h"
+#include "asylo/util/status.h"
+#include "asylo/util/thread.h"
+
+namespace asylo {
+namespace primitives {
+
+// An untrusted poller thread completing enclave exit calls without an
+// enclave exit per call.
+//
+// On Start(), the poller allocates a SwitchlessCallQueue in untrusted memory
+// and registers it with the enclave together with the list of exit selectors
+// that should go switchless. Trusted code then places exit-call requests for
+// those selectors in the queue instead of leaving the enclave; the poller
+// thread dequeues each request, invokes the registered exit handler, and
+// writes the result back through the response ring.
+//
+// Only hot selectors should be enabled, since every switchless exit occupies
+// the poller thread for the duration of the host call.
+class SwitchlessExitPoller {
+ public:
+  // Constructs a poller for exit calls from |client|. The wrapped client must
+  // outlive the SwitchlessExitPoller.
+  explicit SwitchlessExitPoller(std::shared_ptr<Client> client)
+      : client_(std::move(client)) {}
+
+  ~SwitchlessExitPoller() { Stop(); }
+
+  SwitchlessExitPoller(const SwitchlessExitPoller &) = delete;
+  SwitchlessExitPoller &operator=(const SwitchlessExitPoller &) = delete;
+
+  // Enables switchless dispatch for |selectors| and starts the poller thread.
+  // May be called at most once.
+  Status Start(const std::vector<uint64_t> &selectors) ASYLO_MUST_USE_RESULT;
+
+  // Disables switchless dispatch in the enclave and joins the poller thread.
+  // In-flight calls complete first. Safe to call multiple times, or without a
+  // prior Start().
+  void Stop();
+
+ private:
+  std::shared_ptr<Client> client_;
+  std::unique_ptr<SwitchlessCallQueue> queue_;
+  std::unique_ptr<Thread> thread_;
+};
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_SWITCHLESS_EXIT_POLLER_H_
@@ -0,0 +1,94 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/timer_tick_thread.h"
+
+#include <time.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "asylo/util/logging.h"
+#include "asylo/platform/common/time_util.h"
+#include "asylo/platform/primitives/primitives.h"
+#include "asylo/platform/primitives/util/message.h"
+#include "asylo/util/status.h"
+#include "asylo/util/status_macros.h"
+
+namespace asylo {
+namespace primitives {
+
+namespace {
+
+// Enters the enclave with the current host time, advancing the timer wheel.
+Status Tick(Client *client) {
+  struct timespec realtime;
+  clock_gettime(CLOCK_REALTIME, &realtime);
+  MessageWriter input;
+  input.Push<uint64_t>(
+      static_cast<uint64_t>(TimeSpecToNanoseconds(&realtime) / 1000));
+  MessageReader output;
+  return client->EnclaveCall(kSelectorAsyloTimerTick, &input, &output);
+}
+
+}  // namespace
+
+Status TimerTickThread::Start(absl::Duration tick_interval) {
+  if (thread_) {
+    return absl::FailedPreconditionError(
+        "TimerTickThread::Start() may only be called once.");
+  }
+  if (tick_interval <= absl::ZeroDuration()) {
+    return absl::InvalidArgumentError(
+        "TimerTickThread requires a positive tick interval.");
+  }
+
+  // Deliver the first tick synchronously so the wheel is active by the time
+  // Start() returns.
+  ASYLO_RETURN_IF_ERROR(Tick(client_.get()));
+
+  Client *client = client_.get();
+  std::atomic<bool> *stop = &stop_;
+  thread_ = absl::make_unique<Thread>([client, stop, tick_interval] {
+    while (!stop->load(std::memory_order_relaxed)) {
+      absl::SleepFor(tick_interval);
+      Status status = Tick(client);
+      if (!status.ok()) {
+        LOG(ERROR) << "Timer tick failed: " << status;
+        return;
+      }
+    }
+  });
+  return absl::OkStatus();
+}
+
+void TimerTickThread::Stop() {
+  if (!thread_) {
+    return;
+  }
+  stop_ = true;
+  thread_->Join();
+  thread_.reset();
+}
+
+}  // namespace primitives
+}  // namespace asylo
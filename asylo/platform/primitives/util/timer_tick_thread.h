@@ -0,0 +1,74 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_TIMER_TICK_THREAD_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_TIMER_TICK_THREAD_H_
+
+#include <atomic>
+#include <memory>
+
+#include "absl/time/time.h"
+#include "asylo/platform/primitives/untrusted_primitives.h"
+#include "asylo/util/asylo_macros.h"
+#include "asylo/util/status.h"
+#include "asylo/util/thread.h"
+
+namespace asylo {
+namespace primitives {
+
+// An untrusted ticker thread driving the enclave's timer wheel, so that timed
+// waits inside the enclave are woken by one coarse periodic enclave entry
+// instead of one host timer per wait.
+//
+// On Start(), the ticker enters the enclave through kSelectorAsyloTimerTick
+// every tick interval, carrying the host's CLOCK_REALTIME reading; the
+// trusted handler advances the timer wheel and wakes every expired waiter.
+// Until the first tick arrives the wheel is inactive and timed waits inside
+// the enclave use host-side timeouts, so running a ticker is optional.
+class TimerTickThread {
+ public:
+  // Constructs a ticker driving the timer wheel of |client|. The wrapped
+  // client must outlive the TimerTickThread.
+  explicit TimerTickThread(std::shared_ptr<Client> client)
+      : client_(std::move(client)) {}
+
+  ~TimerTickThread() { Stop(); }
+
+  TimerTickThread(const TimerTickThread &) = delete;
+  TimerTickThread &operator=(const TimerTickThread &) = delete;
+
+  // Starts the ticker thread, entering the enclave every |tick_interval|.
+  // The interval bounds how late a timed wait is woken past its deadline.
+  // May be called at most once.
+  Status Start(absl::Duration tick_interval) ASYLO_MUST_USE_RESULT;
+
+  // Stops and joins the ticker thread. Timed waits already parked on the
+  // wheel are still bounded by their host-side backstop timeouts. Safe to
+  // call multiple times, or without a prior Start().
+  void Stop();
+
+ private:
+  std::shared_ptr<Client> client_;
+  std::unique_ptr<Thread> thread_;
+  std::atomic<bool> stop_{false};
+};
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_TIMER_TICK_THREAD_H_
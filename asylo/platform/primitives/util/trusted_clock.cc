@@ -0,0 +1,86 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/trusted_clock.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/trusted_primitives.h"
+#include "asylo/platform/primitives/util/shared_clock.h"
+
+namespace asylo {
+namespace primitives {
+
+namespace {
+
+// The installed clock page in untrusted memory, or null when clock reads are
+// dispatched as host calls. Written once per install/uninstall and read on
+// every served clock read.
+std::atomic<SharedClockPage *> shared_clock_page{nullptr};
+
+// Reads a consistent snapshot of the installed page. Returns false when no
+// page is installed or the page could not be read consistently.
+bool ReadSharedClock(int64_t *realtime_ns, int64_t *monotonic_ns) {
+  SharedClockPage *page = shared_clock_page.load(std::memory_order_acquire);
+  if (!page) {
+    return false;
+  }
+  return page->TryRead(realtime_ns, monotonic_ns);
+}
+
+}  // namespace
+
+bool SharedClockReadRealtime(int64_t *nanoseconds) {
+  int64_t realtime;
+  int64_t monotonic;
+  if (!ReadSharedClock(&realtime, &monotonic)) {
+    return false;
+  }
+  *nanoseconds = realtime;
+  return true;
+}
+
+bool SharedClockReadMonotonic(int64_t *nanoseconds) {
+  int64_t realtime;
+  int64_t monotonic;
+  if (!ReadSharedClock(&realtime, &monotonic)) {
+    return false;
+  }
+  *nanoseconds = monotonic;
+  return true;
+}
+
+PrimitiveStatus SharedClockInitEntry(void *context, MessageReader *in,
+                                     MessageWriter *out) {
+  if (in->size() != 1) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "SharedClockInitEntry expects exactly one input extent."};
+  }
+  auto *page = reinterpret_cast<SharedClockPage *>(in->next<uint64_t>());
+  if (page && !TrustedPrimitives::IsOutsideEnclave(page, sizeof(*page))) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "Shared clock page must reside in untrusted memory."};
+  }
+  shared_clock_page.store(page, std::memory_order_release);
+  return PrimitiveStatus::OkStatus();
+}
+
+}  // namespace primitives
+}  // namespace asylo
@@ -0,0 +1,54 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_CLOCK_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_CLOCK_H_
+
+#include <cstdint>
+
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/message.h"
+
+namespace asylo {
+namespace primitives {
+
+// Trusted side of the shared clock page. Once a SharedClockUpdater installs
+// its page, clock reads served from it complete without an enclave exit;
+// until then, and whenever the page cannot be read consistently, the readers
+// below report failure and the caller falls back to a host call.
+
+// Entry handler bound to kSelectorAsyloSharedClockInit. |in| carries one
+// uint64_t value: the untrusted address of a SharedClockPage, or 0 to
+// uninstall the page and restore host call dispatch for clock reads.
+PrimitiveStatus SharedClockInitEntry(void *context, MessageReader *in,
+                                     MessageWriter *out);
+
+// Reads CLOCK_REALTIME from the shared clock page into |nanoseconds|.
+// Returns false if no page is installed or no consistent snapshot could be
+// observed.
+bool SharedClockReadRealtime(int64_t *nanoseconds);
+
+// Reads CLOCK_MONOTONIC from the shared clock page into |nanoseconds|.
+// Returns false if no page is installed or no consistent snapshot could be
+// observed.
+bool SharedClockReadMonotonic(int64_t *nanoseconds);
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_CLOCK_H_
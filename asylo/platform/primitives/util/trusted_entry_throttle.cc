@@ -0,0 +1,173 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/trusted_entry_throttle.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include "asylo/platform/primitives/primitives.h"
+#include "asylo/platform/primitives/util/message.h"
+
+namespace asylo {
+namespace primitives {
+
+namespace {
+
+// Upper bound on classifiable selectors; matches the size of the entry table
+// in trusted_runtime_helper.cc.
+constexpr uint64_t kThrottledSelectorMax = 4096;
+
+// Bitmap of bulk-class selectors, one bit per selector. All bits start clear:
+// every selector is control class until explicitly reclassified.
+std::atomic<uint64_t> bulk_selector_bitmap[kThrottledSelectorMax / 64] = {};
+
+// Maximum number of concurrently executing bulk entries; 0 means unlimited.
+std::atomic<uint64_t> max_active_bulk(0);
+
+// Queueing statistics. The peak is maintained with a compare-exchange loop so
+// concurrent admissions cannot lose a high-water mark.
+std::atomic<uint64_t> control_admitted(0);
+std::atomic<uint64_t> bulk_admitted(0);
+std::atomic<uint64_t> bulk_throttled(0);
+std::atomic<uint64_t> active_bulk(0);
+std::atomic<uint64_t> peak_active_bulk(0);
+std::atomic<uint64_t> active_entries(0);
+std::atomic<uint64_t> peak_active_entries(0);
+
+bool IsBulkSelector(uint64_t selector) {
+  if (selector >= kThrottledSelectorMax) {
+    return false;
+  }
+  return (bulk_selector_bitmap[selector / 64].load(std::memory_order_relaxed) >>
+          (selector % 64)) &
+         1;
+}
+
+void UpdatePeak(std::atomic<uint64_t> *peak_counter, uint64_t active) {
+  uint64_t peak = peak_counter->load(std::memory_order_relaxed);
+  while (active > peak && !peak_counter->compare_exchange_weak(
+                              peak, active, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+ScopedEntryAdmission::ScopedEntryAdmission(uint64_t selector)
+    : admitted_(true), charged_bulk_(false) {
+  if (IsBulkSelector(selector)) {
+    uint64_t active = active_bulk.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t limit = max_active_bulk.load(std::memory_order_relaxed);
+    if (limit != 0 && active > limit) {
+      active_bulk.fetch_sub(1, std::memory_order_relaxed);
+      bulk_throttled.fetch_add(1, std::memory_order_relaxed);
+      admitted_ = false;
+      return;
+    }
+    charged_bulk_ = true;
+    bulk_admitted.fetch_add(1, std::memory_order_relaxed);
+    UpdatePeak(&peak_active_bulk, active);
+  } else {
+    control_admitted.fetch_add(1, std::memory_order_relaxed);
+  }
+  UpdatePeak(&peak_active_entries,
+             active_entries.fetch_add(1, std::memory_order_relaxed) + 1);
+}
+
+ScopedEntryAdmission::~ScopedEntryAdmission() {
+  if (admitted_) {
+    active_entries.fetch_sub(1, std::memory_order_relaxed);
+  }
+  if (charged_bulk_) {
+    active_bulk.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+PrimitiveStatus EntryThrottleEntry(void *context, MessageReader *in,
+                                   MessageWriter *out) {
+  if (in->size() < 1) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "Missing entry throttle command."};
+  }
+  uint64_t command = in->next<uint64_t>();
+  switch (command) {
+    case kEntryThrottleSetPriority: {
+      if (in->size() != 3) {
+        return {primitives::AbslStatusCode::kInvalidArgument,
+                "Malformed entry throttle priority request."};
+      }
+      uint64_t selector = in->next<uint64_t>();
+      uint64_t priority = in->next<uint64_t>();
+      if (selector < kSelectorUser || selector >= kThrottledSelectorMax) {
+        return {primitives::AbslStatusCode::kInvalidArgument,
+                "Only user selectors may be reclassified."};
+      }
+      if (priority != kEntryPriorityControl && priority != kEntryPriorityBulk) {
+        return {primitives::AbslStatusCode::kInvalidArgument,
+                "Unknown entry priority class."};
+      }
+      uint64_t mask = uint64_t{1} << (selector % 64);
+      if (priority == kEntryPriorityBulk) {
+        bulk_selector_bitmap[selector / 64].fetch_or(
+            mask, std::memory_order_relaxed);
+      } else {
+        bulk_selector_bitmap[selector / 64].fetch_and(
+            ~mask, std::memory_order_relaxed);
+      }
+      return PrimitiveStatus::OkStatus();
+    }
+    case kEntryThrottleSetBulkLimit: {
+      if (in->size() != 2) {
+        return {primitives::AbslStatusCode::kInvalidArgument,
+                "Malformed entry throttle limit request."};
+      }
+      max_active_bulk.store(in->next<uint64_t>(), std::memory_order_relaxed);
+      return PrimitiveStatus::OkStatus();
+    }
+    case kEntryThrottleSnapshot: {
+      EntryThrottleStats stats;
+      stats.control_admitted = control_admitted.load(std::memory_order_relaxed);
+      stats.bulk_admitted = bulk_admitted.load(std::memory_order_relaxed);
+      stats.bulk_throttled = bulk_throttled.load(std::memory_order_relaxed);
+      stats.active_bulk = active_bulk.load(std::memory_order_relaxed);
+      stats.peak_active_bulk =
+          peak_active_bulk.load(std::memory_order_relaxed);
+      stats.active_entries = active_entries.load(std::memory_order_relaxed);
+      stats.peak_active_entries =
+          peak_active_entries.load(std::memory_order_relaxed);
+      out->PushByCopy(Extent{&stats, sizeof(stats)});
+      return PrimitiveStatus::OkStatus();
+    }
+    case kEntryThrottleReset:
+      control_admitted.store(0, std::memory_order_relaxed);
+      bulk_admitted.store(0, std::memory_order_relaxed);
+      bulk_throttled.store(0, std::memory_order_relaxed);
+      peak_active_bulk.store(active_bulk.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+      peak_active_entries.store(
+          active_entries.load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+      return PrimitiveStatus::OkStatus();
+    default:
+      return {primitives::AbslStatusCode::kInvalidArgument,
+              "Unknown entry throttle command."};
+  }
+}
+
+}  // namespace primitives
+}  // namespace asylo
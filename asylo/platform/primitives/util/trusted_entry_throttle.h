@@ -0,0 +1,91 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_ENTRY_THROTTLE_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_ENTRY_THROTTLE_H_
+
+#include <cstdint>
+
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/message.h"
+
+namespace asylo {
+namespace primitives {
+
+// Priority-aware admission control for enclave entries. Every entry occupies
+// a TCS slot for its full duration, so a flood of bulk data calls can exhaust
+// the slots and starve latency-critical control entries. Selectors are split
+// into two classes: control (the default, never throttled) and bulk. When a
+// bulk concurrency limit is configured, a bulk entry arriving while the limit
+// many bulk entries are already executing is rejected with
+// kResourceExhausted before its handler runs, freeing the TCS slot
+// immediately; the untrusted caller retries. Runtime selectors below
+// kSelectorUser are always control class. Configure through the
+// kSelectorAsyloEntryThrottle entry handler; with no bulk selectors or no
+// limit configured, admission is a pass-through.
+
+// Counters exported by the kEntryThrottleSnapshot command. Admission and
+// rejection totals are cumulative since load or the last kEntryThrottleReset;
+// the active and peak counts describe concurrently executing bulk entries.
+struct EntryThrottleStats {
+  uint64_t control_admitted;
+  uint64_t bulk_admitted;
+  uint64_t bulk_throttled;
+  uint64_t active_bulk;
+  uint64_t peak_active_bulk;
+
+  // Concurrently executing entries of either class, as seen from inside the
+  // enclave. The peak is the trusted-side view of TCS pool pressure and
+  // should track the untrusted CallMetrics entry concurrency gauge.
+  uint64_t active_entries;
+  uint64_t peak_active_entries;
+};
+
+// Charges one admission for |selector| on construction and releases it on
+// destruction. The class the entry was charged against is captured at
+// admission time, so reclassifying a selector while calls are in flight
+// cannot skew the active count.
+class ScopedEntryAdmission {
+ public:
+  explicit ScopedEntryAdmission(uint64_t selector);
+  ~ScopedEntryAdmission();
+
+  ScopedEntryAdmission(const ScopedEntryAdmission &) = delete;
+  ScopedEntryAdmission &operator=(const ScopedEntryAdmission &) = delete;
+
+  // Returns false if the entry was rejected because the bulk concurrency
+  // limit was reached; the caller must not run the entry handler.
+  bool admitted() const { return admitted_; }
+
+ private:
+  bool admitted_;
+  bool charged_bulk_;
+};
+
+// Entry handler bound to kSelectorAsyloEntryThrottle. |in| carries one uint64
+// command word (see primitives.h) followed by command arguments:
+// kEntryThrottleSetPriority takes [uint64 selector, uint64 priority class],
+// kEntryThrottleSetBulkLimit takes [uint64 limit] with 0 meaning unlimited,
+// and kEntryThrottleSnapshot pushes one EntryThrottleStats to |out|.
+PrimitiveStatus EntryThrottleEntry(void *context, MessageReader *in,
+                                   MessageWriter *out);
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_ENTRY_THROTTLE_H_
@@ -0,0 +1,90 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/trusted_init_timing.h"
+
+#include <cstdint>
+
+#include "asylo/platform/core/trusted_spin_lock.h"
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/message.h"
+#include "asylo/platform/system_call/sysno.h"
+#include "asylo/platform/system_call/system_call.h"
+#include "asylo/platform/system_call/type_conversions/types_functions.h"
+#include "asylo/util/lock_guard.h"
+
+namespace asylo {
+namespace primitives {
+
+namespace {
+
+// Maximum number of initialization phases retained.
+constexpr int kMaxInitPhases = 16;
+
+// A statically initialized record of the stamped initialization phases.
+// Entries are appended under |lock| and never removed.
+struct {
+  TrustedSpinLock lock{/*is_recursive=*/false};
+  int count = 0;
+  uint64_t phases[kMaxInitPhases];
+  uint64_t timestamps[kMaxInitPhases];
+} init_timing;
+
+// Returns the host wall clock in nanoseconds, or 0 before the system call
+// dispatcher is installed. gettimeofday is used because it is the finest
+// grained time source available from the serialized system call layer, which
+// is the only exit path guaranteed to work this early in initialization.
+uint64_t InitTimingClock() {
+  if (!enc_is_syscall_dispatcher_set()) {
+    return 0;
+  }
+  struct kLinux_timeval tv;
+  if (enc_untrusted_syscall(asylo::system_call::kSYS_gettimeofday, &tv,
+                            nullptr) != 0) {
+    return 0;
+  }
+  return (static_cast<uint64_t>(tv.kLinux_tv_sec) * 1000000 +
+          static_cast<uint64_t>(tv.kLinux_tv_usec)) *
+         1000;
+}
+
+}  // namespace
+
+void RecordInitPhase(uint64_t phase) {
+  uint64_t now = InitTimingClock();
+  LockGuard lock(&init_timing.lock);
+  if (init_timing.count < kMaxInitPhases) {
+    init_timing.phases[init_timing.count] = phase;
+    init_timing.timestamps[init_timing.count] = now;
+    ++init_timing.count;
+  }
+}
+
+PrimitiveStatus InitTimingEntry(void *context, MessageReader *in,
+                                MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 0);
+  LockGuard lock(&init_timing.lock);
+  for (int i = 0; i < init_timing.count; ++i) {
+    out->Push<uint64_t>(init_timing.phases[i]);
+    out->Push<uint64_t>(init_timing.timestamps[i]);
+  }
+  return PrimitiveStatus::OkStatus();
+}
+
+}  // namespace primitives
+}  // namespace asylo
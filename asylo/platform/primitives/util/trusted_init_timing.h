@@ -0,0 +1,51 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_INIT_TIMING_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_INIT_TIMING_H_
+
+#include <cstdint>
+
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/message.h"
+
+namespace asylo {
+namespace primitives {
+
+// Phase-stamped timing of enclave initialization. The runtime stamps each
+// phase of initialization as it completes, and the untrusted loader reads the
+// resulting timeline through kSelectorAsyloInitTiming to attribute cold-start
+// latency to individual subsystems.
+
+// Records that the initialization phase |phase| (one of the kInitPhase
+// constants in primitives.h) completed now. The timestamp is the host wall
+// clock in nanoseconds, read with a single enclave exit; a phase is stamped
+// with 0 if no system call dispatcher is installed yet. Recording is a no-op
+// once the phase table is full.
+void RecordInitPhase(uint64_t phase);
+
+// Entry handler bound to kSelectorAsyloInitTiming. Takes no input and pushes
+// a pair [uint64 phase, uint64 wall-clock nanoseconds] to |out| for every
+// phase recorded, in recording order.
+PrimitiveStatus InitTimingEntry(void *context, MessageReader *in,
+                                MessageWriter *out);
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_INIT_TIMING_H_
@@ -0,0 +1,149 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/trusted_profiler.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "asylo/platform/core/trusted_spin_lock.h"
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/trusted_primitives.h"
+#include "asylo/platform/primitives/trusted_runtime.h"
+#include "asylo/platform/primitives/util/profiler_sample.h"
+
+namespace asylo {
+namespace primitives {
+
+namespace {
+
+// Countdown re-arm value used while profiling is disabled. The slow path
+// then runs once per this many checkpoints to notice a later enable, which
+// is cheap enough to be unmeasurable.
+constexpr uint64_t kDisabledRearm = 4096;
+
+// Profiler state shared by all threads. The spin lock serializes writers on
+// the single-writer export ring; contended samples are dropped, which is
+// acceptable for a statistical profiler.
+struct {
+  TrustedSpinLock lock{/*is_recursive=*/false};
+  ProfilerSampleBuffer *buffer = nullptr;
+  uint64_t period = kDisabledRearm;
+} profiler_state;
+
+// FNV-1a hash over the captured program counters.
+uint64_t HashStack(const uint64_t *pcs, uint64_t depth) {
+  uint64_t hash = UINT64_C(14695981039346656037);
+  for (uint64_t i = 0; i < depth; ++i) {
+    const char *bytes = reinterpret_cast<const char *>(&pcs[i]);
+    for (size_t b = 0; b < sizeof(uint64_t); ++b) {
+      hash = (hash ^ static_cast<uint8_t>(bytes[b])) * UINT64_C(1099511628211);
+    }
+  }
+  return hash;
+}
+
+// A frame as laid out by -fno-omit-frame-pointer code.
+struct Frame {
+  Frame *next;
+  uint64_t return_address;
+};
+
+// Walks the calling thread's frame-pointer chain, stopping at the first
+// frame that leaves trusted memory. Returns the captured depth.
+uint64_t CaptureStack(uint64_t *pcs) {
+  Frame *frame = reinterpret_cast<Frame *>(__builtin_frame_address(0));
+  uint64_t depth = 0;
+  while (depth < kProfilerMaxFrames && frame &&
+         TrustedPrimitives::IsInsideEnclave(frame, sizeof(Frame)) &&
+         frame->return_address != 0 &&
+         TrustedPrimitives::IsInsideEnclave(
+             reinterpret_cast<void *>(frame->return_address), 1)) {
+    pcs[depth++] = frame->return_address;
+    if (frame->next <= frame) {
+      // Refuse to follow a chain that does not grow toward the stack base.
+      break;
+    }
+    frame = frame->next;
+  }
+  return depth;
+}
+
+}  // namespace
+
+uint64_t *ProfilerCountdownCell() {
+  // Starts at 1 so the first checkpoint of each thread consults the profiler
+  // state and picks up the configured period.
+  thread_local uint64_t countdown = 1;
+  return &countdown;
+}
+
+void ProfilerTakeSample() {
+  // Re-arm the countdown first so a drop below still samples later.
+  *ProfilerCountdownCell() =
+      profiler_state.buffer ? profiler_state.period : kDisabledRearm;
+  if (!profiler_state.buffer) {
+    return;
+  }
+
+  ProfilerSampleRecord record;
+  record.thread_id = enc_thread_self();
+  record.depth = CaptureStack(record.pcs);
+  if (record.depth == 0) {
+    return;
+  }
+  record.stack_hash = HashStack(record.pcs, record.depth);
+
+  if (!profiler_state.lock.TryLock()) {
+    return;
+  }
+  ProfilerSampleBuffer *buffer = profiler_state.buffer;
+  if (buffer && buffer->available() >= sizeof(record) &&
+      !buffer->is_closed_for_read()) {
+    buffer->Write(reinterpret_cast<const uint8_t *>(&record), sizeof(record));
+  }
+  profiler_state.lock.Unlock();
+}
+
+PrimitiveStatus ProfilerInitEntry(void *context, MessageReader *in,
+                                  MessageWriter *out) {
+  if (in->size() != 2) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "ProfilerInitEntry expects exactly two input extents."};
+  }
+  auto *buffer = reinterpret_cast<ProfilerSampleBuffer *>(in->next<uint64_t>());
+  uint64_t period = in->next<uint64_t>();
+  if (buffer &&
+      !TrustedPrimitives::IsOutsideEnclave(buffer, sizeof(*buffer))) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "Profiler sample buffer must reside in untrusted memory."};
+  }
+  if (buffer && period == 0) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "Profiler sampling period must be nonzero."};
+  }
+
+  profiler_state.lock.Lock();
+  profiler_state.buffer = buffer;
+  profiler_state.period = buffer ? period : kDisabledRearm;
+  profiler_state.lock.Unlock();
+  return PrimitiveStatus::OkStatus();
+}
+
+}  // namespace primitives
+}  // namespace asylo
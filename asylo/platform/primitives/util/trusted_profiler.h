@@ -0,0 +1,65 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_PROFILER_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_PROFILER_H_
+
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/message.h"
+
+namespace asylo {
+namespace primitives {
+
+// In-enclave sampling profiler. Since perf cannot observe trusted code, hot
+// trusted paths are annotated with ASYLO_PROFILER_CHECKPOINT(); every Nth
+// checkpoint per thread captures the calling thread's frame-pointer chain,
+// hashes it, and exports the sample through a RingBuffer in untrusted shared
+// memory for the untrusted SamplingProfilerCollector to drain and symbolize.
+//
+// Checkpoints compile to a thread-local counter decrement when profiling is
+// disabled, so annotations can remain in production code.
+
+// Entry handler bound to kSelectorAsyloProfilerInit. |in| carries two
+// uint64_t values: the untrusted address of a ProfilerSampleBuffer (0 to
+// disable profiling), and the sampling period in checkpoints.
+PrimitiveStatus ProfilerInitEntry(void *context, MessageReader *in,
+                                  MessageWriter *out);
+
+// Implements the checkpoint slow path: captures and exports one sample.
+// Called by ASYLO_PROFILER_CHECKPOINT() when the thread's sample counter
+// expires; not intended to be called directly.
+void ProfilerTakeSample();
+
+// Returns the calling thread's checkpoint countdown cell.
+uint64_t *ProfilerCountdownCell();
+
+}  // namespace primitives
+}  // namespace asylo
+
+// Marks a sampling checkpoint in hot trusted code. Cheap when profiling is
+// disabled: a thread-local decrement and a predictable branch.
+#define ASYLO_PROFILER_CHECKPOINT()                                \
+  do {                                                             \
+    uint64_t *asylo_profiler_countdown =                           \
+        ::asylo::primitives::ProfilerCountdownCell();              \
+    if (--*asylo_profiler_countdown == 0) {                        \
+      ::asylo::primitives::ProfilerTakeSample();                   \
+    }                                                              \
+  } while (0)
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_PROFILER_H_
@@ -30,6 +30,14 @@
 #include "asylo/platform/primitives/trusted_primitives.h"
 #include "asylo/platform/primitives/trusted_runtime.h"
 #include "asylo/platform/primitives/util/message.h"
+#include "asylo/platform/primitives/util/trusted_clock.h"
+#include "asylo/platform/primitives/util/trusted_entry_throttle.h"
+#include "asylo/platform/primitives/util/trusted_init_timing.h"
+#include "asylo/platform/primitives/util/trusted_profiler.h"
+#include "asylo/platform/primitives/util/trusted_spin_calibration.h"
+#include "asylo/platform/primitives/util/trusted_switchless.h"
+#include "asylo/platform/primitives/util/trusted_timer.h"
+#include "asylo/platform/system_call/system_call.h"
 #include "asylo/util/lock_guard.h"
 #include "asylo/util/status_macros.h"
 
@@ -75,18 +83,177 @@ PrimitiveStatus ReservedEntry(void *context, MessageReader *in,
           "Invalid call to reserved selector."};
 }
 
+// Entry handler bound to kSelectorAsyloBatchCall. Executes a sequence of
+// enclave calls flattened into |in| by Client::EnclaveCallBatch() and writes
+// the per-call statuses and results to |out|.
+PrimitiveStatus BatchCallEntry(void *context, MessageReader *in,
+                               MessageWriter *out) {
+  if (in->size() % 2 != 0) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "Malformed batch call request."};
+  }
+  while (in->hasNext()) {
+    uint64_t selector = in->next<uint64_t>();
+    Extent payload = in->next();
+    MessageReader call_input;
+    if (payload.size() > 0) {
+      call_input.Deserialize(payload.data(), payload.size());
+    }
+    MessageWriter call_output;
+    PrimitiveStatus status =
+        InvokeEntryHandler(selector, &call_input, &call_output);
+
+    uint32_t code = status.error_code();
+    out->Push<uint32_t>(code);
+    out->PushByCopy(
+        Extent{status.error_message(), strlen(status.error_message())});
+    size_t output_size = status.ok() ? call_output.MessageSize() : 0;
+    std::vector<char> serialized(output_size);
+    if (output_size > 0) {
+      call_output.Serialize(serialized.data());
+    }
+    out->PushByCopy(Extent{serialized.data(), serialized.size()});
+  }
+  return PrimitiveStatus::OkStatus();
+}
+
+// Time source for system call latency accounting, backed by the shared clock
+// page when one has been installed. Returns 0 before the page is configured,
+// which degrades statistics to invocation counts only.
+uint64_t SyscallStatsClock() {
+  int64_t nanoseconds;
+  return SharedClockReadMonotonic(&nanoseconds) ? nanoseconds : 0;
+}
+
+// Entry handler bound to kSelectorAsyloSyscallStats. |in| carries one uint64
+// command word (see primitives.h). For kSyscallStatsSnapshot, pushes a pair
+// [uint64 sysno, struct SyscallStats] to |out| for every system call number
+// with a nonzero invocation count; the other commands produce no output.
+PrimitiveStatus SyscallStatsEntry(void *context, MessageReader *in,
+                                  MessageWriter *out) {
+  ASYLO_RETURN_IF_INCORRECT_READER_ARGUMENTS(*in, 1);
+  uint64_t command = in->next<uint64_t>();
+  switch (command) {
+    case kSyscallStatsEnable:
+      if (!enc_is_syscall_clock_set()) {
+        enc_set_syscall_clock(&SyscallStatsClock);
+      }
+      enc_set_syscall_stats_enabled(true);
+      return PrimitiveStatus::OkStatus();
+    case kSyscallStatsDisable:
+      enc_set_syscall_stats_enabled(false);
+      return PrimitiveStatus::OkStatus();
+    case kSyscallStatsReset:
+      enc_reset_syscall_stats();
+      return PrimitiveStatus::OkStatus();
+    case kSyscallStatsSnapshot: {
+      struct SyscallStats stats;
+      for (int sysno = 0; enc_read_syscall_stats(sysno, &stats); sysno++) {
+        if (stats.count > 0) {
+          out->Push<uint64_t>(sysno);
+          out->PushByCopy(Extent{&stats, sizeof(stats)});
+        }
+      }
+      return PrimitiveStatus::OkStatus();
+    }
+    default:
+      return {primitives::AbslStatusCode::kInvalidArgument,
+              "Unknown syscall stats command."};
+  }
+}
+
 // Initializes the enclave if it has not been initialized already.
 void EnsureInitialized() {
   LockGuard lock(&enclave_state.initialization_lock);
   if (!(enclave_state.flags & Flag::kInitialized)) {
+    RecordInitPhase(kInitPhaseFirstEntry);
+
+    // Register the switchless call worker entry point.
+    if (!TrustedPrimitives::RegisterEntryHandler(
+             kSelectorAsyloSwitchlessWorker,
+             EntryHandler{SwitchlessWorkerEntry})
+             .ok()) {
+      TrustedPrimitives::BestEffortAbort(
+          "Could not register switchless worker handler");
+    }
+
+    // Register the switchless exit call configuration entry point.
+    if (!TrustedPrimitives::RegisterEntryHandler(
+             kSelectorAsyloSwitchlessExitInit,
+             EntryHandler{SwitchlessExitInitEntry})
+             .ok()) {
+      TrustedPrimitives::BestEffortAbort(
+          "Could not register switchless exit init handler");
+    }
+
+    // Register the batched enclave call entry point.
+    if (!TrustedPrimitives::RegisterEntryHandler(kSelectorAsyloBatchCall,
+                                                 EntryHandler{BatchCallEntry})
+             .ok()) {
+      TrustedPrimitives::BestEffortAbort(
+          "Could not register batch call handler");
+    }
+
+    // Register the sampling profiler configuration entry point.
+    if (!TrustedPrimitives::RegisterEntryHandler(
+             kSelectorAsyloProfilerInit, EntryHandler{ProfilerInitEntry})
+             .ok()) {
+      TrustedPrimitives::BestEffortAbort(
+          "Could not register profiler init handler");
+    }
+
+    // Register the shared clock page configuration entry point.
+    if (!TrustedPrimitives::RegisterEntryHandler(
+             kSelectorAsyloSharedClockInit,
+             EntryHandler{SharedClockInitEntry})
+             .ok()) {
+      TrustedPrimitives::BestEffortAbort(
+          "Could not register shared clock init handler");
+    }
+
+    // Register the syscall statistics control entry point.
+    if (!TrustedPrimitives::RegisterEntryHandler(
+             kSelectorAsyloSyscallStats, EntryHandler{SyscallStatsEntry})
+             .ok()) {
+      TrustedPrimitives::BestEffortAbort(
+          "Could not register syscall stats handler");
+    }
+
+    // Register the initialization timing entry point.
+    if (!TrustedPrimitives::RegisterEntryHandler(
+             kSelectorAsyloInitTiming, EntryHandler{InitTimingEntry})
+             .ok()) {
+      TrustedPrimitives::BestEffortAbort(
+          "Could not register init timing handler");
+    }
+
+    // Register the entry throttle configuration entry point.
+    if (!TrustedPrimitives::RegisterEntryHandler(
+             kSelectorAsyloEntryThrottle, EntryHandler{EntryThrottleEntry})
+             .ok()) {
+      TrustedPrimitives::BestEffortAbort(
+          "Could not register entry throttle handler");
+    }
+
+    // Register the timer wheel tick entry point.
+    if (!TrustedPrimitives::RegisterEntryHandler(kSelectorAsyloTimerTick,
+                                                 EntryHandler{TimerTickEntry})
+             .ok()) {
+      TrustedPrimitives::BestEffortAbort(
+          "Could not register timer tick handler");
+    }
+
     // Register placeholder handlers for reserved entry points.
-    for (uint64_t i = kSelectorAsyloFini + 1; i < kSelectorUser; i++) {
+    for (uint64_t i = kSelectorAsyloTimerTick + 1; i < kSelectorUser;
+         i++) {
       EntryHandler handler{ReservedEntry};
       if (!TrustedPrimitives::RegisterEntryHandler(i, handler).ok()) {
         TrustedPrimitives::BestEffortAbort("Could not register entry handler");
       }
     }
 
+    RecordInitPhase(kInitPhaseRuntimeHandlersRegistered);
+
     // Invoke the user-defined initialization routine.
     if (!asylo_enclave_init().ok()) {
       TrustedPrimitives::BestEffortAbort(
@@ -97,7 +264,13 @@ void EnsureInitialized() {
     // Register runtime handlers. Implemented by backends utilizing this shim.
     RegisterInternalHandlers();
 
+    // Measure the enclave transition cost and publish spin budgets for the
+    // trusted synchronization primitives. Host calls are available by now;
+    // locks taken earlier used the conservative defaults.
+    CalibrateSpinBudgets();
+
     MarkEnclaveInitialized();
+    RecordInitPhase(kInitPhaseRuntimeInitialized);
   }
 }
 
@@ -134,6 +307,15 @@ PrimitiveStatus InvokeEntryHandler(uint64_t selector, MessageReader *in,
             "Invalid selector passed in call to asylo_enclave_call."};
   }
 
+  // Admit the entry against its priority class. A rejected bulk entry returns
+  // immediately, freeing its TCS slot for control entries; a call that waited
+  // here instead would keep the slot pinned and defeat the throttle.
+  ScopedEntryAdmission admission(selector);
+  if (!admission.admitted()) {
+    return {primitives::AbslStatusCode::kResourceExhausted,
+            "Bulk entry concurrency limit reached."};
+  }
+
   // Invoke the entry point handler.
   auto &handler = enclave_state.entry_table[selector];
 
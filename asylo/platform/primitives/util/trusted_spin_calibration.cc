@@ -0,0 +1,174 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/trusted_spin_calibration.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include "asylo/platform/primitives/trusted_runtime.h"
+#include "asylo/platform/system_call/sysno.h"
+#include "asylo/platform/system_call/system_call.h"
+#include "asylo/platform/system_call/type_conversions/types_functions.h"
+
+namespace asylo {
+namespace primitives {
+
+namespace {
+
+// Defaults in effect until calibration runs, matching the budgets the
+// primitives shipped with before calibration existed.
+constexpr uint64_t kDefaultPausesPerTransition = 10000;
+constexpr uint64_t kDefaultMaxBackoffPauses = 64;
+
+// Bounds on the published budgets, protecting the primitives from a
+// mismeasured clock (for example, the host stepping the wall clock in the
+// middle of the calibration).
+constexpr uint64_t kMinPausesPerTransition = 256;
+constexpr uint64_t kMaxPausesPerTransition = 1 << 20;
+constexpr uint64_t kMinBackoffPauses = 16;
+constexpr uint64_t kMaxBackoffPausesBound = 1024;
+
+// Number of host-call round trips averaged for the transition cost, and the
+// enc_pause() burst timed for the pause cost. Together well under a
+// millisecond of one-time boot work.
+constexpr uint64_t kTransitionSamples = 16;
+constexpr uint64_t kPauseSamples = 64 * 1024;
+
+// Published budgets. Relaxed atomics suffice: readers only need a consistent
+// value, not ordering against the measurement that produced it.
+std::atomic<uint64_t> published_pauses_per_transition{
+    kDefaultPausesPerTransition};
+std::atomic<uint64_t> published_max_backoff_pauses{kDefaultMaxBackoffPauses};
+std::atomic<bool> published_measured{false};
+
+// Returns the host wall clock in nanoseconds through the serialized system
+// call layer, the only exit path guaranteed to work this early in
+// initialization, or 0 on failure. Each call is itself one enclave exit and
+// re-entry, which the calibration exploits to time transitions.
+uint64_t CalibrationClock() {
+  struct kLinux_timeval tv;
+  if (enc_untrusted_syscall(asylo::system_call::kSYS_gettimeofday, &tv,
+                            nullptr) != 0) {
+    return 0;
+  }
+  return (static_cast<uint64_t>(tv.kLinux_tv_sec) * 1000000 +
+          static_cast<uint64_t>(tv.kLinux_tv_usec)) *
+         1000;
+}
+
+uint64_t Clamp(uint64_t value, uint64_t lo, uint64_t hi) {
+  if (value < lo) return lo;
+  if (value > hi) return hi;
+  return value;
+}
+
+}  // namespace
+
+SpinCalibration ComputeSpinCalibration(uint64_t transition_nanos,
+                                       uint64_t pause_nanos_x1024) {
+  SpinCalibration calibration;
+  if (transition_nanos == 0 || pause_nanos_x1024 == 0) {
+    calibration.pauses_per_transition = kDefaultPausesPerTransition;
+    calibration.max_backoff_pauses = kDefaultMaxBackoffPauses;
+    calibration.measured = false;
+    return calibration;
+  }
+  calibration.pauses_per_transition =
+      Clamp(transition_nanos * 1024 / pause_nanos_x1024,
+            kMinPausesPerTransition, kMaxPausesPerTransition);
+  // A waiter tolerating a stale lock word for about 1/64th of a transition
+  // keeps the latency of noticing an unlock negligible next to the exit the
+  // back-off is avoiding.
+  calibration.max_backoff_pauses =
+      Clamp(calibration.pauses_per_transition / 64, kMinBackoffPauses,
+            kMaxBackoffPausesBound);
+  calibration.measured = true;
+  return calibration;
+}
+
+SpinCalibration GetSpinCalibration() {
+  SpinCalibration calibration;
+  calibration.pauses_per_transition =
+      published_pauses_per_transition.load(std::memory_order_relaxed);
+  calibration.max_backoff_pauses =
+      published_max_backoff_pauses.load(std::memory_order_relaxed);
+  calibration.measured = published_measured.load(std::memory_order_relaxed);
+  return calibration;
+}
+
+uint64_t MaxSpinPausesBeforeWait() {
+  return published_pauses_per_transition.load(std::memory_order_relaxed);
+}
+
+uint64_t MaxBackoffPauses() {
+  return published_max_backoff_pauses.load(std::memory_order_relaxed);
+}
+
+void CalibrateSpinBudgets() {
+  if (!enc_is_syscall_dispatcher_set()) {
+    return;
+  }
+
+  // Transition cost: the clock reads are host-call round trips themselves,
+  // so a run of consecutive reads times exactly the transition being
+  // measured.
+  uint64_t start = CalibrationClock();
+  if (start == 0) {
+    return;
+  }
+  for (uint64_t i = 0; i + 1 < kTransitionSamples; ++i) {
+    if (CalibrationClock() == 0) {
+      return;
+    }
+  }
+  uint64_t end = CalibrationClock();
+  if (end <= start) {
+    return;
+  }
+  const uint64_t transition_nanos = (end - start) / kTransitionSamples;
+
+  // Pause cost: one burst of pauses between two clock reads, with the single
+  // enclosed transition subtracted back out.
+  start = CalibrationClock();
+  for (uint64_t i = 0; i < kPauseSamples; ++i) {
+    enc_pause();
+  }
+  end = CalibrationClock();
+  if (start == 0 || end <= start) {
+    return;
+  }
+  uint64_t burst_nanos = end - start;
+  burst_nanos = burst_nanos > transition_nanos ? burst_nanos - transition_nanos
+                                               : 0;
+  const uint64_t pause_nanos_x1024 = burst_nanos * 1024 / kPauseSamples;
+
+  SpinCalibration calibration =
+      ComputeSpinCalibration(transition_nanos, pause_nanos_x1024);
+  if (!calibration.measured) {
+    return;
+  }
+  published_pauses_per_transition.store(calibration.pauses_per_transition,
+                                        std::memory_order_relaxed);
+  published_max_backoff_pauses.store(calibration.max_backoff_pauses,
+                                     std::memory_order_relaxed);
+  published_measured.store(true, std::memory_order_relaxed);
+}
+
+}  // namespace primitives
+}  // namespace asylo
@@ -0,0 +1,82 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_SPIN_CALIBRATION_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_SPIN_CALIBRATION_H_
+
+#include <cstdint>
+
+namespace asylo {
+namespace primitives {
+
+// Boot-time calibration of busy-wait budgets for the trusted synchronization
+// primitives.
+//
+// How long a lock should spin before paying for an enclave exit depends on
+// the cost of that exit, which varies by more than an order of magnitude
+// between SGX hardware generations and the simulation backend. Rather than
+// each primitive hardcoding a budget tuned for one configuration, the runtime
+// measures the enclave transition cost and the cost of one enc_pause() once
+// during initialization and publishes budgets derived from their ratio.
+
+// Spin budgets published by the calibration. All values are counts of
+// enc_pause() iterations.
+struct SpinCalibration {
+  // Iterations costing about as much wall-clock time as one enclave exit and
+  // re-entry. This is the point of indifference for a contended lock: a
+  // waiter that spins longer than this would have been better off sleeping
+  // on the host from the start.
+  uint64_t pauses_per_transition;
+
+  // Longest back-off burst a spinning waiter should issue between lock
+  // probes. Bounds how stale a waiter's view of the lock word can become
+  // relative to the cost of re-checking it.
+  uint64_t max_backoff_pauses;
+
+  // True when the budgets were measured at boot; false while the
+  // conservative compile-time defaults are still in effect.
+  bool measured;
+};
+
+// Returns the current calibration. Thread-safe. Returns the compile-time
+// defaults until CalibrateSpinBudgets() has run.
+SpinCalibration GetSpinCalibration();
+
+// Accessors for the individual budgets, cheap enough for a lock's contended
+// path: each is a single relaxed atomic load.
+uint64_t MaxSpinPausesBeforeWait();
+uint64_t MaxBackoffPauses();
+
+// Derives budgets from measured costs. |transition_nanos| is the wall-clock
+// cost of one enclave exit/re-entry round trip; |pause_nanos_x1024| is the
+// cost of 1024 enc_pause() iterations. Either value being zero yields the
+// unmeasured defaults. Exposed separately from CalibrateSpinBudgets() so the
+// derivation is independent of the measurement machinery.
+SpinCalibration ComputeSpinCalibration(uint64_t transition_nanos,
+                                       uint64_t pause_nanos_x1024);
+
+// Measures the transition and pause costs and publishes the derived budgets.
+// Called once from the runtime initialization path; leaves the defaults in
+// effect when the system call dispatcher is not yet installed or the host
+// clock misbehaves during the measurement.
+void CalibrateSpinBudgets();
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_SPIN_CALIBRATION_H_
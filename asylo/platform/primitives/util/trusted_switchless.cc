@@ -0,0 +1,150 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/trusted_switchless.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "asylo/platform/core/trusted_spin_lock.h"
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/trusted_primitives.h"
+#include "asylo/platform/primitives/util/switchless_call_queue.h"
+#include "asylo/platform/primitives/util/trusted_runtime_helper.h"
+#include "asylo/util/lock_guard.h"
+
+namespace asylo {
+namespace primitives {
+
+namespace {
+
+// Maximum number of exit selectors that may be routed switchlessly. The list
+// is scanned linearly on every exit call attempt, so it is intentionally
+// limited to a handful of hot selectors.
+constexpr size_t kMaxSwitchlessExitSelectors = 32;
+
+// The switchless exit channel. The spin lock serializes the channel's single
+// trusted writer with configuration changes; contended or oversized exit
+// calls fall back to a regular enclave exit instead of blocking here.
+struct {
+  TrustedSpinLock lock{/*is_recursive=*/false};
+  SwitchlessCallQueue *queue = nullptr;
+  uint64_t selectors[kMaxSwitchlessExitSelectors];
+  size_t num_selectors = 0;
+} exit_channel;
+
+// Returns true if |selector| is enabled for switchless dispatch. The caller
+// must hold exit_channel.lock.
+bool IsSwitchlessExitSelector(uint64_t selector) {
+  for (size_t i = 0; i < exit_channel.num_selectors; ++i) {
+    if (exit_channel.selectors[i] == selector) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+PrimitiveStatus SwitchlessWorkerEntry(void *context, MessageReader *in,
+                                      MessageWriter *out) {
+  if (in->size() != 1) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "SwitchlessWorkerEntry expects exactly one input extent."};
+  }
+  auto *queue =
+      reinterpret_cast<SwitchlessCallQueue *>(in->next<uint64_t>());
+  if (!TrustedPrimitives::IsOutsideEnclave(queue, sizeof(*queue))) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "Switchless call queue must reside in untrusted memory."};
+  }
+
+  // Serve calls until the untrusted side closes the request ring. Each
+  // request is copied into trusted memory by SwitchlessDequeueRequest before
+  // the selector or payload are interpreted.
+  uint64_t selector;
+  MessageReader request;
+  while (SwitchlessDequeueRequest(queue->requests(), &selector, &request)) {
+    MessageWriter response;
+    PrimitiveStatus status = InvokeEntryHandler(selector, &request, &response);
+    if (!SwitchlessEnqueueResponse(queue->responses(), status, &response)) {
+      // The response cannot be delivered; close the channel so the caller
+      // fails fast instead of spinning forever.
+      queue->responses()->close_for_write();
+      return {primitives::AbslStatusCode::kInternal,
+              "Switchless call response did not fit in the response ring."};
+    }
+    request = MessageReader();
+  }
+  queue->responses()->close_for_write();
+  return PrimitiveStatus::OkStatus();
+}
+
+PrimitiveStatus SwitchlessExitInitEntry(void *context, MessageReader *in,
+                                        MessageWriter *out) {
+  if (in->size() != 2) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "SwitchlessExitInitEntry expects exactly two input extents."};
+  }
+  auto *queue = reinterpret_cast<SwitchlessCallQueue *>(in->next<uint64_t>());
+  Extent selectors = in->next();
+  if (selectors.size() % sizeof(uint64_t) != 0 ||
+      selectors.size() / sizeof(uint64_t) > kMaxSwitchlessExitSelectors) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "Invalid switchless exit selector list."};
+  }
+  if (queue && !TrustedPrimitives::IsOutsideEnclave(queue, sizeof(*queue))) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "Switchless exit queue must reside in untrusted memory."};
+  }
+
+  LockGuard lock(&exit_channel.lock);
+  exit_channel.queue = queue;
+  exit_channel.num_selectors = queue ? selectors.size() / sizeof(uint64_t) : 0;
+  if (exit_channel.num_selectors > 0) {
+    memcpy(exit_channel.selectors, selectors.data(), selectors.size());
+  }
+  return PrimitiveStatus::OkStatus();
+}
+
+bool SwitchlessUntrustedCall(uint64_t untrusted_selector, MessageWriter *input,
+                             MessageReader *output, PrimitiveStatus *status) {
+  if (!exit_channel.lock.TryLock()) {
+    return false;
+  }
+  SwitchlessCallQueue *queue = exit_channel.queue;
+  if (!queue || !IsSwitchlessExitSelector(untrusted_selector) ||
+      queue->requests()->is_closed_for_write() ||
+      !SwitchlessEnqueueRequest(queue->requests(), untrusted_selector,
+                                input)) {
+    exit_channel.lock.Unlock();
+    return false;
+  }
+  if (!SwitchlessDequeueResponse(queue->responses(), status, output)) {
+    // The poller went away mid-call; report the failure rather than falling
+    // back, since the request may already have executed host side effects.
+    *status = PrimitiveStatus{
+        primitives::AbslStatusCode::kInternal,
+        "Switchless exit channel closed while awaiting a response."};
+  }
+  exit_channel.lock.Unlock();
+  return true;
+}
+
+}  // namespace primitives
+}  // namespace asylo
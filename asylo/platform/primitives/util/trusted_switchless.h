@@ -0,0 +1,60 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_SWITCHLESS_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_SWITCHLESS_H_
+
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/message.h"
+
+namespace asylo {
+namespace primitives {
+
+// Entry handler bound to kSelectorAsyloSwitchlessWorker. The calling thread
+// is donated by the untrusted SwitchlessClient and remains resident inside
+// the enclave, serving call requests from a shared-memory SwitchlessCallQueue
+// until the queue is closed for writing.
+//
+// |in| carries a single uint64_t: the untrusted address of the channel's
+// SwitchlessCallQueue. The handler validates that the queue lies entirely in
+// untrusted memory before serving from it.
+PrimitiveStatus SwitchlessWorkerEntry(void *context, MessageReader *in,
+                                      MessageWriter *out);
+
+// Entry handler bound to kSelectorAsyloSwitchlessExitInit. Configures (or,
+// with a null queue address, tears down) the switchless exit call channel
+// served by an untrusted SwitchlessExitPoller.
+//
+// |in| carries two extents: the untrusted address of a SwitchlessCallQueue
+// (0 to disable the channel), and an array of uint64_t exit selectors that
+// should be dispatched switchlessly.
+PrimitiveStatus SwitchlessExitInitEntry(void *context, MessageReader *in,
+                                        MessageWriter *out);
+
+// Attempts to perform an exit call through the switchless exit channel.
+// Returns true and fills in |status| if the call was served switchlessly.
+// Returns false if |untrusted_selector| is not enabled for switchless
+// dispatch, if no channel is configured, or if the channel is busy or full;
+// the caller should then fall back to a regular enclave exit.
+bool SwitchlessUntrustedCall(uint64_t untrusted_selector, MessageWriter *input,
+                             MessageReader *output, PrimitiveStatus *status);
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_SWITCHLESS_H_
@@ -0,0 +1,52 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/primitives/util/trusted_timer.h"
+
+#include <cstdint>
+
+#include "asylo/platform/common/timer_wheel.h"
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/trusted_clock.h"
+
+namespace asylo {
+namespace primitives {
+
+PrimitiveStatus TimerTickEntry(void *context, MessageReader *in,
+                               MessageWriter *out) {
+  if (in->size() != 1) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "TimerTickEntry expects exactly one input extent."};
+  }
+  uint64_t now_micros = in->next<uint64_t>();
+
+  // Prefer the shared clock page when one is installed, so that the wheel's
+  // notion of "now" matches the clock timed waiters compute deadlines
+  // against.
+  int64_t realtime_ns;
+  if (SharedClockReadRealtime(&realtime_ns) && realtime_ns > 0) {
+    now_micros = static_cast<uint64_t>(realtime_ns) / 1000;
+  }
+
+  const int fired = TimerWheel::GetInstance()->Advance(now_micros);
+  out->Push<uint64_t>(static_cast<uint64_t>(fired));
+  return PrimitiveStatus::OkStatus();
+}
+
+}  // namespace primitives
+}  // namespace asylo
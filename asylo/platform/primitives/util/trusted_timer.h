@@ -0,0 +1,47 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_TIMER_H_
+#define ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_TIMER_H_
+
+#include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/message.h"
+
+namespace asylo {
+namespace primitives {
+
+// Trusted side of the timer wheel tick. An untrusted ticker thread enters the
+// enclave once per tick interval; the handler advances the process-wide
+// TimerWheel, which wakes every timed waiter whose deadline has passed. Timed
+// waits thus consume one enclave entry per tick instead of one host timer
+// per wait. Until the first tick arrives the wheel is inactive and timed
+// waits fall back to host-side timeouts.
+
+// Entry handler bound to kSelectorAsyloTimerTick. |in| carries one uint64_t
+// value: the host's CLOCK_REALTIME reading in microseconds. When a shared
+// clock page is installed its reading is preferred over the pushed value.
+// Pushes the number of timers fired to |out|. Like all host-provided time,
+// the tick is not a secure time source: a hostile host can delay or suppress
+// timeouts, as pthread_cond_timedwait() already documents.
+PrimitiveStatus TimerTickEntry(void *context, MessageReader *in,
+                               MessageWriter *out);
+
+}  // namespace primitives
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_PRIMITIVES_UTIL_TRUSTED_TIMER_H_
@@ -24,14 +24,18 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/synchronization/mutex.h"
 #include "asylo/crypto/util/bytes.h"
 #include "asylo/platform/crypto/gcmlib/gcm_cryptor.h"
 #include "asylo/platform/storage/secure/authenticated_dictionary.h"
+#include "asylo/platform/storage/secure/block_cache.h"
 #include "asylo/platform/storage/secure/ctmmt_authenticated_dictionary.h"
+#include "asylo/platform/storage/secure/sparse_extent_index.h"
 #include "asylo/platform/storage/utils/offset_translator.h"
+#include "asylo/util/file_mapping.h"
 
 namespace asylo {
 namespace platform {
@@ -62,6 +66,15 @@ constexpr size_t kSecureBlockLength = kCipherBlockLength + kTokenLength;
 using FileHash = UnsafeBytes<kFileHashLength>;
 using FileDigest = UnsafeBytes<kRootHashLength>;
 
+// Length of the file header preceding the first secure block: the file hash
+// followed by the logical file size.
+constexpr size_t kFileHeaderLength = kFileHashLength + sizeof(size_t);
+
+// Offset translator for the secure file geometry. The layout is fixed at
+// compile time, so translations compile down to constant arithmetic.
+using SecureOffsetTranslator =
+    FixedOffsetTranslator<kFileHeaderLength, kBlockLength, kSecureBlockLength>;
+
 // Authenticated Encryption with Associated Data (AEAD) handler class. Maintains
 // AEAD metadata for file data when a securely handled file is modified from the
 // enclave. Encapsulates operations on file's integrity metadata based on the
@@ -106,7 +119,71 @@ class AeadHandler {
   // Returns the logical file size, or -1 on failure.
   off_t GetLogicalFileSize(int fd) ABSL_LOCKS_EXCLUDED(mu_);
 
-  const OffsetTranslator &GetOffsetTranslator() const;
+  // Caps the decrypted-block cache of the file opened at |fd| at |max_blocks|
+  // blocks and sets its write |policy|. A cap of zero disables caching for the
+  // file. Returns -1 on failure.
+  int ConfigureBlockCache(int fd, size_t max_blocks,
+                          BlockCache<Block>::WritePolicy policy)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Returns the number of plaintext bytes currently held in the
+  // decrypted-block cache of the file opened at |fd|, or -1 on failure.
+  ssize_t GetBlockCacheByteCount(int fd) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Enables write-back buffering of up to |capacity_bytes| of plaintext for
+  // the file opened at |fd|. Buffered writes are coalesced and encrypted and
+  // persisted as one range when the buffer fills, when a non-adjacent write or
+  // a read arrives, or on flush. A capacity of zero (the default) disables
+  // buffering and flushes any pending data. Returns -1 on failure.
+  int ConfigureWriteBuffer(int fd, size_t capacity_bytes)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Encrypts and persists any buffered writes of the file opened at |fd|.
+  // Returns -1 on failure.
+  int FlushWriteBuffer(int fd) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Maps the ciphertext of the file opened at |fd| into untrusted memory and
+  // serves subsequent reads from the mapping, decrypting block-wise into the
+  // trusted decrypted-block cache instead of streaming ciphertext through
+  // read host calls. Intended for read-mostly files; a write through the
+  // secure API drops the mapping and reads fall back to the host-call path
+  // until mapped reading is enabled again. Returns -1 on failure.
+  int EnableMappedRead(int fd) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Releases the ciphertext mapping of the file opened at |fd|, if any.
+  // Returns -1 on failure.
+  int DisableMappedRead(int fd) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Point-in-time totals of the handler's profiling counters: cumulative
+  // nanoseconds and timed-section counts since enclave start, split by where
+  // the secure I/O paths spend their time. Callers compute deltas across a
+  // measured interval.
+  struct ProfileSnapshot {
+    // AEAD block encryption and decryption.
+    uint64_t crypto_nanos;
+    uint64_t crypto_ops;
+
+    // Integrity digest maintenance - leaf hashing, Merkle tree updates and
+    // root recomputation.
+    uint64_t digest_nanos;
+    uint64_t digest_ops;
+
+    // Bulk-data host calls crossing the enclave boundary.
+    uint64_t host_io_nanos;
+    uint64_t host_io_ops;
+  };
+
+  // Enables or disables profiling of the secure I/O paths. While enabled, the
+  // timed sections above accumulate into counters exposed on the enclave
+  // performance counter page. Reading the clock from the enclave is itself a
+  // host call, so profiling adds boundary crossings of its own - enable it to
+  // attribute time, not to measure absolute throughput. Disabled by default.
+  static void SetProfilingEnabled(bool enabled);
+
+  // Returns the current profiling counter totals.
+  static ProfileSnapshot GetProfileSnapshot();
+
+  const SecureOffsetTranslator &GetOffsetTranslator() const;
 
  private:
   // Structure represents the file header layout.
@@ -122,6 +199,9 @@ class AeadHandler {
     uint8_t *data() { return file_hash.data(); }
   } ABSL_ATTRIBUTE_PACKED;
 
+  static_assert(sizeof(FileHeader) == kFileHeaderLength,
+                "FileHeader layout does not match the translator geometry");
+
   // Structure represents the file data digest from which the file hash used for
   // integrity validation is calculated.
   struct DataDigest {
@@ -145,6 +225,29 @@ class AeadHandler {
     std::string zero_hash;
     std::unique_ptr<GcmCryptorKey> master_key;
 
+    // Bounded LRU cache of decrypted blocks, keyed by block-aligned logical
+    // offset. Guarded by mu. Mutable because read paths take the FileControl
+    // by const reference yet still promote and insert cache entries.
+    mutable BlockCache<Block> block_cache{kDefaultBlockCacheCapacity};
+
+    // Sorted extent index of the file's sparse block ranges. Guarded by mu.
+    // Lets reads classify a block as sparse in O(log n) of the extent count
+    // instead of hashing against the AD, and lets reads that fall entirely
+    // inside a hole skip host I/O altogether.
+    SparseExtentIndex sparse_index;
+
+    // Copy-on-write mapping of the file's ciphertext into untrusted memory
+    // while mapped read mode is enabled, nullptr otherwise. Guarded by mu.
+    std::unique_ptr<FileMapping> mapped_read;
+
+    // Pending write-back data - a single contiguous range of plaintext
+    // starting at the logical offset |write_buffer_offset|, coalescing
+    // adjacent writes until flushed. Guarded by mu. Buffering is disabled
+    // while |write_buffer_capacity| is zero.
+    std::vector<uint8_t> write_buffer;
+    off_t write_buffer_offset = -1;
+    size_t write_buffer_capacity = 0;
+
     // Mutex for protecting FileControl instance.
     absl::Mutex mu;
 
@@ -197,6 +300,19 @@ class AeadHandler {
                                    off_t logical_offset) const
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(file_ctrl.mu);
 
+  // Similar to EncryptAndPersist, but is called by internal implementation
+  // with the file lock held and the cursor associated with the file descriptor
+  // |fd| already at the position of |logical_offset|.
+  ssize_t EncryptAndPersistInternal(int fd, const void *buf, size_t count,
+                                    FileControl *file_ctrl,
+                                    off_t logical_offset)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(file_ctrl->mu);
+
+  // Encrypts and persists the pending write-back range of |file_ctrl|, if
+  // any, preserving the cursor position of |fd|. Returns false on failure.
+  bool FlushWriteBufferInternal(int fd, FileControl *file_ctrl)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(file_ctrl->mu);
+
   // Reads a single full block of a file at a specified logical offset. Returns
   // false on failure.
   bool ReadFullBlock(const FileControl &file_ctrl, off_t logical_offset,
@@ -217,8 +333,11 @@ class AeadHandler {
   std::unordered_map<std::string, std::shared_ptr<FileControl>> opened_files_
       ABSL_GUARDED_BY(mu_);
 
-  // An instance that performs operations on untrusted file offset.
-  std::unique_ptr<OffsetTranslator> offset_translator_;
+  // An instance that performs operations on untrusted file offset. The
+  // geometry is fixed at compile time, so translations compile down to
+  // constant shift/mask and multiply-shift arithmetic with no per-call
+  // division.
+  SecureOffsetTranslator offset_translator_;
 
   // Mutex for protecting map members of the class.
   absl::Mutex mu_;
@@ -0,0 +1,159 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_STORAGE_SECURE_BLOCK_CACHE_H_
+#define ASYLO_PLATFORM_STORAGE_SECURE_BLOCK_CACHE_H_
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace asylo {
+namespace platform {
+namespace storage {
+
+// Default per-file capacity of the decrypted-block cache, in blocks.
+constexpr size_t kDefaultBlockCacheCapacity = 256;
+
+// A bounded LRU cache of decrypted file blocks, keyed by block-aligned logical
+// offset. Entries hold verified plaintext, so serving a hit skips both the
+// AES-GCM decryption and the integrity check for that block. The cache memory
+// is attributable to the owning file through byte_count() and cappable through
+// set_capacity().
+//
+// BlockCache is not thread-safe; callers are expected to hold the lock
+// guarding the owning file control structure.
+template <class BlockT>
+class BlockCache {
+ public:
+  // Policy applied to blocks on write.
+  enum class WritePolicy {
+    // Written blocks are inserted into the cache, so reads immediately
+    // following a write are served without decryption.
+    kWriteThrough,
+    // Written blocks are evicted from the cache and cached again only when
+    // read back; keeps write-heavy scans from flushing the read set.
+    kWriteAround,
+  };
+
+  explicit BlockCache(size_t capacity,
+                      WritePolicy write_policy = WritePolicy::kWriteThrough)
+      : capacity_(capacity), write_policy_(write_policy) {}
+
+  // Copies the cached block at |block_offset| into |block| and marks it as
+  // most recently used. Returns false if the block is not cached.
+  bool Get(off_t block_offset, BlockT *block) {
+    auto it = index_.find(block_offset);
+    if (it == index_.end()) {
+      return false;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    *block = it->second->second;
+    return true;
+  }
+
+  // Inserts or refreshes the cached copy of the block at |block_offset| and
+  // marks it as most recently used, evicting the least recently used entries
+  // while the cache is over capacity.
+  void Put(off_t block_offset, const BlockT &block) {
+    if (capacity_ == 0) {
+      return;
+    }
+    auto it = index_.find(block_offset);
+    if (it != index_.end()) {
+      it->second->second = block;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+    lru_.emplace_front(block_offset, block);
+    index_.emplace(block_offset, lru_.begin());
+    while (lru_.size() > capacity_) {
+      EvictOldest();
+    }
+  }
+
+  // Drops the cached copy of the block at |block_offset|, if any.
+  void Invalidate(off_t block_offset) {
+    auto it = index_.find(block_offset);
+    if (it == index_.end()) {
+      return;
+    }
+    lru_.erase(it->second);
+    index_.erase(it);
+  }
+
+  // Drops all cached blocks.
+  void Clear() {
+    lru_.clear();
+    index_.clear();
+  }
+
+  // Caps the cache at |capacity| blocks, evicting the least recently used
+  // entries if it is currently larger. A capacity of zero disables caching.
+  void set_capacity(size_t capacity) {
+    capacity_ = capacity;
+    while (lru_.size() > capacity_) {
+      EvictOldest();
+    }
+  }
+
+  size_t capacity() const { return capacity_; }
+
+  // Returns the number of blocks currently cached.
+  size_t size() const { return lru_.size(); }
+
+  // Returns the plaintext bytes currently held, for attributing cache memory
+  // to the owning file.
+  size_t byte_count() const { return lru_.size() * sizeof(BlockT); }
+
+  WritePolicy write_policy() const { return write_policy_; }
+
+  void set_write_policy(WritePolicy write_policy) {
+    write_policy_ = write_policy;
+  }
+
+ private:
+  // Evicts the least recently used entry. The cache must not be empty.
+  void EvictOldest() {
+    index_.erase(lru_.back().first);
+    lru_.pop_back();
+  }
+
+  // Entries ordered from most to least recently used. Avoid using absl based
+  // containers which may perform system calls, as this class is expected to be
+  // used in trusted primitives layer where system calls might not be
+  // available.
+  std::list<std::pair<off_t, BlockT>> lru_;
+
+  // Index from block offset to the entry's position in lru_.
+  std::unordered_map<off_t, typename std::list<std::pair<off_t, BlockT>>::
+                                iterator>
+      index_;
+
+  size_t capacity_;
+  WritePolicy write_policy_;
+};
+
+}  // namespace storage
+}  // namespace platform
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_STORAGE_SECURE_BLOCK_CACHE_H_
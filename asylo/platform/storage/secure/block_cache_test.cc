@@ -0,0 +1,125 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/storage/secure/block_cache.h"
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+namespace asylo {
+namespace platform {
+namespace storage {
+namespace {
+
+using TestBlock = std::array<uint8_t, 16>;
+using TestCache = BlockCache<TestBlock>;
+
+TestBlock MakeBlock(uint8_t fill) {
+  TestBlock block;
+  block.fill(fill);
+  return block;
+}
+
+TEST(BlockCacheTest, MissOnEmptyCache) {
+  TestCache cache(/*capacity=*/4);
+  TestBlock block;
+  EXPECT_FALSE(cache.Get(0, &block));
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.byte_count(), 0);
+}
+
+TEST(BlockCacheTest, PutThenGet) {
+  TestCache cache(/*capacity=*/4);
+  cache.Put(16, MakeBlock(0xab));
+
+  TestBlock block;
+  ASSERT_TRUE(cache.Get(16, &block));
+  EXPECT_EQ(block, MakeBlock(0xab));
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.byte_count(), sizeof(TestBlock));
+}
+
+TEST(BlockCacheTest, PutRefreshesExistingEntry) {
+  TestCache cache(/*capacity=*/4);
+  cache.Put(16, MakeBlock(0xab));
+  cache.Put(16, MakeBlock(0xcd));
+
+  TestBlock block;
+  ASSERT_TRUE(cache.Get(16, &block));
+  EXPECT_EQ(block, MakeBlock(0xcd));
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(BlockCacheTest, EvictsLeastRecentlyUsed) {
+  TestCache cache(/*capacity=*/2);
+  cache.Put(0, MakeBlock(0));
+  cache.Put(16, MakeBlock(1));
+
+  // Touch offset 0 so that offset 16 becomes the eviction candidate.
+  TestBlock block;
+  ASSERT_TRUE(cache.Get(0, &block));
+
+  cache.Put(32, MakeBlock(2));
+  EXPECT_TRUE(cache.Get(0, &block));
+  EXPECT_FALSE(cache.Get(16, &block));
+  EXPECT_TRUE(cache.Get(32, &block));
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(BlockCacheTest, InvalidateDropsEntry) {
+  TestCache cache(/*capacity=*/4);
+  cache.Put(0, MakeBlock(0));
+  cache.Invalidate(0);
+
+  TestBlock block;
+  EXPECT_FALSE(cache.Get(0, &block));
+
+  // Invalidating a missing entry is a no-op.
+  cache.Invalidate(16);
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(BlockCacheTest, ShrinkingCapacityEvicts) {
+  TestCache cache(/*capacity=*/4);
+  for (off_t offset = 0; offset < 4; ++offset) {
+    cache.Put(offset * 16, MakeBlock(offset));
+  }
+
+  cache.set_capacity(1);
+  EXPECT_EQ(cache.size(), 1);
+
+  // Only the most recently used entry survives.
+  TestBlock block;
+  EXPECT_TRUE(cache.Get(48, &block));
+  EXPECT_EQ(block, MakeBlock(3));
+}
+
+TEST(BlockCacheTest, ZeroCapacityDisablesCaching) {
+  TestCache cache(/*capacity=*/0);
+  cache.Put(0, MakeBlock(0));
+
+  TestBlock block;
+  EXPECT_FALSE(cache.Get(0, &block));
+  EXPECT_EQ(cache.size(), 0);
+}
+
+}  // namespace
+}  // namespace storage
+}  // namespace platform
+}  // namespace asylo
@@ -88,12 +88,19 @@ int secure_close(int fd) {
   return (finalize_result && enc_untrusted_close(fd) == 0) ? 0 : -1;
 }
 
+int secure_fsync(int fd) {
+  if (AeadHandler::GetInstance().FlushWriteBuffer(fd) == -1) {
+    return -1;
+  }
+  return enc_untrusted_fsync(fd);
+}
+
 off_t secure_lseek(int fd, off_t offset, int whence) {
   if (offset < 0) {
     return -1;
   }
 
-  const OffsetTranslator &offset_translator =
+  const SecureOffsetTranslator &offset_translator =
       AeadHandler::GetInstance().GetOffsetTranslator();
 
   // The net logical offset to which lseek has been requested.
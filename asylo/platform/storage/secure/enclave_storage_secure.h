@@ -45,6 +45,10 @@ ssize_t secure_write(int fd, const void *buf, size_t count);
 
 int secure_close(int fd);
 
+// Flushes writes buffered in the enclave before synchronizing the backing
+// file with the host.
+int secure_fsync(int fd);
+
 off_t secure_lseek(int fd, off_t offset, int whence);
 
 // |st->st_size| will be set to logical file size on success.
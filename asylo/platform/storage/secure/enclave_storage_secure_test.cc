@@ -49,6 +49,7 @@ using platform::storage::kCipherBlockLength;
 using platform::storage::kFileHashLength;
 using platform::storage::secure_close;
 using platform::storage::secure_fstat;
+using platform::storage::secure_fsync;
 using platform::storage::secure_lseek;
 using platform::storage::secure_open;
 using platform::storage::secure_read;
@@ -314,6 +315,45 @@ TEST_P(EnclaveStorageSecureTest, LseekReadWriteInterlacedMultiFdSuccess) {
   }
 }
 
+TEST_P(EnclaveStorageSecureTest, WriteBackBufferedWritesSuccess) {
+  // Open for read/write.
+  int fd = secure_open(GetPath().c_str(), O_RDWR | O_CREAT,
+                       S_IRWXU | S_IRWXG | S_IRWXO);
+  LOG(INFO) << "Opened file for read and write, fd = " << fd;
+  ASSERT_GE(fd, 0);
+
+  EXPECT_EQ(EmulateSetKeyIoctl(fd), 0);
+  EXPECT_EQ(
+      AeadHandler::GetInstance().ConfigureWriteBuffer(fd, 2 * test_buf_len_),
+      0);
+
+  // Issue small adjacent writes - they coalesce in the enclave until flushed.
+  constexpr size_t kChunkLen = 16;
+  const char *data = reinterpret_cast<const char *>(GetWriteBuffer());
+  for (size_t offset = 0; offset < test_buf_len_; offset += kChunkLen) {
+    EXPECT_EQ(secure_write(fd, data + offset, kChunkLen), kChunkLen);
+  }
+
+  // Buffered bytes are reflected in the logical file size before any flush.
+  struct stat file_stat;
+  EXPECT_EQ(secure_fstat(fd, &file_stat), 0);
+  EXPECT_EQ(file_stat.st_size, test_buf_len_);
+
+  // Fsync persists the coalesced range.
+  EXPECT_EQ(secure_fsync(fd), 0);
+
+  // Read back and verify.
+  EXPECT_EQ(secure_lseek(fd, 0, SEEK_SET), 0);
+  EXPECT_EQ(secure_read(fd, GetReadBuffer(), test_buf_len_), test_buf_len_);
+  EXPECT_EQ(memcmp(GetWriteBuffer(), GetReadBuffer(), test_buf_len_), 0);
+
+  // Close.
+  EXPECT_EQ(secure_close(fd), 0);
+
+  // Persisted data survives reopen.
+  EXPECT_THAT(OpenReadVerifyClose(0, test_buf_len_), IsOk());
+}
+
 TEST_P(EnclaveStorageSecureTest, ReopenReadWriteSuccess) {
   // Open for write.
   int fd = secure_open(GetPath().c_str(), O_WRONLY | O_CREAT,
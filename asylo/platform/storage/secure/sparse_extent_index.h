@@ -0,0 +1,140 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_STORAGE_SECURE_SPARSE_EXTENT_INDEX_H_
+#define ASYLO_PLATFORM_STORAGE_SECURE_SPARSE_EXTENT_INDEX_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+
+namespace asylo {
+namespace platform {
+namespace storage {
+
+// A sorted extent index of the sparse (never materialized) block ranges of a
+// secure file. Hole extents are kept coalesced - adjacent and overlapping
+// ranges are merged on insertion - so membership queries cost O(log n) in the
+// number of extents rather than in the number of blocks, and a read that
+// falls entirely inside one hole can be answered without any host I/O.
+// Blocks are identified by zero-based index into the file's secure blocks.
+//
+// SparseExtentIndex is not thread-safe; callers are expected to hold the lock
+// guarding the owning file control structure.
+class SparseExtentIndex {
+ public:
+  // Records the |block_count| blocks starting at |first_block| as a hole,
+  // merging with any adjacent or overlapping hole extents.
+  void MarkHole(int64_t first_block, int64_t block_count) {
+    if (block_count <= 0) {
+      return;
+    }
+    int64_t end = first_block + block_count;
+    auto it = holes_.upper_bound(first_block);
+    if (it != holes_.begin()) {
+      auto prev = std::prev(it);
+      if (prev->first + prev->second >= first_block) {
+        first_block = prev->first;
+        end = std::max(end, prev->first + prev->second);
+        it = holes_.erase(prev);
+      }
+    }
+    while (it != holes_.end() && it->first <= end) {
+      end = std::max(end, it->first + it->second);
+      it = holes_.erase(it);
+    }
+    holes_.emplace(first_block, end - first_block);
+  }
+
+  // Records the |block_count| blocks starting at |first_block| as
+  // materialized data, trimming or splitting any hole extents they overlap.
+  void MarkData(int64_t first_block, int64_t block_count) {
+    if (block_count <= 0) {
+      return;
+    }
+    const int64_t end = first_block + block_count;
+    auto it = holes_.lower_bound(first_block);
+    if (it != holes_.begin()) {
+      auto prev = std::prev(it);
+      const int64_t prev_end = prev->first + prev->second;
+      if (prev_end > first_block) {
+        // lower_bound guarantees prev->first < first_block, so the trimmed
+        // extent is never empty.
+        prev->second = first_block - prev->first;
+        if (prev_end > end) {
+          holes_.emplace(end, prev_end - end);
+          return;
+        }
+      }
+    }
+    while (it != holes_.end() && it->first < end) {
+      const int64_t it_end = it->first + it->second;
+      it = holes_.erase(it);
+      if (it_end > end) {
+        holes_.emplace(end, it_end - end);
+        break;
+      }
+    }
+  }
+
+  // Returns true if the block at |block_index| lies in a hole.
+  bool IsHole(int64_t block_index) const {
+    auto it = holes_.upper_bound(block_index);
+    if (it == holes_.begin()) {
+      return false;
+    }
+    --it;
+    return block_index < it->first + it->second;
+  }
+
+  // Returns true if all |block_count| blocks starting at |first_block| lie in
+  // holes. Extents are coalesced, so a fully sparse range is always contained
+  // in a single extent.
+  bool RangeIsHole(int64_t first_block, int64_t block_count) const {
+    if (block_count <= 0) {
+      return true;
+    }
+    auto it = holes_.upper_bound(first_block);
+    if (it == holes_.begin()) {
+      return false;
+    }
+    --it;
+    return first_block + block_count <= it->first + it->second;
+  }
+
+  // Returns the number of hole extents currently indexed.
+  size_t extent_count() const { return holes_.size(); }
+
+  // Drops all hole extents.
+  void Clear() { holes_.clear(); }
+
+ private:
+  // Hole extents keyed by first block index, mapped to block count. Avoid
+  // using absl based containers which may perform system calls, as this class
+  // is expected to be used in trusted primitives layer where system calls
+  // might not be available.
+  std::map<int64_t, int64_t> holes_;
+};
+
+}  // namespace storage
+}  // namespace platform
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_STORAGE_SECURE_SPARSE_EXTENT_INDEX_H_
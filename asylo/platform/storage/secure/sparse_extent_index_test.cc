@@ -0,0 +1,133 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/storage/secure/sparse_extent_index.h"
+
+#include <gtest/gtest.h>
+
+namespace asylo {
+namespace platform {
+namespace storage {
+namespace {
+
+TEST(SparseExtentIndexTest, EmptyIndexHasNoHoles) {
+  SparseExtentIndex index;
+  EXPECT_FALSE(index.IsHole(0));
+  EXPECT_FALSE(index.RangeIsHole(0, 4));
+  EXPECT_EQ(index.extent_count(), 0);
+}
+
+TEST(SparseExtentIndexTest, MarkHoleCoversRange) {
+  SparseExtentIndex index;
+  index.MarkHole(4, 4);
+
+  EXPECT_FALSE(index.IsHole(3));
+  EXPECT_TRUE(index.IsHole(4));
+  EXPECT_TRUE(index.IsHole(7));
+  EXPECT_FALSE(index.IsHole(8));
+  EXPECT_TRUE(index.RangeIsHole(4, 4));
+  EXPECT_FALSE(index.RangeIsHole(4, 5));
+  EXPECT_FALSE(index.RangeIsHole(3, 2));
+  EXPECT_EQ(index.extent_count(), 1);
+}
+
+TEST(SparseExtentIndexTest, AdjacentHolesCoalesce) {
+  SparseExtentIndex index;
+  index.MarkHole(0, 2);
+  index.MarkHole(2, 2);
+  index.MarkHole(4, 2);
+
+  EXPECT_EQ(index.extent_count(), 1);
+  EXPECT_TRUE(index.RangeIsHole(0, 6));
+}
+
+TEST(SparseExtentIndexTest, OverlappingHolesCoalesce) {
+  SparseExtentIndex index;
+  index.MarkHole(0, 4);
+  index.MarkHole(8, 4);
+  EXPECT_EQ(index.extent_count(), 2);
+
+  // Bridges and overlaps both existing extents.
+  index.MarkHole(2, 8);
+  EXPECT_EQ(index.extent_count(), 1);
+  EXPECT_TRUE(index.RangeIsHole(0, 12));
+  EXPECT_FALSE(index.IsHole(12));
+}
+
+TEST(SparseExtentIndexTest, MarkDataSplitsHole) {
+  SparseExtentIndex index;
+  index.MarkHole(0, 10);
+  index.MarkData(4, 2);
+
+  EXPECT_EQ(index.extent_count(), 2);
+  EXPECT_TRUE(index.RangeIsHole(0, 4));
+  EXPECT_FALSE(index.IsHole(4));
+  EXPECT_FALSE(index.IsHole(5));
+  EXPECT_TRUE(index.RangeIsHole(6, 4));
+}
+
+TEST(SparseExtentIndexTest, MarkDataTrimsHoleEnds) {
+  SparseExtentIndex index;
+  index.MarkHole(4, 4);
+
+  // Overlaps the front of the extent.
+  index.MarkData(2, 4);
+  EXPECT_FALSE(index.IsHole(5));
+  EXPECT_TRUE(index.RangeIsHole(6, 2));
+
+  // Overlaps the back of the extent.
+  index.MarkData(7, 4);
+  EXPECT_TRUE(index.IsHole(6));
+  EXPECT_FALSE(index.IsHole(7));
+  EXPECT_EQ(index.extent_count(), 1);
+}
+
+TEST(SparseExtentIndexTest, MarkDataRemovesCoveredHoles) {
+  SparseExtentIndex index;
+  index.MarkHole(0, 2);
+  index.MarkHole(4, 2);
+  index.MarkHole(8, 2);
+
+  index.MarkData(0, 10);
+  EXPECT_EQ(index.extent_count(), 0);
+  EXPECT_FALSE(index.IsHole(0));
+  EXPECT_FALSE(index.IsHole(9));
+}
+
+TEST(SparseExtentIndexTest, MarkDataOnDataIsNoOp) {
+  SparseExtentIndex index;
+  index.MarkHole(8, 4);
+  index.MarkData(0, 4);
+
+  EXPECT_EQ(index.extent_count(), 1);
+  EXPECT_TRUE(index.RangeIsHole(8, 4));
+}
+
+TEST(SparseExtentIndexTest, ClearDropsAllExtents) {
+  SparseExtentIndex index;
+  index.MarkHole(0, 4);
+  index.Clear();
+
+  EXPECT_EQ(index.extent_count(), 0);
+  EXPECT_FALSE(index.IsHole(0));
+}
+
+}  // namespace
+}  // namespace storage
+}  // namespace platform
+}  // namespace asylo
@@ -0,0 +1,534 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Benchmark of SQLite backed by the Secure IO Library. Registers a SQLite
+// VFS that routes all database I/O through a pluggable backend - either the
+// secure storage stack or the plain host-call path it is compared against -
+// and runs TPC-B-like query mixes: a bulk load, point selects, range
+// aggregates and transactional updates. For the secure backend, each phase
+// additionally reports the AeadHandler profiling split between AEAD crypto,
+// integrity digest maintenance and bulk-data host I/O, so the database
+// workload validates the block-cache, Merkle and write-back work in the
+// stack. Results are reported via LOG(INFO); the assertions only check that
+// the database operations succeed and that the data survives the workload
+// intact.
+
+#include <fcntl.h>
+#include <openssl/rand.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <functional>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/flags/flag.h"
+#include "absl/strings/str_cat.h"
+#include "sqlite3.h"
+#include "asylo/util/logging.h"
+#include "asylo/platform/host_call/trusted/host_calls.h"
+#include "asylo/platform/storage/secure/aead_handler.h"
+#include "asylo/platform/storage/secure/enclave_storage_secure.h"
+#include "asylo/test/util/test_flags.h"
+#include "asylo/util/cleansing_types.h"
+
+namespace asylo {
+namespace {
+
+using platform::crypto::gcmlib::kKeyLength;
+using platform::storage::AeadHandler;
+
+// Rows loaded into the accounts table. With the small page cache configured
+// below, the resulting database is large enough that the query phases reach
+// the VFS instead of being absorbed by SQLite's pager cache.
+constexpr int kRowCount = 2000;
+
+// Operations per query phase.
+constexpr int kPointSelects = 1000;
+constexpr int kRangeSelects = 100;
+constexpr int kUpdates = 500;
+
+// Rows spanned by one range aggregate.
+constexpr int kRangeWidth = 50;
+
+// Updates grouped into one transaction.
+constexpr int kUpdateTxnSize = 10;
+
+// Name of the registered benchmark VFS.
+constexpr char kVfsName[] = "asylo-benchmark";
+
+// The file operations the benchmark VFS routes SQLite I/O through - either
+// the secure storage stack or the plain host-call path.
+struct IoBackend {
+  const char *name;
+
+  // Whether the AeadHandler profiling split applies to this backend.
+  bool profiled;
+
+  std::function<int(const char *path)> open;
+  std::function<ssize_t(int fd, void *buf, size_t count)> read;
+  std::function<ssize_t(int fd, const void *buf, size_t count)> write;
+  std::function<off_t(int fd, off_t offset, int whence)> seek;
+  std::function<int(int fd)> sync;
+  std::function<int(int fd)> close;
+};
+
+// SQLite file handle carrying the backend the database was opened on. SQLite
+// allocates szOsFile bytes for it and the I/O methods downcast.
+struct BenchmarkFile {
+  sqlite3_file base;
+  const IoBackend *backend;
+  int fd;
+};
+
+int VfsClose(sqlite3_file *file) {
+  BenchmarkFile *benchmark_file = reinterpret_cast<BenchmarkFile *>(file);
+  return benchmark_file->backend->close(benchmark_file->fd) == 0
+             ? SQLITE_OK
+             : SQLITE_IOERR_CLOSE;
+}
+
+int VfsRead(sqlite3_file *file, void *buf, int amount, sqlite3_int64 offset) {
+  BenchmarkFile *benchmark_file = reinterpret_cast<BenchmarkFile *>(file);
+  if (benchmark_file->backend->seek(benchmark_file->fd, offset, SEEK_SET) !=
+      offset) {
+    return SQLITE_IOERR_READ;
+  }
+
+  const size_t count = amount;
+  size_t total = 0;
+  while (total < count) {
+    const ssize_t bytes_read = benchmark_file->backend->read(
+        benchmark_file->fd, static_cast<uint8_t *>(buf) + total,
+        count - total);
+    if (bytes_read < 0) {
+      return SQLITE_IOERR_READ;
+    }
+    if (bytes_read == 0) {
+      break;
+    }
+    total += bytes_read;
+  }
+
+  if (total < count) {
+    // SQLite requires the unread tail to be zero-filled on a short read.
+    memset(static_cast<uint8_t *>(buf) + total, 0, count - total);
+    return SQLITE_IOERR_SHORT_READ;
+  }
+  return SQLITE_OK;
+}
+
+int VfsWrite(sqlite3_file *file, const void *buf, int amount,
+             sqlite3_int64 offset) {
+  BenchmarkFile *benchmark_file = reinterpret_cast<BenchmarkFile *>(file);
+  if (benchmark_file->backend->seek(benchmark_file->fd, offset, SEEK_SET) !=
+      offset) {
+    return SQLITE_IOERR_WRITE;
+  }
+
+  const size_t count = amount;
+  size_t total = 0;
+  while (total < count) {
+    const ssize_t bytes_written = benchmark_file->backend->write(
+        benchmark_file->fd, static_cast<const uint8_t *>(buf) + total,
+        count - total);
+    if (bytes_written <= 0) {
+      return SQLITE_IOERR_WRITE;
+    }
+    total += bytes_written;
+  }
+  return SQLITE_OK;
+}
+
+// Nothing truncates the main database under this workload - journaling is
+// off and the workload does not vacuum.
+int VfsTruncate(sqlite3_file *file, sqlite3_int64 size) { return SQLITE_OK; }
+
+int VfsSync(sqlite3_file *file, int flags) {
+  BenchmarkFile *benchmark_file = reinterpret_cast<BenchmarkFile *>(file);
+  return benchmark_file->backend->sync(benchmark_file->fd) == 0
+             ? SQLITE_OK
+             : SQLITE_IOERR_FSYNC;
+}
+
+int VfsFileSize(sqlite3_file *file, sqlite3_int64 *size) {
+  BenchmarkFile *benchmark_file = reinterpret_cast<BenchmarkFile *>(file);
+  const off_t end =
+      benchmark_file->backend->seek(benchmark_file->fd, 0, SEEK_END);
+  if (end == -1) {
+    return SQLITE_IOERR_FSTAT;
+  }
+  *size = end;
+  return SQLITE_OK;
+}
+
+// The benchmark uses a single connection - locking is vacuous.
+int VfsLock(sqlite3_file *file, int level) { return SQLITE_OK; }
+
+int VfsUnlock(sqlite3_file *file, int level) { return SQLITE_OK; }
+
+int VfsCheckReservedLock(sqlite3_file *file, int *result_out) {
+  *result_out = 0;
+  return SQLITE_OK;
+}
+
+int VfsFileControl(sqlite3_file *file, int op, void *arg) {
+  return SQLITE_NOTFOUND;
+}
+
+int VfsSectorSize(sqlite3_file *file) { return 512; }
+
+int VfsDeviceCharacteristics(sqlite3_file *file) { return 0; }
+
+const sqlite3_io_methods kIoMethods = {
+    1,  // iVersion
+    VfsClose,
+    VfsRead,
+    VfsWrite,
+    VfsTruncate,
+    VfsSync,
+    VfsFileSize,
+    VfsLock,
+    VfsUnlock,
+    VfsCheckReservedLock,
+    VfsFileControl,
+    VfsSectorSize,
+    VfsDeviceCharacteristics,
+};
+
+int VfsOpen(sqlite3_vfs *vfs, const char *name, sqlite3_file *file, int flags,
+            int *out_flags) {
+  BenchmarkFile *benchmark_file = reinterpret_cast<BenchmarkFile *>(file);
+  benchmark_file->backend = static_cast<const IoBackend *>(vfs->pAppData);
+  benchmark_file->fd = benchmark_file->backend->open(name);
+  if (benchmark_file->fd < 0) {
+    return SQLITE_CANTOPEN;
+  }
+  benchmark_file->base.pMethods = &kIoMethods;
+  if (out_flags) {
+    *out_flags = flags;
+  }
+  return SQLITE_OK;
+}
+
+int VfsDelete(sqlite3_vfs *vfs, const char *name, int sync_dir) {
+  // A missing file is fine - there is nothing to delete.
+  enc_untrusted_unlink(name);
+  return SQLITE_OK;
+}
+
+int VfsAccess(sqlite3_vfs *vfs, const char *name, int flags, int *result_out) {
+  // With journaling off the only existence probes are for stale journals.
+  *result_out = 0;
+  return SQLITE_OK;
+}
+
+int VfsFullPathname(sqlite3_vfs *vfs, const char *name, int size, char *out) {
+  // The benchmark passes absolute paths.
+  snprintf(out, size, "%s", name);
+  return SQLITE_OK;
+}
+
+int VfsRandomness(sqlite3_vfs *vfs, int count, char *out) {
+  return RAND_bytes(reinterpret_cast<uint8_t *>(out), count) == 1 ? count : 0;
+}
+
+int VfsSleep(sqlite3_vfs *vfs, int microseconds) {
+  enc_untrusted_usleep(microseconds);
+  return microseconds;
+}
+
+int VfsCurrentTime(sqlite3_vfs *vfs, double *now) {
+  struct timespec ts;
+  if (enc_untrusted_clock_gettime(CLOCK_REALTIME, &ts) != 0) {
+    return 1;
+  }
+  // Julian day of the Unix epoch plus the elapsed fraction of days.
+  *now = 2440587.5 + (ts.tv_sec + ts.tv_nsec * 1e-9) / 86400.0;
+  return 0;
+}
+
+int VfsGetLastError(sqlite3_vfs *vfs, int size, char *out) { return 0; }
+
+// Returns the benchmark VFS. pAppData is pointed at the backend under
+// measurement before each registration.
+sqlite3_vfs *BenchmarkVfs() {
+  static sqlite3_vfs vfs = {
+      1,                      // iVersion
+      sizeof(BenchmarkFile),  // szOsFile
+      512,                    // mxPathname
+      nullptr,                // pNext
+      kVfsName,               // zName
+      nullptr,                // pAppData
+      VfsOpen,
+      VfsDelete,
+      VfsAccess,
+      VfsFullPathname,
+      nullptr,  // xDlOpen - extension loading is omitted
+      nullptr,  // xDlError
+      nullptr,  // xDlSym
+      nullptr,  // xDlClose
+      VfsRandomness,
+      VfsSleep,
+      VfsCurrentTime,
+      VfsGetLastError,
+  };
+  return &vfs;
+}
+
+// Returns the current monotonic time in microseconds. Note that reading the
+// clock from the enclave is itself a host call.
+double NowMicros() {
+  struct timespec ts;
+  CHECK_EQ(enc_untrusted_clock_gettime(CLOCK_MONOTONIC, &ts), 0);
+  return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+// Executes |sql| on |db|, aborting on failure.
+void Exec(sqlite3 *db, const std::string &sql) {
+  char *error_message = nullptr;
+  const int rc =
+      sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &error_message);
+  CHECK_EQ(rc, SQLITE_OK) << sql << ": "
+                          << (error_message ? error_message : "");
+}
+
+// Prepares |sql| on |db|, aborting on failure.
+sqlite3_stmt *Prepare(sqlite3 *db, const char *sql) {
+  sqlite3_stmt *statement = nullptr;
+  CHECK_EQ(sqlite3_prepare_v2(db, sql, -1, &statement, nullptr), SQLITE_OK)
+      << sql;
+  return statement;
+}
+
+// Reports one workload phase: wall time always, and for the secure backend
+// the AeadHandler time split across the phase. The split's buckets are the
+// profiled sections of the secure stack; "other" is everything else under
+// the phase's wall time, including SQLite itself and the profiling clock
+// reads.
+void ReportPhase(const IoBackend &backend, const char *phase, int operations,
+                 double wall_micros, const AeadHandler::ProfileSnapshot &before,
+                 const AeadHandler::ProfileSnapshot &after) {
+  if (!backend.profiled) {
+    LOG(INFO) << backend.name << " " << phase << ": ops = " << operations
+              << ", wall = " << wall_micros / 1000
+              << " ms, per-op = " << wall_micros / operations << " us";
+    return;
+  }
+
+  const double crypto_micros = (after.crypto_nanos - before.crypto_nanos) / 1e3;
+  const double digest_micros = (after.digest_nanos - before.digest_nanos) / 1e3;
+  const double host_io_micros =
+      (after.host_io_nanos - before.host_io_nanos) / 1e3;
+  const double other_micros =
+      wall_micros - crypto_micros - digest_micros - host_io_micros;
+  LOG(INFO) << backend.name << " " << phase << ": ops = " << operations
+            << ", wall = " << wall_micros / 1000
+            << " ms, per-op = " << wall_micros / operations
+            << " us, crypto = " << crypto_micros / 1000 << " ms ("
+            << 100 * crypto_micros / wall_micros
+            << "%), digest = " << digest_micros / 1000 << " ms ("
+            << 100 * digest_micros / wall_micros
+            << "%), host I/O = " << host_io_micros / 1000 << " ms ("
+            << 100 * host_io_micros / wall_micros
+            << "%), other = " << other_micros / 1000 << " ms";
+}
+
+class SqliteSecureBenchmark : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = absl::StrCat(absl::GetFlag(FLAGS_test_tmpdir),
+                         "/SqliteSecureBenchmark.db");
+    remove(path_.c_str());
+
+    key_.resize(kKeyLength);
+    ASSERT_EQ(RAND_bytes(key_.data(), key_.size()), 1);
+
+    // SQLite is built with SQLITE_OMIT_AUTOINIT.
+    ASSERT_EQ(sqlite3_initialize(), SQLITE_OK);
+  }
+
+  void TearDown() override { remove(path_.c_str()); }
+
+  IoBackend SecureBackend() {
+    return IoBackend{
+        "secure",
+        /*profiled=*/true,
+        [this](const char *path) {
+          int fd = platform::storage::secure_open(path, O_RDWR | O_CREAT,
+                                                  S_IRWXU | S_IRWXG | S_IRWXO);
+          if (fd >= 0) {
+            CHECK_EQ(AeadHandler::GetInstance().SetMasterKey(fd, key_.data(),
+                                                             key_.size()),
+                     0);
+          }
+          return fd;
+        },
+        platform::storage::secure_read,
+        platform::storage::secure_write,
+        platform::storage::secure_lseek,
+        platform::storage::secure_fsync,
+        platform::storage::secure_close,
+    };
+  }
+
+  IoBackend HostBackend() {
+    return IoBackend{
+        "host",
+        /*profiled=*/false,
+        [](const char *path) {
+          return enc_untrusted_open(path, O_RDWR | O_CREAT,
+                                    S_IRWXU | S_IRWXG | S_IRWXO);
+        },
+        enc_untrusted_read,
+        enc_untrusted_write,
+        enc_untrusted_lseek,
+        enc_untrusted_fsync,
+        enc_untrusted_close,
+    };
+  }
+
+  // Runs the TPC-B-like phases against a database opened through |backend|.
+  void RunWorkload(const IoBackend &backend) {
+    AeadHandler::SetProfilingEnabled(backend.profiled);
+
+    sqlite3_vfs *vfs = BenchmarkVfs();
+    vfs->pAppData = const_cast<IoBackend *>(&backend);
+    ASSERT_EQ(sqlite3_vfs_register(vfs, /*makeDflt=*/0), SQLITE_OK);
+
+    sqlite3 *db = nullptr;
+    ASSERT_EQ(sqlite3_open_v2(path_.c_str(), &db,
+                              SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
+                              kVfsName),
+              SQLITE_OK);
+
+    // Journaling and durability flushes are not under measurement; the small
+    // page cache keeps the query phases reaching the VFS instead of being
+    // absorbed by SQLite's pager cache.
+    Exec(db, "PRAGMA journal_mode = OFF;");
+    Exec(db, "PRAGMA synchronous = OFF;");
+    Exec(db, "PRAGMA temp_store = MEMORY;");
+    Exec(db, "PRAGMA cache_size = 16;");
+
+    // Deterministic access pattern so runs are comparable.
+    std::mt19937 generator(20260829);
+    std::uniform_int_distribution<int> id_dist(1, kRowCount);
+    std::uniform_int_distribution<int> delta_dist(-100, 100);
+
+    // Bulk load in one transaction.
+    AeadHandler::ProfileSnapshot before = AeadHandler::GetProfileSnapshot();
+    double start = NowMicros();
+    Exec(db,
+         "BEGIN; CREATE TABLE accounts (id INTEGER PRIMARY KEY, "
+         "branch INTEGER, balance INTEGER, filler CHAR(84));");
+    sqlite3_stmt *insert =
+        Prepare(db, "INSERT INTO accounts VALUES (?, ?, ?, ?);");
+    const std::string filler(84, 'x');
+    int64_t expected_sum = 0;
+    for (int id = 1; id <= kRowCount; id++) {
+      const int balance = id % 1000;
+      expected_sum += balance;
+      sqlite3_bind_int(insert, 1, id);
+      sqlite3_bind_int(insert, 2, id % 10);
+      sqlite3_bind_int(insert, 3, balance);
+      sqlite3_bind_text(insert, 4, filler.c_str(), filler.size(),
+                        SQLITE_STATIC);
+      ASSERT_EQ(sqlite3_step(insert), SQLITE_DONE);
+      ASSERT_EQ(sqlite3_reset(insert), SQLITE_OK);
+    }
+    sqlite3_finalize(insert);
+    Exec(db, "COMMIT;");
+    ReportPhase(backend, "load", kRowCount, NowMicros() - start, before,
+                AeadHandler::GetProfileSnapshot());
+
+    // Point selects.
+    before = AeadHandler::GetProfileSnapshot();
+    start = NowMicros();
+    sqlite3_stmt *point_select =
+        Prepare(db, "SELECT balance FROM accounts WHERE id = ?;");
+    for (int op = 0; op < kPointSelects; op++) {
+      sqlite3_bind_int(point_select, 1, id_dist(generator));
+      ASSERT_EQ(sqlite3_step(point_select), SQLITE_ROW);
+      ASSERT_EQ(sqlite3_reset(point_select), SQLITE_OK);
+    }
+    sqlite3_finalize(point_select);
+    ReportPhase(backend, "point select", kPointSelects, NowMicros() - start,
+                before, AeadHandler::GetProfileSnapshot());
+
+    // Range aggregates.
+    before = AeadHandler::GetProfileSnapshot();
+    start = NowMicros();
+    sqlite3_stmt *range_select = Prepare(
+        db, "SELECT SUM(balance) FROM accounts WHERE id BETWEEN ? AND ?;");
+    for (int op = 0; op < kRangeSelects; op++) {
+      const int first = id_dist(generator);
+      sqlite3_bind_int(range_select, 1, first);
+      sqlite3_bind_int(range_select, 2, first + kRangeWidth - 1);
+      ASSERT_EQ(sqlite3_step(range_select), SQLITE_ROW);
+      ASSERT_EQ(sqlite3_reset(range_select), SQLITE_OK);
+    }
+    sqlite3_finalize(range_select);
+    ReportPhase(backend, "range aggregate", kRangeSelects, NowMicros() - start,
+                before, AeadHandler::GetProfileSnapshot());
+
+    // Transactional updates.
+    before = AeadHandler::GetProfileSnapshot();
+    start = NowMicros();
+    sqlite3_stmt *update = Prepare(
+        db, "UPDATE accounts SET balance = balance + ? WHERE id = ?;");
+    for (int op = 0; op < kUpdates; op++) {
+      if (op % kUpdateTxnSize == 0) {
+        Exec(db, "BEGIN;");
+      }
+      const int delta = delta_dist(generator);
+      expected_sum += delta;
+      sqlite3_bind_int(update, 1, delta);
+      sqlite3_bind_int(update, 2, id_dist(generator));
+      ASSERT_EQ(sqlite3_step(update), SQLITE_DONE);
+      ASSERT_EQ(sqlite3_reset(update), SQLITE_OK);
+      if ((op + 1) % kUpdateTxnSize == 0 || op + 1 == kUpdates) {
+        Exec(db, "COMMIT;");
+      }
+    }
+    sqlite3_finalize(update);
+    ReportPhase(backend, "update", kUpdates, NowMicros() - start, before,
+                AeadHandler::GetProfileSnapshot());
+
+    // The measurements are only meaningful if the data survived the workload
+    // intact.
+    sqlite3_stmt *sum = Prepare(db, "SELECT SUM(balance) FROM accounts;");
+    ASSERT_EQ(sqlite3_step(sum), SQLITE_ROW);
+    EXPECT_EQ(sqlite3_column_int64(sum, 0), expected_sum);
+    sqlite3_finalize(sum);
+
+    ASSERT_EQ(sqlite3_close(db), SQLITE_OK);
+    AeadHandler::SetProfilingEnabled(false);
+  }
+
+  std::string path_;
+  CleansingVector<uint8_t> key_;
+};
+
+TEST_F(SqliteSecureBenchmark, SecureStorage) { RunWorkload(SecureBackend()); }
+
+TEST_F(SqliteSecureBenchmark, HostBaseline) { RunWorkload(HostBackend()); }
+
+}  // namespace
+}  // namespace asylo
@@ -49,52 +49,30 @@ OffsetTranslator::OffsetTranslator(size_t header_len, size_t payload_len,
       block_length_(block_len) {}
 
 off_t OffsetTranslator::PhysicalToLogical(off_t offset) const {
-  off_t header_length_offset = header_length_;
-  if (offset < header_length_offset) {
-    return kInvalidOffset;
-  }
-
-  off_t tail = (offset - header_length_) % block_length_;
-  if (tail >= payload_length_) {
-    return kInvalidOffset;
-  }
-
-  return ((offset - header_length_) / block_length_) * payload_length_ + tail;
+  return internal::PhysicalToLogicalImpl(offset, header_length_,
+                                         payload_length_, block_length_);
 }
 
 off_t OffsetTranslator::LogicalToPhysical(off_t offset) const {
-  if (offset < 0) {
-    return kInvalidOffset;
-  }
-
-  return header_length_ + (offset / payload_length_) * block_length_ +
-         offset % payload_length_;
+  return internal::LogicalToPhysicalImpl(offset, header_length_,
+                                         payload_length_, block_length_);
 }
 
 void OffsetTranslator::ReduceLogicalRangeToFullLogicalBlocks(
     off_t logical_offset, size_t count, size_t *first_partial_block_bytes_count,
     size_t *last_partial_block_bytes_count,
     size_t *full_inclusive_blocks_bytes_count) {
-  off_t in_block_offset = logical_offset % payload_length_;
-  *first_partial_block_bytes_count =
-      (in_block_offset > 0) ? (payload_length_ - in_block_offset) : 0;
-  *last_partial_block_bytes_count = 0;
-  size_t full_blocks_bytes_count = 0;
-  if (*first_partial_block_bytes_count >= count) {
-    *first_partial_block_bytes_count = count;
-  } else {
-    *last_partial_block_bytes_count =
-        (count - *first_partial_block_bytes_count) % payload_length_;
-    full_blocks_bytes_count = count - *first_partial_block_bytes_count -
-                              *last_partial_block_bytes_count;
-  }
-  *full_inclusive_blocks_bytes_count = full_blocks_bytes_count;
-  if (*first_partial_block_bytes_count > 0) {
-    *full_inclusive_blocks_bytes_count += payload_length_;
-  }
-  if (*last_partial_block_bytes_count > 0) {
-    *full_inclusive_blocks_bytes_count += payload_length_;
-  }
+  internal::ReduceLogicalRangeToFullLogicalBlocksImpl(
+      logical_offset, count, payload_length_, first_partial_block_bytes_count,
+      last_partial_block_bytes_count, full_inclusive_blocks_bytes_count);
+}
+
+size_t OffsetTranslator::LogicalRangeToPhysicalExtents(
+    off_t logical_offset, size_t count,
+    std::vector<PhysicalExtent> *extents) const {
+  return internal::LogicalRangeToPhysicalExtentsImpl(
+      logical_offset, count, header_length_, payload_length_, block_length_,
+      extents);
 }
 
 }  // namespace storage
@@ -20,12 +20,105 @@
 #define ASYLO_PLATFORM_STORAGE_UTILS_OFFSET_TRANSLATOR_H_
 
 #include <sys/types.h>
+
+#include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace asylo {
 namespace platform {
 namespace storage {
 
+// A contiguous physical byte range produced by translating a logical range.
+struct PhysicalExtent {
+  off_t offset;
+  size_t length;
+};
+
+namespace internal {
+
+// Shared translation arithmetic, parameterized on the file geometry. Fixed
+// geometry callers pass compile-time constants, which lets the compiler fold
+// the division/modulo chains into shift/mask sequences for power-of-two
+// lengths and multiply-shift sequences otherwise.
+
+inline off_t PhysicalToLogicalImpl(off_t offset, size_t header_len,
+                                   size_t payload_len, size_t block_len) {
+  off_t header_length_offset = header_len;
+  if (offset < header_length_offset) {
+    return -1;
+  }
+
+  off_t tail = (offset - header_len) % block_len;
+  if (tail >= static_cast<off_t>(payload_len)) {
+    return -1;
+  }
+
+  return ((offset - header_len) / block_len) * payload_len + tail;
+}
+
+inline off_t LogicalToPhysicalImpl(off_t offset, size_t header_len,
+                                   size_t payload_len, size_t block_len) {
+  if (offset < 0) {
+    return -1;
+  }
+
+  return header_len + (offset / payload_len) * block_len +
+         offset % payload_len;
+}
+
+inline void ReduceLogicalRangeToFullLogicalBlocksImpl(
+    off_t logical_offset, size_t count, size_t payload_len,
+    size_t *first_partial_block_bytes_count,
+    size_t *last_partial_block_bytes_count,
+    size_t *full_inclusive_blocks_bytes_count) {
+  off_t in_block_offset = logical_offset % payload_len;
+  *first_partial_block_bytes_count =
+      (in_block_offset > 0) ? (payload_len - in_block_offset) : 0;
+  *last_partial_block_bytes_count = 0;
+  size_t full_blocks_bytes_count = 0;
+  if (*first_partial_block_bytes_count >= count) {
+    *first_partial_block_bytes_count = count;
+  } else {
+    *last_partial_block_bytes_count =
+        (count - *first_partial_block_bytes_count) % payload_len;
+    full_blocks_bytes_count = count - *first_partial_block_bytes_count -
+                              *last_partial_block_bytes_count;
+  }
+  *full_inclusive_blocks_bytes_count = full_blocks_bytes_count;
+  if (*first_partial_block_bytes_count > 0) {
+    *full_inclusive_blocks_bytes_count += payload_len;
+  }
+  if (*last_partial_block_bytes_count > 0) {
+    *full_inclusive_blocks_bytes_count += payload_len;
+  }
+}
+
+inline size_t LogicalRangeToPhysicalExtentsImpl(
+    off_t logical_offset, size_t count, size_t header_len, size_t payload_len,
+    size_t block_len, std::vector<PhysicalExtent> *extents) {
+  if (logical_offset < 0) {
+    return 0;
+  }
+  size_t appended = 0;
+  off_t offset = logical_offset;
+  size_t remaining = count;
+  while (remaining > 0) {
+    size_t in_block = offset % payload_len;
+    size_t chunk = std::min(remaining, payload_len - in_block);
+    extents->push_back(
+        {LogicalToPhysicalImpl(offset, header_len, payload_len, block_len),
+         chunk});
+    offset += chunk;
+    remaining -= chunk;
+    appended++;
+  }
+  return appended;
+}
+
+}  // namespace internal
+
 // Class exposes interface to facilitate translating between "physical" offset
 // in a secure file where file data is interlaced with file metadata, and the
 // "logical" offset in the file's view that does not include file metadata.
@@ -68,6 +161,17 @@ class OffsetTranslator {
       size_t *last_partial_block_bytes_count,
       size_t *full_inclusive_blocks_bytes_count);
 
+  // Translates the logical range [logical_offset, logical_offset + count)
+  // into physical extents, one per payload region touched, and appends them
+  // to |extents| in offset order. Returns the number of extents appended. The
+  // extents are suitable for building an iovec-style multi-range operation
+  // over the physical file; payload regions are separated by metadata, so
+  // consecutive extents are never physically contiguous. Expects non-negative
+  // |logical_offset|.
+  size_t LogicalRangeToPhysicalExtents(off_t logical_offset, size_t count,
+                                       std::vector<PhysicalExtent> *extents)
+      const;
+
  private:
   OffsetTranslator(size_t header_len, size_t payload_len, size_t block_len);
   const size_t header_length_;
@@ -75,6 +179,57 @@ class OffsetTranslator {
   const size_t block_length_;
 };
 
+// OffsetTranslator counterpart whose header/payload/block geometry is fixed
+// at compile time. The translation arithmetic operates on template constants,
+// so the compiler folds the division/modulo chains into shift/mask sequences
+// when kPayloadLength is a power of two and into multiply-shift sequences
+// otherwise - there is no per-call division and no geometry to load. Intended
+// for callers like the secure storage read/write path whose geometry is known
+// when they are built.
+template <size_t kHeaderLength, size_t kPayloadLength, size_t kBlockLength>
+class FixedOffsetTranslator {
+ public:
+  // The layout must not be degenerate - header, payload, and metadata at the
+  // end of the block must all be non-empty.
+  static_assert(kHeaderLength > 0, "header must be non-empty");
+  static_assert(kPayloadLength > 0, "payload must be non-empty");
+  static_assert(kPayloadLength < kBlockLength,
+                "block metadata must be non-empty");
+
+  // Represents an invalid offset.
+  static constexpr off_t kInvalidOffset = -1;
+
+  // The methods below match OffsetTranslator, with the same contracts.
+
+  off_t PhysicalToLogical(off_t offset) const {
+    return internal::PhysicalToLogicalImpl(offset, kHeaderLength,
+                                           kPayloadLength, kBlockLength);
+  }
+
+  off_t LogicalToPhysical(off_t offset) const {
+    return internal::LogicalToPhysicalImpl(offset, kHeaderLength,
+                                           kPayloadLength, kBlockLength);
+  }
+
+  void ReduceLogicalRangeToFullLogicalBlocks(
+      off_t logical_offset, size_t count,
+      size_t *first_partial_block_bytes_count,
+      size_t *last_partial_block_bytes_count,
+      size_t *full_inclusive_blocks_bytes_count) const {
+    internal::ReduceLogicalRangeToFullLogicalBlocksImpl(
+        logical_offset, count, kPayloadLength, first_partial_block_bytes_count,
+        last_partial_block_bytes_count, full_inclusive_blocks_bytes_count);
+  }
+
+  size_t LogicalRangeToPhysicalExtents(
+      off_t logical_offset, size_t count,
+      std::vector<PhysicalExtent> *extents) const {
+    return internal::LogicalRangeToPhysicalExtentsImpl(
+        logical_offset, count, kHeaderLength, kPayloadLength, kBlockLength,
+        extents);
+  }
+};
+
 }  // namespace storage
 }  // namespace platform
 }  // namespace asylo
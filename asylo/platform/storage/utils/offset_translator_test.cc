@@ -191,5 +191,71 @@ TEST_P(OffsetTranslatorTest, ReduceLogicalRangeToFullLogicalBlocksTest) {
   }
 }
 
+TEST(LogicalRangeToPhysicalExtentsTest, OffsetTranslatorTest) {
+  auto translator = OffsetTranslator::Create(10, 40, 50);
+  ASSERT_NE(translator, nullptr);
+
+  // A range within one payload region yields a single extent.
+  std::vector<platform::storage::PhysicalExtent> extents;
+  EXPECT_EQ(translator->LogicalRangeToPhysicalExtents(5, 10, &extents), 1);
+  ASSERT_EQ(extents.size(), 1);
+  EXPECT_EQ(extents[0].offset, 15);
+  EXPECT_EQ(extents[0].length, 10);
+
+  // A range spanning three payload regions yields one extent apiece: the tail
+  // of the first block, the full second block, and the head of the third.
+  extents.clear();
+  EXPECT_EQ(translator->LogicalRangeToPhysicalExtents(30, 60, &extents), 3);
+  ASSERT_EQ(extents.size(), 3);
+  EXPECT_EQ(extents[0].offset, 40);
+  EXPECT_EQ(extents[0].length, 10);
+  EXPECT_EQ(extents[1].offset, 60);
+  EXPECT_EQ(extents[1].length, 40);
+  EXPECT_EQ(extents[2].offset, 110);
+  EXPECT_EQ(extents[2].length, 10);
+
+  // An empty range yields nothing.
+  extents.clear();
+  EXPECT_EQ(translator->LogicalRangeToPhysicalExtents(30, 0, &extents), 0);
+  EXPECT_TRUE(extents.empty());
+}
+
+// Ensure the compile-time specialized translator agrees with the runtime
+// translator over the same geometry.
+TEST(FixedOffsetTranslatorTest, MatchesRuntimeTranslator) {
+  constexpr size_t kHeaderLength = 24;
+  constexpr size_t kPayloadLength = 128;
+  constexpr size_t kBlockLength = 188;
+
+  platform::storage::FixedOffsetTranslator<kHeaderLength, kPayloadLength,
+                                           kBlockLength>
+      fixed;
+  auto runtime =
+      OffsetTranslator::Create(kHeaderLength, kPayloadLength, kBlockLength);
+  ASSERT_NE(runtime, nullptr);
+
+  for (off_t offset = -1;
+       offset < static_cast<off_t>(kHeaderLength + 3 * kBlockLength);
+       offset++) {
+    EXPECT_EQ(fixed.PhysicalToLogical(offset),
+              runtime->PhysicalToLogical(offset));
+  }
+  for (off_t offset = -1; offset < static_cast<off_t>(3 * kPayloadLength);
+       offset++) {
+    EXPECT_EQ(fixed.LogicalToPhysical(offset),
+              runtime->LogicalToPhysical(offset));
+  }
+
+  std::vector<platform::storage::PhysicalExtent> fixed_extents;
+  std::vector<platform::storage::PhysicalExtent> runtime_extents;
+  EXPECT_EQ(fixed.LogicalRangeToPhysicalExtents(100, 300, &fixed_extents),
+            runtime->LogicalRangeToPhysicalExtents(100, 300, &runtime_extents));
+  ASSERT_EQ(fixed_extents.size(), runtime_extents.size());
+  for (size_t i = 0; i < fixed_extents.size(); i++) {
+    EXPECT_EQ(fixed_extents[i].offset, runtime_extents[i].offset);
+    EXPECT_EQ(fixed_extents[i].length, runtime_extents[i].length);
+  }
+}
+
 }  // namespace
 }  // namespace asylo
@@ -0,0 +1,50 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/platform/storage/utils/random_access_storage.h"
+
+#include <utility>
+#include <vector>
+
+namespace asylo {
+
+Status RandomAccessStorage::SubmitRead(void *buffer, off_t offset, size_t size,
+                                       CompletionCallback callback) {
+  ready_.emplace_back(Read(buffer, offset, size), std::move(callback));
+  return Status::OkStatus();
+}
+
+Status RandomAccessStorage::SubmitWrite(const void *buffer, off_t offset,
+                                        size_t size,
+                                        CompletionCallback callback) {
+  ready_.emplace_back(Write(buffer, offset, size), std::move(callback));
+  return Status::OkStatus();
+}
+
+size_t RandomAccessStorage::Poll() {
+  // Swap the ready list out first so that a callback submitting further
+  // operations does not invalidate the iteration.
+  std::vector<std::pair<Status, CompletionCallback>> ready;
+  ready.swap(ready_);
+  for (auto &completion : ready) {
+    completion.second(completion.first);
+  }
+  return ready.size();
+}
+
+}  // namespace asylo
@@ -22,6 +22,9 @@
 #include <sys/types.h>
 
 #include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
 
 #include "asylo/util/asylo_macros.h"
 #include "asylo/util/status.h"
@@ -62,6 +65,42 @@ class RandomAccessStorage {
   // than Size() then the underlying resource is extended to a length of |size|
   // bytes by appending zero-initialized storage.
   virtual ASYLO_MUST_USE_RESULT Status Truncate(size_t size) = 0;
+
+  // Completion callback for an asynchronous operation, invoked from Poll()
+  // with the final status of the operation.
+  using CompletionCallback = std::function<void(Status)>;
+
+  // Submits an asynchronous read of |size| bytes from byte offset |offset|
+  // into |buffer|. The buffer must remain valid until |callback| is invoked.
+  // Callbacks never run inside a submit call; they are deferred to Poll(). A
+  // submission failure means the operation was not queued and its callback
+  // will never run.
+  //
+  // The base implementation performs the operation synchronously at submit
+  // time and defers only its completion to Poll(). Implementations backed by
+  // batched or asynchronous I/O override the submit methods to keep multiple
+  // operations in flight.
+  virtual ASYLO_MUST_USE_RESULT Status SubmitRead(void *buffer, off_t offset,
+                                                  size_t size,
+                                                  CompletionCallback callback);
+
+  // Submits an asynchronous write of |size| bytes at byte offset |offset|
+  // from |buffer|, with the same queueing and callback contract as
+  // SubmitRead(). Extends the resource like Write() if it ends beyond the
+  // current size.
+  virtual ASYLO_MUST_USE_RESULT Status SubmitWrite(const void *buffer,
+                                                   off_t offset, size_t size,
+                                                   CompletionCallback callback);
+
+  // Drives all submitted operations to completion and invokes their
+  // completion callbacks in submission order. Returns the number of
+  // operations completed by this call, whether they succeeded or failed.
+  virtual size_t Poll();
+
+ private:
+  // Operations completed by the base submit implementations, awaiting
+  // callback delivery by Poll().
+  std::vector<std::pair<Status, CompletionCallback>> ready_;
 };
 
 }  // namespace asylo
@@ -23,6 +23,7 @@
 #include <iterator>
 #include <list>
 #include <type_traits>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "asylo/util/logging.h"
@@ -45,10 +46,13 @@ namespace asylo {
 // the same time, for instance to manage a file containing multiple kinds of
 // record along side other kinds of data.
 //
-// Read and write operations are performed via a fixed-size cache using a least-
-// recently-used eviction policy. The cache may be flushed to disk explicitly
-// via Flush(), and is automatically flushed when the RecordStore passes out of
-// scope.
+// Read and write operations are performed via a fixed-size cache using a CLOCK
+// (second chance) eviction policy: references mark a cache entry rather than
+// reordering it, and eviction sweeps for an unmarked victim. Dirty entries are
+// written behind: a write back coalesces the evicted record with cached dirty
+// records at adjacent storage offsets into a single storage write. The cache
+// may be flushed to disk explicitly via Flush(), and is automatically flushed
+// when the RecordStore passes out of scope.
 //
 // This class is not thread-safe. It is the responsibility of the caller to
 // ensure that its methods are not called concurrently.
@@ -87,8 +91,20 @@ class RecordStore {
   // Flushes the cache to persistent storage and ensures the underlying storage
   // resource has been synchronized. Returns an error status on failure.
   ASYLO_MUST_USE_RESULT Status Flush() {
-    for (auto it = cache_.begin(); it != cache_.end(); it++) {
-      ASYLO_RETURN_IF_ERROR(Commit(it));
+    // Commit dirty entries in storage offset order so that records adjacent
+    // in storage coalesce into a single write per contiguous run.
+    std::vector<off_t> dirty;
+    for (const CacheEntry &entry : cache_) {
+      if (entry.dirty) {
+        dirty.push_back(entry.offset);
+      }
+    }
+    std::sort(dirty.begin(), dirty.end());
+    for (off_t offset : dirty) {
+      NodeRef node = index_.find(offset)->second;
+      if (node->dirty) {
+        ASYLO_RETURN_IF_ERROR(CommitRun(node));
+      }
     }
     ASYLO_RETURN_IF_ERROR(io_->Sync());
     return Status::OkStatus();
@@ -101,8 +117,9 @@ class RecordStore {
   // has been modified otherwise.
   ASYLO_MUST_USE_RESULT Status Read(off_t offset, T *item) {
     auto it = index_.find(offset);
+    NodeRef node;
     if (it != index_.end()) {
-      MoveToFront(it->second);
+      node = it->second;
     } else {
       if (count_ < capacity_) {
         cache_.emplace_front();
@@ -110,21 +127,25 @@ class RecordStore {
       } else {
         ASYLO_RETURN_IF_ERROR(Evict());
       }
-      auto first = cache_.begin();
-      Status status = io_->Read(&first->value, offset, sizeof(T));
+      node = cache_.begin();
+      Status status = io_->Read(&node->value, offset, sizeof(T));
       if (!status.ok()) {
         // On read failure, the contents of the head node are undefined. Discard
         // the cache head node to ensure garbage data is not evicted and written
-        // back to disk.
+        // back to disk, moving the clock hand off the node first.
+        if (hand_valid_ && hand_ == node) {
+          hand_valid_ = false;
+        }
         cache_.pop_front();
         count_--;
         return status;
       }
-      first->offset = offset;
-      first->dirty = false;
-      index_[offset] = first;
+      node->offset = offset;
+      node->dirty = false;
+      index_[offset] = node;
     }
-    *item = cache_.begin()->value;
+    node->referenced = true;
+    *item = node->value;
     return Status::OkStatus();
   }
 
@@ -136,8 +157,9 @@ class RecordStore {
   // Flush() is called or the RecordStore is destroyed.
   ASYLO_MUST_USE_RESULT Status Write(off_t offset, const T &item) {
     auto it = index_.find(offset);
+    NodeRef node;
     if (it != index_.end()) {
-      MoveToFront(it->second);
+      node = it->second;
     } else {
       if (count_ < capacity_) {
         // Allocate a new cache entry. Note that existing iterators into cache_
@@ -147,12 +169,13 @@ class RecordStore {
       } else {
         ASYLO_RETURN_IF_ERROR(Evict());
       }
-      cache_.begin()->offset = offset;
-      index_[offset] = cache_.begin();
+      node = cache_.begin();
+      node->offset = offset;
+      index_[offset] = node;
     }
-    auto first = cache_.begin();
-    first->value = item;
-    first->dirty = true;
+    node->value = item;
+    node->dirty = true;
+    node->referenced = true;
     return Status::OkStatus();
   }
 
@@ -162,32 +185,99 @@ class RecordStore {
 
  private:
   struct CacheEntry {
-    off_t offset;  // Byte offset of this record.
-    T value;       // Cached record value.
-    bool dirty;    // True if this entry has been modified.
+    off_t offset;     // Byte offset of this record.
+    T value;          // Cached record value.
+    bool dirty;       // True if this entry has been modified.
+    bool referenced;  // True if this entry was referenced since the last
+                      // sweep of the clock hand.
   };
 
   using NodeRef = typename std::list<CacheEntry>::iterator;
   using ConstNodeRef = typename std::list<CacheEntry>::const_iterator;
 
-  // Writes a cache entry to storage, returning an error status on failure.
-  ASYLO_MUST_USE_RESULT Status Commit(NodeRef entry) {
-    ASYLO_RETURN_IF_ERROR(io_->Write(&entry->value, entry->offset, sizeof(T)));
-    entry->dirty = false;
+  // Writes the run of cached dirty records contiguous in storage with |entry|
+  // back in a single storage write, and marks the whole run clean. Records
+  // are fixed size, so a cached neighbor of a record lies exactly sizeof(T)
+  // bytes away; the common case of records laid out back-to-back makes one
+  // write out of what would otherwise be one write back per record.
+  ASYLO_MUST_USE_RESULT Status CommitRun(NodeRef entry) {
+    constexpr off_t kStride = sizeof(T);
+    off_t start = entry->offset;
+    while (true) {
+      auto it = index_.find(start - kStride);
+      if (it == index_.end() || !it->second->dirty) {
+        break;
+      }
+      start -= kStride;
+    }
+    off_t end = entry->offset + kStride;
+    while (true) {
+      auto it = index_.find(end);
+      if (it == index_.end() || !it->second->dirty) {
+        break;
+      }
+      end += kStride;
+    }
+
+    if (end - start == kStride) {
+      ASYLO_RETURN_IF_ERROR(
+          io_->Write(&entry->value, entry->offset, sizeof(T)));
+      entry->dirty = false;
+      return Status::OkStatus();
+    }
+
+    std::vector<T> run;
+    run.reserve((end - start) / kStride);
+    for (off_t offset = start; offset != end; offset += kStride) {
+      run.push_back(index_.find(offset)->second->value);
+    }
+    ASYLO_RETURN_IF_ERROR(io_->Write(run.data(), start, run.size() * sizeof(T)));
+    for (off_t offset = start; offset != end; offset += kStride) {
+      index_.find(offset)->second->dirty = false;
+    }
     return Status::OkStatus();
   }
 
   // Evicts an entry from the cache and moves the evicted cache node to the
-  // front of the LRU list. Returns an error status on failure.
+  // front of the list for reuse. Returns an error status on failure.
+  //
+  // Victim selection implements the CLOCK policy: the hand sweeps from the
+  // longest-resident entry toward the front of the list, clearing reference
+  // marks and passing over marked entries, and evicts the first unmarked
+  // entry it finds. A dirty victim is written back along with any cached
+  // dirty records contiguous with it in storage.
   ASYLO_MUST_USE_RESULT Status Evict() {
-    auto last = std::prev(cache_.end());
-    ASYLO_RETURN_IF_ERROR(Commit(last));
-    index_.erase(last->offset);
-    MoveToFront(last);
+    if (!hand_valid_) {
+      hand_ = std::prev(cache_.end());
+      hand_valid_ = true;
+    }
+    while (hand_->referenced) {
+      hand_->referenced = false;
+      AdvanceHand();
+    }
+    NodeRef victim = hand_;
+    AdvanceHand();
+    if (victim->dirty) {
+      ASYLO_RETURN_IF_ERROR(CommitRun(victim));
+    }
+    index_.erase(victim->offset);
+    MoveToFront(victim);
     return Status::OkStatus();
   }
 
-  // Moves an LRU list node to the front of the list.
+  // Advances the clock hand one position from older to newer entries,
+  // wrapping from the front of the list back to the longest-resident entry
+  // at the tail. New and recycled nodes enter at the front, so a sweep
+  // visits the longest-resident entries first.
+  void AdvanceHand() {
+    if (hand_ == cache_.begin()) {
+      hand_ = std::prev(cache_.end());
+    } else {
+      --hand_;
+    }
+  }
+
+  // Moves a list node to the front of the list.
   void MoveToFront(ConstNodeRef node) {
     if (node != cache_.begin()) {
       // Splice node onto the front of the list. Note that splice does not
@@ -206,14 +296,21 @@ class RecordStore {
 
   RandomAccessStorage *io_;  // Record backing store.
 
-  // Entries in the cache, maintained in LRU order. This implementation does not
-  // preallocate the cache at the time it is created, opting instead to allocate
-  // entries and add them to a list lazily as they are referenced. This enables
-  // overcommitment of heap capacity at the cost of greater overhead incurred
-  // by the default allocator.
+  // Entries in the cache. New and recycled nodes enter at the front; the
+  // clock hand sweeps the list to select victims. This implementation does
+  // not preallocate the cache at the time it is created, opting instead to
+  // allocate entries and add them to a list lazily as they are referenced.
+  // This enables overcommitment of heap capacity at the cost of greater
+  // overhead incurred by the default allocator.
   std::list<CacheEntry> cache_;
 
-  absl::flat_hash_map<off_t, ConstNodeRef> index_;  // Index by record offset.
+  absl::flat_hash_map<off_t, NodeRef> index_;  // Index by record offset.
+
+  // The clock hand, valid only while hand_valid_ is set. Kept as a lazily
+  // initialized iterator so that moving the RecordStore never leaves the
+  // hand referring to a sentinel of the moved-from list.
+  NodeRef hand_;
+  bool hand_valid_ = false;
 };
 
 }  // namespace asylo
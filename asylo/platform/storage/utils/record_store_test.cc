@@ -22,6 +22,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "asylo/platform/storage/utils/fd_closer.h"
+#include "asylo/platform/storage/utils/random_access_storage.h"
 #include "asylo/platform/storage/utils/record_store.h"
 #include "asylo/platform/storage/utils/test_utils.h"
 #include "asylo/platform/storage/utils/untrusted_file.h"
@@ -30,6 +31,34 @@
 namespace asylo {
 namespace {
 
+// A storage wrapper which counts the write operations issued to its backing
+// store.
+class CountingStorage : public RandomAccessStorage {
+ public:
+  explicit CountingStorage(RandomAccessStorage *base) : base_(base) {}
+
+  StatusOr<size_t> Size() const override { return base_->Size(); }
+
+  Status Read(void *buffer, off_t offset, size_t size) override {
+    return base_->Read(buffer, offset, size);
+  }
+
+  Status Write(const void *buffer, off_t offset, size_t size) override {
+    write_count_++;
+    return base_->Write(buffer, offset, size);
+  }
+
+  Status Sync() override { return base_->Sync(); }
+
+  Status Truncate(size_t size) override { return base_->Truncate(size); }
+
+  size_t write_count() const { return write_count_; }
+
+ private:
+  RandomAccessStorage *base_;
+  size_t write_count_ = 0;
+};
+
 // Ensure that reading and writing records through a RecordStore returns the
 // expected values.
 TEST(RecordStoreTest, WriteRead) {
@@ -94,6 +123,36 @@ TEST(RecordStoreTest, Eviction) {
   }
 }
 
+// Ensure that contiguous dirty records are written back in coalesced runs
+// rather than one storage write per record.
+TEST(RecordStoreTest, CoalescedWriteBack) {
+  int fd = CreateEmptyTempFileOrDie("coalesced_write_back.tmp");
+  platform::storage::FdCloser closer(fd);
+  UntrustedFile file(fd);
+  CountingStorage storage(&file);
+
+  constexpr size_t kCapacity = 16;
+  constexpr size_t kRecordCount = 64;
+
+  {
+    RecordStore<size_t> records(kCapacity, &storage);
+    for (size_t i = 0; i < kRecordCount; i++) {
+      ASYLO_EXPECT_OK(records.Write(i * sizeof(size_t), i));
+    }
+    ASYLO_ASSERT_OK(records.Flush());
+  }
+
+  // Sequential records fill the cache with one contiguous dirty run, so each
+  // write back covers a full cache worth of records in a single write.
+  EXPECT_EQ(storage.write_count(), kRecordCount / kCapacity);
+
+  for (size_t i = 0; i < kRecordCount; i++) {
+    size_t record;
+    ASYLO_EXPECT_OK(file.Read(&record, i * sizeof(size_t), sizeof(size_t)));
+    EXPECT_EQ(record, i);
+  }
+}
+
 // Ensure that cached writes are flushed when a RecordStore goes out of scope.
 TEST(RecordStoreTest, Flush) {
   int fd = CreateEmptyTempFileOrDie("flush.tmp");
@@ -19,15 +19,32 @@
 #include "asylo/platform/storage/utils/untrusted_file.h"
 
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
 #include "asylo/util/posix_error_space.h"
 
 namespace asylo {
 
+namespace {
+
+// Maximum number of operations coalesced into one vectored transfer, kept
+// comfortably below IOV_MAX.
+constexpr size_t kMaxRunSegments = 64;
+
+}  // namespace
+
 UntrustedFile::UntrustedFile(int fd) : fd_(fd) {}
 
 UntrustedFile::~UntrustedFile() {
+  // Drive any still-queued asynchronous operations to completion before the
+  // final sync so their writes are not dropped.
+  Poll();
   Status result = Sync();
   if (!result.ok()) {
     LOG(ERROR) << "Unexpected failure in Sync() when closing an UntrustedFile: "
@@ -118,6 +135,115 @@ Status UntrustedFile::Write(const void *buffer, off_t offset, size_t size) {
   return Status::OkStatus();
 }
 
+Status UntrustedFile::SubmitRead(void *buffer, off_t offset, size_t size,
+                                 CompletionCallback callback) {
+  pending_.push_back(
+      {/*is_write=*/false, buffer, offset, size, std::move(callback)});
+  return Status::OkStatus();
+}
+
+Status UntrustedFile::SubmitWrite(const void *buffer, off_t offset, size_t size,
+                                  CompletionCallback callback) {
+  pending_.push_back({/*is_write=*/true, const_cast<void *>(buffer), offset,
+                      size, std::move(callback)});
+  return Status::OkStatus();
+}
+
+Status UntrustedFile::ExecuteRun(const std::vector<PendingOp> &ops,
+                                 const std::vector<size_t> &order, size_t first,
+                                 size_t last) {
+  std::vector<struct iovec> iov;
+  iov.reserve(last - first);
+  size_t total = 0;
+  for (size_t i = first; i < last; ++i) {
+    const PendingOp &op = ops[order[i]];
+    iov.push_back({op.buffer, op.size});
+    total += op.size;
+  }
+  const bool is_write = ops[order[first]].is_write;
+  off_t offset = ops[order[first]].offset;
+
+  size_t segment = 0;
+  while (total > 0) {
+    ssize_t result =
+        is_write ? pwritev(fd_, &iov[segment], iov.size() - segment, offset)
+                 : preadv(fd_, &iov[segment], iov.size() - segment, offset);
+    if (result == 0) {
+      return is_write ? Status{error::RESOURCE_EXHAUSTED,
+                               "pwritev() failed in UntrustedFile::Poll()"}
+                      : Status{error::NOT_FOUND,
+                               "preadv() failed in UntrustedFile::Poll()"};
+    }
+    if (result < 0) {
+      return Status{static_cast<error::PosixError>(errno),
+                    is_write ? "pwritev() failed in UntrustedFile::Poll()"
+                             : "preadv() failed in UntrustedFile::Poll()"};
+    }
+    offset += result;
+    total -= result;
+
+    // Consume fully transferred segments and trim a partially transferred
+    // one so a short transfer resumes where it stopped.
+    size_t transferred = result;
+    while (transferred > 0 && transferred >= iov[segment].iov_len) {
+      transferred -= iov[segment].iov_len;
+      segment++;
+    }
+    if (transferred > 0) {
+      iov[segment].iov_base =
+          reinterpret_cast<uint8_t *>(iov[segment].iov_base) + transferred;
+      iov[segment].iov_len -= transferred;
+    }
+  }
+
+  return Status::OkStatus();
+}
+
+size_t UntrustedFile::Poll() {
+  // Swap the queue out first so that a callback submitting further operations
+  // does not invalidate the iteration.
+  std::vector<PendingOp> ops;
+  ops.swap(pending_);
+  if (ops.empty()) {
+    return 0;
+  }
+
+  // Visit operations in offset order so that operations contiguous in the
+  // file coalesce into a single vectored transfer per run.
+  std::vector<size_t> order(ops.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&ops](size_t a, size_t b) {
+    return ops[a].offset < ops[b].offset;
+  });
+
+  std::vector<Status> statuses(ops.size());
+  size_t first = 0;
+  while (first < order.size()) {
+    const PendingOp &head = ops[order[first]];
+    size_t last = first + 1;
+    off_t run_end = head.offset + head.size;
+    while (last < order.size() && last - first < kMaxRunSegments &&
+           ops[order[last]].is_write == head.is_write &&
+           ops[order[last]].offset == run_end) {
+      run_end += ops[order[last]].size;
+      last++;
+    }
+    Status status = ExecuteRun(ops, order, first, last);
+    if (!status.ok()) {
+      for (size_t i = first; i < last; ++i) {
+        statuses[order[i]] = status;
+      }
+    }
+    first = last;
+  }
+
+  // Deliver completions in submission order.
+  for (size_t i = 0; i < ops.size(); ++i) {
+    ops[i].callback(statuses[i]);
+  }
+  return ops.size();
+}
+
 Status UntrustedFile::Truncate(size_t size) {
   if (ftruncate(fd_, size) != 0) {
     return Status{static_cast<error::PosixError>(errno),
@@ -19,6 +19,11 @@
 #ifndef ASYLO_PLATFORM_STORAGE_UTILS_UNTRUSTED_FILE_H_
 #define ASYLO_PLATFORM_STORAGE_UTILS_UNTRUSTED_FILE_H_
 
+#include <sys/types.h>
+
+#include <cstddef>
+#include <vector>
+
 #include "asylo/platform/storage/utils/random_access_storage.h"
 
 namespace asylo {
@@ -45,8 +50,41 @@ class UntrustedFile : public RandomAccessStorage {
 
   Status Truncate(size_t size) override;
 
+  // Asynchronous submission. Operations are queued at submit time and
+  // executed by Poll(), which sorts them by offset and issues each run of
+  // operations contiguous in the file as one vectored preadv(2)/pwritev(2)
+  // transfer. Inside an enclave a vectored transfer costs a single host call,
+  // so several queued operations complete with one boundary crossing instead
+  // of one apiece. If a transfer fails, every operation in its run completes
+  // with that error.
+  Status SubmitRead(void *buffer, off_t offset, size_t size,
+                    CompletionCallback callback) override;
+
+  Status SubmitWrite(const void *buffer, off_t offset, size_t size,
+                     CompletionCallback callback) override;
+
+  size_t Poll() override;
+
  private:
+  // One queued asynchronous operation awaiting execution by Poll().
+  struct PendingOp {
+    bool is_write;
+    void *buffer;
+    off_t offset;
+    size_t size;
+    CompletionCallback callback;
+  };
+
+  // Executes the operations of |ops| selected by [first, last) of |order| as
+  // a single vectored transfer starting at the first operation's offset.
+  Status ExecuteRun(const std::vector<PendingOp> &ops,
+                    const std::vector<size_t> &order, size_t first,
+                    size_t last);
+
   int fd_;
+
+  // Operations queued by the submit methods, in submission order.
+  std::vector<PendingOp> pending_;
 };
 
 }  // namespace asylo
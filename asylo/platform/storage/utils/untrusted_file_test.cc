@@ -18,6 +18,9 @@
 
 #include "asylo/platform/storage/utils/untrusted_file.h"
 
+#include <utility>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "asylo/platform/storage/utils/fd_closer.h"
@@ -77,5 +80,59 @@ TEST(UntrustedFileTest, WriteHoles) {
   }
 }
 
+// Ensure that asynchronously submitted operations complete at Poll() with
+// callbacks delivered in submission order.
+TEST(UntrustedFileTest, AsyncSubmitPoll) {
+  int fd = CreateEmptyTempFileOrDie("async_submit_poll.tmp");
+  platform::storage::FdCloser closer(fd);
+
+  UntrustedFile file(fd);
+  constexpr int kCount = 64;
+
+  // Submit contiguous writes out of order; nothing executes before Poll().
+  int values[kCount];
+  std::vector<int> completions;
+  for (int i = kCount - 1; i >= 0; i--) {
+    values[i] = i;
+    ASYLO_EXPECT_OK(file.SubmitWrite(
+        &values[i], i * sizeof(int), sizeof(int), [&completions, i](Status s) {
+          ASYLO_EXPECT_OK(s);
+          completions.push_back(i);
+        }));
+  }
+  EXPECT_THAT(file.Size(), IsOkAndHolds(0));
+  EXPECT_EQ(file.Poll(), kCount);
+  ASSERT_EQ(completions.size(), kCount);
+  for (int i = 0; i < kCount; i++) {
+    EXPECT_EQ(completions[i], kCount - 1 - i);
+  }
+  EXPECT_THAT(file.Size(), IsOkAndHolds(kCount * sizeof(int)));
+
+  // Reads submitted in one batch complete with the written values.
+  int records[kCount];
+  size_t read_completions = 0;
+  for (int i = 0; i < kCount; i++) {
+    ASYLO_EXPECT_OK(file.SubmitRead(&records[i], i * sizeof(int), sizeof(int),
+                                    [&read_completions](Status s) {
+                                      ASYLO_EXPECT_OK(s);
+                                      read_completions++;
+                                    }));
+  }
+  EXPECT_EQ(file.Poll(), kCount);
+  EXPECT_EQ(read_completions, kCount);
+  for (int i = 0; i < kCount; i++) {
+    EXPECT_EQ(records[i], i);
+  }
+
+  // A read past the end of the file fails its completion.
+  int record;
+  Status async_status;
+  ASYLO_EXPECT_OK(file.SubmitRead(
+      &record, (kCount + 1) * sizeof(int), sizeof(int),
+      [&async_status](Status s) { async_status = std::move(s); }));
+  EXPECT_EQ(file.Poll(), 1);
+  EXPECT_FALSE(async_status.ok());
+}
+
 }  // namespace
 }  // namespace asylo
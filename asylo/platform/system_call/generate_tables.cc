@@ -303,9 +303,9 @@ void EmitSystemCallTable(std::ostream *os) {
 
   int last = SystemCallTable()->rbegin()->first;
 
-  *os << "const size_t kSystemCallTableSize = " << last + 1 << ";\n";
+  *os << "constexpr size_t kSystemCallTableSize = " << last + 1 << ";\n";
   *os << "\n";
-  *os << "const SystemCallTableEntry kSystemCallTable[] = {\n";
+  *os << "constexpr SystemCallTableEntry kSystemCallTable[] = {\n";
   for (int i = 0; i <= last; i++) {
     auto it = SystemCallTable()->find(i);
     std::string name;
@@ -328,7 +328,7 @@ void EmitSystemCallTable(std::ostream *os) {
 
 // Emits a table of parameter descriptions.
 void EmitParameterTable(std::ostream *os) {
-  *os << "const ParameterTableEntry kParameterTable[] = {\n";
+  *os << "constexpr ParameterTableEntry kParameterTable[] = {\n";
   for (size_t i = 0; i < ParameterTable()->size(); i++) {
     const ParameterDescription &desc = (*ParameterTable())[i];
     *os << absl::StreamFormat(
@@ -337,6 +337,9 @@ void EmitParameterTable(std::ostream *os) {
         desc.element_size);
   }
   *os << "};\n";
+  *os << "\n";
+  *os << "constexpr size_t kParameterTableSize = "
+      << "sizeof(kParameterTable) / sizeof(kParameterTable[0]);\n";
 }
 
 int main(int argc, char **argv) {
@@ -19,6 +19,7 @@
 #include "asylo/platform/system_call/message.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <string>
 #include <vector>
@@ -50,6 +51,89 @@ bool SumOverflowOnRoundUpToMultipleOf8(uint64_t v1, uint64_t v2) {
          v1 > RoundDownToMultipleOf8(SIZE_MAX) - v2;
 }
 
+// Sentinel for parameters whose encoded size cannot be determined from the
+// metadata tables alone (strings and bounded buffers).
+constexpr uint32_t kVariableSize = UINT32_MAX;
+
+// Per-sysno validation template precomputed from the metadata tables, so that
+// validating a message on the dispatch path reduces to mask tests and integer
+// comparisons rather than repeated descriptor table walks.
+struct ValidationTemplate {
+  // True if the sysno has a descriptor table entry.
+  bool valid;
+
+  // Bit |i| is set if parameter |i| is present in request encodings.
+  uint8_t request_used_mask;
+
+  // Bit |i| is set if parameter |i| is present in response encodings.
+  uint8_t response_used_mask;
+
+  // Bit |i| is set if parameter |i| is a null-terminated string.
+  uint8_t string_mask;
+
+  // Bit |i| is set if parameter |i| may be carried out-of-line by the
+  // scatter-gather encoding (bulk bounded pointers only).
+  uint8_t out_of_line_ok_mask;
+
+  // Exact required encoding size of each parameter, or kVariableSize if the
+  // size depends on the message contents.
+  uint32_t required_size[kParameterMax];
+};
+
+// Table of validation templates indexed by sysno, built on first use and never
+// freed. Lazy initialization avoids dynamic initialization order issues, as
+// this code runs inside the enclave as well as in the untrusted dispatcher.
+std::atomic<const ValidationTemplate *> validation_templates{nullptr};
+
+const ValidationTemplate *GetValidationTemplates() {
+  const ValidationTemplate *table =
+      validation_templates.load(std::memory_order_acquire);
+  if (table) {
+    return table;
+  }
+
+  auto *fresh = new ValidationTemplate[LastSystemCall() + 1]();
+  for (int sysno = 0; sysno <= LastSystemCall(); sysno++) {
+    ValidationTemplate &entry = fresh[sysno];
+    SystemCallDescriptor syscall(sysno);
+    entry.valid = syscall.is_valid();
+    for (int i = 0; i < kParameterMax; i++) {
+      entry.required_size[i] = kVariableSize;
+      ParameterDescriptor parameter = syscall.parameter(i);
+      if (!parameter.is_valid()) {
+        continue;
+      }
+      if (parameter.is_in()) {
+        entry.request_used_mask |= 1 << i;
+      }
+      if (parameter.is_out()) {
+        entry.response_used_mask |= 1 << i;
+      }
+      if (parameter.is_string()) {
+        entry.string_mask |= 1 << i;
+      }
+      if (parameter.is_pointer() && parameter.is_bounded()) {
+        entry.out_of_line_ok_mask |= 1 << i;
+      }
+      if (parameter.is_scalar()) {
+        entry.required_size[i] = sizeof(uint64_t);
+      } else if (parameter.is_fixed()) {
+        entry.required_size[i] = parameter.size();
+      }
+    }
+  }
+
+  const ValidationTemplate *expected = nullptr;
+  if (!validation_templates.compare_exchange_strong(expected, fresh,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_acquire)) {
+    // Another thread won the race to install its table.
+    delete[] fresh;
+    return expected;
+  }
+  return fresh;
+}
+
 }  // namespace
 
 std::string FormatMessage(primitives::Extent extent) {
@@ -91,47 +175,6 @@ std::string FormatMessage(primitives::Extent extent) {
   return result;
 }
 
-bool MessageReader::IsValidParameterSize(int index) const {
-  if (!parameter_is_used(index)) {
-    return true;
-  }
-
-  SystemCallDescriptor syscall(sysno());
-  ParameterDescriptor parameter = syscall.parameter(index);
-  if (parameter.is_scalar()) {
-    return header()->size[index] == sizeof(uint64_t);
-  }
-
-  if (parameter.is_fixed()) {
-    return header()->size[index] == parameter.size();
-  }
-
-  if (header()->size[index] == 0) {
-    return true;
-  }
-
-  if (parameter.is_string()) {
-    const char *value =
-        this->parameter_address<const char *>(parameter.index());
-
-    if (value[header()->size[index] - 1] != '\0') {
-      return false;
-    }
-
-    return header()->size[index] == strlen(value) + 1;
-  }
-
-  // Bounded parameter size could not be verified here, simply return true.
-  // The general validations that checks parameter size does not extend outside
-  // the message still apply.
-  if (parameter.is_bounded()) {
-    return true;
-  }
-
-  // The following line is expected to be unreachable.
-  abort();
-}
-
 primitives::PrimitiveStatus MessageReader::invalid_argument_status(
     const std::string &reason) const {
   return primitives::PrimitiveStatus{
@@ -168,12 +211,32 @@ primitives::PrimitiveStatus MessageReader::ValidateMessageHeader() const {
 primitives::PrimitiveStatus MessageReader::Validate() const {
   ASYLO_RETURN_IF_ERROR(ValidateMessageHeader());
 
-  size_t next_offset = sizeof(MessageHeader);
-  SystemCallDescriptor syscall(sysno());
+  // The sysno is range checked by ValidateMessageHeader, so indexing the
+  // template table is safe. From here on validation is mask tests and integer
+  // comparisons against the precomputed template; the only data-dependent work
+  // left is the null-terminator scan for string parameters.
+  const ValidationTemplate &entry = GetValidationTemplates()[sysno()];
+  const uint8_t used_mask =
+      is_request() ? entry.request_used_mask : entry.response_used_mask;
 
+  size_t next_offset = sizeof(MessageHeader);
   for (int i = 0; i < kParameterMax; i++) {
-    ParameterDescriptor parameter = syscall.parameter(i);
-    if (!parameter_is_used(parameter)) {
+    if (!(used_mask & (1 << i))) {
+      continue;
+    }
+
+    const uint64_t size = header()->size[i];
+
+    if (parameter_is_out_of_line(i)) {
+      // Out-of-line parameters occupy no space in the message body; their
+      // contents travel as separate extents which the caller validates
+      // against the recorded size. Only bulk bounded pointers may be carried
+      // out-of-line.
+      if (!(entry.out_of_line_ok_mask & (1 << i))) {
+        return invalid_argument_status(
+            absl::StrCat("Message malformed: parameter under index ", i,
+                         " may not be carried out-of-line"));
+      }
       continue;
     }
 
@@ -183,23 +246,36 @@ primitives::PrimitiveStatus MessageReader::Validate() const {
                        " has drifted offset"));
     }
 
-    if (SumOverflowOnRoundUpToMultipleOf8(header()->size[i], next_offset)) {
+    if (SumOverflowOnRoundUpToMultipleOf8(size, next_offset)) {
       return invalid_argument_status(
           absl::StrCat("Message malformed: parameter under index ", i,
                        " resides above max offset"));
     }
 
-    next_offset = RoundUpToMultipleOf8(next_offset + header()->size[i]);
+    next_offset = RoundUpToMultipleOf8(next_offset + size);
     if (next_offset > extent_.size()) {
       return invalid_argument_status(
           absl::StrCat("Message malformed: parameter under index ", i,
                        " overflowed from buffer memory"));
     }
 
-    if (!IsValidParameterSize(i)) {
+    if (entry.required_size[i] != kVariableSize &&
+        size != entry.required_size[i]) {
       return invalid_argument_status(absl::StrCat(
           "Message malformed: parameter under index ", i, " size mismatched"));
     }
+
+    if ((entry.string_mask & (1 << i)) && size != 0) {
+      // String parameters must carry their terminating null in the last
+      // encoded byte. The bounds of the string were established by the offset
+      // checks above.
+      const char *value = extent_.As<char>() + header()->offset[i];
+      if (value[size - 1] != '\0' || strlen(value) + 1 != size) {
+        return invalid_argument_status(
+            absl::StrCat("Message malformed: parameter under index ", i,
+                         " size mismatched"));
+      }
+    }
   }
 
   return primitives::PrimitiveStatus::OkStatus();
@@ -231,11 +307,12 @@ bool MessageReader::parameter_is_used(int index) const {
 
 MessageWriter::MessageWriter(
     int sysno, uint64_t result, uint64_t error_number, bool is_request,
-    const std::array<uint64_t, kParameterMax> &parameters)
+    bool scatter_gather, const std::array<uint64_t, kParameterMax> &parameters)
     : sysno_(sysno),
       result_(result),
       error_number_(error_number),
       is_request_(is_request),
+      scatter_gather_(scatter_gather),
       parameters_(parameters) {
   SystemCallDescriptor syscall{sysno};
   for (int i = 0; i < kParameterMax; i++) {
@@ -245,18 +322,48 @@ MessageWriter::MessageWriter(
 
 MessageWriter MessageWriter::RequestWriter(
     int sysno, const std::array<uint64_t, kParameterMax> &parameters) {
-  return MessageWriter(sysno, 0, 0, true, parameters);
+  return MessageWriter(sysno, 0, 0, true, false, parameters);
 }
 
 MessageWriter MessageWriter::ResponseWriter(
     int sysno, uint64_t result, uint64_t error_number,
     const std::array<uint64_t, kParameterMax> &parameters) {
-  return MessageWriter(sysno, result, error_number, false, parameters);
+  return MessageWriter(sysno, result, error_number, false, false, parameters);
+}
+
+MessageWriter MessageWriter::SgRequestWriter(
+    int sysno, const std::array<uint64_t, kParameterMax> &parameters) {
+  return MessageWriter(sysno, 0, 0, true, true, parameters);
+}
+
+MessageWriter MessageWriter::SgResponseWriter(
+    int sysno, uint64_t result, uint64_t error_number,
+    const std::array<uint64_t, kParameterMax> &parameters) {
+  return MessageWriter(sysno, result, error_number, false, true, parameters);
+}
+
+bool MessageWriter::IsOutOfLine(ParameterDescriptor parameter) const {
+  // Only bulk pointer parameters whose size is bounded by another parameter
+  // (read/write-style buffers) are worth carrying out-of-line; strings and
+  // fixed-size structures are small and stay in the message body. Null
+  // pointers are encoded inline as zero-size fields.
+  return scatter_gather_ && parameter_is_used(parameter) &&
+         parameter.is_pointer() && parameter.is_bounded() &&
+         parameters_[parameter.index()] != 0;
+}
+
+bool MessageWriter::parameter_is_out_of_line(int index) const {
+  SystemCallDescriptor syscall(sysno_);
+  return IsOutOfLine(syscall.parameter(index));
 }
 
 size_t MessageWriter::MessageSize() const {
+  SystemCallDescriptor syscall(sysno_);
   size_t result = sizeof(MessageHeader);
   for (int i = 0; i < kParameterMax; i++) {
+    if (IsOutOfLine(syscall.parameter(i))) {
+      continue;
+    }
     result += RoundUpToMultipleOf8(parameter_size_[i]);
   }
   return result;
@@ -327,6 +434,9 @@ bool MessageWriter::Write(primitives::Extent *message) const {
   auto *header = reinterpret_cast<MessageHeader *>(message->data());
   header->magic = kMessageMagic;
   header->flags = is_request_ ? kSystemCallRequest : kSystemCallResponse;
+  if (scatter_gather_) {
+    header->flags |= kSystemCallScatterGather;
+  }
   header->sysno = sysno_;
 
   // If this is a response message, add the result value to the message header.
@@ -345,6 +455,15 @@ bool MessageWriter::Write(primitives::Extent *message) const {
       continue;
     }
 
+    // Out-of-line parameters contribute no bytes to the message body; record
+    // their size and mark the offset so readers know to find their contents
+    // in an accompanying extent.
+    if (IsOutOfLine(parameter)) {
+      header->offset[i] = kOutOfLineOffset;
+      header->size[i] = parameter_size_[i];
+      continue;
+    }
+
     // If this parameter is a pointer and not null, then copy its contents into
     // the body of the message. Null pointers are encoded as having a size of
     // zero.
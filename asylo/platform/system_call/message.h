@@ -21,6 +21,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include "absl/base/attributes.h"
@@ -34,9 +35,19 @@ namespace system_call {
 // Serialized system call flag values.
 enum MessageFlags : uint32_t {
   kSystemCallRequest = 0x1,
-  kSystemCallResponse = 0x2
+  kSystemCallResponse = 0x2,
+  // The message uses the scatter-gather encoding: bulk pointer parameters are
+  // carried out-of-line as separate extents rather than copied into the
+  // message body.
+  kSystemCallScatterGather = 0x4
 };
 
+// Offset sentinel recorded for parameters carried out-of-line by the
+// scatter-gather encoding. Such parameters occupy no space in the message
+// buffer; their contents travel as separate extents accompanying the message,
+// in increasing parameter index order.
+constexpr uint64_t kOutOfLineOffset = UINT64_MAX;
+
 // Message magic number = "syscal\0".
 constexpr uint64_t kMessageMagic = 0x1006c6163737973;
 
@@ -86,6 +97,17 @@ class MessageReader {
   // Returns true is this message is a system call request.
   bool is_response() const { return header()->flags & kSystemCallResponse; }
 
+  // Returns true if this message uses the scatter-gather encoding.
+  bool is_scatter_gather() const {
+    return header()->flags & kSystemCallScatterGather;
+  }
+
+  // Returns true if the parameter at offset |index| into the parameter list is
+  // carried out-of-line as a separate extent rather than in the message body.
+  bool parameter_is_out_of_line(int index) const {
+    return is_scatter_gather() && header()->offset[index] == kOutOfLineOffset;
+  }
+
   // Returns the system call encoded by the message.
   int sysno() const { return header()->sysno; }
 
@@ -114,7 +136,7 @@ class MessageReader {
   // returns it.
   template <typename T = const void *>
   T parameter_address(int index) const {
-    return parameter_size(index) > 0
+    return parameter_size(index) > 0 && !parameter_is_out_of_line(index)
                ? reinterpret_cast<T>(extent_.As<char>() + offset(index))
                : T(0);
   }
@@ -142,9 +164,6 @@ class MessageReader {
   // encoding.
   bool parameter_is_used(ParameterDescriptor parameter) const;
 
-  // Returns true if the parameter size is correct.
-  bool IsValidParameterSize(int index) const;
-
   primitives::Extent extent_;
 };
 
@@ -160,6 +179,21 @@ class MessageWriter {
       int sysno, uint64_t result, uint64_t error_number,
       const std::array<uint64_t, kParameterMax> &parameters);
 
+  // Construct a scatter-gather request writer. Bulk pointer parameters are
+  // recorded in the header but excluded from the message body; the caller is
+  // responsible for transporting them as separate extents.
+  static MessageWriter SgRequestWriter(
+      int sysno, const std::array<uint64_t, kParameterMax> &parameters);
+
+  // Construct a scatter-gather response writer.
+  static MessageWriter SgResponseWriter(
+      int sysno, uint64_t result, uint64_t error_number,
+      const std::array<uint64_t, kParameterMax> &parameters);
+
+  // Returns true if the parameter at offset |index| into the parameters list
+  // is carried out-of-line by this encoding.
+  bool parameter_is_out_of_line(int index) const;
+
   // Returns the size of the configured message.
   size_t MessageSize() const;
 
@@ -169,9 +203,12 @@ class MessageWriter {
 
  private:
   MessageWriter(int sysno, uint64_t result, uint64_t error_number,
-                bool is_request,
+                bool is_request, bool scatter_gather,
                 const std::array<uint64_t, kParameterMax> &parameters);
 
+  // Returns true if a parameter is carried out-of-line by this encoding.
+  bool IsOutOfLine(ParameterDescriptor parameter) const;
+
   // Returns true if the parameter into the parameters list is used by this
   // encoding.
   bool parameter_is_used(ParameterDescriptor parameter) const;
@@ -191,6 +228,7 @@ class MessageWriter {
   uint64_t result_;
   uint64_t error_number_;
   bool is_request_;
+  bool scatter_gather_;
   const std::array<uint64_t, kParameterMax> parameters_;
   std::array<size_t, kParameterMax> parameter_size_;
 };
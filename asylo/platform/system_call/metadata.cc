@@ -54,9 +54,63 @@ struct ParameterTableEntry {
   const uint32_t element_size;
 };
 
-// Include the metadata tables generated at build time.
+// Include the metadata tables generated at build time. The tables are
+// constexpr and constant-initialized: no work happens at startup and every
+// lookup below is a dense array index.
 #include "asylo/platform/system_call/generated_tables.inc"
 
+// Checks that every system call entry stays within the bounds of the
+// parameter table, so that lookups validated against parameter_count never
+// need a bound check against the table itself.
+constexpr bool ValidateSystemCallTable() {
+  for (size_t i = 0; i < kSystemCallTableSize; ++i) {
+    const SystemCallTableEntry &entry = kSystemCallTable[i];
+    if (entry.name == nullptr) {
+      if (entry.parameter_count != 0 || entry.parameter_index != 0) {
+        return false;
+      }
+      continue;
+    }
+    if (entry.parameter_count > kParameterMax) {
+      return false;
+    }
+    if (entry.parameter_index + entry.parameter_count > kParameterTableSize) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Checks invariants of the parameter descriptions themselves: each parameter
+// is a scalar or a pointer, and a bounded parameter names an in-range
+// bounding parameter and a nonzero element stride.
+constexpr bool ValidateParameterTable() {
+  for (size_t i = 0; i < kSystemCallTableSize; ++i) {
+    const SystemCallTableEntry &entry = kSystemCallTable[i];
+    if (entry.name == nullptr) {
+      continue;
+    }
+    for (size_t j = 0; j < entry.parameter_count; ++j) {
+      const ParameterTableEntry &parameter =
+          kParameterTable[entry.parameter_index + j];
+      if (!(parameter.flags & (kScalar | kPointer))) {
+        return false;
+      }
+      if (parameter.flags & kBounded) {
+        if (parameter.size >= entry.parameter_count ||
+            parameter.element_size == 0) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+static_assert(ValidateSystemCallTable(),
+              "malformed generated system call table");
+static_assert(ValidateParameterTable(), "malformed generated parameter table");
+
 // Returns the index of an entry into the parameter table. This routine does not
 // bound check its input and assumes the passed parameters have already been
 // validated.
@@ -19,8 +19,11 @@
 #include "asylo/platform/system_call/serialize.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdlib>
 #include <numeric>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "asylo/platform/primitives/primitive_status.h"
@@ -37,11 +40,41 @@ typename T::value_type Sum(const T &values) {
   return std::accumulate(values.begin(), values.end(),
                          static_cast<typename T::value_type>(0));
 }
+
+// Allocates a message buffer from `provider`, falling back to malloc when no
+// provider is given.
+uint8_t *AllocateMessage(size_t size, BufferProvider provider) {
+  return provider ? provider(size) : reinterpret_cast<uint8_t *>(malloc(size));
+}
+
+// Writes a scatter-gather message into `extents`: a fixed-layout message
+// first, then one aliasing extent per out-of-line parameter, in increasing
+// parameter index order.
+primitives::PrimitiveStatus WriteScatterGather(
+    const MessageWriter &writer,
+    const std::array<uint64_t, kParameterMax> &parameters,
+    std::vector<primitives::Extent> *extents, BufferProvider provider) {
+  size_t size = writer.MessageSize();
+  primitives::Extent message = {AllocateMessage(size, provider), size};
+  writer.Write(&message);
+
+  extents->clear();
+  extents->push_back(message);
+  MessageReader reader(message);
+  for (int i = 0; i < kParameterMax; i++) {
+    if (writer.parameter_is_out_of_line(i)) {
+      extents->push_back({reinterpret_cast<uint8_t *>(parameters[i]),
+                          reader.parameter_size(i)});
+    }
+  }
+  return primitives::PrimitiveStatus::OkStatus();
+}
+
 }  // namespace
 
 primitives::PrimitiveStatus SerializeRequest(
     int sysno, const std::array<uint64_t, kParameterMax> &parameters,
-    primitives::Extent *request) {
+    primitives::Extent *request, BufferProvider provider) {
   SystemCallDescriptor descriptor{sysno};
   if (!descriptor.is_valid()) {
     return primitives::PrimitiveStatus{
@@ -53,7 +86,7 @@ primitives::PrimitiveStatus SerializeRequest(
   auto writer = MessageWriter::RequestWriter(sysno, parameters);
   size_t size = writer.MessageSize();
 
-  *request = {reinterpret_cast<uint8_t *>(malloc(size)), size};
+  *request = {AllocateMessage(size, provider), size};
 
   writer.Write(request);
   return primitives::PrimitiveStatus::OkStatus();
@@ -82,5 +115,37 @@ primitives::PrimitiveStatus SerializeResponse(
   return primitives::PrimitiveStatus::OkStatus();
 }
 
+primitives::PrimitiveStatus SerializeRequestSg(
+    int sysno, const std::array<uint64_t, kParameterMax> &parameters,
+    std::vector<primitives::Extent> *extents, BufferProvider provider) {
+  SystemCallDescriptor descriptor{sysno};
+  if (!descriptor.is_valid()) {
+    return primitives::PrimitiveStatus{
+        primitives::AbslStatusCode::kInvalidArgument,
+        absl::StrCat("Could not infer system call descriptor from the sysno (",
+                     sysno, ") provided.")};
+  }
+
+  auto writer = MessageWriter::SgRequestWriter(sysno, parameters);
+  return WriteScatterGather(writer, parameters, extents, provider);
+}
+
+primitives::PrimitiveStatus SerializeResponseSg(
+    int sysno, uint64_t result, uint64_t error_number,
+    const std::array<uint64_t, kParameterMax> &parameters,
+    std::vector<primitives::Extent> *extents) {
+  SystemCallDescriptor descriptor{sysno};
+  if (!descriptor.is_valid()) {
+    return primitives::PrimitiveStatus{
+        primitives::AbslStatusCode::kInvalidArgument,
+        absl::StrCat("Could not infer system call descriptor from the sysno (",
+                     sysno, ") provided.")};
+  }
+
+  auto writer =
+      MessageWriter::SgResponseWriter(sysno, result, error_number, parameters);
+  return WriteScatterGather(writer, parameters, extents, /*provider=*/nullptr);
+}
+
 }  // namespace system_call
 }  // namespace asylo
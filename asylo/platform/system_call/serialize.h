@@ -20,7 +20,9 @@
 #define ASYLO_PLATFORM_SYSTEM_CALL_SERIALIZE_H_
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include "asylo/platform/primitives/extent.h"
 #include "asylo/platform/system_call/message.h"
@@ -31,12 +33,20 @@ namespace system_call {
 // An array of parameters to a Linux system call.
 using ParameterList = std::array<uint64_t, kParameterMax>;
 
+// A function providing a buffer of at least `size` bytes for a serialized
+// message, called by the request serializers in place of malloc. The provider
+// retains ownership of the returned memory, which must stay valid until the
+// serialized message has been consumed.
+using BufferProvider = uint8_t *(*)(size_t size);
+
 // Serializes a system call request specified by a system call number and a list
 // of parameters into a buffer. On success, `request` is populated with a buffer
-// allocated by malloc and owned by the caller.
+// obtained from `provider`, or allocated by malloc and owned by the caller when
+// `provider` is null.
 primitives::PrimitiveStatus SerializeRequest(int sysno,
                                              const ParameterList &parameters,
-                                             primitives::Extent *request);
+                                             primitives::Extent *request,
+                                             BufferProvider provider = nullptr);
 
 // Serializes a system call response specified by a system call number, a return
 // code, and a list of parameters into a buffer. On success, `response` is
@@ -46,6 +56,27 @@ primitives::PrimitiveStatus SerializeResponse(int sysno, uint64_t result,
                                               const ParameterList &parameters,
                                               primitives::Extent *response);
 
+// Serializes a system call request into a scatter-gather extent list. On
+// success, `extents` holds a fixed-layout message first — obtained from
+// `provider`, or allocated by malloc and owned by the caller when `provider`
+// is null — followed by one extent per bulk pointer parameter, in increasing
+// parameter index order. The bulk extents alias the caller's parameter
+// buffers, so their contents are copied at most once — when the extents cross
+// the enclave boundary — instead of being assembled into one contiguous
+// buffer first.
+primitives::PrimitiveStatus SerializeRequestSg(
+    int sysno, const ParameterList &parameters,
+    std::vector<primitives::Extent> *extents,
+    BufferProvider provider = nullptr);
+
+// Serializes a system call response into a scatter-gather extent list, with
+// the same layout and ownership contract as `SerializeRequestSg`: the first
+// extent is allocated by malloc and owned by the caller, and the bulk extents
+// alias the output parameter buffers in `parameters`.
+primitives::PrimitiveStatus SerializeResponseSg(
+    int sysno, uint64_t result, uint64_t error_number,
+    const ParameterList &parameters, std::vector<primitives::Extent> *extents);
+
 }  // namespace system_call
 }  // namespace asylo
 
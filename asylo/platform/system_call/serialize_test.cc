@@ -18,10 +18,18 @@
 
 #include "asylo/platform/system_call/serialize.h"
 
+#include <sys/syscall.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/strings/str_cat.h"
+#include "asylo/platform/primitives/extent.h"
 #include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/system_call/message.h"
 
 namespace asylo {
 namespace system_call {
@@ -58,6 +66,69 @@ TEST(SerializeTest, SerializeResponseInvalidSysnoTest) {
                   10000, ") provided.")));
 }
 
+// A buffer provider handing out a static buffer, standing in for the
+// per-thread request buffer used on the syscall path.
+uint8_t *StaticBufferProvider(size_t size) {
+  static uint8_t buffer[1024];
+  return size <= sizeof(buffer) ? buffer : nullptr;
+}
+
+TEST(SerializeTest, SerializeRequestUsesBufferProviderTest) {
+  const std::array<uint64_t, kParameterMax> parameters =
+      std::array<uint64_t, 6>();
+  primitives::Extent request;
+  ASSERT_TRUE(
+      SerializeRequest(SYS_getpid, parameters, &request, &StaticBufferProvider)
+          .ok());
+
+  // The request is serialized into the provider's buffer, which the provider
+  // keeps ownership of; nothing is allocated on behalf of the caller.
+  EXPECT_THAT(request.As<uint8_t>(), Eq(StaticBufferProvider(0)));
+  EXPECT_TRUE(MessageReader(request).Validate().ok());
+}
+
+TEST(SerializeTest, SerializeRequestSgInvalidSysnoTest) {
+  const std::array<uint64_t, kParameterMax> parameters =
+      std::array<uint64_t, 6>();
+  std::vector<primitives::Extent> extents;
+  primitives::PrimitiveStatus status =
+      SerializeRequestSg(10000, parameters, &extents);
+
+  EXPECT_THAT(status.error_code(),
+              Eq(primitives::AbslStatusCode::kInvalidArgument));
+  EXPECT_THAT(status.error_message(),
+              StrEq(absl::StrCat(
+                  "Could not infer system call descriptor from the sysno (",
+                  10000, ") provided.")));
+}
+
+TEST(SerializeTest, SerializeRequestSgReferencesBulkParameterTest) {
+  constexpr char kBuffer[] = "scatter-gather write body";
+  std::array<uint64_t, kParameterMax> parameters{};
+  parameters[0] = 1;  // fd
+  parameters[1] = reinterpret_cast<uint64_t>(kBuffer);
+  parameters[2] = sizeof(kBuffer);
+
+  std::vector<primitives::Extent> extents;
+  ASSERT_TRUE(SerializeRequestSg(SYS_write, parameters, &extents).ok());
+
+  // The bounded buffer parameter is carried as a separate extent aliasing the
+  // caller's memory rather than being copied into the message body.
+  ASSERT_THAT(extents.size(), Eq(2));
+  EXPECT_THAT(extents[1].As<char>(), Eq(kBuffer));
+  EXPECT_THAT(extents[1].size(), Eq(sizeof(kBuffer)));
+
+  MessageReader reader(extents[0]);
+  ASSERT_TRUE(reader.Validate().ok());
+  EXPECT_TRUE(reader.is_scatter_gather());
+  EXPECT_FALSE(reader.parameter_is_out_of_line(0));
+  EXPECT_TRUE(reader.parameter_is_out_of_line(1));
+  EXPECT_THAT(reader.parameter_size(1), Eq(sizeof(kBuffer)));
+  EXPECT_THAT(reader.parameter<uint64_t>(2), Eq(sizeof(kBuffer)));
+
+  free(extents[0].data());
+}
+
 }  // namespace
 }  // namespace system_call
 }  // namespace asylo
@@ -20,11 +20,16 @@
 
 #include <errno.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdarg>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
+#include "asylo/platform/primitives/util/message.h"
 #include "asylo/platform/system_call/metadata.h"
 #include "asylo/platform/system_call/serialize.h"
 #include "asylo/platform/system_call/type_conversions/types_functions.h"
@@ -40,8 +45,468 @@ struct MallocDeleter {
 void default_error_handler(const char *message) { abort(); }
 
 syscall_dispatch_callback global_syscall_callback = nullptr;
+syscall_sg_dispatch_callback global_sg_syscall_callback = nullptr;
+
+// Per-thread bound on the host-side duration of dispatched system calls, in
+// microseconds. Zero means unbounded synchronous dispatch.
+thread_local uint64_t syscall_timeout_micros = 0;
+syscall_async_submit_callback global_async_submit_callback = nullptr;
+syscall_async_collect_callback global_async_collect_callback = nullptr;
 void (*error_handler)(const char *message) = nullptr;
 
+// Book-keeping for a system call submitted for asynchronous completion. The
+// parameter array is retained until the response is collected so that output
+// parameters can be copied back into the caller's buffers.
+struct PendingAsyncSyscall {
+  std::atomic<bool> in_use{false};
+  uint64_t ticket;
+  int sysno;
+  uint64_t start_ticks;
+  std::array<uint64_t, asylo::system_call::kParameterMax> parameters;
+};
+
+// Maximum number of asynchronous system calls in flight at once.
+constexpr int kMaxPendingAsyncSyscalls = 64;
+
+// Table of in-flight asynchronous system calls; handles returned by
+// enc_untrusted_syscall_submit() index into this table.
+PendingAsyncSyscall pending_async_syscalls[kMaxPendingAsyncSyscalls];
+
+// Per-sysno statistics counters. All fields are updated with relaxed atomics
+// and may be torn relative to one another in a snapshot; they are
+// monotonically increasing, so successive snapshots can be differenced
+// safely.
+struct SyscallStatsCounters {
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> total_ticks;
+  std::atomic<uint64_t> latency_buckets[kSyscallStatsLatencyBuckets];
+};
+
+std::atomic<bool> syscall_stats_enabled{false};
+syscall_clock_callback syscall_clock = nullptr;
+
+// Table of statistics counters indexed densely by sysno, sized by the
+// generated system call table. Allocated on first enable and never freed.
+std::atomic<SyscallStatsCounters *> syscall_stats_table{nullptr};
+
+// Returns the start timestamp for latency accounting, or 0 when statistics
+// are disabled or no clock is installed.
+uint64_t SyscallStatsStart() {
+  return syscall_stats_enabled.load(std::memory_order_relaxed) && syscall_clock
+             ? syscall_clock()
+             : 0;
+}
+
+// Records one dispatch of |sysno| started at |start_ticks|. A zero
+// |start_ticks| (no clock, or the clock had no time source at call start)
+// still counts the invocation but records no latency.
+void RecordSyscallStats(int sysno, uint64_t start_ticks) {
+  if (!syscall_stats_enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  SyscallStatsCounters *table =
+      syscall_stats_table.load(std::memory_order_acquire);
+  if (!table || sysno < 0 || sysno > asylo::system_call::LastSystemCall()) {
+    return;
+  }
+  SyscallStatsCounters &counters = table[sysno];
+  counters.count.fetch_add(1, std::memory_order_relaxed);
+  if (start_ticks == 0) {
+    return;
+  }
+  uint64_t ticks = syscall_clock() - start_ticks;
+  counters.total_ticks.fetch_add(ticks, std::memory_order_relaxed);
+  int bucket = ticks == 0 ? 0 : 63 - __builtin_clzll(ticks);
+  if (bucket >= kSyscallStatsLatencyBuckets) {
+    bucket = kSyscallStatsLatencyBuckets - 1;
+  }
+  counters.latency_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+// Smallest capacity retained by the per-thread request buffer.
+constexpr size_t kRequestBufferMinCapacity = 1024;
+
+// Number of system calls between trim checks of the per-thread request buffer.
+constexpr size_t kRequestBufferTrimInterval = 256;
+
+// A grow-only scratch buffer reused across system calls to serialize request
+// messages, so that the steady-state syscall path performs no heap
+// allocations. The buffer is trimmed back to the recent high watermark
+// periodically so that a single oversized request does not pin memory for the
+// lifetime of the thread.
+class RequestBuffer {
+ public:
+  RequestBuffer() = default;
+
+  ~RequestBuffer() { free(data_); }
+
+  // Returns a buffer of at least `size` bytes, valid until the next call.
+  uint8_t *Acquire(size_t size) {
+    high_watermark_ = std::max(high_watermark_, size);
+    if (--calls_until_trim_ == 0) {
+      calls_until_trim_ = kRequestBufferTrimInterval;
+      if (capacity_ > std::max(high_watermark_, kRequestBufferMinCapacity)) {
+        free(data_);
+        data_ = nullptr;
+        capacity_ = 0;
+      }
+      high_watermark_ = size;
+    }
+    if (size > capacity_) {
+      free(data_);
+      capacity_ = std::max(size, kRequestBufferMinCapacity);
+      data_ = reinterpret_cast<uint8_t *>(malloc(capacity_));
+    }
+    return data_;
+  }
+
+ private:
+  uint8_t *data_ = nullptr;
+  size_t capacity_ = 0;
+  size_t high_watermark_ = 0;
+  size_t calls_until_trim_ = kRequestBufferTrimInterval;
+};
+
+// Buffer provider passed to the request serializers. The returned memory is
+// owned by the calling thread's RequestBuffer and must not be freed.
+uint8_t *AcquireRequestBuffer(size_t size) {
+  thread_local RequestBuffer buffer;
+  return buffer.Acquire(size);
+}
+
+// True while the calling thread's RequestBuffer backs an in-flight request.
+// Nested system calls, such as those made from a signal handler delivered
+// while a syscall is being dispatched, fall back to malloc.
+thread_local bool request_buffer_in_use = false;
+
+// Returns the calling thread's reusable extent list for scatter-gather
+// requests. The vector's capacity is retained across calls.
+std::vector<asylo::primitives::Extent> *ThreadLocalRequestExtents() {
+  thread_local std::vector<asylo::primitives::Extent> extents;
+  return &extents;
+}
+
+// Fixed-size stack encoding of an all-scalar request message: the message
+// header followed by one 8-byte inline slot per parameter, matching the
+// layout MessageWriter produces for such calls. sizeof(MessageHeader) is a
+// multiple of 8, so the payload slots are naturally aligned.
+struct ScalarRequestMessage {
+  asylo::system_call::MessageHeader header;
+  uint64_t payload[asylo::system_call::kParameterMax];
+};
+
+// Cached per-sysno eligibility for the all-scalar fast path. State 0 is not
+// yet computed, 1 eligible, 2 ineligible; parameter_count is valid once the
+// state is 1. Concurrent first callers compute identical values, so the race
+// on parameter_count ahead of the release store is benign.
+struct ScalarRequestLayout {
+  std::atomic<uint8_t> state{0};
+  uint8_t parameter_count = 0;
+};
+
+// Eligibility table indexed by sysno. Linux x86-64 system call numbers fit
+// comfortably; sysnos at or above the bound take the generic path.
+constexpr int kScalarLayoutMax = 512;
+ScalarRequestLayout scalar_request_layouts[kScalarLayoutMax];
+
+// Returns true if every parameter of `descriptor` is an input scalar, making
+// the call eligible for the fixed-layout stack serialization, and sets
+// `parameter_count`. The metadata walk runs once per sysno and is cached.
+bool GetScalarRequestLayout(int sysno,
+                            const asylo::system_call::SystemCallDescriptor
+                                &descriptor,
+                            int *parameter_count) {
+  if (sysno < 0 || sysno >= kScalarLayoutMax) {
+    return false;
+  }
+  ScalarRequestLayout &layout = scalar_request_layouts[sysno];
+  uint8_t state = layout.state.load(std::memory_order_acquire);
+  if (state == 0) {
+    bool eligible = true;
+    for (int i = 0; i < descriptor.parameter_count(); i++) {
+      asylo::system_call::ParameterDescriptor parameter =
+          descriptor.parameter(i);
+      if (!parameter.is_scalar() || !parameter.is_in()) {
+        eligible = false;
+        break;
+      }
+    }
+    layout.parameter_count = descriptor.parameter_count();
+    state = eligible ? 1 : 2;
+    layout.state.store(state, std::memory_order_release);
+  }
+  if (state != 1) {
+    return false;
+  }
+  *parameter_count = layout.parameter_count;
+  return true;
+}
+
+// Serializes an all-scalar request into `message` and returns the encoded
+// size. The layout is identical to what MessageWriter::RequestWriter (or
+// SgRequestWriter when `scatter_gather` is set) produces: scalars are
+// zero-extended to 64 bits and laid out contiguously after the header.
+size_t SerializeScalarRequest(
+    int sysno, bool scatter_gather, int parameter_count,
+    const std::array<uint64_t, asylo::system_call::kParameterMax> &parameters,
+    ScalarRequestMessage *message) {
+  asylo::system_call::MessageHeader &header = message->header;
+  header.magic = asylo::system_call::kMessageMagic;
+  header.flags = asylo::system_call::kSystemCallRequest;
+  if (scatter_gather) {
+    header.flags |= asylo::system_call::kSystemCallScatterGather;
+  }
+  header.sysno = sysno;
+  header.result = 0;
+  header.error_number = 0;
+  size_t next_offset = sizeof(asylo::system_call::MessageHeader);
+  for (int i = 0; i < asylo::system_call::kParameterMax; i++) {
+    if (i < parameter_count) {
+      message->payload[i] = parameters[i];
+      header.offset[i] = next_offset;
+      header.size[i] = sizeof(uint64_t);
+      next_offset += sizeof(uint64_t);
+    } else {
+      header.offset[i] = 0;
+      header.size[i] = 0;
+    }
+  }
+  return next_offset;
+}
+
+// Completes a system call by copying output parameters back into the caller's
+// buffers and setting errno. Shared by the contiguous and scatter-gather
+// response paths; `response` supplies the out-of-line response extents for
+// the latter and is null for the former.
+int64_t FinishSyscall(
+    const asylo::system_call::SystemCallDescriptor &descriptor,
+    const std::array<uint64_t, asylo::system_call::kParameterMax> &parameters,
+    const asylo::system_call::MessageReader &response_reader,
+    asylo::primitives::MessageReader *response) {
+  for (int i = 0; i < asylo::system_call::kParameterMax; i++) {
+    asylo::system_call::ParameterDescriptor parameter = descriptor.parameter(i);
+    if (parameter.is_out()) {
+      void *dst = reinterpret_cast<void *>(parameters[i]);
+      if (response_reader.parameter_is_out_of_line(i)) {
+        if (!response || !response->hasNext()) {
+          error_handler(
+              "system_call.cc: response is missing an out-of-line extent.");
+        }
+        auto extent = response->next();
+        if (dst != nullptr) {
+          memcpy(dst, extent.data(),
+                 std::min(extent.size(), response_reader.parameter_size(i)));
+        }
+        continue;
+      }
+      size_t size;
+      if (parameter.is_fixed()) {
+        size = parameter.size();
+      } else {
+        size = parameters[parameter.size()] * parameter.element_size();
+      }
+      const void *src = response_reader.parameter_address(i);
+      if (dst != nullptr) {
+        memcpy(dst, src, size);
+      }
+    }
+  }
+
+  uint64_t result = response_reader.header()->result;
+  if (static_cast<int64_t>(result) == -1) {
+    int klinux_errno = response_reader.header()->error_number;
+
+    // Simply having a return value of -1 from a syscall is not a necessary
+    // condition that the syscall failed. Some syscalls can return -1 when
+    // successful (eg., lseek). The reliable way to check for syscall failure is
+    // to therefore check both return value and presence of a non-zero errno.
+    if (klinux_errno != 0) {
+      errno = FromkLinuxErrorNumber(klinux_errno);
+    }
+  }
+  return result;
+}
+
+// Dispatches a system call through the scatter-gather callback. Bulk pointer
+// parameters are referenced as separate extents aliasing the caller's
+// buffers, so their contents cross the enclave boundary exactly once in each
+// direction instead of being assembled into a contiguous message first.
+int64_t DispatchScatterGatherSyscall(
+    int sysno, const asylo::system_call::SystemCallDescriptor &descriptor,
+    const std::array<uint64_t, asylo::system_call::kParameterMax> &parameters) {
+  const bool use_request_buffer = !request_buffer_in_use;
+  std::vector<asylo::primitives::Extent> local_request;
+  std::vector<asylo::primitives::Extent> *request =
+      use_request_buffer ? ThreadLocalRequestExtents() : &local_request;
+  if (use_request_buffer) {
+    request_buffer_in_use = true;
+  }
+
+  asylo::primitives::PrimitiveStatus status =
+      asylo::system_call::SerializeRequestSg(
+          sysno, parameters, request,
+          use_request_buffer ? &AcquireRequestBuffer : nullptr);
+  if (!status.ok()) {
+    error_handler(
+        "system_call.cc: Encountered serialization error when serializing "
+        "syscall parameters.");
+  }
+
+  std::unique_ptr<uint8_t, MallocDeleter> request_owner(
+      use_request_buffer ? nullptr : (*request)[0].As<uint8_t>());
+
+  asylo::primitives::MessageReader response;
+  status =
+      global_sg_syscall_callback(request->data(), request->size(), &response);
+  if (use_request_buffer) {
+    request_buffer_in_use = false;
+  }
+  if (!status.ok()) {
+    error_handler(
+        "system_call.cc: Callback from syscall dispatcher was unsuccessful.");
+  }
+  if (response.empty()) {
+    error_handler(
+        "system_call.cc: empty response received for the syscall.");
+  }
+
+  auto response_extent = response.next();
+  asylo::system_call::MessageReader response_reader(response_extent);
+  const asylo::primitives::PrimitiveStatus response_status =
+      response_reader.Validate();
+  if (!response_status.ok()) {
+    error_handler(
+        "system_call.cc: Error deserializing response buffer into response "
+        "reader.");
+  }
+
+  return FinishSyscall(descriptor, parameters, response_reader, &response);
+}
+
+// Dispatches a system call through the contiguous-message callback. The
+// request is serialized into the calling thread's reusable request buffer,
+// falling back to a malloc-allocated buffer for nested calls.
+int64_t DispatchContiguousSyscall(
+    int sysno, const asylo::system_call::SystemCallDescriptor &descriptor,
+    const std::array<uint64_t, asylo::system_call::kParameterMax> &parameters) {
+  const bool use_request_buffer = !request_buffer_in_use;
+  if (use_request_buffer) {
+    request_buffer_in_use = true;
+  }
+
+  asylo::primitives::Extent request;
+  asylo::primitives::PrimitiveStatus status;
+  status = asylo::system_call::SerializeRequest(
+      sysno, parameters, &request,
+      use_request_buffer ? &AcquireRequestBuffer : nullptr);
+  if (!status.ok()) {
+    error_handler(
+        "system_call.cc: Encountered serialization error when serializing "
+        "syscall parameters.");
+  }
+
+  std::unique_ptr<uint8_t, MallocDeleter> request_owner(
+      use_request_buffer ? nullptr : request.As<uint8_t>());
+
+  // Invoke the system call dispatch callback to execute the system call.
+  uint8_t *response_buffer;
+  size_t response_size;
+
+  status = global_syscall_callback(request.As<uint8_t>(), request.size(),
+                                   &response_buffer, &response_size);
+  if (use_request_buffer) {
+    request_buffer_in_use = false;
+  }
+  if (!status.ok()) {
+    error_handler(
+        "system_call.cc: Callback from syscall dispatcher was unsuccessful.");
+  }
+
+  std::unique_ptr<uint8_t, MallocDeleter> response_owner(response_buffer);
+
+  if (!response_buffer) {
+    error_handler(
+        "system_call.cc: null response buffer received for the syscall.");
+  }
+
+  // Copy outputs back into pointer parameters.
+  auto response_reader =
+      asylo::system_call::MessageReader({response_buffer, response_size});
+  const asylo::primitives::PrimitiveStatus response_status =
+      response_reader.Validate();
+  if (!response_status.ok()) {
+    error_handler(
+        "system_call.cc: Error deserializing response buffer into response "
+        "reader.");
+  }
+
+  return FinishSyscall(descriptor, parameters, response_reader,
+                       /*response=*/nullptr);
+}
+
+// Dispatches an all-scalar system call serialized into a fixed-size stack
+// message, bypassing the MessageWriter machinery, the extent vector, and the
+// per-thread request buffer entirely. Works against whichever dispatcher is
+// installed: an all-scalar request carries no out-of-line extents, so the
+// scatter-gather form is a single extent aliasing the stack message.
+int64_t DispatchScalarSyscall(
+    int sysno, const asylo::system_call::SystemCallDescriptor &descriptor,
+    const std::array<uint64_t, asylo::system_call::kParameterMax> &parameters,
+    int parameter_count) {
+  const bool use_sg = enc_is_sg_syscall_dispatcher_set();
+  ScalarRequestMessage message;
+  size_t size =
+      SerializeScalarRequest(sysno, use_sg, parameter_count, parameters,
+                             &message);
+
+  asylo::primitives::PrimitiveStatus status;
+  asylo::primitives::MessageReader sg_response;
+  uint8_t *response_buffer;
+  size_t response_size;
+  if (use_sg) {
+    asylo::primitives::Extent request_extent = {
+        reinterpret_cast<uint8_t *>(&message), size};
+    status = global_sg_syscall_callback(&request_extent, 1, &sg_response);
+    if (!status.ok()) {
+      error_handler(
+          "system_call.cc: Callback from syscall dispatcher was unsuccessful.");
+    }
+    if (sg_response.empty()) {
+      error_handler(
+          "system_call.cc: empty response received for the syscall.");
+    }
+    auto response_extent = sg_response.next();
+    response_buffer = response_extent.As<uint8_t>();
+    response_size = response_extent.size();
+  } else {
+    status = global_syscall_callback(reinterpret_cast<uint8_t *>(&message),
+                                     size, &response_buffer, &response_size);
+    if (!status.ok()) {
+      error_handler(
+          "system_call.cc: Callback from syscall dispatcher was unsuccessful.");
+    }
+    if (!response_buffer) {
+      error_handler(
+          "system_call.cc: null response buffer received for the syscall.");
+    }
+  }
+  std::unique_ptr<uint8_t, MallocDeleter> response_owner(
+      use_sg ? nullptr : response_buffer);
+
+  auto response_reader =
+      asylo::system_call::MessageReader({response_buffer, response_size});
+  const asylo::primitives::PrimitiveStatus response_status =
+      response_reader.Validate();
+  if (!response_status.ok()) {
+    error_handler(
+        "system_call.cc: Error deserializing response buffer into response "
+        "reader.");
+  }
+
+  return FinishSyscall(descriptor, parameters, response_reader,
+                       use_sg ? &sg_response : nullptr);
+}
+
 }  // namespace
 
 extern "C" bool enc_is_syscall_dispatcher_set() {
@@ -54,11 +519,28 @@ extern "C" void enc_set_dispatch_syscall(syscall_dispatch_callback callback) {
   global_syscall_callback = callback;
 }
 
+extern "C" bool enc_is_sg_syscall_dispatcher_set() {
+  return global_sg_syscall_callback != nullptr;
+}
+
+extern "C" void enc_set_dispatch_sg_syscall(
+    syscall_sg_dispatch_callback callback) {
+  global_sg_syscall_callback = callback;
+}
+
 extern "C" void enc_set_error_handler(
     void (*abort_handler)(const char *message)) {
   error_handler = abort_handler;
 }
 
+extern "C" void enc_set_syscall_timeout(uint64_t timeout_micros) {
+  syscall_timeout_micros = timeout_micros;
+}
+
+extern "C" uint64_t enc_get_syscall_timeout() {
+  return syscall_timeout_micros;
+}
+
 extern "C" int64_t enc_untrusted_syscall(int sysno, ...) {
   if (!enc_is_error_handler_set()) {
     enc_set_error_handler(default_error_handler);
@@ -78,40 +560,162 @@ extern "C" int64_t enc_untrusted_syscall(int sysno, ...) {
   }
   va_end(args);
 
-  // Allocate a buffer for the serialized request.
+  const uint64_t start_ticks = SyscallStatsStart();
+
+  // All-scalar calls (close, lseek, fsync, ...) serialize into a fixed-size
+  // stack message with no writer machinery or extent vector; everything else
+  // prefers the scatter-gather dispatcher when one is installed, so that bulk
+  // pointer parameters cross the enclave boundary without an intermediate
+  // contiguous copy. Deadline-bounded calls take the contiguous path
+  // unconditionally: the untrusted side enforces the deadline by handing the
+  // request to a worker thread, which requires the whole request in one
+  // self-contained buffer.
+  int64_t result;
+  int scalar_parameter_count;
+  if (syscall_timeout_micros != 0 && enc_is_syscall_dispatcher_set()) {
+    result = DispatchContiguousSyscall(sysno, descriptor, parameters);
+  } else if (GetScalarRequestLayout(sysno, descriptor,
+                                    &scalar_parameter_count) &&
+             (enc_is_sg_syscall_dispatcher_set() ||
+              enc_is_syscall_dispatcher_set())) {
+    result = DispatchScalarSyscall(sysno, descriptor, parameters,
+                                   scalar_parameter_count);
+  } else if (enc_is_sg_syscall_dispatcher_set()) {
+    result = DispatchScatterGatherSyscall(sysno, descriptor, parameters);
+  } else {
+    if (!enc_is_syscall_dispatcher_set()) {
+      error_handler("system_.cc: system call dispatcher not set.");
+    }
+    result = DispatchContiguousSyscall(sysno, descriptor, parameters);
+  }
+  RecordSyscallStats(sysno, start_ticks);
+  return result;
+}
+
+extern "C" void enc_set_dispatch_async_syscall(
+    syscall_async_submit_callback submit,
+    syscall_async_collect_callback collect) {
+  global_async_submit_callback = submit;
+  global_async_collect_callback = collect;
+}
+
+extern "C" bool enc_is_async_syscall_dispatcher_set() {
+  return global_async_submit_callback != nullptr &&
+         global_async_collect_callback != nullptr;
+}
+
+extern "C" int64_t enc_untrusted_syscall_submit(int sysno, ...) {
+  if (!enc_is_error_handler_set()) {
+    enc_set_error_handler(default_error_handler);
+  }
+
+  if (!enc_is_async_syscall_dispatcher_set()) {
+    errno = ENOSYS;
+    return -1;
+  }
+
+  asylo::system_call::SystemCallDescriptor descriptor{sysno};
+  if (!descriptor.is_valid()) {
+    error_handler("system_call.cc: Invalid SystemCallDescriptor encountered.");
+  }
+
+  // Claim a slot in the pending call table.
+  PendingAsyncSyscall *pending = nullptr;
+  int64_t handle = -1;
+  for (int i = 0; i < kMaxPendingAsyncSyscalls; i++) {
+    bool expected = false;
+    if (pending_async_syscalls[i].in_use.compare_exchange_strong(
+            expected, true, std::memory_order_acq_rel)) {
+      pending = &pending_async_syscalls[i];
+      handle = i;
+      break;
+    }
+  }
+  if (!pending) {
+    errno = EAGAIN;
+    return -1;
+  }
+
+  pending->sysno = sysno;
+  va_list args;
+  va_start(args, sysno);
+  for (int i = 0; i < descriptor.parameter_count(); i++) {
+    pending->parameters[i] = va_arg(args, uint64_t);
+  }
+  va_end(args);
+  pending->start_ticks = SyscallStatsStart();
+
+  // Serialize the request. The untrusted side copies the request before the
+  // submit callback returns, so the thread-local request buffer may be reused
+  // immediately afterwards; input parameter contents are captured by the
+  // serialization.
+  const bool use_request_buffer = !request_buffer_in_use;
+  if (use_request_buffer) {
+    request_buffer_in_use = true;
+  }
+
   asylo::primitives::Extent request;
-  asylo::primitives::PrimitiveStatus status;
-  status = asylo::system_call::SerializeRequest(sysno, parameters, &request);
+  asylo::primitives::PrimitiveStatus status =
+      asylo::system_call::SerializeRequest(
+          sysno, pending->parameters, &request,
+          use_request_buffer ? &AcquireRequestBuffer : nullptr);
   if (!status.ok()) {
     error_handler(
         "system_call.cc: Encountered serialization error when serializing "
         "syscall parameters.");
   }
 
-  std::unique_ptr<uint8_t, MallocDeleter> request_owner(request.As<uint8_t>());
+  std::unique_ptr<uint8_t, MallocDeleter> request_owner(
+      use_request_buffer ? nullptr : request.As<uint8_t>());
 
-  // Invoke the system call dispatch callback to execute the system call.
-  uint8_t *response_buffer;
-  size_t response_size;
+  status = global_async_submit_callback(request.As<uint8_t>(), request.size(),
+                                        &pending->ticket);
+  if (use_request_buffer) {
+    request_buffer_in_use = false;
+  }
+  if (!status.ok()) {
+    pending->in_use.store(false, std::memory_order_release);
+    error_handler(
+        "system_call.cc: Callback from async syscall submission was "
+        "unsuccessful.");
+  }
+
+  return handle;
+}
 
-  if (!enc_is_syscall_dispatcher_set()) {
-    error_handler("system_.cc: system call dispatcher not set.");
+extern "C" int64_t enc_untrusted_syscall_collect(int64_t handle, bool wait) {
+  if (!enc_is_error_handler_set()) {
+    enc_set_error_handler(default_error_handler);
   }
-  status = global_syscall_callback(request.As<uint8_t>(), request.size(),
-                                   &response_buffer, &response_size);
+
+  if (handle < 0 || handle >= kMaxPendingAsyncSyscalls ||
+      !pending_async_syscalls[handle].in_use.load(std::memory_order_acquire)) {
+    errno = EINVAL;
+    return -1;
+  }
+  PendingAsyncSyscall *pending = &pending_async_syscalls[handle];
+
+  uint8_t *response_buffer = nullptr;
+  size_t response_size = 0;
+  bool ready = false;
+  asylo::primitives::PrimitiveStatus status = global_async_collect_callback(
+      pending->ticket, wait, &response_buffer, &response_size, &ready);
   if (!status.ok()) {
     error_handler(
-        "system_call.cc: Callback from syscall dispatcher was unsuccessful.");
+        "system_call.cc: Callback from async syscall collection was "
+        "unsuccessful.");
+  }
+  if (!ready) {
+    errno = EAGAIN;
+    return -1;
   }
 
   std::unique_ptr<uint8_t, MallocDeleter> response_owner(response_buffer);
-
   if (!response_buffer) {
     error_handler(
         "system_call.cc: null response buffer received for the syscall.");
   }
 
-  // Copy outputs back into pointer parameters.
   auto response_reader =
       asylo::system_call::MessageReader({response_buffer, response_size});
   const asylo::primitives::PrimitiveStatus response_status =
@@ -122,34 +726,66 @@ extern "C" int64_t enc_untrusted_syscall(int sysno, ...) {
         "reader.");
   }
 
-  for (int i = 0; i < asylo::system_call::kParameterMax; i++) {
-    asylo::system_call::ParameterDescriptor parameter = descriptor.parameter(i);
-    if (parameter.is_out()) {
-      size_t size;
-      if (parameter.is_fixed()) {
-        size = parameter.size();
-      } else {
-        size = parameters[parameter.size()] * parameter.element_size();
-      }
-      const void *src = response_reader.parameter_address(i);
-      void *dst = reinterpret_cast<void *>(parameters[i]);
-      if (dst != nullptr) {
-        memcpy(dst, src, size);
-      }
+  asylo::system_call::SystemCallDescriptor descriptor{pending->sysno};
+  int64_t result = FinishSyscall(descriptor, pending->parameters,
+                                 response_reader, /*response=*/nullptr);
+  RecordSyscallStats(pending->sysno, pending->start_ticks);
+  pending->in_use.store(false, std::memory_order_release);
+  return result;
+}
+
+extern "C" void enc_set_syscall_clock(syscall_clock_callback callback) {
+  syscall_clock = callback;
+}
+
+extern "C" bool enc_is_syscall_clock_set() { return syscall_clock != nullptr; }
+
+extern "C" void enc_set_syscall_stats_enabled(bool enabled) {
+  if (enabled && !syscall_stats_table.load(std::memory_order_acquire)) {
+    SyscallStatsCounters *table = new SyscallStatsCounters[
+        asylo::system_call::LastSystemCall() + 1]();
+    SyscallStatsCounters *expected = nullptr;
+    if (!syscall_stats_table.compare_exchange_strong(
+            expected, table, std::memory_order_release,
+            std::memory_order_acquire)) {
+      delete[] table;  // Another thread installed a table first.
     }
   }
+  syscall_stats_enabled.store(enabled, std::memory_order_relaxed);
+}
 
-  uint64_t result = response_reader.header()->result;
-  if (static_cast<int64_t>(result) == -1) {
-    int klinux_errno = response_reader.header()->error_number;
+extern "C" bool enc_syscall_stats_enabled() {
+  return syscall_stats_enabled.load(std::memory_order_relaxed);
+}
 
-    // Simply having a return value of -1 from a syscall is not a necessary
-    // condition that the syscall failed. Some syscalls can return -1 when
-    // successful (eg., lseek). The reliable way to check for syscall failure is
-    // to therefore check both return value and presence of a non-zero errno.
-    if (klinux_errno != 0) {
-      errno = FromkLinuxErrorNumber(klinux_errno);
+extern "C" bool enc_read_syscall_stats(int sysno, struct SyscallStats *stats) {
+  const SyscallStatsCounters *table =
+      syscall_stats_table.load(std::memory_order_acquire);
+  if (!table || !stats || sysno < 0 ||
+      sysno > asylo::system_call::LastSystemCall()) {
+    return false;
+  }
+  const SyscallStatsCounters &counters = table[sysno];
+  stats->count = counters.count.load(std::memory_order_relaxed);
+  stats->total_ticks = counters.total_ticks.load(std::memory_order_relaxed);
+  for (int i = 0; i < kSyscallStatsLatencyBuckets; i++) {
+    stats->latency_buckets[i] =
+        counters.latency_buckets[i].load(std::memory_order_relaxed);
+  }
+  return true;
+}
+
+extern "C" void enc_reset_syscall_stats() {
+  SyscallStatsCounters *table =
+      syscall_stats_table.load(std::memory_order_acquire);
+  if (!table) {
+    return;
+  }
+  for (int sysno = 0; sysno <= asylo::system_call::LastSystemCall(); sysno++) {
+    table[sysno].count.store(0, std::memory_order_relaxed);
+    table[sysno].total_ticks.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < kSyscallStatsLatencyBuckets; i++) {
+      table[sysno].latency_buckets[i].store(0, std::memory_order_relaxed);
     }
   }
-  return result;
 }
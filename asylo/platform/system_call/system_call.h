@@ -22,7 +22,9 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "asylo/platform/primitives/extent.h"
 #include "asylo/platform/primitives/primitive_status.h"
+#include "asylo/platform/primitives/util/message.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +42,27 @@ typedef asylo::primitives::PrimitiveStatus (*syscall_dispatch_callback)(
 // Installs a callback as dispatch function for serialized system calls.
 void enc_set_dispatch_syscall(syscall_dispatch_callback callback);
 
+// Callback type installed at runtime to dispatch a scatter-gather serialized
+// system call across the enclave boundary. `request_extents` designates
+// `num_request_extents` extents owned by the caller: the fixed-layout request
+// message followed by one extent per bulk input parameter. On success,
+// `response` holds the response message extents: the fixed-layout response
+// message followed by one extent per bulk output parameter. Bulk parameter
+// contents are copied at most once in each direction, when the extents cross
+// the enclave boundary.
+typedef asylo::primitives::PrimitiveStatus (*syscall_sg_dispatch_callback)(
+    const asylo::primitives::Extent *request_extents,
+    size_t num_request_extents, asylo::primitives::MessageReader *response);
+
+// Installs a callback as dispatch function for scatter-gather serialized
+// system calls. When set, it is preferred over the dispatch function
+// installed by enc_set_dispatch_syscall().
+void enc_set_dispatch_sg_syscall(syscall_sg_dispatch_callback callback);
+
+// Returns whether a scatter-gather dispatch function has been registered for
+// making system calls.
+bool enc_is_sg_syscall_dispatcher_set();
+
 // Installs an error handler function that aborts with a message in case of a
 // failure.
 void enc_set_error_handler(void (*abort_handler)(const char *message));
@@ -55,6 +78,105 @@ bool enc_is_error_handler_set();
 // callback.
 int64_t enc_untrusted_syscall(int sysno, ...);
 
+// Bounds the host-side duration of system calls made by the calling thread.
+// While a non-zero timeout is set, every call made through
+// enc_untrusted_syscall() that does not complete within `timeout_micros`
+// microseconds fails with -1/ETIMEDOUT instead of keeping the thread in the
+// exit indefinitely; the abandoned call keeps running on an untrusted worker
+// thread and its result is discarded. A timeout of zero (the default)
+// restores unbounded synchronous dispatch. Timed calls always use the
+// contiguous dispatcher installed by enc_set_dispatch_syscall(), so the whole
+// request can be handed off to a worker thread.
+void enc_set_syscall_timeout(uint64_t timeout_micros);
+
+// Returns the timeout installed by enc_set_syscall_timeout() for the calling
+// thread, or zero when none is set.
+uint64_t enc_get_syscall_timeout();
+
+// Callback type installed at runtime to submit a serialized system call for
+// asynchronous completion on the host. `request_buffer` and `request_size`
+// designate a system call request owned by the caller and valid only for the
+// duration of the call; the untrusted side copies it before returning. On
+// success, `ticket` identifies the submitted call for later collection.
+typedef asylo::primitives::PrimitiveStatus (*syscall_async_submit_callback)(
+    const uint8_t *request_buffer, size_t request_size, uint64_t *ticket);
+
+// Callback type installed at runtime to collect the response of a system call
+// previously submitted for asynchronous completion. When `wait` is true,
+// blocks until the call identified by `ticket` completes. On return with
+// `*ready` set, `response_buffer` and `response_size` are populated with a
+// response allocated by malloc() on the trusted heap and the ticket is
+// consumed; with `*ready` unset, the call is still in flight and the ticket
+// remains valid.
+typedef asylo::primitives::PrimitiveStatus (*syscall_async_collect_callback)(
+    uint64_t ticket, bool wait, uint8_t **response_buffer,
+    size_t *response_size, bool *ready);
+
+// Installs the pair of callbacks used to dispatch system calls for
+// asynchronous completion.
+void enc_set_dispatch_async_syscall(syscall_async_submit_callback submit,
+                                    syscall_async_collect_callback collect);
+
+// Returns whether dispatch functions have been registered for asynchronous
+// system call completion.
+bool enc_is_async_syscall_dispatcher_set();
+
+// Submits a system call for asynchronous completion on the host and returns
+// immediately with a handle to pass to enc_untrusted_syscall_collect(), or -1
+// with errno set on failure: ENOSYS when no asynchronous dispatcher is
+// installed, or EAGAIN when too many asynchronous calls are already in
+// flight. Input parameter contents are captured at submission time; output
+// parameter buffers must stay valid until the call is collected.
+int64_t enc_untrusted_syscall_submit(int sysno, ...);
+
+// Collects the result of a system call previously submitted with
+// enc_untrusted_syscall_submit(), copying output parameters back into the
+// caller's buffers and setting errno as the synchronous path would. When
+// `wait` is false and the call has not completed yet, returns -1 with errno
+// set to EAGAIN and the handle remains valid; otherwise the handle is
+// consumed.
+int64_t enc_untrusted_syscall_collect(int64_t handle, bool wait);
+
+// Number of power-of-two latency buckets tracked per system call number;
+// bucket i counts dispatches whose latency fell in [2^i, 2^(i+1)) clock
+// ticks.
+enum { kSyscallStatsLatencyBuckets = 32 };
+
+// A plain-value snapshot of the statistics accumulated for one system call
+// number.
+struct SyscallStats {
+  uint64_t count;
+  uint64_t total_ticks;
+  uint64_t latency_buckets[kSyscallStatsLatencyBuckets];
+};
+
+// Callback type installed at runtime to timestamp system call dispatch for
+// latency accounting. Returns the current time in monotonic ticks of any
+// fixed resolution, or 0 when no time source is available.
+typedef uint64_t (*syscall_clock_callback)();
+
+// Installs a callback as the time source for system call latency accounting.
+void enc_set_syscall_clock(syscall_clock_callback callback);
+
+// Returns whether a time source has been registered for system call latency
+// accounting.
+bool enc_is_syscall_clock_set();
+
+// Enables or disables per-sysno system call statistics. Statistics are
+// disabled at startup; when enabled without a clock installed, only
+// invocation counts accumulate.
+void enc_set_syscall_stats_enabled(bool enabled);
+
+// Returns whether per-sysno system call statistics are being recorded.
+bool enc_syscall_stats_enabled();
+
+// Copies the statistics accumulated for |sysno| into |stats|. Returns false
+// when |sysno| is out of range or statistics have never been enabled.
+bool enc_read_syscall_stats(int sysno, struct SyscallStats *stats);
+
+// Resets all accumulated system call statistics to zero.
+void enc_reset_syscall_stats();
+
 #ifdef __cplusplus
 }
 #endif
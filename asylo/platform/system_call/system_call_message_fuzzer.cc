@@ -18,8 +18,11 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "asylo/platform/system_call/message.h"
+#include "asylo/platform/system_call/metadata.h"
 
 namespace asylo {
 namespace system_call {
@@ -28,9 +31,45 @@ namespace {
 // Tests passing a random byte buffer into MessageReader, and verifies it does
 // not point to data outside the input buffer in the fuzzer environment, see
 // http://llvm.org/docs/LibFuzzer.html.
+//
+// Validate() accepts messages by checking them against per-sysno templates
+// precomputed from the metadata tables. Whenever a message is accepted, this
+// harness re-derives the acceptance conditions directly from the descriptor
+// tables and aborts on any divergence, so the fast path cannot silently admit
+// a message the metadata would reject.
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
   MessageReader reader({data, size});
   if (reader.Validate().ok()) {
+    SystemCallDescriptor descriptor(reader.sysno());
+    if (!descriptor.is_valid()) {
+      abort();
+    }
+    for (int i = 0; i < kParameterMax; i++) {
+      if (!reader.parameter_is_used(i)) {
+        continue;
+      }
+      ParameterDescriptor parameter = descriptor.parameter(i);
+      if (reader.parameter_is_out_of_line(i)) {
+        if (!parameter.is_pointer() || !parameter.is_bounded()) {
+          abort();
+        }
+        continue;
+      }
+      if (parameter.is_scalar() &&
+          reader.parameter_size(i) != sizeof(uint64_t)) {
+        abort();
+      }
+      if (parameter.is_fixed() &&
+          reader.parameter_size(i) != parameter.size()) {
+        abort();
+      }
+      if (parameter.is_string() && reader.parameter_size(i) != 0) {
+        const char *value = reader.parameter_address<const char *>(i);
+        if (reader.parameter_size(i) != strlen(value) + 1) {
+          abort();
+        }
+      }
+    }
     FormatMessage(primitives::Extent(data, size));
   }
 
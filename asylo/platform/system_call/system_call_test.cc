@@ -26,8 +26,11 @@
 #include <unistd.h>
 
 #include <cerrno>
+#include <cstdlib>
 #include <cstring>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -36,6 +39,7 @@
 #include "absl/strings/str_cat.h"
 #include "asylo/platform/primitives/primitive_status.h"
 #include "asylo/platform/primitives/untrusted_primitives.h"
+#include "asylo/platform/primitives/util/message.h"
 #include "asylo/platform/system_call/sysno.h"
 #include "asylo/platform/system_call/type_conversions/types.h"
 #include "asylo/platform/system_call/type_conversions/types_functions.h"
@@ -88,6 +92,33 @@ asylo::primitives::PrimitiveStatus InvalidResponseDispatcher(
   return asylo::primitives::PrimitiveStatus::OkStatus();
 }
 
+// A scatter-gather system call dispatch function which invokes a request
+// locally and flattens the response extents into |response|, the way the
+// enclave boundary would.
+asylo::primitives::PrimitiveStatus SgSystemCallDispatcher(
+    const primitives::Extent *request_extents, size_t num_request_extents,
+    primitives::MessageReader *response) {
+  std::vector<primitives::Extent> request(
+      request_extents, request_extents + num_request_extents);
+  std::vector<primitives::Extent> response_extents;
+
+  ASYLO_RETURN_IF_ERROR(UntrustedInvoke(request, &response_extents));
+
+  primitives::MessageWriter writer;
+  for (const auto &extent : response_extents) {
+    writer.PushByReference(extent);
+  }
+  size_t size = writer.MessageSize();
+  void *buffer = malloc(size);
+  writer.Serialize(buffer);
+  for (const auto &extent : response_extents) {
+    free(extent.data());
+  }
+  response->DeserializeOwned(buffer, size, &free);
+
+  return asylo::primitives::PrimitiveStatus::OkStatus();
+}
+
 // A system call dispatch function that always fails.
 asylo::primitives::PrimitiveStatus AlwaysFailingDispatcher(
     const uint8_t *request_buffer, size_t request_size,
@@ -297,6 +328,157 @@ TEST(SystemCallTest, BoundedBufferByParamLenTest) {
   EXPECT_THAT(fds_actual[1].revents, Eq(fds_actual[1].revents));
 }
 
+// Invokes read and write through the scatter-gather dispatch path, where bulk
+// buffer parameters travel as separate extents instead of being copied into
+// the serialized message.
+TEST(SystemCallTest, ScatterGatherReadWriteTest) {
+  enc_set_dispatch_syscall(SystemCallDispatcher);
+  enc_set_dispatch_sg_syscall(SgSystemCallDispatcher);
+
+  int fds[2];
+  ASSERT_THAT(enc_untrusted_syscall(SYS_pipe, fds), Eq(0));
+
+  constexpr char kMessage[] = "scatter-gather round trip";
+  EXPECT_THAT(
+      enc_untrusted_syscall(SYS_write, fds[1], kMessage, sizeof(kMessage)),
+      Eq(sizeof(kMessage)));
+
+  char buffer[sizeof(kMessage)] = {};
+  EXPECT_THAT(enc_untrusted_syscall(SYS_read, fds[0], buffer, sizeof(buffer)),
+              Eq(sizeof(kMessage)));
+  EXPECT_THAT(buffer, StrEq(kMessage));
+
+  EXPECT_THAT(enc_untrusted_syscall(SYS_close, fds[0]), Eq(0));
+  EXPECT_THAT(enc_untrusted_syscall(SYS_close, fds[1]), Eq(0));
+
+  // Restore the legacy dispatch path for the remaining tests.
+  enc_set_dispatch_sg_syscall(nullptr);
+}
+
+// Pending responses held by the fake asynchronous dispatchers, keyed by
+// ticket. Each entry counts the collect attempts made for it, so the first
+// non-waiting collect can report the call as still in flight.
+std::map<uint64_t, std::pair<primitives::Extent, int>> *pending_responses =
+    new std::map<uint64_t, std::pair<primitives::Extent, int>>;
+
+// A fake asynchronous submit dispatcher which invokes the request locally at
+// submission time and holds the response until collected.
+asylo::primitives::PrimitiveStatus AsyncSubmitDispatcher(
+    const uint8_t *request_buffer, size_t request_size, uint64_t *ticket) {
+  static uint64_t next_ticket = 1;
+  primitives::Extent response;
+
+  ASYLO_RETURN_IF_ERROR(
+      UntrustedInvoke({request_buffer, request_size}, &response));
+
+  *ticket = next_ticket++;
+  (*pending_responses)[*ticket] = {response, 0};
+
+  return asylo::primitives::PrimitiveStatus::OkStatus();
+}
+
+// A fake asynchronous collect dispatcher. Reports the call as still in flight
+// on the first non-waiting collect, then hands off the held response.
+asylo::primitives::PrimitiveStatus AsyncCollectDispatcher(
+    uint64_t ticket, bool wait, uint8_t **response_buffer,
+    size_t *response_size, bool *ready) {
+  auto it = pending_responses->find(ticket);
+  if (it == pending_responses->end()) {
+    return {primitives::AbslStatusCode::kInvalidArgument, "unknown ticket"};
+  }
+  if (!wait && it->second.second++ == 0) {
+    *ready = false;
+    return asylo::primitives::PrimitiveStatus::OkStatus();
+  }
+  *ready = true;
+  *response_buffer = it->second.first.As<uint8_t>();
+  *response_size = it->second.first.size();
+  pending_responses->erase(it);
+  return asylo::primitives::PrimitiveStatus::OkStatus();
+}
+
+// Submits system calls for asynchronous completion and collects their results,
+// covering deferred readiness, output parameter copyback and invalid handles.
+TEST(SystemCallTest, AsyncSubmitCollectTest) {
+  enc_set_dispatch_syscall(SystemCallDispatcher);
+  enc_set_dispatch_async_syscall(AsyncSubmitDispatcher, AsyncCollectDispatcher);
+  ASSERT_TRUE(enc_is_async_syscall_dispatcher_set());
+
+  // A non-waiting collect observes the call in flight before completion.
+  int64_t handle = enc_untrusted_syscall_submit(SYS_getpid);
+  ASSERT_GE(handle, 0);
+  EXPECT_THAT(enc_untrusted_syscall_collect(handle, /*wait=*/false), Eq(-1));
+  EXPECT_THAT(errno, Eq(EAGAIN));
+  EXPECT_THAT(enc_untrusted_syscall_collect(handle, /*wait=*/true),
+              Eq(getpid()));
+
+  // Output parameters are copied back into the caller's buffer at collection.
+  char buffer[2048];
+  handle = enc_untrusted_syscall_submit(SYS_getcwd, buffer, sizeof(buffer));
+  ASSERT_GE(handle, 0);
+  EXPECT_GT(enc_untrusted_syscall_collect(handle, /*wait=*/true), 0);
+  char buffer_expected[2048];
+  EXPECT_THAT(getcwd(buffer_expected, sizeof(buffer_expected)), Not(IsNull()));
+  EXPECT_THAT(buffer, StrEq(buffer_expected));
+
+  // A consumed or never-issued handle is rejected.
+  EXPECT_THAT(enc_untrusted_syscall_collect(handle, /*wait=*/true), Eq(-1));
+  EXPECT_THAT(errno, Eq(EINVAL));
+}
+
+// Ensure that submission fails with ENOSYS when no asynchronous dispatcher is
+// installed.
+TEST(SystemCallTest, AsyncSubmitWithoutDispatcherTest) {
+  enc_set_dispatch_async_syscall(nullptr, nullptr);
+  EXPECT_FALSE(enc_is_async_syscall_dispatcher_set());
+  EXPECT_THAT(enc_untrusted_syscall_submit(SYS_getpid), Eq(-1));
+  EXPECT_THAT(errno, Eq(ENOSYS));
+}
+
+// Fake time source for latency accounting, advancing 8 ticks per read so a
+// recorded dispatch observes a latency of exactly 8 ticks.
+uint64_t FakeStatsClock() {
+  static uint64_t ticks = 0;
+  return ticks += 8;
+}
+
+// Verifies that enabled statistics record an invocation count, total latency
+// and the matching power-of-two histogram bucket per sysno.
+TEST(SystemCallTest, SyscallStatsTest) {
+  enc_set_dispatch_syscall(SystemCallDispatcher);
+  enc_set_syscall_clock(FakeStatsClock);
+  enc_set_syscall_stats_enabled(true);
+  enc_reset_syscall_stats();
+
+  EXPECT_THAT(enc_untrusted_syscall(SYS_getpid), Eq(getpid()));
+  enc_set_syscall_stats_enabled(false);
+
+  struct SyscallStats stats;
+  ASSERT_TRUE(enc_read_syscall_stats(SYS_getpid, &stats));
+  EXPECT_THAT(stats.count, Eq(1));
+  EXPECT_THAT(stats.total_ticks, Eq(8));
+  EXPECT_THAT(stats.latency_buckets[3], Eq(1));  // 8 ticks: [2^3, 2^4).
+
+  EXPECT_FALSE(enc_read_syscall_stats(-1, &stats));
+  enc_set_syscall_clock(nullptr);
+}
+
+// Verifies that statistics enabled without a clock still count invocations.
+TEST(SystemCallTest, SyscallStatsWithoutClockTest) {
+  enc_set_dispatch_syscall(SystemCallDispatcher);
+  ASSERT_FALSE(enc_is_syscall_clock_set());
+  enc_set_syscall_stats_enabled(true);
+  enc_reset_syscall_stats();
+
+  EXPECT_THAT(enc_untrusted_syscall(SYS_getpid), Eq(getpid()));
+  enc_set_syscall_stats_enabled(false);
+
+  struct SyscallStats stats;
+  ASSERT_TRUE(enc_read_syscall_stats(SYS_getpid, &stats));
+  EXPECT_THAT(stats.count, Eq(1));
+  EXPECT_THAT(stats.total_ticks, Eq(0));
+}
+
 }  // namespace
 }  // namespace system_call
 }  // namespace asylo
@@ -0,0 +1,81 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_PLATFORM_SYSTEM_CALL_TYPE_CONVERSIONS_FLAG_CONVERSION_H_
+#define ASYLO_PLATFORM_SYSTEM_CALL_TYPE_CONVERSIONS_FLAG_CONVERSION_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Helpers for table-driven conversion of bitset flags (open flags, mmap
+// protections, socket types, ...) between the enclave and host
+// representations. Used by the conversion functions emitted by the types
+// conversions generator.
+
+namespace asylo {
+namespace system_call {
+
+// A single entry of a flag-conversion table, mapping one flag value in the
+// input representation to its counterpart in the output representation.
+struct FlagMapEntry {
+  int64_t from;
+  int64_t to;
+};
+
+// Returns true if |value| has exactly one bit set.
+constexpr bool IsSingleBit(int64_t value) {
+  return value != 0 && (value & (value - 1)) == 0;
+}
+
+// Returns the mask of single-bit flags in |map| that have the same value in
+// both representations. These flags convert by masking the input, without a
+// per-flag test.
+template <size_t N>
+constexpr int64_t IdentityBits(const FlagMapEntry (&map)[N]) {
+  int64_t bits = 0;
+  for (size_t i = 0; i < N; ++i) {
+    if (map[i].from == map[i].to && IsSingleBit(map[i].from)) {
+      bits |= map[i].from;
+    }
+  }
+  return bits;
+}
+
+// Converts the flags set in |input| according to |map|. Identical single-bit
+// flags pass through bit-parallel in one mask operation; the remaining
+// entries use a per-flag test, exactly like the if-chains this replaces.
+// Since the generated tables are constexpr, the compiler resolves
+// IdentityBits() and the per-entry skip tests at compile time, so on hosts
+// where the enclave and kernel flag values coincide the whole conversion
+// folds down to a single mask.
+template <size_t N>
+constexpr int64_t ConvertFlagBits(const FlagMapEntry (&map)[N], int64_t input) {
+  int64_t output = input & IdentityBits(map);
+  for (size_t i = 0; i < N; ++i) {
+    if ((map[i].from != map[i].to || !IsSingleBit(map[i].from)) &&
+        (input & map[i].from) == map[i].from) {
+      output |= map[i].to;
+    }
+  }
+  return output;
+}
+
+}  // namespace system_call
+}  // namespace asylo
+
+#endif  // ASYLO_PLATFORM_SYSTEM_CALL_TYPE_CONVERSIONS_FLAG_CONVERSION_H_
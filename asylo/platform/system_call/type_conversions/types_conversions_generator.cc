@@ -91,32 +91,40 @@ std::string GetOrBasedEnumBody(bool to_prefix, const std::string &enum_name,
                                const EnumProperties &enum_properties) {
   std::ostringstream os;
 
-  // Generate result initialization.
-  os << "  " << enum_properties.data_type << " output = "
-     << (to_prefix ? enum_properties.default_value_host
-                   : enum_properties.default_value_enclave)
-     << ";\n";
-
-  // Generate or-based enum result accumulation. Since there are cases that enum
-  // may contain multiple bits, the value has to be checked explicitly.
+  // Generate a constexpr conversion table. ConvertFlagBits() passes identical
+  // single-bit flags through bit-parallel in one mask operation and only
+  // tests the remaining entries per flag; since the table is constexpr, the
+  // split between the two is resolved at compile time.
+  os << "  static constexpr ::asylo::system_call::FlagMapEntry "
+        "kConversionMap[] = {\n";
   for (const auto &enum_pair : enum_properties.values) {
+    std::string input_val =
+        to_prefix ? enum_pair.first
+                  : absl::StrCat(klinux_prefix, "_", enum_pair.first);
+    std::string output_val =
+        to_prefix ? absl::StrCat(klinux_prefix, "_", enum_pair.first)
+                  : enum_pair.first;
+
     if (enum_properties.wrap_macros_with_if_defined) {
       os << "#if defined(" << enum_pair.first << ")\n";
     }
-    os << "  if ((input & "
-       << (to_prefix ? enum_pair.first
-                     : absl::StrCat(klinux_prefix, "_", enum_pair.first))
-       << ") == "
-       << (to_prefix ? enum_pair.first
-                     : absl::StrCat(klinux_prefix, "_", enum_pair.first))
-       << ") output |= static_cast<" << enum_properties.data_type << ">("
-       << (to_prefix ? absl::StrCat(klinux_prefix, "_", enum_pair.first)
-                     : enum_pair.first)
-       << ");\n";
+    os << "      {" << input_val << ", " << output_val << "},\n";
     if (enum_properties.wrap_macros_with_if_defined) {
       os << "#endif\n";
     }
   }
+  // The sentinel converts nothing; it keeps the array non-empty even if every
+  // macro above is compiled out.
+  os << "      {0, 0},\n";
+  os << "  };\n";
+
+  // Generate result initialization and table-driven accumulation.
+  os << "  " << enum_properties.data_type << " output = "
+     << (to_prefix ? enum_properties.default_value_host
+                   : enum_properties.default_value_enclave)
+     << ";\n";
+  os << "  output |= static_cast<" << enum_properties.data_type
+     << ">(::asylo::system_call::ConvertFlagBits(kConversionMap, input));\n";
 
   if (enum_properties.or_input_to_default_value) {
     os << "  output |= static_cast<" << enum_properties.data_type
@@ -375,6 +383,9 @@ void WriteTypesConversions(
   *os_h << "#include "
            "\"asylo/platform/system_call/type_conversions/"
            "generated_types.h\"\n";
+  *os_h << "#include "
+           "\"asylo/platform/system_call/type_conversions/"
+           "flag_conversion.h\"\n";
 
   WriteEnumConversions(enum_properties_table, os_h, os_cc);
   WriteStructConversions(struct_properties_table, os_h, os_cc);
@@ -23,6 +23,8 @@
 
 #include <array>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -76,5 +78,140 @@ primitives::PrimitiveStatus UntrustedInvoke(primitives::Extent request,
   return SerializeResponse(reader.sysno(), result, errno, params, response);
 }
 
+primitives::PrimitiveStatus SerializeFailureResponse(
+    primitives::Extent request, int error_number,
+    primitives::Extent *response) {
+  MessageReader reader(request);
+  SystemCallDescriptor descriptor(reader.sysno());
+
+  // Response parameters: failed calls carry zero-filled output buffers, sized
+  // exactly as a real invocation would size them.
+  std::array<uint64_t, kParameterMax> params;
+  params.fill(0);
+  std::vector<std::unique_ptr<char[]>> output_buffers;
+
+  for (int i = 0; i < kParameterMax; i++) {
+    ParameterDescriptor parameter = descriptor.parameter(i);
+    if (parameter.is_in()) {
+      if (parameter.is_pointer()) {
+        params[i] = reader.parameter_address<uint64_t>(i);
+      } else {
+        params[i] = reader.parameter<uint64_t>(i);
+      }
+    } else if (parameter.is_out()) {
+      size_t size;
+      if (parameter.is_bounded()) {
+        int bounding_index = parameter.bounding_parameter().index();
+        size =
+            reader.parameter<size_t>(bounding_index) * parameter.element_size();
+      } else {
+        size = parameter.size();
+      }
+      output_buffers.emplace_back(new char[size]());
+      params[i] = reinterpret_cast<uint64_t>(output_buffers.back().get());
+    }
+  }
+
+  return SerializeResponse(reader.sysno(), static_cast<uint64_t>(-1),
+                           error_number, params, response);
+}
+
+primitives::PrimitiveStatus UntrustedInvoke(
+    const std::vector<primitives::Extent> &request,
+    std::vector<primitives::Extent> *response) {
+  if (request.empty()) {
+    return {primitives::AbslStatusCode::kInvalidArgument,
+            "Scatter-gather request contains no message extent."};
+  }
+  MessageReader reader(request[0]);
+  SystemCallDescriptor descriptor(reader.sysno());
+
+  // Parameters passed to a native system call.
+  std::array<uint64_t, kParameterMax> params;
+  params.fill(0);
+
+  // Buffers allocated for parameters, freed below unless handed back to the
+  // caller as response extents.
+  std::vector<void *> allocated;
+
+  // Frees every allocated parameter buffer, on early exit.
+  auto free_allocated = [&allocated]() {
+    for (void *buffer : allocated) {
+      free(buffer);
+    }
+  };
+
+  // Index of the next out-of-line extent in the request.
+  size_t next_extent = 1;
+
+  for (int i = 0; i < kParameterMax; i++) {
+    ParameterDescriptor parameter = descriptor.parameter(i);
+    if (parameter.is_in()) {
+      if (reader.parameter_is_out_of_line(i)) {
+        if (next_extent >= request.size()) {
+          free_allocated();
+          return {primitives::AbslStatusCode::kInvalidArgument,
+                  "Scatter-gather request is missing an out-of-line extent."};
+        }
+        primitives::Extent extent = request[next_extent++];
+        if (parameter.is_out()) {
+          // In-out buffers come back to the caller as response extents, which
+          // must be owned by the caller; copy them out of the request.
+          void *buffer = malloc(extent.size());
+          memcpy(buffer, extent.data(), extent.size());
+          allocated.push_back(buffer);
+          params[i] = reinterpret_cast<uint64_t>(buffer);
+        } else {
+          // Pass the out-of-line input buffer to the system call in place.
+          params[i] = reinterpret_cast<uint64_t>(extent.data());
+        }
+      } else if (parameter.is_pointer()) {
+        params[i] = reader.parameter_address<uint64_t>(i);
+      } else {
+        params[i] = reader.parameter<uint64_t>(i);
+      }
+    } else if (parameter.is_out()) {
+      // Allocate storage for the result. Out-of-line output buffers are
+      // written by the system call and returned directly as response extents.
+      size_t size;
+      if (parameter.is_bounded()) {
+        int bounding_index = parameter.bounding_parameter().index();
+        size =
+            reader.parameter<size_t>(bounding_index) * parameter.element_size();
+      } else {
+        size = parameter.size();
+      }
+      void *buffer = calloc(1, size);
+      allocated.push_back(buffer);
+      params[i] = reinterpret_cast<uint64_t>(buffer);
+    }
+  }
+
+  // Invoke the native system call.
+  uint64_t result = syscall(reader.sysno(), params[0], params[1], params[2],
+                            params[3], params[4], params[5]);
+
+  // Build the response message.
+  primitives::PrimitiveStatus status =
+      SerializeResponseSg(reader.sysno(), result, errno, params, response);
+
+  // Free parameter buffers not handed back to the caller as response extents.
+  for (void *buffer : allocated) {
+    bool returned = false;
+    if (status.ok()) {
+      for (size_t j = 1; j < response->size(); j++) {
+        if ((*response)[j].data() == buffer) {
+          returned = true;
+          break;
+        }
+      }
+    }
+    if (!returned) {
+      free(buffer);
+    }
+  }
+  return status;
+}
+
 }  // namespace system_call
 }  // namespace asylo
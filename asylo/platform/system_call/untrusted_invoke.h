@@ -33,6 +33,27 @@ namespace system_call {
 primitives::PrimitiveStatus UntrustedInvoke(primitives::Extent request,
                                             primitives::Extent *response);
 
+// Invokes the native Linux system call described by a scatter-gather request
+// and builds a scatter-gather response. `request` holds the fixed-layout
+// message followed by one extent per out-of-line input parameter, in
+// increasing parameter index order; out-of-line input buffers are passed to
+// the system call in place, without reassembly into a contiguous message. On
+// success, every extent in `response` is allocated by malloc and owned by the
+// caller, with out-of-line output buffers written by the system call returned
+// directly as response extents.
+primitives::PrimitiveStatus UntrustedInvoke(
+    const std::vector<primitives::Extent> &request,
+    std::vector<primitives::Extent> *response);
+
+// Builds in `response` the serialized response `request` would produce had
+// the system call failed with -1 and `error_number`, without invoking the
+// system call. Output parameters are zero-filled. Used to complete a call
+// from the untrusted runtime itself — for example one abandoned at its
+// deadline — through the regular response deserialization path.
+primitives::PrimitiveStatus SerializeFailureResponse(
+    primitives::Extent request, int error_number,
+    primitives::Extent *response);
+
 }  // namespace system_call
 }  // namespace asylo
 
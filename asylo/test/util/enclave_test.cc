@@ -25,6 +25,10 @@
 #include "asylo/test/util/test_flags.h"
 
 ABSL_FLAG(std::string, enclave_path, "", "Path to enclave");
+ABSL_FLAG(bool, reuse_enclave, false,
+          "Reuse one loaded enclave across the tests in a shard, sending it a "
+          "reset input between tests instead of reloading it. Requires a test "
+          "enclave that handles the enclave_input_test_reset extension");
 
 namespace asylo {
 
@@ -34,7 +38,8 @@ void EnclaveTest::SetUpBase() {
     logging_config->set_log_directory(absl::GetFlag(FLAGS_test_tmpdir));
   }
   ASYLO_ASSERT_OK(test_launcher_.SetUp(absl::GetFlag(FLAGS_enclave_path),
-                                       config_, enclave_url_));
+                                       config_, enclave_url_,
+                                       absl::GetFlag(FLAGS_reuse_enclave)));
   client_ = test_launcher_.mutable_client();
 }
 
@@ -29,6 +29,7 @@
 #include "asylo/util/status.h"
 
 ABSL_DECLARE_FLAG(std::string, enclave_path);
+ABSL_DECLARE_FLAG(bool, reuse_enclave);
 
 namespace asylo {
 
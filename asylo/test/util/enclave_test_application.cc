@@ -42,4 +42,9 @@ const std::string &EnclaveTestCase::GetEnclaveFinalTestString(
   return final_input.GetExtension(enclave_final_test_string).test_string();
 }
 
+bool EnclaveTestCase::IsEnclaveResetInput(const EnclaveInput &input) {
+  return input.HasExtension(enclave_input_test_reset) &&
+         input.GetExtension(enclave_input_test_reset).reset();
+}
+
 }  // namespace asylo
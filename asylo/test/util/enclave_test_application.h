@@ -38,6 +38,12 @@ class EnclaveTestCase : public TrustedApplication {
 
   // Gets test_string from the enclave_final_test_string protobuf extension.
   const std::string &GetEnclaveFinalTestString(const EnclaveFinal &final_input);
+
+  // Returns true if |input| is a between-test reset request from an
+  // EnclaveTestLauncher reusing this enclave across tests. Test enclaves run
+  // in that mode must check for this in Run, clear any per-test state, and
+  // return an OK status without further processing.
+  bool IsEnclaveResetInput(const EnclaveInput &input);
 };
 
 }  // namespace asylo
@@ -33,14 +33,31 @@
 namespace asylo {
 
 EnclaveTestLauncher::EnclaveTestLauncher()
-    : manager_(nullptr), client_(nullptr), loader_(nullptr) {}
+    : manager_(nullptr),
+      client_(nullptr),
+      loader_(nullptr),
+      reuse_enclave_(false) {}
 
 Status EnclaveTestLauncher::SetUp(const std::string &enclave_path,
                                   const EnclaveConfig &econfig,
-                                  const std::string &enclave_url) {
+                                  const std::string &enclave_url,
+                                  bool reuse_enclave) {
   EnclaveManager::Configure(EnclaveManagerOptions());
   ASYLO_ASSIGN_OR_RETURN(manager_, EnclaveManager::Instance());
 
+  reuse_enclave_ = reuse_enclave;
+  if (reuse_enclave_) {
+    client_ = manager_->GetClient(enclave_url);
+    if (client_) {
+      // An enclave loaded by an earlier test is being reused; ask it to clear
+      // per-test state instead of reloading.
+      EnclaveInput reset_input;
+      reset_input.MutableExtension(enclave_input_test_reset)->set_reset(true);
+      EnclaveOutput reset_output;
+      return client_->EnterAndRun(reset_input, &reset_output);
+    }
+  }
+
   // Create an EnclaveLoadConfig object.
   EnclaveLoadConfig load_config;
   load_config.set_name(enclave_url);
@@ -80,6 +97,11 @@ Status EnclaveTestLauncher::TearDown(const EnclaveFinal &efinal,
   if (!client_) {
     return Status::OkStatus();
   }
+  if (reuse_enclave_) {
+    // The enclave stays loaded for the next test in the shard. It is
+    // finalized when the process exits.
+    return Status::OkStatus();
+  }
   if (!manager_) {
     EnclaveManager::Configure(EnclaveManagerOptions());
     ASYLO_ASSIGN_OR_RETURN(manager_, EnclaveManager::Instance());
@@ -33,8 +33,17 @@ class EnclaveTestLauncher {
 
   // Loads and initializes the enclave passed in |enclave_path| with name
   // |enclave_url| and calls EnterAndInitialize with |econfig|.
+  //
+  // If |reuse_enclave| is true and an enclave named |enclave_url| is already
+  // loaded in this process, the loaded enclave is reused instead: SetUp()
+  // skips the load and sends the enclave a reset request (an EnclaveInput
+  // carrying the enclave_input_test_reset extension) so it can clear per-test
+  // state. TearDown() then leaves the enclave loaded for the next test in the
+  // shard. Reuse requires a test enclave that handles the reset input in its
+  // Run method; note that the reused enclave keeps the EnclaveConfig it was
+  // first loaded with, so |econfig| is ignored on reuse.
   Status SetUp(const std::string &enclave_path, const EnclaveConfig &econfig,
-               const std::string &enclave_url);
+               const std::string &enclave_url, bool reuse_enclave = false);
 
   // Calls the client's EnterAndRun method with |input| and |output|. Returns
   // PRECONDITION_FAILED if SetUp() has not yet been invoked successfully to
@@ -43,7 +52,9 @@ class EnclaveTestLauncher {
 
   // Runs EnterAndFinalize with |efinal| unless |skipTearDown| is true, and then
   // destroys the enclave. Returns OK if there is no enclave under test because
-  // SetUp() has not been called successfully.
+  // SetUp() has not been called successfully. If SetUp() was called with
+  // |reuse_enclave| set, skips finalization and destruction and leaves the
+  // enclave loaded for reuse by a later test.
   Status TearDown(const EnclaveFinal &efinal, bool skipTearDown = false);
 
   // Mutable access to the loaded client.
@@ -62,6 +73,9 @@ class EnclaveTestLauncher {
   EnclaveManager *manager_;
   EnclaveClient *client_;
   std::unique_ptr<SgxLoader> loader_;
+
+  // Whether the enclave is shared across tests and must survive TearDown().
+  bool reuse_enclave_;
 };
 
 }  // namespace asylo
@@ -20,6 +20,7 @@
 
 #include <fcntl.h>
 #include <libgen.h>  // dirname()
+#include <poll.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -27,7 +28,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <sstream>
-#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "absl/strings/str_cat.h"
@@ -36,6 +37,22 @@
 
 namespace asylo {
 namespace experimental {
+namespace {
+
+// Size of each read from the subprocess's output pipe. Large reads amortize
+// the per-read and per-batch checking overhead for verbose subprocesses.
+constexpr size_t kReadBufferSize = 64 * 1024;
+
+// Capacity requested for the output pipe. A larger in-kernel ring keeps an
+// output-heavy subprocess from blocking on a full pipe between reads. The
+// request is best-effort; the kernel caps it for unprivileged processes.
+constexpr int kCheckPipeCapacity = 1 << 20;
+
+// How long one wait for subprocess output may last, bounding the latency of
+// noticing subprocess termination without output.
+constexpr int kPollTimeoutMs = 50;
+
+}  // namespace
 
 ExecTester::ExecTester(const std::vector<std::string> &args, int fd_to_check)
     : args_(args), fd_to_check_(fd_to_check) {
@@ -128,6 +145,10 @@ void ExecTester::RunWithAsserts(const std::string &input, bool *result,
     int flags = fcntl(read_fd_to_check, F_GETFL, 0);
     fcntl(read_fd_to_check, F_SETFL, flags | O_NONBLOCK);
 
+#ifdef F_SETPIPE_SZ
+    fcntl(read_fd_to_check, F_SETPIPE_SZ, kCheckPipeCapacity);
+#endif
+
     ReadCheckLoop(pid, read_fd_to_check, result, status);
   }
 }
@@ -136,20 +157,31 @@ void ExecTester::ReadCheckLoop(pid_t pid, int fd, bool *result, int *status) {
   ASSERT_NE(nullptr, status);
 
   bool conjunction = true;
-  char buffer[1024];
+  std::vector<char> buffer(kReadBufferSize);
   std::stringstream linebuf;
+  bool saw_eof = false;
 
   // Read and check all subprocess output to |fd| until the subprocess
   // terminates.
   while (true) {
-    std::this_thread::yield();
+    // Sleep until the subprocess produces output or closes the pipe, bounded
+    // so that termination without output is still noticed promptly.
+    struct pollfd poll_fd = {fd, POLLIN, 0};
+    poll(&poll_fd, 1, kPollTimeoutMs);
+
     int changed_pid = waitpid(pid, status, WNOHANG);
     ASSERT_NE(-1, changed_pid)
         << "Wait on subprocess status failed: " << strerror(errno);
 
-    CheckFD(fd, buffer, &linebuf, &conjunction);
+    CheckFD(fd, absl::MakeSpan(buffer), &linebuf, &conjunction, &saw_eof);
 
     if (changed_pid && (WIFEXITED(*status) || WIFSIGNALED(*status))) {
+      // Drain and check output that was still in the pipe when the
+      // subprocess terminated. With no writers left, the reads below cannot
+      // block indefinitely: they end with an end-of-file.
+      while (!saw_eof) {
+        CheckFD(fd, absl::MakeSpan(buffer), &linebuf, &conjunction, &saw_eof);
+      }
       *result = conjunction;
       return;
     }
@@ -157,9 +189,11 @@ void ExecTester::ReadCheckLoop(pid_t pid, int fd, bool *result, int *status) {
 }
 
 void ExecTester::CheckFD(int fd, absl::Span<char> buffer,
-                         std::stringstream *linebuf, bool *result) {
+                         std::stringstream *linebuf, bool *result,
+                         bool *saw_eof) {
   ASSERT_FALSE(buffer.empty());
   ASSERT_NE(nullptr, linebuf);
+  ASSERT_NE(nullptr, saw_eof);
 
   ssize_t numread = read(fd, buffer.data(), buffer.size());
 
@@ -169,24 +203,34 @@ void ExecTester::CheckFD(int fd, absl::Span<char> buffer,
                              << "): " << strerror(errno);
     return;
   } else if (numread == 0) {  // The fd is closed. Test the rest of the line.
+    *saw_eof = true;
     std::string line = linebuf->str();
     if (!line.empty()) {
       linebuf->str("");
-      *result &= CheckLine(line);
+      absl::string_view last_line = line;
+      *result &= CheckBatch(absl::MakeConstSpan(&last_line, 1));
     }
     return;
   }
 
-  // Test each line we see in this buffer before moving on.
-  std::vector<absl::string_view> lines =
+  // Check the complete lines in this buffer as one batch before moving on.
+  std::vector<absl::string_view> pieces =
       absl::StrSplit(absl::string_view(buffer.data(), numread), '\n');
-  for (int i = 0; i < lines.size() - 1; ++i) {
-    linebuf->write(lines[i].data(), lines[i].size());
-    *result &= CheckLine(linebuf->str());
-    linebuf->str("");
+  ASSERT_GT(pieces.size(), 0);
+  std::string first_line;
+  if (pieces.size() > 1) {
+    std::vector<absl::string_view> lines(pieces.begin(), pieces.end() - 1);
+    // The first complete line ends any partial line carried over from the
+    // previous read.
+    first_line = linebuf->str();
+    if (!first_line.empty()) {
+      linebuf->str("");
+      first_line.append(lines[0].data(), lines[0].size());
+      lines[0] = first_line;
+    }
+    *result &= CheckBatch(lines);
   }
-  ASSERT_GT(lines.size(), 0);
-  linebuf->write(lines.back().data(), lines.back().size());
+  linebuf->write(pieces.back().data(), pieces.back().size());
 }
 
 }  // namespace experimental
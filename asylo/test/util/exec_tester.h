@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 
 namespace asylo {
@@ -80,6 +81,23 @@ class ExecTester {
   /// \return `true` if the property holds and `false` otherwise.
   virtual bool CheckLine(const std::string &line) { return true; }
 
+  /// Checks a batch of complete output lines, as many as one read from the
+  /// subprocess produced. The default implementation calls CheckLine() on
+  /// each line in order. Subclasses that match output against regular
+  /// expressions or other patterns spanning many lines can override this to
+  /// run one matching pass per batch instead of one per line, which keeps the
+  /// harness out of the profile of output-heavy subprocesses.
+  ///
+  /// \param lines The complete lines from one read, without terminators.
+  /// \return The conjunction of the per-line check results.
+  virtual bool CheckBatch(absl::Span<const absl::string_view> lines) {
+    bool result = true;
+    for (absl::string_view line : lines) {
+      result &= CheckLine(std::string(line));
+    }
+    return result;
+  }
+
   /// Returns the final result given the accumulated CheckLine() results. This
   /// is useful e.g., for determining hard bounds that CheckLine() soft-checks.
   ///
@@ -98,13 +116,14 @@ class ExecTester {
   void DoExec(int read_stdin, int write_stdin, int read_fd_to_check,
               int write_fd_to_check);
 
-  // Reads contents of `fd` into `buffer` and runs CheckLine() on each
-  // newline-terminated piece of `buffer` as written to `linebuf`. Stores any
-  // unfinished line in `linebuf`, i.e., the characters in `buffer` that follow
-  // the last newline. The accumulated CheckLine() results are stored in
-  // `result`.
+  // Reads contents of `fd` into `buffer` and runs CheckBatch() on the
+  // newline-terminated pieces of `buffer` as one batch. Stores any unfinished
+  // line in `linebuf`, i.e., the characters in `buffer` that follow the last
+  // newline. The accumulated check results are stored in `result`. Sets
+  // `saw_eof` when the read returns end-of-file, i.e., all writers have
+  // closed `fd` and its contents are fully consumed.
   void CheckFD(int fd, absl::Span<char> buffer, std::stringstream *linebuf,
-               bool *result);
+               bool *result, bool *saw_eof);
 
   // Polls output from `pid` to `fd` and calls CheckFD() to accumulate
   // CheckLine() results. Sets `status` to `pid`'s termination status.
@@ -28,6 +28,16 @@
 #include "asylo/util/status_macros.h"
 
 namespace asylo {
+namespace {
+
+// Capture pipe capacity requested at construction. The default pipe capacity
+// (64kB on Linux) stalls verbose writers between collections; a larger
+// in-kernel ring lets output-heavy tests run ahead of the collector. The
+// request is best-effort: the kernel caps it at /proc/sys/fs/pipe-max-size
+// for unprivileged processes, and capture works at any granted size.
+constexpr int kCapturePipeCapacity = 1 << 20;
+
+}  // namespace
 
 OutputCollector::OutputCollector(internal::FromStdoutTag)
     : OutputCollector(STDOUT_FILENO) {}
@@ -40,6 +50,9 @@ OutputCollector::OutputCollector(int fd)
   CHECK_NE(fd_copy_, -1) << strerror(errno);
   int pipe_fds[2];
   CHECK_NE(pipe(pipe_fds), -1) << strerror(errno);
+#ifdef F_SETPIPE_SZ
+  fcntl(pipe_fds[1], F_SETPIPE_SZ, kCapturePipeCapacity);
+#endif
 
   // Ensure that the new file represented by target_fd_ has the same flags as
   // the original one.
@@ -19,6 +19,7 @@
 #ifndef ASYLO_UTIL_ALIGNED_OBJECT_PTR_H_
 #define ASYLO_UTIL_ALIGNED_OBJECT_PTR_H_
 
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <memory>
@@ -27,52 +28,148 @@
 
 namespace asylo {
 
+namespace internal {
+
+constexpr size_t AlignedSlabGcd(size_t a, size_t b) {
+  return b == 0 ? a : AlignedSlabGcd(b, a % b);
+}
+
+constexpr size_t AlignedSlabLcm(size_t a, size_t b) {
+  return a / AlignedSlabGcd(a, b) * b;
+}
+
+constexpr size_t AlignedSlabMax(size_t a, size_t b) { return a < b ? b : a; }
+
+constexpr size_t AlignedSlabRoundUp(size_t value, size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+// A size-class slab pool backing AlignedObjectPtr. Each distinct
+// (slot size, alignment) pair gets its own static pool; object types that
+// round up to the same slot size share one pool. A slab is a single heap
+// allocation carved into pre-aligned slots, so the alignment arithmetic is
+// paid once per slab instead of once per object, and freed slots are pushed
+// on a free list for reuse. Steady-state allocation is a list pop.
+//
+// Slabs are retained for the lifetime of the process; the pool's footprint
+// is bounded by the peak number of live objects in its size class.
+template <size_t SlotSize, size_t Align>
+class AlignedSlabPool {
+ public:
+  // Pops a pre-aligned slot of SlotSize bytes off the free list, growing the
+  // pool by one slab if the list is empty.
+  static void *Allocate() {
+    Lock();
+    if (free_list_ == nullptr) {
+      AddSlab();
+    }
+    FreeNode *slot = free_list_;
+    free_list_ = slot->next;
+    Unlock();
+    return slot;
+  }
+
+  // Returns a slot obtained from Allocate() to the free list.
+  static void Deallocate(void *slot) {
+    FreeNode *node = static_cast<FreeNode *>(slot);
+    Lock();
+    node->next = free_list_;
+    free_list_ = node;
+    Unlock();
+  }
+
+ private:
+  // Free slots are threaded through the slots themselves; SlotSize is
+  // guaranteed by AlignedObjectPtr to hold and align a pointer.
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  // Target slab footprint. Small size classes get many slots per slab; size
+  // classes at or above the target degenerate to one slot per slab, which
+  // still buys free-list reuse without holding large idle slabs.
+  static constexpr size_t kTargetSlabBytes = 16 * 1024;
+  static constexpr size_t kSlotsPerSlab =
+      SlotSize >= kTargetSlabBytes ? 1 : kTargetSlabBytes / SlotSize;
+
+  // Allocates one slab and pushes its slots onto the free list. Must be
+  // called with the pool lock held.
+  static void AddSlab() {
+    // Over-allocate by one alignment quantum so the first slot can be
+    // aligned; subsequent slots stay aligned because SlotSize is a multiple
+    // of Align. The slab intentionally lives for the rest of the process.
+    uint8_t *raw = new uint8_t[SlotSize * kSlotsPerSlab + Align - 1];
+    uintptr_t numeric_addr = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned_addr =
+        numeric_addr + (Align - numeric_addr % Align) % Align;
+    for (size_t i = 0; i < kSlotsPerSlab; ++i) {
+      FreeNode *node =
+          reinterpret_cast<FreeNode *>(aligned_addr + i * SlotSize);
+      node->next = free_list_;
+      free_list_ = node;
+    }
+  }
+
+  static void Lock() {
+    while (lock_.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+
+  static void Unlock() { lock_.clear(std::memory_order_release); }
+
+  static FreeNode *free_list_;
+  static std::atomic_flag lock_;
+};
+
+template <size_t SlotSize, size_t Align>
+typename AlignedSlabPool<SlotSize, Align>::FreeNode
+    *AlignedSlabPool<SlotSize, Align>::free_list_ = nullptr;
+
+template <size_t SlotSize, size_t Align>
+std::atomic_flag AlignedSlabPool<SlotSize, Align>::lock_ = ATOMIC_FLAG_INIT;
+
+}  // namespace internal
+
 // An AlignedObjectPtr internally allocates aligned memory for one instance
 // of the object, and presents a pointer-like interface (*, ->) to that memory.
 // The memory allocated to the embedded object is always owned by the
 // AlignedObjectPtr, and must not be managed outside of the AlignedObjectPtr.
 // An AlignedObjectPtr instance cannot be copied. However, it can be moved to
 // another AlignedObjectPtr instance.
+//
+// Storage comes from a static slab pool keyed by the object's padded size and
+// alignment, so repeated construction on a hot path (e.g. the aligned
+// parameter structs crossing the enclave boundary) reuses pre-aligned slots
+// instead of paying an oversized allocation per object.
 template <class T, size_t Align>
 class AlignedObjectPtr {
  public:
   template <typename... Args>
-  explicit AlignedObjectPtr(Args &&... args)
-      : obj_ptr_{nullptr}, buffer_{nullptr} {
+  explicit AlignedObjectPtr(Args &&... args) : obj_ptr_{nullptr} {
     static_assert(sizeof(T) < (1ULL << 62),
                   "Size of template parameter T is too large.");
     static_assert(Align != 0, "Template parameter Align must not be zero.");
     static_assert(!std::is_array<T>::value,
                   "Template parameter T must not be an array type.");
-    size_t alloc_size = sizeof(T) + Align - 1;
     // For consistency with the rest of the code, do not check the value
-    // returned by new for nullptr equality.
-    buffer_.reset(new uint8_t[alloc_size]);
-    uint8_t *aligned_addr = align(Align, buffer_.get());
-    obj_ptr_ = new (aligned_addr) T(std::forward<Args>(args)...);
+    // returned by the allocator for nullptr equality.
+    void *slot = Pool::Allocate();
+    obj_ptr_ = new (slot) T(std::forward<Args>(args)...);
   }
 
-  AlignedObjectPtr(AlignedObjectPtr &&rhs)
-      : obj_ptr_{rhs.obj_ptr_}, buffer_{std::move(rhs.buffer_)} {
+  AlignedObjectPtr(AlignedObjectPtr &&rhs) : obj_ptr_{rhs.obj_ptr_} {
     rhs.obj_ptr_ = nullptr;
   }
 
-  ~AlignedObjectPtr() {
-    if (obj_ptr_ != nullptr) {
-      obj_ptr_->~T();
-    }
-  }
+  ~AlignedObjectPtr() { Reset(); }
 
   AlignedObjectPtr &operator=(AlignedObjectPtr &&rhs) {
     if (this == &rhs) {
       return *this;
     }
-    if (obj_ptr_ != nullptr) {
-      obj_ptr_->~T();
-    }
+    Reset();
     obj_ptr_ = rhs.obj_ptr_;
     rhs.obj_ptr_ = nullptr;
-    buffer_ = std::move(rhs.buffer_);
     return *this;
   }
 
@@ -95,19 +192,28 @@ class AlignedObjectPtr {
   }
 
  private:
-  // Aligns a memory address.
-  uint8_t *align(size_t alignment, uint8_t *addr) {
-    uintptr_t numeric_addr = reinterpret_cast<uintptr_t>(addr);
-    uint64_t offset = (alignment - (numeric_addr % alignment)) % alignment;
-    return reinterpret_cast<uint8_t *>(numeric_addr + offset);
+  // The pool slot stride: large enough for the object and the pool's
+  // embedded free-list pointer, and a multiple of both the requested
+  // alignment and the pointer alignment so every slot in a slab satisfies
+  // both. Object types that share a stride share a pool.
+  static constexpr size_t kSlotSize = internal::AlignedSlabRoundUp(
+      internal::AlignedSlabMax(sizeof(T), sizeof(void *)),
+      internal::AlignedSlabLcm(Align, alignof(void *)));
+
+  using Pool = internal::AlignedSlabPool<kSlotSize, Align>;
+
+  // Destroys the object, if any, and returns its slot to the pool.
+  void Reset() {
+    if (obj_ptr_ != nullptr) {
+      obj_ptr_->~T();
+      Pool::Deallocate(obj_ptr_);
+      obj_ptr_ = nullptr;
+    }
   }
 
-  // Pointer to the aligned object. This points to a location within the
-  // memory held by the buffer_ member below.
+  // Pointer to the aligned object. This points to the start of a slot owned
+  // by the slab pool.
   T *obj_ptr_;
-
-  // Smart pointer that points to the actual memory allocated on the heap.
-  std::unique_ptr<uint8_t[]> buffer_;
 };
 
 }  // namespace asylo
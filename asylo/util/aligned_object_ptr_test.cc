@@ -19,6 +19,7 @@
 #include "asylo/util/aligned_object_ptr.h"
 
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "absl/base/attributes.h"
@@ -271,5 +272,38 @@ TEST_F(AlignedObjectPtrTest, SelfMoveAssign) {
   EXPECT_NE(map->find(std::string("s3")), map->end());
 }
 
+// Test that a destroyed object's slot is reused by the next allocation of the
+// same size class, rather than triggering a fresh heap allocation.
+TEST_F(AlignedObjectPtrTest, SlotReuse) {
+  const void *first_addr;
+  {
+    AlignedObjectPtr<TestClass, kAlignSizes[2]> tc(1, 2);
+    first_addr = tc.get();
+  }
+  // The slab pool free list is LIFO, so a single-threaded
+  // allocate/destroy/allocate sequence must hand back the same slot.
+  AlignedObjectPtr<TestClass, kAlignSizes[2]> tc(3, 4);
+  EXPECT_EQ(tc.get(), first_addr);
+  CheckAlign(tc);
+}
+
+// Test that many concurrently live objects from the same pool occupy
+// distinct, properly aligned slots across slab boundaries.
+TEST_F(AlignedObjectPtrTest, ManyLiveObjectsAreDistinct) {
+  constexpr int kCount = 1000;
+  std::vector<AlignedObjectPtr<TestStruct, kAlignSizes[3]>> objects;
+  for (int i = 0; i < kCount; ++i) {
+    objects.emplace_back();
+    objects.back()->a = i;
+    CheckAlign(objects.back());
+  }
+  for (int i = 0; i < kCount; ++i) {
+    EXPECT_EQ(objects[i]->a, i);
+    for (int j = i + 1; j < kCount; ++j) {
+      ASSERT_NE(objects[i].get(), objects[j].get());
+    }
+  }
+}
+
 }  // namespace
 }  // namespace asylo
@@ -28,6 +28,81 @@
 
 namespace asylo {
 
+// Returns the index of the first element of the sorted array |data| of
+// |size| elements that does not compare less than |value|, or |size| if every
+// element does. Unlike std::lower_bound, the probe sequence is driven by a
+// conditional move rather than a data-dependent branch, so a mispredicted
+// comparison never flushes the pipeline; repeated probes with unpredictable
+// outcomes (e.g. validating pointers against a table of address extents) run
+// at a steady cost. Elements are compared with operator<.
+template <typename T>
+size_t BranchlessLowerBound(const T *data, size_t size, const T &value) {
+  const T *base = data;
+  size_t remaining = size;
+  while (remaining > 1) {
+    const size_t half = remaining / 2;
+    // Both possible next probes are known now; fetch them while the current
+    // comparison resolves.
+    __builtin_prefetch(base + half / 2);
+    __builtin_prefetch(base + half + half / 2);
+    // Compiles to a conditional move: no branch on the comparison outcome.
+    base += (base[half - 1] < value) ? half : 0;
+    remaining -= half;
+  }
+  return (base - data) + (size != 0 && base[0] < value ? 1 : 0);
+}
+
+// Fills |eytzinger| (of the same size as |sorted|) with the elements of the
+// sorted array |sorted| arranged in Eytzinger (breadth-first heap) order:
+// element 0 is the root, and the children of element i are elements 2i+1 and
+// 2i+2. Arrays laid out this way keep the first few probe levels of
+// EytzingerLowerBound in one or two cache lines. Callers that can afford the
+// one-time preprocessing should prefer this layout for repeated searches.
+template <typename T>
+void MakeEytzingerLayout(const T *sorted, size_t size, T *eytzinger) {
+  // Recursive in-order walk of the implicit tree, consuming |sorted| from the
+  // left. Lambda recursion keeps the helper out of the namespace.
+  struct Filler {
+    const T *sorted;
+    T *eytzinger;
+    size_t size;
+    size_t next = 0;
+    void Fill(size_t k) {
+      if (k > size) {
+        return;
+      }
+      Fill(2 * k);
+      eytzinger[k - 1] = sorted[next++];
+      Fill(2 * k + 1);
+    }
+  };
+  Filler filler{sorted, eytzinger, size};
+  filler.Fill(1);
+}
+
+// BranchlessLowerBound over an array in the Eytzinger layout produced by
+// MakeEytzingerLayout. Returns the index *into the Eytzinger array* of the
+// first element not less than |value|, or |size| if every element is less.
+// The descent touches one node per level, each prefetched a few levels
+// ahead, so large arrays cost close to one cache miss per level instead of
+// one per probe.
+template <typename T>
+size_t EytzingerLowerBound(const T *data, size_t size, const T &value) {
+  size_t k = 1;
+  while (k <= size) {
+    // Prefetch the great-great-grandchildren of the current node: all 16
+    // candidates are contiguous, so this is a single cache line for small T.
+    if (16 * k <= size) {
+      __builtin_prefetch(data + (16 * k - 1));
+    }
+    k = 2 * k + (data[k - 1] < value ? 1 : 0);
+  }
+  // The lower bound is the last node where the descent went left; peel off
+  // the trailing right turns (set bits) plus the final left turn.
+  k >>= __builtin_ctzll(~k) + 1;
+  return k == 0 ? size : k - 1;
+}
+
 // Returns the largest size_t for which f returns true, or 0 if f returns
 // false for all numbers. Assumes f returns true for all numbers from 0 up
 // to an unknown constant k, and false above that. Finds an upper bound in such
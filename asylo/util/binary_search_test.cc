@@ -17,7 +17,9 @@
  */
 #include "asylo/util/binary_search.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -41,5 +43,55 @@ TEST(BinarySearchTest, ConstantsSearchTest) {
             std::numeric_limits<std::ptrdiff_t>::max());
 }
 
+TEST(BinarySearchTest, BranchlessLowerBoundMatchesStdLowerBound) {
+  std::vector<int> data = {2, 3, 3, 5, 8, 13, 13, 13, 21, 34};
+  for (int value = 0; value <= 40; ++value) {
+    size_t expected =
+        std::lower_bound(data.begin(), data.end(), value) - data.begin();
+    EXPECT_EQ(BranchlessLowerBound(data.data(), data.size(), value), expected)
+        << "value = " << value;
+  }
+}
+
+TEST(BinarySearchTest, BranchlessLowerBoundEdgeCases) {
+  EXPECT_EQ(BranchlessLowerBound<int>(nullptr, 0, 7), 0);
+  int single = 5;
+  EXPECT_EQ(BranchlessLowerBound(&single, 1, 4), 0);
+  EXPECT_EQ(BranchlessLowerBound(&single, 1, 5), 0);
+  EXPECT_EQ(BranchlessLowerBound(&single, 1, 6), 1);
+}
+
+TEST(BinarySearchTest, MakeEytzingerLayoutOrdersBreadthFirst) {
+  std::vector<int> sorted = {1, 2, 3, 4, 5, 6, 7};
+  std::vector<int> eytzinger(sorted.size());
+  MakeEytzingerLayout(sorted.data(), sorted.size(), eytzinger.data());
+  // A full tree of seven elements: root 4, then 2 and 6, then the leaves.
+  EXPECT_THAT(eytzinger, ::testing::ElementsAre(4, 2, 6, 1, 3, 5, 7));
+}
+
+TEST(BinarySearchTest, EytzingerLowerBoundMatchesStdLowerBound) {
+  for (size_t size : {0, 1, 2, 3, 7, 10, 31, 100}) {
+    std::vector<int> sorted;
+    for (size_t i = 0; i < size; ++i) {
+      sorted.push_back(3 * i);  // Spaced so probes fall between elements.
+    }
+    std::vector<int> eytzinger(sorted.size());
+    MakeEytzingerLayout(sorted.data(), sorted.size(), eytzinger.data());
+    for (int value = -1; value <= static_cast<int>(3 * size) + 1; ++value) {
+      size_t expected =
+          std::lower_bound(sorted.begin(), sorted.end(), value) -
+          sorted.begin();
+      size_t actual =
+          EytzingerLowerBound(eytzinger.data(), eytzinger.size(), value);
+      if (expected == sorted.size()) {
+        EXPECT_EQ(actual, sorted.size()) << "value = " << value;
+      } else {
+        ASSERT_LT(actual, eytzinger.size()) << "value = " << value;
+        EXPECT_EQ(eytzinger[actual], sorted[expected]) << "value = " << value;
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace asylo
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "asylo/util/cleansing_allocator.h"
+#include "asylo/util/pooled_cleansing_allocator.h"
 
 namespace asylo {
 
@@ -36,6 +37,12 @@ using CleansingString =
 template <typename T>
 using CleansingVector = std::vector<T, CleansingAllocator<T>>;
 
+/// A vector container that zeros its memory on free and recycles freed
+/// buffers through a per-thread pool. Suitable for hot paths that churn
+/// through many similarly sized secrets.
+template <typename T>
+using PooledCleansingVector = std::vector<T, PooledCleansingAllocator<T>>;
+
 }  // namespace asylo
 
 #endif  // ASYLO_UTIL_CLEANSING_TYPES_H_
@@ -19,10 +19,14 @@
 #include "asylo/util/elf_reader.h"
 
 #include <cstring>
+#include <memory>
+#include <utility>
 
+#include "absl/base/call_once.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/types/optional.h"
+#include "asylo/util/mutex_guarded.h"
 #include "asylo/util/status_macros.h"
 
 namespace asylo {
@@ -147,10 +151,39 @@ StatusOr<ElfReader> ElfReader::CreateFromSpan(
   return ElfReaderCreator(elf_file).Create();
 }
 
+StatusOr<std::shared_ptr<const ElfReader>> ElfReader::CreateCachedFromSpan(
+    absl::Span<const uint8_t> elf_file) {
+  using ReaderCache = absl::flat_hash_map<std::pair<const uint8_t *, size_t>,
+                                          std::shared_ptr<const ElfReader>>;
+
+  // The registry is leaked so that cached readers survive until process exit.
+  static MutexGuarded<ReaderCache> *cache =
+      new MutexGuarded<ReaderCache>(ReaderCache());
+
+  const std::pair<const uint8_t *, size_t> key(elf_file.data(),
+                                               elf_file.size());
+  {
+    auto view = cache->ReaderLock();
+    auto lookup = view->find(key);
+    if (lookup != view->end()) {
+      return lookup->second;
+    }
+  }
+
+  ElfReader reader;
+  ASYLO_ASSIGN_OR_RETURN(reader, CreateFromSpan(elf_file));
+
+  // Another thread may have parsed the same file while this one did. The
+  // first insertion wins, so that all callers share one reader and the symbol
+  // index is built at most once per file.
+  auto view = cache->Lock();
+  return view->emplace(key, std::make_shared<const ElfReader>(std::move(reader)))
+      .first->second;
+}
+
 StatusOr<absl::Span<const uint8_t>> ElfReader::GetSectionData(
     absl::string_view section_name) const {
-  std::string section_name_string = std::string(section_name);
-  auto section_header_lookup = section_headers_.find(section_name_string);
+  auto section_header_lookup = section_headers_.find(section_name);
 
   if (section_header_lookup == section_headers_.cend()) {
     return Status(
@@ -163,7 +196,7 @@ StatusOr<absl::Span<const uint8_t>> ElfReader::GetSectionData(
                   absl::StrCat("Section ", section_name, " has no data"));
   }
 
-  auto section_data_lookup = section_data_.find(section_name_string);
+  auto section_data_lookup = section_data_.find(section_name);
   if (section_data_lookup == section_data_.cend()) {
     return Status(absl::StatusCode::kInternal,
                   absl::StrCat("Could not locate data associated with section ",
@@ -173,6 +206,67 @@ StatusOr<absl::Span<const uint8_t>> ElfReader::GetSectionData(
   return section_data_lookup->second;
 }
 
+StatusOr<const Elf64_Sym *> ElfReader::GetSymbol(
+    absl::string_view symbol_name) const {
+  SymbolIndex *index = symbol_index_.get();
+  absl::call_once(index->once,
+                  [this, index] { index->status = BuildSymbolIndex(index); });
+  ASYLO_RETURN_IF_ERROR(index->status);
+
+  auto symbol_lookup = index->symbols.find(symbol_name);
+  if (symbol_lookup == index->symbols.cend()) {
+    return Status(
+        absl::StatusCode::kNotFound,
+        absl::StrCat("File does not contain a symbol called ", symbol_name));
+  }
+
+  return symbol_lookup->second;
+}
+
+Status ElfReader::BuildSymbolIndex(SymbolIndex *index) const {
+  // Prefer the full symbol table; fall back to the dynamic symbol table for
+  // stripped binaries.
+  absl::string_view symbol_table_name = ".symtab";
+  absl::string_view string_table_name = ".strtab";
+  if (!section_headers_.contains(symbol_table_name)) {
+    symbol_table_name = ".dynsym";
+    string_table_name = ".dynstr";
+  }
+
+  absl::Span<const uint8_t> symbol_table;
+  absl::Span<const uint8_t> string_table;
+
+  ASYLO_ASSIGN_OR_RETURN(symbol_table, GetSectionData(symbol_table_name));
+  ASYLO_ASSIGN_OR_RETURN(string_table, GetSectionData(string_table_name));
+
+  // Add each named symbol to the index in the order they appear in the symbol
+  // table.
+  const size_t num_symbols = symbol_table.size() / sizeof(Elf64_Sym);
+  index->symbols.reserve(num_symbols);
+  for (size_t i = 0; i < num_symbols; ++i) {
+    const Elf64_Sym *symbol = reinterpret_cast<const Elf64_Sym *>(
+        &symbol_table[i * sizeof(Elf64_Sym)]);
+
+    // A st_name of zero indicates that the symbol has no name.
+    if (symbol->st_name == 0) {
+      continue;
+    }
+
+    auto symbol_name_or_none = GetStringAtOffset(string_table, symbol->st_name);
+    if (!symbol_name_or_none.has_value()) {
+      return Status(absl::StatusCode::kInvalidArgument,
+                    absl::StrCat("Malformed ELF file: symbol ", i,
+                                 " has invalid st_name"));
+    }
+
+    // Unlike section names, symbol names may legitimately be duplicated; keep
+    // the entry that appears first.
+    index->symbols.emplace(std::string(symbol_name_or_none.value()), symbol);
+  }
+
+  return Status::OkStatus();
+}
+
 StatusOr<ElfReader> ElfReaderCreator::Create() {
   ASYLO_RETURN_IF_ERROR(InitializeSectionMaps());
   return ElfReader(elf_file_, std::move(section_headers_),
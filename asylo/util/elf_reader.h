@@ -21,9 +21,11 @@
 
 #include <elf.h>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 
+#include "absl/base/call_once.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
@@ -42,8 +44,20 @@ class ElfReader {
   // there is no guarantee that ElfReader remains valid.
   static StatusOr<ElfReader> CreateFromSpan(absl::Span<const uint8_t> elf_file);
 
+  // Returns a reader for the given ELF file from a process-wide registry keyed
+  // by file identity - the address and size of |elf_file|. The first call for
+  // a given buffer parses the file and caches the reader; later calls return
+  // the cached reader, so repeated queries of the same binary share one
+  // section and symbol index.
+  //
+  // Readers in the registry are never discarded, so the underlying buffer must
+  // remain valid and unmodified for the remaining lifetime of the process.
+  static StatusOr<std::shared_ptr<const ElfReader>> CreateCachedFromSpan(
+      absl::Span<const uint8_t> elf_file);
+
   ElfReader() = default;
 
+  // Copies of an ElfReader share one lazily-built symbol index.
   ElfReader(const ElfReader &other) = default;
   ElfReader &operator=(const ElfReader &other) = default;
 
@@ -52,10 +66,33 @@ class ElfReader {
   StatusOr<absl::Span<const uint8_t>> GetSectionData(
       absl::string_view section_name) const;
 
+  // Returns a pointer into the given ELF file to the symbol table entry for
+  // |symbol_name|. The index over the file's symbol table (.symtab, or .dynsym
+  // if the file has no .symtab) is built on the first call and reused by later
+  // calls. If a name appears more than once, the entry that appears first in
+  // the symbol table is returned.
+  StatusOr<const Elf64_Sym *> GetSymbol(absl::string_view symbol_name) const;
+
  private:
   // This class is defined in elf_reader.cc.
   friend class ElfReaderCreator;
 
+  // The lazily-built index over the file's symbol table. Held by shared_ptr so
+  // that copies of an ElfReader build the index at most once between them.
+  struct SymbolIndex {
+    absl::once_flag once;
+
+    // A map from symbol names to their entries in the symbol table.
+    absl::flat_hash_map<std::string, const Elf64_Sym *> symbols;
+
+    // The result of building the index.
+    Status status;
+  };
+
+  // Builds |index| over the file's symbol table. Called at most once, on the
+  // first call to GetSymbol().
+  Status BuildSymbolIndex(SymbolIndex *index) const;
+
   ElfReader(
       absl::Span<const uint8_t> elf_file,
       absl::flat_hash_map<std::string, const Elf64_Shdr *> &&section_headers,
@@ -73,6 +110,9 @@ class ElfReader {
 
   // A map from section names to views of their data.
   absl::flat_hash_map<std::string, absl::Span<const uint8_t>> section_data_;
+
+  // The symbol index. Empty until the first call to GetSymbol().
+  std::shared_ptr<SymbolIndex> symbol_index_ = std::make_shared<SymbolIndex>();
 };
 
 }  // namespace asylo
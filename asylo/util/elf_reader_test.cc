@@ -22,6 +22,7 @@
 
 #include <cstring>
 #include <limits>
+#include <memory>
 #include <string>
 
 #include <gmock/gmock.h>
@@ -338,6 +339,64 @@ TEST_F(ElfReaderTest, ReturnsAppropriateErrorIfSectionTooBig) {
                                     " exceeds boundary of file"));
 }
 
+// Tests that GetSymbol locates a known symbol in a valid ELF file and that the
+// returned entry points inside the file.
+TEST_F(ElfReaderTest, GetSymbolFindsKnownSymbol) {
+  auto create_from_span_result =
+      ElfReader::CreateFromSpan(elf_file_mapping_.buffer());
+  ASSERT_THAT(create_from_span_result, IsOk());
+  ElfReader reader = create_from_span_result.ValueOrDie();
+
+  // The test binary is an unstripped executable, so its symbol table contains
+  // an entry for main().
+  auto get_symbol_result = reader.GetSymbol("main");
+  ASSERT_THAT(get_symbol_result, IsOk());
+  const Elf64_Sym *symbol = get_symbol_result.ValueOrDie();
+
+  const uint8_t *file_start = elf_file_mapping_.buffer().data();
+  const uint8_t *file_end = file_start + elf_file_mapping_.buffer().size();
+  EXPECT_GE(reinterpret_cast<const uint8_t *>(symbol), file_start);
+  EXPECT_LT(reinterpret_cast<const uint8_t *>(symbol + 1), file_end);
+
+  // A second lookup hits the cached index and returns the same entry.
+  auto second_lookup_result = reader.GetSymbol("main");
+  ASSERT_THAT(second_lookup_result, IsOk());
+  EXPECT_EQ(second_lookup_result.ValueOrDie(), symbol);
+}
+
+// Tests that GetSymbol returns an appropriate error if the requested symbol
+// does not exist.
+TEST_F(ElfReaderTest, GetSymbolReturnsAppropriateErrorIfSymbolNotFound) {
+  auto create_from_span_result =
+      ElfReader::CreateFromSpan(elf_file_mapping_.buffer());
+  ASSERT_THAT(create_from_span_result, IsOk());
+  ElfReader reader = create_from_span_result.ValueOrDie();
+
+  auto get_symbol_result = reader.GetSymbol(kAbsentSectionName);
+  EXPECT_THAT(get_symbol_result, Not(IsOk()));
+  EXPECT_THAT(get_symbol_result, StatusIs(absl::StatusCode::kNotFound));
+  EXPECT_EQ(get_symbol_result.status().error_message(),
+            absl::StrCat("File does not contain a symbol called ",
+                         kAbsentSectionName));
+}
+
+// Tests that CreateCachedFromSpan returns the same reader for repeated queries
+// of the same buffer.
+TEST_F(ElfReaderTest, CreateCachedFromSpanReturnsSameReader) {
+  auto first_result = ElfReader::CreateCachedFromSpan(elf_file_mapping_.buffer());
+  ASSERT_THAT(first_result, IsOk());
+  std::shared_ptr<const ElfReader> first = first_result.ValueOrDie();
+
+  auto second_result =
+      ElfReader::CreateCachedFromSpan(elf_file_mapping_.buffer());
+  ASSERT_THAT(second_result, IsOk());
+  EXPECT_EQ(second_result.ValueOrDie().get(), first.get());
+
+  auto get_section_data_result =
+      first->GetSectionData(absl::GetFlag(FLAGS_section_name));
+  EXPECT_THAT(get_section_data_result, IsOk());
+}
+
 // Tests that GetSectionData returns an appropriate error if the requested
 // section does not exist.
 TEST_F(ElfReaderTest, ReturnsAppropriateErrorIfSectionNotFound) {
@@ -26,10 +26,14 @@
 #include <unistd.h>
 #include <cstddef>
 #include <cstring>
+#include <memory>
+#include <utility>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_cat.h"
 #include "asylo/util/logging.h"
 #include "asylo/util/cleanup.h"
+#include "asylo/util/mutex_guarded.h"
 #include "asylo/util/posix_error_space.h"
 #include "asylo/util/status.h"
 #include "asylo/util/status_macros.h"
@@ -37,6 +41,11 @@
 namespace asylo {
 
 StatusOr<FileMapping> FileMapping::CreateFromFile(absl::string_view file_name) {
+  return CreateFromFile(file_name, Options());
+}
+
+StatusOr<FileMapping> FileMapping::CreateFromFile(absl::string_view file_name,
+                                                  const Options &options) {
   // Create a copy of |file_name| that is definitely null-terminated so that it
   // can be passed to open(). This copy can be re-used by moving it into the
   // final FileMapping object at the end of the function. This ensures that we
@@ -72,8 +81,11 @@ StatusOr<FileMapping> FileMapping::CreateFromFile(absl::string_view file_name) {
     file_size = static_cast<size_t>(file_stat.st_size);
 
     // Map the file into memory.
-    buffer_ptr =
-        mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    int flags = MAP_PRIVATE;
+    if (options.prefault) {
+      flags |= MAP_POPULATE;
+    }
+    buffer_ptr = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, flags, fd, 0);
     if (buffer_ptr == MAP_FAILED) {
       return Status(static_cast<error::PosixError>(errno),
                     absl::StrCat("Failed to mmap ", file_name));
@@ -82,11 +94,74 @@ StatusOr<FileMapping> FileMapping::CreateFromFile(absl::string_view file_name) {
 
   ASYLO_RETURN_IF_ERROR(close_status);
 
+  // Transparent huge pages are purely advisory, and kernels built without
+  // support for them reject MADV_HUGEPAGE, so failure here is not an error.
+  if (options.huge_pages) {
+    madvise(buffer_ptr, file_size, MADV_HUGEPAGE);
+  }
+
+  // Apply the requested access-pattern hints.
+  struct AccessHint {
+    bool requested;
+    int advice;
+    const char *name;
+  };
+  constexpr int kNumAccessHints = 2;
+  const AccessHint access_hints[kNumAccessHints] = {
+      {options.sequential, MADV_SEQUENTIAL, "MADV_SEQUENTIAL"},
+      {options.will_need, MADV_WILLNEED, "MADV_WILLNEED"},
+  };
+  for (const AccessHint &hint : access_hints) {
+    if (hint.requested && madvise(buffer_ptr, file_size, hint.advice) == -1) {
+      Status status(static_cast<error::PosixError>(errno),
+                    absl::StrCat("Failed to apply ", hint.name,
+                                 " to the mapping of ", file_name));
+      munmap(buffer_ptr, file_size);
+      return status;
+    }
+  }
+
   return FileMapping(
       std::move(file_name_string),
       absl::MakeSpan(reinterpret_cast<uint8_t *>(buffer_ptr), file_size));
 }
 
+StatusOr<std::shared_ptr<const FileMapping>> FileMapping::CreateCachedFromFile(
+    absl::string_view file_name) {
+  return CreateCachedFromFile(file_name, Options());
+}
+
+StatusOr<std::shared_ptr<const FileMapping>> FileMapping::CreateCachedFromFile(
+    absl::string_view file_name, const Options &options) {
+  using MappingCache =
+      absl::flat_hash_map<std::string, std::shared_ptr<const FileMapping>>;
+
+  // The registry is leaked so that cached mappings stay valid until process
+  // exit.
+  static MutexGuarded<MappingCache> *cache =
+      new MutexGuarded<MappingCache>(MappingCache());
+
+  {
+    auto view = cache->ReaderLock();
+    auto lookup = view->find(file_name);
+    if (lookup != view->end()) {
+      return lookup->second;
+    }
+  }
+
+  FileMapping mapping;
+  ASYLO_ASSIGN_OR_RETURN(mapping, CreateFromFile(file_name, options));
+
+  // Another thread may have mapped the same file while this one did. The
+  // first insertion wins; the losing mapping is unmapped when its shared_ptr
+  // is discarded.
+  auto view = cache->Lock();
+  return view
+      ->emplace(std::string(file_name),
+                std::make_shared<const FileMapping>(std::move(mapping)))
+      .first->second;
+}
+
 FileMapping::~FileMapping() {
   if (mapped_region_.data() &&
       munmap(mapped_region_.data(), mapped_region_.size()) == -1) {
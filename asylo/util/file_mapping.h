@@ -20,6 +20,8 @@
 #define ASYLO_UTIL_FILE_MAPPING_H_
 
 #include <cstdint>
+#include <memory>
+#include <string>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
@@ -33,10 +35,55 @@ namespace asylo {
 // of memory are not propagated to the backing file.
 class FileMapping {
  public:
+  // Options controlling how the file is mapped. The defaults reproduce a plain
+  // mmap(): pages are faulted in on first access with no access-pattern hints.
+  struct Options {
+    // If true, prefaults all pages of the mapping at creation time
+    // (MAP_POPULATE) instead of on first access. This avoids a fault storm
+    // when a large mapping is read immediately after creation, at the cost of
+    // blocking until the whole file is read.
+    bool prefault = false;
+
+    // If true, advises the kernel to back the mapping with transparent huge
+    // pages (MADV_HUGEPAGE). This is purely a hint: kernels built without
+    // transparent-huge-page support ignore it, and the mapping works either
+    // way.
+    bool huge_pages = false;
+
+    // If true, advises the kernel that the mapping will be read sequentially
+    // (MADV_SEQUENTIAL), enabling aggressive readahead.
+    bool sequential = false;
+
+    // If true, advises the kernel that the mapping will be needed soon
+    // (MADV_WILLNEED). Unlike |prefault|, this starts readahead without
+    // blocking until it completes.
+    bool will_need = false;
+  };
+
   // Returns a new FileMapping of |file_name| into memory, or a non-OK status if
   // the mapping workflow fails.
   static StatusOr<FileMapping> CreateFromFile(absl::string_view file_name);
 
+  // As above, but maps the file according to |options|.
+  static StatusOr<FileMapping> CreateFromFile(absl::string_view file_name,
+                                              const Options &options);
+
+  // Returns a mapping of |file_name| from a process-wide registry keyed by
+  // file name. The first call for a given name maps the file with |options|
+  // and caches the mapping; later calls return the cached mapping regardless
+  // of their |options|, so repeated opens of the same file fault its pages in
+  // at most once.
+  //
+  // Cached mappings are never discarded and all callers share one
+  // copy-on-write region, so callers must not write through buffer().
+  static StatusOr<std::shared_ptr<const FileMapping>> CreateCachedFromFile(
+      absl::string_view file_name);
+
+  // As above, but if |file_name| is not already cached, maps it according to
+  // |options|.
+  static StatusOr<std::shared_ptr<const FileMapping>> CreateCachedFromFile(
+      absl::string_view file_name, const Options &options);
+
   FileMapping() = default;
 
   FileMapping(const FileMapping &other) = delete;
@@ -80,6 +80,47 @@ TEST_F(FileMappingTest, MapsFileSuccessfully) {
             0);
 }
 
+// Tests that a file mapped with prefaulting, huge pages, and access-pattern
+// hints enabled still has the same size and contents as the backing file.
+TEST_F(FileMappingTest, MapsFileSuccessfullyWithAllOptions) {
+  FileMapping::Options options;
+  options.prefault = true;
+  options.huge_pages = true;
+  options.sequential = true;
+  options.will_need = true;
+
+  auto from_file_result =
+      FileMapping::CreateFromFile(absl::GetFlag(FLAGS_test_file), options);
+  ASSERT_THAT(from_file_result, IsOk());
+
+  FileMapping mapping = std::move(from_file_result.ValueOrDie());
+  EXPECT_EQ(mapping.buffer().size(), expected_file_contents_.size());
+  EXPECT_EQ(memcmp(mapping.buffer().data(), expected_file_contents_.data(),
+                   mapping.buffer().size()),
+            0);
+}
+
+// Tests that CreateCachedFromFile returns the same mapping for repeated opens
+// of the same file.
+TEST_F(FileMappingTest, CreateCachedFromFileReturnsSameMapping) {
+  auto first_result =
+      FileMapping::CreateCachedFromFile(absl::GetFlag(FLAGS_test_file));
+  ASSERT_THAT(first_result, IsOk());
+  std::shared_ptr<const FileMapping> first = first_result.ValueOrDie();
+
+  auto second_result =
+      FileMapping::CreateCachedFromFile(absl::GetFlag(FLAGS_test_file));
+  ASSERT_THAT(second_result, IsOk());
+  std::shared_ptr<const FileMapping> second = second_result.ValueOrDie();
+
+  EXPECT_EQ(second.get(), first.get());
+  EXPECT_EQ(second->buffer().data(), first->buffer().data());
+  EXPECT_EQ(first->buffer().size(), expected_file_contents_.size());
+  EXPECT_EQ(memcmp(first->buffer().data(), expected_file_contents_.data(),
+                   first->buffer().size()),
+            0);
+}
+
 // Tests that updates to a mapped file buffer do not propagate to the original
 // file, but are still visible in memory.
 TEST_F(FileMappingTest, MapExhibitsCopyOnWriteSemantics) {
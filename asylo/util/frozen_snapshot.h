@@ -0,0 +1,70 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_UTIL_FROZEN_SNAPSHOT_H_
+#define ASYLO_UTIL_FROZEN_SNAPSHOT_H_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace asylo {
+
+// Holder for state that is built, or rebuilt, rarely -- typically only during
+// initialization -- and read on hot paths. A writer prepares a fully
+// constructed object and publishes it atomically; readers obtain a
+// consistent, immutable snapshot with a single atomic load and no lock. A
+// reader holding a snapshot keeps it alive across a concurrent republish.
+template <typename T>
+class FrozenSnapshot {
+ public:
+  FrozenSnapshot() = default;
+  FrozenSnapshot(const FrozenSnapshot &) = delete;
+  FrozenSnapshot &operator=(const FrozenSnapshot &) = delete;
+
+  // Returns the most recently published snapshot, or nullptr if nothing has
+  // been published yet.
+  std::shared_ptr<const T> Get() const {
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+  }
+
+  // Atomically replaces the published snapshot with |snapshot|. The release
+  // ordering guarantees that a reader observing the new pointer also observes
+  // the object it points to as fully constructed.
+  void Publish(std::shared_ptr<const T> snapshot) {
+    std::atomic_store_explicit(&snapshot_, std::move(snapshot),
+                               std::memory_order_release);
+  }
+
+  // Publishes |snapshot| only if nothing has been published yet. Returns
+  // false without publishing if a snapshot is already present, making
+  // set-once initialization race-free.
+  bool PublishIfUnset(std::shared_ptr<const T> snapshot) {
+    std::shared_ptr<const T> expected;
+    return std::atomic_compare_exchange_strong_explicit(
+        &snapshot_, &expected, std::move(snapshot),
+        std::memory_order_acq_rel, std::memory_order_acquire);
+  }
+
+ private:
+  std::shared_ptr<const T> snapshot_;
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_UTIL_FROZEN_SNAPSHOT_H_
@@ -0,0 +1,59 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/util/frozen_snapshot.h"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace asylo {
+namespace {
+
+TEST(FrozenSnapshotTest, UnpublishedReturnsNull) {
+  FrozenSnapshot<int> snapshot;
+  EXPECT_EQ(snapshot.Get(), nullptr);
+}
+
+TEST(FrozenSnapshotTest, PublishThenGet) {
+  FrozenSnapshot<std::string> snapshot;
+  snapshot.Publish(std::make_shared<const std::string>("frozen"));
+  std::shared_ptr<const std::string> value = snapshot.Get();
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, "frozen");
+}
+
+TEST(FrozenSnapshotTest, PublishIfUnsetSucceedsOnlyOnce) {
+  FrozenSnapshot<int> snapshot;
+  EXPECT_TRUE(snapshot.PublishIfUnset(std::make_shared<const int>(1)));
+  EXPECT_FALSE(snapshot.PublishIfUnset(std::make_shared<const int>(2)));
+  EXPECT_EQ(*snapshot.Get(), 1);
+}
+
+TEST(FrozenSnapshotTest, ReaderSnapshotSurvivesRepublish) {
+  FrozenSnapshot<int> snapshot;
+  snapshot.Publish(std::make_shared<const int>(1));
+  std::shared_ptr<const int> old_value = snapshot.Get();
+  snapshot.Publish(std::make_shared<const int>(2));
+  EXPECT_EQ(*old_value, 1);
+  EXPECT_EQ(*snapshot.Get(), 2);
+}
+
+}  // namespace
+}  // namespace asylo
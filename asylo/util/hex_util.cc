@@ -20,12 +20,52 @@
 
 #include <endian.h>
 
+#include <cstdint>
+#include <cstring>
+
 #include "absl/strings/ascii.h"
-#include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
 
 namespace asylo {
 
+namespace {
+
+// The two lowercase hexadecimal digits of every byte value. One table lookup
+// copies both digits of a byte at once, and the encoders below size their
+// output up front, so encoding a buffer costs a single allocation and one
+// two-byte store per byte.
+constexpr char kByteToHex[] =
+    "000102030405060708090a0b0c0d0e0f"
+    "101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f"
+    "303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f"
+    "505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f"
+    "707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f"
+    "909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+    "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+    "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+    "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+// Appends the hex encoding of the |nbytes| bytes at |buf| to |out|, growing
+// it exactly once.
+void AppendHexEncoded(const void *buf, size_t nbytes, std::string *out) {
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(buf);
+  const size_t offset = out->size();
+  out->resize(offset + 2 * nbytes);
+  char *dest = &(*out)[offset];
+  for (size_t i = 0; i < nbytes; ++i) {
+    memcpy(dest + 2 * i, &kByteToHex[2 * bytes[i]], 2);
+  }
+}
+
+}  // namespace
+
 bool IsHexEncoded(absl::string_view str) {
   for (char c : str) {
     if (!absl::ascii_isxdigit(c)) {
@@ -37,8 +77,9 @@ bool IsHexEncoded(absl::string_view str) {
 
 std::string Uint16ToLittleEndianHexString(uint16_t val) {
   uint16_t le_val = htole16(val);
-  return absl::BytesToHexString(
-      absl::string_view{reinterpret_cast<char *>(&le_val), sizeof(uint16_t)});
+  std::string result;
+  AppendHexEncoded(&le_val, sizeof(le_val), &result);
+  return result;
 }
 
 std::string BufferToDebugHexString(const void *buf, int nbytes) {
@@ -51,10 +92,12 @@ std::string BufferToDebugHexString(const void *buf, int nbytes) {
   if (nbytes == 0) {
     return "[]";
   }
-  return absl::StrCat("[0x",
-                      absl::BytesToHexString(absl::string_view(
-                          reinterpret_cast<const char *>(buf), nbytes)),
-                      "]");
+  std::string result;
+  result.reserve(2 * static_cast<size_t>(nbytes) + 4);
+  result.append("[0x");
+  AppendHexEncoded(buf, nbytes, &result);
+  result.push_back(']');
+  return result;
 }
 
 }  // namespace asylo
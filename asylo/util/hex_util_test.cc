@@ -20,6 +20,10 @@
 
 #include <endian.h>
 
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -91,5 +95,20 @@ TEST(BufferToDebugHexString, NonemptyNullBuffer) {
               StrEq("[0x00000000]"));
 }
 
+TEST(BufferToDebugHexString, EncodesEveryByteValue) {
+  uint8_t buffer[256];
+  std::string expected = "[0x";
+  for (int i = 0; i < 256; ++i) {
+    buffer[i] = static_cast<uint8_t>(i);
+    char digits[3];
+    snprintf(digits, sizeof(digits), "%02x", i);
+    expected.append(digits);
+  }
+  expected.push_back(']');
+  EXPECT_THAT(BufferToDebugHexString(static_cast<const void*>(buffer),
+                                     sizeof(buffer)),
+              StrEq(expected));
+}
+
 }  // namespace
 }  // namespace asylo
@@ -63,6 +63,28 @@ class HttpFetcher {
   virtual StatusOr<HttpResponse> Get(
       absl::string_view url,
       const std::vector<HttpHeaderField> &custom_headers) = 0;
+
+  // Fetches each URL in |urls| with the custom header fields specified in
+  // |custom_headers| and returns one HttpResponse per URL, in the same order
+  // as |urls|. Returns a non-OK Status if any fetch fails. Thread safe.
+  // Synchronous.
+  //
+  // The default implementation fetches the URLs one at a time.
+  // Implementations may override it to fetch the URLs concurrently.
+  virtual StatusOr<std::vector<HttpResponse>> GetMany(
+      const std::vector<std::string> &urls,
+      const std::vector<HttpHeaderField> &custom_headers) {
+    std::vector<HttpResponse> responses;
+    responses.reserve(urls.size());
+    for (const std::string &url : urls) {
+      StatusOr<HttpResponse> response = Get(url, custom_headers);
+      if (!response.ok()) {
+        return response.status();
+      }
+      responses.push_back(std::move(response).ValueOrDie());
+    }
+    return responses;
+  }
 };
 
 }  // namespace asylo
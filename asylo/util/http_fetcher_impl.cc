@@ -19,6 +19,9 @@
 
 #include <cstddef>
 #include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/ascii.h"
@@ -30,6 +33,7 @@
 #include "asylo/util/status_macros.h"
 #include <curl/curl.h>
 #include <curl/easy.h>
+#include <curl/multi.h>
 #include "re2/re2.h"
 
 namespace asylo {
@@ -78,11 +82,20 @@ class CurlImpl : public Curl {
   Status Perform() override { return ToStatus(curl_easy_perform(curl_.get())); }
 
   void Reset() override {
-    curl_.reset(curl_easy_init());
+    if (curl_ == nullptr) {
+      curl_.reset(curl_easy_init());
+    } else {
+      // Reset the options of the existing handle rather than creating a new
+      // one so that the handle's connection cache survives and subsequent
+      // fetches can reuse established keep-alive connections.
+      curl_easy_reset(curl_.get());
+    }
     memset(err_msg_, 0, sizeof(err_msg_));
     ASYLO_CHECK_OK(SetOpt(CURLOPT_ERRORBUFFER, err_msg_));
   }
 
+  CURL *GetEasyHandle() override { return curl_.get(); }
+
   // Not copyable or movable.
   CurlImpl(const CurlImpl &) = delete;
   CurlImpl &operator=(const CurlImpl &) = delete;
@@ -110,6 +123,63 @@ void FreeCurlList(void *headers) {
   curl_slist_free_all(reinterpret_cast<curl_slist *>(headers));
 }
 
+using CurlHeaderList = std::unique_ptr<curl_slist, FunctionDeleter<FreeCurlList>>;
+
+// Smuggles a numeric option value through the void * parameter of
+// Curl::SetOpt. curl_easy_setopt reads a long for numeric options, which has
+// the same width as a pointer on the platforms Asylo supports.
+void *LongOpt(long value) { return reinterpret_cast<void *>(value); }
+
+// Configures |curl| to fetch |url| with |custom_headers|, writing the parsed
+// response into |response|. On success, |*headers| owns the header list
+// passed to libcurl, which must stay alive until the transfer has been
+// performed.
+Status ConfigureRequest(
+    Curl *curl, absl::string_view url,
+    const std::vector<HttpFetcher::HttpHeaderField> &custom_headers,
+    const std::string &ca_cert_filename, HttpFetcher::HttpResponse *response,
+    CurlHeaderList *headers) {
+  curl->Reset();
+  if (!ca_cert_filename.empty()) {
+    ASYLO_RETURN_IF_ERROR(curl->SetOpt(
+        CURLOPT_CAINFO, const_cast<char *>(ca_cert_filename.c_str())));
+  }
+  ASYLO_RETURN_IF_ERROR(curl->SetOpt(
+      CURLOPT_URL,
+      reinterpret_cast<void *>(const_cast<char *>(std::string(url).c_str()))));
+  // Keep the connection alive between fetches and let the server negotiate
+  // HTTP/2 so that concurrent transfers to the same host can be multiplexed
+  // over one connection.
+  ASYLO_RETURN_IF_ERROR(curl->SetOpt(CURLOPT_TCP_KEEPALIVE, LongOpt(1)));
+  ASYLO_RETURN_IF_ERROR(
+      curl->SetOpt(CURLOPT_HTTP_VERSION, LongOpt(CURL_HTTP_VERSION_2TLS)));
+  for (const auto &header : custom_headers) {
+    headers->reset(curl_slist_append(
+        headers->get(),
+        absl::StrFormat("%s: %s", header.first, header.second).c_str()));
+  }
+  ASYLO_RETURN_IF_ERROR(curl->SetOpt(CURLOPT_HTTPHEADER, headers->get()));
+  ASYLO_RETURN_IF_ERROR(curl->SetOpt(CURLOPT_WRITEFUNCTION,
+                                     reinterpret_cast<void *>(ReadToString)));
+  ASYLO_RETURN_IF_ERROR(curl->SetOpt(CURLOPT_WRITEDATA, &response->body));
+  ASYLO_RETURN_IF_ERROR(curl->SetOpt(CURLOPT_HEADERDATA, response));
+  ASYLO_RETURN_IF_ERROR(curl->SetOpt(
+      CURLOPT_HEADERFUNCTION, reinterpret_cast<void *>(ParseHttpHeader)));
+  return Status::OkStatus();
+}
+
+void CurlMultiCleanup(void *multi) {
+  curl_multi_cleanup(reinterpret_cast<CURLM *>(multi));
+}
+
+// Returns a Status based on a libcurl multi interface |error_code|.
+Status MultiToStatus(CURLMcode error_code) {
+  return Status(
+      absl::StatusCode::kInternal,
+      absl::StrFormat("Call to libcurl multi failed with error code %s",
+                      curl_multi_strerror(error_code)));
+}
+
 }  // namespace
 
 std::unique_ptr<Curl> CreateCurl() { return absl::make_unique<CurlImpl>(); }
@@ -146,30 +216,95 @@ size_t ParseHttpHeader(const char *buffer, size_t size, size_t nitems,
 StatusOr<HttpFetcher::HttpResponse> HttpFetcherImpl::Get(
     absl::string_view url,
     const std::vector<HttpFetcher::HttpHeaderField> &custom_headers) {
-  curl_->Reset();
-  if (!ca_cert_filename_.empty()) {
-    ASYLO_RETURN_IF_ERROR(curl_->SetOpt(
-        CURLOPT_CAINFO, const_cast<char *>(ca_cert_filename_.c_str())));
-  }
-  ASYLO_RETURN_IF_ERROR(curl_->SetOpt(
-      CURLOPT_URL,
-      reinterpret_cast<void *>(const_cast<char *>(std::string(url).c_str()))));
-  std::unique_ptr<curl_slist, FunctionDeleter<FreeCurlList>> headers;
-  for (const auto &header : custom_headers) {
-    headers.reset(curl_slist_append(
-        headers.get(),
-        absl::StrFormat("%s: %s", header.first, header.second).c_str()));
-  }
-  ASYLO_RETURN_IF_ERROR(curl_->SetOpt(CURLOPT_HTTPHEADER, headers.get()));
   HttpFetcher::HttpResponse result;
-  ASYLO_RETURN_IF_ERROR(curl_->SetOpt(CURLOPT_WRITEFUNCTION,
-                                      reinterpret_cast<void *>(ReadToString)));
-  ASYLO_RETURN_IF_ERROR(curl_->SetOpt(CURLOPT_WRITEDATA, &result.body));
-  ASYLO_RETURN_IF_ERROR(curl_->SetOpt(CURLOPT_HEADERDATA, &result));
-  ASYLO_RETURN_IF_ERROR(curl_->SetOpt(
-      CURLOPT_HEADERFUNCTION, reinterpret_cast<void *>(ParseHttpHeader)));
+  CurlHeaderList headers;
+  ASYLO_RETURN_IF_ERROR(ConfigureRequest(curl_.get(), url, custom_headers,
+                                         ca_cert_filename_, &result, &headers));
   ASYLO_RETURN_IF_ERROR(curl_->Perform());
   return result;
 }
 
+StatusOr<std::vector<HttpFetcher::HttpResponse>> HttpFetcherImpl::GetMany(
+    const std::vector<std::string> &urls,
+    const std::vector<HttpFetcher::HttpHeaderField> &custom_headers) {
+  std::vector<HttpFetcher::HttpResponse> responses(urls.size());
+  if (urls.empty()) {
+    return responses;
+  }
+
+  // Configure one transfer per URL. Each transfer gets its own Curl object so
+  // that the transfers can run concurrently.
+  std::vector<std::unique_ptr<Curl>> transfers;
+  std::vector<CurlHeaderList> header_lists(urls.size());
+  bool multiplexable = true;
+  for (size_t i = 0; i < urls.size(); ++i) {
+    transfers.push_back(curl_factory_());
+    ASYLO_RETURN_IF_ERROR(ConfigureRequest(transfers[i].get(), urls[i],
+                                           custom_headers, ca_cert_filename_,
+                                           &responses[i], &header_lists[i]));
+    multiplexable &= transfers[i]->GetEasyHandle() != nullptr;
+  }
+
+  if (!multiplexable) {
+    // At least one transfer is not backed by libcurl (e.g. a test fake), so
+    // the multi API cannot drive it. Perform the transfers one at a time.
+    for (auto &transfer : transfers) {
+      ASYLO_RETURN_IF_ERROR(transfer->Perform());
+    }
+    return responses;
+  }
+
+  // Drive all transfers through a multi handle, which multiplexes transfers
+  // to the same host over one HTTP/2 connection when the server supports it.
+  std::unique_ptr<CURLM, FunctionDeleter<CurlMultiCleanup>> multi(
+      curl_multi_init());
+  if (multi == nullptr) {
+    return Status(absl::StatusCode::kInternal, "curl_multi_init failed");
+  }
+  curl_multi_setopt(multi.get(), CURLMOPT_PIPELINING, CURL_PIPE_MULTIPLEX);
+
+  size_t added = 0;
+  Cleanup remove_handles([&multi, &transfers, &added] {
+    for (size_t i = 0; i < added; ++i) {
+      curl_multi_remove_handle(multi.get(), transfers[i]->GetEasyHandle());
+    }
+  });
+  for (; added < transfers.size(); ++added) {
+    CURLMcode error_code =
+        curl_multi_add_handle(multi.get(), transfers[added]->GetEasyHandle());
+    if (error_code != CURLM_OK) {
+      return MultiToStatus(error_code);
+    }
+  }
+
+  int still_running = 0;
+  do {
+    CURLMcode error_code = curl_multi_perform(multi.get(), &still_running);
+    if (error_code != CURLM_OK) {
+      return MultiToStatus(error_code);
+    }
+    if (still_running > 0) {
+      error_code = curl_multi_wait(multi.get(), /*extra_fds=*/nullptr,
+                                   /*extra_nfds=*/0, /*timeout_ms=*/1000,
+                                   /*ret=*/nullptr);
+      if (error_code != CURLM_OK) {
+        return MultiToStatus(error_code);
+      }
+    }
+  } while (still_running > 0);
+
+  // Surface the first transfer-level failure, if any.
+  int msgs_in_queue = 0;
+  while (CURLMsg *message =
+             curl_multi_info_read(multi.get(), &msgs_in_queue)) {
+    if (message->msg == CURLMSG_DONE && message->data.result != CURLE_OK) {
+      return Status(
+          absl::StatusCode::kInternal,
+          absl::StrFormat("Call to libcurl failed with error code %s",
+                          curl_easy_strerror(message->data.result)));
+    }
+  }
+  return responses;
+}
+
 }  // namespace asylo
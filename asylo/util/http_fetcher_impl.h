@@ -18,7 +18,9 @@
 #ifndef ASYLO_UTIL_HTTP_FETCHER_IMPL_H_
 #define ASYLO_UTIL_HTTP_FETCHER_IMPL_H_
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "absl/strings/str_format.h"
@@ -43,6 +45,11 @@ class Curl {
   // Resets the Curl object before each use. Wraps libcurl's curl_easy_init
   // call.
   virtual void Reset() = 0;
+
+  // Returns the underlying libcurl easy handle, or nullptr if this Curl
+  // object is not backed by libcurl. Used to drive several transfers
+  // concurrently through libcurl's multi API.
+  virtual CURL *GetEasyHandle() { return nullptr; }
 };
 
 // Creates an instance of Curl implementation.
@@ -66,15 +73,34 @@ class HttpFetcherImpl : public HttpFetcher {
 
   explicit HttpFetcherImpl(std::unique_ptr<Curl> curl,
                            absl::string_view ca_cert_filename)
-      : curl_(std::move(curl)), ca_cert_filename_(ca_cert_filename) {}
+      : curl_(std::move(curl)),
+        curl_factory_(CreateCurl),
+        ca_cert_filename_(ca_cert_filename) {}
+
+  // Constructs an HttpFetcherImpl object that uses |curl_factory| to create
+  // the Curl object behind each transfer. Used by tests.
+  HttpFetcherImpl(std::function<std::unique_ptr<Curl>()> curl_factory,
+                  absl::string_view ca_cert_filename)
+      : curl_(curl_factory()),
+        curl_factory_(std::move(curl_factory)),
+        ca_cert_filename_(ca_cert_filename) {}
+
   ~HttpFetcherImpl() override {}
 
   StatusOr<HttpFetcher::HttpResponse> Get(
       absl::string_view url,
       const std::vector<HttpFetcher::HttpHeaderField> &custom_headers) override;
 
+  // Fetches all of |urls| concurrently. The transfers share one multiplexed
+  // HTTP/2 connection when the server supports it, so fetching many URLs from
+  // the same host does not pay one round trip per URL.
+  StatusOr<std::vector<HttpFetcher::HttpResponse>> GetMany(
+      const std::vector<std::string> &urls,
+      const std::vector<HttpFetcher::HttpHeaderField> &custom_headers) override;
+
  private:
   std::unique_ptr<Curl> curl_;
+  std::function<std::unique_ptr<Curl>()> curl_factory_;
   std::string ca_cert_filename_;
 };
 
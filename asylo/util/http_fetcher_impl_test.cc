@@ -17,6 +17,7 @@
  */
 #include "asylo/util/http_fetcher_impl.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -136,6 +137,8 @@ Status FakeCurl::SetOpt(CURLoption option, void *value) {
       write_data_ = value;
       break;
     case CURLOPT_HTTPHEADER:
+    case CURLOPT_TCP_KEEPALIVE:
+    case CURLOPT_HTTP_VERSION:
       break;
     case CURLOPT_URL:
       last_url_ = static_cast<char *>(value);
@@ -279,6 +282,68 @@ TEST(HttpFetcherImplTest, Perform_Failure) {
   EXPECT_THAT(fetcher.Get(kUrl, {}), StatusIs(absl::StatusCode::kInternal));
 }
 
+TEST(HttpFetcherImplTest, GetManyWithNoUrlsReturnsNoResponses) {
+  constexpr char kRawResponse[] =
+      "HTTP/1.1 200 OK\r\n"
+      "\r\n"
+      "lorem ipsum dolor sit\r\n";
+  std::unique_ptr<FakeCurl> curl;
+  ASYLO_ASSERT_OK_AND_ASSIGN(curl, FakeCurl::Create(kRawResponse));
+  HttpFetcherImpl fetcher(std::move(curl), /*ca_cert_filename=*/"");
+  std::vector<HttpFetcher::HttpResponse> responses;
+  ASYLO_ASSERT_OK_AND_ASSIGN(responses, fetcher.GetMany({}, {}));
+  EXPECT_THAT(responses.size(), Eq(0));
+}
+
+TEST(HttpFetcherImplTest, GetManyFetchesAllUrlsInOrder) {
+  // The first fake backs the fetcher's own Curl object, which GetMany does
+  // not use.
+  auto raw_responses = std::make_shared<std::vector<std::string>>(
+      std::vector<std::string>{"HTTP/1.1 200 OK\r\n\r\nunused\r\n",
+                               "HTTP/1.1 200 OK\r\n\r\nfirst\r\n",
+                               "HTTP/1.1 200 OK\r\n\r\nsecond\r\n"});
+  auto next_response = std::make_shared<size_t>(0);
+  HttpFetcherImpl fetcher(
+      [raw_responses, next_response]() -> std::unique_ptr<Curl> {
+        return FakeCurl::Create((*raw_responses)[(*next_response)++])
+            .ValueOrDie();
+      },
+      /*ca_cert_filename=*/"");
+
+  std::vector<HttpFetcher::HttpResponse> responses;
+  ASYLO_ASSERT_OK_AND_ASSIGN(
+      responses,
+      fetcher.GetMany({"http://first.url", "http://second.url"}, {}));
+  ASSERT_THAT(responses.size(), Eq(2));
+  EXPECT_THAT(responses[0].status_code, Eq(200));
+  EXPECT_THAT(responses[0].body, Eq("first\r\n"));
+  EXPECT_THAT(responses[1].status_code, Eq(200));
+  EXPECT_THAT(responses[1].body, Eq("second\r\n"));
+}
+
+TEST(HttpFetcherImplTest, GetManyPropagatesTransferFailure) {
+  auto num_created = std::make_shared<size_t>(0);
+  HttpFetcherImpl fetcher(
+      [num_created]() -> std::unique_ptr<Curl> {
+        constexpr char kRawResponse[] =
+            "HTTP/1.1 200 OK\r\n"
+            "\r\n"
+            "lorem ipsum dolor sit\r\n";
+        std::unique_ptr<FakeCurl> curl =
+            FakeCurl::Create(kRawResponse).ValueOrDie();
+        // Fail the second transfer configured by GetMany. The first object
+        // created backs the fetcher's own Curl object.
+        if (++(*num_created) == 3) {
+          curl->set_perform_failure();
+        }
+        return curl;
+      },
+      /*ca_cert_filename=*/"");
+  EXPECT_THAT(fetcher.GetMany({"http://first.url", "http://second.url"}, {})
+                  .status(),
+              StatusIs(absl::StatusCode::kInternal));
+}
+
 class HttpFetcherImplSetOptErrorTest
     : public ::testing::Test,
       public ::testing::WithParamInterface<CURLoption> {};
@@ -25,12 +25,18 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <sstream>
 #include <string>
+#include <thread>
+
+#include "asylo/platform/common/mpsc_ring_buffer.h"
 
 namespace asylo {
 
@@ -89,6 +95,84 @@ const std::string get_log_basename() {
   return *log_basename;
 }
 
+// Capacity, in bytes, of the text of one buffered log record. Longer records
+// are truncated. Sized to cover typical log lines while keeping a slot small.
+constexpr size_t kBufferedLogTextCapacity = 508;
+
+// One formatted log record awaiting the next batch write.
+struct BufferedLogRecord {
+  uint32_t size;                        // Bytes of text used.
+  char text[kBufferedLogTextCapacity];  // Formatted message, unterminated.
+};
+
+// Number of slots in the log buffer. Must be a power of two.
+constexpr size_t kBufferedLogSlots = 128;
+
+// Buffered record count at which the logging thread writes out a batch.
+constexpr size_t kLogFlushBatchSize = 32;
+
+// Whether records below ERROR severity are buffered rather than written
+// immediately, and whether a full buffer blocks or drops, as configured by
+// set_log_buffering().
+std::atomic<bool> log_buffering_enabled{false};
+std::atomic<bool> log_block_when_full{false};
+
+// Count of records dropped because the buffer was full, reported with the
+// next batch.
+std::atomic<uint64_t> dropped_log_records{0};
+
+// Buffer of formatted records awaiting a batch write. Allocated when
+// buffering is first enabled and intentionally leaked, like the other logging
+// globals.
+MpscRingBuffer<BufferedLogRecord, kBufferedLogSlots> *log_buffer = nullptr;
+
+// Serializes batch writes while letting other threads continue logging.
+std::atomic_flag log_flusher_busy = ATOMIC_FLAG_INIT;
+
+// Appends |text| to the log file, complaining to stderr on failure.
+void WriteTextToLogFile(const std::string &text) {
+  std::string log_path = get_log_directory() + get_log_basename();
+
+  FILE *file = fopen(log_path.c_str(), "ab");
+  if (file) {
+    if (fprintf(file, "%s", text.c_str()) <= 0) {
+      fprintf(stderr, "Failed to write to log file : %s!\n", log_path.c_str());
+    }
+    fclose(file);
+  } else {
+    fprintf(stderr, "Failed to open log file : %s!\n", log_path.c_str());
+  }
+}
+
+// Appends |message_text| to the log buffer if buffered logging is enabled,
+// returning false if the record must be written synchronously instead. A full
+// buffer either drops the record or makes this thread write out a batch,
+// according to the configured policy.
+bool TryBufferLogRecord(const std::string &message_text) {
+  if (!log_buffering_enabled.load(std::memory_order_relaxed) ||
+      log_buffer == nullptr) {
+    return false;
+  }
+  BufferedLogRecord record;
+  record.size = static_cast<uint32_t>(
+      std::min(message_text.size(), kBufferedLogTextCapacity));
+  memcpy(record.text, message_text.data(), record.size);
+  while (!log_buffer->TryPush(record)) {
+    if (!log_block_when_full.load(std::memory_order_relaxed)) {
+      dropped_log_records.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    // The record must not be dropped: drain a batch on this thread, or yield
+    // to the thread already doing so.
+    FlushLogBuffer();
+    std::this_thread::yield();
+  }
+  if (log_buffer->size() >= kLogFlushBatchSize) {
+    FlushLogBuffer();
+  }
+  return true;
+}
+
 }  // namespace
 
 bool set_log_directory(const std::string &log_directory) {
@@ -118,6 +202,50 @@ void set_vlog_level(int level) { vlog_level = level; }
 
 int get_vlog_level() { return vlog_level; }
 
+void set_log_buffering(bool enabled, bool block_when_full) {
+  if (enabled && log_buffer == nullptr) {
+    log_buffer = new MpscRingBuffer<BufferedLogRecord, kBufferedLogSlots>();
+  }
+  log_block_when_full.store(block_when_full, std::memory_order_relaxed);
+  log_buffering_enabled.store(enabled, std::memory_order_relaxed);
+  if (!enabled) {
+    FlushLogBuffer();
+  }
+}
+
+void FlushLogBuffer() {
+  if (log_buffer == nullptr) {
+    return;
+  }
+  if (log_flusher_busy.test_and_set(std::memory_order_acquire)) {
+    // Another thread is already writing a batch; it picks up these records.
+    return;
+  }
+  std::string batch;
+  BufferedLogRecord record;
+  while (log_buffer->TryPop(&record)) {
+    batch.append(record.text,
+                 std::min<size_t>(record.size, kBufferedLogTextCapacity));
+    if (batch.empty() || batch.back() != '\n') {
+      batch.push_back('\n');
+    }
+  }
+  const uint64_t dropped =
+      dropped_log_records.exchange(0, std::memory_order_relaxed);
+  if (dropped > 0) {
+    batch.append("Dropped " + std::to_string(dropped) +
+                 " buffered log records\n");
+  }
+  if (!batch.empty()) {
+    // The whole batch is written with a single file append (and, inside an
+    // enclave, a single boundary crossing) instead of one per record.
+    WriteTextToLogFile(batch);
+    printf("%s", batch.c_str());
+    fflush(stdout);
+  }
+  log_flusher_busy.clear(std::memory_order_release);
+}
+
 bool EnsureDirectory(const char *path) {
   struct stat dirStat;
   if (stat(path, &dirStat)) {
@@ -217,21 +345,18 @@ LogMessageFatal::~LogMessageFatal() {
 }
 
 void LogMessage::SendToLog(const std::string &message_text) {
-  std::string log_path = get_log_directory() + get_log_basename();
+  if (severity_ < ERROR && TryBufferLogRecord(message_text)) {
+    return;
+  }
 
-  FILE *file = fopen(log_path.c_str(), "ab");
-  if (file) {
-    if (fprintf(file, "%s", message_text.c_str()) > 0) {
-      if (message_text.back() != '\n') {
-        fprintf(file, "\n");
-      }
-    } else {
-      fprintf(stderr, "Failed to write to log file : %s!\n", log_path.c_str());
-    }
-    fclose(file);
-  } else {
-    fprintf(stderr, "Failed to open log file : %s!\n", log_path.c_str());
+  // Synchronously written records must not overtake buffered ones.
+  FlushLogBuffer();
+
+  std::string text = message_text;
+  if (text.empty() || text.back() != '\n') {
+    text.push_back('\n');
   }
+  WriteTextToLogFile(text);
   if (severity_ >= ERROR) {
     fprintf(stderr, "%s\n", message_text.c_str());
     fflush(stderr);
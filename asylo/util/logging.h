@@ -294,6 +294,25 @@ void set_vlog_level(int level);
 /// \return The current verbosity threshold for VLOG.
 int get_vlog_level();
 
+/// Enables or disables buffered logging.
+///
+/// When enabled, formatted records below `ERROR` severity are appended to an
+/// in-memory buffer and written out in batches, instead of each record being
+/// written (and, inside an enclave, crossing the enclave boundary) on its
+/// own. A batch is written once enough records accumulate, when a record of
+/// `ERROR` or higher severity is logged, or on `FlushLogBuffer()`.
+///
+/// \param enabled Whether to buffer records below `ERROR` severity.
+/// \param block_when_full Whether a logging thread finding the buffer full
+///        should write out a batch itself rather than drop the record. When
+///        records are dropped, a count of dropped records is reported with
+///        the next batch.
+void set_log_buffering(bool enabled, bool block_when_full);
+
+/// Writes out any buffered log records immediately. Call before the process
+/// or enclave exits if buffered logging is enabled.
+void FlushLogBuffer();
+
 /// Sets the log directory, as specified when this enclave is initialized. This
 /// is only set once. Any request to reset it will return false.
 ///
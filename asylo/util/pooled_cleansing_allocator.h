@@ -0,0 +1,214 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_UTIL_POOLED_CLEANSING_ALLOCATOR_H_
+#define ASYLO_UTIL_POOLED_CLEANSING_ALLOCATOR_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace asylo {
+namespace internal {
+
+// Zeroes |size| bytes at |ptr|. The wipe is a plain memset, which the
+// compiler is free to widen into vectorized stores, followed by a compiler
+// barrier that keeps the stores from being elided on the grounds that the
+// buffer is about to be freed or recycled.
+inline void CleanseMemory(void *ptr, size_t size) {
+  memset(ptr, 0, size);
+  __asm__ __volatile__("" : : "r"(ptr) : "memory");
+}
+
+// A thread-local pool of cleansed buffers, bucketed by power-of-two size
+// class. Buffers handed to Deallocate() must already be cleansed; the pool
+// therefore only ever holds zeroed memory, and recycling a buffer costs a
+// free-list pop instead of a trip through the heap allocator. Each thread
+// owns an independent pool, so no locking is required; buffers cached by an
+// exiting thread are released back to the heap.
+class CleansingBufferPool {
+ public:
+  // Smallest and largest pooled size classes, as powers of two. Requests
+  // outside this range go straight to the heap.
+  static constexpr size_t kMinSizeClassShift = 5;   // 32 bytes
+  static constexpr size_t kMaxSizeClassShift = 12;  // 4096 bytes
+  static constexpr size_t kNumSizeClasses =
+      kMaxSizeClassShift - kMinSizeClassShift + 1;
+
+  // Maximum number of cached buffers per size class per thread. Key and
+  // secret handling rarely has more than a handful of live buffers of one
+  // size, so a small cap bounds the memory held by idle threads.
+  static constexpr size_t kMaxCachedPerClass = 8;
+
+  // Returns a buffer of at least |size| bytes, reusing a pooled buffer when
+  // one is available.
+  static void *Allocate(size_t size) {
+    int size_class = SizeClass(size);
+    if (size_class >= 0) {
+      std::vector<void *> &free_list = Pool()[size_class];
+      if (!free_list.empty()) {
+        void *ptr = free_list.back();
+        free_list.pop_back();
+        return ptr;
+      }
+      // Allocate the full size class so that the buffer is reusable by any
+      // later request that maps to the same class.
+      return ::operator new(ClassSize(size_class));
+    }
+    return ::operator new(size);
+  }
+
+  // Returns the |size|-byte buffer at |ptr| to the pool, or to the heap if
+  // the buffer is not pooled or its size class is full. |ptr| must already
+  // have been cleansed by the caller.
+  static void Deallocate(void *ptr, size_t size) {
+    int size_class = SizeClass(size);
+    if (size_class >= 0) {
+      std::vector<void *> &free_list = Pool()[size_class];
+      if (free_list.size() < kMaxCachedPerClass) {
+        free_list.push_back(ptr);
+        return;
+      }
+    }
+    ::operator delete(ptr);
+  }
+
+ private:
+  // The per-thread free lists. Wrapped in a class so that the destructor
+  // releases cached buffers when the owning thread exits.
+  class FreeLists {
+   public:
+    ~FreeLists() {
+      for (std::vector<void *> &free_list : free_lists_) {
+        for (void *ptr : free_list) {
+          ::operator delete(ptr);
+        }
+      }
+    }
+
+    std::vector<void *> &operator[](int size_class) {
+      return free_lists_[size_class];
+    }
+
+   private:
+    std::array<std::vector<void *>, kNumSizeClasses> free_lists_;
+  };
+
+  static FreeLists &Pool() {
+    thread_local FreeLists pool;
+    return pool;
+  }
+
+  // Returns the index of the smallest size class that holds |size| bytes, or
+  // -1 if |size| is not pooled.
+  static int SizeClass(size_t size) {
+    for (size_t shift = kMinSizeClassShift; shift <= kMaxSizeClassShift;
+         ++shift) {
+      if (size <= (static_cast<size_t>(1) << shift)) {
+        return static_cast<int>(shift - kMinSizeClassShift);
+      }
+    }
+    return -1;
+  }
+
+  static size_t ClassSize(int size_class) {
+    return static_cast<size_t>(1) << (size_class + kMinSizeClassShift);
+  }
+};
+
+}  // namespace internal
+
+/// PooledCleansingAllocator is a C++11
+/// [allocator](http://en.cppreference.com/w/cpp/concept/Allocator) that, like
+/// `CleansingAllocator`, guarantees memory cleansing before releasing memory.
+/// Unlike `CleansingAllocator`, released buffers are recycled through a
+/// per-thread pool bucketed by size class, so code that repeatedly allocates
+/// and frees secrets of similar sizes — key handling, handshake transcripts —
+/// avoids a round trip through the heap allocator on every operation. The
+/// wipe itself uses plain vectorizable stores behind a compiler barrier
+/// rather than a byte-at-a-time loop.
+///
+/// Memory is always cleansed before it enters the pool, so pooled buffers
+/// never carry stale secrets, and buffers evicted from the pool are returned
+/// to the heap already zeroed.
+template <typename T>
+class PooledCleansingAllocator {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+
+  // reference and const_reference are non-standard extensions that are used
+  // by some containers in the standard library.
+  using reference = T &;
+  using const_reference = const T &;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  PooledCleansingAllocator() = default;
+  template <typename U>
+  PooledCleansingAllocator(const PooledCleansingAllocator<U> &) {}
+  ~PooledCleansingAllocator() = default;
+
+  template <typename U>
+  struct rebind {
+    using other = PooledCleansingAllocator<U>;
+  };
+
+  pointer allocate(size_type n) {
+    return static_cast<pointer>(
+        internal::CleansingBufferPool::Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(pointer ptr, size_type n) {
+    internal::CleanseMemory(ptr, n * sizeof(T));
+    internal::CleansingBufferPool::Deallocate(ptr, n * sizeof(T));
+  }
+
+  std::size_t max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+  }
+
+  void construct(T *ptr, const T &t) { new (ptr) T(t); }
+  void destroy(T *ptr) { ptr->~T(); }
+};
+
+// All PooledCleansingAllocator instances are interchangeable: memory
+// allocated through one can be deallocated through any other.
+template <typename T, typename U>
+bool operator==(const PooledCleansingAllocator<T> &,
+                const PooledCleansingAllocator<U> &) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PooledCleansingAllocator<T> &lhs,
+                const PooledCleansingAllocator<U> &rhs) {
+  return !(lhs == rhs);
+}
+
+}  // namespace asylo
+
+#endif  // ASYLO_UTIL_POOLED_CLEANSING_ALLOCATOR_H_
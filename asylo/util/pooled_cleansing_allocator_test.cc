@@ -0,0 +1,113 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/util/pooled_cleansing_allocator.h"
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "asylo/crypto/util/bytes.h"
+#include "asylo/crypto/util/trivial_object_util.h"
+
+namespace asylo {
+namespace {
+
+const size_t kNumIterations = 1000;
+
+// A typed test fixture is used for tests that require a single type object.
+template <typename T>
+class TypedPooledCleansingAllocatorTest : public ::testing::Test {};
+
+// Test the allocator with objects of varying types/sizes. The sizes straddle
+// the smallest and largest pooled size classes.
+typedef ::testing::Types<SafeBytes<8>, UnsafeBytes<15>, SafeBytes<235>,
+                         UnsafeBytes<519>, UnsafeBytes<8192>, uint8_t,
+                         uint64_t>
+    MyTypes;
+TYPED_TEST_SUITE(TypedPooledCleansingAllocatorTest, MyTypes);
+
+// Verify that a freed buffer is cleansed before it is recycled: a fresh
+// allocation mapping to the same size class must hand back zeroed memory.
+// This guarantee only applies to pooled sizes; larger buffers go straight to
+// the heap, which makes no zeroing promise for fresh allocations.
+TYPED_TEST(TypedPooledCleansingAllocatorTest, RecycledBuffersAreCleansed) {
+  if (sizeof(TypeParam) >
+      (static_cast<size_t>(1)
+       << internal::CleansingBufferPool::kMaxSizeClassShift)) {
+    GTEST_SKIP() << "Type is larger than the largest pooled size class.";
+  }
+
+  PooledCleansingAllocator<TypeParam> allocator;
+
+  for (size_t i = 0; i < kNumIterations; ++i) {
+    TypeParam *buffer = allocator.allocate(1);
+    memset(buffer, 0xff, sizeof(TypeParam));
+    allocator.deallocate(buffer, 1);
+
+    TypeParam *recycled = allocator.allocate(1);
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(recycled);
+    for (size_t j = 0; j < sizeof(TypeParam); ++j) {
+      ASSERT_EQ(bytes[j], 0) << "i = " << i << ", j = " << j;
+    }
+    allocator.deallocate(recycled, 1);
+  }
+}
+
+// Verify that a buffer freed and reallocated within the same size class is
+// actually recycled rather than fetched from the heap.
+TEST(PooledCleansingAllocatorTest, SameSizeClassReusesBuffer) {
+  PooledCleansingAllocator<uint8_t> allocator;
+
+  uint8_t *first = allocator.allocate(64);
+  allocator.deallocate(first, 64);
+  uint8_t *second = allocator.allocate(64);
+  EXPECT_EQ(second, first);
+  allocator.deallocate(second, 64);
+
+  // A request for a different byte count in the same power-of-two class also
+  // reuses the buffer.
+  uint8_t *third = allocator.allocate(50);
+  EXPECT_EQ(third, first);
+  allocator.deallocate(third, 50);
+}
+
+// Verify standard-container usage with vectors that grow through several size
+// classes.
+TYPED_TEST(TypedPooledCleansingAllocatorTest, VectorTest) {
+  std::vector<TypeParam, PooledCleansingAllocator<TypeParam>> v;
+  for (size_t i = 0; i < kNumIterations; ++i) {
+    v.push_back(TrivialRandomObject<TypeParam>());
+  }
+}
+
+// std::list utilizes the rebind functionality of the allocator, and
+// consequently, in addition to testing the allocator with std::vector,
+// it is also tested with std::list.
+TYPED_TEST(TypedPooledCleansingAllocatorTest, ListTest) {
+  std::list<TypeParam, PooledCleansingAllocator<TypeParam>> l;
+  for (size_t i = 0; i < kNumIterations; ++i) {
+    l.push_back(TrivialRandomObject<TypeParam>());
+  }
+}
+
+}  // namespace
+}  // namespace asylo
@@ -19,8 +19,7 @@
 #ifndef ASYLO_UTIL_PROTO_PARSE_UTIL_H_
 #define ASYLO_UTIL_PROTO_PARSE_UTIL_H_
 
-#include <string>
-
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <google/protobuf/text_format.h>
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
@@ -35,7 +34,11 @@ namespace asylo {
 template <typename T>
 StatusOr<T> ParseTextProto(absl::string_view text) {
   T proto;
-  if (!google::protobuf::TextFormat::ParseFromString(std::string{text}, &proto)) {
+  // Parse straight out of |text|. Copying it into a std::string first would
+  // duplicate every embedded config on each load.
+  google::protobuf::io::ArrayInputStream input(text.data(),
+                                     static_cast<int>(text.size()));
+  if (!google::protobuf::TextFormat::Parse(&input, &proto)) {
     return absl::InvalidArgumentError("Invalid textproto input");
   }
   return proto;
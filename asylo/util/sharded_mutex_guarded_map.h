@@ -0,0 +1,161 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ASYLO_UTIL_SHARDED_MUTEX_GUARDED_MAP_H_
+#define ASYLO_UTIL_SHARDED_MUTEX_GUARDED_MAP_H_
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/types/optional.h"
+#include "asylo/util/mutex_guarded.h"
+
+namespace asylo {
+
+// ShardedMutexGuardedMap<K, V> is a map from K to V partitioned into
+// kNumShards independently locked sub-maps selected by key hash. It keeps the
+// MutexGuarded<T> discipline — the contained maps are only reachable through
+// RAII lock views — while letting operations on keys that hash to different
+// shards proceed in parallel, so read-mostly registries scale instead of
+// serializing every lookup on one mutex.
+//
+// Single-key operations (Find(), InsertOrAssign(), Erase(), ...) lock only
+// the shard owning the key. Whole-map operations (Size(), ForEach(), Clear())
+// visit shards one at a time and therefore observe each shard atomically but
+// the map as a whole only approximately; there is deliberately no way to lock
+// all shards at once, which keeps the locking order trivial and
+// deadlock-free.
+//
+// For multi-step operations on a single key, LockShard() and
+// ReaderLockShard() expose the owning shard's map through the usual
+// LockView/ReaderLockView objects:
+//
+//     ShardedMutexGuardedMap<std::string, Config> configs;
+//     {
+//       auto shard = configs.LockShard(name);
+//       auto it = shard->find(name);
+//       if (it != shard->end()) {
+//         it->second.mark_used();
+//       }
+//     }
+//
+// V must be copy-constructible for Find(), which returns the value by copy so
+// that no reference outlives the shard lock.
+template <typename K, typename V, size_t kNumShards = 16,
+          typename Hash = absl::Hash<K>>
+class ShardedMutexGuardedMap {
+  static_assert(kNumShards != 0 && (kNumShards & (kNumShards - 1)) == 0,
+                "kNumShards must be a power of two");
+
+ public:
+  using MapType = absl::flat_hash_map<K, V>;
+
+  ShardedMutexGuardedMap() = default;
+
+  ShardedMutexGuardedMap(const ShardedMutexGuardedMap &other) = delete;
+  ShardedMutexGuardedMap &operator=(const ShardedMutexGuardedMap &other) =
+      delete;
+
+  // Returns a writeable RAII lock view of the shard owning |key|.
+  LockView<MapType> LockShard(const K &key) {
+    return shards_[ShardIndex(key)].Lock();
+  }
+
+  // Returns a read-only RAII lock view of the shard owning |key|.
+  ReaderLockView<MapType> ReaderLockShard(const K &key) const {
+    return shards_[ShardIndex(key)].ReaderLock();
+  }
+
+  // Returns a copy of the value mapped to |key|, or absl::nullopt if |key| is
+  // not present. Takes a reader lock on one shard.
+  absl::optional<V> Find(const K &key) const {
+    auto shard = ReaderLockShard(key);
+    auto it = shard->find(key);
+    if (it == shard->end()) {
+      return absl::nullopt;
+    }
+    return it->second;
+  }
+
+  // Returns true if |key| is present. Takes a reader lock on one shard.
+  bool Contains(const K &key) const {
+    auto shard = ReaderLockShard(key);
+    return shard->find(key) != shard->end();
+  }
+
+  // Inserts |value| under |key| if |key| is not already present. Returns true
+  // if the insertion took place.
+  bool Insert(K key, V value) {
+    return LockShard(key)
+        ->emplace(std::move(key), std::move(value))
+        .second;
+  }
+
+  // Inserts |value| under |key|, overwriting any existing value.
+  void InsertOrAssign(K key, V value) {
+    auto shard = LockShard(key);
+    (*shard)[std::move(key)] = std::move(value);
+  }
+
+  // Removes |key| if present. Returns true if an element was removed.
+  bool Erase(const K &key) { return LockShard(key)->erase(key) != 0; }
+
+  // Returns the total number of elements. Shards are counted one at a time,
+  // so the result is exact only if the map is not concurrently modified.
+  size_t Size() const {
+    size_t size = 0;
+    for (const MutexGuarded<MapType> &shard : shards_) {
+      size += shard.ReaderLock()->size();
+    }
+    return size;
+  }
+
+  // Invokes |func| on every element under a reader lock, one shard at a time.
+  // |func| must not re-enter this map.
+  void ForEach(const std::function<void(const K &, const V &)> &func) const {
+    for (const MutexGuarded<MapType> &shard : shards_) {
+      auto view = shard.ReaderLock();
+      for (const auto &entry : *view) {
+        func(entry.first, entry.second);
+      }
+    }
+  }
+
+  // Removes all elements, one shard at a time.
+  void Clear() {
+    for (MutexGuarded<MapType> &shard : shards_) {
+      shard.Lock()->clear();
+    }
+  }
+
+ private:
+  // Returns the index of the shard owning |key|.
+  size_t ShardIndex(const K &key) const {
+    return Hash()(key) & (kNumShards - 1);
+  }
+
+  std::array<MutexGuarded<MapType>, kNumShards> shards_;
+};
+
+}  // namespace asylo
+
+#endif  // ASYLO_UTIL_SHARDED_MUTEX_GUARDED_MAP_H_
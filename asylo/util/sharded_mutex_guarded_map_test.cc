@@ -0,0 +1,137 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "asylo/util/sharded_mutex_guarded_map.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/str_cat.h"
+
+namespace asylo {
+namespace {
+
+using ::testing::Eq;
+using ::testing::Optional;
+
+constexpr int kManyThreads = 8;
+constexpr int kKeysPerThread = 256;
+
+TEST(ShardedMutexGuardedMapTest, BasicOperations) {
+  ShardedMutexGuardedMap<std::string, int> map;
+
+  EXPECT_FALSE(map.Contains("one"));
+  EXPECT_EQ(map.Find("one"), absl::nullopt);
+
+  EXPECT_TRUE(map.Insert("one", 1));
+  EXPECT_FALSE(map.Insert("one", 100));
+  EXPECT_THAT(map.Find("one"), Optional(Eq(1)));
+
+  map.InsertOrAssign("one", 11);
+  EXPECT_THAT(map.Find("one"), Optional(Eq(11)));
+
+  EXPECT_TRUE(map.Erase("one"));
+  EXPECT_FALSE(map.Erase("one"));
+  EXPECT_FALSE(map.Contains("one"));
+}
+
+TEST(ShardedMutexGuardedMapTest, ShardViews) {
+  ShardedMutexGuardedMap<std::string, int> map;
+  ASSERT_TRUE(map.Insert("key", 1));
+
+  {
+    auto shard = map.LockShard("key");
+    auto it = shard->find("key");
+    ASSERT_NE(it, shard->end());
+    it->second = 2;
+  }
+  EXPECT_THAT(map.ReaderLockShard("key")->at("key"), Eq(2));
+}
+
+TEST(ShardedMutexGuardedMapTest, SizeForEachAndClear) {
+  ShardedMutexGuardedMap<int, int> map;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(map.Insert(i, i * i));
+  }
+  EXPECT_EQ(map.Size(), 100);
+
+  int sum = 0;
+  map.ForEach([&sum](const int &key, const int &value) {
+    EXPECT_EQ(value, key * key);
+    sum += value;
+  });
+  EXPECT_EQ(sum, 328350);
+
+  map.Clear();
+  EXPECT_EQ(map.Size(), 0);
+}
+
+// Threads working on disjoint key ranges must not lose updates; every key
+// lands in its hash-selected shard independently.
+TEST(ShardedMutexGuardedMapTest, ConcurrentDisjointWriters) {
+  ShardedMutexGuardedMap<std::string, int> map;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kManyThreads; ++t) {
+    threads.emplace_back([t, &map] {
+      for (int i = 0; i < kKeysPerThread; ++i) {
+        map.InsertOrAssign(absl::StrCat("thread-", t, "-key-", i), t);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(map.Size(), kManyThreads * kKeysPerThread);
+  for (int t = 0; t < kManyThreads; ++t) {
+    for (int i = 0; i < kKeysPerThread; ++i) {
+      EXPECT_THAT(map.Find(absl::StrCat("thread-", t, "-key-", i)),
+                  Optional(Eq(t)));
+    }
+  }
+}
+
+// Concurrent increments of a single hot key must serialize through the
+// owning shard's lock view.
+TEST(ShardedMutexGuardedMapTest, ConcurrentSingleKeyIncrements) {
+  ShardedMutexGuardedMap<std::string, int> map;
+  ASSERT_TRUE(map.Insert("counter", 0));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kManyThreads; ++t) {
+    threads.emplace_back([&map] {
+      for (int i = 0; i < kKeysPerThread; ++i) {
+        auto shard = map.LockShard("counter");
+        ++shard->at("counter");
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_THAT(map.Find("counter"),
+              Optional(Eq(kManyThreads * kKeysPerThread)));
+}
+
+}  // namespace
+}  // namespace asylo
@@ -39,9 +39,11 @@ constexpr char kMovedByAssignmentErrorMsg[] = "";
 constexpr char kStatusProtoErrorSpaceMsg[] = "";
 constexpr char kStatusProtoOkMismatchMsg[] = "";
 #else
-constexpr char kMovedByConstructorErrorMsg[] =
-    "Invalidated by move-constructor";
-constexpr char kMovedByAssignmentErrorMsg[] = "Invalidated by move-assignment";
+// The moved-from messages are kept within std::string's small-string buffer
+// (15 bytes on libstdc++) so that moving a Status never heap-allocates, in
+// any build mode. See status_allocation_test.cc.
+constexpr char kMovedByConstructorErrorMsg[] = "Moved by ctor";
+constexpr char kMovedByAssignmentErrorMsg[] = "Moved by assign";
 constexpr char kStatusProtoErrorSpaceMsg[] =
     "ErrorSpace canonical code mismatch";
 constexpr char kStatusProtoOkMismatchMsg[] =
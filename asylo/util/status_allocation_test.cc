@@ -0,0 +1,131 @@
+/*
+ *
+ * Copyright 2026 Asylo authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Verifies that the hot Status and StatusOr paths — OK construction, moves
+// and small error messages — perform no heap allocations in any build mode.
+// StatusOr moves through practically every API in the codebase, so a single
+// allocation on these paths is multiplied by every call.
+//
+// The test counts allocations by replacing the global allocation functions
+// for this test binary.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "asylo/util/status.h"
+#include "asylo/util/statusor.h"
+
+namespace {
+
+std::atomic<size_t> global_allocation_count{0};
+
+}  // namespace
+
+void *operator new(size_t size) {
+  ++global_allocation_count;
+  void *ptr = malloc(size);
+  if (ptr == nullptr) {
+    std::abort();
+  }
+  return ptr;
+}
+
+void *operator new[](size_t size) {
+  ++global_allocation_count;
+  void *ptr = malloc(size);
+  if (ptr == nullptr) {
+    std::abort();
+  }
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+
+void operator delete[](void *ptr) noexcept { free(ptr); }
+
+void operator delete(void *ptr, size_t size) noexcept { free(ptr); }
+
+void operator delete[](void *ptr, size_t size) noexcept { free(ptr); }
+
+namespace asylo {
+namespace {
+
+// Returns the number of heap allocations performed by |func|.
+template <typename F>
+size_t CountAllocations(F func) {
+  const size_t before = global_allocation_count.load();
+  func();
+  return global_allocation_count.load() - before;
+}
+
+TEST(StatusAllocationTest, CounterObservesAllocations) {
+  // Sanity-check the counting machinery itself with a message long enough to
+  // defeat any small-string optimization.
+  const std::string long_message(128, 'x');
+  EXPECT_GE(CountAllocations([&long_message]() {
+              Status status(absl::StatusCode::kInternal, long_message);
+            }),
+            1);
+}
+
+TEST(StatusAllocationTest, OkStatusDoesNotAllocate) {
+  EXPECT_EQ(CountAllocations([]() {
+              Status default_constructed;
+              Status named = Status::OkStatus();
+              Status from_function = OkStatus();
+            }),
+            0);
+}
+
+TEST(StatusAllocationTest, SmallErrorMessageDoesNotAllocate) {
+  EXPECT_EQ(CountAllocations([]() {
+              Status status(absl::StatusCode::kInvalidArgument, "bad arg");
+            }),
+            0);
+}
+
+TEST(StatusAllocationTest, StatusMoveDoesNotAllocate) {
+  Status ok = OkStatus();
+  Status error(absl::StatusCode::kInvalidArgument, "bad arg");
+  Status target;
+  EXPECT_EQ(CountAllocations([&ok, &error, &target]() {
+              Status moved_ok(std::move(ok));
+              Status moved_error(std::move(error));
+              target = std::move(moved_error);
+            }),
+            0);
+}
+
+TEST(StatusAllocationTest, StatusOrMoveDoesNotAllocate) {
+  StatusOr<int> value(42);
+  StatusOr<int> error(Status(absl::StatusCode::kInvalidArgument, "bad arg"));
+  EXPECT_EQ(CountAllocations([&value, &error]() {
+              StatusOr<int> moved_value(std::move(value));
+              StatusOr<int> moved_error(std::move(error));
+              moved_value = StatusOr<int>(7);
+            }),
+            0);
+}
+
+}  // namespace
+}  // namespace asylo
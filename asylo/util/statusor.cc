@@ -27,15 +27,14 @@ const char kValueOrDieMovedMsg[] = "";
 const char kStatusMoveConstructorMsg[] = "";
 const char kStatusMoveAssignmentMsg[] = "";
 #else
-const char kValueMoveConstructorMsg[] =
-    "Value moved by StatusOr move constructor";
-const char kValueMoveAssignmentMsg[] =
-    "Value moved by StatusOr move assignment";
-const char kStatusMoveConstructorMsg[] =
-    "Status moved by StatusOr move constructor";
-const char kValueOrDieMovedMsg[] = "Value moved by StatusOr::ValueOrDie";
-const char kStatusMoveAssignmentMsg[] =
-    "Status moved by StatusOr move assignment";
+// The moved-from messages are kept within std::string's small-string buffer
+// (15 bytes on libstdc++) so that moving a StatusOr never heap-allocates, in
+// any build mode. See status_allocation_test.cc.
+const char kValueMoveConstructorMsg[] = "Value move ctor";
+const char kValueMoveAssignmentMsg[] = "Value move asgn";
+const char kStatusMoveConstructorMsg[] = "Stat move ctor";
+const char kValueOrDieMovedMsg[] = "ValueOrDie move";
+const char kStatusMoveAssignmentMsg[] = "Stat move asgn";
 #endif
 
 }  // namespace asylo